@@ -0,0 +1,280 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "ArrayValue.h"
+#include "ByteArrayValue.h"
+#include "DequeValue.h"
+#include "DictValue.h"
+#include "ListValue.h"
+#include "SetValue.h"
+#include "SliceValue.h"
+#include "Value.h"
+#include "VectorValue.h"
+
+namespace {
+
+    Value integer(const std::int64_t n) {
+        return Value(static_cast<Value::SmallInt>(n));
+    }
+
+    // контейнеры создаются через shared_ptr, как в интерпретаторе: сборщик мусора
+    // и shared_from_this рассчитывают на объекты в куче
+
+    /// псевдослучайные ключи: порядок вставки не совпадает с порядком хешей
+    Value scrambled(const std::int64_t n) {
+        return integer((n * 2654435761LL) % 1000003);
+    }
+
+    void BM_DictInsert(benchmark::State& state) {
+
+        const std::int64_t size = state.range(0);
+
+        for (auto _ : state) {
+
+            const auto dict = std::make_shared<DictValue>();
+
+            for (std::int64_t i = 0; i < size; ++i) {
+                dict->setItem(scrambled(i), integer(i));
+            }
+
+            benchmark::DoNotOptimize(dict->len());
+        }
+
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(BM_DictInsert)->Arg(3)->Arg(8)->Arg(1024)->Arg(65536);
+
+    void BM_DictLookup(benchmark::State& state) {
+
+        const std::int64_t size = state.range(0);
+        const auto dict = std::make_shared<DictValue>();
+
+        for (std::int64_t i = 0; i < size; ++i) {
+            dict->setItem(scrambled(i), integer(i));
+        }
+
+        std::int64_t i = 0;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(dict->find(scrambled(i)));
+            i = (i + 1) % size;
+        }
+    }
+    BENCHMARK(BM_DictLookup)->Arg(3)->Arg(8)->Arg(1024)->Arg(65536);
+
+    void BM_DictStringLookup(benchmark::State& state) {
+
+        const auto dict = std::make_shared<DictValue>();
+        std::vector<Value> keys;
+
+        for (int i = 0; i < 1024; ++i) {
+            keys.emplace_back(QString("key_%1").arg(i));
+            dict->setItem(keys.back(), integer(i));
+        }
+
+        std::size_t i = 0;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(dict->find(keys[i]));
+            i = (i + 1) % keys.size();
+        }
+    }
+    BENCHMARK(BM_DictStringLookup);
+
+    void BM_DictDeleteInsert(benchmark::State& state) {
+
+        const std::int64_t size = state.range(0);
+        const auto dict = std::make_shared<DictValue>();
+
+        for (std::int64_t i = 0; i < size; ++i) {
+            dict->setItem(scrambled(i), integer(i));
+        }
+
+        // удаление и вставка того же ключа: надгробия и перестройки таблицы
+        std::int64_t i = 0;
+
+        for (auto _ : state) {
+            const Value key = scrambled(i);
+            dict->delItem(key);
+            dict->setItem(key, integer(i));
+            i = (i + 1) % size;
+        }
+    }
+    BENCHMARK(BM_DictDeleteInsert)->Arg(1024);
+
+    void BM_SetInsertContains(benchmark::State& state) {
+
+        const std::int64_t size = state.range(0);
+
+        for (auto _ : state) {
+
+            const auto set = std::make_shared<SetValue>();
+
+            for (std::int64_t i = 0; i < size; ++i) {
+                set->add(scrambled(i));
+            }
+
+            std::int64_t hits = 0;
+
+            for (std::int64_t i = 0; i < size; ++i) {
+                hits += set->contains(scrambled(i * 2));
+            }
+
+            benchmark::DoNotOptimize(hits);
+        }
+
+        state.SetItemsProcessed(state.iterations() * size * 2);
+    }
+    BENCHMARK(BM_SetInsertContains)->Arg(1024)->Arg(65536);
+
+    void BM_SetDiscard(benchmark::State& state) {
+
+        const std::int64_t size = state.range(0);
+
+        for (auto _ : state) {
+
+            state.PauseTiming();
+            const auto set = std::make_shared<SetValue>();
+
+            for (std::int64_t i = 0; i < size; ++i) {
+                set->add(scrambled(i));
+            }
+            state.ResumeTiming();
+
+            for (std::int64_t i = 0; i < size; ++i) {
+                set->discard(scrambled(i));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(BM_SetDiscard)->Arg(1024);
+
+    void BM_ListAppend(benchmark::State& state) {
+
+        const std::int64_t size = state.range(0);
+
+        for (auto _ : state) {
+
+            const auto list = std::make_shared<ListValue>();
+
+            for (std::int64_t i = 0; i < size; ++i) {
+                list->append(integer(i));
+            }
+
+            benchmark::DoNotOptimize(list->len());
+        }
+
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(BM_ListAppend)->Arg(16)->Arg(4096);
+
+    void BM_ListSlice(benchmark::State& state) {
+
+        const auto list = std::make_shared<ListValue>();
+
+        for (std::int64_t i = 0; i < 4096; ++i) {
+            list->append(integer(i));
+        }
+
+        const Value slice(std::make_shared<SliceValue>(integer(100), integer(3100), integer(state.range(0))));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(list->getItem(slice));
+        }
+    }
+    BENCHMARK(BM_ListSlice)->Arg(1)->Arg(3);
+
+    void BM_ListSort(benchmark::State& state) {
+
+        const std::int64_t size = state.range(0);
+        std::vector<Value> unsorted;
+
+        for (std::int64_t i = 0; i < size; ++i) {
+            unsorted.push_back(scrambled(i));
+        }
+
+        for (auto _ : state) {
+
+            state.PauseTiming();
+            const auto list = std::make_shared<ListValue>(unsorted);
+            state.ResumeTiming();
+
+            list->sort(std::nullopt, false, nullptr);
+        }
+
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+    BENCHMARK(BM_ListSort)->Arg(64)->Arg(16384);
+
+    void BM_DequeQueue(benchmark::State& state) {
+
+        // очередь с обоих концов: каждый шаг — один append и один popleft
+        const auto deque = std::make_shared<DequeValue>();
+
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            deque->append(integer(i));
+        }
+
+        for (auto _ : state) {
+            deque->append(deque->popLeft());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_DequeQueue)->Arg(64)->Arg(65536);
+
+    void BM_ByteArrayConsumePrefix(benchmark::State& state) {
+
+        const QByteArray chunk(state.range(0), 'x');
+        const Value head(std::make_shared<SliceValue>(std::nullopt, integer(16), std::nullopt));
+
+        for (auto _ : state) {
+
+            const auto buffer = std::make_shared<ByteArrayValue>(chunk);
+
+            // разбор потока с головы: срез префикса по 16 байт до конца буфера
+            while (buffer->len() > 0) {
+                buffer->delItem(head);
+            }
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ByteArrayConsumePrefix)->Arg(4096)->Arg(262144);
+
+    void BM_ArraySum(benchmark::State& state) {
+
+        // sum() по array('q'): один проход по буферу без Value на элемент
+        const auto array = std::make_shared<ArrayValue>('q', QByteArray(state.range(0) * 8, '\x01'));
+        const Value start = integer(0);
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(array->sumOf(start));
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ArraySum)->Arg(1024)->Arg(1 << 20);
+
+    void BM_VectorAdd(benchmark::State& state) {
+
+        // v + w над vector('d'): одно ядро на весь буфер вместо сложения Value
+        const Value left = VectorValue::make('d', QByteArray(state.range(0) * 8, '\0'));
+        const Value right = VectorValue::make('d', QByteArray(state.range(0) * 8, '\0'));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(left + right);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_VectorAdd)->Arg(1024)->Arg(1 << 20);
+}
@@ -0,0 +1,48 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include <benchmark/benchmark.h>
+
+#include "EmbeddedInterpreter.h"
+
+namespace {
+
+    void BM_EmbeddedCall(benchmark::State& state) {
+
+        // правило компилируется один раз, а вызывается с Value-аргументом без разбора вывода
+        EmbeddedInterpreter python;
+        python.execute(*python.compile(
+            "def rule(amount):\n"
+            "    if amount > 1000:\n"
+            "        return amount * 2\n"
+            "    return amount + 1\n"));
+
+        const Value rule = python.get("rule");
+        const std::vector<Value> args = {Value(static_cast<Value::SmallInt>(1500))};
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(python.call(rule, args));
+        }
+    }
+    BENCHMARK(BM_EmbeddedCall);
+
+    void BM_EmbeddedCompile(benchmark::State& state) {
+
+        EmbeddedInterpreter python;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(python.compile("def rule(amount):\n    return amount * 2\n"));
+        }
+    }
+    BENCHMARK(BM_EmbeddedCompile);
+
+    void BM_EmbeddedStartup(benchmark::State& state) {
+
+        // встроенные функции копируются из снимка, заново строятся только модули и классы
+        for (auto _ : state) {
+            EmbeddedInterpreter python;
+            benchmark::DoNotOptimize(&python);
+        }
+    }
+    BENCHMARK(BM_EmbeddedStartup);
+}
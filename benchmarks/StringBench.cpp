@@ -0,0 +1,237 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BytesValue.h"
+#include "CallRuntime.h"
+#include "CodecKernels.h"
+#include "ListValue.h"
+#include "StrValue.h"
+#include "StructFormat.h"
+#include "Value.h"
+
+namespace {
+
+    /// строка из `words` слов через пробел
+    QString sentence(const std::int64_t words) {
+
+        QStringList parts;
+
+        for (std::int64_t i = 0; i < words; ++i) {
+            parts.append(QString("word%1").arg(i % 97));
+        }
+
+        return parts.join(u' ');
+    }
+
+    void BM_StrSplit(benchmark::State& state) {
+
+        const auto text = std::make_shared<StrValue>(sentence(state.range(0)));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(text->split());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_StrSplit)->Arg(16)->Arg(4096);
+
+    void BM_StrSplitSeparator(benchmark::State& state) {
+
+        const auto text = std::make_shared<StrValue>(sentence(state.range(0)).replace(u' ', u','));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(text->split(QString(",")));
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_StrSplitSeparator)->Arg(16)->Arg(4096);
+
+    void BM_StrJoin(benchmark::State& state) {
+
+        const auto separator = std::make_shared<StrValue>(", ");
+        const Value parts = std::make_shared<StrValue>(sentence(state.range(0)))->split();
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(separator->join(parts));
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_StrJoin)->Arg(16)->Arg(4096);
+
+    void BM_StrReplace(benchmark::State& state) {
+
+        const auto text = std::make_shared<StrValue>(sentence(state.range(0)));
+        const Value from("word1");
+        const Value to("w");
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(text->replace(from, to));
+        }
+    }
+    BENCHMARK(BM_StrReplace)->Arg(16)->Arg(4096);
+
+    void BM_StrFindWorstCase(benchmark::State& state) {
+
+        // почти совпадение в каждой позиции: наивный поиск квадратичен, двусторонний — линеен
+        const auto text = std::make_shared<StrValue>(QString(state.range(0), u'a'));
+        const Value needle(QString(64, u'a') + u'b');
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(text->find(needle));
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+    }
+    BENCHMARK(BM_StrFindWorstCase)->Arg(4096)->Arg(65536);
+
+    void BM_StrUpper(benchmark::State& state) {
+
+        const auto text = std::make_shared<StrValue>(sentence(state.range(0)));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(text->upper());
+        }
+
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text->len()) * 2);
+    }
+    BENCHMARK(BM_StrUpper)->Arg(16)->Arg(4096);
+
+    void BM_StrFormat(benchmark::State& state) {
+
+        const auto pattern = std::make_shared<StrValue>("{} + {} = {:>8.3f} [{name}]");
+        const std::vector<Value> args = {Value(static_cast<Value::SmallInt>(2)),
+                                         Value(static_cast<Value::SmallInt>(40)),
+                                         Value(42.0)};
+        const Kwargs kwargs = {{"name", Value("answer")}};
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(pattern->format(args, kwargs));
+        }
+    }
+    BENCHMARK(BM_StrFormat);
+
+    void BM_BytesFind(benchmark::State& state) {
+
+        // образец в самом конце: поиск проходит весь буфер
+        QByteArray data(static_cast<qsizetype>(state.range(0)), 'a');
+        data.append("needle");
+
+        const auto haystack = std::make_shared<BytesValue>(data);
+        const Value needle(std::make_shared<BytesValue>(QByteArray("needle")));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(haystack->find(needle));
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BytesFind)->Arg(64)->Arg(65536);
+
+    void BM_BytesCount(benchmark::State& state) {
+
+        QByteArray data;
+
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            data.append(i % 7 == 0 ? "ab" : "xy");
+        }
+
+        const auto haystack = std::make_shared<BytesValue>(data);
+        const Value needle(std::make_shared<BytesValue>(QByteArray("ab")));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(haystack->count(needle));
+        }
+
+        state.SetBytesProcessed(state.iterations() * data.size());
+    }
+    BENCHMARK(BM_BytesCount)->Arg(32768);
+
+    QByteArray binary(const std::int64_t size) {
+
+        QByteArray data(size, Qt::Uninitialized);
+
+        for (std::int64_t i = 0; i < size; ++i) {
+            data[i] = static_cast<char>(i * 131 + 7);
+        }
+
+        return data;
+    }
+
+    void BM_BytesHex(benchmark::State& state) {
+
+        const auto data = std::make_shared<BytesValue>(binary(state.range(0)));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(data->hex());
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BytesHex)->Arg(64)->Arg(65536);
+
+    void BM_BytesFromHex(benchmark::State& state) {
+
+        const QString text = codeckernels::toHex(binary(state.range(0)));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(BytesValue::fromHex(text));
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BytesFromHex)->Arg(64)->Arg(65536);
+
+    void BM_Base64RoundTrip(benchmark::State& state) {
+
+        const QByteArray data = binary(state.range(0));
+        std::string error;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(codeckernels::fromBase64(codeckernels::toBase64(data),
+                                                              codeckernels::Alphabet::Standard, false, error));
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Base64RoundTrip)->Arg(65536);
+
+    void BM_BytesTranslate(benchmark::State& state) {
+
+        const auto data = std::make_shared<BytesValue>(binary(65536));
+        const Value table = BytesValue::maketrans({Value(std::make_shared<BytesValue>(QByteArray("abc"))),
+                                                   Value(std::make_shared<BytesValue>(QByteArray("xyz")))});
+        const std::optional<Value> deleted = state.range(0)
+            ? std::optional<Value>(Value(std::make_shared<BytesValue>(QByteArray("\0\n", 2))))
+            : std::nullopt;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(BytesValue::translateOf(data->bytes(), table, deleted));
+        }
+
+        state.SetBytesProcessed(state.iterations() * 65536);
+    }
+    BENCHMARK(BM_BytesTranslate)->Arg(0)->Arg(1);
+
+    void BM_StructUnpackRecords(benchmark::State& state) {
+
+        const auto format = StructFormat::compile(QString("<IHh"));
+        const QByteArray data = binary(format->size() * state.range(0));
+
+        for (auto _ : state) {
+            for (qsizetype offset = 0; offset < data.size(); offset += format->size()) {
+                benchmark::DoNotOptimize(format->unpack(data.constData() + offset));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_StructUnpackRecords)->Arg(4096);
+}
@@ -0,0 +1,90 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include <benchmark/benchmark.h>
+
+#include "IntMath.h"
+#include "Value.h"
+
+namespace {
+
+    void BM_SmallIntAdd(benchmark::State& state) {
+
+        Value total(static_cast<Value::SmallInt>(0));
+        const Value one(static_cast<Value::SmallInt>(1));
+
+        for (auto _ : state) {
+            total = total + one;
+        }
+
+        benchmark::DoNotOptimize(total);
+    }
+    BENCHMARK(BM_SmallIntAdd);
+
+    void BM_SmallIntMultiplyOverflow(benchmark::State& state) {
+
+        // произведение выходит за int64 и становится длинным целым
+        const Value big(static_cast<Value::SmallInt>(1) << 40);
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(big * big);
+        }
+    }
+    BENCHMARK(BM_SmallIntMultiplyOverflow);
+
+    void BM_FloatArithmetic(benchmark::State& state) {
+
+        Value x(1.0);
+        const Value factor(1.000001);
+
+        for (auto _ : state) {
+            x = x * factor + factor;
+        }
+
+        benchmark::DoNotOptimize(x);
+    }
+    BENCHMARK(BM_FloatArithmetic);
+
+    void BM_CompareSmallInt(benchmark::State& state) {
+
+        const Value a(static_cast<Value::SmallInt>(3));
+        const Value b(static_cast<Value::SmallInt>(5));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a < b);
+        }
+    }
+    BENCHMARK(BM_CompareSmallInt);
+
+    void BM_HashSmallInt(benchmark::State& state) {
+
+        const Value value(static_cast<Value::SmallInt>(123456789));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(value.hash());
+        }
+    }
+    BENCHMARK(BM_HashSmallInt);
+
+    void BM_HashString(benchmark::State& state) {
+
+        const Value value(QString(static_cast<qsizetype>(state.range(0)), u'x'));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(value.hash());
+        }
+    }
+    BENCHMARK(BM_HashString)->Arg(8)->Arg(64)->Arg(1024);
+
+    void BM_PowerModBigInt(benchmark::State& state) {
+
+        const Value base(Value::BigInt(12345678901234567890ULL));
+        const Value exp(static_cast<Value::SmallInt>(state.range(0)));
+        const Value mod(Value::BigInt("1000000000000000000000000000057"));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(IntMath::powerMod(base, exp, mod));
+        }
+    }
+    BENCHMARK(BM_PowerModBigInt)->Arg(1 << 10)->Arg(1 << 20);
+}
@@ -0,0 +1,48 @@
+# Fannkuch-redux: перестановки, срезы с отрицательным шагом и присваивание срезу.
+
+
+def fannkuch(n):
+    count = list(range(1, n + 1))
+    perm1 = list(range(n))
+    max_flips = 0
+    checksum = 0
+    sign = 1
+    r = n
+
+    while True:
+        while r != 1:
+            count[r - 1] = r
+            r -= 1
+
+        if perm1[0] != 0:
+            perm = perm1[:]
+            flips = 0
+            k = perm[0]
+            while k:
+                perm[:k + 1] = perm[k::-1]
+                flips += 1
+                k = perm[0]
+            if flips > max_flips:
+                max_flips = flips
+            checksum += sign * flips
+
+        sign = -sign
+
+        while True:
+            if r == n:
+                return checksum, max_flips
+            first = perm1[0]
+            i = 0
+            while i < r:
+                perm1[i] = perm1[i + 1]
+                i += 1
+            perm1[r] = first
+            count[r] -= 1
+            if count[r] > 0:
+                break
+            r += 1
+
+
+checksum, flips = fannkuch(8)
+print(checksum)
+print("Pfannkuchen(8) = " + str(flips))
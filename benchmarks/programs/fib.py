@@ -0,0 +1,10 @@
+# Рекурсивные вызовы: кадры, аргументы, сравнение и сложение малых целых.
+
+
+def fib(n):
+    if n < 2:
+        return n
+    return fib(n - 1) + fib(n - 2)
+
+
+print(fib(25))
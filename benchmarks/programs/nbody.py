@@ -0,0 +1,89 @@
+# Задача n тел для Солнца и планет-гигантов: вещественная арифметика,
+# распаковка кортежей и доступ к элементам списков.
+
+PI = 3.14159265358979323
+SOLAR_MASS = 4 * PI * PI
+DAYS_PER_YEAR = 365.24
+
+
+def make_bodies():
+    # x, y, z, vx, vy, vz, масса
+    return [
+        [0.0, 0.0, 0.0, 0.0, 0.0, 0.0, SOLAR_MASS],
+        [4.84143144246472090e+00, -1.16032004402742839e+00, -1.03622044471123109e-01,
+         1.66007664274403694e-03 * DAYS_PER_YEAR, 7.69901118419740425e-03 * DAYS_PER_YEAR,
+         -6.90460016972063023e-05 * DAYS_PER_YEAR, 9.54791938424326609e-04 * SOLAR_MASS],
+        [8.34336671824457987e+00, 4.12479856412430479e+00, -4.03523417114321381e-01,
+         -2.76742510726862411e-03 * DAYS_PER_YEAR, 4.99852801234917238e-03 * DAYS_PER_YEAR,
+         2.30417297573763929e-05 * DAYS_PER_YEAR, 2.85885980666130812e-04 * SOLAR_MASS],
+        [1.28943695621391310e+01, -1.51111514016986312e+01, -2.23307578892655734e-01,
+         2.96460137564761618e-03 * DAYS_PER_YEAR, 2.37847173959480950e-03 * DAYS_PER_YEAR,
+         -2.96589568540237556e-05 * DAYS_PER_YEAR, 4.36624404335156298e-05 * SOLAR_MASS],
+        [1.53796971148509165e+01, -2.59193146099879641e+01, 1.79258772950371181e-01,
+         2.68067772490389322e-03 * DAYS_PER_YEAR, 1.62824170038242295e-03 * DAYS_PER_YEAR,
+         -9.51592254519715870e-05 * DAYS_PER_YEAR, 5.15138902046611451e-05 * SOLAR_MASS],
+    ]
+
+
+def pairs_of(bodies):
+    result = []
+    for i in range(len(bodies)):
+        for j in range(i + 1, len(bodies)):
+            result.append((bodies[i], bodies[j]))
+    return result
+
+
+def advance(bodies, pairs, dt, steps):
+    for _ in range(steps):
+        for b1, b2 in pairs:
+            dx = b1[0] - b2[0]
+            dy = b1[1] - b2[1]
+            dz = b1[2] - b2[2]
+            dist2 = dx * dx + dy * dy + dz * dz
+            mag = dt / (dist2 * dist2 ** 0.5)
+            m1 = b1[6] * mag
+            m2 = b2[6] * mag
+            b1[3] -= dx * m2
+            b1[4] -= dy * m2
+            b1[5] -= dz * m2
+            b2[3] += dx * m1
+            b2[4] += dy * m1
+            b2[5] += dz * m1
+        for body in bodies:
+            body[0] += dt * body[3]
+            body[1] += dt * body[4]
+            body[2] += dt * body[5]
+
+
+def energy(bodies, pairs):
+    e = 0.0
+    for b1, b2 in pairs:
+        dx = b1[0] - b2[0]
+        dy = b1[1] - b2[1]
+        dz = b1[2] - b2[2]
+        e -= b1[6] * b2[6] / (dx * dx + dy * dy + dz * dz) ** 0.5
+    for body in bodies:
+        e += body[6] * (body[3] * body[3] + body[4] * body[4] + body[5] * body[5]) / 2.0
+    return e
+
+
+def offset_momentum(bodies):
+    px = 0.0
+    py = 0.0
+    pz = 0.0
+    for body in bodies:
+        px -= body[3] * body[6]
+        py -= body[4] * body[6]
+        pz -= body[5] * body[6]
+    sun = bodies[0]
+    sun[3] = px / SOLAR_MASS
+    sun[4] = py / SOLAR_MASS
+    sun[5] = pz / SOLAR_MASS
+
+
+bodies = make_bodies()
+pairs = pairs_of(bodies)
+offset_momentum(bodies)
+print("{:.9f}".format(energy(bodies, pairs)))
+advance(bodies, pairs, 0.01, 5000)
+print("{:.9f}".format(energy(bodies, pairs)))
@@ -0,0 +1,104 @@
+# Объектно-ориентированный код: иерархия классов, super(), свойства,
+# переопределённые методы и __eq__/__hash__ в ключах словаря.
+
+
+class Shape:
+    count = 0
+
+    def __init__(self, name):
+        self.name = name
+        Shape.count += 1
+
+    def area(self):
+        raise NotImplementedError
+
+    def describe(self):
+        return "{}:{:.2f}".format(self.name, self.area())
+
+    def edge_length(self):
+        return 0
+
+
+class Rect(Shape):
+    def __init__(self, w, h):
+        super().__init__("rect")
+        self.w = w
+        self.h = h
+
+    def area(self):
+        return self.w * self.h
+
+    @property
+    def perimeter(self):
+        return 2 * (self.w + self.h)
+
+    def edge_length(self):
+        return self.perimeter
+
+
+class Square(Rect):
+    def __init__(self, side):
+        super().__init__(side, side)
+        self.name = "square"
+
+
+class Circle(Shape):
+    def __init__(self, r):
+        super().__init__("circle")
+        self.r = r
+
+    def area(self):
+        return 3.14159 * self.r * self.r
+
+
+class Point:
+    def __init__(self, x, y):
+        self.x = x
+        self.y = y
+
+    def __eq__(self, other):
+        return self.x == other.x and self.y == other.y
+
+    def __hash__(self):
+        return hash((self.x, self.y))
+
+    def moved(self, dx, dy):
+        return Point(self.x + dx, self.y + dy)
+
+
+def build(n):
+    shapes = []
+    for i in range(n):
+        kind = i % 3
+        if kind == 0:
+            shapes.append(Rect(i % 7 + 1, i % 5 + 1))
+        elif kind == 1:
+            shapes.append(Square(i % 4 + 1))
+        else:
+            shapes.append(Circle(i % 3 + 1))
+    return shapes
+
+
+def walk(steps):
+    seen = {}
+    p = Point(0, 0)
+    seed = 7
+    for _ in range(steps):
+        seed = (seed * 1103515245 + 12345) % 2147483648
+        step = (seed // 65536) % 9
+        p = p.moved(step % 3 - 1, step // 3 - 1)
+        seen[p] = seen.get(p, 0) + 1
+    return len(seen)
+
+
+total = 0.0
+perimeter = 0
+for _ in range(10):
+    shapes = build(3000)
+    for shape in shapes:
+        total += shape.area()
+        perimeter += shape.edge_length()
+
+print("{:.2f}".format(total), perimeter, Shape.count)
+print(shapes[0].describe(), shapes[1].describe(), shapes[2].describe())
+print(walk(20000))
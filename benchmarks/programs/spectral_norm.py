@@ -0,0 +1,51 @@
+# Спектральная норма матрицы A[i][j] = 1 / ((i + j) * (i + j + 1) / 2 + i + 1):
+# вещественная арифметика во вложенных циклах.
+
+
+def eval_a(i, j):
+    return 1.0 / ((i + j) * (i + j + 1) // 2 + i + 1)
+
+
+def multiply_av(v):
+    n = len(v)
+    result = []
+    for i in range(n):
+        total = 0.0
+        for j in range(n):
+            total += eval_a(i, j) * v[j]
+        result.append(total)
+    return result
+
+
+def multiply_atv(v):
+    n = len(v)
+    result = []
+    for i in range(n):
+        total = 0.0
+        for j in range(n):
+            total += eval_a(j, i) * v[j]
+        result.append(total)
+    return result
+
+
+def multiply_atav(v):
+    return multiply_atv(multiply_av(v))
+
+
+def spectral_norm(n):
+    u = [1.0] * n
+    v = u
+    for _ in range(10):
+        v = multiply_atav(u)
+        u = multiply_atav(v)
+
+    vbv = 0.0
+    vv = 0.0
+    for i in range(n):
+        vbv += u[i] * v[i]
+        vv += v[i] * v[i]
+
+    return (vbv / vv) ** 0.5
+
+
+print("{:.9f}".format(spectral_norm(60)))
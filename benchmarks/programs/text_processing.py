@@ -0,0 +1,57 @@
+# Обработка текста: split/join/replace/lower, подсчёт слов в словаре,
+# сортировка по ключу и форматирование строк.
+
+WORDS = ["alpha", "Beta", "gamma", "delta", "Epsilon", "zeta", "eta", "theta",
+         "iota", "Kappa", "lambda", "mu", "nu", "xi", "omicron", "pi"]
+
+
+def make_text(lines, width):
+    seed = 12345
+    result = []
+    for _ in range(lines):
+        words = []
+        for _ in range(width):
+            seed = (seed * 1103515245 + 12345) % 2147483648
+            words.append(WORDS[(seed // 65536) % len(WORDS)])
+        result.append(" ".join(words) + ".")
+    return "\n".join(result)
+
+
+def word_counts(text):
+    counts = {}
+    for line in text.split("\n"):
+        for word in line.replace(".", "").lower().split():
+            counts[word] = counts.get(word, 0) + 1
+    return counts
+
+
+def bigrams(text):
+    pairs = {}
+    for line in text.splitlines():
+        words = line.strip(".").split(" ")
+        for i in range(len(words) - 1):
+            key = words[i] + "_" + words[i + 1]
+            if key in pairs:
+                pairs[key] += 1
+            else:
+                pairs[key] = 1
+    return pairs
+
+
+def report(counts):
+    ordered = sorted(counts.items(), key=lambda item: (-item[1], item[0]))
+    parts = []
+    for word, count in ordered[:5]:
+        parts.append("{}={}".format(word, count))
+    return ", ".join(parts)
+
+
+text = make_text(2000, 12)
+total = 0
+for _ in range(3):
+    counts = word_counts(text)
+    pairs = bigrams(text)
+    total += len(pairs)
+print(report(counts))
+print(len(pairs), total)
+print(text.upper().count("ALPHA"), text.find("pi pi"))
@@ -0,0 +1,126 @@
+"""
+Сквозные бенчмарки: каждая программа из benchmarks/programs запускается
+под cppython и под CPython, берётся лучшее время из нескольких повторов.
+
+Вывод обеих реализаций сравнивается — расхождение считается ошибкой, чтобы
+ускорение не покупалось неправильным результатом. Итоговое число — среднее
+геометрическое отношений времени cppython / CPython по всем программам.
+
+    python benchmarks/run_benchmarks.py [--cppython PATH] [--repeat N]
+                                        [--json FILE] [program ...]
+"""
+import argparse
+import json
+import math
+import os
+import platform
+import subprocess
+import sys
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PROGRAMS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "programs")
+
+if platform.system() == "Windows":
+    DEFAULT_CPPYTHON = os.path.join(ROOT, "cmake-build-debug", "cppython.exe")
+else:
+    DEFAULT_CPPYTHON = os.path.join(ROOT, "build", "cppython")
+
+
+def run_once(interpreter: str, script: str, timeout: float) -> tuple[float, str]:
+    """
+    Выполняет скрипт один раз и возвращает время в секундах и stdout.
+
+    :raises RuntimeError: если интерпретатор завершился с ошибкой.
+    """
+    start = time.perf_counter()
+    p = subprocess.run(
+        [interpreter, script],
+        cwd=PROGRAMS,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        timeout=timeout,
+    )
+    elapsed = time.perf_counter() - start
+
+    if p.returncode != 0:
+        raise RuntimeError(f"{interpreter} {os.path.basename(script)}: exit code {p.returncode}\n"
+                           + p.stderr.decode("utf-8", "replace"))
+
+    return elapsed, p.stdout.decode("utf-8").replace("\r\n", "\n")
+
+
+def best_of(interpreter: str, script: str, repeat: int, timeout: float) -> tuple[float, str]:
+    """Лучшее время из `repeat` запусков: меньше всего зависит от шума системы."""
+    times = []
+    output = ""
+
+    for _ in range(repeat):
+        elapsed, output = run_once(interpreter, script, timeout)
+        times.append(elapsed)
+
+    return min(times), output
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="cppython vs CPython end-to-end benchmarks")
+    parser.add_argument("programs", nargs="*", help="имена программ без .py (по умолчанию все)")
+    parser.add_argument("--cppython", default=DEFAULT_CPPYTHON, help="путь к интерпретатору cppython")
+    parser.add_argument("--python", default=sys.executable, help="эталонный CPython")
+    parser.add_argument("--repeat", type=int, default=3, help="запусков на программу")
+    parser.add_argument("--timeout", type=float, default=300.0, help="предел одного запуска, с")
+    parser.add_argument("--json", help="файл для результатов в JSON")
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.cppython):
+        print(f"cppython not found: {args.cppython}", file=sys.stderr)
+        return 2
+
+    names = args.programs or sorted(f[:-3] for f in os.listdir(PROGRAMS) if f.endswith(".py"))
+
+    results = []
+    failed = False
+
+    print(f"{'benchmark':<18}{'cppython, s':>13}{'CPython, s':>13}{'ratio':>9}")
+
+    for name in names:
+        script = os.path.join(PROGRAMS, name + ".py")
+
+        try:
+            ours, our_output = best_of(args.cppython, script, args.repeat, args.timeout)
+            theirs, their_output = best_of(args.python, script, args.repeat, args.timeout)
+        except (RuntimeError, subprocess.TimeoutExpired) as error:
+            print(f"{name:<18}FAILED: {error}")
+            failed = True
+            continue
+
+        if our_output != their_output:
+            print(f"{name:<18}FAILED: output differs\n--- cppython\n{our_output}--- CPython\n{their_output}")
+            failed = True
+            continue
+
+        ratio = ours / theirs
+        results.append({"name": name, "cppython": ours, "cpython": theirs, "ratio": ratio})
+        print(f"{name:<18}{ours:>13.3f}{theirs:>13.3f}{ratio:>8.2f}x")
+
+    geomean = math.exp(sum(math.log(r["ratio"]) for r in results) / len(results)) if results else None
+
+    if geomean is not None:
+        print(f"\ngeometric mean ratio: {geomean:.2f}x")
+
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as out:
+            json.dump({
+                "cppython": os.path.abspath(args.cppython),
+                "python": args.python,
+                "python_version": platform.python_version(),
+                "repeat": args.repeat,
+                "benchmarks": results,
+                "geometric_mean_ratio": geomean,
+            }, out, indent=2)
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,29 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ARRAYITERATOR_H
+#define CPPYTHON_ARRAYITERATOR_H
+#include <memory>
+
+#include "IteratorValue.h"
+
+class PackedValue;
+
+/// обход array или vector по индексу; элемент упаковывается в Value только при выдаче
+class ArrayIterator : public IteratorValue {
+public:
+
+    std::shared_ptr<PackedValue> sequence;
+    qsizetype index = 0;
+    const char* typeName;
+
+    ArrayIterator(std::shared_ptr<PackedValue> sequence, const char* typeName);
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    [[nodiscard]] QString getTypeName() const override;
+};
+#endif //CPPYTHON_ARRAYITERATOR_H
@@ -0,0 +1,163 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ARRAYKERNELS_H
+#define CPPYTHON_ARRAYKERNELS_H
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <QByteArray>
+
+#include "Value.h"
+
+/**
+ * Ядра над буферами машинных чисел для array.array и vecmath.vector.
+ *
+ * Буфер — QByteArray с элементами C-типа кода (`b`, `B`, `h`, `H`, `i`, `I`,
+ * `l`, `L`, `q`, `Q`, `f`, `d`). visitCode() превращает код в тип, и каждое
+ * ядро — простой цикл над одним типом, который компилятор векторизует сам.
+ *
+ * Поэлементные операции работают в одном типе результата: операнды сначала
+ * приводятся к нему (widen()), поэтому число шаблонных экземпляров не растёт
+ * как квадрат числа кодов. Большие буферы делятся на куски между потоками,
+ * если setThreads() разрешил больше одного.
+ */
+namespace arraykernels {
+
+    enum class Op { Add, Sub, Mul, Div };
+
+    enum class Compare { Less, LessOrEqual, Greater, GreaterOrEqual, Equal, NotEqual };
+
+    /**
+     * @brief Вызывает fn с нулём C-типа кода: `fn(T{})`.
+     *
+     * Так один шаблонный цикл обслуживает все коды, и тип элемента известен компилятору.
+     */
+    template<typename Fn>
+    decltype(auto) visitCode(const char code, Fn&& fn) {
+
+        switch (code) {
+            case 'b': return fn(std::int8_t{});
+            case 'B': return fn(std::uint8_t{});
+            case 'h': return fn(std::int16_t{});
+            case 'H': return fn(std::uint16_t{});
+            case 'i': return fn(std::int32_t{});
+            case 'I': return fn(std::uint32_t{});
+            case 'l': return fn(static_cast<long>(0));
+            case 'L': return fn(static_cast<unsigned long>(0));
+            case 'q': return fn(static_cast<long long>(0));
+            case 'Q': return fn(static_cast<unsigned long long>(0));
+            case 'f': return fn(0.0f);
+            default: return fn(0.0);
+        }
+    }
+
+    template<typename T>
+    T load(const char* data, const qsizetype index) {
+        T value;
+        std::memcpy(&value, data + index * static_cast<qsizetype>(sizeof(T)), sizeof value);
+        return value;
+    }
+
+    template<typename T>
+    void store(char* data, const qsizetype index, const T value) {
+        std::memcpy(data + index * static_cast<qsizetype>(sizeof(T)), &value, sizeof value);
+    }
+
+    /// элемент как Value: вещественный — float, 64-битный беззнаковый сверх SmallInt — BigInt
+    template<typename T>
+    Value box(const T value) {
+
+        if constexpr (std::is_floating_point_v<T>) {
+            return Value(static_cast<Value::Float>(value));
+        } else if constexpr (std::is_unsigned_v<T> && sizeof(T) == 8) {
+            return value > static_cast<T>(std::numeric_limits<Value::SmallInt>::max())
+                ? Value(Value::BigInt(value))
+                : Value(static_cast<Value::SmallInt>(value));
+        } else {
+            return Value(static_cast<Value::SmallInt>(value));
+        }
+    }
+
+    /// размер элемента кода или 0 для неизвестного кода
+    qsizetype itemSize(char code);
+
+    inline bool isFloatCode(const char code) {
+        return code == 'f' || code == 'd';
+    }
+
+    /// число потоков для поэлементных операций и сортировки больших списков; 1 — без деления на куски
+    int threads();
+
+    /// n <= 0 — по числу ядер процессора
+    void setThreads(int n);
+
+    /// буферы короче этого числа элементов не делятся между потоками
+    constexpr qsizetype parallelThreshold = qsizetype(1) << 16;
+
+    /**
+     * @brief fn(begin, end) по кускам [0, count): в вызывающем потоке или между threads().
+     *
+     * Куски не пересекаются, поэтому fn может писать в свою часть общего буфера.
+     */
+    template<typename Fn>
+    void parallelFor(const qsizetype count, Fn&& fn) {
+
+        const qsizetype workers = std::min<qsizetype>(threads(), count / parallelThreshold);
+
+        if (workers <= 1) {
+            fn(qsizetype(0), count);
+            return;
+        }
+
+        const qsizetype chunk = (count + workers - 1) / workers;
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+
+        for (qsizetype begin = chunk; begin < count; begin += chunk) {
+            pool.emplace_back([&fn, begin, end = std::min(begin + chunk, count)] { fn(begin, end); });
+        }
+
+        fn(qsizetype(0), std::min(chunk, count));
+
+        for (std::thread& worker : pool) {
+            worker.join();
+        }
+    }
+
+    /// буфер кода from, приведённый к коду to; при совпадении кодов — тот же буфер без копии
+    QByteArray widen(const QByteArray& data, char from, char to);
+
+    /**
+     * @brief Поэлементная операция над буферами кода code (`q` или `d`).
+     *
+     * Буфер из одного элемента растягивается на длину другого. Целые `q`
+     * складываются и умножаются по модулю 2^64, как в numpy; Div — только для `d`,
+     * деление на ноль даёт inf или nan.
+     */
+    QByteArray apply(Op op, char code, const QByteArray& left, const QByteArray& right);
+
+    /// маска `B` из 0 и 1: результат сравнения буферов кода code с растяжением, как в apply()
+    QByteArray compare(Compare op, char code, const QByteArray& left, const QByteArray& right);
+
+    /**
+     * @brief sum(buffer, start) без обхода через Value.
+     *
+     * Целые складываются в 64-битном (для 64-битных кодов — 128-битном)
+     * аккумуляторе. Вещественные — по порядку, как в CPython, чтобы округление
+     * совпадало. nullopt — start не int (и не float), считается общим путём.
+     */
+    std::optional<Value> sum(char code, const QByteArray& data, const Value& start);
+
+    /// min() или max() непустого буфера; при равенстве — первый, NaN ведёт себя как в CPython
+    Value extremum(char code, const QByteArray& data, bool wantMax);
+}
+
+#endif //CPPYTHON_ARRAYKERNELS_H
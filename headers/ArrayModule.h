@@ -0,0 +1,20 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ARRAYMODULE_H
+#define CPPYTHON_ARRAYMODULE_H
+
+class Value;
+
+/**
+ * @class ArrayModule
+ * @brief Глобальный объект `array`: конструктор `array(typecode, initializer)`
+ * (ArrayValue) и строка поддерживаемых кодов `typecodes`.
+ */
+class ArrayModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_ARRAYMODULE_H
@@ -0,0 +1,79 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ARRAYVALUE_H
+#define CPPYTHON_ARRAYVALUE_H
+#include "PackedValue.h"
+
+/**
+ * @class ArrayValue
+ * @brief `array.array` — изменяемый однородный массив чисел (`b`, `B`, `h`, `H`,
+ * `i`, `I`, `l`, `L`, `q`, `Q`, `f`, `d`) в непрерывном буфере.
+ *
+ * @details
+ * Семантика — как у CPython: `+` склеивает массивы, `*` повторяет. sum(), min()
+ * и max() над массивом идут прямым циклом по буферу (PackedValue::sumOf(),
+ * PackedValue::extremum()) вместо обхода через итератор.
+ */
+class ArrayValue final : public PackedValue {
+public:
+    /// код из str длины 1; ValueError или TypeError, как в CPython
+    [[nodiscard]] static char parseTypecode(const Value& value);
+
+    explicit ArrayValue(char typecode, QByteArray data = {});
+
+    /// array в значении или nullptr
+    [[nodiscard]] static ArrayValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    [[nodiscard]] Value getItem(const Value& index) const override;
+    void setItem(const Value& index, const Value& value) override;
+    void delItem(const Value& index) override;
+
+    [[nodiscard]] bool contains(const Value& value) const override;
+    [[nodiscard]] bool equal(const Value& other) const override;
+    [[nodiscard]] bool notEqual(const Value& other) const override;
+
+    [[nodiscard]] Value add(const Value& other) const override;
+    [[nodiscard]] Value multiply(const Value& other) const override;
+    [[nodiscard]] Value rmul(const Value& other) const override;
+
+    /// `+=`: только array того же кода, на месте
+    Value iadd(const Value& other) override;
+
+    /// `*=`: повтор на месте
+    Value imul(const Value& other) override;
+
+    void append(const Value& value);
+
+    /// элементы итерируемого объекта; array — только с тем же кодом
+    void extend(const Value& iterable);
+
+    /// байты bytes, bytearray или memoryview как машинные значения
+    void fromBytes(const Value& source);
+
+    Value pop(qsizetype index);
+    void insert(qsizetype index, const Value& value);
+    void remove(const Value& value);
+    void reverse();
+
+    [[nodiscard]] qsizetype index(const Value& value, qsizetype start, qsizetype stop) const;
+    [[nodiscard]] qsizetype countOf(const Value& value) const;
+
+private:
+    /// записывает value в элемент по адресу out; OverflowError и TypeError, как в CPython
+    void encode(char* out, const Value& value) const;
+
+    /// байты элементов другого массива или итерируемого объекта в коде этого массива
+    [[nodiscard]] QByteArray encodeAll(const Value& iterable) const;
+
+    [[nodiscard]] qsizetype checkedIndex(const Value& index, const char* message) const;
+
+    /// первый индекс в [from, to), равный value, или -1
+    [[nodiscard]] qsizetype find(const Value& value, qsizetype from, qsizetype to) const;
+};
+
+#endif //CPPYTHON_ARRAYVALUE_H
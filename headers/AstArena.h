@@ -0,0 +1,82 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ASTARENA_H
+#define CPPYTHON_ASTARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @class AstArena
+ * @brief Линейная (bump) арена для узлов AST одного модуля или ячейки REPL.
+ *
+ * @details
+ * Память выделяется сдвигом указателя внутри блоков, растущих вдвое, и никогда
+ * не освобождается по одному узлу: все блоки освобождаются разом вместе с ареной.
+ * Узлы соседних инструкций оказываются рядом в памяти, а разбор не обращается
+ * к общему распределителю на каждый узел.
+ */
+class AstArena {
+public:
+    AstArena() = default;
+    AstArena(const AstArena&) = delete;
+    AstArena& operator=(const AstArena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment);
+
+private:
+    static constexpr std::size_t initialBlockSize = 4 * 1024;
+    static constexpr std::size_t maxBlockSize = 256 * 1024;
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    std::byte* cursor = nullptr;
+    std::byte* end = nullptr;
+    std::size_t nextBlockSize = initialBlockSize;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief Аллокатор для std::allocate_shared, размещающий узел и его блок управления в AstArena.
+ *
+ * Копия аллокатора хранится в блоке управления каждого узла и удерживает арену:
+ * арена освобождается, когда умирает последний узел модуля — в том числе узлы,
+ * на которые ссылается `FunctionValue::body` после окончания разбора.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<AstArena> arena) : arena(std::move(arena)) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(const std::size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /// память возвращается только вместе со всей ареной
+    void deallocate(T*, std::size_t) noexcept {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return arena != other.arena;
+    }
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    std::shared_ptr<AstArena> arena;
+};
+
+#endif //CPPYTHON_ASTARENA_H
@@ -0,0 +1,26 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ASYNCIOMODULE_H
+#define CPPYTHON_ASYNCIOMODULE_H
+
+class Value;
+
+/**
+ * @class AsyncioModule
+ * @brief Глобальный объект `asyncio` — минимальное подмножество одноимённого модуля CPython.
+ *
+ * @details
+ * `run(coro)` создаёт EventLoop и выполняет сопрограмму до конца; внутри неё доступны
+ * `sleep(delay, result=None)`, `create_task(coro)`, `gather(*aws)` и
+ * `open_connection(host, port)` с потоками StreamReader/StreamWriter.
+ * `wait_readable(fd)` и `wait_writable(fd)` — Future готовности произвольного
+ * дескриптора (в CPython то же делают loop.add_reader и add_writer).
+ */
+class AsyncioModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_ASYNCIOMODULE_H
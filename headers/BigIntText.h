@@ -0,0 +1,38 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_BIGINTTEXT_H
+#define CPPYTHON_BIGINTTEXT_H
+#include <cstddef>
+#include <string>
+
+#include "Value.h"
+
+/**
+ * @class BigIntText
+ * @brief Десятичная запись длинных целых: `str(int)` и целые литералы.
+ *
+ * @details
+ * С GMP (`CPPYTHON_USE_GMP`) обе стороны — mpz_get_str и mpz_set_str, которые
+ * сами переходят на алгоритмы «разделяй и властвуй» для длинных чисел.
+ *
+ * С cpp_int разбор длинной записи делится пополам по степеням 10^(chunk·2^k):
+ * старшая половина умножается на степень и складывается с младшей, так что
+ * время определяется умножением длинных чисел, а не квадратичным накоплением
+ * по цифре. Степени вычисляются возведением в квадрат и запоминаются. Запись
+ * в строку остаётся у Boost: без быстрого деления разбиение её не ускоряет.
+ */
+class BigIntText {
+public:
+    /// короче этого цифры разбираются Boost напрямую
+    static constexpr std::size_t chunk = 512;
+
+    /// десятичная запись со знаком минус для отрицательных
+    [[nodiscard]] static std::string toString(const Value::BigInt& value);
+
+    /// целое из записи литерала: десятичные цифры разбиваются, прочее (0x…) — конструктором BigInt
+    [[nodiscard]] static Value::BigInt fromString(const std::string& text);
+};
+
+#endif //CPPYTHON_BIGINTTEXT_H
@@ -0,0 +1,43 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_BINDINGPLAN_H
+#define CPPYTHON_BINDINGPLAN_H
+#include <cstddef>
+#include <vector>
+
+#include <QHash>
+#include <QString>
+
+#include "Param.h"
+
+/**
+ * @class BindingPlan
+ * @brief Разобранная заранее сигнатура функции для связывания аргументов.
+ *
+ * @details
+ * Строится один раз для определения функции (`def` или `lambda`) и разделяется
+ * всеми FunctionValue, созданными при его выполнении. Позиционные аргументы
+ * занимают первые слоты по порядку, именованный аргумент находит свой слот одним
+ * поиском в таблице вместо перебора параметров со сравнением строк.
+ */
+class BindingPlan {
+public:
+    explicit BindingPlan(const std::vector<Param>& params);
+
+    /// индекс параметра с именем `name` или -1
+    [[nodiscard]] int indexOf(const QString& name) const {
+        return indices.value(name, -1);
+    }
+
+    /// число параметров, которые можно передать позиционно
+    [[nodiscard]] std::size_t positionalCount() const {
+        return positional;
+    }
+
+private:
+    std::size_t positional;
+    QHash<QString, int> indices;
+};
+#endif //CPPYTHON_BINDINGPLAN_H
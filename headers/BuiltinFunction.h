@@ -24,10 +24,15 @@ public:
     BuiltinFunction(QString name, FuncType func)
         : func(std::move(func)), name(std::move(name)) {}
 
+    /// встроенные функции в env; таблица общая для всех интерпретаторов процесса
     static void registerBuiltins(const std::shared_ptr<Environment>&);
 
     Value get(const std::shared_ptr<InstanceValue>&, const std::shared_ptr<ClassValue>&);
 
     [[nodiscard]] QString toString() const override;
+
+private:
+    /// создаёт встроенные функции; вызывается один раз для снимка registerBuiltins
+    static void defineBuiltins(const std::shared_ptr<Environment>&);
 };
 #endif //CPPYTHON_BUILTINFUNCTION_H
\ No newline at end of file
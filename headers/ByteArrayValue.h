@@ -4,13 +4,25 @@
 
 #ifndef CPPYTHON_BYTEARRAYVALUE_H
 #define CPPYTHON_BYTEARRAYVALUE_H
+#include "MemoryTracker.h"
 #include "ObjectValue.h"
 #include "Value.h"
 
-class ByteArrayValue : public ObjectValue, public std::enable_shared_from_this<ByteArrayValue> {
+class ByteArrayValue : public ObjectValue, public std::enable_shared_from_this<ByteArrayValue>,
+                       public MemoryTracked<MemoryTracker::Kind::ByteArray> {
 
+    /**
+     * Удаление префикса (`pop(0)`, `del b[:n]`) идёт через QByteArray::remove():
+     * у неразделённого буфера Qt 6 лишь сдвигает начало данных внутри выделенного
+     * блока, как ob_start в CPython, а свободное место в начале переиспользуется,
+     * когда append упирается в конец буфера. Разбор потока с головы выходит O(1)
+     * амортизированно.
+     */
     QByteArray data;
 
+    /// живые memoryview над буфером: пока их больше нуля, размер менять нельзя
+    qsizetype exports = 0;
+
 public:
 
     explicit ByteArrayValue(QByteArray data)
@@ -25,12 +37,21 @@ public:
         return data;
     }
 
+    void exportBuffer() { ++exports; }
+    void releaseBuffer() { --exports; }
+
+    /// BufferError, если над буфером есть memoryview
+    void ensureResizable() const;
+
     [[nodiscard]] QString repr() const override;
 
     [[nodiscard]] Value getItem(const Value& indexValue) const override;
 
     void setItem(const Value& indexValue, const Value& value) override;
 
+    [[nodiscard]] Value getItemInt(Value::SmallInt index) const override;
+    void setItemInt(Value::SmallInt index, const Value& value) override;
+
     void delItem(const Value& indexValue) override;
 
     [[nodiscard]] std::size_t len() const;
@@ -193,9 +214,7 @@ public:
 
     Value reverse();
 
-    [[nodiscard]] Value hex(
-    const std::optional<QString>& sep = std::nullopt,
-    const std::optional<Value::BigInt>& bytesPerSep = std::nullopt) const;
+    [[nodiscard]] Value hex(const std::vector<Value>& args = {}) const;
 
     static Value fromHex(const std::vector<Value>& args);
 
@@ -0,0 +1,77 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_BYTEKERNELS_H
+#define CPPYTHON_BYTEKERNELS_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+/**
+ * Общие ядра поиска и классификации байтов для bytes и bytearray.
+ *
+ * Поиск подстроки — searchkernels::Pattern<char>, общий со str: фильтр по
+ * краям образца пословно и двусторонний алгоритм для длинных образцов. Ядра
+ * работают с диапазоном [from, to) исходного буфера без копирования срезов;
+ * from и to — индексы среза Python (отрицательные отсчитываются от конца).
+ *
+ * Классификация и translate используют таблицы на 256 элементов:
+ * один индексный доступ на байт вместо цепочки сравнений.
+ */
+namespace bytekernels {
+
+    /// классы байтов для isalpha()/isdigit()/isspace()/islower()/isupper()
+    enum ByteClass : std::uint8_t {
+        Lower = 1,
+        Upper = 2,
+        Digit = 4,
+        Space = 8,
+        Alpha = Lower | Upper,
+        Alnum = Alpha | Digit
+    };
+
+    /// таблица классов ASCII; байты >= 0x80 не принадлежат ни одному классу
+    extern const std::array<std::uint8_t, 256> classTable;
+
+    inline bool is(const char byte, const std::uint8_t mask) {
+        return (classTable[static_cast<unsigned char>(byte)] & mask) != 0;
+    }
+
+    /// непустой буфер, каждый байт которого принадлежит одному из классов mask
+    bool allOf(const QByteArray& data, std::uint8_t mask);
+
+    /// позиция первого вхождения needle в data[from, to) или -1
+    qsizetype find(const QByteArray& data, const QByteArray& needle, qsizetype from, qsizetype to);
+
+    /// позиция последнего вхождения needle в data[from, to) или -1
+    qsizetype rfind(const QByteArray& data, const QByteArray& needle, qsizetype from, qsizetype to);
+
+    /// число неперекрывающихся вхождений needle в data[from, to); пустой needle — длина + 1
+    qsizetype count(const QByteArray& data, const QByteArray& needle, qsizetype from, qsizetype to);
+
+    /// замена не более limit вхождений (limit < 0 — всех) за один проход с однократным выделением
+    QByteArray replace(const QByteArray& data, const QByteArray& before, const QByteArray& after, long long limit);
+
+    /// таблица maketrans(): тождественная, кроме байтов from, которые переходят в to
+    QByteArray makeTranslation(QByteArrayView from, QByteArrayView to);
+
+    /**
+     * @brief Перекодирует байты по таблице из 256 элементов (пустая таблица — без перекодирования).
+     *
+     * Результат выделяется один раз по длине data. Без deleted — восемь табличных
+     * подстановок за шаг без ветвлений; с deleted — битовая маска на 256 бит, и байт
+     * пишется всегда, а позиция записи сдвигается только для оставляемых. Тождественная
+     * таблица без deleted возвращает data без копирования.
+     */
+    QByteArray translate(const QByteArray& data, QByteArrayView table, QByteArrayView deleted);
+
+    /// части через separator; результат выделяется один раз по сумме длин
+    QByteArray join(const QByteArray& separator, const std::vector<QByteArrayView>& pieces);
+}
+
+#endif //CPPYTHON_BYTEKERNELS_H
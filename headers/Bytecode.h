@@ -0,0 +1,158 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_BYTECODE_H
+#define CPPYTHON_BYTECODE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Environment.h"
+#include "InlineCache.h"
+#include "Value.h"
+
+class ASTNode;
+struct FrameLayout;
+
+/**
+ * @enum OpCode
+ * @brief Набор инструкций стековой виртуальной машины.
+ *
+ * Инструкции работают со стеком значений: операнды снимаются с вершины стека,
+ * результат кладётся обратно. Аргумент инструкции (`Instruction::arg`) трактуется
+ * в зависимости от кода операции: индекс константы, индекс имени, код операции
+ * узла AST или адрес перехода.
+ */
+enum class OpCode : std::uint8_t {
+    LoadConst,          ///< положить constants[arg]
+    LoadName,           ///< положить значение переменной names[arg]
+    StoreName,          ///< снять значение и записать его в переменную names[arg]
+    LoadFast,           ///< положить локальную переменную из слота arg кадра (names[arg2] — запасной путь)
+    StoreFast,          ///< снять значение и записать его в слот arg кадра (names[arg2] — запасной путь)
+    LoadDeref,          ///< положить значение ячейки arg кадра — переменной, общей с замыканиями (names[arg2] — запасной путь)
+    StoreDeref,         ///< снять значение и записать его в ячейку arg кадра (names[arg2] — запасной путь)
+    LoadGlobal,         ///< положить переменную модуля names[arg], объявленную `global` (кэш nameCaches[arg2])
+    StoreGlobal,        ///< снять значение и записать его в переменную модуля names[arg], объявленную `global`
+    LoadAttr,           ///< заменить объект на вершине его атрибутом names[arg] (кэш caches[arg2])
+    BinarySubscr,       ///< obj[idx]
+    PopTop,             ///< снять значение (результат инструкции-выражения)
+    PrintExpr,          ///< снять значение и вывести его, как это делает REPL
+    TraceLine,          ///< начало инструкции строки arg в теле функции или модуля: событие line, если включён Tracer
+    DupTop,             ///< продублировать вершину стека
+    RotTwo,             ///< поменять местами два верхних значения
+    RotThree,           ///< поднять вершину стека на третью позицию
+    UnaryOp,            ///< унарная операция, arg — UnaryOpNode::Operation
+    BinaryOp,           ///< бинарная операция, arg — BinOpNode::Operation
+    CompareOp,          ///< сравнение, arg — CompareNode::Operation
+    InplaceOp,          ///< составное присваивание, arg — AugAssignNode::Operation
+    CallFunction,       ///< вызов с arg позиционными аргументами
+    CallMethod,         ///< вызов метода names[arg2] объекта под arg позиционными аргументами (кэш caches[cache])
+    Jump,               ///< безусловный переход на arg
+    PopJumpIfFalse,     ///< снять значение и перейти на arg, если оно ложно
+    PopJumpIfTrue,      ///< снять значение и перейти на arg, если оно истинно
+    JumpIfFalseOrPop,   ///< перейти на arg, оставив значение, если оно ложно; иначе снять
+    JumpIfTrueOrPop,    ///< перейти на arg, оставив значение, если оно истинно; иначе снять
+    SetupLoop,          ///< открыть блок цикла: arg — выход по break, arg2 — адрес continue
+    PopBlock,           ///< закрыть блок цикла
+    BreakLoop,          ///< выйти из текущего цикла
+    GetIter,            ///< заменить объект на вершине его итератором (__iter__)
+    ForIter,            ///< положить следующее значение итератора или перейти на arg
+    ForIterPair,        ///< как ForIter, но элемент распакован в два значения (первое — на вершине)
+    UnpackSequence,     ///< снять значение и положить его arg элементов так, что первый — на вершине
+    ReturnValue,        ///< снять значение и завершить выполнение байткода функции с этим результатом
+    YieldValue,         ///< снять значение и приостановить кадр генератора; при возобновлении положить отправленное
+    Send,               ///< [итератор, отправленное]: положить следующее значение итератора или снять его, положить результат и перейти на arg;
+                        ///< arg2 != 0 — StopAsyncIteration из итератора снимает его и переходит на arg2
+    GetAwaitable,       ///< заменить объект на вершине итератором его ожидания (`await`)
+    GetAIter,           ///< заменить объект на вершине асинхронным итератором (__aiter__)
+    GetANext,           ///< положить итератор ожидания `__anext__()` асинхронного итератора на вершине
+    EvalNode,           ///< вычислить nodes[arg] рекурсивно и положить результат
+    BuildString,        ///< снять arg2 значений полей f-строки nodes[arg] и положить собранную строку
+    BuildConcat,        ///< принять часть arg цепочки ConcatNode (их arg на вершине); arg2 != 0 — последняя: снять все и положить сумму
+    Raise,              ///< снять причину (если arg == 1) и исключение под ней и выбросить исключение
+    Reraise,            ///< выбросить снова исключение, лежащее в stack[arg], не снимая его
+    MatchException,     ///< снять тип `except` и положить, подходит ли к нему исключение под ним
+
+    // Специализированные формы BinaryOp, InplaceOp и CompareOp. Компилятор их не порождает:
+    // VirtualMachine переписывает инструкцию, когда типы операндов стабилизировались,
+    // и возвращает общую форму, если проверка типов не прошла.
+    BinaryOpInt,        ///< BinaryOp над двумя машинными целыми (+, -, *)
+    BinaryOpFloat,      ///< BinaryOp над двумя float (+, -, *, /)
+    BinaryAddStr,       ///< конкатенация двух str
+    InplaceOpInt,       ///< InplaceOp над двумя машинными целыми (+=, -=, *=)
+    InplaceOpFloat,     ///< InplaceOp над двумя float (+=, -=, *=, /=)
+    InplaceAddStr,      ///< += над двумя str
+    CompareOpInt,       ///< CompareOp (<, <=, >, >=, ==, !=) над двумя машинными целыми
+    CompareOpFloat,     ///< CompareOp (<, <=, >, >=, ==, !=) над двумя float
+
+    // Суперинструкции горячего кода. Встают на место первой инструкции последовательности,
+    // остальные инструкции остаются в байткоде: на них можно перейти, и к ним возвращается
+    // деоптимизация. Операнды — LoadFast или LoadConst; проверка типов — int или float.
+    FastBinary,         ///< операнд, операнд, BinaryOp (+, -, *, /) — результат на стек
+    FastInplace,        ///< LoadFast x, операнд, InplaceOp (+=, -=, *=, /=), StoreFast x — без стека
+    FastCompareJump     ///< операнд, операнд, CompareOp, PopJumpIfFalse — переход без bool на стеке
+};
+
+/**
+ * @struct Instruction
+ * @brief Одна инструкция байткода.
+ */
+struct Instruction {
+    OpCode op;
+    std::int32_t arg = 0;
+    std::int32_t arg2 = 0;
+    /// индекс InlineCache места обращения к атрибуту, если третьего аргумента не хватает;
+    /// у арифметики и сравнений — счётчик выполнений до специализации,
+    /// у суперинструкций — код операции, который они заменили
+    std::int32_t cache = 0;
+};
+
+/**
+ * @struct ExceptionEntry
+ * @brief Защищённый диапазон `try`: куда передать исключение, выброшенное в [start, end).
+ *
+ * Записи лежат от внутренних `try` к внешним — берётся первая, содержащая адрес
+ * инструкции. Перед переходом на `target` стек значений усекается до `stackDepth`,
+ * блоки циклов — до `blockDepth`, и на стек кладётся объект исключения.
+ */
+struct ExceptionEntry {
+    std::int32_t start;
+    std::int32_t end;
+    std::int32_t target;
+    std::int32_t stackDepth;
+    std::int32_t blockDepth;
+};
+
+/**
+ * @struct CodeObject
+ * @brief Результат компиляции инструкции: линейный байткод и его таблицы.
+ *
+ * `nodes` хранит поддеревья AST, которые компилятор не опускает в байткод
+ * (определения функций и классов, литералы коллекций и т.п.) — они вычисляются
+ * через `ASTNode::eval` инструкцией `EvalNode`.
+ */
+struct CodeObject {
+    /// инструкции арифметики и сравнений переписываются при специализации во время выполнения
+    mutable std::vector<Instruction> code;
+    /// раскладка кадра функции, к слотам которой обращаются LoadFast/StoreFast
+    const FrameLayout* layout = nullptr;
+    std::vector<Value> constants;
+    std::vector<QString> names;
+    std::vector<std::shared_ptr<ASTNode>> nodes;
+    /// кэши мест обращения к атрибутам — заполняются во время выполнения
+    mutable std::vector<InlineCache> caches;
+    /// кэши глобальных и встроенных имён инструкций LoadName
+    mutable std::vector<NameCache> nameCaches;
+    /// диапазоны `try`; на пути без исключений не выполняется ни одной инструкции
+    std::vector<ExceptionEntry> exceptionTable;
+    /// в теле есть yield: вызов функции создаёт генератор, а не выполняет тело
+    bool generator = false;
+    /// тело `async def`: вызов создаёт сопрограмму на том же приостанавливаемом кадре
+    bool coroutine = false;
+    /// входы в байткод и обратные переходы циклов до VirtualMachine::hotThreshold
+    mutable std::int32_t heat = 0;
+};
+
+#endif //CPPYTHON_BYTECODE_H
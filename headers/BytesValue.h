@@ -4,12 +4,21 @@
 
 #ifndef CPPYTHON_BYTESVALUE_H
 #define CPPYTHON_BYTESVALUE_H
+#include <optional>
+#include <vector>
+
+#include <QByteArrayView>
+#include <QStringView>
+
+#include "MemoryTracker.h"
 #include "ObjectValue.h"
 #include "Value.h"
 
-class BytesValue : public ObjectValue {
+class BytesValue : public ObjectValue, public MemoryTracked<MemoryTracker::Kind::Bytes> {
 
 QByteArray data;
+/// bytes неизменяемы — хеш считается один раз
+mutable std::optional<std::size_t> cachedHash;
 
 public:
     explicit BytesValue(QByteArray data);
@@ -25,6 +34,7 @@ public:
     [[nodiscard]] QString repr() const override;
 
     [[nodiscard]] Value getItem(const Value& indexValue) const override;
+    [[nodiscard]] Value getItemInt(Value::SmallInt index) const override;
 
     [[nodiscard]] std::size_t len() const;
 
@@ -91,6 +101,9 @@ public:
 
     [[nodiscard]] Value join(const Value& iterable) const;
 
+    /// байты элементов join для bytes и bytearray без копирования; не bytes-like — TypeError
+    [[nodiscard]] static std::vector<QByteArrayView> joinPieces(const std::vector<Value>& items);
+
     [[nodiscard]] Value replace(
     const Value& oldValue,
     const Value& newValue,
@@ -157,20 +170,41 @@ public:
 
     [[nodiscard]] Value expandTabs(int tabsize = 8) const;
 
-    [[nodiscard]] Value hex() const;
+    /// hex([sep[, bytes_per_sep]])
+    [[nodiscard]] Value hex(const std::vector<Value>& args = {}) const;
+
+    /// hex() для bytes, bytearray и memoryview
+    [[nodiscard]] static Value hexOf(QByteArrayView data, const std::vector<Value>& args);
+
+    struct HexSeparator {
+        char16_t sep = 0;
+        qsizetype bytesPerSep = 1;
+    };
+
+    /// sep и bytes_per_sep из аргументов hex(): sep — str или bytes из одного ASCII-символа
+    [[nodiscard]] static HexSeparator hexSeparator(const std::vector<Value>& args, qsizetype size);
 
     [[nodiscard]] static Value fromHex(const QString& text);
 
+    /// байты fromhex(); пробелы допускаются только между парами цифр
+    [[nodiscard]] static QByteArray parseHex(QStringView text);
+
     [[nodiscard]] Value decode(
     const QString& encoding = "utf-8",
     const QString& errors = "strict") const;
 
+    /// maketrans() для bytes и bytearray: результат — готовая таблица, которую translate() читает без разбора
     static Value maketrans(const std::vector<Value>& args);
 
     [[nodiscard]]Value translate(
     const Value& table,
     const std::optional<Value>& deleteBytes = std::nullopt) const;
 
+    /// translate() для bytes и bytearray: table — 256 байтов или None, deleteBytes — bytes-like
+    [[nodiscard]] static QByteArray translateOf(const QByteArray& data,
+                                                const Value& table,
+                                                const std::optional<Value>& deleteBytes);
+
     [[nodiscard]] Value mod(const Value& rhs) const override;
 
     [[nodiscard]] std::size_t hash() const override;
@@ -0,0 +1,120 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_CACHEDFUNCTIONVALUE_H
+#define CPPYTHON_CACHEDFUNCTIONVALUE_H
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "CallRuntime.h"
+#include "GarbageCollector.h"
+#include "ObjectValue.h"
+
+/**
+ * @class CachedFunctionValue
+ * @brief Обёртка `functools.lru_cache` / `functools.cache` над вызываемым объектом.
+ *
+ * @details
+ * Ключ — позиционные аргументы и пары именованных в порядке вызова. Хеш ключа
+ * считается прямо по аргументам, а записи сравниваются с ними поэлементно,
+ * поэтому попадание не создаёт кортежа; копия аргументов сохраняется только
+ * при промахе.
+ *
+ * Записи связаны в двусвязный список от давней к недавней. Попадание
+ * переносит запись в конец, а при полном кэше вытесняется первая. Без предела
+ * (maxsize=None) порядок не ведётся, при maxsize=0 ничего не запоминается.
+ */
+class CachedFunctionValue final : public ObjectValue, public GcObject,
+                                  public std::enable_shared_from_this<CachedFunctionValue> {
+public:
+    CachedFunctionValue(Value function, std::optional<qsizetype> maxsize, bool typed);
+
+    /// обёртка в значении или nullptr
+    [[nodiscard]] static CachedFunctionValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    /// результат из кэша или вызов обёрнутой функции; исключение вызова не кэшируется
+    Value call(const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env);
+
+    [[nodiscard]] const Value& wrapped() const { return function; }
+
+    /// `CacheInfo(hits, misses, maxsize, currsize)`
+    [[nodiscard]] Value cacheInfo() const;
+
+    /// очищает кэш и счётчики
+    void cacheClear();
+
+    [[nodiscard]] long gcRefCount() const override;
+    [[nodiscard]] std::shared_ptr<GcObject> gcSelf() override;
+    void gcTraverse(const GcVisitor& visit) const override;
+    void gcClear() override;
+
+private:
+    struct Entry {
+        std::size_t hash;
+        std::vector<Value> args;
+        Kwargs kwargs;
+        Value result;
+        Entry* older = nullptr;
+        Entry* newer = nullptr;
+    };
+
+    [[nodiscard]] static std::size_t hashKey(const std::vector<Value>& args, const Kwargs& kwargs);
+
+    [[nodiscard]] bool sameKey(const Value& stored, const Value& given) const;
+
+    /// запись с тем же ключом или nullptr
+    [[nodiscard]] Entry* find(std::size_t hash, const std::vector<Value>& args, const Kwargs& kwargs) const;
+
+    void unlink(Entry* entry);
+    void pushNewest(Entry* entry);
+    void evictOldest();
+
+    Value function;
+    std::optional<qsizetype> maxsize;
+    bool typed;
+
+    std::unordered_multimap<std::size_t, std::unique_ptr<Entry>> entries;
+    Entry* oldest = nullptr;
+    Entry* newest = nullptr;
+
+    qsizetype hits = 0;
+    qsizetype misses = 0;
+};
+
+/**
+ * @class CacheInfoValue
+ * @brief Результат `cache_info()`: поля hits, misses, maxsize, currsize.
+ *
+ * Индексируется и сравнивается с кортежем, как именованный кортеж CPython.
+ */
+class CacheInfoValue final : public ObjectValue {
+public:
+    static constexpr qsizetype fieldCount = 4;
+
+    explicit CacheInfoValue(std::vector<Value> fields);
+
+    /// CacheInfo в значении или nullptr
+    [[nodiscard]] static CacheInfoValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    /// поле по имени; пустой optional — такого поля нет
+    [[nodiscard]] std::optional<Value> field(const QString& name) const;
+
+    [[nodiscard]] Value getItem(const Value& index) const override;
+
+    [[nodiscard]] bool equal(const Value& other) const override;
+    [[nodiscard]] bool notEqual(const Value& other) const override;
+
+private:
+    std::vector<Value> fields;
+};
+
+#endif //CPPYTHON_CACHEDFUNCTIONVALUE_H
@@ -6,6 +6,8 @@
 #define CPPYTHON_CALLRUNTIME_H
 #pragma once
 
+#include <optional>
+
 #include "Environment.h"
 #include "Value.h"
 
@@ -16,24 +18,166 @@ Value call(const Value&,
            const Kwargs&,
            const std::shared_ptr<Environment>&);
 
-Value callFunction(const Value::FunctionPtr&,
-                   const std::vector<Value>&,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&);
+/**
+ * @brief Вызов пользовательской функции в новом кадре.
+ *
+ * Кадр получает только параметры, ячейки замыкания и `__class__` — переменные
+ * вызывающего в него не попадают, поэтому цена вызова не зависит от размера
+ * области, из которой функция вызвана.
+ *
+ * Метод вызывается с `self`: он связывается с первым параметром, а `args` — со
+ * следующими, так что список аргументов не копируется ради одного лишнего элемента.
+ * ownerClass — запасной `__class__` для функции без FunctionValue::ownerClass.
+ */
+Value callFunction(const Value::FunctionPtr& func,
+                   const std::vector<Value>& args,
+                   const Kwargs& kwargs,
+                   const Value* self = nullptr,
+                   const std::shared_ptr<ClassValue>& ownerClass = nullptr);
+
+/**
+ * @brief Окружение кадра вызова func: параметры связаны с аргументами, ячейки и `__class__` на месте.
+ *
+ * Первая половина callFunction; её же использует цикл VM, выполняя вызов без рекурсии C++.
+ */
+std::shared_ptr<Environment> makeCallFrame(const Value::FunctionPtr& func,
+                                           const std::vector<Value>& args,
+                                           const Kwargs& kwargs,
+                                           const Value* self = nullptr,
+                                           const std::shared_ptr<ClassValue>& ownerClass = nullptr);
 
+/**
+ * @brief Вызов класса: конструктор встроенного типа или новый экземпляр с `__init__`.
+ *
+ * `__init__` разрешается один раз и хранится в ClassValue::construction до
+ * следующей записи атрибута класса.
+ */
 Value constructClass(const Value::ClassPtr&,
                      const std::vector<Value>&,
                      const Kwargs&,
                      const std::shared_ptr<Environment>&);
 
+/// ClassValue::construct для `str`, `bytes` и `bytearray`
+Value constructStr(const std::vector<Value>& args, const Kwargs& kwargs);
+Value constructBytes(const std::vector<Value>& args, const Kwargs& kwargs);
+Value constructByteArray(const std::vector<Value>& args, const Kwargs& kwargs);
+
 Value callBoundMethod(const Value::BoundMethodPtr&,
                       const std::vector<Value>&,
                       const Kwargs&);
 
+/**
+ * @brief Вызов функции класса как метода экземпляра `self` — то, что делает связанный метод.
+ *
+ * Общий путь для BoundMethod и для мест вызова, которые находят метод через
+ * InlineCache и не создают объект связанного метода.
+ */
+Value callMethodFunction(const Value::FunctionPtr& func,
+                         const Value& self,
+                         const std::shared_ptr<ClassValue>& ownerClass,
+                         const std::vector<Value>& args,
+                         const Kwargs& kwargs);
+
+/**
+ * @brief Вызов операторного dunder-метода экземпляра: `self.name(other)`.
+ *
+ * Как и в Python, метод ищется в классе экземпляра, а не в его полях.
+ * @return Результат метода или Value::notImplemented(), если класс метод не определяет.
+ */
+Value callOperatorMethod(const Value& self, const QString& name, const Value& other);
+
 QByteArray constructBytesData(
     const std::vector<Value>& args,
     const Kwargs& kwargs);
 
+/**
+ * @brief Дописывает к out байты итерируемого — общий путь bytes(), bytearray() и bytearray.extend.
+ *
+ * bytes, bytearray, memoryview и array копируются блоком из буфера, list и tuple
+ * целых — одним проходом с проверкой диапазона после него, остальное обходится
+ * итератором с резервом по длине. При ошибке out возвращается к исходной длине.
+ * @param rangeError Сообщение для целого вне range(0, 256) — у bytes() и extend оно разное.
+ */
+void appendBytesFrom(QByteArray& out, const Value& iterable,
+                     const char* rangeError = "ValueError: byte must be in range(0, 256)");
+
+/// у объекта есть `__iter__`; проверка не выбрасывает исключений
 bool supportsIter(const Value& obj);
 
+/**
+ * @brief `obj[index]`.
+ *
+ * Машинное целое индексирует list, tuple, str, bytes и bytearray через
+ * ObjectValue::getItemInt — без поиска `__getitem__` и вызова встроенного метода.
+ * Словарь (и defaultdict, Counter, OrderedDict) читается через DictValue::getItem.
+ */
+Value getSubscript(const Value& obj, const Value& index, const std::shared_ptr<Environment>& env);
+
+/// `obj[index] = value`; машинное целое в list и bytearray — через ObjectValue::setItemInt, ключ dict — через DictValue::setItem
+void setSubscript(const Value& obj, const Value& index, const Value& value, const std::shared_ptr<Environment>& env);
+
+/**
+ * @brief Вызов `obj.name(args)`.
+ *
+ * Методы встроенных типов из MethodTable вызываются напрямую, без создания
+ * объекта связанного метода; в остальных случаях атрибут читается как обычно
+ * (с учётом `super` и `__getattribute__`) и вызывается.
+ */
+Value callMethod(const Value& obj,
+                 const QString& name,
+                 const std::vector<Value>& args,
+                 const Kwargs& kwargs,
+                 const std::shared_ptr<Environment>& env);
+
+/**
+ * @brief Возвращает итератор объекта.
+ *
+ * Встроенные коллекции и итераторы получают IteratorValue напрямую, без поиска
+ * и вызова метода `__iter__`; для остальных объектов вызывается `__iter__`.
+ */
+Value getIter(const Value& iterable, const std::shared_ptr<Environment>& env);
+
+/// getIter, для неитерируемого объекта — пустой optional вместо TypeError
+std::optional<Value> tryGetIterator(const Value& iterable, const std::shared_ptr<Environment>& env);
+
+/**
+ * @brief Достаёт следующий элемент итератора.
+ * @return false, если итератор исчерпан.
+ *
+ * Встроенные итераторы опрашиваются через `hasNext()`/`next()` без создания
+ * объекта метода и без StopIterationException; `__next__` вызывается только
+ * для пользовательских итераторов.
+ */
+bool iterNext(const Value& iterator, Value& item, const std::shared_ptr<Environment>& env);
+
+/**
+ * @brief Итератор ожидания для `await value`.
+ *
+ * Сопрограмма ожидается сама, Future и Task — через FutureAwaiter, остальные
+ * объекты — через итератор, который возвращает их `__await__`.
+ */
+Value getAwaitable(const Value& value, const std::shared_ptr<Environment>& env);
+
+/// асинхронный итератор `async for`: результат `__aiter__()`
+Value getAsyncIter(const Value& iterable, const std::shared_ptr<Environment>& env);
+
+/**
+ * @brief Встроенный итератор, отдающий пары через nextPair(), или nullptr.
+ *
+ * Цикл `for a, b in ...` над dict.items(), enumerate и zip двух источников
+ * связывает имена прямо из записей, не создавая кортеж на каждый шаг.
+ */
+IteratorValue* pairIterator(const Value& iterator);
+
+/**
+ * @brief Распаковывает `value` ровно в `count` значений и дописывает их в `out` по порядку.
+ *
+ * Кортеж и список копируются без итератора; у остальных объектов берётся
+ * не больше `count + 1` элементов — лишний нужен только для сообщения об ошибке.
+ */
+void unpackSequence(const Value& value,
+                    std::size_t count,
+                    std::vector<Value>& out,
+                    const std::shared_ptr<Environment>& env);
+
 #endif //CPPYTHON_CALLRUNTIME_H
\ No newline at end of file
@@ -0,0 +1,33 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_CELL_H
+#define CPPYTHON_CELL_H
+#include <memory>
+#include <optional>
+
+#include "GarbageCollector.h"
+#include "Value.h"
+
+/**
+ * @class Cell
+ * @brief Переменная функции, которую читают вложенные функции, — как cell в CPython.
+ *
+ * @details
+ * Кадр объемлющей функции и все созданные в нём замыкания держат одну и ту же ячейку,
+ * поэтому запись с любой стороны видна остальным. Замыкание удерживает только
+ * ячейки своих свободных переменных, а не кадр целиком.
+ */
+class Cell final : public GcObject, public std::enable_shared_from_this<Cell> {
+public:
+    /// пусто — переменная ещё не связана
+    std::optional<Value> value;
+
+    [[nodiscard]] long gcRefCount() const override;
+    [[nodiscard]] std::shared_ptr<GcObject> gcSelf() override;
+    void gcTraverse(const GcVisitor& visit) const override;
+    void gcClear() override;
+};
+
+#endif //CPPYTHON_CELL_H
@@ -4,14 +4,31 @@
 
 #ifndef CPPYTHON_CLASSUTILS_H
 #define CPPYTHON_CLASSUTILS_H
+#include <optional>
+
 #include "Value.h"
 
 bool hasAttr(const Value::ClassPtr&, const QString&);
 
+/// имя типа для сообщений об ошибках: `int`, `list`, имя класса экземпляра
+QString typeName(const Value&);
+
+/// поиск атрибута без `__getattribute__` и `__getattr__`; промах — пустой optional
+std::optional<Value> tryGenericGetAttr(const Value&, const QString&);
+
+/// tryGenericGetAttr, промах которого — AttributeError
 Value genericGetAttr(const Value&, const QString&);
 
 Value makeIterMethod(const Value&);
 
+/**
+ * Чтение атрибута с `__getattribute__` и `__getattr__`, промах которого — пустой optional.
+ * Для проверок вроде hasattr: на промахе ни одно исключение C++ не выбрасывается,
+ * если его не выбросил пользовательский `__getattribute__` или `__getattr__`.
+ */
+std::optional<Value> tryGetAttr(const Value&, const QString&);
+
+/// tryGetAttr, промах которого — AttributeError
 Value getAttrValue(const Value&, const QString&);
 
 void genericSetAttr(const Value&, const QString&, const Value&);
@@ -20,9 +37,24 @@ void setAttrValue(const Value&, const QString&, const Value&);
 
 Value getAttrFromSuper(const Value::SuperPtr&, const QString&);
 
+/// C3-линеаризация предков класса (без него самого), вычисляется один раз на класс
+const std::vector<Value::ClassPtr>& getMRO(const Value::ClassPtr&);
+
 void buildMRO(const Value::ClassPtr&, std::vector<Value::ClassPtr>&);
 
+/// разбирает `__slots__` тела класса в ClassValue::slotNames
+void initSlots(const Value::ClassPtr&);
+
 Value::ClassPtr getObjectClass(const Value& obj);
 
-Value findAttrInHierarchy(const Value::ClassPtr&, const QString&);
+/// поиск атрибута по MRO через кэш класса; промах — пустой optional
+std::optional<Value> findAttrInHierarchy(const Value::ClassPtr&, const QString&);
+
+/// как findAttrInHierarchy, но вместе с ролью атрибута в протоколе дескрипторов
+std::optional<ClassValue::Attr> findClassAttr(const Value::ClassPtr&, const QString&);
+
+/// поиск `super()`: атрибут из MRO receiverClass после originClass, через кэш receiverClass
+std::optional<ClassValue::SuperAttr> findSuperAttr(const Value::ClassPtr& receiverClass,
+                                                   const Value::ClassPtr& originClass,
+                                                   const QString& attr);
 #endif //CPPYTHON_CLASSUTILS_H
\ No newline at end of file
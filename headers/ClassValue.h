@@ -4,21 +4,118 @@
 
 #ifndef CPPYTHON_CLASSVALUE_H
 #define CPPYTHON_CLASSVALUE_H
+#include <cstdint>
+#include <optional>
 #include <qmap.h>
+#include <QHash>
+#include <QPair>
+#include <QSet>
 #include <QString>
 
+#include "GarbageCollector.h"
 #include "ReprMixin.h"
+#include "Shape.h"
 #include "Value.h"
 
-class ClassValue : public ReprMixin {
+class ClassValue : public ReprMixin, public GcObject, public std::enable_shared_from_this<ClassValue> {
 public:
     QString name;
+    /// собственные атрибуты класса; запись — только через setAttribute()
     QMap<QString, Value> attributes;
     std::vector<std::shared_ptr<ClassValue>> bases;
 
+    /// C3-линеаризация предков без самого класса (заполняется computeMRO в ClassUtils)
+    std::vector<std::shared_ptr<ClassValue>> mro;
+    bool mroReady = false;
+
+    /**
+     * @struct Attr
+     * @brief Атрибут, найденный по MRO, вместе с его ролью в протоколе дескрипторов.
+     *
+     * Роль определяется один раз при поиске: для пользовательского дескриптора это
+     * поиск `__get__` и `__set__` в его классе, который иначе повторялся бы при
+     * каждом чтении атрибута экземпляра.
+     */
+    struct Attr {
+        Value value;
+        /// функция, property, staticmethod, classmethod или объект с `__get__`
+        bool getter = false;
+        /// property с setter или объект с `__set__`; вместе с getter — дескриптор данных, важнее поля экземпляра
+        bool setter = false;
+    };
+
+    /**
+     * @brief Кэш поиска атрибута по MRO: имя -> найденный атрибут или промах.
+     *
+     * Действителен, пока `cacheVersion` совпадает с глобальной `attributesVersion`,
+     * — запись атрибута в любой класс сбрасывает кэши всех классов, так как
+     * изменённый класс может оказаться предком (или классом дескриптора).
+     */
+    QHash<QString, std::optional<Attr>> lookupCache;
+
+    /// атрибут для `super()`: найденный в MRO после заданного класса, и класс, в котором он найден
+    struct SuperAttr {
+        Attr attr;
+        std::shared_ptr<ClassValue> owner;
+    };
+
+    /**
+     * @brief Кэш `super()` с получателем этого класса: (класс вызова, имя) -> атрибут или промах.
+     *
+     * Цепочка `super().__init__` через глубокую иерархию не ищет каждый раз класс
+     * вызова в MRO. Сбрасывается вместе с lookupCache.
+     */
+    QHash<QPair<const ClassValue*, QString>, std::optional<SuperAttr>> superCache;
+    std::uint64_t cacheVersion = 0;
+
+    static std::uint64_t attributesVersion;
+
+    /// корневая (пустая) форма экземпляров класса
+    std::shared_ptr<const Shape> instanceShape = std::make_shared<Shape>();
+
+    /// имена из `__slots__` класса и предков; пусто — экземпляры принимают любые поля
+    std::optional<QSet<QString>> slotNames;
+
+    /**
+     * @brief Конструктор встроенного типа (`str`, `bytes`...): вызов класса сразу строит значение.
+     *
+     * Слот не наследуется: подкласс встроенного типа создаёт обычный экземпляр.
+     */
+    Value (*construct)(const std::vector<Value>& args, const std::vector<std::pair<QString, Value>>& kwargs) = nullptr;
+
+    /**
+     * @struct Construction
+     * @brief Что делает вызов класса, разрешённое один раз, а не при каждом экземпляре.
+     *
+     * Действительно, пока `version` совпадает с `attributesVersion`. fieldHint —
+     * число полей, с которым экземпляр в прошлый раз вышел из `__init__`: новый
+     * экземпляр сразу резервирует под них массив значений.
+     */
+    struct Construction {
+        std::uint64_t version = 0;
+        /// `__init__` — функция на Python: вызывается без объекта связанного метода
+        Value::FunctionPtr init;
+        /// `__init__` другого рода (встроенный, дескриптор) — вызывается через поиск атрибута
+        bool genericInit = false;
+        bool exception = false;
+        std::size_t fieldHint = 0;
+    };
+
+    Construction construction;
+
     explicit ClassValue(QString name)
        : name(std::move(name)) {}
 
+    void setAttribute(const QString& attr, const Value& value) {
+        attributes[attr] = value;
+        ++attributesVersion;
+    }
+
     [[nodiscard]] QString toString() const override;
+
+    [[nodiscard]] long gcRefCount() const override;
+    [[nodiscard]] std::shared_ptr<GcObject> gcSelf() override;
+    void gcTraverse(const GcVisitor& visit) const override;
+    void gcClear() override;
 };
-#endif //CPPYTHON_CLASSVALUE_H
\ No newline at end of file
+#endif //CPPYTHON_CLASSVALUE_H
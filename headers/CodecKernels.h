@@ -0,0 +1,62 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_CODECKERNELS_H
+#define CPPYTHON_CODECKERNELS_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QStringView>
+
+/**
+ * Кодирование байтов в hex и base64 и обратно для bytes.hex()/fromhex(),
+ * bytearray и модулей binascii и base64.
+ *
+ * Кодирование табличное: байт — один индекс в таблицу из 256 готовых пар
+ * символов, тройка байтов — четыре индекса в алфавит base64. Результат
+ * выделяется один раз точного размера и заполняется без проверок на каждом шаге.
+ * Разбор идёт блоками: значения символов из таблицы объединяются по ИЛИ,
+ * и неверный символ в блоке обнаруживается одной проверкой в конце блока;
+ * только тогда блок разбирается посимвольно, чтобы найти позицию ошибки.
+ */
+namespace codeckernels {
+
+    /**
+     * hex-запись data. sep (0 — без разделителя) ставится между группами по
+     * |bytesPerSep| байтов; при bytesPerSep > 0 группы отсчитываются справа, как в CPython.
+     */
+    QString toHex(QByteArrayView data, char16_t sep = 0, qsizetype bytesPerSep = 1);
+
+    /// то же в байтах — для binascii.hexlify()
+    QByteArray toHexBytes(QByteArrayView data, char sep = 0, qsizetype bytesPerSep = 1);
+
+    /**
+     * Разбор пар hex-цифр в out. skipSpaces — пробельные символы между парами
+     * пропускаются, как в fromhex(). Результат — позиция первого неверного символа
+     * (size, если у последней пары нет второй цифры) или -1 при успехе.
+     */
+    qsizetype fromHex(QStringView text, QByteArray& out, bool skipSpaces);
+    qsizetype fromHex(QByteArrayView text, QByteArray& out, bool skipSpaces);
+
+    enum class Alphabet : std::uint8_t {
+        Standard,  ///< `+` и `/`
+        UrlSafe    ///< `-` и `_`; при разборе принимаются и стандартные символы
+    };
+
+    QByteArray toBase64(QByteArrayView data, Alphabet alphabet = Alphabet::Standard, bool newline = false);
+
+    /**
+     * Разбор base64 по правилам binascii.a2b_base64(): без strict посторонние
+     * символы пропускаются, а данные после завершающего `=` отбрасываются.
+     * При ошибке возвращает nullopt, а текст для binascii.Error пишет в error.
+     */
+    std::optional<QByteArray> fromBase64(QByteArrayView text, Alphabet alphabet, bool strict, std::string& error);
+}
+
+#endif //CPPYTHON_CODECKERNELS_H
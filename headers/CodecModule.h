@@ -0,0 +1,30 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_CODECMODULE_H
+#define CPPYTHON_CODECMODULE_H
+
+class Value;
+
+/**
+ * @class CodecModule
+ * @brief Глобальные объекты `binascii` и `base64` поверх ядер codeckernels.
+ *
+ * @details
+ * binascii: `hexlify`/`b2a_hex`, `unhexlify`/`a2b_hex`, `b2a_base64`,
+ * `a2b_base64` и класс ошибок `binascii.Error` (подкласс ValueError).
+ *
+ * base64: `b64encode`/`b64decode` с altchars и validate, `standard_*`,
+ * `urlsafe_*` и `b16encode`/`b16decode`.
+ *
+ * Данные — bytes, bytearray или memoryview; декодеры принимают и str из
+ * ASCII-символов, как в CPython.
+ */
+class CodecModule {
+public:
+    static Value makeBinascii();
+    static Value makeBase64();
+};
+
+#endif //CPPYTHON_CODECMODULE_H
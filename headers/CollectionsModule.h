@@ -0,0 +1,20 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_COLLECTIONSMODULE_H
+#define CPPYTHON_COLLECTIONSMODULE_H
+
+class Value;
+
+/**
+ * @class CollectionsModule
+ * @brief Глобальный объект `collections`: `deque` (DequeValue) и наследники dict —
+ * `defaultdict`, `Counter`, `OrderedDict`.
+ */
+class CollectionsModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_COLLECTIONSMODULE_H
@@ -0,0 +1,195 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_COMPILER_H
+#define CPPYTHON_COMPILER_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Bytecode.h"
+#include "Environment.h"
+
+class ASTNode;
+class IfNode;
+class WhileNode;
+class CompareNode;
+class ForNode;
+class UnpackAssignNode;
+class YieldNode;
+class AwaitNode;
+class AsyncForNode;
+class TryNode;
+class RaiseNode;
+
+/**
+ * @class Compiler
+ * @brief Опускает дерево, построенное `Parser::parse()`, в линейный байткод для VirtualMachine.
+ *
+ * @details
+ * В байткод компилируются управляющие конструкции (`if`, `while`, `for`, `break`, `continue`,
+ * `try`, `raise`, `return` и `yield` в теле функции),
+ * присваивания имён и горячие выражения: литералы, переменные, арифметика, сравнения,
+ * логические операторы, доступ к атрибутам, индексация и вызовы без именованных аргументов.
+ * Остальные узлы попадают в таблицу `CodeObject::nodes` и вычисляются рекурсивно
+ * инструкцией `EvalNode`, поэтому любая инструкция, разобранная парсером, компилируема.
+ */
+class Compiler {
+public:
+    /**
+     * @brief Компилирует одну инструкцию верхнего уровня.
+     * @param node Корень инструкции.
+     * @return Готовый к выполнению байткод.
+     */
+    static std::shared_ptr<const CodeObject> compile(const std::shared_ptr<ASTNode>& node);
+
+    /**
+     * @brief Компилирует тело функции целиком.
+     *
+     * `return` становится инструкцией ReturnValue, результаты инструкций-выражений
+     * не печатаются, а выполнение, дошедшее до конца тела, возвращает None.
+     * @param body Инструкции тела функции.
+     * @param coroutine Тело `async def`: в нём разрешены `await` и `async for`.
+     * @return Байткод, выполняемый callFunction для каждого вызова.
+     */
+    static std::shared_ptr<const CodeObject> compileFunction(const std::vector<std::shared_ptr<ASTNode>>& body,
+                                                             bool coroutine = false);
+
+    /**
+     * @brief Компилирует все инструкции верхнего уровня исходного файла в один байткод.
+     * @param body Инструкции, разобранные Parser::parseModule().
+     * @return Байткод, выполняемый один раз в глобальном окружении.
+     */
+    static std::shared_ptr<const CodeObject> compileModule(const std::vector<std::shared_ptr<ASTNode>>& body);
+
+    /**
+     * Результаты инструкций-выражений печатаются (`PrintExpr`), как в REPL.
+     * Выполнение файла выключает печать до компиляции первой инструкции:
+     * байткод кэшируется в узлах, поэтому режим общий для всего процесса.
+     */
+    static inline bool echoResults = true;
+
+private:
+    CodeObject code;
+
+    /// адреса `continue` для циклов, охватывающих компилируемый код
+    std::vector<std::int32_t> loopHeads;
+
+    /// компилируется тело функции: `return` — переход к выходу, а не исключение
+    bool inFunction = false;
+
+    /// компилируется тело `async def`
+    bool inCoroutine = false;
+
+    /// ставить TraceLine перед инструкциями: тела функций и модулей, но не строки REPL
+    bool traceLines = false;
+
+    /// глубина стека значений в текущем месте: итераторы циклов `for` и исключения в обработчиках
+    std::int32_t stackDepth = 0;
+
+    /**
+     * @struct TryContext
+     * @brief Конструкция `try`, внутри которой компилируется код.
+     *
+     * Except и Finally защищают диапазоны байткода: `break`, `continue` и `return`,
+     * выходящие из `try`, прерывают диапазон, пока выполняются встроенные копии блоков
+     * `finally`. Handler — обработчик: исключение лежит на стеке по индексу `stackDepth`.
+     */
+    struct TryContext {
+        enum class Kind { Except, Finally, Handler };
+
+        Kind kind;
+        /// циклов вокруг `try`: break и continue пересекают контексты внутри самого внутреннего цикла
+        std::size_t loopDepth;
+        std::int32_t stackDepth;
+        /// начало открытого диапазона
+        std::int32_t openedAt;
+        std::vector<std::pair<std::int32_t, std::int32_t>> ranges;
+        const std::vector<std::shared_ptr<ASTNode>>* finallyBody = nullptr;
+    };
+
+    std::vector<TryContext> tryContexts;
+
+    void compileStatement(const std::shared_ptr<ASTNode>& node);
+
+    void compileBlock(const std::vector<std::shared_ptr<ASTNode>>& body);
+
+    void compileExpression(const std::shared_ptr<ASTNode>& node);
+
+    void compileFallback(const std::shared_ptr<ASTNode>& node);
+
+    bool tryCompileExpression(const std::shared_ptr<ASTNode>& node);
+
+    void compileIf(const IfNode& node);
+
+    /// условие ветвления: ложное — переходы, записанные в falseJumps, истинное — дальше
+    void compileCondition(const std::shared_ptr<ASTNode>& node, std::vector<std::size_t>& falseJumps);
+
+    /// i-й правый операнд сравнения
+    void compileCompareOperand(const CompareNode& compare, std::size_t i);
+
+    void compileWhile(const WhileNode& node);
+
+    void compileFor(const ForNode& node);
+    void compileUnpackAssign(const UnpackAssignNode& node);
+
+    /// `yield` и `yield from`; функция с ними становится генератором
+    void compileYield(const YieldNode& node);
+
+    /// `await`: цикл Send/YieldValue над итератором ожидания
+    void compileAwait(const AwaitNode& node);
+
+    void compileAsyncFor(const AsyncForNode& node);
+
+    /// цикл отправки в итератор на вершине стека; exit — переход по StopAsyncIteration или 0
+    void emitSendLoop(std::int32_t exit = 0);
+
+    void compileTry(const TryNode& node);
+
+    /// false — голый `raise` вне обработчика, который вычисляется по дереву
+    bool compileRaise(const RaiseNode& node);
+
+    void openTry(TryContext::Kind kind, const std::vector<std::shared_ptr<ASTNode>>* finallyBody = nullptr);
+
+    /// закрывает внутренний контекст вместе с его открытым диапазоном
+    TryContext closeTry();
+
+    /// записывает диапазоны закрытого `try` в таблицу исключений с обработчиком по текущему адресу
+    void addHandler(const TryContext& context);
+
+    /**
+     * @brief Выход из `try` по `break`, `continue` (`loop`) или `return`.
+     *
+     * Встраивает блоки `finally` пересекаемых контекстов (от внутреннего к внешнему)
+     * и снимает исключения пересекаемых обработчиков, затем `jump` порождает сам
+     * переход, после которого контексты снова открываются.
+     */
+    template <typename Jump>
+    void compileExit(bool loop, Jump jump);
+
+    std::size_t emit(OpCode op, std::int32_t arg = 0, std::int32_t arg2 = 0);
+
+    void patch(std::size_t at);
+
+    [[nodiscard]] std::int32_t here() const;
+
+    std::int32_t addConstant(const Value& value);
+
+    std::int32_t addName(const QString& name);
+
+    std::int32_t addCache();
+
+    void emitLoad(const QString& name, const LocalSlot& slot);
+
+    void emitStore(const QString& name, const LocalSlot& slot);
+
+    /// TraceLine перед инструкцией тела функции, у которой известна строка
+    void emitLine(const ASTNode& node);
+
+    /// слот, к которому можно обращаться из этого байткода, — все слоты одной раскладки
+    bool acceptSlot(const LocalSlot& slot);
+};
+
+#endif //CPPYTHON_COMPILER_H
@@ -0,0 +1,115 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_COMPREHENSION_H
+#define CPPYTHON_COMPREHENSION_H
+#include <memory>
+#include <vector>
+
+#include <QString>
+
+#include "Environment.h"
+#include "LookaheadIterator.h"
+#include "Value.h"
+
+class ASTNode;
+class Resolver;
+struct ResolvedScope;
+
+/// `for цели in источник if условие...` — одна секция включения
+struct ComprehensionClause {
+    /// одно имя или несколько — распаковка элемента: `for k, v in ...`
+    std::vector<QString> targets;
+    std::shared_ptr<ASTNode> iterable;
+    std::vector<std::shared_ptr<ASTNode>> conditions;
+
+    /// слоты целей в кадре включения
+    std::vector<LocalSlot> slots;
+};
+
+/**
+ * @class Comprehension
+ * @brief Общая часть списковых, словарных и множественных включений и генераторных выражений.
+ *
+ * @details
+ * Включение выполняется в собственном кадре, как функция: переменные циклов получают
+ * слоты раскладки, построенной Resolver при разборе, и не попадают в объемлющую
+ * область. Источник первой секции вычисляется в объемлющей области, остальные
+ * выражения — в кадре включения. Переменные объемлющей функции включение, как
+ * и вложенная функция, читает из ячеек, захваченных при создании кадра.
+ *
+ * Результат заполняется напрямую, без вызовов `append`/`add`/`__setitem__`; если
+ * у включения одна секция без условий, ёмкость списка резервируется заранее
+ * по ListValue::lengthHint источника.
+ */
+class Comprehension {
+public:
+    enum class Kind { List, Set, Dict, Generator };
+
+    Kind kind;
+
+    /// элемент результата; для словаря — ключ
+    std::shared_ptr<ASTNode> element;
+
+    /// значение словарного включения
+    std::shared_ptr<ASTNode> value;
+
+    std::vector<ComprehensionClause> clauses;
+
+    std::shared_ptr<ResolvedScope> scope;
+    std::shared_ptr<const FrameLayout> layout;
+
+    Comprehension(Kind kind,
+                  std::shared_ptr<ASTNode> element,
+                  std::shared_ptr<ASTNode> value,
+                  std::vector<ComprehensionClause> clauses);
+
+    /// в объемлющую функцию попадает только источник первой секции, остальное — как вложенная область
+    void resolve(Resolver& r) const;
+
+    [[nodiscard]] Value evalList(const std::shared_ptr<Environment>& env) const;
+    [[nodiscard]] Value evalSet(const std::shared_ptr<Environment>& env) const;
+    [[nodiscard]] Value evalDict(const std::shared_ptr<Environment>& env) const;
+
+    /// ленивый генератор: источник первой секции вычисляется сразу, остальное — по запросу
+    [[nodiscard]] static Value makeGenerator(const std::shared_ptr<const Comprehension>& self,
+                                             const std::shared_ptr<Environment>& env);
+
+    [[nodiscard]] QString toString() const;
+
+    /// связывает цели секции с очередным элементом источника
+    void bind(const ComprehensionClause& clause, Environment& scope, const Value& item) const;
+
+    /// все условия секции истинны
+    [[nodiscard]] bool accepts(const ComprehensionClause& clause, const std::shared_ptr<Environment>& scope) const;
+
+    [[nodiscard]] std::shared_ptr<Environment> makeScope(const std::shared_ptr<Environment>& env) const;
+};
+
+/**
+ * @class GeneratorExpressionIterator
+ * @brief Генераторное выражение `(x for x in xs)`: секции обходятся лениво, по элементу за шаг.
+ *
+ * Итераторы секций хранятся стеком: исчерпанный снимается, и обход продолжается
+ * со следующего элемента внешней секции, как во вложенных циклах.
+ */
+class GeneratorExpressionIterator final : public LookaheadIterator {
+public:
+    GeneratorExpressionIterator(std::shared_ptr<const Comprehension> comprehension,
+                                std::shared_ptr<Environment> scope,
+                                Value source);
+
+    [[nodiscard]] QString getTypeName() const override { return "generator"; }
+
+    [[nodiscard]] QString toString() const override;
+
+protected:
+    bool produce(Value& out) override;
+
+private:
+    std::shared_ptr<const Comprehension> comprehension;
+    std::vector<Value> iterators;
+};
+
+#endif //CPPYTHON_COMPREHENSION_H
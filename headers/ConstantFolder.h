@@ -0,0 +1,49 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_CONSTANTFOLDER_H
+#define CPPYTHON_CONSTANTFOLDER_H
+
+#include <memory>
+#include <optional>
+
+#include "Value.h"
+
+class ASTNode;
+
+/**
+ * @class ConstantFolder
+ * @brief Свёртка константных выражений, которую Compiler выполняет перед генерацией байткода.
+ *
+ * @details
+ * Выражение сворачивается, если все его листья — литералы (ValueNode), а узлы —
+ * унарные и бинарные операции, сравнения и кортежи. Результат вычисляется один раз
+ * и попадает в таблицу констант, поэтому в байткоде остаётся один `LoadConst`.
+ *
+ * Свёртка никогда не меняет поведение программы:
+ * - операция, выбросившая исключение (например, `1 / 0`), не сворачивается
+ *   и выбросит его во время выполнения;
+ * - результаты больше разумного размера (длинные строки, огромные целые,
+ *   `'x' * 10**9`) не вычисляются, как и в CPython;
+ * - константами становятся только неизменяемые значения.
+ */
+class ConstantFolder {
+public:
+    /**
+     * @brief Вычисляет константное выражение.
+     * @return Значение выражения или nullopt, если выражение нельзя свернуть.
+     */
+    static std::optional<Value> fold(const std::shared_ptr<ASTNode>& node);
+
+    /**
+     * @brief Сворачивает правый операнд `in` / `not in`.
+     *
+     * Литералы множества становятся frozenset, а литералы списка — кортежем:
+     * операнд проверки вхождения не виден программе, поэтому изменяемость
+     * коллекции не наблюдаема.
+     */
+    static std::optional<Value> foldContainer(const std::shared_ptr<ASTNode>& node);
+};
+
+#endif //CPPYTHON_CONSTANTFOLDER_H
@@ -0,0 +1,29 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_COROUTINEVALUE_H
+#define CPPYTHON_COROUTINEVALUE_H
+#include "GeneratorValue.h"
+
+/**
+ * @class CoroutineValue
+ * @brief Сопрограмма — результат вызова `async def`.
+ *
+ * @details
+ * Кадр и возобновление те же, что у генератора: каждое `await` — цикл Send/YieldValue,
+ * и наружу сопрограмма отдаёт только то, что отдало ожидаемое — в конце цепочки
+ * это Future, завершения которой ждёт Task. Сама по себе сопрограмма ничего
+ * не делает: её выполняет `await` в другой сопрограмме или цикл событий
+ * (`asyncio.run`, `asyncio.create_task`).
+ */
+class CoroutineValue final : public GeneratorValue {
+public:
+    using GeneratorValue::GeneratorValue;
+
+    /// сопрограмма в значении или nullptr
+    [[nodiscard]] static CoroutineValue* of(const Value& value);
+
+    [[nodiscard]] QString getTypeName() const override;
+};
+#endif //CPPYTHON_COROUTINEVALUE_H
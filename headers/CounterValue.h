@@ -0,0 +1,69 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_COUNTERVALUE_H
+#define CPPYTHON_COUNTERVALUE_H
+#include <optional>
+
+#include "DictValue.h"
+
+/**
+ * @class CounterValue
+ * @brief `collections.Counter` — словарь счётчиков.
+ *
+ * @details
+ * Подсчёт (конструктор, update(), subtract()) идёт в C++: одно зондирование
+ * таблицы на элемент и сложение машинных целых на месте, без `d.get(k, 0) + 1`
+ * через интерпретатор. Отсутствующий ключ читается как 0 и в словарь не попадает.
+ *
+ * most_common(n) выбирает n наибольших частичной сортировкой; при равных
+ * счётчиках порядок — порядок вставки, как в CPython.
+ */
+class CounterValue final : public DictValue {
+public:
+    CounterValue() = default;
+
+    /// Counter в значении или nullptr
+    [[nodiscard]] static CounterValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    [[nodiscard]] Value copy() const override;
+
+    /// прибавляет delta к счётчику key; отсутствующий ключ начинается с 0
+    void increment(const Value& key, const Value& delta);
+
+    /// каждый элемент iterable — +sign; отображение — его значения со знаком sign
+    void count(const Value& source, int sign, const std::shared_ptr<Environment>& env);
+
+    /// пары (элемент, счётчик) по убыванию счётчика; n — только первые n
+    [[nodiscard]] Value mostCommon(std::optional<qsizetype> n) const;
+
+    /// элементы, каждый повторён столько раз, каков его положительный счётчик
+    [[nodiscard]] Value elements() const;
+
+    /// сумма счётчиков
+    [[nodiscard]] Value total() const;
+
+    /// `c + d`, `c - d`, `c | d`, `c & d`: в результат попадают только положительные счётчики
+    [[nodiscard]] Value add(const Value& other) const override;
+    [[nodiscard]] Value sub(const Value& other) const override;
+    [[nodiscard]] Value bitOr(const Value& other) const override;
+    [[nodiscard]] Value bitAnd(const Value& other) const override;
+
+    /// отсутствующий ключ равен нулевому счётчику: Counter(a=1) == Counter(a=1, b=0)
+    [[nodiscard]] bool equal(const Value& other) const override;
+    [[nodiscard]] bool notEqual(const Value& other) const override;
+
+protected:
+    Value missing(const Value& key) override;
+
+private:
+    /// новый Counter из ключей обоих операндов; combine(a, b) — счётчик результата
+    template<typename Combine>
+    [[nodiscard]] Value merge(const Value& other, Combine combine) const;
+};
+
+#endif //CPPYTHON_COUNTERVALUE_H
@@ -0,0 +1,177 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_COWVECTOR_H
+#define CPPYTHON_COWVECTOR_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ObjectPool.h"
+
+/**
+ * @class CowVector
+ * @brief Вектор с копированием при записи: копии делят один буфер до первого изменения.
+ *
+ * @details
+ * Копия CowVector — это ещё одна ссылка на тот же буфер. Константный доступ
+ * никогда не копирует; любой неконстантный (operator[], begin, push_back, ...)
+ * сначала отделяет буфер, если его делит кто-то ещё. Поэтому в коде только для
+ * чтения элементы лучше брать через `get()` или константную ссылку — иначе
+ * неконстантный operator[] отделит буфер впустую.
+ *
+ * Пустой вектор буфера не держит. Ссылки и итераторы, полученные неконстантным
+ * доступом, живут до следующей копии CowVector: после неё запись через них
+ * видна обеим копиям.
+ *
+ * version() растёт при каждом неконстантном доступе: владелец может кэшировать
+ * сведения о содержимом и сверять их с версией, не следя за каждой записью.
+ */
+template<typename T>
+class CowVector {
+public:
+    using Vector = std::vector<T>;
+    using value_type = T;
+    using size_type = typename Vector::size_type;
+    using iterator = typename Vector::iterator;
+    using const_iterator = typename Vector::const_iterator;
+
+    CowVector() = default;
+    CowVector(const CowVector&) = default;
+    CowVector(CowVector&&) noexcept = default;
+
+    explicit CowVector(Vector items)
+        : buffer(items.empty() ? nullptr : allocate(std::move(items))) {}
+
+    CowVector& operator=(const CowVector& other) {
+        buffer = other.buffer;
+        ++changes;
+        return *this;
+    }
+
+    CowVector& operator=(CowVector&& other) noexcept {
+        buffer = std::move(other.buffer);
+        ++changes;
+        return *this;
+    }
+
+    CowVector& operator=(Vector items) {
+        buffer = items.empty() ? nullptr : allocate(std::move(items));
+        ++changes;
+        return *this;
+    }
+
+    /// элементы только для чтения; буфер не отделяется
+    [[nodiscard]] const Vector& get() const { return buffer ? *buffer : none(); }
+
+    operator const Vector&() const { return get(); }
+
+    /// собственный буфер для изменения: общий сперва копируется
+    Vector& mutate() {
+
+        ++changes;
+
+        if (!buffer) {
+            buffer = allocate(Vector());
+        } else if (buffer.use_count() > 1) {
+            buffer = allocate(Vector(*buffer));
+        }
+
+        return *buffer;
+    }
+
+    /// делит ли буфер с другой копией
+    [[nodiscard]] bool shared() const { return buffer && buffer.use_count() > 1; }
+
+    /// число неконстантных обращений; равные версии — то же содержимое
+    [[nodiscard]] std::uint64_t version() const { return changes; }
+
+    [[nodiscard]] size_type size() const { return get().size(); }
+    [[nodiscard]] bool empty() const { return get().empty(); }
+    [[nodiscard]] size_type capacity() const { return get().capacity(); }
+
+    const T& operator[](const size_type i) const { return get()[i]; }
+    T& operator[](const size_type i) { return mutate()[i]; }
+
+    const T& front() const { return get().front(); }
+    T& front() { return mutate().front(); }
+
+    const T& back() const { return get().back(); }
+    T& back() { return mutate().back(); }
+
+    const_iterator begin() const { return get().begin(); }
+    const_iterator end() const { return get().end(); }
+    iterator begin() { return mutate().begin(); }
+    iterator end() { return mutate().end(); }
+
+    void reserve(const size_type n) { mutate().reserve(n); }
+    void resize(const size_type n) { mutate().resize(n); }
+
+    void push_back(const T& value) { mutate().push_back(value); }
+    void push_back(T&& value) { mutate().push_back(std::move(value)); }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) { return mutate().emplace_back(std::forward<Args>(args)...); }
+
+    void pop_back() { mutate().pop_back(); }
+
+    template<typename... Args>
+    iterator insert(const_iterator pos, Args&&... args) {
+        // pos указывает в общий буфер: после отделения нужен тот же индекс в новом
+        const auto index = pos - get().begin();
+        Vector& items = mutate();
+        return items.insert(items.cbegin() + index, std::forward<Args>(args)...);
+    }
+
+    iterator erase(const_iterator pos) {
+        const auto index = pos - get().begin();
+        Vector& items = mutate();
+        return items.erase(items.cbegin() + index);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        const auto from = first - get().begin();
+        const auto to = last - get().begin();
+        Vector& items = mutate();
+        return items.erase(items.cbegin() + from, items.cbegin() + to);
+    }
+
+    /// общий буфер не очищается, а просто отпускается
+    void clear() {
+        ++changes;
+        if (shared()) {
+            buffer.reset();
+        } else if (buffer) {
+            buffer->clear();
+        }
+    }
+
+    /// обмен содержимым с обычным вектором; общий буфер при этом не меняется
+    void swap(Vector& other) {
+        ++changes;
+        if (shared()) {
+            Vector own(std::move(other));
+            other = get();
+            buffer = allocate(std::move(own));
+        } else {
+            mutate().swap(other);
+        }
+    }
+
+private:
+    static std::shared_ptr<Vector> allocate(Vector items) {
+        return std::allocate_shared<Vector>(PoolAllocator<Vector>(), std::move(items));
+    }
+
+    static const Vector& none() {
+        static const Vector items;
+        return items;
+    }
+
+    std::shared_ptr<Vector> buffer;
+    std::uint64_t changes = 0;
+};
+#endif //CPPYTHON_COWVECTOR_H
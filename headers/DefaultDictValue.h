@@ -0,0 +1,43 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_DEFAULTDICTVALUE_H
+#define CPPYTHON_DEFAULTDICTVALUE_H
+#include "DictValue.h"
+
+/**
+ * @class DefaultDictValue
+ * @brief `collections.defaultdict` — словарь, который создаёт значение отсутствующего ключа.
+ *
+ * @details
+ * Это DictValue, поэтому быстрые пути словаря к нему применимы как есть; отличие
+ * только в `__missing__`: d[key] без ключа вызывает default_factory, кладёт
+ * результат в словарь и возвращает его. get() и `in` фабрику не вызывают.
+ */
+class DefaultDictValue final : public DictValue {
+public:
+    explicit DefaultDictValue(Value factory);
+
+    /// defaultdict в значении или nullptr
+    [[nodiscard]] static DefaultDictValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    [[nodiscard]] Value copy() const override;
+
+    /// фабрика значений; None — отсутствующий ключ даёт KeyError, как у dict
+    [[nodiscard]] const Value& defaultFactory() const { return factory; }
+
+    void gcTraverse(const GcVisitor& visit) const override;
+    void gcClear() override;
+
+protected:
+    Value missing(const Value& key) override;
+
+private:
+    Value factory;
+};
+
+#endif //CPPYTHON_DEFAULTDICTVALUE_H
@@ -0,0 +1,27 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_DEQUEITERATOR_H
+#define CPPYTHON_DEQUEITERATOR_H
+#include "IteratorValue.h"
+
+class DequeValue;
+
+/// обход deque по индексу; изменение очереди во время обхода — RuntimeError, как в CPython
+class DequeIterator : public IteratorValue {
+public:
+
+    std::shared_ptr<DequeValue> deque;
+    qsizetype index = 0;
+    quint64 version;
+
+    explicit DequeIterator(std::shared_ptr<DequeValue> deque);
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    [[nodiscard]] QString getTypeName() const override;
+};
+#endif //CPPYTHON_DEQUEITERATOR_H
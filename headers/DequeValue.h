@@ -0,0 +1,107 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_DEQUEVALUE_H
+#define CPPYTHON_DEQUEVALUE_H
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "GarbageCollector.h"
+#include "ObjectValue.h"
+
+/**
+ * @class DequeValue
+ * @brief `collections.deque` — очередь с O(1) добавлением и удалением с обоих концов.
+ *
+ * @details
+ * Элементы лежат в блоках по blockSize штук, а указатели на блоки — в кольцевом
+ * буфере. Элемент i находится в блоке (first + (head + i) / blockSize) по модулю
+ * числа блоков, поэтому индексирование тоже O(1). Сдвиг с конца в конец
+ * (appendleft после pop, rotate) меняет только head и first: элементы не
+ * переезжают, а освободившиеся блоки остаются в кольце и переиспользуются.
+ * Когда блоков не хватает, кольцо удваивается — переставляются указатели, не
+ * элементы.
+ *
+ * При заданном maxlen добавление в полную очередь вытесняет элемент с другого конца.
+ */
+class DequeValue final : public ObjectValue, public GcObject, public std::enable_shared_from_this<DequeValue> {
+public:
+    static constexpr qsizetype blockSize = 64;
+
+    explicit DequeValue(std::optional<qsizetype> maxlen = std::nullopt);
+
+    /// deque в значении или nullptr
+    [[nodiscard]] static DequeValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    [[nodiscard]] Value getItem(const Value& index) const override;
+    void setItem(const Value& index, const Value& value) override;
+    void delItem(const Value& index) override;
+
+    [[nodiscard]] bool contains(const Value& value) const override;
+    [[nodiscard]] bool equal(const Value& other) const override;
+    [[nodiscard]] bool notEqual(const Value& other) const override;
+
+    [[nodiscard]] qsizetype len() const { return count; }
+    [[nodiscard]] std::optional<qsizetype> maxLength() const { return maxlen; }
+
+    /// элемент с неотрицательным индексом `index < len()`
+    [[nodiscard]] const Value& at(qsizetype index) const;
+
+    /// счётчик изменений: итератор сверяет его, чтобы заметить изменение во время обхода
+    [[nodiscard]] quint64 version() const { return state; }
+
+    void append(const Value& value);
+    void appendLeft(const Value& value);
+    Value pop();
+    Value popLeft();
+
+    void extend(const Value& iterable);
+    void extendLeft(const Value& iterable);
+
+    void insert(const Value& index, const Value& value);
+    void remove(const Value& value);
+    void clear();
+    void rotate(qsizetype steps);
+    void reverse();
+
+    [[nodiscard]] qsizetype countOf(const Value& value) const;
+    [[nodiscard]] qsizetype index(const Value& value, qsizetype start, qsizetype stop) const;
+
+    [[nodiscard]] Value copy() const;
+
+    [[nodiscard]] long gcRefCount() const override;
+    [[nodiscard]] std::shared_ptr<GcObject> gcSelf() override;
+    void gcTraverse(const GcVisitor& visit) const override;
+    void gcClear() override;
+
+private:
+    using Block = std::array<Value, blockSize>;
+
+    /// ячейка по позиции от начала блока first; блок создаётся при первом обращении
+    Value& slot(qsizetype position);
+    [[nodiscard]] const Value& slot(qsizetype position) const;
+
+    /// удваивает кольцо, раскладывая блоки по порядку с first = 0
+    void grow();
+
+    /// индекс после нормализации отрицательного; IndexError вне [0, len)
+    [[nodiscard]] qsizetype checkedIndex(const Value& index) const;
+
+    /// удаляет элемент по индексу, сдвигая ближнюю к краю часть
+    void erase(qsizetype index);
+
+    std::vector<std::unique_ptr<Block>> blocks;
+    qsizetype first = 0;
+    qsizetype head = 0;
+    qsizetype count = 0;
+    std::optional<qsizetype> maxlen;
+    quint64 state = 0;
+};
+
+#endif //CPPYTHON_DEQUEVALUE_H
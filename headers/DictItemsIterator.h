@@ -4,6 +4,7 @@
 
 #ifndef CPPYTHON_DICTITEMSITERATOR_H
 #define CPPYTHON_DICTITEMSITERATOR_H
+#include <cstdint>
 #include <memory>
 
 #include "IteratorValue.h"
@@ -17,14 +18,20 @@ public:
 
     std::shared_ptr<DictValue> dict;
     std::size_t index = 0;
+    /// длина и версия словаря при создании: изменение во время обхода — RuntimeError
+    std::size_t size;
+    std::uint64_t version;
 
-    explicit DictItemsIterator(std::shared_ptr<DictValue> dict)
-    : dict(std::move(dict)) {}
+    explicit DictItemsIterator(std::shared_ptr<DictValue> dict);
 
     Value next() override;
 
     [[nodiscard]] bool hasNext() const override;
 
     [[nodiscard]] QString getTypeName() const override;
+
+    [[nodiscard]] bool pairwise() const override { return true; }
+
+    bool nextPair(Value& key, Value& value) override;
 };
 #endif //CPPYTHON_DICTITEMSITERATOR_H
\ No newline at end of file
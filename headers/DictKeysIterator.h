@@ -4,6 +4,7 @@
 
 #ifndef CPPYTHON_DICTKEYSITERATOR_H
 #define CPPYTHON_DICTKEYSITERATOR_H
+#include <cstdint>
 #include <memory>
 
 #include "IteratorValue.h"
@@ -16,9 +17,11 @@ public:
 
     std::shared_ptr<DictValue> dict;
     std::size_t index = 0;
+    /// длина и версия словаря при создании: изменение во время обхода — RuntimeError
+    std::size_t size;
+    std::uint64_t version;
 
-    explicit DictKeysIterator(std::shared_ptr<DictValue> dict)
-    : dict(std::move(dict)) {}
+    explicit DictKeysIterator(std::shared_ptr<DictValue> dict);
 
     Value next() override;
 
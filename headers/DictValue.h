@@ -5,21 +5,81 @@
 #ifndef CPPYTHON_DICTVALUE_H
 #define CPPYTHON_DICTVALUE_H
 
-#include <QHash>
+#include <cstdint>
+#include <vector>
 
+#include <QVector>
+
+#include "GarbageCollector.h"
+#include "MemoryTracker.h"
 #include "ObjectValue.h"
 #include "Value.h"
 
-class DictValue : public ObjectValue, public std::enable_shared_from_this<DictValue> {
-    QHash<Value, Value> elements;
-    QVector<Value> order;
+/**
+ * @class DictValue
+ * @brief Словарь Python с сохранением порядка вставки — компактная таблица в духе CPython.
+ *
+ * @details
+ * Пары хранятся плотным массивом `entries` в порядке вставки, а разреженная таблица
+ * `indices` (размер — степень двойки, открытая адресация) хранит номера записей.
+ * Удаление оставляет в массиве надгробие и помечает ячейку таблицы как DUMMY,
+ * поэтому стоит O(1); надгробия вычищаются при очередном перестроении таблицы.
+ *
+ * Пока записей не больше SMALL_SIZE (kwargs, небольшие записи), таблицы `indices`
+ * нет вовсе: ключ ищется линейным проходом по entries со сравнением хешей сначала.
+ * Малый словарь — одно выделение памяти; таблица строится при росте.
+ */
+class DictValue : public ObjectValue, public GcObject, public std::enable_shared_from_this<DictValue>,
+                  public MemoryTracked<MemoryTracker::Kind::Dict> {
+public:
+    struct Entry {
+        std::size_t hash = 0;
+        Value key;
+        Value value;
+        bool live = false;
+    };
+
+protected:
+    std::vector<Entry> entries;
+    std::vector<std::int32_t> indices;
+    /// живых записей
+    std::size_t used = 0;
+    /// занятых ячеек `indices`: живые записи и DUMMY
+    std::size_t fill = 0;
+    /// растёт, когда записи в entries переезжают: при перестроении таблицы и clear()
+    std::uint64_t layoutVersion = 0;
+
+    static constexpr std::int32_t EMPTY = -1;
+    static constexpr std::int32_t DUMMY = -2;
+    static constexpr std::size_t MIN_SIZE = 8;
+    /// записей в entries, до которых словарь обходится без таблицы indices
+    static constexpr std::size_t SMALL_SIZE = 8;
+
+    /// номер записи ключа в entries или -1
+    [[nodiscard]] std::ptrdiff_t lookup(const Value& key, std::size_t hash) const;
+
+    [[nodiscard]] const Entry* findEntry(const Value& key) const;
+
+    void insert(const Value& key, const Value& value);
+
+    /// insert с уже известным qHash(key) — хешем из записи другого словаря или множества
+    void insertHashed(const Value& key, std::size_t hash, const Value& value);
+
+    void removeAt(std::ptrdiff_t ix);
+
+    /**
+     * @brief Выбрасывает надгробия и строит таблицу с запасом на рост; малый словарь только уплотняет.
+     * @param capacity Живых записей, которые таблица должна вместить без следующего перестроения.
+     */
+    void rebuild(std::size_t capacity = 0);
+
+    /// `__missing__`: чем отвечает d[key] на отсутствующий ключ; у dict — KeyError
+    virtual Value missing(const Value& key);
 
 public:
 
     DictValue() = default;
 
-    explicit DictValue(const QHash<Value, Value>&, const QVector<Value>&);
-
     [[nodiscard]] QString toString() const override;
 
     [[nodiscard]] QString repr() const override;
@@ -36,21 +96,93 @@ public:
 
     void clear();
 
-    [[nodiscard]] Value copy() const;
+    /// поверхностная копия того же типа: копия defaultdict — defaultdict
+    [[nodiscard]] virtual Value copy() const;
 
     Value pop(const Value&, const Value* = nullptr);
 
     void update(const std::shared_ptr<DictValue>&);
 
+    /**
+     * @brief Готовит таблицу к extra новым ключам: до этой длины вставка не перестраивает её.
+     *
+     * extra — оценка сверху по длине источника; повторяющиеся ключи оставляют запас неиспользованным.
+     */
+    void reserve(std::size_t extra);
+
+    /**
+     * @brief Пары other поверх своих: `update`, `|`, `|=` и `{**a, **b}`.
+     *
+     * Пустой словарь получает копию плотного массива и таблицы other целиком, без
+     * хеширования и сравнения ключей. Иначе таблица резервируется под other сразу,
+     * а ключи вставляются с хешами из его записей.
+     */
+    void merge(const DictValue& other);
+
+    /// пары (ключ, значение) итерируемого — `dict(pairs)` и `update(pairs)`; таблица резервируется по его длине
+    void mergePairs(const Value& iterable);
+
     Value setdefault(const Value&, const Value& = Value());
 
-    [[nodiscard]] Value popitem();
+    /// последняя пара, при last=false — первая
+    [[nodiscard]] Value popitem(bool last = true);
 
-    [[nodiscard]] QVector<Value> getOrder() const;
+    /**
+     * @brief Переносит запись ключа в конец порядка или, при last=false, в начало.
+     *
+     * В конец — надгробие на старом месте и запись в хвост, амортизированно O(1);
+     * в начало — сдвиг плотного массива, O(n). KeyError, если ключа нет.
+     */
+    void moveToEnd(const Value& key, bool last = true);
 
-    [[nodiscard]] QHash<Value, Value> getElements() const;
+    /// ключи в порядке вставки
+    [[nodiscard]] QVector<Value> getOrder() const;
 
-    [[nodiscard]] const QHash<Value, Value>& getElementsRef() const;
+    /// значение по ключу или nullptr
+    [[nodiscard]] const Value* find(const Value& key) const;
+
+    /// длина плотного массива вместе с надгробиями — граница для итераторов
+    [[nodiscard]] std::size_t entryCount() const {
+        return entries.size();
+    }
+
+    /// байты, выделенные под плотный массив записей и таблицу индексов
+    [[nodiscard]] std::size_t tableBytes() const {
+        return entries.capacity() * sizeof(Entry) + indices.capacity() * sizeof(std::int32_t);
+    }
+
+    [[nodiscard]] std::uint64_t version() const {
+        return layoutVersion;
+    }
+
+    /**
+     * @brief Проверка итератора перед шагом: RuntimeError, если с его создания
+     * изменилась длина словаря или записи переехали.
+     *
+     * Итератор хранит номер записи в entries. Замена значения и удаление с
+     * добавлением той же длины номер не сбивают — обход продолжается, как в
+     * CPython; перестроение массива сбивает, и шаг бросает ошибку.
+     */
+    void ensureUnchanged(std::size_t size, std::uint64_t version) const;
+
+    /// первая живая запись с номером не меньше `from` или entryCount()
+    [[nodiscard]] std::size_t nextLive(std::size_t from) const;
+
+    /// последняя живая запись с номером не больше `from` или -1
+    [[nodiscard]] std::ptrdiff_t prevLive(std::ptrdiff_t from) const;
+
+    [[nodiscard]] const Entry& entryAt(const std::size_t i) const {
+        return entries[i];
+    }
+
+    template<typename Fn>
+    void forEachItem(Fn&& fn) const {
+        for (const auto& entry : entries) {
+            if (entry.live) {
+                fn(entry.key, entry.value);
+            }
+        }
+    }
 
     [[nodiscard]] static Value keys(const std::shared_ptr<DictValue>& self);
 
@@ -76,5 +208,14 @@ public:
 
     [[nodiscard]] Value reversed() const override;
 
+    [[nodiscard]] long gcRefCount() const override;
+
+    [[nodiscard]] std::shared_ptr<GcObject> gcSelf() override;
+
+    /// надгробия тоже перечисляются: их ключ и значение — такие же владеющие ссылки
+    void gcTraverse(const GcVisitor& visit) const override;
+
+    void gcClear() override;
+
 };
 #endif //CPPYTHON_DICTVALUE_H
\ No newline at end of file
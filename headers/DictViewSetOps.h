@@ -0,0 +1,36 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_DICTVIEWSETOPS_H
+#define CPPYTHON_DICTVIEWSETOPS_H
+#include <optional>
+
+#include "Value.h"
+
+/**
+ * @brief Операции множеств над `dict.keys()` и `dict.items()`.
+ *
+ * @details
+ * Представление отвечает на `in` поиском по хеш-таблице своего DictValue, а
+ * set и frozenset — по своей таблице, поэтому операнды не копируются во
+ * временное множество; копируется только операнд произвольного типа (список,
+ * генератор). `&` и isdisjoint() обходят меньший операнд и проверяют элементы
+ * в большем. Результат операций — новый set, как в CPython.
+ */
+namespace dictviews {
+
+    /// dict_keys или dict_items
+    [[nodiscard]] bool isSetLike(const Value& value);
+
+    /**
+     * @brief `l op r` для op из `&`, `|`, `-`, `^`.
+     * @return nullopt, если ни один операнд не представление keys или items.
+     */
+    [[nodiscard]] std::optional<Value> binary(const Value& l, const Value& r, const char* symbol);
+
+    /// view.isdisjoint(other)
+    [[nodiscard]] bool isDisjoint(const Value& view, const Value& other);
+}
+
+#endif //CPPYTHON_DICTVIEWSETOPS_H
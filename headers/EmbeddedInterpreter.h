@@ -0,0 +1,78 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_EMBEDDEDINTERPRETER_H
+#define CPPYTHON_EMBEDDEDINTERPRETER_H
+#include <memory>
+#include <vector>
+
+#include <QString>
+
+#include "CallRuntime.h"
+#include "ExecutionBudget.h"
+#include "InterpreterContext.h"
+#include "Value.h"
+
+struct CodeObject;
+class Environment;
+
+/**
+ * @class EmbeddedInterpreter
+ * @brief Интерпретатор внутри C++-программы (библиотека libcppython), без REPL и stdout.
+ *
+ * @details
+ * Исходник компилируется один раз (compile) и выполняется в модуле `__main__`
+ * интерпретатора (execute), после чего функции скрипта вызываются с Value-аргументами
+ * и возвращают Value — без разбора текста вывода:
+ *
+ * @code
+ * EmbeddedInterpreter python;
+ * python.execute(*python.compile("def score(x):\n    return x * 2\n"));
+ * const Value result = python.call("score", {Value(Value::SmallInt(21))});
+ * @endcode
+ *
+ * У каждого экземпляра свои встроенные классы (InterpreterContext) и глобальные
+ * имена; методы активируют его контекст сами. Таблица модулей `import` и sys.path
+ * общие для процесса, как и остальное состояние рантайма, поэтому все экземпляры
+ * выполняются в одном потоке за раз (InterpreterContext::Scope). Ошибки скрипта выбрасываются как std::runtime_error
+ * с текстом `Тип: сообщение`.
+ *
+ * setBudget ограничивает каждый execute и call по отдельности: бесконечный цикл
+ * правила заканчивается TimeoutError, а не зависшим потоком хоста.
+ */
+class EmbeddedInterpreter {
+public:
+    /// searchDir — первый каталог sys.path для `import` из скрипта
+    explicit EmbeddedInterpreter(const QString& searchDir = QString());
+    ~EmbeddedInterpreter();
+
+    EmbeddedInterpreter(const EmbeddedInterpreter&) = delete;
+    EmbeddedInterpreter& operator=(const EmbeddedInterpreter&) = delete;
+
+    /// байткод модуля; его можно выполнять многократно и в любом экземпляре
+    [[nodiscard]] std::shared_ptr<const CodeObject> compile(const QString& source) const;
+
+    /// выполняет байткод в глобальных именах `__main__`
+    void execute(const CodeObject& code);
+
+    /// вызывает глобальную функцию (или другой вызываемый объект) по имени
+    Value call(const QString& name, const std::vector<Value>& args, const Kwargs& kwargs = {});
+
+    Value call(const Value& callable, const std::vector<Value>& args, const Kwargs& kwargs = {});
+
+    /// глобальное имя `__main__`; NameError, если его нет
+    [[nodiscard]] Value get(const QString& name) const;
+
+    void set(const QString& name, Value value);
+
+    /// пределы каждого следующего execute и call; нулевые — без пределов
+    void setBudget(const ExecutionBudget::Limits& limits) { budget = limits; }
+
+private:
+    InterpreterContext context;
+    ExecutionBudget::Limits budget;
+    std::shared_ptr<Environment> globals;
+};
+
+#endif //CPPYTHON_EMBEDDEDINTERPRETER_H
@@ -0,0 +1,27 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ENUMERATEITERATOR_H
+#define CPPYTHON_ENUMERATEITERATOR_H
+#include "LookaheadIterator.h"
+
+/// enumerate(iterable, start): пары (индекс, элемент), индекс — машинное целое
+class EnumerateIterator : public LookaheadIterator {
+public:
+    EnumerateIterator(Value source, Value::SmallInt start, std::shared_ptr<Environment> env);
+
+    [[nodiscard]] QString getTypeName() const override;
+
+    [[nodiscard]] bool pairwise() const override { return true; }
+
+protected:
+    bool produce(Value& out) override;
+
+    bool producePair(Value& index, Value& item) override;
+
+private:
+    Value source;
+    Value::SmallInt index;
+};
+#endif //CPPYTHON_ENUMERATEITERATOR_H
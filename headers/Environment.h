@@ -1,9 +1,69 @@
 #ifndef ENVIRONMENT_H
 #define ENVIRONMENT_H
+#include "Cell.h"
+#include "GarbageCollector.h"
+#include "MemoryTracker.h"
+#include "RuntimeStats.h"
 #include "Value.h"
 #include <QSet>
 #include <QHash>
+#include <cstdint>
+#include <optional>
 #include <utility>
+#include <vector>
+
+/**
+ * @struct FrameLayout
+ * @brief Раскладка локальных переменных функции по слотам кадра.
+ *
+ * Строится Resolver один раз для тела функции: параметры занимают первые слоты
+ * в порядке объявления, за ними идут остальные имена, которым в теле присваивается значение.
+ *
+ * Переменные, которые читают вложенные функции, живут не в слотах, а в ячейках:
+ * первые `ownCells` создаются каждым вызовом, остальные — свободные переменные,
+ * взятые из объемлющей функции при создании замыкания.
+ */
+struct FrameLayout {
+    std::vector<QString> names;
+    QHash<QString, int> indices;
+
+    std::vector<QString> cellNames;
+    QHash<QString, int> cellIndices;
+    std::size_t ownCells = 0;
+    /// параметр, захваченный вложенной функцией: связывается по слоту и переносится в ячейку
+    std::vector<std::pair<int, int>> cellParams;
+};
+
+/**
+ * @struct LocalSlot
+ * @brief Результат разрешения имени: слот в кадре функции с раскладкой `layout`.
+ *
+ * Слот действителен только в окружении с той же раскладкой — в остальных случаях
+ * (тело класса, вызов через чужое окружение) имя ищется по строке. При `cell`
+ * индекс указывает в `Environment::cells`. `global` — имя объявлено `global` в
+ * функции: слота нет, и обращение идёт прямо в окружение модуля.
+ */
+struct LocalSlot {
+    const FrameLayout* layout = nullptr;
+    int index = -1;
+    bool cell = false;
+    bool global = false;
+};
+
+/**
+ * @struct NameCache
+ * @brief Запомненный результат поиска глобального или встроенного имени в месте обращения.
+ *
+ * Действителен, пока в глобальном окружении модуля (а для встроенного имени — и в
+ * окружении встроенных имён) не появилось и не пропало ни одно имя: версии окружений
+ * уникальны на весь запуск, поэтому совпадение версии означает и то же самое окружение.
+ */
+struct NameCache {
+    std::uint64_t globalsVersion = 0;
+    /// 0 — имя найдено среди глобальных переменных модуля
+    std::uint64_t builtinsVersion = 0;
+    Value* value = nullptr;
+};
 
 /**
  * @class Environment
@@ -12,18 +72,155 @@
  * Класс Environment служит хранилищем для переменных в заданной области видимости.
  * Он позволяет хранить и получать именованные значения, что делает его полезным для управления
  * переменными и связанными с ними данными в рамках определенного контекста.
+ *
+ * Кадр вызова функции дополнительно хранит локальные переменные в массиве `slots`
+ * по раскладке `layout`, а переменные, общие с вложенными функциями, — в `cells`.
+ * Родитель кадра — глобальное окружение модуля: замыкание держит только свои ячейки.
  */
-class Environment : public std::enable_shared_from_this<Environment> {
+class Environment : public GcObject, public std::enable_shared_from_this<Environment>,
+                    public MemoryTracked<MemoryTracker::Kind::Environment> {
 public:
     QSet<QString> globalVars;
     QSet<QString> nonlocalVars;
     QHash<QString, Value> variables;
     std::shared_ptr<Environment> parent;
+    /// глобальное окружение модуля: `global` в его функциях пишет сюда, а не во встроенные имена
+    bool moduleScope = false;
+    /// меняется при добавлении и удалении имён в `variables`, но не при перезаписи значения
+    std::uint64_t keysVersion = nextVersion();
 
-    void set(const QString& name, const Value& value);
+    std::shared_ptr<const FrameLayout> layout;
+    std::vector<std::optional<Value>> slots;
+    std::vector<std::shared_ptr<Cell>> cells;
+    /// `__class__` кадра функции, определённой в теле класса: с него super() без аргументов начинает поиск
+    std::shared_ptr<ClassValue> ownerClass;
+
+    /// значение принимается по значению: временные и снятые со стека значения не копируются
+    void set(const QString& name, Value value);
     Value& get(const QString& name);
 
+    /// добавляет готовые имена; в пустое окружение таблица копируется целиком, с общими данными до записи
+    void setAll(const QHash<QString, Value>& values);
+
+    /**
+     * @brief Как get, но глобальное или встроенное имя берётся из кэша места обращения.
+     *
+     * Кадры функций и тела классов по пути к окружению модуля по-прежнему проверяются по имени.
+     * @throws std::runtime_error NameError, если имя не найдено.
+     */
+    Value& lookup(const QString& name, NameCache& cache);
+
+    /// значение слота или nullptr, если слот не принадлежит этому кадру или ещё не связан
+    Value* slot(const LocalSlot& local) {
+
+        if (!local.layout || local.layout != layout.get()) {
+            return nullptr;
+        }
+
+        auto& value = local.cell ? cellValue(local.index) : slots[local.index];
+        return value ? &*value : nullptr;
+    }
+
+    /**
+     * @brief Запись в слот; false — слот не принадлежит этому кадру, нужна запись по имени.
+     *
+     * Переданное rvalue забирается только при успешной записи, так что при false
+     * значение остаётся у вызывающего для записи по имени.
+     */
+    template<typename V>
+    bool setSlot(const LocalSlot& local, V&& value) {
+
+        if (!local.layout || local.layout != layout.get()) {
+            return false;
+        }
+
+        // `global` и `nonlocal` исключают имя из раскладки ещё при разрешении, поэтому
+        // слот и ячейка никогда не принадлежат таким именам — проверять их здесь не нужно
+        if (local.cell) {
+            cellValue(local.index) = std::forward<V>(value);
+            return true;
+        }
+
+        slots[local.index] = std::forward<V>(value);
+        return true;
+    }
+
+    /// переменная этого окружения (без обхода родителей) или nullptr
+    Value* findLocal(const QString& name);
+
+    /// переменная этого окружения или одного из родителей; промах — nullptr без исключения
+    Value* find(const QString& name);
+
+    /// глобальное окружение модуля, к которому относится это окружение
+    [[nodiscard]] std::shared_ptr<Environment> moduleGlobals();
+
+    /// запись имени, объявленного `global`, прямо в окружение модуля — без проверок set()
+    void setGlobal(const QString& name, Value value);
+
+    /**
+     * @brief Ячейки свободных переменных `layout` для замыкания, создаваемого в этом окружении.
+     *
+     * Ячейка ищется по имени в кадрах от этого окружения до окружения модуля — один раз
+     * при создании функции, а не при каждом обращении к переменной.
+     */
+    [[nodiscard]] std::vector<std::shared_ptr<Cell>> captureCells(const FrameLayout& layout);
+
+    /// свободные переменные кадра — ячейки, захваченные замыканием
+    void bindFreeCells(const std::vector<std::shared_ptr<Cell>>& free);
+
+    /// обходит все связанные переменные этого окружения
+    template<typename F>
+    void forEachLocal(F&& visit) const {
+
+        for (auto it = variables.cbegin(); it != variables.cend(); ++it) {
+            visit(it.key(), it.value());
+        }
+
+        for (std::size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i]) {
+                visit(layout->names[i], *slots[i]);
+            }
+        }
+
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            if (cells[i] && cells[i]->value) {
+                visit(layout->cellNames[i], *cells[i]->value);
+            }
+        }
+    }
+
+    [[nodiscard]] long gcRefCount() const override;
+    [[nodiscard]] std::shared_ptr<GcObject> gcSelf() override;
+    void gcTraverse(const GcVisitor& visit) const override;
+    void gcClear() override;
+
     explicit Environment(std::shared_ptr<Environment> parent = nullptr)
-       : parent(std::move(std::move(parent))) {}
+       : parent(std::move(std::move(parent))) {
+        RuntimeStats::add(RuntimeStats::Environments);
+    }
+
+    /// кадр функции: пустые слоты и свежие ячейки для переменных, захватываемых вложенными функциями
+    Environment(std::shared_ptr<Environment> parent, std::shared_ptr<const FrameLayout> layout);
+
+private:
+    static std::uint64_t nextVersion() {
+        static std::uint64_t counter = 0;
+        return ++counter;
+    }
+
+    /// запись в `variables` со сменой версии, если имя новое
+    void store(const QString& name, Value value);
+
+    /// значение ячейки; ячейка, отпущенная сборщиком, создаётся заново пустой
+    std::optional<Value>& cellValue(const int index) {
+
+        auto& cell = cells[index];
+
+        if (!cell) {
+            cell = std::make_shared<Cell>();
+        }
+
+        return cell->value;
+    }
 };
 #endif //ENVIRONMENT_H
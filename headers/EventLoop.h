@@ -0,0 +1,120 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_EVENTLOOP_H
+#define CPPYTHON_EVENTLOOP_H
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "Value.h"
+
+class FutureValue;
+class TaskValue;
+
+/**
+ * @class EventLoop
+ * @brief Однопоточный цикл событий `asyncio`: очередь готовых шагов, таймеры и готовность дескрипторов.
+ *
+ * @details
+ * Каждый проход выполняет шаги, готовые к его началу, затем ждёт ближайшего
+ * события: истечения таймера или готовности дескриптора к чтению или записи.
+ * Ожидание дескрипторов — epoll в Linux, WSAPoll в Windows (только сокеты) и poll(2)
+ * в остальных системах; одна подписка срабатывает один раз, как add_reader
+ * с немедленным remove_reader.
+ *
+ * Пока выполняется runUntilComplete(), цикл доступен через current() тому,
+ * кто создаёт Future и задачи: `asyncio.sleep`, `create_task`, потокам сокетов.
+ */
+class EventLoop {
+public:
+    using Callback = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /// выполняемый в этом потоке цикл или nullptr
+    [[nodiscard]] static EventLoop* current();
+
+    /// @throws std::runtime_error RuntimeError, если цикл не выполняется
+    [[nodiscard]] static EventLoop& running();
+
+    void callSoon(Callback callback);
+
+    /// callback через delay секунд; отрицательная задержка — как нулевая
+    void callLater(double delay, Callback callback);
+
+    /// callback один раз, когда fd готов к чтению (write == false) или записи
+    void watch(int fd, bool write, Callback callback);
+
+    /// снимает подписки fd, не запуская их: дескриптор закрывается
+    void forget(int fd);
+
+    /// Task для сопрограммы; первый шаг — в следующем проходе
+    std::shared_ptr<TaskValue> createTask(const Value& coroutine);
+
+    /**
+     * @brief Future ожидаемого значения: сама Future или задача для сопрограммы.
+     * @throws std::runtime_error TypeError для остальных значений.
+     */
+    std::shared_ptr<FutureValue> ensureFuture(const Value& awaitable);
+
+    /**
+     * @brief Выполняет цикл, пока ожидаемое не завершится, и возвращает его результат.
+     *
+     * Незавершённые к этому моменту задачи закрываются без выполнения `finally`.
+     * Если ждать больше нечего — ни шагов, ни таймеров, ни дескрипторов, — а ожидаемое
+     * не завершено, выбрасывается RuntimeError вместо вечного ожидания.
+     */
+    Value runUntilComplete(const Value& awaitable);
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        /// порядок таймеров с одним сроком — порядок callLater
+        std::uint64_t sequence;
+        Callback callback;
+
+        bool operator>(const Timer& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+        }
+    };
+
+    struct Watch {
+        Callback reader;
+        Callback writer;
+    };
+
+    std::deque<Callback> ready;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers;
+    std::uint64_t timerSequence = 0;
+    std::unordered_map<int, Watch> watches;
+    std::vector<std::weak_ptr<TaskValue>> tasks;
+
+    /// дескриптор epoll; -1 там, где используется poll(2)
+    int poller = -1;
+
+    /// один проход: ожидание событий и выполнение готовых шагов
+    void runOnce();
+
+    /// ждёт готовности дескрипторов не дольше timeout миллисекунд (-1 — без ограничения)
+    void poll(int timeout);
+
+    /// переносит сработавшие подписки fd в очередь готовых
+    void dispatch(int fd, bool readable, bool writable);
+
+    /// сообщает epoll, каких событий fd теперь ждать
+    void rearm(int fd, bool added);
+};
+
+#endif //CPPYTHON_EVENTLOOP_H
@@ -0,0 +1,101 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_EXECUTIONBUDGET_H
+#define CPPYTHON_EXECUTIONBUDGET_H
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class ExecutionBudget
+ * @brief Предел работы одного вычисления: число тиков и память новых объектов.
+ *
+ * @details
+ * Тик — обратный переход цикла (байткод, WhileNode, ForNode) или вызов функции
+ * Python. На горячем пути тик — одно уменьшение счётчика потока и переход:
+ * счётчику выдаётся ровно столько тиков, сколько осталось до предела или до
+ * следующей проверки памяти, и всё остальное делает медленный путь expire().
+ * Без пределов счётчик не истекает никогда.
+ *
+ * Память считает MemoryTracker: на время вычисления с пределом памяти он включается,
+ * если ещё не включён, и проверка сравнивает с пределом прирост суммы размеров живых
+ * объектов с начала вычисления — объекты, созданные до него, не входят. Обход
+ * n объектов делается не чаще раза на n тиков — его цена размазана по тикам.
+ *
+ * Превышение бросает TimeoutError или MemoryError. Их можно поймать `except`, но
+ * исчерпание липкое: следующий же тик бросит снова, поэтому `while True` с
+ * `except: pass` внутри не продолжит работу, а хост увидит ошибку в check().
+ */
+class ExecutionBudget {
+public:
+    /// пределы одного вычисления; 0 — без предела
+    struct Limits {
+        std::int64_t ticks = 0;
+        std::uint64_t memory = 0;
+    };
+
+    /// обратный переход цикла или вызов функции
+    static void tick() {
+        if (--countdown < 0) {
+            expire();
+        }
+    }
+
+    /// бросает ошибку превышения, если вычисление исчерпало предел (даже если скрипт её поймал)
+    static void check();
+
+    /// тиков израсходовано текущим вычислением
+    [[nodiscard]] static std::int64_t used();
+
+private:
+    enum class Reason : std::uint8_t { None, Ticks, Memory };
+
+    struct State {
+        Limits limits;
+        /// тиков до последнего выданного отрезка включительно
+        std::int64_t used = 0;
+        /// длина отрезка, выданного счётчику
+        std::int64_t granted = std::numeric_limits<std::int64_t>::max();
+        std::int64_t nextMemoryCheck = 0;
+        /// MemoryTracker::liveBytes() на входе в вычисление
+        std::uint64_t memoryBaseline = 0;
+        Reason exhausted = Reason::None;
+    };
+
+public:
+    /**
+     * @brief Пределы на время жизни объекта, с нулевым расходом.
+     *
+     * Вложенное вычисление (хост вызывает Python из функции, вызванной Python)
+     * по выходу списывает свои тики с внешнего.
+     */
+    class Scope {
+    public:
+        explicit Scope(const Limits& limits);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        State saved;
+        std::int64_t savedCountdown;
+        /// MemoryTracker включён этим вычислением
+        bool tracking = false;
+    };
+
+private:
+    /// медленный путь тика: учёт отрезка, проверки, новый отрезок
+    static void expire();
+
+    /// выдаёт счётчику тики до ближайшего предела или проверки
+    static void grant();
+
+    [[noreturn]] static void raise();
+
+    static inline thread_local std::int64_t countdown = std::numeric_limits<std::int64_t>::max();
+    static thread_local State state;
+};
+
+#endif //CPPYTHON_EXECUTIONBUDGET_H
@@ -0,0 +1,107 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_FILEVALUE_H
+#define CPPYTHON_FILEVALUE_H
+#include <memory>
+#include <optional>
+
+#include <QFile>
+#include <QStringDecoder>
+
+#include "LookaheadIterator.h"
+#include "Value.h"
+
+class ByteArrayValue;
+class StrValue;
+
+/**
+ * @class FileValue
+ * @brief Файловый объект, возвращаемый `open()`: чтение и запись блоками через QFile.
+ *
+ * @details
+ * Чтение идёт блоками по `blockSize` байт. В текстовом режиме блок декодируется из UTF-8
+ * (QStringDecoder сохраняет незаконченную последовательность до следующего блока),
+ * переводы строк `\r\n` и `\r` приводятся к `\n`, и декодированный текст становится
+ * одной строкой-владельцем: строки файла и результаты `read()` — её срезы через
+ * StrValue::substring, которые не копируют символы, если срез достаточно длинный.
+ *
+ * В двоичном режиме строки и `read()` возвращают bytes, а `readinto(bytearray)`
+ * заполняет буфер bytearray на месте: сначала из прочитанного блока, затем
+ * чтением из файла прямо в его память.
+ *
+ * Итерация по файлу отдаёт строки, как `readline()`, до первой пустой.
+ */
+class FileValue final : public LookaheadIterator {
+public:
+    static constexpr qsizetype blockSize = 64 * 1024;
+
+    /// `open(path, mode)`: режимы r, w, a, x с необязательными b/t
+    static Value open(const QString& path, const QString& mode);
+
+    FileValue(QString path, QString mode, bool binary, bool readable, bool writable);
+
+    [[nodiscard]] QString getTypeName() const override;
+
+    [[nodiscard]] QString toString() const override;
+
+    [[nodiscard]] const QString& name() const { return path; }
+    [[nodiscard]] const QString& modeString() const { return mode; }
+    [[nodiscard]] bool isClosed() const { return closed; }
+
+    /// `read(size)`: отрицательный или отсутствующий размер — до конца файла
+    Value read(std::optional<qsizetype> size);
+
+    Value readline();
+
+    Value readlines();
+
+    /// число записанных символов (текст) или байт
+    qsizetype write(const Value& data);
+
+    qsizetype readinto(ByteArrayValue& target);
+
+    void flush();
+
+    void close();
+
+protected:
+    bool produce(Value& out) override;
+
+private:
+    QFile file;
+    QString path;
+    QString mode;
+    bool binary;
+    bool readable;
+    bool writable;
+    bool closed = false;
+
+    /// двоичный режим: прочитанный блок и позиция первого непрочитанного байта
+    QByteArray raw;
+    qsizetype rawPos = 0;
+
+    /// текстовый режим: декодированный текст и позиция первого непрочитанного символа
+    QStringDecoder decoder{QStringDecoder::Utf8};
+    std::shared_ptr<const StrValue> text;
+    qsizetype textPos = 0;
+    /// блок закончился на `\r`: `\n` в начале следующего относится к тому же переводу строки
+    bool pendingCR = false;
+
+    void ensureOpen() const;
+    void ensureReadable() const;
+    void ensureWritable() const;
+
+    /// дочитывает блок в `raw`; false — конец файла
+    bool fillRaw();
+
+    /// декодирует следующий блок и добавляет его к непрочитанному тексту; false — конец файла
+    bool fillText();
+
+    [[nodiscard]] qsizetype textAvailable() const;
+
+    Value takeText(qsizetype length);
+    Value takeRaw(qsizetype length);
+};
+#endif //CPPYTHON_FILEVALUE_H
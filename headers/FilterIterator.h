@@ -0,0 +1,23 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_FILTERITERATOR_H
+#define CPPYTHON_FILTERITERATOR_H
+#include "LookaheadIterator.h"
+
+/// filter(func, iterable): элементы, для которых func истинна; при func = None — сами истинные
+class FilterIterator : public LookaheadIterator {
+public:
+    FilterIterator(Value predicate, Value source, std::shared_ptr<Environment> env);
+
+    [[nodiscard]] QString getTypeName() const override;
+
+protected:
+    bool produce(Value& out) override;
+
+private:
+    Value predicate;
+    Value source;
+};
+#endif //CPPYTHON_FILTERITERATOR_H
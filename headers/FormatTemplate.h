@@ -0,0 +1,105 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_FORMATTEMPLATE_H
+#define CPPYTHON_FORMATTEMPLATE_H
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QString>
+
+/**
+ * @class FormatTemplate
+ * @brief Шаблон `str.format` / `format_map`, разобранный один раз: литералы и поля подстановки.
+ *
+ * @details
+ * Разобранные шаблоны запоминаются по тексту (compile), поэтому форматирование
+ * в цикле не разбирает строку заново. У полей с частыми спецификаторами —
+ * пустым, `d` и `.Nf` — вид спецификатора определён заранее, и подстановка
+ * не перебирает ветви applyFormatSpec.
+ */
+class FormatTemplate {
+public:
+    /// `.attr` или `[key]` после имени поля
+    struct Accessor {
+        bool attribute = false;
+        QString name;
+        /// `[3]` — числовой индекс, иначе -1 и ключ-строка `name`
+        qsizetype index = -1;
+    };
+
+    enum class FastSpec : std::uint8_t {
+        None,   ///< общий путь applyFormatSpec
+        Empty,  ///< `{}`: str(value)
+        Decimal,///< `{:d}` для целого
+        Fixed   ///< `{:.Nf}` для числа
+    };
+
+    struct Segment {
+        /// текст перед полем, `{{` и `}}` уже раскрыты
+        QString literal;
+        bool field = false;
+        /// именованный аргумент; пусто — позиционный `index`
+        QString name;
+        qsizetype index = -1;
+        std::vector<Accessor> accessors;
+        /// `r`, `s`, `a` или нулевой символ
+        QChar conversion;
+        QString spec;
+        FastSpec fast = FastSpec::None;
+        int precision = 0;
+    };
+
+    /// последний сегмент может быть без поля — хвост шаблона
+    std::vector<Segment> segments;
+    qsizetype literalLength = 0;
+    qsizetype fieldCount = 0;
+
+    /// разобранный шаблон из кэша или новый; ошибки разбора — ValueError
+    static std::shared_ptr<const FormatTemplate> compile(const QString& text);
+
+    /// поле без имени с конверсией и спецификатором — так форматируются поля f-строк
+    static Segment field(QChar conversion, QString spec);
+};
+
+/**
+ * @class PercentTemplate
+ * @brief Шаблон `%`-форматирования, разобранный один раз: флаги, ширина, точность и тип каждой конверсии.
+ */
+class PercentTemplate {
+public:
+    struct Conversion {
+        /// текст перед конверсией, `%%` уже раскрыт
+        QString literal;
+        bool field = false;
+        /// ключ `%(name)s`
+        QString key;
+        bool keyed = false;
+        bool leftAlign = false;
+        bool zeroPad = false;
+        bool showSign = false;
+        bool spaceSign = false;
+        bool alternateForm = false;
+        /// ширина и точность `*` берутся из аргументов
+        bool starWidth = false;
+        bool starPrecision = false;
+        int width = 0;
+        int precision = -1;
+        /// тип конверсии одной буквой: `s`, `d`, `f`, …
+        QString type;
+        /// `%s` и `%d` без флагов, ширины и точности
+        bool plain = false;
+    };
+
+    std::vector<Conversion> segments;
+    qsizetype literalLength = 0;
+    /// аргументов, которые забирают конверсии, вместе с `*`
+    qsizetype argumentCount = 0;
+    bool keyed = false;
+
+    static std::shared_ptr<const PercentTemplate> compile(const QString& text);
+};
+
+#endif //CPPYTHON_FORMATTEMPLATE_H
@@ -16,7 +16,7 @@ public:
 
     std::shared_ptr<FrozenSetValue> frozenSet;
 
-    int index = 0;
+    std::size_t index = 0;
 
     explicit FrozenSetIterator(
         std::shared_ptr<FrozenSetValue> frozenSet
@@ -4,28 +4,23 @@
 
 #ifndef CPPYTHON_FROZENSETVALUE_H
 #define CPPYTHON_FROZENSETVALUE_H
-#include <qset.h>
+#include <optional>
 
 #include "ObjectValue.h"
+#include "OrderedValueSet.h"
 
 class FrozenSetValue : public ObjectValue, public std::enable_shared_from_this<FrozenSetValue> {
 
-    QSet<Value> elements;
-    QList<Value> order;
+    OrderedValueSet elements;
+    /// frozenset неизменяем — хеш считается один раз по хешам, сохранённым в таблице
+    mutable std::optional<std::size_t> cachedHash;
 
 public:
 
     FrozenSetValue() = default;
 
-    explicit FrozenSetValue(const QSet<Value>& elements)
-    : elements(elements),
-      order(elements.values())
-    {}
-
-
-    explicit FrozenSetValue(QSet<Value>&& elements)
-    : elements(std::move(elements)),
-      order(this->elements.values())
+    explicit FrozenSetValue(OrderedValueSet elements)
+    : elements(std::move(elements))
     {}
 
     [[nodiscard]] QString repr() const override;
@@ -36,9 +31,7 @@ public:
 
     [[nodiscard]] bool contains(const Value& value) const override;
 
-    [[nodiscard]] const QSet<Value>& getElements() const;
-
-    [[nodiscard]] const QList<Value>& getOrder() const;
+    [[nodiscard]] const OrderedValueSet& getElements() const;
 
     [[nodiscard]] Value unionSet(const std::vector<Value>& others) const;
 
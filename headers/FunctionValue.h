@@ -4,32 +4,62 @@
 
 #ifndef CPPYTHON_FUNCTIONVALUE_H
 #define CPPYTHON_FUNCTIONVALUE_H
+#include "BindingPlan.h"
+#include "Cell.h"
+#include "GarbageCollector.h"
 #include "InstanceValue.h"
 #include "Param.h"
 
 class ASTNode;
 class Environment;
+struct FrameLayout;
+struct CodeObject;
 
-class FunctionValue : public std::enable_shared_from_this<FunctionValue>, public ReprMixin {
+class FunctionValue : public std::enable_shared_from_this<FunctionValue>, public ReprMixin, public GcObject {
 public:
     FunctionValue(
         std::vector<Param> params,
         std::vector<std::shared_ptr<ASTNode>> body,
         const std::shared_ptr<Environment> &env,
-        QString name)
+        QString name,
+        std::shared_ptr<const FrameLayout> layout = nullptr,
+        std::shared_ptr<const CodeObject> code = nullptr,
+        std::shared_ptr<const BindingPlan> plan = nullptr,
+        std::vector<std::shared_ptr<Cell>> cells = {})
             : params(std::move(params)),
             body(std::move(body)),
             closure(env),
-            name(std::move(name)) {}
+            name(std::move(name)),
+            layout(std::move(layout)),
+            code(std::move(code)),
+            plan(plan ? std::move(plan) : std::make_shared<BindingPlan>(this->params)),
+            cells(std::move(cells)) {}
 
     Value get(const Value&, const std::shared_ptr<ClassValue>&);
     [[nodiscard]] QString toString() const override;
 
+    [[nodiscard]] long gcRefCount() const override;
+    [[nodiscard]] std::shared_ptr<GcObject> gcSelf() override;
+    /// окружение модуля и ячейки замыкания обычно сами ссылаются на функцию — главный источник циклов
+    void gcTraverse(const GcVisitor& visit) const override;
+    void gcClear() override;
+
     std::vector<Param> params;
     std::vector<std::shared_ptr<ASTNode>> body;
+    /// глобальное окружение модуля, в котором определена функция, — родитель кадров вызова
     std::shared_ptr<Environment> closure;
     QString name;
+    /// раскладка локальных переменных кадра, построенная Resolver
+    std::shared_ptr<const FrameLayout> layout;
+    /// байткод тела; если его нет, тело вычисляется по дереву
+    std::shared_ptr<const CodeObject> code;
+    /// связывание аргументов; общее для всех функций одного определения
+    std::shared_ptr<const BindingPlan> plan;
+    /// ячейки свободных переменных в порядке `layout->cellNames` после собственных ячеек кадра
+    std::vector<std::shared_ptr<Cell>> cells;
     std::shared_ptr<ClassValue> ownerClass;
+    /// строка `def` (или первого декоратора) — co_firstlineno для трассировки
+    int firstLine = 0;
 };
 
 #endif //CPPYTHON_FUNCTIONVALUE_H
\ No newline at end of file
@@ -0,0 +1,19 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_FUNCTOOLSMODULE_H
+#define CPPYTHON_FUNCTOOLSMODULE_H
+
+class Value;
+
+/**
+ * @class FunctoolsModule
+ * @brief Глобальный объект `functools`: декораторы `lru_cache` и `cache` (CachedFunctionValue).
+ */
+class FunctoolsModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_FUNCTOOLSMODULE_H
@@ -0,0 +1,102 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_FUTUREVALUE_H
+#define CPPYTHON_FUTUREVALUE_H
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "IteratorValue.h"
+#include "ObjectValue.h"
+
+/**
+ * @class FutureValue
+ * @brief `asyncio.Future` — результат, который появится позже.
+ *
+ * @details
+ * Future завершается один раз: результатом (setResult) или исключением
+ * (setException). Ожидающие — обычно шаги Task — подписываются addDoneCallback()
+ * и запускаются циклом событий в следующем проходе, а не внутри setResult(),
+ * поэтому цепочки ожиданий не растят стек C++.
+ *
+ * Исключение хранится как std::exception_ptr: `await` выбрасывает его снова тем же
+ * типом C++, и `except` в сопрограмме видит то же, что видел бы синхронный вызов.
+ */
+class FutureValue : public ObjectValue {
+public:
+    using Callback = std::function<void()>;
+
+    /// Future или Task в значении или nullptr
+    [[nodiscard]] static FutureValue* of(const Value& value);
+
+    [[nodiscard]] static std::shared_ptr<FutureValue> create();
+
+    [[nodiscard]] bool done() const { return finished; }
+
+    /// завершает Future; повторное завершение — RuntimeError (InvalidStateError в CPython)
+    void setResult(Value value);
+    void setException(std::exception_ptr exception);
+
+    /**
+     * @brief Результат завершённой Future.
+     * @throws исключение, которым Future завершилась; RuntimeError, если она не завершена.
+     */
+    [[nodiscard]] Value result() const;
+
+    /// объект исключения завершённой Future или None
+    [[nodiscard]] Value exception() const;
+
+    /// callback будет запущен циклом событий после завершения (сразу в очередь, если уже завершена)
+    void addDoneCallback(Callback callback);
+
+    /// имя класса для type() и repr: Future или Task
+    [[nodiscard]] virtual QString className() const { return "Future"; }
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+protected:
+    /// отменяет ожидание без запуска подписчиков: цикл событий закрывается
+    void dropCallbacks() { callbacks.clear(); }
+
+private:
+    bool finished = false;
+    Value value;
+    std::exception_ptr error;
+    std::vector<Callback> callbacks;
+
+    void finish();
+};
+
+/**
+ * @class FutureAwaiter
+ * @brief Итератор ожидания `await future`.
+ *
+ * Пока Future не завершена, отдаёт её саму — через цепочку `await` она доходит до Task,
+ * которая подписывается на завершение. Когда Future завершена, ожидание заканчивается
+ * её результатом (или исключением).
+ */
+class FutureAwaiter final : public IteratorValue {
+public:
+    explicit FutureAwaiter(Value future);
+
+    /**
+     * @brief Шаг ожидания для инструкции Send.
+     * @return true — Future не завершена, в out она сама; false — в out результат.
+     */
+    bool resume(Value& out) const;
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    [[nodiscard]] QString getTypeName() const override { return "FutureIter"; }
+
+private:
+    Value future;
+};
+
+#endif //CPPYTHON_FUTUREVALUE_H
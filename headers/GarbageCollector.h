@@ -0,0 +1,111 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_GARBAGECOLLECTOR_H
+#define CPPYTHON_GARBAGECOLLECTOR_H
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+class Value;
+class GcObject;
+
+/// получает каждый отслеживаемый объект, которым владеет обходимый объект
+using GcVisitor = std::function<void(const GcObject*)>;
+
+/**
+ * @class GcObject
+ * @brief Объект-контейнер, через который может замкнуться цикл ссылок.
+ *
+ * @details
+ * Объект встаёт на учёт сборщика при создании и снимается с него в деструкторе.
+ * Наследник сообщает число владеющих им shared_ptr, перечисляет отслеживаемые
+ * объекты, которыми владеет сам, и отпускает их, когда сборщик признал его мусором.
+ * Перечислять можно только владеющие ссылки: лишняя ссылка в обходе выдаст живой
+ * объект за мусор, пропущенная — лишь оставит цикл несобранным.
+ */
+class GcObject {
+public:
+    GcObject();
+    GcObject(const GcObject&);
+    GcObject& operator=(const GcObject&) { return *this; }
+    virtual ~GcObject();
+
+    /// число владеющих shared_ptr; 0 — объект не под управлением shared_ptr
+    [[nodiscard]] virtual long gcRefCount() const = 0;
+
+    /// сильная ссылка на себя: удерживает объект, пока сборщик разрывает цикл
+    [[nodiscard]] virtual std::shared_ptr<GcObject> gcSelf() = 0;
+
+    virtual void gcTraverse(const GcVisitor& visit) const = 0;
+
+    /// отпускает ссылки на другие объекты; вызывается только для мусора
+    virtual void gcClear() = 0;
+
+private:
+    friend class GarbageCollector;
+
+    GcObject* gcPrev = nullptr;
+    GcObject* gcNext = nullptr;
+    int gcGeneration = 0;
+};
+
+/// передаёт visit объект, которым владеет значение, если этот объект отслеживается
+void gcVisitValue(const Value& value, const GcVisitor& visit);
+
+/**
+ * @class GarbageCollector
+ * @brief Поколенческий сборщик циклов между объектами под shared_ptr.
+ *
+ * @details
+ * shared_ptr не освобождает циклы: функция и окружение её замыкания, экземпляр
+ * и класс, список, содержащий сам себя. Сборщик работает как gc в CPython: из числа
+ * владельцев каждого объекта собираемых поколений вычитаются ссылки из этих же
+ * поколений. Объекты, у которых остались внешние владельцы, и всё достижимое из них
+ * живы; у остальных очищается содержимое, что разрывает циклы и освобождает их.
+ *
+ * Новые объекты попадают в поколение 0, пережившие сборку переходят в следующее.
+ * Поколение 0 собирается, когда созданных объектов становится больше первого порога;
+ * старшее поколение — когда число сборок младшего превышает его порог. Автоматическая
+ * сборка идёт только в безопасных точках (collectIfNeeded): в начале вызова функции
+ * и на обратном переходе цикла, где объекты удерживаются через shared_ptr.
+ */
+class GarbageCollector {
+public:
+    static constexpr int generations = 3;
+
+    static inline bool enabled = true;
+    static inline std::array<long, generations> thresholds = {700, 10, 10};
+    /// для поколения 0 — созданные объекты, для старших — сборки предыдущего поколения
+    static inline std::array<long, generations> counts = {0, 0, 0};
+
+    /// собирает поколения с 0 по `generation`; возвращает число освобождённых объектов
+    static std::size_t collect(int generation = generations - 1);
+
+    /// безопасная точка: сборка, если превышен порог поколения 0
+    static void collectIfNeeded() {
+        if (enabled && thresholds[0] > 0 && counts[0] > thresholds[0]) {
+            collectGenerations();
+        }
+    }
+
+    /// объект `gc` со встроенными функциями collect, enable, get_threshold и т.д.
+    static Value makeModule();
+
+private:
+    friend class GcObject;
+
+    static inline std::array<GcObject*, generations> heads = {};
+    static inline bool collecting = false;
+
+    static void track(GcObject* object);
+    static void untrack(GcObject* object);
+    static void link(GcObject* object, int generation);
+    static void unlink(GcObject* object);
+
+    /// собирает старшее из поколений, чей порог превышен
+    static void collectGenerations();
+};
+#endif //CPPYTHON_GARBAGECOLLECTOR_H
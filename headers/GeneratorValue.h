@@ -0,0 +1,75 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_GENERATORVALUE_H
+#define CPPYTHON_GENERATORVALUE_H
+#include <memory>
+#include <optional>
+
+#include "IteratorValue.h"
+#include "Value.h"
+#include "VirtualMachine.h"
+
+class Environment;
+struct CodeObject;
+
+/**
+ * @class GeneratorValue
+ * @brief Генератор: приостановленный кадр функции, в теле которой есть `yield`.
+ *
+ * @details
+ * Вызов такой функции связывает аргументы и возвращает генератор, не выполняя тело.
+ * Каждый `next()` продолжает байткод с места последней приостановки до следующего
+ * YieldValue; локальные переменные остаются в слотах окружения вызова, а стек
+ * значений и блоки циклов — в собственном кадре. Поэтому for, list(), sum() и другие
+ * потребители получают элементы по одному, и конвейер генераторов работает
+ * в постоянной памяти.
+ *
+ * Как у LookaheadIterator, `hasNext()` возобновляет кадр заранее и держит
+ * выданное значение до `next()`.
+ *
+ * Тот же кадр исполняет тело `async def` — см. CoroutineValue.
+ */
+class GeneratorValue : public IteratorValue {
+public:
+    GeneratorValue(std::shared_ptr<const CodeObject> code, std::shared_ptr<Environment> env, QString name);
+
+    /**
+     * @brief Продолжает кадр до следующего yield.
+     * @param sent Значение выражения `yield`, на котором кадр остановился.
+     * @param out Выданное значение.
+     * @return false, если генератор завершился; тогда результат return — в returnValue().
+     */
+    bool resume(const Value& sent, Value& out);
+
+    /// generator.send(value); по завершении — StopIterationException
+    Value send(const Value& value);
+
+    /// generator.close(): кадр освобождается, дальше генератор пуст
+    void close();
+
+    /// значение return завершившегося генератора — результат `yield from`
+    [[nodiscard]] const Value& returnValue() const { return result; }
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    [[nodiscard]] QString getTypeName() const override;
+
+    [[nodiscard]] QString toString() const override;
+
+private:
+    std::shared_ptr<const CodeObject> code;
+    std::shared_ptr<Environment> env;
+    QString name;
+    /// пуст после завершения: стек и блоки сразу возвращаются в пул
+    std::optional<Frame> frame;
+    /// значение, полученное hasNext() заранее
+    mutable std::optional<Value> pending;
+    Value result;
+    bool started = false;
+    bool running = false;
+};
+#endif //CPPYTHON_GENERATORVALUE_H
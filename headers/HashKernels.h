@@ -0,0 +1,29 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_HASHKERNELS_H
+#define CPPYTHON_HASHKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Хеш строк и байтов для hash(str) и hash(bytes) — wyhash.
+ *
+ * Длинный вход читается блоками по 48 байт тремя независимыми цепочками
+ * умножений 64×64→128, которые процессор выполняет параллельно; короткий
+ * (до 16 байт, типичный ключ словаря) — двумя-тремя невыровненными чтениями
+ * без цикла. Зерно случайно на процесс, как в CPython, и задаётся
+ * переменной окружения PYTHONHASHSEED для воспроизводимых запусков.
+ */
+namespace hashkernels {
+
+    /// хеш size байтов по адресу data; никогда не равен -1 — он занят под ошибку, как в CPython
+    std::size_t hashBytes(const void* data, std::size_t size);
+
+    /// зерно процесса: PYTHONHASHSEED (0 — без рандомизации) или случайное
+    std::uint64_t seed();
+}
+
+#endif //CPPYTHON_HASHKERNELS_H
@@ -0,0 +1,84 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_INLINECACHE_H
+#define CPPYTHON_INLINECACHE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "CallRuntime.h"
+#include "Value.h"
+
+class ClassValue;
+class InstanceValue;
+class Shape;
+
+/**
+ * @struct InlineCacheEntry
+ * @brief Запомненный результат поиска атрибута для экземпляров одного класса.
+ *
+ * Запись действительна, пока `version` совпадает с `ClassValue::attributesVersion`:
+ * любая запись атрибута класса сбрасывает все записи разом.
+ */
+struct InlineCacheEntry {
+    /// где найден атрибут и как его отдавать
+    enum class Kind : std::uint8_t {
+        Generic,            ///< класс переопределяет __getattribute__ — только общий путь
+        Missing,            ///< в классе атрибута нет: поле экземпляра или общий путь
+        Plain,              ///< атрибут класса без дескриптора
+        Method,             ///< функция класса: связывается с экземпляром
+        Descriptor,         ///< дескриптор без __set__ — поле экземпляра важнее
+        DataDescriptor      ///< дескриптор данных — важнее поля экземпляра
+    };
+
+    std::shared_ptr<ClassValue> klass;
+    std::uint64_t version = 0;
+    Kind kind = Kind::Generic;
+    Value classAttr;
+
+    /// последняя встреченная форма экземпляра и смещение поля в ней (-1 — поля нет)
+    const Shape* shape = nullptr;
+    int offset = -1;
+};
+
+/**
+ * @class InlineCache
+ * @brief Полиморфный кэш места обращения `obj.attr` (узел AST или инструкция байткода).
+ *
+ * @details
+ * Хранит до `capacity` записей — по одной на класс получателя, встреченный в этом месте.
+ * Попадание избавляет от `getAttrValue`/`genericGetAttr`, а если и форма экземпляра
+ * совпала с запомненной, поле читается по смещению без поиска по имени. Получатели, не являющиеся экземплярами пользовательских
+ * классов, идут общим путём.
+ */
+class InlineCache {
+public:
+    static constexpr std::size_t capacity = 4;
+
+    /// `obj.attr` с учётом порядка дескриптор данных → поле → атрибут класса
+    Value getAttr(const Value& obj, const QString& attr);
+
+    /// `obj.attr(args)`: метод класса вызывается без создания связанного метода
+    Value callMethod(const Value& obj,
+                     const QString& attr,
+                     const std::vector<Value>& args,
+                     const Kwargs& kwargs,
+                     const std::shared_ptr<Environment>& env);
+
+    /// функция класса, которую callMethod вызвал бы для экземпляра obj напрямую, и её класс; иначе nullptr
+    Value::FunctionPtr findMethod(const Value& obj, const QString& attr, std::shared_ptr<ClassValue>& owner);
+
+private:
+    std::array<InlineCacheEntry, capacity> entries;
+    std::size_t next = 0;
+
+    InlineCacheEntry& lookup(const std::shared_ptr<ClassValue>& cls, const QString& attr);
+
+    static const Value* findField(InlineCacheEntry& entry, const InstanceValue& instance, const QString& attr);
+};
+
+#endif //CPPYTHON_INLINECACHE_H
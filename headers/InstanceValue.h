@@ -4,16 +4,59 @@
 
 #ifndef CPPYTHON_INSTANCEVALUE_H
 #define CPPYTHON_INSTANCEVALUE_H
+#include <vector>
+
 #include "ClassValue.h"
+#include "MemoryTracker.h"
+#include "Shape.h"
 
-class InstanceValue : public ReprMixin {
+class InstanceValue : public ReprMixin, public GcObject, public std::enable_shared_from_this<InstanceValue>,
+                      public MemoryTracked<MemoryTracker::Kind::Instance> {
 public:
     std::shared_ptr<ClassValue> klass;
-    QMap<QString, Value> fields;
+    /// форма экземпляра: имена полей и их смещения в `slots`
+    std::shared_ptr<const Shape> shape;
+    std::vector<Value> slots;
+    /// поля сверх Shape::maxFields; у экземпляров классов с __slots__ не используется
+    QHash<QString, Value> overflow;
 
     explicit InstanceValue(std::shared_ptr<ClassValue> cls)
-    : klass(std::move(cls)) {}
+    : klass(std::move(cls)), shape(klass->instanceShape) {
+
+        // экземпляр класса с __slots__ сразу получает массив под все слоты, прочие — под поля прошлого экземпляра
+        if (klass->slotNames) {
+            slots.reserve(klass->slotNames->size());
+        } else if (klass->construction.fieldHint) {
+            slots.reserve(klass->construction.fieldHint);
+        }
+    }
+
+    /// поле экземпляра или nullptr, если его нет
+    [[nodiscard]] const Value* findField(const QString& name) const {
+
+        if (const int offset = shape->offsetOf(name); offset >= 0) {
+            return &slots[offset];
+        }
+
+        if (const auto it = overflow.constFind(name); it != overflow.cend()) {
+            return &it.value();
+        }
 
+        return nullptr;
+    }
+
+    void setField(const QString& name, const Value& value);
+
+    /// у исключения — текст `str(e)`
     [[nodiscard]] QString toString() const override;
+
+    /// у исключения — `ValueError('text')`, у прочих экземпляров совпадает с toString()
+    [[nodiscard]] QString repr() const override;
+
+    [[nodiscard]] long gcRefCount() const override;
+    [[nodiscard]] std::shared_ptr<GcObject> gcSelf() override;
+    void gcTraverse(const GcVisitor& visit) const override;
+    /// класс остаётся: его имя нужно toString(), а цикл через класс разорвёт сборка самого класса
+    void gcClear() override;
 };
-#endif //CPPYTHON_INSTANCEVALUE_H
\ No newline at end of file
+#endif //CPPYTHON_INSTANCEVALUE_H
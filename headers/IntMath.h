@@ -0,0 +1,47 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_INTMATH_H
+#define CPPYTHON_INTMATH_H
+#include <utility>
+
+#include "Value.h"
+
+/**
+ * @class IntMath
+ * @brief Целочисленные алгоритмы встроенных функций: `**`, `pow(b, e, m)`, `divmod`,
+ * `round` и методы `int.bit_length()` / `int.bit_count()`.
+ *
+ * @details
+ * Каждая операция сначала пробует машинные целые (SmallInt) и переходит на BigInt
+ * только при переполнении. Степень считается возведением в квадрат, а по модулю —
+ * через `powm` бэкенда (mpz_powm у GMP), не строя промежуточную длинную степень.
+ * Все аргументы — целые или bool; проверка типов остаётся у вызывающего.
+ */
+class IntMath {
+public:
+    [[nodiscard]] static bool isInt(const Value& value) {
+        return value.isSmallInt() || value.isBigInt() || value.isBool();
+    }
+
+    /// base ** exp при exp >= 0
+    [[nodiscard]] static Value power(const Value& base, const Value& exp);
+
+    /// pow(base, exp, mod): знак результата — знак mod, отрицательная степень — через обратный элемент
+    [[nodiscard]] static Value powerMod(const Value& base, const Value& exp, const Value& mod);
+
+    /// частное с округлением вниз и остаток со знаком делителя, одним делением
+    [[nodiscard]] static std::pair<Value, Value> divMod(const Value& left, const Value& right);
+
+    /// round(value, ndigits) для целого: при ndigits < 0 — до 10^-ndigits, половина к чётному
+    [[nodiscard]] static Value round(const Value& value, const Value& ndigits);
+
+    /// число значащих бит модуля
+    [[nodiscard]] static Value::SmallInt bitLength(const Value& value);
+
+    /// число единичных бит модуля
+    [[nodiscard]] static Value::SmallInt bitCount(const Value& value);
+};
+
+#endif //CPPYTHON_INTMATH_H
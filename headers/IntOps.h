@@ -0,0 +1,129 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_INTOPS_H
+#define CPPYTHON_INTOPS_H
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * Машинная целочисленная арифметика с проверкой переполнения и битовые операции
+ * над 64-битными словами — одинаково для GCC, Clang и MSVC.
+ *
+ * Проверки возвращают true при переполнении и пишут в out младшие 64 бита
+ * результата, как __builtin_*_overflow. Там, где есть 128-битное целое
+ * (__SIZEOF_INT128__), умножения идут через него, иначе — через половины слов.
+ */
+namespace intops {
+
+    inline bool addOverflow(const std::int64_t a, const std::int64_t b, std::int64_t& out) {
+        out = static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+        // знак суммы отличается от знаков обоих слагаемых
+        return ((a ^ out) & (b ^ out)) < 0;
+    }
+
+    inline bool subOverflow(const std::int64_t a, const std::int64_t b, std::int64_t& out) {
+        out = static_cast<std::int64_t>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b));
+        // знаки операндов разные, и знак разности не совпал со знаком уменьшаемого
+        return ((a ^ b) & (a ^ out)) < 0;
+    }
+
+    inline bool mulOverflow(const std::int64_t a, const std::int64_t b, std::int64_t& out) {
+#ifdef __SIZEOF_INT128__
+        const __int128 product = static_cast<__int128>(a) * b;
+        out = static_cast<std::int64_t>(product);
+        return product != out;
+#else
+        out = static_cast<std::int64_t>(static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b));
+
+        if (a == 0 || b == 0) {
+            return false;
+        }
+
+        // INT64_MIN / -1 не представимо: этот случай — переполнение и без деления
+        if ((a == -1 && b == INT64_MIN) || (b == -1 && a == INT64_MIN)) {
+            return true;
+        }
+
+        return out / b != a;
+#endif
+    }
+
+    /// полное произведение a·b: младшие 64 бита — результат, старшие — в high
+    inline std::uint64_t multiplyFull(const std::uint64_t a, const std::uint64_t b, std::uint64_t& high) {
+#ifdef __SIZEOF_INT128__
+        const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        high = static_cast<std::uint64_t>(product >> 64);
+        return static_cast<std::uint64_t>(product);
+#else
+        const std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+        const std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+        const std::uint64_t middle0 = aHigh * bLow, middle1 = aLow * bHigh, low = aLow * bLow;
+        const std::uint64_t middle = (low >> 32) + static_cast<std::uint32_t>(middle0) + static_cast<std::uint32_t>(middle1);
+        high = aHigh * bHigh + (middle0 >> 32) + (middle1 >> 32) + (middle >> 32);
+        return (middle << 32) | static_cast<std::uint32_t>(low);
+#endif
+    }
+
+    /// a·b mod modulus для a, b < modulus без переполнения
+    inline std::uint64_t mulMod(const std::uint64_t a, const std::uint64_t b, const std::uint64_t modulus) {
+#ifdef __SIZEOF_INT128__
+        return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % modulus);
+#else
+        // удвоение и сложение по модулю: ни одна сумма не выходит за 64 бита
+        const auto addMod = [modulus](const std::uint64_t x, const std::uint64_t y) {
+            return x >= modulus - y ? x - (modulus - y) : x + y;
+        };
+
+        std::uint64_t result = 0;
+        std::uint64_t addend = a;
+
+        for (std::uint64_t rest = b; rest != 0; rest >>= 1) {
+
+            if (rest & 1) {
+                result = addMod(result, addend);
+            }
+
+            addend = addMod(addend, addend);
+        }
+
+        return result;
+#endif
+    }
+
+    /// число ведущих нулевых битов; word != 0
+    inline int countLeadingZeros(const std::uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanReverse64(&index, word);
+        return 63 - static_cast<int>(index);
+#else
+        return __builtin_clzll(word);
+#endif
+    }
+
+    /// число младших нулевых битов; word != 0
+    inline int countTrailingZeros(const std::uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    inline int popCount(const std::uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return static_cast<int>(__popcnt64(word));
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+}
+
+#endif //CPPYTHON_INTOPS_H
@@ -16,7 +16,30 @@ class ASTNode;
  */
 class Interpreter {
     public:
-        static void run(int argc, char *argv[]);
+        static int run(int argc, char *argv[]);
+
+        /**
+         * @brief Выполняет исходный файл целиком, без приглашений REPL и вывода результатов выражений
+         * @param path Путь к файлу
+         * @return Код завершения процесса
+         */
+        static int runFile(const QString& path);
+
+        /**
+         * @brief Рабочий процесс parallel_map (опция `--worker=функция`)
+         * @param path Файл модуля функции
+         * @param function Имя функции
+         * @param input Файл с элементами
+         * @param output Файл для результатов
+         * @return Код завершения процесса
+         */
+        static int runWorker(const QString& path, const QString& function, const QString& input, const QString& output);
+
+        /**
+         * @brief Создаёт окружение встроенных функций и классов в активном InterpreterContext
+         * @return Родитель глобальных окружений всех модулей
+         */
+        static std::shared_ptr<Environment> createGlobals();
 
         static Value executeNode(
             const std::shared_ptr<ASTNode>& node,
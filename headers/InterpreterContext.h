@@ -0,0 +1,76 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_INTERPRETERCONTEXT_H
+#define CPPYTHON_INTERPRETERCONTEXT_H
+#include <memory>
+
+#include <QHash>
+#include <QString>
+
+class ClassValue;
+
+/**
+ * @class InterpreterContext
+ * @brief Встроенные классы одного интерпретатора: object, str, bytes, bytearray и исключения.
+ *
+ * @details
+ * Каждый интерпретатор создаёт свой контекст и делает его активным (Scope):
+ * Interpreter::createGlobals заполняет активный контекст, а код, которому нужен
+ * встроенный класс, берёт его через current(). Активный контекст — thread_local
+ * указатель: обращение стоит одной загрузки.
+ *
+ * Контекст разделяет только встроенные классы. Пулы объектов (ObjectPool),
+ * списки и пороги сборщика мусора, таблица атомов строк, свободные списки
+ * кортежей, RuntimeStats и MemoryTracker общие для процесса и работают без
+ * блокировок, поэтому интерпретаторы выполняются только в одном потоке за раз.
+ * Scope следит за этим: пока в одном потоке активен хоть один контекст, Scope
+ * в другом потоке выбрасывает RuntimeError. Передать интерпретатор другому
+ * потоку можно, когда первый вышел из всех своих Scope.
+ *
+ * reset() отпускает все классы: между заданиями долгоживущего процесса
+ * контекст очищается без перезапуска, циклы классов и их методов собирает gc.
+ */
+class InterpreterContext {
+public:
+    std::shared_ptr<ClassValue> objectClass;
+
+    std::shared_ptr<ClassValue> strClass;
+
+    std::shared_ptr<ClassValue> bytesClass;
+
+    std::shared_ptr<ClassValue> bytearrayClass;
+
+    std::shared_ptr<ClassValue> baseExceptionClass;
+
+    /// встроенные классы исключений по имени (PyException::registerClasses)
+    QHash<QString, std::shared_ptr<ClassValue>> exceptionClasses;
+
+    /// контекст, активный в этом потоке; без Scope — контекст потока по умолчанию
+    static InterpreterContext& current();
+
+    /// отпускает все классы контекста
+    void reset();
+
+    /**
+     * @class Scope
+     * @brief Делает контекст активным в этом потоке до конца области видимости.
+     *
+     * Области вкладываются: при выходе снова активен предыдущий контекст.
+     * @throws std::runtime_error RuntimeError, если интерпретатор уже выполняется в другом потоке.
+     */
+    class Scope {
+    public:
+        explicit Scope(InterpreterContext& context);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        InterpreterContext* previous;
+    };
+};
+
+#endif //CPPYTHON_INTERPRETERCONTEXT_H
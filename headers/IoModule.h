@@ -0,0 +1,24 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_IOMODULE_H
+#define CPPYTHON_IOMODULE_H
+
+class Value;
+
+/**
+ * @class IoModule
+ * @brief Глобальный объект `io`: потоки в памяти StringIO и BytesIO, open и UnsupportedOperation.
+ *
+ * @details
+ * StringIO и BytesIO накапливают вывод в одном растущем буфере — замена
+ * квадратичной склейки `s += part` в цикле. Параметр newline у StringIO
+ * не поддерживается: текст хранится как записан.
+ */
+class IoModule {
+public:
+    static Value makeModule(const Value& open);
+};
+
+#endif //CPPYTHON_IOMODULE_H
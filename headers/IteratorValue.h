@@ -18,6 +18,17 @@ public:
 
     [[nodiscard]] virtual QString getTypeName() const = 0;
 
+    /// элементы — пары, которые nextPair() отдаёт без промежуточного кортежа
+    [[nodiscard]] virtual bool pairwise() const { return false; }
+
+    /**
+     * @brief Следующая пара для цикла `for a, b in ...`; false — итератор исчерпан.
+     *
+     * Вызывается, только если pairwise() истинно: пара берётся прямо из записи
+     * словаря или источников enumerate/zip, и TupleValue не создаётся.
+     */
+    virtual bool nextPair(Value&, Value&) { return false; }
+
     [[nodiscard]] QString toString() const override {
 
         QString addr = QString("0x%1")
@@ -0,0 +1,54 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_JSONCODEC_H
+#define CPPYTHON_JSONCODEC_H
+#include <optional>
+
+#include <QString>
+#include <QStringView>
+
+#include "CallRuntime.h"
+
+/**
+ * Разбор и запись JSON прямо в значения интерпретатора и из них.
+ *
+ * Разбор — один проход рекурсивным спуском по тексту строки без копирования:
+ * объект сразу становится DictValue, массив — ListValue, число — int или float,
+ * строка без escape-последовательностей копируется из исходного текста одним куском.
+ * Одинаковые ключи объектов внутри документа разделяют один StrValue, а ключи,
+ * похожие на идентификатор, берутся из StringTable и совпадают между вызовами.
+ *
+ * Запись обходит Value и дописывает текст в один буфер QString; строки
+ * копируются кусками между символами, которые нужно экранировать.
+ */
+namespace jsoncodec {
+
+    /// параметры json.dumps
+    struct DumpOptions {
+        /// отступ уровня; пустой optional — запись в одну строку
+        std::optional<QString> indent;
+        QString itemSeparator = ", ";
+        QString keySeparator = ": ";
+        bool sortKeys = false;
+        bool ensureAscii = true;
+        bool allowNan = true;
+        bool skipKeys = false;
+        /// `default`: вызывается для значений, которые JSON не описывает
+        Value fallback;
+    };
+
+    /**
+     * @brief Значение, записанное в text.
+     *
+     * Ошибка разбора — `json.JSONDecodeError` с позицией, как в CPython;
+     * object_hook (если не None) вызывается для каждого прочитанного объекта.
+     */
+    Value parse(QStringView text, const Value& objectHook, const std::shared_ptr<Environment>& env);
+
+    /// дописывает JSON-запись value в конец out
+    void dump(const Value& value, const DumpOptions& options, QString& out, const std::shared_ptr<Environment>& env);
+}
+
+#endif //CPPYTHON_JSONCODEC_H
@@ -0,0 +1,25 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_JSONMODULE_H
+#define CPPYTHON_JSONMODULE_H
+
+class Value;
+
+/**
+ * @class JsonModule
+ * @brief Глобальный объект `json` поверх jsoncodec.
+ *
+ * @details
+ * `loads`/`load` с object_hook, `dumps`/`dump` с indent, separators,
+ * sort_keys, ensure_ascii, allow_nan, skipkeys и default, а также класс
+ * `json.JSONDecodeError` (подкласс ValueError). loads принимает str, bytes
+ * и bytearray; bytes читаются как UTF-8.
+ */
+class JsonModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_JSONMODULE_H
@@ -2,6 +2,7 @@
 #define LEXER_H
 
 #include <QVector>
+#include <string_view>
 #include <QRegularExpression>
 #include <utility>
 
@@ -21,6 +22,9 @@
  * - TOKEN_STRING
  * Строковые литералы, заключенные в кавычки (например: "hello", 'world')
  * 
+ * - TOKEN_FSTRING
+ * Тело f-строки (f"x = {x}") с уже раскрытыми escape-последовательностями; поля разбирает Parser
+ * 
  * - TOKEN_BOOL
  * Логические значения True и False
  * 
@@ -47,6 +51,7 @@ enum TokenType {
     TOKEN_NUMBER,
     TOKEN_STRING,
     TOKEN_BYTES,
+    TOKEN_FSTRING,
     TOKEN_BOOL,
     TOKEN_NONE,
     TOKEN_KEYWORD,
@@ -78,7 +83,16 @@ enum class Keyword {
     AND,
     OR,
     DEL,
-    IS
+    IS,
+    YIELD,
+    TRY,
+    EXCEPT,
+    FINALLY,
+    RAISE,
+    AS,
+    IMPORT,
+    ASYNC,
+    AWAIT
 };
 
 static const std::unordered_map<QString, Keyword> keywords = {
@@ -101,7 +115,16 @@ static const std::unordered_map<QString, Keyword> keywords = {
     {"and", Keyword::AND},
     {"or", Keyword::OR},
     {"del", Keyword::DEL},
-    {"is", Keyword::IS}
+    {"is", Keyword::IS},
+    {"yield", Keyword::YIELD},
+    {"try", Keyword::TRY},
+    {"except", Keyword::EXCEPT},
+    {"finally", Keyword::FINALLY},
+    {"raise", Keyword::RAISE},
+    {"as", Keyword::AS},
+    {"import", Keyword::IMPORT},
+    {"async", Keyword::ASYNC},
+    {"await", Keyword::AWAIT}
 };
 
 /**
@@ -130,68 +153,75 @@ struct Token {
  * @class Lexer
  * @brief Отвечает за разбор входного кода на отдельные токены.
  *
- * Класс Lexer выполняет обработку строкового исходного кода, разбивая его на токены.
- * Он поддерживает различные типы токенов, такие как идентификаторы, числа,
- * строки, логические значения, операторы и ключевые слова. Основным методом работы
- * является метод tokenize(), результатом работы которого является последовательность токенов.
+ * Класс Lexer за один проход разбирает исходный код в кодировке UTF-8, не декодируя
+ * его целиком в QString. Значения токенов по возможности не выделяют память:
+ * имена, ключевые слова и операторы берутся из общих таблиц и разделяют один
+ * буфер QString, а отдельная строка создаётся только для чисел и строковых литералов.
+ * Основным методом работы является метод tokenize(), результатом работы которого
+ * является последовательность токенов.
  */
 class Lexer {
 public:
-    QVector<Token> tokenize(const QString& code); //Главный метод
+    QVector<Token> tokenize(std::string_view code); //Главный метод
 
 private:
-    int pos = 0; //текущая позиция в коде
+    const char* src = nullptr; //исходный код в UTF-8
+    qsizetype length = 0; //длина исходного кода в байтах
+    qsizetype pos = 0; //текущая позиция в коде (в байтах)
     int line = 1; //текущая строка
     int column = 1; //текущий столбец
     QVector<int> indentStack;
 
     /**
      * @brief Извлекает следующий токен из входного кода
-     * @param code Исходный код для обработки
      * @return Token Следующий найденный токен
      */
-    Token nextToken(const QString& code);
+    Token nextToken();
 
-        /**
+    /**
      * @brief Читает и возвращает числовой токен из входного кода
-     * @param code Исходный код для обработки
      * @return Token Токен, содержащий числовое значение
      */
-    Token readNumber(const QString &code);
+    Token readNumber();
 
     /**
      * @brief Читает и возвращает строковый токен из входного кода
-     * @param code Исходный код для обработки
      * @return Token Токен, содержащий строковое значение
      */
-    Token readString(const QString &code);
+    Token readString();
+
+    Token readBytes();
 
-    Token readBytes(const QString& code);
+    /// f"..." / F"..." — тело как у обычной строки, но токен TOKEN_FSTRING
+    Token readFString();
 
     /**
      * @brief Читает идентификатор, ключевое слово или булево значение
-     * @param code Исходный код для обработки
      * @return Token Токен типа TOKEN_ID, TOKEN_KEYWORD или TOKEN_BOOL
      */
-    Token readIdentifierOrBool(const QString &code);
+    Token readIdentifierOrBool();
 
     /**
      * @brief Читает и возвращает токен оператора
-     * @param code Исходный код для обработки
      * @return Token Токен, содержащий оператор
      */
-    Token readOperator(const QString &code);
+    Token readOperator();
 
     /**
      * @brief Пропускает пробельные символы (кроме символа новой строки)
-     * @param code Исходный код для обработки
      */
-    void skipWhitespace(const QString &code);
+    void skipWhitespace();
 
     /**
      * @brief Пропускает однострочные комментарии, начинающиеся с #
-     * @param code Исходный код для обработки
      */
-    void skipComment(const QString &code);
+    void skipComment();
+
+    /**
+     * @brief Декодирует символ UTF-8 в текущей позиции, не сдвигая её
+     * @param size Длина символа в байтах
+     * @return Код символа; U+FFFD для некорректной последовательности
+     */
+    [[nodiscard]] char32_t peekCodePoint(int& size) const;
 };
-#endif // LEXER_H
\ No newline at end of file
+#endif // LEXER_H
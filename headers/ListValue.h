@@ -4,20 +4,60 @@
 
 #ifndef CPPYTHON_LISTVALUE_H
 #define CPPYTHON_LISTVALUE_H
+#include <cstdint>
+#include <optional>
 #include <vector>
 
+#include "CowVector.h"
+#include "GarbageCollector.h"
+#include "MemoryTracker.h"
 #include "ObjectValue.h"
+#include "SliceValue.h"
 #include "Value.h"
 
-class ListValue : public ObjectValue, public std::enable_shared_from_this<ListValue> {
+/**
+ * @class ListValue
+ * @brief Список Python.
+ *
+ * @details
+ * Элементы — Value, в которых int и float и так лежат без отдельного объекта,
+ * поэтому отдельных типизированных буферов нет. Вместо них список помнит свою
+ * стратегию — все ли элементы int, float или str. Она вычисляется одним проходом
+ * и хранится до следующего изменения (по CowVector::version()), а append
+ * поддерживает её на ходу. По стратегии sum, min/max, `in`, index, count, `==`
+ * и sort выбирают цикл без разбора типа каждого элемента.
+ */
+class ListValue : public ObjectValue, public GcObject, public std::enable_shared_from_this<ListValue>,
+                  public MemoryTracked<MemoryTracker::Kind::List> {
 public:
-    std::vector<Value> elements;
+    /// copy(), полный срез и list(list) делят буфер с исходным списком до первой записи
+    CowVector<Value> elements;
 
     ListValue() = default;
 
+    /// ёмкость, ниже которой буфер не ужимается: мелкие списки не перераспределяются зря
+    static constexpr std::size_t shrinkThreshold = 64;
+
     explicit ListValue(std::vector<Value> elems)
         : elements(std::move(elems)) {}
 
+    explicit ListValue(CowVector<Value> shared)
+        : elements(std::move(shared)) {}
+
+    /// какого типа все элементы; Generic — разного или не int/float/str
+    enum class Strategy : std::uint8_t { Empty, Int, Float, Str, Generic };
+
+    [[nodiscard]] Strategy strategy() const;
+
+    /// sum(self, start) прямым циклом; nullopt — список или start требуют общего пути
+    [[nodiscard]] std::optional<Value> sumOf(const Value& start) const;
+
+    /// min() или max() непустого списка int или float; иначе nullopt
+    [[nodiscard]] std::optional<Value> extremumOf(bool wantMax) const;
+
+    /// длина итерируемого, если её можно узнать без обхода (operator.length_hint), иначе 0
+    [[nodiscard]] static std::size_t lengthHint(const Value& iterable);
+
     [[nodiscard]] QString toString() const override;
 
     [[nodiscard]] QString repr() const override;
@@ -26,8 +66,17 @@ public:
 
     void setItem(const Value& index, const Value& value) override;
 
+    [[nodiscard]] Value getItemInt(Value::SmallInt index) const override;
+    void setItemInt(Value::SmallInt index, const Value& value) override;
+
     void delItem(const Value& index) override;
 
+    /// a[i:j] = iterable — замена диапазона одной вставкой или удалением
+    void assignSlice(const SliceValue& slice, const Value& value);
+
+    /// del a[i:j:k] — одним проходом уплотнения
+    void deleteSlice(const SliceValue& slice);
+
     void append(const Value& value);
 
     Value pop(const std::optional<Value>& index = std::nullopt);
@@ -80,8 +129,31 @@ public:
 
     [[nodiscard]] Value reversed() const override;
 
+    [[nodiscard]] long gcRefCount() const override;
+
+    [[nodiscard]] std::shared_ptr<GcObject> gcSelf() override;
+
+    void gcTraverse(const GcVisitor& visit) const override;
+
+    void gcClear() override;
+
 private:
+    /// позиция первого элемента в [from, to), равного value, или -1
+    [[nodiscard]] std::ptrdiff_t find(const Value& value, std::ptrdiff_t from, std::ptrdiff_t to) const;
+
+    /// потоков для сортировки без key: больше одного — у большого однородного списка при vecmath.set_threads
+    [[nodiscard]] std::size_t sortWorkers(Strategy kind) const;
+
+    mutable std::optional<Strategy> cachedStrategy;
+    mutable std::uint64_t strategyVersion = 0;
+
     std::vector<Value> buildRepeated(long long times) const;
 
+    /// готовит место под `extra` новых элементов, не теряя геометрического роста
+    void reserveFor(std::size_t extra);
+
+    /// ужимает буфер, если занято меньше его четверти
+    void shrinkIfSparse();
+
 };
 #endif //CPPYTHON_LISTVALUE_H
\ No newline at end of file
@@ -0,0 +1,49 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_LOOKAHEADITERATOR_H
+#define CPPYTHON_LOOKAHEADITERATOR_H
+#include <memory>
+#include <optional>
+
+#include "IteratorValue.h"
+#include "Value.h"
+
+class Environment;
+
+/**
+ * @class LookaheadIterator
+ * @brief Основа ленивых итераторов над другими итераторами (map, filter, zip, enumerate).
+ *
+ * @details
+ * Конец таких итераторов известен только после попытки достать следующий элемент
+ * источника, поэтому `hasNext()` заранее получает элемент через `produce()`
+ * и держит его до вызова `next()`. Источники опрашиваются через iterNext:
+ * встроенные коллекции — напрямую, пользовательские итераторы — через `__next__`.
+ */
+class LookaheadIterator : public IteratorValue {
+public:
+    explicit LookaheadIterator(std::shared_ptr<Environment> env) : env(std::move(env)) {}
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    bool nextPair(Value& first, Value& second) override;
+
+protected:
+    /// окружение вызова встроенной функции: в нём вызываются функции и `__next__`
+    std::shared_ptr<Environment> env;
+
+    /// следующий элемент в `out`; false, если элементов больше нет
+    virtual bool produce(Value& out) = 0;
+
+    /// следующая пара без кортежа; переопределяется вместе с pairwise()
+    virtual bool producePair(Value&, Value&) { return false; }
+
+private:
+    mutable std::optional<Value> pending;
+    mutable bool exhausted = false;
+};
+#endif //CPPYTHON_LOOKAHEADITERATOR_H
@@ -0,0 +1,25 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MAPITERATOR_H
+#define CPPYTHON_MAPITERATOR_H
+#include <vector>
+
+#include "LookaheadIterator.h"
+
+/// map(func, *iterables): func от очередных элементов всех источников
+class MapIterator : public LookaheadIterator {
+public:
+    MapIterator(Value func, std::vector<Value> sources, std::shared_ptr<Environment> env);
+
+    [[nodiscard]] QString getTypeName() const override;
+
+protected:
+    bool produce(Value& out) override;
+
+private:
+    Value func;
+    std::vector<Value> sources;
+};
+#endif //CPPYTHON_MAPITERATOR_H
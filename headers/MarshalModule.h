@@ -0,0 +1,24 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MARSHALMODULE_H
+#define CPPYTHON_MARSHALMODULE_H
+
+class Value;
+
+/**
+ * @class MarshalModule
+ * @brief Глобальный объект `marshal`: `dumps`/`loads`, `dump`/`load` в формате valuecodec.
+ *
+ * @details
+ * Тот же формат, которым parallel_map передаёт данные рабочим: общие объекты
+ * и циклы через list, dict и set сохраняются. Формат свой, с marshal и pickle
+ * CPython он не совместим и читается только тем же исполняемым файлом.
+ */
+class MarshalModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_MARSHALMODULE_H
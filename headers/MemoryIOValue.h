@@ -0,0 +1,126 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MEMORYIOVALUE_H
+#define CPPYTHON_MEMORYIOVALUE_H
+#include <memory>
+#include <optional>
+
+#include <QString>
+
+#include "LookaheadIterator.h"
+#include "Value.h"
+
+class ByteArrayValue;
+
+/**
+ * @class StringIOValue
+ * @brief `io.StringIO` — текстовый поток в памяти.
+ *
+ * @details
+ * Текст лежит в одном QString, ёмкость которого при записи за конец растёт
+ * вдвое: серия `write()` стоит O(n) суммарно, в отличие от `s += part`.
+ * `getvalue()` отдаёт строку, разделяющую буфер (неявное разделение Qt),
+ * поэтому копия делается только при следующей записи, если она будет.
+ *
+ * Итерация, как у файла, отдаёт строки до первой пустой.
+ */
+class StringIOValue final : public LookaheadIterator {
+public:
+    explicit StringIOValue(QString initial);
+
+    [[nodiscard]] QString getTypeName() const override;
+    [[nodiscard]] QString toString() const override;
+
+    [[nodiscard]] bool isClosed() const { return closed; }
+
+    Value read(std::optional<qsizetype> size);
+
+    /// строка до `\n` включительно, не длиннее limit
+    Value readline(std::optional<qsizetype> limit);
+
+    Value readlines();
+
+    /// число записанных символов
+    qsizetype write(const Value& data);
+
+    [[nodiscard]] Value getvalue() const;
+
+    /// whence: 0 — от начала, 1 и 2 — только со смещением 0, как в CPython
+    qsizetype seek(qsizetype offset, int whence);
+
+    [[nodiscard]] qsizetype tell() const;
+
+    /// обрезает текст до size (по умолчанию — до текущей позиции); позиция не меняется
+    qsizetype truncate(std::optional<qsizetype> size);
+
+    void close();
+
+    /// ValueError на закрытом потоке
+    void ensureOpen() const;
+
+protected:
+    bool produce(Value& out) override;
+
+private:
+    QString buffer;
+    qsizetype pos = 0;
+    bool closed = false;
+};
+
+/**
+ * @class BytesIOValue
+ * @brief `io.BytesIO` — двоичный поток в памяти.
+ *
+ * Буфер — собственный bytearray потока: `getbuffer()` возвращает memoryview
+ * прямо над ним, и, пока вид жив, запись и truncate бросают BufferError.
+ * Рост при записи за конец — геометрический, `getvalue()` разделяет буфер
+ * с возвращаемыми bytes без копирования.
+ */
+class BytesIOValue final : public LookaheadIterator {
+public:
+    explicit BytesIOValue(QByteArray initial);
+
+    [[nodiscard]] QString getTypeName() const override;
+    [[nodiscard]] QString toString() const override;
+
+    [[nodiscard]] bool isClosed() const { return closed; }
+
+    Value read(std::optional<qsizetype> size);
+
+    Value readline(std::optional<qsizetype> limit);
+
+    Value readlines();
+
+    /// число записанных байтов; принимает bytes, bytearray и memoryview
+    qsizetype write(const Value& data);
+
+    /// читает в bytearray на месте, не больше его длины
+    qsizetype readinto(ByteArrayValue& target);
+
+    [[nodiscard]] Value getvalue() const;
+
+    /// memoryview над буфером потока
+    [[nodiscard]] Value getbuffer() const;
+
+    qsizetype seek(qsizetype offset, int whence);
+
+    [[nodiscard]] qsizetype tell() const;
+
+    qsizetype truncate(std::optional<qsizetype> size);
+
+    void close();
+
+    void ensureOpen() const;
+
+protected:
+    bool produce(Value& out) override;
+
+private:
+    std::shared_ptr<ByteArrayValue> buffer;
+    qsizetype pos = 0;
+    bool closed = false;
+};
+
+#endif //CPPYTHON_MEMORYIOVALUE_H
@@ -0,0 +1,121 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MEMORYTRACKER_H
+#define CPPYTHON_MEMORYTRACKER_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include <QString>
+
+class Value;
+
+/**
+ * @class MemoryTracker
+ * @brief Учёт живых объектов по типам и строкам, где они созданы: модуль `tracemalloc` и `--tracemalloc`.
+ *
+ * @details
+ * Отслеживаются списки, словари, строки, bytes, bytearray, экземпляры классов и окружения.
+ * Каждый из этих классов наследует MemoryTracked: его конструкторы и деструктор
+ * сообщают о себе трекеру, а при выключенном учёте стоят одной проверки флага `tracing`.
+ * Место создания берётся у Tracer — файл и строка верхнего кадра; окружение кадра
+ * функции создаётся до входа в неё и поэтому относится к строке вызова.
+ *
+ * Размер считается в момент снимка: объект с собственными буферами по их текущей
+ * ёмкости, без объектов, на которые он ссылается, — как `sys.getsizeof`. Объекты,
+ * созданные до `start()`, не учитываются.
+ */
+class MemoryTracker {
+public:
+    enum class Kind : std::uint8_t {
+        List,
+        Dict,
+        Str,
+        Bytes,
+        ByteArray,
+        Instance,
+        Environment
+    };
+
+    /// учёт включён: новые объекты попадают в таблицу живых
+    static inline bool tracing = false;
+
+    /// печатать живые объекты в stderr при выходе (`--tracemalloc`)
+    static inline bool reportOnExit = false;
+
+    static void allocated(const void* object, const Kind kind) {
+        if (tracing) {
+            track(object, kind);
+        }
+    }
+
+    static void released(const void* object) {
+        if (tracing) {
+            untrack(object);
+        }
+    }
+
+    /// получает адрес объекта, его вид и место создания
+    using LiveVisitor = std::function<void(const void*, Kind, const std::pair<QString, int>&)>;
+
+    static void start();
+
+    /// выключает учёт и забывает отслеженные объекты
+    static void stop();
+
+    /// забывает отслеженные объекты, не выключая учёт
+    static void clear();
+
+    /// объект `tracemalloc`: start, stop, is_tracing, clear_traces, take_snapshot
+    static Value makeModule();
+
+    /// обходит живые отслеженные объекты
+    static void forEachLive(const LiveVisitor& visit);
+
+    /// суммарный размер живых отслеженных объектов, как в снимке
+    [[nodiscard]] static std::uint64_t liveBytes();
+
+    [[nodiscard]] static std::size_t liveCount();
+
+    /// печатает живые объекты по типам и строкам в stderr
+    static void report();
+
+private:
+    struct State;
+
+    /// таблицы трекера не разрушаются при выходе: объекты из статических переменных
+    /// снимаются с учёта в своих деструкторах, возможно, уже после конца main
+    static State& state();
+
+    static void track(const void* object, Kind kind);
+    static void untrack(const void* object);
+};
+
+/**
+ * @brief Основа отслеживаемого класса: регистрирует объект на всё время его жизни.
+ *
+ * Ключ в таблице трекера — адрес этой пустой основы; по нему и виду `kind`
+ * трекер приводит указатель обратно к классу объекта, чтобы узнать размер.
+ */
+template<MemoryTracker::Kind kind>
+class MemoryTracked {
+protected:
+    MemoryTracked() {
+        MemoryTracker::allocated(this, kind);
+    }
+
+    MemoryTracked(const MemoryTracked&) : MemoryTracked() {}
+
+    MemoryTracked& operator=(const MemoryTracked&) {
+        return *this;
+    }
+
+    ~MemoryTracked() {
+        MemoryTracker::released(this);
+    }
+};
+
+#endif //CPPYTHON_MEMORYTRACKER_H
@@ -0,0 +1,27 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MEMORYVIEWITERATOR_H
+#define CPPYTHON_MEMORYVIEWITERATOR_H
+#include "IteratorValue.h"
+
+class MemoryViewValue;
+
+/// обход элементов memoryview по индексу; элементы читаются из буфера по мере обхода
+class MemoryViewIterator : public IteratorValue {
+public:
+
+    std::shared_ptr<MemoryViewValue> view;
+    qsizetype index = 0;
+
+    explicit MemoryViewIterator(std::shared_ptr<MemoryViewValue> view)
+        : view(std::move(view)) {}
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    [[nodiscard]] QString getTypeName() const override;
+};
+#endif //CPPYTHON_MEMORYVIEWITERATOR_H
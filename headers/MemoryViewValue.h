@@ -0,0 +1,114 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MEMORYVIEWVALUE_H
+#define CPPYTHON_MEMORYVIEWVALUE_H
+#include <QByteArray>
+#include <QByteArrayView>
+
+#include "ObjectValue.h"
+
+class ByteArrayValue;
+
+/**
+ * @class MemoryViewValue
+ * @brief `memoryview` — окно в буфер bytes, bytearray или общего сегмента без копирования данных.
+ *
+ * @details
+ * Вид хранит владельца буфера и три числа: смещение первого элемента в байтах,
+ * число элементов и шаг между ними в байтах (отрицательный у `mv[::-1]`). Срез
+ * вида — новый вид над тем же буфером: меняются только эти числа, байты не
+ * копируются. Данные читаются через QByteArray владельца при каждом обращении,
+ * поэтому запись в bytearray сразу видна во всех видах.
+ *
+ * Пока вид над bytearray не освобождён (`release()` или уничтожение объекта),
+ * bytearray нельзя менять в размере: append, extend, `del`, resize и другие
+ * бросают BufferError, как в CPython.
+ *
+ * Вид над SharedBufferValue (`sharedmem.share`) только для чтения: байты лежат в
+ * отображённом файле, и такой вид передаётся рабочим parallel_map ссылкой на сегмент.
+ */
+class MemoryViewValue final : public ObjectValue {
+public:
+    /// положение вида в буфере владельца: смещение и шаг в байтах, число элементов, формат
+    struct Layout {
+        qsizetype offset;
+        qsizetype length;
+        qsizetype stride;
+        char format;
+    };
+
+    /// вид на весь буфер bytes, bytearray, общего сегмента или другого memoryview
+    explicit MemoryViewValue(const Value& source);
+
+    /// вид над source в положении layout; ValueError, если он выходит за буфер или формат неизвестен
+    [[nodiscard]] static Value over(const Value& source, const Layout& layout);
+    ~MemoryViewValue() override;
+
+    MemoryViewValue(const MemoryViewValue&) = delete;
+    MemoryViewValue& operator=(const MemoryViewValue&) = delete;
+
+    /// memoryview в значении или nullptr
+    [[nodiscard]] static MemoryViewValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    /// элемент по целому индексу или новый вид по срезу
+    [[nodiscard]] Value getItem(const Value& index) const override;
+    void setItem(const Value& index, const Value& value) override;
+
+    [[nodiscard]] bool equal(const Value& other) const override;
+    [[nodiscard]] bool notEqual(const Value& other) const override;
+
+    [[nodiscard]] qsizetype len() const;
+
+    /// элемент с неотрицательным индексом `index < len()`
+    [[nodiscard]] Value item(qsizetype index) const;
+
+    /// копия байтов вида; у непрерывного вида — одно копирование блока
+    [[nodiscard]] QByteArray toBytes() const;
+
+    /// байты непрерывного вида без копирования; только при contiguous()
+    [[nodiscard]] QByteArrayView view() const;
+    [[nodiscard]] Value toList() const;
+
+    /// тот же буфер в другом формате; форма и шаг пересчитываются по новому размеру элемента
+    [[nodiscard]] Value cast(const QString& format) const;
+
+    /// отпускает буфер: bytearray снова можно менять в размере
+    void release();
+
+    /// ValueError, если вид уже освобождён
+    void ensureAlive() const;
+
+    [[nodiscard]] const Value& object() const;
+    [[nodiscard]] Layout layout() const;
+    [[nodiscard]] bool readOnly() const;
+    [[nodiscard]] bool contiguous() const;
+    [[nodiscard]] qsizetype nbytes() const;
+    [[nodiscard]] qsizetype itemSize() const;
+    [[nodiscard]] qsizetype strides() const;
+    [[nodiscard]] QString format() const;
+
+private:
+    MemoryViewValue(const MemoryViewValue& parent, qsizetype offset, qsizetype length, qsizetype stride, char format);
+
+    void pin() const;
+
+    [[nodiscard]] const char* address(qsizetype index) const;
+
+    Value owner;
+    const QByteArray* buffer = nullptr;
+    /// владелец — bytearray: запись разрешена, размер закреплён
+    ByteArrayValue* array = nullptr;
+
+    qsizetype offset = 0;
+    qsizetype length = 0;
+    qsizetype stride = 1;
+    char code = 'B';
+    bool released = false;
+};
+
+#endif //CPPYTHON_MEMORYVIEWVALUE_H
@@ -0,0 +1,80 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MODULELOADER_H
+#define CPPYTHON_MODULELOADER_H
+#include <memory>
+#include <optional>
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include "Lexer.h"
+#include "Value.h"
+
+class Environment;
+class ModuleValue;
+
+/**
+ * @class ModuleLoader
+ * @brief `import`: поиск модулей по `sys.path`, загрузка и кэш `sys.modules`.
+ *
+ * @details
+ * Модуль `a.b` ищется как `b.py` или пакет `b/__init__.py` в каталоге пакета `a`,
+ * модуль верхнего уровня — в каталогах `sys.path` (первый — каталог запускаемого
+ * скрипта). Каждый файл разбирается и выполняется один раз за запуск: загруженный
+ * модуль попадает в `sys.modules` ещё до выполнения его кода, поэтому повторный
+ * и циклический импорт берут готовый объект. Токены файла, как и у главного
+ * скрипта, берутся из TokenCache, так что между запусками модули не токенизируются заново.
+ *
+ * Глобальное окружение каждого модуля — отдельный потомок окружения встроенных имён:
+ * модули не видят переменных друг друга, а `global` пишет в окружение своего модуля.
+ */
+class ModuleLoader {
+public:
+    /// окружение встроенных имён, общее для всех модулей, и первый каталог `sys.path`
+    static void initialize(const std::shared_ptr<Environment>& builtins, const QString& scriptDir);
+
+    /// глобальное окружение нового модуля с `__name__`
+    static std::shared_ptr<Environment> makeGlobals(const QString& name);
+
+    /// модуль с полным именем `a.b.c` вместе с родительскими пакетами
+    static Value importModule(const QString& name);
+
+    /**
+     * @brief `from module import name`: атрибут модуля или его подмодуль.
+     * @throws std::runtime_error ImportError, если нет ни того, ни другого.
+     */
+    static Value importFrom(const Value& module, const QString& name);
+
+    /// подмодуль пакета, найденный на диске, или nullopt; уже загруженный берётся из кэша
+    static std::optional<Value> importSubmodule(const ModuleValue& package, const QString& name);
+
+    /// `from module import *`: `__all__` или все имена без подчёркивания в начале
+    static void importStar(const Value& module, const std::shared_ptr<Environment>& env);
+
+    /// словарь `sys.modules`
+    static const Value& modules();
+
+    /// список каталогов `sys.path`
+    static const Value& path();
+
+    /// токены открытого файла: из TokenCache или лексером с записью в кэш
+    static QVector<Token> readTokens(QFile& file);
+
+private:
+    static inline std::shared_ptr<Environment> builtins;
+
+    /// загруженный модуль из `sys.modules` или nullopt
+    static std::optional<Value> cached(const QString& name);
+
+    /// выполняет файл модуля `name`; `packageDir` непуст у пакета
+    static Value load(const QString& name, const QString& file, const QString& packageDir);
+
+    /// ищет `name.py` или `name/__init__.py` в каталоге `dir`
+    static std::optional<Value> loadFrom(const QString& dir, const QString& name, const QString& fullName);
+};
+
+#endif //CPPYTHON_MODULELOADER_H
@@ -0,0 +1,55 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MODULEVALUE_H
+#define CPPYTHON_MODULEVALUE_H
+#include <memory>
+#include <optional>
+
+#include "ObjectValue.h"
+
+class Environment;
+
+/**
+ * @class ModuleValue
+ * @brief Модуль, загруженный `import`: его атрибуты — глобальные переменные модуля.
+ *
+ * @details
+ * Атрибуты не копируются в отдельную таблицу: `mod.name` читает переменную прямо
+ * из глобального окружения модуля одним поиском по хешу, без MRO и дескрипторов,
+ * а `mod.name = value` пишет туда же — функции модуля видят запись сразу.
+ *
+ * У пакета (каталога с `__init__.py`) есть `packageDir`: подмодуль, который ещё
+ * не импортирован, загружается при первом обращении к нему как к атрибуту пакета.
+ */
+class ModuleValue final : public ObjectValue {
+public:
+    ModuleValue(QString name, QString file, std::shared_ptr<Environment> globals, QString packageDir = {});
+
+    /// модуль в значении или nullptr
+    [[nodiscard]] static ModuleValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    /// переменная модуля или ещё не загруженный подмодуль пакета; промах — nullopt
+    [[nodiscard]] std::optional<Value> findAttr(const QString& attr) const;
+
+    void setAttr(const QString& attr, Value value) const;
+
+    [[nodiscard]] const QString& moduleName() const { return name; }
+    [[nodiscard]] const QString& fileName() const { return file; }
+    [[nodiscard]] const std::shared_ptr<Environment>& globals() const { return env; }
+
+    /// каталог пакета, в котором ищутся подмодули; пусто — обычный модуль
+    [[nodiscard]] const QString& searchDir() const { return packageDir; }
+
+private:
+    QString name;
+    QString file;
+    std::shared_ptr<Environment> env;
+    QString packageDir;
+};
+
+#endif //CPPYTHON_MODULEVALUE_H
@@ -0,0 +1,93 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_OBJECTPOOL_H
+#define CPPYTHON_OBJECTPOOL_H
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "RuntimeStats.h"
+
+/**
+ * @class ObjectPool
+ * @brief Пулы блоков фиксированных размеров для мелких объектов среды выполнения.
+ *
+ * @details
+ * Устроен как pymalloc: запрос округляется вверх до класса размера с шагом
+ * `granularity`, и у каждого класса свой список свободных блоков. Освобождённый
+ * блок возвращается в начало списка и достаётся следующему объекту того же класса,
+ * поэтому короткоживущие кадры, кортежи и связанные методы не обращаются к malloc.
+ * Когда список пуст, от системы берётся участок на `chunkSize` байт и нарезается
+ * на блоки класса. Запросы больше `maxBlockSize` идут в обычный operator new.
+ *
+ * Память участков не возвращается системе, а сам пул не разрушается: объекты,
+ * переживающие статические деструкторы (встроенные классы), освобождаются в него
+ * до самого конца программы. Интерпретатор однопоточный, пул без блокировок.
+ */
+class ObjectPool {
+public:
+    static constexpr std::size_t granularity = alignof(std::max_align_t);
+    static constexpr std::size_t maxBlockSize = 512;
+    static constexpr std::size_t classCount = maxBlockSize / granularity;
+    static constexpr std::size_t chunkSize = 16 * 1024;
+
+    static void* allocate(std::size_t size);
+    static void deallocate(void* block, std::size_t size) noexcept;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct State {
+        std::array<FreeBlock*, classCount> freeLists = {};
+        std::vector<void*> chunks;
+    };
+
+    static State& state();
+
+    [[nodiscard]] static std::size_t classIndex(std::size_t size) {
+        return (size + granularity - 1) / granularity - 1;
+    }
+
+    /// нарезает новый участок на блоки класса `index` и кладёт их в список свободных
+    static void refill(std::size_t index);
+};
+
+/// аллокатор для std::allocate_shared: объект и его блок управления — один блок пула
+template<typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(const std::size_t n) {
+        return static_cast<T*>(ObjectPool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* block, const std::size_t n) noexcept {
+        ObjectPool::deallocate(block, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+};
+
+/// std::make_shared, берущий память из ObjectPool
+template<typename T, typename... Args>
+std::shared_ptr<T> makePooled(Args&&... args) {
+    RuntimeStats::allocated<T>();
+    return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+#endif //CPPYTHON_OBJECTPOOL_H
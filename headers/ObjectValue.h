@@ -7,6 +7,16 @@
 #include "ReprMixin.h"
 #include "Value.h"
 
+/**
+ * @class ObjectValue
+ * @brief Базовый класс встроенных объектов с операциями по умолчанию.
+ *
+ * @details
+ * Бинарные операции (`add`, `sub`, `bitOr`...) и их отражённые формы (`radd`, `ror`...)
+ * следуют протоколу NotImplemented: если тип второго операнда не поддерживается,
+ * метод возвращает Value::notImplemented(), а не бросает исключение. Тогда Value
+ * пробует отражённый метод правого операнда и только после этого сообщает TypeError.
+ */
 class ObjectValue : public ReprMixin {
 public:
 
@@ -22,28 +32,50 @@ public:
         throw std::runtime_error("Not supported operation for this type");
     }
 
+    /**
+     * @brief `obj[i]` с машинным целым индексом.
+     *
+     * Последовательности переопределяют его, чтобы индекс не проходил через BigInt;
+     * по умолчанию — общий getItem.
+     */
+    [[nodiscard]] virtual Value getItemInt(const Value::SmallInt index) const {
+        return getItem(Value(index));
+    }
+
+    virtual void setItemInt(const Value::SmallInt index, const Value& value) {
+        setItem(Value(index), value);
+    }
+
     [[nodiscard]] virtual Value add(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value sub(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value multiply(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value mod(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
+    }
+
+    [[nodiscard]] virtual Value truediv(const Value& other) const {
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value radd(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value rmod(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
+    }
+
+    [[nodiscard]] virtual Value rtruediv(const Value& other) const {
+        return Value::notImplemented();
     }
 
     virtual Value iadd(const Value& other) {
@@ -83,7 +115,7 @@ public:
     }
 
     [[nodiscard]] virtual Value rmul(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual bool contains(const Value& value) const {
@@ -123,31 +155,31 @@ public:
     }
 
     [[nodiscard]] virtual Value bitOr(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value bitAnd(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value bitXor(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value ror(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value rand(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value rsub(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual Value rxor(const Value& other) const {
-        throw std::runtime_error("Not supported operation for this type");
+        return Value::notImplemented();
     }
 
     [[nodiscard]] virtual std::size_t hash() const {
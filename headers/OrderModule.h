@@ -0,0 +1,32 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ORDERMODULE_H
+#define CPPYTHON_ORDERMODULE_H
+
+class Value;
+
+/**
+ * @class OrderModule
+ * @brief Глобальные объекты `heapq` и `bisect` — алгоритмы над упорядоченными списками.
+ *
+ * @details
+ * heapq: `heappush`, `heappop`, `heapify`, `heappushpop`, `heapreplace`,
+ * `nsmallest`, `nlargest`. Куча — сам массив ListValue::elements, просеивание
+ * идёт по нему на месте в том же порядке сравнений, что и heapq.py.
+ *
+ * bisect: `bisect_left`, `bisect_right`/`bisect`, `insort_left`,
+ * `insort_right`/`insort` с lo, hi и key. Список и кортеж читаются без
+ * обращения к `__getitem__`, прочие последовательности — через протокол.
+ *
+ * key принимают те же функции, что и в CPython 3.11: nsmallest, nlargest и bisect.
+ * Два int, два float и две строки сравниваются напрямую, остальное — Value::operator<.
+ */
+class OrderModule {
+public:
+    static Value makeHeapq();
+    static Value makeBisect();
+};
+
+#endif //CPPYTHON_ORDERMODULE_H
@@ -0,0 +1,35 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ORDEREDDICTVALUE_H
+#define CPPYTHON_ORDEREDDICTVALUE_H
+#include "DictValue.h"
+
+/**
+ * @class OrderedDictValue
+ * @brief `collections.OrderedDict` — словарь, порядок которого можно менять.
+ *
+ * @details
+ * Порядок вставки хранит уже плотный массив DictValue, поэтому отдельного
+ * связного списка нет: move_to_end(key) оставляет надгробие и дописывает запись
+ * в хвост за амортизированное O(1), popitem(last=False) снимает запись с головы.
+ * Сравнение двух OrderedDict учитывает порядок, с обычным dict — нет.
+ */
+class OrderedDictValue final : public DictValue {
+public:
+    OrderedDictValue() = default;
+
+    /// OrderedDict в значении или nullptr
+    [[nodiscard]] static OrderedDictValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    [[nodiscard]] Value copy() const override;
+
+    [[nodiscard]] bool equal(const Value& other) const override;
+    [[nodiscard]] bool notEqual(const Value& other) const override;
+};
+
+#endif //CPPYTHON_ORDEREDDICTVALUE_H
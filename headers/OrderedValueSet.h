@@ -0,0 +1,126 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_ORDEREDVALUESET_H
+#define CPPYTHON_ORDEREDVALUESET_H
+
+#include <cstdint>
+#include <vector>
+
+#include <QList>
+
+#include "CowVector.h"
+#include "Value.h"
+
+/**
+ * @class OrderedValueSet
+ * @brief Хеш-таблица значений с порядком вставки — хранилище SetValue и FrozenSetValue.
+ *
+ * @details
+ * Устроена так же, как компактная таблица DictValue: плотный массив записей в порядке
+ * вставки и разреженная таблица индексов с открытой адресацией. Удаление оставляет
+ * надгробие и стоит O(1), надгробия вычищаются при перестроении таблицы. Отдельный
+ * список порядка не нужен: итерация идёт по плотному массиву.
+ *
+ * Как и у DictValue, до SMALL_SIZE записей таблицы индексов нет: значение ищется
+ * линейным проходом, а `{a, b}` обходится одним выделением памяти.
+ *
+ * Записи и таблица индексов — CowVector: копия множества делит их с оригиналом
+ * до первого изменения любой из копий. Поэтому `frozenset(s)`, `set(fs)` и
+ * `s.copy()` стоят O(1), а не перестройку таблицы.
+ */
+class OrderedValueSet {
+public:
+    [[nodiscard]] bool contains(const Value& value) const {
+        return lookup(value, qHash(value)) >= 0;
+    }
+
+    /// @return false, если значение уже было в множестве
+    bool insert(const Value& value);
+
+    /// @return false, если значения не было
+    bool remove(const Value& value);
+
+    /// снимает первое по порядку значение; множество не должно быть пустым
+    Value takeFirst();
+
+    void clear();
+
+    [[nodiscard]] std::size_t size() const {
+        return used;
+    }
+
+    [[nodiscard]] bool isEmpty() const {
+        return used == 0;
+    }
+
+    /// длина плотного массива вместе с надгробиями — граница для итераторов
+    [[nodiscard]] std::size_t entryCount() const {
+        return entries.size();
+    }
+
+    /// первая живая запись с номером не меньше `from` или entryCount()
+    [[nodiscard]] std::size_t nextLive(std::size_t from) const;
+
+    [[nodiscard]] const Value& at(const std::size_t i) const {
+        return entries[i].value;
+    }
+
+    [[nodiscard]] QList<Value> values() const;
+
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (std::size_t i = head; i < entries.size(); ++i) {
+            if (entries[i].live) {
+                fn(entries[i].value);
+            }
+        }
+    }
+
+    /// как forEach, но вместе с хешем значения — чтобы не считать его заново
+    template<typename Fn>
+    void forEachHashed(Fn&& fn) const {
+        for (std::size_t i = head; i < entries.size(); ++i) {
+            if (entries[i].live) {
+                fn(entries[i].value, entries[i].hash);
+            }
+        }
+    }
+
+    /**
+     * @brief Содержимое множества-операнда.
+     *
+     * Для set и frozenset возвращает их собственную таблицу без копирования,
+     * иначе собирает значения итерируемого объекта в `storage`.
+     */
+    static const OrderedValueSet& of(const Value& iterable, OrderedValueSet& storage);
+
+private:
+    struct Entry {
+        std::size_t hash = 0;
+        Value value;
+        bool live = false;
+    };
+
+    CowVector<Entry> entries;
+    CowVector<std::int32_t> indices;
+    std::size_t used = 0;
+    std::size_t fill = 0;
+    /// все записи до `head` — надгробия: pop() из начала не просматривает их заново
+    std::size_t head = 0;
+
+    static constexpr std::int32_t EMPTY = -1;
+    static constexpr std::int32_t DUMMY = -2;
+    static constexpr std::size_t MIN_SIZE = 8;
+    static constexpr std::size_t SMALL_SIZE = 8;
+
+    /// номер записи в entries или -1
+    [[nodiscard]] std::ptrdiff_t lookup(const Value& value, std::size_t hash) const;
+
+    void removeAt(std::ptrdiff_t ix);
+
+    void rebuild();
+};
+
+#endif //CPPYTHON_ORDEREDVALUESET_H
@@ -0,0 +1,57 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_OUTPUTSTREAM_H
+#define CPPYTHON_OUTPUTSTREAM_H
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+#include <QStringView>
+
+/**
+ * @class OutputStream
+ * @brief Буферизованный вывод в stdout/stderr с кодированием в UTF-8 прямо в буфер.
+ *
+ * @details
+ * `print` пишет сюда символы строк без промежуточного std::string: UTF-16 из
+ * QStringView кодируется в UTF-8 сразу в буфер на `capacity` байт, который
+ * уходит в файл одним fwrite. iostream и его синхронизация со stdio не участвуют.
+ *
+ * Как в CPython, stdout буферизуется построчно только на терминале — тогда вывод
+ * сбрасывается на каждом переводе строки, — а в файл или канал уходит целыми
+ * блоками. stderr не буферизуется. Весь вывод интерпретатора в stdout идёт через
+ * этот класс, поэтому порядок строк сохраняется; перед чтением ввода и сообщениями
+ * в stderr буфер сбрасывается явно.
+ */
+class OutputStream {
+public:
+    static constexpr std::size_t capacity = 64 * 1024;
+
+    static OutputStream& standardOutput();
+    static OutputStream& standardError();
+
+    void write(QStringView text);
+    void write(std::string_view bytes);
+
+    void flush();
+
+    ~OutputStream();
+
+    OutputStream(const OutputStream&) = delete;
+    OutputStream& operator=(const OutputStream&) = delete;
+
+private:
+    OutputStream(std::FILE* file, bool unbuffered);
+
+    /// сбрасывает буфер после записи у небуферизованного потока или у построчного, если был перевод строки
+    void commit(bool newline);
+
+    std::FILE* file;
+    bool unbuffered;
+    bool lineBuffered;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+};
+#endif //CPPYTHON_OUTPUTSTREAM_H
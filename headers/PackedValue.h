@@ -0,0 +1,55 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_PACKEDVALUE_H
+#define CPPYTHON_PACKEDVALUE_H
+#include <optional>
+
+#include <QByteArray>
+
+#include "ObjectValue.h"
+
+/**
+ * @class PackedValue
+ * @brief Общая часть array.array и vecmath.vector: числа одного C-типа в непрерывном буфере.
+ *
+ * @details
+ * Элементы хранятся в QByteArray как значения C-типа кода, по itemSize()
+ * байтов на элемент, без упаковки каждого числа в Value: миллион `d` занимает
+ * 8 МБ. Value создаётся только при чтении элемента. Чтение, сумма и min/max
+ * общие, а изменение и операторы определяют наследники.
+ */
+class PackedValue : public ObjectValue {
+public:
+    /// array или vector в значении, иначе nullptr
+    [[nodiscard]] static PackedValue* of(const Value& value);
+
+    [[nodiscard]] char typecode() const { return code; }
+    [[nodiscard]] qsizetype itemSize() const { return size; }
+    [[nodiscard]] qsizetype len() const { return data.size() / size; }
+    [[nodiscard]] const QByteArray& bytes() const { return data; }
+
+    /// элемент с неотрицательным индексом `index < len()`
+    [[nodiscard]] Value item(qsizetype index) const;
+
+    [[nodiscard]] Value toList() const;
+
+    /// sum(self, start) прямо по буферу; nullopt — start не int и не float
+    [[nodiscard]] std::optional<Value> sumOf(const Value& start) const;
+
+    /// min() или max() непустого буфера
+    [[nodiscard]] Value extremum(bool wantMax) const;
+
+protected:
+    PackedValue(char typecode, QByteArray data);
+
+    /// `name('code', [элементы])` или `name('code')` для пустого
+    [[nodiscard]] QString reprAs(const char* name) const;
+
+    char code;
+    qsizetype size;
+    QByteArray data;
+};
+
+#endif //CPPYTHON_PACKEDVALUE_H
@@ -0,0 +1,53 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_PARALLELMAP_H
+#define CPPYTHON_PARALLELMAP_H
+#include <memory>
+
+#include <QString>
+
+class Environment;
+class Value;
+
+/**
+ * @class ParallelMap
+ * @brief Встроенная `parallel_map(func, iterable, workers=None)`: map по рабочим процессам.
+ *
+ * @details
+ * Интерпретатор однопоточный, а кэши, пулы объектов и сборщик мусора
+ * общие для процесса, поэтому каждый рабочий — отдельный процесс того же
+ * исполняемого файла: собственный интерпретатор без общего изменяемого
+ * состояния. Элементы делятся на `workers` непрерывных кусков, кусок и
+ * результаты передаются через временные файлы в формате valuecodec.
+ *
+ * Как multiprocessing в режиме spawn, рабочий выполняет модуль функции под
+ * именем `__mp_main__` (код под `if __name__ == "__main__":` не выполняется)
+ * и берёт функцию из его глобальных имён, поэтому передаются только функции
+ * верхнего уровня модуля. Исключение в функции поднимается в родителе с тем
+ * же типом и сообщением.
+ *
+ * memoryview над общим сегментом (`sharedmem.share`) в элементах не копируется:
+ * рабочий отображает тот же файл, так что большая таблица на всех одна.
+ */
+class ParallelMap {
+public:
+    static Value makeBuiltin();
+
+    /**
+     * @brief Рабочий процесс: применяет function к элементам из input, результаты — в output.
+     * @param globals Глобальные имена выполненного модуля функции
+     * @return Код завершения процесса
+     */
+    static int serve(const std::shared_ptr<Environment>& globals, const QString& function,
+                     const QString& input, const QString& output);
+
+    /// исполняемый файл интерпретатора для рабочих процессов; задаёт Interpreter::run
+    static inline QString executable;
+
+    /// рабочий выполняет модуль функции: parallel_map в это время — RuntimeError, а не рекурсия процессов
+    static inline bool bootstrapping = false;
+};
+
+#endif //CPPYTHON_PARALLELMAP_H
@@ -1,28 +1,44 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include "AstArena.h"
 #include "Lexer.h"
+#include "ObjectPool.h"
 #include "Value.h"
 #include "Environment.h"
+#include <cstdint>
 #include <memory>
 #include <utility>
 
+#include <QVarLengthArray>
+
+#include "Bytecode.h"
+#include "Compiler.h"
+#include "Resolver.h"
+
 #include "CallRuntime.h"
 #include "ClassMethodValue.h"
 #include "ClassUtils.h"
+#include "Comprehension.h"
 #include "DictValue.h"
+#include "ExecutionBudget.h"
 #include "FunctionValue.h"
+#include "InlineCache.h"
 #include "InstanceValue.h"
 #include "Interpreter.h"
 #include "IteratorValue.h"
 #include "ListValue.h"
+#include "ModuleLoader.h"
 #include "Param.h"
-#include "Runtime.h"
+#include "PyException.h"
+#include "InterpreterContext.h"
 #include "SetValue.h"
 #include "SliceValue.h"
 #include "StaticMethodValue.h"
 #include "StopIterationException.h"
+#include "StrValue.h"
 #include "TupleValue.h"
+#include "VectorPool.h"
 
 /**
  * @class ASTNode
@@ -42,8 +58,19 @@ public:
     using EnvPtr = std::shared_ptr<Environment>;
     virtual ~ASTNode() = default;
     [[nodiscard]] virtual Value eval(EnvPtr env) const = 0;
+    /// истинность выражения в условии; сравнения и `and`/`or` отвечают без промежуточного Value
+    [[nodiscard]] virtual bool evalCondition(EnvPtr env) const { return eval(std::move(env)).toBool(); }
     [[nodiscard]] virtual QString toString() const = 0;
     [[nodiscard]] virtual bool shouldPrint() const { return true; }
+
+    /// Сообщает Resolver о прочитанных и присвоенных именах; по умолчанию узел имён не содержит
+    virtual void resolve(Resolver&) {}
+
+    /// Байткод инструкции, скомпилированный при первом выполнении через Interpreter::executeNode
+    mutable std::shared_ptr<const CodeObject> bytecode;
+
+    /// строка исходника, с которой начинается инструкция (Token::line); 0 — у выражений внутри инструкций
+    int line = 0;
 };
 
 
@@ -76,6 +103,10 @@ public:
 
 class UnaryOpNode final : public ASTNode {
 
+    friend class Compiler;
+    friend class ConstantFolder;
+    friend class VirtualMachine;
+
     QString op;
     std::shared_ptr<ASTNode> operand;
 
@@ -85,7 +116,10 @@ class UnaryOpNode final : public ASTNode {
         UnaryMinus
     };
 
-    static Operation parseOperation(const QString &op) {
+    /// операция, разобранная один раз при построении узла
+    std::optional<Operation> operation;
+
+    static std::optional<Operation> findOperation(const QString &op) {
         static const std::unordered_map<QString, Operation> opMap = {
             {"+", Operation::UnaryPlus},
             {"-", Operation::UnaryMinus},
@@ -94,7 +128,7 @@ class UnaryOpNode final : public ASTNode {
 
         const auto it = opMap.find(op);
         if (it == opMap.end()) {
-            throw std::runtime_error("Unsupported operation: " + op.toStdString());
+            return std::nullopt;
         }
         return it->second;
     }
@@ -102,21 +136,45 @@ class UnaryOpNode final : public ASTNode {
 public:
 
     UnaryOpNode(QString  op, std::shared_ptr<ASTNode> operand)
-        : op(std::move(op)), operand(std::move(operand)) {}
+        : op(std::move(op)), operand(std::move(operand)), operation(findOperation(this->op)) {}
+
+    void resolve(Resolver& r) override {
+        r.visit(operand);
+    }
 
     [[nodiscard]] Value eval(EnvPtr env) const override {
 
+        if (operation == Operation::Not) {
+            return Value(!operand->evalCondition(std::move(env)));
+        }
+
         const Value val = operand->eval(env);
 
-        switch (parseOperation(op)) {
+        if (!operation) {
+            throw std::runtime_error("Unsupported operation: " + op.toStdString());
+        }
+
+        return apply(*operation, val);
+    }
+
+    [[nodiscard]] bool evalCondition(EnvPtr env) const override {
+
+        if (operation == Operation::Not) {
+            return !operand->evalCondition(std::move(env));
+        }
+
+        return ASTNode::evalCondition(std::move(env));
+    }
+
+    static Value apply(const Operation operation, const Value& val) {
+
+        switch (operation) {
             case Operation::Not:        return Value(!val.toBool());
             case Operation::UnaryPlus:  return +val;
             case Operation::UnaryMinus: return -val;
 
-            default: throw std::runtime_error("Unsupported operation: " + op.toStdString());
+            default: throw std::runtime_error("Unsupported unary operation");
         }
-
-
     }
 
     [[nodiscard]] QString toString() const override {
@@ -143,6 +201,10 @@ public:
  */
 class BinOpNode final : public ASTNode {
 
+    friend class Compiler;
+    friend class ConstantFolder;
+    friend class Parser;
+
     std::shared_ptr<ASTNode> left;
     QString op; // "+", "-", "=", "/", "%", "*", "**", "//", "=="
     std::shared_ptr<ASTNode> right;
@@ -150,7 +212,7 @@ class BinOpNode final : public ASTNode {
 public:
 
     BinOpNode(std::shared_ptr<ASTNode> left, QString  op, std::shared_ptr<ASTNode> right)
-        : left(std::move(left)), op(std::move(op)), right(std::move(right)) {}
+        : left(std::move(left)), op(std::move(op)), right(std::move(right)), operation(findOperation(this->op)) {}
 
     [[nodiscard]] QString toString() const override {
         return "(" + left->toString() + " " + op + " " + right->toString() + ")";
@@ -169,27 +231,24 @@ public:
      *         и операндов (например, числовой результат для арифметических операций, строковый результат для строковых операций).
      * @throws std::runtime_error Если операция не поддерживается для данных типов операндов.
      */
+    void resolve(Resolver& r) override {
+        r.visit(left);
+        r.visit(right);
+    }
+
     [[nodiscard]] Value eval(const EnvPtr env) const override {
 
         const Value l = left->eval(env);
         const Value r = right->eval(env);
 
-        switch (parseOperation(op)) {
-            case Operation::Add:            return l + r;
-            case Operation::Subtract:       return l - r;
-            case Operation::Multiply:       return l * r;
-            case Operation::Power:          return l.power(r);
-            case Operation::Divide:         return l / r;
-            case Operation::Modulo:         return l % r;
-            case Operation::IntDivide:      return l.intDivide(r);
-            case Operation::BitOr:          return l | r;
-            case Operation::BitAnd:         return l & r;
-            case Operation::BitXor:         return l ^ r;
-
-            default: throw std::runtime_error("Unsupported operation: " + op.toStdString());
+        if (!operation || *operation == Operation::And || *operation == Operation::Or) {
+            throw std::runtime_error("Unsupported operation: " + op.toStdString());
         }
+
+        return apply(*operation, l, r);
     }
 
+
     /**
      * @enum Operation
      * @brief Представляет операции, которые могут быть выполнены в бинарном узле AST.
@@ -226,13 +285,12 @@ public:
      *
      * Этот метод принимает строку, представляющую математический оператор или оператор сравнения, и,
      * используя предопределенное отображение, преобразует её в соответствующее значение перечисления `Operation`.
-     * Если предоставленная строка не соответствует ни одному известному оператору, выбрасывается исключение.
+     * Вызывается один раз в конструкторе узла; неизвестный оператор даёт ошибку только при вычислении.
      *
      * @param op Строковое представление оператора для разбора (например, "+", "-", "**").
-     * @return Соответствующее значение перечисления `Operation` для указанного оператора.
-     * @throws std::runtime_error Если входная строка не соответствует поддерживаемой операции.
+     * @return Соответствующее значение перечисления `Operation` или nullopt для неизвестного оператора.
      */
-    static Operation parseOperation(const QString &op) {
+    static std::optional<Operation> findOperation(const QString &op) {
         static const std::unordered_map<QString, Operation> opMap = {
             {"+", Operation::Add},
             {"-", Operation::Subtract},
@@ -251,14 +309,173 @@ public:
         const auto it = opMap.find(op);
 
         if (it == opMap.end()) {
-            throw std::runtime_error("Unsupported operation: " + op.toStdString());
+            return std::nullopt;
         }
 
         return it->second;
     }
+
+    /**
+     * @brief Применяет бинарную операцию к уже вычисленным операндам.
+     *
+     * Используется как при рекурсивном вычислении узла, так и виртуальной машиной
+     * при выполнении инструкции `BinaryOp`.
+     *
+     * @param operation Операция, полученная из `findOperation`.
+     * @param l Левый операнд.
+     * @param r Правый операнд.
+     * @return Результат операции.
+     * @throws std::runtime_error Если операция не поддерживается для данных типов операндов.
+     */
+    static Value apply(const Operation operation, const Value& l, const Value& r) {
+
+        switch (operation) {
+            case Operation::Add:            return l + r;
+            case Operation::Subtract:       return l - r;
+            case Operation::Multiply:       return l * r;
+            case Operation::Power:          return l.power(r);
+            case Operation::Divide:         return l / r;
+            case Operation::Modulo:         return l % r;
+            case Operation::IntDivide:      return l.intDivide(r);
+            case Operation::BitOr:          return l | r;
+            case Operation::BitAnd:         return l & r;
+            case Operation::BitXor:         return l ^ r;
+
+            default: throw std::runtime_error("Unsupported binary operation");
+        }
+    }
+
+private:
+    /// операция, разобранная один раз при построении узла
+    std::optional<Operation> operation;
+};
+
+/**
+ * @class ConcatNode
+ * @brief Цепочка `a + ":" + b + "\n"` со строковой частью — одна склейка вместо временной строки на каждый `+`.
+ *
+ * @details
+ * Парсер строит узел вместо вложенных BinOpNode, если в левоассоциативной цепочке `+`
+ * есть строковый литерал или f-строка. Части вычисляются слева направо, как и раньше.
+ * Пока все они str, сложение откладывается (у str + str нет побочных эффектов), и
+ * результат выделяется один раз по сумме длин. На первой части другого типа уже
+ * вычисленные строки склеиваются, а остаток цепочки складывается обычным `+` по
+ * одной части — `__add__`, `__radd__` и ошибки те же, что без свёртки.
+ */
+class ConcatNode final : public ASTNode {
+
+    friend class Compiler;
+    friend class ConstantFolder;
+
+    std::vector<std::shared_ptr<ASTNode>> pieces;
+
+public:
+
+    explicit ConcatNode(std::vector<std::shared_ptr<ASTNode>> pieces) : pieces(std::move(pieces)) {}
+
+    /// `(цепочка) + piece`
+    void append(std::shared_ptr<ASTNode> piece) {
+        pieces.push_back(std::move(piece));
+    }
+
+    void resolve(Resolver& r) override {
+        for (const auto& piece : pieces) {
+            r.visit(piece);
+        }
+    }
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+
+        QVarLengthArray<Value, 8> values;
+        values.push_back(pieces.front()->eval(env));
+
+        for (std::size_t i = 1; i < pieces.size(); ++i) {
+            values.push_back(pieces[i]->eval(env));
+            step(values.data(), static_cast<std::size_t>(values.size()));
+        }
+
+        return finish(values.data(), static_cast<std::size_t>(values.size()));
+    }
+
+    /**
+     * @brief Принимает последнюю из count вычисленных частей (count >= 2).
+     *
+     * Пока values[0..count) — строки, они остаются как есть. Иначе values[0] — сумма
+     * частей, а остальные слоты пусты (None); сумма продолжается обычным `+`.
+     * Этим же шагом выполняется инструкция BuildConcat.
+     */
+    static void step(Value* values, const std::size_t count) {
+
+        Value& last = values[count - 1];
+
+        if (count > 2 && !isStr(values[1])) {
+            values[0] = BinOpNode::apply(BinOpNode::Operation::Add, values[0], last);
+            last = Value();
+            return;
+        }
+
+        if (isStr(values[0]) && isStr(last)) {
+            return;
+        }
+
+        values[0] = BinOpNode::apply(BinOpNode::Operation::Add, join(values, count - 1), last);
+
+        for (std::size_t i = 1; i < count; ++i) {
+            values[i] = Value();
+        }
+    }
+
+    /// результат цепочки после step над всеми частями
+    static Value finish(const Value* values, const std::size_t count) {
+        return isStr(values[1]) ? join(values, count) : values[0];
+    }
+
+    [[nodiscard]] QString toString() const override {
+
+        QStringList parts;
+
+        for (const auto& piece : pieces) {
+            parts << piece->toString();
+        }
+
+        return "(" + parts.join(" + ") + ")";
+    }
+
+private:
+
+    static bool isStr(const Value& value) {
+        return std::holds_alternative<Value::StrPtr>(value.data);
+    }
+
+    /// строки values[0..count) одним выделением
+    static Value join(const Value* values, const std::size_t count) {
+
+        if (count == 1) {
+            return values[0];
+        }
+
+        qsizetype length = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            length += std::get<Value::StrPtr>(values[i].data)->text().size();
+        }
+
+        QString result;
+        result.reserve(length);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            result += std::get<Value::StrPtr>(values[i].data)->text();
+        }
+
+        return Value(result);
+    }
 };
 
 class LogicalOpNode : public ASTNode {
+
+    friend class Compiler;
+    friend class ConstantFolder;
+
     QString op;
     std::shared_ptr<ASTNode> left;
     std::shared_ptr<ASTNode> right;
@@ -268,6 +485,11 @@ public:
     LogicalOpNode(std::shared_ptr<ASTNode> left, QString op,  std::shared_ptr<ASTNode> right) :
     op(std::move(op)), left(std::move(left)), right(std::move(right)) {}
 
+    void resolve(Resolver& r) override {
+        r.visit(left);
+        r.visit(right);
+    }
+
     [[nodiscard]] Value eval(EnvPtr env) const override {
 
         Value l = left->eval(env);
@@ -291,6 +513,19 @@ public:
         throw std::runtime_error("Unknown logical operator");
     }
 
+    [[nodiscard]] bool evalCondition(const EnvPtr env) const override {
+
+        if (op == "and") {
+            return left->evalCondition(env) && right->evalCondition(env);
+        }
+
+        if (op == "or") {
+            return left->evalCondition(env) || right->evalCondition(env);
+        }
+
+        throw std::runtime_error("Unknown logical operator");
+    }
+
     [[nodiscard]] QString toString() const override {
         return left->toString() + " " + op + " " + right->toString();
     }
@@ -314,10 +549,40 @@ public:
     explicit VarNode(QString name) : name(std::move(name)) {}
 
     QString name;
+    LocalSlot slot;
+    /// глобальное или встроенное имя, найденное при прошлом вычислении
+    mutable NameCache cache;
+
     [[nodiscard]] QString toString() const override { return name; }
-    [[nodiscard]] Value eval(const EnvPtr env) const override { return env.get()->get(name); }
+    void resolve(Resolver& r) override {
+        r.use(name, slot);
+    }
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+        if (const Value* local = env->slot(slot)) {
+            return *local;
+        }
+
+        return env->lookup(name, cache);
+    }
+
+    /// истинность локальной переменной читается на месте, без копии значения
+    [[nodiscard]] bool evalCondition(const EnvPtr env) const override {
+        if (const Value* local = env->slot(slot)) {
+            return local->toBool();
+        }
+
+        return env->lookup(name, cache).toBool();
+    }
 };
 
+/// запись имени: в слот кадра функции, если он разрешён, иначе по строке
+inline void assignName(const std::shared_ptr<Environment>& env, const QString& name, const LocalSlot& slot, Value value) {
+    if (!env->setSlot(slot, std::move(value))) {
+        env->set(name, std::move(value));
+    }
+}
+
 /**
  * @class AssignNode
  * @brief Представляет операцию присваивания в абстрактном синтаксическом дереве (AST) интерпретатора языка программирования.
@@ -336,9 +601,18 @@ public:
     AssignNode(QString varName, std::shared_ptr<ASTNode> valueExpr) :
     varName(std::move(varName)), valueExpr(std::move(valueExpr)) {}
 
+    void resolve(Resolver& r) override {
+        r.visit(valueExpr);
+        r.bind(varName, slot);
+    }
+
     [[nodiscard]] Value eval(const EnvPtr env) const override {
         Value val = valueExpr->eval(env);
-        env.get()->set(varName, val);
+
+        if (!env->setSlot(slot, val)) {
+            env->set(varName, val);
+        }
+
         return val;
     }
 
@@ -349,8 +623,59 @@ public:
     [[nodiscard]] bool shouldPrint() const override { return false; }
 
 private:
+    friend class Compiler;
+
     QString varName;
     std::shared_ptr<ASTNode> valueExpr;
+    LocalSlot slot;
+};
+
+/**
+ * @class UnpackAssignNode
+ * @brief Присваивание с распаковкой: `a, b = value`.
+ *
+ * Правая часть вычисляется целиком до записи имён, поэтому `a, b = b, a`
+ * меняет значения местами. Для кортежа и списка элементы берутся без итератора.
+ */
+class UnpackAssignNode final : public ASTNode {
+public:
+    UnpackAssignNode(std::vector<QString> targets, std::shared_ptr<ASTNode> valueExpr)
+        : targets(std::move(targets)), valueExpr(std::move(valueExpr)), slots(this->targets.size()) {}
+
+    void resolve(Resolver& r) override {
+        r.visit(valueExpr);
+
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            r.bind(targets[i], slots[i]);
+        }
+    }
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+
+        Value val = valueExpr->eval(env);
+
+        const auto values = VectorPool<Value>::acquire();
+        unpackSequence(val, targets.size(), *values, env);
+
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            assignName(env, targets[i], slots[i], std::move((*values)[i]));
+        }
+
+        return val;
+    }
+
+    [[nodiscard]] QString toString() const override {
+        return QStringList(targets.begin(), targets.end()).join(", ") + " = " + valueExpr->toString();
+    }
+
+    [[nodiscard]] bool shouldPrint() const override { return false; }
+
+private:
+    friend class Compiler;
+
+    std::vector<QString> targets;
+    std::shared_ptr<ASTNode> valueExpr;
+    std::vector<LocalSlot> slots;
 };
 
 /**
@@ -380,9 +705,21 @@ public:
         std::vector<std::shared_ptr<ASTNode>> elseBody)
     : condition(std::move(std::move(condition))), body(std::move(body)), elifs(std::move(elifs)), elseBody(std::move(elseBody)) {}
 
+    void resolve(Resolver& r) override {
+        r.visit(condition);
+        r.visitAll(body);
+
+        for (const auto& [elifCondition, elifBody] : elifs) {
+            r.visit(elifCondition);
+            r.visitAll(elifBody);
+        }
+
+        r.visitAll(elseBody);
+    }
+
     [[nodiscard]] Value eval(EnvPtr env) const override {
 
-        if (condition->eval(env).toBool()) {
+        if (condition->evalCondition(env)) {
 
             Value lastValue;
 
@@ -395,7 +732,7 @@ public:
 
         for (const auto& elif: elifs) {
 
-            if (elif.first->eval(env).toBool()) {
+            if (elif.first->evalCondition(env)) {
 
                 Value lastValue;
 
@@ -453,6 +790,8 @@ public:
     [[nodiscard]] bool shouldPrint() const override { return false; }
 
 private:
+    friend class Compiler;
+
     std::shared_ptr<ASTNode> condition;
     std::vector<std::shared_ptr<ASTNode>> body;
     std::vector<std::pair<std::shared_ptr<ASTNode>, std::vector<std::shared_ptr<ASTNode>>>> elifs;
@@ -478,7 +817,9 @@ private:
  */
 class BreakException final : public std::exception {
 public:
-    explicit BreakException(std::string  message = "") : message(std::move(message)) {}
+    explicit BreakException(std::string  message = "") : message(std::move(message)) {
+        RuntimeStats::add(RuntimeStats::Breaks);
+    }
 
     [[nodiscard]] const char* what() const noexcept override { return message.c_str(); }
 
@@ -503,7 +844,9 @@ private:
  */
 class ContinueException final : public std::exception {
 public:
-    explicit ContinueException(std::string message = "") : message(std::move(message)) {}
+    explicit ContinueException(std::string message = "") : message(std::move(message)) {
+        RuntimeStats::add(RuntimeStats::Continues);
+    }
 
     [[nodiscard]] const char* what() const noexcept override { return message.c_str(); }
 
@@ -578,12 +921,20 @@ public:
             , body(std::move(body))
             , elseBody(std::move(elseBody)) {}
 
+    void resolve(Resolver& r) override {
+        r.visit(condition);
+        r.visitAll(body);
+        r.visitAll(elseBody);
+    }
+
     [[nodiscard]] Value eval(const EnvPtr env) const override {
 
         Value last;
         bool broken = false;
 
-        while (condition->eval(env).toBool()) {
+        while (condition->evalCondition(env)) {
+
+            ExecutionBudget::tick();
 
             try {
                 for (auto& stmt : body) {
@@ -628,6 +979,8 @@ public:
     [[nodiscard]] bool shouldPrint() const override { return false; }
 
 private:
+    friend class Compiler;
+
     std::shared_ptr<ASTNode> condition;
     std::vector<std::shared_ptr<ASTNode>> body;
     std::vector<std::shared_ptr<ASTNode>> elseBody;
@@ -653,6 +1006,11 @@ private:
  * Класс не может быть далее унаследован и реализует поведение для узлов сравнения в AST.
  */
 class CompareNode final : public ASTNode {
+
+    friend class Compiler;
+    friend class ConstantFolder;
+    friend class VirtualMachine;
+
     std::shared_ptr<ASTNode> left;
     std::vector<QString> ops;
     std::vector<std::shared_ptr<ASTNode>> rights;
@@ -670,7 +1028,10 @@ class CompareNode final : public ASTNode {
         IsNot,
     };
 
-    static Operation parseOperation(const QString &op) {
+    /// операции цепочки, разобранные один раз при построении узла
+    std::vector<std::optional<Operation>> operations;
+
+    static std::optional<Operation> findOperation(const QString &op) {
         static const std::unordered_map<QString, Operation> opMap = {
             {"==", Operation::Equal},
             {"!=", Operation::NotEqual},
@@ -686,7 +1047,7 @@ class CompareNode final : public ASTNode {
 
         const auto it = opMap.find(op);
         if (it == opMap.end()) {
-            throw std::runtime_error("Unsupported operation: " + op.toStdString());
+            return std::nullopt;
         }
         return it->second;
     }
@@ -716,9 +1077,26 @@ public:
     CompareNode(std::shared_ptr<ASTNode> lhs,
                 std::vector<QString> operators,
                 std::vector<std::shared_ptr<ASTNode>> rgs)
-      : left(std::move(lhs)), ops(std::move(operators)), rights(std::move(rgs)) {}
+      : left(std::move(lhs)), ops(std::move(operators)), rights(std::move(rgs)) {
+
+        operations.reserve(ops.size());
+
+        for (const auto& op : ops) {
+            operations.push_back(findOperation(op));
+        }
+    }
+
+    void resolve(Resolver& r) override {
+        r.visit(left);
+        r.visitAll(rights);
+    }
 
     [[nodiscard]] Value eval(const EnvPtr env) const override {
+        return Value(evalCondition(env));
+    }
+
+    /// звенья цепочки по очереди; каждый средний операнд вычисляется один раз
+    [[nodiscard]] bool evalCondition(const EnvPtr env) const override {
 
         Value a = left->eval(env);
 
@@ -726,14 +1104,18 @@ public:
 
             Value b = rights[i]->eval(env);
 
-            if (!compare(a, b, parseOperation(ops[i]))) {
-                return Value(false);
+            if (!operations[i]) {
+                throw std::runtime_error("Unsupported operation: " + ops[i].toStdString());
+            }
+
+            if (!compare(a, b, *operations[i])) {
+                return false;
             }
 
             a = std::move(b);
         }
 
-        return Value(true);
+        return true;
     }
 
     [[nodiscard]] QString toString() const override {
@@ -763,15 +1145,40 @@ public:
     std::vector<Param> params;
     std::vector<std::shared_ptr<ASTNode>> body;
     std::vector<std::shared_ptr<ASTNode>> decorators;
+    std::shared_ptr<ResolvedScope> scope;
+    std::shared_ptr<const FrameLayout> layout;
+    std::shared_ptr<const BindingPlan> plan;
+
+    /// байткод тела, компилируется при первом выполнении `def`
+    mutable std::shared_ptr<const CodeObject> bodyCode;
+
+    /// `async def`: вызов создаёт сопрограмму
+    bool coroutine = false;
 
     FunctionDefNode(QString name,
                     std::vector<Param> params,
                     std::vector<std::shared_ptr<ASTNode>> body,
                     std::vector<std::shared_ptr<ASTNode>> decorators = {})
-    : name(std::move(name)), params(std::move(params)), body(std::move(body)), decorators(std::move(decorators)) {}
+    : name(std::move(name)), params(std::move(params)), body(std::move(body)), decorators(std::move(decorators)),
+      scope(Resolver::resolveFunction(this->params, this->body)),
+      layout(scope->layout),
+      plan(std::make_shared<BindingPlan>(this->params)) {}
+
+    void resolve(Resolver& r) override {
+        // тело разрешено собственным проходом в конструкторе
+        r.visitAll(decorators);
+        r.bind(name);
+        r.nested(*scope);
+    }
 
     [[nodiscard]] Value eval(const EnvPtr env) const override {
-        const auto func = std::make_shared<FunctionValue>(params, body, env, name);
+        if (!bodyCode) {
+            bodyCode = Compiler::compileFunction(body, coroutine);
+        }
+
+        const auto func = std::make_shared<FunctionValue>(params, body, env->moduleGlobals(), name, layout, bodyCode, plan,
+                                                          env->captureCells(*layout));
+        func->firstLine = line;
 
         Value v(func);
 
@@ -826,6 +1233,8 @@ public:
     std::shared_ptr<ASTNode> callee;
     std::vector<std::shared_ptr<ASTNode>> args;
     std::vector<KeywordArg> kwargs;
+    /// кэш метода для вызовов вида obj.method(...)
+    mutable InlineCache methodCache;
 
     CallNode(std::shared_ptr<ASTNode> callee,
         std::vector<std::shared_ptr<ASTNode>> args,
@@ -834,40 +1243,33 @@ public:
         args(std::move(args)),
         kwargs(std::move(kwargs)) {}
 
-    [[nodiscard]] Value eval(const EnvPtr env) const override {
-        const Value calleeVal = callee->eval(env);
-
-        // positional
-        std::vector<Value> evaluatedArgs;
-        evaluatedArgs.reserve(args.size());
-
-        for (const auto& arg : args)
-            evaluatedArgs.push_back(arg->eval(env));
-
-        // keyword
-        std::vector<std::pair<QString, Value>> evaluatedKwargs;
-        evaluatedKwargs.reserve(kwargs.size());
+    void resolve(Resolver& r) override {
+        r.visit(callee);
+        r.visitAll(args);
 
-        for (const auto&[name, value] : kwargs) {
-
-            evaluatedKwargs.emplace_back(
-                name,
-                value->eval(env)
-            );
+        for (const auto& kwarg : kwargs) {
+            r.visit(kwarg.value);
         }
-
-        return call(calleeVal, evaluatedArgs, evaluatedKwargs, env);
     }
 
+    [[nodiscard]] Value eval(EnvPtr env) const override;
+
     [[nodiscard]] QString toString() const override {
         return callee->toString() + "(...)";
     }
 };
 
 class ReturnNode final : public ASTNode {
+
+    friend class Compiler;
+
 public:
     explicit ReturnNode(std::shared_ptr<ASTNode> expr) : expr(std::move(expr)) {}
 
+    void resolve(Resolver& r) override {
+        r.visit(expr);
+    }
+
     [[nodiscard]] Value eval(const EnvPtr env) const override {
         const Value val = expr ? expr->eval(env) : Value();
         throw ReturnException(val);
@@ -883,24 +1285,297 @@ private:
     std::shared_ptr<ASTNode> expr;
 };
 
-class PassNode : public ASTNode {
+/**
+ * @class YieldNode
+ * @brief `yield value` или `yield from iterable` в теле функции-генератора.
+ *
+ * Приостановка возможна только в байткоде: Compiler превращает узел в YieldValue
+ * (или цикл Send/YieldValue для `yield from`) и помечает функцию генератором.
+ * Сюда, в вычисление по дереву, попадает yield вне функции или внутри
+ * конструкции, которую компилятор не опускает в байткод.
+ */
+class YieldNode final : public ASTNode {
+
+    friend class Compiler;
+
 public:
-    [[nodiscard]] Value eval(std::shared_ptr<Environment> env) const override {
-        return {}; // None
+    YieldNode(std::shared_ptr<ASTNode> value, const bool delegate)
+        : value(std::move(value)), delegate(delegate) {}
+
+    void resolve(Resolver& r) override {
+        r.visit(value);
+    }
+
+    [[nodiscard]] Value eval(EnvPtr) const override {
+        throw std::runtime_error("SyntaxError: 'yield' is not supported in this position");
     }
 
     [[nodiscard]] QString toString() const override {
-        return "pass";
+        return delegate ? "yield from ..." : "yield ...";
     }
 
-    [[nodiscard]] bool shouldPrint() const override { return false; }
+private:
+    /// nullptr — `yield` без значения
+    std::shared_ptr<ASTNode> value;
+    /// `yield from`: значения берутся из вложенного итератора
+    bool delegate;
 };
 
-class GlobalNode : public ASTNode {
+/**
+ * @class AwaitNode
+ * @brief `await awaitable` в теле `async def`.
+ *
+ * Как и YieldNode, исполняется только байткодом: Compiler превращает узел в
+ * GetAwaitable и цикл Send/YieldValue, через который сопрограмма отдаёт
+ * ожидаемую Future циклу событий.
+ */
+class AwaitNode final : public ASTNode {
+
+    friend class Compiler;
+
 public:
-    std::vector<QString> names;
+    explicit AwaitNode(std::shared_ptr<ASTNode> value) : value(std::move(value)) {}
 
-    [[nodiscard]] Value eval(const EnvPtr env) const override {
+    void resolve(Resolver& r) override {
+        r.visit(value);
+    }
+
+    [[nodiscard]] Value eval(EnvPtr) const override {
+        throw std::runtime_error("SyntaxError: 'await' is not supported in this position");
+    }
+
+    [[nodiscard]] QString toString() const override {
+        return "await " + value->toString();
+    }
+
+private:
+    std::shared_ptr<ASTNode> value;
+};
+
+/**
+ * @struct ExceptHandler
+ * @brief Секция `except [тип [as имя]]:` инструкции `try`.
+ */
+struct ExceptHandler {
+    /// nullptr — голый `except:`, ловит любое исключение
+    std::shared_ptr<ASTNode> type;
+    /// пусто — без `as`
+    QString name;
+    LocalSlot slot;
+    std::vector<std::shared_ptr<ASTNode>> body;
+};
+
+/**
+ * @class RaiseNode
+ * @brief `raise`, `raise exc` или `raise exc from cause`.
+ *
+ * Голый `raise` внутри скомпилированного обработчика Compiler превращает в Reraise.
+ * Сюда он попадает из обработчика, выполняемого по дереву (TryNode::eval), — активные
+ * исключения таких обработчиков лежат в `handling`.
+ */
+class RaiseNode final : public ASTNode {
+
+    friend class Compiler;
+
+public:
+    RaiseNode(std::shared_ptr<ASTNode> exception, std::shared_ptr<ASTNode> cause)
+        : exception(std::move(exception)), cause(std::move(cause)) {}
+
+    /// исключения, которые сейчас обрабатывают `except`, выполняемые по дереву
+    static inline std::vector<Value> handling;
+
+    void resolve(Resolver& r) override {
+        r.visit(exception);
+        r.visit(cause);
+    }
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+
+        if (!exception) {
+
+            if (handling.empty()) {
+                throw std::runtime_error("RuntimeError: No active exception to reraise");
+            }
+
+            PyException::raise(handling.back());
+        }
+
+        const Value value = exception->eval(env);
+
+        PyException::raise(value, cause ? cause->eval(env) : Value());
+    }
+
+    [[nodiscard]] QString toString() const override {
+        return exception ? "raise " + exception->toString() : "raise";
+    }
+
+    [[nodiscard]] bool shouldPrint() const override { return false; }
+
+private:
+    /// nullptr — голый `raise`
+    std::shared_ptr<ASTNode> exception;
+    std::shared_ptr<ASTNode> cause;
+};
+
+/**
+ * @class TryNode
+ * @brief Инструкция `try` с обработчиками `except`, веткой `else` и блоком `finally`.
+ *
+ * @details
+ * Обычно узел компилируется: Compiler размещает обработчики после тела и записывает
+ * защищённые диапазоны в таблицу исключений CodeObject, так что вход в `try` не стоит
+ * ни одной инструкции. Вычисление по дереву ниже — для узлов вне байткода: оно
+ * ловит исключение C++, превращает его в объект PyException::toException и ищет
+ * первую подходящую секцию. BreakException, ContinueException и ReturnException
+ * пролетают сквозь обработчики, но блок `finally` выполняется на любом пути.
+ */
+class TryNode final : public ASTNode {
+
+    friend class Compiler;
+
+public:
+    TryNode(std::vector<std::shared_ptr<ASTNode>> body,
+            std::vector<ExceptHandler> handlers,
+            std::vector<std::shared_ptr<ASTNode>> elseBody,
+            std::vector<std::shared_ptr<ASTNode>> finallyBody)
+        : body(std::move(body)),
+          handlers(std::move(handlers)),
+          elseBody(std::move(elseBody)),
+          finallyBody(std::move(finallyBody)) {}
+
+    void resolve(Resolver& r) override {
+
+        r.visitAll(body);
+
+        for (auto& handler : handlers) {
+
+            r.visit(handler.type);
+
+            if (!handler.name.isEmpty()) {
+                r.bind(handler.name, handler.slot);
+            }
+
+            r.visitAll(handler.body);
+        }
+
+        r.visitAll(elseBody);
+        r.visitAll(finallyBody);
+    }
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+
+        Value last;
+
+        const auto run = [&](const std::vector<std::shared_ptr<ASTNode>>& block) {
+            for (const auto& stmt : block) {
+                last = Interpreter::executeNode(stmt, env);
+            }
+        };
+
+        try {
+
+            bool handled = false;
+
+            try {
+                run(body);
+            }
+            catch ([[maybe_unused]] const BreakException& e) { throw; }
+            catch ([[maybe_unused]] const ContinueException& e) { throw; }
+            catch ([[maybe_unused]] const ReturnException& e) { throw; }
+            catch (const std::exception& error) {
+
+                if (handlers.empty()) {
+                    throw;
+                }
+
+                const Value exception = PyException::toException(error);
+                const ExceptHandler* handler = findHandler(exception, env);
+
+                if (!handler) {
+                    throw;
+                }
+
+                if (!handler->name.isEmpty()) {
+                    assignName(env, handler->name, handler->slot, exception);
+                }
+
+                RaiseNode::handling.push_back(exception);
+
+                try {
+                    run(handler->body);
+                }
+                catch (...) {
+                    RaiseNode::handling.pop_back();
+                    throw;
+                }
+
+                RaiseNode::handling.pop_back();
+                handled = true;
+            }
+
+            if (!handled) {
+                run(elseBody);
+            }
+        }
+        catch (...) {
+            run(finallyBody);
+            throw;
+        }
+
+        run(finallyBody);
+
+        return last;
+    }
+
+    [[nodiscard]] QString toString() const override {
+        return "try: ...";
+    }
+
+    [[nodiscard]] bool shouldPrint() const override { return false; }
+
+private:
+    std::vector<std::shared_ptr<ASTNode>> body;
+    std::vector<ExceptHandler> handlers;
+    std::vector<std::shared_ptr<ASTNode>> elseBody;
+    std::vector<std::shared_ptr<ASTNode>> finallyBody;
+
+    /// первая секция, тип которой подходит к исключению
+    const ExceptHandler* findHandler(const Value& exception, const EnvPtr& env) const {
+
+        for (const auto& handler : handlers) {
+            if (!handler.type || PyException::matches(exception, handler.type->eval(env))) {
+                return &handler;
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+class PassNode : public ASTNode {
+public:
+    [[nodiscard]] Value eval(std::shared_ptr<Environment> env) const override {
+        return {}; // None
+    }
+
+    [[nodiscard]] QString toString() const override {
+        return "pass";
+    }
+
+    [[nodiscard]] bool shouldPrint() const override { return false; }
+};
+
+class GlobalNode : public ASTNode {
+public:
+    std::vector<QString> names;
+
+    void resolve(Resolver& r) override {
+        for (const auto& name : names) {
+            r.declareGlobal(name);
+        }
+    }
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
         for (const auto& name : names) {
             env->globalVars.insert(name);
         }
@@ -914,6 +1589,12 @@ class NonlocalNode : public ASTNode {
 public:
     std::vector<QString> names;
 
+    void resolve(Resolver& r) override {
+        for (const auto& name : names) {
+            r.exclude(name);
+        }
+    }
+
     [[nodiscard]] Value eval(const EnvPtr env) const override {
         for (const auto& name : names) {
             env->nonlocalVars.insert(name);
@@ -924,12 +1605,169 @@ public:
     [[nodiscard]] bool shouldPrint() const override { return false; }
 };
 
+/**
+ * @struct ImportName
+ * @brief Один импортируемый модуль или имя: `a.b as c` в `import`, `x as y` в `from ... import`.
+ */
+struct ImportName {
+    QString name;
+    /// пусто — без `as`
+    QString alias;
+    LocalSlot slot;
+};
+
+/**
+ * @class ImportNode
+ * @brief `import a.b.c [as x], ...`.
+ *
+ * Без `as` связывается имя пакета верхнего уровня `a`, с `as` — сам модуль `a.b.c`.
+ */
+class ImportNode final : public ASTNode {
+public:
+    explicit ImportNode(std::vector<ImportName> modules) : modules(std::move(modules)) {}
+
+    void resolve(Resolver& r) override {
+        for (auto& module : modules) {
+            r.bind(bound(module), module.slot);
+        }
+    }
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+
+        for (const auto& module : modules) {
+
+            Value value = ModuleLoader::importModule(module.name);
+
+            if (module.alias.isEmpty() && module.name.contains(u'.')) {
+                value = ModuleLoader::importModule(module.name.section(u'.', 0, 0));
+            }
+
+            if (!env->setSlot(module.slot, value)) {
+                env->set(bound(module), std::move(value));
+            }
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] QString toString() const override {
+
+        QStringList parts;
+
+        for (const auto& module : modules) {
+            parts.append(module.alias.isEmpty() ? module.name : module.name + " as " + module.alias);
+        }
+
+        return "import " + parts.join(", ");
+    }
+
+    [[nodiscard]] bool shouldPrint() const override { return false; }
+
+private:
+    std::vector<ImportName> modules;
+
+    static QString bound(const ImportName& module) {
+        return module.alias.isEmpty() ? module.name.section(u'.', 0, 0) : module.alias;
+    }
+};
+
+/**
+ * @class ImportFromNode
+ * @brief `from module import x [as y], ...` и `from module import *`.
+ *
+ * `level` — число точек относительного импорта: модуль ищется от пакета `__package__`
+ * того модуля, где выполняется инструкция.
+ */
+class ImportFromNode final : public ASTNode {
+public:
+    ImportFromNode(QString module, const int level, std::vector<ImportName> names)
+        : module(std::move(module)), level(level), names(std::move(names)) {}
+
+    void resolve(Resolver& r) override {
+        for (auto& name : names) {
+            r.bind(name.alias.isEmpty() ? name.name : name.alias, name.slot);
+        }
+    }
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+
+        const Value source = ModuleLoader::importModule(absoluteName(env));
+
+        // `import *` разрешён только на уровне модуля, где слотов нет
+        if (names.empty()) {
+            ModuleLoader::importStar(source, env);
+            return {};
+        }
+
+        for (const auto& name : names) {
+
+            Value value = ModuleLoader::importFrom(source, name.name);
+            const QString& target = name.alias.isEmpty() ? name.name : name.alias;
+
+            if (!env->setSlot(name.slot, value)) {
+                env->set(target, std::move(value));
+            }
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] QString toString() const override {
+
+        QStringList parts;
+
+        for (const auto& name : names) {
+            parts.append(name.alias.isEmpty() ? name.name : name.name + " as " + name.alias);
+        }
+
+        return "from " + QString(level, u'.') + module + " import " + (names.empty() ? "*" : parts.join(", "));
+    }
+
+    [[nodiscard]] bool shouldPrint() const override { return false; }
+
+private:
+    QString module;
+    int level;
+    /// пусто — `import *`
+    std::vector<ImportName> names;
+
+    /// полное имя модуля: относительное разрешается от `__package__`
+    [[nodiscard]] QString absoluteName(const EnvPtr& env) const {
+
+        if (level == 0) {
+            return module;
+        }
+
+        const Value* package = env->find("__package__");
+
+        if (!package || !package->isString() || package->toString().isEmpty()) {
+            throw std::runtime_error("ImportError: attempted relative import with no known parent package");
+        }
+
+        QStringList parts = package->toString().split(u'.');
+
+        if (level - 1 >= parts.size()) {
+            throw std::runtime_error("ImportError: attempted relative import beyond top-level package");
+        }
+
+        parts.erase(parts.end() - (level - 1), parts.end());
+
+        if (!module.isEmpty()) {
+            parts.append(module);
+        }
+
+        return parts.join(u'.');
+    }
+};
+
 class ClassDefNode final : public ASTNode {
 public:
     QString name;
     std::vector<std::shared_ptr<ASTNode>> baseExprs;
     QVector<std::shared_ptr<ASTNode>> body;
     std::vector<std::shared_ptr<ASTNode>> decorators;
+    /// методы и лямбды тела класса, которым нужны переменные объемлющей функции
+    std::shared_ptr<ResolvedScope> scope;
 
     ClassDefNode(QString name,
                  std::vector<std::shared_ptr<ASTNode>> bases,
@@ -938,7 +1776,16 @@ public:
         : name(std::move(name)),
         baseExprs(std::move(bases)),
         body(std::move(body)),
-        decorators(std::move(decorators)) {}
+        decorators(std::move(decorators)),
+        scope(Resolver::resolveClass(this->body)) {}
+
+    void resolve(Resolver& r) override {
+        // тело класса выполняется в собственном окружении
+        r.visitAll(baseExprs);
+        r.visitAll(decorators);
+        r.bind(name);
+        r.nested(*scope);
+    }
 
     [[nodiscard]] Value eval(EnvPtr env) const override {
         std::vector<Value::ClassPtr> bases;
@@ -955,12 +1802,15 @@ public:
 
         // наследование по умолчанию
         if (bases.empty()) {
-            bases.push_back(Runtime::objectClass);
+            bases.push_back(InterpreterContext::current().objectClass);
         }
 
         const auto cls = std::make_shared<ClassValue>(name);
         cls->bases = bases;
 
+        // несогласуемая иерархия — ошибка в момент определения класса, как в CPython
+        getMRO(cls);
+
         // создаём временное окружение
         const auto classEnv = std::make_shared<Environment>(env);
 
@@ -1000,9 +1850,11 @@ public:
                 cm->func->ownerClass = cls;
             }
 
-            cls->attributes.insert(key, val);
+            cls->setAttribute(key, val);
         }
 
+        initSlots(cls);
+
         Value classValue(cls);
 
         // применяем декораторы снизу вверх
@@ -1026,19 +1878,17 @@ class AttributeAccessNode : public ASTNode {
 public:
     std::shared_ptr<ASTNode> object;
     QString attr;
+    mutable InlineCache cache;
 
     AttributeAccessNode(std::shared_ptr<ASTNode> object, QString attr)
         : object(std::move(object)), attr(std::move(attr)) {}
 
-    [[nodiscard]] Value eval(const EnvPtr env) const override {
-        const Value objVal = object->eval(env);
-
-        if (std::holds_alternative<Value::SuperPtr>(objVal.data)) {
-            const auto super = std::get<Value::SuperPtr>(objVal.data);
-            return getAttrFromSuper(super, attr);
-        }
+    void resolve(Resolver& r) override {
+        r.visit(object);
+    }
 
-        return getAttrValue(objVal, attr);
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+        return cache.getAttr(object->eval(env), attr);
     }
 
     [[nodiscard]] QString toString() const override {
@@ -1046,6 +1896,38 @@ public:
     }
 };
 
+inline Value CallNode::eval(const EnvPtr env) const {
+    const auto method = dynamic_cast<const AttributeAccessNode*>(callee.get());
+
+    // obj.method(...): встроенные методы вызываются без создания объекта метода
+    const Value calleeVal = method ? method->object->eval(env) : callee->eval(env);
+
+    // positional: вектор из пула, чтобы рекурсивные вызовы не выделяли память
+    const auto evaluatedArgs = VectorPool<Value>::acquire();
+    evaluatedArgs->reserve(args.size());
+
+    for (const auto& arg : args)
+        evaluatedArgs->push_back(arg->eval(env));
+
+    // keyword
+    const auto evaluatedKwargs = VectorPool<std::pair<QString, Value>>::acquire();
+    evaluatedKwargs->reserve(kwargs.size());
+
+    for (const auto&[name, value] : kwargs) {
+
+        evaluatedKwargs->emplace_back(
+            name,
+            value->eval(env)
+        );
+    }
+
+    if (method) {
+        return methodCache.callMethod(calleeVal, method->attr, *evaluatedArgs, *evaluatedKwargs, env);
+    }
+
+    return call(calleeVal, *evaluatedArgs, *evaluatedKwargs, env);
+}
+
 class AttributeAssignNode final : public ASTNode {
 public:
     std::shared_ptr<ASTNode> object;
@@ -1059,6 +1941,11 @@ public:
           attr(std::move(attr)),
           valueExpr(std::move(valueExpr)) {}
 
+    void resolve(Resolver& r) override {
+        r.visit(object);
+        r.visit(valueExpr);
+    }
+
     [[nodiscard]] Value eval(const EnvPtr env) const override {
         Value objVal = object->eval(env);
         Value val = valueExpr->eval(env);
@@ -1082,6 +1969,10 @@ public:
     explicit StarredNode(std::shared_ptr<ASTNode> value)
         : value(std::move(value)) {}
 
+    void resolve(Resolver& r) override {
+        r.visit(value);
+    }
+
     [[nodiscard]] Value eval(EnvPtr env) const override {
         return value->eval(env);
     }
@@ -1098,9 +1989,14 @@ public:
     explicit ListNode(std::vector<std::shared_ptr<ASTNode>> elems)
         : elements(std::move(elems)) {}
 
+    void resolve(Resolver& r) override {
+        r.visitAll(elements);
+    }
+
     [[nodiscard]] Value eval(const EnvPtr env) const override {
 
         std::vector<Value> values;
+        values.reserve(elements.size());
 
         for (const auto &el: elements) {
 
@@ -1108,6 +2004,8 @@ public:
 
                 Value iterable = starred->value->eval(env);
 
+                values.reserve(values.size() + ListValue::lengthHint(iterable) + elements.size());
+
                 const auto iter = iterable.getIterator();
 
                 while (iter->hasNext()) {
@@ -1119,7 +2017,7 @@ public:
             }
         }
 
-        return Value(std::make_shared<ListValue>(std::move(values)));
+        return Value(makePooled<ListValue>(std::move(values)));
     }
 
     [[nodiscard]] QString toString() const override {
@@ -1143,14 +2041,17 @@ public:
         : object(std::move(object)),
           index(std::move(index)) {}
 
-    [[nodiscard]] Value eval(EnvPtr env) const override {
+    void resolve(Resolver& r) override {
+        r.visit(object);
+        r.visit(index);
+    }
 
-        Value obj = object->eval(env);
-        Value idx = index->eval(env);
+    [[nodiscard]] Value eval(EnvPtr env) const override {
 
-        Value getter = genericGetAttr(obj, "__getitem__");
+        const Value obj = object->eval(env);
+        const Value idx = index->eval(env);
 
-        return call(getter, {idx}, {}, env);
+        return getSubscript(obj, idx, env);
     }
 
     [[nodiscard]] QString toString() const override {
@@ -1171,15 +2072,19 @@ public:
           index(std::move(index)),
           value(std::move(value)) {}
 
+    void resolve(Resolver& r) override {
+        r.visit(object);
+        r.visit(index);
+        r.visit(value);
+    }
+
     [[nodiscard]] Value eval(EnvPtr env) const override {
 
-        Value obj = object->eval(env);
-        Value idx = index->eval(env);
+        const Value obj = object->eval(env);
+        const Value idx = index->eval(env);
         Value val = value->eval(env);
 
-        Value setitem = getAttrValue(obj, "__setitem__");
-
-        call(setitem, {idx, val}, {}, env);
+        setSubscript(obj, idx, val, env);
 
         return val;
     }
@@ -1196,19 +2101,33 @@ public:
 
     std::vector<Param> params;
     std::shared_ptr<ASTNode> body;
+    std::vector<std::shared_ptr<ASTNode>> functionBody;
+    std::shared_ptr<ResolvedScope> scope;
+    std::shared_ptr<const FrameLayout> layout;
+    std::shared_ptr<const BindingPlan> plan;
+    mutable std::shared_ptr<const CodeObject> bodyCode;
 
     LambdaNode(std::vector<Param> params,
         std::shared_ptr<ASTNode> body)
         : params(std::move(params)),
-          body(std::move(body)) {}
+          body(std::move(body)),
+          functionBody{std::make_shared<ReturnNode>(this->body)},
+          scope(Resolver::resolveFunction(this->params, functionBody)),
+          layout(scope->layout),
+          plan(std::make_shared<BindingPlan>(this->params)) {}
 
-    [[nodiscard]] Value eval(EnvPtr env) const override {
+    void resolve(Resolver& r) override {
+        r.nested(*scope);
+    }
 
-        std::vector<std::shared_ptr<ASTNode>> functionBody;
+    [[nodiscard]] Value eval(EnvPtr env) const override {
 
-        functionBody.push_back(std::make_shared<ReturnNode>(body));
+        if (!bodyCode) {
+            bodyCode = Compiler::compileFunction(functionBody);
+        }
 
-        const auto fn = std::make_shared<FunctionValue>(params, functionBody, env, "<lambda>");
+        const auto fn = std::make_shared<FunctionValue>(params, functionBody, env->moduleGlobals(), "<lambda>", layout,
+                                                        bodyCode, plan, env->captureCells(*layout));
 
         return Value(fn);
     }
@@ -1246,6 +2165,11 @@ public:
         dict->setItem(key->eval(env), value->eval(env));
     }
 
+    void resolve(Resolver& r) override {
+        r.visit(key);
+        r.visit(value);
+    }
+
     [[nodiscard]] Value eval(EnvPtr) const override {
         throw std::runtime_error("DictKeyValueNode cannot be evaluated directly");
     }
@@ -1264,12 +2188,11 @@ public:
 
     void apply(const std::shared_ptr<DictValue>& dict, std::shared_ptr<Environment> env) const override {
 
-        const auto other = value->eval(env).asDict();
-
-        for (const auto& key : other->getOrder()) {
+        dict->merge(*value->eval(env).asDict());
+    }
 
-            dict->setItem(key, other->getElements()[key]);
-        }
+    void resolve(Resolver& r) override {
+        r.visit(value);
     }
 
     [[nodiscard]] Value eval(EnvPtr env) const override {
@@ -1290,9 +2213,16 @@ public:
     explicit DictNode(std::vector<std::shared_ptr<DictElementNode>> items)
         : items(std::move(items)) {}
 
+    void resolve(Resolver& r) override {
+        for (const auto& item : items) {
+            r.visit(item);
+        }
+    }
+
     [[nodiscard]] Value eval(EnvPtr env) const override {
 
         const auto dict = std::make_shared<DictValue>();
+        dict->reserve(items.size());
 
         for (const auto& item : items) {
             item->apply(dict, env);
@@ -1320,9 +2250,13 @@ public:
     explicit TupleNode(std::vector<std::shared_ptr<ASTNode>> elements)
         : elements(std::move(elements)) {}
 
+    void resolve(Resolver& r) override {
+        r.visitAll(elements);
+    }
+
     [[nodiscard]] Value eval(EnvPtr env) const override {
 
-        std::vector<Value> values;
+        std::vector<Value> values = TupleValue::acquireItems(elements.size());
 
         for (const auto& element : elements) {
 
@@ -1341,7 +2275,7 @@ public:
             }
         }
 
-        return Value(std::make_shared<TupleValue>(std::move(values)));
+        return TupleValue::make(std::move(values));
     }
 
     [[nodiscard]] QString toString() const override {
@@ -1354,56 +2288,253 @@ public:
     }
 };
 
+/**
+ * @class FormattedStringNode
+ * @brief f-строка `f"x = {x!r:>8}"`, ещё парсером разделённая на литералы и выражения полей.
+ *
+ * Шаблон не разбирается во время выполнения: спецификаторы классифицированы заранее,
+ * а результат собирается в строку, зарезервированную под суммарную длину литералов и полей.
+ */
+class FormattedStringNode final : public ASTNode {
+public:
+    struct Part {
+        /// текст перед полем, `{{` и `}}` уже раскрыты
+        QString literal;
+        /// выражение поля; у хвоста строки пусто
+        std::shared_ptr<ASTNode> expr;
+        /// конверсия `!r`/`!s`/`!a` и постоянный спецификатор
+        FormatTemplate::Segment format;
+        /// спецификатор с вложенными полями (`{x:>{width}}`) — сам f-строка
+        std::shared_ptr<ASTNode> spec;
+    };
+
+    std::vector<Part> parts;
+    qsizetype literalLength = 0;
+    /// значений полей и вложенных спецификаторов — операндов BuildString
+    std::int32_t operandCount = 0;
+
+    explicit FormattedStringNode(std::vector<Part> parts) : parts(std::move(parts)) {
+
+        for (const auto& part : this->parts) {
+            literalLength += part.literal.size();
+            operandCount += (part.expr != nullptr) + (part.spec != nullptr);
+        }
+    }
+
+    void resolve(Resolver& r) override {
+
+        for (const auto& part : parts) {
+            r.visit(part.expr);
+            r.visit(part.spec);
+        }
+    }
+
+    /**
+     * @brief Собирает строку из вычисленных операндов.
+     * @param operands значения полей по порядку; за полем со вложенным спецификатором — значение спецификатора
+     */
+    [[nodiscard]] Value build(const Value* operands) const {
+
+        QVarLengthArray<QString, 8> fields;
+        qsizetype length = literalLength;
+
+        for (const auto& part : parts) {
+
+            if (!part.expr) {
+                continue;
+            }
+
+            const Value& value = *operands++;
+
+            if (part.spec) {
+                const QString spec = (operands++)->toString();
+                fields.push_back(StrValue::formatField(FormatTemplate::field(part.format.conversion, spec), value));
+            } else {
+                fields.push_back(StrValue::formatField(part.format, value));
+            }
+
+            length += fields.back().size();
+        }
+
+        QString result;
+        result.reserve(length);
+
+        qsizetype field = 0;
+
+        for (const auto& part : parts) {
+
+            result += part.literal;
+
+            if (part.expr) {
+                result += fields[field++];
+            }
+        }
+
+        return Value(result);
+    }
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+
+        QVarLengthArray<Value, 8> operands;
+
+        for (const auto& part : parts) {
+
+            if (part.expr) {
+                operands.push_back(part.expr->eval(env));
+            }
+
+            if (part.spec) {
+                operands.push_back(part.spec->eval(env));
+            }
+        }
+
+        return build(operands.data());
+    }
+
+    [[nodiscard]] QString toString() const override {
+        return "f\"" + body() + "\"";
+    }
+
+private:
+    /// текст между кавычками; вложенный спецификатор печатается без своих кавычек
+    [[nodiscard]] QString body() const {
+
+        QString text;
+
+        for (const auto& part : parts) {
+
+            text += QString(part.literal).replace('{', "{{").replace('}', "}}");
+
+            if (!part.expr) {
+                continue;
+            }
+
+            text += "{" + part.expr->toString();
+
+            if (!part.format.conversion.isNull()) {
+                text += QString("!") + part.format.conversion;
+            }
+
+            if (part.spec) {
+                text += ":" + static_cast<const FormattedStringNode&>(*part.spec).body();
+            } else if (!part.format.spec.isEmpty()) {
+                text += ":" + part.format.spec;
+            }
+
+            text += "}";
+        }
+
+        return text;
+    }
+};
+
+/**
+ * @class ForNode
+ * @brief Цикл `for`; цель — одно имя или несколько через запятую (`for k, v in d.items()`).
+ *
+ * При двух именах и итераторе, отдающем пары (dict.items(), enumerate, zip двух
+ * источников), имена связываются через IteratorValue::nextPair без кортежа на шаг.
+ */
 class ForNode : public ASTNode {
 public:
 
-    QString varName;
+    std::vector<QString> targets;
 
     std::shared_ptr<ASTNode> iterable;
 
     std::vector<std::shared_ptr<ASTNode>> body;
 
-    ForNode(QString varName,
+    std::vector<LocalSlot> slots;
+
+    ForNode(std::vector<QString> targets,
             std::shared_ptr<ASTNode> iterable,
             std::vector<std::shared_ptr<ASTNode>> body)
-        : varName(std::move(varName)),
+        : targets(std::move(targets)),
           iterable(std::move(iterable)),
-          body(std::move(body)) {}
+          body(std::move(body)),
+          slots(this->targets.size()) {}
 
-    [[nodiscard]] Value eval(EnvPtr env) const override {
+    void resolve(Resolver& r) override {
+        r.visit(iterable);
+
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            r.bind(targets[i], slots[i]);
+        }
 
-        Value iterableValue = iterable->eval(env);
+        r.visitAll(body);
+    }
 
-        Value iterMethod = getAttrValue(iterableValue, "__iter__");
+    [[nodiscard]] Value eval(EnvPtr env) const override {
 
-        Value iterator = call(iterMethod, {}, {}, env);
+        const Value iterator = getIter(iterable->eval(env), env);
 
         Value last;
 
-        while (true) {
+        // false — цикл прерван break
+        const auto runBody = [&] {
+
+            ExecutionBudget::tick();
 
             try {
+                for (const auto& stmt : body) {
+                    last = Interpreter::executeNode(stmt, env);
+                }
+            }
+            catch ([[maybe_unused]] const ContinueException& e) {}
+            catch ([[maybe_unused]] const BreakException& e) {
+                return false;
+            }
+
+            return true;
+        };
 
-                Value nextMethod = getAttrValue(iterator, "__next__");
-                Value value = call(nextMethod, {}, {}, env);
+        if (targets.size() == 1) {
 
-                env->set(varName, value);
+            Value value;
 
-                try {
+            while (iterNext(iterator, value, env)) {
 
-                    for (const auto& stmt : body) {
-                        last = Interpreter::executeNode(stmt, env);
-                    }
+                assignName(env, targets[0], slots[0], value);
 
+                if (!runBody()) {
+                    break;
                 }
+            }
+
+            return last;
+        }
+
+        if (IteratorValue* pairs = targets.size() == 2 ? pairIterator(iterator) : nullptr) {
+
+            Value first;
+            Value second;
+
+            while (pairs->nextPair(first, second)) {
+
+                assignName(env, targets[0], slots[0], std::move(first));
+                assignName(env, targets[1], slots[1], std::move(second));
 
-                catch ([[maybe_unused]] const ContinueException& e) {}
-                catch ([[maybe_unused]] const BreakException& e) {
+                if (!runBody()) {
                     break;
                 }
+            }
+
+            return last;
+        }
+
+        const auto values = VectorPool<Value>::acquire();
+        Value item;
 
+        while (iterNext(iterator, item, env)) {
+
+            values->clear();
+            unpackSequence(item, targets.size(), *values, env);
+
+            for (std::size_t i = 0; i < targets.size(); ++i) {
+                assignName(env, targets[i], slots[i], std::move((*values)[i]));
             }
-            catch (const StopIterationException&) {
+
+            if (!runBody()) {
                 break;
             }
         }
@@ -1412,7 +2543,8 @@ public:
     }
 
     [[nodiscard]] QString toString() const override {
-        return "for " + varName + " in " + iterable->toString() + ": ...";
+        return "for " + QStringList(targets.begin(), targets.end()).join(", ") +
+               " in " + iterable->toString() + ": ...";
     }
 
     [[nodiscard]] bool shouldPrint() const override {
@@ -1420,6 +2552,24 @@ public:
     }
 };
 
+/**
+ * @class AsyncForNode
+ * @brief `async for` в теле `async def`: элементы дают `await it.__anext__()`,
+ * цикл заканчивается на StopAsyncIteration.
+ */
+class AsyncForNode final : public ForNode {
+public:
+    using ForNode::ForNode;
+
+    [[nodiscard]] Value eval(EnvPtr) const override {
+        throw std::runtime_error("SyntaxError: 'async for' outside async function");
+    }
+
+    [[nodiscard]] QString toString() const override {
+        return "async " + ForNode::toString();
+    }
+};
+
 class SetNode : public ASTNode {
 public:
     std::vector<std::shared_ptr<ASTNode>> elements;
@@ -1427,6 +2577,10 @@ public:
     explicit SetNode(std::vector<std::shared_ptr<ASTNode>> elements)
     : elements(std::move(elements)) {}
 
+    void resolve(Resolver& r) override {
+        r.visitAll(elements);
+    }
+
     [[nodiscard]] Value eval(EnvPtr env) const override {
         const auto set = std::make_shared<SetValue>();
 
@@ -1440,24 +2594,12 @@ public:
 
                 while (iter->hasNext()) {
 
-                    Value next = iter->next();
-
-                    if (!set->elements.contains(next)) {
-
-                        set->elements.insert(next);
-                        set->order.push_back(next);
-                    }
+                    set->add(iter->next());
                 }
             }
             else {
 
-                Value value = element->eval(env);
-
-                if (!set->elements.contains(value)) {
-
-                    set->elements.insert(value);
-                    set->order.push_back(value);
-                }
+                set->add(element->eval(env));
             }
         }
 
@@ -1474,6 +2616,69 @@ public:
     }
 };
 
+/**
+ * @class ComprehensionNode
+ * @brief Основа узлов включений: хранит общую часть Comprehension и передаёт ей разрешение имён.
+ *
+ * Comprehension лежит вне арены узлов и удерживается генераторными выражениями,
+ * которые могут пережить разобранную ячейку REPL.
+ */
+class ComprehensionNode : public ASTNode {
+public:
+    std::shared_ptr<const Comprehension> comprehension;
+
+    explicit ComprehensionNode(std::shared_ptr<const Comprehension> comprehension)
+        : comprehension(std::move(comprehension)) {}
+
+    void resolve(Resolver& r) override {
+        comprehension->resolve(r);
+    }
+
+    [[nodiscard]] QString toString() const override {
+        return comprehension->toString();
+    }
+};
+
+/// `[x for x in xs]`
+class ListCompNode final : public ComprehensionNode {
+public:
+    using ComprehensionNode::ComprehensionNode;
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+        return comprehension->evalList(env);
+    }
+};
+
+/// `{x for x in xs}`
+class SetCompNode final : public ComprehensionNode {
+public:
+    using ComprehensionNode::ComprehensionNode;
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+        return comprehension->evalSet(env);
+    }
+};
+
+/// `{k: v for k in xs}`
+class DictCompNode final : public ComprehensionNode {
+public:
+    using ComprehensionNode::ComprehensionNode;
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+        return comprehension->evalDict(env);
+    }
+};
+
+/// `(x for x in xs)` — ленивый итератор, а не список
+class GeneratorExpNode final : public ComprehensionNode {
+public:
+    using ComprehensionNode::ComprehensionNode;
+
+    [[nodiscard]] Value eval(const EnvPtr env) const override {
+        return Comprehension::makeGenerator(comprehension, env);
+    }
+};
+
 class SliceNode : public ASTNode {
 public:
 
@@ -1491,6 +2696,12 @@ public:
     {}
 
 
+    void resolve(Resolver& r) override {
+        r.visit(start);
+        r.visit(stop);
+        r.visit(step);
+    }
+
     [[nodiscard]] Value eval(const EnvPtr env) const override {
 
         std::optional<Value> startValue;
@@ -1569,6 +2780,10 @@ public:
     explicit DeleteNode(std::shared_ptr<ASTNode> target)
     : target(std::move(target)) {}
 
+    void resolve(Resolver& r) override {
+        r.visit(target);
+    }
+
     [[nodiscard]] Value eval(EnvPtr env) const override {
 
         auto indexNode =
@@ -1601,6 +2816,9 @@ public:
 
 class AugAssignNode : public ASTNode {
 
+    friend class Compiler;
+    friend class VirtualMachine;
+
     enum class Operation {
         Add,
         Subtract,
@@ -1617,8 +2835,11 @@ class AugAssignNode : public ASTNode {
     QString name;
     QString op;
     std::shared_ptr<ASTNode> value;
+    LocalSlot slot;
+    /// операция, разобранная один раз при построении узла
+    std::optional<Operation> operation;
 
-    static Operation parseOperation(const QString& op) {
+    static std::optional<Operation> findOperation(const QString& op) {
 
         static const std::unordered_map<QString, Operation> opMap = {
             {"+=",  Operation::Add},
@@ -1636,10 +2857,7 @@ class AugAssignNode : public ASTNode {
         const auto it = opMap.find(op);
 
         if (it == opMap.end()) {
-            throw std::runtime_error(
-                "Unsupported augmented assignment: "
-                + op.toStdString()
-            );
+            return std::nullopt;
         }
 
         return it->second;
@@ -1652,18 +2870,8 @@ class AugAssignNode : public ASTNode {
     const EnvPtr& env,
     const std::function<Value()>& fallback) {
 
-        try {
-
-            const Value method = getAttrValue(left, methodName);
-
-            return call(method, { right }, {}, env);
-
-        } catch (const std::runtime_error& e) {
-
-            if (const std::string msg = e.what();
-                msg.find("AttributeError") == std::string::npos) {
-                throw;
-            }
+        if (const std::optional<Value> method = tryGetAttr(left, methodName)) {
+            return call(*method, { right }, {}, env);
         }
 
         return fallback();
@@ -1672,15 +2880,45 @@ class AugAssignNode : public ASTNode {
 public:
 
     AugAssignNode(QString name, QString op, std::shared_ptr<ASTNode> value)
-        : name(std::move(name)), op(std::move(op)), value(std::move(value)) {}
+        : name(std::move(name)), op(std::move(op)), value(std::move(value)), operation(findOperation(this->op)) {}
+
+    void resolve(Resolver& r) override {
+        r.visit(value);
+        r.bind(name, slot);
+    }
 
     [[nodiscard]] Value eval(EnvPtr env) const override {
-        Value left = env->get(name);
+        const Value* local = env->slot(slot);
+        Value left = local ? *local : env->get(name);
         Value right = value->eval(env);
 
+        if (!operation) {
+            throw std::runtime_error("Unsupported augmented assignment: " + op.toStdString());
+        }
+
+        Value result = apply(*operation, left, right, env);
+
+        if (!env->setSlot(slot, result)) {
+            env->set(name, result);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Применяет составное присваивание к уже вычисленным операндам.
+     *
+     * Сначала пробует in-place dunder-метод левого операнда (`__iadd__` и т.д.),
+     * при его отсутствии — обычную бинарную операцию.
+     */
+    static Value apply(const Operation operation,
+                       const Value& left,
+                       const Value& right,
+                       const EnvPtr& env) {
+
         Value result;
 
-        switch (parseOperation(op)) {
+        switch (operation) {
             case Operation::Add:
                 result = tryInplaceOperation(
                     left,
@@ -1787,8 +3025,6 @@ public:
                 );
         }
 
-        env->set(name, result);
-
         return result;
     }
 
@@ -1809,7 +3045,8 @@ public:
  *
  * @details
  * Основной метод `parse` возвращает корневой узел AST, представляющего собой анализируемое выражение.
- * Парсинг происходит в несколько этапов, начиная с самых низкоприоритетных операций до высокоприоритетных.
+ * Операторы разбираются по Пратту (parseBinary): таблица силы связывания по классу оператора,
+ * определённому для каждого токена в конструкторе, заменяет цепочку функций по уровням приоритета.
  * Класс включает методы, которые обеспечивают парсинг конкретных конструкций, таких как выражения со скобками,
  * операции унарного минуса, математические операции, сравнения и присваивания.
  * Если входные токены содержат синтаксические ошибки, генерируются исключения.
@@ -1820,8 +3057,16 @@ public:
 
     std::shared_ptr<ASTNode> parse(); //Главный метод
 
+    /**
+     * @brief Разбирает весь исходный файл — последовательность инструкций до конца токенов.
+     * @return Инструкции верхнего уровня в порядке следования.
+     */
+    std::vector<std::shared_ptr<ASTNode>> parseModule();
+
 private:
-    //Здесь методы разделены для анализа выражения согласно приоритету
+    /// инструкция без отметки строки; parse() записывает её в узел
+    std::shared_ptr<ASTNode> parseStatement();
+
     /**
      * @brief Разбирает операции присваивания (=)
      * @return Узел присваивания или выражение более высокого приоритета
@@ -1833,27 +3078,19 @@ private:
     std::shared_ptr<ASTNode> parseDoubleStarredExpression();
 
     /**
-     * @brief Разбирает операции сравнения (==, !=, <, <=, >, >=)
-     * @return Узел сравнения или выражение более высокого приоритета
+     * @brief Разбирает операторы, связывающие не слабее minPower (от `or` до `**`)
+     * @return Узел выражения; при minPower = 0 — всё выражение без присваивания
      */
-    std::shared_ptr<ASTNode> parseComparison();
+    std::shared_ptr<ASTNode> parseBinary(int minPower = 0);
 
-    /**
-     * @brief Разбирает операции сложения и вычитания (+, -)
-     * @return Узел арифметической операции или выражение более высокого приоритета
-     */
-    std::shared_ptr<ASTNode> parseAdditionAndSubtraction();
-    /**
-    * @brief Разбирает операции умножения, деления и остатка (*, /, //, %)
-    * @return Узел арифметической операции или выражение более высокого приоритета
-    */
-    std::shared_ptr<ASTNode> parseTerm();
+    /// операнд с префиксными not, + и -
+    std::shared_ptr<ASTNode> parseOperand(int minPower);
 
-    /**
-     * @brief Разбирает операцию возведения в степень (**)
-     * @return Узел возведения в степень или первичное выражение
-     */
-    std::shared_ptr<ASTNode> parsePower();
+    /// цепочка сравнений после левого операнда
+    std::shared_ptr<ASTNode> parseComparisonChain(std::shared_ptr<ASTNode> left);
+
+    /// `left + right`; строковая цепочка — ConcatNode
+    std::shared_ptr<ASTNode> makeAddition(std::shared_ptr<ASTNode> left, std::shared_ptr<ASTNode> right);
 
     /**
      * @brief Разбирает первичные выражения (числа, строки, переменные, выражения в скобках)
@@ -1875,6 +3112,14 @@ private:
 
     std::shared_ptr<ASTNode> parseBytesToken();
 
+    std::shared_ptr<ASTNode> parseFStringToken();
+
+    /**
+     * @brief Разбирает тело f-строки на литералы и поля
+     * @return FormattedStringNode или ValueNode, если полей нет
+     */
+    std::shared_ptr<ASTNode> parseFString(const QString& text);
+
     /**
      * @brief Разбирает логический токен
      * @return Узел логического значения
@@ -1899,13 +3144,16 @@ private:
      * @brief Возвращает текущий токен без продвижения
      * @return Текущий токен
      */
-    [[nodiscard]] Token peek() const;
+    [[nodiscard]] const Token& peek() const;
 
     /**
     * @brief Возвращает текущий токен и переходит к следующему
     * @return Текущий токен
     */
-    Token advance();
+    const Token& advance();
+
+    /// общий токен конца потока
+    static const Token& eofToken();
 
     /**
      * @brief Выбрасывает ошибку о неожиданном токене
@@ -1944,12 +3192,41 @@ private:
      */
     std::shared_ptr<ASTNode> parseContinueStatement();
 
-    std::shared_ptr<ASTNode> parseFunctionDef(const std::vector<std::shared_ptr<ASTNode>>& decorators = {});
+    /// coroutine — определение после `async`
+    std::shared_ptr<ASTNode> parseFunctionDef(const std::vector<std::shared_ptr<ASTNode>>& decorators = {},
+                                              bool coroutine = false);
+
+    /// `async def` или `async for`
+    std::shared_ptr<ASTNode> parseAsync(const std::vector<std::shared_ptr<ASTNode>>& decorators = {});
 
     std::shared_ptr<ASTNode> parseReturn();
 
+    /// `yield`, `yield value` или `yield from iterable`
+    std::shared_ptr<ASTNode> parseYield();
+
     std::shared_ptr<ASTNode> parsePass();
 
+    /// `global a, b` или `nonlocal a, b`
+    std::shared_ptr<ASTNode> parseScopeDeclaration();
+
+    /// `try` с секциями `except`, `else` и `finally`
+    std::shared_ptr<ASTNode> parseTryStatement();
+
+    /// `raise`, `raise exc` или `raise exc from cause`
+    std::shared_ptr<ASTNode> parseRaise();
+
+    /// `import a.b [as c], ...`
+    std::shared_ptr<ASTNode> parseImport();
+
+    /// `from [.]module import names`, `from module import (names)` или `from module import *`
+    std::shared_ptr<ASTNode> parseFromImport();
+
+    /// `a.b.c` после `import` или `from`
+    QString parseDottedName();
+
+    /// имя после `as` в импорте
+    QString parseImportAlias();
+
     std::shared_ptr<ASTNode> parseGlobalStatement();
 
     std::shared_ptr<ASTNode> parseNonlocalStatement();
@@ -1972,10 +3249,25 @@ private:
 
     bool isDictLiteral();
 
-    std::shared_ptr<ASTNode> parseForStatement();
+    /// isAsync — цикл `async for`
+    std::shared_ptr<ASTNode> parseForStatement(bool isAsync = false);
+
+    [[nodiscard]] bool isUnpackTarget() const;
+
+    std::shared_ptr<ASTNode> parseUnpackAssignment();
 
     std::shared_ptr<ASTNode> parseDictOrSet();
 
+    /// секции `for ... in ... if ...` включения; текущий токен — первое `for`
+    std::vector<ComprehensionClause> parseComprehensionClauses();
+
+    /// собирает узел включения вида `kind` с уже разобранным элементом
+    std::shared_ptr<ASTNode> parseComprehension(Comprehension::Kind kind,
+                                                std::shared_ptr<ASTNode> element,
+                                                std::shared_ptr<ASTNode> value = nullptr);
+
+    [[nodiscard]] bool matchKeyword(Keyword keyword) const;
+
     std::shared_ptr<ASTNode> parseIndexOrSlice();
 
     QString consume(TokenType type, const QString &value);
@@ -1988,29 +3280,63 @@ private:
 
     bool matchAnyAndAdvance(TokenType type, const std::vector<QString>& values);
 
-    [[nodiscard]] bool isComparisonOperator() const;
-
     QString parseComparisonOperator();
 
-    std::shared_ptr<ASTNode> parseUnary();
-
-    std::shared_ptr<ASTNode> parseNot();
+    std::shared_ptr<ASTNode> parseDelStatement();
 
-    std::shared_ptr<ASTNode> parseAnd();
+    /**
+     * @brief Создаёт узел AST в арене этого разбора.
+     *
+     * Узлы остаются `std::shared_ptr<ASTNode>`, но узел и его блок управления
+     * размещаются в одной арене: узлы модуля лежат рядом, а память освобождается
+     * разом, когда умирает последний узел.
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> makeNode(Args&&... args) {
+        return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+    }
 
-    std::shared_ptr<ASTNode> parseOr();
+    /// инфиксная роль токена; Compare — и у `in`, `is` и `not` перед `in`
+    enum class Infix : std::uint8_t {
+        None,
+        Or,
+        And,
+        Compare,
+        BitOr,
+        BitXor,
+        BitAnd,
+        Additive,
+        Multiplicative,
+        Power,
+        Assign,
+        AugAssign
+    };
 
-    std::shared_ptr<ASTNode> parseBitOr();
+    /// сила связывания префиксного not: его операнд — сравнения и всё, что связывает сильнее
+    static constexpr int notPower = 3;
 
-    std::shared_ptr<ASTNode> parseBitXor();
+    /// сила связывания унарных + и -: сильнее только `**` слева от них
+    static constexpr int unaryPower = 10;
 
-    std::shared_ptr<ASTNode> parseBitAnd();
+    /// сила связывания инфиксного оператора; 0 — токен не продолжает выражение
+    static constexpr int bindingPower(const Infix op) {
+        constexpr int powers[] = {0, 1, 2, 4, 5, 6, 7, 8, 9, 11, 0, 0};
+        return powers[static_cast<int>(op)];
+    }
 
-    std::shared_ptr<ASTNode> parseShift();
+    [[nodiscard]] Infix infixAt(const int position) const {
+        return position < static_cast<int>(infix.size()) ? infix[position] : Infix::None;
+    }
 
-    std::shared_ptr<ASTNode> parseDelStatement();
+    /// заполняет infix для всех токенов
+    void classifyOperators();
 
     QVector<Token> tokens;
+    /// Infix каждого токена — классифицированы один раз в конструкторе
+    std::vector<Infix> infix;
     int current = 0;
+
+    /// арена узлов модуля или ячейки REPL
+    std::shared_ptr<AstArena> arena = std::make_shared<AstArena>();
 };
 #endif //PARSER_H
@@ -0,0 +1,104 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_PROFILER_H
+#define CPPYTHON_PROFILER_H
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <QHash>
+#include <QString>
+
+class FunctionValue;
+
+/**
+ * @class Profiler
+ * @brief Детерминированный профилировщик `--profile`: счётчики вызовов и время функций.
+ *
+ * @details
+ * Кадр Frame открывается на каждый вызов функции Python и встроенной функции.
+ * По выходе из кадра его время делится на собственное (без вложенных вызовов)
+ * и полное; полное время рекурсивной функции считается только по внешнему вызову,
+ * как в cProfile. Собственное время копится ещё и в дереве стеков вызовов, из
+ * которого пишется файл в свёрнутом формате `a;b;c мкс` для flamegraph.pl и speedscope.
+ *
+ * Пока профилировщик выключен, кадр — одна проверка статического флага.
+ */
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static inline bool enabled = false;
+
+    /// кадр профилирования на время вызова
+    class Frame {
+    public:
+        explicit Frame(const QString& name) : active(enabled) {
+            if (active) {
+                enter(name);
+            }
+        }
+
+        /// функция Python: метод подписывается именем класса
+        explicit Frame(const FunctionValue& function);
+
+        ~Frame() {
+            if (active) {
+                leave();
+            }
+        }
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+    private:
+        bool active;
+    };
+
+    /// включает профилирование; непустой `stacksPath` — файл для свёрнутых стеков
+    static void start(const QString& stacksPath);
+
+    /// выключает профилирование, печатает таблицу в stderr и пишет файл стеков
+    static void report();
+
+private:
+    struct Stats {
+        std::uint64_t calls = 0;
+        Clock::duration total{};
+        Clock::duration self{};
+        /// незавершённые вызовы: полное время добавляет только внешний из них
+        int active = 0;
+    };
+
+    /// узел дерева стеков: путь от корня — стек вызовов
+    struct StackNode {
+        QString name;
+        int parent = -1;
+        QHash<QString, int> children;
+        Clock::duration self{};
+    };
+
+    struct Activation {
+        int node;
+        Stats* stats;
+        Clock::time_point start;
+        Clock::duration nested{};
+    };
+
+    static inline QString stacksPath;
+    static inline std::unordered_map<QString, Stats> functions;
+    static inline std::vector<StackNode> stacks;
+    static inline std::vector<Activation> activations;
+    /// полное время вызовов верхнего уровня
+    static inline Clock::duration wall{};
+
+    static void enter(const QString& name);
+    static void leave();
+
+    static void writeStacks();
+};
+
+#endif //CPPYTHON_PROFILER_H
@@ -0,0 +1,98 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_PYEXCEPTION_H
+#define CPPYTHON_PYEXCEPTION_H
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <QString>
+
+#include "RuntimeStats.h"
+#include "Value.h"
+
+class Environment;
+class InstanceValue;
+
+/**
+ * @class PyException
+ * @brief Исключение уровня языка: экземпляр класса, производного от BaseException.
+ *
+ * @details
+ * `raise` выбрасывает PyException с готовым объектом исключения. Ошибки самого
+ * интерпретатора по-прежнему выбрасываются как `std::runtime_error("TypeError: ...")`:
+ * объект для них создаёт toException только тогда, когда ошибку перехватывает
+ * `except`, — на пути без исключений разбор сообщения ничего не стоит.
+ *
+ * `what()` всегда имеет вид `Тип: сообщение`, поэтому непойманное исключение
+ * печатается так же, как любая ошибка интерпретатора.
+ */
+class PyException : public std::runtime_error {
+public:
+    /// исключение, поднятое `raise`
+    explicit PyException(Value exception);
+
+    /// ошибка интерпретатора известного типа; объект создаётся при первом обращении
+    PyException(const QString& type, const std::string& message);
+
+    /// экземпляр класса исключения
+    [[nodiscard]] Value exception() const;
+
+    /**
+     * @brief Объект исключения для любой ошибки, пойманной `except` или `finally`.
+     *
+     * Тип ошибки интерпретатора берётся из префикса сообщения (`ValueError: ...`);
+     * сообщение без известного префикса становится RuntimeError.
+     */
+    [[nodiscard]] static Value toException(const std::exception& error);
+
+    /**
+     * @brief Выбрасывает исключение `raise`: класс создаётся без аргументов, экземпляр — как есть.
+     * @throws std::runtime_error TypeError, если значение не исключение.
+     */
+    [[noreturn]] static void raise(const Value& exception, const Value& cause = Value());
+
+    /// экземпляр встроенного класса исключения `type` с аргументами `args`
+    [[nodiscard]] static Value make(const QString& type, std::vector<Value> args);
+
+    /// `except type`: класс или кортеж классов, к одному из которых относится исключение
+    [[nodiscard]] static bool matches(const Value& exception, const Value& type);
+
+    /// класс производный от BaseException
+    [[nodiscard]] static bool isExceptionClass(const Value::ClassPtr& cls);
+
+    /// `str(e)`: пусто без аргументов, строка единственного аргумента, иначе кортеж аргументов
+    [[nodiscard]] static QString message(const InstanceValue& exception);
+
+    /// `repr(e)`: `ValueError('text')`
+    [[nodiscard]] static QString repr(const InstanceValue& exception);
+
+    /// создаёт встроенные классы исключений и делает их глобальными именами
+    static void registerClasses(const std::shared_ptr<Environment>& globals);
+
+private:
+    mutable Value object;
+    QString type;
+};
+
+/**
+ * @class AttributeErrorException
+ * @brief AttributeError отдельным типом C++: поиск атрибута перехватывает его
+ * по типу, а не по тексту сообщения.
+ */
+class AttributeErrorException final : public PyException {
+public:
+    explicit AttributeErrorException(const std::string& message)
+        : PyException("AttributeError", message) {
+        RuntimeStats::add(RuntimeStats::AttributeErrors);
+    }
+
+    explicit AttributeErrorException(Value exception)
+        : PyException(std::move(exception)) {
+        RuntimeStats::add(RuntimeStats::AttributeErrors);
+    }
+};
+
+#endif //CPPYTHON_PYEXCEPTION_H
@@ -0,0 +1,73 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_RANGEITERATOR_H
+#define CPPYTHON_RANGEITERATOR_H
+#include <cstdint>
+#include <utility>
+
+#include "IteratorValue.h"
+#include "Value.h"
+
+/**
+ * @class RangeIterator
+ * @brief Итератор range: счётчик — машинное целое, элементы не хранятся.
+ *
+ * VirtualMachine в ForIter вызывает `advance` напрямую, минуя next()/hasNext().
+ */
+class RangeIterator final : public IteratorValue {
+public:
+    RangeIterator(const std::int64_t start, const std::int64_t step, const std::int64_t count)
+    : current(start), step(step), remaining(count) {}
+
+    /// следующий элемент в `out`; false, если прогрессия закончилась
+    bool advance(std::int64_t& out) {
+
+        if (remaining <= 0) {
+            return false;
+        }
+
+        out = current;
+        --remaining;
+
+        // после последнего элемента счётчик не сдвигается: current + step может выйти за int64
+        if (remaining > 0) {
+            current = static_cast<std::int64_t>(static_cast<std::uint64_t>(current) + static_cast<std::uint64_t>(step));
+        }
+
+        return true;
+    }
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    [[nodiscard]] QString getTypeName() const override;
+
+private:
+    std::int64_t current;
+    std::int64_t step;
+    std::int64_t remaining;
+};
+/**
+ * @class LongRangeIterator
+ * @brief Итератор range с границами за пределами int64; счётчик — длинное целое.
+ */
+class LongRangeIterator final : public IteratorValue {
+public:
+    LongRangeIterator(Value::BigInt start, Value::BigInt step, Value::BigInt count)
+    : current(std::move(start)), step(std::move(step)), remaining(std::move(count)) {}
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    [[nodiscard]] QString getTypeName() const override;
+
+private:
+    Value::BigInt current;
+    Value::BigInt step;
+    Value::BigInt remaining;
+};
+#endif //CPPYTHON_RANGEITERATOR_H
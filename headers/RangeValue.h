@@ -0,0 +1,99 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_RANGEVALUE_H
+#define CPPYTHON_RANGEVALUE_H
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "ObjectValue.h"
+
+/**
+ * @class RangeValue
+ * @brief Ленивая арифметическая прогрессия `range(start, stop, step)`.
+ *
+ * @details
+ * Хранит только три машинных целых: длина, элемент по индексу, срез и проверка
+ * `x in r` для целого `x` вычисляются за O(1) без построения элементов.
+ *
+ * Если граница, шаг или длина не помещаются в int64 (`range(2**70, 2**70 + 3)`),
+ * прогрессия хранится длинными целыми (Wide) и обходится LongRangeIterator;
+ * машинные поля start/stop/step у неё не используются. len() такой прогрессии —
+ * OverflowError, если длина больше int64, как в CPython.
+ */
+class RangeValue : public ObjectValue {
+public:
+    const Value::SmallInt start;
+    const Value::SmallInt stop;
+    const Value::SmallInt step;
+
+    /// границы прогрессии длинными целыми
+    struct Wide {
+        Value::BigInt start;
+        Value::BigInt stop;
+        Value::BigInt step;
+        Value::BigInt length;
+    };
+
+    RangeValue(Value::SmallInt start, Value::SmallInt stop, Value::SmallInt step);
+
+    explicit RangeValue(std::shared_ptr<const Wide> wide);
+
+    /// range(stop), range(start, stop) и range(start, stop, step) из аргументов вызова
+    static Value fromArgs(const std::vector<Value>& args);
+
+    /// прогрессия с машинными полями, если всё помещается в int64, иначе длинная
+    static Value make(const Value::BigInt& start, const Value::BigInt& stop, const Value::BigInt& step);
+
+    [[nodiscard]] bool isWide() const { return wide != nullptr; }
+
+    [[nodiscard]] bool empty() const { return wide ? wide->length == 0 : length == 0; }
+
+    /// @throws std::runtime_error OverflowError, если длина не помещается в int64
+    [[nodiscard]] Value::SmallInt len() const { return wide ? wideLength() : length; }
+
+    /// атрибуты start, stop и step для обеих форм
+    [[nodiscard]] Value startValue() const;
+    [[nodiscard]] Value stopValue() const;
+    [[nodiscard]] Value stepValue() const;
+
+    /// iter(r) или reversed(r)
+    [[nodiscard]] Value::IteratorPtr makeIterator(bool reversed) const;
+
+    /// элемент с неотрицательным индексом `index < len()`; только для прогрессии без Wide
+    [[nodiscard]] Value::SmallInt at(const Value::SmallInt index) const {
+        // в беззнаковой арифметике промежуточное index * step не переполняется
+        return static_cast<Value::SmallInt>(
+            static_cast<std::uint64_t>(start) + static_cast<std::uint64_t>(index) * static_cast<std::uint64_t>(step));
+    }
+
+    /// индекс значения в прогрессии или -1
+    [[nodiscard]] Value::SmallInt indexOf(const Value& value) const;
+
+    [[nodiscard]] Value getItem(const Value& index) const override;
+
+    [[nodiscard]] bool contains(const Value& value) const override;
+
+    [[nodiscard]] bool equal(const Value& other) const override;
+
+    [[nodiscard]] bool notEqual(const Value& other) const override;
+
+    [[nodiscard]] std::size_t hash() const override;
+
+    [[nodiscard]] QString toString() const override;
+
+private:
+    Value::SmallInt length;
+    std::shared_ptr<const Wide> wide;
+
+    [[nodiscard]] Value::SmallInt wideLength() const;
+
+    /// границы и длина длинными целыми для обеих форм: сравнение с длинной прогрессией
+    [[nodiscard]] Wide bounds() const;
+
+    /// индекс значения в длинной прогрессии или nullopt
+    [[nodiscard]] std::optional<Value::BigInt> wideIndexOf(const Value& value) const;
+};
+#endif //CPPYTHON_RANGEVALUE_H
@@ -0,0 +1,72 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_RECURSIONLIMIT_H
+#define CPPYTHON_RECURSIONLIMIT_H
+#include <stdexcept>
+#include <string>
+
+/**
+ * @class RecursionLimit
+ * @brief Глубина вызовов функций Python и её предел — `sys.setrecursionlimit()`.
+ *
+ * @details
+ * Каждый выполняемый кадр функции Python — вызванный через callFunction или
+ * выполняемый циклом VM в куче — занимает единицу глубины. Вызов сверх предела
+ * бросает RecursionError в вызывающем кадре, и его можно поймать `except`.
+ * Глубина своя у каждого потока, предел общий, по умолчанию 1000, как в CPython.
+ */
+class RecursionLimit {
+public:
+    [[nodiscard]] static int limit() { return maximum; }
+
+    [[nodiscard]] static int depth() { return current; }
+
+    /// ValueError для n < 1, RecursionError — если текущая глубина уже не меньше n
+    static void setLimit(const int n) {
+
+        if (n < 1) {
+            throw std::runtime_error("ValueError: recursion limit must be greater or equal than 1");
+        }
+
+        if (current >= n) {
+            throw std::runtime_error(
+                "RecursionError: cannot set the recursion limit to " + std::to_string(n) +
+                " at the recursion depth " + std::to_string(current) + ": the limit is too low");
+        }
+
+        maximum = n;
+    }
+
+    /// вход в кадр; при превышении предела глубина не меняется
+    static void enter() {
+
+        if (current >= maximum) {
+            throw std::runtime_error("RecursionError: maximum recursion depth exceeded");
+        }
+
+        ++current;
+    }
+
+    /// выход из frames кадров
+    static void leave(const int frames = 1) {
+        current -= frames;
+    }
+
+    /// единица глубины на время вызова
+    class Guard {
+    public:
+        Guard() { enter(); }
+        ~Guard() { leave(); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+private:
+    static inline int maximum = 1000;
+    static inline thread_local int current = 0;
+};
+
+#endif //CPPYTHON_RECURSIONLIMIT_H
@@ -0,0 +1,25 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_REGEXMODULE_H
+#define CPPYTHON_REGEXMODULE_H
+
+class Value;
+
+/**
+ * @class RegexModule
+ * @brief Глобальный объект `re`.
+ *
+ * @details
+ * compile, match, search, fullmatch, findall, finditer, sub, subn, split,
+ * escape и purge, флаги `re.I`, `re.M`, `re.S`, `re.X`, `re.A`... и класс
+ * `re.error`. Функции модуля берут шаблон из кэша PatternValue::compile и
+ * вызывают одноимённый метод Pattern. Поддерживаются только шаблоны str.
+ */
+class RegexModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_REGEXMODULE_H
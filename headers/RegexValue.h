@@ -0,0 +1,180 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_REGEXVALUE_H
+#define CPPYTHON_REGEXVALUE_H
+#include <memory>
+#include <optional>
+
+#include <QRegularExpression>
+#include <QStringList>
+
+#include "CallRuntime.h"
+#include "IteratorValue.h"
+#include "ObjectValue.h"
+
+/**
+ * @class PatternValue
+ * @brief Скомпилированное регулярное выражение `re.Pattern` поверх PCRE2 из Qt.
+ *
+ * @details
+ * Шаблон компилируется один раз, сразу с JIT (QRegularExpression::optimize).
+ * compile() берёт шаблоны из общего для процесса LRU-кэша по паре (шаблон, флаги),
+ * поэтому `re.search(p, s)` в цикле не пересобирает выражение.
+ *
+ * Синтаксис Python переводится в PCRE2 там, где они расходятся: `\Z` — конец
+ * строки, `\uXXXX` и `\UXXXXXXXX` — код символа. Позиции — в единицах UTF-16,
+ * как индексы str интерпретатора.
+ */
+class PatternValue final : public ObjectValue, public std::enable_shared_from_this<PatternValue> {
+public:
+    /// флаги модуля re, те же числа, что в CPython
+    enum Flag : int {
+        IgnoreCase = 2,
+        Locale = 4,
+        Multiline = 8,
+        DotAll = 16,
+        Unicode = 32,
+        Verbose = 64,
+        Ascii = 256
+    };
+
+    /// способ привязки совпадения к позиции pos
+    enum class Anchor { Search, Start, Full };
+
+    /// ошибка в шаблоне — re.error
+    PatternValue(QString pattern, int flags);
+
+    /// шаблон из кэша или новый, который попадает в кэш
+    [[nodiscard]] static std::shared_ptr<PatternValue> compile(const QString& pattern, int flags);
+
+    /// очищает кэш шаблонов — re.purge()
+    static void purge();
+
+    /// шаблон в значении или nullptr
+    [[nodiscard]] static PatternValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    [[nodiscard]] const QString& pattern() const { return source; }
+    [[nodiscard]] int flags() const { return options; }
+    [[nodiscard]] int groups() const { return regex.captureCount(); }
+
+    /// имена групп по номерам; у безымянных — пустая строка
+    [[nodiscard]] const QStringList& groupNames() const { return names; }
+
+    /// номер группы с именем name или -1
+    [[nodiscard]] int groupIndex(const QString& name) const;
+
+    /// Match или None
+    [[nodiscard]] Value match(const Value::StrPtr& subject, qsizetype pos, qsizetype endpos, Anchor anchor) const;
+
+    /// итератор по непересекающимся совпадениям
+    [[nodiscard]] Value findIter(const Value::StrPtr& subject, qsizetype pos, qsizetype endpos) const;
+
+    /// список совпадений, групп или кортежей групп, как re.findall
+    [[nodiscard]] Value findAll(const Value::StrPtr& subject, qsizetype pos, qsizetype endpos) const;
+
+    [[nodiscard]] Value split(const Value::StrPtr& subject, qsizetype maxsplit) const;
+
+    /**
+     * @brief re.sub / re.subn: repl — строка-шаблон с `\1`, `\g<name>` или функция от Match.
+     * @return Новая строка и число замен
+     */
+    [[nodiscard]] std::pair<Value, qsizetype> sub(const Value& repl, const Value::StrPtr& subject, qsizetype count,
+                                                  const std::shared_ptr<Environment>& env) const;
+
+    [[nodiscard]] bool equal(const Value& other) const override;
+    [[nodiscard]] bool notEqual(const Value& other) const override;
+    [[nodiscard]] std::size_t hash() const override;
+
+private:
+    /// текст subject в границах [0, endpos): без endpos — сам буфер строки, без копии
+    [[nodiscard]] static QString window(const Value::StrPtr& subject, qsizetype endpos);
+
+    QString source;
+    int options;
+    QRegularExpression regex;
+    /// `\A(?:шаблон)\z` для fullmatch, компилируется при первом вызове
+    mutable std::optional<QRegularExpression> anchored;
+    QStringList names;
+};
+
+/**
+ * @class MatchValue
+ * @brief Результат поиска `re.Match`.
+ *
+ * Хранит саму строку-источник, а не её копию: группы — срезы источника
+ * (StrValue::substring), длинные из них — представления без копирования символов.
+ */
+class MatchValue final : public ObjectValue {
+public:
+    MatchValue(std::shared_ptr<const PatternValue> pattern, Value::StrPtr subject,
+               QRegularExpressionMatch match, qsizetype pos, qsizetype endpos);
+
+    /// Match в значении или nullptr
+    [[nodiscard]] static MatchValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    /// номер группы по int или имени; IndexError — нет такой группы
+    [[nodiscard]] int groupIndex(const Value& group) const;
+
+    /// текст группы или None, если она не участвовала в совпадении
+    [[nodiscard]] Value group(int index) const;
+
+    [[nodiscard]] qsizetype start(const int index) const { return result.capturedStart(index); }
+    [[nodiscard]] qsizetype end(const int index) const { return result.capturedEnd(index); }
+
+    /// группы с первой; не участвовавшие — fallback
+    [[nodiscard]] Value groups(const Value& fallback) const;
+
+    /// именованные группы; не участвовавшие — fallback
+    [[nodiscard]] Value groupDict(const Value& fallback) const;
+
+    /// шаблон замены с `\1` и `\g<name>` по группам этого совпадения
+    [[nodiscard]] Value expand(const QString& templ) const;
+
+    /// номер последней участвовавшей группы или None
+    [[nodiscard]] Value lastIndex() const;
+    [[nodiscard]] Value lastGroup() const;
+
+    [[nodiscard]] Value getItem(const Value& index) const override;
+
+    [[nodiscard]] const std::shared_ptr<const PatternValue>& pattern() const { return regex; }
+    [[nodiscard]] const Value::StrPtr& subject() const { return string; }
+    [[nodiscard]] qsizetype pos() const { return from; }
+    [[nodiscard]] qsizetype endpos() const { return to; }
+
+private:
+    std::shared_ptr<const PatternValue> regex;
+    Value::StrPtr string;
+    QRegularExpressionMatch result;
+    qsizetype from;
+    qsizetype to;
+};
+
+/// re.finditer(): совпадения по одному, по мере обхода
+class MatchIterator final : public IteratorValue {
+public:
+    MatchIterator(std::shared_ptr<const PatternValue> pattern, Value::StrPtr subject,
+                  QRegularExpressionMatchIterator matches, qsizetype pos, qsizetype endpos);
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    [[nodiscard]] QString getTypeName() const override;
+
+private:
+    std::shared_ptr<const PatternValue> pattern;
+    Value::StrPtr subject;
+    QRegularExpressionMatchIterator matches;
+    qsizetype pos;
+    qsizetype endpos;
+};
+
+#endif //CPPYTHON_REGEXVALUE_H
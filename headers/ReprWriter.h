@@ -0,0 +1,59 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_REPRWRITER_H
+#define CPPYTHON_REPRWRITER_H
+#include <string_view>
+
+#include <QString>
+#include <QStringView>
+
+class DictValue;
+class ListValue;
+class OutputStream;
+class SetValue;
+class TupleValue;
+class Value;
+
+/**
+ * @class ReprWriter
+ * @brief repr() и str() значения, записанные по частям в строку или прямо в поток вывода.
+ *
+ * @details
+ * list, tuple, dict и set пишутся поэлементно в один приёмник: вложенные контейнеры
+ * не собирают собственные промежуточные строки, поэтому вывод линеен по размеру
+ * результата при любой глубине. `print` и эхо REPL пишут в OutputStream — список
+ * из миллиона элементов не материализуется строкой целиком.
+ *
+ * Контейнер, который уже печатается выше по стеку, пишется как `[...]`, `{...}`
+ * или `(...)`, как в CPython. Каждый уровень вложенности занимает единицу
+ * RecursionLimit: слишком глубокая вложенность — RecursionError, а не переполнение стека.
+ * В поток к этому моменту уже ушло начало записи — цена вывода без строки целиком.
+ */
+class ReprWriter {
+public:
+    explicit ReprWriter(QString& target) : target(&target) {}
+    explicit ReprWriter(OutputStream& stream) : stream(&stream) {}
+
+    void repr(const Value& value);
+
+    /// строка пишется как есть, остальное — как repr
+    void str(const Value& value);
+
+    void list(const ListValue& list);
+    void tuple(const TupleValue& tuple);
+    void dict(const DictValue& dict);
+    void set(const SetValue& set);
+
+    void write(QStringView text);
+
+    /// ASCII-текст: числа и разделители без промежуточного QString
+    void write(std::string_view text);
+
+private:
+    QString* target = nullptr;
+    OutputStream* stream = nullptr;
+};
+
+#endif //CPPYTHON_REPRWRITER_H
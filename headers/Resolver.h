@@ -0,0 +1,107 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_RESOLVER_H
+#define CPPYTHON_RESOLVER_H
+
+#include <memory>
+#include <vector>
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "Environment.h"
+#include "Param.h"
+
+class ASTNode;
+
+/**
+ * @struct ResolvedScope
+ * @brief Итог разрешения имён одной области: функции, лямбды, включения или тела класса.
+ *
+ * Имена, не связанные в области, остаются глобальными, пока объемлющая функция
+ * не окажется их владельцем: тогда она делает переменную ячейкой, а эта область
+ * и вложенные в неё получают её свободной переменной. Раскладка поэтому дополняется
+ * свободными переменными уже после построения — при разрешении объемлющей функции.
+ */
+struct ResolvedScope {
+    /// раскладка кадра; у тела класса её нет — его имена ищутся по строке
+    std::shared_ptr<FrameLayout> layout;
+    /// обращения к несвязанным именам, которые станут ячейками, если имя захватят
+    QHash<QString, std::vector<LocalSlot*>> unresolved;
+    /// несвязанные имена этой области и вложенных в неё, кроме объявленных `global`
+    QSet<QString> freeCandidates;
+    std::vector<ResolvedScope*> children;
+};
+
+/**
+ * @class Resolver
+ * @brief Проход по телу функции, назначающий локальным переменным фиксированные слоты кадра.
+ *
+ * @details
+ * Локальными считаются параметры и имена, которым в теле присваивается значение
+ * (`=`, составное присваивание, переменная цикла `for`, `def`, `class`), кроме объявленных
+ * `global`/`nonlocal`. Узлы, читающие или записывающие такие имена, получают LocalSlot
+ * и обращаются к `Environment::slots` по индексу вместо поиска по строке.
+ *
+ * В тела вложенных функций, лямбд и классов проход не заходит: они разрешаются
+ * собственным проходом при построении узла и сообщают о себе через nested. Локальная
+ * переменная, которую читает вложенная область, становится ячейкой, а вложенная
+ * область — как в CPython с cellvars/freevars — получает её свободной переменной.
+ */
+class Resolver {
+public:
+    /**
+     * @brief Строит раскладку кадра функции и разрешает обращения к её локальным переменным.
+     * @param params Параметры функции — занимают первые слоты в порядке объявления.
+     * @param body Инструкции тела функции.
+     * @return Область, раскладку которой FunctionValue передаёт кадру каждого вызова.
+     */
+    static std::shared_ptr<ResolvedScope> resolveFunction(
+        const std::vector<Param>& params,
+        const std::vector<std::shared_ptr<ASTNode>>& body);
+
+    /// тело класса: своих слотов нет, свободные переменные методов берутся из объемлющей функции
+    static std::shared_ptr<ResolvedScope> resolveClass(const QVector<std::shared_ptr<ASTNode>>& body);
+
+    void visit(const std::shared_ptr<ASTNode>& node);
+
+    template<typename Container>
+    void visitAll(const Container& nodes) {
+        for (const auto& node : nodes) {
+            visit(node);
+        }
+    }
+
+    /// чтение имени
+    void use(const QString& name, LocalSlot& slot);
+
+    /// присваивание имени: делает его локальным для функции
+    void bind(const QString& name, LocalSlot& slot);
+    void bind(const QString& name);
+
+    /// имя, объявленное `nonlocal` (или `global`), в слот не попадает
+    void exclude(const QString& name);
+
+    /// `global`: имя не попадает в слот и не захватывается из объемлющей функции
+    void declareGlobal(const QString& name);
+
+    /// вложенная область, уже разрешённая собственным проходом
+    void nested(ResolvedScope& scope);
+
+private:
+    std::vector<QString> bound;
+    QSet<QString> boundSet;
+    QSet<QString> excluded;
+    QSet<QString> globals;
+    std::vector<std::pair<QString, LocalSlot*>> references;
+    std::vector<ResolvedScope*> children;
+
+    /// делает `name` свободной переменной области и тех вложенных, что его читают
+    static void capture(ResolvedScope& scope, const QString& name);
+};
+
+#endif //CPPYTHON_RESOLVER_H
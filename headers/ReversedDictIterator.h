@@ -11,6 +11,8 @@ class ReversedDictIterator : public IteratorValue {
 
     std::shared_ptr<const DictValue> dict;
     std::ptrdiff_t index;
+    std::size_t size;
+    std::uint64_t version;
 
 public:
 
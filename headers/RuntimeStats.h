@@ -0,0 +1,75 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_RUNTIMESTATS_H
+#define CPPYTHON_RUNTIMESTATS_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/**
+ * @class RuntimeStats
+ * @brief Счётчики горячих путей интерпретатора: `sys.runtime_stats()` и сводка `--stats`.
+ *
+ * @details
+ * Счётчики включены всегда — это инкремент статической переменной, без проверок
+ * флагов. Выделения считаются по типам объектов в makePooled: через него создаются
+ * все короткоживущие объекты (кортежи, строки, кадры, связанные методы, итераторы),
+ * счётчик типа находится один раз на экземпляр шаблона. Остальные события
+ * отмечаются в местах, где они происходят: конструкторах окружения и служебных
+ * исключений, инлайн-кэше атрибутов, перестройке таблицы словаря, замене
+ * инструкций суперинструкциями и их деоптимизации, дописывании строки на месте.
+ */
+class RuntimeStats {
+public:
+    enum Counter : std::size_t {
+        Environments,
+        StopIterations,
+        Breaks,
+        Continues,
+        AttributeErrors,
+        AttributeCacheHits,
+        AttributeCacheMisses,
+        DictResizes,
+        Superinstructions,
+        Deoptimizations,
+        StrAppends,
+        CounterCount
+    };
+
+    /// печатать сводку в stderr при выходе (`--stats`)
+    static inline bool dumpOnExit = false;
+
+    static void add(const Counter counter) {
+        ++counters[counter];
+    }
+
+    /// выделение объекта типа `T` через ObjectPool
+    template<typename T>
+    static void allocated() {
+        static std::uint64_t& count = allocationCounter(typeid(T));
+        ++count;
+    }
+
+    /// все счётчики по именам: сначала события, затем `alloc.<тип>`
+    [[nodiscard]] static std::vector<std::pair<std::string, std::uint64_t>> snapshot();
+
+    /// печатает ненулевые счётчики в stderr
+    static void report();
+
+private:
+    static inline std::array<std::uint64_t, CounterCount> counters = {};
+
+    /// ссылка стабильна: узлы std::map не перемещаются
+    static std::map<std::string, std::uint64_t>& allocations();
+
+    static std::uint64_t& allocationCounter(const std::type_info& type);
+};
+
+#endif //CPPYTHON_RUNTIMESTATS_H
@@ -0,0 +1,71 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_SEARCHKERNELS_H
+#define CPPYTHON_SEARCHKERNELS_H
+
+#include <cstddef>
+#include <vector>
+
+#include <QtGlobal>
+
+/**
+ * Поиск подстроки для str (char16_t) и bytes (char).
+ *
+ * Короткий образец ищется фильтром по первому и последнему символу: за шаг
+ * сравнивается 64-битное слово текста — восемь байтов или четыре символа
+ * UTF-16, — и полное сравнение запускается только в позициях, где совпали оба
+ * края. Длинный образец ищется двусторонним алгоритмом Крошмора — Перрена:
+ * линейное время в худшем случае и O(1) памяти сверх самого образца.
+ * Обратный поиск — тот же алгоритм над перевёрнутыми текстом и образцом.
+ */
+namespace searchkernels {
+
+    /// образец короче этого ищется фильтром по краям, длиннее — двусторонним алгоритмом
+    constexpr qsizetype twoWayThreshold = 32;
+
+    /// критическая факторизация образца для двустороннего алгоритма
+    struct Factorization {
+        std::size_t suffix = 0;
+        std::size_t period = 0;
+        /// образец периодичен с period — при сдвиге запоминается совпавший префикс
+        bool periodic = false;
+    };
+
+    /**
+     * @class Pattern
+     * @brief Образец, подготовленный один раз для нескольких поисков (count, replace, split).
+     *
+     * Символы образца не копируются: буфер должен жить дольше Pattern.
+     */
+    template<typename Char>
+    class Pattern {
+    public:
+        Pattern(const Char* needle, qsizetype size);
+
+        [[nodiscard]] qsizetype size() const {
+            return length;
+        }
+
+        /// первое вхождение в text[from, size) или -1; пустой образец находится в from
+        [[nodiscard]] qsizetype find(const Char* text, qsizetype size, qsizetype from = 0) const;
+
+        /// последнее вхождение, целиком лежащее в text[0, end), или -1; пустой образец — end
+        [[nodiscard]] qsizetype rfind(const Char* text, qsizetype end) const;
+
+        /// позиции не более limit неперекрывающихся вхождений (limit < 0 — всех) слева направо
+        [[nodiscard]] std::vector<qsizetype> findAll(const Char* text, qsizetype size, long long limit = -1) const;
+
+    private:
+        const Char* needle;
+        qsizetype length;
+        Factorization forward;
+        Factorization backward;
+    };
+
+    extern template class Pattern<char>;
+    extern template class Pattern<char16_t>;
+}
+
+#endif //CPPYTHON_SEARCHKERNELS_H
@@ -12,7 +12,7 @@
 class SetIterator : public IteratorValue {
 public:
     std::shared_ptr<SetValue> set;
-    int index = 0;
+    std::size_t index = 0;
 
     explicit SetIterator(std::shared_ptr<SetValue> set)
         : set(std::move(set)) {}
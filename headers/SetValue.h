@@ -5,20 +5,19 @@
 #ifndef CPPYTHON_SETVALUE_H
 #define CPPYTHON_SETVALUE_H
 #include <QString>
-#include <qset.h>
 
 #include "ObjectValue.h"
-
-class Value;
+#include "OrderedValueSet.h"
 
 class SetValue : public ObjectValue, public std::enable_shared_from_this<SetValue> {
 public:
 
-    explicit SetValue(const QSet<Value>& elements = {}, const QList<Value>& order = {})
-        : elements(elements), order(order) {}
+    SetValue() = default;
+
+    explicit SetValue(OrderedValueSet elements)
+        : elements(std::move(elements)) {}
 
-    QSet<Value> elements;
-    QList<Value> order;
+    OrderedValueSet elements;
 
     [[nodiscard]] QString toString() const override;
 
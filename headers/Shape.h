@@ -0,0 +1,52 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_SHAPE_H
+#define CPPYTHON_SHAPE_H
+
+#include <memory>
+
+#include <QHash>
+#include <QString>
+
+/**
+ * @class Shape
+ * @brief Скрытый класс: общий для экземпляров набор имён полей и их смещений.
+ *
+ * @details
+ * Экземпляры, получившие одни и те же поля в одном порядке, разделяют один Shape
+ * и хранят значения плоским массивом по его смещениям. Добавление поля — переход
+ * к дочерней форме, который запоминается в родительской, поэтому все экземпляры,
+ * проходящие через тот же `__init__`, приходят к одной и той же форме.
+ *
+ * Корневая форма принадлежит классу и через переходы удерживает всё дерево форм
+ * его экземпляров. Формы не изменяются после создания, кроме таблицы переходов.
+ */
+class Shape {
+public:
+    /// после стольких полей новые атрибуты экземпляра хранятся в словаре
+    static constexpr int maxFields = 32;
+
+    /// смещение поля в массиве значений экземпляра или -1
+    [[nodiscard]] int offsetOf(const QString& name) const {
+        return offsets.value(name, -1);
+    }
+
+    [[nodiscard]] int size() const {
+        return static_cast<int>(offsets.size());
+    }
+
+    [[nodiscard]] bool isFull() const {
+        return size() >= maxFields;
+    }
+
+    /// форма с дополнительным полем `name` в конце; переход создаётся один раз
+    [[nodiscard]] std::shared_ptr<const Shape> withField(const QString& name) const;
+
+private:
+    QHash<QString, int> offsets;
+    mutable QHash<QString, std::shared_ptr<const Shape>> transitions;
+};
+
+#endif //CPPYTHON_SHAPE_H
@@ -0,0 +1,28 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_SHAREDMEMORYMODULE_H
+#define CPPYTHON_SHAREDMEMORYMODULE_H
+
+class Value;
+
+/**
+ * @class SharedMemoryModule
+ * @brief Глобальный объект `sharedmem`: `share(obj)` кладёт данные в общий сегмент.
+ *
+ * @details
+ * share() принимает bytes, bytearray, memoryview, array и vector и кортеж из
+ * одних bool, одних int или int и float. Данные копируются в новый SharedSegment
+ * один раз, результат — memoryview только для чтения над ним: байты с форматом `B`,
+ * массив — с форматом своего кода, кортеж — упакованный в `?`, `q` или `d`.
+ *
+ * Такой memoryview в элементах parallel_map передаётся рабочим ссылкой на сегмент:
+ * таблица на гигабайты не сериализуется и не копируется в каждый процесс.
+ */
+class SharedMemoryModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_SHAREDMEMORYMODULE_H
@@ -0,0 +1,83 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_SHAREDSEGMENT_H
+#define CPPYTHON_SHAREDSEGMENT_H
+#include <memory>
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QFile>
+#include <QString>
+
+#include "ObjectValue.h"
+
+/**
+ * @class SharedSegment
+ * @brief Неизменяемый блок байтов в файле, отображённом в память, — общий для процессов.
+ *
+ * @details
+ * Процесс-владелец записывает данные один раз (create()), другие процессы того же
+ * исполняемого файла отображают тот же файл по пути (attach()) и читают страницы,
+ * которые ОС держит в памяти в одном экземпляре: ни копии, ни разбора на стороне
+ * читателя. Отображение только для чтения.
+ *
+ * Время жизни — счётчик ссылок std::shared_ptr, атомарный: сегмент живёт, пока на
+ * него ссылается хоть одно значение процесса. Владелец, освобождая сегмент, удаляет
+ * файл; читатели к этому моменту должны завершиться — parallel_map держит свои
+ * элементы, пока ждёт рабочих. Повторный attach() того же пути в процессе
+ * возвращает уже открытое отображение.
+ */
+class SharedSegment {
+public:
+    /// новый сегмент с копией data; OSError, если файл не создаётся
+    [[nodiscard]] static std::shared_ptr<SharedSegment> create(QByteArrayView data);
+
+    /// сегмент другого процесса по пути его файла; OSError, если файла уже нет
+    [[nodiscard]] static std::shared_ptr<SharedSegment> attach(const QString& path);
+
+    ~SharedSegment();
+
+    SharedSegment(const SharedSegment&) = delete;
+    SharedSegment& operator=(const SharedSegment&) = delete;
+
+    /// байты прямо в отображении (QByteArray::fromRawData); действительны, пока жив сегмент
+    [[nodiscard]] const QByteArray& bytes() const { return data; }
+
+    [[nodiscard]] const QString& path() const { return file.fileName(); }
+
+private:
+    SharedSegment(const QString& path, bool owner);
+
+    QFile file;
+    QByteArray data;
+    uchar* mapped = nullptr;
+    /// сегмент создан этим процессом: файл удаляется вместе с ним
+    bool owner;
+};
+
+/**
+ * @class SharedBufferValue
+ * @brief Владелец сегмента для memoryview: вид над ним читает байты прямо из отображения.
+ *
+ * Сам по себе в скрипте виден только как `mv.obj`; данные — через memoryview.
+ */
+class SharedBufferValue final : public ObjectValue {
+public:
+    explicit SharedBufferValue(std::shared_ptr<SharedSegment> segment) : segment(std::move(segment)) {}
+
+    /// общий буфер в значении или nullptr
+    [[nodiscard]] static SharedBufferValue* of(const Value& value);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    [[nodiscard]] const QByteArray& bytes() const { return segment->bytes(); }
+    [[nodiscard]] const QString& path() const { return segment->path(); }
+
+private:
+    std::shared_ptr<SharedSegment> segment;
+};
+
+#endif //CPPYTHON_SHAREDSEGMENT_H
@@ -5,8 +5,15 @@
 #ifndef CPPYTHON_STOPITERATIONEXCEPTION_H
 #define CPPYTHON_STOPITERATIONEXCEPTION_H
 #include <exception>
+
+#include "RuntimeStats.h"
+
 class StopIterationException final : public std::exception {
 public:
+    StopIterationException() {
+        RuntimeStats::add(RuntimeStats::StopIterations);
+    }
+
     [[nodiscard]] const char* what() const noexcept override {
         return "StopIteration";
     }
@@ -4,14 +4,48 @@
 
 #ifndef CPPYTHON_STRVALUE_H
 #define CPPYTHON_STRVALUE_H
+#include <cstdint>
+#include <optional>
+
 #include "CallRuntime.h"
+#include "FormatTemplate.h"
+#include "MemoryTracker.h"
 #include "ObjectValue.h"
 #include "Value.h"
 
 class Value;
 
-class StrValue : public ObjectValue, public std::enable_shared_from_this<StrValue> {
-    QString value;
+/**
+ * @class StrValue
+ * @brief Неизменяемая строка Python.
+ *
+ * @details
+ * Длинный срез не копирует символы: он ссылается на буфер строки-владельца
+ * (`root`, `offset`, `length`) и копирует их в собственный `value` только тогда,
+ * когда методу нужен QString целиком. Длина, индексация, срезы, сравнение, хеш,
+ * поиск и разбиение работают прямо по представлению `view()`.
+ */
+class StrValue : public ObjectValue, public std::enable_shared_from_this<StrValue>,
+                 public MemoryTracked<MemoryTracker::Kind::Str> {
+    /// текст строки; у среза-представления заполняется при материализации
+    mutable QString value;
+    /// строка-владелец буфера, пока срез не материализован; сама root представлением не бывает
+    mutable std::shared_ptr<const StrValue> root;
+    qsizetype offset = 0;
+    qsizetype length = 0;
+    /// строка неизменяема — хеш считается один раз
+    mutable std::optional<std::size_t> cachedHash;
+
+public:
+    /// наибольший символ строки, как в PEP 393: определяет доступные быстрые пути
+    enum class Kind : std::uint8_t {
+        Ascii,      ///< все символы < 0x80
+        Latin1,     ///< все символы < 0x100
+        Wide        ///< остальные строки
+    };
+
+private:
+    mutable std::optional<Kind> cachedKind;
 
 public:
 
@@ -19,13 +53,53 @@ public:
 
     explicit StrValue(const char* value) : value(value) {}
 
+    /// срезы короче этого копируются: копия дешевле, чем удержание родителя
+    static constexpr qsizetype minViewLength = 32;
+
+    /**
+     * @brief Подстрока [offset, offset + length) строки source.
+     *
+     * Длинный срез становится представлением корневой строки. Короткий срез
+     * или срез, занимающий меньше четверти родителя, копируется, чтобы маленькая
+     * подстрока не удерживала в памяти огромный буфер.
+     */
+    static Value substring(const std::shared_ptr<const StrValue>& source, qsizetype offset, qsizetype length);
+
+    /// символы строки без копирования
+    [[nodiscard]] QStringView view() const {
+        return root ? QStringView(root->value).mid(offset, length) : QStringView(value);
+    }
+
+    /// текст строки; срез-представление при первом вызове копирует символы и отпускает родителя
+    [[nodiscard]] const QString& text() const {
+
+        if (root) {
+            materialize();
+        }
+
+        return value;
+    }
+
     [[nodiscard]] QString toString() const override;
 
+    /// ширина строки вычисляется при первом обращении и запоминается
+    [[nodiscard]] Kind kind() const;
+
+    [[nodiscard]] bool isAscii() const {
+        return kind() == Kind::Ascii;
+    }
+
+    /// равенство текста; интернированные атомы совпадают уже по указателю
+    [[nodiscard]] bool sameText(const StrValue& other) const {
+        return this == &other || view() == other.view();
+    }
+
     [[nodiscard]] QString repr() const override;
 
     [[nodiscard]] std::size_t len() const;
 
     [[nodiscard]] Value getItem(const Value&) const override;
+    [[nodiscard]] Value getItemInt(Value::SmallInt index) const override;
 
     [[nodiscard]] Value upper() const;
 
@@ -162,6 +236,15 @@ public:
 
     [[nodiscard]] Value add(const Value&) const override;
 
+    /**
+     * @brief Дописывает other в конец самой строки — `s += t` в цикле за O(n) вместо O(n²).
+     *
+     * Вызывается только для строки, на которую больше никто не ссылается: тогда изменение
+     * ненаблюдаемо. QString растёт с запасом ёмкости, так что следующие дописывания
+     * обычно не копируют уже накопленный текст.
+     */
+    void append(const StrValue& other);
+
     [[nodiscard]] Value multiply(const Value&) const override;
 
     [[nodiscard]] Value rmul(const Value&) const override;
@@ -194,16 +277,17 @@ public:
 
     [[nodiscard]] Value removeSuffix(const Value& suffix) const;
 
+    /// значение поля после `.attr`/`[key]`, конверсии и спецификатора; им же форматируются поля f-строк
+    static QString formatField(const FormatTemplate::Segment& segment, Value value);
+
 private:
 
-    static Value resolveFormatField(
-    const std::shared_ptr<DictValue>& dict,
-    const QString& field);
+    /// подстановка разобранного шаблона `str.format`
+    template<typename Root>
+    static Value renderFormat(const FormatTemplate& compiled, Root&& root);
 
     static Value getItemValue(const Value& obj, const Value& key);
 
-    static Value resolveEmptyFormatField(const std::shared_ptr<DictValue>& dict);
-
     static QString applyFormatSpec(
     const Value& value,
     const QString& spec);
@@ -228,10 +312,6 @@ private:
 
     static QString applyStringFormatSpec(const QString &text, const QString &spec);
 
-    [[nodiscard]] Value modTuple(const std::shared_ptr<TupleValue>& tuple) const;
-
-    [[nodiscard]] Value modSingle(const Value &rhs) const;
-
-    [[nodiscard]] Value modMapping(const Value::DictPtr & dict) const;
+    void materialize() const;
 };
 #endif //CPPYTHON_STRVALUE_H
\ No newline at end of file
@@ -0,0 +1,109 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_STREAMVALUE_H
+#define CPPYTHON_STREAMVALUE_H
+#include <memory>
+#include <vector>
+
+#include <QByteArray>
+
+#include "ObjectValue.h"
+
+class FutureValue;
+
+/**
+ * @struct StreamConnection
+ * @brief Неблокирующий сокет с буферами чтения и записи — общее состояние StreamReader и StreamWriter.
+ *
+ * Дескриптор закрывается close() или вместе с последним потоком, который на него ссылается.
+ */
+struct StreamConnection {
+    int fd = -1;
+    QByteArray input;
+    QByteArray output;
+    /// собеседник закрыл свою сторону: больше данных не будет
+    bool eof = false;
+    /// вызван StreamWriter.close(): дескриптор закроется, когда уйдёт буфер записи
+    bool closing = false;
+    /// чтение, ждущее данных; второе одновременное чтение — RuntimeError, как в CPython
+    std::shared_ptr<FutureValue> pendingRead;
+    /// drain(), ждущие опустошения буфера записи
+    std::vector<std::shared_ptr<FutureValue>> drainers;
+
+    StreamConnection() = default;
+    StreamConnection(const StreamConnection&) = delete;
+    StreamConnection& operator=(const StreamConnection&) = delete;
+
+    ~StreamConnection();
+
+    /// снимает подписки цикла событий и закрывает дескриптор; ждущие получают OSError
+    void close();
+
+    /**
+     * @brief `asyncio.open_connection(host, port)`: Future пары (StreamReader, StreamWriter).
+     *
+     * Имя разрешается getaddrinfo синхронно: у минимального цикла нет пула потоков.
+     */
+    static Value open(const QString& host, int port);
+};
+
+/**
+ * @class StreamReaderValue
+ * @brief `asyncio.StreamReader`: read(), readline() и `async for line in reader`.
+ *
+ * Методы возвращают Future; если в буфере уже есть ответ, она завершена сразу,
+ * иначе дочитывание ждёт готовности сокета в цикле событий.
+ */
+class StreamReaderValue final : public ObjectValue {
+public:
+    explicit StreamReaderValue(std::shared_ptr<StreamConnection> connection);
+
+    [[nodiscard]] static StreamReaderValue* of(const Value& value);
+
+    /// до n байт, как только появится хотя бы один; n < 0 — всё до конца потока
+    [[nodiscard]] Value read(qsizetype n) const;
+
+    /// строка с `\n` или остаток перед концом потока; b'' — поток закончился
+    [[nodiscard]] Value readline() const;
+
+    /// readline() для `async for`: в конце потока — StopAsyncIteration
+    [[nodiscard]] Value nextLine() const;
+
+    [[nodiscard]] bool atEof() const;
+
+    [[nodiscard]] QString toString() const override;
+
+private:
+    std::shared_ptr<StreamConnection> connection;
+};
+
+/**
+ * @class StreamWriterValue
+ * @brief `asyncio.StreamWriter`: write() сразу отправляет, сколько примет сокет,
+ * остаток дописывает цикл событий; `await drain()` ждёт, пока буфер опустеет.
+ */
+class StreamWriterValue final : public ObjectValue {
+public:
+    explicit StreamWriterValue(std::shared_ptr<StreamConnection> connection);
+
+    [[nodiscard]] static StreamWriterValue* of(const Value& value);
+
+    void write(QByteArrayView data) const;
+
+    /// Future, завершённая, когда буфер записи отправлен целиком
+    [[nodiscard]] Value drain() const;
+
+    /// закрывает соединение, дописав буфер
+    void close() const;
+
+    [[nodiscard]] bool isClosing() const;
+
+    [[nodiscard]] QString toString() const override;
+
+private:
+    std::shared_ptr<StreamConnection> connection;
+};
+
+#endif //CPPYTHON_STREAMVALUE_H
@@ -0,0 +1,42 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_STRINGTABLE_H
+#define CPPYTHON_STRINGTABLE_H
+
+#include <QHash>
+#include <QString>
+
+#include "Value.h"
+
+/**
+ * @class StringTable
+ * @brief Таблица интернированных строк: идентификаторов и коротких литералов.
+ *
+ * @details
+ * Равные атомы делят один буфер QString и один объект StrValue, поэтому имена
+ * из разных мест программы совпадают по указателю, а хеш строкового объекта
+ * (StrValue кэширует его) считается один раз на всю программу. Сравнение строк
+ * по-прежнему корректно и для неинтернированных значений: интернирование только
+ * ускоряет проверку, но не заменяет её.
+ *
+ * Как и в CPython, интернируются идентификаторы и литералы, похожие на идентификатор;
+ * строки, построенные во время выполнения, в таблицу не попадают.
+ */
+class StringTable {
+public:
+    /// канонический экземпляр строки — его буфер общий для всех равных атомов
+    static QString intern(const QString& str);
+
+    /// канонический объект str для литерала
+    static Value::StrPtr internStr(const QString& str);
+
+    /// литерал выглядит как идентификатор и будет интернирован
+    static bool isInternable(const QString& str);
+
+private:
+    static QHash<QString, Value::StrPtr>& table();
+};
+
+#endif //CPPYTHON_STRINGTABLE_H
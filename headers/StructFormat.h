@@ -0,0 +1,77 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_STRUCTFORMAT_H
+#define CPPYTHON_STRUCTFORMAT_H
+#include <memory>
+#include <vector>
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+
+class Value;
+
+/**
+ * @class StructFormat
+ * @brief Разобранная строка формата модуля `struct`.
+ *
+ * @details
+ * Формат разбирается один раз в список полей со смещениями, и pack()/unpack()
+ * идут по этому списку без повторного чтения строки. compile() хранит
+ * разобранные форматы в кэше, поэтому `struct.unpack('<IH', ...)` в цикле
+ * разбирает строку только при первом вызове.
+ *
+ * Порядок байтов — первый символ: `@` (по умолчанию) — родной порядок, размеры
+ * и выравнивание; `=`, `<`, `>`, `!` — стандартные размеры без выравнивания.
+ * Коды: x c b B ? h H i I l L q Q f d s p, а в родном режиме ещё n N P.
+ */
+class StructFormat {
+public:
+    /// разобранный формат из кэша; struct.error при ошибке в строке
+    [[nodiscard]] static std::shared_ptr<const StructFormat> compile(const QString& format);
+
+    /// формат из str или bytes
+    [[nodiscard]] static std::shared_ptr<const StructFormat> compile(const Value& format);
+
+    /**
+     * @brief Байты bytes, bytearray или непрерывного memoryview без копирования.
+     *
+     * Вид действителен, пока жив value и буфер не меняется в размере.
+     */
+    [[nodiscard]] static QByteArrayView bufferOf(const Value& value);
+
+    [[nodiscard]] qsizetype size() const { return length; }
+    [[nodiscard]] qsizetype items() const { return static_cast<qsizetype>(fields.size()); }
+    [[nodiscard]] const QString& text() const { return source; }
+
+    /// значения args[first..] в байты формата; struct.error при несовпадении числа или типа
+    [[nodiscard]] QByteArray pack(const std::vector<Value>& args, std::size_t first) const;
+
+    /// кортеж значений из size() байтов начиная с data
+    [[nodiscard]] Value unpack(const char* data) const;
+
+private:
+    struct Field {
+        char code;
+        /// смещение поля от начала записи
+        qsizetype offset;
+        /// длина s и p; у остальных кодов — размер одного значения
+        qsizetype size;
+    };
+
+    explicit StructFormat(const QString& format);
+
+    void packField(char* out, const Field& field, const Value& value) const;
+    [[nodiscard]] Value unpackField(const char* data, const Field& field) const;
+
+    QString source;
+    std::vector<Field> fields;
+    qsizetype length = 0;
+    bool native = true;
+    /// порядок байтов отличается от порядка процессора
+    bool swap = false;
+};
+
+#endif //CPPYTHON_STRUCTFORMAT_H
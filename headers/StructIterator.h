@@ -0,0 +1,35 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_STRUCTITERATOR_H
+#define CPPYTHON_STRUCTITERATOR_H
+#include <memory>
+
+#include "IteratorValue.h"
+#include "Value.h"
+
+class StructFormat;
+
+/**
+ * @brief Итератор `struct.iter_unpack`: по записи за шаг прямо из буфера источника.
+ *
+ * Пока итератор жив, bytearray-источник нельзя менять в размере, как и под memoryview.
+ */
+class StructIterator : public IteratorValue {
+public:
+
+    std::shared_ptr<const StructFormat> format;
+    Value source;
+    qsizetype offset = 0;
+
+    StructIterator(std::shared_ptr<const StructFormat> format, const Value& source);
+    ~StructIterator() override;
+
+    Value next() override;
+
+    [[nodiscard]] bool hasNext() const override;
+
+    [[nodiscard]] QString getTypeName() const override;
+};
+#endif //CPPYTHON_STRUCTITERATOR_H
@@ -0,0 +1,24 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_STRUCTMODULE_H
+#define CPPYTHON_STRUCTMODULE_H
+
+class Value;
+
+/**
+ * @class StructModule
+ * @brief Глобальный объект `struct`: `pack`, `unpack`, `unpack_from`, `iter_unpack`,
+ * `calcsize` и класс ошибок `struct.error`.
+ *
+ * @details
+ * Формат разбирается через кэш StructFormat::compile(), а записи читаются прямо
+ * из буфера bytes, bytearray или memoryview: срезы под каждую запись не создаются.
+ */
+class StructModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_STRUCTMODULE_H
@@ -0,0 +1,42 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_SYSMODULE_H
+#define CPPYTHON_SYSMODULE_H
+#include <cstddef>
+
+class OutputStream;
+class Value;
+
+/**
+ * @class SysModule
+ * @brief Глобальный объект `sys` с частью интерфейса модуля sys из CPython.
+ *
+ * @details
+ * `sys.getsizeof(obj)` возвращает размер самого объекта и принадлежащих ему
+ * буферов в байтах, без объектов, на которые он ссылается. Для списка в размер
+ * входит вся выделенная ёмкость, поэтому по нему видны запас на рост и ужатие
+ * буфера. Числа у нас хранятся прямо в Value, и их размер — размер Value.
+ *
+ * `sys.settrace(func)` и `sys.gettrace()` — функция трассировки Tracer.
+ *
+ * `sys.setrecursionlimit(n)` и `sys.getrecursionlimit()` — предел глубины RecursionLimit.
+ *
+ * `sys.runtime_stats()` — словарь счётчиков RuntimeStats на момент вызова.
+ *
+ * `sys.modules` и `sys.path` — кэш загруженных модулей и каталоги поиска ModuleLoader.
+ *
+ * `sys.stdout` и `sys.stderr` — объекты с методами `write` и `flush` поверх
+ * OutputStream; `print(..., file=sys.stderr)` узнаёт их и пишет в поток напрямую.
+ */
+class SysModule {
+public:
+    [[nodiscard]] static std::size_t sizeOf(const Value& value);
+
+    static Value makeModule();
+
+    /// поток OutputStream за объектом sys.stdout/sys.stderr или nullptr для прочих файлов
+    [[nodiscard]] static OutputStream* nativeStream(const Value& file);
+};
+#endif //CPPYTHON_SYSMODULE_H
@@ -0,0 +1,38 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_TASKVALUE_H
+#define CPPYTHON_TASKVALUE_H
+#include "FutureValue.h"
+
+/**
+ * @class TaskValue
+ * @brief `asyncio.Task` — сопрограмма, которую выполняет цикл событий.
+ *
+ * @details
+ * Шаг задачи возобновляет сопрограмму до следующей приостановки. Сопрограмма
+ * отдаёт Future, которую ждёт самое глубокое `await`; задача подписывается на её
+ * завершение и делает следующий шаг, когда Future готова. `None` (голый `yield`
+ * в `__await__`) — просьба уступить очередь: шаг повторяется в следующем проходе.
+ * Возврат из сопрограммы завершает задачу результатом, исключение — исключением.
+ */
+class TaskValue final : public FutureValue {
+public:
+    explicit TaskValue(Value coroutine);
+
+    /// ставит первый шаг в очередь цикла событий
+    static void start(const std::shared_ptr<TaskValue>& task);
+
+    /// закрывает незавершённую сопрограмму: цикл событий остановлен, а задача всё ещё ждёт
+    void abandon();
+
+    [[nodiscard]] QString className() const override { return "Task"; }
+
+private:
+    Value coroutine;
+
+    static void step(const std::shared_ptr<TaskValue>& task);
+};
+
+#endif //CPPYTHON_TASKVALUE_H
@@ -0,0 +1,48 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_TEXTCODEC_H
+#define CPPYTHON_TEXTCODEC_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QStringView>
+
+/**
+ * Кодеки str.encode и bytes.decode: utf-8, ascii и latin-1.
+ *
+ * Байты и символы проверяются по восемь байт (четыре символа UTF-16) за шаг
+ * одним сравнением с маской старших битов. Чисто ASCII-вход — частый случай —
+ * переписывается одним расширяющим или сужающим циклом без декодирования.
+ * UTF-8 разбирается и проверяется за один проход прямо в буфер результата;
+ * обработчик ошибок (strict, replace, ignore) вызывается только там, где
+ * встретилась неверная последовательность.
+ */
+namespace textcodec {
+
+    enum class Codec { Utf8, Ascii, Latin1 };
+
+    enum class Errors { Strict, Replace, Ignore };
+
+    /// кодек по имени без учёта регистра, `_` и `-`; LookupError — неизвестное имя
+    Codec codecOf(const QString& name);
+
+    /// обработчик ошибок по имени; LookupError — неизвестное имя
+    Errors errorsOf(const QString& name);
+
+    /// длина начального отрезка из байтов < 0x80
+    qsizetype asciiPrefix(QByteArrayView data);
+
+    /// длина начального отрезка из символов < 0x80
+    qsizetype asciiPrefix(QStringView text);
+
+    /// UnicodeDecodeError с позицией, как в CPython, — при errors = Strict
+    QString decode(QByteArrayView data, Codec codec, Errors errors);
+
+    /// UnicodeEncodeError с позицией, как в CPython, — при errors = Strict
+    QByteArray encode(QStringView text, Codec codec, Errors errors);
+}
+
+#endif //CPPYTHON_TEXTCODEC_H
@@ -0,0 +1,49 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_TEXTKERNELS_H
+#define CPPYTHON_TEXTKERNELS_H
+
+#include <cstdint>
+
+#include <QStringView>
+
+/**
+ * Ядра регистра и классификации для ASCII-строк str.
+ *
+ * Символы UTF-16 обрабатываются словами по 64 бита — четыре символа на слово,
+ * четыре слова (32 байта) за шаг цикла. Проверка диапазона в каждой 16-битной
+ * дорожке — сложение со смещением, после которого бит 0x80 дорожки говорит,
+ * попал ли символ в диапазон; переносов между дорожками нет, пока символы < 0x80.
+ * Поэтому все ядра, кроме unionBits, ожидают строку из одних ASCII-символов —
+ * вызывающий проверяет это по StrValue::isAscii() и иначе идёт через таблицы Unicode Qt.
+ */
+namespace textkernels {
+
+    /// побитовое ИЛИ всех символов: < 0x80 — строка ASCII, < 0x100 — Latin-1
+    char16_t unionBits(QStringView text);
+
+    enum class Case : std::uint8_t {
+        Upper,
+        Lower,
+        Swap
+    };
+
+    /// перевод регистра ASCII-строки в dst того же размера
+    void convertCase(QStringView text, char16_t* dst, Case mode);
+
+    /// классы isdigit()/isalpha()/isalnum()/isspace() и хвоста isidentifier()
+    enum class CharClass : std::uint8_t {
+        Digit,
+        Alpha,
+        Alnum,
+        Space,
+        Identifier  ///< буква, цифра или `_`
+    };
+
+    /// каждый символ ASCII-строки принадлежит классу; пустая строка — true
+    bool allOf(QStringView text, CharClass charClass);
+}
+
+#endif //CPPYTHON_TEXTKERNELS_H
@@ -0,0 +1,37 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_TIMEMODULE_H
+#define CPPYTHON_TIMEMODULE_H
+
+class Value;
+
+/**
+ * @class TimeModule
+ * @brief Глобальные объекты `time` и `timeit` — часы и замер кода из самого скрипта.
+ *
+ * @details
+ * time: `time`/`time_ns` (системные часы), `perf_counter`/`perf_counter_ns` и
+ * `monotonic`/`monotonic_ns` (steady_clock), `process_time`/`process_time_ns`
+ * (процессорное время процесса) и `sleep`.
+ *
+ * timeit: `timeit(stmt, setup, number=)` и `repeat(stmt, setup, repeat=, number=)`
+ * как в CPython, плюс `measure(stmt, setup, number=, repeat=)` — словарь с временем
+ * одного выполнения по каждому повтору и его минимумом и медианой; без number
+ * число выполнений подбирается как в `python -m timeit`.
+ *
+ * stmt и setup — вызываемый объект или исходный текст. Текст компилируется один
+ * раз, а цикл из number выполнений идёт в C++: байткод запускается VirtualMachine::run
+ * без разбора и компиляции на каждом шаге, объект вызывается без создания аргументов.
+ * Текст видит глобальные имена вызвавшего модуля, а свои присваивания делает в
+ * отдельной области, новой для каждого повтора. Сборщик мусора на время замера
+ * выключен, как в CPython.
+ */
+class TimeModule {
+public:
+    static Value makeTime();
+    static Value makeTimeit();
+};
+
+#endif //CPPYTHON_TIMEMODULE_H
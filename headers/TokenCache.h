@@ -0,0 +1,67 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_TOKENCACHE_H
+#define CPPYTHON_TOKENCACHE_H
+
+#include <cstdint>
+#include <optional>
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include "Lexer.h"
+
+/**
+ * @class TokenCache
+ * @brief Кэш токенов исходного файла на диске (аналог `__pycache__/*.pyc`).
+ *
+ * @details
+ * Для `script.py` результат Lexer::tokenize сохраняется в `__pycache__/script.py.tokc`
+ * рядом с файлом. Формат перемещаемый: заголовок, массив записей фиксированного размера
+ * и пул UTF-16 строк, на который записи ссылаются смещениями, — файл читается через
+ * отображение в память без разбора и без выделения памяти на запись.
+ *
+ * Запись действительна, если совпадают версия формата, размер, время изменения и хеш
+ * исходного текста. Любое несовпадение или повреждённый файл — промах: исходник
+ * токенизируется заново и кэш перезаписывается. Ошибки записи (каталог только для чтения
+ * и т.п.) молча игнорируются, как в CPython.
+ *
+ * Кэшируется только лексический разбор: байткод ссылается на поддеревья AST
+ * (`CodeObject::nodes`), поэтому дерево строится парсером при каждом запуске.
+ */
+class TokenCache {
+public:
+    /// версия формата — увеличивается при изменении лексера или раскладки записей
+    static constexpr std::uint32_t version = 4;
+
+    /// 64-битный FNV-1a хеш исходного текста — устойчив между запусками и платформами
+    static std::uint64_t hashSource(const char* data, qint64 size);
+
+    /**
+     * @brief Загружает токены из кэша, если он соответствует исходнику.
+     * @param sourcePath Путь к исходному файлу.
+     * @param mtime Время изменения исходника в миллисекундах.
+     * @param size Размер исходника в байтах.
+     * @param hash Хеш исходника (hashSource).
+     * @return Токены или nullopt при промахе.
+     */
+    static std::optional<QVector<Token>> load(const QString& sourcePath, qint64 mtime, qint64 size, std::uint64_t hash);
+
+    /**
+     * @brief Сохраняет токены исходника в кэш.
+     * @return true, если файл кэша записан.
+     */
+    static bool store(const QString& sourcePath, qint64 mtime, qint64 size, std::uint64_t hash,
+                      const QVector<Token>& tokens);
+
+    /// путь к файлу кэша для исходника
+    static QString cachePath(const QString& sourcePath);
+
+private:
+    static QByteArray serialize(qint64 mtime, qint64 size, std::uint64_t hash, const QVector<Token>& tokens);
+};
+
+#endif //CPPYTHON_TOKENCACHE_H
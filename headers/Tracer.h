@@ -0,0 +1,153 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_TRACER_H
+#define CPPYTHON_TRACER_H
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <QString>
+
+#include "Value.h"
+
+class FunctionValue;
+struct CodeObject;
+
+/**
+ * @class Tracer
+ * @brief Трассировка выполнения функций: `sys.settrace`, построчный профилировщик `--lineprofile`
+ * и место выполнения для MemoryTracker.
+ *
+ * @details
+ * События те же, что в CPython: `call` при входе в функцию Python, `line` перед каждой
+ * инструкцией её тела (и заголовком цикла на каждой итерации), `exception`, когда
+ * исключение проходит через кадр, и `return` при выходе — со значением или None,
+ * если кадр покидает исключение. Глобальная функция трассировки получает `call`
+ * и возвращает локальную для остальных событий кадра: если ответ на `call` — None,
+ * кадр не трассируется, None на прочие события оставляет прежнюю функцию.
+ * Пока вызывается функция трассировки, сама она не трассируется.
+ *
+ * Строки отмечает инструкция TraceLine, которую компилятор ставит в начало каждой
+ * инструкции тела функции и модуля. Без трассировки она стоит одной проверки флага
+ * `active`, вызов функции — одной проверки в конструкторе Frame. Кадр модуля заводится
+ * всегда: трассировка, включённая посреди модуля, сразу знает его строки. Для кадров
+ * модулей события не посылаются — как у нас, так и у `sys.settrace`, вызванного в модуле.
+ *
+ * Построчный профилировщик — встроенный потребитель тех же событий: время от
+ * события `line` до следующего события кадра относится к строке (вместе с вызовами
+ * из неё), по выходе печатается таблица с текстом строк исходника.
+ */
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// установлена функция трассировки, включён построчный профилировщик или учёт мест
+    static inline bool active = false;
+
+    /// кадр трассировки на время вызова функции Python или выполнения модуля
+    class Frame {
+    public:
+        explicit Frame(const FunctionValue& function) : entered(active && enter(function)) {}
+
+        /// кадр модуля `file` с байткодом `code`
+        Frame(const CodeObject& code, const QString& file) : entered(enterModule(code, file)) {}
+
+        /// кадр покидает исключение: событие `return` с None
+        ~Frame() {
+            if (entered) {
+                leave(Value(), false);
+            }
+        }
+
+        /// нормальный возврат: событие `return` со значением
+        Value returned(Value result) {
+            if (entered) {
+                entered = false;
+                leave(result, true);
+            }
+            return result;
+        }
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+    private:
+        bool entered;
+    };
+
+    /// `sys.settrace(func)`; None снимает трассировку
+    static void setTrace(const Value& function);
+
+    /// `sys.gettrace()`
+    static Value getTrace() { return globalTrace; }
+
+    /// событие `line`: начинается инструкция строки `line` байткода `code`
+    static void line(const CodeObject& code, int line);
+
+    /// событие `exception`: исключение выброшено в байткоде `code` или прошло через него
+    static void exception(const CodeObject& code, const std::exception& error);
+
+    /// включает построчный профилировщик
+    static void startLineProfile();
+
+    /// печатает время по строкам в stderr, если профилировщик был включён
+    static void reportLineProfile();
+
+    /// следить за текущей строкой без функции трассировки (MemoryTracker)
+    static void trackLocations(bool enabled);
+
+    /// файл и строка, которые сейчас выполняются; {"<unknown>", 0} вне кадров
+    [[nodiscard]] static std::pair<QString, int> location();
+
+private:
+    struct TraceFrame {
+        /// nullptr у кадра модуля
+        const FunctionValue* function;
+        const CodeObject* code;
+        QString file;
+        /// объект кадра для функции трассировки; создаётся при первом событии
+        Value object;
+        /// локальная функция трассировки кадра; None — события кадра не нужны
+        Value localTrace;
+        int line = 0;
+        Clock::time_point lineStart;
+    };
+
+    struct LineStats {
+        std::uint64_t hits = 0;
+        Clock::duration time{};
+        QString function;
+    };
+
+    static inline Value globalTrace;
+    static inline bool lineProfiling = false;
+    static inline bool locationTracking = false;
+    /// выполняется функция трассировки: её собственные вызовы не трассируются
+    static inline bool inTracer = false;
+    static inline std::vector<TraceFrame> frames;
+    static inline std::map<std::pair<QString, int>, LineStats> lines;
+
+    static void updateActive() {
+        active = !globalTrace.isNone() || lineProfiling || locationTracking;
+    }
+
+    static bool enter(const FunctionValue& function);
+    static bool enterModule(const CodeObject& code, const QString& file);
+    static void leave(const Value& result, bool propagate);
+
+    /// кадр, к которому относится байткод `code`, или nullptr
+    static TraceFrame* current(const CodeObject& code);
+
+    /// время до `now` относится к текущей строке кадра
+    static void closeLine(TraceFrame& frame, Clock::time_point now);
+
+    /// вызывает функцию трассировки кадра; её ответ становится локальной функцией
+    static void dispatch(TraceFrame& frame, const Value& trace, const char* event, const Value& arg);
+};
+
+#endif //CPPYTHON_TRACER_H
@@ -4,24 +4,61 @@
 
 #ifndef CPPYTHON_TUPLEVALUE_H
 #define CPPYTHON_TUPLEVALUE_H
+#include <array>
+#include <optional>
 #include <vector>
 
 #include "ObjectValue.h"
 #include "Value.h"
 
+/**
+ * @class TupleValue
+ * @brief Неизменяемый кортеж Python.
+ *
+ * @details
+ * Кортежи создаются постоянно: пары dict.items(), enumerate и zip, несколько
+ * возвращаемых значений. Сам объект берётся из ObjectPool, а буфер элементов
+ * коротких кортежей (до `maxCachedLength`) после разрушения кортежа попадает в
+ * список свободных буферов своей длины, как free list кортежей в CPython. Буфер
+ * из `acquireItems` уже имеет нужную ёмкость, поэтому новый короткий кортеж не
+ * обращается к malloc. Пустой кортеж один на весь интерпретатор.
+ */
 class TupleValue : public ObjectValue {
 public:
+    /// наибольшая длина кортежа, буфер которого переиспользуется
+    static constexpr std::size_t maxCachedLength = 8;
+    /// свободных буферов каждой длины
+    static constexpr std::size_t maxFreePerLength = 256;
+
     std::vector<Value> items;
 
     TupleValue() = default;
 
     explicit TupleValue(const std::vector<Value>& items);
 
+    explicit TupleValue(std::vector<Value>&& items) noexcept;
+
+    /// возвращает буфер короткого кортежа в список свободных
+    ~TupleValue() override;
+
+    /// общий пустой кортеж: `() is ()`
+    [[nodiscard]] static Value empty();
+
+    /// кортеж из готовых элементов без копирования; пустой — общий
+    [[nodiscard]] static Value make(std::vector<Value> items);
+
+    /// кортеж из двух элементов на переиспользуемом буфере — для items(), enumerate
+    [[nodiscard]] static Value pair(Value first, Value second);
+
+    /// пустой вектор с ёмкостью length; для коротких длин — из списка свободных буферов
+    [[nodiscard]] static std::vector<Value> acquireItems(std::size_t length);
+
     [[nodiscard]] QString toString() const override;
 
     [[nodiscard]] QString repr() const override;
 
     [[nodiscard]] Value getItem(const Value& index) const override;
+    [[nodiscard]] Value getItemInt(Value::SmallInt index) const override;
 
     [[nodiscard]] Value count(const Value& value) const;
 
@@ -53,6 +90,13 @@ public:
     [[nodiscard]] std::size_t hash() const override;
 
     [[nodiscard]] bool contains(const Value& value) const override;
+
+private:
+    /// элементы не меняются после создания — хеш считается один раз
+    mutable std::optional<std::size_t> cachedHash;
+
+    /// намеренно не разрушается: кортежи освобождаются и из статических деструкторов
+    static std::array<std::vector<std::vector<Value>>, maxCachedLength + 1>& freeLists();
 };
 
 #endif //CPPYTHON_TUPLEVALUE_H
\ No newline at end of file
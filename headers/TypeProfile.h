@@ -0,0 +1,53 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_TYPEPROFILE_H
+#define CPPYTHON_TYPEPROFILE_H
+
+#include <cstdint>
+#include <memory>
+
+#include <QString>
+
+struct CodeObject;
+
+/**
+ * @class TypeProfile
+ * @brief Профиль специализации байткода между запусками одного скрипта.
+ *
+ * @details
+ * При выходе из `script.py` в `__pycache__/script.py.prof` записывается, какие
+ * инструкции арифметики и сравнений успели перейти в быструю форму (BinaryOpInt,
+ * CompareOpFloat, ...) и какой байткод стал горячим. При следующем запуске того же
+ * исходника байткод сразу после компиляции получает эти формы и суперинструкции,
+ * не проходя разогрев заново.
+ *
+ * Байткод опознаётся по строке начала и хешу его инструкций, поэтому профиль
+ * переживает ленивую компиляцию функций в любом порядке. Файл действителен, только
+ * если совпадают версия формата и хеш исходника. Быстрые формы остаются под той же
+ * проверкой типов, что и при обычной специализации: неверный профиль стоит только
+ * деоптимизации, а не неверного результата.
+ *
+ * Кэши атрибутов и вызовов (InlineCache) не сохраняются: их записи держат классы
+ * и функции текущего процесса.
+ */
+class TypeProfile {
+public:
+    /// версия формата — увеличивается при изменении записей или набора быстрых форм
+    static constexpr std::uint32_t version = 2;
+
+    /// начинает профиль запуска sourcePath и загружает профиль прошлого запуска
+    static void open(const QString& sourcePath);
+
+    /// запоминает скомпилированный байткод и применяет к нему загруженный профиль
+    static void attach(const std::shared_ptr<const CodeObject>& code);
+
+    /// записывает профиль живого байткода; ошибки записи игнорируются
+    static void save();
+
+    /// путь к файлу профиля для исходника
+    static QString profilePath(const QString& sourcePath);
+};
+
+#endif //CPPYTHON_TYPEPROFILE_H
@@ -1,13 +1,17 @@
 #ifndef VALUE_H
 #define VALUE_H
 
+#ifdef CPPYTHON_USE_GMP
+#include <boost/multiprecision/gmp.hpp>
+#else
 #include <boost/multiprecision/cpp_int.hpp>
+#endif
 #include <boost/multiprecision/cpp_dec_float.hpp>
 
 #include "BuiltinFunction.h"
-#include "ReprMixin.h"
 
 class FrozenSetValue;
+class RangeValue;
 class ObjectValue;
 class ByteArrayValue;
 class SliceValue;
@@ -41,8 +45,13 @@ class FunctionValue;
  *
  * Класс предоставляет конструкторы для инициализации экземпляра `Value` различными типами,
  * автоматически управляя выделением памяти для сложных типов с использованием умных указателей.
+ *
+ * Машинные целые, double и bool хранятся на месте, все остальные типы — одним указателем
+ * с подсчётом ссылок, включая длинные целые и decimal. Поэтому Value занимает три машинных
+ * слова, а копирование и перемещение не копируют цифры числа и не бросают исключений:
+ * векторы значений при росте перемещают элементы, а не копируют их.
  */
-class Value : public ReprMixin {
+class Value {
 public:
 
     using ListPtr = std::shared_ptr<ListValue>;
@@ -51,9 +60,23 @@ public:
 
     using FunctionPtr = std::shared_ptr<FunctionValue>;
 
+    /// Целые, помещающиеся в машинное слово, хранятся без boost::cpp_int и без выделений памяти
+    using SmallInt = std::int64_t;
+    /// длинная арифметика GMP, если она найдена при сборке (CPPYTHON_GMP), иначе cpp_int из Boost
+#ifdef CPPYTHON_USE_GMP
+    using BigInt = boost::multiprecision::mpz_int;
+#else
     using BigInt = boost::multiprecision::cpp_int;
+#endif
+    /// Вещественные числа по умолчанию — аппаратный IEEE double, как float в CPython
+    using Float = double;
+    /// 50-значная десятичная арифметика, доступна явно через встроенную функцию decimal()
     using BigFloat = boost::multiprecision::cpp_dec_float_50;
 
+    /// неизменяемые длинные числа разделяются копиями Value
+    using BigIntPtr = std::shared_ptr<const BigInt>;
+    using BigFloatPtr = std::shared_ptr<const BigFloat>;
+
     using ClassPtr = std::shared_ptr<ClassValue>;
     using InstancePtr = std::shared_ptr<InstanceValue>;
     using BoundMethodPtr = std::shared_ptr<BoundMethod>;
@@ -86,9 +109,13 @@ public:
 
     using FrozenSetPtr = std::shared_ptr<FrozenSetValue>;
 
+    using RangePtr = std::shared_ptr<RangeValue>;
+
     std::variant<
-        BigInt,
-        BigFloat,
+        SmallInt,
+        BigIntPtr,
+        Float,
+        BigFloatPtr,
         bool,
         StrPtr,
         BytesPtr,
@@ -113,14 +140,17 @@ public:
         ByteArrayPtr,
         ObjectPtr,
         FrozenSetPtr,
+        RangePtr,
         std::monostate
         //В будущем здесь появятся еще типы (наверное)>;
     > data;
 
     Value() : data(std::monostate{}) {}
 
-    explicit Value(BigInt integer) : data(integer) {}
-    explicit Value(BigFloat number) : data(number) {}
+    explicit Value(const SmallInt integer) : data(integer) {}
+    explicit Value(const BigInt& integer);
+    explicit Value(const Float number) : data(number) {}
+    explicit Value(const BigFloat& number) : data(std::make_shared<BigFloat>(number)) {}
     explicit Value(bool boolean) : data(boolean) {}
 
     explicit Value(const StrPtr& str) : data(str) {}
@@ -166,23 +196,39 @@ public:
 
     explicit Value(const FrozenSetPtr& frozenSet): data(frozenSet) {}
 
-    [[nodiscard]] QString toString() const override;
-    [[nodiscard]] QString repr() const override;
+    explicit Value(const RangePtr& range) : data(range) {}
+
+    /// встроенный объект без собственной альтернативы в variant, например модуль
+    explicit Value(const ObjectPtr& object) : data(object) {}
+
+    [[nodiscard]] QString toString() const;
+    [[nodiscard]] QString repr() const;
     [[nodiscard]] QString display() const;
 
     [[nodiscard]] bool isBool() const;
     [[nodiscard]] bool toBool() const;
 
     [[nodiscard]] bool isNone() const;
+
+    /// единственный объект NotImplemented: результат операции, не поддерживающей тип операнда
+    static Value notImplemented();
+    [[nodiscard]] bool isNotImplemented() const;
+
     [[nodiscard]] BigFloat toBigFloat() const;
+    [[nodiscard]] Float toDouble() const;
     [[nodiscard]] BigInt toBigInt() const;
     [[nodiscard]] bool isNumeric() const;
     [[nodiscard]] bool isCallable() const;
 
+    /// true для любого целого (SmallInt или BigInt)
     [[nodiscard]] bool isBigInt() const;
+    [[nodiscard]] bool isSmallInt() const;
     [[nodiscard]] BigInt asBigInt(const QString& = "") const;
 
+    /// true для любого вещественного (Float или BigFloat)
     [[nodiscard]] bool isBigFloat() const;
+    [[nodiscard]] bool isDouble() const;
+    [[nodiscard]] bool isDecimal() const;
     [[nodiscard]] BigFloat asBigFloat(const QString& = "") const;
 
     [[nodiscard]] bool isList() const;
@@ -238,6 +284,10 @@ public:
 
     [[nodiscard]] bool isHashable() const;
     [[nodiscard]] std::size_t hash() const;
+    /// равенство ключей хеш-таблиц: строки сравниваются напрямую, начиная с тождества
+    [[nodiscard]] bool keyEquals(const Value& other) const;
+    /// равенство элементов контейнера: один и тот же объект равен себе без вызова ==, как в CPython
+    [[nodiscard]] bool itemEquals(const Value& other) const;
 
     [[nodiscard]] bool isIterable() const;
     [[nodiscard]] IteratorPtr getIterator() const;
@@ -261,6 +311,9 @@ public:
     [[nodiscard]] bool isFrozenSet() const;
     [[nodiscard]] FrozenSetPtr asFrozenSet(const QString& = "") const;
 
+    [[nodiscard]] bool isRange() const;
+    [[nodiscard]] RangePtr asRange() const;
+
     [[nodiscard]] Value operator*(const Value&) const;
 
     [[nodiscard]] Value operator/(const Value&) const;
@@ -328,8 +381,13 @@ public:
     overloaded(Ts...) -> overloaded<Ts...>;
 
     static QString formatFloat(const BigFloat& num);
+    static QString formatDouble(Float num);
 
 };
 
+static_assert(std::is_nothrow_move_constructible_v<Value> && std::is_nothrow_move_assignable_v<Value>,
+              "Value must relocate without copying");
+static_assert(sizeof(Value) <= 3 * sizeof(void*), "Value must stay three machine words");
+
 size_t qHash(const Value& value, size_t seed = 0);
 #endif //VALUE_H
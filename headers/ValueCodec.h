@@ -0,0 +1,45 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_VALUECODEC_H
+#define CPPYTHON_VALUECODEC_H
+#include <QByteArray>
+
+#include "Value.h"
+
+/**
+ * Двоичная сериализация значений для передачи между процессами интерпретатора.
+ *
+ * Поддерживаются None, bool, int, float, decimal, str, bytes, bytearray и
+ * tuple, list, dict, set, frozenset из них. Значение — байт тега и данные:
+ * машинные целые (zigzag), длины и номера ссылок — varint LEB128, float —
+ * 8 байт в порядке хоста (читает тот же исполняемый файл), str — UTF-8,
+ * длинное целое и decimal — десятичным текстом.
+ *
+ * Каждый str, bytes и контейнер получает номер при первой записи, повторная
+ * встреча — ссылка на номер, поэтому общие объекты читаются общими, а циклы
+ * через list, dict и set сохраняются. Кортеж, содержащий сам себя, — TypeError.
+ * Остальные типы — TypeError `cannot serialize 'X' object`.
+ *
+ * С shareSegments memoryview над общим сегментом (SharedSegment) пишется не
+ * байтами, а путём файла сегмента и положением вида: читатель отображает тот же
+ * файл. Такая запись действительна, только пока жив сегмент процесса-владельца, —
+ * её используют parallel_map и его рабочие, но не marshal.
+ */
+namespace valuecodec {
+
+    /// дописывает value в конец out
+    void encode(const Value& value, QByteArray& out, bool shareSegments = false);
+
+    /**
+     * @brief Читает одно значение из data начиная с pos и сдвигает pos за него.
+     *
+     * Обрезанные или повреждённые данные — ValueError. Блобы читаются прямо из
+     * data, поэтому data может быть QByteArray::fromRawData над отображённым файлом.
+     * Ссылка на общий сегмент читается только с shareSegments, иначе — ValueError.
+     */
+    Value decode(const QByteArray& data, qsizetype& pos, bool shareSegments = false);
+}
+
+#endif //CPPYTHON_VALUECODEC_H
@@ -0,0 +1,20 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_VECMATHMODULE_H
+#define CPPYTHON_VECMATHMODULE_H
+
+class Value;
+
+/**
+ * @class VecMathModule
+ * @brief Глобальный объект `vecmath`: конструктор `vector(iterable, typecode='d')`
+ * (VectorValue) и число потоков поэлементных ядер `set_threads(n)`, `get_threads()`.
+ */
+class VecMathModule {
+public:
+    static Value makeModule();
+};
+
+#endif //CPPYTHON_VECMATHMODULE_H
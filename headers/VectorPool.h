@@ -0,0 +1,84 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_VECTORPOOL_H
+#define CPPYTHON_VECTORPOOL_H
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @class VectorPool
+ * @brief Список свободных векторов для стеков и аргументов вызовов.
+ *
+ * @details
+ * Каждый вызов функции заводит стек значений, стек блоков цикла и вектор
+ * аргументов. Вектор, выданный `acquire()`, после использования очищается и
+ * возвращается в список вместе с выделенной памятью, поэтому следующий вызов той
+ * же глубины получает готовый буфер. При рекурсии каждый уровень держит свой
+ * вектор, и после прогрева цепочка вызовов не обращается к malloc.
+ *
+ * Векторы, выросшие больше `maxRetainedCapacity`, не сохраняются, чтобы одна
+ * глубокая рекурсия или огромный литерал не удерживали память навсегда.
+ */
+template<typename T>
+class VectorPool {
+public:
+    static constexpr std::size_t maxFree = 256;
+    static constexpr std::size_t maxRetainedCapacity = 1024;
+
+    /// владеет вектором из пула и возвращает его туда при разрушении
+    class Lease {
+    public:
+        explicit Lease(std::unique_ptr<std::vector<T>> items) : items(std::move(items)) {}
+
+        Lease(Lease&&) noexcept = default;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease& operator=(Lease&&) = delete;
+
+        ~Lease() {
+            if (items) {
+                release(std::move(items));
+            }
+        }
+
+        std::vector<T>& operator*() const { return *items; }
+        std::vector<T>* operator->() const { return items.get(); }
+
+    private:
+        std::unique_ptr<std::vector<T>> items;
+    };
+
+    [[nodiscard]] static Lease acquire() {
+
+        auto& list = freeList();
+
+        if (list.empty()) {
+            return Lease(std::make_unique<std::vector<T>>());
+        }
+
+        auto items = std::move(list.back());
+        list.pop_back();
+
+        return Lease(std::move(items));
+    }
+
+private:
+    /// намеренно не разрушается: векторы могут возвращаться из статических деструкторов
+    static std::vector<std::unique_ptr<std::vector<T>>>& freeList() {
+        static auto* list = new std::vector<std::unique_ptr<std::vector<T>>>();
+        return *list;
+    }
+
+    static void release(std::unique_ptr<std::vector<T>> items) {
+
+        items->clear();
+
+        if (auto& list = freeList(); list.size() < maxFree && items->capacity() <= maxRetainedCapacity) {
+            list.push_back(std::move(items));
+        }
+    }
+};
+#endif //CPPYTHON_VECTORPOOL_H
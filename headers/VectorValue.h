@@ -0,0 +1,74 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_VECTORVALUE_H
+#define CPPYTHON_VECTORVALUE_H
+#include "ArrayKernels.h"
+#include "PackedValue.h"
+
+/**
+ * @class VectorValue
+ * @brief `vecmath.vector` — неизменяемый числовой вектор с поэлементной арифметикой.
+ *
+ * @details
+ * Хранение — как у array.array (PackedValue), но операторы числовые, как в numpy:
+ * `v + w`, `v - 1`, `2.0 * v`, `v / w` считаются поэлементно ядрами
+ * arraykernels. Вектор из одного элемента и число растягиваются на длину
+ * другого операнда. Тип результата — `q`, если оба операнда целые и помещаются
+ * в int64, иначе `d`; `/` всегда даёт `d`.
+ *
+ * Сравнения `<`, `==`... в интерпретаторе возвращают bool, поэтому маски дают
+ * методы lt(), le(), gt(), ge(), eq(), ne(): вектор `B` из 0 и 1. Маска
+ * выбирает элементы индексом: `v[v.gt(0)]`.
+ */
+class VectorValue final : public PackedValue {
+public:
+    VectorValue(char typecode, QByteArray data);
+
+    /// vector в значении или nullptr
+    [[nodiscard]] static VectorValue* of(const Value& value);
+
+    [[nodiscard]] static Value make(char typecode, QByteArray data);
+
+    [[nodiscard]] QString toString() const override;
+    [[nodiscard]] QString repr() const override { return toString(); }
+
+    /// индекс, срез или маска той же длины
+    [[nodiscard]] Value getItem(const Value& index) const override;
+
+    [[nodiscard]] bool contains(const Value& value) const override;
+
+    /// все элементы равны поэлементно, как у array
+    [[nodiscard]] bool equal(const Value& other) const override;
+    [[nodiscard]] bool notEqual(const Value& other) const override;
+
+    [[nodiscard]] Value add(const Value& other) const override;
+    [[nodiscard]] Value sub(const Value& other) const override;
+    [[nodiscard]] Value multiply(const Value& other) const override;
+    [[nodiscard]] Value truediv(const Value& other) const override;
+
+    [[nodiscard]] Value radd(const Value& other) const override;
+    [[nodiscard]] Value rsub(const Value& other) const override;
+    [[nodiscard]] Value rmul(const Value& other) const override;
+    [[nodiscard]] Value rtruediv(const Value& other) const override;
+
+    /// маска `B` поэлементного сравнения с вектором или числом
+    [[nodiscard]] Value compare(arraykernels::Compare op, const Value& other) const;
+
+    /// скалярное произведение векторов одной длины
+    [[nodiscard]] Value dot(const Value& other) const;
+
+    /// вектор кода target с теми же значениями
+    [[nodiscard]] Value astype(char target) const;
+
+private:
+    /**
+     * @brief Поэлементная операция; NotImplemented — other не вектор и не число.
+     *
+     * reflected: self — правый операнд (`2 - v`).
+     */
+    [[nodiscard]] Value arithmetic(arraykernels::Op op, const Value& other, bool reflected) const;
+};
+
+#endif //CPPYTHON_VECTORVALUE_H
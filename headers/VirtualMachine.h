@@ -0,0 +1,170 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_VIRTUALMACHINE_H
+#define CPPYTHON_VIRTUALMACHINE_H
+
+#include <deque>
+#include <exception>
+#include <memory>
+#include <optional>
+
+#include "Bytecode.h"
+#include "Environment.h"
+#include "VectorPool.h"
+
+class FunctionValue;
+
+/// блок цикла: адреса выхода по break и продолжения, глубина стека на входе
+struct LoopBlock {
+    std::int32_t breakTarget;
+    std::int32_t continueTarget;
+    std::size_t stackDepth;
+};
+
+/**
+ * @struct Frame
+ * @brief Состояние выполнения байткода: стек значений, блоки циклов, счётчик команд.
+ *
+ * Вызов из C++ держит кадр на стеке C++ до возврата, вызовы функций Python из байткода
+ * получают кадры в куче (Activation). Генератор хранит кадр у себя: между
+ * приостановками в нём остаются промежуточные значения и итераторы незавершённых
+ * циклов, а локальные переменные — в слотах окружения вызова.
+ */
+struct Frame {
+    VectorPool<Value>::Lease stack = VectorPool<Value>::acquire();
+    VectorPool<LoopBlock>::Lease blocks = VectorPool<LoopBlock>::acquire();
+    std::int32_t pc = 0;
+    Value last;
+    /// выполнение остановилось на YieldValue и может быть продолжено
+    bool suspended = false;
+    /// кадр передал вызов функции циклу execute и продолжится с `pc`, когда она вернёт значение
+    bool calling = false;
+};
+
+/// кадр функции Python, которую цикл execute выполняет сам, без рекурсии C++
+struct Activation {
+    std::shared_ptr<const CodeObject> code;
+    std::shared_ptr<Environment> env;
+    Frame frame;
+    /// хвостовые вызовы, которые переиспользовали кадр; глубину они занимают, как в CPython
+    int tailCalls = 0;
+};
+
+/**
+ * @class VirtualMachine
+ * @brief Стековая виртуальная машина, выполняющая байткод, построенный Compiler.
+ *
+ * @details
+ * Цикл выполнения работает с плоским массивом инструкций и стеком значений:
+ * управляющие конструкции превращаются в переходы, а `break`/`continue` внутри
+ * скомпилированного цикла — в переходы по блоку цикла без исключений.
+ * Исключения BreakException/ContinueException, пришедшие из узлов, вычисляемых
+ * рекурсивно (`EvalNode`), перехватываются и обрабатываются тем же блоком.
+ *
+ * Остальные исключения C++ ищут обработчик `try` в таблице исключений CodeObject
+ * по адресу выброшенной инструкции; если его нет, исключение уходит вызывающему.
+ *
+ * Арифметика и сравнения специализируются по ходу выполнения: после нескольких
+ * выполнений с операндами одного вида (два машинных целых, два float, две str)
+ * инструкция переписывается в быструю форму с проверкой типов. Если проверка
+ * не проходит, инструкция возвращается к общей форме и специализируется снова
+ * не раньше, чем через `backoff` выполнений.
+ *
+ * Горячий байткод — вошли в него или прошли обратный переход цикла `hotThreshold` раз —
+ * один раз переписывается суперинструкциями (fuse): частые последовательности
+ * «два операнда и арифметика», «составное присваивание локальной переменной» и
+ * «сравнение с условным переходом» выполняются одной инструкцией прямо над слотами
+ * кадра, без промежуточных значений на стеке. Если операнды не int и не float
+ * одного вида или слот не связан, суперинструкция навсегда возвращает исходную
+ * первую инструкцию и последовательность выполняется по-обычному с того же адреса.
+ */
+class VirtualMachine {
+public:
+    /**
+     * @brief Выполняет байткод в заданном окружении.
+     * @param code Скомпилированная инструкция.
+     * @param env Окружение, в котором читаются и записываются переменные.
+     * @return Значение последней выполненной инструкции-выражения.
+     */
+    static Value run(const CodeObject& code, const std::shared_ptr<Environment>& env);
+
+    /**
+     * @brief Выполняет кадр с `frame.pc` до возврата, конца байткода или YieldValue.
+     *
+     * На YieldValue кадр запоминает адрес продолжения, `frame.suspended` становится
+     * true, а результатом будет выданное значение. Перед возобновлением вызывающий
+     * кладёт на стек кадра значение, которое вернёт выражение `yield`.
+     *
+     * Вызовы функций Python с байткодом (не генераторов и не сопрограмм) этот же цикл
+     * выполняет сам: кадр вызываемой кладётся в стек активаций в куче, по возврату
+     * результат попадает на стек вызывающего, а необработанное исключение выбрасывается
+     * снова в вызывающем кадре на адресе вызова. Поэтому рекурсия в Python не расходует
+     * стек C++, и её глубину ограничивает только RecursionLimit. При трассировке и
+     * профилировании вызовы идут через callFunction — события кадров остаются прежними.
+     */
+    static Value execute(const CodeObject& code, const std::shared_ptr<Environment>& env, Frame& frame);
+
+    /// входов и обратных переходов, после которых байткод переписывается суперинструкциями
+    static constexpr std::int32_t hotThreshold = 256;
+
+    /**
+     * @brief Переводит инструкцию at в быструю форму, известную заранее (TypeProfile).
+     * @return false, если fast — не быстрая форма этой инструкции; инструкция не меняется.
+     */
+    static bool prespecialize(const CodeObject& code, std::size_t at, OpCode fast);
+
+    /// считает байткод горячим сразу, не дожидаясь hotThreshold входов
+    static void preheat(const CodeObject& code);
+
+private:
+    /// выполнений общей формы до попытки специализации
+    static constexpr std::int32_t warmup = 8;
+
+    /// столько выполнений общей формы после неудачной специализации или проверки типов
+    static constexpr std::int32_t backoff = 64;
+
+    /// быстрая форма инструкции для данных операндов или её собственный код операции
+    static OpCode specialize(Instruction& instr, const Value& l, const Value& r);
+
+    /// сравнение в быстрой форме; nullopt, если типы операндов не совпали с ожидаемыми
+    static std::optional<bool> compareSpecialized(const Instruction& instr, const Value& l, const Value& r);
+
+    /// возвращает инструкцию к общей форме
+    static void deoptimize(Instruction& instr, OpCode generic);
+
+    /// отмечает вход или обратный переход; на пороге переписывает байткод суперинструкциями
+    static void heatUp(const CodeObject& code) {
+        if (code.heat < hotThreshold && ++code.heat == hotThreshold) {
+            fuse(code);
+        }
+    }
+
+    /// заменяет подходящие последовательности инструкций суперинструкциями
+    static void fuse(const CodeObject& code);
+
+    /**
+     * @brief Один кадр: до возврата, YieldValue или передачи вызова в calls (`frame.calling`).
+     *
+     * error — исключение вложенного вызова: оно выбрасывается снова на адресе вызова
+     * и ищет обработчик в таблице исключений этого кадра.
+     */
+    static Value executeFrame(const CodeObject& code, const std::shared_ptr<Environment>& env, Frame& frame,
+                              std::deque<Activation>& calls, std::exception_ptr& error);
+
+    /// функция выполняется кадром в куче: есть байткод, не генератор, нет трассировки и профилирования
+    static bool runsInline(const FunctionValue& func);
+
+    /**
+     * @brief Передаёт вызов func с окружением local циклу execute.
+     *
+     * `return f(...)` самой себя вне `try` — хвостовой вызов: кадр в куче
+     * переиспользуется с новым окружением, и память под кадры не растёт. Глубину
+     * хвостовой вызов всё равно занимает: бесконечная рекурсия остаётся RecursionError.
+     */
+    static void enterCall(const CodeObject& code, std::int32_t pc, Frame& frame, std::deque<Activation>& calls,
+                          const FunctionValue& func, std::shared_ptr<Environment> local);
+};
+
+#endif //CPPYTHON_VIRTUALMACHINE_H
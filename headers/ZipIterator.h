@@ -0,0 +1,28 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ZIPITERATOR_H
+#define CPPYTHON_ZIPITERATOR_H
+#include <vector>
+
+#include "LookaheadIterator.h"
+
+/// zip(*iterables): кортежи элементов, заканчивается вместе с самым коротким источником
+class ZipIterator : public LookaheadIterator {
+public:
+    ZipIterator(std::vector<Value> sources, std::shared_ptr<Environment> env);
+
+    [[nodiscard]] QString getTypeName() const override;
+
+    [[nodiscard]] bool pairwise() const override { return sources.size() == 2; }
+
+protected:
+    bool produce(Value& out) override;
+
+    bool producePair(Value& first, Value& second) override;
+
+private:
+    std::vector<Value> sources;
+};
+#endif //CPPYTHON_ZIPITERATOR_H
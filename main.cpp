@@ -1,6 +1,5 @@
 #include "Interpreter.h"
 
 int main(const int argc, char *argv[]) {
-    Interpreter::run(argc, argv);
-    return 0;
+    return Interpreter::run(argc, argv);
 }
\ No newline at end of file
@@ -4,8 +4,12 @@
 
 #ifndef CPPYTHON_ARGVALIDATION_H
 #define CPPYTHON_ARGVALIDATION_H
+#include <algorithm>
+#include <utility>
 #include <vector>
 
+#include <QString>
+
 #include "Value.h"
 
 inline void expectArgs(
@@ -35,4 +39,25 @@ inline void expectArgsRange(
              " and " + QString::number(max) + " args").toStdString());
         }
 }
+
+/// именованный аргумент name; nullptr — не передан
+inline const Value* findKwarg(
+    const std::vector<std::pair<QString, Value>>& kwargs,
+    const QString& name) {
+
+    const auto it = std::find_if(kwargs.begin(), kwargs.end(),
+        [&](const auto& pair) { return pair.first == name; });
+
+    return it == kwargs.end() ? nullptr : &it->second;
+}
+
+/// аргумент по позиции index или по имени name; nullptr — не передан
+inline const Value* option(
+    const std::vector<Value>& args,
+    const std::vector<std::pair<QString, Value>>& kwargs,
+    const size_t index,
+    const QString& name) {
+
+    return index < args.size() ? &args[index] : findKwarg(kwargs, name);
+}
 #endif //CPPYTHON_ARGVALIDATION_H
\ No newline at end of file
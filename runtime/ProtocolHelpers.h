@@ -6,9 +6,38 @@
 #define CPPYTHON_PROTOCOLHELPERS_H
 #include "CallRuntime.h"
 #include "ClassUtils.h"
+#include "ListValue.h"
 #include "RuntimeUtils.h"
 #include "ArgValidation.h"
 #include "SliceValue.h"
+#include "TupleValue.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+/**
+ * Элементы iterable для двухпроходных алгоритмов вроде join: список и кортеж
+ * отдают свой массив без копирования, остальное один раз проходится итератором в storage.
+ */
+inline const std::vector<Value>& sequenceItems(const Value& iterable, std::vector<Value>& storage) {
+
+    if (const auto list = std::get_if<Value::ListPtr>(&iterable.data)) {
+        return (*list)->elements.get();
+    }
+
+    if (const auto tuple = std::get_if<Value::TuplePtr>(&iterable.data)) {
+        return (*tuple)->items;
+    }
+
+    const Value iterator = getIter(iterable, nullptr);
+
+    for (Value item; iterNext(iterator, item, nullptr);) {
+        storage.push_back(std::move(item));
+    }
+
+    return storage;
+}
 
 inline Value makeIterMethodBuiltin(const Value& obj) {
     return makeIterMethod(obj);
@@ -41,87 +70,98 @@ struct NormalizedSlice {
     long long step;
 };
 
-inline NormalizedSlice normalizeSlice(
-    const SliceValue& slice,
-    const long long length) {
+/**
+ * Граница среза как машинное целое.
+ *
+ * Обычные числа читаются из SmallInt без перевода в BigInt; значения за пределами
+ * long long насыщаются, как в CPython — после клампинга к длине они всё равно
+ * указывают на край последовательности.
+ */
+inline std::optional<long long> sliceBound(const std::optional<Value>& bound) {
+
+    if (!bound.has_value() || bound->isNone()) {
+        return std::nullopt;
+    }
 
-    long long step = 1;
+    if (const auto small = std::get_if<Value::SmallInt>(&bound->data)) {
+        return *small;
+    }
 
-    if (slice.step.has_value()) {
+    if (!bound->isBigInt() && !bound->isBool()) {
+        throw std::runtime_error(
+            "TypeError: slice indices must be integers or None"
+        );
+    }
 
-        step = slice.step->toBigInt().convert_to<long long>();
+    const Value::BigInt value = bound->toBigInt();
 
-        if (step == 0) {
-            throw std::runtime_error(
-                "ValueError: slice step cannot be zero"
-            );
-        }
+    if (value > std::numeric_limits<long long>::max()) {
+        return std::numeric_limits<long long>::max();
     }
 
-    long long start;
-    long long stop;
-
-    if (step > 0) {
+    if (value < std::numeric_limits<long long>::min()) {
+        return std::numeric_limits<long long>::min();
+    }
 
-        start = slice.start.has_value()
-            ? slice.start->toBigInt().convert_to<long long>()
-            : 0;
+    return value.convert_to<long long>();
+}
 
-        stop = slice.stop.has_value()
-            ? slice.stop->toBigInt().convert_to<long long>()
-            : length;
+/// приводит границу к [0, length] (к [-1, length - 1] при отрицательном шаге)
+inline long long adjustSliceBound(long long bound, const long long length, const long long step) {
 
-    } else {
+    if (bound < 0) {
 
-        start = slice.start.has_value()
-            ? slice.start->toBigInt().convert_to<long long>()
-            : length - 1;
+        bound += length;
 
-        stop = slice.stop.has_value()
-            ? slice.stop->toBigInt().convert_to<long long>()
-            : -1;
-    }
+        if (bound < 0) {
+            bound = step < 0 ? -1 : 0;
+        }
 
-    if (start < 0) {
-        start += length;
+    } else if (bound >= length) {
+        bound = step < 0 ? length - 1 : length;
     }
 
-    if (stop < 0) {
+    return bound;
+}
 
-        if (step > 0) {
-            stop += length;
-        }
-        else if (stop != -1) {
-            stop += length;
-        }
-    }
+inline NormalizedSlice normalizeSlice(
+    const SliceValue& slice,
+    const long long length) {
 
-    if (step > 0) {
+    long long step = sliceBound(slice.step).value_or(1);
 
-        start = std::clamp(start, 0LL, length);
+    if (step == 0) {
+        throw std::runtime_error(
+            "ValueError: slice step cannot be zero"
+        );
+    }
 
-        stop = std::clamp(stop, 0LL, length);
+    // -step не должен переполняться
+    step = std::max(step, -std::numeric_limits<long long>::max());
 
-    } else {
+    const long long start = sliceBound(slice.start).value_or(
+        step < 0 ? std::numeric_limits<long long>::max() : 0
+    );
 
-        if (start >= length) {
-            start = length - 1;
-        }
+    const long long stop = sliceBound(slice.stop).value_or(
+        step < 0 ? std::numeric_limits<long long>::min() : std::numeric_limits<long long>::max()
+    );
 
-        if (start < -1) {
-            start = -1;
-        }
+    return {
+        adjustSliceBound(start, length, step),
+        adjustSliceBound(stop, length, step),
+        step
+    };
+}
 
-        if (stop >= length) {
-            stop = length - 1;
-        }
+/// число элементов, которые выбирает нормализованный срез
+inline long long sliceLength(const NormalizedSlice& slice) {
 
-        if (stop < -1) {
-            stop = -1;
-        }
+    if (slice.step > 0) {
+        return slice.start < slice.stop ? (slice.stop - slice.start - 1) / slice.step + 1 : 0;
     }
 
-    return {start, stop, step};
+    return slice.stop < slice.start ? (slice.start - slice.stop - 1) / -slice.step + 1 : 0;
 }
 
 template<typename AppendFn>
@@ -129,17 +169,11 @@ void iterateSlice(
     const NormalizedSlice& slice,
     AppendFn append) {
 
-    if (slice.step > 0) {
-
-        for (auto i = slice.start; i < slice.stop; i += slice.step) {
-            append(i);
-        }
+    // по счётчику: при огромном шаге `i += step` после последнего элемента переполнился бы
+    const long long count = sliceLength(slice);
 
-    } else {
-
-        for (auto i = slice.start; i > slice.stop; i += slice.step) {
-            append(i);
-        }
+    for (long long k = 0; k < count; ++k) {
+        append(slice.start + k * slice.step);
     }
 }
 
@@ -4,6 +4,7 @@
 
 #ifndef CPPYTHON_RUNTIMEUTILS_H
 #define CPPYTHON_RUNTIMEUTILS_H
+#include "ObjectPool.h"
 #include "Value.h"
 
 template<typename T>
@@ -54,10 +55,15 @@ inline Value::FrozenSetPtr extract<Value::FrozenSetPtr>(const Value& obj) {
     return std::get<Value::FrozenSetPtr>(obj.data);
 }
 
+template<>
+inline Value::RangePtr extract<Value::RangePtr>(const Value& obj) {
+    return std::get<Value::RangePtr>(obj.data);
+}
+
 template<typename Fn>
 Value makeBuiltin(const QString& name, Fn&& fn) {
     return Value(
-        std::make_shared<BuiltinFunction>(
+        makePooled<BuiltinFunction>(
             name,
             std::forward<Fn>(fn)
         )
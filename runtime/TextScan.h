@@ -0,0 +1,190 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#ifndef CPPYTHON_TEXTSCAN_H
+#define CPPYTHON_TEXTSCAN_H
+
+#include <QChar>
+#include <QtGlobal>
+
+/**
+ * Однопроходные сканеры для split()/rsplit()/splitlines() строк и байтов.
+ *
+ * Сканер не создаёт подстрок сам: он сообщает границы кусков функции `emit(start, length)`,
+ * а вызывающий метод строит из них значения своего типа (срез str, bytes или bytearray).
+ * Текст — любой контейнер с `operator[]`: QStringView, QString или QByteArray.
+ */
+namespace textscan {
+
+    /// пробельные байты bytes.split(): только ASCII " \t\n\r\v\f"
+    inline bool isByteSpace(const char c) {
+        const auto byte = static_cast<unsigned char>(c);
+        return byte == ' ' || (byte >= '\t' && byte <= '\r');
+    }
+
+    /// пробельные символы str.split() и str.isspace(): ASCII проверяется без таблиц Unicode
+    inline bool isStrSpace(const QChar ch) {
+
+        const char16_t c = ch.unicode();
+
+        if (c < 0x80) {
+            return c == ' ' || (c >= '\t' && c <= '\r') || (c >= 0x1c && c <= 0x1f);
+        }
+
+        return ch.isSpace();
+    }
+
+    /**
+     * @brief Разбиение по пробельным символам слева направо.
+     *
+     * Слова сообщаются по порядку. После `maxSplit` разрезов (если он неотрицателен)
+     * остаток без ведущих пробелов становится последним куском — как в CPython.
+     */
+    template<typename Text, typename IsSpace, typename Emit>
+    void splitWhitespace(const Text& text, const qsizetype size, const long long maxSplit,
+                         IsSpace isSpace, Emit emit) {
+
+        qsizetype i = 0;
+        long long splits = 0;
+
+        while (true) {
+
+            while (i < size && isSpace(text[i])) {
+                ++i;
+            }
+
+            if (i == size) {
+                return;
+            }
+
+            if (maxSplit >= 0 && splits == maxSplit) {
+                emit(i, size - i);
+                return;
+            }
+
+            const qsizetype start = i;
+
+            while (i < size && !isSpace(text[i])) {
+                ++i;
+            }
+
+            emit(start, i - start);
+            ++splits;
+        }
+    }
+
+    /**
+     * @brief Разбиение по пробельным символам справа налево.
+     *
+     * Куски сообщаются в обратном порядке — от последнего слова к первому.
+     */
+    template<typename Text, typename IsSpace, typename Emit>
+    void rsplitWhitespace(const Text& text, const qsizetype size, const long long maxSplit,
+                          IsSpace isSpace, Emit emit) {
+
+        qsizetype i = size;
+        long long splits = 0;
+
+        while (true) {
+
+            while (i > 0 && isSpace(text[i - 1])) {
+                --i;
+            }
+
+            if (i == 0) {
+                return;
+            }
+
+            if (maxSplit >= 0 && splits == maxSplit) {
+                emit(0, i);
+                return;
+            }
+
+            const qsizetype end = i;
+
+            while (i > 0 && !isSpace(text[i - 1])) {
+                --i;
+            }
+
+            emit(i, end - i);
+            ++splits;
+        }
+    }
+
+    /**
+     * @brief Разбиение на строки.
+     *
+     * `breakLength(i)` возвращает длину разделителя строк, начинающегося в позиции i
+     * (0 — не разделитель), так что str и bytes задают свой набор разделителей.
+     * Для каждой строки вызывается `emit(start, length)`; с keepEnds разделитель
+     * входит в кусок.
+     */
+    template<typename BreakLength, typename Emit>
+    void splitLines(const qsizetype size, const bool keepEnds, BreakLength breakLength, Emit emit) {
+
+        qsizetype start = 0;
+        qsizetype i = 0;
+
+        while (i < size) {
+
+            const qsizetype length = breakLength(i);
+
+            if (length == 0) {
+                ++i;
+                continue;
+            }
+
+            emit(start, (keepEnds ? i + length : i) - start);
+
+            i += length;
+            start = i;
+        }
+
+        if (start < size) {
+            emit(start, size - start);
+        }
+    }
+
+    /// длина разделителя строк bytes.splitlines(): \n, \r или \r\n
+    template<typename Text>
+    qsizetype byteLineBreak(const Text& text, const qsizetype size, const qsizetype i) {
+
+        if (text[i] == '\n') {
+            return 1;
+        }
+
+        if (text[i] == '\r') {
+            return i + 1 < size && text[i + 1] == '\n' ? 2 : 1;
+        }
+
+        return 0;
+    }
+
+    /// длина разделителя строк str.splitlines(): кроме \n, \r и \r\n — \v, \f, \x1c-\x1e, \x85, U+2028, U+2029
+    template<typename Text>
+    qsizetype strLineBreak(const Text& text, const qsizetype size, const qsizetype i) {
+
+        switch (text[i].unicode()) {
+
+            case u'\r':
+                return i + 1 < size && text[i + 1] == u'\n' ? 2 : 1;
+
+            case u'\n':
+            case u'\v':
+            case u'\f':
+            case 0x1c:
+            case 0x1d:
+            case 0x1e:
+            case 0x85:
+            case 0x2028:
+            case 0x2029:
+                return 1;
+
+            default:
+                return 0;
+        }
+    }
+}
+
+#endif //CPPYTHON_TEXTSCAN_H
@@ -0,0 +1,231 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_TIMSORT_H
+#define CPPYTHON_TIMSORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+/**
+ * Устойчивая сортировка слиянием готовых серий — упрощённый Timsort из CPython.
+ *
+ * Массив делится на серии: неубывающие берутся как есть, строго убывающие
+ * переворачиваются (строгость сохраняет порядок равных). Короткие серии добираются
+ * до `minRun` вставками. Серии сливаются по инвариантам Timsort, поэтому почти
+ * упорядоченные данные сортируются за время, близкое к линейному. Слияние —
+ * std::inplace_merge, без галопа: на типичных данных разница невелика.
+ *
+ * `less` вызывается только как строгое «меньше», как `<` в Python.
+ */
+namespace timsort {
+
+    struct Run {
+        std::size_t start;
+        std::size_t length;
+    };
+
+    /// длина серии, при которой число серий — степень двойки или чуть меньше
+    inline std::size_t minRunLength(std::size_t n) {
+
+        std::size_t r = 0;
+
+        while (n >= 64) {
+            r |= n & 1;
+            n >>= 1;
+        }
+
+        return n + r;
+    }
+
+    template<typename T, typename Less>
+    void mergeAt(std::vector<T>& items, std::vector<Run>& runs, const std::size_t i, Less& less) {
+
+        const Run& a = runs[i];
+        const Run& b = runs[i + 1];
+
+        const auto first = items.begin() + static_cast<std::ptrdiff_t>(a.start);
+        const auto middle = items.begin() + static_cast<std::ptrdiff_t>(b.start);
+        const auto last = middle + static_cast<std::ptrdiff_t>(b.length);
+
+        std::inplace_merge(first, middle, last, less);
+
+        runs[i].length += b.length;
+        runs.erase(runs.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+    }
+
+    /// восстанавливает инварианты стека серий (в редакции с исправлением 2015 года)
+    template<typename T, typename Less>
+    void mergeCollapse(std::vector<T>& items, std::vector<Run>& runs, Less& less) {
+
+        while (runs.size() > 1) {
+
+            std::size_t n = runs.size() - 2;
+
+            if ((n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+                (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length)) {
+
+                if (runs[n - 1].length < runs[n + 1].length) {
+                    --n;
+                }
+
+            } else if (runs[n].length > runs[n + 1].length) {
+                break;
+            }
+
+            mergeAt(items, runs, n, less);
+        }
+    }
+
+    template<typename T, typename Less>
+    void sort(std::vector<T>& items, Less less) {
+
+        const std::size_t n = items.size();
+
+        if (n < 2) {
+            return;
+        }
+
+        const std::size_t minRun = minRunLength(n);
+        const auto at = [&](const std::size_t i) { return items.begin() + static_cast<std::ptrdiff_t>(i); };
+
+        std::vector<Run> runs;
+        std::size_t lo = 0;
+
+        while (lo < n) {
+
+            std::size_t runEnd = lo + 1;
+
+            if (runEnd < n) {
+
+                if (less(items[runEnd], items[lo])) {
+
+                    ++runEnd;
+
+                    while (runEnd < n && less(items[runEnd], items[runEnd - 1])) {
+                        ++runEnd;
+                    }
+
+                    std::reverse(at(lo), at(runEnd));
+
+                } else {
+
+                    ++runEnd;
+
+                    while (runEnd < n && !less(items[runEnd], items[runEnd - 1])) {
+                        ++runEnd;
+                    }
+                }
+            }
+
+            // бинарные вставки: новый элемент встаёт после равных ему — устойчиво
+            const std::size_t end = std::min(n, lo + std::max(minRun, runEnd - lo));
+
+            for (std::size_t i = runEnd; i < end; ++i) {
+                const auto position = std::upper_bound(at(lo), at(i), items[i], less);
+                std::rotate(position, at(i), at(i + 1));
+            }
+
+            runs.push_back(Run{lo, end - lo});
+            lo = end;
+
+            mergeCollapse(items, runs, less);
+        }
+
+        while (runs.size() > 1) {
+
+            std::size_t i = runs.size() - 2;
+
+            if (i > 0 && runs[i - 1].length < runs[i + 1].length) {
+                --i;
+            }
+
+            mergeAt(items, runs, i, less);
+        }
+    }
+
+    /// fn(i) для i из [0, count): первый в вызывающем потоке, остальные — каждый в своём
+    template<typename Fn>
+    void forEachParallel(const std::size_t count, Fn&& fn) {
+
+        std::vector<std::thread> pool;
+        pool.reserve(count);
+
+        for (std::size_t i = 1; i < count; ++i) {
+            pool.emplace_back([&fn, i] { fn(i); });
+        }
+
+        if (count > 0) {
+            fn(0);
+        }
+
+        for (std::thread& worker : pool) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief sort() на workers потоках с тем же результатом.
+     *
+     * Массив делится на workers кусков, каждый сортируется отдельно, затем
+     * соседние куски сливаются попарно, по уровню за раз, — каждое слияние
+     * в своём потоке. Слияние берёт из левого куска при равенстве, поэтому
+     * сортировка устойчива, а при строгом слабом порядке less результат
+     * совпадает с последовательным. less не должен вызывать код Python.
+     */
+    template<typename T, typename Less>
+    void parallelSort(std::vector<T>& items, Less less, const std::size_t workers) {
+
+        const std::size_t n = items.size();
+
+        if (workers <= 1 || n < workers) {
+            sort(items, less);
+            return;
+        }
+
+        std::vector<std::vector<T>> parts(workers);
+
+        forEachParallel(workers, [&](const std::size_t i) {
+            const auto first = items.begin() + static_cast<std::ptrdiff_t>(n * i / workers);
+            const auto last = items.begin() + static_cast<std::ptrdiff_t>(n * (i + 1) / workers);
+            parts[i].assign(std::make_move_iterator(first), std::make_move_iterator(last));
+            sort(parts[i], less);
+        });
+
+        while (parts.size() > 1) {
+
+            std::vector<std::vector<T>> merged((parts.size() + 1) / 2);
+
+            forEachParallel(merged.size(), [&](const std::size_t i) {
+
+                std::vector<T>& left = parts[2 * i];
+
+                // нечётный последний кусок переходит на следующий уровень как есть
+                if (2 * i + 1 == parts.size()) {
+                    merged[i] = std::move(left);
+                    return;
+                }
+
+                std::vector<T>& right = parts[2 * i + 1];
+
+                merged[i].reserve(left.size() + right.size());
+                std::merge(std::make_move_iterator(left.begin()), std::make_move_iterator(left.end()),
+                           std::make_move_iterator(right.begin()), std::make_move_iterator(right.end()),
+                           std::back_inserter(merged[i]), less);
+
+                std::vector<T>().swap(left);
+                std::vector<T>().swap(right);
+            });
+
+            parts = std::move(merged);
+        }
+
+        items = std::move(parts.front());
+    }
+}
+
+#endif //CPPYTHON_TIMSORT_H
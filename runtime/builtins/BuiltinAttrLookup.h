@@ -4,13 +4,16 @@
 
 #ifndef CPPYTHON_BUILTINATTRLOOKUP_H
 #define CPPYTHON_BUILTINATTRLOOKUP_H
+#include <optional>
+
 #include "BuiltinMethodRegistry.h"
+#include "../RuntimeUtils.h"
 
-inline Value getBuiltinAttr(
+/// атрибут из таблицы MethodMap; промах — пустой optional, AttributeError формирует genericGetAttr
+inline std::optional<Value> getBuiltinAttr(
     const Value& obj,
     const QString& attr,
-    const MethodMap& methods,
-    const QString& typeName) {
+    const MethodMap& methods) {
 
     if (const auto it = methods.find(attr);
         it != methods.end()) {
@@ -18,8 +21,40 @@ inline Value getBuiltinAttr(
         return it.value()(obj);
     }
 
-    throw std::runtime_error("AttributeError: " + typeName.toStdString() +
-        " has no attribute '" + attr.toStdString() + "'"
-    );
+    return std::nullopt;
+}
+inline BuiltinMethod findBuiltinMethod(
+    const QString& attr,
+    const MethodTable& methods) {
+
+    const auto it = methods.constFind(attr);
+
+    return it != methods.constEnd() ? it.value() : nullptr;
+}
+
+/**
+ * Атрибут-метод из таблицы MethodTable. Объект метода создаётся только здесь — при явном
+ * обращении к атрибуту (`f = lst.append`); вызов `lst.append(x)` идёт через callMethod.
+ */
+inline std::optional<Value> getBuiltinAttr(
+    const Value& obj,
+    const QString& attr,
+    const MethodTable& methods) {
+
+    if (const BuiltinMethod method = findBuiltinMethod(attr, methods)) {
+
+        return makeBuiltin(
+            attr,
+
+            [obj, method](const std::vector<Value>& args,
+                          const std::vector<std::pair<QString, Value>>& kwargs,
+                          const std::shared_ptr<Environment>& env) -> Value {
+
+                return method(obj, args, kwargs, env);
+            }
+        );
+    }
+
+    return std::nullopt;
 }
 #endif //CPPYTHON_BUILTINATTRLOOKUP_H
\ No newline at end of file
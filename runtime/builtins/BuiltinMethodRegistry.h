@@ -19,4 +19,20 @@ using BuiltinMethodFactory =
 
 using MethodMap = QHash<QString, BuiltinMethodFactory>;
 
+#define REGISTER_DIRECT_METHOD(name, fn) \
+{ name, BuiltinMethod(fn) }
+
+/**
+ * Метод встроенного типа, не захватывающий объект: `self` передаётся при вызове.
+ * Таблица таких методов строится один раз на тип, а вызов `obj.method(...)`
+ * идёт напрямую, без создания BuiltinFunction на каждое обращение.
+ */
+using BuiltinMethod = Value(*)(
+    const Value& self,
+    const std::vector<Value>& args,
+    const std::vector<std::pair<QString, Value>>& kwargs,
+    const std::shared_ptr<Environment>& env);
+
+using MethodTable = QHash<QString, BuiltinMethod>;
+
 #endif //CPPYTHON_BUILTINMETHODREGISTRY_H
\ No newline at end of file
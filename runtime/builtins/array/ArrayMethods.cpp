@@ -0,0 +1,351 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include <limits>
+
+#include "ArrayIterator.h"
+#include "ArrayValue.h"
+#include "BytesValue.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    ArrayValue& array(const Value& obj) {
+        return *ArrayValue::of(obj);
+    }
+
+    /// границы start и stop из index(); отрицательные отсчитываются от конца
+    qsizetype bound(const Value& value, const qsizetype size) {
+
+        Value::BigInt position = value.asBigInt("index");
+
+        if (position < 0) {
+            position += size;
+        }
+
+        return position < 0 ? 0 : position > size ? size : position.convert_to<qsizetype>();
+    }
+
+    /// индекс pop() и insert() как машинное целое; за пределами qsizetype — насыщение
+    qsizetype position(const Value& value, const char* name) {
+
+        const Value::BigInt index = value.asBigInt(name);
+
+        if (index > std::numeric_limits<qsizetype>::max()) {
+            return std::numeric_limits<qsizetype>::max();
+        }
+
+        if (index < std::numeric_limits<qsizetype>::min()) {
+            return std::numeric_limits<qsizetype>::min();
+        }
+
+        return index.convert_to<qsizetype>();
+    }
+
+    Value iterMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__iter__");
+
+        const auto self = std::static_pointer_cast<ArrayValue>(std::get<Value::ObjectPtr>(obj.data));
+
+        return Value(std::static_pointer_cast<IteratorValue>(std::make_shared<ArrayIterator>(self, "arrayiterator")));
+    }
+
+    Value lenMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__len__");
+
+        return Value(Value::SmallInt(array(obj).len()));
+    }
+
+    Value getitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__getitem__");
+
+        return array(obj).getItem(args[0]);
+    }
+
+    Value setitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 2, "__setitem__");
+
+        array(obj).setItem(args[0], args[1]);
+
+        return {};
+    }
+
+    Value delitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__delitem__");
+
+        array(obj).delItem(args[0]);
+
+        return {};
+    }
+
+    Value containsMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__contains__");
+
+        return Value(array(obj).contains(args[0]));
+    }
+
+    Value equalMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__eq__");
+
+        return Value(array(obj).equal(args[0]));
+    }
+
+    Value notEqualMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__ne__");
+
+        return Value(array(obj).notEqual(args[0]));
+    }
+
+    Value iaddMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__iadd__");
+
+        array(obj).iadd(args[0]);
+
+        return obj;
+    }
+
+    Value imulMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__imul__");
+
+        array(obj).imul(args[0]);
+
+        return obj;
+    }
+
+    Value copyMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__copy__");
+
+        const ArrayValue& self = array(obj);
+
+        return Value(std::static_pointer_cast<ObjectValue>(std::make_shared<ArrayValue>(self.typecode(), self.bytes())));
+    }
+
+    Value appendMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "append");
+
+        array(obj).append(args[0]);
+
+        return {};
+    }
+
+    Value extendMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "extend");
+
+        array(obj).extend(args[0]);
+
+        return {};
+    }
+
+    Value frombytesMethod(const Value& obj,
+                          const std::vector<Value>& args,
+                          const Kwargs&,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "frombytes");
+
+        array(obj).fromBytes(args[0]);
+
+        return {};
+    }
+
+    Value fromlistMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "fromlist");
+
+        if (!args[0].isList()) {
+            throw std::runtime_error("TypeError: arg must be list");
+        }
+
+        array(obj).extend(args[0]);
+
+        return {};
+    }
+
+    Value tobytesMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "tobytes");
+
+        // QByteArray разделяется неявно: байты копируются, только когда массив изменится
+        return Value(std::make_shared<BytesValue>(array(obj).bytes()));
+    }
+
+    Value tolistMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "tolist");
+
+        return array(obj).toList();
+    }
+
+    Value popMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 1, "pop");
+
+        return array(obj).pop(args.empty() ? -1 : position(args[0], "pop"));
+    }
+
+    Value insertMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 2, "insert");
+
+        array(obj).insert(position(args[0], "insert"), args[1]);
+
+        return {};
+    }
+
+    Value removeMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "remove");
+
+        array(obj).remove(args[0]);
+
+        return {};
+    }
+
+    Value reverseMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "reverse");
+
+        array(obj).reverse();
+
+        return {};
+    }
+
+    Value countMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "count");
+
+        return Value(Value::SmallInt(array(obj).countOf(args[0])));
+    }
+
+    Value indexMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 1, 3, "index");
+
+        const ArrayValue& self = array(obj);
+        const qsizetype start = args.size() > 1 ? bound(args[1], self.len()) : 0;
+        const qsizetype stop = args.size() > 2 ? bound(args[2], self.len()) : self.len();
+
+        return Value(Value::SmallInt(self.index(args[0], start, stop)));
+    }
+
+    const MethodTable ARRAY_METHODS = {
+        REGISTER_DIRECT_METHOD("__iter__", iterMethod),
+        REGISTER_DIRECT_METHOD("__len__", lenMethod),
+        REGISTER_DIRECT_METHOD("__getitem__", getitemMethod),
+        REGISTER_DIRECT_METHOD("__setitem__", setitemMethod),
+        REGISTER_DIRECT_METHOD("__delitem__", delitemMethod),
+        REGISTER_DIRECT_METHOD("__contains__", containsMethod),
+        REGISTER_DIRECT_METHOD("__eq__", equalMethod),
+        REGISTER_DIRECT_METHOD("__ne__", notEqualMethod),
+        REGISTER_DIRECT_METHOD("__iadd__", iaddMethod),
+        REGISTER_DIRECT_METHOD("__imul__", imulMethod),
+        REGISTER_DIRECT_METHOD("__copy__", copyMethod),
+        REGISTER_DIRECT_METHOD("append", appendMethod),
+        REGISTER_DIRECT_METHOD("extend", extendMethod),
+        REGISTER_DIRECT_METHOD("frombytes", frombytesMethod),
+        REGISTER_DIRECT_METHOD("fromlist", fromlistMethod),
+        REGISTER_DIRECT_METHOD("tobytes", tobytesMethod),
+        REGISTER_DIRECT_METHOD("tolist", tolistMethod),
+        REGISTER_DIRECT_METHOD("pop", popMethod),
+        REGISTER_DIRECT_METHOD("insert", insertMethod),
+        REGISTER_DIRECT_METHOD("remove", removeMethod),
+        REGISTER_DIRECT_METHOD("reverse", reverseMethod),
+        REGISTER_DIRECT_METHOD("count", countMethod),
+        REGISTER_DIRECT_METHOD("index", indexMethod),
+    };
+}
+
+std::optional<Value> getArrayAttr(const Value& obj, const QString& attr) {
+
+    if (attr == "typecode") {
+        return Value(QString(QChar(array(obj).typecode())));
+    }
+
+    if (attr == "itemsize") {
+        return Value(Value::SmallInt(array(obj).itemSize()));
+    }
+
+    return getBuiltinAttr(obj, attr, ARRAY_METHODS);
+}
@@ -0,0 +1,13 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ARRAYMETHODS_H
+#define CPPYTHON_ARRAYMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// атрибуты typecode, itemsize и методы array.array
+std::optional<Value> getArrayAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_ARRAYMETHODS_H
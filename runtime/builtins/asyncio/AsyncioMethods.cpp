@@ -0,0 +1,216 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "AsyncioMethods.h"
+
+#include <limits>
+
+#include "FutureValue.h"
+#include "StreamValue.h"
+#include "StructFormat.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    FutureValue& future(const Value& obj) {
+        return *FutureValue::of(obj);
+    }
+
+    StreamReaderValue& reader(const Value& obj) {
+        return *StreamReaderValue::of(obj);
+    }
+
+    StreamWriterValue& writer(const Value& obj) {
+        return *StreamWriterValue::of(obj);
+    }
+
+    Value doneMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "done");
+
+        return Value(future(obj).done());
+    }
+
+    Value resultMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "result");
+
+        return future(obj).result();
+    }
+
+    Value exceptionMethod(const Value& obj,
+                          const std::vector<Value>& args,
+                          const Kwargs&,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "exception");
+
+        return future(obj).exception();
+    }
+
+    Value awaitMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__await__");
+
+        return Value(std::static_pointer_cast<IteratorValue>(std::make_shared<FutureAwaiter>(obj)));
+    }
+
+    Value readMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 1, "read");
+
+        const Value::BigInt n = args.empty() ? Value::BigInt(-1) : args[0].asBigInt("read");
+
+        return reader(obj).read(n < 0 ? -1 : n > std::numeric_limits<qsizetype>::max()
+                                                 ? std::numeric_limits<qsizetype>::max()
+                                                 : n.convert_to<qsizetype>());
+    }
+
+    Value readlineMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "readline");
+
+        return reader(obj).readline();
+    }
+
+    Value atEofMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "at_eof");
+
+        return Value(reader(obj).atEof());
+    }
+
+    Value aiterMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__aiter__");
+
+        return obj;
+    }
+
+    Value anextMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__anext__");
+
+        return reader(obj).nextLine();
+    }
+
+    Value writeMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "write");
+
+        writer(obj).write(StructFormat::bufferOf(args[0]));
+
+        return {};
+    }
+
+    Value drainMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "drain");
+
+        return writer(obj).drain();
+    }
+
+    Value closeMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "close");
+
+        writer(obj).close();
+
+        return {};
+    }
+
+    Value isClosingMethod(const Value& obj,
+                          const std::vector<Value>& args,
+                          const Kwargs&,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "is_closing");
+
+        return Value(writer(obj).isClosing());
+    }
+
+    Value waitClosedMethod(const Value& obj,
+                           const std::vector<Value>& args,
+                           const Kwargs&,
+                           const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "wait_closed");
+
+        // close() отпускает дескриптор сам, когда уйдёт буфер; ждать здесь нечего
+        const auto done = FutureValue::create();
+        done->setResult(Value());
+
+        return Value(std::static_pointer_cast<ObjectValue>(done));
+    }
+
+    const MethodTable FUTURE_METHODS = {
+        REGISTER_DIRECT_METHOD("done", doneMethod),
+        REGISTER_DIRECT_METHOD("result", resultMethod),
+        REGISTER_DIRECT_METHOD("exception", exceptionMethod),
+        REGISTER_DIRECT_METHOD("__await__", awaitMethod),
+    };
+
+    const MethodTable STREAM_READER_METHODS = {
+        REGISTER_DIRECT_METHOD("read", readMethod),
+        REGISTER_DIRECT_METHOD("readline", readlineMethod),
+        REGISTER_DIRECT_METHOD("at_eof", atEofMethod),
+        REGISTER_DIRECT_METHOD("__aiter__", aiterMethod),
+        REGISTER_DIRECT_METHOD("__anext__", anextMethod),
+    };
+
+    const MethodTable STREAM_WRITER_METHODS = {
+        REGISTER_DIRECT_METHOD("write", writeMethod),
+        REGISTER_DIRECT_METHOD("drain", drainMethod),
+        REGISTER_DIRECT_METHOD("close", closeMethod),
+        REGISTER_DIRECT_METHOD("is_closing", isClosingMethod),
+        REGISTER_DIRECT_METHOD("wait_closed", waitClosedMethod),
+    };
+}
+
+std::optional<Value> getFutureAttr(const Value& obj, const QString& attr) {
+    return getBuiltinAttr(obj, attr, FUTURE_METHODS);
+}
+
+std::optional<Value> getStreamReaderAttr(const Value& obj, const QString& attr) {
+    return getBuiltinAttr(obj, attr, STREAM_READER_METHODS);
+}
+
+std::optional<Value> getStreamWriterAttr(const Value& obj, const QString& attr) {
+    return getBuiltinAttr(obj, attr, STREAM_WRITER_METHODS);
+}
@@ -0,0 +1,19 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_ASYNCIOMETHODS_H
+#define CPPYTHON_ASYNCIOMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// методы Future и Task: done, result, exception, __await__
+std::optional<Value> getFutureAttr(const Value& obj, const QString& attr);
+
+/// методы StreamReader: read, readline, at_eof, __aiter__, __anext__
+std::optional<Value> getStreamReaderAttr(const Value& obj, const QString& attr);
+
+/// методы StreamWriter: write, drain, close, is_closing, wait_closed
+std::optional<Value> getStreamWriterAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_ASYNCIOMETHODS_H
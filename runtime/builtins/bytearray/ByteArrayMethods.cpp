@@ -680,7 +680,12 @@ namespace {
                 const std::shared_ptr<Environment>&)
             -> Value {
 
-                expectArgsRange(args, 1, 2, "split");
+                expectArgsRange(args, 0, 2, "split");
+
+                if (args.empty()) {
+
+                    return byteArray->split(Value());
+                }
 
                 if (args.size() == 1) {
 
@@ -705,7 +710,12 @@ namespace {
                 const std::shared_ptr<Environment>&)
             -> Value {
 
-                expectArgsRange(args, 1, 2, "rsplit");
+                expectArgsRange(args, 0, 2, "rsplit");
+
+                if (args.empty()) {
+
+                    return byteArray->rsplit(Value());
+                }
 
                 if (args.size() == 1) {
 
@@ -1377,29 +1387,7 @@ namespace {
                 const std::shared_ptr<Environment>&)
             -> Value {
 
-                expectArgsRange(args, 0, 2, "hex");
-
-                if (args.empty()) {
-                    return byteArray->hex();
-                }
-
-                const QString sep =
-                    args[0]
-                    .asString("hex")
-                    ->toString();
-
-                if (sep.size() != 1) {
-
-                    throw std::runtime_error(
-                        "ValueError: sep must be length 1"
-                    );
-                }
-
-                if (args.size() == 1) {
-                    return byteArray->hex(sep, std::nullopt);
-                }
-
-                return byteArray->hex(sep, args[1].toBigInt());
+                return byteArray->hex(args);
             }
         );
     }
@@ -1489,7 +1477,7 @@ namespace {
 
             [byteArray](
                 const std::vector<Value>& args,
-                const Kwargs&,
+                const Kwargs& kwargs,
                 const std::shared_ptr<Environment>&)
             -> Value {
 
@@ -1501,6 +1489,12 @@ namespace {
                     deleteBytes = args[1];
                 }
 
+                for (const auto& [name, value] : kwargs) {
+                    if (name == "delete") {
+                        deleteBytes = value;
+                    }
+                }
+
                 return byteArray->translate(args[0], deleteBytes);
             }
         );
@@ -1702,9 +1696,9 @@ namespace {
 
 }
 
-Value getByteArrayAttr(const Value& obj, const QString& attr) {
+std::optional<Value> getByteArrayAttr(const Value& obj, const QString& attr) {
 
-    return getBuiltinAttr(obj, attr, BYTEARRAY_METHODS, "bytes");
+    return getBuiltinAttr(obj, attr, BYTEARRAY_METHODS);
 }
 
 Value make_byteArray_ClassBuiltin() {
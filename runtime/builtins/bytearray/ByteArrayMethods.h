@@ -4,9 +4,11 @@
 
 #ifndef CPPYTHON_BYTEARRAYMETHODS_H
 #define CPPYTHON_BYTEARRAYMETHODS_H
+#include <optional>
+
 #include "Value.h"
 
-Value getByteArrayAttr(const Value& obj, const QString& attr);
+std::optional<Value> getByteArrayAttr(const Value& obj, const QString& attr);
 
 Value make_byteArray_ClassBuiltin();
 
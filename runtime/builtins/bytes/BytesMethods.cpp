@@ -267,7 +267,7 @@ namespace {
 
                 expectArgs(args, 0, "__hash__");
 
-                return Value(Value::BigInt(bytes->hash()));
+                return Value(Value::BigInt(static_cast<long long>(bytes->hash())));
             }
         );
     }
@@ -1041,9 +1041,7 @@ namespace {
                   const std::shared_ptr<Environment>&)
             -> Value {
 
-                expectArgs(args, 0, "hex");
-
-                return obj.asBytes()->hex();
+                return obj.asBytes()->hex(args);
             }
         );
     }
@@ -1116,7 +1114,7 @@ namespace {
 
             [obj](
                 const std::vector<Value>& args,
-                const Kwargs&,
+                const Kwargs& kwargs,
                 const std::shared_ptr<Environment>&
             ) -> Value {
 
@@ -1128,6 +1126,12 @@ namespace {
                     deleteBytes = args[1];
                 }
 
+                for (const auto& [name, value] : kwargs) {
+                    if (name == "delete") {
+                        deleteBytes = value;
+                    }
+                }
+
                 return obj.asBytes()->translate(args[0], deleteBytes);
             }
         );
@@ -1304,9 +1308,9 @@ namespace {
     };
 }
 
-Value getBytesAttr(const Value& obj, const QString& attr) {
+std::optional<Value> getBytesAttr(const Value& obj, const QString& attr) {
 
-    return getBuiltinAttr(obj, attr, BYTES_METHODS, "bytes");
+    return getBuiltinAttr(obj, attr, BYTES_METHODS);
 }
 
 Value makeFromHexClassBuiltin() {
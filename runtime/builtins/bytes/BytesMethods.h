@@ -4,9 +4,11 @@
 
 #ifndef CPPYTHON_BYTESMETHODS_H
 #define CPPYTHON_BYTESMETHODS_H
+#include <optional>
+
 #include "Value.h"
 
-Value getBytesAttr(const Value& obj, const QString& attr);
+std::optional<Value> getBytesAttr(const Value& obj, const QString& attr);
 
 Value makeFromHexClassBuiltin();
 
@@ -0,0 +1,183 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "CounterValue.h"
+#include "DefaultDictValue.h"
+#include "OrderedDictValue.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../dict/DictMethods.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    /// значение именованного аргумента name или fallback; другие имена — TypeError
+    Value kwarg(const Kwargs& kwargs, const QString& name, const Value& fallback, const QString& method) {
+
+        Value result = fallback;
+
+        for (const auto& [key, value] : kwargs) {
+
+            if (key != name) {
+                throw std::runtime_error(
+                    "TypeError: " + method.toStdString() + "() got an unexpected keyword argument '" + key.toStdString() + "'");
+            }
+
+            result = value;
+        }
+
+        return result;
+    }
+
+    Value missingMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__missing__");
+
+        // getItem сам вызовет `__missing__`, если ключа нет
+        return obj.asDict()->getItem(args[0]);
+    }
+
+    Value mostCommonMethod(const Value& obj,
+                           const std::vector<Value>& args,
+                           const Kwargs& kwargs,
+                           const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 1, "most_common");
+
+        const Value n = kwarg(kwargs, "n", args.empty() ? Value() : args[0], "most_common");
+
+        return CounterValue::of(obj)->mostCommon(
+            n.isNone() ? std::nullopt : std::optional(n.asBigInt("most_common").convert_to<qsizetype>()));
+    }
+
+    Value elementsMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>& env) {
+
+        expectArgs(args, 0, "elements");
+
+        return getIter(CounterValue::of(obj)->elements(), env);
+    }
+
+    Value totalMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "total");
+
+        return CounterValue::of(obj)->total();
+    }
+
+    /// update и subtract: позиционный источник, затем именованные аргументы как отображение
+    Value countFrom(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                    const std::shared_ptr<Environment>& env, const int sign, const QString& name) {
+
+        expectArgsRange(args, 0, 1, name);
+
+        CounterValue* counter = CounterValue::of(obj);
+
+        if (!args.empty() && !args[0].isNone()) {
+            counter->count(args[0], sign, env);
+        }
+
+        for (const auto& [key, value] : kwargs) {
+            counter->increment(Value(key), sign > 0 ? value : -value);
+        }
+
+        return {};
+    }
+
+    Value updateMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs& kwargs,
+                       const std::shared_ptr<Environment>& env) {
+        return countFrom(obj, args, kwargs, env, 1, "update");
+    }
+
+    Value subtractMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs& kwargs,
+                         const std::shared_ptr<Environment>& env) {
+        return countFrom(obj, args, kwargs, env, -1, "subtract");
+    }
+
+    Value moveToEndMethod(const Value& obj,
+                          const std::vector<Value>& args,
+                          const Kwargs& kwargs,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 1, 2, "move_to_end");
+
+        const Value last = kwarg(kwargs, "last", args.size() > 1 ? args[1] : Value(true), "move_to_end");
+
+        obj.asDict()->moveToEnd(args[0], last.toBool());
+
+        return {};
+    }
+
+    Value popitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs& kwargs,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 1, "popitem");
+
+        const Value last = kwarg(kwargs, "last", args.empty() ? Value(true) : args[0], "popitem");
+
+        return obj.asDict()->popitem(last.toBool());
+    }
+
+    const MethodTable DEFAULT_DICT_METHODS = {
+        REGISTER_DIRECT_METHOD("__missing__", missingMethod),
+    };
+
+    const MethodTable COUNTER_METHODS = {
+        REGISTER_DIRECT_METHOD("most_common", mostCommonMethod),
+        REGISTER_DIRECT_METHOD("elements", elementsMethod),
+        REGISTER_DIRECT_METHOD("total", totalMethod),
+        REGISTER_DIRECT_METHOD("update", updateMethod),
+        REGISTER_DIRECT_METHOD("subtract", subtractMethod),
+    };
+
+    const MethodTable ORDERED_DICT_METHODS = {
+        REGISTER_DIRECT_METHOD("move_to_end", moveToEndMethod),
+        REGISTER_DIRECT_METHOD("popitem", popitemMethod),
+    };
+}
+
+std::optional<Value> getDefaultDictAttr(const Value& obj, const QString& attr) {
+
+    if (attr == "default_factory") {
+        return DefaultDictValue::of(obj)->defaultFactory();
+    }
+
+    if (std::optional<Value> method = getBuiltinAttr(obj, attr, DEFAULT_DICT_METHODS)) {
+        return method;
+    }
+
+    return getDictAttr(obj, attr);
+}
+
+std::optional<Value> getCounterAttr(const Value& obj, const QString& attr) {
+
+    if (std::optional<Value> method = getBuiltinAttr(obj, attr, COUNTER_METHODS)) {
+        return method;
+    }
+
+    return getDictAttr(obj, attr);
+}
+
+std::optional<Value> getOrderedDictAttr(const Value& obj, const QString& attr) {
+
+    if (std::optional<Value> method = getBuiltinAttr(obj, attr, ORDERED_DICT_METHODS)) {
+        return method;
+    }
+
+    return getDictAttr(obj, attr);
+}
@@ -0,0 +1,19 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_COLLECTIONSDICTMETHODS_H
+#define CPPYTHON_COLLECTIONSDICTMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// default_factory и `__missing__`; остальное — как у dict
+std::optional<Value> getDefaultDictAttr(const Value& obj, const QString& attr);
+
+/// most_common, elements, total и счётные update/subtract; остальное — как у dict
+std::optional<Value> getCounterAttr(const Value& obj, const QString& attr);
+
+/// move_to_end и popitem(last); остальное — как у dict
+std::optional<Value> getOrderedDictAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_COLLECTIONSDICTMETHODS_H
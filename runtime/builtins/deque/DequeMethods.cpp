@@ -0,0 +1,316 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "DequeIterator.h"
+#include "DequeValue.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    DequeValue& deque(const Value& obj) {
+        return *DequeValue::of(obj);
+    }
+
+    /// границы start и stop из index(); отрицательные отсчитываются от конца
+    qsizetype bound(const Value& value, const qsizetype size) {
+
+        Value::BigInt position = value.asBigInt("index");
+
+        if (position < 0) {
+            position += size;
+        }
+
+        return position < 0 ? 0 : position > size ? size : position.convert_to<qsizetype>();
+    }
+
+    Value iterMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__iter__");
+
+        const auto self = std::static_pointer_cast<DequeValue>(std::get<Value::ObjectPtr>(obj.data));
+
+        return Value(std::static_pointer_cast<IteratorValue>(std::make_shared<DequeIterator>(self)));
+    }
+
+    Value lenMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__len__");
+
+        return Value(Value::SmallInt(deque(obj).len()));
+    }
+
+    Value getitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__getitem__");
+
+        return deque(obj).getItem(args[0]);
+    }
+
+    Value setitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 2, "__setitem__");
+
+        deque(obj).setItem(args[0], args[1]);
+
+        return {};
+    }
+
+    Value delitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__delitem__");
+
+        deque(obj).delItem(args[0]);
+
+        return {};
+    }
+
+    Value containsMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__contains__");
+
+        return Value(deque(obj).contains(args[0]));
+    }
+
+    Value equalMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__eq__");
+
+        return Value(deque(obj).equal(args[0]));
+    }
+
+    Value notEqualMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__ne__");
+
+        return Value(deque(obj).notEqual(args[0]));
+    }
+
+    Value appendMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "append");
+
+        deque(obj).append(args[0]);
+
+        return {};
+    }
+
+    Value appendleftMethod(const Value& obj,
+                           const std::vector<Value>& args,
+                           const Kwargs&,
+                           const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "appendleft");
+
+        deque(obj).appendLeft(args[0]);
+
+        return {};
+    }
+
+    Value popMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "pop");
+
+        return deque(obj).pop();
+    }
+
+    Value popleftMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "popleft");
+
+        return deque(obj).popLeft();
+    }
+
+    Value extendMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "extend");
+
+        deque(obj).extend(args[0]);
+
+        return {};
+    }
+
+    Value extendleftMethod(const Value& obj,
+                           const std::vector<Value>& args,
+                           const Kwargs&,
+                           const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "extendleft");
+
+        deque(obj).extendLeft(args[0]);
+
+        return {};
+    }
+
+    Value insertMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 2, "insert");
+
+        deque(obj).insert(args[0], args[1]);
+
+        return {};
+    }
+
+    Value removeMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "remove");
+
+        deque(obj).remove(args[0]);
+
+        return {};
+    }
+
+    Value clearMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "clear");
+
+        deque(obj).clear();
+
+        return {};
+    }
+
+    Value rotateMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 1, "rotate");
+
+        const Value::BigInt steps = args.empty() ? Value::BigInt(1) : args[0].asBigInt("rotate");
+        const auto size = static_cast<long long>(deque(obj).len());
+
+        // сдвиг больше длины сводится по модулю до перевода в машинное целое
+        deque(obj).rotate(size == 0 ? 0 : static_cast<qsizetype>((steps % size).convert_to<long long>()));
+
+        return {};
+    }
+
+    Value reverseMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "reverse");
+
+        deque(obj).reverse();
+
+        return {};
+    }
+
+    Value countMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "count");
+
+        return Value(Value::SmallInt(deque(obj).countOf(args[0])));
+    }
+
+    Value indexMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 1, 3, "index");
+
+        const DequeValue& self = deque(obj);
+        const qsizetype start = args.size() > 1 ? bound(args[1], self.len()) : 0;
+        const qsizetype stop = args.size() > 2 ? bound(args[2], self.len()) : self.len();
+
+        return Value(Value::SmallInt(self.index(args[0], start, stop)));
+    }
+
+    Value copyMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "copy");
+
+        return deque(obj).copy();
+    }
+
+    const MethodTable DEQUE_METHODS = {
+        REGISTER_DIRECT_METHOD("__iter__", iterMethod),
+        REGISTER_DIRECT_METHOD("__len__", lenMethod),
+        REGISTER_DIRECT_METHOD("__getitem__", getitemMethod),
+        REGISTER_DIRECT_METHOD("__setitem__", setitemMethod),
+        REGISTER_DIRECT_METHOD("__delitem__", delitemMethod),
+        REGISTER_DIRECT_METHOD("__contains__", containsMethod),
+        REGISTER_DIRECT_METHOD("__eq__", equalMethod),
+        REGISTER_DIRECT_METHOD("__ne__", notEqualMethod),
+        REGISTER_DIRECT_METHOD("__copy__", copyMethod),
+        REGISTER_DIRECT_METHOD("append", appendMethod),
+        REGISTER_DIRECT_METHOD("appendleft", appendleftMethod),
+        REGISTER_DIRECT_METHOD("pop", popMethod),
+        REGISTER_DIRECT_METHOD("popleft", popleftMethod),
+        REGISTER_DIRECT_METHOD("extend", extendMethod),
+        REGISTER_DIRECT_METHOD("extendleft", extendleftMethod),
+        REGISTER_DIRECT_METHOD("insert", insertMethod),
+        REGISTER_DIRECT_METHOD("remove", removeMethod),
+        REGISTER_DIRECT_METHOD("clear", clearMethod),
+        REGISTER_DIRECT_METHOD("rotate", rotateMethod),
+        REGISTER_DIRECT_METHOD("reverse", reverseMethod),
+        REGISTER_DIRECT_METHOD("count", countMethod),
+        REGISTER_DIRECT_METHOD("index", indexMethod),
+        REGISTER_DIRECT_METHOD("copy", copyMethod),
+    };
+}
+
+std::optional<Value> getDequeAttr(const Value& obj, const QString& attr) {
+
+    if (attr == "maxlen") {
+        const std::optional<qsizetype> maxlen = deque(obj).maxLength();
+        return maxlen ? Value(Value::SmallInt(*maxlen)) : Value();
+    }
+
+    return getBuiltinAttr(obj, attr, DEQUE_METHODS);
+}
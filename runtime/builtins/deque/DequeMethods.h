@@ -0,0 +1,13 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_DEQUEMETHODS_H
+#define CPPYTHON_DEQUEMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// атрибут maxlen и методы collections.deque
+std::optional<Value> getDequeAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_DEQUEMETHODS_H
@@ -319,13 +319,23 @@ namespace {
             "update",
 
             [dict](const std::vector<Value>& args,
-                   const Kwargs&,
+                   const Kwargs& kwargs,
                    const std::shared_ptr<Environment>&)
                    -> Value {
 
-                expectArgs(args, 1, "update");
+                expectArgsRange(args, 0, 1, "update");
+
+                if (!args.empty() && args[0].isDict()) {
+                    dict->update(args[0].asDict());
+                } else if (!args.empty()) {
+                    dict->mergePairs(args[0]);
+                }
 
-                dict->update(args[0].asDict("update"));
+                dict->reserve(kwargs.size());
+
+                for (const auto& [name, value] : kwargs) {
+                    dict->setItem(Value(name), value);
+                }
 
                 return {};
             }
@@ -487,7 +497,7 @@ namespace {
 
 }
 
-Value getDictAttr(const Value& obj, const QString& attr) {
+std::optional<Value> getDictAttr(const Value& obj, const QString& attr) {
 
-    return getBuiltinAttr(obj, attr, DICT_METHODS, "dict");
+    return getBuiltinAttr(obj, attr, DICT_METHODS);
 }
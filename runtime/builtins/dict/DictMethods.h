@@ -4,7 +4,9 @@
 
 #ifndef CPPYTHON_DICTMETHODS_H
 #define CPPYTHON_DICTMETHODS_H
+#include <optional>
+
 #include "../../../headers/Value.h"
 
-Value getDictAttr(const Value& obj, const QString& attr);
+std::optional<Value> getDictAttr(const Value& obj, const QString& attr);
 #endif //CPPYTHON_DICTMETHODS_H
\ No newline at end of file
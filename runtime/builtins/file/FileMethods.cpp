@@ -0,0 +1,179 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "FileMethods.h"
+
+#include "ByteArrayValue.h"
+#include "FileValue.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    FileValue& fileOf(const Value& obj) {
+        return static_cast<FileValue&>(*extract<Value::IteratorPtr>(obj));
+    }
+
+    /// необязательный размер `read(size)`: None или отрицательное число — всё
+    std::optional<qsizetype> sizeArgument(const std::vector<Value>& args, const char* name) {
+
+        expectArgsRange(args, 0, 1, name);
+
+        if (args.empty() || args[0].isNone()) {
+            return std::nullopt;
+        }
+
+        return args[0].asBigInt(name).convert_to<qsizetype>();
+    }
+
+    Value readMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        return fileOf(obj).read(sizeArgument(args, "read"));
+    }
+
+    Value readlineMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "readline");
+
+        return fileOf(obj).readline();
+    }
+
+    Value readlinesMethod(const Value& obj,
+                          const std::vector<Value>& args,
+                          const Kwargs&,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "readlines");
+
+        return fileOf(obj).readlines();
+    }
+
+    Value readintoMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "readinto");
+
+        if (!args[0].isByteArray()) {
+            throw std::runtime_error("TypeError: readinto() argument must be bytearray");
+        }
+
+        return Value(static_cast<Value::SmallInt>(fileOf(obj).readinto(*args[0].asByteArray())));
+    }
+
+    Value writeMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "write");
+
+        return Value(static_cast<Value::SmallInt>(fileOf(obj).write(args[0])));
+    }
+
+    Value flushMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "flush");
+
+        fileOf(obj).flush();
+
+        return {};
+    }
+
+    Value closeMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "close");
+
+        fileOf(obj).close();
+
+        return {};
+    }
+
+    Value iterMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__iter__");
+
+        return obj;
+    }
+
+    Value nextMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__next__");
+
+        return fileOf(obj).next();
+    }
+
+    Value enterMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__enter__");
+
+        return obj;
+    }
+
+    Value exitMethod(const Value& obj,
+                     const std::vector<Value>&,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        fileOf(obj).close();
+
+        return Value(false);
+    }
+
+    const MethodTable FILE_METHODS = {
+        REGISTER_DIRECT_METHOD("read", readMethod),
+        REGISTER_DIRECT_METHOD("readline", readlineMethod),
+        REGISTER_DIRECT_METHOD("readlines", readlinesMethod),
+        REGISTER_DIRECT_METHOD("readinto", readintoMethod),
+        REGISTER_DIRECT_METHOD("write", writeMethod),
+        REGISTER_DIRECT_METHOD("flush", flushMethod),
+        REGISTER_DIRECT_METHOD("close", closeMethod),
+        REGISTER_DIRECT_METHOD("__iter__", iterMethod),
+        REGISTER_DIRECT_METHOD("__next__", nextMethod),
+        REGISTER_DIRECT_METHOD("__enter__", enterMethod),
+        REGISTER_DIRECT_METHOD("__exit__", exitMethod),
+    };
+}
+
+std::optional<Value> getFileAttr(const Value& obj, const QString& attr) {
+
+    const FileValue& file = fileOf(obj);
+
+    if (attr == "name") {
+        return Value(file.name());
+    }
+
+    if (attr == "mode") {
+        return Value(file.modeString());
+    }
+
+    if (attr == "closed") {
+        return Value(file.isClosed());
+    }
+
+    return getBuiltinAttr(obj, attr, FILE_METHODS);
+}
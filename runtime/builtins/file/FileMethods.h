@@ -0,0 +1,13 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_FILEMETHODS_H
+#define CPPYTHON_FILEMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// методы и атрибуты файлового объекта (name, mode, closed)
+std::optional<Value> getFileAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_FILEMETHODS_H
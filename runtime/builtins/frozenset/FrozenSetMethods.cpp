@@ -538,7 +538,7 @@ namespace {
 
 }
 
-Value getFrozenSetAttr(const Value& obj, const QString& attr) {
+std::optional<Value> getFrozenSetAttr(const Value& obj, const QString& attr) {
 
-    return getBuiltinAttr(obj, attr, FROZENSET_METHODS, "frozenset");
+    return getBuiltinAttr(obj, attr, FROZENSET_METHODS);
 }
\ No newline at end of file
@@ -4,7 +4,9 @@
 
 #ifndef CPPYTHON_FROZENSETMETHODS_H
 #define CPPYTHON_FROZENSETMETHODS_H
+#include <optional>
+
 #include "Value.h"
 
-Value getFrozenSetAttr(const Value& obj, const QString& attr);
+std::optional<Value> getFrozenSetAttr(const Value& obj, const QString& attr);
 #endif //CPPYTHON_FROZENSETMETHODS_H
\ No newline at end of file
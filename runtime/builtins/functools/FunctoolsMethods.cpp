@@ -0,0 +1,61 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "CachedFunctionValue.h"
+#include "ClassUtils.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    CachedFunctionValue& cached(const Value& obj) {
+        return *CachedFunctionValue::of(obj);
+    }
+
+    Value cacheInfoMethod(const Value& obj,
+                          const std::vector<Value>& args,
+                          const Kwargs&,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "cache_info");
+
+        return cached(obj).cacheInfo();
+    }
+
+    Value cacheClearMethod(const Value& obj,
+                           const std::vector<Value>& args,
+                           const Kwargs&,
+                           const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "cache_clear");
+
+        cached(obj).cacheClear();
+
+        return {};
+    }
+
+    const MethodTable CACHED_FUNCTION_METHODS = {
+        REGISTER_DIRECT_METHOD("cache_info", cacheInfoMethod),
+        REGISTER_DIRECT_METHOD("cache_clear", cacheClearMethod),
+    };
+}
+
+std::optional<Value> getCachedFunctionAttr(const Value& obj, const QString& attr) {
+
+    if (attr == "__wrapped__") {
+        return cached(obj).wrapped();
+    }
+
+    if (std::optional<Value> method = getBuiltinAttr(obj, attr, CACHED_FUNCTION_METHODS)) {
+        return method;
+    }
+
+    // `__name__`, `__doc__` и прочее — как у обёрнутой функции, по functools.update_wrapper
+    return tryGenericGetAttr(cached(obj).wrapped(), attr);
+}
+
+std::optional<Value> getCacheInfoAttr(const Value& obj, const QString& attr) {
+    return CacheInfoValue::of(obj)->field(attr);
+}
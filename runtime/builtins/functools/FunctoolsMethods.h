@@ -0,0 +1,16 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_FUNCTOOLSMETHODS_H
+#define CPPYTHON_FUNCTOOLSMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// cache_info(), cache_clear(), `__wrapped__` обёртки lru_cache; прочие атрибуты — обёрнутой функции
+std::optional<Value> getCachedFunctionAttr(const Value& obj, const QString& attr);
+
+/// поля hits, misses, maxsize, currsize результата cache_info()
+std::optional<Value> getCacheInfoAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_FUNCTOOLSMETHODS_H
@@ -0,0 +1,70 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "GeneratorMethods.h"
+
+#include "GeneratorValue.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    GeneratorValue& generatorOf(const Value& obj) {
+        return static_cast<GeneratorValue&>(*extract<Value::IteratorPtr>(obj));
+    }
+
+    Value iterMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__iter__");
+
+        return obj;
+    }
+
+    Value nextMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__next__");
+
+        return generatorOf(obj).next();
+    }
+
+    Value sendMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "send");
+
+        return generatorOf(obj).send(args[0]);
+    }
+
+    Value closeMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "close");
+
+        generatorOf(obj).close();
+
+        return {};
+    }
+
+    const MethodTable GENERATOR_METHODS = {
+        REGISTER_DIRECT_METHOD("__iter__", iterMethod),
+        REGISTER_DIRECT_METHOD("__next__", nextMethod),
+        REGISTER_DIRECT_METHOD("send", sendMethod),
+        REGISTER_DIRECT_METHOD("close", closeMethod),
+    };
+}
+
+std::optional<Value> getGeneratorAttr(const Value& obj, const QString& attr) {
+    return getBuiltinAttr(obj, attr, GENERATOR_METHODS);
+}
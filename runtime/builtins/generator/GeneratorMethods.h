@@ -0,0 +1,13 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_GENERATORMETHODS_H
+#define CPPYTHON_GENERATORMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// методы генератора: __iter__, __next__, send, close
+std::optional<Value> getGeneratorAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_GENERATORMETHODS_H
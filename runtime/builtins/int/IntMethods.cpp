@@ -0,0 +1,69 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "IntMath.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    /// сам целый без bool: `True.conjugate()` — это 1
+    Value asInt(const Value& obj) {
+        return obj.isBool() ? Value(obj.toBigInt()) : obj;
+    }
+
+    Value bitLengthMethod(const Value& obj,
+                          const std::vector<Value>& args,
+                          const Kwargs&,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "bit_length");
+
+        return Value(IntMath::bitLength(obj));
+    }
+
+    Value bitCountMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "bit_count");
+
+        return Value(IntMath::bitCount(obj));
+    }
+
+    Value conjugateMethod(const Value& obj,
+                          const std::vector<Value>& args,
+                          const Kwargs&,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "conjugate");
+
+        return asInt(obj);
+    }
+
+    const MethodTable INT_METHODS = {
+        REGISTER_DIRECT_METHOD("bit_length", bitLengthMethod),
+        REGISTER_DIRECT_METHOD("bit_count", bitCountMethod),
+        REGISTER_DIRECT_METHOD("conjugate", conjugateMethod),
+    };
+}
+
+std::optional<Value> getIntAttr(const Value& obj, const QString& attr) {
+
+    if (attr == "real" || attr == "numerator") {
+        return asInt(obj);
+    }
+
+    if (attr == "imag") {
+        return Value(Value::SmallInt(0));
+    }
+
+    if (attr == "denominator") {
+        return Value(Value::SmallInt(1));
+    }
+
+    return getBuiltinAttr(obj, attr, INT_METHODS);
+}
@@ -0,0 +1,13 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_INTMETHODS_H
+#define CPPYTHON_INTMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// методы int и bool: bit_length, bit_count, conjugate и атрибуты real/imag/numerator/denominator
+std::optional<Value> getIntAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_INTMETHODS_H
@@ -0,0 +1,260 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "MemoryIOMethods.h"
+
+#include "ByteArrayValue.h"
+#include "CallRuntime.h"
+#include "MemoryIOValue.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    /// StringIOValue или BytesIOValue внутри значения; тип выбирает таблица методов
+    template <typename Stream>
+    Stream& streamOf(const Value& obj) {
+        return static_cast<Stream&>(*extract<Value::IteratorPtr>(obj));
+    }
+
+    /// необязательный размер: None или отрицательное число — без ограничения
+    std::optional<qsizetype> sizeArgument(const std::vector<Value>& args, const char* name) {
+
+        expectArgsRange(args, 0, 1, name);
+
+        if (args.empty() || args[0].isNone()) {
+            return std::nullopt;
+        }
+
+        return args[0].asBigInt(name).convert_to<qsizetype>();
+    }
+
+    template <typename Stream>
+    Value readMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+        return streamOf<Stream>(obj).read(sizeArgument(args, "read"));
+    }
+
+    template <typename Stream>
+    Value readlineMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+        return streamOf<Stream>(obj).readline(sizeArgument(args, "readline"));
+    }
+
+    template <typename Stream>
+    Value readlinesMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 1, "readlines");
+
+        return streamOf<Stream>(obj).readlines();
+    }
+
+    template <typename Stream>
+    Value writeMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "write");
+
+        return Value(static_cast<Value::SmallInt>(streamOf<Stream>(obj).write(args[0])));
+    }
+
+    template <typename Stream>
+    Value writelinesMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                           const std::shared_ptr<Environment>& env) {
+
+        expectArgs(args, 1, "writelines");
+
+        Stream& stream = streamOf<Stream>(obj);
+        const Value iterator = getIter(args[0], env);
+
+        for (Value item; iterNext(iterator, item, env);) {
+            stream.write(item);
+        }
+
+        return {};
+    }
+
+    template <typename Stream>
+    Value getvalueMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "getvalue");
+
+        return streamOf<Stream>(obj).getvalue();
+    }
+
+    template <typename Stream>
+    Value seekMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 1, 2, "seek");
+
+        const qsizetype offset = args[0].asBigInt("seek").convert_to<qsizetype>();
+        const int whence = args.size() > 1 ? args[1].asBigInt("seek").convert_to<int>() : 0;
+
+        return Value(static_cast<Value::SmallInt>(streamOf<Stream>(obj).seek(offset, whence)));
+    }
+
+    template <typename Stream>
+    Value tellMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "tell");
+
+        return Value(static_cast<Value::SmallInt>(streamOf<Stream>(obj).tell()));
+    }
+
+    template <typename Stream>
+    Value truncateMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+        return Value(static_cast<Value::SmallInt>(streamOf<Stream>(obj).truncate(sizeArgument(args, "truncate"))));
+    }
+
+    /// readable(), writable(), seekable(): у открытого потока в памяти — всегда True
+    template <typename Stream>
+    Value capabilityMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                           const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "readable");
+        streamOf<Stream>(obj).ensureOpen();
+
+        return Value(true);
+    }
+
+    template <typename Stream>
+    Value flushMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "flush");
+        streamOf<Stream>(obj).ensureOpen();
+
+        return {};
+    }
+
+    template <typename Stream>
+    Value closeMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "close");
+        streamOf<Stream>(obj).close();
+
+        return {};
+    }
+
+    template <typename Stream>
+    Value iterMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__iter__");
+        streamOf<Stream>(obj).ensureOpen();
+
+        return obj;
+    }
+
+    template <typename Stream>
+    Value nextMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__next__");
+
+        return streamOf<Stream>(obj).next();
+    }
+
+    template <typename Stream>
+    Value enterMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__enter__");
+        streamOf<Stream>(obj).ensureOpen();
+
+        return obj;
+    }
+
+    template <typename Stream>
+    Value exitMethod(const Value& obj, const std::vector<Value>&, const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        streamOf<Stream>(obj).close();
+
+        return Value(false);
+    }
+
+    Value getbufferMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "getbuffer");
+
+        return streamOf<BytesIOValue>(obj).getbuffer();
+    }
+
+    Value readintoMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "readinto");
+
+        if (!args[0].isByteArray()) {
+            throw std::runtime_error("TypeError: readinto() argument must be bytearray");
+        }
+
+        return Value(static_cast<Value::SmallInt>(streamOf<BytesIOValue>(obj).readinto(*args[0].asByteArray())));
+    }
+
+    /// общие методы StringIO и BytesIO
+    template <typename Stream>
+    MethodTable streamMethods() {
+
+        return {
+            REGISTER_DIRECT_METHOD("read", readMethod<Stream>),
+            REGISTER_DIRECT_METHOD("readline", readlineMethod<Stream>),
+            REGISTER_DIRECT_METHOD("readlines", readlinesMethod<Stream>),
+            REGISTER_DIRECT_METHOD("write", writeMethod<Stream>),
+            REGISTER_DIRECT_METHOD("writelines", writelinesMethod<Stream>),
+            REGISTER_DIRECT_METHOD("getvalue", getvalueMethod<Stream>),
+            REGISTER_DIRECT_METHOD("seek", seekMethod<Stream>),
+            REGISTER_DIRECT_METHOD("tell", tellMethod<Stream>),
+            REGISTER_DIRECT_METHOD("truncate", truncateMethod<Stream>),
+            REGISTER_DIRECT_METHOD("readable", capabilityMethod<Stream>),
+            REGISTER_DIRECT_METHOD("writable", capabilityMethod<Stream>),
+            REGISTER_DIRECT_METHOD("seekable", capabilityMethod<Stream>),
+            REGISTER_DIRECT_METHOD("flush", flushMethod<Stream>),
+            REGISTER_DIRECT_METHOD("close", closeMethod<Stream>),
+            REGISTER_DIRECT_METHOD("__iter__", iterMethod<Stream>),
+            REGISTER_DIRECT_METHOD("__next__", nextMethod<Stream>),
+            REGISTER_DIRECT_METHOD("__enter__", enterMethod<Stream>),
+            REGISTER_DIRECT_METHOD("__exit__", exitMethod<Stream>),
+        };
+    }
+
+    const MethodTable STRINGIO_METHODS = streamMethods<StringIOValue>();
+
+    const MethodTable BYTESIO_METHODS = [] {
+
+        MethodTable methods = streamMethods<BytesIOValue>();
+
+        methods.insert("getbuffer", getbufferMethod);
+        methods.insert("readinto", readintoMethod);
+
+        return methods;
+    }();
+}
+
+std::optional<Value> getStringIOAttr(const Value& obj, const QString& attr) {
+
+    if (attr == "closed") {
+        return Value(streamOf<StringIOValue>(obj).isClosed());
+    }
+
+    return getBuiltinAttr(obj, attr, STRINGIO_METHODS);
+}
+
+std::optional<Value> getBytesIOAttr(const Value& obj, const QString& attr) {
+
+    if (attr == "closed") {
+        return Value(streamOf<BytesIOValue>(obj).isClosed());
+    }
+
+    return getBuiltinAttr(obj, attr, BYTESIO_METHODS);
+}
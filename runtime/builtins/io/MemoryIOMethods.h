@@ -0,0 +1,16 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MEMORYIOMETHODS_H
+#define CPPYTHON_MEMORYIOMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// методы io.StringIO и атрибут closed
+std::optional<Value> getStringIOAttr(const Value& obj, const QString& attr);
+
+/// методы io.BytesIO, включая getbuffer и readinto, и атрибут closed
+std::optional<Value> getBytesIOAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_MEMORYIOMETHODS_H
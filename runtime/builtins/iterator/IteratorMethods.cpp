@@ -52,7 +52,7 @@ namespace {
 
 }
 
-Value getIteratorAttr(const Value& obj, const QString& attr) {
+std::optional<Value> getIteratorAttr(const Value& obj, const QString& attr) {
 
-    return getBuiltinAttr(obj, attr, ITERATOR_METHODS, "iterator");
+    return getBuiltinAttr(obj, attr, ITERATOR_METHODS);
 }
@@ -4,7 +4,9 @@
 
 #ifndef CPPYTHON_ITERATORMETHODS_H
 #define CPPYTHON_ITERATORMETHODS_H
+#include <optional>
+
 #include "../../../headers/Value.h"
 
-Value getIteratorAttr(const Value& obj, const QString& attr);
+std::optional<Value> getIteratorAttr(const Value& obj, const QString& attr);
 #endif //CPPYTHON_ITERATORMETHODS_H
\ No newline at end of file
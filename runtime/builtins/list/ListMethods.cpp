@@ -7,624 +7,473 @@
 #include "../BuiltinAttrLookup.h"
 #include "../BuiltinMethodRegistry.h"
 #include "../../ArgValidation.h"
-#include "../../ProtocolHelpers.h"
 #include "../../RuntimeUtils.h"
 
 namespace {
 
-    Value make_getitem_Method(const Value& obj) {
+    Value iterMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
 
-        auto list = extract<Value::ListPtr>(obj);
+        expectArgs(args, 0, "__iter__");
 
-        return makeBuiltin(
-            "__getitem__",
+        return Value(obj.getIterator());
+    }
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
+    Value lenMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
 
-                expectArgs(args, 1, "__getitem__");
+        expectArgs(args, 0, "__len__");
 
-                return list->getItem(args[0]);
-            }
-        );
+        return Value(Value::BigInt(extract<Value::ListPtr>(obj)->len()));
     }
 
-    Value make_setitem_Method(const Value& obj) {
+    Value getitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__setitem__",
-
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
-
-                expectArgs(args, 2, "__setitem__");
-
-                list->setItem(args[0], args[1]);
+        expectArgs(args, 1, "__getitem__");
 
-                return {};
-            }
-        );
+        return list->getItem(args[0]);
     }
 
-    Value makeDelItemMethod(const Value& obj) {
+    Value setitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__delitem__",
-
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-            -> Value {
-
-                expectArgs(args, 1, "__delitem__");
+        expectArgs(args, 2, "__setitem__");
 
-                list->delItem(args[0]);
+        list->setItem(args[0], args[1]);
 
-                return {};
-            }
-        );
+        return {};
     }
 
-    Value makeContainsMethod(const Value& obj) {
+    Value delItemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__contains__",
-
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-            -> Value {
+        expectArgs(args, 1, "__delitem__");
 
-                expectArgs(args, 1, "__contains__");
+        list->delItem(args[0]);
 
-                return Value(list->contains(args[0]));
-            }
-        );
+        return {};
     }
 
-    Value makeEqualMethod(const Value& obj) {
+    Value containsMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__eq__",
+        expectArgs(args, 1, "__contains__");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
-
-                expectArgs(args, 1, "__eq__");
-
-                return Value(list->equal(args[0]));
-            }
-        );
+        return Value(list->contains(args[0]));
     }
 
-    Value makeNotEqualMethod(const Value& obj) {
+    Value equalMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__ne__",
+        expectArgs(args, 1, "__eq__");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
-
-                expectArgs(args, 1, "__ne__");
-
-                return Value(list->notEqual(args[0]));
-            }
-        );
+        return Value(list->equal(args[0]));
     }
 
-    Value makeLessOrEqualMethod(const Value& obj) {
+    Value notEqualMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__le__",
+        expectArgs(args, 1, "__ne__");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
-
-                expectArgs(args, 1, "__le__");
-
-                return Value(list->lessOrEqual(args[0]));
-            }
-        );
+        return Value(list->notEqual(args[0]));
     }
 
-    Value makeLessMethod(const Value& obj) {
+    Value lessOrEqualMethod(const Value& obj,
+                            const std::vector<Value>& args,
+                            const Kwargs&,
+                            const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__lt__",
+        expectArgs(args, 1, "__le__");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
-
-                expectArgs(args, 1, "__lt__");
-
-                return Value(list->less(args[0]));
-            }
-        );
+        return Value(list->lessOrEqual(args[0]));
     }
 
-    Value makeGreaterOrEqualMethod(const Value& obj) {
+    Value lessMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__ge__",
+        expectArgs(args, 1, "__lt__");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
-
-                expectArgs(args, 1, "__ge__");
-
-                return Value(list->greaterOrEqual(args[0]));
-            }
-        );
+        return Value(list->less(args[0]));
     }
 
-    Value makeGreaterMethod(const Value& obj) {
+    Value greaterOrEqualMethod(const Value& obj,
+                               const std::vector<Value>& args,
+                               const Kwargs&,
+                               const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__gt__",
+        expectArgs(args, 1, "__ge__");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
-
-                expectArgs(args, 1, "__gt__");
-
-                return Value(list->greater(args[0]));
-            }
-        );
+        return Value(list->greaterOrEqual(args[0]));
     }
 
-    Value makeAddMethod(const Value& obj) {
+    Value greaterMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__add__",
+        expectArgs(args, 1, "__gt__");
 
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-            -> Value {
-
-                expectArgs(args, 1, "__add__");
-
-                return list->add(args[0]);
-            }
-        );
+        return Value(list->greater(args[0]));
     }
 
-    Value makeIAddMethod(const Value& obj) {
+    Value addMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__iadd__",
+        expectArgs(args, 1, "__add__");
 
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-            -> Value {
-
-                expectArgs(args, 1, "__iadd__");
-
-                return list->iadd(args[0]);
-            }
-        );
+        return list->add(args[0]);
     }
 
-    Value makeMulMethod(const Value& obj) {
+    Value iaddMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__mul__",
+        expectArgs(args, 1, "__iadd__");
 
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-            -> Value {
-
-                expectArgs(args, 1, "__mul__");
-
-                return list->multiply(args[0]);
-            }
-        );
+        return list->iadd(args[0]);
     }
 
-    Value makeRMulMethod(const Value& obj) {
+    Value mulMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__rmul__",
+        expectArgs(args, 1, "__mul__");
 
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-            -> Value {
-
-                expectArgs(args, 1, "__rmul__");
-
-                return list->rmul(args[0]);
-            }
-        );
+        return list->multiply(args[0]);
     }
 
-    Value makeIMulMethod(const Value& obj) {
+    Value rmulMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__imul__",
+        expectArgs(args, 1, "__rmul__");
 
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-            -> Value {
-
-                expectArgs(args, 1, "__imul__");
-
-                return list->imul(args[0]);
-            }
-        );
+        return list->rmul(args[0]);
     }
 
-    Value makeReversedMethod(const Value& obj) {
+    Value imulMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__reversed__",
+        expectArgs(args, 1, "__imul__");
 
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-            -> Value {
-
-                expectArgs(args, 0, "__reversed__");
-
-                return list->reversed();
-            }
-        );
+        return list->imul(args[0]);
     }
 
-    Value makeReprMethod(const Value& obj) {
+    Value reversedMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "__repr__",
+        expectArgs(args, 0, "__reversed__");
 
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-            -> Value {
-
-                expectArgs(args, 0, "__repr__");
-
-                return Value(list->repr());
-            }
-        );
+        return list->reversed();
     }
 
-    Value makeAppendMethod(const Value& obj) {
+    Value reprMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "append",
-
-            [list](const std::vector<Value>& args,
-                   const Kwargs&,
-                   const std::shared_ptr<Environment>&)
-                   -> Value {
-
-                expectArgs(args, 1, "append");
-
-                list->append(args[0]);
+        expectArgs(args, 0, "__repr__");
 
-                return {};
-            }
-        );
+        return Value(list->repr());
     }
 
-    Value makePopMethod(const Value& obj) {
+    Value appendMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "pop",
-
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
-
-                if (args.empty()) {
-                    return list->pop();
-                }
+        expectArgs(args, 1, "append");
 
-                if (args.size() == 1) {
-                    return list->pop(args[0]);
-                }
+        list->append(args[0]);
 
-                throw std::runtime_error("pop expects at most 1 arg");
-            }
-        );
+        return {};
     }
 
-    Value makeExtendMethod(const Value& obj) {
+    Value popMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "extend",
+        if (args.empty()) {
+            return list->pop();
+        }
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
+        if (args.size() == 1) {
+            return list->pop(args[0]);
+        }
 
-                expectArgs(args, 1, "extend");
-
-                list->extend(args[0]);
-
-                return {};
-            }
-        );
+        throw std::runtime_error("pop expects at most 1 arg");
     }
 
-    Value makeInsertMethod(const Value& obj) {
+    Value extendMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "insert",
+        expectArgs(args, 1, "extend");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
+        list->extend(args[0]);
 
-                expectArgs(args, 2, "insert");
-
-                list->insert(args[0], args[1]);
-
-                return {};
-            }
-        );
+        return {};
     }
 
-    Value makeRemoveMethod(const Value& obj) {
+    Value insertMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "remove",
+        expectArgs(args, 2, "insert");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
+        list->insert(args[0], args[1]);
 
-                expectArgs(args, 1, "remove");
-
-                list->remove(args[0]);
-
-                return {};
-            }
-        );
+        return {};
     }
 
-    Value makeClearMethod(const Value& obj) {
+    Value removeMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "clear",
+        expectArgs(args, 1, "remove");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
+        list->remove(args[0]);
 
-                expectArgs(args, 0, "clear");
-
-                list->clear();
-
-                return {};
-            }
-        );
+        return {};
     }
 
-    Value makeCountMethod(const Value& obj) {
+    Value clearMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "count",
+        expectArgs(args, 0, "clear");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
+        list->clear();
 
-                expectArgs(args, 1, "count");
-
-                return list->count(args[0]);
-            }
-        );
+        return {};
     }
 
-    Value makeIndexMethod(const Value& obj) {
+    Value countMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "index",
-
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
-
-                expectArgsRange(args, 1, 3, "index");
-
-                if (args.size() == 1) {
-                    return list->index(args[0]);
-                }
-
-                if (args.size() == 2) {
-                    return list->index(args[0], args[1]);
-                }
+        expectArgs(args, 1, "count");
 
-                return list->index(args[0], args[1], args[2]);
-            }
-        );
+        return list->count(args[0]);
     }
 
-    Value makeReverseMethod(const Value& obj) {
+    Value indexMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "reverse",
+        expectArgsRange(args, 1, 3, "index");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
+        if (args.size() == 1) {
+            return list->index(args[0]);
+        }
 
-                expectArgs(args, 0, "reverse");
+        if (args.size() == 2) {
+            return list->index(args[0], args[1]);
+        }
 
-                list->reverse();
-
-                return {};
-            }
-        );
+        return list->index(args[0], args[1], args[2]);
     }
 
-    Value makeCopyMethod(const Value& obj) {
+    Value reverseMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "copy",
-
-            [list](const std::vector<Value> &args,
-                   const Kwargs &,
-                   const std::shared_ptr<Environment> &) -> Value {
+        expectArgs(args, 0, "reverse");
 
-                expectArgs(args, 0, "copy");
+        list->reverse();
 
-                return list->copy();
-            }
-        );
+        return {};
     }
 
-    Value makeSortMethod(const Value& obj) {
+    Value copyMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
 
         auto list = extract<Value::ListPtr>(obj);
 
-        return makeBuiltin(
-            "sort",
+        expectArgs(args, 0, "copy");
 
-            [list](const std::vector<Value> &args,
-                   const Kwargs &kwargs,
-                   const std::shared_ptr<Environment> &env) -> Value {
+        return list->copy();
+    }
 
-                std::optional<Value> key = std::nullopt;
+    Value sortMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs& kwargs,
+                     const std::shared_ptr<Environment>& env) {
 
-                bool reverse = false;
+        auto list = extract<Value::ListPtr>(obj);
 
-                for (const auto &[name, value]: kwargs) {
+        std::optional<Value> key = std::nullopt;
 
-                    if (name == "key") {
-                        key = value;
-                    } else if (name == "reverse") {
-                        reverse = value.toBool();
-                    } else {
-                        throw std::runtime_error("Unknown keyword argument: " + name.toStdString());
-                    }
-                }
+        bool reverse = false;
 
-                expectArgsRange(args, 0, 2, "sort");
-
-                // sort(key)
-                // sort(reverse)
-                if (!args.empty()) {
-                    // если callable, то это key
-                    if (args[0].isCallable()) {
-                        key = args[0];
-                    } else {
-                        reverse = args[0].toBool();
-                    }
-                }
+        for (const auto &[name, value]: kwargs) {
 
-                // sort(key, reverse)
-                if (args.size() == 2) {
-                    key = args[0];
-                    reverse = args[1].toBool();
+            if (name == "key") {
+                // key=None — сортировка по самим элементам
+                if (!value.isNone()) {
+                    key = value;
                 }
+            } else if (name == "reverse") {
+                reverse = value.toBool();
+            } else {
+                throw std::runtime_error("Unknown keyword argument: " + name.toStdString());
+            }
+        }
+
+        expectArgsRange(args, 0, 2, "sort");
+
+        // sort(key)
+        // sort(reverse)
+        if (!args.empty()) {
+            // если callable, то это key
+            if (args[0].isCallable()) {
+                key = args[0];
+            } else {
+                reverse = args[0].toBool();
+            }
+        }
 
-                list->sort(key, reverse, env);
+        // sort(key, reverse)
+        if (args.size() == 2) {
+            key = args[0];
+            reverse = args[1].toBool();
+        }
 
-                return {};
-            }
-        );
+        list->sort(key, reverse, env);
+
+        return {};
     }
 
-    const MethodMap LIST_METHODS = {
-        REGISTER_METHOD("__getitem__", make_getitem_Method),
-        REGISTER_METHOD("__setitem__", make_setitem_Method),
-        REGISTER_METHOD("__delitem__", makeDelItemMethod),
-        REGISTER_METHOD("__iter__", makeIterMethodBuiltin),
-        REGISTER_METHOD("__contains__", makeContainsMethod),
-        REGISTER_METHOD("__len__", makeLenMethodBuiltin<Value::ListPtr>),
-        REGISTER_METHOD("__eq__", makeEqualMethod),
-        REGISTER_METHOD("__ne__", makeNotEqualMethod),
-        REGISTER_METHOD("__le__", makeLessOrEqualMethod),
-        REGISTER_METHOD("__lt__", makeLessMethod),
-        REGISTER_METHOD("__ge__", makeGreaterOrEqualMethod),
-        REGISTER_METHOD("__gt__", makeGreaterMethod),
-        REGISTER_METHOD("__add__", makeAddMethod),
-        REGISTER_METHOD("__iadd__", makeIAddMethod),
-        REGISTER_METHOD("__mul__", makeMulMethod),
-        REGISTER_METHOD("__imul__", makeIMulMethod),
-        REGISTER_METHOD("__rmul__", makeRMulMethod),
-        REGISTER_METHOD("__reversed__", makeReversedMethod),
-        REGISTER_METHOD("__repr__", makeReprMethod),
-        REGISTER_METHOD("append", makeAppendMethod),
-        REGISTER_METHOD("pop", makePopMethod),
-        REGISTER_METHOD("extend", makeExtendMethod),
-        REGISTER_METHOD("insert", makeInsertMethod),
-        REGISTER_METHOD("remove", makeRemoveMethod),
-        REGISTER_METHOD("clear", makeClearMethod),
-        REGISTER_METHOD("count", makeCountMethod),
-        REGISTER_METHOD("index", makeIndexMethod),
-        REGISTER_METHOD("reverse", makeReverseMethod),
-        REGISTER_METHOD("copy", makeCopyMethod),
-        REGISTER_METHOD("sort", makeSortMethod)
+    const MethodTable LIST_METHODS = {
+        REGISTER_DIRECT_METHOD("__getitem__", getitemMethod),
+        REGISTER_DIRECT_METHOD("__setitem__", setitemMethod),
+        REGISTER_DIRECT_METHOD("__delitem__", delItemMethod),
+        REGISTER_DIRECT_METHOD("__iter__", iterMethod),
+        REGISTER_DIRECT_METHOD("__contains__", containsMethod),
+        REGISTER_DIRECT_METHOD("__len__", lenMethod),
+        REGISTER_DIRECT_METHOD("__eq__", equalMethod),
+        REGISTER_DIRECT_METHOD("__ne__", notEqualMethod),
+        REGISTER_DIRECT_METHOD("__le__", lessOrEqualMethod),
+        REGISTER_DIRECT_METHOD("__lt__", lessMethod),
+        REGISTER_DIRECT_METHOD("__ge__", greaterOrEqualMethod),
+        REGISTER_DIRECT_METHOD("__gt__", greaterMethod),
+        REGISTER_DIRECT_METHOD("__add__", addMethod),
+        REGISTER_DIRECT_METHOD("__iadd__", iaddMethod),
+        REGISTER_DIRECT_METHOD("__mul__", mulMethod),
+        REGISTER_DIRECT_METHOD("__imul__", imulMethod),
+        REGISTER_DIRECT_METHOD("__rmul__", rmulMethod),
+        REGISTER_DIRECT_METHOD("__reversed__", reversedMethod),
+        REGISTER_DIRECT_METHOD("__repr__", reprMethod),
+        REGISTER_DIRECT_METHOD("append", appendMethod),
+        REGISTER_DIRECT_METHOD("pop", popMethod),
+        REGISTER_DIRECT_METHOD("extend", extendMethod),
+        REGISTER_DIRECT_METHOD("insert", insertMethod),
+        REGISTER_DIRECT_METHOD("remove", removeMethod),
+        REGISTER_DIRECT_METHOD("clear", clearMethod),
+        REGISTER_DIRECT_METHOD("count", countMethod),
+        REGISTER_DIRECT_METHOD("index", indexMethod),
+        REGISTER_DIRECT_METHOD("reverse", reverseMethod),
+        REGISTER_DIRECT_METHOD("copy", copyMethod),
+        REGISTER_DIRECT_METHOD("sort", sortMethod)
     };
 }
 
-Value getListAttr(const Value &obj, const QString &attr) {
+std::optional<Value> getListAttr(const Value& obj, const QString& attr) {
+
+    return getBuiltinAttr(obj, attr, LIST_METHODS);
+}
+
+BuiltinMethod findListMethod(const QString &attr) {
 
-    return getBuiltinAttr(obj, attr, LIST_METHODS, "list");
+    return findBuiltinMethod(attr, LIST_METHODS);
 }
\ No newline at end of file
@@ -4,7 +4,13 @@
 
 #ifndef CPPYTHON_BUILTINATTRHANDLERS_H
 #define CPPYTHON_BUILTINATTRHANDLERS_H
+#include <optional>
+
 #include "../../../headers/Value.h"
+#include "../BuiltinMethodRegistry.h"
+
+std::optional<Value> getListAttr(const Value& obj, const QString& attr);
 
-Value getListAttr(const Value& obj, const QString& attr);
+/// метод списка для прямого вызова или nullptr
+BuiltinMethod findListMethod(const QString& attr);
 #endif //CPPYTHON_BUILTINATTRHANDLERS_H
\ No newline at end of file
@@ -0,0 +1,200 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "BytesValue.h"
+#include "MemoryViewIterator.h"
+#include "MemoryViewValue.h"
+#include "TupleValue.h"
+#include "ObjectPool.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    MemoryViewValue& view(const Value& obj) {
+        return *MemoryViewValue::of(obj);
+    }
+
+    Value iterMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__iter__");
+
+        view(obj).ensureAlive();
+
+        const auto self = std::static_pointer_cast<MemoryViewValue>(std::get<Value::ObjectPtr>(obj.data));
+
+        return Value(std::static_pointer_cast<IteratorValue>(std::make_shared<MemoryViewIterator>(self)));
+    }
+
+    Value lenMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__len__");
+
+        return Value(Value::SmallInt(view(obj).len()));
+    }
+
+    Value getitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__getitem__");
+
+        return view(obj).getItem(args[0]);
+    }
+
+    Value setitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 2, "__setitem__");
+
+        view(obj).setItem(args[0], args[1]);
+
+        return {};
+    }
+
+    Value equalMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__eq__");
+
+        return Value(view(obj).equal(args[0]));
+    }
+
+    Value notEqualMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__ne__");
+
+        return Value(view(obj).notEqual(args[0]));
+    }
+
+    Value releaseMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "release");
+
+        view(obj).release();
+
+        return {};
+    }
+
+    Value tobytesMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "tobytes");
+
+        return Value(std::make_shared<BytesValue>(view(obj).toBytes()));
+    }
+
+    Value tolistMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "tolist");
+
+        return view(obj).toList();
+    }
+
+    Value hexMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        return BytesValue::hexOf(view(obj).toBytes(), args);
+    }
+
+    Value castMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "cast");
+
+        if (!args[0].isString()) {
+            throw std::runtime_error("TypeError: memoryview: format argument must be a string");
+        }
+
+        return view(obj).cast(args[0].toString());
+    }
+
+    const MethodTable MEMORYVIEW_METHODS = {
+        REGISTER_DIRECT_METHOD("__iter__", iterMethod),
+        REGISTER_DIRECT_METHOD("__len__", lenMethod),
+        REGISTER_DIRECT_METHOD("__getitem__", getitemMethod),
+        REGISTER_DIRECT_METHOD("__setitem__", setitemMethod),
+        REGISTER_DIRECT_METHOD("__eq__", equalMethod),
+        REGISTER_DIRECT_METHOD("__ne__", notEqualMethod),
+        REGISTER_DIRECT_METHOD("release", releaseMethod),
+        REGISTER_DIRECT_METHOD("tobytes", tobytesMethod),
+        REGISTER_DIRECT_METHOD("tolist", tolistMethod),
+        REGISTER_DIRECT_METHOD("hex", hexMethod),
+        REGISTER_DIRECT_METHOD("cast", castMethod),
+    };
+
+    Value oneTuple(const Value::SmallInt value) {
+        return Value(makePooled<TupleValue>(std::vector<Value>{Value(value)}));
+    }
+}
+
+std::optional<Value> getMemoryViewAttr(const Value& obj, const QString& attr) {
+
+    const MemoryViewValue& mv = view(obj);
+
+    if (attr == "obj") {
+        return mv.object();
+    }
+
+    if (attr == "nbytes") {
+        return Value(Value::SmallInt(mv.nbytes()));
+    }
+
+    if (attr == "readonly") {
+        return Value(mv.readOnly());
+    }
+
+    if (attr == "itemsize") {
+        return Value(Value::SmallInt(mv.itemSize()));
+    }
+
+    if (attr == "format") {
+        return Value(mv.format());
+    }
+
+    if (attr == "ndim") {
+        return Value(Value::SmallInt(1));
+    }
+
+    if (attr == "shape") {
+        return oneTuple(mv.len());
+    }
+
+    if (attr == "strides") {
+        return oneTuple(mv.strides());
+    }
+
+    if (attr == "contiguous" || attr == "c_contiguous" || attr == "f_contiguous") {
+        return Value(mv.contiguous());
+    }
+
+    return getBuiltinAttr(obj, attr, MEMORYVIEW_METHODS);
+}
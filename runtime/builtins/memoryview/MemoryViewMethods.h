@@ -0,0 +1,13 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_MEMORYVIEWMETHODS_H
+#define CPPYTHON_MEMORYVIEWMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// атрибуты буфера (obj, nbytes, format...) и методы memoryview
+std::optional<Value> getMemoryViewAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_MEMORYVIEWMETHODS_H
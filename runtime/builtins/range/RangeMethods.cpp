@@ -0,0 +1,150 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "RangeValue.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    Value iterMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__iter__");
+
+        return Value(obj.getIterator());
+    }
+
+    Value reversedMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__reversed__");
+
+        return Value(extract<Value::RangePtr>(obj)->makeIterator(true));
+    }
+
+    Value lenMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__len__");
+
+        return Value(extract<Value::RangePtr>(obj)->len());
+    }
+
+    Value getitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__getitem__");
+
+        return extract<Value::RangePtr>(obj)->getItem(args[0]);
+    }
+
+    Value containsMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__contains__");
+
+        return Value(extract<Value::RangePtr>(obj)->contains(args[0]));
+    }
+
+    Value equalMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__eq__");
+
+        return Value(extract<Value::RangePtr>(obj)->equal(args[0]));
+    }
+
+    Value notEqualMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__ne__");
+
+        return Value(extract<Value::RangePtr>(obj)->notEqual(args[0]));
+    }
+
+    Value hashMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__hash__");
+
+        return Value(Value::BigInt(extract<Value::RangePtr>(obj)->hash()));
+    }
+
+    Value countMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "count");
+
+        // элементы прогрессии различны, поэтому значение встречается не больше одного раза
+        return Value(static_cast<Value::SmallInt>(extract<Value::RangePtr>(obj)->contains(args[0]) ? 1 : 0));
+    }
+
+    Value indexMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "index");
+
+        const Value::SmallInt index = extract<Value::RangePtr>(obj)->indexOf(args[0]);
+
+        if (index < 0) {
+            throw std::runtime_error("ValueError: " + args[0].toString().toStdString() + " is not in range");
+        }
+
+        return Value(index);
+    }
+
+    const MethodTable RANGE_METHODS = {
+        REGISTER_DIRECT_METHOD("__iter__", iterMethod),
+        REGISTER_DIRECT_METHOD("__reversed__", reversedMethod),
+        REGISTER_DIRECT_METHOD("__len__", lenMethod),
+        REGISTER_DIRECT_METHOD("__getitem__", getitemMethod),
+        REGISTER_DIRECT_METHOD("__contains__", containsMethod),
+        REGISTER_DIRECT_METHOD("__eq__", equalMethod),
+        REGISTER_DIRECT_METHOD("__ne__", notEqualMethod),
+        REGISTER_DIRECT_METHOD("__hash__", hashMethod),
+        REGISTER_DIRECT_METHOD("count", countMethod),
+        REGISTER_DIRECT_METHOD("index", indexMethod),
+    };
+}
+
+std::optional<Value> getRangeAttr(const Value& obj, const QString& attr) {
+
+    const auto range = extract<Value::RangePtr>(obj);
+
+    if (attr == "start") {
+        return range->startValue();
+    }
+
+    if (attr == "stop") {
+        return range->stopValue();
+    }
+
+    if (attr == "step") {
+        return range->stepValue();
+    }
+
+    return getBuiltinAttr(obj, attr, RANGE_METHODS);
+}
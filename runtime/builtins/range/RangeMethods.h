@@ -0,0 +1,13 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_RANGEMETHODS_H
+#define CPPYTHON_RANGEMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// атрибуты start/stop/step и методы range
+std::optional<Value> getRangeAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_RANGEMETHODS_H
@@ -0,0 +1,314 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "RegexMethods.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "ClassUtils.h"
+#include "DictValue.h"
+#include "RegexValue.h"
+#include "StrValue.h"
+#include "TupleValue.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    const PatternValue& pattern(const Value& obj) {
+        return *PatternValue::of(obj);
+    }
+
+    const MatchValue& match(const Value& obj) {
+        return *MatchValue::of(obj);
+    }
+
+    qsizetype integer(const Value* value, const qsizetype fallback) {
+
+        if (!value) {
+            return fallback;
+        }
+
+        if (!value->isBigInt() && !value->isBool()) {
+            throw std::runtime_error(
+                "TypeError: '" + typeName(*value).toStdString() + "' object cannot be interpreted as an integer");
+        }
+
+        const Value::BigInt number = value->toBigInt();
+
+        return number > std::numeric_limits<qsizetype>::max() ? std::numeric_limits<qsizetype>::max()
+                                                              : number.convert_to<qsizetype>();
+    }
+
+    Value::StrPtr subject(const Value* value) {
+
+        if (!value) {
+            throw std::runtime_error("TypeError: missing required argument 'string'");
+        }
+
+        if (!value->isString()) {
+            throw std::runtime_error(
+                "TypeError: expected string or bytes-like object, got '" + typeName(*value).toStdString() + "'");
+        }
+
+        return value->asString();
+    }
+
+    /// match, search и fullmatch: string, pos=0, endpos=len(string)
+    Value find(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+               const PatternValue::Anchor anchor, const char* name) {
+
+        expectArgsRange(args, 0, 3, name);
+
+        const Value::StrPtr string = subject(option(args, kwargs, 0, "string"));
+        const qsizetype pos = integer(option(args, kwargs, 1, "pos"), 0);
+        const qsizetype endpos = integer(option(args, kwargs, 2, "endpos"), std::numeric_limits<qsizetype>::max());
+
+        return pattern(obj).match(string, pos, endpos, anchor);
+    }
+
+    Value matchMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                      const std::shared_ptr<Environment>&) {
+        return find(obj, args, kwargs, PatternValue::Anchor::Start, "match");
+    }
+
+    Value searchMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                       const std::shared_ptr<Environment>&) {
+        return find(obj, args, kwargs, PatternValue::Anchor::Search, "search");
+    }
+
+    Value fullmatchMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                          const std::shared_ptr<Environment>&) {
+        return find(obj, args, kwargs, PatternValue::Anchor::Full, "fullmatch");
+    }
+
+    Value findallMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 3, "findall");
+
+        return pattern(obj).findAll(subject(option(args, kwargs, 0, "string")),
+                                    integer(option(args, kwargs, 1, "pos"), 0),
+                                    integer(option(args, kwargs, 2, "endpos"), std::numeric_limits<qsizetype>::max()));
+    }
+
+    Value finditerMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 3, "finditer");
+
+        return pattern(obj).findIter(subject(option(args, kwargs, 0, "string")),
+                                     integer(option(args, kwargs, 1, "pos"), 0),
+                                     integer(option(args, kwargs, 2, "endpos"), std::numeric_limits<qsizetype>::max()));
+    }
+
+    std::pair<Value, qsizetype> substitute(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                                           const std::shared_ptr<Environment>& env, const char* name) {
+
+        expectArgsRange(args, 0, 3, name);
+
+        const Value* repl = option(args, kwargs, 0, "repl");
+
+        if (!repl) {
+            throw std::runtime_error(std::string("TypeError: ") + name + "() missing required argument 'repl'");
+        }
+
+        return pattern(obj).sub(*repl, subject(option(args, kwargs, 1, "string")),
+                                integer(option(args, kwargs, 2, "count"), 0), env);
+    }
+
+    Value subMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                    const std::shared_ptr<Environment>& env) {
+        return substitute(obj, args, kwargs, env, "sub").first;
+    }
+
+    Value subnMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                     const std::shared_ptr<Environment>& env) {
+
+        auto [text, count] = substitute(obj, args, kwargs, env, "subn");
+
+        return TupleValue::make({std::move(text), Value(Value::SmallInt(count))});
+    }
+
+    Value splitMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 2, "split");
+
+        return pattern(obj).split(subject(option(args, kwargs, 0, "string")),
+                                  integer(option(args, kwargs, 1, "maxsplit"), 0));
+    }
+
+    const MethodTable PATTERN_METHODS = {
+        REGISTER_DIRECT_METHOD("match", matchMethod),
+        REGISTER_DIRECT_METHOD("search", searchMethod),
+        REGISTER_DIRECT_METHOD("fullmatch", fullmatchMethod),
+        REGISTER_DIRECT_METHOD("findall", findallMethod),
+        REGISTER_DIRECT_METHOD("finditer", finditerMethod),
+        REGISTER_DIRECT_METHOD("sub", subMethod),
+        REGISTER_DIRECT_METHOD("subn", subnMethod),
+        REGISTER_DIRECT_METHOD("split", splitMethod),
+    };
+
+    /// номер группы из необязательного аргумента; по умолчанию 0
+    int groupArg(const MatchValue& m, const std::vector<Value>& args, const char* name) {
+
+        expectArgsRange(args, 0, 1, name);
+
+        return args.empty() ? 0 : m.groupIndex(args[0]);
+    }
+
+    Value groupMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        const MatchValue& m = match(obj);
+
+        if (args.size() <= 1) {
+            return m.group(args.empty() ? 0 : m.groupIndex(args[0]));
+        }
+
+        std::vector<Value> items;
+        items.reserve(args.size());
+
+        for (const Value& arg : args) {
+            items.push_back(m.group(m.groupIndex(arg)));
+        }
+
+        return TupleValue::make(std::move(items));
+    }
+
+    Value groupsMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 1, "groups");
+
+        const Value* fallback = option(args, kwargs, 0, "default");
+
+        return match(obj).groups(fallback ? *fallback : Value());
+    }
+
+    Value groupdictMethod(const Value& obj, const std::vector<Value>& args, const Kwargs& kwargs,
+                          const std::shared_ptr<Environment>&) {
+
+        expectArgsRange(args, 0, 1, "groupdict");
+
+        const Value* fallback = option(args, kwargs, 0, "default");
+
+        return match(obj).groupDict(fallback ? *fallback : Value());
+    }
+
+    Value startMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        const MatchValue& m = match(obj);
+
+        return Value(Value::SmallInt(m.start(groupArg(m, args, "start"))));
+    }
+
+    Value endMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        const MatchValue& m = match(obj);
+
+        return Value(Value::SmallInt(m.end(groupArg(m, args, "end"))));
+    }
+
+    Value spanMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        const MatchValue& m = match(obj);
+        const int group = groupArg(m, args, "span");
+
+        return TupleValue::pair(Value(Value::SmallInt(m.start(group))), Value(Value::SmallInt(m.end(group))));
+    }
+
+    Value expandMethod(const Value& obj, const std::vector<Value>& args, const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "expand");
+
+        return match(obj).expand(args[0].asString("expand")->toString());
+    }
+
+    const MethodTable MATCH_METHODS = {
+        REGISTER_DIRECT_METHOD("group", groupMethod),
+        REGISTER_DIRECT_METHOD("groups", groupsMethod),
+        REGISTER_DIRECT_METHOD("groupdict", groupdictMethod),
+        REGISTER_DIRECT_METHOD("start", startMethod),
+        REGISTER_DIRECT_METHOD("end", endMethod),
+        REGISTER_DIRECT_METHOD("span", spanMethod),
+        REGISTER_DIRECT_METHOD("expand", expandMethod),
+    };
+}
+
+std::optional<Value> getPatternAttr(const Value& obj, const QString& attr) {
+
+    const PatternValue& p = pattern(obj);
+
+    if (attr == "pattern") {
+        return Value(p.pattern());
+    }
+
+    if (attr == "flags") {
+        return Value(Value::SmallInt(p.flags()));
+    }
+
+    if (attr == "groups") {
+        return Value(Value::SmallInt(p.groups()));
+    }
+
+    if (attr == "groupindex") {
+
+        const auto dict = std::make_shared<DictValue>();
+        const QStringList& names = p.groupNames();
+
+        for (qsizetype i = 1; i < names.size(); ++i) {
+            if (!names[i].isEmpty()) {
+                dict->setItem(Value(names[i]), Value(Value::SmallInt(i)));
+            }
+        }
+
+        return Value(dict);
+    }
+
+    return getBuiltinAttr(obj, attr, PATTERN_METHODS);
+}
+
+std::optional<Value> getMatchAttr(const Value& obj, const QString& attr) {
+
+    const MatchValue& m = match(obj);
+
+    if (attr == "string") {
+        return Value(m.subject());
+    }
+
+    if (attr == "re") {
+        return Value(std::static_pointer_cast<ObjectValue>(std::const_pointer_cast<PatternValue>(m.pattern())));
+    }
+
+    if (attr == "pos") {
+        return Value(Value::SmallInt(m.pos()));
+    }
+
+    if (attr == "endpos") {
+        return Value(Value::SmallInt(m.endpos()));
+    }
+
+    if (attr == "lastindex") {
+        return m.lastIndex();
+    }
+
+    if (attr == "lastgroup") {
+        return m.lastGroup();
+    }
+
+    return getBuiltinAttr(obj, attr, MATCH_METHODS);
+}
+
+Value callPatternMethod(const Value& pattern, const QString& name, const std::vector<Value>& args,
+                        const Kwargs& kwargs, const std::shared_ptr<Environment>& env) {
+    return findBuiltinMethod(name, PATTERN_METHODS)(pattern, args, kwargs, env);
+}
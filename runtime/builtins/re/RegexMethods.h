@@ -0,0 +1,20 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_REGEXMETHODS_H
+#define CPPYTHON_REGEXMETHODS_H
+#include <optional>
+
+#include "CallRuntime.h"
+
+/// методы match, search, sub... и атрибуты pattern, flags, groups, groupindex объекта re.Pattern
+std::optional<Value> getPatternAttr(const Value& obj, const QString& attr);
+
+/// group, groups, span... и атрибуты string, re, pos, endpos, lastindex, lastgroup объекта re.Match
+std::optional<Value> getMatchAttr(const Value& obj, const QString& attr);
+
+/// метод Pattern напрямую, без объекта метода: функции модуля re
+Value callPatternMethod(const Value& pattern, const QString& name, const std::vector<Value>& args,
+                        const Kwargs& kwargs, const std::shared_ptr<Environment>& env);
+#endif //CPPYTHON_REGEXMETHODS_H
@@ -726,7 +726,7 @@ namespace {
 
 }
 
-Value getSetAttr(const Value& obj, const QString& attr) {
+std::optional<Value> getSetAttr(const Value& obj, const QString& attr) {
 
-    return getBuiltinAttr(obj, attr, SET_METHODS, "set");
+    return getBuiltinAttr(obj, attr, SET_METHODS);
 }
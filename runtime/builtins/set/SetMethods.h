@@ -4,7 +4,9 @@
 
 #ifndef CPPYTHON_SETMETHODS_H
 #define CPPYTHON_SETMETHODS_H
+#include <optional>
+
 #include "../../../headers/Value.h"
 
-Value getSetAttr(const Value& obj, const QString& attr);
+std::optional<Value> getSetAttr(const Value& obj, const QString& attr);
 #endif //CPPYTHON_SETMETHODS_H
\ No newline at end of file
@@ -1475,9 +1475,9 @@ namespace {
     };
 }
 
-Value getStrAttr(const Value& obj, const QString& attr) {
+std::optional<Value> getStrAttr(const Value& obj, const QString& attr) {
 
-    return getBuiltinAttr(obj, attr, STR_METHODS, "str");
+    return getBuiltinAttr(obj, attr, STR_METHODS);
 }
 
 Value makeMakeTransStrClassBuiltin() {
@@ -4,9 +4,11 @@
 
 #ifndef CPPYTHON_STRMETHODS_H
 #define CPPYTHON_STRMETHODS_H
+#include <optional>
+
 #include "../../../headers/Value.h"
 
-Value getStrAttr(const Value& obj, const QString& attr);
+std::optional<Value> getStrAttr(const Value& obj, const QString& attr);
 
 Value makeMakeTransStrClassBuiltin();
 
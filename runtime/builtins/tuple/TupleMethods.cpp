@@ -44,7 +44,7 @@ namespace {
 
                 expectArgs(args, 0, "__hash__");
 
-                return Value(Value::BigInt(tuple->hash()));
+                return Value(Value::BigInt(static_cast<long long>(tuple->hash())));
             }
         );
     }
@@ -323,7 +323,7 @@ namespace {
 
 }
 
-Value getTupleAttr(const Value& obj, const QString& attr) {
+std::optional<Value> getTupleAttr(const Value& obj, const QString& attr) {
 
-    return getBuiltinAttr(obj, attr, TUPLE_METHODS, "tuple");
+    return getBuiltinAttr(obj, attr, TUPLE_METHODS);
 }
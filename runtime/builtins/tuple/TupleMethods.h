@@ -4,8 +4,10 @@
 
 #ifndef CPPYTHON_TUPLEMETHODS_H
 #define CPPYTHON_TUPLEMETHODS_H
+#include <optional>
+
 #include "../../../headers/Value.h"
 
 
-Value getTupleAttr(const Value& obj, const QString& attr);
+std::optional<Value> getTupleAttr(const Value& obj, const QString& attr);
 #endif //CPPYTHON_TUPLEMETHODS_H
\ No newline at end of file
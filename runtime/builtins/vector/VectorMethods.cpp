@@ -0,0 +1,240 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include <cmath>
+#include <limits>
+
+#include "ArrayIterator.h"
+#include "ArrayValue.h"
+#include "BytesValue.h"
+#include "VectorValue.h"
+#include "../BuiltinAttrLookup.h"
+#include "../BuiltinMethodRegistry.h"
+#include "../../ArgValidation.h"
+#include "../../RuntimeUtils.h"
+
+namespace {
+
+    VectorValue& vector(const Value& obj) {
+        return *VectorValue::of(obj);
+    }
+
+    Value iterMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__iter__");
+
+        const auto self = std::static_pointer_cast<VectorValue>(std::get<Value::ObjectPtr>(obj.data));
+
+        return Value(std::static_pointer_cast<IteratorValue>(std::make_shared<ArrayIterator>(self, "vector_iterator")));
+    }
+
+    Value lenMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "__len__");
+
+        return Value(Value::SmallInt(vector(obj).len()));
+    }
+
+    Value getitemMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__getitem__");
+
+        return vector(obj).getItem(args[0]);
+    }
+
+    Value containsMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__contains__");
+
+        return Value(vector(obj).contains(args[0]));
+    }
+
+    Value equalMethod(const Value& obj,
+                      const std::vector<Value>& args,
+                      const Kwargs&,
+                      const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__eq__");
+
+        return Value(vector(obj).equal(args[0]));
+    }
+
+    Value notEqualMethod(const Value& obj,
+                         const std::vector<Value>& args,
+                         const Kwargs&,
+                         const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "__ne__");
+
+        return Value(vector(obj).notEqual(args[0]));
+    }
+
+    /// метод маски: lt(), le(), gt()...
+    template<arraykernels::Compare op>
+    Value compareMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "compare");
+
+        return vector(obj).compare(op, args[0]);
+    }
+
+    Value sumMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "sum");
+
+        return *vector(obj).sumOf(Value(Value::SmallInt(0)));
+    }
+
+    Value minMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "min");
+
+        if (vector(obj).len() == 0) {
+            throw std::runtime_error("ValueError: zero-size vector has no minimum");
+        }
+
+        return vector(obj).extremum(false);
+    }
+
+    Value maxMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "max");
+
+        if (vector(obj).len() == 0) {
+            throw std::runtime_error("ValueError: zero-size vector has no maximum");
+        }
+
+        return vector(obj).extremum(true);
+    }
+
+    Value meanMethod(const Value& obj,
+                     const std::vector<Value>& args,
+                     const Kwargs&,
+                     const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "mean");
+
+        const VectorValue& self = vector(obj);
+
+        // как в numpy: у пустого вектора среднее — nan
+        if (self.len() == 0) {
+            return Value(std::numeric_limits<double>::quiet_NaN());
+        }
+
+        return Value(self.sumOf(Value(0.0))->toDouble() / static_cast<double>(self.len()));
+    }
+
+    Value dotMethod(const Value& obj,
+                    const std::vector<Value>& args,
+                    const Kwargs&,
+                    const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "dot");
+
+        return vector(obj).dot(args[0]);
+    }
+
+    Value astypeMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 1, "astype");
+
+        return vector(obj).astype(ArrayValue::parseTypecode(args[0]));
+    }
+
+    Value tolistMethod(const Value& obj,
+                       const std::vector<Value>& args,
+                       const Kwargs&,
+                       const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "tolist");
+
+        return vector(obj).toList();
+    }
+
+    Value tobytesMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "tobytes");
+
+        return Value(std::make_shared<BytesValue>(vector(obj).bytes()));
+    }
+
+    Value toarrayMethod(const Value& obj,
+                        const std::vector<Value>& args,
+                        const Kwargs&,
+                        const std::shared_ptr<Environment>&) {
+
+        expectArgs(args, 0, "toarray");
+
+        // буфер общий до первого изменения массива
+        const VectorValue& self = vector(obj);
+
+        return Value(std::static_pointer_cast<ObjectValue>(std::make_shared<ArrayValue>(self.typecode(), self.bytes())));
+    }
+
+    const MethodTable VECTOR_METHODS = {
+        REGISTER_DIRECT_METHOD("__iter__", iterMethod),
+        REGISTER_DIRECT_METHOD("__len__", lenMethod),
+        REGISTER_DIRECT_METHOD("__getitem__", getitemMethod),
+        REGISTER_DIRECT_METHOD("__contains__", containsMethod),
+        REGISTER_DIRECT_METHOD("__eq__", equalMethod),
+        REGISTER_DIRECT_METHOD("__ne__", notEqualMethod),
+        REGISTER_DIRECT_METHOD("lt", compareMethod<arraykernels::Compare::Less>),
+        REGISTER_DIRECT_METHOD("le", compareMethod<arraykernels::Compare::LessOrEqual>),
+        REGISTER_DIRECT_METHOD("gt", compareMethod<arraykernels::Compare::Greater>),
+        REGISTER_DIRECT_METHOD("ge", compareMethod<arraykernels::Compare::GreaterOrEqual>),
+        REGISTER_DIRECT_METHOD("eq", compareMethod<arraykernels::Compare::Equal>),
+        REGISTER_DIRECT_METHOD("ne", compareMethod<arraykernels::Compare::NotEqual>),
+        REGISTER_DIRECT_METHOD("sum", sumMethod),
+        REGISTER_DIRECT_METHOD("min", minMethod),
+        REGISTER_DIRECT_METHOD("max", maxMethod),
+        REGISTER_DIRECT_METHOD("mean", meanMethod),
+        REGISTER_DIRECT_METHOD("dot", dotMethod),
+        REGISTER_DIRECT_METHOD("astype", astypeMethod),
+        REGISTER_DIRECT_METHOD("tolist", tolistMethod),
+        REGISTER_DIRECT_METHOD("tobytes", tobytesMethod),
+        REGISTER_DIRECT_METHOD("toarray", toarrayMethod),
+    };
+}
+
+std::optional<Value> getVectorAttr(const Value& obj, const QString& attr) {
+
+    if (attr == "typecode") {
+        return Value(QString(QChar(vector(obj).typecode())));
+    }
+
+    if (attr == "itemsize") {
+        return Value(Value::SmallInt(vector(obj).itemSize()));
+    }
+
+    return getBuiltinAttr(obj, attr, VECTOR_METHODS);
+}
@@ -0,0 +1,13 @@
+//
+// Created by semyo on 15.10.2026.
+//
+
+#ifndef CPPYTHON_VECTORMETHODS_H
+#define CPPYTHON_VECTORMETHODS_H
+#include <optional>
+
+#include "Value.h"
+
+/// атрибуты typecode, itemsize и методы vecmath.vector
+std::optional<Value> getVectorAttr(const Value& obj, const QString& attr);
+#endif //CPPYTHON_VECTORMETHODS_H
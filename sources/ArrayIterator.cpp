@@ -0,0 +1,27 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ArrayIterator.h"
+
+#include "PackedValue.h"
+#include "StopIterationException.h"
+
+ArrayIterator::ArrayIterator(std::shared_ptr<PackedValue> sequence, const char* typeName)
+    : sequence(std::move(sequence)), typeName(typeName) {}
+
+Value ArrayIterator::next() {
+
+    if (!hasNext()) {
+        throw StopIterationException();
+    }
+
+    return sequence->item(index++);
+}
+
+bool ArrayIterator::hasNext() const {
+    return index < sequence->len();
+}
+
+QString ArrayIterator::getTypeName() const {
+    return typeName;
+}
@@ -0,0 +1,328 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ArrayKernels.h"
+
+#include "IntOps.h"
+
+namespace arraykernels {
+
+    namespace {
+
+        int workerCount = 1;
+
+#ifdef __SIZEOF_INT128__
+        /// знаковое 128-битное целое как Value
+        Value composeWide(const __int128 value) {
+
+            if (value >= std::numeric_limits<Value::SmallInt>::min() &&
+                value <= std::numeric_limits<Value::SmallInt>::max()) {
+                return Value(static_cast<Value::SmallInt>(value));
+            }
+
+            const unsigned __int128 magnitude = value < 0 ? -static_cast<unsigned __int128>(value)
+                                                          : static_cast<unsigned __int128>(value);
+
+            Value::BigInt result = Value::BigInt(static_cast<std::uint64_t>(magnitude >> 64));
+            result <<= 64;
+            result += static_cast<std::uint64_t>(magnitude);
+
+            return Value(value < 0 ? Value::BigInt(-result) : result);
+        }
+#endif
+
+        /// приведение элемента; вещественное вне диапазона целого T (и NaN) — 0, иначе приведение не определено
+        template<typename T, typename S>
+        T convert(const S value) {
+
+            if constexpr (std::is_floating_point_v<S> && std::is_integral_v<T>) {
+
+                const double lower = static_cast<double>(std::numeric_limits<T>::min());
+                const double upper = static_cast<double>(std::numeric_limits<T>::max()) + 1.0;
+
+                return value >= lower && value < upper ? static_cast<T>(value) : T(0);
+
+            } else {
+                return static_cast<T>(value);
+            }
+        }
+
+        template<typename T>
+        T calculate(const Op op, const T a, const T b) {
+
+            if constexpr (std::is_integral_v<T>) {
+
+                // по модулю 2^64: переполнение знакового целого в C++ не определено
+                const auto x = static_cast<std::uint64_t>(a);
+                const auto y = static_cast<std::uint64_t>(b);
+
+                switch (op) {
+                    case Op::Add: return static_cast<T>(x + y);
+                    case Op::Sub: return static_cast<T>(x - y);
+                    default: return static_cast<T>(x * y);
+                }
+
+            } else {
+
+                switch (op) {
+                    case Op::Add: return a + b;
+                    case Op::Sub: return a - b;
+                    case Op::Mul: return a * b;
+                    default: return a / b;
+                }
+            }
+        }
+
+        template<typename T>
+        bool test(const Compare op, const T a, const T b) {
+
+            switch (op) {
+                case Compare::Less: return a < b;
+                case Compare::LessOrEqual: return a <= b;
+                case Compare::Greater: return a > b;
+                case Compare::GreaterOrEqual: return a >= b;
+                case Compare::Equal: return a == b;
+                default: return a != b;
+            }
+        }
+
+        /**
+         * Общий обход двух буферов с растяжением одноэлементного: fn(a, b) пишет
+         * элемент результата типа R. Операция выбирается снаружи цикла, поэтому
+         * внутренний цикл без ветвлений и векторизуется.
+         */
+        template<typename T, typename R, typename Fn>
+        QByteArray zip(const QByteArray& left, const QByteArray& right, Fn fn) {
+
+            const qsizetype leftCount = left.size() / qsizetype(sizeof(T));
+            const qsizetype rightCount = right.size() / qsizetype(sizeof(T));
+            const qsizetype count = leftCount == 1 ? rightCount : leftCount;
+
+            QByteArray result(count * qsizetype(sizeof(R)), Qt::Uninitialized);
+
+            const char* a = left.constData();
+            const char* b = right.constData();
+            char* out = result.data();
+
+            parallelFor(count, [&](const qsizetype begin, const qsizetype end) {
+
+                if (leftCount == rightCount) {
+                    for (qsizetype i = begin; i < end; ++i) {
+                        store(out, i, fn(load<T>(a, i), load<T>(b, i)));
+                    }
+                } else if (leftCount == 1) {
+                    const T scalar = load<T>(a, 0);
+                    for (qsizetype i = begin; i < end; ++i) {
+                        store(out, i, fn(scalar, load<T>(b, i)));
+                    }
+                } else {
+                    const T scalar = load<T>(b, 0);
+                    for (qsizetype i = begin; i < end; ++i) {
+                        store(out, i, fn(load<T>(a, i), scalar));
+                    }
+                }
+            });
+
+            return result;
+        }
+
+        template<typename T>
+        QByteArray applyAs(const Op op, const QByteArray& left, const QByteArray& right) {
+
+            switch (op) {
+                case Op::Add: return zip<T, T>(left, right, [](T a, T b) { return calculate(Op::Add, a, b); });
+                case Op::Sub: return zip<T, T>(left, right, [](T a, T b) { return calculate(Op::Sub, a, b); });
+                case Op::Mul: return zip<T, T>(left, right, [](T a, T b) { return calculate(Op::Mul, a, b); });
+                default: return zip<T, T>(left, right, [](T a, T b) { return calculate(Op::Div, a, b); });
+            }
+        }
+
+        template<typename T>
+        QByteArray compareAs(const Compare op, const QByteArray& left, const QByteArray& right) {
+
+            using Mask = std::uint8_t;
+
+            switch (op) {
+                case Compare::Less:
+                    return zip<T, Mask>(left, right, [](T a, T b) { return Mask(test(Compare::Less, a, b)); });
+                case Compare::LessOrEqual:
+                    return zip<T, Mask>(left, right, [](T a, T b) { return Mask(test(Compare::LessOrEqual, a, b)); });
+                case Compare::Greater:
+                    return zip<T, Mask>(left, right, [](T a, T b) { return Mask(test(Compare::Greater, a, b)); });
+                case Compare::GreaterOrEqual:
+                    return zip<T, Mask>(left, right, [](T a, T b) { return Mask(test(Compare::GreaterOrEqual, a, b)); });
+                case Compare::Equal:
+                    return zip<T, Mask>(left, right, [](T a, T b) { return Mask(test(Compare::Equal, a, b)); });
+                default:
+                    return zip<T, Mask>(left, right, [](T a, T b) { return Mask(test(Compare::NotEqual, a, b)); });
+            }
+        }
+    }
+
+    qsizetype itemSize(const char code) {
+
+        switch (code) {
+            case 'b': case 'B': case 'h': case 'H': case 'i': case 'I':
+            case 'l': case 'L': case 'q': case 'Q': case 'f': case 'd':
+                return visitCode(code, [](auto zero) { return static_cast<qsizetype>(sizeof zero); });
+            default:
+                return 0;
+        }
+    }
+
+    int threads() {
+        return workerCount;
+    }
+
+    void setThreads(const int n) {
+        workerCount = n > 0 ? n : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    QByteArray widen(const QByteArray& data, const char from, const char to) {
+
+        if (from == to) {
+            return data;
+        }
+
+        return visitCode(from, [&](auto source) {
+            return visitCode(to, [&](auto target) {
+
+                using S = decltype(source);
+                using T = decltype(target);
+
+                const qsizetype count = data.size() / qsizetype(sizeof(S));
+                QByteArray result(count * qsizetype(sizeof(T)), Qt::Uninitialized);
+
+                const char* in = data.constData();
+                char* out = result.data();
+
+                parallelFor(count, [&](const qsizetype begin, const qsizetype end) {
+                    for (qsizetype i = begin; i < end; ++i) {
+                        store(out, i, convert<T>(load<S>(in, i)));
+                    }
+                });
+
+                return result;
+            });
+        });
+    }
+
+    QByteArray apply(const Op op, const char code, const QByteArray& left, const QByteArray& right) {
+        return code == 'd' ? applyAs<double>(op, left, right) : applyAs<long long>(op, left, right);
+    }
+
+    QByteArray compare(const Compare op, const char code, const QByteArray& left, const QByteArray& right) {
+        return code == 'd' ? compareAs<double>(op, left, right) : compareAs<long long>(op, left, right);
+    }
+
+    std::optional<Value> sum(const char code, const QByteArray& data, const Value& start) {
+
+        const auto* smallStart = std::get_if<Value::SmallInt>(&start.data);
+        const auto* floatStart = std::get_if<Value::Float>(&start.data);
+
+        if (!smallStart && !floatStart) {
+            return std::nullopt;
+        }
+
+        return visitCode(code, [&](auto zero) -> std::optional<Value> {
+
+            using T = decltype(zero);
+            const char* bytes = data.constData();
+            const qsizetype count = data.size() / qsizetype(sizeof(T));
+
+            // вещественная сумма по порядку: CPython 3.11 складывает double так же
+            if (std::is_floating_point_v<T> || floatStart) {
+
+                double total = floatStart ? *floatStart : static_cast<double>(*smallStart);
+
+                for (qsizetype i = 0; i < count; ++i) {
+                    total += static_cast<double>(load<T>(bytes, i));
+                }
+
+                return Value(total);
+            }
+
+            if constexpr (!std::is_floating_point_v<T>) {
+#ifdef __SIZEOF_INT128__
+                // до 32 бит хватает 64-битного аккумулятора, 64-битным кодам нужен 128-битный
+                using Wide = std::conditional_t<sizeof(T) < 8, std::int64_t, __int128>;
+
+                Wide total = 0;
+
+                for (qsizetype i = 0; i < count; ++i) {
+                    total += static_cast<Wide>(load<T>(bytes, i));
+                }
+
+                return composeWide(static_cast<__int128>(total) + *smallStart);
+#else
+                if constexpr (sizeof(T) < 8) {
+
+                    std::int64_t total = 0;
+
+                    for (qsizetype i = 0; i < count; ++i) {
+                        total += static_cast<std::int64_t>(load<T>(bytes, i));
+                    }
+
+                    if (std::int64_t result; !intops::addOverflow(total, *smallStart, result)) {
+                        return Value(result);
+                    }
+
+                    return Value(Value::BigInt(Value::BigInt(total) + *smallStart));
+
+                } else {
+
+                    // без 128-битного целого старшие и младшие половины элементов копятся
+                    // отдельно; в блоке из 2^30 элементов ни одна из сумм не переполняется
+                    constexpr qsizetype block = qsizetype(1) << 30;
+                    Value::BigInt total = *smallStart;
+
+                    for (qsizetype begin = 0; begin < count; begin += block) {
+
+                        const qsizetype end = std::min(count, begin + block);
+                        std::int64_t high = 0;
+                        std::uint64_t low = 0;
+
+                        for (qsizetype i = begin; i < end; ++i) {
+                            const T value = load<T>(bytes, i);
+                            high += static_cast<std::int64_t>(value >> 32);
+                            low += static_cast<std::uint32_t>(value);
+                        }
+
+                        total += (Value::BigInt(high) << 32) + low;
+                    }
+
+                    return Value(total);
+                }
+#endif
+            }
+
+            return std::nullopt;
+        });
+    }
+
+    Value extremum(const char code, const QByteArray& data, const bool wantMax) {
+
+        return visitCode(code, [&](auto zero) {
+
+            using T = decltype(zero);
+            const char* bytes = data.constData();
+            const qsizetype count = data.size() / qsizetype(sizeof(T));
+            T best = load<T>(bytes, 0);
+
+            // строгое сравнение: при равенстве остаётся первый, NaN не вытесняет и не вытесняется
+            if (wantMax) {
+                for (qsizetype i = 1; i < count; ++i) {
+                    const T value = load<T>(bytes, i);
+                    best = value > best ? value : best;
+                }
+            } else {
+                for (qsizetype i = 1; i < count; ++i) {
+                    const T value = load<T>(bytes, i);
+                    best = value < best ? value : best;
+                }
+            }
+
+            return box(best);
+        });
+    }
+}
@@ -0,0 +1,55 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ArrayModule.h"
+
+#include "ArrayValue.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+Value ArrayModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("array");
+
+    module->setAttribute("array", makeBuiltin(
+        "array",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            if (!kwargs.empty()) {
+                throw std::runtime_error("TypeError: array.array() takes no keyword arguments");
+            }
+
+            expectArgsRange(args, 1, 2, "array");
+
+            const char code = ArrayValue::parseTypecode(args[0]);
+            const auto array = std::make_shared<ArrayValue>(code);
+
+            if (args.size() > 1) {
+
+                const Value& initializer = args[1];
+
+                if (initializer.isString()) {
+                    throw std::runtime_error(
+                        std::string("TypeError: cannot use a str to initialize an array with typecode '") + code + "'");
+                }
+
+                // bytes и bytearray — готовые машинные значения, остальное перекодируется поэлементно
+                if (initializer.isBytes() || initializer.isByteArray()) {
+                    array->fromBytes(initializer);
+                } else if (const ArrayValue* other = ArrayValue::of(initializer); other && other->typecode() != code) {
+                    array->extend(other->toList());
+                } else {
+                    array->extend(initializer);
+                }
+            }
+
+            return Value(std::static_pointer_cast<ObjectValue>(array));
+        }
+    ));
+
+    module->setAttribute("typecodes", Value("bBhHiIlLqQfd"));
+
+    return Value(module);
+}
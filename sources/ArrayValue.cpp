@@ -0,0 +1,605 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ArrayValue.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "ArrayKernels.h"
+#include "ListValue.h"
+#include "StrValue.h"
+#include "StructFormat.h"
+#include "../runtime/ProtocolHelpers.h"
+
+namespace {
+
+    using arraykernels::load;
+    using arraykernels::store;
+    using arraykernels::visitCode;
+
+    /// OverflowError для значения вне диапазона кода, текстом CPython
+    [[noreturn]] void rangeError(const char code, const bool negative) {
+
+        std::string message;
+
+        switch (code) {
+            case 'b': message = negative ? "signed char is less than minimum" : "signed char is greater than maximum"; break;
+            case 'B': message = negative ? "unsigned byte integer is less than minimum"
+                                         : "unsigned byte integer is greater than maximum"; break;
+            case 'h': message = negative ? "signed short integer is less than minimum"
+                                         : "signed short integer is greater than maximum"; break;
+            case 'H': message = negative ? "unsigned short is less than minimum" : "unsigned short is greater than maximum"; break;
+            case 'i': message = negative ? "signed integer is less than minimum" : "signed integer is greater than maximum"; break;
+            case 'I': message = negative ? "can't convert negative value to unsigned int"
+                                         : "unsigned int is greater than maximum"; break;
+            case 'l': message = "Python int too large to convert to C long"; break;
+            case 'L': message = negative ? "can't convert negative value to unsigned int"
+                                         : "Python int too large to convert to C unsigned long"; break;
+            case 'Q': message = negative ? "can't convert negative int to unsigned" : "int too big to convert"; break;
+            default: message = "int too big to convert"; break;
+        }
+
+        throw std::runtime_error("OverflowError: " + message);
+    }
+
+    /// целое value как T; false — вне диапазона T, negative — с какой стороны
+    template<typename T>
+    bool narrow(const Value& value, T& out, bool& negative) {
+
+        if (const auto* small = std::get_if<Value::SmallInt>(&value.data)) {
+
+            negative = *small < 0;
+
+            if constexpr (std::is_unsigned_v<T>) {
+                if (negative || static_cast<std::uint64_t>(*small) > std::numeric_limits<T>::max()) {
+                    return false;
+                }
+            } else {
+                if (*small < std::numeric_limits<T>::min() || *small > std::numeric_limits<T>::max()) {
+                    return false;
+                }
+            }
+
+            out = static_cast<T>(*small);
+            return true;
+        }
+
+        const Value::BigInt number = value.toBigInt();
+        negative = number < 0;
+
+        if (number < Value::BigInt(std::numeric_limits<T>::min()) ||
+            number > Value::BigInt(std::numeric_limits<T>::max())) {
+            return false;
+        }
+
+        out = number.convert_to<T>();
+        return true;
+    }
+}
+
+char ArrayValue::parseTypecode(const Value& value) {
+
+    if (!value.isString() || value.asString()->view().size() != 1) {
+        throw std::runtime_error(
+            "TypeError: array() argument 1 must be a unicode character, not " + typeName(value).toStdString());
+    }
+
+    const QChar symbol = value.asString()->view()[0];
+    const char code = symbol.unicode() < 0x80 ? symbol.toLatin1() : '\0';
+
+    if (arraykernels::itemSize(code) == 0) {
+        throw std::runtime_error("ValueError: bad typecode (must be b, B, u, h, H, i, I, l, L, q, Q, f or d)");
+    }
+
+    return code;
+}
+
+ArrayValue::ArrayValue(const char typecode, QByteArray data) : PackedValue(typecode, std::move(data)) {}
+
+ArrayValue* ArrayValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<ArrayValue*>(object->get()) : nullptr;
+}
+
+void ArrayValue::encode(char* out, const Value& value) const {
+
+    visitCode(code, [&](auto zero) {
+
+        using T = decltype(zero);
+
+        if constexpr (std::is_floating_point_v<T>) {
+
+            if (!value.isNumeric()) {
+                throw std::runtime_error("TypeError: must be real number, not " + typeName(value).toStdString());
+            }
+
+            store(out, 0, static_cast<T>(value.toDouble()));
+
+        } else {
+
+            if (!value.isBigInt() && !value.isBool()) {
+                throw std::runtime_error(
+                    "TypeError: '" + typeName(value).toStdString() + "' object cannot be interpreted as an integer");
+            }
+
+            T number{};
+            bool negative = false;
+
+            if (value.isBool()) {
+                number = value.toBool() ? 1 : 0;
+            } else if (!narrow(value, number, negative)) {
+                rangeError(code, negative);
+            }
+
+            store(out, 0, number);
+        }
+    });
+}
+
+QByteArray ArrayValue::encodeAll(const Value& iterable) const {
+
+    if (const ArrayValue* other = of(iterable)) {
+
+        if (other->code == code) {
+            return other->data;
+        }
+
+        QByteArray result(other->len() * size, '\0');
+
+        for (qsizetype i = 0; i < other->len(); ++i) {
+            encode(result.data() + i * size, other->item(i));
+        }
+
+        return result;
+    }
+
+    // список перекодируется сразу в буфер нужной длины
+    if (const auto list = std::get_if<Value::ListPtr>(&iterable.data)) {
+
+        const std::vector<Value>& elements = (*list)->elements.get();
+        QByteArray result(static_cast<qsizetype>(elements.size()) * size, '\0');
+
+        for (std::size_t i = 0; i < elements.size(); ++i) {
+            encode(result.data() + static_cast<qsizetype>(i) * size, elements[i]);
+        }
+
+        return result;
+    }
+
+    QByteArray result;
+    char cell[sizeof(double)];
+
+    const Value iterator = getIter(iterable, nullptr);
+
+    for (Value element; iterNext(iterator, element, nullptr);) {
+        encode(cell, element);
+        result.append(cell, size);
+    }
+
+    return result;
+}
+
+qsizetype ArrayValue::checkedIndex(const Value& index, const char* message) const {
+
+    if (!index.isBigInt() && !index.isBool()) {
+        throw std::runtime_error("TypeError: array indices must be integers");
+    }
+
+    Value::BigInt position = index.toBigInt();
+
+    if (position < 0) {
+        position += len();
+    }
+
+    if (position < 0 || position >= len()) {
+        throw std::runtime_error(std::string("IndexError: ") + message);
+    }
+
+    return position.convert_to<qsizetype>();
+}
+
+Value ArrayValue::getItem(const Value& index) const {
+
+    if (index.isSlice()) {
+
+        const auto slice = normalizeSlice(*index.asSlice(), len());
+
+        if (slice.step == 1) {
+            const long long count = sliceLength(slice);
+            return Value(std::static_pointer_cast<ObjectValue>(
+                std::make_shared<ArrayValue>(code, data.mid(slice.start * size, count * size))));
+        }
+
+        QByteArray result;
+        result.reserve(sliceLength(slice) * size);
+
+        iterateSlice(slice, [&](const long long i) {
+            result.append(data.constData() + i * size, size);
+        });
+
+        return Value(std::static_pointer_cast<ObjectValue>(std::make_shared<ArrayValue>(code, std::move(result))));
+    }
+
+    return item(checkedIndex(index, "array index out of range"));
+}
+
+void ArrayValue::setItem(const Value& index, const Value& value) {
+
+    if (index.isSlice()) {
+
+        const ArrayValue* other = of(value);
+
+        if (!other) {
+            throw std::runtime_error(
+                "TypeError: can only assign array (not \"" + typeName(value).toStdString() + "\") to array slice");
+        }
+
+        if (other->code != code) {
+            throw std::runtime_error("TypeError: bad argument type for built-in operation");
+        }
+
+        // копия до изменения: справа может стоять этот же массив
+        const QByteArray source = other->data;
+        const auto slice = normalizeSlice(*index.asSlice(), len());
+        const long long count = sliceLength(slice);
+
+        if (slice.step == 1) {
+            data.replace(slice.start * size, count * size, source);
+            return;
+        }
+
+        if (source.size() / size != count) {
+            throw std::runtime_error(
+                "ValueError: attempt to assign array of size " + std::to_string(source.size() / size) +
+                " to extended slice of size " + std::to_string(count));
+        }
+
+        char* out = data.data();
+        qsizetype read = 0;
+
+        iterateSlice(slice, [&](const long long i) {
+            std::memcpy(out + i * size, source.constData() + read, size);
+            read += size;
+        });
+
+        return;
+    }
+
+    // значение проверяется до индекса: при ошибке массив не меняется
+    char cell[sizeof(double)];
+    encode(cell, value);
+
+    std::memcpy(data.data() + checkedIndex(index, "array assignment index out of range") * size, cell, size);
+}
+
+void ArrayValue::delItem(const Value& index) {
+
+    if (index.isSlice()) {
+
+        const auto slice = normalizeSlice(*index.asSlice(), len());
+        const long long count = sliceLength(slice);
+
+        if (count == 0) {
+            return;
+        }
+
+        const long long first = slice.step > 0 ? slice.start : slice.start + (count - 1) * slice.step;
+        const long long step = slice.step > 0 ? slice.step : -slice.step;
+
+        if (step == 1 || count == 1) {
+            data.remove(first * size, count * size);
+            return;
+        }
+
+        // с шагом: уплотнение на месте одним проходом по элементам
+        const long long last = first + (count - 1) * step;
+        char* bytes = data.data();
+        qsizetype write = first;
+
+        for (qsizetype read = first; read < len(); ++read) {
+
+            if (read <= last && (read - first) % step == 0) {
+                continue;
+            }
+
+            std::memmove(bytes + write * size, bytes + read * size, size);
+            ++write;
+        }
+
+        data.truncate(write * size);
+        return;
+    }
+
+    data.remove(checkedIndex(index, "array assignment index out of range") * size, size);
+}
+
+bool ArrayValue::contains(const Value& value) const {
+    return find(value, 0, len()) >= 0;
+}
+
+qsizetype ArrayValue::find(const Value& value, const qsizetype from, const qsizetype to) const {
+
+    qsizetype found = -1;
+
+    // число сравнивается в C-типе элемента, без Value на каждый элемент
+    const bool typed = visitCode(code, [&](auto zero) {
+
+        using T = decltype(zero);
+
+        // вещественные элементы сравниваются в double: так int и float сравниваются точно
+        std::conditional_t<std::is_floating_point_v<T>, double, T> needle{};
+
+        if constexpr (std::is_floating_point_v<T>) {
+
+            constexpr Value::SmallInt exact = Value::SmallInt(1) << 53;
+            const auto* small = std::get_if<Value::SmallInt>(&value.data);
+
+            if (const auto* number = std::get_if<Value::Float>(&value.data)) {
+                needle = *number;
+            } else if (small && *small >= -exact && *small <= exact) {
+                needle = static_cast<double>(*small);
+            } else {
+                return false;
+            }
+
+        } else {
+
+            bool negative = false;
+
+            if (!std::get_if<Value::SmallInt>(&value.data)) {
+                return false;
+            }
+
+            // число вне диапазона типа не равно ни одному элементу
+            if (!narrow(value, needle, negative)) {
+                return true;
+            }
+        }
+
+        for (qsizetype i = from; i < to; ++i) {
+            if (load<T>(data.constData(), i) == needle) {
+                found = i;
+                break;
+            }
+        }
+
+        return true;
+    });
+
+    if (typed) {
+        return found;
+    }
+
+    for (qsizetype i = from; i < to; ++i) {
+        if (item(i) == value) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+bool ArrayValue::equal(const Value& other) const {
+
+    const ArrayValue* array = of(other);
+
+    if (!array || array->len() != len()) {
+        return false;
+    }
+
+    // у целых одного кода равенство — совпадение байтов; у вещественных мешают NaN и -0.0
+    if (array->code == code && !arraykernels::isFloatCode(code)) {
+        return array->data == data;
+    }
+
+    for (qsizetype i = 0; i < len(); ++i) {
+        if (!(item(i) == array->item(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ArrayValue::notEqual(const Value& other) const {
+    return !equal(other);
+}
+
+Value ArrayValue::add(const Value& other) const {
+
+    const ArrayValue* array = of(other);
+
+    if (!array) {
+
+        if (other.isInstance()) {
+            return Value::notImplemented();
+        }
+
+        throw std::runtime_error(
+            "TypeError: can only append array (not \"" + typeName(other).toStdString() + "\") to array");
+    }
+
+    if (array->code != code) {
+        throw std::runtime_error("TypeError: bad argument type for built-in operation");
+    }
+
+    return Value(std::static_pointer_cast<ObjectValue>(std::make_shared<ArrayValue>(code, data + array->data)));
+}
+
+Value ArrayValue::multiply(const Value& other) const {
+
+    if (!other.isBigInt() && !other.isBool()) {
+        return Value::notImplemented();
+    }
+
+    const Value::BigInt count = other.toBigInt();
+
+    if (count <= 0 || data.isEmpty()) {
+        return Value(std::static_pointer_cast<ObjectValue>(std::make_shared<ArrayValue>(code)));
+    }
+
+    if (count > std::numeric_limits<qsizetype>::max() / data.size()) {
+        throw std::runtime_error("MemoryError");
+    }
+
+    return Value(std::static_pointer_cast<ObjectValue>(
+        std::make_shared<ArrayValue>(code, data.repeated(count.convert_to<qsizetype>()))));
+}
+
+Value ArrayValue::rmul(const Value& other) const {
+    return multiply(other);
+}
+
+Value ArrayValue::iadd(const Value& other) {
+
+    if (!of(other)) {
+        throw std::runtime_error(
+            "TypeError: can only extend array with array (not \"" + typeName(other).toStdString() + "\")");
+    }
+
+    extend(other);
+
+    return {};
+}
+
+Value ArrayValue::imul(const Value& other) {
+
+    if (!other.isBigInt() && !other.isBool()) {
+        throw std::runtime_error(
+            "TypeError: can't multiply sequence by non-int of type '" + typeName(other).toStdString() + "'");
+    }
+
+    const Value::BigInt count = other.toBigInt();
+
+    if (count <= 0 || data.isEmpty()) {
+        data.clear();
+        return {};
+    }
+
+    if (count > std::numeric_limits<qsizetype>::max() / data.size()) {
+        throw std::runtime_error("MemoryError");
+    }
+
+    data = data.repeated(count.convert_to<qsizetype>());
+
+    return {};
+}
+
+void ArrayValue::append(const Value& value) {
+
+    char cell[sizeof(double)];
+    encode(cell, value);
+
+    data.append(cell, size);
+}
+
+void ArrayValue::extend(const Value& iterable) {
+
+    if (const ArrayValue* other = of(iterable); other && other->code != code) {
+        throw std::runtime_error("TypeError: can only extend with array of same kind");
+    }
+
+    data.append(encodeAll(iterable));
+}
+
+void ArrayValue::fromBytes(const Value& source) {
+
+    // bytes, bytearray и memoryview читаются на месте, копируются только в конец массива
+    const QByteArrayView bytes = StructFormat::bufferOf(source);
+
+    if (bytes.size() % size != 0) {
+        throw std::runtime_error("ValueError: bytes length not a multiple of item size");
+    }
+
+    data.append(bytes.data(), bytes.size());
+}
+
+Value ArrayValue::pop(qsizetype index) {
+
+    if (data.isEmpty()) {
+        throw std::runtime_error("IndexError: pop from empty array");
+    }
+
+    if (index < 0) {
+        index += len();
+    }
+
+    if (index < 0 || index >= len()) {
+        throw std::runtime_error("IndexError: pop index out of range");
+    }
+
+    Value result = item(index);
+    data.remove(index * size, size);
+
+    return result;
+}
+
+void ArrayValue::insert(qsizetype index, const Value& value) {
+
+    char cell[sizeof(double)];
+    encode(cell, value);
+
+    if (index < 0) {
+        index = std::max<qsizetype>(index + len(), 0);
+    }
+
+    data.insert(std::min(index, len()) * size, QByteArrayView(cell, size));
+}
+
+void ArrayValue::remove(const Value& value) {
+
+    const qsizetype position = find(value, 0, len());
+
+    if (position < 0) {
+        throw std::runtime_error("ValueError: array.remove(x): x not in array");
+    }
+
+    data.remove(position * size, size);
+}
+
+void ArrayValue::reverse() {
+
+    visitCode(code, [&](auto zero) {
+
+        using T = decltype(zero);
+        char* bytes = data.data();
+
+        for (qsizetype i = 0, j = len() - 1; i < j; ++i, --j) {
+            const T left = load<T>(bytes, i);
+            store(bytes, i, load<T>(bytes, j));
+            store(bytes, j, left);
+        }
+    });
+}
+
+qsizetype ArrayValue::index(const Value& value, const qsizetype start, const qsizetype stop) const {
+
+    const qsizetype position = find(value, std::max<qsizetype>(start, 0), std::min(stop, len()));
+
+    if (position < 0) {
+        throw std::runtime_error("ValueError: array.index(x): x not in array");
+    }
+
+    return position;
+}
+
+qsizetype ArrayValue::countOf(const Value& value) const {
+
+    qsizetype result = 0;
+
+    for (qsizetype from = 0; (from = find(value, from, len())) >= 0; ++from) {
+        ++result;
+    }
+
+    return result;
+}
+
+QString ArrayValue::toString() const {
+    return reprAs("array");
+}
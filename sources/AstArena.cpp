@@ -0,0 +1,33 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "AstArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+void* AstArena::allocate(const std::size_t size, const std::size_t alignment) {
+
+    auto aligned = [&](std::byte* at) {
+        const auto address = reinterpret_cast<std::uintptr_t>(at);
+        return reinterpret_cast<std::byte*>((address + alignment - 1) & ~(alignment - 1));
+    };
+
+    std::byte* start = cursor ? aligned(cursor) : nullptr;
+
+    if (!start || start + size > end) {
+
+        // узел крупнее блока получает собственный блок нужного размера
+        const std::size_t blockSize = std::max(nextBlockSize, size + alignment);
+
+        blocks.emplace_back(new std::byte[blockSize]);
+        cursor = blocks.back().get();
+        end = cursor + blockSize;
+        nextBlockSize = std::min(nextBlockSize * 2, maxBlockSize);
+
+        start = aligned(cursor);
+    }
+
+    cursor = start + size;
+    return start;
+}
@@ -0,0 +1,223 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "AsyncioModule.h"
+
+#include <limits>
+
+#include "CallRuntime.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "EventLoop.h"
+#include "FutureValue.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "StreamValue.h"
+#include "TaskValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    Value futureValue(const std::shared_ptr<FutureValue>& future) {
+        return Value(std::static_pointer_cast<ObjectValue>(future));
+    }
+
+    [[noreturn]] void unexpectedKeyword(const char* function, const QString& name) {
+        throw std::runtime_error(std::string("TypeError: ") + function + "() got an unexpected keyword argument '" +
+                                 name.toStdString() + "'");
+    }
+
+    /// дескриптор аргумента: int или объект с fileno()
+    int descriptorOf(const Value& value, const std::shared_ptr<Environment>& env, const char* function) {
+
+        const Value fd = value.isBigInt() ? value : callMethod(value, "fileno", {}, {}, env);
+        const Value::BigInt number = fd.asBigInt(function);
+
+        if (number < 0 || number > std::numeric_limits<int>::max()) {
+            throw std::runtime_error("ValueError: file descriptor cannot be a negative integer (" +
+                                     number.str() + ")");
+        }
+
+        return number.convert_to<int>();
+    }
+
+    /// Future, завершаемая None, когда fd готов к чтению или записи
+    Value readiness(const Value& fd, const std::shared_ptr<Environment>& env, const bool write, const char* function) {
+
+        const int descriptor = descriptorOf(fd, env, function);
+        const auto future = FutureValue::create();
+
+        EventLoop::running().watch(descriptor, write, [future] {
+            if (!future->done()) {
+                future->setResult(Value());
+            }
+        });
+
+        return futureValue(future);
+    }
+}
+
+Value AsyncioModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("asyncio");
+
+    module->setAttribute("run", makeBuiltin(
+        "run",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "run");
+
+            for (const auto& [name, value] : kwargs) {
+                unexpectedKeyword("run", name);
+            }
+
+            EventLoop loop;
+
+            return loop.runUntilComplete(args[0]);
+        }
+    ));
+
+    module->setAttribute("sleep", makeBuiltin(
+        "sleep",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgsRange(args, 1, 2, "sleep");
+
+            Value result = args.size() > 1 ? args[1] : Value();
+
+            for (const auto& [name, value] : kwargs) {
+
+                if (name != "result") {
+                    unexpectedKeyword("sleep", name);
+                }
+
+                result = value;
+            }
+
+            if (!args[0].isNumeric()) {
+                throw std::runtime_error("TypeError: sleep() argument must be a number, not '" +
+                                         typeName(args[0]).toStdString() + "'");
+            }
+
+            const auto future = FutureValue::create();
+
+            EventLoop::running().callLater(args[0].toDouble(), [future, result] {
+                if (!future->done()) {
+                    future->setResult(result);
+                }
+            });
+
+            return futureValue(future);
+        }
+    ));
+
+    module->setAttribute("create_task", makeBuiltin(
+        "create_task",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "create_task");
+
+            return futureValue(EventLoop::running().createTask(args[0]));
+        }
+    ));
+
+    module->setAttribute("gather", makeBuiltin(
+        "gather",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            EventLoop& loop = EventLoop::running();
+            const auto gathered = FutureValue::create();
+
+            std::vector<std::shared_ptr<FutureValue>> children;
+            children.reserve(args.size());
+
+            for (const Value& awaitable : args) {
+                children.push_back(loop.ensureFuture(awaitable));
+            }
+
+            if (children.empty()) {
+                gathered->setResult(Value(makePooled<ListValue>()));
+                return futureValue(gathered);
+            }
+
+            // результаты — в порядке аргументов; первое исключение завершает gather сразу
+            const auto remaining = std::make_shared<std::size_t>(children.size());
+
+            for (const auto& child : children) {
+
+                child->addDoneCallback([gathered, children, remaining, child] {
+
+                    if (gathered->done()) {
+                        return;
+                    }
+
+                    try {
+                        (void) child->result();
+                    } catch (...) {
+                        gathered->setException(std::current_exception());
+                        return;
+                    }
+
+                    if (--*remaining > 0) {
+                        return;
+                    }
+
+                    std::vector<Value> results;
+                    results.reserve(children.size());
+
+                    for (const auto& done : children) {
+                        results.push_back(done->result());
+                    }
+
+                    gathered->setResult(Value(makePooled<ListValue>(std::move(results))));
+                });
+            }
+
+            return futureValue(gathered);
+        }
+    ));
+
+    module->setAttribute("open_connection", makeBuiltin(
+        "open_connection",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 2, "open_connection");
+
+            if (!args[0].isString()) {
+                throw std::runtime_error("TypeError: open_connection() host must be str, not '" +
+                                         typeName(args[0]).toStdString() + "'");
+            }
+
+            const Value::BigInt port = args[1].asBigInt("open_connection");
+
+            if (port < 0 || port > 65535) {
+                throw std::runtime_error("OverflowError: port must be 0-65535.");
+            }
+
+            return StreamConnection::open(args[0].toString(), port.convert_to<int>());
+        }
+    ));
+
+    module->setAttribute("wait_readable", makeBuiltin(
+        "wait_readable",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgs(args, 1, "wait_readable");
+
+            return readiness(args[0], env, false, "wait_readable");
+        }
+    ));
+
+    module->setAttribute("wait_writable", makeBuiltin(
+        "wait_writable",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgs(args, 1, "wait_writable");
+
+            return readiness(args[0], env, true, "wait_writable");
+        }
+    ));
+
+    return Value(module);
+}
@@ -0,0 +1,79 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "BigIntText.h"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+#ifndef CPPYTHON_USE_GMP
+
+    /// 10^(chunk·2^k) для k = 0, 1, …
+    const Value::BigInt& power(const std::size_t k) {
+
+        static std::vector<Value::BigInt> powers;
+
+        if (powers.empty()) {
+            powers.push_back(boost::multiprecision::pow(Value::BigInt(10), static_cast<unsigned>(BigIntText::chunk)));
+        }
+
+        while (powers.size() <= k) {
+            powers.push_back(powers.back() * powers.back());
+        }
+
+        return powers[k];
+    }
+
+    Value::BigInt parseDigits(const std::string_view digits) {
+
+        if (digits.size() <= BigIntText::chunk) {
+
+            // ведущие нули младших частей: Boost прочёл бы запись с 0 как восьмеричную
+            const std::size_t first = digits.find_first_not_of('0');
+
+            return first == std::string_view::npos ? Value::BigInt(0) : Value::BigInt(std::string(digits.substr(first)));
+        }
+
+        // младшая часть — наибольшая степень двойки блоков, меньшая всей записи
+        std::size_t k = 0;
+        std::size_t low = BigIntText::chunk;
+
+        while (low * 2 < digits.size()) {
+            low *= 2;
+            ++k;
+        }
+
+        const std::size_t high = digits.size() - low;
+
+        return parseDigits(digits.substr(0, high)) * power(k) + parseDigits(digits.substr(high));
+    }
+
+#endif
+}
+
+std::string BigIntText::toString(const Value::BigInt& value) {
+    return value.str();
+}
+
+Value::BigInt BigIntText::fromString(const std::string& text) {
+
+#ifdef CPPYTHON_USE_GMP
+    return Value::BigInt(text);
+#else
+    const bool negative = !text.empty() && text[0] == '-';
+    const std::string_view digits = std::string_view(text).substr(negative || (!text.empty() && text[0] == '+'));
+
+    // ведущий 0 у длинной записи — другие основания и восьмеричная запись Boost
+    if (digits.size() <= chunk || digits[0] == '0' ||
+        !std::all_of(digits.begin(), digits.end(), [](const char c) { return c >= '0' && c <= '9'; })) {
+        return Value::BigInt(text);
+    }
+
+    Value::BigInt result = parseDigits(digits);
+
+    return negative ? Value::BigInt(-result) : result;
+#endif
+}
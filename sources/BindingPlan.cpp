@@ -0,0 +1,13 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "BindingPlan.h"
+
+BindingPlan::BindingPlan(const std::vector<Param>& params) : positional(params.size()) {
+
+    indices.reserve(static_cast<qsizetype>(params.size()));
+
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        indices.insert(params[i].name, static_cast<int>(i));
+    }
+}
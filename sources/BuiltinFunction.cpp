@@ -1,3 +1,8 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "PackedValue.h"
 #include "BoundMethod.h"
 #include "ByteArrayValue.h"
 #include "BytesValue.h"
@@ -5,39 +10,254 @@
 #include "ClassMethodValue.h"
 #include "ClassUtils.h"
 #include "DictValue.h"
+#include "EnumerateIterator.h"
 #include "Environment.h"
+#include "FileValue.h"
+#include "FilterIterator.h"
 #include "FrozenSetValue.h"
+#include "IntMath.h"
 #include "IteratorValue.h"
 #include "ListValue.h"
+#include "MapIterator.h"
+#include "MemoryViewValue.h"
+#include "ObjectPool.h"
+#include "OutputStream.h"
 #include "PropertyValue.h"
+#include "RangeValue.h"
+#include "ReprWriter.h"
 #include "ReversedSequenceIterator.h"
 #include "SetValue.h"
 #include "StaticMethodValue.h"
 #include "StrValue.h"
 #include "SuperValue.h"
+#include "SysModule.h"
 #include "TupleValue.h"
 #include "Value.h"
+#include "ZipIterator.h"
 #include "../runtime/ArgValidation.h"
 #include "../runtime/RuntimeUtils.h"
 //
 // Created by semyo on 04.05.2026.
 //
 
-const Value* findKwarg(const Kwargs& kwargs, const QString& name) {
+namespace {
+
+    /**
+     * Передаёт fn элементы iterable, пока fn возвращает true. Список, кортеж и range
+     * обходятся напрямую по элементам, без объекта-итератора; остальное — через iterNext.
+     */
+    template<typename Fn>
+    void forEachItem(const Value& iterable, const std::shared_ptr<Environment>& env, Fn&& fn) {
+
+        if (const auto list = std::get_if<Value::ListPtr>(&iterable.data)) {
+
+            // по индексу и с копией элемента: fn может изменить сам список
+            for (std::size_t i = 0; i < (*list)->elements.size(); ++i) {
+                if (const Value item = (*list)->elements.get()[i]; !fn(item)) {
+                    return;
+                }
+            }
+
+            return;
+        }
+
+        if (const auto tuple = std::get_if<Value::TuplePtr>(&iterable.data)) {
+
+            for (const auto& item : (*tuple)->items) {
+                if (!fn(item)) {
+                    return;
+                }
+            }
+
+            return;
+        }
+
+        // длинная прогрессия обходится своим итератором
+        if (const auto range = std::get_if<Value::RangePtr>(&iterable.data); range && !(*range)->isWide()) {
+
+            for (Value::SmallInt i = 0; i < (*range)->len(); ++i) {
+                if (!fn(Value((*range)->at(i)))) {
+                    return;
+                }
+            }
+
+            return;
+        }
 
-    const auto it = std::find_if(kwargs.begin(), kwargs.end(),
-        [&](const auto& pair) { return pair.first == name; });
+        const Value iterator = getIter(iterable, env);
 
-    if (it == kwargs.end()) {
-        return nullptr;
+        for (Value item; iterNext(iterator, item, env);) {
+            if (!fn(item)) {
+                return;
+            }
+        }
     }
 
-    return &it->second;
+    /// min() и max(): один итерируемый аргумент или несколько значений, key= и default=
+    Value extremum(const std::vector<Value>& args,
+                   const Kwargs& kwargs,
+                   const std::shared_ptr<Environment>& env,
+                   const QString& name,
+                   const bool wantMax) {
+
+        if (args.empty()) {
+            throw std::runtime_error(
+                "TypeError: " + name.toStdString() + " expected at least 1 argument, got 0"
+            );
+        }
+
+        const Value* key = findKwarg(kwargs, "key");
+
+        if (key && key->isNone()) {
+            key = nullptr;
+        }
+
+        const Value* fallback = findKwarg(kwargs, "default");
+
+        if (fallback && args.size() > 1) {
+            throw std::runtime_error(
+                "TypeError: Cannot specify a default for " + name.toStdString() +
+                "() with multiple positional arguments"
+            );
+        }
+
+        // array и vector без key= сравниваются прямо в буфере машинных значений
+        if (const PackedValue* array = args.size() == 1 && !key ? PackedValue::of(args[0]) : nullptr;
+            array && array->len() > 0) {
+            return array->extremum(wantMax);
+        }
+
+        // список одних int или одних float — тем же прямым циклом по элементам
+        if (args.size() == 1 && !key && args[0].isList()) {
+            if (std::optional<Value> result = args[0].asList()->extremumOf(wantMax)) {
+                return std::move(*result);
+            }
+        }
+
+        std::optional<Value> best;
+        Value bestKey;
+
+        const auto consider = [&](const Value& item) {
+
+            Value itemKey = key ? call(*key, {item}, {}, env) : item;
+
+            // при равенстве остаётся первый элемент, как в CPython
+            if (!best || (wantMax ? itemKey > bestKey : itemKey < bestKey)) {
+                best = item;
+                bestKey = std::move(itemKey);
+            }
+
+            return true;
+        };
+
+        if (args.size() == 1) {
+            forEachItem(args[0], env, consider);
+        } else {
+            for (const auto& item : args) {
+                consider(item);
+            }
+        }
+
+        if (best) {
+            return *best;
+        }
+
+        if (fallback) {
+            return *fallback;
+        }
+
+        throw std::runtime_error("ValueError: " + name.toStdString() + "() iterable argument is empty");
+    }
+
+    /// источники для zip и map: итератор каждого аргумента
+    std::vector<Value> iteratorsOf(const std::vector<Value>& iterables,
+                                   const std::size_t first,
+                                   const std::shared_ptr<Environment>& env) {
+
+        std::vector<Value> sources;
+        sources.reserve(iterables.size() - first);
+
+        for (std::size_t i = first; i < iterables.size(); ++i) {
+            sources.push_back(getIter(iterables[i], env));
+        }
+
+        return sources;
+    }
+
+    /// позиционный аргумент или одноимённый именованный; None — если нет ни того, ни другого
+    Value optionalArg(const std::vector<Value>& args, const std::size_t index,
+                      const Kwargs& kwargs, const QString& name) {
+
+        if (index < args.size()) {
+            return args[index];
+        }
+
+        const Value* value = findKwarg(kwargs, name);
+
+        return value ? *value : Value();
+    }
+
+    /// метод `__abs__`, `__round__` и т. п. экземпляра или TypeError
+    Value callDunder(const Value& obj, const QString& name, const std::vector<Value>& args,
+                     const std::string& message) {
+
+        if (obj.isInstance()) {
+            if (const std::optional<Value> method = tryGetAttr(obj, name)) {
+                return call(*method, args, {}, nullptr);
+            }
+        }
+
+        throw std::runtime_error("TypeError: " + message);
+    }
+
+    /**
+     * round(float, ndigits). printf округляет точное двоичное значение половиной
+     * к чётному — так же, как CPython через dtoa. Отрицательные ndigits считаются
+     * делением на степень десяти и могут расходиться с CPython в последнем бите.
+     */
+    Value::Float roundDouble(const Value::Float x, const Value::SmallInt ndigits) {
+
+        // за этими границами результат — сам x или ноль его знака, как в CPython
+        if (!std::isfinite(x) || x == 0 || ndigits > 323) {
+            return x;
+        }
+
+        if (ndigits < -308) {
+            return 0.0 * x;
+        }
+
+        if (ndigits < 0) {
+            const Value::Float unit = std::pow(10.0, static_cast<Value::Float>(-ndigits));
+            return std::nearbyint(x / unit) * unit;
+        }
+
+        const int digits = static_cast<int>(ndigits);
+        std::string text(static_cast<std::size_t>(std::snprintf(nullptr, 0, "%.*f", digits, x)), '\0');
+
+        std::snprintf(text.data(), text.size() + 1, "%.*f", digits, x);
+
+        return std::strtod(text.c_str(), nullptr);
+    }
 }
 
 
 void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env) {
 
+    // функции без состояния строятся один раз на процесс; интерпретатор получает копию
+    // таблицы со ссылками на те же объекты, без std::function и выделений на каждое имя
+    static const QHash<QString, Value> snapshot = [] {
+        const auto scratch = std::make_shared<Environment>();
+        defineBuiltins(scratch);
+        return scratch->variables;
+    }();
+
+    env->setAll(snapshot);
+}
+
+void BuiltinFunction::defineBuiltins(const std::shared_ptr<Environment> &env) {
+
+    env->set("NotImplemented", Value::notImplemented());
+
     env->set("super",
              makeBuiltin(
                  "super",
@@ -46,18 +266,20 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                     const Kwargs &,
                     const std::shared_ptr<Environment> &local_env) -> Value {
 
-                     Value receiver;
+                     // instance method или classmethod
+                     const Value* self = local_env->find("self");
+                     const Value receiver = self ? *self : local_env->get("cls");
+
+                     // кадр метода или вложенная в него область (тело включения)
+                     std::shared_ptr<ClassValue> origin;
 
-                     // instance method
-                     try {
-                         receiver = local_env->get("self");
-                     } catch (...) {
-                         // classmethod
-                         receiver = local_env->get("cls");
+                     for (const Environment* scope = local_env.get(); scope && !origin; scope = scope->parent.get()) {
+                         origin = scope->ownerClass;
                      }
 
-                     auto clsVal = local_env->get("__class__");
-                     auto origin = std::get<Value::ClassPtr>(clsVal.data);
+                     if (!origin) {
+                         throw std::runtime_error("RuntimeError: super(): __class__ cell not found");
+                     }
 
                      return Value(std::make_shared<SuperValue>(
                          origin, // currentClass
@@ -80,13 +302,7 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                      const Value &obj = args[0];
                      const QString attr = args[1].asString()->toString();
 
-                     try {
-                         genericGetAttr(obj, attr);
-
-                         return Value(true);
-                     } catch (...) {
-                         return Value(false);
-                     }
+                     return Value(tryGetAttr(obj, attr).has_value());
                  }
              ));
 
@@ -103,14 +319,11 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                      const Value &obj = args[0];
                      const QString &attr = args[1].asString()->toString();
 
-                     try {
-                         return genericGetAttr(obj, attr);
-                     } catch (...) {
-                         if (args.size() == 3) {
-                             return args[2]; // default
-                         }
-                         throw; // AttributeError
+                     if (args.size() == 3) {
+                         return tryGetAttr(obj, attr).value_or(args[2]); // default
                      }
+
+                     return getAttrValue(obj, attr);
                  }
              ));
 
@@ -259,13 +472,14 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                          return Value(Value::BigInt((*l)->len()));
                      }
 
-                     try {
-
-                         const Value lenMethod = getAttrValue(obj, "__len__");
-
-                         return call(lenMethod, {}, {}, nullptr);
+                     // range: длина вычисляется, элементы не строятся
+                     if (const auto r = std::get_if<Value::RangePtr>(&obj.data)) {
+                         return Value((*r)->len());
+                     }
 
-                     } catch (...) {}
+                     if (const std::optional<Value> lenMethod = tryGetAttr(obj, "__len__")) {
+                         return call(*lenMethod, {}, {}, nullptr);
+                     }
 
                      throw std::runtime_error("Object has no len()");
                  }
@@ -281,9 +495,7 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
 
                 expectArgs(args, 1, "iter");
 
-                const Value method = getAttrValue(args[0], "__iter__");
-
-                return call(method, {}, {}, env);
+                return getIter(args[0], env);
             }
         ));
 
@@ -303,6 +515,41 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
             }
         ));
 
+    env->set("open",
+        makeBuiltin(
+            "open",
+
+            [](const std::vector<Value> &args,
+               const Kwargs &kwargs,
+               const std::shared_ptr<Environment> &) -> Value {
+
+                expectArgsRange(args, 1, 3, "open");
+
+                if (!args[0].isString()) {
+                    throw std::runtime_error("TypeError: expected str as file path");
+                }
+
+                const Value* mode = args.size() > 1 ? &args[1] : findKwarg(kwargs, "mode");
+                const Value* encoding = args.size() > 2 ? &args[2] : findKwarg(kwargs, "encoding");
+
+                if (mode && !mode->isString()) {
+                    throw std::runtime_error("TypeError: open() argument 'mode' must be str");
+                }
+
+                // файлы читаются и пишутся только в UTF-8
+                if (encoding && !encoding->isNone()) {
+
+                    const QString name = encoding->toString().toLower().remove('-').remove('_');
+
+                    if (name != "utf8") {
+                        throw std::runtime_error("LookupError: unsupported encoding: " + encoding->toString().toStdString());
+                    }
+                }
+
+                return FileValue::open(args[0].toString(), mode ? mode->toString() : QString("r"));
+            }
+        ));
+
     env->set("hash",
         makeBuiltin(
             "hash",
@@ -323,6 +570,177 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
             }
         ));
 
+    env->set("abs",
+        makeBuiltin(
+            "abs",
+
+            [](const std::vector<Value> &args,
+               const Kwargs &,
+               const std::shared_ptr<Environment> &) -> Value {
+
+                expectArgs(args, 1, "abs");
+
+                const Value& x = args[0];
+
+                if (x.isDouble()) {
+                    return Value(std::fabs(std::get<Value::Float>(x.data)));
+                }
+
+                if (x.isNumeric()) {
+                    const Value number = x.isBool() ? Value(x.toBigInt()) : x;
+                    return number < Value(Value::SmallInt(0)) ? -number : number;
+                }
+
+                return callDunder(x, "__abs__", {},
+                    "bad operand type for abs(): '" + typeName(x).toStdString() + "'");
+            }
+        ));
+
+    env->set("divmod",
+        makeBuiltin(
+            "divmod",
+
+            [](const std::vector<Value> &args,
+               const Kwargs &,
+               const std::shared_ptr<Environment> &) -> Value {
+
+                expectArgs(args, 2, "divmod");
+
+                const Value& a = args[0];
+                const Value& b = args[1];
+
+                if (IntMath::isInt(a) && IntMath::isInt(b)) {
+                    auto [quotient, remainder] = IntMath::divMod(a, b);
+                    return Value(makePooled<TupleValue>(std::vector<Value>{ std::move(quotient), std::move(remainder) }));
+                }
+
+                if (a.isNumeric() && b.isNumeric()) {
+                    return Value(makePooled<TupleValue>(std::vector<Value>{ a.intDivide(b), a % b }));
+                }
+
+                return callDunder(a, "__divmod__", { b },
+                    "unsupported operand type(s) for divmod(): '" + typeName(a).toStdString() +
+                    "' and '" + typeName(b).toStdString() + "'");
+            }
+        ));
+
+    // pow(base, exp, mod): с mod — возведение по модулю, без построения полной степени
+    env->set("pow",
+        makeBuiltin(
+            "pow",
+
+            [](const std::vector<Value> &args,
+               const Kwargs &kwargs,
+               const std::shared_ptr<Environment> &) -> Value {
+
+                expectArgsRange(args, 1, 3, "pow");
+
+                const Value base = args[0];
+                const Value exp = optionalArg(args, 1, kwargs, "exp");
+                const Value mod = optionalArg(args, 2, kwargs, "mod");
+
+                if (mod.isNone()) {
+                    return base.power(exp);
+                }
+
+                if (!IntMath::isInt(base) || !IntMath::isInt(exp) || !IntMath::isInt(mod)) {
+                    throw std::runtime_error("TypeError: pow() 3rd argument not allowed unless all arguments are integers");
+                }
+
+                return IntMath::powerMod(base, exp, mod);
+            }
+        ));
+
+    env->set("round",
+        makeBuiltin(
+            "round",
+
+            [](const std::vector<Value> &args,
+               const Kwargs &kwargs,
+               const std::shared_ptr<Environment> &) -> Value {
+
+                expectArgsRange(args, 1, 2, "round");
+
+                const Value& x = args[0];
+                const Value ndigits = optionalArg(args, 1, kwargs, "ndigits");
+
+                if (!ndigits.isNone() && !IntMath::isInt(ndigits)) {
+                    throw std::runtime_error("TypeError: '" + typeName(ndigits).toStdString() +
+                                             "' object cannot be interpreted as an integer");
+                }
+
+                if (IntMath::isInt(x)) {
+                    return IntMath::round(x, ndigits);
+                }
+
+                if (x.isDouble()) {
+
+                    const Value::Float value = std::get<Value::Float>(x.data);
+
+                    if (!ndigits.isNone()) {
+                        const Value::BigInt places = ndigits.toBigInt();
+                        const auto clamped = places > 1000 ? 1000 : places < -1000 ? -1000 : places.convert_to<Value::SmallInt>();
+                        return Value(roundDouble(value, clamped));
+                    }
+
+                    if (std::isnan(value)) {
+                        throw std::runtime_error("ValueError: cannot convert float NaN to integer");
+                    }
+
+                    if (std::isinf(value)) {
+                        throw std::runtime_error("OverflowError: cannot convert float infinity to integer");
+                    }
+
+                    // nearbyint в режиме по умолчанию — половина к чётному, как round() в Python
+                    return Value(Value::BigInt(std::nearbyint(value)));
+                }
+
+                std::vector<Value> rest;
+
+                if (!ndigits.isNone()) {
+                    rest.push_back(ndigits);
+                }
+
+                return callDunder(x, "__round__", rest,
+                    "type " + typeName(x).toStdString() + " doesn't define __round__ method");
+            }
+        ));
+
+    // 50-значное десятичное вещественное: float по умолчанию — IEEE double
+    env->set("decimal",
+        makeBuiltin(
+            "decimal",
+
+            [](const std::vector<Value> &args,
+               const Kwargs &,
+               const std::shared_ptr<Environment> &) -> Value {
+
+                if (args.empty()) {
+                    return Value(Value::BigFloat(0));
+                }
+
+                expectArgs(args, 1, "decimal");
+
+                if (args[0].isNumeric()) {
+                    return Value(args[0].toBigFloat());
+                }
+
+                if (args[0].isString()) {
+
+                    const QString text = args[0].asString()->toString().trimmed();
+
+                    try {
+                        return Value(Value::BigFloat(text.toStdString()));
+                    } catch (const std::exception&) {
+                        throw std::runtime_error(
+                            "ValueError: invalid literal for decimal(): '" + text.toStdString() + "'");
+                    }
+                }
+
+                throw std::runtime_error("TypeError: decimal() argument must be a string or a number");
+            }
+        ));
+
     env->set("list",
              makeBuiltin(
                  "list",
@@ -334,20 +752,38 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                      expectArgsRange(args, 0, 1, "list");
 
                      if (args.empty()) {
-                         return Value(std::make_shared<ListValue>());
+                         return Value(makePooled<ListValue>());
                      }
 
                      const Value &iterable = args[0];
 
+                     // копия списка делит его буфер до первой записи
+                     if (iterable.isList()) {
+                         return iterable.asList()->copy();
+                     }
+
                      const auto it = iterable.getIterator();
 
                      std::vector<Value> items;
+                     items.reserve(ListValue::lengthHint(iterable));
 
                      while (it->hasNext()) {
                          items.push_back(it->next());
                      }
 
-                     return Value(std::make_shared<ListValue>(items));
+                     return Value(makePooled<ListValue>(std::move(items)));
+                 }
+             ));
+
+    env->set("range",
+             makeBuiltin(
+                 "range",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &,
+                    const std::shared_ptr<Environment> &) -> Value {
+
+                     return RangeValue::fromArgs(args);
                  }
              ));
 
@@ -362,20 +798,20 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                      expectArgsRange(args, 0, 1, "tuple");
 
                      if (args.empty()) {
-                         return Value(std::make_shared<TupleValue>(std::vector<Value>{}));
+                         return TupleValue::empty();
                      }
 
                      const Value &iterable = args[0];
 
                      const auto it = iterable.getIterator();
 
-                     std::vector<Value> items;
+                     std::vector<Value> items = TupleValue::acquireItems(ListValue::lengthHint(iterable));
 
                      while (it->hasNext()) {
                          items.push_back(it->next());
                      }
 
-                     return Value(std::make_shared<TupleValue>(items));
+                     return TupleValue::make(std::move(items));
                  }
              ));
 
@@ -395,6 +831,15 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
 
                      const Value &iterable = args[0];
 
+                     // set(s) и set(fs) делят таблицу с источником до первого изменения
+                     if (iterable.isSet()) {
+                         return Value(std::make_shared<SetValue>(iterable.asSet()->elements));
+                     }
+
+                     if (iterable.isFrozenSet()) {
+                         return Value(std::make_shared<SetValue>(iterable.asFrozenSet()->getElements()));
+                     }
+
                      const auto it = iterable.getIterator();
 
                      const auto set = std::make_shared<SetValue>();
@@ -412,32 +857,27 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                  "dict",
 
                  [](const std::vector<Value> &args,
-                    const Kwargs &,
+                    const Kwargs &kwargs,
                     const std::shared_ptr<Environment> &) -> Value {
 
                      expectArgsRange(args, 0, 1, "dict");
 
-                     if (args.empty()) {
-                         return Value(std::make_shared<DictValue>());
-                     }
-
-                     const Value &iterable = args[0];
-
-                     const auto it = iterable.getIterator();
-
                      const auto dict = std::make_shared<DictValue>();
 
-                     while (it->hasNext()) {
+                     if (!args.empty() && args[0].isDict()) {
 
-                         Value item = it->next();
+                         // копия записей и таблицы источника без хеширования ключей
+                         dict->merge(*args[0].asDict());
 
-                         const auto tup = item.asTuple("dict()");
+                     } else if (!args.empty()) {
+                         dict->mergePairs(args[0]);
+                     }
 
-                         if (tup->items.size() != 2) {
-                             throw std::runtime_error("dict() expects (key, value) pairs");
-                         }
+                     // dict(base, key=value): именованные аргументы поверх позиционного
+                     dict->reserve(kwargs.size());
 
-                         dict->setItem(tup->items[0], tup->items[1]);
+                     for (const auto& [name, value] : kwargs) {
+                         dict->setItem(Value(name), value);
                      }
 
                      return Value(dict);
@@ -463,10 +903,24 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                     );
                 }
 
+                // frozenset неизменяем: frozenset(fs) — он же, как в CPython
+                if (args[0].isFrozenSet()) {
+                    return args[0];
+                }
+
+                // таблица set не перестраивается: записи общие до первого изменения set
+                if (args[0].isSet()) {
+                    return Value(
+                        std::make_shared<FrozenSetValue>(
+                            args[0].asSet()->elements
+                        )
+                    );
+                }
+
                 const auto iterator =
                         args[0].getIterator();
 
-                QSet<Value> elements;
+                OrderedValueSet elements;
 
                 while (iterator->hasNext()) {
                     elements.insert(
@@ -483,6 +937,223 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
         )
     );
 
+    env->set("sum",
+             makeBuiltin(
+                 "sum",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &kwargs,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     expectArgsRange(args, 1, 2, "sum");
+
+                     Value total = args.size() == 2 ? args[1] : Value(static_cast<Value::SmallInt>(0));
+
+                     if (const auto start = findKwarg(kwargs, "start")) {
+                         total = *start;
+                     }
+
+                     if (total.isString()) {
+                         throw std::runtime_error("TypeError: sum() can't sum strings [use ''.join(seq) instead]");
+                     }
+
+                     if (const PackedValue* array = PackedValue::of(args[0])) {
+                         if (std::optional<Value> result = array->sumOf(total)) {
+                             return std::move(*result);
+                         }
+                     }
+
+                     if (args[0].isList()) {
+                         if (std::optional<Value> result = args[0].asList()->sumOf(total)) {
+                             return std::move(*result);
+                         }
+                     }
+
+                     forEachItem(args[0], env, [&](const Value& item) {
+                         total = total + item;
+                         return true;
+                     });
+
+                     return total;
+                 }
+             ));
+
+    env->set("min",
+             makeBuiltin(
+                 "min",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &kwargs,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     return extremum(args, kwargs, env, "min", false);
+                 }
+             ));
+
+    env->set("max",
+             makeBuiltin(
+                 "max",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &kwargs,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     return extremum(args, kwargs, env, "max", true);
+                 }
+             ));
+
+    env->set("any",
+             makeBuiltin(
+                 "any",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     expectArgs(args, 1, "any");
+
+                     bool found = false;
+
+                     forEachItem(args[0], env, [&](const Value& item) {
+                         found = item.toBool();
+                         return !found;
+                     });
+
+                     return Value(found);
+                 }
+             ));
+
+    env->set("all",
+             makeBuiltin(
+                 "all",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     expectArgs(args, 1, "all");
+
+                     bool result = true;
+
+                     forEachItem(args[0], env, [&](const Value& item) {
+                         result = item.toBool();
+                         return result;
+                     });
+
+                     return Value(result);
+                 }
+             ));
+
+    env->set("sorted",
+             makeBuiltin(
+                 "sorted",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &kwargs,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     expectArgs(args, 1, "sorted");
+
+                     std::optional<Value> key;
+                     bool reverse = false;
+
+                     for (const auto &[name, value] : kwargs) {
+
+                         if (name == "key") {
+                             if (!value.isNone()) {
+                                 key = value;
+                             }
+                         } else if (name == "reverse") {
+                             reverse = value.toBool();
+                         } else {
+                             throw std::runtime_error("Unknown keyword argument: " + name.toStdString());
+                         }
+                     }
+
+                     std::vector<Value> items;
+
+                     forEachItem(args[0], env, [&](const Value& item) {
+                         items.push_back(item);
+                         return true;
+                     });
+
+                     const auto result = makePooled<ListValue>(std::move(items));
+                     result->sort(key, reverse, env);
+
+                     return Value(result);
+                 }
+             ));
+
+    env->set("enumerate",
+             makeBuiltin(
+                 "enumerate",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &kwargs,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     expectArgsRange(args, 1, 2, "enumerate");
+
+                     const Value* start = args.size() == 2 ? &args[1] : findKwarg(kwargs, "start");
+
+                     return Value(std::static_pointer_cast<IteratorValue>(
+                         std::make_shared<EnumerateIterator>(
+                             getIter(args[0], env),
+                             start ? start->asBigInt("enumerate").convert_to<Value::SmallInt>() : 0,
+                             env
+                         )
+                     ));
+                 }
+             ));
+
+    env->set("zip",
+             makeBuiltin(
+                 "zip",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     return Value(std::static_pointer_cast<IteratorValue>(
+                         std::make_shared<ZipIterator>(iteratorsOf(args, 0, env), env)
+                     ));
+                 }
+             ));
+
+    env->set("map",
+             makeBuiltin(
+                 "map",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     if (args.size() < 2) {
+                         throw std::runtime_error("TypeError: map() must have at least two arguments.");
+                     }
+
+                     return Value(std::static_pointer_cast<IteratorValue>(
+                         std::make_shared<MapIterator>(args[0], iteratorsOf(args, 1, env), env)
+                     ));
+                 }
+             ));
+
+    env->set("filter",
+             makeBuiltin(
+                 "filter",
+
+                 [](const std::vector<Value> &args,
+                    const Kwargs &,
+                    const std::shared_ptr<Environment> &env) -> Value {
+
+                     expectArgs(args, 2, "filter");
+
+                     return Value(std::static_pointer_cast<IteratorValue>(
+                         std::make_shared<FilterIterator>(args[0], getIter(args[1], env), env)
+                     ));
+                 }
+             ));
+
     env->set("repr",
              makeBuiltin(
                  "repr",
@@ -504,51 +1175,87 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
 
         [](const std::vector<Value>& args,
            const Kwargs& kwargs,
-           const std::shared_ptr<Environment>&) -> Value {
+           const std::shared_ptr<Environment>& env) -> Value {
 
-            QString sep = " ";
-            QString end = "\n";
+            std::optional<Value> sep;
+            std::optional<Value> end;
             bool flush = false;
 
-            // sep
-            if (const auto sepArg = findKwarg(kwargs, "sep"))
-            {
-                if (!sepArg->isString()) {
-                    throw std::runtime_error("TypeError: sep must be str");
-                }
+            // sep и end: None означает значение по умолчанию
+            const auto textKwarg = [&](const char* name, std::optional<Value>& target) {
 
-                sep = sepArg->toString();
-            }
+                if (const auto arg = findKwarg(kwargs, name); arg && !arg->isNone()) {
+
+                    if (!arg->isString()) {
+                        throw std::runtime_error(std::string("TypeError: ") + name + " must be None or a string");
+                    }
 
-            // end
-            if (const auto endArg = findKwarg(kwargs, "end"))
-            {
-                if (!endArg->isString()) {
-                    throw std::runtime_error("TypeError: end must be str");
+                    target = *arg;
                 }
+            };
 
-                end = endArg->toString();
-            }
+            textKwarg("sep", sep);
+            textKwarg("end", end);
 
             // flush
             if (const auto flushArg = findKwarg(kwargs, "flush")) {
                 flush = flushArg->toBool();
             }
 
-            // output
-            for (size_t i = 0; i < args.size(); ++i) {
+            OutputStream* stream = &OutputStream::standardOutput();
+            Value file;
+
+            if (const auto fileArg = findKwarg(kwargs, "file"); fileArg && !fileArg->isNone()) {
+                stream = SysModule::nativeStream(*fileArg);
+                file = *fileArg;
+            }
+
+            // sys.stdout/sys.stderr: символы строк кодируются прямо в буфер потока
+            if (stream) {
+
+                // контейнеры пишутся в буфер потока по элементам, без строки целиком
+                const auto emit = [stream](const Value& value) {
+                    if (value.isString()) {
+                        stream->write(value.asString()->view());
+                    } else {
+                        ReprWriter(*stream).str(value);
+                    }
+                };
+
+                for (std::size_t i = 0; i < args.size(); ++i) {
+
+                    if (i > 0) {
+                        sep ? emit(*sep) : stream->write(std::string_view(" "));
+                    }
+
+                    emit(args[i]);
+                }
+
+                end ? emit(*end) : stream->write(std::string_view("\n"));
+
+                if (flush) {
+                    stream->flush();
+                }
+
+                return {};
+            }
+
+            // любой объект с методом write: как в CPython, по вызову на каждый фрагмент
+            const Value write = getAttrValue(file, "write");
+
+            for (std::size_t i = 0; i < args.size(); ++i) {
 
                 if (i > 0) {
-                    std::cout << sep.toStdString();
+                    call(write, {sep.value_or(Value(" "))}, {}, env);
                 }
 
-                std::cout << args[i].toString().toStdString();
+                call(write, {args[i].isString() ? args[i] : Value(args[i].toString())}, {}, env);
             }
 
-            std::cout << end.toStdString();
+            call(write, {end.value_or(Value("\n"))}, {}, env);
 
             if (flush) {
-                std::cout.flush();
+                call(getAttrValue(file, "flush"), {}, {}, env);
             }
 
             return {}; // None
@@ -589,11 +1296,9 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
 
             const Value& obj = args[0];
 
-            try {
-
-                Value method = getAttrValue(obj, "__bytes__");
+            if (const std::optional<Value> method = tryGetAttr(obj, "__bytes__")) {
 
-                Value result = call(method, {}, {}, nullptr);
+                Value result = call(*method, {}, {}, nullptr);
 
                 if (!result.isBytes()) {
                     throw std::runtime_error(
@@ -602,19 +1307,16 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                 }
 
                 return result;
-
-            } catch (const std::runtime_error &e) {
-
-                if (const std::string msg = e.what();
-                    msg.find("AttributeError") == std::string::npos) {
-                    throw;
-                }
             }
 
             if (obj.isBytes()) {
                 return obj;
             }
 
+            if (const MemoryViewValue* view = MemoryViewValue::of(obj)) {
+                return Value(std::make_shared<BytesValue>(view->toBytes()));
+            }
+
             if (obj.isString()) {
 
                 return Value(
@@ -650,11 +1352,9 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
 
              const Value &obj = args[0];
 
-             try {
+             if (const std::optional<Value> method = tryGetAttr(obj, "__bytes__")) {
 
-                Value method = getAttrValue(obj, "__bytes__");
-
-                Value result = call(method, {}, {}, nullptr);
+                Value result = call(*method, {}, {}, nullptr);
 
                 if (!result.isBytes()) {
                     throw std::runtime_error(
@@ -663,13 +1363,6 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                 }
 
                 return result;
-
-            } catch (const std::runtime_error &e) {
-
-                if (const std::string msg = e.what();
-                    msg.find("AttributeError") == std::string::npos) {
-                    throw;
-                }
             }
 
              if (obj.isByteArray()) {
@@ -688,6 +1381,10 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                  );
              }
 
+             if (const MemoryViewValue* view = MemoryViewValue::of(obj)) {
+                 return Value(std::make_shared<ByteArrayValue>(view->toBytes()));
+             }
+
              if (obj.isString()) {
                  return Value(
                      std::make_shared<ByteArrayValue>(
@@ -702,6 +1399,21 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
          }
     ));
 
+    // вид без копирования: срезы memoryview делят буфер bytes или bytearray
+    env->set("memoryview",
+        makeBuiltin(
+            "memoryview",
+
+            [](const std::vector<Value>& args,
+               const Kwargs&,
+               const std::shared_ptr<Environment>&) -> Value {
+
+                expectArgs(args, 1, "memoryview");
+
+                return Value(std::make_shared<MemoryViewValue>(args[0]));
+            }
+        ));
+
     env->set(
     "reversed",
 
@@ -717,22 +1429,16 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
             const Value& obj = args[0];
 
             // 1. __reversed__
-            try {
-
-                Value method = getAttrValue(obj, "__reversed__");
-
-                return call(method, {}, {}, env);
-
-            } catch (...) {}
+            if (const std::optional<Value> method = tryGetAttr(obj, "__reversed__")) {
+                return call(*method, {}, {}, env);
+            }
 
             // 2. fallback через __len__ + __getitem__
-            try {
+            const std::optional<Value> lenMethod = tryGetAttr(obj, "__len__");
 
-                Value lenMethod = getAttrValue(obj, "__len__");
+            if (lenMethod && tryGetAttr(obj, "__getitem__")) {
 
-                Value getItemMethod = getAttrValue(obj, "__getitem__");
-
-                Value lenValue = call(lenMethod, {}, {}, env);
+                Value lenValue = call(*lenMethod, {}, {}, env);
 
                 auto len = static_cast<std::ptrdiff_t>(lenValue.toBigInt());
 
@@ -740,8 +1446,7 @@ void BuiltinFunction::registerBuiltins(const std::shared_ptr<Environment> &env)
                         obj, len
                     )
                 );
-
-            } catch (...) {}
+            }
 
             throw std::runtime_error(
                 "TypeError: '"
@@ -807,7 +1512,7 @@ Value BuiltinFunction::get(const Value::InstancePtr& instance, const Value::Clas
         return Value(shared_from_this());
     }
 
-    return Value(std::make_shared<BoundMethod>(
+    return Value(makePooled<BoundMethod>(
         Value(shared_from_this()),
         Value(instance),
         owner
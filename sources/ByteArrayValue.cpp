@@ -6,9 +6,28 @@
 #include "BytesValue.h"
 #include "IteratorValue.h"
 #include "ListValue.h"
+#include "ObjectPool.h"
 #include "StrValue.h"
 #include "TupleValue.h"
 #include "../runtime/ProtocolHelpers.h"
+#include "../runtime/TextScan.h"
+#include "ByteKernels.h"
+#include "TextCodec.h"
+
+Value ByteArrayValue::getItemInt(Value::SmallInt index) const {
+
+    if (index < 0) {
+        index += data.size();
+    }
+
+    if (index < 0 || index >= data.size()) {
+        throw std::runtime_error(
+            "IndexError: index out of range"
+        );
+    }
+
+    return Value(static_cast<Value::SmallInt>(static_cast<unsigned char>(data[static_cast<qsizetype>(index)])));
+}
 
 Value ByteArrayValue::getItem(const Value& indexValue) const {
 
@@ -32,6 +51,10 @@ Value ByteArrayValue::getItem(const Value& indexValue) const {
         );
     }
 
+    if (const auto small = std::get_if<Value::SmallInt>(&indexValue.data)) {
+        return getItemInt(*small);
+    }
+
     int index = indexValue.asBigInt("__getitem__").convert_to<int>();
 
     if (data.isEmpty()) {
@@ -57,6 +80,33 @@ Value ByteArrayValue::getItem(const Value& indexValue) const {
     );
 }
 
+void ByteArrayValue::setItemInt(Value::SmallInt index, const Value& value) {
+
+    const auto size = data.size();
+
+    if (index < 0) {
+        index += size;
+    }
+
+    if (index < 0 || index >= size) {
+
+        throw std::runtime_error(
+            "IndexError: bytearray index out of range"
+        );
+    }
+
+    const auto byte = value.toBigInt();
+
+    if (byte < 0 || byte > 255) {
+
+        throw std::runtime_error(
+            "ValueError: byte must be in range(0, 256)"
+        );
+    }
+
+    data[static_cast<qsizetype>(index)] = static_cast<char>(byte.convert_to<int>());
+}
+
 void ByteArrayValue::setItem(
     const Value& indexValue,
     const Value& value) {
@@ -68,6 +118,11 @@ void ByteArrayValue::setItem(
         );
     }
 
+    if (const auto small = std::get_if<Value::SmallInt>(&indexValue.data)) {
+        setItemInt(*small, value);
+        return;
+    }
+
     auto index =
         indexValue.toBigInt()
         .convert_to<long long>();
@@ -99,31 +154,42 @@ void ByteArrayValue::setItem(
 
 void ByteArrayValue::delItem(const Value& indexValue) {
 
-    if (indexValue.isSlice()) {
+    ensureResizable();
 
-        const auto sliceObj = indexValue.asSlice();
+    if (indexValue.isSlice()) {
 
-        const auto slice = normalizeSlice(*sliceObj, data.size());
+        const auto slice = normalizeSlice(*indexValue.asSlice(), data.size());
+        const long long count = sliceLength(slice);
 
-        QByteArray result;
+        if (count == 0) {
+            return;
+        }
 
-        std::vector removeMask(data.size(), false);
+        // сплошной диапазон — одно remove(); префикс Qt снимает сдвигом начала данных
+        if (slice.step == 1 || count == 1) {
+            data.remove(slice.start, count);
+            return;
+        }
 
-        iterateSlice(slice,
+        // с шагом: уплотнение на месте одним проходом
+        const long long first = slice.step > 0 ? slice.start : slice.start + (count - 1) * slice.step;
+        const long long step = slice.step > 0 ? slice.step : -slice.step;
+        const long long last = first + (count - 1) * step;
 
-        [&](const long long i) {
-                removeMask[static_cast<std::size_t>(i)] = true;
-            }
-        );
+        char* bytes = data.data();
+        qsizetype write = first;
 
-        for (int i = 0; i < data.size(); ++i) {
+        for (qsizetype read = first; read < data.size(); ++read) {
 
-            if (!removeMask[i]) {
-                result.append(data[i]);
+            if (read <= last && (read - first) % step == 0) {
+                continue;
             }
+
+            bytes[write++] = bytes[read];
         }
 
-        data = std::move(result);
+        data.truncate(write);
+        return;
     }
 
     int index =
@@ -145,6 +211,15 @@ void ByteArrayValue::delItem(const Value& indexValue) {
     data.remove(index, 1);
 }
 
+void ByteArrayValue::ensureResizable() const {
+
+    if (exports > 0) {
+        throw std::runtime_error(
+            "BufferError: Existing exports of data: object cannot be re-sized"
+        );
+    }
+}
+
 std::size_t ByteArrayValue::len() const {
     return data.size();
 }
@@ -253,18 +328,13 @@ Value ByteArrayValue::add(const Value& other) const {
         );
     }
 
-    throw std::runtime_error(
-        "TypeError: can't concat bytearray with non-bytes-like object"
-    );
+    return Value::notImplemented();
 }
 
 Value ByteArrayValue::multiply(const Value& other) const {
 
     if (!other.isBigInt() && !other.isBool()) {
-
-        throw std::runtime_error(
-            "TypeError: can't multiply bytearray by non-int"
-        );
+        return Value::notImplemented();
     }
 
     const auto count =
@@ -295,6 +365,8 @@ Value ByteArrayValue::multiply(const Value& other) const {
 
 Value ByteArrayValue::iadd(const Value& other) {
 
+    ensureResizable();
+
     if (other.isBytes()) {
         data.append(other.asBytes()->bytes());
 
@@ -322,6 +394,8 @@ Value ByteArrayValue::imul(const Value& other) {
         );
     }
 
+    ensureResizable();
+
     const auto count = other.toBigInt();
 
     if (count <= 0) {
@@ -360,17 +434,13 @@ bool ByteArrayValue::contains(const Value& value) const {
     // bytes
     if (value.isBytes()) {
 
-        return data.contains(
-            value.asBytes()->bytes()
-        );
+        return bytekernels::find(data, value.asBytes()->bytes(), 0, data.size()) != -1;
     }
 
     // bytearray
     if (value.isByteArray()) {
 
-        return data.contains(
-            value.asByteArray()->bytes()
-        );
+        return bytekernels::find(data, value.asByteArray()->bytes(), 0, data.size()) != -1;
     }
 
     throw std::runtime_error(
@@ -513,42 +583,16 @@ Value ByteArrayValue::find(
         );
     }
 
-    long long begin = 0;
-    long long finish = data.size();
-
-    if (start.has_value()) {
-        begin = start->toBigInt().convert_to<long long>();
-    }
-
-    if (end.has_value()) {
-        finish = end->toBigInt().convert_to<long long>();
-    }
-
-    if (begin < 0) {
-        begin += data.size();
-    }
-
-    if (finish < 0) {
-        finish += data.size();
-    }
-
-    begin = std::clamp(begin, 0LL, data.size());
-    finish = std::clamp(finish, 0LL, data.size());
+    const qsizetype from = start.has_value()
+        ? start->toBigInt().convert_to<qsizetype>()
+        : 0;
 
-    const QByteArray slice =
-        data.mid(
-            static_cast<int>(begin),
-            static_cast<int>(finish - begin)
-        );
-
-    const int pos = slice.indexOf(needle);
-
-    if (pos == -1) {
-        return Value(Value::BigInt(-1));
-    }
+    const qsizetype to = end.has_value()
+        ? end->toBigInt().convert_to<qsizetype>()
+        : data.size();
 
     return Value(
-        Value::BigInt(begin + pos)
+        Value::BigInt(bytekernels::find(data, needle, from, to))
     );
 }
 
@@ -591,51 +635,16 @@ Value ByteArrayValue::rfind(
         );
     }
 
-    long long begin = 0;
-    long long finish = data.size();
-
-    if (start.has_value()) {
-        begin = start->toBigInt().convert_to<long long>();
-    }
-
-    if (end.has_value()) {
-        finish = end->toBigInt().convert_to<long long>();
-    }
-
-    if (begin < 0) {
-        begin += data.size();
-    }
-
-    if (finish < 0) {
-        finish += data.size();
-    }
-
-    begin = std::clamp(
-        begin,
-        0LL,
-        static_cast<long long>(data.size())
-    );
-
-    finish = std::clamp(
-        finish,
-        0LL,
-        static_cast<long long>(data.size())
-    );
-
-    QByteArray slice =
-        data.mid(
-            static_cast<int>(begin),
-            static_cast<int>(finish - begin)
-        );
-
-    const int pos = slice.lastIndexOf(needle);
+    const qsizetype from = start.has_value()
+        ? start->toBigInt().convert_to<qsizetype>()
+        : 0;
 
-    if (pos == -1) {
-        return Value(Value::BigInt(-1));
-    }
+    const qsizetype to = end.has_value()
+        ? end->toBigInt().convert_to<qsizetype>()
+        : data.size();
 
     return Value(
-        Value::BigInt(begin + pos)
+        Value::BigInt(bytekernels::rfind(data, needle, from, to))
     );
 }
 
@@ -711,69 +720,16 @@ Value ByteArrayValue::count(
         );
     }
 
-    long long begin = 0;
-    long long finish = data.size();
-
-    if (start.has_value()) {
-        begin = start->toBigInt().convert_to<long long>();
-    }
-
-    if (end.has_value()) {
-        finish = end->toBigInt().convert_to<long long>();
-    }
-
-    if (begin < 0) {
-        begin += data.size();
-    }
-
-    if (finish < 0) {
-        finish += data.size();
-    }
-
-    begin = std::clamp(
-        begin,
-        0LL,
-        data.size()
-    );
-
-    finish = std::clamp(
-        finish,
-        0LL,
-        data.size()
-    );
-
-    QByteArray haystack =
-        data.mid(
-            static_cast<int>(begin),
-            static_cast<int>(finish - begin)
-        );
-
-    if (needle.isEmpty()) {
-        return Value(
-            Value::BigInt(
-                haystack.size() + 1
-            )
-        );
-    }
-
-    int occurrences = 0;
-    int pos = 0;
-
-    while (true) {
-
-        pos = haystack.indexOf(needle, pos);
-
-        if (pos == -1) {
-            break;
-        }
+    const qsizetype from = start.has_value()
+        ? start->toBigInt().convert_to<qsizetype>()
+        : 0;
 
-        ++occurrences;
-
-        pos += needle.size();
-    }
+    const qsizetype to = end.has_value()
+        ? end->toBigInt().convert_to<qsizetype>()
+        : data.size();
 
     return Value(
-        Value::BigInt(occurrences)
+        Value::BigInt(bytekernels::count(data, needle, from, to))
     );
 }
 
@@ -1125,88 +1081,39 @@ Value ByteArrayValue::replace(
 
     const long long maxCount = count.convert_to<long long>();
 
-    // special case: old == b""
-    if (oldBytes.isEmpty()) {
-
-        QByteArray result;
-
-        long long inserted = 0;
-
-        auto canInsert =
-            [&]() -> bool {
-
-                return  maxCount < 0 || inserted < maxCount;
-            };
-
-        if (canInsert()) {
-
-            result.append(newBytes);
-            ++inserted;
-        }
-
-        for (const char ch : data) {
+    return Value(
+        std::make_shared<ByteArrayValue>(
+            bytekernels::replace(data, oldBytes, newBytes, maxCount)
+        )
+    );
+}
 
-            result.append(ch);
+Value ByteArrayValue::split(
+    const Value& sep,
+    const Value::BigInt& maxsplit) const {
 
-            if (canInsert()) {
+    const long long limit = maxsplit.convert_to<long long>();
 
-                result.append(newBytes);
-                ++inserted;
-            }
-        }
+    std::vector<Value> result;
 
-        return Value(
+    const auto part = [&](const qsizetype start, const qsizetype length) {
+        result.emplace_back(
             std::make_shared<ByteArrayValue>(
-                result
+                data.mid(start, length)
             )
         );
-    }
+    };
 
-    QByteArray result = data;
+    // split() без разделителя режет по пробельным байтам
+    if (sep.isNone()) {
 
-    if (maxCount == 0) {
+        textscan::splitWhitespace(data, data.size(), limit, textscan::isByteSpace, part);
 
         return Value(
-            std::make_shared<ByteArrayValue>(
-                result
-            )
-        );
-    }
-
-    int pos = 0;
-    long long replaced = 0;
-
-    while ((pos = result.indexOf(oldBytes, pos)) != -1) {
-
-        if (
-            maxCount >= 0
-            && replaced >= maxCount
-        ) {
-            break;
-        }
-
-        result.replace(
-            pos,
-            oldBytes.size(),
-            newBytes
+            makePooled<ListValue>(std::move(result))
         );
-
-        pos += newBytes.size();
-
-        ++replaced;
     }
 
-    return Value(
-        std::make_shared<ByteArrayValue>(
-            result
-        )
-    );
-}
-
-Value ByteArrayValue::split(
-    const Value& sep,
-    const Value::BigInt& maxsplit) const {
-
     QByteArray separator;
 
     if (sep.isBytes()) {
@@ -1231,11 +1138,7 @@ Value ByteArrayValue::split(
         );
     }
 
-    std::vector<Value> result;
-
-    const long long limit = maxsplit.convert_to<long long>();
-
-    int start = 0;
+    qsizetype start = 0;
 
     long long splits = 0;
 
@@ -1248,7 +1151,7 @@ Value ByteArrayValue::split(
             break;
         }
 
-        const int pos = data.indexOf(separator, start);
+        const qsizetype pos = bytekernels::find(data, separator, start, data.size());
 
         if (pos < 0) {
             break;
@@ -1272,7 +1175,7 @@ Value ByteArrayValue::split(
     );
 
     return Value(
-        std::make_shared<ListValue>(result)
+        makePooled<ListValue>(result)
     );
 }
 
@@ -1280,6 +1183,30 @@ Value ByteArrayValue::rsplit(
     const Value& sep,
     const Value::BigInt& maxsplit) const {
 
+    const long long limit =
+        maxsplit.convert_to<long long>();
+
+    if (sep.isNone()) {
+
+        // куски приходят справа налево
+        std::vector<Value> parts;
+
+        textscan::rsplitWhitespace(data, data.size(), limit, textscan::isByteSpace,
+            [&](const qsizetype start, const qsizetype length) {
+                parts.emplace_back(
+                    std::make_shared<ByteArrayValue>(
+                        data.mid(start, length)
+                    )
+                );
+            });
+
+        std::reverse(parts.begin(), parts.end());
+
+        return Value(
+            makePooled<ListValue>(std::move(parts))
+        );
+    }
+
     QByteArray separator;
 
     if (sep.isBytes()) {
@@ -1304,12 +1231,9 @@ Value ByteArrayValue::rsplit(
         );
     }
 
-    const long long limit =
-        maxsplit.convert_to<long long>();
-
     std::vector<Value> parts;
 
-    QByteArray remaining = data;
+    qsizetype end = data.size();
 
     long long splits = 0;
 
@@ -1322,8 +1246,12 @@ Value ByteArrayValue::rsplit(
             break;
         }
 
-        const int pos =
-            remaining.lastIndexOf(separator);
+        if (end < separator.size()) {
+            break;
+        }
+
+        const qsizetype pos =
+            bytekernels::rfind(data, separator, 0, end);
 
         if (pos < 0) {
             break;
@@ -1331,21 +1259,21 @@ Value ByteArrayValue::rsplit(
 
         parts.emplace_back(
             std::make_shared<ByteArrayValue>(
-                remaining.mid(
-                    pos + separator.size()
+                data.mid(
+                    pos + separator.size(),
+                    end - pos - separator.size()
                 )
             )
         );
 
-        remaining =
-            remaining.left(pos);
+        end = pos;
 
         ++splits;
     }
 
     parts.emplace_back(
         std::make_shared<ByteArrayValue>(
-            remaining
+            data.left(end)
         )
     );
 
@@ -1355,7 +1283,7 @@ Value ByteArrayValue::rsplit(
     );
 
     return Value(
-        std::make_shared<ListValue>(
+        makePooled<ListValue>(
             parts
         )
     );
@@ -1393,7 +1321,7 @@ Value ByteArrayValue::partition(
     if (pos < 0) {
 
         return Value(
-            std::make_shared<TupleValue>(
+            makePooled<TupleValue>(
                 std::vector{
                     Value(
                         std::make_shared<ByteArrayValue>(data)
@@ -1414,7 +1342,7 @@ Value ByteArrayValue::partition(
     }
 
     return Value(
-        std::make_shared<TupleValue>(
+        makePooled<TupleValue>(
             std::vector{
 
                 Value(
@@ -1476,7 +1404,7 @@ Value ByteArrayValue::rpartition(
     if (pos < 0) {
 
         return Value(
-            std::make_shared<TupleValue>(
+            makePooled<TupleValue>(
                 std::vector<Value>{
 
                     Value(
@@ -1502,7 +1430,7 @@ Value ByteArrayValue::rpartition(
     }
 
     return Value(
-        std::make_shared<TupleValue>(
+        makePooled<TupleValue>(
             std::vector<Value>{
 
                 Value(
@@ -2018,85 +1946,22 @@ Value ByteArrayValue::isAscii() const {
 
 Value ByteArrayValue::isAlpha() const {
 
-    if (data.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const unsigned char c : data) {
-
-        const bool isAlpha =
-            (c >= 'a' && c <= 'z') ||
-            (c >= 'A' && c <= 'Z');
-
-        if (!isAlpha) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(bytekernels::allOf(data, bytekernels::Alpha));
 }
 
 Value ByteArrayValue::isDigit() const {
 
-    if (data.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const unsigned char c : data) {
-
-        if (!(c >= '0' && c <= '9')) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(bytekernels::allOf(data, bytekernels::Digit));
 }
 
 Value ByteArrayValue::isAlnum() const {
 
-    if (data.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const unsigned char c : data) {
-
-        const bool isAlpha =
-            (c >= 'a' && c <= 'z') ||
-            (c >= 'A' && c <= 'Z');
-
-        const bool isDigit =
-            (c >= '0' && c <= '9');
-
-        if (!(isAlpha || isDigit)) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(bytekernels::allOf(data, bytekernels::Alnum));
 }
 
 Value ByteArrayValue::isSpace() const {
 
-    if (data.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const unsigned char c : data) {
-
-        const bool isSpace =
-            c == ' '  ||
-            c == '\t' ||
-            c == '\n' ||
-            c == '\r' ||
-            c == '\v' ||
-            c == '\f';
-
-        if (!isSpace) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(bytekernels::allOf(data, bytekernels::Space));
 }
 
 Value ByteArrayValue::expandTabs(
@@ -2159,59 +2024,20 @@ Value ByteArrayValue::splitLines(
 
     std::vector<Value> result;
 
-    int start = 0;
-    int i = 0;
-
-    while (i < data.size()) {
-
-        int lineBreakLen = 0;
-
-        if (data[i] == '\n' ||
-            data[i] == '\r') {
-
-            lineBreakLen = 1;
-
-            if (data[i] == '\r' &&
-                i + 1 < data.size() &&
-                data[i + 1] == '\n') {
-
-                lineBreakLen = 2;
-            }
-        }
-
-        if (lineBreakLen > 0) {
-
-            const int end =
-                keepEnds
-                ? i + lineBreakLen
-                : i;
+    const qsizetype size = data.size();
 
+    textscan::splitLines(size, keepEnds,
+        [&](const qsizetype i) { return textscan::byteLineBreak(data, size, i); },
+        [&](const qsizetype start, const qsizetype length) {
             result.emplace_back(
                 std::make_shared<ByteArrayValue>(
-                    data.mid(start, end - start)
+                    data.mid(start, length)
                 )
             );
-
-            i += lineBreakLen;
-            start = i;
-
-            continue;
-        }
-
-        ++i;
-    }
-
-    if (start < data.size()) {
-
-        result.emplace_back(
-            std::make_shared<ByteArrayValue>(
-                data.mid(start)
-            )
-        );
-    }
+        });
 
     return Value(
-        std::make_shared<ListValue>(
+        makePooled<ListValue>(
             result
         )
     );
@@ -2220,74 +2046,12 @@ Value ByteArrayValue::splitLines(
 Value ByteArrayValue::join(
     const Value& iterable) const {
 
-    std::vector<QByteArray> chunks;
-
-    auto appendChunk =
-        [&chunks](const Value& value) {
-
-            if (value.isByteArray()) {
-
-                chunks.push_back(
-                    value.asByteArray("join")->bytes()
-                );
-
-                return;
-            }
-
-            if (value.isBytes()) {
-
-                chunks.push_back(
-                    value.asBytes("join")->bytes()
-                );
-
-                return;
-            }
-
-            throw std::runtime_error(
-                "TypeError: sequence item "
-                "must be bytes-like"
-            );
-    };
-
-    if (iterable.isIterable() || supportsIter(iterable)) {
-
-        Value iterMethod = getAttrValue(iterable, "__iter__");
-
-        Value iterObj = call(iterMethod, {}, {}, nullptr);
-
-        if (!std::holds_alternative<Value::IteratorPtr>(iterObj.data)) {
-            throw std::runtime_error(
-                "__iter__ returned non-iterator"
-            );
-        }
-
-        auto iterator = std::get<Value::IteratorPtr>(iterObj.data);
-
-        while (iterator->hasNext()) {
-            appendChunk(iterator->next());
-        }
-
-    } else {
-
-        throw std::runtime_error(
-            "TypeError: object is not iterable"
-        );
-    }
-
-    QByteArray result;
-
-    for (size_t i = 0; i < chunks.size(); ++i) {
-
-        if (i > 0) {
-            result += data;
-        }
-
-        result += chunks[i];
-    }
+    std::vector<Value> storage;
+    const std::vector<Value>& items = sequenceItems(iterable, storage);
 
     return Value(
         std::make_shared<ByteArrayValue>(
-            std::move(result)
+            bytekernels::join(data, BytesValue::joinPieces(items))
         )
     );
 }
@@ -2303,6 +2067,8 @@ Value ByteArrayValue::append(const Value& value) {
         );
     }
 
+    ensureResizable();
+
     data.append(
         static_cast<char>(
             byte.convert_to<int>()
@@ -2321,38 +2087,8 @@ Value ByteArrayValue::extend(const Value& iterable) {
         );
     }
 
-    Value iterMethod = getAttrValue(iterable, "__iter__");
-
-    Value iterObj = call(iterMethod, {}, {}, nullptr);
-
-    if (!std::holds_alternative<Value::IteratorPtr>(iterObj.data)) {
-
-        throw std::runtime_error(
-            "__iter__ returned non-iterator"
-        );
-    }
-
-    auto iterator =std::get<Value::IteratorPtr>(iterObj.data);
-
-    while (iterator->hasNext()) {
-
-        Value item = iterator->next();
-
-        auto byte = item.toBigInt();
-
-        if (byte < 0 || byte > 255) {
-
-            throw std::runtime_error(
-                "ValueError: byte must be in range(0, 256)"
-            );
-        }
-
-        data.append(
-            static_cast<char>(
-                byte.convert_to<int>()
-            )
-        );
-    }
+    ensureResizable();
+    appendBytesFrom(data, iterable);
 
     return {};
 }
@@ -2384,6 +2120,8 @@ Value ByteArrayValue::insert(const Value::BigInt& indexValue, const Value& value
         index = size;
     }
 
+    ensureResizable();
+
     data.insert(
         index,
         static_cast<char>(
@@ -2432,6 +2170,8 @@ Value ByteArrayValue::pop(const std::optional<Value::BigInt>& indexValue) {
             data[index]
         );
 
+    ensureResizable();
+
     data.remove(index, 1);
 
     return Value(Value::BigInt(result));
@@ -2462,6 +2202,8 @@ Value ByteArrayValue::remove(const Value& value) {
         );
     }
 
+    ensureResizable();
+
     data.remove(index, 1);
 
     return {};
@@ -2469,6 +2211,8 @@ Value ByteArrayValue::remove(const Value& value) {
 
 Value ByteArrayValue::clear() {
 
+    ensureResizable();
+
     data.clear();
 
     return {};
@@ -2490,139 +2234,15 @@ Value ByteArrayValue::reverse() {
     return {};
 }
 
-Value ByteArrayValue::hex(
-    const std::optional<QString>& sep,
-    const std::optional<Value::BigInt>& bytesPerSep) const {
-
-    if (!sep.has_value()) {
-
-        QString result;
-
-        result.reserve(
-            data.size() * 2
-        );
-
-        for (unsigned char byte : data) {
-
-            result += QString("%1")
-                .arg(
-                    static_cast<int>(byte),
-                    2,
-                    16,
-                    QLatin1Char('0')
-                );
-        }
-
-        return Value(result);
-    }
-
-    const QString separator = *sep;
-
-    const long long groupSize =
-        bytesPerSep.has_value()
-        ? bytesPerSep->convert_to<long long>()
-        : 1;
-
-    if (groupSize == 0) {
-
-        throw std::runtime_error(
-            "ValueError: bytes_per_sep must not be zero"
-        );
-    }
-
-    QString result;
-
-    const bool fromRight =
-        groupSize > 0;
-
-    const long long absGroup =
-        std::llabs(groupSize);
-
-    for (int i = 0; i < data.size(); ++i) {
-
-        if (i > 0) {
-
-            bool insertSep = false;
-
-            if (fromRight) {
-
-                const int remaining = data.size() - i;
-
-                insertSep = remaining % absGroup == 0;
-
-            } else {
-
-                insertSep = i % absGroup == 0;
-            }
-
-            if (insertSep) {
-                result += separator;
-            }
-        }
-
-        result += QString("%1")
-            .arg(
-                static_cast<unsigned char>(data[i]),
-                2,
-                16,
-                QLatin1Char('0')
-            );
-    }
-
-    return Value(result);
+Value ByteArrayValue::hex(const std::vector<Value>& args) const {
+    return BytesValue::hexOf(data, args);
 }
 
 Value ByteArrayValue::fromHex(const std::vector<Value> &args) {
 
-    QString text = args[0]
-                .asString("fromhex")
-                ->toString();
-
-    QByteArray cleaned;
-
-    for (QChar ch : text) {
-
-        if (!ch.isSpace()) {
-            cleaned.append(
-                ch.toLatin1()
-            );
-        }
-    }
-
-    if (cleaned.size() % 2 != 0) {
-
-        throw std::runtime_error(
-            "ValueError: non-hexadecimal "
-            "number found in fromhex() arg"
-        );
-    }
-
-    QByteArray result;
-
-    for (int i = 0; i < cleaned.size(); i += 2) {
-
-        bool ok = false;
-
-        const QByteArray pair = cleaned.mid(i, 2);
-
-        const int value = pair.toInt(&ok, 16);
-
-        if (!ok) {
-
-            throw std::runtime_error(
-                "ValueError: non-hexadecimal "
-                "number found in fromhex() arg"
-            );
-        }
-
-        result.append(
-            static_cast<char>(value)
-        );
-    }
-
     return Value(
         std::make_shared<ByteArrayValue>(
-            std::move(result)
+            BytesValue::parseHex(args[0].asString("fromhex")->view())
         )
     );
 }
@@ -2631,192 +2251,20 @@ Value ByteArrayValue::decode(
     const QString& encoding,
     const QString& errors) const {
 
-    const QString normalized = encoding.toLower();
-
-    if (normalized != "utf8" && normalized != "utf-8") {
-
-        throw std::runtime_error(
-            QString(
-                "LookupError: unknown encoding: %1"
-            ).arg(encoding).toStdString()
-        );
-    }
-
-    if (errors != "strict") {
-
-        throw std::runtime_error(
-            QString(
-                "LookupError: unknown error handler name '%1'"
-            ).arg(errors).toStdString()
-        );
-    }
-
-    const QString decoded = QString::fromUtf8(data);
-
-    if (decoded.toUtf8() != data) {
-
-        throw std::runtime_error(
-            "UnicodeDecodeError"
-        );
-    }
-
-    return Value(decoded);
+    return Value(textcodec::decode(data, textcodec::codecOf(encoding), textcodec::errorsOf(errors)));
 }
 
 Value ByteArrayValue::makeTrans(const std::vector<Value> &args) {
-
-    QByteArray from;
-    QByteArray to;
-
-    if (args[0].isBytes()) {
-        from = args[0]
-                .asBytes("maketrans")
-                ->bytes();
-
-    } else if (args[0].isByteArray()) {
-        from = args[0]
-                .asByteArray("maketrans")
-                ->bytes();
-
-    } else {
-        throw std::runtime_error(
-            "TypeError: first argument "
-            "must be bytes-like"
-        );
-    }
-
-    if (args[1].isBytes()) {
-        to = args[1]
-                .asBytes("maketrans")
-                ->bytes();
-
-    } else if (
-        args[1].isByteArray()) {
-        to = args[1]
-                .asByteArray("maketrans")
-                ->bytes();
-
-    } else {
-        throw std::runtime_error(
-            "TypeError: second argument "
-            "must be bytes-like"
-        );
-    }
-
-    if (from.size() != to.size()) {
-        throw std::runtime_error(
-            "ValueError: arguments "
-            "must have same length"
-        );
-    }
-
-    QByteArray table(256, '\0');
-
-    for (int i = 0; i < 256; ++i) {
-        table[i] = static_cast<char>(i);
-    }
-
-    for (int i = 0; i < from.size(); ++i) {
-        table[
-            static_cast<
-                unsigned char>(from[i])
-        ] = to[i];
-    }
-
-    return Value(
-        std::make_shared<BytesValue>(table)
-    );
+    return BytesValue::maketrans(args);
 }
 
 Value ByteArrayValue::translate(
     const std::optional<Value>& table,
     const std::optional<Value>& deleteBytes) const {
 
-    QByteArray deletionSet;
-
-    if (deleteBytes.has_value()) {
-
-        if (const Value& del = *deleteBytes;
-            del.isBytes()) {
-
-            deletionSet = del.asBytes("translate")->bytes();
-
-        } else if (del.isByteArray()) {
-
-            deletionSet = del.asByteArray("translate")->bytes();
-
-        } else {
-
-            throw std::runtime_error(
-                "TypeError: delete argument "
-                "must be bytes-like"
-            );
-        }
-    }
-
-    QByteArray translationTable;
-
-    bool useTranslation = table.has_value();
-
-    if (useTranslation) {
-
-        if (const Value& tbl = *table;
-            tbl.isNone()) {
-
-            useTranslation = false;
-
-        } else if (tbl.isBytes()) {
-
-            translationTable = tbl.asBytes("translate")->bytes();
-
-        } else if (tbl.isByteArray()) {
-
-            translationTable = tbl.asByteArray("translate")->bytes();
-
-        } else {
-
-            throw std::runtime_error(
-                "TypeError: translation table "
-                "must be bytes-like"
-            );
-        }
-
-        if (useTranslation && translationTable.size() != 256) {
-
-            throw std::runtime_error(
-                "ValueError: translation table "
-                "must be 256 bytes long"
-            );
-        }
-    }
-
-    QByteArray result;
-
-    for (const unsigned char byte : data) {
-
-        if (
-            deletionSet.contains(
-                static_cast<char>(byte)
-            )
-        ) {
-            continue;
-        }
-
-        if (useTranslation) {
-
-            result.append(translationTable[byte]);
-
-        } else {
-
-            result.append(
-                static_cast<char>(byte)
-            );
-        }
-    }
-
     return Value(
         std::make_shared<ByteArrayValue>(
-            std::move(result)
+            BytesValue::translateOf(data, table.value_or(Value()), deleteBytes)
         )
     );
 }
@@ -2837,6 +2285,8 @@ Value ByteArrayValue::resize(const Value& newSizeValue) {
         );
     }
 
+    ensureResizable();
+
     const qsizetype oldSize = data.size();
     const qsizetype size = static_cast<qsizetype>(newSize);
 
@@ -2874,9 +2324,6 @@ Value ByteArrayValue::mod(const Value& other) const {
 
 Value ByteArrayValue::rmod(const Value& other) const {
 
-    return other % Value(
-        std::const_pointer_cast<ByteArrayValue>(
-            shared_from_this()
-        )
-    );
+    // форматирование `x % bytearray` выполняет mod левого операнда, отражённой формы нет
+    return Value::notImplemented();
 }
@@ -0,0 +1,247 @@
+//
+// Created by semyo on 14.10.2026.
+//
+#include "ByteKernels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "SearchKernels.h"
+
+namespace bytekernels {
+
+    namespace {
+
+        constexpr std::array<std::uint8_t, 256> buildClassTable() {
+
+            std::array<std::uint8_t, 256> table{};
+
+            for (int c = 'a'; c <= 'z'; ++c) {
+                table[c] = Lower;
+            }
+
+            for (int c = 'A'; c <= 'Z'; ++c) {
+                table[c] = Upper;
+            }
+
+            for (int c = '0'; c <= '9'; ++c) {
+                table[c] = Digit;
+            }
+
+            for (const int c : {' ', '\t', '\n', '\r', '\v', '\f'}) {
+                table[c] = Space;
+            }
+
+            return table;
+        }
+
+        /// индексы среза Python: отрицательные отсчитываются от конца; false — диапазон пуст
+        bool clampRange(const QByteArray& data, qsizetype& from, qsizetype& to) {
+
+            const qsizetype size = data.size();
+
+            if (from < 0) {
+                from = std::max<qsizetype>(from + size, 0);
+            }
+
+            if (to < 0) {
+                to = std::max<qsizetype>(to + size, 0);
+            }
+
+            to = std::min(to, size);
+
+            // from за концом буфера не сдвигается: find(b'', 5) у b'abc' ничего не находит
+            return from <= to;
+        }
+    }
+
+    const std::array<std::uint8_t, 256> classTable = buildClassTable();
+
+    bool allOf(const QByteArray& data, const std::uint8_t mask) {
+
+        if (data.isEmpty()) {
+            return false;
+        }
+
+        return std::all_of(data.cbegin(), data.cend(),
+            [mask](const char byte) { return is(byte, mask); });
+    }
+
+    qsizetype find(const QByteArray& data, const QByteArray& needle, qsizetype from, qsizetype to) {
+
+        if (!clampRange(data, from, to)) {
+            return -1;
+        }
+
+        return searchkernels::Pattern<char>(needle.constData(), needle.size()).find(data.constData(), to, from);
+    }
+
+    qsizetype rfind(const QByteArray& data, const QByteArray& needle, qsizetype from, qsizetype to) {
+
+        if (!clampRange(data, from, to)) {
+            return -1;
+        }
+
+        const qsizetype found =
+            searchkernels::Pattern<char>(needle.constData(), needle.size()).rfind(data.constData() + from, to - from);
+
+        return found == -1 ? -1 : from + found;
+    }
+
+    qsizetype count(const QByteArray& data, const QByteArray& needle, qsizetype from, qsizetype to) {
+
+        if (!clampRange(data, from, to)) {
+            return 0;
+        }
+
+        if (needle.isEmpty()) {
+            return to - from + 1;
+        }
+
+        const searchkernels::Pattern<char> pattern(needle.constData(), needle.size());
+
+        qsizetype occurrences = 0;
+
+        for (qsizetype pos = from; (pos = pattern.find(data.constData(), to, pos)) != -1; pos += needle.size()) {
+            ++occurrences;
+        }
+
+        return occurrences;
+    }
+
+    QByteArray replace(const QByteArray& data, const QByteArray& before, const QByteArray& after, const long long limit) {
+
+        const char* base = data.constData();
+
+        // позиции вхождений собираются заранее, чтобы выделить результат один раз
+        const std::vector<qsizetype> positions =
+            searchkernels::Pattern<char>(before.constData(), before.size()).findAll(base, data.size(), limit);
+
+        if (positions.empty()) {
+            return data;
+        }
+
+        QByteArray result;
+        result.reserve(data.size() + static_cast<qsizetype>(positions.size()) * (after.size() - before.size()));
+
+        qsizetype copied = 0;
+
+        for (const qsizetype pos : positions) {
+            result.append(base + copied, pos - copied);
+            result.append(after);
+            copied = pos + before.size();
+        }
+
+        result.append(base + copied, data.size() - copied);
+
+        return result;
+    }
+
+    QByteArray makeTranslation(const QByteArrayView from, const QByteArrayView to) {
+
+        QByteArray table(256, Qt::Uninitialized);
+        auto* out = reinterpret_cast<unsigned char*>(table.data());
+
+        for (int i = 0; i < 256; ++i) {
+            out[i] = static_cast<unsigned char>(i);
+        }
+
+        for (qsizetype i = 0; i < from.size(); ++i) {
+            out[static_cast<unsigned char>(from[i])] = static_cast<unsigned char>(to[i]);
+        }
+
+        return table;
+    }
+
+    QByteArray translate(const QByteArray& data, const QByteArrayView table, const QByteArrayView deleted) {
+
+        static const QByteArray identity = makeTranslation({}, {});
+
+        const qsizetype size = data.size();
+        const auto* src = reinterpret_cast<const unsigned char*>(data.constData());
+        const auto* mapping = reinterpret_cast<const unsigned char*>(
+            table.isEmpty() ? identity.constData() : table.data());
+
+        if (deleted.isEmpty()) {
+
+            if (table.isEmpty() || std::memcmp(mapping, identity.constData(), 256) == 0) {
+                return data;
+            }
+
+            QByteArray result(size, Qt::Uninitialized);
+            auto* out = reinterpret_cast<unsigned char*>(result.data());
+
+            qsizetype i = 0;
+
+            for (; i + 8 <= size; i += 8) {
+                out[i] = mapping[src[i]];
+                out[i + 1] = mapping[src[i + 1]];
+                out[i + 2] = mapping[src[i + 2]];
+                out[i + 3] = mapping[src[i + 3]];
+                out[i + 4] = mapping[src[i + 4]];
+                out[i + 5] = mapping[src[i + 5]];
+                out[i + 6] = mapping[src[i + 6]];
+                out[i + 7] = mapping[src[i + 7]];
+            }
+
+            for (; i < size; ++i) {
+                out[i] = mapping[src[i]];
+            }
+
+            return result;
+        }
+
+        std::array<std::uint64_t, 4> drop{};
+
+        for (const char byte : deleted) {
+            const auto index = static_cast<unsigned char>(byte);
+            drop[index >> 6] |= std::uint64_t(1) << (index & 63);
+        }
+
+        QByteArray result(size, Qt::Uninitialized);
+        auto* out = reinterpret_cast<unsigned char*>(result.data());
+        qsizetype written = 0;
+
+        for (qsizetype i = 0; i < size; ++i) {
+            const unsigned char byte = src[i];
+            out[written] = mapping[byte];
+            written += static_cast<qsizetype>(~drop[byte >> 6] >> (byte & 63) & 1);
+        }
+
+        result.truncate(written);
+
+        return result;
+    }
+
+    QByteArray join(const QByteArray& separator, const std::vector<QByteArrayView>& pieces) {
+
+        if (pieces.empty()) {
+            return {};
+        }
+
+        qsizetype total = separator.size() * static_cast<qsizetype>(pieces.size() - 1);
+
+        for (const QByteArrayView piece : pieces) {
+            total += piece.size();
+        }
+
+        QByteArray result(total, Qt::Uninitialized);
+        char* out = result.data();
+
+        for (std::size_t i = 0; i < pieces.size(); ++i) {
+
+            if (i > 0 && !separator.isEmpty()) {
+                std::memcpy(out, separator.constData(), static_cast<std::size_t>(separator.size()));
+                out += separator.size();
+            }
+
+            if (!pieces[i].isEmpty()) {
+                std::memcpy(out, pieces[i].data(), static_cast<std::size_t>(pieces[i].size()));
+                out += pieces[i].size();
+            }
+        }
+
+        return result;
+    }
+}
@@ -5,15 +5,22 @@
 
 #include "IteratorValue.h"
 #include "ListValue.h"
+#include "ObjectPool.h"
 #include "StrValue.h"
 #include "TupleValue.h"
 
 #include <iomanip>
 #include <sstream>
 
+#include "BigIntText.h"
 #include "ByteArrayValue.h"
 #include "DictValue.h"
 #include "../runtime/ProtocolHelpers.h"
+#include "../runtime/TextScan.h"
+#include "ByteKernels.h"
+#include "CodecKernels.h"
+#include "HashKernels.h"
+#include "TextCodec.h"
 
 QString BytesValue::repr() const {
 
@@ -103,6 +110,18 @@ static void normalizeSliceIndices(int& start, int& end, const int size) {
     }
 }
 
+// индексы среза как есть: ядра bytekernels сами отсчитывают отрицательные от конца
+static std::pair<qsizetype, qsizetype> searchBounds(
+    const QByteArray& data,
+    const std::optional<Value>& start,
+    const std::optional<Value>& end) {
+
+    return {
+        start.has_value() ? static_cast<qsizetype>(start->toBigInt()) : 0,
+        end.has_value() ? static_cast<qsizetype>(end->toBigInt()) : data.size()
+    };
+}
+
 static std::pair<int, int> getSliceBounds(
     const QByteArray& data,
     const std::optional<Value>& start,
@@ -143,11 +162,19 @@ static bool isAsciiWhitespace(const unsigned char c) {
     }
 }
 
-static bool isAsciiAlpha(unsigned char ch) {
+Value BytesValue::getItemInt(Value::SmallInt index) const {
 
-    return
-        (ch >= 'a' && ch <= 'z') ||
-        (ch >= 'A' && ch <= 'Z');
+    if (index < 0) {
+        index += data.size();
+    }
+
+    if (index < 0 || index >= data.size()) {
+        throw std::runtime_error(
+            "IndexError: index out of range"
+        );
+    }
+
+    return Value(static_cast<Value::SmallInt>(static_cast<unsigned char>(data[static_cast<qsizetype>(index)])));
 }
 
 Value BytesValue::getItem(const Value& indexValue) const {
@@ -172,6 +199,10 @@ Value BytesValue::getItem(const Value& indexValue) const {
         );
     }
 
+    if (const auto small = std::get_if<Value::SmallInt>(&indexValue.data)) {
+        return getItemInt(*small);
+    }
+
     int index = indexValue.asBigInt("__getitem__").convert_to<int>();
 
     if (data.isEmpty()) {
@@ -204,9 +235,7 @@ std::size_t BytesValue::len() const {
 Value BytesValue::add(const Value& other) const {
 
     if (!other.isBytes()) {
-        throw std::runtime_error(
-            "TypeError: can't concat bytes to non-bytes"
-        );
+        return Value::notImplemented();
     }
 
     QByteArray result = data;
@@ -222,9 +251,7 @@ Value BytesValue::add(const Value& other) const {
 Value BytesValue::multiply(const Value &other) const {
 
     if (!other.isNumeric() || other.isBigFloat()) {
-        throw std::runtime_error(
-            "TypeError: can't multiply sequence by non-int"
-        );
+        return Value::notImplemented();
     }
 
     const Value::BigInt count = other.toBigInt();
@@ -326,9 +353,7 @@ bool BytesValue::contains(const Value& other) const {
 
     if (other.isBytes()) {
 
-        return data.contains(
-            other.asBytes()->bytes()
-        );
+        return bytekernels::find(data, other.asBytes()->bytes(), 0, data.size()) != -1;
     }
 
     throw std::runtime_error(
@@ -345,19 +370,11 @@ Value BytesValue::find(
         throw std::runtime_error("find() argument must be bytes");
     }
 
-    auto [startIdx, endIdx] = getSliceBounds(data, start, end);
-
-    const auto& needle = sub.asBytes()->bytes();
+    const auto [from, to] = searchBounds(data, start, end);
 
-    const QByteArray slice = data.mid(startIdx, endIdx - startIdx);
-
-    const int pos = slice.indexOf(needle);
-
-    if (pos == -1) {
-        return Value(Value::BigInt(-1));
-    }
-
-    return Value(Value::BigInt(pos + startIdx));
+    return Value(Value::BigInt(
+        bytekernels::find(data, sub.asBytes()->bytes(), from, to)
+    ));
 }
 
 Value BytesValue::rfind(
@@ -371,47 +388,11 @@ Value BytesValue::rfind(
         );
     }
 
-    int startIdx = 0;
-    int endIdx = data.size();
+    const auto [from, to] = searchBounds(data, start, end);
 
-    if (start.has_value()) {
-        startIdx =
-            static_cast<int>(
-                start->toBigInt()
-            );
-    }
-
-    if (end.has_value()) {
-        endIdx =
-            static_cast<int>(
-                end->toBigInt()
-            );
-    }
-
-    normalizeSliceIndices(startIdx, endIdx, data.size());
-
-    const QByteArray needle = sub.asBytes()->bytes();
-
-    const QByteArray haystack =
-        data.mid(
-            startIdx,
-            endIdx - startIdx
-        );
-
-    const int pos = haystack.lastIndexOf(needle);
-
-    if (pos == -1) {
-
-        return Value(
-            Value::BigInt(-1)
-        );
-    }
-
-    return Value(
-        Value::BigInt(
-            pos + startIdx
-        )
-    );
+    return Value(Value::BigInt(
+        bytekernels::rfind(data, sub.asBytes()->bytes(), from, to)
+    ));
 }
 
 Value BytesValue::index(
@@ -454,37 +435,11 @@ Value BytesValue::count(
         throw std::runtime_error("count() argument must be bytes");
     }
 
-    auto [startIdx, endIdx] = getSliceBounds(data, start, end);
-
-    const QByteArray haystack = data.mid(startIdx, endIdx - startIdx);
-
-    const QByteArray needle = sub.asBytes()->bytes();
-
-
-    if (needle.isEmpty()) {
-        return Value(
-            Value::BigInt(haystack.size() + 1)
-        );
-    }
-
-    int count = 0;
-    int pos = 0;
-
-    while (true) {
-
-        pos = haystack.indexOf(needle, pos);
-
-        if (pos == -1) {
-            break;
-        }
-
-        ++count;
-
-        // неперекрывающиеся вхождения
-        pos += needle.size();
-    }
+    const auto [from, to] = searchBounds(data, start, end);
 
-    return Value(Value::BigInt(count));
+    return Value(Value::BigInt(
+        bytekernels::count(data, sub.asBytes()->bytes(), from, to)
+    ));
 }
 
 Value BytesValue::startsWith(
@@ -529,49 +484,22 @@ Value BytesValue::split(
 
     std::vector<Value> result;
 
-    if (!sep.has_value()) {
-
-        qsizetype i = 0;
-        Value::BigInt splits = 0;
-
-        while (i < data.size()) {
-
-            while (i < data.size() && isAsciiWhitespace(data[i])) {
-                ++i;
-            }
-
-            if (i >= data.size()) {
-                break;
-            }
-
-            if (maxsplit >= 0 && splits >= maxsplit) {
-
-                result.emplace_back(
-                    std::make_shared<BytesValue>(
-                        data.mid(i)
-                    )
-                );
-
-                break;
-            }
+    const long long limit = maxsplit.convert_to<long long>();
 
-            const qsizetype start = i;
-
-            while (i < data.size() && !isAsciiWhitespace(data[i])) {
-                ++i;
-            }
+    const auto part = [&](const qsizetype start, const qsizetype length) {
+        result.emplace_back(
+            std::make_shared<BytesValue>(
+                data.mid(start, length)
+            )
+        );
+    };
 
-            result.emplace_back(
-                std::make_shared<BytesValue>(
-                    data.mid(start, i - start)
-                )
-            );
+    if (!sep.has_value()) {
 
-            ++splits;
-        }
+        textscan::splitWhitespace(data, data.size(), limit, textscan::isByteSpace, part);
 
         return Value(
-            std::make_shared<ListValue>(
+            makePooled<ListValue>(
                 std::move(result)
             )
         );
@@ -590,15 +518,15 @@ Value BytesValue::split(
     }
 
     qsizetype start = 0;
-    Value::BigInt splits = 0;
+    long long splits = 0;
 
     while (true) {
 
-        if (maxsplit >= 0 && splits >= maxsplit) {
+        if (limit >= 0 && splits >= limit) {
             break;
         }
 
-        const qsizetype pos = data.indexOf(delimiter, start);
+        const qsizetype pos = bytekernels::find(data, delimiter, start, data.size());
 
         if (pos == -1) {
             break;
@@ -622,7 +550,7 @@ Value BytesValue::split(
     );
 
     return Value(
-        std::make_shared<ListValue>(
+        makePooled<ListValue>(
             std::move(result)
         )
     );
@@ -631,86 +559,26 @@ Value BytesValue::split(
 
 Value BytesValue::rsplit(const std::optional<Value> &sep, const Value::BigInt &maxsplit) const {
 
-    if (!sep.has_value()) {
-
-        std::vector<QByteArray> parts;
-
-        qsizetype i = data.size() - 1;
-        Value::BigInt splits = 0;
-
-        while (i >= 0) {
-
-            while (
-                i >= 0 &&
-                isAsciiWhitespace(
-                    static_cast<unsigned char>(data[i])
-                )
-            ) {
-                --i;
-            }
-
-            if (i < 0) {
-                break;
-            }
-
-            const qsizetype end = i + 1;
-
-            while (
-                i >= 0 &&
-                !isAsciiWhitespace(
-                    static_cast<unsigned char>(data[i])
-                )
-            ) {
-                --i;
-            }
-
-            const qsizetype start = i + 1;
-
-            parts.push_back(
-                data.mid(start, end - start)
-            );
+    const long long limit = maxsplit.convert_to<long long>();
 
-            ++splits;
+    if (!sep.has_value()) {
 
-            if (
-                maxsplit >= 0 &&
-                splits >= maxsplit
-            ) {
+        // куски приходят справа налево
+        std::vector<Value> result;
 
-                while (
-                    i >= 0 &&
-                    isAsciiWhitespace(
-                        static_cast<unsigned char>(data[i])
+        textscan::rsplitWhitespace(data, data.size(), limit, textscan::isByteSpace,
+            [&](const qsizetype start, const qsizetype length) {
+                result.emplace_back(
+                    std::make_shared<BytesValue>(
+                        data.mid(start, length)
                     )
-                ) {
-                    --i;
-                }
-
-                if (i >= 0) {
-                    parts.push_back(
-                        data.left(i + 1)
-                    );
-                }
-
-                break;
-            }
-        }
-
-        std::reverse(parts.begin(), parts.end());
-
-        std::vector<Value> result;
+                );
+            });
 
-        for (const auto& part : parts) {
-
-            result.emplace_back(
-                std::make_shared<BytesValue>(
-                    part
-                )
-            );
-        }
+        std::reverse(result.begin(), result.end());
 
         return Value(
-            std::make_shared<ListValue>(
+            makePooled<ListValue>(
                 std::move(result)
             )
         );
@@ -727,11 +595,11 @@ Value BytesValue::rsplit(const std::optional<Value> &sep, const Value::BigInt &m
     std::vector<QByteArray> parts;
 
     qsizetype end = data.size();
-    Value::BigInt splits = 0;
+    long long splits = 0;
 
     while (
-        maxsplit < 0 ||
-        splits < maxsplit
+        limit < 0 ||
+        splits < limit
     ) {
 
         const qsizetype searchFrom = end - delimiter.size();
@@ -741,10 +609,7 @@ Value BytesValue::rsplit(const std::optional<Value> &sep, const Value::BigInt &m
         }
 
         const qsizetype pos =
-            data.lastIndexOf(
-                delimiter,
-                searchFrom
-            );
+            bytekernels::rfind(data, delimiter, 0, end);
 
         if (pos == -1) {
             break;
@@ -778,48 +643,42 @@ Value BytesValue::rsplit(const std::optional<Value> &sep, const Value::BigInt &m
     }
 
     return Value(
-        std::make_shared<ListValue>(
+        makePooled<ListValue>(
             std::move(result)
         )
     );
 }
 
-Value BytesValue::join(const Value& iterable) const {
+std::vector<QByteArrayView> BytesValue::joinPieces(const std::vector<Value>& items) {
 
-    if (!iterable.isIterable()) {
-        throw std::runtime_error(
-            "TypeError: can only join an iterable"
-        );
-    }
+    std::vector<QByteArrayView> pieces;
+    pieces.reserve(items.size());
 
-    QByteArray result;
-
-    const auto iter = iterable.getIterator();
-
-    bool first = true;
+    for (std::size_t i = 0; i < items.size(); ++i) {
 
-    while (iter->hasNext()) {
-
-        const Value item = iter->next();
-
-        if (!item.isBytes()) {
+        if (const auto bytes = std::get_if<Value::BytesPtr>(&items[i].data)) {
+            pieces.emplace_back((*bytes)->bytes());
+        } else if (const auto array = std::get_if<Value::ByteArrayPtr>(&items[i].data)) {
+            pieces.emplace_back((*array)->bytes());
+        } else {
             throw std::runtime_error(
-                "TypeError: sequence item is not bytes"
+                "TypeError: sequence item " + std::to_string(i) +
+                ": expected a bytes-like object, " + typeName(items[i]).toStdString() + " found"
             );
         }
+    }
 
-        if (!first) {
-            result += data;
-        }
+    return pieces;
+}
 
-        result += item.asBytes()->bytes();
+Value BytesValue::join(const Value& iterable) const {
 
-        first = false;
-    }
+    std::vector<Value> storage;
+    const std::vector<Value>& items = sequenceItems(iterable, storage);
 
     return Value(
         std::make_shared<BytesValue>(
-            std::move(result)
+            bytekernels::join(data, joinPieces(items))
         )
     );
 }
@@ -845,65 +704,9 @@ Value BytesValue::replace(
 
     const QByteArray newBytes = newValue.asBytes()->bytes();
 
-    QByteArray result = data;
-
-    if (count < 0) {
-
-        result.replace(oldBytes, newBytes);
-
-        return Value(
-            std::make_shared<BytesValue>(
-                std::move(result)
-            )
-        );
-    }
-
-    if (oldBytes.isEmpty()) {
-
-        QByteArray out;
-
-        Value::BigInt replacements = 0;
-
-        for (qsizetype i = 0; i <= data.size(); ++i) {
-
-            if (replacements < count) {
-                out += newBytes;
-                ++replacements;
-            }
-
-            if (i < data.size()) {
-                out += data[i];
-            }
-        }
-
-        return Value(
-            std::make_shared<BytesValue>(
-                std::move(out)
-            )
-        );
-    }
-
-    Value::BigInt replacements = 0;
-    int pos = 0;
-
-    while (replacements < count) {
-
-        pos = result.indexOf(oldBytes, pos);
-
-        if (pos == -1) {
-            break;
-        }
-
-        result.replace(pos, oldBytes.size(), newBytes);
-
-        pos += newBytes.size();
-
-        ++replacements;
-    }
-
     return Value(
         std::make_shared<BytesValue>(
-            std::move(result)
+            bytekernels::replace(data, oldBytes, newBytes, count.convert_to<long long>())
         )
     );
 }
@@ -922,74 +725,22 @@ Value BytesValue::isAscii() const {
 
 Value BytesValue::isAlpha() const {
 
-    if (data.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const unsigned char byte : data) {
-
-        if (!isAsciiAlpha(byte)) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
-}
-
-static bool isAsciiDigit(unsigned char ch) {
-
-    return ch >= '0' && ch <= '9';
+    return Value(bytekernels::allOf(data, bytekernels::Alpha));
 }
 
 Value BytesValue::isDigit() const {
 
-    if (data.isEmpty()) {
-        return Value(false);
-    }
-
-    for (unsigned char byte : data) {
-
-        if (!isAsciiDigit(byte)) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(bytekernels::allOf(data, bytekernels::Digit));
 }
 
 Value BytesValue::isAlnum() const {
 
-    if (data.isEmpty()) {
-        return Value(false);
-    }
-
-    for (unsigned char byte : data) {
-
-        if (
-            !isAsciiAlpha(byte) &&
-            !isAsciiDigit(byte)
-        ) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(bytekernels::allOf(data, bytekernels::Alnum));
 }
 
 Value BytesValue::isSpace() const {
 
-    if (data.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const unsigned char byte : data) {
-
-        if (!isAsciiWhitespace(byte)) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(bytekernels::allOf(data, bytekernels::Space));
 }
 
 Value BytesValue::isLower() const {
@@ -1607,7 +1358,7 @@ Value BytesValue::partition(const Value& sep) const {
     }
 
     return Value(
-        std::make_shared<TupleValue>(
+        makePooled<TupleValue>(
             std::move(items)
         )
     );
@@ -1677,7 +1428,7 @@ Value BytesValue::rpartition(const Value& sep) const {
     }
 
     return Value(
-        std::make_shared<TupleValue>(
+        makePooled<TupleValue>(
             std::move(items)
         )
     );
@@ -1687,69 +1438,20 @@ Value BytesValue::splitlines(const bool keepends) const {
 
     std::vector<Value> result;
 
-    qsizetype start = 0;
-    qsizetype i = 0;
-
-    while (i < data.size()) {
-
-        const qsizetype lineEnd = i;
-        qsizetype separatorLength = 0;
-
-        const unsigned char ch = data[i];
-
-        if (ch == '\n') {
-
-            separatorLength = 1;
-
-        } else if (ch == '\r') {
-
-            if (
-                i + 1 < data.size() &&
-                data[i + 1] == '\n'
-            ) {
-
-                separatorLength = 2;
-
-            } else {
-
-                separatorLength = 1;
-            }
-
-        }
-
-        if (separatorLength != 0) {
-
-            const qsizetype length =
-                keepends
-                ? (lineEnd - start + separatorLength)
-                : (lineEnd - start);
+    const qsizetype size = data.size();
 
+    textscan::splitLines(size, keepends,
+        [&](const qsizetype i) { return textscan::byteLineBreak(data, size, i); },
+        [&](const qsizetype start, const qsizetype length) {
             result.emplace_back(
                 std::make_shared<BytesValue>(
                     data.mid(start, length)
                 )
             );
-
-            i += separatorLength;
-            start = i;
-
-            continue;
-        }
-
-        ++i;
-    }
-
-    if (start < data.size()) {
-
-        result.emplace_back(
-            std::make_shared<BytesValue>(
-                data.mid(start)
-            )
-        );
-    }
+        });
 
     return Value(
-        std::make_shared<ListValue>(
+        makePooled<ListValue>(
             std::move(result)
         )
     );
@@ -1796,166 +1498,133 @@ Value BytesValue::expandTabs(const int tabsize) const {
     );
 }
 
-Value BytesValue::hex() const {
-
-    return Value(
-        QString::fromLatin1(
-            data.toHex()
-        )
-    );
+Value BytesValue::hex(const std::vector<Value>& args) const {
+    return hexOf(data, args);
 }
 
-Value BytesValue::fromHex(const QString& text) {
-
-    QString cleaned;
+Value BytesValue::hexOf(const QByteArrayView data, const std::vector<Value>& args) {
 
-    for (const QChar ch : text) {
+    const auto [sep, bytesPerSep] = hexSeparator(args, data.size());
 
-        if (!ch.isSpace()) {
-            cleaned += ch;
-        }
-    }
+    return Value(codeckernels::toHex(data, sep, bytesPerSep));
+}
 
-    if (cleaned.size() % 2 != 0) {
+BytesValue::HexSeparator BytesValue::hexSeparator(const std::vector<Value>& args, const qsizetype size) {
 
+    if (args.size() > 2) {
         throw std::runtime_error(
-            "ValueError: non-hexadecimal number found in fromhex() arg"
+            "TypeError: hex() takes at most 2 arguments (" + std::to_string(args.size()) + " given)"
         );
     }
 
-    QByteArray result;
+    HexSeparator result;
 
-    result.reserve(cleaned.size() / 2);
+    if (!args.empty()) {
 
-    for (int i = 0; i < cleaned.size(); i += 2) {
+        const Value& separator = args[0];
+        QString text;
 
-        bool ok = false;
+        if (separator.isString()) {
+            text = separator.toString();
+        } else if (separator.isBytes()) {
+            text = QString::fromLatin1(separator.asBytes()->bytes());
+        } else if (separator.isByteArray()) {
+            text = QString::fromLatin1(separator.asByteArray()->bytes());
+        } else {
+            throw std::runtime_error("TypeError: sep must be str or bytes.");
+        }
 
-        const QString pair = cleaned.mid(i, 2);
+        if (text.size() != 1) {
+            throw std::runtime_error("ValueError: sep must be length 1.");
+        }
 
-        const int value = pair.toInt(&ok, 16);
+        if (text[0].unicode() >= 0x80) {
+            throw std::runtime_error("ValueError: sep must be ASCII.");
+        }
 
-        if (!ok) {
+        result.sep = text[0].unicode();
+    }
 
-            throw std::runtime_error(
-                "ValueError: non-hexadecimal number found in fromhex() arg"
-            );
-        }
+    if (args.size() == 2) {
+
+        // группа длиннее данных ничем не отличается от группы в длину данных
+        const Value::BigInt group = args[1].asBigInt("hex");
+        const qsizetype limit = size + 1;
 
-        result.append(static_cast<char>(value));
+        result.bytesPerSep = group > limit ? limit : group < -limit ? -limit : group.convert_to<qsizetype>();
     }
 
+    return result;
+}
+
+Value BytesValue::fromHex(const QString& text) {
+
     return Value(
         std::make_shared<BytesValue>(
-            std::move(result)
+            parseHex(text)
         )
     );
 }
 
-Value BytesValue::decode(
-    const QString& encoding,
-    const QString& errors
-) const {
-
-    QString result;
-
-    if (encoding == "utf-8" || encoding == "utf8") {
-
-        result = QString::fromUtf8(data);
-
-        if (errors == "strict") {
-
-            const QByteArray encoded = result.toUtf8();
+QByteArray BytesValue::parseHex(const QStringView text) {
 
-            if (encoded != data) {
+    QByteArray result;
 
-                throw std::runtime_error(
-                    "UnicodeDecodeError: invalid utf-8 sequence"
-                );
-            }
-        }
+    if (const qsizetype position = codeckernels::fromHex(text, result, true); position >= 0) {
+        throw std::runtime_error(
+            "ValueError: non-hexadecimal number found in fromhex() arg at position " + std::to_string(position)
+        );
+    }
 
-    } else if (encoding == "ascii") {
+    return result;
+}
 
-        for (const unsigned char ch : data) {
+Value BytesValue::decode(
+    const QString& encoding,
+    const QString& errors
+) const {
 
-            if (ch > 127) {
+    return Value(
+        makePooled<StrValue>(
+            textcodec::decode(data, textcodec::codecOf(encoding), textcodec::errorsOf(errors))
+        )
+    );
+}
 
-                if (errors == "ignore") {
-                    continue;
-                }
+namespace {
 
-                throw std::runtime_error(
-                    "UnicodeDecodeError: ordinal not in range(128)"
-                );
-            }
+    /// буфер bytes или bytearray без копирования
+    QByteArrayView bytesLikeView(const Value& value) {
 
-            result += QChar(ch);
+        if (value.isBytes()) {
+            return value.asBytes()->bytes();
         }
 
-    } else if (encoding == "latin-1" ||
-               encoding == "latin1") {
-
-        for (unsigned char ch : data) {
-            result += QChar(ch);
+        if (value.isByteArray()) {
+            return value.asByteArray()->bytes();
         }
 
-    } else {
-
         throw std::runtime_error(
-            QString(
-                "LookupError: unknown encoding '%1'"
-            ).arg(encoding).toStdString()
-        );
+            "TypeError: a bytes-like object is required, not '" + typeName(value).toStdString() + "'");
     }
-
-    return Value(
-        std::make_shared<StrValue>(result)
-    );
 }
 
 Value BytesValue::maketrans(const std::vector<Value>& args) {
 
-    if (args.size() != 2) {
-        throw std::runtime_error(
-            "maketrans expected 2 arguments"
-        );
-    }
-
-    if (
-        !args[0].isBytes() ||
-        !args[1].isBytes()
-    ) {
-        throw std::runtime_error(
-            "maketrans arguments must be bytes"
-        );
-    }
-
-    const QByteArray from = args[0].asBytes()->bytes();
+    expectArgs(args, 2, "maketrans");
 
-    const QByteArray to = args[1].asBytes()->bytes();
+    const QByteArrayView from = bytesLikeView(args[0]);
+    const QByteArrayView to = bytesLikeView(args[1]);
 
     if (from.size() != to.size()) {
         throw std::runtime_error(
-            "ValueError: maketrans arguments must have equal length"
+            "ValueError: maketrans arguments must have same length"
         );
     }
 
-    QByteArray table(256, '\0');
-
-    for (int i = 0; i < 256; ++i) {
-        table[i] = static_cast<char>(i);
-    }
-
-    for (int i = 0; i < from.size(); ++i) {
-
-        const auto src = static_cast<unsigned char>(from[i]);
-        table[src] = to[i];
-    }
-
     return Value(
         std::make_shared<BytesValue>(
-            std::move(table)
+            bytekernels::makeTranslation(from, to)
         )
     );
 }
@@ -1964,52 +1633,29 @@ Value BytesValue::translate(
     const Value& table,
     const std::optional<Value>& deleteBytes) const {
 
-    if (!table.isBytes()) {
-        throw std::runtime_error(
-            "translate table must be bytes"
-        );
-    }
+    return Value(
+        std::make_shared<BytesValue>(
+            translateOf(data, table, deleteBytes)
+        )
+    );
+}
+
+QByteArray BytesValue::translateOf(const QByteArray& data,
+                                   const Value& table,
+                                   const std::optional<Value>& deleteBytes) {
 
-    const QByteArray mapping = table.asBytes()->bytes();
+    // таблица и набор удаляемых байтов читаются на месте: ни копии, ни перевода в Value
+    const QByteArrayView mapping = table.isNone() ? QByteArrayView() : bytesLikeView(table);
 
-    if (mapping.size() != 256) {
+    if (!table.isNone() && mapping.size() != 256) {
         throw std::runtime_error(
-            "translation table must be 256 characters long"
+            "ValueError: translation table must be 256 characters long"
         );
     }
 
-    QByteArray deleteSet;
-
-    if (deleteBytes.has_value()) {
+    const QByteArrayView deleted = deleteBytes ? bytesLikeView(*deleteBytes) : QByteArrayView();
 
-        if (!deleteBytes->isBytes()) {
-            throw std::runtime_error(
-                "delete argument must be bytes"
-            );
-        }
-
-        deleteSet = deleteBytes->asBytes()->bytes();
-    }
-
-    QByteArray result;
-    result.reserve(data.size());
-
-    for (const unsigned char byte : data) {
-
-        if (deleteSet.contains(
-                static_cast<char>(byte)
-            )) {
-            continue;
-            }
-
-        result.append(mapping[byte]);
-    }
-
-    return Value(
-        std::make_shared<BytesValue>(
-            std::move(result)
-        )
-    );
+    return bytekernels::translate(data, mapping, deleted);
 }
 
 struct BytesFormatSpec {
@@ -2389,7 +2035,7 @@ static QByteArray formatBytesArgument(
 
             const auto number = value.toBigInt();
 
-            result = QByteArray::fromStdString(number.str());
+            result = QByteArray::fromStdString(BigIntText::toString(number));
 
             applySign(result, specifier, number);
 
@@ -2840,24 +2486,22 @@ Value BytesValue::mod(const Value& rhs) const {
 
             auto dict = rhs.asDict();
 
-            const auto& elements = dict->getElementsRef();
-
             auto bytesKey = Value(
                 std::make_shared<BytesValue>(
                     effectiveSpec.mappingKey.toUtf8()
                 )
             );
 
-            auto it = elements.find(bytesKey);
+            const Value* mapped = dict->find(bytesKey);
 
-            if (it == elements.end()) {
+            if (!mapped) {
 
                 throw std::runtime_error(
                     "missing key in mapping"
                 );
             }
 
-            currentArg = it.value();
+            currentArg = *mapped;
 
         } else {
 
@@ -2893,9 +2537,11 @@ Value BytesValue::mod(const Value& rhs) const {
 
 std::size_t BytesValue::hash() const {
 
-    return static_cast<long long>(
-        qHash(bytes())
-    );
+    if (!cachedHash) {
+        cachedHash = hashkernels::hashBytes(data.constData(), static_cast<std::size_t>(data.size()));
+    }
+
+    return *cachedHash;
 }
 
 BytesValue::BytesValue(QByteArray data) : data(std::move(data)) {}
@@ -0,0 +1,288 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "CachedFunctionValue.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include <QHash>
+#include <QStringList>
+
+#include "ClassUtils.h"
+#include "TupleValue.h"
+
+namespace {
+
+    void combine(std::size_t& seed, const std::size_t hash) {
+        seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    const std::array<QString, CacheInfoValue::fieldCount> fieldNames = {"hits", "misses", "maxsize", "currsize"};
+}
+
+CachedFunctionValue::CachedFunctionValue(Value function, const std::optional<qsizetype> maxsize, const bool typed)
+    : function(std::move(function)), maxsize(maxsize), typed(typed) {}
+
+CachedFunctionValue* CachedFunctionValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<CachedFunctionValue*>(object->get()) : nullptr;
+}
+
+QString CachedFunctionValue::toString() const {
+    return QString("<functools._lru_cache_wrapper object at 0x%1>").arg(reinterpret_cast<quintptr>(this), 0, 16);
+}
+
+std::size_t CachedFunctionValue::hashKey(const std::vector<Value>& args, const Kwargs& kwargs) {
+
+    // нехешируемый аргумент бросает TypeError до вызова функции, как в CPython
+    std::size_t seed = args.size();
+
+    for (const Value& arg : args) {
+        combine(seed, arg.hash());
+    }
+
+    for (const auto& [name, value] : kwargs) {
+        combine(seed, qHash(name));
+        combine(seed, value.hash());
+    }
+
+    return seed;
+}
+
+bool CachedFunctionValue::sameKey(const Value& stored, const Value& given) const {
+    return stored.keyEquals(given) && (!typed || typeName(stored) == typeName(given));
+}
+
+CachedFunctionValue::Entry* CachedFunctionValue::find(const std::size_t hash,
+                                                      const std::vector<Value>& args,
+                                                      const Kwargs& kwargs) const {
+
+    const auto [begin, end] = entries.equal_range(hash);
+
+    for (auto it = begin; it != end; ++it) {
+
+        Entry* entry = it->second.get();
+
+        if (entry->args.size() != args.size() || entry->kwargs.size() != kwargs.size()) {
+            continue;
+        }
+
+        bool same = true;
+
+        for (std::size_t i = 0; same && i < args.size(); ++i) {
+            same = sameKey(entry->args[i], args[i]);
+        }
+
+        for (std::size_t i = 0; same && i < kwargs.size(); ++i) {
+            same = entry->kwargs[i].first == kwargs[i].first && sameKey(entry->kwargs[i].second, kwargs[i].second);
+        }
+
+        if (same) {
+            return entry;
+        }
+    }
+
+    return nullptr;
+}
+
+void CachedFunctionValue::unlink(Entry* entry) {
+
+    (entry->older ? entry->older->newer : oldest) = entry->newer;
+    (entry->newer ? entry->newer->older : newest) = entry->older;
+
+    entry->older = nullptr;
+    entry->newer = nullptr;
+}
+
+void CachedFunctionValue::pushNewest(Entry* entry) {
+
+    entry->older = newest;
+    (newest ? newest->newer : oldest) = entry;
+    newest = entry;
+}
+
+void CachedFunctionValue::evictOldest() {
+
+    Entry* entry = oldest;
+    unlink(entry);
+
+    const auto [begin, end] = entries.equal_range(entry->hash);
+
+    for (auto it = begin; it != end; ++it) {
+        if (it->second.get() == entry) {
+            entries.erase(it);
+            return;
+        }
+    }
+}
+
+Value CachedFunctionValue::call(const std::vector<Value>& args,
+                                const Kwargs& kwargs,
+                                const std::shared_ptr<Environment>& env) {
+
+    if (maxsize && *maxsize == 0) {
+        ++misses;
+        return ::call(function, args, kwargs, env);
+    }
+
+    const std::size_t hash = hashKey(args, kwargs);
+
+    if (Entry* entry = find(hash, args, kwargs)) {
+
+        ++hits;
+
+        if (maxsize) {
+            unlink(entry);
+            pushNewest(entry);
+        }
+
+        return entry->result;
+    }
+
+    ++misses;
+
+    // функция может удалить последнюю ссылку на обёртку: она нужна до записи результата
+    const std::shared_ptr<CachedFunctionValue> self = shared_from_this();
+    Value result = ::call(function, args, kwargs, env);
+
+    // рекурсивный вызов с теми же аргументами уже мог положить ключ в кэш
+    if (find(hash, args, kwargs)) {
+        return result;
+    }
+
+    if (maxsize && static_cast<qsizetype>(entries.size()) >= *maxsize) {
+        evictOldest();
+    }
+
+    auto entry = std::make_unique<Entry>(Entry{hash, args, kwargs, result});
+    pushNewest(entry.get());
+    entries.emplace(hash, std::move(entry));
+
+    return result;
+}
+
+Value CachedFunctionValue::cacheInfo() const {
+
+    return Value(std::static_pointer_cast<ObjectValue>(std::make_shared<CacheInfoValue>(std::vector<Value>{
+        Value(Value::SmallInt(hits)),
+        Value(Value::SmallInt(misses)),
+        maxsize ? Value(Value::SmallInt(*maxsize)) : Value(),
+        Value(Value::SmallInt(static_cast<qsizetype>(entries.size())))
+    })));
+}
+
+void CachedFunctionValue::cacheClear() {
+
+    // записи уходят после отвязки: деструктор результата может снова обратиться к кэшу
+    auto released = std::move(entries);
+    entries.clear();
+
+    oldest = nullptr;
+    newest = nullptr;
+    hits = 0;
+    misses = 0;
+}
+
+long CachedFunctionValue::gcRefCount() const {
+    return weak_from_this().use_count();
+}
+
+std::shared_ptr<GcObject> CachedFunctionValue::gcSelf() {
+    return shared_from_this();
+}
+
+void CachedFunctionValue::gcTraverse(const GcVisitor& visit) const {
+
+    gcVisitValue(function, visit);
+
+    for (const auto& [hash, entry] : entries) {
+
+        for (const Value& arg : entry->args) {
+            gcVisitValue(arg, visit);
+        }
+
+        for (const auto& [name, value] : entry->kwargs) {
+            gcVisitValue(value, visit);
+        }
+
+        gcVisitValue(entry->result, visit);
+    }
+}
+
+void CachedFunctionValue::gcClear() {
+
+    cacheClear();
+    function = Value();
+}
+
+CacheInfoValue::CacheInfoValue(std::vector<Value> fields) : fields(std::move(fields)) {}
+
+CacheInfoValue* CacheInfoValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<CacheInfoValue*>(object->get()) : nullptr;
+}
+
+QString CacheInfoValue::toString() const {
+
+    QStringList parts;
+
+    for (qsizetype i = 0; i < fieldCount; ++i) {
+        parts << fieldNames[i] + "=" + fields[i].repr();
+    }
+
+    return "CacheInfo(" + parts.join(", ") + ")";
+}
+
+std::optional<Value> CacheInfoValue::field(const QString& name) const {
+
+    for (qsizetype i = 0; i < fieldCount; ++i) {
+        if (fieldNames[i] == name) {
+            return fields[i];
+        }
+    }
+
+    return std::nullopt;
+}
+
+Value CacheInfoValue::getItem(const Value& index) const {
+
+    if (!index.isBigInt() && !index.isBool()) {
+        throw std::runtime_error(
+            "TypeError: tuple indices must be integers or slices, not " + typeName(index).toStdString());
+    }
+
+    Value::BigInt position = index.toBigInt();
+
+    if (position < 0) {
+        position += fieldCount;
+    }
+
+    if (position < 0 || position >= fieldCount) {
+        throw std::runtime_error("IndexError: tuple index out of range");
+    }
+
+    return fields[position.convert_to<std::size_t>()];
+}
+
+bool CacheInfoValue::equal(const Value& other) const {
+
+    if (const CacheInfoValue* info = of(other)) {
+        return std::equal(fields.begin(), fields.end(), info->fields.begin(),
+                          [](const Value& a, const Value& b) { return a.itemEquals(b); });
+    }
+
+    const auto* tuple = std::get_if<Value::TuplePtr>(&other.data);
+
+    return tuple && std::equal(fields.begin(), fields.end(), (*tuple)->items.begin(), (*tuple)->items.end(),
+                               [](const Value& a, const Value& b) { return a.itemEquals(b); });
+}
+
+bool CacheInfoValue::notEqual(const Value& other) const {
+    return !equal(other);
+}
@@ -1,17 +1,40 @@
 #include "CallRuntime.h"
 
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "ArrayValue.h"
 #include "BoundMethod.h"
 #include "ByteArrayValue.h"
 #include "BytesValue.h"
+#include "CachedFunctionValue.h"
 #include "ClassMethodValue.h"
+#include "ClassUtils.h"
+#include "CoroutineValue.h"
+#include "DictValue.h"
 #include "Environment.h"
+#include "ExecutionBudget.h"
 #include "FunctionValue.h"
+#include "FutureValue.h"
+#include "GarbageCollector.h"
+#include "GeneratorValue.h"
+#include "InterpreterContext.h"
+#include "ListValue.h"
+#include "MemoryViewValue.h"
+#include "ObjectPool.h"
+#include "PyException.h"
+#include "RecursionLimit.h"
 #include "Parser.h"
+#include "Profiler.h"
 #include "StaticMethodValue.h"
 #include "StrValue.h"
+#include "Tracer.h"
+#include "TupleValue.h"
 #include "Value.h"
-
-#include <unordered_set>
+#include "VectorPool.h"
+#include "VirtualMachine.h"
+#include "../runtime/builtins/list/ListMethods.h"
 
 //
 // Created by semyo on 03.05.2026.
@@ -23,11 +46,12 @@ Value call(const Value& callee,
 
     if (std::holds_alternative<Value::BuiltinFunctionPtr>(callee.data)) {
         const auto fn = std::get<Value::BuiltinFunctionPtr>(callee.data);
+        const Profiler::Frame frame(fn->name);
         return fn->func(args, kwargs, env);
     }
 
     if (const auto f = std::get_if<Value::FunctionPtr>(&callee.data)) {
-        return callFunction(*f, args, kwargs, env);
+        return callFunction(*f, args, kwargs);
     }
 
     if (const auto c = std::get_if<Value::ClassPtr>(&callee.data)) {
@@ -46,160 +70,496 @@ Value call(const Value& callee,
         return call(Value((*cm)->func), args, kwargs, env);
     }
 
+    if (CachedFunctionValue* cached = CachedFunctionValue::of(callee)) {
+        return cached->call(args, kwargs, env);
+    }
+
     throw std::runtime_error("Object is not callable");
 }
 
-Value callFunction(const Value::FunctionPtr& func,
-                   const std::vector<Value>& args,
-                   const Kwargs& kwargs,
-                   const std::shared_ptr<Environment>& envOverride = nullptr) {
+std::shared_ptr<Environment> makeCallFrame(const Value::FunctionPtr& func,
+                                           const std::vector<Value>& args,
+                                           const Kwargs& kwargs,
+                                           const Value* self,
+                                           const std::shared_ptr<ClassValue>& ownerClass) {
 
-    const auto local = std::make_shared<Environment>(func->closure);
+    const auto local = makePooled<Environment>(func->closure, func->layout);
+
+    if (!func->cells.empty()) {
+        local->bindFreeCells(func->cells);
+    }
 
-    if (envOverride) {
-        for (auto it = envOverride->variables.cbegin();
-            it != envOverride->variables.cend(); ++it) {
+    // `__class__` кадра — класс, в теле которого определена функция; для присвоенной классу позже — класс вызова
+    local->ownerClass = func->ownerClass ? func->ownerClass : ownerClass;
 
-            local->set(it.key(), it.value());
+    // параметры занимают первые слоты кадра — связываются по индексу, без поиска по имени
+    const auto bindParam = [&](const std::size_t index, const Value& value) {
+        if (func->layout) {
+            local->slots[index] = value;
+        } else {
+            local->set(func->params[index].name, value);
         }
+    };
+
+    const BindingPlan& plan = *func->plan;
+
+    // self занимает первый параметр, args связываются следом — без копии списка аргументов
+    const std::size_t offset = self ? 1 : 0;
+    const std::size_t positional = args.size() + offset;
+
+    if (positional > plan.positionalCount()) {
+        throw std::runtime_error("Too many positional arguments");
     }
 
-    std::unordered_set<QString> assigned;
+    if (self) {
+        bindParam(0, *self);
+    }
 
     // позиционные аргументы
     for (size_t i = 0; i < args.size(); ++i) {
+        bindParam(i + offset, args[i]);
+    }
 
-        if (i >= func->params.size()) {
-            throw std::runtime_error("Too many positional arguments");
+    // без именованных аргументов достаточно сравнить количество — без вспомогательных контейнеров
+    if (kwargs.empty()) {
+
+        if (positional < plan.positionalCount()) {
+            throw std::runtime_error("Missing argument: " + func->params[positional].name.toStdString());
         }
 
-        const QString& paramName = func->params[i].name;
+    } else {
 
-        local->set(paramName, args[i]);
-        assigned.insert(paramName);
-    }
+        const auto assignedLease = VectorPool<bool>::acquire();
+        std::vector<bool>& assigned = *assignedLease;
+
+        assigned.assign(func->params.size(), false);
+        std::fill_n(assigned.begin(), positional, true);
+
+        // именованные аргументы: слот по таблице плана, без перебора параметров
+        for (const auto& [name, value] : kwargs) {
 
-    // именованные аргументы
-    for (const auto& [name, value] : kwargs) {
+            const int index = plan.indexOf(name);
 
-        bool found = false;
+            if (index < 0) {
+                throw std::runtime_error("Unknown keyword argument: " + name.toStdString());
+            }
 
-        for (const auto& param : func->params) {
+            if (assigned[index]) {
+                throw std::runtime_error(
+                "Multiple values for argument: "+ name.toStdString()
+                );
+            }
 
-            if (param.name == name) {
+            bindParam(index, value);
 
-                if (assigned.count(name)) {
-                    throw std::runtime_error(
-                    "Multiple values for argument: "+ name.toStdString()
-                    );
-                }
+            assigned[index] = true;
+        }
 
-                local->set(name, value);
+        // повторы отсеяны выше, поэтому полный набор виден по количеству
+        if (positional + kwargs.size() < func->params.size()) {
 
-                assigned.insert(name);
+            const auto missing = std::find(assigned.begin(), assigned.end(), false) - assigned.begin();
 
-                found = true;
-                break;
-            }
+            throw std::runtime_error("Missing argument: " + func->params[missing].name.toStdString());
         }
+    }
 
-        if (!found) {
-            throw std::runtime_error("Unknown keyword argument: " + name.toStdString());
+    // параметры, которые читают вложенные функции, переезжают из слотов в ячейки кадра
+    if (func->layout) {
+        for (const auto& [slot, cell] : func->layout->cellParams) {
+            local->cells[cell]->value = std::move(local->slots[slot]);
+            local->slots[slot].reset();
         }
     }
 
-    // отсутствие аргументов
-    for (const auto& param : func->params) {
+    return local;
+}
 
-        if (!assigned.count(param.name)) {
-            throw std::runtime_error("Missing argument: " + param.name.toStdString());
-        }
+Value callFunction(const Value::FunctionPtr& func,
+                   const std::vector<Value>& args,
+                   const Kwargs& kwargs,
+                   const Value* self,
+                   const std::shared_ptr<ClassValue>& ownerClass) {
+
+    GarbageCollector::collectIfNeeded();
+
+    const Profiler::Frame frame(*func);
+
+    const auto local = makeCallFrame(func, args, kwargs, self, ownerClass);
+
+    // тело сопрограммы выполняет цикл событий, шаг за шагом между ожиданиями
+    if (func->code && func->code->coroutine) {
+        return Value(std::static_pointer_cast<IteratorValue>(
+            makePooled<CoroutineValue>(func->code, local, func->name)
+        ));
     }
 
+    // тело генератора выполняется по мере потребления значений
+    if (func->code && func->code->generator) {
+        return Value(std::static_pointer_cast<IteratorValue>(
+            makePooled<GeneratorValue>(func->code, local, func->name)
+        ));
+    }
+
+    ExecutionBudget::tick();
+    const RecursionLimit::Guard depth;
+    Tracer::Frame trace(*func);
+
     try {
+        if (func->code) {
+            return trace.returned(VirtualMachine::run(*func->code, local));
+        }
+
         Value result;
 
         for (const auto& stmt : func->body) {
             result = stmt->eval(local);
         }
 
-        return result;
+        return trace.returned(std::move(result));
     }
     catch (ReturnException& e) {
-        return e.getValue();
+        return trace.returned(e.getValue());
+    }
+}
+
+Value callMethod(const Value& obj,
+                 const QString& name,
+                 const std::vector<Value>& args,
+                 const Kwargs& kwargs,
+                 const std::shared_ptr<Environment>& env) {
+
+    if (obj.isList()) {
+        if (const BuiltinMethod method = findListMethod(name)) {
+            return method(obj, args, kwargs, env);
+        }
+    }
+
+    if (const auto super = std::get_if<Value::SuperPtr>(&obj.data)) {
+        return call(getAttrFromSuper(*super, name), args, kwargs, env);
+    }
+
+    return call(getAttrValue(obj, name), args, kwargs, env);
+}
+
+namespace {
+
+    /// встроенная последовательность с целыми индексами или nullptr
+    ObjectValue* sequenceOf(const Value& value) {
+
+        if (const auto list = std::get_if<Value::ListPtr>(&value.data)) {
+            return list->get();
+        }
+
+        if (const auto tuple = std::get_if<Value::TuplePtr>(&value.data)) {
+            return tuple->get();
+        }
+
+        if (const auto str = std::get_if<Value::StrPtr>(&value.data)) {
+            return str->get();
+        }
+
+        if (const auto bytes = std::get_if<Value::BytesPtr>(&value.data)) {
+            return bytes->get();
+        }
+
+        if (const auto array = std::get_if<Value::ByteArrayPtr>(&value.data)) {
+            return array->get();
+        }
+
+        return nullptr;
+    }
+}
+
+Value getSubscript(const Value& obj, const Value& index, const std::shared_ptr<Environment>& env) {
+
+    if (const auto small = std::get_if<Value::SmallInt>(&index.data)) {
+        if (const ObjectValue* sequence = sequenceOf(obj)) {
+            return sequence->getItemInt(*small);
+        }
+    }
+
+    // dict и его наследники из collections: `__missing__` вызывает сам getItem
+    if (const auto dict = std::get_if<Value::DictPtr>(&obj.data)) {
+        return (*dict)->getItem(index);
     }
+
+    return call(genericGetAttr(obj, "__getitem__"), {index}, {}, env);
+}
+
+void setSubscript(const Value& obj, const Value& index, const Value& value, const std::shared_ptr<Environment>& env) {
+
+    if (const auto small = std::get_if<Value::SmallInt>(&index.data)) {
+        if (ObjectValue* sequence = sequenceOf(obj)) {
+            sequence->setItemInt(*small, value);
+            return;
+        }
+    }
+
+    if (const auto dict = std::get_if<Value::DictPtr>(&obj.data)) {
+        (*dict)->setItem(index, value);
+        return;
+    }
+
+    call(getAttrValue(obj, "__setitem__"), {index, value}, {}, env);
 }
 
 bool supportsIter(const Value& obj) {
+    return tryGetAttr(obj, "__iter__").has_value();
+}
+
+std::optional<Value> tryGetIterator(const Value& iterable, const std::shared_ptr<Environment>& env) {
+
+    if (iterable.isIterable() ||
+        iterable.isByteArray() ||
+        iterable.isFrozenSet() ||
+        std::holds_alternative<Value::IteratorPtr>(iterable.data)) {
+        return Value(iterable.getIterator());
+    }
+
+    if (const std::optional<Value> iterMethod = tryGetAttr(iterable, "__iter__")) {
+        return call(*iterMethod, {}, {}, env);
+    }
+
+    return std::nullopt;
+}
+
+Value getIter(const Value& iterable, const std::shared_ptr<Environment>& env) {
+
+    if (std::optional<Value> iterator = tryGetIterator(iterable, env)) {
+        return std::move(*iterator);
+    }
+
+    throw std::runtime_error("TypeError: '" + typeName(iterable).toStdString() + "' object is not iterable");
+}
+
+bool iterNext(const Value& iterator, Value& item, const std::shared_ptr<Environment>& env) {
 
     try {
+        if (const auto native = std::get_if<Value::IteratorPtr>(&iterator.data)) {
+
+            if (!(*native)->hasNext()) {
+                return false;
+            }
+
+            item = (*native)->next();
+            return true;
+        }
 
-        getAttrValue(obj, "__iter__");
+        const Value nextMethod = getAttrValue(iterator, "__next__");
 
+        item = call(nextMethod, {}, {}, env);
         return true;
+    }
+    catch (const StopIterationException&) {
+        return false;
+    }
+    catch (const PyException& e) {
 
-    } catch (...) {
+        // raise StopIteration в __next__ пользовательского итератора
+        if (!PyException::matches(e.exception(), Value(InterpreterContext::current().exceptionClasses.value("StopIteration")))) {
+            throw;
+        }
 
         return false;
     }
 }
 
-Value constructClass(const Value::ClassPtr& cls,
-                     const std::vector<Value>& args,
-                     const Kwargs& kwargs,
-                     const std::shared_ptr<Environment>& env) {
+Value getAwaitable(const Value& value, const std::shared_ptr<Environment>& env) {
 
-    if (cls == Runtime::strClass) {
+    if (CoroutineValue::of(value)) {
+        return value;
+    }
 
-        if (args.empty()) {
-            return Value("");
+    if (FutureValue::of(value)) {
+        return Value(std::static_pointer_cast<IteratorValue>(std::make_shared<FutureAwaiter>(value)));
+    }
+
+    Value method;
+
+    try {
+        method = getAttrValue(value, "__await__");
+    } catch (const AttributeErrorException&) {
+        throw std::runtime_error("TypeError: object " + typeName(value).toStdString() +
+                                 " can't be used in 'await' expression");
+    }
+
+    const Value iterator = call(method, {}, {}, env);
+
+    if (CoroutineValue::of(iterator)) {
+        throw std::runtime_error("TypeError: __await__() returned a coroutine");
+    }
+
+    return getIter(iterator, env);
+}
+
+Value getAsyncIter(const Value& iterable, const std::shared_ptr<Environment>& env) {
+
+    Value method;
+
+    try {
+        method = getAttrValue(iterable, "__aiter__");
+    } catch (const AttributeErrorException&) {
+        throw std::runtime_error("TypeError: 'async for' requires an object with __aiter__ method, got " +
+                                 typeName(iterable).toStdString());
+    }
+
+    return call(method, {}, {}, env);
+}
+
+IteratorValue* pairIterator(const Value& iterator) {
+
+    if (const auto native = std::get_if<Value::IteratorPtr>(&iterator.data); native && (*native)->pairwise()) {
+        return native->get();
+    }
+
+    return nullptr;
+}
+
+void unpackSequence(const Value& value,
+                    const std::size_t count,
+                    std::vector<Value>& out,
+                    const std::shared_ptr<Environment>& env) {
+
+    const std::vector<Value>* items = nullptr;
+
+    if (value.isTuple()) {
+        items = &value.asTuple()->items;
+    } else if (value.isList()) {
+        items = &value.asList()->elements.get();
+    }
+
+    const std::size_t base = out.size();
+
+    if (items) {
+        if (items->size() == count) {
+            out.insert(out.end(), items->begin(), items->end());
+            return;
         }
+    } else {
 
-        if (args.size() > 1) {
-            throw std::runtime_error(
-                "str() takes at most 1 argument"
-            );
+        const Value iterator = getIter(value, env);
+        Value item;
+
+        while (out.size() - base <= count && iterNext(iterator, item, env)) {
+            out.push_back(std::move(item));
         }
+    }
+
+    const std::size_t got = items ? items->size() : out.size() - base;
 
-        return Value(args[0].toString());
+    if (got == count) {
+        return;
     }
 
-    if (cls == Runtime::bytesClass) {
+    out.resize(base);
 
-        return Value(
-            std::make_shared<BytesValue>(
-                constructBytesData(args, kwargs)
-            )
-        );
+    if (got < count) {
+        throw std::runtime_error(
+            "ValueError: not enough values to unpack (expected " + std::to_string(count) +
+            ", got " + std::to_string(got) + ")");
+    }
 
+    if (got > count) {
+        throw std::runtime_error(
+            "ValueError: too many values to unpack (expected " + std::to_string(count) + ")");
     }
+}
 
-    if (cls == Runtime::bytearrayClass) {
+Value constructStr(const std::vector<Value>& args, const Kwargs&) {
 
-        return Value(
-            std::make_shared<ByteArrayValue>(
-                constructBytesData(args, kwargs)
-            )
+    if (args.empty()) {
+        return Value("");
+    }
+
+    if (args.size() > 1) {
+        throw std::runtime_error(
+            "str() takes at most 1 argument"
         );
     }
 
+    return Value(args[0].toString());
+}
+
+Value constructBytes(const std::vector<Value>& args, const Kwargs& kwargs) {
+    return Value(std::make_shared<BytesValue>(constructBytesData(args, kwargs)));
+}
+
+Value constructByteArray(const std::vector<Value>& args, const Kwargs& kwargs) {
+    return Value(std::make_shared<ByteArrayValue>(constructBytesData(args, kwargs)));
+}
+
+namespace {
+
+    /// разрешение `__init__` класса; пересчитывается только после записи атрибута в какой-либо класс
+    const ClassValue::Construction& construction(const Value::ClassPtr& cls) {
+
+        ClassValue::Construction& info = cls->construction;
+
+        if (info.version == ClassValue::attributesVersion) {
+            return info;
+        }
+
+        const std::optional<Value> init = findAttrInHierarchy(cls, "__init__");
+        const auto function = init ? std::get_if<Value::FunctionPtr>(&init->data) : nullptr;
+
+        info.init = function ? *function : nullptr;
+        info.genericInit = init && !function;
+        info.exception = PyException::isExceptionClass(cls);
+        info.version = ClassValue::attributesVersion;
+
+        return info;
+    }
+}
+
+Value constructClass(const Value::ClassPtr& cls,
+                     const std::vector<Value>& args,
+                     const Kwargs& kwargs,
+                     const std::shared_ptr<Environment>& env) {
+
+    if (cls->construct) {
+        return cls->construct(args, kwargs);
+    }
+
+    const ClassValue::Construction& info = construction(cls);
+    // info.init держит функцию на время вызова: __init__ может переопределить атрибуты класса
+    const Value::FunctionPtr init = info.init;
     const auto instance = std::make_shared<InstanceValue>(cls);
+    const Value self(instance);
 
-    try {
-        const Value init = getAttrValue(Value(instance), "__init__");
-        call(init, args, kwargs, env);
-    } catch (...) {
-        if (!args.empty()) {
-            throw std::runtime_error("Class takes no arguments");
+    // исключение хранит аргументы конструктора в args; __init__ подкласса вызывается поверх
+    if (info.exception) {
+
+        instance->setField("args", TupleValue::make(args));
+
+        if (init) {
+            callMethodFunction(init, self, cls, args, kwargs);
         }
+
+        return self;
     }
 
-    return Value(instance);
+    if (init) {
+        callMethodFunction(init, self, cls, args, kwargs);
+    } else if (info.genericInit) {
+        call(getAttrValue(self, "__init__"), args, kwargs, env);
+    } else if (!args.empty() || !kwargs.empty()) {
+        throw std::runtime_error("TypeError: " + cls->name.toStdString() + "() takes no arguments");
+    }
+
+    cls->construction.fieldHint = std::max(cls->construction.fieldHint, instance->slots.size());
+
+    return self;
 }
 
 Value callBoundMethod(const Value::BoundMethodPtr &bm,
                       const std::vector<Value> &args,
                       const Kwargs& kwargs) {
+    if (const auto f =
+        std::get_if<Value::FunctionPtr>(&bm->callable.data)) {
+        return callMethodFunction(*f, bm->self, bm->ownerClass, args, kwargs);
+    }
+
     std::vector<Value> newArgs;
 
     // self
@@ -208,24 +568,163 @@ Value callBoundMethod(const Value::BoundMethodPtr &bm,
     // остальные аргументы
     newArgs.insert(newArgs.end(), args.begin(), args.end());
 
-    if (const auto f =
-        std::get_if<Value::FunctionPtr>(&bm->callable.data)) {
-        const auto local = std::make_shared<Environment>((*f)->closure);
-
-        local->set("__class__", Value(bm->ownerClass));
-
-        return callFunction(*f, newArgs, kwargs, local);
-    }
-
 
     if (const auto b =
        std::get_if<Value::BuiltinFunctionPtr>(&bm->callable.data)) {
+        const Profiler::Frame frame((*b)->name);
         return (*b)->func(newArgs, kwargs, nullptr);
     }
 
     throw std::runtime_error("Invalid bound method callable");
 }
 
+Value callMethodFunction(const Value::FunctionPtr& func,
+                         const Value& self,
+                         const std::shared_ptr<ClassValue>& ownerClass,
+                         const std::vector<Value>& args,
+                         const Kwargs& kwargs) {
+    return callFunction(func, args, kwargs, &self, ownerClass);
+}
+
+Value callOperatorMethod(const Value& self, const QString& name, const Value& other) {
+
+    const auto cls = self.asInstance()->klass;
+    const std::optional<Value> method = findAttrInHierarchy(cls, name);
+
+    if (!method) {
+        return Value::notImplemented();
+    }
+
+    if (const auto func = std::get_if<Value::FunctionPtr>(&method->data)) {
+        return callMethodFunction(*func, self, cls, { other }, {});
+    }
+
+    return call(getAttrValue(self, name), { other }, {}, nullptr);
+}
+
+namespace {
+
+    /// байт из целого элемента итерируемого; rangeError вне range(0, 256)
+    char byteOf(const Value& item, const char* rangeError) {
+
+        const auto value = item.toBigInt();
+
+        if (value < 0 || value > 255) {
+            throw std::runtime_error(rangeError);
+        }
+
+        return static_cast<char>(value.convert_to<int>());
+    }
+
+    /**
+     * Элементы list или tuple пишутся прямо в out без проверки на каждом: машинное целое
+     * копируется младшим байтом, а биты выше восьмого (у отрицательных — все старшие)
+     * собираются по ИЛИ в одну маску. Цикл без ветвлений по значению векторизуется,
+     * и диапазон проверяется один раз после него — или перед первым элементом другого
+     * типа, чтобы ошибка была той же, что при обходе по одному.
+     */
+    void appendItems(QByteArray& out, const Value* items, const std::size_t count, const char* rangeError) {
+
+        const qsizetype start = out.size();
+        out.resize(start + static_cast<qsizetype>(count));
+
+        char* target = out.data() + start;
+        std::uint64_t outOfRange = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+
+            if (const auto small = std::get_if<Value::SmallInt>(&items[i].data)) {
+
+                const auto bits = static_cast<std::uint64_t>(*small);
+                outOfRange |= bits >> 8;
+                target[i] = static_cast<char>(bits);
+                continue;
+            }
+
+            if (outOfRange != 0) {
+                break;
+            }
+
+            target[i] = byteOf(items[i], rangeError);
+        }
+
+        if (outOfRange != 0) {
+            throw std::runtime_error(rangeError);
+        }
+    }
+
+    /// содержимое bytes, bytearray, memoryview или array одним блоком; nullopt — у obj нет буфера
+    std::optional<QByteArray> bufferOf(const Value& obj) {
+
+        if (obj.isBytes()) {
+            return obj.asBytes()->bytes();
+        }
+
+        if (obj.isByteArray()) {
+            return obj.asByteArray()->bytes();
+        }
+
+        if (const MemoryViewValue* view = MemoryViewValue::of(obj)) {
+            return view->toBytes();
+        }
+
+        if (const ArrayValue* array = ArrayValue::of(obj)) {
+            return array->bytes();
+        }
+
+        return std::nullopt;
+    }
+}
+
+void appendBytesFrom(QByteArray& out, const Value& iterable, const char* rangeError) {
+
+    if (const std::optional<QByteArray> buffer = bufferOf(iterable)) {
+        out.append(*buffer);
+        return;
+    }
+
+    const qsizetype start = out.size();
+
+    try {
+
+        if (iterable.isList()) {
+
+            // константный доступ: буфер, общий с копиями списка, не отделяется
+            const CowVector<Value>& elements = std::as_const(iterable.asList()->elements);
+            appendItems(out, elements.size() == 0 ? nullptr : &elements[0], elements.size(), rangeError);
+            return;
+        }
+
+        if (iterable.isTuple()) {
+
+            const std::vector<Value>& items = iterable.asTuple()->items;
+            appendItems(out, items.data(), items.size(), rangeError);
+            return;
+        }
+
+        Value iterObj = call(getAttrValue(iterable, "__iter__"), {}, {}, nullptr);
+
+        if (!std::holds_alternative<Value::IteratorPtr>(iterObj.data)) {
+            throw std::runtime_error(
+                "__iter__ returned non-iterator"
+            );
+        }
+
+        const auto iterator = std::get<Value::IteratorPtr>(iterObj.data);
+
+        out.reserve(start + static_cast<qsizetype>(ListValue::lengthHint(iterable)));
+
+        while (iterator->hasNext()) {
+            out.append(byteOf(iterator->next(), rangeError));
+        }
+
+    } catch (...) {
+        // как в CPython: при ошибке bytearray.extend не меняет массив
+        out.truncate(start);
+        throw;
+    }
+}
+
 QByteArray constructBytesData(const std::vector<Value> &args, const Kwargs &kwargs) {
 
     std::optional<QString> encoding;
@@ -289,11 +788,9 @@ QByteArray constructBytesData(const std::vector<Value> &args, const Kwargs &kwar
             return obj.asByteArray("bytes")->bytes();
         }
 
-        try {
+        if (const std::optional<Value> bytesMethod = tryGetAttr(obj, "__bytes__")) {
 
-            Value bytesMethod = getAttrValue(obj, "__bytes__");
-
-            Value result = call(bytesMethod, {}, {}, nullptr);
+            Value result = call(*bytesMethod, {}, {}, nullptr);
 
             if (!result.isBytes()) {
 
@@ -303,15 +800,6 @@ QByteArray constructBytesData(const std::vector<Value> &args, const Kwargs &kwar
             }
 
             return result.asBytes()->bytes();
-
-        }
-        catch (const std::runtime_error& e) {
-
-            const std::string msg = e.what();
-
-            if (msg.find("AttributeError") == std::string::npos) {
-                throw;
-            }
         }
 
         if (obj.isString()) {
@@ -360,37 +848,7 @@ QByteArray constructBytesData(const std::vector<Value> &args, const Kwargs &kwar
         if (obj.isIterable() || supportsIter(obj)) {
 
             QByteArray result;
-
-            Value iterMethod = getAttrValue(obj, "__iter__");
-
-            Value iterObj = call(iterMethod, {}, {}, nullptr);
-
-            if (!std::holds_alternative<Value::IteratorPtr>(iterObj.data)) {
-                throw std::runtime_error(
-                    "__iter__ returned non-iterator"
-                );
-            }
-
-            auto iterator = std::get<Value::IteratorPtr>(iterObj.data);
-
-            while (iterator->hasNext()) {
-
-                Value item = iterator->next();
-
-                auto value = item.toBigInt();
-
-                if (value < 0 || value > 255) {
-                    throw std::runtime_error(
-                        "bytes must be in range(0, 256)"
-                    );
-                }
-
-                result.append(
-                    static_cast<char>(
-                        value.convert_to<int>()
-                    )
-                );
-            }
+            appendBytesFrom(result, obj, "ValueError: bytes must be in range(0, 256)");
 
             return result;
         }
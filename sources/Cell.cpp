@@ -0,0 +1,22 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "Cell.h"
+
+long Cell::gcRefCount() const {
+    return weak_from_this().use_count();
+}
+
+std::shared_ptr<GcObject> Cell::gcSelf() {
+    return shared_from_this();
+}
+
+void Cell::gcTraverse(const GcVisitor& visit) const {
+    if (value) {
+        gcVisitValue(*value, visit);
+    }
+}
+
+void Cell::gcClear() {
+    value.reset();
+}
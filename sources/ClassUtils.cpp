@@ -3,100 +3,303 @@
 //
 #include "ClassUtils.h"
 
+#include <algorithm>
+
+#include "BuiltinFunction.h"
 #include "CallRuntime.h"
 #include "ClassValue.h"
 #include "DescriptorUtils.h"
+#include "DictViewSetOps.h"
+#include "FileValue.h"
+#include "GeneratorValue.h"
 #include "../runtime/builtins/dict/DictMethods.h"
+#include "../runtime/builtins/file/FileMethods.h"
+#include "../runtime/builtins/generator/GeneratorMethods.h"
+#include "../runtime/builtins/int/IntMethods.h"
 #include "InstanceValue.h"
+#include "../runtime/builtins/io/MemoryIOMethods.h"
 #include "../runtime/builtins/iterator/IteratorMethods.h"
 #include "../runtime/builtins/list/ListMethods.h"
 #include "ListValue.h"
+#include "ObjectPool.h"
+#include "PyException.h"
+#include "InterpreterContext.h"
 #include "../runtime/builtins/set/SetMethods.h"
 #include "../runtime/builtins/str/StrMethods.h"
+#include "ArrayValue.h"
+#include "CachedFunctionValue.h"
+#include "CounterValue.h"
+#include "DefaultDictValue.h"
+#include "DequeValue.h"
+#include "FutureValue.h"
+#include "MemoryIOValue.h"
+#include "MemoryViewValue.h"
+#include "ModuleValue.h"
+#include "OrderedDictValue.h"
+#include "RegexValue.h"
+#include "SharedSegment.h"
+#include "StreamValue.h"
 #include "SuperValue.h"
+#include "VectorValue.h"
+#include "../runtime/builtins/array/ArrayMethods.h"
+#include "../runtime/builtins/asyncio/AsyncioMethods.h"
 #include "../runtime/builtins/bytearray/ByteArrayMethods.h"
 #include "../runtime/builtins/bytes/BytesMethods.h"
+#include "../runtime/builtins/collections/CollectionsDictMethods.h"
+#include "../runtime/builtins/deque/DequeMethods.h"
+#include "../runtime/builtins/functools/FunctoolsMethods.h"
 #include "../runtime/builtins/frozenset/FrozenSetMethods.h"
+#include "../runtime/builtins/memoryview/MemoryViewMethods.h"
+#include "../runtime/builtins/range/RangeMethods.h"
+#include "../runtime/builtins/re/RegexMethods.h"
 #include "../runtime/builtins/tuple/TupleMethods.h"
+#include "../runtime/builtins/vector/VectorMethods.h"
+#include "../runtime/ArgValidation.h"
 
 bool hasAttr(const Value::ClassPtr& cls, const QString& attr) {
-    try {
-        findAttrInHierarchy(cls, attr);
-        return true;
-    } catch (...) {
-        return false;
+    return findAttrInHierarchy(cls, attr).has_value();
+}
+
+QString typeName(const Value& obj) {
+
+    if (obj.isNone()) return "NoneType";
+    if (obj.isBool()) return "bool";
+    if (obj.isBigInt()) return "int";
+    if (obj.isBigFloat()) return obj.isDecimal() ? "decimal" : "float";
+    if (obj.isString()) return "str";
+    if (obj.isList()) return "list";
+    if (DefaultDictValue::of(obj)) return "defaultdict";
+    if (CounterValue::of(obj)) return "Counter";
+    if (OrderedDictValue::of(obj)) return "OrderedDict";
+    if (obj.isDict()) return "dict";
+    if (obj.isTuple()) return "tuple";
+    if (obj.isSet()) return "set";
+    if (obj.isFrozenSet()) return "frozenset";
+    if (obj.isBytes()) return "bytes";
+    if (obj.isByteArray()) return "bytearray";
+    if (obj.isRange()) return "range";
+    if (obj.isSlice()) return "slice";
+    if (obj.isFunction()) return "function";
+    if (obj.isBuiltinFunction()) return "builtin_function_or_method";
+    if (obj.isBoundMethod()) return "method";
+    if (obj.isClass()) return "type";
+    if (obj.isSuper()) return "super";
+    if (obj.isDictKeysView()) return "dict_keys";
+    if (obj.isDictValuesView()) return "dict_values";
+    if (obj.isDictItemsView()) return "dict_items";
+
+    if (const auto instance = std::get_if<Value::InstancePtr>(&obj.data)) {
+        return (*instance)->klass->name;
+    }
+
+    if (const auto iterator = std::get_if<Value::IteratorPtr>(&obj.data)) {
+        return (*iterator)->getTypeName();
+    }
+
+    if (ModuleValue::of(obj)) {
+        return "module";
+    }
+
+    if (MemoryViewValue::of(obj)) {
+        return "memoryview";
+    }
+
+    if (SharedBufferValue::of(obj)) {
+        return "shared_buffer";
+    }
+
+    if (DequeValue::of(obj)) {
+        return "deque";
+    }
+
+    if (PatternValue::of(obj)) {
+        return "re.Pattern";
+    }
+
+    if (MatchValue::of(obj)) {
+        return "re.Match";
     }
+
+    if (ArrayValue::of(obj)) {
+        return "array";
+    }
+
+    if (VectorValue::of(obj)) {
+        return "vector";
+    }
+
+    if (CachedFunctionValue::of(obj)) {
+        return "functools._lru_cache_wrapper";
+    }
+
+    if (CacheInfoValue::of(obj)) {
+        return "CacheInfo";
+    }
+
+    if (const FutureValue* future = FutureValue::of(obj)) {
+        return future->className();
+    }
+
+    if (StreamReaderValue::of(obj)) {
+        return "StreamReader";
+    }
+
+    if (StreamWriterValue::of(obj)) {
+        return "StreamWriter";
+    }
+
+    return "object";
 }
 
-Value genericGetAttr(const Value& obj, const QString& attr) {
+namespace {
 
-    // instance
-    if (std::holds_alternative<Value::InstancePtr>(obj.data)) {
+    std::string missingAttribute(const Value& obj, const QString& attr) {
 
-        auto instance = std::get<Value::InstancePtr>(obj.data);
-        auto cls = instance->klass;
+        if (const auto cls = std::get_if<Value::ClassPtr>(&obj.data)) {
+            return "type object '" + (*cls)->name.toStdString() + "' has no attribute '" + attr.toStdString() + "'";
+        }
 
-        //  1. data descriptor (hasSet)
-        try {
+        if (const ModuleValue* module = ModuleValue::of(obj)) {
+            return "module '" + module->moduleName().toStdString() + "' has no attribute '" + attr.toStdString() + "'";
+        }
+
+        return "'" + typeName(obj).toStdString() + "' object has no attribute '" + attr.toStdString() + "'";
+    }
 
-            Value val = findAttrInHierarchy(cls, attr);
+    /// атрибут из MRO получателя после originClass
+    std::optional<Value> findInSuper(const Value::SuperPtr& super, const QString& attr) {
 
-            if (DescriptorUtils::hasGet(val) && DescriptorUtils::hasSet(val)) {
-                return DescriptorUtils::callGet(val, Value(instance), cls);
-            }
+        const std::optional<ClassValue::SuperAttr> found =
+            findSuperAttr(getObjectClass(super->receiver), super->originClass, attr);
 
-        } catch (const std::runtime_error& e) {
+        if (!found) {
+            return std::nullopt;
+        }
 
-            const std::string msg = e.what();
+        const Value& val = found->attr.value;
 
-            if (msg.find("Attribute not found") == std::string::npos) {
-                throw;
-            }
+        // classmethod связывается с классом получателя, а не с предком, где он найден
+        if (val.isClassMethod()) {
+            return DescriptorUtils::callGet(val, Value(super->receiver), getObjectClass(super->receiver));
         }
 
-        // 2. instance fields
-        if (instance->fields.contains(attr)) {
-            return instance->fields[attr];
+        if (found->attr.getter) {
+            return DescriptorUtils::callGet(val, Value(super->receiver), found->owner);
         }
 
-        // 3. non-data descriptor | class attribute
-        try {
+        // встроенный метод класса, например BaseException.__init__, получает self первым аргументом
+        const auto builtin = std::get_if<Value::BuiltinFunctionPtr>(&val.data);
+        const auto instance = std::get_if<Value::InstancePtr>(&super->receiver.data);
+
+        if (builtin && instance) {
+            return (*builtin)->get(*instance, found->owner);
+        }
 
-            Value val = findAttrInHierarchy(cls, attr);
+        return val;
+    }
 
-            if (DescriptorUtils::hasGet(val)) {
-                return DescriptorUtils::callGet(val, Value(instance), cls);
-            }
+    /// встроенный метод object.__getattribute__ или object.__setattr__, который можно обойти прямым поиском
+    bool isDefaultHook(const Value& hook, const QString& builtinName) {
 
-            return val;
+        const auto builtin = std::get_if<Value::BuiltinFunctionPtr>(&hook.data);
 
-        } catch (const std::runtime_error& e) {
+        return builtin && (*builtin)->name == builtinName;
+    }
+}
 
-            const std::string msg = e.what();
+std::optional<Value> tryGenericGetAttr(const Value& obj, const QString& attr) {
 
-            if (msg.find("Attribute not found") == std::string::npos) {
-                throw;
-            }
+    // instance
+    if (std::holds_alternative<Value::InstancePtr>(obj.data)) {
+
+        auto instance = std::get<Value::InstancePtr>(obj.data);
+        auto cls = instance->klass;
+
+        // поиск по MRO и роль атрибута в протоколе дескрипторов берутся из кэша класса
+        const std::optional<ClassValue::Attr> classAttr = findClassAttr(cls, attr);
+
+        //  1. data descriptor
+        if (classAttr && classAttr->getter && classAttr->setter) {
+            return DescriptorUtils::callGet(classAttr->value, Value(instance), cls);
+        }
+
+        // 2. instance fields
+        if (const Value* field = instance->findField(attr)) {
+            return *field;
         }
+
+        // 3. non-data descriptor | class attribute
+        if (!classAttr) {
+            return std::nullopt;
+        }
+
+        return classAttr->getter ? DescriptorUtils::callGet(classAttr->value, Value(instance), cls) : classAttr->value;
     }
 
     // super
     if (std::holds_alternative<Value::SuperPtr>(obj.data)) {
-        auto super = std::get<Value::SuperPtr>(obj.data);
-        return getAttrFromSuper(super, attr);
+        return findInSuper(std::get<Value::SuperPtr>(obj.data), attr);
     }
 
     // class
     if (std::holds_alternative<Value::ClassPtr>(obj.data)) {
         auto cls = std::get<Value::ClassPtr>(obj.data);
 
-        Value val = findAttrInHierarchy(cls, attr);
+        const std::optional<ClassValue::Attr> val = findClassAttr(cls, attr);
 
-        if (DescriptorUtils::hasGet(val)) {
-            return DescriptorUtils::callGet(val, Value(), cls);
+        if (!val) {
+            return std::nullopt;
         }
 
-        return val;
+        return val->getter ? DescriptorUtils::callGet(val->value, Value(), cls) : val->value;
+    }
+
+    if (const ModuleValue* module = ModuleValue::of(obj)) {
+        return module->findAttr(attr);
+    }
+
+    if (MemoryViewValue::of(obj)) {
+        return getMemoryViewAttr(obj, attr);
+    }
+
+    if (DequeValue::of(obj)) {
+        return getDequeAttr(obj, attr);
+    }
+
+    if (PatternValue::of(obj)) {
+        return getPatternAttr(obj, attr);
+    }
+
+    if (MatchValue::of(obj)) {
+        return getMatchAttr(obj, attr);
+    }
+
+    if (ArrayValue::of(obj)) {
+        return getArrayAttr(obj, attr);
+    }
+
+    if (VectorValue::of(obj)) {
+        return getVectorAttr(obj, attr);
+    }
+
+    if (CachedFunctionValue::of(obj)) {
+        return getCachedFunctionAttr(obj, attr);
+    }
+
+    if (CacheInfoValue::of(obj)) {
+        return getCacheInfoAttr(obj, attr);
+    }
+
+    if (FutureValue::of(obj)) {
+        return getFutureAttr(obj, attr);
+    }
+
+    if (StreamReaderValue::of(obj)) {
+        return getStreamReaderAttr(obj, attr);
+    }
+
+    if (StreamWriterValue::of(obj)) {
+        return getStreamWriterAttr(obj, attr);
     }
 
     if (obj.isList()) {
@@ -104,30 +307,40 @@ Value genericGetAttr(const Value& obj, const QString& attr) {
     }
 
     if (obj.isDict()) {
-        return getDictAttr(obj, attr);
-    }
 
-    if (obj.isDictKeysView()) {
+        if (DefaultDictValue::of(obj)) {
+            return getDefaultDictAttr(obj, attr);
+        }
 
-        if (attr == "__iter__") {
-            return makeIterMethod(obj);
+        if (CounterValue::of(obj)) {
+            return getCounterAttr(obj, attr);
+        }
+
+        if (OrderedDictValue::of(obj)) {
+            return getOrderedDictAttr(obj, attr);
         }
 
+        return getDictAttr(obj, attr);
     }
 
-    if (obj.isDictValuesView()) {
+    if (obj.isDictKeysView() || obj.isDictValuesView() || obj.isDictItemsView()) {
 
         if (attr == "__iter__") {
             return makeIterMethod(obj);
         }
 
-    }
-
-    if (obj.isDictItemsView()) {
+        if (attr == "isdisjoint" && dictviews::isSetLike(obj)) {
 
-        if (attr == "__iter__") {
-            return makeIterMethod(obj);
+            return Value(makePooled<BuiltinFunction>(
+                "isdisjoint",
+                [obj](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+                    expectArgs(args, 1, "isdisjoint");
+                    return Value(dictviews::isDisjoint(obj, args[0]));
+                }
+            ));
         }
+
+        return std::nullopt;
     }
 
     if (obj.isTuple()) {
@@ -138,8 +351,24 @@ Value genericGetAttr(const Value& obj, const QString& attr) {
         return getSetAttr(obj, attr);
     }
 
+    if (const auto iterator = std::get_if<Value::IteratorPtr>(&obj.data)) {
+
+        if (dynamic_cast<const GeneratorValue*>(iterator->get())) {
+            return getGeneratorAttr(obj, attr);
+        }
+
+        if (dynamic_cast<const FileValue*>(iterator->get())) {
+            return getFileAttr(obj, attr);
+        }
+
+        if (dynamic_cast<const StringIOValue*>(iterator->get())) {
+            return getStringIOAttr(obj, attr);
+        }
+
+        if (dynamic_cast<const BytesIOValue*>(iterator->get())) {
+            return getBytesIOAttr(obj, attr);
+        }
 
-    if (std::holds_alternative<Value::IteratorPtr>(obj.data)) {
         return getIteratorAttr(obj, attr);
     }
 
@@ -159,14 +388,30 @@ Value genericGetAttr(const Value& obj, const QString& attr) {
         return getFrozenSetAttr(obj, attr);
     }
 
-    throw std::runtime_error("AttributeError: object has no attribute '" +
-                            attr.toStdString() + "'");
+    if (obj.isRange()) {
+        return getRangeAttr(obj, attr);
+    }
+
+    if (obj.isSmallInt() || obj.isBigInt() || obj.isBool()) {
+        return getIntAttr(obj, attr);
+    }
+
+    return std::nullopt;
+}
+
+Value genericGetAttr(const Value& obj, const QString& attr) {
+
+    if (std::optional<Value> value = tryGenericGetAttr(obj, attr)) {
+        return std::move(*value);
+    }
+
+    throw AttributeErrorException(missingAttribute(obj, attr));
 }
 
 Value makeIterMethod(const Value& obj) {
 
     return Value(
-        std::make_shared<BuiltinFunction>(
+        makePooled<BuiltinFunction>(
             "__iter__",
 
             [obj](const std::vector<Value>& args,
@@ -184,117 +429,205 @@ Value makeIterMethod(const Value& obj) {
     );
 }
 
-Value getAttrValue(const Value& obj, const QString& attr) {
-
-    // super bypasses __getattribute__
-    if (std::holds_alternative<Value::SuperPtr>(obj.data)) {
-        return genericGetAttr(obj, attr);
+/**
+ * Промах на стандартном пути — пустой optional без исключения. Исключение возможно
+ * только из пользовательских `__getattribute__` и `__getattr__`: их AttributeError
+ * тоже означает промах.
+ */
+std::optional<Value> tryGetAttr(const Value& obj, const QString& attr) {
+
+    // __getattribute__ и __getattr__ бывают только у экземпляров и классов:
+    // у встроенных значений и super атрибут ищется сразу
+    if (!std::holds_alternative<Value::InstancePtr>(obj.data) &&
+        !std::holds_alternative<Value::ClassPtr>(obj.data)) {
+        return tryGenericGetAttr(obj, attr);
     }
 
     // instance/class custom __getattribute__
-    try {
+    if (const std::optional<Value> getattribute = tryGenericGetAttr(obj, "__getattribute__");
+        getattribute && !isDefaultHook(*getattribute, "__object_getattribute__")) {
 
-        Value getattribute = genericGetAttr(obj, "__getattribute__");
+        try {
+            return call(*getattribute, { Value(attr) }, {}, nullptr);
+        } catch (const AttributeErrorException&) {}
+    }
 
-        // builtin object.__getattribute__
+    // default lookup
+    if (std::optional<Value> value = tryGenericGetAttr(obj, attr)) {
+        return value;
+    }
 
-        bool isDefault = false;
+    // __getattr__ класса относится к его экземплярам
+    if (std::holds_alternative<Value::ClassPtr>(obj.data)) {
+        return std::nullopt;
+    }
 
-        if (std::holds_alternative<Value::BuiltinFunctionPtr>(getattribute.data)) {
+    // __getattr__
+    if (const std::optional<Value> getattr = tryGenericGetAttr(obj, "__getattr__")) {
 
-            const auto builtin =
-                std::get<Value::BuiltinFunctionPtr>(getattribute.data);
+        try {
+            return call(*getattr, { Value(attr) }, {}, nullptr);
+        } catch (const AttributeErrorException&) {}
+    }
 
-            isDefault = (builtin->name == "__object_getattribute__");
-        }
+    return std::nullopt;
+}
 
-        if (!isDefault) {
-            return call(getattribute, { Value(attr) }, {}, nullptr);
-        }
+Value getAttrValue(const Value& obj, const QString& attr) {
 
-    } catch (const std::runtime_error& e) {
+    if (std::optional<Value> value = tryGetAttr(obj, attr)) {
+        return std::move(*value);
+    }
 
-        const std::string msg = e.what();
+    throw AttributeErrorException(missingAttribute(obj, attr));
+}
 
-        if (msg.find("AttributeError") == std::string::npos) {
-            throw;
-        }
+Value getAttrFromSuper(const Value::SuperPtr& super, const QString& attr) {
+
+    if (std::optional<Value> value = findInSuper(super, attr)) {
+        return std::move(*value);
     }
 
-    // default lookup
-    try {
-        return genericGetAttr(obj, attr);
+    throw AttributeErrorException(missingAttribute(Value(super), attr));
+}
+
+const std::vector<Value::ClassPtr>& getMRO(const Value::ClassPtr& cls) {
+
+    if (cls->mroReady) {
+        return cls->mro;
     }
-    catch (const std::runtime_error& e) {
 
-        const std::string msg = e.what();
+    // C3: L[C] = C + merge(L[B1], ..., L[Bn], [B1, ..., Bn])
+    std::vector<std::vector<Value::ClassPtr>> sequences;
 
-        // только если attr реально не найден
-        if (msg.find("AttributeError") == std::string::npos) {
-            throw;
-        }
+    for (const auto& base : cls->bases) {
+        std::vector<Value::ClassPtr> linearization { base };
+        const auto& baseMRO = getMRO(base);
+        linearization.insert(linearization.end(), baseMRO.begin(), baseMRO.end());
+        sequences.push_back(std::move(linearization));
     }
 
-    // __getattr__
-    try {
+    sequences.push_back(cls->bases);
 
-        Value getattr = genericGetAttr(obj, "__getattr__");
+    std::vector<Value::ClassPtr> result;
 
-        return call(getattr, { Value(attr) }, {}, nullptr);
+    while (true) {
 
-    } catch (const std::runtime_error& e) {
+        sequences.erase(std::remove_if(sequences.begin(), sequences.end(),
+                                       [](const auto& seq) { return seq.empty(); }),
+                        sequences.end());
 
-        const std::string msg = e.what();
+        if (sequences.empty()) {
+            break;
+        }
+
+        // голова, не встречающаяся в хвосте ни одной из последовательностей
+        Value::ClassPtr candidate;
+
+        for (const auto& seq : sequences) {
+
+            const bool inTail = std::any_of(sequences.begin(), sequences.end(), [&](const auto& other) {
+                return std::find(other.begin() + 1, other.end(), seq.front()) != other.end();
+            });
 
-        if (msg.find("AttributeError") == std::string::npos) {
-            throw;
+            if (!inTail) {
+                candidate = seq.front();
+                break;
+            }
+        }
+
+        if (!candidate) {
+            QStringList names;
+
+            for (const auto& base : cls->bases) {
+                names << base->name;
+            }
+
+            throw std::runtime_error("TypeError: Cannot create a consistent method resolution order (MRO) "
+                                     "for bases " + names.join(", ").toStdString());
+        }
+
+        result.push_back(candidate);
+
+        for (auto& seq : sequences) {
+            if (seq.front() == candidate) {
+                seq.erase(seq.begin());
+            }
         }
     }
 
-    throw std::runtime_error(
-        "AttributeError: object has no attribute '" +
-        attr.toStdString() + "'"
-    );
+    cls->mro = std::move(result);
+    cls->mroReady = true;
+
+    return cls->mro;
 }
 
-Value getAttrFromSuper(const Value::SuperPtr& super, const QString& attr) {
-    std::vector<Value::ClassPtr> mro;
-    buildMRO(getObjectClass(super->receiver), mro);
+void initSlots(const Value::ClassPtr& cls) {
 
-    bool foundOrigin = false;
+    const auto declared = cls->attributes.constFind("__slots__");
 
-    for (const auto& cls : mro) {
+    if (declared == cls->attributes.cend()) {
+        return;
+    }
 
-        if (!foundOrigin) {
-            if (cls == super->originClass) {
-                foundOrigin = true;
-            }
+    // без словаря экземпляры остаются, только если __slots__ объявлен по всей иерархии
+    QSet<QString> names;
 
+    for (const auto& base : getMRO(cls)) {
+
+        if (base == InterpreterContext::current().objectClass) {
             continue;
         }
 
-        if (cls->attributes.contains(attr)) {
+        if (!base->slotNames) {
+            return;
+        }
+
+        names.unite(*base->slotNames);
+    }
 
-            Value val = cls->attributes[attr];
+    std::vector<Value> items;
+    const Value& spec = declared.value();
 
-            if (DescriptorUtils::hasGet(val)) {
-                return DescriptorUtils::callGet(val, Value(super->receiver), cls);
-            }
+    if (spec.isString()) {
+        items.push_back(spec);
+    } else {
+        const Value iterator = getIter(spec, nullptr);
+        Value item;
+
+        while (iterNext(iterator, item, nullptr)) {
+            items.push_back(item);
+        }
+    }
+
+    for (const auto& item : items) {
+
+        if (!item.isString()) {
+            throw std::runtime_error("TypeError: __slots__ items must be strings");
+        }
 
-            return val;
+        const QString name = item.toString();
+
+        if (name == "__dict__") {
+            return;
+        }
+
+        if (cls->attributes.contains(name)) {
+            throw std::runtime_error("ValueError: '" + name.toStdString() +
+                                     "' in __slots__ conflicts with class variable");
         }
+
+        names.insert(name);
     }
 
-    throw std::runtime_error("AttributeError: object has no attribute '" +
-                            attr.toStdString() + "'");
+    cls->slotNames = std::move(names);
 }
 
 void buildMRO(const Value::ClassPtr& cls, std::vector<Value::ClassPtr>& out) {
     out.push_back(cls);
 
-    for (const auto& base : cls->bases) {
-        buildMRO(base, out);
-    }
+    const auto& mro = getMRO(cls);
+    out.insert(out.end(), mro.begin(), mro.end());
 }
 
 Value::ClassPtr getObjectClass(const Value& obj)
@@ -310,26 +643,103 @@ Value::ClassPtr getObjectClass(const Value& obj)
     throw std::runtime_error("super(): invalid receiver");
 }
 
-Value findAttrInHierarchy(const Value::ClassPtr& cls, const QString& attr) {
-    if (cls->attributes.contains(attr)) {
-        return cls->attributes[attr];
+namespace {
+
+    /// кэши поиска класса действительны до первой записи атрибута в любой класс
+    void validateCaches(ClassValue& cls) {
+
+        if (cls.cacheVersion != ClassValue::attributesVersion) {
+            cls.lookupCache.clear();
+            cls.superCache.clear();
+            cls.cacheVersion = ClassValue::attributesVersion;
+        }
+    }
+
+    ClassValue::Attr classify(const Value& value) {
+        return {value, DescriptorUtils::hasGet(value), DescriptorUtils::hasSet(value)};
+    }
+}
+
+std::optional<ClassValue::Attr> findClassAttr(const Value::ClassPtr& cls, const QString& attr) {
+
+    validateCaches(*cls);
+
+    if (const auto cached = cls->lookupCache.constFind(attr); cached != cls->lookupCache.cend()) {
+        return cached.value();
     }
 
-    for (const auto& base : cls->bases) {
-        try {
-            return findAttrInHierarchy(base, attr);
+    const Value* found = nullptr;
 
-        } catch (const std::runtime_error& e) {
+    if (const auto own = cls->attributes.constFind(attr); own != cls->attributes.cend()) {
+        found = &own.value();
+    } else {
 
-            const std::string msg = e.what();
+        for (const auto& base : getMRO(cls)) {
 
-            if (msg.find("Attribute not found") == std::string::npos) {
-                throw;
+            if (const auto inherited = base->attributes.constFind(attr); inherited != base->attributes.cend()) {
+                found = &inherited.value();
+                break;
             }
         }
     }
 
-    throw std::runtime_error("Attribute not found: " + attr.toStdString());
+    std::optional<ClassValue::Attr> result;
+
+    if (found) {
+        result = classify(*found);
+    }
+
+    cls->lookupCache.insert(attr, result);
+
+    return result;
+}
+
+std::optional<ClassValue::SuperAttr> findSuperAttr(const Value::ClassPtr& receiverClass,
+                                                   const Value::ClassPtr& originClass,
+                                                   const QString& attr) {
+
+    validateCaches(*receiverClass);
+
+    const QPair<const ClassValue*, QString> key(originClass.get(), attr);
+
+    if (const auto cached = receiverClass->superCache.constFind(key); cached != receiverClass->superCache.cend()) {
+        return cached.value();
+    }
+
+    const std::vector<Value::ClassPtr>& mro = getMRO(receiverClass);
+
+    // поиск начинается с класса, следующего за originClass в MRO получателя
+    auto it = mro.begin();
+
+    if (receiverClass != originClass) {
+        it = std::find(mro.begin(), mro.end(), originClass);
+
+        if (it != mro.end()) {
+            ++it;
+        }
+    }
+
+    std::optional<ClassValue::SuperAttr> result;
+
+    for (; it != mro.end(); ++it) {
+        if (const auto found = (*it)->attributes.constFind(attr); found != (*it)->attributes.cend()) {
+            result = ClassValue::SuperAttr{classify(found.value()), *it};
+            break;
+        }
+    }
+
+    receiverClass->superCache.insert(key, result);
+
+    return result;
+}
+
+std::optional<Value> findAttrInHierarchy(const Value::ClassPtr& cls, const QString& attr) {
+
+    if (std::optional<ClassValue::Attr> found = findClassAttr(cls, attr)) {
+        return std::move(found->value);
+    }
+
+    return std::nullopt;
 }
 
 void genericSetAttr(const Value& obj, const QString& attr, const Value& value) {
@@ -339,33 +749,31 @@ void genericSetAttr(const Value& obj, const QString& attr, const Value& value) {
         const auto cls = instance->klass;
 
         // 1. проверяем descriptor в классе
-        try {
-
-            const Value descr = findAttrInHierarchy(cls, attr);
-
-            if (DescriptorUtils::hasSet(descr)) {
-                DescriptorUtils::callSet(descr, Value(instance), cls, value);
-                return;
-            }
-
-        } catch (const std::runtime_error& e) {
-
-            const std::string msg = e.what();
+        if (const std::optional<ClassValue::Attr> descr = findClassAttr(cls, attr); descr && descr->setter) {
+            DescriptorUtils::callSet(descr->value, Value(instance), cls, value);
+            return;
+        }
 
-            if (msg.find("Attribute not found") == std::string::npos) {
-                throw;
-            }
+        // 2. обычная запись в поля; класс с __slots__ принимает только объявленные имена
+        if (cls->slotNames && !cls->slotNames->contains(attr)) {
+            throw AttributeErrorException("'" + cls->name.toStdString() +
+                                          "' object has no attribute '" + attr.toStdString() + "'");
         }
 
-        // 2. обычная запись в поля
-        instance->fields[attr] = value;
+        instance->setField(attr, value);
         return;
     }
 
     // class
     if (std::holds_alternative<Value::ClassPtr>(obj.data)) {
         const auto cls = std::get<Value::ClassPtr>(obj.data);
-        cls->attributes[attr] = value;
+        cls->setAttribute(attr, value);
+        return;
+    }
+
+    // module: запись в глобальные переменные модуля
+    if (const ModuleValue* module = ModuleValue::of(obj)) {
+        module->setAttr(attr, value);
         return;
     }
 
@@ -380,37 +788,11 @@ void setAttrValue(const Value& obj, const QString& attr, const Value& value) {
         return;
     }
 
-    try {
-
-        Value setattr =
-            genericGetAttr(obj, "__setattr__");
-
-        bool isDefault = false;
-
-        if (std::holds_alternative<Value::BuiltinFunctionPtr>(
-                setattr.data)) {
-
-            const auto builtin =
-                std::get<Value::BuiltinFunctionPtr>(
-                    setattr.data);
-
-            isDefault = builtin->name == "__object_setattr__";
-                }
-
-        if (!isDefault) {
+    if (const std::optional<Value> setattr = tryGenericGetAttr(obj, "__setattr__");
+        setattr && !isDefaultHook(*setattr, "__object_setattr__")) {
 
-            call(setattr, { Value(attr), value }, {}, nullptr);
-
-            return;
-        }
-
-    } catch (const std::runtime_error& e) {
-
-        const std::string msg = e.what();
-
-        if (msg.find("AttributeError") == std::string::npos) {
-            throw;
-        }
+        call(*setattr, { Value(attr), value }, {}, nullptr);
+        return;
     }
 
     genericSetAttr(obj, attr, value);
@@ -1,8 +1,60 @@
 #include "ClassValue.h"
+
+#include "FunctionValue.h"
 //
 // Created by semyo on 05.05.2026.
 //
+std::uint64_t ClassValue::attributesVersion = 1;
+
 QString ClassValue::toString() const {
     return QString("<class '%1.%2'>")
         .arg("__main__", name);
-}
\ No newline at end of file
+}
+
+long ClassValue::gcRefCount() const {
+    return weak_from_this().use_count();
+}
+
+std::shared_ptr<GcObject> ClassValue::gcSelf() {
+    return shared_from_this();
+}
+
+void ClassValue::gcTraverse(const GcVisitor& visit) const {
+
+    for (const auto& value : attributes) {
+        gcVisitValue(value, visit);
+    }
+
+    for (const auto& base : bases) {
+        visit(base.get());
+    }
+
+    for (const auto& ancestor : mro) {
+        visit(ancestor.get());
+    }
+
+    for (const auto& cached : lookupCache) {
+        if (cached) {
+            gcVisitValue(cached->value, visit);
+        }
+    }
+
+    for (const auto& cached : superCache) {
+        if (cached) {
+            gcVisitValue(cached->attr.value, visit);
+            visit(cached->owner.get());
+        }
+    }
+
+    visit(construction.init.get());
+}
+
+void ClassValue::gcClear() {
+    attributes.clear();
+    bases.clear();
+    mro.clear();
+    mroReady = false;
+    lookupCache.clear();
+    superCache.clear();
+    construction = {};
+}
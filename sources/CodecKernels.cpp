@@ -0,0 +1,398 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "CodecKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace codeckernels {
+
+    namespace {
+
+        /// метка символа вне алфавита в таблицах разбора
+        constexpr std::uint8_t invalid = 0xff;
+
+        constexpr char digits[] = "0123456789abcdef";
+
+        /// пары hex-цифр всех байтов в типе символов результата
+        template<typename Char>
+        const std::array<std::array<Char, 2>, 256>& hexPairs() {
+
+            static const auto table = [] {
+                std::array<std::array<Char, 2>, 256> pairs{};
+                for (int byte = 0; byte < 256; ++byte) {
+                    pairs[byte] = {Char(digits[byte >> 4]), Char(digits[byte & 0xf])};
+                }
+                return pairs;
+            }();
+
+            return table;
+        }
+
+        /// значения hex-цифр; остальные байты — invalid
+        const std::array<std::uint8_t, 256> hexValues = [] {
+
+            std::array<std::uint8_t, 256> values{};
+            values.fill(invalid);
+
+            for (int i = 0; i < 10; ++i) {
+                values['0' + i] = static_cast<std::uint8_t>(i);
+            }
+
+            for (int i = 0; i < 6; ++i) {
+                values['a' + i] = values['A' + i] = static_cast<std::uint8_t>(10 + i);
+            }
+
+            return values;
+        }();
+
+        template<typename Char>
+        std::uint8_t hexValue(const Char c) {
+            const auto code = static_cast<std::make_unsigned_t<Char>>(c);
+            return code < 0x100 ? hexValues[code] : invalid;
+        }
+
+        /// пробельные символы bytes.isspace(): между парами fromhex() их можно ставить
+        template<typename Char>
+        bool isSpace(const Char c) {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        template<typename Char>
+        void encodeHex(const unsigned char* data, const qsizetype size, Char* dst,
+                       const Char sep, const qsizetype bytesPerSep) {
+
+            const auto& pairs = hexPairs<Char>();
+
+            const auto encode = [&](const qsizetype from, const qsizetype to) {
+                for (qsizetype i = from; i < to; ++i, dst += 2) {
+                    std::memcpy(dst, pairs[data[i]].data(), 2 * sizeof(Char));
+                }
+            };
+
+            if (sep == 0 || bytesPerSep == 0) {
+                encode(0, size);
+                return;
+            }
+
+            const qsizetype group = bytesPerSep < 0 ? -bytesPerSep : bytesPerSep;
+
+            // при счёте справа неполной оказывается первая группа, слева — последняя
+            qsizetype end = bytesPerSep > 0 ? (size - 1) % group + 1 : std::min(group, size);
+            qsizetype start = 0;
+
+            for (;;) {
+
+                encode(start, end);
+
+                if (end == size) {
+                    return;
+                }
+
+                *dst++ = sep;
+                start = end;
+                end = std::min(end + group, size);
+            }
+        }
+
+        template<typename Char>
+        qsizetype hexLength(const qsizetype size, const Char sep, const qsizetype bytesPerSep) {
+
+            if (size == 0) {
+                return 0;
+            }
+
+            if (sep == 0 || bytesPerSep == 0) {
+                return 2 * size;
+            }
+
+            const qsizetype group = bytesPerSep < 0 ? -bytesPerSep : bytesPerSep;
+
+            return 2 * size + (size - 1) / group;
+        }
+
+        /// пар за шаг блочного разбора
+        constexpr qsizetype hexBlock = 8;
+
+        template<typename Char>
+        qsizetype decodeHex(const Char* text, const qsizetype size, QByteArray& out, const bool skipSpaces) {
+
+            out = QByteArray(size / 2, Qt::Uninitialized);
+            auto* dst = reinterpret_cast<unsigned char*>(out.data());
+            qsizetype written = 0;
+            qsizetype i = 0;
+
+            while (i < size) {
+
+                // блок из восьми пар без пробелов и ошибок: одна проверка на весь блок
+                if (i + 2 * hexBlock <= size) {
+
+                    std::uint8_t seen = 0;
+
+                    for (qsizetype k = 0; k < hexBlock; ++k) {
+                        const std::uint8_t high = hexValue(text[i + 2 * k]);
+                        const std::uint8_t low = hexValue(text[i + 2 * k + 1]);
+                        seen |= high | low;
+                        dst[written + k] = static_cast<unsigned char>(high << 4 | (low & 0xf));
+                    }
+
+                    if ((seen & 0xf0) == 0) {
+                        i += 2 * hexBlock;
+                        written += hexBlock;
+                        continue;
+                    }
+                }
+
+                // пробел, ошибка или хвост — одна пара посимвольно
+                if (skipSpaces && isSpace(text[i])) {
+
+                    while (i < size && isSpace(text[i])) {
+                        ++i;
+                    }
+
+                    continue;
+                }
+
+                const std::uint8_t high = hexValue(text[i]);
+
+                if (high == invalid) {
+                    return i;
+                }
+
+                if (i + 1 >= size) {
+                    return size;
+                }
+
+                const std::uint8_t low = hexValue(text[i + 1]);
+
+                if (low == invalid) {
+                    return i + 1;
+                }
+
+                dst[written++] = static_cast<unsigned char>(high << 4 | low);
+                i += 2;
+            }
+
+            out.truncate(written);
+
+            return -1;
+        }
+
+        constexpr char standardAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        constexpr char urlSafeAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+        std::array<std::uint8_t, 256> base64Values(const Alphabet alphabet) {
+
+            std::array<std::uint8_t, 256> values{};
+            values.fill(invalid);
+
+            for (int i = 0; i < 64; ++i) {
+                values[static_cast<unsigned char>(standardAlphabet[i])] = static_cast<std::uint8_t>(i);
+            }
+
+            if (alphabet == Alphabet::UrlSafe) {
+                values['-'] = 62;
+                values['_'] = 63;
+            }
+
+            return values;
+        }
+
+        const std::array<std::uint8_t, 256>& base64Table(const Alphabet alphabet) {
+
+            static const auto standard = base64Values(Alphabet::Standard);
+            static const auto urlSafe = base64Values(Alphabet::UrlSafe);
+
+            return alphabet == Alphabet::UrlSafe ? urlSafe : standard;
+        }
+    }
+
+    QString toHex(const QByteArrayView data, const char16_t sep, const qsizetype bytesPerSep) {
+
+        QString result(hexLength(data.size(), sep, bytesPerSep), Qt::Uninitialized);
+
+        encodeHex(reinterpret_cast<const unsigned char*>(data.data()), data.size(),
+                  reinterpret_cast<char16_t*>(result.data()), sep, bytesPerSep);
+
+        return result;
+    }
+
+    QByteArray toHexBytes(const QByteArrayView data, const char sep, const qsizetype bytesPerSep) {
+
+        QByteArray result(hexLength(data.size(), sep, bytesPerSep), Qt::Uninitialized);
+
+        encodeHex(reinterpret_cast<const unsigned char*>(data.data()), data.size(), result.data(), sep, bytesPerSep);
+
+        return result;
+    }
+
+    qsizetype fromHex(const QStringView text, QByteArray& out, const bool skipSpaces) {
+        return decodeHex(text.utf16(), text.size(), out, skipSpaces);
+    }
+
+    qsizetype fromHex(const QByteArrayView text, QByteArray& out, const bool skipSpaces) {
+        return decodeHex(reinterpret_cast<const unsigned char*>(text.data()), text.size(), out, skipSpaces);
+    }
+
+    QByteArray toBase64(const QByteArrayView data, const Alphabet alphabet, const bool newline) {
+
+        const char* letters = alphabet == Alphabet::UrlSafe ? urlSafeAlphabet : standardAlphabet;
+        const auto* src = reinterpret_cast<const unsigned char*>(data.data());
+        const qsizetype size = data.size();
+
+        QByteArray result((size + 2) / 3 * 4 + (newline ? 1 : 0), Qt::Uninitialized);
+        char* dst = result.data();
+
+        qsizetype i = 0;
+
+        for (; i + 3 <= size; i += 3, dst += 4) {
+
+            const std::uint32_t triple = src[i] << 16 | src[i + 1] << 8 | src[i + 2];
+
+            dst[0] = letters[triple >> 18];
+            dst[1] = letters[triple >> 12 & 0x3f];
+            dst[2] = letters[triple >> 6 & 0x3f];
+            dst[3] = letters[triple & 0x3f];
+        }
+
+        if (const qsizetype rest = size - i; rest > 0) {
+
+            const std::uint32_t triple = src[i] << 16 | (rest == 2 ? src[i + 1] << 8 : 0);
+
+            dst[0] = letters[triple >> 18];
+            dst[1] = letters[triple >> 12 & 0x3f];
+            dst[2] = rest == 2 ? letters[triple >> 6 & 0x3f] : '=';
+            dst[3] = '=';
+            dst += 4;
+        }
+
+        if (newline) {
+            *dst = '\n';
+        }
+
+        return result;
+    }
+
+    std::optional<QByteArray> fromBase64(const QByteArrayView text, const Alphabet alphabet,
+                                         const bool strict, std::string& error) {
+
+        const auto& table = base64Table(alphabet);
+        const auto* src = reinterpret_cast<const unsigned char*>(text.data());
+        const qsizetype size = text.size();
+
+        if (strict && size > 0 && src[0] == '=') {
+            error = "Leading padding not allowed";
+            return std::nullopt;
+        }
+
+        QByteArray out(size / 4 * 3 + 3, Qt::Uninitialized);
+        auto* dst = reinterpret_cast<unsigned char*>(out.data());
+        qsizetype written = 0;
+
+        // позиция в четвёрке символов и ещё не выведенные биты
+        int quad = 0;
+        std::uint32_t pending = 0;
+        int pads = 0;
+        bool padding = false;
+
+        for (qsizetype i = 0; i < size; ++i) {
+
+            // целая четвёрка символов алфавита — три байта за один шаг
+            if (quad == 0 && !padding && i + 4 <= size) {
+
+                const std::uint32_t a = table[src[i]];
+                const std::uint32_t b = table[src[i + 1]];
+                const std::uint32_t c = table[src[i + 2]];
+                const std::uint32_t d = table[src[i + 3]];
+
+                if ((a | b | c | d) < 64) {
+
+                    const std::uint32_t triple = a << 18 | b << 12 | c << 6 | d;
+
+                    dst[written] = static_cast<unsigned char>(triple >> 16);
+                    dst[written + 1] = static_cast<unsigned char>(triple >> 8);
+                    dst[written + 2] = static_cast<unsigned char>(triple);
+                    written += 3;
+                    i += 3;
+                    continue;
+                }
+            }
+
+            if (src[i] == '=') {
+
+                padding = true;
+
+                // завершающий `=` заканчивает данные
+                if (quad >= 2 && quad + ++pads >= 4) {
+
+                    if (strict && i + 1 < size) {
+                        error = "Excess data after padding";
+                        return std::nullopt;
+                    }
+
+                    out.truncate(written);
+                    return out;
+                }
+
+                continue;
+            }
+
+            const std::uint8_t value = table[src[i]];
+
+            if (value == invalid) {
+
+                if (strict) {
+                    error = "Only base64 data is allowed";
+                    return std::nullopt;
+                }
+
+                continue;
+            }
+
+            if (strict && padding) {
+                error = "Discontinuous padding not allowed";
+                return std::nullopt;
+            }
+
+            pads = 0;
+
+            switch (quad) {
+                case 0:
+                    pending = value;
+                    quad = 1;
+                    break;
+                case 1:
+                    dst[written++] = static_cast<unsigned char>(pending << 2 | value >> 4);
+                    pending = value & 0x0f;
+                    quad = 2;
+                    break;
+                case 2:
+                    dst[written++] = static_cast<unsigned char>(pending << 4 | value >> 2);
+                    pending = value & 0x03;
+                    quad = 3;
+                    break;
+                default:
+                    dst[written++] = static_cast<unsigned char>(pending << 6 | value);
+                    quad = 0;
+                    break;
+            }
+        }
+
+        if (quad == 1) {
+            error = "Invalid base64-encoded string: number of data characters (" +
+                    std::to_string(written / 3 * 4 + 1) + ") cannot be 1 more than a multiple of 4";
+            return std::nullopt;
+        }
+
+        if (quad != 0) {
+            error = "Incorrect padding";
+            return std::nullopt;
+        }
+
+        out.truncate(written);
+        return out;
+    }
+}
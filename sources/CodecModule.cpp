@@ -0,0 +1,281 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "CodecModule.h"
+
+#include <algorithm>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "CodecKernels.h"
+#include "MemoryViewValue.h"
+#include "InterpreterContext.h"
+#include "StrValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    [[noreturn]] void codecError(const std::string& message) {
+        throw std::runtime_error("binascii.Error: " + message);
+    }
+
+    bool flag(const std::vector<Value>& args, const Kwargs& kwargs,
+              const std::size_t index, const QString& name, const bool fallback) {
+
+        const Value* value = option(args, kwargs, index, name);
+
+        return value ? value->toBool() : fallback;
+    }
+
+    /// байты bytes, bytearray или memoryview
+    QByteArray bytesLike(const Value& value) {
+
+        if (value.isBytes()) {
+            return value.asBytes()->bytes();
+        }
+
+        if (value.isByteArray()) {
+            return value.asByteArray()->bytes();
+        }
+
+        if (const MemoryViewValue* view = MemoryViewValue::of(value)) {
+            return view->toBytes();
+        }
+
+        throw std::runtime_error(
+            "TypeError: a bytes-like object is required, not '" + typeName(value).toStdString() + "'");
+    }
+
+    /// данные для разбора: bytes-like или str только из ASCII-символов
+    QByteArray decodeInput(const Value& value) {
+
+        if (!value.isString()) {
+            return bytesLike(value);
+        }
+
+        const QStringView text = value.asString()->view();
+
+        if (std::any_of(text.begin(), text.end(), [](const QChar c) { return c.unicode() >= 0x80; })) {
+            throw std::runtime_error("ValueError: string argument should contain only ASCII characters");
+        }
+
+        return text.toLatin1();
+    }
+
+    Value makeBytes(QByteArray data) {
+        return Value(std::make_shared<BytesValue>(std::move(data)));
+    }
+
+    QByteArray unhexlify(const QByteArray& text) {
+
+        if (text.size() % 2 != 0) {
+            codecError("Odd-length string");
+        }
+
+        QByteArray out;
+
+        if (codeckernels::fromHex(QByteArrayView(text), out, false) >= 0) {
+            codecError("Non-hexadecimal digit found");
+        }
+
+        return out;
+    }
+
+    QByteArray fromBase64(const QByteArray& text, const codeckernels::Alphabet alphabet, const bool strict) {
+
+        std::string error;
+        std::optional<QByteArray> decoded = codeckernels::fromBase64(text, alphabet, strict, error);
+
+        if (!decoded) {
+            codecError(error);
+        }
+
+        return std::move(*decoded);
+    }
+
+    std::string bytesRepr(const QByteArray& data) {
+        return BytesValue(data).repr().toStdString();
+    }
+
+    /// altchars из двух байтов вместо `+` и `/`; nullptr и None — без замены
+    QByteArray altChars(const Value* value) {
+
+        if (!value || value->isNone()) {
+            return {};
+        }
+
+        QByteArray chars = bytesLike(*value);
+
+        if (chars.size() != 2) {
+            throw std::runtime_error("AssertionError: " + bytesRepr(chars));
+        }
+
+        return chars;
+    }
+}
+
+Value CodecModule::makeBinascii() {
+
+    const auto module = std::make_shared<ClassValue>("binascii");
+
+    const auto hexlify = [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+        expectArgsRange(args, 1, 3, "hexlify");
+
+        const QByteArray data = bytesLike(args[0]);
+        std::vector<Value> separator(args.begin() + 1, args.end());
+
+        if (const Value* sep = option(args, kwargs, 1, "sep"); sep && separator.empty()) {
+            separator.push_back(*sep);
+        }
+
+        if (const Value* group = option(args, kwargs, 2, "bytes_per_sep"); group && separator.size() == 1) {
+            separator.push_back(*group);
+        }
+
+        if (!separator.empty() && separator[0].isNone()) {
+            separator.clear();
+        }
+
+        const auto [sep, bytesPerSep] = BytesValue::hexSeparator(separator, data.size());
+
+        return makeBytes(codeckernels::toHexBytes(data, static_cast<char>(sep), bytesPerSep));
+    };
+
+    const auto unhex = [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+        expectArgs(args, 1, "unhexlify");
+        return makeBytes(unhexlify(decodeInput(args[0])));
+    };
+
+    module->setAttribute("hexlify", makeBuiltin("hexlify", hexlify));
+    module->setAttribute("b2a_hex", makeBuiltin("b2a_hex", hexlify));
+    module->setAttribute("unhexlify", makeBuiltin("unhexlify", unhex));
+    module->setAttribute("a2b_hex", makeBuiltin("a2b_hex", unhex));
+
+    module->setAttribute("b2a_base64", makeBuiltin(
+        "b2a_base64",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "b2a_base64");
+
+            const bool newline = flag({}, kwargs, 0, "newline", true);
+
+            return makeBytes(codeckernels::toBase64(bytesLike(args[0]), codeckernels::Alphabet::Standard, newline));
+        }
+    ));
+
+    module->setAttribute("a2b_base64", makeBuiltin(
+        "a2b_base64",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "a2b_base64");
+
+            const bool strict = flag({}, kwargs, 0, "strict_mode", false);
+
+            return makeBytes(fromBase64(decodeInput(args[0]), codeckernels::Alphabet::Standard, strict));
+        }
+    ));
+
+    module->setAttribute("Error", Value(InterpreterContext::current().exceptionClasses.value("Error")));
+
+    return Value(module);
+}
+
+Value CodecModule::makeBase64() {
+
+    const auto module = std::make_shared<ClassValue>("base64");
+
+    // b64encode и b64decode принимают altchars (и validate), прочие варианты — только данные
+    const auto encoder = [](const QString& name, const codeckernels::Alphabet alphabet, const bool options) {
+
+        return makeBuiltin(
+            name,
+            [name, alphabet, options](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+                expectArgsRange(args, 1, options ? 2 : 1, name);
+
+                QByteArray encoded = codeckernels::toBase64(bytesLike(args[0]), alphabet);
+
+                if (const QByteArray chars = options ? altChars(option(args, kwargs, 1, "altchars")) : QByteArray();
+                    !chars.isEmpty()) {
+
+                    for (char& c : encoded) {
+                        c = c == '+' ? chars[0] : c == '/' ? chars[1] : c;
+                    }
+                }
+
+                return makeBytes(std::move(encoded));
+            }
+        );
+    };
+
+    const auto decoder = [](const QString& name, const codeckernels::Alphabet alphabet, const bool options) {
+
+        return makeBuiltin(
+            name,
+            [name, alphabet, options](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+                expectArgsRange(args, 1, options ? 3 : 1, name);
+
+                QByteArray text = decodeInput(args[0]);
+
+                if (!options) {
+                    return makeBytes(fromBase64(text, alphabet, false));
+                }
+
+                if (const QByteArray chars = altChars(option(args, kwargs, 1, "altchars")); !chars.isEmpty()) {
+
+                    // одна замена на байт: altchars=b'/+' меняет символы местами, а не склеивает
+                    for (char& c : text) {
+                        c = c == chars[0] ? '+' : c == chars[1] ? '/' : c;
+                    }
+                }
+
+                return makeBytes(fromBase64(text, alphabet, flag(args, kwargs, 2, "validate", false)));
+            }
+        );
+    };
+
+    module->setAttribute("b64encode", encoder("b64encode", codeckernels::Alphabet::Standard, true));
+    module->setAttribute("b64decode", decoder("b64decode", codeckernels::Alphabet::Standard, true));
+    module->setAttribute("standard_b64encode", encoder("standard_b64encode", codeckernels::Alphabet::Standard, false));
+    module->setAttribute("standard_b64decode", decoder("standard_b64decode", codeckernels::Alphabet::Standard, false));
+    module->setAttribute("urlsafe_b64encode", encoder("urlsafe_b64encode", codeckernels::Alphabet::UrlSafe, false));
+    module->setAttribute("urlsafe_b64decode", decoder("urlsafe_b64decode", codeckernels::Alphabet::UrlSafe, false));
+
+    module->setAttribute("b16encode", makeBuiltin(
+        "b16encode",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 1, "b16encode");
+            return makeBytes(codeckernels::toHexBytes(bytesLike(args[0])).toUpper());
+        }
+    ));
+
+    module->setAttribute("b16decode", makeBuiltin(
+        "b16decode",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgsRange(args, 1, 2, "b16decode");
+
+            QByteArray text = decodeInput(args[0]);
+
+            if (flag(args, kwargs, 1, "casefold", false)) {
+                text = text.toUpper();
+            }
+
+            // RFC 3548: только заглавные цифры, строчные — через casefold
+            if (std::any_of(text.begin(), text.end(), [](const char c) {
+                    return !((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F'));
+                })) {
+                codecError("Non-base16 digit found");
+            }
+
+            return makeBytes(unhexlify(text));
+        }
+    ));
+
+    return Value(module);
+}
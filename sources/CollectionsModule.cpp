@@ -0,0 +1,161 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "CollectionsModule.h"
+
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "CounterValue.h"
+#include "DefaultDictValue.h"
+#include "DequeValue.h"
+#include "OrderedDictValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/ProtocolHelpers.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    std::optional<qsizetype> parseMaxlen(const Value& value) {
+
+        if (value.isNone()) {
+            return std::nullopt;
+        }
+
+        if (!value.isBigInt() && !value.isBool()) {
+            throw std::runtime_error(
+                "TypeError: an integer is required, not '" + typeName(value).toStdString() + "'");
+        }
+
+        const Value::BigInt maxlen = value.toBigInt();
+
+        if (maxlen < 0) {
+            throw std::runtime_error("ValueError: maxlen must be non-negative");
+        }
+
+        return maxlen.convert_to<qsizetype>();
+    }
+
+    /// заполняет dict, как dict(source, **kwargs): source — отображение или пары ключ-значение
+    void fill(DictValue& dict, const Value* source, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) {
+
+        if (source && source->isDict()) {
+
+            source->asDict()->forEachItem([&dict](const Value& key, const Value& value) {
+                dict.setItem(key, value);
+            });
+
+        } else if (source) {
+
+            const Value iterator = getIter(*source, env);
+            std::size_t index = 0;
+
+            for (Value item; iterNext(iterator, item, env); ++index) {
+
+                std::vector<Value> storage;
+                const std::vector<Value>& pair = sequenceItems(item, storage);
+
+                if (pair.size() != 2) {
+                    throw std::runtime_error(
+                        "ValueError: dictionary update sequence element #" + std::to_string(index) +
+                        " has length " + std::to_string(pair.size()) + "; 2 is required");
+                }
+
+                dict.setItem(pair[0], pair[1]);
+            }
+        }
+
+        for (const auto& [name, value] : kwargs) {
+            dict.setItem(Value(name), value);
+        }
+    }
+}
+
+Value CollectionsModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("collections");
+
+    module->setAttribute("deque", makeBuiltin(
+        "deque",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgsRange(args, 0, 2, "deque");
+
+            const Value* iterable = args.empty() ? nullptr : &args[0];
+            const Value* maxlen = args.size() > 1 ? &args[1] : nullptr;
+
+            for (const auto& [name, value] : kwargs) {
+
+                if (name == "iterable") {
+                    iterable = &value;
+                } else if (name == "maxlen") {
+                    maxlen = &value;
+                } else {
+                    throw std::runtime_error(
+                        "TypeError: deque() got an unexpected keyword argument '" + name.toStdString() + "'");
+                }
+            }
+
+            const auto deque = std::make_shared<DequeValue>(maxlen ? parseMaxlen(*maxlen) : std::nullopt);
+
+            if (iterable) {
+                deque->extend(*iterable);
+            }
+
+            return Value(std::static_pointer_cast<ObjectValue>(deque));
+        }
+    ));
+
+    module->setAttribute("defaultdict", makeBuiltin(
+        "defaultdict",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgsRange(args, 0, 2, "defaultdict");
+
+            const Value factory = args.empty() ? Value() : args[0];
+
+            if (!factory.isNone() && !factory.isCallable()) {
+                throw std::runtime_error("TypeError: first argument must be callable or None");
+            }
+
+            const auto dict = std::make_shared<DefaultDictValue>(factory);
+            fill(*dict, args.size() > 1 ? &args[1] : nullptr, kwargs, env);
+
+            return Value(std::static_pointer_cast<DictValue>(dict));
+        }
+    ));
+
+    module->setAttribute("Counter", makeBuiltin(
+        "Counter",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgsRange(args, 0, 1, "Counter");
+
+            const auto counter = std::make_shared<CounterValue>();
+
+            if (!args.empty() && !args[0].isNone()) {
+                counter->count(args[0], 1, env);
+            }
+
+            for (const auto& [name, value] : kwargs) {
+                counter->increment(Value(name), value);
+            }
+
+            return Value(std::static_pointer_cast<DictValue>(counter));
+        }
+    ));
+
+    module->setAttribute("OrderedDict", makeBuiltin(
+        "OrderedDict",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgsRange(args, 0, 1, "OrderedDict");
+
+            const auto dict = std::make_shared<OrderedDictValue>();
+            fill(*dict, args.empty() ? nullptr : &args[0], kwargs, env);
+
+            return Value(std::static_pointer_cast<DictValue>(dict));
+        }
+    ));
+
+    return Value(module);
+}
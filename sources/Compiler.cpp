@@ -0,0 +1,1078 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#include "Compiler.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "ConstantFolder.h"
+#include "Parser.h"
+#include "TypeProfile.h"
+
+std::shared_ptr<const CodeObject> Compiler::compile(const std::shared_ptr<ASTNode>& node) {
+
+    Compiler compiler;
+
+    compiler.compileStatement(node);
+
+    return std::make_shared<const CodeObject>(std::move(compiler.code));
+}
+
+std::shared_ptr<const CodeObject> Compiler::compileFunction(const std::vector<std::shared_ptr<ASTNode>>& body,
+                                                            const bool coroutine) {
+
+    Compiler compiler;
+    compiler.inFunction = true;
+    compiler.inCoroutine = coroutine;
+    compiler.traceLines = true;
+
+    // сопрограмма без единого await всё равно приостановлена до первого шага цикла событий
+    compiler.code.generator = coroutine;
+    compiler.code.coroutine = coroutine;
+
+    compiler.compileBlock(body);
+
+    compiler.emit(OpCode::LoadConst, compiler.addConstant(Value()));
+    compiler.emit(OpCode::ReturnValue);
+
+    auto code = std::make_shared<const CodeObject>(std::move(compiler.code));
+    TypeProfile::attach(code);
+
+    return code;
+}
+
+std::shared_ptr<const CodeObject> Compiler::compileModule(const std::vector<std::shared_ptr<ASTNode>>& body) {
+
+    Compiler compiler;
+    compiler.traceLines = true;
+
+    compiler.compileBlock(body);
+
+    auto code = std::make_shared<const CodeObject>(std::move(compiler.code));
+    TypeProfile::attach(code);
+
+    return code;
+}
+
+std::size_t Compiler::emit(const OpCode op, const std::int32_t arg, const std::int32_t arg2) {
+    code.code.push_back(Instruction{op, arg, arg2});
+    return code.code.size() - 1;
+}
+
+std::int32_t Compiler::addCache() {
+    code.caches.emplace_back();
+    return static_cast<std::int32_t>(code.caches.size() - 1);
+}
+
+void Compiler::patch(const std::size_t at) {
+    code.code[at].arg = here();
+}
+
+std::int32_t Compiler::here() const {
+    return static_cast<std::int32_t>(code.code.size());
+}
+
+std::int32_t Compiler::addConstant(const Value& value) {
+    code.constants.push_back(value);
+    return static_cast<std::int32_t>(code.constants.size() - 1);
+}
+
+std::int32_t Compiler::addName(const QString& name) {
+
+    for (std::size_t i = 0; i < code.names.size(); ++i) {
+        if (code.names[i] == name) {
+            return static_cast<std::int32_t>(i);
+        }
+    }
+
+    code.names.push_back(name);
+    return static_cast<std::int32_t>(code.names.size() - 1);
+}
+
+bool Compiler::acceptSlot(const LocalSlot& slot) {
+
+    if (!slot.layout) {
+        return false;
+    }
+
+    if (!code.layout) {
+        code.layout = slot.layout;
+    }
+
+    return code.layout == slot.layout;
+}
+
+void Compiler::emitLoad(const QString& name, const LocalSlot& slot) {
+
+    if (acceptSlot(slot)) {
+        emit(slot.cell ? OpCode::LoadDeref : OpCode::LoadFast, slot.index, addName(name));
+    } else {
+        code.nameCaches.emplace_back();
+        emit(slot.global ? OpCode::LoadGlobal : OpCode::LoadName, addName(name),
+             static_cast<std::int32_t>(code.nameCaches.size() - 1));
+    }
+}
+
+void Compiler::emitStore(const QString& name, const LocalSlot& slot) {
+
+    if (acceptSlot(slot)) {
+        emit(slot.cell ? OpCode::StoreDeref : OpCode::StoreFast, slot.index, addName(name));
+    } else {
+        emit(slot.global ? OpCode::StoreGlobal : OpCode::StoreName, addName(name));
+    }
+}
+
+void Compiler::emitLine(const ASTNode& node) {
+    if (traceLines && node.line > 0) {
+        emit(OpCode::TraceLine, node.line);
+    }
+}
+
+template <typename Jump>
+void Compiler::compileExit(const bool loop, Jump jump) {
+
+    const std::int32_t depth = stackDepth;
+    std::vector<TryContext> crossed;
+
+    // пересечённые контексты снимаются, пока встраиваются блоки finally: `break` внутри
+    // такого блока не должен встраивать его ещё раз, а исключение из него уходит наружу
+    while (!tryContexts.empty() && (!loop || tryContexts.back().loopDepth == loopHeads.size())) {
+
+        TryContext context = closeTry();
+
+        if (context.kind == TryContext::Kind::Handler) {
+
+            if (loop) {
+                emit(OpCode::PopTop);
+                --stackDepth;
+            }
+
+        } else if (context.kind == TryContext::Kind::Finally) {
+            compileBlock(*context.finallyBody);
+        }
+
+        crossed.push_back(std::move(context));
+    }
+
+    jump();
+
+    stackDepth = depth;
+
+    for (auto it = crossed.rbegin(); it != crossed.rend(); ++it) {
+        it->openedAt = here();
+        tryContexts.push_back(std::move(*it));
+    }
+}
+
+void Compiler::compileBlock(const std::vector<std::shared_ptr<ASTNode>>& body) {
+    for (const auto& stmt : body) {
+        compileStatement(stmt);
+    }
+}
+
+/**
+ * @brief Компилирует инструкцию.
+ *
+ * Результат инструкции-выражения выводится (`PrintExpr`), если узел требует печати,
+ * — так же, как это делал Interpreter::executeNode для каждой инструкции блока.
+ */
+void Compiler::compileStatement(const std::shared_ptr<ASTNode>& node) {
+
+    // циклы отмечают строку в заголовке — событие line приходит на каждой итерации, как в CPython
+    if (!dynamic_cast<const WhileNode*>(node.get()) && !dynamic_cast<const ForNode*>(node.get())) {
+        emitLine(*node);
+    }
+
+    if (const auto assign = dynamic_cast<const AssignNode*>(node.get())) {
+        compileExpression(assign->valueExpr);
+        emitStore(assign->varName, assign->slot);
+        return;
+    }
+
+    if (const auto unpack = dynamic_cast<const UnpackAssignNode*>(node.get())) {
+        compileUnpackAssign(*unpack);
+        return;
+    }
+
+    if (const auto aug = dynamic_cast<const AugAssignNode*>(node.get())) {
+
+        if (!aug->operation) {
+            compileFallback(node);
+            emit(OpCode::PopTop);
+            return;
+        }
+
+        emitLoad(aug->name, aug->slot);
+        compileExpression(aug->value);
+        emit(OpCode::InplaceOp, static_cast<std::int32_t>(*aug->operation));
+        emitStore(aug->name, aug->slot);
+        return;
+    }
+
+    if (const auto ifNode = dynamic_cast<const IfNode*>(node.get())) {
+        compileIf(*ifNode);
+        return;
+    }
+
+    if (const auto whileNode = dynamic_cast<const WhileNode*>(node.get())) {
+        compileWhile(*whileNode);
+        return;
+    }
+
+    if (const auto asyncFor = dynamic_cast<const AsyncForNode*>(node.get())) {
+        compileAsyncFor(*asyncFor);
+        return;
+    }
+
+    if (const auto forNode = dynamic_cast<const ForNode*>(node.get())) {
+        compileFor(*forNode);
+        return;
+    }
+
+    if (const auto tryNode = dynamic_cast<const TryNode*>(node.get())) {
+        compileTry(*tryNode);
+        return;
+    }
+
+    if (const auto raise = dynamic_cast<const RaiseNode*>(node.get())) {
+
+        if (!compileRaise(*raise)) {
+            compileFallback(node);
+            emit(OpCode::PopTop);
+        }
+        return;
+    }
+
+    if (dynamic_cast<const PassNode*>(node.get())) {
+        return;
+    }
+
+    if (const auto returnNode = dynamic_cast<const ReturnNode*>(node.get()); returnNode && inFunction) {
+
+        if (returnNode->expr) {
+            compileExpression(returnNode->expr);
+        } else {
+            emit(OpCode::LoadConst, addConstant(Value()));
+        }
+
+        // возвращаемое значение лежит на стеке, пока выполняются блоки finally
+        ++stackDepth;
+        compileExit(false, [&] { emit(OpCode::ReturnValue); });
+        --stackDepth;
+        return;
+    }
+
+    // break/continue вне скомпилированного цикла выбрасывают исключение,
+    // которое перехватит внешний цикл, выполняемый через AST
+    if (!loopHeads.empty()) {
+
+        if (dynamic_cast<const BreakNode*>(node.get())) {
+            compileExit(true, [&] { emit(OpCode::BreakLoop); });
+            return;
+        }
+
+        if (dynamic_cast<const ContinueNode*>(node.get())) {
+            compileExit(true, [&] { emit(OpCode::Jump, loopHeads.back()); });
+            return;
+        }
+    }
+
+    compileExpression(node);
+    emit(node->shouldPrint() && !inFunction && echoResults ? OpCode::PrintExpr : OpCode::PopTop);
+}
+
+/**
+ * Ветви с константным условием разрешаются при компиляции: ложная ветвь не попадает
+ * в байткод, а после истинной не компилируются остальные `elif` и `else`.
+ */
+void Compiler::compileIf(const IfNode& node) {
+
+    std::vector<std::size_t> exitJumps;
+
+    const auto compileBranch = [&](const std::shared_ptr<ASTNode>& condition,
+                                   const std::vector<std::shared_ptr<ASTNode>>& body) {
+
+        if (const auto constant = ConstantFolder::fold(condition)) {
+
+            if (constant->toBool()) {
+                compileBlock(body);
+                return true;
+            }
+
+            return false;
+        }
+
+        std::vector<std::size_t> nextBranch;
+        compileCondition(condition, nextBranch);
+
+        compileBlock(body);
+        exitJumps.push_back(emit(OpCode::Jump));
+
+        for (const std::size_t jump : nextBranch) {
+            patch(jump);
+        }
+        return false;
+    };
+
+    bool taken = compileBranch(node.condition, node.body);
+
+    for (auto it = node.elifs.begin(); !taken && it != node.elifs.end(); ++it) {
+        taken = compileBranch(it->first, it->second);
+    }
+
+    if (!taken) {
+        compileBlock(node.elseBody);
+    }
+
+    for (const std::size_t jump : exitJumps) {
+        patch(jump);
+    }
+}
+
+/**
+ * Условие `if` и `while` переходом, без bool на стеке. Цепочка `a < b < c` уходит
+ * на ложную ветвь из любого звена; `x and y` — два условия подряд, `x or y` и
+ * `not x` переходят по истинному значению (PopJumpIfTrue). Прочие выражения
+ * вычисляются обычным путём и снимаются PopJumpIfFalse.
+ *
+ * Ложная цепочка выходит одним из двух путей:
+ * @code
+ *         <a> <b> DupTop RotThree CompareOp
+ *         PopJumpIfFalse fail
+ *         <c> CompareOp
+ *         PopJumpIfFalse false
+ *         Jump        done
+ * fail:   PopTop
+ *         Jump        false
+ * done:
+ * @endcode
+ */
+void Compiler::compileCondition(const std::shared_ptr<ASTNode>& node, std::vector<std::size_t>& falseJumps) {
+
+    if (const auto logical = dynamic_cast<const LogicalOpNode*>(node.get())) {
+
+        if (logical->op == "and") {
+            compileCondition(logical->left, falseJumps);
+            compileCondition(logical->right, falseJumps);
+            return;
+        }
+
+        // истинный левый операнд сразу ведёт в тело, минуя правый
+        if (logical->op == "or") {
+            compileExpression(logical->left);
+            const std::size_t taken = emit(OpCode::PopJumpIfTrue);
+            compileCondition(logical->right, falseJumps);
+            patch(taken);
+            return;
+        }
+    }
+
+    // `not x`: то же значение x, переход по истинному
+    if (const auto unary = dynamic_cast<const UnaryOpNode*>(node.get());
+        unary && unary->operation == UnaryOpNode::Operation::Not) {
+        compileExpression(unary->operand);
+        falseJumps.push_back(emit(OpCode::PopJumpIfTrue));
+        return;
+    }
+
+    const auto compare = dynamic_cast<const CompareNode*>(node.get());
+
+    const bool chain = compare && compare->operations.size() > 1 &&
+        std::all_of(compare->operations.begin(), compare->operations.end(),
+                    [](const auto& operation) { return operation.has_value(); });
+
+    // одиночное сравнение и так даёт CompareOp, PopJumpIfFalse — их сливает FastCompareJump
+    if (!chain) {
+        compileExpression(node);
+        falseJumps.push_back(emit(OpCode::PopJumpIfFalse));
+        return;
+    }
+
+    const std::size_t last = compare->operations.size() - 1;
+    std::vector<std::size_t> cleanupJumps;
+
+    compileExpression(compare->left);
+
+    for (std::size_t i = 0; i < last; ++i) {
+        compileCompareOperand(*compare, i);
+        emit(OpCode::DupTop);
+        emit(OpCode::RotThree);
+        emit(OpCode::CompareOp, static_cast<std::int32_t>(*compare->operations[i]));
+        cleanupJumps.push_back(emit(OpCode::PopJumpIfFalse));
+    }
+
+    compileCompareOperand(*compare, last);
+    emit(OpCode::CompareOp, static_cast<std::int32_t>(*compare->operations[last]));
+    falseJumps.push_back(emit(OpCode::PopJumpIfFalse));
+
+    const std::size_t done = emit(OpCode::Jump);
+
+    // ложное звено оставило на стеке свой правый операнд
+    for (const std::size_t jump : cleanupJumps) {
+        patch(jump);
+    }
+
+    emit(OpCode::PopTop);
+    falseJumps.push_back(emit(OpCode::Jump));
+
+    patch(done);
+}
+
+void Compiler::compileCompareOperand(const CompareNode& compare, const std::size_t i) {
+
+    const auto operation = *compare.operations[i];
+    const bool membership = operation == CompareNode::Operation::In || operation == CompareNode::Operation::NotIn;
+
+    // правый операнд `in` — литерал коллекции: кортеж или frozenset строится один раз
+    if (const auto constant = membership ? ConstantFolder::foldContainer(compare.rights[i]) : std::nullopt) {
+        emit(OpCode::LoadConst, addConstant(*constant));
+    } else {
+        compileExpression(compare.rights[i]);
+    }
+}
+
+/**
+ * Схема цикла:
+ * @code
+ *         SetupLoop   break, head
+ * head:   <condition>
+ *         PopJumpIfFalse else
+ *         <body>
+ *         Jump        head
+ * else:   PopBlock
+ *         <elseBody>
+ *         Jump        end
+ * break:  PopBlock
+ * end:
+ * @endcode
+ */
+void Compiler::compileWhile(const WhileNode& node) {
+
+    const std::size_t setup = emit(OpCode::SetupLoop);
+    const std::int32_t head = here();
+    code.code[setup].arg2 = head;
+
+    emitLine(node);
+    std::vector<std::size_t> exitJumps;
+    compileCondition(node.condition, exitJumps);
+
+    loopHeads.push_back(head);
+    compileBlock(node.body);
+    loopHeads.pop_back();
+
+    emit(OpCode::Jump, head);
+
+    for (const std::size_t jump : exitJumps) {
+        patch(jump);
+    }
+    emit(OpCode::PopBlock);
+    compileBlock(node.elseBody);
+    const std::size_t endJump = emit(OpCode::Jump);
+
+    patch(setup);
+    emit(OpCode::PopBlock);
+
+    patch(endJump);
+}
+
+/**
+ * Схема цикла (итератор лежит на стеке под блоком цикла):
+ * @code
+ *         <iterable>
+ *         GetIter
+ *         SetupLoop   break, head
+ * head:   ForIter     break
+ *         StoreName   var
+ *         <body>
+ *         Jump        head
+ * break:  PopBlock
+ *         PopTop
+ * @endcode
+ *
+ * Цель из двух имён получает ForIterPair, из большего числа — ForIter и UnpackSequence;
+ * имена записываются слева направо.
+ */
+void Compiler::compileFor(const ForNode& node) {
+
+    compileExpression(node.iterable);
+    emit(OpCode::GetIter);
+    ++stackDepth;
+
+    const std::size_t setup = emit(OpCode::SetupLoop);
+    const std::int32_t head = here();
+    code.code[setup].arg2 = head;
+
+    emitLine(node);
+    const std::size_t forIter = emit(node.targets.size() == 2 ? OpCode::ForIterPair : OpCode::ForIter);
+
+    if (node.targets.size() > 2) {
+        emit(OpCode::UnpackSequence, static_cast<std::int32_t>(node.targets.size()));
+    }
+
+    for (std::size_t i = 0; i < node.targets.size(); ++i) {
+        emitStore(node.targets[i], node.slots[i]);
+    }
+
+    loopHeads.push_back(head);
+    compileBlock(node.body);
+    loopHeads.pop_back();
+
+    emit(OpCode::Jump, head);
+
+    patch(setup);
+    patch(forIter);
+    emit(OpCode::PopBlock);
+    emit(OpCode::PopTop);
+    --stackDepth;
+}
+
+/**
+ * Кортеж без распаковки справа той же длины кладётся на стек поэлементно и
+ * записывается с конца — `a, b = b, a` обходится без TupleValue. Иначе значение
+ * распаковывает UnpackSequence.
+ */
+void Compiler::compileUnpackAssign(const UnpackAssignNode& node) {
+
+    const std::size_t count = node.targets.size();
+    const auto tuple = dynamic_cast<const TupleNode*>(node.valueExpr.get());
+
+    const bool direct = tuple && tuple->elements.size() == count &&
+        std::none_of(tuple->elements.begin(), tuple->elements.end(), [](const auto& element) {
+            return dynamic_cast<const StarredNode*>(element.get()) != nullptr;
+        });
+
+    if (direct) {
+
+        for (const auto& element : tuple->elements) {
+            compileExpression(element);
+        }
+
+        for (std::size_t i = count; i-- > 0;) {
+            emitStore(node.targets[i], node.slots[i]);
+        }
+
+        return;
+    }
+
+    compileExpression(node.valueExpr);
+    emit(OpCode::UnpackSequence, static_cast<std::int32_t>(count));
+
+    for (std::size_t i = 0; i < count; ++i) {
+        emitStore(node.targets[i], node.slots[i]);
+    }
+}
+
+void Compiler::compileExpression(const std::shared_ptr<ASTNode>& node) {
+    if (!tryCompileExpression(node)) {
+        compileFallback(node);
+    }
+}
+
+void Compiler::compileFallback(const std::shared_ptr<ASTNode>& node) {
+    code.nodes.push_back(node);
+    emit(OpCode::EvalNode, static_cast<std::int32_t>(code.nodes.size() - 1));
+}
+
+bool Compiler::tryCompileExpression(const std::shared_ptr<ASTNode>& node) {
+
+    if (const auto value = dynamic_cast<const ValueNode*>(node.get())) {
+        emit(OpCode::LoadConst, addConstant(value->value));
+        return true;
+    }
+
+    if (const auto constant = ConstantFolder::fold(node)) {
+        emit(OpCode::LoadConst, addConstant(*constant));
+        return true;
+    }
+
+    if (const auto var = dynamic_cast<const VarNode*>(node.get())) {
+        emitLoad(var->name, var->slot);
+        return true;
+    }
+
+    if (const auto binOp = dynamic_cast<const BinOpNode*>(node.get())) {
+
+        const auto operation = binOp->operation;
+
+        if (!operation || *operation == BinOpNode::Operation::And || *operation == BinOpNode::Operation::Or) {
+            return false;
+        }
+
+        compileExpression(binOp->left);
+        compileExpression(binOp->right);
+        emit(OpCode::BinaryOp, static_cast<std::int32_t>(*operation));
+        return true;
+    }
+
+    // части остаются на стеке до последней: строки склеиваются одним выделением
+    if (const auto concat = dynamic_cast<const ConcatNode*>(node.get())) {
+
+        const auto count = static_cast<std::int32_t>(concat->pieces.size());
+
+        compileExpression(concat->pieces.front());
+
+        for (std::int32_t i = 1; i < count; ++i) {
+            compileExpression(concat->pieces[i]);
+            emit(OpCode::BuildConcat, i + 1, i + 1 == count);
+        }
+
+        return true;
+    }
+
+    if (const auto unary = dynamic_cast<const UnaryOpNode*>(node.get())) {
+
+        if (!unary->operation) {
+            return false;
+        }
+
+        compileExpression(unary->operand);
+        emit(OpCode::UnaryOp, static_cast<std::int32_t>(*unary->operation));
+        return true;
+    }
+
+    if (const auto compare = dynamic_cast<const CompareNode*>(node.get())) {
+
+        std::vector<CompareNode::Operation> operations;
+
+        for (const auto& operation : compare->operations) {
+
+            if (!operation) {
+                return false;
+            }
+
+            operations.push_back(*operation);
+        }
+
+        if (operations.empty()) {
+            return false;
+        }
+
+        compileExpression(compare->left);
+
+        // a < b < c: промежуточный операнд дублируется и вычисляется один раз
+        std::vector<std::size_t> cleanupJumps;
+
+        for (std::size_t i = 0; i + 1 < operations.size(); ++i) {
+            compileCompareOperand(*compare, i);
+            emit(OpCode::DupTop);
+            emit(OpCode::RotThree);
+            emit(OpCode::CompareOp, static_cast<std::int32_t>(operations[i]));
+            cleanupJumps.push_back(emit(OpCode::JumpIfFalseOrPop));
+        }
+
+        compileCompareOperand(*compare, operations.size() - 1);
+        emit(OpCode::CompareOp, static_cast<std::int32_t>(operations.back()));
+
+        if (!cleanupJumps.empty()) {
+            const std::size_t endJump = emit(OpCode::Jump);
+
+            for (const std::size_t jump : cleanupJumps) {
+                patch(jump);
+            }
+
+            emit(OpCode::RotTwo);
+            emit(OpCode::PopTop);
+
+            patch(endJump);
+        }
+
+        return true;
+    }
+
+    if (const auto logical = dynamic_cast<const LogicalOpNode*>(node.get())) {
+
+        OpCode jump;
+
+        if (logical->op == "and") {
+            jump = OpCode::JumpIfFalseOrPop;
+        } else if (logical->op == "or") {
+            jump = OpCode::JumpIfTrueOrPop;
+        } else {
+            return false;
+        }
+
+        compileExpression(logical->left);
+        const std::size_t shortCircuit = emit(jump);
+        compileExpression(logical->right);
+        patch(shortCircuit);
+        return true;
+    }
+
+    if (const auto callNode = dynamic_cast<const CallNode*>(node.get())) {
+
+        if (!callNode->kwargs.empty()) {
+            return false;
+        }
+
+        for (const auto& arg : callNode->args) {
+            if (dynamic_cast<const StarredNode*>(arg.get())) {
+                return false;
+            }
+        }
+
+        const auto argc = static_cast<std::int32_t>(callNode->args.size());
+
+        // obj.method(args): метод не материализуется как отдельный объект
+        if (const auto method = dynamic_cast<const AttributeAccessNode*>(callNode->callee.get())) {
+
+            compileExpression(method->object);
+
+            for (const auto& arg : callNode->args) {
+                compileExpression(arg);
+            }
+
+            const auto at = emit(OpCode::CallMethod, argc, addName(method->attr));
+            code.code[at].cache = addCache();
+            return true;
+        }
+
+        compileExpression(callNode->callee);
+
+        for (const auto& arg : callNode->args) {
+            compileExpression(arg);
+        }
+
+        emit(OpCode::CallFunction, argc);
+        return true;
+    }
+
+    if (const auto attr = dynamic_cast<const AttributeAccessNode*>(node.get())) {
+        compileExpression(attr->object);
+        emit(OpCode::LoadAttr, addName(attr->attr), addCache());
+        return true;
+    }
+
+    if (const auto index = dynamic_cast<const IndexNode*>(node.get())) {
+        compileExpression(index->object);
+        compileExpression(index->index);
+        emit(OpCode::BinarySubscr);
+        return true;
+    }
+
+    if (const auto yield = dynamic_cast<const YieldNode*>(node.get())) {
+        compileYield(*yield);
+        return true;
+    }
+
+    if (const auto await = dynamic_cast<const AwaitNode*>(node.get())) {
+        compileAwait(*await);
+        return true;
+    }
+
+    // f-строка: поля вычисляются байткодом, литералы и спецификаторы остаются в узле
+    if (const auto formatted = dynamic_cast<const FormattedStringNode*>(node.get())) {
+
+        for (const auto& part : formatted->parts) {
+
+            if (part.expr) {
+                compileExpression(part.expr);
+            }
+
+            if (part.spec) {
+                compileExpression(part.spec);
+            }
+        }
+
+        code.nodes.push_back(node);
+        emit(OpCode::BuildString, static_cast<std::int32_t>(code.nodes.size() - 1), formatted->operandCount);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * `yield value` — одна инструкция YieldValue. `yield from` — цикл отправки
+ * (итератор остаётся на стеке, пока не исчерпан):
+ * @code
+ *         <iterable>
+ *         GetIter
+ *         LoadConst   None
+ * head:   Send        end
+ *         YieldValue
+ *         Jump        head
+ * end:
+ * @endcode
+ */
+void Compiler::compileYield(const YieldNode& node) {
+
+    if (!inFunction) {
+        throw std::runtime_error("SyntaxError: 'yield' outside function");
+    }
+
+    // асинхронных генераторов нет: YieldValue сопрограммы принадлежит циклу событий
+    if (inCoroutine) {
+        throw std::runtime_error("SyntaxError: 'yield' inside async function");
+    }
+
+    code.generator = true;
+
+    if (node.delegate) {
+
+        compileExpression(node.value);
+        emit(OpCode::GetIter);
+        emitSendLoop();
+        return;
+    }
+
+    if (node.value) {
+        compileExpression(node.value);
+    } else {
+        emit(OpCode::LoadConst, addConstant(Value()));
+    }
+
+    emit(OpCode::YieldValue);
+}
+
+void Compiler::emitSendLoop(const std::int32_t exit) {
+
+    emit(OpCode::LoadConst, addConstant(Value()));
+
+    const std::int32_t head = here();
+    const std::size_t send = emit(OpCode::Send, 0, exit);
+
+    emit(OpCode::YieldValue);
+    emit(OpCode::Jump, head);
+
+    patch(send);
+}
+
+/**
+ * `await x` — `yield from` над итератором ожидания x: сопрограмма отдаёт наружу
+ * то, что отдаёт ожидаемое (в конце цепочки — Future), а результат ожидания
+ * остаётся на стеке.
+ */
+void Compiler::compileAwait(const AwaitNode& node) {
+
+    if (!inCoroutine) {
+        throw std::runtime_error("SyntaxError: 'await' outside async function");
+    }
+
+    compileExpression(node.value);
+    emit(OpCode::GetAwaitable);
+    emitSendLoop();
+}
+
+/**
+ * Схема цикла (асинхронный итератор лежит на стеке под блоком цикла):
+ * @code
+ *         <iterable>
+ *         GetAIter
+ *         SetupLoop   break, head
+ * head:   GetANext
+ *         LoadConst   None
+ * send:   Send        item, break
+ *         YieldValue
+ *         Jump        send
+ * item:   StoreName   var
+ *         <body>
+ *         Jump        head
+ * break:  PopBlock
+ *         PopTop
+ * @endcode
+ */
+void Compiler::compileAsyncFor(const AsyncForNode& node) {
+
+    if (!inCoroutine) {
+        throw std::runtime_error("SyntaxError: 'async for' outside async function");
+    }
+
+    compileExpression(node.iterable);
+    emit(OpCode::GetAIter);
+    ++stackDepth;
+
+    const std::size_t setup = emit(OpCode::SetupLoop);
+    const std::int32_t head = here();
+    code.code[setup].arg2 = head;
+
+    emitLine(node);
+    emit(OpCode::GetANext);
+
+    // адрес выхода ещё не известен: Send исправляется вместе с SetupLoop
+    const auto send = static_cast<std::size_t>(here()) + 1;
+    emitSendLoop(-1);
+
+    if (node.targets.size() > 1) {
+        emit(OpCode::UnpackSequence, static_cast<std::int32_t>(node.targets.size()));
+    }
+
+    for (std::size_t i = 0; i < node.targets.size(); ++i) {
+        emitStore(node.targets[i], node.slots[i]);
+    }
+
+    loopHeads.push_back(head);
+    compileBlock(node.body);
+    loopHeads.pop_back();
+
+    emit(OpCode::Jump, head);
+
+    patch(setup);
+    code.code[send].arg2 = here();
+    emit(OpCode::PopBlock);
+    emit(OpCode::PopTop);
+    --stackDepth;
+}
+
+
+void Compiler::openTry(const TryContext::Kind kind, const std::vector<std::shared_ptr<ASTNode>>* finallyBody) {
+    tryContexts.push_back(TryContext{kind, loopHeads.size(), stackDepth, here(), {}, finallyBody});
+}
+
+Compiler::TryContext Compiler::closeTry() {
+
+    TryContext context = std::move(tryContexts.back());
+    tryContexts.pop_back();
+
+    if (context.openedAt < here()) {
+        context.ranges.emplace_back(context.openedAt, here());
+    }
+
+    return context;
+}
+
+void Compiler::addHandler(const TryContext& context) {
+    for (const auto& [start, end] : context.ranges) {
+        code.exceptionTable.push_back(ExceptionEntry{
+            start, end, here(), context.stackDepth, static_cast<std::int32_t>(context.loopDepth)
+        });
+    }
+}
+
+/**
+ * Вход в `try` не порождает инструкций: тело защищено записью таблицы исключений,
+ * обработчики лежат после него и выполняются только при исключении.
+ * @code
+ *         <body>                  ; защищено: handler
+ *         <elseBody>
+ *         Jump        end
+ * handler:                        ; на стеке исключение
+ *         DupTop
+ *         <type>
+ *         MatchException
+ *         PopJumpIfFalse next
+ *         DupTop
+ *         StoreName   name
+ *         <handler body>
+ *         PopTop
+ *         Jump        end
+ * next:   ...
+ *         Reraise                 ; ни одна секция не подошла
+ * end:
+ * @endcode
+ *
+ * `finally` защищает всё вышеперечисленное. Его блок компилируется дважды:
+ * на обычном пути после `end` и в обработчике, который затем выбрасывает исключение снова.
+ */
+void Compiler::compileTry(const TryNode& node) {
+
+    const bool hasFinally = !node.finallyBody.empty();
+
+    if (hasFinally) {
+        openTry(TryContext::Kind::Finally, &node.finallyBody);
+    }
+
+    if (node.handlers.empty()) {
+        compileBlock(node.body);
+    } else {
+
+        openTry(TryContext::Kind::Except);
+        compileBlock(node.body);
+        const TryContext body = closeTry();
+
+        compileBlock(node.elseBody);
+        std::vector<std::size_t> exitJumps{emit(OpCode::Jump)};
+
+        addHandler(body);
+
+        openTry(TryContext::Kind::Handler);
+        const std::int32_t exception = stackDepth++;
+
+        for (const auto& handler : node.handlers) {
+
+            std::optional<std::size_t> nextHandler;
+
+            if (handler.type) {
+                emit(OpCode::DupTop);
+                compileExpression(handler.type);
+                emit(OpCode::MatchException);
+                nextHandler = emit(OpCode::PopJumpIfFalse);
+            }
+
+            if (!handler.name.isEmpty()) {
+                emit(OpCode::DupTop);
+                emitStore(handler.name, handler.slot);
+            }
+
+            compileBlock(handler.body);
+            emit(OpCode::PopTop);
+            exitJumps.push_back(emit(OpCode::Jump));
+
+            if (nextHandler) {
+                patch(*nextHandler);
+            }
+        }
+
+        if (node.handlers.back().type) {
+            emit(OpCode::Reraise, exception);
+        }
+
+        closeTry();
+        --stackDepth;
+
+        for (const std::size_t jump : exitJumps) {
+            patch(jump);
+        }
+    }
+
+    if (!hasFinally) {
+        return;
+    }
+
+    const TryContext protectedBlock = closeTry();
+
+    compileBlock(node.finallyBody);
+    const std::size_t skipHandler = emit(OpCode::Jump);
+
+    addHandler(protectedBlock);
+
+    openTry(TryContext::Kind::Handler);
+    const std::int32_t exception = stackDepth++;
+
+    compileBlock(node.finallyBody);
+    emit(OpCode::Reraise, exception);
+
+    closeTry();
+    --stackDepth;
+
+    patch(skipHandler);
+}
+
+/**
+ * Голый `raise` в обработчике выбрасывает снова исключение, лежащее на стеке;
+ * вне скомпилированного обработчика он не компилируется — его вычисляет RaiseNode::eval.
+ */
+bool Compiler::compileRaise(const RaiseNode& node) {
+
+    if (!node.exception) {
+
+        for (auto it = tryContexts.rbegin(); it != tryContexts.rend(); ++it) {
+            if (it->kind == TryContext::Kind::Handler) {
+                emit(OpCode::Reraise, it->stackDepth);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    compileExpression(node.exception);
+
+    if (node.cause) {
+        compileExpression(node.cause);
+    }
+
+    emit(OpCode::Raise, node.cause ? 1 : 0);
+    return true;
+}
@@ -0,0 +1,294 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "Comprehension.h"
+
+#include "CallRuntime.h"
+#include "DictValue.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "Parser.h"
+#include "Resolver.h"
+#include "SetValue.h"
+#include "VectorPool.h"
+
+namespace {
+
+    /**
+     * Обходит секции начиная с `depth` и вызывает `emit` для каждого набора
+     * значений переменных, прошедшего все условия. Вложенные секции — вложенные циклы.
+     */
+    template<typename Emit>
+    void forEach(const Comprehension& comprehension,
+                 const std::shared_ptr<Environment>& scope,
+                 const std::size_t depth,
+                 const Value& source,
+                 Emit& emit) {
+
+        const ComprehensionClause& clause = comprehension.clauses[depth];
+        const bool innermost = depth + 1 == comprehension.clauses.size();
+
+        const Value iterator = getIter(source, scope);
+
+        const auto step = [&] {
+
+            if (!comprehension.accepts(clause, scope)) {
+                return;
+            }
+
+            if (innermost) {
+                emit();
+            } else {
+                const ComprehensionClause& inner = comprehension.clauses[depth + 1];
+                forEach(comprehension, scope, depth + 1, inner.iterable->eval(scope), emit);
+            }
+        };
+
+        // {k: v for k, v in d.items()}: имена связываются из записей, без кортежей
+        if (IteratorValue* pairs = clause.targets.size() == 2 ? pairIterator(iterator) : nullptr) {
+
+            Value first;
+            Value second;
+
+            while (pairs->nextPair(first, second)) {
+                scope->setSlot(clause.slots[0], std::move(first));
+                scope->setSlot(clause.slots[1], std::move(second));
+                step();
+            }
+
+            return;
+        }
+
+        Value item;
+
+        while (iterNext(iterator, item, scope)) {
+            comprehension.bind(clause, *scope, item);
+            step();
+        }
+    }
+}
+
+Comprehension::Comprehension(const Kind kind,
+                             std::shared_ptr<ASTNode> element,
+                             std::shared_ptr<ASTNode> value,
+                             std::vector<ComprehensionClause> clauses)
+    : kind(kind),
+      element(std::move(element)),
+      value(std::move(value)),
+      clauses(std::move(clauses)) {
+
+    // переменные циклов — параметры кадра включения, повторы занимают один слот
+    std::vector<Param> params;
+    QSet<QString> seen;
+
+    for (const auto& clause : this->clauses) {
+        for (const auto& target : clause.targets) {
+            if (!seen.contains(target)) {
+                seen.insert(target);
+                params.push_back(Param{target, {}});
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<ASTNode>> body{this->element};
+
+    if (this->value) {
+        body.push_back(this->value);
+    }
+
+    for (std::size_t i = 0; i < this->clauses.size(); ++i) {
+
+        if (i > 0) {
+            body.push_back(this->clauses[i].iterable);
+        }
+
+        body.insert(body.end(), this->clauses[i].conditions.begin(), this->clauses[i].conditions.end());
+    }
+
+    scope = Resolver::resolveFunction(params, body);
+    layout = scope->layout;
+
+    // переменная цикла, которую захватывает лямбда в элементе, живёт в ячейке
+    for (auto& clause : this->clauses) {
+        for (const auto& target : clause.targets) {
+            if (const auto cell = layout->cellIndices.constFind(target); cell != layout->cellIndices.constEnd()) {
+                clause.slots.push_back(LocalSlot{layout.get(), cell.value(), true});
+            } else {
+                clause.slots.push_back(LocalSlot{layout.get(), layout->indices.value(target)});
+            }
+        }
+    }
+}
+
+void Comprehension::resolve(Resolver& r) const {
+    r.visit(clauses.front().iterable);
+    r.nested(*scope);
+}
+
+std::shared_ptr<Environment> Comprehension::makeScope(const std::shared_ptr<Environment>& env) const {
+
+    const auto frame = makePooled<Environment>(env, layout);
+
+    if (layout->cellNames.size() > layout->ownCells) {
+        frame->bindFreeCells(env->captureCells(*layout));
+    }
+
+    return frame;
+}
+
+void Comprehension::bind(const ComprehensionClause& clause, Environment& scope, const Value& item) const {
+
+    if (clause.targets.size() == 1) {
+        scope.setSlot(clause.slots.front(), item);
+        return;
+    }
+
+    const auto values = VectorPool<Value>::acquire();
+    unpackSequence(item, clause.targets.size(), *values, scope.shared_from_this());
+
+    for (std::size_t i = 0; i < clause.targets.size(); ++i) {
+        scope.setSlot(clause.slots[i], std::move((*values)[i]));
+    }
+}
+
+bool Comprehension::accepts(const ComprehensionClause& clause, const std::shared_ptr<Environment>& scope) const {
+
+    for (const auto& condition : clause.conditions) {
+        if (!condition->evalCondition(scope)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Value Comprehension::evalList(const std::shared_ptr<Environment>& env) const {
+
+    const Value source = clauses.front().iterable->eval(env);
+    const auto scope = makeScope(env);
+
+    std::vector<Value> elements;
+
+    // без фильтров и вложенных циклов длина результата равна длине источника
+    if (clauses.size() == 1 && clauses.front().conditions.empty()) {
+        elements.reserve(ListValue::lengthHint(source));
+    }
+
+    auto emit = [&] { elements.push_back(element->eval(scope)); };
+    forEach(*this, scope, 0, source, emit);
+
+    return Value(makePooled<ListValue>(std::move(elements)));
+}
+
+Value Comprehension::evalSet(const std::shared_ptr<Environment>& env) const {
+
+    const Value source = clauses.front().iterable->eval(env);
+    const auto scope = makeScope(env);
+
+    const auto set = std::make_shared<SetValue>();
+
+    auto emit = [&] { set->add(element->eval(scope)); };
+    forEach(*this, scope, 0, source, emit);
+
+    return Value(set);
+}
+
+Value Comprehension::evalDict(const std::shared_ptr<Environment>& env) const {
+
+    const Value source = clauses.front().iterable->eval(env);
+    const auto scope = makeScope(env);
+
+    const auto dict = std::make_shared<DictValue>();
+
+    // как у списка: одна секция без фильтров — не больше ключей, чем элементов источника
+    if (clauses.size() == 1 && clauses.front().conditions.empty()) {
+        dict->reserve(ListValue::lengthHint(source));
+    }
+
+    auto emit = [&] {
+        Value key = element->eval(scope);
+        dict->setItem(key, value->eval(scope));
+    };
+
+    forEach(*this, scope, 0, source, emit);
+
+    return Value(dict);
+}
+
+Value Comprehension::makeGenerator(const std::shared_ptr<const Comprehension>& self,
+                                   const std::shared_ptr<Environment>& env) {
+
+    // как в CPython: ошибка «не итерируемый источник» возникает при создании генератора
+    const Value source = getIter(self->clauses.front().iterable->eval(env), env);
+
+    return Value(std::make_shared<GeneratorExpressionIterator>(self, self->makeScope(env), source));
+}
+
+QString Comprehension::toString() const {
+
+    QString text = element->toString();
+
+    if (value) {
+        text += ": " + value->toString();
+    }
+
+    for (const auto& clause : clauses) {
+
+        text += " for " + QStringList(clause.targets.begin(), clause.targets.end()).join(", ") +
+                " in " + clause.iterable->toString();
+
+        for (const auto& condition : clause.conditions) {
+            text += " if " + condition->toString();
+        }
+    }
+
+    switch (kind) {
+        case Kind::List: return "[" + text + "]";
+        case Kind::Generator: return "(" + text + ")";
+        default: return "{" + text + "}";
+    }
+}
+
+GeneratorExpressionIterator::GeneratorExpressionIterator(std::shared_ptr<const Comprehension> comprehension,
+                                                         std::shared_ptr<Environment> scope,
+                                                         Value source)
+    : LookaheadIterator(std::move(scope)),
+      comprehension(std::move(comprehension)) {
+
+    iterators.push_back(std::move(source));
+}
+
+bool GeneratorExpressionIterator::produce(Value& out) {
+
+    const auto& clauses = comprehension->clauses;
+    Value item;
+
+    while (!iterators.empty()) {
+
+        const ComprehensionClause& clause = clauses[iterators.size() - 1];
+
+        if (!iterNext(iterators.back(), item, env)) {
+            iterators.pop_back();
+            continue;
+        }
+
+        comprehension->bind(clause, *env, item);
+
+        if (!comprehension->accepts(clause, env)) {
+            continue;
+        }
+
+        if (iterators.size() == clauses.size()) {
+            out = comprehension->element->eval(env);
+            return true;
+        }
+
+        iterators.push_back(getIter(clauses[iterators.size()].iterable->eval(env), env));
+    }
+
+    return false;
+}
+
+QString GeneratorExpressionIterator::toString() const {
+    return QString("<generator object <genexpr> at 0x%1>").arg(reinterpret_cast<quintptr>(this), 0, 16);
+}
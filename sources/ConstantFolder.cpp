@@ -0,0 +1,322 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ConstantFolder.h"
+
+#include "FrozenSetValue.h"
+#include "ObjectPool.h"
+#include "Parser.h"
+#include "TupleValue.h"
+
+namespace {
+
+/// наибольшая длина сворачиваемой строки или bytes
+constexpr std::size_t maxSequenceLength = 4096;
+
+/// наибольшая длина кортежа, полученного операцией над кортежами
+constexpr std::size_t maxCollectionLength = 256;
+
+/// наибольшая разрядность сворачиваемого целого
+constexpr unsigned maxIntBits = 128;
+
+bool isInteger(const Value& value) {
+    return std::holds_alternative<Value::SmallInt>(value.data) || std::holds_alternative<Value::BigIntPtr>(value.data);
+}
+
+/// число значащих бит модуля целого
+unsigned intBits(const Value& value) {
+
+    if (const auto small = std::get_if<Value::SmallInt>(&value.data)) {
+
+        auto magnitude = *small < 0 ? 0 - static_cast<std::uint64_t>(*small) : static_cast<std::uint64_t>(*small);
+        unsigned bits = 0;
+
+        while (magnitude) {
+            magnitude >>= 1;
+            ++bits;
+        }
+
+        return bits;
+    }
+
+    const auto& big = *std::get<Value::BigIntPtr>(value.data);
+
+    return big.is_zero() ? 0 : static_cast<unsigned>(boost::multiprecision::msb(abs(big))) + 1;
+}
+
+/// длина строки, bytes или кортежа и предел длины для такого результата
+std::optional<std::pair<std::size_t, std::size_t>> sequenceLength(const Value& value) {
+
+    if (const auto str = std::get_if<Value::StrPtr>(&value.data)) {
+        return std::make_pair((*str)->len(), maxSequenceLength);
+    }
+
+    if (const auto bytes = std::get_if<Value::BytesPtr>(&value.data)) {
+        return std::make_pair((*bytes)->len(), maxSequenceLength);
+    }
+
+    if (const auto tuple = std::get_if<Value::TuplePtr>(&value.data)) {
+        return std::make_pair((*tuple)->len(), maxCollectionLength);
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * Оценивает результат до вычисления: `2 ** 10**6` или `'x' * 10**9` не должны
+ * вычисляться во время компиляции, тем более что код может вообще не выполниться.
+ */
+bool tooLarge(const BinOpNode::Operation operation, const Value& left, const Value& right) {
+
+    if (operation == BinOpNode::Operation::Power && isInteger(left) && isInteger(right)) {
+
+        // отрицательная степень даёт float, ±1 и 0 в любой степени малы
+        if (right.toBigInt() < 0 || intBits(left) <= 1) {
+            return false;
+        }
+
+        return intBits(right) > 16 || intBits(left) * right.toBigInt() > maxIntBits;
+    }
+
+    if (operation == BinOpNode::Operation::Multiply) {
+
+        const auto checkRepeat = [](const Value& sequence, const Value& count) {
+
+            const auto length = sequenceLength(sequence);
+
+            if (!length || !isInteger(count) || length->first == 0) {
+                return false;
+            }
+
+            return intBits(count) > 32 || length->first * count.toBigInt() > length->second;
+        };
+
+        return checkRepeat(left, right) || checkRepeat(right, left);
+    }
+
+    return false;
+}
+
+/// значение неизменяемо и достаточно мало, чтобы стать константой байткода
+bool isFoldableResult(const Value& value) {
+
+    if (value.isNone() || value.isBool() || value.isDouble() || value.isFrozenSet()) {
+        return true;
+    }
+
+    if (isInteger(value)) {
+        return intBits(value) <= maxIntBits;
+    }
+
+    if (const auto length = sequenceLength(value)) {
+        return length->first <= length->second || value.isTuple();
+    }
+
+    return false;
+}
+
+/// элементы литерала коллекции, если все они константы
+std::optional<std::vector<Value>> foldElements(const std::vector<std::shared_ptr<ASTNode>>& elements) {
+
+    std::vector<Value> values;
+    values.reserve(elements.size());
+
+    for (const auto& element : elements) {
+
+        const auto value = ConstantFolder::fold(element);
+
+        if (!value) {
+            return std::nullopt;
+        }
+
+        values.push_back(*value);
+    }
+
+    return values;
+}
+
+}
+
+std::optional<Value> ConstantFolder::fold(const std::shared_ptr<ASTNode>& node) {
+
+    if (const auto literal = dynamic_cast<const ValueNode*>(node.get())) {
+        return literal->value;
+    }
+
+    if (const auto unary = dynamic_cast<const UnaryOpNode*>(node.get())) {
+
+        const auto operand = unary->operation ? fold(unary->operand) : std::nullopt;
+
+        if (!operand) {
+            return std::nullopt;
+        }
+
+        try {
+            const Value result = UnaryOpNode::apply(*unary->operation, *operand);
+            return isFoldableResult(result) ? std::optional(result) : std::nullopt;
+        } catch (...) {
+            return std::nullopt;
+        }
+    }
+
+    if (const auto binOp = dynamic_cast<const BinOpNode*>(node.get())) {
+
+        const auto operation = binOp->operation;
+
+        if (!operation || *operation == BinOpNode::Operation::And || *operation == BinOpNode::Operation::Or) {
+            return std::nullopt;
+        }
+
+        const auto left = fold(binOp->left);
+        const auto right = left ? fold(binOp->right) : std::nullopt;
+
+        if (!right || tooLarge(*operation, *left, *right)) {
+            return std::nullopt;
+        }
+
+        try {
+            const Value result = BinOpNode::apply(*operation, *left, *right);
+            return isFoldableResult(result) ? std::optional(result) : std::nullopt;
+        } catch (...) {
+            return std::nullopt;
+        }
+    }
+
+    // литералы без свёртки в ConcatNode: "a" + "b" + "c" — одна константа
+    if (const auto concat = dynamic_cast<const ConcatNode*>(node.get())) {
+
+        auto result = fold(concat->pieces.front());
+
+        for (std::size_t i = 1; result && i < concat->pieces.size(); ++i) {
+
+            const auto piece = fold(concat->pieces[i]);
+
+            if (!piece) {
+                return std::nullopt;
+            }
+
+            try {
+                result = BinOpNode::apply(BinOpNode::Operation::Add, *result, *piece);
+            } catch (...) {
+                return std::nullopt;
+            }
+
+            if (!isFoldableResult(*result)) {
+                return std::nullopt;
+            }
+        }
+
+        return result;
+    }
+
+    if (const auto compare = dynamic_cast<const CompareNode*>(node.get())) {
+
+        auto a = fold(compare->left);
+
+        if (!a) {
+            return std::nullopt;
+        }
+
+        std::vector<Value> operands;
+
+        for (std::size_t i = 0; i < compare->rights.size(); ++i) {
+
+            const auto& operation = compare->operations[i];
+
+            if (!operation) {
+                return std::nullopt;
+            }
+
+            const bool membership = *operation == CompareNode::Operation::In ||
+                                    *operation == CompareNode::Operation::NotIn;
+
+            const auto b = membership ? foldContainer(compare->rights[i]) : fold(compare->rights[i]);
+
+            if (!b) {
+                return std::nullopt;
+            }
+
+            operands.push_back(*b);
+        }
+
+        // операнды вычислены заранее: у литералов нет побочных эффектов
+        try {
+            for (std::size_t i = 0; i < operands.size(); ++i) {
+
+                if (!CompareNode::compare(*a, operands[i], *compare->operations[i])) {
+                    return Value(false);
+                }
+
+                a = operands[i];
+            }
+        } catch (...) {
+            return std::nullopt;
+        }
+
+        return Value(true);
+    }
+
+    if (const auto logical = dynamic_cast<const LogicalOpNode*>(node.get())) {
+
+        if (logical->op != "and" && logical->op != "or") {
+            return std::nullopt;
+        }
+
+        const auto left = fold(logical->left);
+
+        if (!left) {
+            return std::nullopt;
+        }
+
+        // результат определяется левым операндом — правый может быть любым
+        if (left->toBool() == (logical->op == "or")) {
+            return left;
+        }
+
+        return fold(logical->right);
+    }
+
+    if (const auto tuple = dynamic_cast<const TupleNode*>(node.get())) {
+
+        if (auto values = foldElements(tuple->elements)) {
+            return TupleValue::make(std::move(*values));
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<Value> ConstantFolder::foldContainer(const std::shared_ptr<ASTNode>& node) {
+
+    if (const auto set = dynamic_cast<const SetNode*>(node.get())) {
+
+        const auto values = foldElements(set->elements);
+
+        if (!values) {
+            return std::nullopt;
+        }
+
+        OrderedValueSet elements;
+
+        try {
+            for (const Value& value : *values) {
+                elements.insert(value);
+            }
+        } catch (...) {
+            return std::nullopt;
+        }
+
+        return Value(std::make_shared<FrozenSetValue>(std::move(elements)));
+    }
+
+    if (const auto list = dynamic_cast<const ListNode*>(node.get())) {
+
+        if (auto values = foldElements(list->elements)) {
+            return Value(makePooled<TupleValue>(std::move(*values)));
+        }
+
+        return std::nullopt;
+    }
+
+    return fold(node);
+}
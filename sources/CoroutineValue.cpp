@@ -0,0 +1,15 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "CoroutineValue.h"
+
+CoroutineValue* CoroutineValue::of(const Value& value) {
+
+    const auto iterator = std::get_if<Value::IteratorPtr>(&value.data);
+
+    return iterator ? dynamic_cast<CoroutineValue*>(iterator->get()) : nullptr;
+}
+
+QString CoroutineValue::getTypeName() const {
+    return "coroutine";
+}
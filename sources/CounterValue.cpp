@@ -0,0 +1,263 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "CounterValue.h"
+
+#include <algorithm>
+
+#include "CallRuntime.h"
+#include "ClassUtils.h"
+#include "IntOps.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "TupleValue.h"
+
+namespace {
+
+    const Value zero(Value::SmallInt(0));
+
+    bool positive(const Value& count) {
+        return count > zero;
+    }
+}
+
+CounterValue* CounterValue::of(const Value& value) {
+
+    const auto dict = std::get_if<Value::DictPtr>(&value.data);
+
+    return dict ? dynamic_cast<CounterValue*>(dict->get()) : nullptr;
+}
+
+QString CounterValue::toString() const {
+
+    if (len() == 0) {
+        return "Counter()";
+    }
+
+    QString out = "Counter({";
+    bool first = true;
+
+    for (const Value& item : mostCommon(std::nullopt).asList()->elements.get()) {
+
+        const auto& pair = item.asTuple()->items;
+
+        if (!first) {
+            out += ", ";
+        }
+
+        first = false;
+        out += pair[0].repr() + ": " + pair[1].repr();
+    }
+
+    return out + "})";
+}
+
+Value CounterValue::copy() const {
+    return Value(std::static_pointer_cast<DictValue>(std::make_shared<CounterValue>(*this)));
+}
+
+Value CounterValue::missing(const Value&) {
+    return zero;
+}
+
+void CounterValue::increment(const Value& key, const Value& delta) {
+
+    if (!key.isHashable()) {
+        throw std::runtime_error("TypeError: unhashable type");
+    }
+
+    const std::ptrdiff_t ix = lookup(key, qHash(key));
+
+    if (ix < 0) {
+        insert(key, delta);
+        return;
+    }
+
+    Value& slot = entries[ix].value;
+
+    const auto* a = std::get_if<Value::SmallInt>(&slot.data);
+    const auto* b = std::get_if<Value::SmallInt>(&delta.data);
+
+    if (Value::SmallInt sum; a && b && !intops::addOverflow(*a, *b, sum)) {
+        slot = Value(sum);
+    } else {
+        slot = slot + delta;
+    }
+}
+
+void CounterValue::count(const Value& source, const int sign, const std::shared_ptr<Environment>& env) {
+
+    if (const auto dict = std::get_if<Value::DictPtr>(&source.data)) {
+
+        // копия пар: источник может быть самим счётчиком
+        std::vector<std::pair<Value, Value>> items;
+        items.reserve((*dict)->len());
+
+        (*dict)->forEachItem([&](const Value& key, const Value& value) {
+            items.emplace_back(key, value);
+        });
+
+        for (const auto& [key, value] : items) {
+            increment(key, sign > 0 ? value : -value);
+        }
+
+        return;
+    }
+
+    const Value delta(Value::SmallInt{sign});
+    const Value iterator = getIter(source, env);
+
+    for (Value item; iterNext(iterator, item, env);) {
+        increment(item, delta);
+    }
+}
+
+Value CounterValue::mostCommon(const std::optional<qsizetype> n) const {
+
+    struct Ranked {
+        const Entry* entry;
+        std::size_t order;
+    };
+
+    std::vector<Ranked> ranked;
+    ranked.reserve(len());
+
+    for (const Entry& entry : entries) {
+        if (entry.live) {
+            ranked.push_back({&entry, ranked.size()});
+        }
+    }
+
+    // больший счётчик раньше, при равных — раньше вставленный
+    const auto before = [](const Ranked& a, const Ranked& b) {
+
+        if (b.entry->value < a.entry->value) {
+            return true;
+        }
+
+        return !(a.entry->value < b.entry->value) && a.order < b.order;
+    };
+
+    const std::size_t taken = n ? std::clamp<qsizetype>(*n, 0, static_cast<qsizetype>(ranked.size())) : ranked.size();
+
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(taken), ranked.end(), before);
+
+    const auto result = makePooled<ListValue>();
+    result->elements.reserve(taken);
+
+    for (std::size_t i = 0; i < taken; ++i) {
+        result->elements.push_back(TupleValue::pair(ranked[i].entry->key, ranked[i].entry->value));
+    }
+
+    return Value(result);
+}
+
+Value CounterValue::elements() const {
+
+    const auto result = makePooled<ListValue>();
+
+    forEachItem([&](const Value& key, const Value& value) {
+
+        if (!value.isBigInt() && !value.isBool()) {
+            throw std::runtime_error(
+                "TypeError: '" + typeName(value).toStdString() + "' object cannot be interpreted as an integer");
+        }
+
+        for (Value::BigInt i = value.toBigInt(); i > 0; --i) {
+            result->elements.push_back(key);
+        }
+    });
+
+    return Value(result);
+}
+
+Value CounterValue::total() const {
+
+    Value sum = zero;
+
+    forEachItem([&](const Value&, const Value& value) {
+        sum = sum + value;
+    });
+
+    return sum;
+}
+
+template<typename Combine>
+Value CounterValue::merge(const Value& other, Combine combine) const {
+
+    const CounterValue* rhs = of(other);
+
+    if (!rhs) {
+        return Value::notImplemented();
+    }
+
+    const auto result = std::make_shared<CounterValue>();
+
+    forEachItem([&](const Value& key, const Value& value) {
+
+        const Value* found = rhs->find(key);
+        const Value merged = combine(value, found ? *found : zero);
+
+        if (positive(merged)) {
+            result->setItem(key, merged);
+        }
+    });
+
+    rhs->forEachItem([&](const Value& key, const Value& value) {
+
+        if (find(key)) {
+            return;
+        }
+
+        const Value merged = combine(zero, value);
+
+        if (positive(merged)) {
+            result->setItem(key, merged);
+        }
+    });
+
+    return Value(std::static_pointer_cast<DictValue>(result));
+}
+
+Value CounterValue::add(const Value& other) const {
+    return merge(other, [](const Value& a, const Value& b) { return a + b; });
+}
+
+Value CounterValue::sub(const Value& other) const {
+    return merge(other, [](const Value& a, const Value& b) { return a - b; });
+}
+
+Value CounterValue::bitOr(const Value& other) const {
+    return merge(other, [](const Value& a, const Value& b) { return a < b ? b : a; });
+}
+
+Value CounterValue::bitAnd(const Value& other) const {
+    return merge(other, [](const Value& a, const Value& b) { return a < b ? a : b; });
+}
+
+bool CounterValue::equal(const Value& other) const {
+
+    const CounterValue* rhs = of(other);
+
+    if (!rhs) {
+        return DictValue::equal(other);
+    }
+
+    const auto covered = [](const CounterValue& left, const CounterValue& right) {
+
+        bool same = true;
+
+        left.forEachItem([&](const Value& key, const Value& value) {
+            const Value* found = right.find(key);
+            same = same && value == (found ? *found : zero);
+        });
+
+        return same;
+    };
+
+    return covered(*this, *rhs) && covered(*rhs, *this);
+}
+
+bool CounterValue::notEqual(const Value& other) const {
+    return !equal(other);
+}
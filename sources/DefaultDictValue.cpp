@@ -0,0 +1,50 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "DefaultDictValue.h"
+
+#include <utility>
+
+#include "CallRuntime.h"
+#include "PyException.h"
+
+DefaultDictValue::DefaultDictValue(Value factory) : factory(std::move(factory)) {}
+
+DefaultDictValue* DefaultDictValue::of(const Value& value) {
+
+    const auto dict = std::get_if<Value::DictPtr>(&value.data);
+
+    return dict ? dynamic_cast<DefaultDictValue*>(dict->get()) : nullptr;
+}
+
+QString DefaultDictValue::toString() const {
+    return "defaultdict(" + factory.repr() + ", " + DictValue::toString() + ")";
+}
+
+Value DefaultDictValue::copy() const {
+    return Value(std::static_pointer_cast<DictValue>(std::make_shared<DefaultDictValue>(*this)));
+}
+
+Value DefaultDictValue::missing(const Value& key) {
+
+    if (factory.isNone()) {
+        return DictValue::missing(key);
+    }
+
+    Value value = call(factory, {}, {}, nullptr);
+    setItem(key, value);
+
+    return value;
+}
+
+void DefaultDictValue::gcTraverse(const GcVisitor& visit) const {
+
+    DictValue::gcTraverse(visit);
+    gcVisitValue(factory, visit);
+}
+
+void DefaultDictValue::gcClear() {
+
+    DictValue::gcClear();
+    factory = Value();
+}
@@ -0,0 +1,32 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "DequeIterator.h"
+
+#include "DequeValue.h"
+#include "StopIterationException.h"
+
+DequeIterator::DequeIterator(std::shared_ptr<DequeValue> deque)
+    : deque(std::move(deque)), version(this->deque->version()) {}
+
+Value DequeIterator::next() {
+
+    if (!hasNext()) {
+        throw StopIterationException();
+    }
+
+    return deque->at(index++);
+}
+
+bool DequeIterator::hasNext() const {
+
+    if (deque->version() != version) {
+        throw std::runtime_error("RuntimeError: deque mutated during iteration");
+    }
+
+    return index < deque->len();
+}
+
+QString DequeIterator::getTypeName() const {
+    return "_collections._deque_iterator";
+}
@@ -0,0 +1,461 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "DequeValue.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <QStringList>
+
+#include "CallRuntime.h"
+#include "ClassUtils.h"
+
+DequeValue::DequeValue(const std::optional<qsizetype> maxlen) : maxlen(maxlen) {}
+
+DequeValue* DequeValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<DequeValue*>(object->get()) : nullptr;
+}
+
+Value& DequeValue::slot(const qsizetype position) {
+
+    auto& block = blocks[(first + position / blockSize) % blocks.size()];
+
+    if (!block) {
+        block = std::make_unique<Block>();
+    }
+
+    return (*block)[position % blockSize];
+}
+
+const Value& DequeValue::slot(const qsizetype position) const {
+    return (*blocks[(first + position / blockSize) % blocks.size()])[position % blockSize];
+}
+
+void DequeValue::grow() {
+
+    const std::size_t size = blocks.size();
+
+    std::vector<std::unique_ptr<Block>> ring(std::max<std::size_t>(4, 2 * size));
+
+    for (std::size_t k = 0; k < size; ++k) {
+        ring[k] = std::move(blocks[(first + k) % size]);
+    }
+
+    blocks = std::move(ring);
+    first = 0;
+}
+
+const Value& DequeValue::at(const qsizetype index) const {
+    return slot(head + index);
+}
+
+void DequeValue::append(const Value& value) {
+
+    if (maxlen && *maxlen == 0) {
+        return;
+    }
+
+    if (maxlen && count == *maxlen) {
+        popLeft();
+    }
+
+    if (head + count == static_cast<qsizetype>(blocks.size()) * blockSize) {
+        grow();
+    }
+
+    slot(head + count) = value;
+    ++count;
+    ++state;
+}
+
+void DequeValue::appendLeft(const Value& value) {
+
+    if (maxlen && *maxlen == 0) {
+        return;
+    }
+
+    if (maxlen && count == *maxlen) {
+        pop();
+    }
+
+    if (head == 0) {
+
+        // свободный блок перед first есть, пока занятые блоки не заполнили кольцо
+        if ((count + blockSize - 1) / blockSize >= static_cast<qsizetype>(blocks.size())) {
+            grow();
+        }
+
+        first = (first + static_cast<qsizetype>(blocks.size()) - 1) % static_cast<qsizetype>(blocks.size());
+        head = blockSize;
+    }
+
+    --head;
+    slot(head) = value;
+    ++count;
+    ++state;
+}
+
+Value DequeValue::pop() {
+
+    if (count == 0) {
+        throw std::runtime_error("IndexError: pop from an empty deque");
+    }
+
+    Value& cell = slot(head + count - 1);
+    Value result = std::move(cell);
+    cell = Value();
+
+    if (--count == 0) {
+        head = 0;
+    }
+
+    ++state;
+
+    return result;
+}
+
+Value DequeValue::popLeft() {
+
+    if (count == 0) {
+        throw std::runtime_error("IndexError: pop from an empty deque");
+    }
+
+    Value& cell = slot(head);
+    Value result = std::move(cell);
+    cell = Value();
+
+    if (++head == blockSize) {
+        head = 0;
+        first = (first + 1) % static_cast<qsizetype>(blocks.size());
+    }
+
+    if (--count == 0) {
+        head = 0;
+    }
+
+    ++state;
+
+    return result;
+}
+
+void DequeValue::extend(const Value& iterable) {
+
+    // d.extend(d): источник растёт во время обхода, поэтому сначала снимок
+    if (of(iterable) == this) {
+
+        const std::vector<Value> items = [this] {
+            std::vector<Value> snapshot;
+            snapshot.reserve(count);
+            for (qsizetype i = 0; i < count; ++i) {
+                snapshot.push_back(at(i));
+            }
+            return snapshot;
+        }();
+
+        for (const Value& item : items) {
+            append(item);
+        }
+
+        return;
+    }
+
+    const Value iterator = getIter(iterable, nullptr);
+
+    for (Value item; iterNext(iterator, item, nullptr);) {
+        append(item);
+    }
+}
+
+void DequeValue::extendLeft(const Value& iterable) {
+
+    if (of(iterable) == this) {
+        extendLeft(copy());
+        return;
+    }
+
+    const Value iterator = getIter(iterable, nullptr);
+
+    for (Value item; iterNext(iterator, item, nullptr);) {
+        appendLeft(item);
+    }
+}
+
+qsizetype DequeValue::checkedIndex(const Value& index) const {
+
+    if (!index.isBigInt() && !index.isBool()) {
+        throw std::runtime_error(
+            "TypeError: sequence index must be integer, not '" + typeName(index).toStdString() + "'");
+    }
+
+    Value::BigInt position = index.toBigInt();
+
+    if (position < 0) {
+        position += count;
+    }
+
+    if (position < 0 || position >= count) {
+        throw std::runtime_error("IndexError: deque index out of range");
+    }
+
+    return position.convert_to<qsizetype>();
+}
+
+Value DequeValue::getItem(const Value& index) const {
+    return at(checkedIndex(index));
+}
+
+void DequeValue::setItem(const Value& index, const Value& value) {
+    slot(head + checkedIndex(index)) = value;
+}
+
+void DequeValue::delItem(const Value& index) {
+    erase(checkedIndex(index));
+}
+
+void DequeValue::erase(const qsizetype index) {
+
+    // сдвигается меньшая часть: удаление у краёв остаётся O(1)
+    if (index < count / 2) {
+
+        for (qsizetype k = index; k > 0; --k) {
+            slot(head + k) = std::move(slot(head + k - 1));
+        }
+
+        popLeft();
+        return;
+    }
+
+    for (qsizetype k = index; k + 1 < count; ++k) {
+        slot(head + k) = std::move(slot(head + k + 1));
+    }
+
+    pop();
+}
+
+void DequeValue::insert(const Value& index, const Value& value) {
+
+    if (maxlen && count == *maxlen) {
+        throw std::runtime_error("IndexError: deque already at its maximum size");
+    }
+
+    Value::BigInt position = index.asBigInt("insert");
+
+    if (position < 0) {
+        position += count;
+    }
+
+    const qsizetype at = position < 0 ? 0 : position > count ? count : position.convert_to<qsizetype>();
+
+    if (at == count) {
+        append(value);
+        return;
+    }
+
+    // место под элемент освобождается сдвигом ближней к краю части
+    if (at < count / 2) {
+
+        appendLeft(slot(head));
+
+        for (qsizetype k = 1; k < at; ++k) {
+            slot(head + k) = std::move(slot(head + k + 1));
+        }
+
+    } else {
+
+        append(slot(head + count - 1));
+
+        for (qsizetype k = count - 2; k > at; --k) {
+            slot(head + k) = std::move(slot(head + k - 1));
+        }
+    }
+
+    slot(head + at) = value;
+}
+
+void DequeValue::remove(const Value& value) {
+
+    for (qsizetype i = 0; i < count; ++i) {
+
+        if (at(i).itemEquals(value)) {
+            erase(i);
+            return;
+        }
+    }
+
+    throw std::runtime_error("ValueError: " + value.repr().toStdString() + " is not in deque");
+}
+
+void DequeValue::clear() {
+
+    // элементы уничтожаются после сброса: их деструкторы видят уже пустую очередь
+    const auto released = std::move(blocks);
+
+    blocks.clear();
+    first = 0;
+    head = 0;
+    count = 0;
+    ++state;
+}
+
+void DequeValue::rotate(const qsizetype steps) {
+
+    if (count <= 1) {
+        return;
+    }
+
+    qsizetype shift = steps % count;
+
+    if (shift < 0) {
+        shift += count;
+    }
+
+    // вправо на shift или влево на count - shift — что короче
+    if (shift <= count / 2) {
+
+        for (qsizetype i = 0; i < shift; ++i) {
+            appendLeft(pop());
+        }
+
+    } else {
+
+        for (qsizetype i = shift; i < count; ++i) {
+            append(popLeft());
+        }
+    }
+}
+
+void DequeValue::reverse() {
+
+    for (qsizetype i = 0, j = count - 1; i < j; ++i, --j) {
+        std::swap(slot(head + i), slot(head + j));
+    }
+
+    ++state;
+}
+
+qsizetype DequeValue::countOf(const Value& value) const {
+
+    qsizetype result = 0;
+
+    for (qsizetype i = 0; i < count; ++i) {
+
+        if (at(i).itemEquals(value)) {
+            ++result;
+        }
+    }
+
+    return result;
+}
+
+qsizetype DequeValue::index(const Value& value, const qsizetype start, const qsizetype stop) const {
+
+    for (qsizetype i = std::max<qsizetype>(start, 0); i < std::min(stop, count); ++i) {
+
+        if (at(i).itemEquals(value)) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("ValueError: " + value.repr().toStdString() + " is not in deque");
+}
+
+Value DequeValue::copy() const {
+
+    const auto result = std::make_shared<DequeValue>(maxlen);
+
+    for (qsizetype i = 0; i < count; ++i) {
+        result->append(at(i));
+    }
+
+    return Value(std::static_pointer_cast<ObjectValue>(result));
+}
+
+bool DequeValue::contains(const Value& value) const {
+
+    for (qsizetype i = 0; i < count; ++i) {
+
+        if (at(i).itemEquals(value)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool DequeValue::equal(const Value& other) const {
+
+    const DequeValue* deque = of(other);
+
+    if (!deque || deque->count != count) {
+        return false;
+    }
+
+    for (qsizetype i = 0; i < count; ++i) {
+
+        if (!(at(i) == deque->at(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DequeValue::notEqual(const Value& other) const {
+    return !equal(other);
+}
+
+QString DequeValue::toString() const {
+
+    // deque, содержащий сам себя, печатается как [...]
+    static thread_local std::vector<const DequeValue*> printing;
+
+    if (std::find(printing.begin(), printing.end(), this) != printing.end()) {
+        return "[...]";
+    }
+
+    printing.push_back(this);
+
+    QStringList parts;
+
+    try {
+        for (qsizetype i = 0; i < count; ++i) {
+            parts << at(i).repr();
+        }
+    } catch (...) {
+        printing.pop_back();
+        throw;
+    }
+
+    printing.pop_back();
+
+    QString result = "deque([" + parts.join(", ") + "]";
+
+    if (maxlen) {
+        result += QString(", maxlen=%1").arg(*maxlen);
+    }
+
+    return result + ")";
+}
+
+long DequeValue::gcRefCount() const {
+    return weak_from_this().use_count();
+}
+
+std::shared_ptr<GcObject> DequeValue::gcSelf() {
+    return shared_from_this();
+}
+
+void DequeValue::gcTraverse(const GcVisitor& visit) const {
+
+    for (qsizetype i = 0; i < count; ++i) {
+        gcVisitValue(at(i), visit);
+    }
+}
+
+void DequeValue::gcClear() {
+    clear();
+}
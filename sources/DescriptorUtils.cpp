@@ -10,7 +10,10 @@
 #include "ClassMethodValue.h"
 #include "ClassUtils.h"
 #include "FunctionValue.h"
+#include "InstanceValue.h"
+#include "ObjectPool.h"
 #include "PropertyValue.h"
+#include "PyException.h"
 #include "StaticMethodValue.h"
 
 bool DescriptorUtils::hasGet(const Value& descriptor) {
@@ -27,14 +30,10 @@ bool DescriptorUtils::hasGet(const Value& descriptor) {
     if (std::holds_alternative<Value::ClassMethodPtr>(descriptor.data))
         return true;
 
-    // user-defined descriptor
-    try {
-        getAttrValue(descriptor, "__get__");
-        return true;
-    }
-    catch (...) {
-        return false;
-    }
+    // user-defined descriptor: __get__ ищется в классе экземпляра, без пробного поиска с исключением
+    const auto instance = std::get_if<Value::InstancePtr>(&descriptor.data);
+
+    return instance && findAttrInHierarchy((*instance)->klass, "__get__").has_value();
 }
 
 Value DescriptorUtils::callGet(const Value& descriptor,
@@ -92,13 +91,9 @@ bool DescriptorUtils::hasSet(const Value& descriptor) {
         return prop->fset != nullptr;
     }
 
-    try {
-        getAttrValue(descriptor, "__set__");
-        return true;
-    }
-    catch (...) {
-        return false;
-    }
+    const auto instance = std::get_if<Value::InstancePtr>(&descriptor.data);
+
+    return instance && findAttrInHierarchy((*instance)->klass, "__set__").has_value();
 }
 
 void DescriptorUtils::callSet(const Value& descriptor,
@@ -113,13 +108,11 @@ void DescriptorUtils::callSet(const Value& descriptor,
             std::get<Value::PropertyPtr>(descriptor.data);
 
         if (!prop->fset) {
-            throw std::runtime_error(
-                "AttributeError: can't set attribute"
-            );
+            throw AttributeErrorException("can't set attribute");
         }
 
         const auto bound =
-            std::make_shared<BoundMethod>(
+            makePooled<BoundMethod>(
                 Value(prop->fset),
                 instance,
                 owner
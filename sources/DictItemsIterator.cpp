@@ -6,24 +6,45 @@
 #include "DictValue.h"
 #include "StopIterationException.h"
 
+DictItemsIterator::DictItemsIterator(std::shared_ptr<DictValue> dict)
+    : dict(std::move(dict)), size(this->dict->len()), version(this->dict->version()) {}
+
 Value DictItemsIterator::next() {
 
     if (!hasNext()) {
         throw StopIterationException();
     }
 
-    const Value key = dict->getOrder()[index++];
+    index = dict->nextLive(index);
+
+    const DictValue::Entry& entry = dict->entryAt(index++);
+
+    return TupleValue::pair(entry.key, entry.value);
+}
+
+bool DictItemsIterator::nextPair(Value& key, Value& value) {
+
+    dict->ensureUnchanged(size, version);
+
+    index = dict->nextLive(index);
+
+    if (index >= dict->entryCount()) {
+        return false;
+    }
+
+    const DictValue::Entry& entry = dict->entryAt(index++);
 
-    std::vector tupleItems = {
-        Value(key),
-        dict->getElements()[key]
-    };
+    key = entry.key;
+    value = entry.value;
 
-    return Value(std::make_shared<TupleValue>(tupleItems));
+    return true;
 }
 
 bool DictItemsIterator::hasNext() const {
-    return index < static_cast<size_t>(dict->getOrder().size());
+
+    dict->ensureUnchanged(size, version);
+
+    return dict->nextLive(index) < dict->entryCount();
 }
 
 QString DictItemsIterator::getTypeName() const {
@@ -16,7 +16,7 @@ QString DictItemsView::toString() const {
 
     bool first = true;
 
-    for (const auto& key : dict->getOrder()) {
+    dict->forEachItem([&](const Value& key, const Value& value) {
 
         if (!first) {
             out += ", ";
@@ -24,10 +24,10 @@ QString DictItemsView::toString() const {
 
         first = false;
 
-        TupleValue tuple({key, dict->getElements()[key]});
+        TupleValue tuple({key, value});
 
         out += tuple.repr();
-    }
+    });
 
     out += "])";
 
@@ -6,17 +6,25 @@
 #include "DictValue.h"
 #include "StopIterationException.h"
 
+DictKeysIterator::DictKeysIterator(std::shared_ptr<DictValue> dict)
+    : dict(std::move(dict)), size(this->dict->len()), version(this->dict->version()) {}
+
 Value DictKeysIterator::next() {
 
     if (!hasNext()) {
         throw StopIterationException();
     }
 
-    return dict->getOrder()[index++];
+    index = dict->nextLive(index);
+
+    return dict->entryAt(index++).key;
 }
 
 bool DictKeysIterator::hasNext() const {
-    return index < static_cast<size_t>(dict->getOrder().size());
+
+    dict->ensureUnchanged(size, version);
+
+    return dict->nextLive(index) < dict->entryCount();
 }
 
 QString DictKeysIterator::getTypeName() const {
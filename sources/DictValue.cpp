@@ -4,40 +4,204 @@
 #include "DictValue.h"
 #include <Value.h>
 
+#include <algorithm>
+
 #include "CallRuntime.h"
 #include "ClassUtils.h"
 #include "DictItemsView.h"
 #include "DictKeysView.h"
 #include "DictValuesView.h"
+#include "ListValue.h"
+#include "OrderedValueSet.h"
+#include "PyException.h"
+#include "ReprWriter.h"
 #include "ReversedDictIterator.h"
-#include "StopIterationException.h"
+#include "RuntimeStats.h"
 #include "TupleValue.h"
 
-DictValue:: DictValue(const QHash<Value, Value>& items,
-                      const QVector<Value>& order)
-        : elements(items),
-          order(order) {}
+std::ptrdiff_t DictValue::lookup(const Value& key, const std::size_t hash) const {
 
-QString DictValue::toString() const {
+      if (indices.empty()) {
+
+            for (std::size_t ix = 0; ix < entries.size(); ++ix) {
+
+                  const Entry& entry = entries[ix];
+
+                  if (entry.live && entry.hash == hash && entry.key.keyEquals(key)) {
+                        return static_cast<std::ptrdiff_t>(ix);
+                  }
+            }
+
+            return -1;
+      }
+
+      const std::size_t mask = indices.size() - 1;
+      std::size_t perturb = hash;
+      std::size_t i = hash & mask;
+
+      // таблица заполнена не более чем на 2/3, поэтому EMPTY всегда найдётся
+      while (true) {
+
+            const std::int32_t ix = indices[i];
+
+            if (ix == EMPTY) {
+                  return -1;
+            }
+
+            if (ix >= 0) {
+
+                  const Entry& entry = entries[ix];
+
+                  if (entry.hash == hash && entry.key.keyEquals(key)) {
+                        return ix;
+                  }
+            }
+
+            perturb >>= 5;
+            i = (i * 5 + perturb + 1) & mask;
+      }
+}
+
+const DictValue::Entry* DictValue::findEntry(const Value& key) const {
+
+      const std::ptrdiff_t ix = lookup(key, qHash(key));
+
+      return ix < 0 ? nullptr : &entries[ix];
+}
+
+void DictValue::insert(const Value& key, const Value& value) {
+      insertHashed(key, qHash(key), value);
+}
+
+void DictValue::insertHashed(const Value& key, const std::size_t hash, const Value& value) {
+
+      if (const std::ptrdiff_t ix = lookup(key, hash); ix >= 0) {
+            entries[ix].value = value;
+            return;
+      }
+
+      if (indices.empty()) {
+
+            if (entries.size() == SMALL_SIZE) {
+                  rebuild();
+            }
+
+            // перестроение могло оставить словарь малым: тогда таблица не нужна
+            if (indices.empty()) {
+
+                  if (entries.capacity() == 0) {
+                        entries.reserve(SMALL_SIZE / 2);
+                  }
+
+                  entries.push_back(Entry{hash, key, value, true});
+                  ++used;
+                  return;
+            }
+      }
+
+      const std::size_t usable = indices.size() * 2 / 3;
+
+      if (std::max(fill, entries.size()) + 1 > usable) {
+            rebuild();
+      }
 
-      QString out = "{";
+      const std::size_t mask = indices.size() - 1;
+      std::size_t perturb = hash;
+      std::size_t i = hash & mask;
 
-      bool first = true;
+      while (indices[i] >= 0) {
+            perturb >>= 5;
+            i = (i * 5 + perturb + 1) & mask;
+      }
+
+      if (indices[i] == EMPTY) {
+            ++fill;
+      }
+
+      indices[i] = static_cast<std::int32_t>(entries.size());
+      entries.push_back(Entry{hash, key, value, true});
+
+      ++used;
+}
 
-      for (const auto& key : order) {
+void DictValue::removeAt(const std::ptrdiff_t ix) {
 
-            if (!first) {
-                  out += ", ";
+      if (!indices.empty()) {
+
+            const std::size_t mask = indices.size() - 1;
+            std::size_t perturb = entries[ix].hash;
+            std::size_t i = perturb & mask;
+
+            while (indices[i] != ix) {
+                  perturb >>= 5;
+                  i = (i * 5 + perturb + 1) & mask;
             }
 
-            first = false;
+            indices[i] = DUMMY;
+      }
 
-            out += key.repr();
-            out += ": ";
-            out += elements[key].repr();
+      // надгробие отпускает ключ и значение сразу
+      entries[ix] = Entry{};
+
+      --used;
+}
+
+void DictValue::rebuild(const std::size_t capacity) {
+
+      RuntimeStats::add(RuntimeStats::DictResizes);
+
+      // малый словарь с надгробиями только уплотняется и остаётся без таблицы
+      if (indices.empty() && used < SMALL_SIZE && capacity <= SMALL_SIZE) {
+
+            entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                         [](const Entry& entry) { return !entry.live; }),
+                          entries.end());
+
+            ++layoutVersion;
+            return;
       }
 
-      out += "}";
+      std::size_t size = MIN_SIZE;
+
+      while (size < used * 3 || size * 2 / 3 < capacity) {
+            size <<= 1;
+      }
+
+      std::vector<Entry> compacted;
+      compacted.reserve(size * 2 / 3);
+
+      for (auto& entry : entries) {
+            if (entry.live) {
+                  compacted.push_back(std::move(entry));
+            }
+      }
+
+      entries = std::move(compacted);
+      indices.assign(size, EMPTY);
+
+      const std::size_t mask = size - 1;
+
+      for (std::size_t ix = 0; ix < entries.size(); ++ix) {
+
+            std::size_t perturb = entries[ix].hash;
+            std::size_t i = perturb & mask;
+
+            while (indices[i] != EMPTY) {
+                  perturb >>= 5;
+                  i = (i * 5 + perturb + 1) & mask;
+            }
+
+            indices[i] = static_cast<std::int32_t>(ix);
+      }
+
+      fill = used;
+      ++layoutVersion;
+}
+
+QString DictValue::toString() const {
+
+      QString out;
+      ReprWriter(out).dict(*this);
 
       return out;
 }
@@ -52,11 +216,18 @@ Value DictValue::getItem(const Value& key) const {
             throw std::runtime_error("TypeError: unhashable type");
       }
 
-      if (!elements.contains(key)) {
-            throw std::runtime_error("KeyError: " + key.toString().toStdString());
+      const Entry* entry = findEntry(key);
+
+      if (!entry) {
+            // defaultdict вставляет ключ из `__missing__`: чтение d[key] меняет словарь
+            return const_cast<DictValue*>(this)->missing(key);
       }
 
-      return elements[key];
+      return entry->value;
+}
+
+Value DictValue::missing(const Value& key) {
+      throw PyException(PyException::make("KeyError", {key}));
 }
 
 void DictValue::setItem(const Value &key, const Value &value) {
@@ -65,10 +236,7 @@ void DictValue::setItem(const Value &key, const Value &value) {
             throw std::runtime_error("TypeError: unhashable type");
       }
 
-      if (!elements.contains(key))
-            order.push_back(key);
-
-      elements[key] = value;
+      insert(key, value);
 }
 
 bool DictValue::hasKey(const Value &key) const {
@@ -77,7 +245,7 @@ bool DictValue::hasKey(const Value &key) const {
             return false;
       }
 
-      return elements.contains(key);
+      return findEntry(key) != nullptr;
 }
 
 Value DictValue::get(const Value &key, const Value &defaultValue) const {
@@ -86,33 +254,33 @@ Value DictValue::get(const Value &key, const Value &defaultValue) const {
             throw std::runtime_error("TypeError: unhashable type");
       }
 
-      if (!elements.contains(key)) {
-            return defaultValue;
-      }
+      const Entry* entry = findEntry(key);
 
-      return elements[key];
+      return entry ? entry->value : defaultValue;
 }
 
 std::size_t DictValue::len() const {
-      return elements.size();
+      return used;
 }
 
 void DictValue::clear() {
-      elements.clear();
-      order.clear();
+      entries.clear();
+      indices.clear();
+      used = 0;
+      fill = 0;
+      ++layoutVersion;
 }
 
 Value DictValue::copy() const {
-      return Value(std::make_shared<DictValue>(elements, order));
+      return Value(std::make_shared<DictValue>(*this));
 }
 
 Value DictValue::pop(const Value& key, const Value* defaultValue) {
 
-      if (elements.contains(key)) {
+      if (const std::ptrdiff_t ix = lookup(key, qHash(key)); ix >= 0) {
 
-            Value result = elements[key];
-            elements.remove(key);
-            order.removeAll(key);
+            Value result = entries[ix].value;
+            removeAt(ix);
 
             return result;
       }
@@ -121,63 +289,178 @@ Value DictValue::pop(const Value& key, const Value* defaultValue) {
             return *defaultValue;
       }
 
-      throw std::runtime_error("KeyError: " + key.toString().toStdString());
+      throw PyException(PyException::make("KeyError", {key}));
 }
 
 void DictValue::update(const std::shared_ptr<DictValue>& other) {
-      for (const auto& key : other->order) {
+      merge(*other);
+}
 
-            if (!elements.contains(key)) {
-                  order.push_back(key);
+void DictValue::reserve(const std::size_t extra) {
+
+      if (indices.empty() && used + extra <= SMALL_SIZE) {
+            entries.reserve(std::min(entries.size() + extra, SMALL_SIZE));
+            return;
+      }
+
+      if (!indices.empty() && std::max(fill, entries.size()) + extra <= indices.size() * 2 / 3) {
+            return;
+      }
+
+      rebuild(used + extra);
+}
+
+void DictValue::merge(const DictValue& other) {
+
+      if (&other == this || other.used == 0) {
+            return;
+      }
+
+      // ключи other уникальны, и их позиции в его таблице годятся как есть
+      if (used == 0) {
+            entries = other.entries;
+            indices = other.indices;
+            used = other.used;
+            fill = other.fill;
+            ++layoutVersion;
+            return;
+      }
+
+      reserve(other.used);
+
+      for (const Entry& entry : other.entries) {
+            if (entry.live) {
+                  insertHashed(entry.key, entry.hash, entry.value);
             }
+      }
+}
+
+void DictValue::mergePairs(const Value& iterable) {
 
-            elements[key] = other->elements[key];
+      reserve(ListValue::lengthHint(iterable));
+
+      const auto it = iterable.getIterator();
+
+      while (it->hasNext()) {
+
+            const Value item = it->next();
+            const auto pair = item.asTuple("dict()");
+
+            if (pair->items.size() != 2) {
+                  throw std::runtime_error("dict() expects (key, value) pairs");
+            }
+
+            setItem(pair->items[0], pair->items[1]);
       }
 }
 
 Value DictValue::setdefault(const Value& key, const Value& defaultValue) {
 
-      if (elements.contains(key)) {
-            return elements[key];
+      if (const Entry* entry = findEntry(key)) {
+            return entry->value;
       }
 
-      elements[key] = defaultValue;
-      order.push_back(key);
+      insert(key, defaultValue);
 
       return defaultValue;
 }
 
-Value DictValue::popitem() {
+Value DictValue::popitem(const bool last) {
 
-      if (order.empty()) {
+      if (used == 0) {
             throw std::runtime_error("KeyError: 'popitem(): dictionary is empty'");
       }
 
-      const Value key = order.back();
-      order.pop_back();
+      const std::ptrdiff_t ix = last ? prevLive(static_cast<std::ptrdiff_t>(entries.size()) - 1)
+                                     : static_cast<std::ptrdiff_t>(nextLive(0));
+
+      Value item = TupleValue::pair(entries[ix].key, entries[ix].value);
+
+      removeAt(ix);
+
+      // очередь с головы оставляет надгробия в начале: уплотнение, пока их не больше живых
+      if (!last && static_cast<std::size_t>(ix) >= used) {
+            rebuild();
+      }
+
+      // хвостовые надгробия не нужны: следующая запись займёт их место
+      while (!entries.empty() && !entries.back().live) {
+            entries.pop_back();
+      }
+
+      return item;
+}
+
+void DictValue::moveToEnd(const Value& key, const bool last) {
 
-      const Value value = elements[key];
+      const std::ptrdiff_t ix = lookup(key, qHash(key));
 
-      elements.remove(key);
+      if (ix < 0) {
+            throw PyException(PyException::make("KeyError", {key}));
+      }
+
+      Entry entry = entries[ix];
 
-      std::vector tupleItems = {
-            Value(key),
-            value
-        };
+      removeAt(ix);
 
-      return Value(std::make_shared<TupleValue>(tupleItems));
+      if (last) {
+            insert(entry.key, entry.value);
+      } else {
+            entries.insert(entries.begin(), std::move(entry));
+            ++used;
+            rebuild();
+      }
+
+      // запись переехала: обход, начатый до переноса, не должен встретить её дважды
+      ++layoutVersion;
 }
 
 QVector<Value> DictValue::getOrder() const {
-      return order;
+
+      QVector<Value> keys;
+      keys.reserve(static_cast<qsizetype>(used));
+
+      forEachItem([&keys](const Value& key, const Value&) {
+            keys.push_back(key);
+      });
+
+      return keys;
 }
 
-QHash<Value, Value> DictValue::getElements() const {
-      return elements;
+const Value* DictValue::find(const Value& key) const {
+
+      const Entry* entry = findEntry(key);
+
+      return entry ? &entry->value : nullptr;
 }
 
-const QHash<Value, Value>& DictValue::getElementsRef() const {
-      return elements;
+void DictValue::ensureUnchanged(const std::size_t size, const std::uint64_t version) const {
+
+      if (used != size) {
+            throw std::runtime_error("RuntimeError: dictionary changed size during iteration");
+      }
+
+      if (layoutVersion != version) {
+            throw std::runtime_error("RuntimeError: dictionary keys changed during iteration");
+      }
+}
+
+std::size_t DictValue::nextLive(std::size_t from) const {
+
+      while (from < entries.size() && !entries[from].live) {
+            ++from;
+      }
+
+      return from;
+}
+
+std::ptrdiff_t DictValue::prevLive(std::ptrdiff_t from) const {
+
+      while (from >= 0 && !entries[from].live) {
+            --from;
+      }
+
+      return from;
 }
 
 Value DictValue::keys(const std::shared_ptr<DictValue>& self) {
@@ -203,31 +486,43 @@ Value DictValue::fromKeys(
           ? *defaultValue
           : Value();
 
-      Value iterMethod = getAttrValue(iterable, "__iter__");
+      // ключи множества и словаря уже захешированы и уникальны
+      if (iterable.isSet() || iterable.isFrozenSet()) {
 
-      Value iterator = call(iterMethod, {}, {}, nullptr);
+            OrderedValueSet storage;
+            const OrderedValueSet& keys = OrderedValueSet::of(iterable, storage);
 
-      while (true) {
+            result->reserve(keys.size());
 
-            try {
+            keys.forEachHashed([&](const Value& key, const std::size_t hash) {
+                  result->insertHashed(key, hash, value);
+            });
 
-                  Value nextMethod = getAttrValue(
-                      iterator,
-                      "__next__"
-                  );
+            return Value(result);
+      }
 
-                  Value key = call(
-                      nextMethod,
-                      {},
-                      {},
-                      nullptr
-                  );
+      if (iterable.isDict()) {
 
-                  result->setItem(key, value);
+            const auto source = iterable.asDict();
+            result->reserve(source->used);
 
-            } catch (const StopIterationException&) {
-                  break;
+            for (const Entry& entry : source->entries) {
+                  if (entry.live) {
+                        result->insertHashed(entry.key, entry.hash, value);
+                  }
             }
+
+            return Value(result);
+      }
+
+      result->reserve(ListValue::lengthHint(iterable));
+
+      const Value iterator = getIter(iterable, nullptr);
+
+      Value key;
+
+      while (iterNext(iterator, key, nullptr)) {
+            result->setItem(key, value);
       }
 
       return Value(result);
@@ -236,18 +531,12 @@ Value DictValue::fromKeys(
 Value DictValue::bitOr(const Value& other) const {
 
       if (!other.isDict()) {
-            throw std::runtime_error(
-                "TypeError: unsupported operand type(s) for |"
-            );
+            return Value::notImplemented();
       }
 
-      const auto result =
-          std::make_shared<DictValue>(
-              elements,
-              order
-          );
+      const auto result = std::make_shared<DictValue>(*this);
 
-      result->update(other.asDict());
+      result->merge(*other.asDict());
 
       return Value(result);
 }
@@ -275,17 +564,19 @@ bool DictValue::equal(const Value& other) const {
 
       const auto rhs = other.asDict();
 
-      if (elements.size() != rhs->elements.size()) {
+      if (used != rhs->used) {
             return false;
       }
 
-      for (const auto& key : order) {
+      for (const auto& entry : entries) {
 
-            if (!rhs->elements.contains(key)) {
-                  return false;
+            if (!entry.live) {
+                  continue;
             }
 
-            if (elements[key] != rhs->elements[key]) {
+            const Entry* match = rhs->findEntry(entry.key);
+
+            if (!match || entry.value != match->value) {
                   return false;
             }
       }
@@ -300,9 +591,7 @@ bool DictValue::notEqual(const Value& other) const {
 Value DictValue::ror(const Value& other) const {
 
       if (!other.isDict()) {
-            throw std::runtime_error(
-                "TypeError: unsupported operand type(s) for |"
-            );
+            return Value::notImplemented();
       }
 
       return other.asDict()->bitOr(
@@ -320,7 +609,7 @@ bool DictValue::contains(const Value& key) const {
             throw std::runtime_error("TypeError: unhashable type");
       }
 
-      return elements.contains(key);
+      return findEntry(key) != nullptr;
 }
 
 void DictValue::delItem(const Value& key) {
@@ -329,14 +618,13 @@ void DictValue::delItem(const Value& key) {
             throw std::runtime_error("TypeError: unhashable type");
       }
 
-      if (!elements.contains(key)) {
-            throw std::runtime_error(
-                "KeyError: " + key.toString().toStdString()
-            );
+      const std::ptrdiff_t ix = lookup(key, qHash(key));
+
+      if (ix < 0) {
+            throw PyException(PyException::make("KeyError", {key}));
       }
 
-      elements.remove(key);
-      order.removeAll(key);
+      removeAt(ix);
 }
 
 Value DictValue::reversed() const {
@@ -347,3 +635,23 @@ Value DictValue::reversed() const {
           )
       );
 }
+
+long DictValue::gcRefCount() const {
+      return weak_from_this().use_count();
+}
+
+std::shared_ptr<GcObject> DictValue::gcSelf() {
+      return shared_from_this();
+}
+
+void DictValue::gcTraverse(const GcVisitor& visit) const {
+
+      for (const auto& entry : entries) {
+            gcVisitValue(entry.key, visit);
+            gcVisitValue(entry.value, visit);
+      }
+}
+
+void DictValue::gcClear() {
+      clear();
+}
@@ -14,7 +14,7 @@ QString DictValuesView::toString() const {
 
     bool first = true;
 
-    for (const auto& key : dict->getOrder()) {
+    dict->forEachItem([&](const Value&, const Value& value) {
 
         if (!first) {
             out += ", ";
@@ -22,8 +22,8 @@ QString DictValuesView::toString() const {
 
         first = false;
 
-        out += dict->getElements()[key].repr();
-    }
+        out += value.repr();
+    });
 
     out += "])";
 
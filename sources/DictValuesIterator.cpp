@@ -7,17 +7,25 @@
 #include "DictValue.h"
 #include "StopIterationException.h"
 
+DictValuesIterator::DictValuesIterator(std::shared_ptr<DictValue> dict)
+    : dict(std::move(dict)), size(this->dict->len()), version(this->dict->version()) {}
+
 Value DictValuesIterator::next() {
 
     if (!hasNext()) {
         throw StopIterationException();
     }
 
-    return dict->getElements()[dict->getOrder()[index++]];
+    index = dict->nextLive(index);
+
+    return dict->entryAt(index++).value;
 }
 
 bool DictValuesIterator::hasNext() const {
-    return index < static_cast<size_t>(dict->getOrder().size());
+
+    dict->ensureUnchanged(size, version);
+
+    return dict->nextLive(index) < dict->entryCount();
 }
 
 QString DictValuesIterator::getTypeName() const {
@@ -0,0 +1,171 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "DictViewSetOps.h"
+
+#include <cstring>
+
+#include "CallRuntime.h"
+#include "DictItemsView.h"
+#include "DictKeysView.h"
+#include "DictValue.h"
+#include "OrderedValueSet.h"
+#include "SetValue.h"
+#include "TupleValue.h"
+
+namespace dictviews {
+
+    namespace {
+
+        /// операнд операции: представление отвечает через словарь, остальное — через таблицу множества
+        class Operand {
+        public:
+            explicit Operand(const Value& value) {
+
+                if (value.isDictKeysView()) {
+                    dict = value.asDictKeysView()->getDict().get();
+                } else if (value.isDictItemsView()) {
+                    dict = value.asDictItemsView()->getDict().get();
+                    items = true;
+                } else if (value.isSet() || value.isFrozenSet()) {
+                    set = &OrderedValueSet::of(value, storage);
+                } else {
+
+                    // произвольный итерируемый объект, в том числе экземпляр с __iter__
+                    const Value iterator = getIter(value, nullptr);
+
+                    for (Value item; iterNext(iterator, item, nullptr);) {
+                        storage.insert(item);
+                    }
+
+                    set = &storage;
+                }
+            }
+
+            Operand(const Operand&) = delete;
+            Operand& operator=(const Operand&) = delete;
+
+            [[nodiscard]] std::size_t size() const {
+                return dict ? dict->len() : set->size();
+            }
+
+            [[nodiscard]] bool contains(const Value& value) const {
+
+                if (!dict) {
+                    return set->contains(value);
+                }
+
+                if (!items) {
+                    return dict->find(value) != nullptr;
+                }
+
+                // элемент items — пара (ключ, значение) с тем же значением в словаре
+                if (!value.isTuple() || value.asTuple()->items.size() != 2) {
+                    return false;
+                }
+
+                const auto& pair = value.asTuple()->items;
+                const Value* found = dict->find(pair[0]);
+
+                return found && *found == pair[1];
+            }
+
+            template<typename Fn>
+            void forEach(Fn&& fn) const {
+
+                if (!dict) {
+                    set->forEach(fn);
+                } else if (items) {
+                    dict->forEachItem([&](const Value& key, const Value& value) { fn(TupleValue::pair(key, value)); });
+                } else {
+                    dict->forEachItem([&](const Value& key, const Value&) { fn(key); });
+                }
+            }
+
+        private:
+            const DictValue* dict = nullptr;
+            bool items = false;
+            OrderedValueSet storage;
+            const OrderedValueSet* set = nullptr;
+        };
+    }
+
+    bool isSetLike(const Value& value) {
+        return value.isDictKeysView() || value.isDictItemsView();
+    }
+
+    std::optional<Value> binary(const Value& l, const Value& r, const char* symbol) {
+
+        if (!isSetLike(l) && !isSetLike(r)) {
+            return std::nullopt;
+        }
+
+        const Operand left(l);
+        const Operand right(r);
+
+        OrderedValueSet result;
+
+        if (std::strcmp(symbol, "&") == 0) {
+
+            const bool leftSmaller = left.size() <= right.size();
+            const Operand& smaller = leftSmaller ? left : right;
+            const Operand& larger = leftSmaller ? right : left;
+
+            smaller.forEach([&](const Value& value) {
+                if (larger.contains(value)) {
+                    result.insert(value);
+                }
+            });
+
+        } else if (std::strcmp(symbol, "|") == 0) {
+
+            left.forEach([&](const Value& value) { result.insert(value); });
+            right.forEach([&](const Value& value) { result.insert(value); });
+
+        } else if (std::strcmp(symbol, "-") == 0) {
+
+            left.forEach([&](const Value& value) {
+                if (!right.contains(value)) {
+                    result.insert(value);
+                }
+            });
+
+        } else if (std::strcmp(symbol, "^") == 0) {
+
+            left.forEach([&](const Value& value) {
+                if (!right.contains(value)) {
+                    result.insert(value);
+                }
+            });
+
+            right.forEach([&](const Value& value) {
+                if (!left.contains(value)) {
+                    result.insert(value);
+                }
+            });
+
+        } else {
+            return std::nullopt;
+        }
+
+        return Value(std::make_shared<SetValue>(std::move(result)));
+    }
+
+    bool isDisjoint(const Value& view, const Value& other) {
+
+        const Operand self(view);
+        const Operand rhs(other);
+
+        const bool selfSmaller = self.size() <= rhs.size();
+        const Operand& smaller = selfSmaller ? self : rhs;
+        const Operand& larger = selfSmaller ? rhs : self;
+
+        bool disjoint = true;
+
+        smaller.forEach([&](const Value& value) {
+            disjoint = disjoint && !larger.contains(value);
+        });
+
+        return disjoint;
+    }
+}
@@ -0,0 +1,78 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "EmbeddedInterpreter.h"
+
+#include "Compiler.h"
+#include "Environment.h"
+#include "Interpreter.h"
+#include "Lexer.h"
+#include "ModuleLoader.h"
+#include "Parser.h"
+#include "VirtualMachine.h"
+
+EmbeddedInterpreter::EmbeddedInterpreter(const QString& searchDir) {
+
+    const InterpreterContext::Scope scope(context);
+
+    // результаты выражений не печатаются: хост читает значения, а не вывод
+    Compiler::echoResults = false;
+
+    ModuleLoader::initialize(Interpreter::createGlobals(), searchDir);
+    globals = ModuleLoader::makeGlobals("__main__");
+}
+
+EmbeddedInterpreter::~EmbeddedInterpreter() {
+
+    const InterpreterContext::Scope scope(context);
+
+    // функции скрипта ссылаются на globals через замыкание: цикл разрывается сразу, без gc
+    globals->gcClear();
+    context.reset();
+}
+
+std::shared_ptr<const CodeObject> EmbeddedInterpreter::compile(const QString& source) const {
+
+    Lexer lexer;
+    const std::string text = source.toStdString();
+    Parser parser(lexer.tokenize(text));
+
+    return Compiler::compileModule(parser.parseModule());
+}
+
+void EmbeddedInterpreter::execute(const CodeObject& code) {
+
+    const InterpreterContext::Scope scope(context);
+    const ExecutionBudget::Scope limit(budget);
+
+    VirtualMachine::run(code, globals);
+    ExecutionBudget::check();
+}
+
+Value EmbeddedInterpreter::call(const QString& name, const std::vector<Value>& args, const Kwargs& kwargs) {
+    return call(get(name), args, kwargs);
+}
+
+Value EmbeddedInterpreter::call(const Value& callable, const std::vector<Value>& args, const Kwargs& kwargs) {
+
+    const InterpreterContext::Scope scope(context);
+    const ExecutionBudget::Scope limit(budget);
+
+    Value result = ::call(callable, args, kwargs, globals);
+    ExecutionBudget::check();
+
+    return result;
+}
+
+Value EmbeddedInterpreter::get(const QString& name) const {
+
+    if (const Value* value = globals->findLocal(name)) {
+        return *value;
+    }
+
+    throw std::runtime_error("NameError: name '" + name.toStdString() + "' is not defined");
+}
+
+void EmbeddedInterpreter::set(const QString& name, Value value) {
+    globals->set(name, std::move(value));
+}
@@ -0,0 +1,39 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "EnumerateIterator.h"
+
+#include "CallRuntime.h"
+#include "TupleValue.h"
+
+EnumerateIterator::EnumerateIterator(Value source, const Value::SmallInt start, std::shared_ptr<Environment> env)
+    : LookaheadIterator(std::move(env)), source(std::move(source)), index(start) {}
+
+bool EnumerateIterator::produce(Value& out) {
+
+    Value position;
+    Value item;
+
+    if (!producePair(position, item)) {
+        return false;
+    }
+
+    out = TupleValue::pair(std::move(position), std::move(item));
+
+    return true;
+}
+
+bool EnumerateIterator::producePair(Value& position, Value& item) {
+
+    if (!iterNext(source, item, env)) {
+        return false;
+    }
+
+    position = Value(index++);
+
+    return true;
+}
+
+QString EnumerateIterator::getTypeName() const {
+    return "enumerate";
+}
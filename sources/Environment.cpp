@@ -1,5 +1,27 @@
 #include "Environment.h"
 
+#include <algorithm>
+
+#include "ClassValue.h"
+#include "ObjectPool.h"
+
+Environment::Environment(std::shared_ptr<Environment> parent, std::shared_ptr<const FrameLayout> layout)
+    : parent(std::move(parent)), layout(std::move(layout)) {
+
+    RuntimeStats::add(RuntimeStats::Environments);
+
+    if (!this->layout) {
+        return;
+    }
+
+    slots.resize(this->layout->names.size());
+    cells.resize(this->layout->cellNames.size());
+
+    for (std::size_t i = 0; i < this->layout->ownCells; ++i) {
+        cells[i] = makePooled<Cell>();
+    }
+}
+
 /**
  * Устанавливает переменную в окружении с указанным именем и значением.
  * Если переменная уже существует, её значение будет обновлено.
@@ -7,21 +29,30 @@
  * @param name Имя переменной для установки или обновления.
  * @param value Значение, которое нужно связать с указанным именем переменной.
  */
-void Environment::set(const QString& name, const Value& value) {
+void Environment::set(const QString& name, Value value) {
     if (globalVars.contains(name)) {
         auto global = this;
-        while (global->parent) {
+        while (global->parent && !global->moduleScope) {
             global = global->parent.get();
         }
-        global->variables[name] = value;
+        global->store(name, std::move(value));
         return;
     }
 
+    if (layout && !layout->cellNames.empty()) {
+        const auto it = layout->cellIndices.constFind(name);
+
+        if (it != layout->cellIndices.constEnd()) {
+            cellValue(it.value()) = std::move(value);
+            return;
+        }
+    }
+
     if (nonlocalVars.contains(name)) {
         auto env = parent;
         while (env) {
-            if (env->variables.count(name)) {
-                env->variables[name] = value;
+            if (Value* existing = env->findLocal(name)) {
+                *existing = std::move(value);
                 return;
             }
             env = env->parent;
@@ -29,7 +60,42 @@ void Environment::set(const QString& name, const Value& value) {
         throw std::runtime_error("No binding for nonlocal " + name.toStdString());
     }
 
-    variables[name] = value;
+    if (layout) {
+        const auto it = layout->indices.constFind(name);
+
+        if (it != layout->indices.constEnd()) {
+            slots[it.value()] = std::move(value);
+            return;
+        }
+    }
+
+    store(name, std::move(value));
+}
+
+void Environment::store(const QString& name, Value value) {
+
+    const auto it = variables.find(name);
+
+    if (it != variables.end()) {
+        *it = std::move(value);
+        return;
+    }
+
+    variables.insert(name, std::move(value));
+    keysVersion = nextVersion();
+}
+
+void Environment::setAll(const QHash<QString, Value>& values) {
+
+    if (variables.isEmpty()) {
+        variables = values;
+    } else {
+        for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+            variables.insert(it.key(), it.value());
+        }
+    }
+
+    keysVersion = nextVersion();
 }
 
 /**
@@ -41,12 +107,183 @@ void Environment::set(const QString& name, const Value& value) {
  * @throws std::runtime_error Если переменная с указанным именем не найдена.
  */
 Value& Environment::get(const QString& name) {
-    if (variables.count(name)) {
-        return variables[name];
+    if (Value* value = find(name)) {
+        return *value;
     }
 
-    if (parent)
-        return parent->get(name);
+    throw std::runtime_error("NameError: name '" + name.toStdString() + "' is not defined");
+}
+
+Value& Environment::lookup(const QString& name, NameCache& cache) {
+
+    Environment* env = this;
+
+    for (; env && !env->moduleScope; env = env->parent.get()) {
+        if (Value* value = env->findLocal(name)) {
+            return *value;
+        }
+    }
 
-    throw std::runtime_error("Undefined variable: " + name.toStdString());
-}
\ No newline at end of file
+    if (!env) {
+        throw std::runtime_error("NameError: name '" + name.toStdString() + "' is not defined");
+    }
+
+    Environment* builtins = env->parent.get();
+
+    if (cache.value && cache.globalsVersion == env->keysVersion &&
+        (cache.builtinsVersion == 0 || (builtins && cache.builtinsVersion == builtins->keysVersion))) {
+        return *cache.value;
+    }
+
+    cache.globalsVersion = env->keysVersion;
+    cache.builtinsVersion = 0;
+    cache.value = env->findLocal(name);
+
+    if (!cache.value && builtins) {
+        cache.builtinsVersion = builtins->keysVersion;
+        cache.value = builtins->find(name);
+    }
+
+    if (!cache.value) {
+        throw std::runtime_error("NameError: name '" + name.toStdString() + "' is not defined");
+    }
+
+    return *cache.value;
+}
+
+Value* Environment::find(const QString& name) {
+
+    for (Environment* env = this; env; env = env->parent.get()) {
+        if (Value* value = env->findLocal(name)) {
+            return value;
+        }
+    }
+
+    return nullptr;
+}
+
+Value* Environment::findLocal(const QString& name) {
+
+    if (layout) {
+        const auto it = layout->indices.constFind(name);
+
+        if (it != layout->indices.constEnd()) {
+            auto& value = slots[it.value()];
+            return value ? &*value : nullptr;
+        }
+
+        if (const auto cell = layout->cellIndices.constFind(name); cell != layout->cellIndices.constEnd()) {
+            auto& value = cellValue(cell.value());
+            return value ? &*value : nullptr;
+        }
+    }
+
+    const auto it = variables.find(name);
+
+    if (it != variables.end()) {
+        return &it.value();
+    }
+
+    return nullptr;
+}
+
+void Environment::setGlobal(const QString& name, Value value) {
+
+    Environment* env = this;
+
+    while (!env->moduleScope && env->parent) {
+        env = env->parent.get();
+    }
+
+    env->store(name, std::move(value));
+}
+
+std::shared_ptr<Environment> Environment::moduleGlobals() {
+
+    Environment* env = this;
+
+    // вне модуля (код, выполняемый прямо во встроенных именах) глобальное — корень цепочки
+    while (!env->moduleScope && env->parent) {
+        env = env->parent.get();
+    }
+
+    return env->shared_from_this();
+}
+
+std::vector<std::shared_ptr<Cell>> Environment::captureCells(const FrameLayout& layout) {
+
+    std::vector<std::shared_ptr<Cell>> free;
+    free.reserve(layout.cellNames.size() - layout.ownCells);
+
+    for (std::size_t i = layout.ownCells; i < layout.cellNames.size(); ++i) {
+
+        std::shared_ptr<Cell> cell;
+
+        // ближайший кадр, где имя — ячейка; у тела класса раскладки нет, оно пропускается
+        for (Environment* env = this; env && !env->moduleScope && !cell; env = env->parent.get()) {
+
+            if (!env->layout) {
+                continue;
+            }
+
+            if (const auto it = env->layout->cellIndices.constFind(layout.cellNames[i]);
+                it != env->layout->cellIndices.constEnd()) {
+                cell = env->cells[it.value()];
+            }
+        }
+
+        free.push_back(std::move(cell));
+    }
+
+    return free;
+}
+
+void Environment::bindFreeCells(const std::vector<std::shared_ptr<Cell>>& free) {
+    std::copy(free.begin(), free.end(), cells.begin() + static_cast<std::ptrdiff_t>(layout->ownCells));
+}
+
+long Environment::gcRefCount() const {
+    return weak_from_this().use_count();
+}
+
+std::shared_ptr<GcObject> Environment::gcSelf() {
+    return shared_from_this();
+}
+
+void Environment::gcTraverse(const GcVisitor& visit) const {
+
+    visit(parent.get());
+
+    for (const auto& value : variables) {
+        gcVisitValue(value, visit);
+    }
+
+    for (const auto& value : slots) {
+        if (value) {
+            gcVisitValue(*value, visit);
+        }
+    }
+
+    for (const auto& cell : cells) {
+        visit(cell.get());
+    }
+
+    visit(ownerClass.get());
+}
+
+void Environment::gcClear() {
+
+    parent.reset();
+    ownerClass.reset();
+    variables.clear();
+    keysVersion = nextVersion();
+
+    // раскладка кадра остаётся прежней, опустошаются только значения
+    for (auto& value : slots) {
+        value.reset();
+    }
+
+    for (auto& cell : cells) {
+        cell.reset();
+    }
+}
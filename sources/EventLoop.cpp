@@ -0,0 +1,374 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "EventLoop.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#elif defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#else
+#include <poll.h>
+#endif
+
+#include "ClassUtils.h"
+#include "CoroutineValue.h"
+#include "FutureValue.h"
+#include "TaskValue.h"
+
+namespace {
+
+    thread_local EventLoop* active = nullptr;
+
+    /// system_category, а не strerror: в Windows коды сокетов — не errno
+    [[noreturn]] void systemError(const char* call, const int code) {
+        throw std::runtime_error(std::string("OSError: ") + call + " failed: " + std::system_category().message(code));
+    }
+
+#ifdef _WIN32
+    using PollEntry = WSAPOLLFD;
+    constexpr int interrupted = WSAEINTR;
+
+    int lastError() {
+        return WSAGetLastError();
+    }
+
+    int waitDescriptors(std::vector<PollEntry>& fds, const int timeout) {
+
+        // WSAPoll без сокетов — ошибка, а не ожидание; до таймера просто спим
+        if (fds.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::max(timeout, 0)));
+            return 0;
+        }
+
+        return WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), timeout);
+    }
+#elif !defined(__linux__)
+    using PollEntry = pollfd;
+    constexpr int interrupted = EINTR;
+
+    int lastError() {
+        return errno;
+    }
+
+    int waitDescriptors(std::vector<PollEntry>& fds, const int timeout) {
+        return ::poll(fds.data(), static_cast<nfds_t>(fds.size()), timeout);
+    }
+#endif
+}
+
+EventLoop::EventLoop() {
+#ifdef __linux__
+    poller = epoll_create1(EPOLL_CLOEXEC);
+
+    if (poller < 0) {
+        systemError("epoll_create1", errno);
+    }
+#endif
+}
+
+EventLoop::~EventLoop() {
+#ifdef __linux__
+    if (poller >= 0) {
+        ::close(poller);
+    }
+#endif
+}
+
+EventLoop* EventLoop::current() {
+    return active;
+}
+
+EventLoop& EventLoop::running() {
+
+    if (!active) {
+        throw std::runtime_error("RuntimeError: no running event loop");
+    }
+
+    return *active;
+}
+
+void EventLoop::callSoon(Callback callback) {
+    ready.push_back(std::move(callback));
+}
+
+void EventLoop::callLater(const double delay, Callback callback) {
+
+    // NaN и отрицательные — сразу; сверху — чтобы срок не переполнил часы
+    const double seconds = delay > 0 ? std::min(delay, 1e9) : 0.0;
+    const auto wait = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+
+    timers.push(Timer{Clock::now() + wait, timerSequence++, std::move(callback)});
+}
+
+void EventLoop::watch(const int fd, const bool write, Callback callback) {
+
+    const auto [it, added] = watches.try_emplace(fd);
+
+    (write ? it->second.writer : it->second.reader) = std::move(callback);
+
+    rearm(fd, added);
+}
+
+void EventLoop::forget(const int fd) {
+
+    if (watches.erase(fd) == 0) {
+        return;
+    }
+
+#ifdef __linux__
+    epoll_ctl(poller, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+}
+
+void EventLoop::rearm(const int fd, const bool added) {
+
+    const auto it = watches.find(fd);
+
+    if (it == watches.end()) {
+        return;
+    }
+
+    if (!it->second.reader && !it->second.writer) {
+
+        watches.erase(it);
+
+#ifdef __linux__
+        epoll_ctl(poller, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+        return;
+    }
+
+#ifdef __linux__
+    epoll_event event{};
+    event.events = (it->second.reader ? EPOLLIN : 0u) | (it->second.writer ? EPOLLOUT : 0u);
+    event.data.fd = fd;
+
+    if (epoll_ctl(poller, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event) == 0) {
+        return;
+    }
+
+    if (errno != EPERM) {
+        systemError("epoll_ctl", errno);
+    }
+
+    // обычный файл epoll не принимает: он всегда готов, как и для poll(2)
+    Watch ready = std::move(it->second);
+    watches.erase(it);
+
+    if (ready.reader) {
+        callSoon(std::move(ready.reader));
+    }
+
+    if (ready.writer) {
+        callSoon(std::move(ready.writer));
+    }
+#else
+    (void) added;
+#endif
+}
+
+void EventLoop::dispatch(const int fd, const bool readable, const bool writable) {
+
+    const auto it = watches.find(fd);
+
+    if (it == watches.end()) {
+        return;
+    }
+
+    if (readable && it->second.reader) {
+        callSoon(std::exchange(it->second.reader, nullptr));
+    }
+
+    if (writable && it->second.writer) {
+        callSoon(std::exchange(it->second.writer, nullptr));
+    }
+
+    rearm(fd, false);
+}
+
+void EventLoop::poll(const int timeout) {
+
+#ifdef __linux__
+    epoll_event events[64];
+
+    const int count = epoll_wait(poller, events, 64, timeout);
+
+    if (count < 0) {
+
+        if (errno == EINTR) {
+            return;
+        }
+
+        systemError("epoll_wait", errno);
+    }
+
+    for (int i = 0; i < count; ++i) {
+
+        const std::uint32_t flags = events[i].events;
+        // ошибка и разрыв будят обе стороны: чтение или запись сами сообщат, что случилось
+        const bool failed = flags & (EPOLLERR | EPOLLHUP);
+
+        dispatch(events[i].data.fd, failed || (flags & EPOLLIN), failed || (flags & EPOLLOUT));
+    }
+#else
+    std::vector<PollEntry> fds;
+    fds.reserve(watches.size());
+
+    for (const auto& [fd, watch] : watches) {
+
+        PollEntry entry{};
+        entry.fd = static_cast<decltype(entry.fd)>(fd);
+        entry.events = static_cast<short>((watch.reader ? POLLIN : 0) | (watch.writer ? POLLOUT : 0));
+
+        fds.push_back(entry);
+    }
+
+    if (waitDescriptors(fds, timeout) < 0) {
+
+        const int code = lastError();
+
+        if (code == interrupted) {
+            return;
+        }
+
+        systemError("poll", code);
+    }
+
+    for (const PollEntry& entry : fds) {
+
+        const bool failed = entry.revents & (POLLERR | POLLHUP | POLLNVAL);
+
+        if (entry.revents) {
+            dispatch(static_cast<int>(entry.fd), failed || (entry.revents & POLLIN), failed || (entry.revents & POLLOUT));
+        }
+    }
+#endif
+}
+
+void EventLoop::runOnce() {
+
+    int timeout = 0;
+
+    if (ready.empty()) {
+
+        if (!timers.empty()) {
+
+            const auto wait = timers.top().deadline - Clock::now();
+            // вверх до миллисекунды: проснувшись раньше срока, проход ушёл бы в ожидание снова
+            const auto milliseconds = std::chrono::ceil<std::chrono::milliseconds>(wait).count();
+
+            timeout = static_cast<int>(std::clamp<long long>(milliseconds, 0, INT_MAX));
+
+        } else if (!watches.empty()) {
+            timeout = -1;
+        } else {
+            throw std::runtime_error("RuntimeError: Event loop stopped before Future completed.");
+        }
+    }
+
+    poll(timeout);
+
+    const Clock::time_point now = Clock::now();
+
+    while (!timers.empty() && timers.top().deadline <= now) {
+        ready.push_back(timers.top().callback);
+        timers.pop();
+    }
+
+    // шаги, поставленные в очередь во время прохода, выполняются в следующем
+    for (std::size_t pending = ready.size(); pending > 0; --pending) {
+
+        const Callback callback = std::move(ready.front());
+        ready.pop_front();
+
+        callback();
+    }
+}
+
+std::shared_ptr<TaskValue> EventLoop::createTask(const Value& coroutine) {
+
+    if (!CoroutineValue::of(coroutine)) {
+        throw std::runtime_error("TypeError: a coroutine was expected, got " + coroutine.repr().toStdString());
+    }
+
+    // тысячи коротких задач не должны копить мёртвые ссылки
+    if (tasks.size() >= 1024 && tasks.size() == tasks.capacity()) {
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [](const auto& task) { return task.expired(); }),
+                    tasks.end());
+    }
+
+    auto task = std::make_shared<TaskValue>(coroutine);
+    tasks.push_back(task);
+
+    TaskValue::start(task);
+
+    return task;
+}
+
+std::shared_ptr<FutureValue> EventLoop::ensureFuture(const Value& awaitable) {
+
+    if (FutureValue::of(awaitable)) {
+        return std::static_pointer_cast<FutureValue>(std::get<Value::ObjectPtr>(awaitable.data));
+    }
+
+    if (CoroutineValue::of(awaitable)) {
+        return createTask(awaitable);
+    }
+
+    throw std::runtime_error("TypeError: An asyncio.Future, a coroutine or an awaitable is required, got '" +
+                             typeName(awaitable).toStdString() + "'");
+}
+
+Value EventLoop::runUntilComplete(const Value& awaitable) {
+
+    if (active) {
+        throw std::runtime_error("RuntimeError: asyncio.run() cannot be called from a running event loop");
+    }
+
+    active = this;
+
+    // задачи, которые так и не дождались, держат свои Future циклом ссылок через кадры
+    const auto shutdown = [this] {
+
+        for (const auto& weak : tasks) {
+            if (const auto task = weak.lock()) {
+                task->abandon();
+            }
+        }
+
+        tasks.clear();
+        ready.clear();
+        timers = decltype(timers)();
+        watches.clear();
+        active = nullptr;
+    };
+
+    std::shared_ptr<FutureValue> main;
+
+    try {
+        main = ensureFuture(awaitable);
+
+        while (!main->done()) {
+            runOnce();
+        }
+    } catch (...) {
+        shutdown();
+        throw;
+    }
+
+    shutdown();
+
+    return main->result();
+}
@@ -0,0 +1,129 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ExecutionBudget.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "MemoryTracker.h"
+
+namespace {
+
+    /// тиков между проверками памяти при малом числе живых объектов
+    constexpr std::int64_t memoryInterval = 4096;
+}
+
+thread_local ExecutionBudget::State ExecutionBudget::state;
+
+void ExecutionBudget::grant() {
+
+    if (state.exhausted != Reason::None) {
+        state.granted = 0;
+        countdown = 0;
+        return;
+    }
+
+    std::int64_t next = std::numeric_limits<std::int64_t>::max();
+
+    if (state.limits.ticks > 0) {
+        next = std::min(next, state.limits.ticks - state.used);
+    }
+
+    if (state.limits.memory > 0) {
+        next = std::min(next, state.nextMemoryCheck - state.used);
+    }
+
+    state.granted = std::max<std::int64_t>(next, 0);
+    countdown = state.granted;
+}
+
+/**
+ * Счётчик ушёл в -1: израсходован весь отрезок и ещё текущий тик. Без пределов
+ * сюда не попасть — отрезок равен максимуму int64.
+ */
+void ExecutionBudget::expire() {
+
+    state.used += state.granted - countdown;
+
+    if (state.exhausted == Reason::None && state.limits.memory > 0 && state.used >= state.nextMemoryCheck) {
+
+        const std::uint64_t bytes = MemoryTracker::liveBytes();
+        const auto objects = static_cast<std::int64_t>(MemoryTracker::liveCount());
+
+        state.nextMemoryCheck = state.used + std::max(memoryInterval, objects);
+
+        // освобождённые старые объекты могут опустить сумму ниже начальной
+        if (bytes > state.memoryBaseline && bytes - state.memoryBaseline > state.limits.memory) {
+            state.exhausted = Reason::Memory;
+        }
+    }
+
+    if (state.exhausted == Reason::None && state.limits.ticks > 0 && state.used > state.limits.ticks) {
+        state.exhausted = Reason::Ticks;
+    }
+
+    grant();
+
+    if (state.exhausted != Reason::None) {
+        raise();
+    }
+}
+
+void ExecutionBudget::raise() {
+
+    if (state.exhausted == Reason::Memory) {
+        throw std::runtime_error("MemoryError: evaluation exceeded the memory budget of " +
+                                 std::to_string(state.limits.memory) + " bytes");
+    }
+
+    throw std::runtime_error("TimeoutError: evaluation exceeded the budget of " +
+                             std::to_string(state.limits.ticks) + " ticks");
+}
+
+void ExecutionBudget::check() {
+    if (state.exhausted != Reason::None) {
+        raise();
+    }
+}
+
+std::int64_t ExecutionBudget::used() {
+    return state.used + state.granted - countdown;
+}
+
+ExecutionBudget::Scope::Scope(const Limits& limits)
+    : saved(state),
+      savedCountdown(countdown) {
+
+    state = State{};
+    state.limits = limits;
+
+    if (limits.memory > 0) {
+        state.nextMemoryCheck = memoryInterval;
+
+        if (!MemoryTracker::tracing) {
+            MemoryTracker::start();
+            tracking = true;
+        }
+
+        // объекты, созданные до вычисления, в его предел не входят, даже если
+        // tracemalloc уже считал их
+        state.memoryBaseline = MemoryTracker::liveBytes();
+    }
+
+    grant();
+}
+
+ExecutionBudget::Scope::~Scope() {
+
+    const std::int64_t spent = used();
+
+    if (tracking) {
+        MemoryTracker::stop();
+    }
+
+    state = saved;
+    // счётчик внешнего вычисления может уйти ниже нуля — это обработает его следующий тик
+    countdown = savedCountdown - spent;
+}
@@ -0,0 +1,418 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "FileValue.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "StrValue.h"
+
+namespace {
+
+    /// `\r\n` и одиночный `\r` → `\n`; `pendingCR` переносит состояние через границу блоков
+    void translateNewlines(QString& chunk, bool& pendingCR) {
+
+        qsizetype from = 0;
+
+        if (pendingCR && !chunk.isEmpty() && chunk.front() == u'\n') {
+            from = 1;
+        }
+
+        pendingCR = false;
+
+        if (!chunk.contains(u'\r')) {
+            if (from > 0) {
+                chunk.remove(0, from);
+            }
+            return;
+        }
+
+        QString result;
+        result.reserve(chunk.size());
+
+        for (qsizetype i = from; i < chunk.size(); ++i) {
+
+            if (chunk[i] != u'\r') {
+                result.append(chunk[i]);
+                continue;
+            }
+
+            result.append(u'\n');
+
+            if (i + 1 == chunk.size()) {
+                pendingCR = true;
+            } else if (chunk[i + 1] == u'\n') {
+                ++i;
+            }
+        }
+
+        chunk = std::move(result);
+    }
+}
+
+Value FileValue::open(const QString& path, const QString& mode) {
+
+    bool binary = false;
+    bool text = false;
+    QChar kind;
+
+    for (const QChar c : mode) {
+
+        if (c == u'b' && !binary) {
+            binary = true;
+        } else if (c == u't' && !text) {
+            text = true;
+        } else if ((c == u'r' || c == u'w' || c == u'a' || c == u'x') && kind.isNull()) {
+            kind = c;
+        } else if (c == u'+') {
+            throw std::runtime_error("ValueError: open() mode '+' is not supported");
+        } else {
+            throw std::runtime_error("ValueError: invalid mode: '" + mode.toStdString() + "'");
+        }
+    }
+
+    if (kind.isNull() || (binary && text)) {
+        throw std::runtime_error("ValueError: invalid mode: '" + mode.toStdString() + "'");
+    }
+
+    const bool readable = kind == u'r';
+    const auto file = std::make_shared<FileValue>(path, mode, binary, readable, !readable);
+
+    QIODevice::OpenMode flags = QIODevice::ReadOnly;
+
+    if (kind == u'w') {
+        flags = QIODevice::WriteOnly | QIODevice::Truncate;
+    } else if (kind == u'a') {
+        flags = QIODevice::WriteOnly | QIODevice::Append;
+    } else if (kind == u'x') {
+        flags = QIODevice::WriteOnly | QIODevice::NewOnly;
+    }
+
+    if (!file->file.open(flags)) {
+
+        const std::string quoted = "'" + path.toStdString() + "'";
+
+        if (kind == u'x' && file->file.exists()) {
+            throw std::runtime_error("FileExistsError: [Errno 17] File exists: " + quoted);
+        }
+
+        if (readable && !file->file.exists()) {
+            throw std::runtime_error("FileNotFoundError: [Errno 2] No such file or directory: " + quoted);
+        }
+
+        throw std::runtime_error("OSError: " + file->file.errorString().toStdString() + ": " + quoted);
+    }
+
+    return Value(std::static_pointer_cast<IteratorValue>(file));
+}
+
+FileValue::FileValue(QString path, QString mode, const bool binary, const bool readable, const bool writable)
+    : LookaheadIterator(nullptr),
+      file(path),
+      path(std::move(path)),
+      mode(std::move(mode)),
+      binary(binary),
+      readable(readable),
+      writable(writable) {}
+
+QString FileValue::getTypeName() const {
+
+    if (!binary) {
+        return "_io.TextIOWrapper";
+    }
+
+    return readable ? "_io.BufferedReader" : "_io.BufferedWriter";
+}
+
+QString FileValue::toString() const {
+
+    if (binary) {
+        return QString("<%1 name='%2'>").arg(getTypeName(), path);
+    }
+
+    return QString("<%1 name='%2' mode='%3' encoding='UTF-8'>").arg(getTypeName(), path, mode);
+}
+
+void FileValue::ensureOpen() const {
+    if (closed) {
+        throw std::runtime_error("ValueError: I/O operation on closed file.");
+    }
+}
+
+void FileValue::ensureReadable() const {
+
+    ensureOpen();
+
+    if (!readable) {
+        throw std::runtime_error("io.UnsupportedOperation: not readable");
+    }
+}
+
+void FileValue::ensureWritable() const {
+
+    ensureOpen();
+
+    if (!writable) {
+        throw std::runtime_error("io.UnsupportedOperation: not writable");
+    }
+}
+
+bool FileValue::fillRaw() {
+
+    // прочитанное отбрасывается, недочитанный хвост переезжает в начало буфера
+    if (rawPos > 0) {
+        raw.remove(0, rawPos);
+        rawPos = 0;
+    }
+
+    const qsizetype kept = raw.size();
+    raw.resize(kept + blockSize);
+
+    const qint64 got = file.read(raw.data() + kept, blockSize);
+    raw.resize(kept + std::max<qint64>(got, 0));
+
+    return got > 0;
+}
+
+bool FileValue::fillText() {
+
+    QByteArray block = file.read(blockSize);
+
+    if (block.isEmpty()) {
+        return false;
+    }
+
+    QString decoded = decoder.decode(block);
+    translateNewlines(decoded, pendingCR);
+
+    // непрочитанный остаток старого текста и новый блок становятся одной строкой-владельцем
+    if (text && textPos < text->view().size()) {
+        decoded.prepend(text->view().sliced(textPos));
+    }
+
+    text = makePooled<StrValue>(std::move(decoded));
+    textPos = 0;
+
+    return true;
+}
+
+qsizetype FileValue::textAvailable() const {
+    return text ? text->view().size() - textPos : 0;
+}
+
+Value FileValue::takeText(const qsizetype length) {
+
+    if (length == 0) {
+        return Value("");
+    }
+
+    Value result = StrValue::substring(text, textPos, length);
+    textPos += length;
+
+    return result;
+}
+
+Value FileValue::takeRaw(const qsizetype length) {
+
+    Value result(std::make_shared<BytesValue>(raw.mid(rawPos, length)));
+    rawPos += length;
+
+    return result;
+}
+
+Value FileValue::read(const std::optional<qsizetype> size) {
+
+    ensureReadable();
+
+    // остаток файла читается одним вызовом, а не склейкой блоков
+    if (!size || *size < 0) {
+
+        if (binary) {
+            QByteArray rest = raw.mid(rawPos) + file.readAll();
+            raw.clear();
+            rawPos = 0;
+            return Value(std::make_shared<BytesValue>(std::move(rest)));
+        }
+
+        QString rest = decoder.decode(file.readAll());
+        translateNewlines(rest, pendingCR);
+
+        if (textAvailable() > 0) {
+            rest.prepend(text->view().sliced(textPos));
+        }
+
+        text.reset();
+        textPos = 0;
+
+        return Value(rest);
+    }
+
+    if (binary) {
+        while (raw.size() - rawPos < *size && fillRaw()) {}
+        return takeRaw(std::min(*size, raw.size() - rawPos));
+    }
+
+    while (textAvailable() < *size && fillText()) {}
+
+    return takeText(std::min(*size, textAvailable()));
+}
+
+Value FileValue::readline() {
+
+    ensureReadable();
+
+    if (binary) {
+
+        qsizetype searched = rawPos;
+
+        while (true) {
+
+            if (const qsizetype end = raw.indexOf('\n', searched); end >= 0) {
+                return takeRaw(end + 1 - rawPos);
+            }
+
+            searched = raw.size();
+
+            const qsizetype consumed = rawPos;
+
+            if (!fillRaw()) {
+                return takeRaw(raw.size() - rawPos);
+            }
+
+            // fillRaw сдвинул непрочитанное в начало буфера
+            searched -= consumed;
+        }
+    }
+
+    qsizetype searched = 0;
+
+    while (true) {
+
+        if (text) {
+
+            const QStringView rest = text->view().sliced(textPos);
+
+            if (const qsizetype end = rest.indexOf(u'\n', searched); end >= 0) {
+                return takeText(end + 1);
+            }
+
+            searched = rest.size();
+        }
+
+        // после fillText непрочитанный текст начинается с позиции 0, и просмотренное остаётся в начале
+        if (!fillText()) {
+            return takeText(textAvailable());
+        }
+    }
+}
+
+Value FileValue::readlines() {
+
+    std::vector<Value> lines;
+
+    while (true) {
+
+        Value line = readline();
+
+        if (binary ? line.asBytes()->bytes().isEmpty() : line.asString()->view().isEmpty()) {
+            break;
+        }
+
+        lines.push_back(std::move(line));
+    }
+
+    return Value(makePooled<ListValue>(std::move(lines)));
+}
+
+qsizetype FileValue::write(const Value& data) {
+
+    ensureWritable();
+
+    if (binary) {
+
+        const QByteArray* bytes = nullptr;
+
+        if (data.isBytes()) {
+            bytes = &data.asBytes()->bytes();
+        } else if (data.isByteArray()) {
+            bytes = &data.asByteArray()->bytes();
+        } else {
+            throw std::runtime_error("TypeError: a bytes-like object is required");
+        }
+
+        file.write(*bytes);
+
+        return bytes->size();
+    }
+
+    if (!data.isString()) {
+        throw std::runtime_error("TypeError: write() argument must be str");
+    }
+
+    const QStringView chars = data.asString()->view();
+    file.write(chars.toUtf8());
+
+    return chars.size();
+}
+
+qsizetype FileValue::readinto(ByteArrayValue& target) {
+
+    ensureReadable();
+
+    if (!binary) {
+        throw std::runtime_error("io.UnsupportedOperation: readinto");
+    }
+
+    QByteArray& bytes = target.bytes();
+    const qsizetype wanted = bytes.size();
+
+    // сначала уже прочитанный блок, затем файл — прямо в память bytearray
+    const qsizetype buffered = std::min(wanted, raw.size() - rawPos);
+    char* out = bytes.data();
+
+    std::memcpy(out, raw.constData() + rawPos, static_cast<std::size_t>(buffered));
+    rawPos += buffered;
+
+    qsizetype filled = buffered;
+
+    if (filled < wanted) {
+        const qint64 got = file.read(out + filled, wanted - filled);
+        filled += std::max<qint64>(got, 0);
+    }
+
+    return filled;
+}
+
+void FileValue::flush() {
+
+    ensureOpen();
+
+    if (writable) {
+        file.flush();
+    }
+}
+
+void FileValue::close() {
+
+    if (closed) {
+        return;
+    }
+
+    file.close();
+    closed = true;
+
+    raw.clear();
+    text.reset();
+}
+
+bool FileValue::produce(Value& out) {
+
+    out = readline();
+
+    return binary ? !out.asBytes()->bytes().isEmpty() : !out.asString()->view().isEmpty();
+}
@@ -0,0 +1,32 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "FilterIterator.h"
+
+#include "CallRuntime.h"
+
+FilterIterator::FilterIterator(Value predicate, Value source, std::shared_ptr<Environment> env)
+    : LookaheadIterator(std::move(env)), predicate(std::move(predicate)), source(std::move(source)) {}
+
+bool FilterIterator::produce(Value& out) {
+
+    Value item;
+
+    while (iterNext(source, item, env)) {
+
+        const bool keep = predicate.isNone()
+            ? item.toBool()
+            : call(predicate, {item}, {}, env).toBool();
+
+        if (keep) {
+            out = std::move(item);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+QString FilterIterator::getTypeName() const {
+    return "filter";
+}
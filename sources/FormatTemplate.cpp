@@ -0,0 +1,329 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "FormatTemplate.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <QHash>
+
+namespace {
+
+    /// шаблонов в кэше; при переполнении он очищается целиком
+    constexpr qsizetype cacheLimit = 1024;
+
+    template<typename T>
+    std::shared_ptr<const T> cached(const QString& text, T (*parse)(const QString&)) {
+
+        static QHash<QString, std::shared_ptr<const T>> cache;
+
+        if (const auto it = cache.constFind(text); it != cache.constEnd()) {
+            return it.value();
+        }
+
+        auto compiled = std::make_shared<const T>(parse(text));
+
+        if (cache.size() >= cacheLimit) {
+            cache.clear();
+        }
+
+        cache.insert(text, compiled);
+
+        return compiled;
+    }
+
+    bool allDigits(const QStringView text) {
+        return !text.isEmpty() && std::all_of(text.begin(), text.end(), [](const QChar c) { return c.isDigit(); });
+    }
+
+    /// `.attr` и `[key]` после имени поля
+    std::vector<FormatTemplate::Accessor> parseAccessors(const QString& field, qsizetype pos) {
+
+        std::vector<FormatTemplate::Accessor> accessors;
+
+        while (pos < field.size()) {
+
+            FormatTemplate::Accessor accessor;
+
+            if (field[pos] == '.') {
+
+                const qsizetype start = ++pos;
+
+                while (pos < field.size() && field[pos] != '.' && field[pos] != '[') {
+                    ++pos;
+                }
+
+                accessor.attribute = true;
+                accessor.name = field.mid(start, pos - start);
+                accessors.push_back(std::move(accessor));
+                continue;
+            }
+
+            if (field[pos] != '[') {
+                throw std::runtime_error("ValueError: invalid format field");
+            }
+
+            const qsizetype close = field.indexOf(']', pos);
+
+            if (close == -1) {
+                throw std::runtime_error("ValueError: unmatched '[' in format field");
+            }
+
+            QString token = field.mid(pos + 1, close - pos - 1);
+            pos = close + 1;
+
+            // ['name'] и ["name"] — тот же ключ, что [name]
+            if (token.size() >= 2 &&
+                ((token.startsWith('\'') && token.endsWith('\'')) || (token.startsWith('"') && token.endsWith('"')))) {
+                token = token.mid(1, token.size() - 2);
+            } else if (allDigits(token)) {
+                accessor.index = token.toLongLong();
+            }
+
+            accessor.name = std::move(token);
+            accessors.push_back(std::move(accessor));
+        }
+
+        return accessors;
+    }
+
+    void classify(FormatTemplate::Segment& segment) {
+
+        if (!segment.conversion.isNull()) {
+            return;
+        }
+
+        const QString& spec = segment.spec;
+
+        if (spec.isEmpty()) {
+            segment.fast = FormatTemplate::FastSpec::Empty;
+        } else if (spec == "d") {
+            segment.fast = FormatTemplate::FastSpec::Decimal;
+        } else if (spec.size() >= 3 && spec.startsWith('.') && spec.endsWith('f') &&
+                   allDigits(QStringView(spec).mid(1, spec.size() - 2))) {
+            segment.fast = FormatTemplate::FastSpec::Fixed;
+            segment.precision = spec.mid(1, spec.size() - 2).toInt();
+        }
+    }
+
+    FormatTemplate parseBraces(const QString& text) {
+
+        FormatTemplate result;
+        FormatTemplate::Segment current;
+
+        qsizetype automatic = 0;
+        bool manual = false;
+
+        for (qsizetype pos = 0; pos < text.size();) {
+
+            const QChar c = text[pos];
+
+            if ((c == '{' || c == '}') && pos + 1 < text.size() && text[pos + 1] == c) {
+                current.literal += c;
+                pos += 2;
+                continue;
+            }
+
+            if (c != '{') {
+                current.literal += c;
+                ++pos;
+                continue;
+            }
+
+            const qsizetype end = text.indexOf('}', pos);
+
+            if (end == -1) {
+                throw std::runtime_error("ValueError: unmatched '{'");
+            }
+
+            QString field = text.mid(pos + 1, end - pos - 1);
+            pos = end + 1;
+
+            if (const qsizetype colon = field.indexOf(':'); colon != -1) {
+                current.spec = field.mid(colon + 1);
+                field.truncate(colon);
+            }
+
+            if (const qsizetype bang = field.indexOf('!'); bang != -1) {
+
+                if (bang + 1 >= field.size()) {
+                    throw std::runtime_error("ValueError: expected conversion");
+                }
+
+                current.conversion = field[bang + 1];
+
+                if (current.conversion != 'r' && current.conversion != 's' && current.conversion != 'a') {
+                    throw std::runtime_error("ValueError: unknown conversion");
+                }
+
+                field.truncate(bang);
+            }
+
+            qsizetype rootEnd = 0;
+
+            while (rootEnd < field.size() && field[rootEnd] != '.' && field[rootEnd] != '[') {
+                ++rootEnd;
+            }
+
+            const QString root = field.left(rootEnd);
+
+            if (root.isEmpty() || allDigits(root)) {
+
+                const bool isAutomatic = root.isEmpty();
+
+                if (isAutomatic && manual) {
+                    throw std::runtime_error(
+                        "ValueError: cannot switch from manual field specification to automatic field numbering");
+                }
+
+                if (!isAutomatic && automatic > 0) {
+                    throw std::runtime_error(
+                        "ValueError: cannot switch from automatic field numbering to manual field specification");
+                }
+
+                manual = !isAutomatic;
+                current.index = isAutomatic ? automatic++ : root.toLongLong();
+            } else {
+                current.name = root;
+            }
+
+            current.accessors = parseAccessors(field, rootEnd);
+            current.field = true;
+            classify(current);
+
+            result.literalLength += current.literal.size();
+            ++result.fieldCount;
+            result.segments.push_back(std::move(current));
+            current = FormatTemplate::Segment();
+        }
+
+        if (!current.literal.isEmpty()) {
+            result.literalLength += current.literal.size();
+            result.segments.push_back(std::move(current));
+        }
+
+        return result;
+    }
+
+    PercentTemplate parsePercent(const QString& text) {
+
+        PercentTemplate result;
+        PercentTemplate::Conversion current;
+
+        for (qsizetype pos = 0; pos < text.size();) {
+
+            if (text[pos] != '%') {
+                current.literal += text[pos++];
+                continue;
+            }
+
+            if (pos + 1 < text.size() && text[pos + 1] == '%') {
+                current.literal += '%';
+                pos += 2;
+                continue;
+            }
+
+            qsizetype i = pos + 1;
+
+            if (i < text.size() && text[i] == '(') {
+
+                const qsizetype close = text.indexOf(')', i + 1);
+
+                if (close == -1) {
+                    throw std::runtime_error("ValueError: incomplete format key");
+                }
+
+                current.key = text.mid(i + 1, close - i - 1);
+                current.keyed = true;
+                result.keyed = true;
+                i = close + 1;
+            }
+
+            for (; i < text.size(); ++i) {
+
+                const QChar flag = text[i];
+
+                if (flag == '+')      current.showSign = true;
+                else if (flag == ' ') current.spaceSign = true;
+                else if (flag == '#') current.alternateForm = true;
+                else if (flag == '-') current.leftAlign = true;
+                else if (flag == '0') current.zeroPad = true;
+                else break;
+            }
+
+            if (i < text.size() && text[i] == '*') {
+                current.starWidth = true;
+                ++result.argumentCount;
+                ++i;
+            } else {
+                while (i < text.size() && text[i].isDigit()) {
+                    current.width = current.width * 10 + text[i].digitValue();
+                    ++i;
+                }
+            }
+
+            if (i < text.size() && text[i] == '.') {
+
+                ++i;
+                current.precision = 0;
+
+                if (i < text.size() && text[i] == '*') {
+                    current.starPrecision = true;
+                    ++result.argumentCount;
+                    ++i;
+                } else {
+                    while (i < text.size() && text[i].isDigit()) {
+                        current.precision = current.precision * 10 + text[i].digitValue();
+                        ++i;
+                    }
+                }
+            }
+
+            if (i >= text.size()) {
+                throw std::runtime_error("ValueError: incomplete format");
+            }
+
+            current.type = QString(text[i]);
+            current.field = true;
+            current.plain = (current.type == "s" || current.type == "d") &&
+                            !current.leftAlign && !current.zeroPad && !current.showSign &&
+                            !current.spaceSign && !current.alternateForm && !current.starWidth &&
+                            !current.starPrecision && current.width == 0 && current.precision < 0;
+
+            pos = i + 1;
+
+            result.literalLength += current.literal.size();
+            ++result.argumentCount;
+            result.segments.push_back(std::move(current));
+            current = PercentTemplate::Conversion();
+        }
+
+        if (!current.literal.isEmpty()) {
+            result.literalLength += current.literal.size();
+            result.segments.push_back(std::move(current));
+        }
+
+        return result;
+    }
+}
+
+std::shared_ptr<const FormatTemplate> FormatTemplate::compile(const QString& text) {
+    return cached<FormatTemplate>(text, parseBraces);
+}
+
+FormatTemplate::Segment FormatTemplate::field(const QChar conversion, QString spec) {
+
+    Segment segment;
+
+    segment.field = true;
+    segment.conversion = conversion;
+    segment.spec = std::move(spec);
+    classify(segment);
+
+    return segment;
+}
+
+std::shared_ptr<const PercentTemplate> PercentTemplate::compile(const QString& text) {
+    return cached<PercentTemplate>(text, parsePercent);
+}
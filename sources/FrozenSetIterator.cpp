@@ -12,11 +12,17 @@ Value FrozenSetIterator::next() {
         throw StopIterationException();
     }
 
-    return frozenSet->getOrder()[index++];
+    const OrderedValueSet& elements = frozenSet->getElements();
+
+    index = elements.nextLive(index);
+
+    return elements.at(index++);
 }
 
 bool FrozenSetIterator::hasNext() const {
-    return index < frozenSet->getOrder().size();
+    const OrderedValueSet& elements = frozenSet->getElements();
+
+    return elements.nextLive(index) < elements.entryCount();
 }
 
 QString FrozenSetIterator::getTypeName() const {
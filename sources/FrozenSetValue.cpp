@@ -16,19 +16,13 @@ bool FrozenSetValue::contains(const Value& value) const {
     return elements.contains(value);
 }
 
-const QSet<Value> & FrozenSetValue::getElements() const {
+const OrderedValueSet& FrozenSetValue::getElements() const {
     return elements;
 }
 
-const QList<Value> & FrozenSetValue::getOrder() const {
-    return order;
-}
-
 Value FrozenSetValue::unionSet(const std::vector<Value>& others) const {
 
-    const auto result = std::make_shared<FrozenSetValue>();
-
-    result->elements = elements;
+    const auto result = std::make_shared<FrozenSetValue>(elements);
 
     for (const auto& iterable : others) {
 
@@ -47,41 +41,35 @@ Value FrozenSetValue::unionSet(const std::vector<Value>& others) const {
 
 Value FrozenSetValue::intersection(const std::vector<Value>& others) const {
 
-    const auto result = std::make_shared<FrozenSetValue>();
-
-    result->elements = elements;
+    OrderedValueSet current = elements;
 
     for (const auto& iterable : others) {
 
-        QSet<Value> current;
+        OrderedValueSet storage;
+        const OrderedValueSet& other = OrderedValueSet::of(iterable, storage);
 
-        const auto it = iterable.getIterator();
+        // проход по меньшему из множеств, проверка — в большем
+        const bool currentSmaller = current.size() <= other.size();
+        const OrderedValueSet& smaller = currentSmaller ? current : other;
+        const OrderedValueSet& larger = currentSmaller ? other : current;
 
-        while (it->hasNext()) {
-            current.insert(it->next());
-        }
-
-        for (auto iter = result->elements.begin();
-             iter != result->elements.end();) {
-
-            if (!current.contains(*iter)) {
+        OrderedValueSet kept;
 
-                iter = result->elements.erase(iter);
-
-            } else {
-                ++iter;
+        smaller.forEach([&](const Value& value) {
+            if (larger.contains(value)) {
+                kept.insert(value);
             }
-        }
+        });
+
+        current = std::move(kept);
     }
 
-    return Value(result);
+    return Value(std::make_shared<FrozenSetValue>(std::move(current)));
 }
 
 Value FrozenSetValue::difference(const std::vector<Value>& others) const {
 
-    const auto result = std::make_shared<FrozenSetValue>();
-
-    result->elements = elements;
+    const auto result = std::make_shared<FrozenSetValue>(elements);
 
     for (const auto& iterable : others) {
 
@@ -98,63 +86,72 @@ Value FrozenSetValue::difference(const std::vector<Value>& others) const {
 
 Value FrozenSetValue::symmetricDifference(const Value& other) const {
 
-    const auto result = std::make_shared<FrozenSetValue>();
-
-    result->elements = elements;
-
-    const auto it = other.getIterator();
-
-    while (it->hasNext()) {
-
-        const Value value = it->next();
-
-        if (result->elements.contains(value)) {
+    const auto result = std::make_shared<FrozenSetValue>(elements);
 
-            result->elements.remove(value);
+    OrderedValueSet storage;
 
-        } else {
+    OrderedValueSet::of(other, storage).forEach([&result](const Value& value) {
 
+        if (!result->elements.remove(value)) {
             result->elements.insert(value);
         }
-    }
+    });
 
     return Value(result);
 }
 
 Value FrozenSetValue::bitOr(const Value& other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return unionSet({other});
 }
 
 Value FrozenSetValue::bitAnd(const Value& other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return intersection({other});
 }
 
 Value FrozenSetValue::sub(const Value& other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return difference({other});
 }
 
 Value FrozenSetValue::bitXor(const Value& other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return symmetricDifference(other);
 }
 
 bool FrozenSetValue::isSubset(const Value& other) const {
 
-    const auto it = other.getIterator();
-
-    QSet<Value> otherSet;
+    OrderedValueSet storage;
+    const OrderedValueSet& otherSet = OrderedValueSet::of(other, storage);
 
-    while (it->hasNext()) {
-        otherSet.insert(it->next());
+    if (elements.size() > otherSet.size()) {
+        return false;
     }
 
-    for (const auto& value : elements) {
+    bool subset = true;
 
-        if (!otherSet.contains(value)) {
-            return false;
-        }
-    }
+    elements.forEach([&](const Value& value) {
+        subset = subset && otherSet.contains(value);
+    });
 
-    return true;
+    return subset;
 }
 
 bool FrozenSetValue::isSuperset(const Value& other) const {
@@ -172,46 +169,42 @@ bool FrozenSetValue::isSuperset(const Value& other) const {
 
 bool FrozenSetValue::isDisjoint(const Value &other) const {
 
-    const auto it = other.getIterator();
-
-    QSet<Value> otherSet;
+    OrderedValueSet storage;
+    const OrderedValueSet& otherSet = OrderedValueSet::of(other, storage);
 
-    while (it->hasNext()) {
-        otherSet.insert(it->next());
-    }
+    const bool selfSmaller = elements.size() <= otherSet.size();
+    const OrderedValueSet& smaller = selfSmaller ? elements : otherSet;
+    const OrderedValueSet& larger = selfSmaller ? otherSet : elements;
 
-    for (const auto& item : elements) {
+    bool disjoint = true;
 
-        if (otherSet.contains(item)) {
-            return false;
-        }
-    }
-
-    return true;
+    smaller.forEach([&](const Value& value) {
+        disjoint = disjoint && !larger.contains(value);
+    });
 
+    return disjoint;
 }
 
 bool FrozenSetValue::equal(const Value& other) const {
 
-    if (other.isSet()) {
-
-        const auto otherSet = other.asSet()->elements;
-
-        for (auto value : elements) {
-
-            if (!otherSet.contains(value)) {
-                return false;
-            }
-        }
-
-        return true;
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return false;
     }
 
-    if (!other.isFrozenSet()) {
+    OrderedValueSet storage;
+    const OrderedValueSet& otherSet = OrderedValueSet::of(other, storage);
+
+    if (elements.size() != otherSet.size()) {
         return false;
     }
 
-    return elements == other.asFrozenSet()->getElements();
+    bool same = true;
+
+    elements.forEach([&](const Value& value) {
+        same = same && otherSet.contains(value);
+    });
+
+    return same;
 }
 
 bool FrozenSetValue::notEqual(const Value& other) const {
@@ -244,18 +237,35 @@ Value FrozenSetValue::copy() const {
 
 std::size_t FrozenSetValue::hash() const {
 
+    if (cachedHash) {
+        return *cachedHash;
+    }
+
+    // хеши элементов уже лежат в таблице; перемешивание битов, как в CPython,
+    // не даёт xor близких хешей (малых int) сокращаться до одинаковых сумм
+    const auto shuffle = [](const std::size_t hash) {
+        return ((hash ^ 89869747u) ^ (hash << 16)) * 3644798167u;
+    };
+
     std::size_t result = 0;
 
-    for (const auto& value : elements) {
-        result ^= qHash(value);
-    }
+    elements.forEachHashed([&](const Value&, const std::size_t hash) {
+        result ^= shuffle(hash);
+    });
+
+    result ^= (elements.size() + 1) * 1927868237u;
 
-    result ^= elements.size();
+    cachedHash = result;
 
     return result;
 }
 
 Value FrozenSetValue::ror(const Value &other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return other | Value(
         std::const_pointer_cast<FrozenSetValue>(
             shared_from_this()
@@ -264,6 +274,11 @@ Value FrozenSetValue::ror(const Value &other) const {
 }
 
 Value FrozenSetValue::rand(const Value &other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return other & Value(
         std::const_pointer_cast<FrozenSetValue>(
             shared_from_this()
@@ -272,6 +287,11 @@ Value FrozenSetValue::rand(const Value &other) const {
 }
 
 Value FrozenSetValue::rsub(const Value &other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return other - Value(
         std::const_pointer_cast<FrozenSetValue>(
             shared_from_this()
@@ -280,6 +300,11 @@ Value FrozenSetValue::rsub(const Value &other) const {
 }
 
 Value FrozenSetValue::rxor(const Value &other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return other ^ Value(
         std::const_pointer_cast<FrozenSetValue>(
             shared_from_this()
@@ -1,6 +1,8 @@
 #include "FunctionValue.h"
 
 #include "BoundMethod.h"
+#include "Environment.h"
+#include "ObjectPool.h"
 #include "Value.h"
 //
 // Created by semyo on 03.05.2026.
@@ -13,7 +15,7 @@ Value FunctionValue::get(const Value& instance, const std::shared_ptr<ClassValue
     }
 
     // доступ через instance
-    return Value(std::make_shared<BoundMethod>(
+    return Value(makePooled<BoundMethod>(
         Value(shared_from_this()),
         instance,
         owner
@@ -36,3 +38,26 @@ QString FunctionValue::toString() const {
     return QString("<function %1 at %2>")
         .arg(name, addr);
 }
+
+long FunctionValue::gcRefCount() const {
+    return weak_from_this().use_count();
+}
+
+std::shared_ptr<GcObject> FunctionValue::gcSelf() {
+    return shared_from_this();
+}
+
+void FunctionValue::gcTraverse(const GcVisitor& visit) const {
+    visit(closure.get());
+    visit(ownerClass.get());
+
+    for (const auto& cell : cells) {
+        visit(cell.get());
+    }
+}
+
+void FunctionValue::gcClear() {
+    closure.reset();
+    ownerClass.reset();
+    cells.clear();
+}
@@ -0,0 +1,96 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "FunctoolsModule.h"
+
+#include "CachedFunctionValue.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    Value wrap(const Value& function, const std::optional<qsizetype> maxsize, const bool typed) {
+
+        if (!function.isCallable()) {
+            throw std::runtime_error("TypeError: the first argument must be callable");
+        }
+
+        return Value(std::static_pointer_cast<ObjectValue>(
+            std::make_shared<CachedFunctionValue>(function, maxsize, typed)));
+    }
+
+    /// None — без предела; отрицательный размер, как в CPython, равен 0
+    std::optional<qsizetype> parseMaxsize(const Value& value) {
+
+        if (value.isNone()) {
+            return std::nullopt;
+        }
+
+        const Value::BigInt maxsize = value.toBigInt();
+
+        return maxsize < 0 ? 0 : maxsize.convert_to<qsizetype>();
+    }
+}
+
+Value FunctoolsModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("functools");
+
+    module->setAttribute("lru_cache", makeBuiltin(
+        "lru_cache",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgsRange(args, 0, 2, "lru_cache");
+
+            Value maxsize = args.empty() ? Value(Value::SmallInt(128)) : args[0];
+            bool typed = args.size() > 1 && args[1].toBool();
+
+            for (const auto& [name, value] : kwargs) {
+
+                if (name == "maxsize") {
+                    maxsize = value;
+                } else if (name == "typed") {
+                    typed = value.toBool();
+                } else {
+                    throw std::runtime_error(
+                        "TypeError: lru_cache() got an unexpected keyword argument '" + name.toStdString() + "'");
+                }
+            }
+
+            // `@lru_cache` без скобок: первым аргументом пришла сама функция
+            if (maxsize.isCallable()) {
+                return wrap(maxsize, 128, typed);
+            }
+
+            if (!maxsize.isNone() && !maxsize.isBigInt() && !maxsize.isBool()) {
+                throw std::runtime_error("TypeError: Expected first argument to be an integer, a callable, or None");
+            }
+
+            const std::optional<qsizetype> limit = parseMaxsize(maxsize);
+
+            return makeBuiltin(
+                "decorating_function",
+                [limit, typed](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) {
+
+                    expectArgs(args, 1, "decorating_function");
+
+                    return wrap(args[0], limit, typed);
+                }
+            );
+        }
+    ));
+
+    module->setAttribute("cache", makeBuiltin(
+        "cache",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "cache");
+
+            return wrap(args[0], std::nullopt, false);
+        }
+    ));
+
+    return Value(module);
+}
@@ -0,0 +1,136 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "FutureValue.h"
+
+#include "EventLoop.h"
+#include "PyException.h"
+#include "StopIterationException.h"
+
+FutureValue* FutureValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<FutureValue*>(object->get()) : nullptr;
+}
+
+std::shared_ptr<FutureValue> FutureValue::create() {
+    return std::make_shared<FutureValue>();
+}
+
+void FutureValue::setResult(Value result) {
+
+    if (finished) {
+        throw std::runtime_error("RuntimeError: invalid state: the future is already done");
+    }
+
+    value = std::move(result);
+    finish();
+}
+
+void FutureValue::setException(std::exception_ptr exception) {
+
+    if (finished) {
+        throw std::runtime_error("RuntimeError: invalid state: the future is already done");
+    }
+
+    error = std::move(exception);
+    finish();
+}
+
+void FutureValue::finish() {
+
+    finished = true;
+
+    for (Callback& callback : callbacks) {
+        addDoneCallback(std::move(callback));
+    }
+
+    callbacks.clear();
+}
+
+Value FutureValue::result() const {
+
+    if (!finished) {
+        throw std::runtime_error("RuntimeError: invalid state: result is not set");
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return value;
+}
+
+Value FutureValue::exception() const {
+
+    if (!finished) {
+        throw std::runtime_error("RuntimeError: invalid state: exception is not set");
+    }
+
+    if (!error) {
+        return {};
+    }
+
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+        return PyException::toException(e);
+    }
+}
+
+void FutureValue::addDoneCallback(Callback callback) {
+
+    if (!finished) {
+        callbacks.push_back(std::move(callback));
+        return;
+    }
+
+    // вне цикла событий (Future завершили после asyncio.run) ждать некому — запуск сразу
+    if (EventLoop* loop = EventLoop::current()) {
+        loop->callSoon(std::move(callback));
+    } else {
+        callback();
+    }
+}
+
+QString FutureValue::toString() const {
+
+    if (!finished) {
+        return "<" + className() + " pending>";
+    }
+
+    if (error) {
+        return "<" + className() + " finished exception=" + exception().repr() + ">";
+    }
+
+    return "<" + className() + " finished result=" + value.repr() + ">";
+}
+
+FutureAwaiter::FutureAwaiter(Value future) : future(std::move(future)) {}
+
+bool FutureAwaiter::resume(Value& out) const {
+
+    const FutureValue* target = FutureValue::of(future);
+
+    if (!target->done()) {
+        out = future;
+        return true;
+    }
+
+    out = target->result();
+    return false;
+}
+
+Value FutureAwaiter::next() {
+
+    if (Value out; resume(out)) {
+        return out;
+    }
+
+    throw StopIterationException();
+}
+
+bool FutureAwaiter::hasNext() const {
+    return !FutureValue::of(future)->done();
+}
@@ -0,0 +1,308 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "GarbageCollector.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "CallRuntime.h"
+#include "ClassValue.h"
+#include "DictValue.h"
+#include "Environment.h"
+#include "FunctionValue.h"
+#include "InstanceValue.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "TupleValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+GcObject::GcObject() {
+    GarbageCollector::track(this);
+}
+
+GcObject::GcObject(const GcObject&) {
+    GarbageCollector::track(this);
+}
+
+GcObject::~GcObject() {
+    GarbageCollector::untrack(this);
+}
+
+void gcVisitValue(const Value& value, const GcVisitor& visit) {
+
+    if (const auto list = std::get_if<Value::ListPtr>(&value.data)) {
+        visit(list->get());
+    } else if (const auto dict = std::get_if<Value::DictPtr>(&value.data)) {
+        visit(dict->get());
+    } else if (const auto func = std::get_if<Value::FunctionPtr>(&value.data)) {
+        visit(func->get());
+    } else if (const auto instance = std::get_if<Value::InstancePtr>(&value.data)) {
+        visit(instance->get());
+    } else if (const auto cls = std::get_if<Value::ClassPtr>(&value.data)) {
+        visit(cls->get());
+    } else if (const auto object = std::get_if<Value::ObjectPtr>(&value.data)) {
+        // из прочих встроенных объектов циклы замыкают deque и обёртка lru_cache
+        if (const auto gc = dynamic_cast<const GcObject*>(object->get())) {
+            visit(gc);
+        }
+    }
+}
+
+void GarbageCollector::track(GcObject* object) {
+    link(object, 0);
+    ++counts[0];
+}
+
+void GarbageCollector::untrack(GcObject* object) {
+
+    unlink(object);
+
+    if (counts[0] > 0) {
+        --counts[0];
+    }
+}
+
+void GarbageCollector::link(GcObject* object, const int generation) {
+
+    object->gcGeneration = generation;
+    object->gcPrev = nullptr;
+    object->gcNext = heads[generation];
+
+    if (object->gcNext) {
+        object->gcNext->gcPrev = object;
+    }
+
+    heads[generation] = object;
+}
+
+void GarbageCollector::unlink(GcObject* object) {
+
+    if (object->gcPrev) {
+        object->gcPrev->gcNext = object->gcNext;
+    } else {
+        heads[object->gcGeneration] = object->gcNext;
+    }
+
+    if (object->gcNext) {
+        object->gcNext->gcPrev = object->gcPrev;
+    }
+
+    object->gcPrev = object->gcNext = nullptr;
+}
+
+std::size_t GarbageCollector::collect(const int generation) {
+
+    // деструкторы освобождённых объектов не должны запускать сборку повторно
+    if (collecting) {
+        return 0;
+    }
+
+    collecting = true;
+
+    const int oldest = std::clamp(generation, 0, generations - 1);
+
+    struct State {
+        /// владельцы, оставшиеся после вычета ссылок изнутри собираемых поколений
+        long refs = 0;
+        bool reachable = false;
+    };
+
+    std::vector<GcObject*> objects;
+
+    for (int g = 0; g <= oldest; ++g) {
+        for (GcObject* object = heads[g]; object; object = object->gcNext) {
+            objects.push_back(object);
+        }
+    }
+
+    std::unordered_map<const GcObject*, State> states;
+    states.reserve(objects.size());
+
+    std::vector<const GcObject*> pending;
+
+    for (GcObject* object : objects) {
+
+        const long owners = object->gcRefCount();
+
+        // объект вне shared_ptr (временный, ещё не отданный владельцу) считается живым
+        states[object] = State{owners, owners == 0};
+
+        if (owners == 0) {
+            pending.push_back(object);
+        }
+    }
+
+    for (const GcObject* object : objects) {
+        object->gcTraverse([&](const GcObject* child) {
+            if (const auto it = states.find(child); it != states.end()) {
+                --it->second.refs;
+            }
+        });
+    }
+
+    for (const GcObject* object : objects) {
+
+        if (State& state = states[object]; !state.reachable && state.refs > 0) {
+            state.reachable = true;
+            pending.push_back(object);
+        }
+    }
+
+    while (!pending.empty()) {
+
+        const GcObject* object = pending.back();
+        pending.pop_back();
+
+        object->gcTraverse([&](const GcObject* child) {
+            if (const auto it = states.find(child); it != states.end() && !it->second.reachable) {
+                it->second.reachable = true;
+                pending.push_back(child);
+            }
+        });
+    }
+
+    // выжившие переходят в следующее поколение, мусор удерживается до конца очистки
+    const int survivors = std::min(oldest + 1, generations - 1);
+    std::vector<std::shared_ptr<GcObject>> garbage;
+
+    for (GcObject* object : objects) {
+
+        if (states[object].reachable) {
+            unlink(object);
+            link(object, survivors);
+        } else {
+            garbage.push_back(object->gcSelf());
+        }
+    }
+
+    for (int g = 0; g <= oldest; ++g) {
+        counts[g] = 0;
+    }
+
+    if (oldest + 1 < generations) {
+        ++counts[oldest + 1];
+    }
+
+    for (const auto& object : garbage) {
+        object->gcClear();
+    }
+
+    const std::size_t collected = garbage.size();
+    garbage.clear();
+
+    collecting = false;
+
+    return collected;
+}
+
+void GarbageCollector::collectGenerations() {
+
+    for (int g = generations - 1; g > 0; --g) {
+        if (thresholds[g] > 0 && counts[g] > thresholds[g]) {
+            collect(g);
+            return;
+        }
+    }
+
+    collect(0);
+}
+
+Value GarbageCollector::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("gc");
+
+    const auto counters = [](const std::array<long, generations>& values) {
+
+        std::vector<Value> items;
+
+        for (const long value : values) {
+            items.emplace_back(static_cast<Value::SmallInt>(value));
+        }
+
+        return Value(makePooled<TupleValue>(items));
+    };
+
+    module->setAttribute("collect", makeBuiltin(
+        "collect",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgsRange(args, 0, 1, "collect");
+
+            int generation = generations - 1;
+
+            if (!args.empty()) {
+
+                const Value::BigInt requested = args[0].asBigInt("collect");
+
+                if (requested < 0 || requested >= generations) {
+                    throw std::runtime_error("ValueError: invalid generation");
+                }
+
+                generation = requested.convert_to<int>();
+            }
+
+            return Value(static_cast<Value::SmallInt>(collect(generation)));
+        }
+    ));
+
+    module->setAttribute("enable", makeBuiltin(
+        "enable",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "enable");
+            enabled = true;
+            return Value();
+        }
+    ));
+
+    module->setAttribute("disable", makeBuiltin(
+        "disable",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "disable");
+            enabled = false;
+            return Value();
+        }
+    ));
+
+    module->setAttribute("isenabled", makeBuiltin(
+        "isenabled",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "isenabled");
+            return Value(enabled);
+        }
+    ));
+
+    module->setAttribute("get_threshold", makeBuiltin(
+        "get_threshold",
+        [counters](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "get_threshold");
+            return counters(thresholds);
+        }
+    ));
+
+    module->setAttribute("set_threshold", makeBuiltin(
+        "set_threshold",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgsRange(args, 1, generations, "set_threshold");
+
+            for (std::size_t i = 0; i < args.size(); ++i) {
+                thresholds[i] = args[i].asBigInt("set_threshold").convert_to<long>();
+            }
+
+            return Value();
+        }
+    ));
+
+    module->setAttribute("get_count", makeBuiltin(
+        "get_count",
+        [counters](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "get_count");
+            return counters(counts);
+        }
+    ));
+
+    return Value(module);
+}
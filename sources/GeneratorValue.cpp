@@ -0,0 +1,121 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "GeneratorValue.h"
+
+#include "Bytecode.h"
+#include "Environment.h"
+#include "StopIterationException.h"
+
+GeneratorValue::GeneratorValue(std::shared_ptr<const CodeObject> code, std::shared_ptr<Environment> env, QString name)
+    : code(std::move(code)), env(std::move(env)), name(std::move(name)), frame(std::in_place) {}
+
+bool GeneratorValue::resume(const Value& sent, Value& out) {
+
+    if (!frame) {
+        return false;
+    }
+
+    if (running) {
+        throw std::runtime_error("ValueError: generator already executing");
+    }
+
+    if (started) {
+        // результат выражения yield, на котором кадр остановился
+        frame->stack->push_back(sent);
+    } else if (!sent.isNone()) {
+        throw std::runtime_error("TypeError: can't send non-None value to a just-started generator");
+    }
+
+    started = true;
+    running = true;
+
+    Value value;
+
+    try {
+        value = VirtualMachine::execute(*code, env, *frame);
+    } catch (...) {
+        // исключение из тела завершает генератор, как в CPython
+        running = false;
+        frame.reset();
+        throw;
+    }
+
+    running = false;
+
+    if (frame->suspended) {
+        out = std::move(value);
+        return true;
+    }
+
+    result = std::move(value);
+    frame.reset();
+
+    return false;
+}
+
+Value GeneratorValue::send(const Value& value) {
+
+    // значение уже получено заранее через hasNext(): кадр стоит на следующем yield
+    if (pending) {
+        Value item = std::move(*pending);
+        pending.reset();
+        return item;
+    }
+
+    Value item;
+
+    if (!resume(value, item)) {
+        throw StopIterationException();
+    }
+
+    return item;
+}
+
+void GeneratorValue::close() {
+
+    if (running) {
+        throw std::runtime_error("ValueError: generator already executing");
+    }
+
+    pending.reset();
+    frame.reset();
+}
+
+bool GeneratorValue::hasNext() const {
+
+    if (pending) {
+        return true;
+    }
+
+    // возобновление меняет кадр; для наблюдателя генератор тот же
+    auto* self = const_cast<GeneratorValue*>(this);
+
+    if (Value item; self->resume(Value(), item)) {
+        pending = std::move(item);
+    }
+
+    return pending.has_value();
+}
+
+Value GeneratorValue::next() {
+
+    if (!hasNext()) {
+        throw StopIterationException();
+    }
+
+    Value item = std::move(*pending);
+    pending.reset();
+
+    return item;
+}
+
+QString GeneratorValue::getTypeName() const {
+    return "generator";
+}
+
+QString GeneratorValue::toString() const {
+    return QString("<%1 object %2 at 0x%3>")
+        .arg(getTypeName(), name)
+        .arg(reinterpret_cast<quintptr>(this), 0, 16);
+}
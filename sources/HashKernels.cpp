@@ -0,0 +1,140 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "HashKernels.h"
+
+#include <cstring>
+
+#include <QRandomGenerator>
+#include <QtGlobal>
+
+namespace hashkernels {
+
+    namespace {
+
+        /// константы wyhash: нечётные, с равным числом единичных битов в каждом байте
+        constexpr std::uint64_t secret[4] = {
+            0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+        };
+
+        /// полное произведение a·b: младшая половина в a, старшая в b
+        inline void multiply(std::uint64_t& a, std::uint64_t& b) {
+#ifdef __SIZEOF_INT128__
+            const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<std::uint64_t>(product);
+            b = static_cast<std::uint64_t>(product >> 64);
+#else
+            const std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+            const std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+            const std::uint64_t high = aHigh * bHigh, middle0 = aHigh * bLow, middle1 = aLow * bHigh, low = aLow * bLow;
+            const std::uint64_t middle = (low >> 32) + static_cast<std::uint32_t>(middle0) + static_cast<std::uint32_t>(middle1);
+            a = (middle << 32) | static_cast<std::uint32_t>(low);
+            b = high + (middle0 >> 32) + (middle1 >> 32) + (middle >> 32);
+#endif
+        }
+
+        inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) {
+            multiply(a, b);
+            return a ^ b;
+        }
+
+        inline std::uint64_t read8(const std::uint8_t* p) {
+            std::uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline std::uint64_t read4(const std::uint8_t* p) {
+            std::uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        /// 1–3 байта: первый, средний и последний
+        inline std::uint64_t read3(const std::uint8_t* p, const std::size_t size) {
+            return static_cast<std::uint64_t>(p[0]) << 16 | static_cast<std::uint64_t>(p[size >> 1]) << 8 | p[size - 1];
+        }
+
+        std::uint64_t wyhash(const std::uint8_t* p, const std::size_t size, std::uint64_t state) {
+
+            state ^= mix(state ^ secret[0], secret[1]);
+
+            std::uint64_t a = 0;
+            std::uint64_t b = 0;
+
+            if (size <= 16) {
+
+                if (size >= 4) {
+                    // два перекрывающихся окна по 8 байт, собранные из четвёрок
+                    const std::size_t shift = (size >> 3) << 2;
+                    a = read4(p) << 32 | read4(p + shift);
+                    b = read4(p + size - 4) << 32 | read4(p + size - 4 - shift);
+                } else if (size > 0) {
+                    a = read3(p, size);
+                }
+
+            } else {
+
+                std::size_t left = size;
+
+                if (left >= 48) {
+
+                    std::uint64_t lane1 = state;
+                    std::uint64_t lane2 = state;
+
+                    do {
+                        state = mix(read8(p) ^ secret[1], read8(p + 8) ^ state);
+                        lane1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ lane1);
+                        lane2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ lane2);
+                        p += 48;
+                        left -= 48;
+                    } while (left >= 48);
+
+                    state ^= lane1 ^ lane2;
+                }
+
+                while (left > 16) {
+                    state = mix(read8(p) ^ secret[1], read8(p + 8) ^ state);
+                    p += 16;
+                    left -= 16;
+                }
+
+                // последние 16 байт, возможно перекрывающие уже прочитанные
+                a = read8(p + left - 16);
+                b = read8(p + left - 8);
+            }
+
+            a ^= secret[1];
+            b ^= state;
+            multiply(a, b);
+
+            return mix(a ^ secret[0] ^ size, b ^ secret[1]);
+        }
+    }
+
+    std::uint64_t seed() {
+
+        static const std::uint64_t value = [] {
+
+            bool ok = false;
+            const qulonglong fixed = qEnvironmentVariable("PYTHONHASHSEED").toULongLong(&ok);
+
+            if (ok) {
+                return static_cast<std::uint64_t>(fixed);
+            }
+
+            return QRandomGenerator::system()->generate64();
+        }();
+
+        return value;
+    }
+
+    std::size_t hashBytes(const void* data, const std::size_t size) {
+
+        const std::size_t hash = static_cast<std::size_t>(
+            wyhash(static_cast<const std::uint8_t*>(data), size, seed())
+        );
+
+        return hash == static_cast<std::size_t>(-1) ? static_cast<std::size_t>(-2) : hash;
+    }
+}
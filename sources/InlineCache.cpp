@@ -0,0 +1,199 @@
+//
+// Created by semyo on 14.10.2026.
+//
+#include "InlineCache.h"
+
+#include "BuiltinFunction.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "DescriptorUtils.h"
+#include "FunctionValue.h"
+#include "InstanceValue.h"
+#include "ModuleValue.h"
+#include "RuntimeStats.h"
+#include "SuperValue.h"
+
+InlineCacheEntry& InlineCache::lookup(const std::shared_ptr<ClassValue>& cls, const QString& attr) {
+
+    for (auto& entry : entries) {
+        if (entry.klass == cls && entry.version == ClassValue::attributesVersion) {
+            RuntimeStats::add(RuntimeStats::AttributeCacheHits);
+            return entry;
+        }
+    }
+
+    // промах: новая запись вытесняет самую старую
+    RuntimeStats::add(RuntimeStats::AttributeCacheMisses);
+
+    InlineCacheEntry& entry = entries[next];
+    next = (next + 1) % capacity;
+
+    entry.klass = cls;
+    entry.classAttr = Value();
+    entry.shape = nullptr;
+
+    // версия фиксируется до поиска: hasGet/hasSet пользовательского дескриптора
+    // выполняют код, который может изменить классы
+    entry.version = ClassValue::attributesVersion;
+
+    const std::optional<Value> getattribute = findAttrInHierarchy(cls, "__getattribute__");
+    const auto builtin = getattribute ? std::get_if<Value::BuiltinFunctionPtr>(&getattribute->data) : nullptr;
+
+    if (!builtin || (*builtin)->name != "__object_getattribute__") {
+        entry.kind = InlineCacheEntry::Kind::Generic;
+        return entry;
+    }
+
+    const std::optional<ClassValue::Attr> found = findClassAttr(cls, attr);
+
+    if (!found) {
+        entry.kind = InlineCacheEntry::Kind::Missing;
+    } else if (std::holds_alternative<Value::FunctionPtr>(found->value.data)) {
+        entry.kind = InlineCacheEntry::Kind::Method;
+    } else if (!found->getter) {
+        entry.kind = InlineCacheEntry::Kind::Plain;
+    } else if (found->setter) {
+        entry.kind = InlineCacheEntry::Kind::DataDescriptor;
+    } else {
+        entry.kind = InlineCacheEntry::Kind::Descriptor;
+    }
+
+    if (found) {
+        entry.classAttr = found->value;
+    }
+
+    if (entry.version != ClassValue::attributesVersion) {
+        entry.kind = InlineCacheEntry::Kind::Generic;
+    }
+
+    return entry;
+}
+
+const Value* InlineCache::findField(InlineCacheEntry& entry, const InstanceValue& instance, const QString& attr) {
+
+    if (entry.shape != instance.shape.get()) {
+        entry.shape = instance.shape.get();
+        entry.offset = instance.shape->offsetOf(attr);
+    }
+
+    if (entry.offset >= 0) {
+        return &instance.slots[entry.offset];
+    }
+
+    if (const auto it = instance.overflow.constFind(attr); it != instance.overflow.cend()) {
+        return &it.value();
+    }
+
+    return nullptr;
+}
+
+Value InlineCache::getAttr(const Value& obj, const QString& attr) {
+
+    const auto instance = std::get_if<Value::InstancePtr>(&obj.data);
+
+    if (!instance) {
+
+        if (const auto super = std::get_if<Value::SuperPtr>(&obj.data)) {
+            return getAttrFromSuper(*super, attr);
+        }
+
+        // `mod.name` — одно обращение к глобальным переменным модуля
+        if (const ModuleValue* module = ModuleValue::of(obj)) {
+            if (std::optional<Value> value = module->findAttr(attr)) {
+                return std::move(*value);
+            }
+        }
+
+        return getAttrValue(obj, attr);
+    }
+
+    const auto cls = (*instance)->klass;
+
+    // копии: дескриптор может выполнить код, который перезапишет запись этого же кэша
+    InlineCacheEntry& entry = lookup(cls, attr);
+    const auto kind = entry.kind;
+    const Value classAttr = entry.classAttr;
+
+    using Kind = InlineCacheEntry::Kind;
+
+    if (kind == Kind::Generic) {
+        return getAttrValue(obj, attr);
+    }
+
+    if (kind == Kind::DataDescriptor) {
+        return DescriptorUtils::callGet(classAttr, obj, cls);
+    }
+
+    if (const Value* field = findField(entry, **instance, attr)) {
+        return *field;
+    }
+
+    switch (kind) {
+        case Kind::Plain:
+            return classAttr;
+
+        case Kind::Method:
+        case Kind::Descriptor:
+            return DescriptorUtils::callGet(classAttr, obj, cls);
+
+        default:
+            // __getattr__ или AttributeError
+            return getAttrValue(obj, attr);
+    }
+}
+
+Value InlineCache::callMethod(const Value& obj,
+                              const QString& attr,
+                              const std::vector<Value>& args,
+                              const Kwargs& kwargs,
+                              const std::shared_ptr<Environment>& env) {
+
+    const auto instance = std::get_if<Value::InstancePtr>(&obj.data);
+
+    if (!instance) {
+
+        // `super().name(...)` в методе экземпляра: функция предка вызывается без связанного метода
+        if (const auto super = std::get_if<Value::SuperPtr>(&obj.data);
+            super && (*super)->receiver.isInstance()) {
+
+            const Value::ClassPtr receiverClass = (*super)->receiver.asInstance()->klass;
+
+            if (const std::optional<ClassValue::SuperAttr> found =
+                    findSuperAttr(receiverClass, (*super)->originClass, attr)) {
+
+                if (const auto func = std::get_if<Value::FunctionPtr>(&found->attr.value.data)) {
+                    return callMethodFunction(*func, (*super)->receiver, found->owner, args, kwargs);
+                }
+            }
+        }
+
+        return ::callMethod(obj, attr, args, kwargs, env);
+    }
+
+    std::shared_ptr<ClassValue> cls;
+
+    if (const Value::FunctionPtr func = findMethod(obj, attr, cls)) {
+        return callMethodFunction(func, obj, cls, args, kwargs);
+    }
+
+    return call(getAttr(obj, attr), args, kwargs, env);
+}
+
+Value::FunctionPtr InlineCache::findMethod(const Value& obj, const QString& attr, std::shared_ptr<ClassValue>& owner) {
+
+    const auto instance = std::get_if<Value::InstancePtr>(&obj.data);
+
+    if (!instance) {
+        return nullptr;
+    }
+
+    const auto& cls = (*instance)->klass;
+
+    if (InlineCacheEntry& entry = lookup(cls, attr);
+        entry.kind == InlineCacheEntry::Kind::Method && !findField(entry, **instance, attr)) {
+        owner = cls;
+        return std::get<Value::FunctionPtr>(entry.classAttr.data);
+    }
+
+    return nullptr;
+}
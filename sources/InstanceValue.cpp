@@ -2,10 +2,68 @@
 //
 // Created by semyo on 05.05.2026.
 //
+#include "PyException.h"
+
+void InstanceValue::setField(const QString& name, const Value& value) {
+
+    if (const int offset = shape->offsetOf(name); offset >= 0) {
+        slots[offset] = value;
+        return;
+    }
+
+    if ((shape->isFull() && !klass->slotNames) || overflow.contains(name)) {
+        overflow.insert(name, value);
+        return;
+    }
+
+    shape = shape->withField(name);
+    slots.push_back(value);
+}
+
 QString InstanceValue::toString() const {
+
+    if (PyException::isExceptionClass(klass)) {
+        return PyException::message(*this);
+    }
+
     QString addr = QString("0x%1")
         .arg(reinterpret_cast<quintptr>(this), 0, 16);
 
     return QString("<%1.%2 object at %3>")
             .arg("__main__", klass->name, addr);
 }
+
+QString InstanceValue::repr() const {
+
+    if (PyException::isExceptionClass(klass)) {
+        return PyException::repr(*this);
+    }
+
+    return toString();
+}
+
+long InstanceValue::gcRefCount() const {
+    return weak_from_this().use_count();
+}
+
+std::shared_ptr<GcObject> InstanceValue::gcSelf() {
+    return shared_from_this();
+}
+
+void InstanceValue::gcTraverse(const GcVisitor& visit) const {
+
+    visit(klass.get());
+
+    for (const auto& value : slots) {
+        gcVisitValue(value, visit);
+    }
+
+    for (const auto& value : overflow) {
+        gcVisitValue(value, visit);
+    }
+}
+
+void InstanceValue::gcClear() {
+    slots.clear();
+    overflow.clear();
+}
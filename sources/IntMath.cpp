@@ -0,0 +1,291 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "IntMath.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "IntOps.h"
+
+namespace {
+
+    using SmallInt = Value::SmallInt;
+    using BigInt = Value::BigInt;
+
+    /// машинное значение целого или bool
+    bool small(const Value& value, SmallInt& out) {
+
+        if (const auto integer = std::get_if<SmallInt>(&value.data)) {
+            out = *integer;
+            return true;
+        }
+
+        if (const auto flag = std::get_if<bool>(&value.data)) {
+            out = *flag;
+            return true;
+        }
+
+        return false;
+    }
+
+    /// модуль без переполнения на INT64_MIN
+    std::uint64_t magnitude(const SmallInt value) {
+        return value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+    }
+
+    /// остаток со знаком делителя, как `%` в Python
+    BigInt floorMod(const BigInt& value, const BigInt& modulus) {
+
+        BigInt remainder = value % modulus;
+
+        if (remainder != 0 && (remainder < 0) != (modulus < 0)) {
+            remainder += modulus;
+        }
+
+        return remainder;
+    }
+
+    /// обратный к value по модулю modulus > 0 — расширенный алгоритм Евклида
+    BigInt inverse(const BigInt& value, const BigInt& modulus) {
+
+        // инвариант: r ≡ s·value (mod modulus) для обеих пар
+        BigInt r0 = floorMod(value, modulus);
+        BigInt r1 = modulus;
+        BigInt s0 = 1;
+        BigInt s1 = 0;
+
+        while (r1 != 0) {
+
+            const BigInt quotient = r0 / r1;
+
+            r0 -= quotient * r1;
+            s0 -= quotient * s1;
+
+            std::swap(r0, r1);
+            std::swap(s0, s1);
+        }
+
+        if (r0 != 1) {
+            throw std::runtime_error("ValueError: base is not invertible for the given modulus");
+        }
+
+        return floorMod(s0, modulus);
+    }
+}
+
+Value IntMath::power(const Value& base, const Value& exp) {
+
+    SmallInt b;
+    SmallInt e;
+
+    if (small(base, b) && small(exp, e)) {
+
+        SmallInt result = 1;
+        SmallInt square = b;
+        bool overflow = false;
+
+        // квадрат нужен, только пока остались биты степени: переполнение в нём
+        // означает переполнение и результата
+        while (e > 0 && !overflow) {
+
+            if (e & 1) {
+                overflow = intops::mulOverflow(result, square, result);
+            }
+
+            e >>= 1;
+
+            if (e > 0 && !overflow) {
+                overflow = intops::mulOverflow(square, square, square);
+            }
+        }
+
+        if (!overflow) {
+            return Value(result);
+        }
+    }
+
+    const BigInt value = base.toBigInt();
+    const BigInt exponent = exp.toBigInt();
+
+    if (exponent > std::numeric_limits<unsigned>::max()) {
+
+        if (value == 0 || value == 1) {
+            return Value(value);
+        }
+
+        if (value == -1) {
+            return Value(SmallInt(exponent % 2 == 0 ? 1 : -1));
+        }
+
+        throw std::runtime_error("OverflowError: exponent too large");
+    }
+
+    return Value(BigInt(boost::multiprecision::pow(value, exponent.convert_to<unsigned>())));
+}
+
+Value IntMath::powerMod(const Value& base, const Value& exp, const Value& mod) {
+
+    SmallInt b;
+    SmallInt e;
+    SmallInt m;
+
+    if (small(base, b) && small(exp, e) && small(mod, m) &&
+        e >= 0 && m != 0 && m != std::numeric_limits<SmallInt>::min()) {
+
+        const std::uint64_t modulus = magnitude(m);
+
+        SmallInt reduced = b % static_cast<SmallInt>(modulus);
+
+        if (reduced < 0) {
+            reduced += static_cast<SmallInt>(modulus);
+        }
+
+        // остатки меньше модуля: mulMod перемножает их без переполнения
+        std::uint64_t square = static_cast<std::uint64_t>(reduced);
+        std::uint64_t result = 1 % modulus;
+
+        while (e > 0) {
+
+            if (e & 1) {
+                result = intops::mulMod(result, square, modulus);
+            }
+
+            square = intops::mulMod(square, square, modulus);
+            e >>= 1;
+        }
+
+        auto value = static_cast<SmallInt>(result);
+
+        if (m < 0 && value != 0) {
+            value += m;
+        }
+
+        return Value(value);
+    }
+
+    const BigInt modulusSigned = mod.toBigInt();
+
+    if (modulusSigned == 0) {
+        throw std::runtime_error("ValueError: pow() 3rd argument cannot be 0");
+    }
+
+    const BigInt modulus = abs(modulusSigned);
+
+    BigInt value = floorMod(base.toBigInt(), modulus);
+    BigInt exponent = exp.toBigInt();
+
+    if (exponent < 0) {
+        value = inverse(value, modulus);
+        exponent = -exponent;
+    }
+
+    BigInt result = modulus == 1 ? BigInt(0) : BigInt(powm(value, exponent, modulus));
+
+    if (modulusSigned < 0 && result != 0) {
+        result += modulusSigned;
+    }
+
+    return Value(result);
+}
+
+std::pair<Value, Value> IntMath::divMod(const Value& left, const Value& right) {
+
+    SmallInt a;
+    SmallInt b;
+
+    if (small(left, a) && small(right, b) && b != 0 &&
+        !(a == std::numeric_limits<SmallInt>::min() && b == -1)) {
+
+        SmallInt quotient = a / b;
+        SmallInt remainder = a % b;
+
+        if (remainder != 0 && (remainder < 0) != (b < 0)) {
+            --quotient;
+            remainder += b;
+        }
+
+        return { Value(quotient), Value(remainder) };
+    }
+
+    const BigInt divisor = right.toBigInt();
+
+    if (divisor == 0) {
+        throw std::runtime_error("ZeroDivisionError: integer division or modulo by zero");
+    }
+
+    BigInt quotient;
+    BigInt remainder;
+
+    divide_qr(left.toBigInt(), divisor, quotient, remainder);
+
+    if (remainder != 0 && (remainder < 0) != (divisor < 0)) {
+        --quotient;
+        remainder += divisor;
+    }
+
+    return { Value(quotient), Value(remainder) };
+}
+
+Value IntMath::round(const Value& value, const Value& ndigits) {
+
+    if (ndigits.isNone() || ndigits.toBigInt() >= 0) {
+        return value.isBool() ? Value(value.toBigInt()) : value;
+    }
+
+    const BigInt places = -ndigits.toBigInt();
+
+    // |value| < 2^k <= 10^k / 2: ближайшее кратное 10^k — ноль
+    if (places >= bitLength(value)) {
+        return Value(SmallInt(0));
+    }
+
+    const BigInt unit = boost::multiprecision::pow(BigInt(10), places.convert_to<unsigned>());
+    auto [quotient, remainder] = divMod(value, Value(unit));
+
+    const BigInt twice = remainder.toBigInt() * 2;
+
+    if (twice > unit || (twice == unit && quotient.toBigInt() % 2 != 0)) {
+        quotient = quotient + Value(SmallInt(1));
+    }
+
+    return Value(BigInt(quotient.toBigInt() * unit));
+}
+
+Value::SmallInt IntMath::bitLength(const Value& value) {
+
+    if (SmallInt integer; small(value, integer)) {
+
+        const std::uint64_t bits = magnitude(integer);
+
+        return bits == 0 ? 0 : 64 - intops::countLeadingZeros(bits);
+    }
+
+    const BigInt integer = abs(value.toBigInt());
+
+    return integer == 0 ? 0 : static_cast<SmallInt>(msb(integer)) + 1;
+}
+
+Value::SmallInt IntMath::bitCount(const Value& value) {
+
+    if (SmallInt integer; small(value, integer)) {
+        return intops::popCount(magnitude(integer));
+    }
+
+    const BigInt integer = abs(value.toBigInt());
+
+#ifdef CPPYTHON_USE_GMP
+    return static_cast<SmallInt>(mpz_popcount(integer.backend().data()));
+#else
+    // лимбы модуля cpp_int — младшим словом вперёд, без дополнительного кода
+    const auto& backend = integer.backend();
+    SmallInt count = 0;
+
+    for (std::size_t i = 0; i < backend.size(); ++i) {
+        count += intops::popCount(static_cast<std::uint64_t>(backend.limbs()[i]));
+    }
+
+    return count;
+#endif
+}
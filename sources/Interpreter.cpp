@@ -3,10 +3,45 @@
 #include "Lexer.h"
 #include "Parser.h"
 #include "BuiltinFunction.h"
+#include "CallRuntime.h"
+#include "Compiler.h"
+#include "ExecutionBudget.h"
+#include "GarbageCollector.h"
+#include "ArrayModule.h"
+#include "AsyncioModule.h"
+#include "CodecModule.h"
+#include "CollectionsModule.h"
+#include "FunctoolsModule.h"
+#include "IoModule.h"
+#include "JsonModule.h"
+#include "MarshalModule.h"
+#include "OrderModule.h"
+#include "RegexModule.h"
+#include "MemoryTracker.h"
+#include "ModuleLoader.h"
+#include "OutputStream.h"
+#include "ParallelMap.h"
+#include "Profiler.h"
+#include "RuntimeStats.h"
+#include "SharedMemoryModule.h"
+#include "StructModule.h"
+#include "TimeModule.h"
+#include "Tracer.h"
+#include "TypeProfile.h"
+#include "VecMathModule.h"
+#include "PyException.h"
+#include "SysModule.h"
+#include "VirtualMachine.h"
 #include <iostream>
 #include <sstream>
+#include <string_view>
 
-#include "Runtime.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+
+#include "InterpreterContext.h"
 #include "../runtime/builtins/bytearray/ByteArrayMethods.h"
 #include "../runtime/builtins/bytes/BytesMethods.h"
 #include "../runtime/builtins/str/StrMethods.h"
@@ -42,17 +77,25 @@ std::string Interpreter::assembleCode(const std::vector<std::string>& lines) {
     return oss.str();
 }
 
+/**
+ * Выполняет инструкцию через виртуальную машину. При первом выполнении узел компилируется
+ * в байткод, который кэшируется в самом узле: тела циклов и ветвлений, выполняемые
+ * из AST повторно, не компилируются заново. Результаты инструкций-выражений выводятся
+ * так же, как в REPL.
+ *
+ * @param node Корень инструкции.
+ * @param env Окружение выполнения.
+ * @return Значение последней выполненной инструкции-выражения.
+ */
 Value Interpreter::executeNode(
     const std::shared_ptr<ASTNode>& node,
     const std::shared_ptr<Environment>& env) {
 
-    const Value result = node->eval(env);
-
-    if (node->shouldPrint() && !result.isNone()) {
-        std::cout << result.display().toStdString() << "\n";
+    if (!node->bytecode) {
+        node->bytecode = Compiler::compile(node);
     }
 
-    return result;
+    return VirtualMachine::run(*node->bytecode, env);
 }
 
 /**
@@ -72,94 +115,375 @@ void Interpreter::executeCode(
 
     try {
 
-        const QVector<Token> tokens = lexer.tokenize(QString::fromStdString(code));
+        const QVector<Token> tokens = lexer.tokenize(code);
         Parser parser(tokens);
         const std::shared_ptr<ASTNode> ast = parser.parse();
 
         executeNode(ast, env);
 
     } catch (const std::runtime_error& e) {
-        std::cout << e.what() << "\n";
+        OutputStream& out = OutputStream::standardOutput();
+        out.write(std::string_view(e.what()));
+        out.write(std::string_view("\n"));
+    }
+}
+
+
+/**
+ * Создаёт окружение встроенных имён: функции и классы object, str, bytes и bytearray.
+ * Общее для REPL и выполнения файла; глобальные окружения модулей — его потомки.
+ * Встроенные классы записываются в активный InterpreterContext.
+ *
+ * @return Окружение встроенных имён.
+ */
+std::shared_ptr<Environment> Interpreter::createGlobals() {
+
+    InterpreterContext& context = InterpreterContext::current();
+
+    const auto globalEnv = std::make_shared<Environment>();
+    BuiltinFunction::registerBuiltins(globalEnv);
+    globalEnv->set("gc", GarbageCollector::makeModule());
+    globalEnv->set("sys", SysModule::makeModule());
+    globalEnv->set("tracemalloc", MemoryTracker::makeModule());
+    globalEnv->set("collections", CollectionsModule::makeModule());
+    globalEnv->set("functools", FunctoolsModule::makeModule());
+    globalEnv->set("heapq", OrderModule::makeHeapq());
+    globalEnv->set("bisect", OrderModule::makeBisect());
+    globalEnv->set("array", ArrayModule::makeModule());
+    globalEnv->set("vecmath", VecMathModule::makeModule());
+    globalEnv->set("asyncio", AsyncioModule::makeModule());
+    globalEnv->set("time", TimeModule::makeTime());
+    globalEnv->set("timeit", TimeModule::makeTimeit());
+    globalEnv->set("sharedmem", SharedMemoryModule::makeModule());
+    globalEnv->set("parallel_map", ParallelMap::makeBuiltin());
+
+    context.objectClass = std::make_shared<ClassValue>("object");
+
+    context.objectClass->name = "object";
+
+    globalEnv->set("object", Value(context.objectClass));
+
+    context.objectClass->setAttribute("__getattribute__", globalEnv->get("__object_getattribute__"));
+
+    context.objectClass->setAttribute("__setattr__", globalEnv->get("__object_setattr__"));
+
+    PyException::registerClasses(globalEnv);
+
+    // binascii.Error — класс из иерархии исключений, поэтому модули создаются после неё
+    globalEnv->set("binascii", CodecModule::makeBinascii());
+    globalEnv->set("base64", CodecModule::makeBase64());
+    globalEnv->set("struct", StructModule::makeModule());
+    globalEnv->set("json", JsonModule::makeModule());
+    globalEnv->set("marshal", MarshalModule::makeModule());
+    globalEnv->set("re", RegexModule::makeModule());
+    globalEnv->set("io", IoModule::makeModule(globalEnv->get("open")));
+
+
+
+    context.strClass = std::make_shared<ClassValue>("str");
+    context.strClass->name = "str";
+    context.strClass->bases.push_back(context.objectClass);
+    context.strClass->construct = constructStr;
+
+    auto builtin = std::get<Value::BuiltinFunctionPtr>(makeMakeTransStrClassBuiltin().data);
+
+    context.strClass->setAttribute("maketrans", makeMakeTransStrClassBuiltin());
+
+    globalEnv->set("str", Value(context.strClass));
+
+    context.strClass->setAttribute("__call__", globalEnv->get("__str_call__"));
+
+    globalEnv->set("__str_type__", Value(context.strClass));
+
+
+
+    context.bytesClass = std::make_shared<ClassValue>("bytes");
+    context.bytesClass->name = "bytes";
+    context.bytesClass->bases.push_back(context.objectClass);
+    context.bytesClass->construct = constructBytes;
+
+    context.bytesClass->setAttribute("fromhex", makeFromHexClassBuiltin());
+    context.bytesClass->setAttribute("maketrans", makeMakeTransBytesClassBuiltin());
+    context.bytesClass->setAttribute("__bytes__", make__bytes__ClassBuiltin());
+
+    globalEnv->set("bytes", Value(context.bytesClass));
+    context.bytesClass->setAttribute("__call__", globalEnv->get("__bytes_call__"));
+    globalEnv->set("__bytes_type__", Value(context.bytesClass));
+
+
+    context.bytearrayClass = std::make_shared<ClassValue>("bytearray");
+    context.bytearrayClass->name = "bytearray";
+    context.bytearrayClass->bases.push_back(context.objectClass);
+    context.bytearrayClass->construct = constructByteArray;
+
+    globalEnv->set("bytearray", Value(context.bytearrayClass));
+    context.bytearrayClass->setAttribute("__call__", globalEnv->get("__bytearray_call__"));
+    globalEnv->set("__bytearray_type__", Value(context.bytearrayClass));
+    context.bytearrayClass->setAttribute("__bytes__", make_byteArray_ClassBuiltin());
+    context.bytearrayClass->setAttribute("fromhex", makeByteArrayFromHexBuiltin());
+    context.bytearrayClass->setAttribute("maketrans", makeByteArrayMakeTransBuiltin());
+
+    return globalEnv;
+}
+
+/**
+ * Выполняет исходный файл как модуль `__main__`. Токены читает ModuleLoader::readTokens:
+ * из TokenCache, если кэш соответствует файлу, иначе лексером с записью в кэш.
+ * Каталог файла становится первым каталогом `sys.path` для `import`. Исходник
+ * разбирается один раз, и все инструкции верхнего уровня компилируются в один
+ * байткод. Приглашения REPL не выводятся,
+ * результаты инструкций-выражений не печатаются. Сообщение об ошибке выводится
+ * в стандартный поток ошибок.
+ *
+ * @param path Путь к исходному файлу.
+ * @return Код завершения процесса: 0 при успехе, 1 при ошибке.
+ */
+int Interpreter::runFile(const QString& path) {
+
+    QFile file(path);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::cerr << "cppython: can't open file '" << path.toStdString() << "': "
+                  << file.errorString().toStdString() << "\n";
+        return 2;
+    }
+
+    Compiler::echoResults = false;
+
+    ModuleLoader::initialize(createGlobals(), QFileInfo(path).absolutePath());
+
+    const auto globalEnv = ModuleLoader::makeGlobals("__main__");
+    globalEnv->set("__file__", Value(QFileInfo(path).absoluteFilePath()));
+
+    // байткод модуля нужен TypeProfile::save и после исключения
+    std::shared_ptr<const CodeObject> module;
+
+    try {
+
+        const QVector<Token> tokens = ModuleLoader::readTokens(file);
+
+        file.close();
+
+        Parser parser(tokens);
+
+        TypeProfile::open(path);
+
+        module = Compiler::compileModule(parser.parseModule());
+
+        const Profiler::Frame frame("<module>");
+        const Tracer::Frame trace(*module, QFileInfo(path).absoluteFilePath());
+        VirtualMachine::run(*module, globalEnv);
+
+    } catch (const std::runtime_error& e) {
+        TypeProfile::save();
+        OutputStream::standardOutput().flush();
+        std::cerr << e.what() << "\n";
+        return 1;
     }
+
+    TypeProfile::save();
+    OutputStream::standardOutput().flush();
+
+    return 0;
 }
 
+/**
+ * Рабочий процесс parallel_map: выполняет файл модуля под именем `__mp_main__`
+ * (код под `if __name__ == "__main__":` пропускается) и передаёт его глобальные
+ * имена ParallelMap::serve. Пока модуль выполняется, parallel_map запрещён.
+ *
+ * @param path Файл модуля, в котором определена функция.
+ * @param function Имя функции в глобальных именах модуля.
+ * @param input Файл с элементами.
+ * @param output Файл для результатов.
+ * @return Код завершения процесса: 1, если модуль не выполнился.
+ */
+int Interpreter::runWorker(const QString& path, const QString& function, const QString& input, const QString& output) {
+
+    QFile file(path);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::cerr << "cppython: can't open file '" << path.toStdString() << "': "
+                  << file.errorString().toStdString() << "\n";
+        return 2;
+    }
+
+    Compiler::echoResults = false;
+
+    ModuleLoader::initialize(createGlobals(), QFileInfo(path).absolutePath());
+
+    const auto globalEnv = ModuleLoader::makeGlobals("__mp_main__");
+    globalEnv->set("__file__", Value(QFileInfo(path).absoluteFilePath()));
+
+    try {
+
+        const QVector<Token> tokens = ModuleLoader::readTokens(file);
+
+        file.close();
+
+        Parser parser(tokens);
+
+        const auto module = Compiler::compileModule(parser.parseModule());
+
+        ParallelMap::bootstrapping = true;
+        VirtualMachine::run(*module, globalEnv);
+        ParallelMap::bootstrapping = false;
+
+    } catch (const std::runtime_error& e) {
+        OutputStream::standardOutput().flush();
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return ParallelMap::serve(globalEnv, function, input, output);
+}
 
 /**
- * Запускает основной цикл интерпретатора Python. Этот метод непрерывно принимает
+ * Запускает интерпретатор. С путём к файлу в первом аргументе выполняет этот файл
+ * (runFile), без аргументов — запускает REPL. Перед путём можно указать
+ * `--profile` (таблица времени функций в stderr) или `--profile=файл` (ещё и
+ * свёрнутые стеки для flamegraph в этот файл), `--stats` (счётчики RuntimeStats
+ * в stderr при выходе), `--lineprofile` (время по строкам функций в stderr), `--tracemalloc`
+ * (живые при выходе объекты по типам и строкам создания в stderr), `--max-ticks=N` и
+ * `--max-memory=байты` (пределы ExecutionBudget для скрипта); `--worker=функция` — служебный
+ * режим рабочего процесса parallel_map (runWorker). Цикл REPL непрерывно принимает
  * пользовательский ввод, обрабатывает его с помощью лексера и парсера, вычисляет результат
  * и выводит результат вычисления или сообщение об ошибке. Цикл завершается,
  * когда пользователь вводит команды выхода, такие как "exit", "quit", "q" или "Q".
  *
  * @param argc Количество аргументов командной строки, переданных программе.
  * @param argv Массив строк аргументов командной строки.
+ * @return Код завершения процесса.
  */
-void Interpreter::run(int argc, char* argv[]) {
-    std::cout << "Hello and welcome to my minimal Python interpreter!\n"
-                 "Made by Semenov Oleg, with care from MathMech. Let's code!\n";
+int Interpreter::run(const int argc, char* argv[]) {
 
-    const auto globalEnv = std::make_shared<Environment>();
-    BuiltinFunction::registerBuiltins(globalEnv);
+    // встроенные классы этого интерпретатора; createGlobals заполняет активный контекст
+    InterpreterContext context;
+    const InterpreterContext::Scope scope(context);
 
-    Runtime::objectClass = std::make_shared<ClassValue>("object");
+    // рабочие процессы parallel_map запускают этот же файл; /proc/self/exe не зависит от PATH
+    const QFileInfo self("/proc/self/exe");
+    ParallelMap::executable = self.exists() ? self.canonicalFilePath()
+                                            : QFileInfo(QString::fromLocal8Bit(argv[0])).absoluteFilePath();
 
-    Runtime::objectClass->name = "object";
+    int arg = 1;
+    ExecutionBudget::Limits limits;
 
-    globalEnv->set("object", Value(Runtime::objectClass));
+    while (arg < argc && std::string_view(argv[arg]).substr(0, 2) == "--") {
 
-    Runtime::objectClass->attributes["__getattribute__"] =
-    globalEnv->get("__object_getattribute__");
+        const std::string_view option(argv[arg++]);
 
-    Runtime::objectClass->attributes["__setattr__"] =
-    globalEnv->get("__object_setattr__");
+        if (option == "--stats") {
+            RuntimeStats::dumpOnExit = true;
+            continue;
+        }
 
+        if (option == "--lineprofile") {
+            Tracer::startLineProfile();
+            continue;
+        }
 
+        // рабочий процесс parallel_map: за опцией следуют файл модуля, файл элементов и файл результатов
+        if (option.substr(0, 9) == "--worker=") {
 
-    Runtime::strClass = std::make_shared<ClassValue>("str");
-    Runtime::strClass->name = "str";
-    Runtime::strClass->bases.push_back(Runtime::objectClass);
+            if (argc - arg != 3) {
+                std::cerr << "cppython: --worker expects a module file, an input file and an output file\n";
+                return 2;
+            }
 
-    auto builtin = std::get<Value::BuiltinFunctionPtr>(makeMakeTransStrClassBuiltin().data);
+            return runWorker(QString::fromLocal8Bit(argv[arg]), QString::fromLocal8Bit(option.substr(9).data()),
+                             QString::fromLocal8Bit(argv[arg + 1]), QString::fromLocal8Bit(argv[arg + 2]));
+        }
+
+        if (option == "--tracemalloc") {
+            MemoryTracker::start();
+            MemoryTracker::reportOnExit = true;
+            continue;
+        }
+
+        if (option.substr(0, 12) == "--max-ticks=" || option.substr(0, 13) == "--max-memory=") {
+
+            const std::size_t eq = option.find('=');
+            bool ok = false;
+            const qlonglong value = QByteArray(option.data() + eq + 1,
+                                               static_cast<qsizetype>(option.size() - eq - 1)).toLongLong(&ok);
+
+            if (!ok || value <= 0) {
+                std::cerr << "cppython: " << option.substr(0, eq) << " expects a positive integer\n";
+                return 2;
+            }
+
+            if (option[6] == 't') {
+                limits.ticks = value;
+            } else {
+                limits.memory = static_cast<std::uint64_t>(value);
+            }
+            continue;
+        }
 
-    Runtime::strClass->attributes["maketrans"] = makeMakeTransStrClassBuiltin();
+        if (option.substr(0, 9) != "--profile" || (option.size() > 9 && option[9] != '=')) {
+            std::cerr << "cppython: unknown option '" << option << "'\n";
+            return 2;
+        }
 
-    globalEnv->set("str", Value(Runtime::strClass));
+        Profiler::start(option.size() > 10 ? QString::fromLocal8Bit(option.substr(10).data()) : QString());
+    }
 
-    Runtime::strClass->attributes["__call__"] = globalEnv->get("__str_call__");
+    const auto reportAtExit = [] {
+        if (Profiler::enabled) {
+            Profiler::report();
+        }
 
-    globalEnv->set("__str_type__", Value(Runtime::strClass));
+        if (RuntimeStats::dumpOnExit) {
+            RuntimeStats::report();
+        }
 
+        Tracer::reportLineProfile();
 
+        if (MemoryTracker::reportOnExit) {
+            MemoryTracker::report();
+        }
+    };
 
-    Runtime::bytesClass = std::make_shared<ClassValue>("bytes");
-    Runtime::bytesClass->name = "bytes";
-    Runtime::bytesClass->bases.push_back(Runtime::objectClass);
+    if (arg < argc) {
 
-    Runtime::bytesClass->attributes["fromhex"] = makeFromHexClassBuiltin();
-    Runtime::bytesClass->attributes["maketrans"] = makeMakeTransBytesClassBuiltin();
-    Runtime::bytesClass->attributes["__bytes__"] = make__bytes__ClassBuiltin();
+        int status;
 
-    globalEnv->set("bytes", Value(Runtime::bytesClass));
-    Runtime::bytesClass->attributes["__call__"] = globalEnv->get("__bytes_call__");
-    globalEnv->set("__bytes_type__", Value(Runtime::bytesClass));
+        {
+            const ExecutionBudget::Scope budget(limits);
+            status = runFile(QString::fromLocal8Bit(argv[arg]));
 
+            // скрипт мог поймать ошибку превышения и завершиться сам
+            try {
+                ExecutionBudget::check();
+            } catch (const std::runtime_error& e) {
+                std::cerr << e.what() << "\n";
+                status = 1;
+            }
+        }
 
-    Runtime::bytearrayClass = std::make_shared<ClassValue>("bytearray");
-    Runtime::bytearrayClass->name = "bytearray";
-    Runtime::bytearrayClass->bases.push_back(Runtime::objectClass);
+        reportAtExit();
 
-    globalEnv->set("bytearray", Value(Runtime::bytearrayClass));
-    Runtime::bytearrayClass->attributes["__call__"] = globalEnv->get("__bytearray_call__");
-    globalEnv->set("__bytearray_type__", Value(Runtime::bytearrayClass));
-    Runtime::bytearrayClass->attributes["__bytes__"] = make_byteArray_ClassBuiltin();
-    Runtime::bytearrayClass->attributes["fromhex"] = makeByteArrayFromHexBuiltin();
-    Runtime::bytearrayClass->attributes["maketrans"] = makeByteArrayMakeTransBuiltin();
+        return status;
+    }
+
+    OutputStream& out = OutputStream::standardOutput();
+
+    out.write(std::string_view("Hello and welcome to my minimal Python interpreter!\n"
+                               "Made by Semenov Oleg, with care from MathMech. Let's code!\n"));
+
+    ModuleLoader::initialize(createGlobals(), "");
+
+    const auto globalEnv = ModuleLoader::makeGlobals("__main__");
 
     Lexer lexer;
     std::vector<std::string> buffer;
     bool isInBlock = false;
 
     while (true) {
-        std::cout << (isInBlock ? CONTINUATION_PROMPT : MAIN_PROMPT);
+        // приглашение без перевода строки: буфер сбрасывается перед чтением ввода
+        out.write(std::string_view(isInBlock ? CONTINUATION_PROMPT : MAIN_PROMPT));
+        out.flush();
 
         std::string line;
         if (!std::getline(std::cin, line)) break;
@@ -198,4 +522,9 @@ void Interpreter::run(int argc, char* argv[]) {
         executeCode(code, lexer, globalEnv);
         buffer.clear();
     }
-}
\ No newline at end of file
+
+    out.flush();
+    reportAtExit();
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "InterpreterContext.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "ClassValue.h"
+
+namespace {
+
+    thread_local InterpreterContext* active = nullptr;
+
+    /// вложенность Scope в этом потоке
+    thread_local int depth = 0;
+
+    /// поток, в котором сейчас выполняются интерпретаторы; пустой id — ни в каком
+    std::atomic<std::thread::id> owner{};
+}
+
+InterpreterContext& InterpreterContext::current() {
+
+    if (active) {
+        return *active;
+    }
+
+    // код вне Interpreter::run (бенчмарки, встраивание без Scope) работает с контекстом потока
+    thread_local InterpreterContext fallback;
+
+    return fallback;
+}
+
+void InterpreterContext::reset() {
+    objectClass.reset();
+    strClass.reset();
+    bytesClass.reset();
+    bytearrayClass.reset();
+    baseExceptionClass.reset();
+    exceptionClasses.clear();
+}
+
+InterpreterContext::Scope::Scope(InterpreterContext& context) : previous(active) {
+
+    if (depth == 0) {
+
+        std::thread::id expected{};
+
+        // общее состояние рантайма без блокировок: второй поток ждал бы гонки, а не ошибки
+        if (!owner.compare_exchange_strong(expected, std::this_thread::get_id(), std::memory_order_acquire)) {
+            throw std::runtime_error("RuntimeError: the interpreter is already running in another thread");
+        }
+    }
+
+    ++depth;
+    active = &context;
+}
+
+InterpreterContext::Scope::~Scope() {
+
+    active = previous;
+
+    if (--depth == 0) {
+        owner.store(std::thread::id(), std::memory_order_release);
+    }
+}
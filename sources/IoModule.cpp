@@ -0,0 +1,93 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "IoModule.h"
+
+#include <algorithm>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "InterpreterContext.h"
+#include "MemoryIOValue.h"
+#include "MemoryViewValue.h"
+#include "StrValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    /// начальное значение: единственный позиционный аргумент или аргумент с именем name
+    const Value* initialValue(const std::vector<Value>& args, const Kwargs& kwargs,
+                              const char* function, const char* name) {
+
+        expectArgsRange(args, 0, 1, function);
+
+        const Value* initial = args.empty() ? nullptr : &args[0];
+
+        for (const auto& [key, value] : kwargs) {
+
+            if (key != name || initial) {
+                throw std::runtime_error(
+                    std::string("TypeError: ") + function + "() got an unexpected keyword argument '" + key.toStdString() + "'");
+            }
+
+            initial = &value;
+        }
+
+        return initial && !initial->isNone() ? initial : nullptr;
+    }
+}
+
+Value IoModule::makeModule(const Value& open) {
+
+    const auto module = std::make_shared<ClassValue>("io");
+
+    module->setAttribute("StringIO", makeBuiltin(
+        "StringIO",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            const Value* initial = initialValue(args, kwargs, "StringIO", "initial_value");
+
+            if (initial && !initial->isString()) {
+                throw std::runtime_error(
+                    "TypeError: initial_value must be str or None, not " + typeName(*initial).toStdString());
+            }
+
+            QString text = initial ? initial->asString()->text() : QString();
+
+            return Value(std::static_pointer_cast<IteratorValue>(std::make_shared<StringIOValue>(std::move(text))));
+        }
+    ));
+
+    module->setAttribute("BytesIO", makeBuiltin(
+        "BytesIO",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            const Value* initial = initialValue(args, kwargs, "BytesIO", "initial_bytes");
+            QByteArray bytes;
+
+            if (!initial) {
+            } else if (initial->isBytes()) {
+                bytes = initial->asBytes()->bytes();
+            } else if (initial->isByteArray()) {
+                bytes = initial->asByteArray()->bytes();
+            } else if (const MemoryViewValue* view = MemoryViewValue::of(*initial)) {
+                bytes = view->toBytes();
+            } else {
+                throw std::runtime_error(
+                    "TypeError: a bytes-like object is required, not '" + typeName(*initial).toStdString() + "'");
+            }
+
+            // копия bytearray отделяется при первой записи; bytes разделяют буфер до неё же
+            return Value(std::static_pointer_cast<IteratorValue>(std::make_shared<BytesIOValue>(std::move(bytes))));
+        }
+    ));
+
+    module->setAttribute("open", open);
+    module->setAttribute("UnsupportedOperation",
+                         Value(InterpreterContext::current().exceptionClasses.value("UnsupportedOperation")));
+
+    return Value(module);
+}
@@ -0,0 +1,668 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "JsonCodec.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#include <QHash>
+
+#include "BigIntText.h"
+#include "ClassUtils.h"
+#include "DictValue.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "RecursionLimit.h"
+#include "StrValue.h"
+#include "StringTable.h"
+#include "TupleValue.h"
+
+namespace jsoncodec {
+
+    namespace {
+
+        /// столько десятичных цифр всегда помещается в SmallInt
+        constexpr qsizetype smallDigits = 18;
+
+        bool isDigit(const char16_t ch) {
+            return ch >= '0' && ch <= '9';
+        }
+
+        int hexDigit(const char16_t ch) {
+
+            if (isDigit(ch)) return ch - '0';
+            if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+            if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+
+            return -1;
+        }
+
+        class Parser {
+        public:
+            Parser(const QStringView text, const Value& objectHook, const std::shared_ptr<Environment>& env)
+                : text(text), objectHook(objectHook), env(env) {}
+
+            Value document() {
+
+                skipSpace();
+                Value value = parseValue();
+                skipSpace();
+
+                if (pos != text.size()) {
+                    fail("Extra data", pos);
+                }
+
+                return value;
+            }
+
+        private:
+            QStringView text;
+            qsizetype pos = 0;
+            const Value& objectHook;
+            const std::shared_ptr<Environment>& env;
+
+            /// ключи без escape-последовательностей: представление указывает в text
+            QHash<QStringView, Value::StrPtr> keys;
+
+            /// сообщение и позиция в том же виде, что у JSONDecodeError в CPython
+            [[noreturn]] void fail(const char* message, const qsizetype at) const {
+
+                const QStringView before = text.left(at);
+                const qsizetype line = before.count(u'\n') + 1;
+                const qsizetype column = at - before.lastIndexOf(u'\n');
+
+                throw std::runtime_error(
+                    std::string("json.JSONDecodeError: ") + message + ": line " + std::to_string(line) +
+                    " column " + std::to_string(column) + " (char " + std::to_string(at) + ")");
+            }
+
+            [[nodiscard]] char16_t peek() const {
+                return pos < text.size() ? text[pos].unicode() : u'\0';
+            }
+
+            void skipSpace() {
+
+                while (pos < text.size()) {
+
+                    const char16_t ch = text[pos].unicode();
+
+                    if (ch != ' ' && ch != '\t' && ch != '\n' && ch != '\r') {
+                        return;
+                    }
+
+                    ++pos;
+                }
+            }
+
+            bool consume(const QStringView word) {
+
+                if (!text.mid(pos).startsWith(word)) {
+                    return false;
+                }
+
+                pos += word.size();
+                return true;
+            }
+
+            Value parseValue() {
+
+                switch (peek()) {
+
+                    case '"': {
+                        QString decoded;
+                        const QStringView str = scanString(decoded);
+                        return Value(makePooled<StrValue>(str.data() == decoded.data() ? decoded : str.toString()));
+                    }
+
+                    case '{':
+                        return parseObject();
+
+                    case '[':
+                        return parseArray();
+
+                    case 't':
+                        if (consume(u"true")) return Value(true);
+                        break;
+
+                    case 'f':
+                        if (consume(u"false")) return Value(false);
+                        break;
+
+                    case 'n':
+                        if (consume(u"null")) return {};
+                        break;
+
+                    case 'N':
+                        if (consume(u"NaN")) return Value(Value::Float(std::nan("")));
+                        break;
+
+                    case 'I':
+                        if (consume(u"Infinity")) return Value(Value::Float(HUGE_VAL));
+                        break;
+
+                    case '-':
+                        if (consume(u"-Infinity")) return Value(Value::Float(-HUGE_VAL));
+                        return parseNumber();
+
+                    default:
+                        if (isDigit(peek())) return parseNumber();
+                        break;
+                }
+
+                fail("Expecting value", pos);
+            }
+
+            /**
+             * Строка с открывающей кавычкой в pos. Без escape-последовательностей
+             * возвращается представление исходного текста, иначе текст собирается в decoded.
+             */
+            QStringView scanString(QString& decoded) {
+
+                const qsizetype quote = pos++;
+                qsizetype run = pos;
+                bool escaped = false;
+
+                for (;;) {
+
+                    while (pos < text.size()) {
+
+                        const char16_t ch = text[pos].unicode();
+
+                        if (ch == '"' || ch == '\\' || ch < 0x20) {
+                            break;
+                        }
+
+                        ++pos;
+                    }
+
+                    if (pos >= text.size()) {
+                        fail("Unterminated string starting at", quote);
+                    }
+
+                    const char16_t ch = text[pos].unicode();
+
+                    if (ch == '"' && !escaped) {
+                        return text.mid(run, pos++ - run);
+                    }
+
+                    decoded.append(text.mid(run, pos - run));
+
+                    if (ch == '"') {
+                        ++pos;
+                        return decoded;
+                    }
+
+                    if (ch < 0x20) {
+                        fail("Invalid control character at", pos);
+                    }
+
+                    appendEscape(decoded);
+                    escaped = true;
+                    run = pos;
+                }
+            }
+
+            /// escape-последовательность с обратной косой чертой в pos
+            void appendEscape(QString& decoded) {
+
+                const qsizetype backslash = pos++;
+
+                if (pos >= text.size()) {
+                    fail("Unterminated string starting at", backslash);
+                }
+
+                switch (text[pos++].unicode()) {
+                    case '"':  decoded.append(u'"'); return;
+                    case '\\': decoded.append(u'\\'); return;
+                    case '/':  decoded.append(u'/'); return;
+                    case 'b':  decoded.append(u'\b'); return;
+                    case 'f':  decoded.append(u'\f'); return;
+                    case 'n':  decoded.append(u'\n'); return;
+                    case 'r':  decoded.append(u'\r'); return;
+                    case 't':  decoded.append(u'\t'); return;
+                    case 'u':  break;
+                    default:   fail("Invalid \\escape", backslash);
+                }
+
+                // суррогатная пара — две последовательности \uXXXX, в UTF-16 они записываются как есть
+                char16_t unit = 0;
+
+                for (int i = 0; i < 4; ++i, ++pos) {
+
+                    const int digit = pos < text.size() ? hexDigit(text[pos].unicode()) : -1;
+
+                    if (digit < 0) {
+                        fail("Invalid \\uXXXX escape", backslash + 1);
+                    }
+
+                    unit = static_cast<char16_t>(unit << 4 | digit);
+                }
+
+                decoded.append(QChar(unit));
+            }
+
+            /// ключ объекта: повторяющиеся ключи документа разделяют один объект str
+            Value parseKey() {
+
+                QString decoded;
+                const QStringView key = scanString(decoded);
+
+                if (key.data() == decoded.data()) {
+                    return Value(makePooled<StrValue>(decoded));
+                }
+
+                if (const auto it = keys.constFind(key); it != keys.cend()) {
+                    return Value(it.value());
+                }
+
+                const QString name = key.toString();
+                const Value::StrPtr str = StringTable::isInternable(name)
+                    ? StringTable::internStr(name)
+                    : makePooled<StrValue>(name);
+
+                keys.insert(key, str);
+
+                return Value(str);
+            }
+
+            Value parseNumber() {
+
+                const qsizetype start = pos;
+                bool integral = true;
+
+                if (peek() == '-') {
+                    ++pos;
+                }
+
+                if (peek() == '0') {
+                    ++pos;
+                } else if (isDigit(peek())) {
+                    while (isDigit(peek())) ++pos;
+                } else {
+                    fail("Expecting value", start);
+                }
+
+                if (peek() == '.' && pos + 1 < text.size() && isDigit(text[pos + 1].unicode())) {
+
+                    integral = false;
+                    pos += 2;
+
+                    while (isDigit(peek())) ++pos;
+                }
+
+                if (peek() == 'e' || peek() == 'E') {
+
+                    qsizetype exponent = pos + 1;
+
+                    if (exponent < text.size() && (text[exponent] == '+' || text[exponent] == '-')) {
+                        ++exponent;
+                    }
+
+                    if (exponent < text.size() && isDigit(text[exponent].unicode())) {
+
+                        integral = false;
+                        pos = exponent;
+
+                        while (isDigit(peek())) ++pos;
+                    }
+                }
+
+                const QStringView digits = text.mid(start, pos - start);
+
+                if (!integral) {
+                    return Value(Value::Float(std::strtod(digits.toLatin1().constData(), nullptr)));
+                }
+
+                const bool negative = digits.front() == '-';
+
+                if (digits.size() - negative > smallDigits) {
+                    return Value(BigIntText::fromString(digits.toLatin1().toStdString()));
+                }
+
+                Value::SmallInt number = 0;
+
+                for (const QChar ch : digits.mid(negative)) {
+                    number = number * 10 + (ch.unicode() - '0');
+                }
+
+                return Value(Value::SmallInt(negative ? -number : number));
+            }
+
+            Value parseObject() {
+
+                RecursionLimit::Guard depth;
+
+                ++pos;
+                skipSpace();
+
+                const auto dict = std::make_shared<DictValue>();
+
+                if (peek() == '}') {
+                    ++pos;
+                    return finishObject(dict);
+                }
+
+                for (;;) {
+
+                    if (peek() != '"') {
+                        fail("Expecting property name enclosed in double quotes", pos);
+                    }
+
+                    Value key = parseKey();
+                    skipSpace();
+
+                    if (peek() != ':') {
+                        fail("Expecting ':' delimiter", pos);
+                    }
+
+                    ++pos;
+                    skipSpace();
+
+                    dict->setItem(key, parseValue());
+                    skipSpace();
+
+                    if (peek() == '}') {
+                        ++pos;
+                        return finishObject(dict);
+                    }
+
+                    if (peek() != ',') {
+                        fail("Expecting ',' delimiter", pos);
+                    }
+
+                    ++pos;
+                    skipSpace();
+                }
+            }
+
+            Value finishObject(const std::shared_ptr<DictValue>& dict) {
+
+                if (objectHook.isNone()) {
+                    return Value(dict);
+                }
+
+                return call(objectHook, {Value(dict)}, {}, env);
+            }
+
+            Value parseArray() {
+
+                RecursionLimit::Guard depth;
+
+                ++pos;
+                skipSpace();
+
+                const auto list = makePooled<ListValue>();
+
+                if (peek() == ']') {
+                    ++pos;
+                    return Value(list);
+                }
+
+                for (;;) {
+
+                    list->elements.push_back(parseValue());
+                    skipSpace();
+
+                    if (peek() == ']') {
+                        ++pos;
+                        return Value(list);
+                    }
+
+                    if (peek() != ',') {
+                        fail("Expecting ',' delimiter", pos);
+                    }
+
+                    ++pos;
+                    skipSpace();
+                }
+            }
+        };
+
+        class Writer {
+        public:
+            Writer(const DumpOptions& options, QString& out, const std::shared_ptr<Environment>& env)
+                : options(options), out(out), env(env) {}
+
+            void write(const Value& value, const int depth) {
+
+                if (value.isNone()) {
+                    out.append(u"null");
+                } else if (value.isBool()) {
+                    out.append(value.toBool() ? u"true" : u"false");
+                } else if (const auto* small = std::get_if<Value::SmallInt>(&value.data)) {
+                    writeInteger(*small);
+                } else if (value.isBigInt()) {
+                    const std::string digits = BigIntText::toString(value.toBigInt());
+                    out.append(QLatin1String(digits.data(), static_cast<qsizetype>(digits.size())));
+                } else if (value.isDouble()) {
+                    writeFloat(value.toDouble());
+                } else if (value.isString()) {
+                    writeString(value.asString()->view());
+                } else if (const auto* list = std::get_if<Value::ListPtr>(&value.data)) {
+                    writeArray((*list)->elements.get(), list->get(), depth);
+                } else if (const auto* tuple = std::get_if<Value::TuplePtr>(&value.data)) {
+                    writeArray((*tuple)->items, tuple->get(), depth);
+                } else if (const auto* dict = std::get_if<Value::DictPtr>(&value.data)) {
+                    writeObject(**dict, depth);
+                } else if (!options.fallback.isNone()) {
+                    RecursionLimit::Guard guard;
+                    write(call(options.fallback, {value}, {}, env), depth);
+                } else {
+                    throw std::runtime_error(
+                        "TypeError: Object of type " + typeName(value).toStdString() + " is not JSON serializable");
+                }
+            }
+
+        private:
+            const DumpOptions& options;
+            QString& out;
+            const std::shared_ptr<Environment>& env;
+
+            /// контейнеры, которые сейчас записываются: повторное вхождение — цикл
+            std::vector<const void*> open;
+
+            class Marker {
+            public:
+                Marker(std::vector<const void*>& open, const void* container) : open(open) {
+
+                    if (std::find(open.begin(), open.end(), container) != open.end()) {
+                        throw std::runtime_error("ValueError: Circular reference detected");
+                    }
+
+                    open.push_back(container);
+                }
+
+                ~Marker() { open.pop_back(); }
+
+                Marker(const Marker&) = delete;
+                Marker& operator=(const Marker&) = delete;
+
+            private:
+                std::vector<const void*>& open;
+                RecursionLimit::Guard depth;
+            };
+
+            void newline(const int depth) {
+
+                if (!options.indent) {
+                    return;
+                }
+
+                out.append(u'\n');
+
+                for (int i = 0; i < depth; ++i) {
+                    out.append(*options.indent);
+                }
+            }
+
+            void writeInteger(const Value::SmallInt number) {
+
+                char buffer[24];
+                const auto [end, error] = std::to_chars(buffer, buffer + sizeof buffer, number);
+
+                out.append(QLatin1String(buffer, static_cast<qsizetype>(end - buffer)));
+            }
+
+            void writeFloat(const Value::Float number) {
+
+                if (std::isfinite(number)) {
+                    out.append(Value::formatDouble(number));
+                    return;
+                }
+
+                if (!options.allowNan) {
+                    throw std::runtime_error("ValueError: Out of range float values are not JSON compliant");
+                }
+
+                out.append(std::isnan(number) ? u"NaN" : number > 0 ? u"Infinity" : u"-Infinity");
+            }
+
+            void writeString(const QStringView text) {
+
+                out.append(u'"');
+
+                qsizetype run = 0;
+
+                for (qsizetype i = 0; i < text.size(); ++i) {
+
+                    const char16_t ch = text[i].unicode();
+
+                    if (ch >= 0x20 && ch != '"' && ch != '\\' && (ch < 0x7f || !options.ensureAscii)) {
+                        continue;
+                    }
+
+                    out.append(text.mid(run, i - run));
+                    run = i + 1;
+
+                    switch (ch) {
+                        case '"':  out.append(u"\\\""); break;
+                        case '\\': out.append(u"\\\\"); break;
+                        case '\n': out.append(u"\\n"); break;
+                        case '\r': out.append(u"\\r"); break;
+                        case '\t': out.append(u"\\t"); break;
+                        case '\b': out.append(u"\\b"); break;
+                        case '\f': out.append(u"\\f"); break;
+                        default: {
+                            static constexpr char hex[] = "0123456789abcdef";
+                            const char escape[] = {'\\', 'u', hex[ch >> 12], hex[ch >> 8 & 0xf],
+                                                   hex[ch >> 4 & 0xf], hex[ch & 0xf]};
+                            out.append(QLatin1String(escape, sizeof escape));
+                        }
+                    }
+                }
+
+                out.append(text.mid(run));
+                out.append(u'"');
+            }
+
+            void writeArray(const std::vector<Value>& items, const void* container, const int depth) {
+
+                if (items.empty()) {
+                    out.append(u"[]");
+                    return;
+                }
+
+                Marker marker(open, container);
+
+                out.append(u'[');
+
+                for (std::size_t i = 0; i < items.size(); ++i) {
+
+                    if (i > 0) {
+                        out.append(options.itemSeparator);
+                    }
+
+                    newline(depth + 1);
+                    write(items[i], depth + 1);
+                }
+
+                newline(depth);
+                out.append(u']');
+            }
+
+            /// ключ объекта как строка JSON; false — ключ пропускается (skipkeys)
+            bool writeKey(const Value& key) {
+
+                if (key.isString()) {
+                    writeString(key.asString()->view());
+                    return true;
+                }
+
+                if (key.isNone() || key.isBool() || key.isBigInt() || key.isDouble()) {
+
+                    out.append(u'"');
+                    write(key, 0);
+                    out.append(u'"');
+
+                    return true;
+                }
+
+                if (options.skipKeys) {
+                    return false;
+                }
+
+                throw std::runtime_error(
+                    "TypeError: keys must be str, int, float, bool or None, not " + typeName(key).toStdString());
+            }
+
+            void writeObject(const DictValue& dict, const int depth) {
+
+                if (dict.len() == 0) {
+                    out.append(u"{}");
+                    return;
+                }
+
+                Marker marker(open, &dict);
+
+                std::vector<std::pair<Value, Value>> items;
+                items.reserve(dict.len());
+
+                dict.forEachItem([&items](const Value& key, const Value& value) {
+                    items.emplace_back(key, value);
+                });
+
+                if (options.sortKeys) {
+                    std::stable_sort(items.begin(), items.end(),
+                                     [](const auto& a, const auto& b) { return a.first < b.first; });
+                }
+
+                out.append(u'{');
+
+                bool first = true;
+
+                for (const auto& [key, value] : items) {
+
+                    const qsizetype mark = out.size();
+
+                    if (!first) {
+                        out.append(options.itemSeparator);
+                    }
+
+                    newline(depth + 1);
+
+                    if (!writeKey(key)) {
+                        out.truncate(mark);
+                        continue;
+                    }
+
+                    first = false;
+                    out.append(options.keySeparator);
+                    write(value, depth + 1);
+                }
+
+                newline(depth);
+                out.append(u'}');
+            }
+        };
+    }
+
+    Value parse(const QStringView text, const Value& objectHook, const std::shared_ptr<Environment>& env) {
+        return Parser(text, objectHook, env).document();
+    }
+
+    void dump(const Value& value, const DumpOptions& options, QString& out, const std::shared_ptr<Environment>& env) {
+        Writer(options, out, env).write(value, 0);
+    }
+}
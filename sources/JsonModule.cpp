@@ -0,0 +1,173 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "JsonModule.h"
+
+#include <algorithm>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "InterpreterContext.h"
+#include "JsonCodec.h"
+#include "StrValue.h"
+#include "TextCodec.h"
+#include "TupleValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    /// bytes для loads читаются как строгий UTF-8
+    QString utf8(const QByteArray& data) {
+        return textcodec::decode(data, textcodec::Codec::Utf8, textcodec::Errors::Strict);
+    }
+
+    Value loads(const Value& source, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) {
+
+        Value objectHook;
+
+        for (const auto& [name, value] : kwargs) {
+
+            if (name != "object_hook") {
+                throw std::runtime_error(
+                    "TypeError: loads() got an unexpected keyword argument '" + name.toStdString() + "'");
+            }
+
+            objectHook = value;
+        }
+
+        // текст str разбирается на месте, без копии
+        if (source.isString()) {
+            return jsoncodec::parse(source.asString()->view(), objectHook, env);
+        }
+
+        if (source.isBytes()) {
+            return jsoncodec::parse(utf8(source.asBytes()->bytes()), objectHook, env);
+        }
+
+        if (source.isByteArray()) {
+            return jsoncodec::parse(utf8(source.asByteArray()->bytes()), objectHook, env);
+        }
+
+        throw std::runtime_error(
+            "TypeError: the JSON object must be str, bytes or bytearray, not " + typeName(source).toStdString());
+    }
+
+    jsoncodec::DumpOptions dumpOptions(const Kwargs& kwargs, const char* function) {
+
+        jsoncodec::DumpOptions options;
+        bool customSeparators = false;
+
+        for (const auto& [name, value] : kwargs) {
+
+            if (name == "indent") {
+
+                if (value.isBigInt()) {
+                    options.indent = QString(std::max<qsizetype>(value.toBigInt().convert_to<qsizetype>(), 0), ' ');
+                } else if (value.isString()) {
+                    options.indent = value.asString()->toString();
+                } else if (!value.isNone()) {
+                    throw std::runtime_error("TypeError: indent must be an int or a str, not " + typeName(value).toStdString());
+                }
+
+            } else if (name == "separators") {
+
+                if (value.isNone()) {
+                    continue;
+                }
+
+                const auto* pair = std::get_if<Value::TuplePtr>(&value.data);
+
+                if (!pair || (*pair)->items.size() != 2 || !(*pair)->items[0].isString() || !(*pair)->items[1].isString()) {
+                    throw std::runtime_error("TypeError: separators must be a (item_separator, key_separator) tuple of str");
+                }
+
+                options.itemSeparator = (*pair)->items[0].asString()->toString();
+                options.keySeparator = (*pair)->items[1].asString()->toString();
+                customSeparators = true;
+
+            } else if (name == "sort_keys") {
+                options.sortKeys = value.toBool();
+            } else if (name == "ensure_ascii") {
+                options.ensureAscii = value.toBool();
+            } else if (name == "allow_nan") {
+                options.allowNan = value.toBool();
+            } else if (name == "skipkeys") {
+                options.skipKeys = value.toBool();
+            } else if (name == "default") {
+                options.fallback = value;
+            } else if (name != "check_circular") {
+                throw std::runtime_error(
+                    std::string("TypeError: ") + function + "() got an unexpected keyword argument '" + name.toStdString() + "'");
+            }
+        }
+
+        // с отступом запятая в конце строки не оставляет пробела
+        if (options.indent && !customSeparators) {
+            options.itemSeparator = ",";
+        }
+
+        return options;
+    }
+
+    QString dumps(const Value& value, const Kwargs& kwargs, const char* function, const std::shared_ptr<Environment>& env) {
+
+        QString out;
+        jsoncodec::dump(value, dumpOptions(kwargs, function), out, env);
+
+        return out;
+    }
+}
+
+Value JsonModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("json");
+
+    module->setAttribute("loads", makeBuiltin(
+        "loads",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgs(args, 1, "loads");
+
+            return loads(args[0], kwargs, env);
+        }
+    ));
+
+    module->setAttribute("load", makeBuiltin(
+        "load",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgs(args, 1, "load");
+
+            return loads(callMethod(args[0], "read", {}, {}, env), kwargs, env);
+        }
+    ));
+
+    module->setAttribute("dumps", makeBuiltin(
+        "dumps",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgs(args, 1, "dumps");
+
+            return Value(dumps(args[0], kwargs, "dumps", env));
+        }
+    ));
+
+    module->setAttribute("dump", makeBuiltin(
+        "dump",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgs(args, 2, "dump");
+
+            callMethod(args[1], "write", {Value(dumps(args[0], kwargs, "dump", env))}, {}, env);
+
+            return {};
+        }
+    ));
+
+    module->setAttribute("JSONDecodeError", Value(InterpreterContext::current().exceptionClasses.value("JSONDecodeError")));
+
+    return Value(module);
+}
@@ -1,150 +1,337 @@
 #include "Lexer.h"
 
+#include <array>
+#include <map>
+#include <string>
+
+#include "StringTable.h"
+
+namespace {
+
+/**
+ * Готовое значение токена-слова: тип, общий буфер строки и ключевое слово.
+ * Повторные вхождения имени копируют только QString (счётчик ссылок).
+ */
+struct WordAtom {
+    TokenType type;
+    QString value;
+    std::optional<Keyword> keyword;
+};
+
+/**
+ * Таблица слов, уже встреченных лексером. Ключ — байты UTF-8, поиск по string_view
+ * (std::less<>) не создаёт временных строк. Ключевые слова, True/False/None
+ * внесены заранее, имена добавляются при первом вхождении и интернируются.
+ */
+std::map<std::string, WordAtom, std::less<>>& wordTable() {
+
+    static std::map<std::string, WordAtom, std::less<>> words = [] {
+
+        std::map<std::string, WordAtom, std::less<>> table;
+
+        for (const auto& [word, keyword] : keywords) {
+            table.emplace(word.toStdString(), WordAtom{TOKEN_KEYWORD, word, keyword});
+        }
+
+        table.emplace("True", WordAtom{TOKEN_BOOL, QStringLiteral("True"), std::nullopt});
+        table.emplace("False", WordAtom{TOKEN_BOOL, QStringLiteral("False"), std::nullopt});
+        table.emplace("None", WordAtom{TOKEN_NONE, QStringLiteral("None"), std::nullopt});
+
+        return table;
+    }();
+
+    return words;
+}
+
+/// составные операторы: сначала трёхсимвольные, затем двухсимвольные
+const std::array<std::string_view, 17> compoundOperators = {
+    "//=", "**=",
+    "==", "!=", "<=", ">=", "+=", "-=", "*=", "/=", "%=",
+    "//", "**", "->", "|=", "&=", "^="
+};
+
+/// общие строки составных операторов в порядке compoundOperators
+const QString& compoundOperatorValue(const std::size_t index) {
+
+    static const std::array<QString, compoundOperators.size()> values = [] {
+        std::array<QString, compoundOperators.size()> result;
+
+        for (std::size_t i = 0; i < compoundOperators.size(); ++i) {
+            result[i] = QString::fromLatin1(compoundOperators[i].data(),
+                                            static_cast<qsizetype>(compoundOperators[i].size()));
+        }
+
+        return result;
+    }();
+
+    return values[index];
+}
+
+/// общие строки односимвольных ASCII-операторов
+const QString& asciiOperatorValue(const char ch) {
+
+    static const std::array<QString, 128> values = [] {
+        std::array<QString, 128> result;
+
+        for (int i = 0; i < 128; ++i) {
+            result[i] = QString(QChar(i));
+        }
+
+        return result;
+    }();
+
+    return values[static_cast<unsigned char>(ch)];
+}
+
+bool isAsciiIdentifierStart(const char ch) {
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+}
+
+bool isAsciiDigit(const char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+bool isHexDigit(const char ch) {
+    return isAsciiDigit(ch) || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F');
+}
+
+int hexValue(const char ch) {
+    return isAsciiDigit(ch) ? ch - '0' : (ch | 0x20) - 'a' + 10;
+}
+
+}
+
 /**
  * Разбивает заданный исходный код на QVector токенов. Этот метод
  * обрабатывает входной код и создаёт коллекцию токенов,
  * представляющих лексические элементы, такие как идентификаторы, числа, строки,
  * ключевые слова, операторы и другие, сохраняя при этом метаданные, такие как номера строк.
+ * Код разбирается за один проход прямо по байтам UTF-8.
  *
- * @param code Исходный код для токенизации, представленный в виде QString.
+ * @param code Исходный код для токенизации в кодировке UTF-8.
  *
  * @return QVector, содержащий элементы Token, каждый из которых представляет
  *         токенизированный компонент входного исходного кода.
  */
-QVector<Token> Lexer::tokenize(const QString& code) {
+QVector<Token> Lexer::tokenize(const std::string_view code) {
 
     QVector<Token> tokens;
+    src = code.data();
+    length = static_cast<qsizetype>(code.size());
     pos = 0; //текущая позиция в коде
     line = 1;
     column = 1;
     indentStack.clear();
     indentStack.push_back(0);
 
-    while (pos < code.length()) {
+    // примерно один токен на четыре байта исходника
+    tokens.reserve(length / 4 + 1);
+
+    while (pos < length) {
+
+        skipWhitespace();
+        skipComment();
+
+        if (pos >= length) {
+            break;
+        }
 
-        if (QChar ch = code[pos]; ch == '\n') {
+        if (src[pos] == '\n') {
+
+            // пустые строки файла не порождают лишних NEWLINE
+            if (!tokens.isEmpty() && tokens.last().type != TOKEN_NEWLINE) {
+                tokens.push_back(Token(TOKEN_NEWLINE, QString(), line));
+            }
 
-            tokens.push_back(Token(TOKEN_NEWLINE, "", line));
             pos++;
             line++;
             column = 1;
 
-            int spaceCount = 0, tmpPos = pos;
+            int spaceCount = 0;
+            qsizetype tmpPos = pos;
 
-            while (tmpPos < code.length() &&
-                (code[tmpPos] == ' ' || code[tmpPos] == '\t')) {
+            while (tmpPos < length &&
+                (src[tmpPos] == ' ' || src[tmpPos] == '\t' || src[tmpPos] == '\r')) {
 
-                if (code[tmpPos] == ' ')
+                if (src[tmpPos] == ' ')
                     spaceCount++;
 
-                else if (code[tmpPos] == '\t')
+                else if (src[tmpPos] == '\t')
                     spaceCount +=4;
 
                 tmpPos++;
             }
 
+            // строка из пробелов или одного комментария не меняет отступ блока
+            if (tmpPos == length || src[tmpPos] == '\n' || src[tmpPos] == '#') {
+                pos = tmpPos;
+                continue;
+            }
+
             if (spaceCount > indentStack.last()) {
 
                 indentStack.append(spaceCount);
-                tokens.push_back(Token(TOKEN_INDENT, "", line));
+                tokens.push_back(Token(TOKEN_INDENT, QString(), line));
 
             } else while (spaceCount < indentStack.last()) {
 
                     indentStack.pop_back();
-                    tokens.push_back(Token(TOKEN_DEDENT, "", line));
+                    tokens.push_back(Token(TOKEN_DEDENT, QString(), line));
             }
 
             pos = tmpPos;
             continue;
         }
 
-        Token token = nextToken(code);
+        Token token = nextToken();
 
         if (token.type == TOKEN_EOF) {
             break;
         }
 
-        tokens.append(token);
+        tokens.append(std::move(token));
     }
     while (indentStack.size() > 1) {
         indentStack.pop_back();
-        tokens.push_back(Token(TOKEN_DEDENT, "", line));
+        tokens.push_back(Token(TOKEN_DEDENT, QString(), line));
     }
 
-    tokens.push_back(Token(TOKEN_EOF, "", line));
+    tokens.push_back(Token(TOKEN_EOF, QString(), line));
 
     return tokens;
 }
 
+/**
+ * Декодирует символ UTF-8, начинающийся в текущей позиции. Некорректная или
+ * усечённая последовательность даёт U+FFFD длиной в один байт, как QString::fromUtf8.
+ *
+ * @param size Длина символа в байтах.
+ * @return Код символа.
+ */
+char32_t Lexer::peekCodePoint(int& size) const {
+
+    const auto lead = static_cast<unsigned char>(src[pos]);
+
+    size = 1;
+
+    if (lead < 0x80) {
+        return lead;
+    }
+
+    int count;
+    char32_t cp;
+
+    if ((lead & 0xe0) == 0xc0) {
+        count = 2;
+        cp = lead & 0x1f;
+    } else if ((lead & 0xf0) == 0xe0) {
+        count = 3;
+        cp = lead & 0x0f;
+    } else if ((lead & 0xf8) == 0xf0) {
+        count = 4;
+        cp = lead & 0x07;
+    } else {
+        return 0xfffd;
+    }
+
+    if (pos + count > length) {
+        return 0xfffd;
+    }
+
+    for (int i = 1; i < count; ++i) {
+
+        const auto next = static_cast<unsigned char>(src[pos + i]);
+
+        if ((next & 0xc0) != 0x80) {
+            return 0xfffd;
+        }
+
+        cp = (cp << 6) | (next & 0x3f);
+    }
+
+    size = count;
+    return cp;
+}
+
 /**
  * Извлекает следующий токен из заданного исходного кода. Этот метод анализирует
  * текст с текущей позиции, пропуская пробелы и комментарии, и идентифицирует
  * лексический элемент, например число, строку, идентификатор или оператор.
  *
- * @param code Исходный код, представленный в виде QString, из которого
- *             извлекается следующий токен.
- *
  * @return Объект Token, представляющий следующий токен, обнаруженный в коде.
  *         Если достигнут конец кода, возвращается токен типа TOKEN_EOF.
  */
-Token Lexer::nextToken(const QString& code) {
+Token Lexer::nextToken() {
 
     while (true) {
-        const int oldPos = pos;
+        const qsizetype oldPos = pos;
 
-        skipWhitespace(code);
-        skipComment(code);
+        skipWhitespace();
+        skipComment();
 
         if (pos == oldPos)
             break;
     }
 
-    if (pos >= code.length()) {
-        return {TOKEN_EOF, "", line};
+    if (pos >= length) {
+        return {TOKEN_EOF, QString(), line};
     }
 
-    const QChar ch = code[pos];
+    const char ch = src[pos];
 
-    if (ch.isDigit()) {
-        return readNumber(code);
+    if (isAsciiDigit(ch)) {
+        return readNumber();
     }
 
     if ((ch == 'b' || ch == 'B') &&
-    pos + 1 < code.length() &&
-    (code[pos + 1] == '"' || code[pos + 1] == '\'')) {
-        return readBytes(code);
+    pos + 1 < length &&
+    (src[pos + 1] == '"' || src[pos + 1] == '\'')) {
+        return readBytes();
+    }
+
+    if ((ch == 'f' || ch == 'F') &&
+    pos + 1 < length &&
+    (src[pos + 1] == '"' || src[pos + 1] == '\'')) {
+        return readFString();
     }
 
     if (ch == '\"' || ch == '\'') {
-        return readString(code);
+        return readString();
     }
 
-    if (ch.isLetter() || ch == '_') {
-        return readIdentifierOrBool(code);
+    if (isAsciiIdentifierStart(ch)) {
+        return readIdentifierOrBool();
     }
 
-    return readOperator(code);
+    if (static_cast<unsigned char>(ch) >= 0x80) {
+
+        int size;
+
+        if (QChar::isLetter(peekCodePoint(size))) {
+            return readIdentifierOrBool();
+        }
+    }
+
+    return readOperator();
 }
 
 /**
  * Читает числовой литерал из исходного кода и возвращает соответствующий токен.
  * Этот метод поддерживает как целые числа, так и числа с плавающей запятой.
  *
- * @param code Строка, представляющая входной исходный код.
- *
  * @return Token с типом TOKEN_NUMBER, содержащий числовое значение и информацию
  *         о строке, в которой находится число.
  */
-Token Lexer::readNumber(const QString& code)
+Token Lexer::readNumber()
 {
-    const int start = pos;
+    const qsizetype start = pos;
     bool hasDot = false;
     bool hasExp = false;
 
-    while (pos < code.length()) {
-        QChar ch = code[pos];
+    while (pos < length) {
+        const char ch = src[pos];
 
-        if (ch.isDigit() || ch == '_') {
+        if (isAsciiDigit(ch) || ch == '_') {
             pos++;
         }
         else if (ch == '.' && !hasDot && !hasExp) {
@@ -156,7 +343,7 @@ Token Lexer::readNumber(const QString& code)
             pos++;
 
             // после e может быть + или -
-            if (pos < code.length() && (code[pos] == '+' || code[pos] == '-')) {
+            if (pos < length && (src[pos] == '+' || src[pos] == '-')) {
                 pos++;
             }
         }
@@ -165,13 +352,11 @@ Token Lexer::readNumber(const QString& code)
         }
     }
 
-    QString num = code.mid(start, pos - start);
-
-    if (num.endsWith('e') || num.endsWith('E')) {
+    if (src[pos - 1] == 'e' || src[pos - 1] == 'E') {
         throw std::runtime_error("Invalid number format");
     }
 
-    return {TOKEN_NUMBER, num, line};
+    return {TOKEN_NUMBER, QString::fromLatin1(src + start, pos - start), line};
 }
 
 /**
@@ -179,111 +364,122 @@ Token Lexer::readNumber(const QString& code)
  * и возвращает строку, заключённую в кавычках (одинарные или двойные).
  * Если строка не закрыта, генерируется ошибка.
  *
- * @param code Исходный код, представленный в виде QString, из которого будет считан строковый литерал.
+ * Участки без escape-последовательностей копируются целиком, а значение
+ * декодируется из UTF-8 один раз, когда литерал закрыт.
  *
  * @return Token, представляющий строковый литерал, содержащий его тип, значение и номер строки.
  */
-Token Lexer::readString(const QString& code) {
+Token Lexer::readString() {
 
-    const QChar quote = code[pos++];
-    QString result;
+    const char quote = src[pos++];
+    std::string result;
 
-    while (pos < code.length()) {
+    while (pos < length) {
 
-        QChar ch = code[pos++];
+        qsizetype run = pos;
 
-        // конец строки
-        if (ch == quote) {
-            return {TOKEN_STRING, result, line};
+        while (run < length && src[run] != quote && src[run] != '\\') {
+            run++;
         }
 
-        // escape sequence
-        if (ch == '\\') {
-
-            if (pos >= code.length()) {
-                throw std::runtime_error("Invalid escape sequence");
-            }
-
-            QChar next = code[pos++];
+        result.append(src + pos, run - pos);
+        pos = run;
 
-            switch (next.unicode()) {
+        if (pos >= length) {
+            break;
+        }
 
-                case 'n':
-                    result += '\n';
-                    break;
+        // конец строки
+        if (src[pos++] == quote) {
+            return {TOKEN_STRING, QString::fromUtf8(result.data(), static_cast<qsizetype>(result.size())), line};
+        }
 
-                case 't':
-                    result += '\t';
-                    break;
+        // escape sequence
+        if (pos >= length) {
+            throw std::runtime_error("Invalid escape sequence");
+        }
 
-                case 'r':
-                    result += '\r';
-                    break;
+        const char next = src[pos++];
 
-                case '\\':
-                    result += '\\';
-                    break;
+        switch (next) {
 
-                case '\'':
-                    result += '\'';
-                    break;
+            case 'n':
+                result += '\n';
+                break;
 
-                case 'v':
-                    result += '\v';
-                    break;
+            case 't':
+                result += '\t';
+                break;
 
-                case 'f':
-                    result += '\f';
-                    break;
+            case 'r':
+                result += '\r';
+                break;
 
-                case '"':
-                    result += '"';
-                    break;
-                case 'x': {
+            case '\\':
+                result += '\\';
+                break;
 
-                    if (pos + 1 >= code.length()) {
-                        throw std::runtime_error("Invalid hex escape");
-                    }
+            case '\'':
+                result += '\'';
+                break;
 
-                    QString hex;
+            case 'v':
+                result += '\v';
+                break;
 
-                    hex += code[pos++];
-                    hex += code[pos++];
+            case 'f':
+                result += '\f';
+                break;
 
-                    bool ok = false;
+            case '"':
+                result += '"';
+                break;
 
-                    const int value = hex.toInt(&ok, 16);
+            case 'x': {
 
-                    if (!ok) {
-                        throw std::runtime_error("Invalid hex escape");
-                    }
+                if (pos + 1 >= length || !isHexDigit(src[pos]) || !isHexDigit(src[pos + 1])) {
+                    throw std::runtime_error("Invalid hex escape");
+                }
 
-                    result += QChar(value);
+                const int value = hexValue(src[pos]) * 16 + hexValue(src[pos + 1]);
+                pos += 2;
 
-                    continue;
+                // символ U+0000..U+00FF в UTF-8
+                if (value < 0x80) {
+                    result += static_cast<char>(value);
+                } else {
+                    result += static_cast<char>(0xc0 | (value >> 6));
+                    result += static_cast<char>(0x80 | (value & 0x3f));
                 }
 
-                default:
-                    result += next;
-                    break;
+                break;
             }
 
-            continue;
+            default:
+                result += next;
+                break;
         }
-
-        result += ch;
     }
 
     throw std::runtime_error("Unterminated string literal");
 }
 
-Token Lexer::readBytes(const QString& code) {
+Token Lexer::readBytes() {
 
     pos++; // skip b
 
-    Token str = readString(code);
+    Token str = readString();
+
+    return {TOKEN_BYTES, std::move(str.value), str.line};
+}
+
+Token Lexer::readFString() {
+
+    pos++; // skip f
 
-    return {TOKEN_BYTES, str.value, str.line};
+    Token str = readString();
+
+    return {TOKEN_FSTRING, std::move(str.value), str.line};
 }
 
 
@@ -293,33 +489,50 @@ Token Lexer::readBytes(const QString& code) {
  * чтобы определить, является ли она идентификатором (например, именем переменной),
  * ключевым словом (например, "if", "else", "def") или булевым значением ("True", "False").
  *
- * @param code Исходный код, представленный в виде QString, из которого будет производиться чтение.
+ * Слово ищется в общей таблице по байтам исходника, поэтому повторное имя
+ * не создаёт новой строки.
  *
  * @return Объект типа Token, содержащий тип токена (TOKEN_ID, TOKEN_KEYWORD или TOKEN_BOOL),
  *         строковое значение токена и номер строки, в которой токен находится.
  */
-Token Lexer::readIdentifierOrBool(const QString& code) {
-    const int start = pos;
-    pos++;
+Token Lexer::readIdentifierOrBool() {
+    const qsizetype start = pos;
 
-    while (pos < code.length() && (code[pos].isLetterOrNumber() || code[pos] == '_')) {
-        pos++;
-    }
-    QString id = code.mid(start, pos - start);
+    while (pos < length) {
 
-    if (keywords.count(id) == 1) {
-        return {TOKEN_KEYWORD, id, line, keywords.at(id)};
-    }
+        const char ch = src[pos];
+
+        if (isAsciiIdentifierStart(ch) || isAsciiDigit(ch)) {
+            pos++;
+            continue;
+        }
+
+        if (static_cast<unsigned char>(ch) < 0x80) {
+            break;
+        }
+
+        int size;
 
-    if (id == "True" || id == "False") {
-        return {TOKEN_BOOL, id, line};
+        if (!QChar::isLetterOrNumber(peekCodePoint(size))) {
+            break;
+        }
+
+        pos += size;
     }
 
-    if (id == "None") {
-        return {TOKEN_NONE, id, line};
+    const std::string_view word(src + start, static_cast<std::size_t>(pos - start));
+    auto& words = wordTable();
+
+    auto it = words.find(word);
+
+    if (it == words.end()) {
+
+        // имена интернируются: равные идентификаторы делят один буфер
+        QString id = StringTable::intern(QString::fromUtf8(word.data(), static_cast<qsizetype>(word.size())));
+        it = words.emplace(std::string(word), WordAtom{TOKEN_ID, std::move(id), std::nullopt}).first;
     }
 
-    return {TOKEN_ID, id, line};
+    return {it->second.type, it->second.value, line, it->second.keyword};
 }
 
 /**
@@ -327,67 +540,66 @@ Token Lexer::readIdentifierOrBool(const QString& code) {
 * одиночные и составные операторы, такие как "==", "+=", "!=" и другие.
 * В случае составного оператора происходит дополнительное смещение позиции.
 *
-* @param code Строка кода, из которой производится чтение оператора.
-*
 * @return Token, представляющий оператор, содержащий его тип, значение и
 *         строку, где он был обнаружен.
 */
-Token Lexer::readOperator(const QString& code) {
+Token Lexer::readOperator() {
 
-    if (pos + 2 < code.length()) {
+    const std::string_view rest(src + pos, static_cast<std::size_t>(length - pos));
 
-        QString three = code.mid(pos, 3);
+    for (std::size_t i = 0; i < compoundOperators.size(); ++i) {
 
-        if (three == "//=" || three == "**=") {
-            pos += 3;
-            return {TOKEN_OP, three, line};
+        if (rest.substr(0, compoundOperators[i].size()) == compoundOperators[i]) {
+            pos += static_cast<qsizetype>(compoundOperators[i].size());
+            return {TOKEN_OP, compoundOperatorValue(i), line};
         }
     }
 
-    if (pos + 1 < code.length()) {
-
-        QString two = code.mid(pos, 2);
-
-        if (two == "==" ||
-            two == "!=" ||
-            two == "<=" ||
-            two == ">=" ||
-            two == "+=" ||
-            two == "-=" ||
-            two == "*=" ||
-            two == "/=" ||
-            two == "%=" ||
-            two == "//" ||
-            two == "**" ||
-            two == "->" ||
-            two == "|=" ||
-            two == "&=" ||
-            two == "^=") {
-
-            pos += 2;
-            return {TOKEN_OP, two, line};
-            }
-    }
-
-    const QChar op = code[pos++];
+    const char op = src[pos];
 
     if (op == '@') {
-        return {TOKEN_AT, "@", line};
+        pos++;
+        return {TOKEN_AT, asciiOperatorValue(op), line};
     }
 
-    return {TOKEN_OP, QString(op), line};
+    if (static_cast<unsigned char>(op) < 0x80) {
+        pos++;
+        return {TOKEN_OP, asciiOperatorValue(op), line};
+    }
+
+    int size;
+    const char32_t cp = peekCodePoint(size);
+    pos += size;
+
+    return {TOKEN_OP, QString::fromUcs4(&cp, 1), line};
 }
 
 /**
  * Пропускает пробельные символы в коде, исключая символ новой строки. Этот метод
  * обновляет текущую позицию в коде, а также отслеживает положение в колонке.
- *
- * @param code Исходный код, представленный в виде строки QString, который
- *             анализируется текущим лексером.
  */
-void Lexer::skipWhitespace(const QString& code) {
-    while (pos < code.length() && code[pos].isSpace() && code[pos] != '\n') {
-        pos++;
+void Lexer::skipWhitespace() {
+    while (pos < length && src[pos] != '\n') {
+
+        const char ch = src[pos];
+
+        if (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f') {
+            pos++;
+            column++;
+            continue;
+        }
+
+        if (static_cast<unsigned char>(ch) < 0x80) {
+            break;
+        }
+
+        int size;
+
+        if (!QChar::isSpace(peekCodePoint(size))) {
+            break;
+        }
+
+        pos += size;
         column++;
     }
 }
@@ -395,18 +607,14 @@ void Lexer::skipWhitespace(const QString& code) {
 /**
  * Пропускает комментарии в заданном исходном коде. Этот метод проверяет,
  * начинается ли текущая позиция с символа комментария ('#'), и пропускает
- * весь текст до конца строки. После этого обновляет текущую строку и позицию.
- *
- * @param code Исходный код, представленный в виде QString, который будет обработан
- *             для игнорирования комментариев.
+ * весь текст до конца строки. Сам перевод строки остаётся на месте: из него
+ * tokenize() получит NEWLINE и отступ следующей строки.
  */
-void Lexer::skipComment(const QString& code) {
-    if (pos < code.length() && code[pos] == '#') {
-        while (pos < code.length() && code[pos] != '\n') {
+void Lexer::skipComment() {
+    if (pos < length && src[pos] == '#') {
+        while (pos < length && src[pos] != '\n') {
             pos++;
+            column++;
         }
-        column = 1;
-        line++;
-        pos++;
     }
-}
\ No newline at end of file
+}
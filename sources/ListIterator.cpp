@@ -11,7 +11,7 @@ Value ListIterator::next() {
         throw StopIterationException();
     }
 
-    return list->elements[index++];
+    return list->elements.get()[index++];
 }
 
 bool ListIterator::hasNext() const {
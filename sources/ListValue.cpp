@@ -2,58 +2,323 @@
 
 #include <qlist.h>
 #include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
 
+#include "ArrayKernels.h"
 #include "CallRuntime.h"
+#include "DictValue.h"
+#include "IntOps.h"
 #include "IteratorValue.h"
+#include "ObjectPool.h"
+#include "RangeValue.h"
+#include "ReprWriter.h"
 #include "ReversedSequenceIterator.h"
+#include "SetValue.h"
+#include "StrValue.h"
+#include "TupleValue.h"
 #include "Value.h"
 #include "../runtime/ProtocolHelpers.h"
+#include "../runtime/TimSort.h"
 //
 // Created by semyo on 12.05.2026.
 //
 QString ListValue::toString() const {
 
-    QStringList parts;
+    QString out;
+    ReprWriter(out).list(*this);
 
-    for (const auto& el : elements) {
-        parts << el.repr();
-    }
-
-    return "[" + parts.join(", ") + "]";
+    return out;
 }
 
 QString ListValue::repr() const {
     return toString();
 }
 
-Value ListValue::getItem(const Value& index) const {
+namespace {
 
-    if (index.isSlice()) {
+    /// элементы правой части присваивания срезу; список и кортеж без итератора
+    std::vector<Value> sliceSource(const Value& value) {
 
-        const auto sliceObj = index.asSlice();
+        if (value.isList()) {
+            // копия обязательна и для `a[:] = a`: источник меняется во время вставки
+            return value.asList()->elements.get();
+        }
 
-        std::vector<Value> result;
+        if (value.isTuple()) {
+            return value.asTuple()->items;
+        }
 
-        iterateSlice(
-            normalizeSlice(
-                *sliceObj,
-                static_cast<long long>(elements.size())
-            ),
-            [&](const long long i) {
+        if (!value.isIterable()) {
+            throw std::runtime_error(
+                "TypeError: can only assign an iterable"
+            );
+        }
+
+        std::vector<Value> items;
+        const auto iter = value.getIterator();
+
+        while (iter->hasNext()) {
+            items.push_back(iter->next());
+        }
+
+        return items;
+    }
+
+    std::size_t position(const long long index) {
+        return static_cast<std::size_t>(index);
+    }
+
+    using Strategy = ListValue::Strategy;
+
+    Strategy strategyOf(const Value& value) {
+
+        if (std::holds_alternative<Value::SmallInt>(value.data)) {
+            return Strategy::Int;
+        }
+
+        if (std::holds_alternative<Value::Float>(value.data)) {
+            return Strategy::Float;
+        }
+
+        return std::holds_alternative<Value::StrPtr>(value.data) ? Strategy::Str : Strategy::Generic;
+    }
+
+    /// стратегия списка со стратегией current после добавления value
+    Strategy joined(const Strategy current, const Value& value) {
+
+        if (current == Strategy::Generic) {
+            return current;
+        }
+
+        const Strategy next = strategyOf(value);
+
+        return current == Strategy::Empty || current == next ? next : Strategy::Generic;
+    }
+
+    /// элемент списка с известной стратегией — без проверки варианта
+    template<typename T>
+    const T& unboxed(const Value& item) {
+        return *std::get_if<T>(&item.data);
+    }
+}
+
+ListValue::Strategy ListValue::strategy() const {
+
+    if (cachedStrategy && strategyVersion == elements.version()) {
+        return *cachedStrategy;
+    }
+
+    Strategy result = Strategy::Empty;
+
+    for (const auto& item : elements) {
+
+        result = joined(result, item);
+
+        if (result == Strategy::Generic) {
+            break;
+        }
+    }
+
+    cachedStrategy = result;
+    strategyVersion = elements.version();
+
+    return result;
+}
+
+std::ptrdiff_t ListValue::find(const Value& value, const std::ptrdiff_t from, const std::ptrdiff_t to) const {
+
+    const auto& items = elements.get();
+
+    const auto scan = [&](auto matches) -> std::ptrdiff_t {
+
+        for (std::ptrdiff_t i = from; i < to; ++i) {
+            if (matches(items[position(i)])) {
+                return i;
+            }
+        }
+
+        return -1;
+    };
+
+    switch (strategy()) {
+
+        case Strategy::Int:
+            if (const auto x = std::get_if<Value::SmallInt>(&value.data)) {
+                return scan([x](const Value& item) { return unboxed<Value::SmallInt>(item) == *x; });
+            }
+            break;
+
+        case Strategy::Float:
+            if (const auto x = std::get_if<Value::Float>(&value.data)) {
+                return scan([x](const Value& item) { return unboxed<Value::Float>(item) == *x; });
+            }
+            break;
+
+        case Strategy::Str:
+            if (const auto x = std::get_if<Value::StrPtr>(&value.data)) {
+                const QStringView text = (*x)->view();
+                return scan([text](const Value& item) { return unboxed<Value::StrPtr>(item)->view() == text; });
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    // `__eq__` может изменить сам список: границы и буфер перечитываются на каждом шаге
+    for (std::ptrdiff_t i = from; i < to && i < static_cast<std::ptrdiff_t>(elements.size()); ++i) {
+        if (elements[position(i)].itemEquals(value)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+std::optional<Value> ListValue::sumOf(const Value& start) const {
+
+    const auto* smallStart = std::get_if<Value::SmallInt>(&start.data);
+    const auto* floatStart = std::get_if<Value::Float>(&start.data);
+
+    if (!smallStart && !floatStart) {
+        return std::nullopt;
+    }
+
+    const Strategy kind = strategy();
+    const auto& items = elements.get();
+
+    if (kind == Strategy::Empty) {
+        return start;
+    }
+
+    // вещественная сумма по порядку, как у общего пути и array
+    if (kind == Strategy::Float || (kind == Strategy::Int && floatStart)) {
+
+        double total = floatStart ? *floatStart : static_cast<double>(*smallStart);
+
+        if (kind == Strategy::Float) {
+            for (const auto& item : items) {
+                total += unboxed<Value::Float>(item);
+            }
+        } else {
+            for (const auto& item : items) {
+                total += static_cast<double>(unboxed<Value::SmallInt>(item));
+            }
+        }
+
+        return Value(total);
+    }
+
+    if (kind != Strategy::Int) {
+        return std::nullopt;
+    }
+
+    Value::SmallInt total = *smallStart;
+
+    for (std::size_t i = 0; i < items.size(); ++i) {
+
+        Value::SmallInt next;
+
+        // за пределами int64 остаток складывается общим путём с длинной арифметикой
+        if (intops::addOverflow(total, unboxed<Value::SmallInt>(items[i]), next)) {
+
+            Value result(total);
 
-                result.push_back(
-                    elements[static_cast<size_t>(i)]
-                );
+            for (std::size_t j = i; j < items.size(); ++j) {
+                result = result + items[j];
             }
+
+            return result;
+        }
+
+        total = next;
+    }
+
+    return Value(total);
+}
+
+std::optional<Value> ListValue::extremumOf(const bool wantMax) const {
+
+    const Strategy kind = strategy();
+
+    if (kind != Strategy::Int && kind != Strategy::Float) {
+        return std::nullopt;
+    }
+
+    const auto& items = elements.get();
+    std::size_t best = 0;
+
+    // строгое сравнение: из равных остаётся первый, как в CPython
+    const auto pick = [&](auto read) {
+
+        auto bestValue = read(items[0]);
+
+        for (std::size_t i = 1; i < items.size(); ++i) {
+
+            const auto value = read(items[i]);
+
+            if (wantMax ? value > bestValue : value < bestValue) {
+                best = i;
+                bestValue = value;
+            }
+        }
+    };
+
+    if (kind == Strategy::Int) {
+        pick([](const Value& item) { return unboxed<Value::SmallInt>(item); });
+    } else {
+        pick([](const Value& item) { return unboxed<Value::Float>(item); });
+    }
+
+    return items[best];
+}
+
+Value ListValue::getItem(const Value& index) const {
+
+    if (index.isSlice()) {
+
+        const NormalizedSlice slice = normalizeSlice(
+            *index.asSlice(),
+            static_cast<long long>(elements.size())
         );
 
+        // полный срез делит буфер, пока одна из копий не изменится
+        if (slice.step == 1 && slice.start == 0 && position(sliceLength(slice)) == elements.size()) {
+            return Value(makePooled<ListValue>(elements));
+        }
+
+        // непрерывный срез копируется одним диапазоном
+        if (slice.step == 1) {
+
+            const auto first = elements.begin() + slice.start;
+
+            return Value(
+                makePooled<ListValue>(
+                    std::vector<Value>(first, first + sliceLength(slice))
+                )
+            );
+        }
+
+        std::vector<Value> result;
+        result.reserve(position(sliceLength(slice)));
+
+        iterateSlice(slice, [&](const long long i) {
+            result.push_back(elements[position(i)]);
+        });
+
         return Value(
-            std::make_shared<ListValue>(
+            makePooled<ListValue>(
                 std::move(result)
             )
         );
     }
 
+    if (const auto small = std::get_if<Value::SmallInt>(&index.data)) {
+        return getItemInt(*small);
+    }
+
     if (!index.isBigInt() && !index.isBool()) {
         throw std::runtime_error(
             "TypeError: list indices must be integers or slices"
@@ -74,7 +339,56 @@ Value ListValue::getItem(const Value& index) const {
     return elements[idx];
 }
 
+Value ListValue::getItemInt(Value::SmallInt index) const {
+
+    const auto size = static_cast<Value::SmallInt>(elements.size());
+
+    if (index < 0) {
+        index += size;
+    }
+
+    if (index < 0 || index >= size) {
+        throw std::runtime_error("IndexError: list index out of range");
+    }
+
+    return elements[static_cast<std::size_t>(index)];
+}
+
+void ListValue::setItemInt(Value::SmallInt index, const Value& value) {
+
+    const auto size = static_cast<Value::SmallInt>(elements.size());
+
+    if (index < 0) {
+        index += size;
+    }
+
+    if (index < 0 || index >= size) {
+        throw std::runtime_error(
+            "IndexError: list assignment index out of range"
+        );
+    }
+
+    elements[static_cast<std::size_t>(index)] = value;
+}
+
 void ListValue::setItem(const Value &index, const Value &value) {
+
+    if (index.isSlice()) {
+        assignSlice(*index.asSlice(), value);
+        return;
+    }
+
+    if (const auto small = std::get_if<Value::SmallInt>(&index.data)) {
+        setItemInt(*small, value);
+        return;
+    }
+
+    if (!index.isBigInt() && !index.isBool()) {
+        throw std::runtime_error(
+            "TypeError: list indices must be integers or slices"
+        );
+    }
+
     auto i = index.toBigInt();
 
     if (i < 0) {
@@ -90,12 +404,72 @@ void ListValue::setItem(const Value &index, const Value &value) {
     elements[i.convert_to<size_t>()] = value;
 }
 
+void ListValue::assignSlice(const SliceValue& sliceObj, const Value& value) {
+
+    std::vector<Value> items = sliceSource(value);
+
+    const NormalizedSlice slice = normalizeSlice(
+        sliceObj,
+        static_cast<long long>(elements.size())
+    );
+
+    if (slice.step == 1) {
+
+        // a[i:j] = items: перекрытие перезаписывается на месте, затем одна вставка или одно удаление
+        const std::size_t start = position(slice.start);
+        const std::size_t replaced = position(sliceLength(slice));
+        const std::size_t overlap = std::min(replaced, items.size());
+
+        const auto first = elements.begin() + static_cast<std::ptrdiff_t>(start);
+        std::move(items.begin(), items.begin() + static_cast<std::ptrdiff_t>(overlap), first);
+
+        if (items.size() < replaced) {
+
+            elements.erase(
+                first + static_cast<std::ptrdiff_t>(overlap),
+                first + static_cast<std::ptrdiff_t>(replaced)
+            );
+
+        } else {
+
+            elements.insert(
+                first + static_cast<std::ptrdiff_t>(replaced),
+                std::make_move_iterator(items.begin() + static_cast<std::ptrdiff_t>(overlap)),
+                std::make_move_iterator(items.end())
+            );
+        }
+
+        return;
+    }
+
+    const long long count = sliceLength(slice);
+
+    if (static_cast<long long>(items.size()) != count) {
+        throw std::runtime_error(
+            "ValueError: attempt to assign sequence of size " + std::to_string(items.size()) +
+            " to extended slice of size " + std::to_string(count)
+        );
+    }
+
+    auto source = items.begin();
+    std::vector<Value>& target = elements.mutate();
+
+    iterateSlice(slice, [&](const long long i) {
+        target[position(i)] = std::move(*source++);
+    });
+}
+
 void ListValue::delItem(const Value& index) {
 
-    if (!index.isBigInt()) {
+    if (index.isSlice()) {
+        deleteSlice(*index.asSlice());
+        return;
+    }
+
+    if (!index.isBigInt() && !index.isBool()) {
 
         throw std::runtime_error(
-            "TypeError: list indices must be integers"
+            "TypeError: list indices must be integers or slices"
         );
     }
 
@@ -113,10 +487,67 @@ void ListValue::delItem(const Value& index) {
     }
 
     elements.erase(elements.begin() + idx);
+    shrinkIfSparse();
+}
+
+void ListValue::deleteSlice(const SliceValue& sliceObj) {
+
+    const NormalizedSlice slice = normalizeSlice(
+        sliceObj,
+        static_cast<long long>(elements.size())
+    );
+
+    const long long count = sliceLength(slice);
+
+    if (count == 0) {
+        return;
+    }
+
+    // отрицательный шаг выбирает те же позиции, что и положительный от последней из них
+    const long long stride = slice.step > 0 ? slice.step : -slice.step;
+    const std::size_t first = position(slice.step > 0 ? slice.start : slice.start + (count - 1) * slice.step);
+
+    if (stride == 1) {
+        elements.erase(
+            elements.begin() + static_cast<std::ptrdiff_t>(first),
+            elements.begin() + static_cast<std::ptrdiff_t>(first + position(count))
+        );
+        shrinkIfSparse();
+        return;
+    }
+
+    // один проход уплотнения: выжившие элементы сдвигаются к началу, хвост отрезается
+    std::vector<Value>& items = elements.mutate();
+    std::size_t write = first;
+    std::size_t next = first;
+    long long removed = 0;
+
+    for (std::size_t read = first; read < items.size(); ++read) {
+
+        if (removed < count && read == next) {
+            ++removed;
+            next += position(stride);
+            continue;
+        }
+
+        items[write++] = std::move(items[read]);
+    }
+
+    items.resize(write);
+    shrinkIfSparse();
 }
 
 void ListValue::append(const Value &value) {
+
+    const bool known = cachedStrategy && strategyVersion == elements.version();
+
     elements.push_back(value);
+
+    // известная стратегия обновляется на ходу, без прохода по всему списку
+    if (known) {
+        cachedStrategy = joined(*cachedStrategy, value);
+        strategyVersion = elements.version();
+    }
 }
 
 Value ListValue::pop(const std::optional<Value>& index) {
@@ -153,9 +584,10 @@ Value ListValue::pop(const std::optional<Value>& index) {
             "IndexError: pop index out of range");
         }
 
-    Value result = elements[i];
+    Value result = std::move(elements[i]);
 
     elements.erase(elements.begin() + i);
+    shrinkIfSparse();
 
     return result;
 }
@@ -164,12 +596,95 @@ std::size_t ListValue::len() const {
     return elements.size();
 }
 
+std::size_t ListValue::lengthHint(const Value& iterable) {
+
+    if (iterable.isList()) {
+        return iterable.asList()->elements.size();
+    }
+
+    if (iterable.isTuple()) {
+        return iterable.asTuple()->items.size();
+    }
+
+    // у длинной прогрессии len() может не помещаться в int64: подсказки нет
+    if (iterable.isRange() && !iterable.asRange()->isWide()) {
+        return static_cast<std::size_t>(iterable.asRange()->len());
+    }
+
+    if (iterable.isString()) {
+        return iterable.asString()->len();
+    }
+
+    if (iterable.isDict()) {
+        return iterable.asDict()->len();
+    }
+
+    if (iterable.isSet()) {
+        return iterable.asSet()->len();
+    }
+
+    return 0;
+}
+
+void ListValue::reserveFor(const std::size_t extra) {
+
+    const std::size_t needed = elements.size() + extra;
+
+    // точный reserve при повторных extend сделал бы рост линейным, а их цепочку квадратичной
+    if (needed > elements.capacity()) {
+        elements.reserve(std::max(needed, elements.capacity() * 2));
+    }
+}
+
+void ListValue::shrinkIfSparse() {
+
+    const std::size_t capacity = elements.capacity();
+
+    if (capacity <= shrinkThreshold || elements.size() >= capacity / 4) {
+        return;
+    }
+
+    // запас вдвое: чередование pop и append не перераспределяет буфер на каждом шаге
+    std::vector<Value> compact;
+    compact.reserve(std::max(elements.size() * 2, shrinkThreshold));
+    std::move(elements.begin(), elements.end(), std::back_inserter(compact));
+
+    elements.swap(compact);
+}
+
 void ListValue::extend(const Value& other) {
 
+    if (other.isList()) {
+
+        // a.extend(a): индексы, а не итераторы — после reserveFor буфер уже не переедет
+        const auto& source = other.asList()->elements;
+        const std::size_t count = source.size();
+
+        reserveFor(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            elements.push_back(source[i]);
+        }
+
+        return;
+    }
+
+    if (other.isTuple()) {
+
+        const auto& source = other.asTuple()->items;
+
+        reserveFor(source.size());
+        elements.insert(elements.end(), source.begin(), source.end());
+
+        return;
+    }
+
     if (!other.isIterable()) {
         throw std::runtime_error("extend expects iterable");
     }
 
+    reserveFor(lengthHint(other));
+
     const auto iter = other.getIterator();
 
     while (iter->hasNext()) {
@@ -215,9 +730,17 @@ void ListValue::remove(const Value& value) {
     }
 
     elements.erase(it);
+    shrinkIfSparse();
 }
 
 void ListValue::clear() {
+
+    // большой буфер отдаётся сразу, как в CPython; маленький остаётся для повторного заполнения
+    if (elements.capacity() > shrinkThreshold) {
+        elements = std::vector<Value>();
+        return;
+    }
+
     elements.clear();
 }
 
@@ -225,10 +748,9 @@ Value ListValue::count(const Value& value) const {
 
     std::size_t c = 0;
 
-    for (const auto& e : elements) {
-        if (e == value) {
-            c++;
-        }
+    for (std::ptrdiff_t i = find(value, 0, static_cast<std::ptrdiff_t>(elements.size())); i >= 0;
+         i = find(value, i + 1, static_cast<std::ptrdiff_t>(elements.size()))) {
+        c++;
     }
 
     return Value(Value::BigInt(c));
@@ -287,13 +809,10 @@ Value ListValue::index(
         }
     }
 
-    for (std::ptrdiff_t i = s; i < e; ++i) {
-
-        if (elements[i] == value) {
-            return Value(
-                Value::BigInt(i)
-            );
-        }
+    if (const std::ptrdiff_t i = find(value, s, e); i >= 0) {
+        return Value(
+            Value::BigInt(i)
+        );
     }
 
     throw std::runtime_error("ValueError: value is not in list");
@@ -304,59 +823,167 @@ void ListValue::reverse() {
 }
 
 Value ListValue::copy() const {
-    return Value(std::make_shared<ListValue>(elements));
+    return Value(makePooled<ListValue>(elements));
+}
+
+namespace {
+
+    /// какой компаратор подходит ключам сортировки
+    enum class SortKeys { Int, Float, Str, Generic };
+
+    template<typename T, typename Project>
+    SortKeys classifyKeys(const std::vector<T>& items, Project project) {
+
+        if (items.empty()) {
+            return SortKeys::Generic;
+        }
+
+        const auto& first = project(items.front()).data;
+
+        const SortKeys kind = std::holds_alternative<Value::SmallInt>(first) ? SortKeys::Int
+                            : std::holds_alternative<Value::Float>(first) ? SortKeys::Float
+                            : std::holds_alternative<Value::StrPtr>(first) ? SortKeys::Str
+                            : SortKeys::Generic;
+
+        if (kind == SortKeys::Generic) {
+            return kind;
+        }
+
+        const std::size_t index = project(items.front()).data.index();
+
+        for (const auto& item : items) {
+            if (project(item).data.index() != index) {
+                return SortKeys::Generic;
+            }
+        }
+
+        return kind;
+    }
+
+    /// компаратор по стратегии списка: проход classifyKeys уже не нужен
+    SortKeys keysOf(const Strategy strategy) {
+
+        switch (strategy) {
+            case Strategy::Int: return SortKeys::Int;
+            case Strategy::Float: return SortKeys::Float;
+            case Strategy::Str: return SortKeys::Str;
+            default: return SortKeys::Generic;
+        }
+    }
+
+    /**
+     * Сортирует items по ключу project(item). Однородные int, float и str сравниваются
+     * напрямую, без разбора типов в Value::operator<. reverse меняет местами операнды
+     * сравнения, поэтому равные элементы сохраняют исходный порядок, как в CPython.
+     */
+    template<typename T, typename Project>
+    void sortByKey(std::vector<T>& items, const bool reverse, Project project,
+                   const std::optional<SortKeys> known = std::nullopt, const std::size_t workers = 1) {
+
+        // workers > 1 — только для типизированных компараторов: общий вызывает `__lt__`
+        const auto run = [&](auto less, const std::size_t threads) {
+            if (reverse) {
+                timsort::parallelSort(items, [&](const T& a, const T& b) { return less(b, a); }, threads);
+            } else {
+                timsort::parallelSort(items, less, threads);
+            }
+        };
+
+        switch (known ? *known : classifyKeys(items, project)) {
+
+            case SortKeys::Int:
+                run([&](const T& a, const T& b) {
+                    return std::get<Value::SmallInt>(project(a).data) < std::get<Value::SmallInt>(project(b).data);
+                }, workers);
+                break;
+
+            case SortKeys::Float:
+                run([&](const T& a, const T& b) {
+                    return std::get<Value::Float>(project(a).data) < std::get<Value::Float>(project(b).data);
+                }, workers);
+                break;
+
+            case SortKeys::Str:
+                run([&](const T& a, const T& b) {
+                    return std::get<Value::StrPtr>(project(a).data)->view() <
+                           std::get<Value::StrPtr>(project(b).data)->view();
+                }, workers);
+                break;
+
+            case SortKeys::Generic:
+                run([&](const T& a, const T& b) {
+                    return project(a) < project(b);
+                }, 1);
+                break;
+        }
+    }
+}
+
+std::size_t ListValue::sortWorkers(const Strategy kind) const {
+
+    const std::size_t workers = std::min<std::size_t>(
+        static_cast<std::size_t>(arraykernels::threads()),
+        elements.size() / static_cast<std::size_t>(arraykernels::parallelThreshold)
+    );
+
+    if (workers <= 1 || kind == Strategy::Empty || kind == Strategy::Generic) {
+        return 1;
+    }
+
+    // NaN нарушает строгий слабый порядок: результат слияния мог бы разойтись с последовательным
+    if (kind == Strategy::Float && std::any_of(elements.begin(), elements.end(), [](const Value& item) {
+            return std::isnan(unboxed<Value::Float>(item));
+        })) {
+        return 1;
+    }
+
+    return workers;
 }
 
-/* TODO: пооддержка kwargs пока отсутсвует
-    для вызова reverse = True || False делать просто sort([key, ]True || False)
-*/
 void ListValue::sort(
     const std::optional<Value>& key,
     bool reverse,
     const std::shared_ptr<Environment>& env) {
 
-    // обычный sort
     if (!key.has_value()) {
 
-        std::sort(
-            elements.begin(),
-            elements.end(),
+        const Strategy kind = strategy();
+        const std::size_t workers = sortWorkers(kind);
 
-            [reverse](const Value& a, const Value& b) {
-                return reverse ? b < a : a < b;
-            }
-        );
+        // на время сортировки список пуст, как в CPython: копия, снятая в `__lt__`,
+        // не должна делить буфер, который ещё переставляется
+        std::vector<Value> items = std::move(elements.mutate());
+        elements.clear();
 
+        try {
+            sortByKey(items, reverse, [](const Value& item) -> const Value& { return item; }, keysOf(kind), workers);
+        } catch (...) {
+            elements = std::move(items);
+            throw;
+        }
+
+        // перестановка не меняет типов элементов
+        elements = std::move(items);
+        cachedStrategy = kind;
+        strategyVersion = elements.version();
         return;
     }
 
-    // decorate
+    // decorate: key вызывается ровно один раз на элемент
     std::vector<std::pair<Value, Value>> decorated;
+    decorated.reserve(elements.size());
 
-    for (const auto& elem : elements) {
-
-        Value k = call(key.value(),{ elem }, {}, env);
-
-        decorated.emplace_back(k, elem);
+    for (const auto& elem : elements.get()) {
+        decorated.emplace_back(call(key.value(), { elem }, {}, env), elem);
     }
 
-    // sort by key
-    std::sort(
-        decorated.begin(),
-        decorated.end(),
-
-        [reverse](const auto& a, const auto& b) {
-            return reverse
-                ? b.first < a.first
-                : a.first < b.first;
-        }
-    );
+    sortByKey(decorated, reverse, [](const std::pair<Value, Value>& item) -> const Value& { return item.first; });
 
-    // undecorate
+    // undecorate: заново, а не по индексам — key мог изменить сам список
     elements.clear();
 
-    for (const auto& [k, v] : decorated) {
-        elements.push_back(v);
+    for (auto& [k, v] : decorated) {
+        elements.push_back(std::move(v));
     }
 }
 
@@ -372,8 +999,24 @@ bool ListValue::equal(const Value& other) const {
         return false;
     }
 
+    // два однородных числовых списка сравниваются прямо по значениям
+    if (const Strategy kind = strategy(); kind == other.asList()->strategy()) {
+
+        if (kind == Strategy::Int) {
+            return std::equal(elements.begin(), elements.end(), rhs.begin(), [](const Value& a, const Value& b) {
+                return unboxed<Value::SmallInt>(a) == unboxed<Value::SmallInt>(b);
+            });
+        }
+
+        if (kind == Strategy::Float) {
+            return std::equal(elements.begin(), elements.end(), rhs.begin(), [](const Value& a, const Value& b) {
+                return unboxed<Value::Float>(a) == unboxed<Value::Float>(b);
+            });
+        }
+    }
+
     for (size_t i = 0; i < elements.size(); ++i) {
-        if (elements[i] != rhs[i]) {
+        if (!elements[i].itemEquals(rhs[i])) {
             return false;
         }
     }
@@ -400,7 +1043,7 @@ bool ListValue::less(const Value& other) const {
 
     for (size_t i = 0; i < minSize; ++i) {
 
-        if (elements[i] == rhs[i]) {
+        if (elements[i].itemEquals(rhs[i])) {
             continue;
         }
 
@@ -429,7 +1072,7 @@ bool ListValue::greater(const Value& other) const {
 
     for (size_t i = 0; i < minSize; ++i) {
 
-        if (elements[i] == rhs[i]) {
+        if (elements[i].itemEquals(rhs[i])) {
             continue;
         }
 
@@ -442,18 +1085,17 @@ bool ListValue::greater(const Value& other) const {
 Value ListValue::add(const Value& other) const {
 
     if (!other.isList()) {
-
-        throw std::runtime_error(
-            "TypeError: can only concatenate list to list"
-        );
+        return Value::notImplemented();
     }
 
+    const auto& rhs = other.asList()->elements.get();
+
     auto result =
-        std::make_shared<ListValue>();
+        makePooled<ListValue>();
 
     result->elements.reserve(
         elements.size() +
-        other.asList()->elements.size()
+        rhs.size()
     );
 
     result->elements.insert(
@@ -464,20 +1106,15 @@ Value ListValue::add(const Value& other) const {
 
     result->elements.insert(
         result->elements.end(),
-        other.asList()->elements.begin(),
-        other.asList()->elements.end()
+        rhs.begin(),
+        rhs.end()
     );
 
     return Value(result);
 }
 
 bool ListValue::contains(const Value &value) const {
-
-    return std::any_of(
-        elements.begin(),
-        elements.end(),
-        [&](const auto& e) { return e == value;});
-
+    return find(value, 0, static_cast<std::ptrdiff_t>(elements.size())) >= 0;
 }
 
 Value ListValue::iadd(const Value& other) {
@@ -515,15 +1152,13 @@ std::vector<Value> ListValue::buildRepeated(const long long times) const {
 Value ListValue::multiply(const Value& other) const {
 
     if (!other.isNumeric() || other.isBigFloat()) {
-        throw std::runtime_error(
-            "TypeError: can't multiply list by non-int"
-        );
+        return Value::notImplemented();
     }
 
     const auto times = other.toBigInt().convert_to<long long>();
 
     return Value(
-        std::make_shared<ListValue>(
+        makePooled<ListValue>(
             buildRepeated(times)
         )
     );
@@ -546,7 +1181,22 @@ Value ListValue::imul(const Value& other) {
 
     const auto times = other.toBigInt().convert_to<long long>();
 
-    elements = buildRepeated(times);
+    if (times <= 0) {
+        clear();
+    } else {
+
+        // дописываем копии на месте: один reserve, исходный блок не копируется заранее
+        std::vector<Value>& items = elements.mutate();
+        const std::size_t block = items.size();
+
+        items.reserve(block * static_cast<std::size_t>(times));
+
+        for (long long k = 1; k < times; ++k) {
+            for (std::size_t i = 0; i < block; ++i) {
+                items.push_back(items[i]);
+            }
+        }
+    }
 
     return Value(
         std::const_pointer_cast<ListValue>(
@@ -572,3 +1222,29 @@ Value ListValue::reversed() const {
 bool ListValue::greaterOrEqual(const Value& other) const {
     return !less(other);
 }
+
+long ListValue::gcRefCount() const {
+    return weak_from_this().use_count();
+}
+
+std::shared_ptr<GcObject> ListValue::gcSelf() {
+    return shared_from_this();
+}
+
+void ListValue::gcTraverse(const GcVisitor& visit) const {
+
+    // общий буфер владеет элементами один раз, а списков у него несколько:
+    // обход из каждого вычел бы одну ссылку дважды. Цикл через общий буфер
+    // соберётся, когда копии разойдутся
+    if (elements.shared()) {
+        return;
+    }
+
+    for (const auto& element : elements) {
+        gcVisitValue(element, visit);
+    }
+}
+
+void ListValue::gcClear() {
+    elements.clear();
+}
@@ -0,0 +1,59 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "LookaheadIterator.h"
+
+#include "StopIterationException.h"
+#include "TupleValue.h"
+
+bool LookaheadIterator::hasNext() const {
+
+    if (pending || exhausted) {
+        return pending.has_value();
+    }
+
+    // produce меняет состояние источников; для наблюдателя итератор не меняется
+    auto* self = const_cast<LookaheadIterator*>(this);
+
+    if (Value item; self->produce(item)) {
+        pending = std::move(item);
+    } else {
+        exhausted = true;
+    }
+
+    return pending.has_value();
+}
+
+Value LookaheadIterator::next() {
+
+    if (!hasNext()) {
+        throw StopIterationException();
+    }
+
+    Value item = std::move(*pending);
+    pending.reset();
+
+    return item;
+}
+
+bool LookaheadIterator::nextPair(Value& first, Value& second) {
+
+    // элемент, заранее полученный hasNext(), уже собран в кортеж
+    if (pending) {
+        const auto& items = pending->asTuple()->items;
+        first = items[0];
+        second = items[1];
+        pending.reset();
+        return true;
+    }
+
+    if (exhausted) {
+        return false;
+    }
+
+    if (!producePair(first, second)) {
+        exhausted = true;
+    }
+
+    return !exhausted;
+}
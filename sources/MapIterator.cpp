@@ -0,0 +1,28 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "MapIterator.h"
+
+#include "CallRuntime.h"
+
+MapIterator::MapIterator(Value func, std::vector<Value> sources, std::shared_ptr<Environment> env)
+    : LookaheadIterator(std::move(env)), func(std::move(func)), sources(std::move(sources)) {}
+
+bool MapIterator::produce(Value& out) {
+
+    std::vector<Value> args(sources.size());
+
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        if (!iterNext(sources[i], args[i], env)) {
+            return false;
+        }
+    }
+
+    out = call(func, args, {}, env);
+
+    return true;
+}
+
+QString MapIterator::getTypeName() const {
+    return "map";
+}
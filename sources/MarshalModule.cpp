@@ -0,0 +1,89 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "MarshalModule.h"
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "ValueCodec.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    Value dumps(const Value& value) {
+
+        QByteArray data;
+        valuecodec::encode(value, data);
+
+        return Value(std::make_shared<BytesValue>(std::move(data)));
+    }
+
+    /// как marshal.loads: читается первое значение, остаток буфера не проверяется
+    Value loads(const Value& source) {
+
+        qsizetype pos = 0;
+
+        if (source.isBytes()) {
+            return valuecodec::decode(source.asBytes()->bytes(), pos);
+        }
+
+        if (source.isByteArray()) {
+            return valuecodec::decode(source.asByteArray()->bytes(), pos);
+        }
+
+        throw std::runtime_error(
+            "TypeError: a bytes-like object is required, not '" + typeName(source).toStdString() + "'");
+    }
+}
+
+Value MarshalModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("marshal");
+
+    module->setAttribute("dumps", makeBuiltin(
+        "dumps",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "dumps");
+
+            return dumps(args[0]);
+        }
+    ));
+
+    module->setAttribute("loads", makeBuiltin(
+        "loads",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "loads");
+
+            return loads(args[0]);
+        }
+    ));
+
+    module->setAttribute("dump", makeBuiltin(
+        "dump",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgs(args, 2, "dump");
+
+            callMethod(args[1], "write", {dumps(args[0])}, {}, env);
+
+            return {};
+        }
+    ));
+
+    module->setAttribute("load", makeBuiltin(
+        "load",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>& env) -> Value {
+
+            expectArgs(args, 1, "load");
+
+            return loads(callMethod(args[0], "read", {}, {}, env));
+        }
+    ));
+
+    return Value(module);
+}
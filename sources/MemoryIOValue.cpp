@@ -0,0 +1,399 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "MemoryIOValue.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassUtils.h"
+#include "ListValue.h"
+#include "MemoryViewValue.h"
+#include "ObjectPool.h"
+#include "StrValue.h"
+
+namespace {
+
+    /// ёмкость под end элементов: при нехватке — не меньше чем вдвое больше прежней
+    template <typename Buffer>
+    void reserveFor(Buffer& buffer, const qsizetype end) {
+
+        if (end > buffer.capacity()) {
+            buffer.reserve(std::max(end, buffer.capacity() * 2));
+        }
+    }
+
+    /**
+     * Записывает chunk с позиции pos: перекрытое заменяется, за концом дописывается,
+     * а промежуток после seek за конец заполняется нулями, как в CPython.
+     */
+    template <typename Buffer, typename Chunk>
+    void writeAt(Buffer& buffer, const qsizetype pos, const Chunk chunk) {
+
+        const qsizetype end = pos + chunk.size();
+        const qsizetype size = buffer.size();
+
+        if (end > size) {
+            reserveFor(buffer, end);
+            buffer.resize(end);
+        }
+
+        if (pos > size) {
+            std::fill(buffer.begin() + size, buffer.begin() + pos, typename Buffer::value_type(0));
+        }
+
+        std::copy(chunk.begin(), chunk.end(), buffer.begin() + pos);
+    }
+
+    /// позиция после seek(offset, whence) в потоке длины size
+    qsizetype seekTarget(const qsizetype offset, const int whence, const qsizetype pos, const qsizetype size) {
+
+        switch (whence) {
+            case 0:
+                if (offset < 0) {
+                    throw std::runtime_error("ValueError: negative seek value " + std::to_string(offset));
+                }
+                return offset;
+            case 1:
+                return std::max<qsizetype>(pos + offset, 0);
+            case 2:
+                return std::max<qsizetype>(size + offset, 0);
+            default:
+                throw std::runtime_error(
+                    "ValueError: invalid whence (" + std::to_string(whence) + ", should be 0, 1 or 2)");
+        }
+    }
+
+    qsizetype truncateSize(const std::optional<qsizetype> size, const qsizetype pos) {
+
+        if (size && *size < 0) {
+            throw std::runtime_error("ValueError: negative size value " + std::to_string(*size));
+        }
+
+        return size.value_or(pos);
+    }
+
+    /// длина чтения с позиции pos: отрицательный или отсутствующий размер — до конца
+    qsizetype readLength(const std::optional<qsizetype> size, const qsizetype pos, const qsizetype total) {
+
+        const qsizetype available = std::max<qsizetype>(total - pos, 0);
+
+        return !size || *size < 0 ? available : std::min(*size, available);
+    }
+
+    /// у StringIO сообщение CPython без точки, у BytesIO и файлов — с точкой
+    [[noreturn]] void closedError(const char* message) {
+        throw std::runtime_error(std::string("ValueError: ") + message);
+    }
+}
+
+StringIOValue::StringIOValue(QString initial)
+    : LookaheadIterator(nullptr),
+      buffer(std::move(initial)) {}
+
+QString StringIOValue::getTypeName() const {
+    return "_io.StringIO";
+}
+
+QString StringIOValue::toString() const {
+    return QString("<_io.StringIO object at 0x%1>").arg(reinterpret_cast<quintptr>(this), 0, 16);
+}
+
+void StringIOValue::ensureOpen() const {
+    if (closed) {
+        closedError("I/O operation on closed file");
+    }
+}
+
+Value StringIOValue::read(const std::optional<qsizetype> size) {
+
+    ensureOpen();
+
+    const qsizetype length = readLength(size, pos, buffer.size());
+    const qsizetype from = pos;
+    pos += length;
+
+    // весь буфер целиком — без копии
+    if (from == 0 && length == buffer.size()) {
+        return Value(buffer);
+    }
+
+    return Value(buffer.mid(from, length));
+}
+
+Value StringIOValue::readline(const std::optional<qsizetype> limit) {
+
+    ensureOpen();
+
+    const qsizetype available = readLength(limit, pos, buffer.size());
+    const qsizetype newline = available > 0 ? QStringView(buffer).sliced(pos, available).indexOf(u'\n') : -1;
+    const qsizetype length = newline < 0 ? available : newline + 1;
+
+    Value line(buffer.mid(pos, length));
+    pos += length;
+
+    return line;
+}
+
+Value StringIOValue::readlines() {
+
+    std::vector<Value> lines;
+
+    for (Value line = readline(std::nullopt); !line.asString()->view().isEmpty(); line = readline(std::nullopt)) {
+        lines.push_back(std::move(line));
+    }
+
+    return Value(makePooled<ListValue>(std::move(lines)));
+}
+
+qsizetype StringIOValue::write(const Value& data) {
+
+    ensureOpen();
+
+    if (!data.isString()) {
+        throw std::runtime_error("TypeError: string argument expected, got '" + typeName(data).toStdString() + "'");
+    }
+
+    const QStringView chars = data.asString()->view();
+
+    // запись в конец — самый частый случай — дописывает без промежуточных шагов
+    if (pos == buffer.size()) {
+        reserveFor(buffer, pos + chars.size());
+        buffer.append(chars);
+    } else {
+        writeAt(buffer, pos, chars);
+    }
+
+    pos += chars.size();
+
+    return chars.size();
+}
+
+Value StringIOValue::getvalue() const {
+
+    ensureOpen();
+
+    return Value(buffer);
+}
+
+qsizetype StringIOValue::seek(const qsizetype offset, const int whence) {
+
+    ensureOpen();
+
+    if (whence == 1 && offset != 0) {
+        throw std::runtime_error("OSError: Can't do nonzero cur-relative seeks");
+    }
+
+    if (whence == 2 && offset != 0) {
+        throw std::runtime_error("OSError: Can't do nonzero end-relative seeks");
+    }
+
+    pos = seekTarget(offset, whence, pos, buffer.size());
+
+    return pos;
+}
+
+qsizetype StringIOValue::tell() const {
+
+    ensureOpen();
+
+    return pos;
+}
+
+qsizetype StringIOValue::truncate(const std::optional<qsizetype> size) {
+
+    ensureOpen();
+
+    const qsizetype target = truncateSize(size, pos);
+
+    if (target < buffer.size()) {
+        buffer.truncate(target);
+    }
+
+    return target;
+}
+
+void StringIOValue::close() {
+
+    closed = true;
+    buffer.clear();
+}
+
+bool StringIOValue::produce(Value& out) {
+
+    out = readline(std::nullopt);
+
+    return !out.asString()->view().isEmpty();
+}
+
+BytesIOValue::BytesIOValue(QByteArray initial)
+    : LookaheadIterator(nullptr),
+      buffer(std::make_shared<ByteArrayValue>(std::move(initial))) {}
+
+QString BytesIOValue::getTypeName() const {
+    return "_io.BytesIO";
+}
+
+QString BytesIOValue::toString() const {
+    return QString("<_io.BytesIO object at 0x%1>").arg(reinterpret_cast<quintptr>(this), 0, 16);
+}
+
+void BytesIOValue::ensureOpen() const {
+    if (closed) {
+        closedError("I/O operation on closed file.");
+    }
+}
+
+Value BytesIOValue::read(const std::optional<qsizetype> size) {
+
+    ensureOpen();
+
+    const QByteArray& bytes = buffer->bytes();
+    const qsizetype length = readLength(size, pos, bytes.size());
+    const qsizetype from = pos;
+    pos += length;
+
+    if (from == 0 && length == bytes.size()) {
+        return Value(std::make_shared<BytesValue>(bytes));
+    }
+
+    return Value(std::make_shared<BytesValue>(bytes.mid(from, length)));
+}
+
+Value BytesIOValue::readline(const std::optional<qsizetype> limit) {
+
+    ensureOpen();
+
+    const QByteArray& bytes = buffer->bytes();
+    const qsizetype available = readLength(limit, pos, bytes.size());
+    const qsizetype newline = available > 0 ? QByteArrayView(bytes).sliced(pos, available).indexOf('\n') : -1;
+    const qsizetype length = newline < 0 ? available : newline + 1;
+
+    Value line(std::make_shared<BytesValue>(bytes.mid(pos, length)));
+    pos += length;
+
+    return line;
+}
+
+Value BytesIOValue::readlines() {
+
+    std::vector<Value> lines;
+
+    for (Value line = readline(std::nullopt); !line.asBytes()->bytes().isEmpty(); line = readline(std::nullopt)) {
+        lines.push_back(std::move(line));
+    }
+
+    return Value(makePooled<ListValue>(std::move(lines)));
+}
+
+qsizetype BytesIOValue::write(const Value& data) {
+
+    ensureOpen();
+
+    // memoryview над самим буфером не должен читать его во время записи
+    QByteArray copied;
+    QByteArrayView chunk;
+
+    if (data.isBytes()) {
+        chunk = data.asBytes()->bytes();
+    } else if (data.isByteArray()) {
+        chunk = data.asByteArray()->bytes();
+    } else if (const MemoryViewValue* view = MemoryViewValue::of(data)) {
+        copied = view->toBytes();
+        chunk = copied;
+    } else {
+        throw std::runtime_error(
+            "TypeError: a bytes-like object is required, not '" + typeName(data).toStdString() + "'");
+    }
+
+    buffer->ensureResizable();
+
+    QByteArray& bytes = buffer->bytes();
+
+    if (pos == bytes.size()) {
+        reserveFor(bytes, pos + chunk.size());
+        bytes.append(chunk);
+    } else {
+        writeAt(bytes, pos, chunk);
+    }
+
+    pos += chunk.size();
+
+    return chunk.size();
+}
+
+qsizetype BytesIOValue::readinto(ByteArrayValue& target) {
+
+    ensureOpen();
+
+    QByteArray& out = target.bytes();
+    const qsizetype length = readLength(out.size(), pos, buffer->bytes().size());
+
+    if (length > 0) {
+        std::memcpy(out.data(), buffer->bytes().constData() + pos, static_cast<std::size_t>(length));
+        pos += length;
+    }
+
+    return length;
+}
+
+Value BytesIOValue::getvalue() const {
+
+    ensureOpen();
+
+    return Value(std::make_shared<BytesValue>(buffer->bytes()));
+}
+
+Value BytesIOValue::getbuffer() const {
+
+    ensureOpen();
+
+    return Value(std::static_pointer_cast<ObjectValue>(std::make_shared<MemoryViewValue>(Value(buffer))));
+}
+
+qsizetype BytesIOValue::seek(const qsizetype offset, const int whence) {
+
+    ensureOpen();
+
+    pos = seekTarget(offset, whence, pos, buffer->bytes().size());
+
+    return pos;
+}
+
+qsizetype BytesIOValue::tell() const {
+
+    ensureOpen();
+
+    return pos;
+}
+
+qsizetype BytesIOValue::truncate(const std::optional<qsizetype> size) {
+
+    ensureOpen();
+    buffer->ensureResizable();
+
+    const qsizetype target = truncateSize(size, pos);
+
+    if (target < buffer->bytes().size()) {
+        buffer->bytes().truncate(target);
+    }
+
+    return target;
+}
+
+void BytesIOValue::close() {
+
+    buffer->ensureResizable();
+
+    closed = true;
+    buffer->bytes().clear();
+}
+
+bool BytesIOValue::produce(Value& out) {
+
+    out = readline(std::nullopt);
+
+    return !out.asBytes()->bytes().isEmpty();
+}
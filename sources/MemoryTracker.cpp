@@ -0,0 +1,470 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassValue.h"
+#include "DictValue.h"
+#include "Environment.h"
+#include "InstanceValue.h"
+#include "ListValue.h"
+#include "OutputStream.h"
+#include "StrValue.h"
+#include "Tracer.h"
+#include "TupleValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    using Kind = MemoryTracker::Kind;
+
+    /// живые объекты одного типа, созданные в одном месте
+    struct Trace {
+        QString type;
+        QString file;
+        int line = 0;
+        std::uint64_t size = 0;
+        std::uint64_t count = 0;
+    };
+
+    struct Group {
+        QString key;
+        std::uint64_t size = 0;
+        std::uint64_t count = 0;
+    };
+
+    /// объект по адресу его основы MemoryTracked
+    template<typename T, Kind kind>
+    const T& objectAt(const void* object) {
+        return *static_cast<const T*>(static_cast<const MemoryTracked<kind>*>(object));
+    }
+
+    /// тип Python и размер объекта вместе с его буферами
+    std::pair<QString, std::uint64_t> describe(const void* object, const Kind kind) {
+
+        switch (kind) {
+            case Kind::List: {
+                const auto& list = objectAt<ListValue, Kind::List>(object);
+                return {"list", sizeof(ListValue) + list.elements.capacity() * sizeof(Value)};
+            }
+            case Kind::Dict: {
+                const auto& dict = objectAt<DictValue, Kind::Dict>(object);
+                return {"dict", sizeof(DictValue) + dict.tableBytes()};
+            }
+            case Kind::Str: {
+                const auto& str = objectAt<StrValue, Kind::Str>(object);
+                return {"str", sizeof(StrValue) + static_cast<std::uint64_t>(str.view().size()) * sizeof(QChar)};
+            }
+            case Kind::Bytes: {
+                const auto& bytes = objectAt<BytesValue, Kind::Bytes>(object);
+                return {"bytes", sizeof(BytesValue) + static_cast<std::uint64_t>(bytes.bytes().capacity())};
+            }
+            case Kind::ByteArray: {
+                const auto& bytes = objectAt<ByteArrayValue, Kind::ByteArray>(object);
+                return {"bytearray", sizeof(ByteArrayValue) + static_cast<std::uint64_t>(bytes.bytes().capacity())};
+            }
+            case Kind::Instance: {
+                // экземпляры различаются по классу: так видно, чьи объекты копятся
+                const auto& instance = objectAt<InstanceValue, Kind::Instance>(object);
+                return {instance.klass ? instance.klass->name : QString("object"),
+                        sizeof(InstanceValue) + instance.slots.capacity() * sizeof(Value) +
+                        static_cast<std::uint64_t>(instance.overflow.size()) * (sizeof(QString) + sizeof(Value))};
+            }
+            case Kind::Environment: {
+                const auto& env = objectAt<Environment, Kind::Environment>(object);
+                return {"environment",
+                        sizeof(Environment) + env.slots.capacity() * sizeof(std::optional<Value>) +
+                        env.cells.capacity() * sizeof(std::shared_ptr<Cell>) +
+                        static_cast<std::uint64_t>(env.variables.size()) * (sizeof(QString) + sizeof(Value))};
+            }
+        }
+
+        return {"object", 0};
+    }
+
+    QString groupKey(const Trace& trace, const QString& keyType) {
+
+        if (keyType == "type") {
+            return trace.type;
+        }
+
+        if (keyType == "filename") {
+            return trace.file;
+        }
+
+        return trace.file + ":" + QString::number(trace.line);
+    }
+
+    void checkKeyType(const QString& keyType) {
+        if (keyType != "lineno" && keyType != "filename" && keyType != "type") {
+            throw std::runtime_error("ValueError: unknown key_type: '" + keyType.toStdString() + "'");
+        }
+    }
+
+    /// группы по ключу, крупные сначала
+    std::vector<Group> groupBy(const std::vector<Trace>& traces, const QString& keyType) {
+
+        std::map<QString, Group> groups;
+
+        for (const Trace& trace : traces) {
+            const QString key = groupKey(trace, keyType);
+            Group& group = groups[key];
+            group.key = key;
+            group.size += trace.size;
+            group.count += trace.count;
+        }
+
+        std::vector<Group> result;
+        result.reserve(groups.size());
+
+        for (auto& [key, group] : groups) {
+            result.push_back(std::move(group));
+        }
+
+        std::stable_sort(result.begin(), result.end(), [](const Group& a, const Group& b) {
+            return std::tie(b.size, b.count) < std::tie(a.size, a.count);
+        });
+
+        return result;
+    }
+
+    Value number(const std::uint64_t value) {
+        return Value(static_cast<Value::SmallInt>(value));
+    }
+
+    Value number(const std::int64_t value) {
+        return Value(static_cast<Value::SmallInt>(value));
+    }
+
+    Value tracesValue(const std::vector<Trace>& traces) {
+
+        const auto list = std::make_shared<ListValue>();
+        list->elements.reserve(traces.size());
+
+        for (const Trace& trace : traces) {
+            list->elements.push_back(TupleValue::make({
+                Value(trace.type), Value(trace.file), Value(static_cast<Value::SmallInt>(trace.line)),
+                number(trace.size), number(trace.count)
+            }));
+        }
+
+        return Value(list);
+    }
+
+    /// сводка живых объектов по типу и месту создания
+    std::vector<Trace> collect() {
+
+        std::map<std::tuple<QString, QString, int>, Trace> traces;
+
+        MemoryTracker::forEachLive([&traces](const void* object, const Kind kind, const std::pair<QString, int>& site) {
+
+            const auto [type, size] = describe(object, kind);
+
+            Trace& trace = traces[{type, site.first, site.second}];
+            trace.type = type;
+            trace.file = site.first;
+            trace.line = site.second;
+            trace.size += size;
+            ++trace.count;
+        });
+
+        std::vector<Trace> result;
+        result.reserve(traces.size());
+
+        for (auto& [key, trace] : traces) {
+            result.push_back(std::move(trace));
+        }
+
+        return result;
+    }
+
+    /// разбирает `snapshot.traces` обратно: compare_to получает чужой снимок как значение Python
+    std::vector<Trace> tracesOf(const Value& snapshot) {
+
+        if (!snapshot.isClass() || snapshot.asClass()->name != "Snapshot" ||
+            !snapshot.asClass()->attributes.contains("traces")) {
+            throw std::runtime_error("TypeError: compare_to() argument must be a Snapshot");
+        }
+
+        std::vector<Trace> traces;
+
+        for (const Value& item : snapshot.asClass()->attributes.value("traces").asList()->elements.get()) {
+            const auto& fields = item.asTuple()->items;
+            traces.push_back(Trace{
+                fields[0].toString(),
+                fields[1].toString(),
+                fields[2].asBigInt().convert_to<int>(),
+                fields[3].asBigInt().convert_to<std::uint64_t>(),
+                fields[4].asBigInt().convert_to<std::uint64_t>()
+            });
+        }
+
+        return traces;
+    }
+
+    QString keyTypeArg(const std::vector<Value>& args, const std::size_t index) {
+
+        const QString keyType = args.size() > index ? args[index].toString() : QString("lineno");
+        checkKeyType(keyType);
+
+        return keyType;
+    }
+}
+
+struct MemoryTracker::State {
+    struct Allocation {
+        Kind kind;
+        /// номер места создания в `sites`
+        std::uint32_t site;
+    };
+
+    std::unordered_map<const void*, Allocation> live;
+    std::vector<std::pair<QString, int>> sites;
+    std::map<std::pair<QString, int>, std::uint32_t> siteIndex;
+};
+
+MemoryTracker::State& MemoryTracker::state() {
+    static State* const state = new State();
+    return *state;
+}
+
+void MemoryTracker::track(const void* object, const Kind kind) {
+
+    State& tracker = state();
+    std::pair<QString, int> location = Tracer::location();
+
+    const auto [it, inserted] = tracker.siteIndex.try_emplace(location, static_cast<std::uint32_t>(tracker.sites.size()));
+
+    if (inserted) {
+        tracker.sites.push_back(std::move(location));
+    }
+
+    tracker.live[object] = State::Allocation{kind, it->second};
+}
+
+void MemoryTracker::untrack(const void* object) {
+    state().live.erase(object);
+}
+
+void MemoryTracker::start() {
+    tracing = true;
+    Tracer::trackLocations(true);
+}
+
+void MemoryTracker::stop() {
+    tracing = false;
+    Tracer::trackLocations(false);
+    clear();
+}
+
+void MemoryTracker::clear() {
+    State& tracker = state();
+    tracker.live.clear();
+    tracker.sites.clear();
+    tracker.siteIndex.clear();
+}
+
+void MemoryTracker::forEachLive(const LiveVisitor& visit) {
+
+    const State& tracker = state();
+
+    for (const auto& [object, allocation] : tracker.live) {
+        visit(object, allocation.kind, tracker.sites[allocation.site]);
+    }
+}
+
+std::uint64_t MemoryTracker::liveBytes() {
+
+    std::uint64_t total = 0;
+
+    for (const auto& [object, allocation] : state().live) {
+        total += describe(object, allocation.kind).second;
+    }
+
+    return total;
+}
+
+std::size_t MemoryTracker::liveCount() {
+    return state().live.size();
+}
+
+Value MemoryTracker::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("tracemalloc");
+
+    module->setAttribute("start", makeBuiltin(
+        "start",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "start");
+            start();
+            return Value();
+        }
+    ));
+
+    module->setAttribute("stop", makeBuiltin(
+        "stop",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "stop");
+            stop();
+            return Value();
+        }
+    ));
+
+    module->setAttribute("is_tracing", makeBuiltin(
+        "is_tracing",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "is_tracing");
+            return Value(tracing);
+        }
+    ));
+
+    module->setAttribute("clear_traces", makeBuiltin(
+        "clear_traces",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "clear_traces");
+            clear();
+            return Value();
+        }
+    ));
+
+    module->setAttribute("take_snapshot", makeBuiltin(
+        "take_snapshot",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 0, "take_snapshot");
+
+            if (!tracing) {
+                throw std::runtime_error("RuntimeError: the tracemalloc module must be tracing memory "
+                                         "allocations to take a snapshot");
+            }
+
+            const auto traces = std::make_shared<const std::vector<Trace>>(collect());
+            const auto snapshot = std::make_shared<ClassValue>("Snapshot");
+
+            snapshot->setAttribute("traces", tracesValue(*traces));
+
+            snapshot->setAttribute("statistics", makeBuiltin(
+                "statistics",
+                [traces](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+                    expectArgsRange(args, 0, 1, "statistics");
+
+                    const auto list = std::make_shared<ListValue>();
+
+                    for (const Group& group : groupBy(*traces, keyTypeArg(args, 0))) {
+                        list->elements.push_back(TupleValue::make({
+                            Value(group.key), number(group.size), number(group.count)
+                        }));
+                    }
+
+                    return Value(list);
+                }
+            ));
+
+            snapshot->setAttribute("compare_to", makeBuiltin(
+                "compare_to",
+                [traces](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+                    expectArgsRange(args, 1, 2, "compare_to");
+
+                    const QString keyType = keyTypeArg(args, 1);
+
+                    std::map<QString, Group> old;
+
+                    for (Group& group : groupBy(tracesOf(args[0]), keyType)) {
+                        old[group.key] = std::move(group);
+                    }
+
+                    struct Diff {
+                        Group now;
+                        std::int64_t sizeDiff;
+                        std::int64_t countDiff;
+                    };
+
+                    std::vector<Diff> diffs;
+
+                    for (Group& group : groupBy(*traces, keyType)) {
+
+                        const auto it = old.find(group.key);
+                        const Group before = it != old.end() ? it->second : Group{};
+
+                        if (it != old.end()) {
+                            old.erase(it);
+                        }
+
+                        const auto sizeDiff = static_cast<std::int64_t>(group.size) - static_cast<std::int64_t>(before.size);
+                        const auto countDiff = static_cast<std::int64_t>(group.count) - static_cast<std::int64_t>(before.count);
+                        diffs.push_back(Diff{std::move(group), sizeDiff, countDiff});
+                    }
+
+                    // группы, которых в новом снимке уже нет, освободились целиком
+                    for (auto& [key, group] : old) {
+                        diffs.push_back(Diff{Group{key, 0, 0},
+                                             -static_cast<std::int64_t>(group.size),
+                                             -static_cast<std::int64_t>(group.count)});
+                    }
+
+                    // порядок CPython: сначала наибольшее изменение размера
+                    std::stable_sort(diffs.begin(), diffs.end(), [](const Diff& a, const Diff& b) {
+                        return std::make_tuple(std::llabs(b.sizeDiff), b.now.size, std::llabs(b.countDiff), b.now.count) <
+                               std::make_tuple(std::llabs(a.sizeDiff), a.now.size, std::llabs(a.countDiff), a.now.count);
+                    });
+
+                    const auto list = std::make_shared<ListValue>();
+
+                    for (const Diff& diff : diffs) {
+                        list->elements.push_back(TupleValue::make({
+                            Value(diff.now.key), number(diff.now.size), number(diff.sizeDiff),
+                            number(diff.now.count), number(diff.countDiff)
+                        }));
+                    }
+
+                    return Value(list);
+                }
+            ));
+
+            return Value(snapshot);
+        }
+    ));
+
+    return Value(module);
+}
+
+void MemoryTracker::report() {
+
+    const std::vector<Trace> traces = collect();
+
+    OutputStream& err = OutputStream::standardError();
+    char text[64];
+
+    err.write(std::string_view("tracemalloc: live objects at exit\n"));
+
+    for (const QString keyType : {QString("type"), QString("lineno")}) {
+
+        std::snprintf(text, sizeof(text), "\n%12s %10s  ", "bytes", "count");
+        err.write(std::string_view(text));
+        err.write(keyType == "type" ? QString("type") : QString("line"));
+        err.write(std::string_view("\n"));
+
+        for (const Group& group : groupBy(traces, keyType)) {
+            std::snprintf(text, sizeof(text), "%12llu %10llu  ",
+                          static_cast<unsigned long long>(group.size), static_cast<unsigned long long>(group.count));
+            err.write(std::string_view(text));
+            err.write(group.key);
+            err.write(std::string_view("\n"));
+        }
+    }
+
+    err.flush();
+}
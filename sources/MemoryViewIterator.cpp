@@ -0,0 +1,24 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "MemoryViewIterator.h"
+
+#include "MemoryViewValue.h"
+#include "StopIterationException.h"
+
+Value MemoryViewIterator::next() {
+
+    if (!hasNext()) {
+        throw StopIterationException();
+    }
+
+    return view->item(index++);
+}
+
+bool MemoryViewIterator::hasNext() const {
+    return index < view->len();
+}
+
+QString MemoryViewIterator::getTypeName() const {
+    return "memory_iterator";
+}
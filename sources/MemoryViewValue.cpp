@@ -0,0 +1,527 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "MemoryViewValue.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassUtils.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "SharedSegment.h"
+#include "../runtime/ProtocolHelpers.h"
+
+namespace {
+
+    /// размер элемента формата struct; 0 — формат не поддерживается
+    qsizetype sizeOf(const char format) {
+
+        switch (format) {
+            case 'B': case 'b': case 'c': case '?':
+                return 1;
+            case 'H': case 'h':
+                return 2;
+            case 'I': case 'i': case 'f':
+                return 4;
+            case 'L': case 'l': case 'Q': case 'q': case 'N': case 'n': case 'd':
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+    bool isByteFormat(const char format) {
+        return format == 'B' || format == 'b' || format == 'c';
+    }
+
+    std::string formatName(const char format) {
+        return std::string(1, format);
+    }
+
+    template<typename T>
+    T load(const char* address) {
+        T value;
+        std::memcpy(&value, address, sizeof value);
+        return value;
+    }
+
+    template<typename T>
+    void store(char* address, const T value) {
+        std::memcpy(address, &value, sizeof value);
+    }
+
+    Value unpack(const char* address, const char format) {
+
+        switch (format) {
+            case 'B': return Value(Value::SmallInt(load<std::uint8_t>(address)));
+            case 'b': return Value(Value::SmallInt(load<std::int8_t>(address)));
+            case 'c': return Value(std::make_shared<BytesValue>(QByteArray(address, 1)));
+            case '?': return Value(*address != 0);
+            case 'H': return Value(Value::SmallInt(load<std::uint16_t>(address)));
+            case 'h': return Value(Value::SmallInt(load<std::int16_t>(address)));
+            case 'I': return Value(Value::SmallInt(load<std::uint32_t>(address)));
+            case 'i': return Value(Value::SmallInt(load<std::int32_t>(address)));
+            // беззнаковые 64 бита могут не уместиться в SmallInt
+            case 'L': case 'Q': case 'N': return Value(Value::BigInt(load<std::uint64_t>(address)));
+            case 'f': return Value(Value::Float(load<float>(address)));
+            case 'd': return Value(load<double>(address));
+            default:  return Value(Value::SmallInt(load<std::int64_t>(address)));
+        }
+    }
+
+    template<typename T>
+    void packInt(char* address, const Value::BigInt& value, const char format) {
+
+        if (value < Value::BigInt(std::numeric_limits<T>::min()) ||
+            value > Value::BigInt(std::numeric_limits<T>::max())) {
+            throw std::runtime_error("ValueError: memoryview: invalid value for format '" + formatName(format) + "'");
+        }
+
+        store(address, value.convert_to<T>());
+    }
+
+    void pack(char* address, const char format, const Value& value) {
+
+        const std::string invalidType = "TypeError: memoryview: invalid type for format '" + formatName(format) + "'";
+
+        if (format == 'c') {
+
+            if (!value.isBytes()) {
+                throw std::runtime_error(invalidType);
+            }
+
+            const QByteArray& bytes = value.asBytes()->bytes();
+
+            if (bytes.size() != 1) {
+                throw std::runtime_error("ValueError: memoryview: invalid value for format 'c'");
+            }
+
+            *address = bytes[0];
+            return;
+        }
+
+        if (format == '?') {
+            store<std::uint8_t>(address, value.toBool() ? 1 : 0);
+            return;
+        }
+
+        if (format == 'f' || format == 'd') {
+
+            if (!value.isNumeric()) {
+                throw std::runtime_error(invalidType);
+            }
+
+            if (format == 'f') {
+                store(address, static_cast<float>(value.toDouble()));
+            } else {
+                store(address, value.toDouble());
+            }
+
+            return;
+        }
+
+        if (!value.isBigInt() && !value.isBool()) {
+            throw std::runtime_error(invalidType);
+        }
+
+        const Value::BigInt integer = value.toBigInt();
+
+        switch (format) {
+            case 'B': packInt<std::uint8_t>(address, integer, format); break;
+            case 'b': packInt<std::int8_t>(address, integer, format); break;
+            case 'H': packInt<std::uint16_t>(address, integer, format); break;
+            case 'h': packInt<std::int16_t>(address, integer, format); break;
+            case 'I': packInt<std::uint32_t>(address, integer, format); break;
+            case 'i': packInt<std::int32_t>(address, integer, format); break;
+            case 'L': case 'Q': case 'N': packInt<std::uint64_t>(address, integer, format); break;
+            default:  packInt<std::int64_t>(address, integer, format); break;
+        }
+    }
+}
+
+MemoryViewValue::MemoryViewValue(const Value& source) : owner(source) {
+
+    if (const MemoryViewValue* view = of(source)) {
+
+        view->ensureAlive();
+
+        owner = view->owner;
+        buffer = view->buffer;
+        array = view->array;
+        offset = view->offset;
+        length = view->length;
+        stride = view->stride;
+        code = view->code;
+
+    } else if (source.isBytes()) {
+
+        buffer = &source.asBytes()->bytes();
+        length = buffer->size();
+
+    } else if (source.isByteArray()) {
+
+        array = source.asByteArray().get();
+        buffer = &array->bytes();
+        length = buffer->size();
+
+    } else if (const SharedBufferValue* shared = SharedBufferValue::of(source)) {
+
+        buffer = &shared->bytes();
+        length = buffer->size();
+
+    } else {
+        throw std::runtime_error(
+            "TypeError: memoryview: a bytes-like object is required, not '" + typeName(source).toStdString() + "'");
+    }
+
+    pin();
+}
+
+MemoryViewValue::MemoryViewValue(const MemoryViewValue& parent,
+                                 const qsizetype offset,
+                                 const qsizetype length,
+                                 const qsizetype stride,
+                                 const char format)
+    : owner(parent.owner),
+      buffer(parent.buffer),
+      array(parent.array),
+      offset(offset),
+      length(length),
+      stride(stride),
+      code(format) {
+
+    pin();
+}
+
+Value MemoryViewValue::over(const Value& source, const Layout& layout) {
+
+    auto view = std::make_shared<MemoryViewValue>(source);
+
+    const qsizetype size = sizeOf(layout.format);
+    const qsizetype available = view->buffer->size();
+
+    const auto inside = [&](const qsizetype position) {
+        return position >= 0 && position <= available - size;
+    };
+
+    // первый и последний элементы — внутри буфера; шаг проверяется делением, без переполнения
+    const bool valid = size > 0 && layout.length >= 0 && (layout.length == 0 || (
+        inside(layout.offset) && (layout.length == 1 || (
+            layout.stride != 0 &&
+            layout.length - 1 <= available / (layout.stride < 0 ? -layout.stride : layout.stride) &&
+            inside(layout.offset + (layout.length - 1) * layout.stride)))));
+
+    if (!valid) {
+        throw std::runtime_error("ValueError: memoryview layout is outside of its buffer");
+    }
+
+    view->offset = layout.offset;
+    view->length = layout.length;
+    view->stride = layout.stride;
+    view->code = layout.format;
+
+    return Value(view);
+}
+
+MemoryViewValue::~MemoryViewValue() {
+    release();
+}
+
+MemoryViewValue* MemoryViewValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<MemoryViewValue*>(object->get()) : nullptr;
+}
+
+void MemoryViewValue::pin() const {
+
+    if (array) {
+        array->exportBuffer();
+    }
+}
+
+void MemoryViewValue::release() {
+
+    if (released) {
+        return;
+    }
+
+    if (array) {
+        array->releaseBuffer();
+    }
+
+    released = true;
+}
+
+void MemoryViewValue::ensureAlive() const {
+
+    if (released) {
+        throw std::runtime_error("ValueError: operation forbidden on released memoryview object");
+    }
+}
+
+const char* MemoryViewValue::address(const qsizetype index) const {
+    return buffer->constData() + offset + index * stride;
+}
+
+QString MemoryViewValue::toString() const {
+
+    return QString(released ? "<released memory at 0x%1>" : "<memory at 0x%1>")
+        .arg(reinterpret_cast<quintptr>(this), 0, 16);
+}
+
+qsizetype MemoryViewValue::len() const {
+
+    ensureAlive();
+
+    return length;
+}
+
+Value MemoryViewValue::item(const qsizetype index) const {
+    return unpack(address(index), code);
+}
+
+Value MemoryViewValue::getItem(const Value& index) const {
+
+    ensureAlive();
+
+    if (index.isSlice()) {
+
+        const NormalizedSlice slice = normalizeSlice(*index.asSlice(), length);
+
+        return Value(std::shared_ptr<MemoryViewValue>(
+            new MemoryViewValue(*this, offset + slice.start * stride, sliceLength(slice), stride * slice.step, code)));
+    }
+
+    if (!index.isBigInt() && !index.isBool()) {
+        throw std::runtime_error("TypeError: memoryview: invalid slice key");
+    }
+
+    Value::BigInt position = index.toBigInt();
+
+    if (position < 0) {
+        position += length;
+    }
+
+    if (position < 0 || position >= length) {
+        throw std::runtime_error("IndexError: index out of bounds on dimension 1");
+    }
+
+    return item(position.convert_to<qsizetype>());
+}
+
+void MemoryViewValue::setItem(const Value& index, const Value& value) {
+
+    ensureAlive();
+
+    if (!array) {
+        throw std::runtime_error("TypeError: cannot modify read-only memory");
+    }
+
+    const qsizetype size = itemSize();
+
+    if (index.isSlice()) {
+
+        const NormalizedSlice slice = normalizeSlice(*index.asSlice(), length);
+        const long long count = sliceLength(slice);
+
+        const MemoryViewValue source(value);
+
+        if (source.code != code || source.length != count) {
+            throw std::runtime_error("ValueError: memoryview assignment: lvalue and rvalue have different structures");
+        }
+
+        // копия нужна, если источник перекрывается с приёмником: mv[1:] = mv[:-1]
+        const QByteArray bytes = source.toBytes();
+        char* data = array->bytes().data();
+
+        for (long long k = 0; k < count; ++k) {
+            std::memcpy(data + offset + (slice.start + k * slice.step) * stride, bytes.constData() + k * size, size);
+        }
+
+        return;
+    }
+
+    if (!index.isBigInt() && !index.isBool()) {
+        throw std::runtime_error("TypeError: memoryview: invalid slice key");
+    }
+
+    Value::BigInt position = index.toBigInt();
+
+    if (position < 0) {
+        position += length;
+    }
+
+    if (position < 0 || position >= length) {
+        throw std::runtime_error("IndexError: index out of bounds on dimension 1");
+    }
+
+    pack(array->bytes().data() + offset + position.convert_to<qsizetype>() * stride, code, value);
+}
+
+bool MemoryViewValue::equal(const Value& other) const {
+
+    const MemoryViewValue* view = of(other);
+
+    if (view == this) {
+        return true;
+    }
+
+    if (released || (view && view->released) || (!view && !other.isBytes() && !other.isByteArray())) {
+        return false;
+    }
+
+    const MemoryViewValue theirs(other);
+
+    if (theirs.length != length) {
+        return false;
+    }
+
+    // один целочисленный формат — элементы равны, когда равны их байты; NaN требует сравнения чисел
+    const bool bytewise = theirs.code == code && code != 'f' && code != 'd';
+
+    for (qsizetype i = 0; i < length; ++i) {
+
+        const bool same = bytewise
+            ? std::memcmp(address(i), theirs.address(i), itemSize()) == 0
+            : item(i) == theirs.item(i);
+
+        if (!same) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MemoryViewValue::notEqual(const Value& other) const {
+    return !equal(other);
+}
+
+QByteArrayView MemoryViewValue::view() const {
+
+    ensureAlive();
+
+    return {address(0), nbytes()};
+}
+
+QByteArray MemoryViewValue::toBytes() const {
+
+    ensureAlive();
+
+    if (contiguous()) {
+        return {address(0), nbytes()};
+    }
+
+    const qsizetype size = itemSize();
+
+    QByteArray result;
+    result.reserve(nbytes());
+
+    for (qsizetype i = 0; i < length; ++i) {
+        result.append(address(i), size);
+    }
+
+    return result;
+}
+
+Value MemoryViewValue::toList() const {
+
+    ensureAlive();
+
+    std::vector<Value> items;
+    items.reserve(length);
+
+    for (qsizetype i = 0; i < length; ++i) {
+        items.push_back(item(i));
+    }
+
+    return Value(makePooled<ListValue>(std::move(items)));
+}
+
+Value MemoryViewValue::cast(const QString& format) const {
+
+    ensureAlive();
+
+    const QString name = format.startsWith('@') ? format.mid(1) : format;
+    const char target = name.size() == 1 ? name[0].toLatin1() : '\0';
+    const qsizetype size = sizeOf(target);
+
+    if (size == 0) {
+        throw std::runtime_error(
+            "ValueError: memoryview: destination format must be a native single character format prefixed with an optional '@'");
+    }
+
+    if (!contiguous()) {
+        throw std::runtime_error("TypeError: memoryview: casts are restricted to C-contiguous views");
+    }
+
+    if (!isByteFormat(code) && !isByteFormat(target)) {
+        throw std::runtime_error("TypeError: memoryview: cannot cast between two non-byte formats");
+    }
+
+    if (nbytes() % size != 0) {
+        throw std::runtime_error("TypeError: memoryview: length is not a multiple of itemsize");
+    }
+
+    return Value(std::shared_ptr<MemoryViewValue>(
+        new MemoryViewValue(*this, offset, nbytes() / size, size, target)));
+}
+
+const Value& MemoryViewValue::object() const {
+
+    ensureAlive();
+
+    return owner;
+}
+
+MemoryViewValue::Layout MemoryViewValue::layout() const {
+
+    ensureAlive();
+
+    return {offset, length, stride, code};
+}
+
+bool MemoryViewValue::readOnly() const {
+
+    ensureAlive();
+
+    return array == nullptr;
+}
+
+bool MemoryViewValue::contiguous() const {
+
+    ensureAlive();
+
+    return length <= 1 || stride == itemSize();
+}
+
+qsizetype MemoryViewValue::nbytes() const {
+
+    ensureAlive();
+
+    return length * itemSize();
+}
+
+qsizetype MemoryViewValue::itemSize() const {
+    return sizeOf(code);
+}
+
+qsizetype MemoryViewValue::strides() const {
+
+    ensureAlive();
+
+    return stride;
+}
+
+QString MemoryViewValue::format() const {
+
+    ensureAlive();
+
+    return QString(QChar(code));
+}
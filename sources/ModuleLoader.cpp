@@ -0,0 +1,308 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ModuleLoader.h"
+
+#include <algorithm>
+
+#include <QDir>
+#include <QFileInfo>
+
+#include "ClassUtils.h"
+#include "Compiler.h"
+#include "DictValue.h"
+#include "Environment.h"
+#include "ListValue.h"
+#include "ModuleValue.h"
+#include "Parser.h"
+#include "Profiler.h"
+#include "StrValue.h"
+#include "TupleValue.h"
+#include "TokenCache.h"
+#include "Tracer.h"
+#include "VirtualMachine.h"
+
+namespace {
+
+    /// модуль выполняется без вывода результатов выражений, даже если его импортировали из REPL
+    class QuietCompilation {
+    public:
+        QuietCompilation() : saved(Compiler::echoResults) {
+            Compiler::echoResults = false;
+        }
+
+        ~QuietCompilation() {
+            Compiler::echoResults = saved;
+        }
+
+        QuietCompilation(const QuietCompilation&) = delete;
+        QuietCompilation& operator=(const QuietCompilation&) = delete;
+
+    private:
+        bool saved;
+    };
+
+    const std::shared_ptr<DictValue>& moduleTable() {
+        static const auto table = std::make_shared<DictValue>();
+        return table;
+    }
+
+    [[noreturn]] void notFound(const QString& name) {
+        throw std::runtime_error("ModuleNotFoundError: No module named '" + name.toStdString() + "'");
+    }
+}
+
+void ModuleLoader::initialize(const std::shared_ptr<Environment>& builtins, const QString& scriptDir) {
+
+    ModuleLoader::builtins = builtins;
+
+    // повторная инициализация (каждый EmbeddedInterpreter) не удлиняет sys.path
+    std::vector<Value>& dirs = path().asList()->elements.mutate();
+    const Value dir(scriptDir);
+
+    if (std::none_of(dirs.begin(), dirs.end(), [&](const Value& entry) { return entry == dir; })) {
+        dirs.push_back(dir);
+    }
+
+    // встроенные модули уже созданы как глобальные имена: `import sys` берёт их же
+    for (const QString& name : {QString("sys"), QString("gc"), QString("tracemalloc"),
+                                QString("binascii"), QString("base64"), QString("collections"),
+                                QString("struct"), QString("array"), QString("vecmath"),
+                                QString("asyncio"), QString("functools"),
+                                QString("heapq"), QString("bisect"), QString("json"),
+                                QString("marshal"), QString("re"), QString("io"),
+                                QString("time"), QString("timeit"), QString("sharedmem")}) {
+        moduleTable()->setItem(Value(name), builtins->get(name));
+    }
+}
+
+std::shared_ptr<Environment> ModuleLoader::makeGlobals(const QString& name) {
+
+    auto globals = std::make_shared<Environment>(builtins);
+    globals->moduleScope = true;
+    globals->set("__name__", Value(name));
+
+    return globals;
+}
+
+const Value& ModuleLoader::modules() {
+    static const Value value(moduleTable());
+    return value;
+}
+
+const Value& ModuleLoader::path() {
+    static const Value value(std::make_shared<ListValue>());
+    return value;
+}
+
+std::optional<Value> ModuleLoader::cached(const QString& name) {
+
+    if (const Value* module = moduleTable()->find(Value(name))) {
+        return *module;
+    }
+
+    return std::nullopt;
+}
+
+Value ModuleLoader::importModule(const QString& name) {
+
+    if (std::optional<Value> module = cached(name)) {
+        return std::move(*module);
+    }
+
+    const qsizetype dot = name.lastIndexOf(u'.');
+
+    if (dot >= 0) {
+
+        const Value parent = importModule(name.left(dot));
+        const ModuleValue* package = ModuleValue::of(parent);
+
+        if (!package || package->searchDir().isEmpty()) {
+            throw std::runtime_error("ModuleNotFoundError: No module named '" + name.toStdString() +
+                                     "'; '" + name.left(dot).toStdString() + "' is not a package");
+        }
+
+        if (std::optional<Value> module = importSubmodule(*package, name.mid(dot + 1))) {
+            return std::move(*module);
+        }
+
+        notFound(name);
+    }
+
+    // снимок sys.path: общий буфер, без копирования элементов
+    const CowVector<Value> dirs = path().asList()->elements;
+
+    for (const Value& entry : dirs) {
+
+        if (!entry.isString()) {
+            continue;
+        }
+
+        const QString dir = entry.asString()->toString();
+
+        if (std::optional<Value> module = loadFrom(dir.isEmpty() ? QString(".") : dir, name, name)) {
+            return std::move(*module);
+        }
+    }
+
+    notFound(name);
+}
+
+std::optional<Value> ModuleLoader::importSubmodule(const ModuleValue& package, const QString& name) {
+
+    const QString fullName = package.moduleName() + "." + name;
+
+    if (std::optional<Value> module = cached(fullName)) {
+        return module;
+    }
+
+    std::optional<Value> module = loadFrom(package.searchDir(), name, fullName);
+
+    // загруженный подмодуль становится атрибутом пакета
+    if (module) {
+        package.setAttr(name, *module);
+    }
+
+    return module;
+}
+
+std::optional<Value> ModuleLoader::loadFrom(const QString& dir, const QString& name, const QString& fullName) {
+
+    const QDir base(dir);
+
+    if (const QString init = base.filePath(name + "/__init__.py"); QFileInfo::exists(init)) {
+        return load(fullName, QFileInfo(init).absoluteFilePath(), QFileInfo(base.filePath(name)).absoluteFilePath());
+    }
+
+    if (const QString file = base.filePath(name + ".py"); QFileInfo::exists(file)) {
+        return load(fullName, QFileInfo(file).absoluteFilePath(), {});
+    }
+
+    return std::nullopt;
+}
+
+Value ModuleLoader::load(const QString& name, const QString& file, const QString& packageDir) {
+
+    QFile source(file);
+
+    if (!source.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error("ImportError: can't open module file '" + file.toStdString() + "': " +
+                                 source.errorString().toStdString());
+    }
+
+    const QVector<Token> tokens = readTokens(source);
+    source.close();
+
+    const auto globals = makeGlobals(name);
+    globals->set("__file__", Value(file));
+    // пакет, от которого разрешается относительный импорт: сам пакет или пакет модуля
+    globals->set("__package__", Value(packageDir.isEmpty() ? name.section(u'.', 0, -2) : name));
+
+    const Value module(std::make_shared<ModuleValue>(name, file, globals, packageDir));
+
+    // модуль виден в sys.modules до выполнения своего кода — так работает циклический импорт
+    const Value key(name);
+    moduleTable()->setItem(key, module);
+
+    try {
+
+        const QuietCompilation quiet;
+        const Profiler::Frame frame("<module " + name + ">");
+
+        Parser parser(tokens);
+        const auto code = Compiler::compileModule(parser.parseModule());
+
+        const Tracer::Frame trace(*code, file);
+        VirtualMachine::run(*code, globals);
+
+    } catch (...) {
+        moduleTable()->pop(key);
+        throw;
+    }
+
+    return module;
+}
+
+Value ModuleLoader::importFrom(const Value& module, const QString& name) {
+
+    if (const ModuleValue* source = ModuleValue::of(module)) {
+
+        if (std::optional<Value> value = source->findAttr(name)) {
+            return std::move(*value);
+        }
+
+        throw std::runtime_error("ImportError: cannot import name '" + name.toStdString() + "' from '" +
+                                 source->moduleName().toStdString() + "' (" + source->fileName().toStdString() + ")");
+    }
+
+    // встроенные модули sys и gc — объекты с атрибутами
+    if (std::optional<Value> value = tryGetAttr(module, name)) {
+        return std::move(*value);
+    }
+
+    throw std::runtime_error("ImportError: cannot import name '" + name.toStdString() + "'");
+}
+
+void ModuleLoader::importStar(const Value& module, const std::shared_ptr<Environment>& env) {
+
+    const ModuleValue* source = ModuleValue::of(module);
+
+    if (!source) {
+        throw std::runtime_error("ImportError: 'import *' is supported only for module files");
+    }
+
+    if (const Value* all = source->globals()->findLocal("__all__")) {
+
+        if (!all->isList() && !all->isTuple()) {
+            throw std::runtime_error("TypeError: __all__ must be a list or tuple of str");
+        }
+
+        // копия: импорт подмодуля может изменить __all__
+        const std::vector<Value> names = all->isList() ? all->asList()->elements.get() : all->asTuple()->items;
+
+        for (const Value& name : names) {
+            env->set(name.toString(), importFrom(module, name.toString()));
+        }
+
+        return;
+    }
+
+    source->globals()->forEachLocal([&](const QString& name, const Value& value) {
+        if (!name.startsWith(u'_')) {
+            env->set(name, value);
+        }
+    });
+}
+
+QVector<Token> ModuleLoader::readTokens(QFile& file) {
+
+    const qint64 size = file.size();
+    const qint64 mtime = QFileInfo(file).lastModified().toMSecsSinceEpoch();
+
+    // пустой файл или устройство без отображения в память читаются обычным способом
+    QByteArray buffer;
+    const uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+
+    if (!mapped) {
+        buffer = file.readAll();
+    }
+
+    const char* bytes = mapped ? reinterpret_cast<const char*>(mapped) : buffer.constData();
+    const qint64 length = mapped ? size : buffer.size();
+    const std::uint64_t hash = TokenCache::hashSource(bytes, length);
+    const QString path = file.fileName();
+
+    std::optional<QVector<Token>> tokens = TokenCache::load(path, mtime, length, hash);
+
+    if (!tokens) {
+        Lexer lexer;
+        tokens = lexer.tokenize(std::string_view(bytes, static_cast<std::size_t>(length)));
+        TokenCache::store(path, mtime, length, hash, *tokens);
+    }
+
+    if (mapped) {
+        file.unmap(const_cast<uchar*>(mapped));
+    }
+
+    return std::move(*tokens);
+}
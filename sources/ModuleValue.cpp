@@ -0,0 +1,42 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ModuleValue.h"
+
+#include "Environment.h"
+#include "ModuleLoader.h"
+
+ModuleValue::ModuleValue(QString name, QString file, std::shared_ptr<Environment> globals, QString packageDir)
+    : name(std::move(name)),
+      file(std::move(file)),
+      env(std::move(globals)),
+      packageDir(std::move(packageDir)) {}
+
+ModuleValue* ModuleValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<ModuleValue*>(object->get()) : nullptr;
+}
+
+QString ModuleValue::toString() const {
+    return QString("<module '%1' from '%2'>").arg(name, file);
+}
+
+std::optional<Value> ModuleValue::findAttr(const QString& attr) const {
+
+    if (const Value* value = env->findLocal(attr)) {
+        return *value;
+    }
+
+    if (packageDir.isEmpty()) {
+        return std::nullopt;
+    }
+
+    // подмодуль пакета загружается при первом обращении
+    return ModuleLoader::importSubmodule(*this, attr);
+}
+
+void ModuleValue::setAttr(const QString& attr, Value value) const {
+    env->set(attr, std::move(value));
+}
@@ -0,0 +1,64 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ObjectPool.h"
+
+ObjectPool::State& ObjectPool::state() {
+    // намеренно не разрушается: см. описание класса
+    static auto* pool = new State();
+    return *pool;
+}
+
+void ObjectPool::refill(const std::size_t index) {
+
+    const std::size_t blockSize = (index + 1) * granularity;
+    const std::size_t blockCount = chunkSize / blockSize;
+
+    auto* chunk = static_cast<std::byte*>(::operator new(blockSize * blockCount));
+    state().chunks.push_back(chunk);
+
+    FreeBlock*& head = state().freeLists[index];
+
+    for (std::size_t i = blockCount; i-- > 0;) {
+        auto* block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+        block->next = head;
+        head = block;
+    }
+}
+
+void* ObjectPool::allocate(const std::size_t size) {
+
+    if (size == 0 || size > maxBlockSize) {
+        return ::operator new(size);
+    }
+
+    const std::size_t index = classIndex(size);
+    FreeBlock*& head = state().freeLists[index];
+
+    if (!head) {
+        refill(index);
+    }
+
+    FreeBlock* block = head;
+    head = block->next;
+
+    return block;
+}
+
+void ObjectPool::deallocate(void* block, const std::size_t size) noexcept {
+
+    if (!block) {
+        return;
+    }
+
+    if (size == 0 || size > maxBlockSize) {
+        ::operator delete(block);
+        return;
+    }
+
+    auto* freed = static_cast<FreeBlock*>(block);
+    FreeBlock*& head = state().freeLists[classIndex(size)];
+
+    freed->next = head;
+    head = freed;
+}
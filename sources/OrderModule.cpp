@@ -0,0 +1,465 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "OrderModule.h"
+
+#include <algorithm>
+
+#include "CallRuntime.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "StrValue.h"
+#include "TupleValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    /// `a < b`; два int, два float и две строки — без разбора типов в Value::operator<
+    bool less(const Value& a, const Value& b) {
+
+        if (const auto x = std::get_if<Value::SmallInt>(&a.data)) {
+            if (const auto y = std::get_if<Value::SmallInt>(&b.data)) {
+                return *x < *y;
+            }
+        } else if (const auto x = std::get_if<Value::Float>(&a.data)) {
+            if (const auto y = std::get_if<Value::Float>(&b.data)) {
+                return *x < *y;
+            }
+        } else if (const auto x = std::get_if<Value::StrPtr>(&a.data)) {
+            if (const auto y = std::get_if<Value::StrPtr>(&b.data)) {
+                return (*x)->view() < (*y)->view();
+            }
+        }
+
+        // `__lt__` может изменить список, из которого взяты операнды: сравниваются копии
+        const Value left = a;
+        const Value right = b;
+
+        return left < right;
+    }
+
+    qsizetype toIndex(const Value& value) {
+
+        if (!value.isBigInt() && !value.isBool()) {
+            throw std::runtime_error(
+                "TypeError: '" + typeName(value).toStdString() + "' object cannot be interpreted as an integer");
+        }
+
+        return value.toBigInt().convert_to<qsizetype>();
+    }
+
+    ListValue& heapOf(const Value& value) {
+
+        const auto list = std::get_if<Value::ListPtr>(&value.data);
+
+        if (!list) {
+            throw std::runtime_error("TypeError: heap argument must be a list");
+        }
+
+        return **list;
+    }
+
+    /**
+     * Просеивание по массиву списка, как в _heapqmodule.c: элементы меняются
+     * местами, поэтому исключение в сравнении оставляет в списке перестановку
+     * тех же элементов. Сравнение, изменившее длину списка, — RuntimeError.
+     */
+    class Heap {
+    public:
+        explicit Heap(std::vector<Value>& items) : items(items), size(items.size()) {}
+
+        /// поднимает элемент pos к корню, не выше start
+        void siftDown(const std::size_t start, std::size_t pos) {
+
+            while (pos > start) {
+
+                const std::size_t parent = (pos - 1) >> 1;
+
+                if (!before(items[pos], items[parent])) {
+                    break;
+                }
+
+                std::swap(items[pos], items[parent]);
+                pos = parent;
+            }
+        }
+
+        /// опускает элемент pos до листа по меньшим детям, затем поднимает на место
+        void siftUp(std::size_t pos) {
+
+            const std::size_t start = pos;
+            const std::size_t limit = size >> 1;
+
+            while (pos < limit) {
+
+                std::size_t child = 2 * pos + 1;
+
+                if (child + 1 < size && !before(items[child], items[child + 1])) {
+                    ++child;
+                }
+
+                std::swap(items[pos], items[child]);
+                pos = child;
+            }
+
+            siftDown(start, pos);
+        }
+
+    private:
+        bool before(const Value& a, const Value& b) const {
+
+            const bool result = less(a, b);
+
+            if (items.size() != size) {
+                throw std::runtime_error("RuntimeError: list changed size during iteration");
+            }
+
+            return result;
+        }
+
+        std::vector<Value>& items;
+        std::size_t size;
+    };
+
+    /// n первых элементов в порядке sorted(iterable, key=key, reverse=largest)
+    Value selectFirst(const std::vector<Value>& args, const Kwargs& kwargs,
+                      const std::shared_ptr<Environment>& env, const bool largest) {
+
+        const QString name = largest ? "nlargest" : "nsmallest";
+
+        expectArgsRange(args, 2, 3, name);
+
+        std::optional<Value> key;
+
+        if (args.size() == 3 && !args[2].isNone()) {
+            key = args[2];
+        }
+
+        for (const auto& [kwarg, value] : kwargs) {
+
+            if (kwarg != "key") {
+                throw std::runtime_error(
+                    "TypeError: " + name.toStdString() + "() got an unexpected keyword argument '" + kwarg.toStdString() + "'");
+            }
+
+            key = value.isNone() ? std::nullopt : std::optional(value);
+        }
+
+        const qsizetype n = toIndex(args[0]);
+
+        // ключ, номер в исходном порядке, элемент; номер делает частичную сортировку устойчивой
+        struct Ranked {
+            Value key;
+            std::size_t order;
+            Value item;
+        };
+
+        std::vector<Ranked> ranked;
+        const Value iterator = getIter(args[1], env);
+
+        for (Value item; iterNext(iterator, item, env);) {
+            Value rank = key ? call(*key, {item}, {}, env) : item;
+            ranked.push_back({std::move(rank), ranked.size(), std::move(item)});
+        }
+
+        const std::size_t count = n <= 0 ? 0 : std::min<std::size_t>(n, ranked.size());
+
+        std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(count), ranked.end(),
+                          [largest](const Ranked& a, const Ranked& b) {
+                              if (largest ? less(b.key, a.key) : less(a.key, b.key)) {
+                                  return true;
+                              }
+                              return !(largest ? less(a.key, b.key) : less(b.key, a.key)) && a.order < b.order;
+                          });
+
+        const auto result = makePooled<ListValue>();
+        result->elements.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            result->elements.push_back(std::move(ranked[i].item));
+        }
+
+        return Value(result);
+    }
+
+    struct BisectArgs {
+        Value sequence;
+        Value x;
+        qsizetype lo = 0;
+        std::optional<qsizetype> hi;
+        std::optional<Value> key;
+    };
+
+    BisectArgs parseBisect(const std::vector<Value>& args, const Kwargs& kwargs, const QString& name) {
+
+        expectArgsRange(args, 0, 4, name);
+
+        BisectArgs parsed;
+        const Value* sequence = !args.empty() ? &args[0] : nullptr;
+        const Value* x = args.size() > 1 ? &args[1] : nullptr;
+        const Value* lo = args.size() > 2 ? &args[2] : nullptr;
+        const Value* hi = args.size() > 3 ? &args[3] : nullptr;
+
+        for (const auto& [kwarg, value] : kwargs) {
+
+            if (kwarg == "a") {
+                sequence = &value;
+            } else if (kwarg == "x") {
+                x = &value;
+            } else if (kwarg == "lo") {
+                lo = &value;
+            } else if (kwarg == "hi") {
+                hi = &value;
+            } else if (kwarg == "key") {
+                parsed.key = value.isNone() ? std::nullopt : std::optional(value);
+            } else {
+                throw std::runtime_error(
+                    "TypeError: " + name.toStdString() + "() got an unexpected keyword argument '" + kwarg.toStdString() + "'");
+            }
+        }
+
+        if (!sequence || !x) {
+            throw std::runtime_error(
+                "TypeError: " + name.toStdString() + "() missing required argument '" + (sequence ? "x" : "a") + "'");
+        }
+
+        parsed.sequence = *sequence;
+        parsed.x = *x;
+        parsed.lo = lo ? toIndex(*lo) : 0;
+
+        if (parsed.lo < 0) {
+            throw std::runtime_error("ValueError: lo must be non-negative");
+        }
+
+        // hi=-1, как и в CPython, означает конец последовательности
+        if (hi && !hi->isNone() && toIndex(*hi) != -1) {
+            parsed.hi = toIndex(*hi);
+        }
+
+        return parsed;
+    }
+
+    /// точка вставки x; right — правее равных. Ключ вызывается для элементов, но не для x
+    qsizetype search(const BisectArgs& args, const Value& x, const bool right, const std::shared_ptr<Environment>& env) {
+
+        const std::vector<Value>* items = nullptr;
+
+        if (const auto list = std::get_if<Value::ListPtr>(&args.sequence.data)) {
+            items = &(*list)->elements.get();
+        } else if (const auto tuple = std::get_if<Value::TuplePtr>(&args.sequence.data)) {
+            items = &(*tuple)->items;
+        }
+
+        const auto itemAt = [&](const qsizetype index) -> Value {
+
+            if (!items) {
+                return getSubscript(args.sequence, Value(Value::SmallInt(index)), env);
+            }
+
+            // ключ или `__lt__` мог укоротить список
+            if (index >= static_cast<qsizetype>(items->size())) {
+                throw std::runtime_error("IndexError: list index out of range");
+            }
+
+            return (*items)[index];
+        };
+
+        qsizetype lo = args.lo;
+        qsizetype hi = args.hi ? *args.hi
+                     : items ? static_cast<qsizetype>(items->size())
+                     : toIndex(callMethod(args.sequence, "__len__", {}, {}, env));
+
+        while (lo < hi) {
+
+            const qsizetype mid = lo + (hi - lo) / 2;
+            const Value item = args.key ? call(*args.key, {itemAt(mid)}, {}, env) : itemAt(mid);
+
+            if (right ? less(x, item) : !less(item, x)) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+
+        return lo;
+    }
+}
+
+Value OrderModule::makeHeapq() {
+
+    const auto module = std::make_shared<ClassValue>("heapq");
+
+    module->setAttribute("heappush", makeBuiltin(
+        "heappush",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 2, "heappush");
+
+            ListValue& heap = heapOf(args[0]);
+            heap.append(args[1]);
+
+            Heap(heap.elements.mutate()).siftDown(0, heap.elements.size() - 1);
+
+            return {};
+        }
+    ));
+
+    module->setAttribute("heappop", makeBuiltin(
+        "heappop",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "heappop");
+
+            ListValue& heap = heapOf(args[0]);
+
+            if (heap.elements.empty()) {
+                throw std::runtime_error("IndexError: index out of range");
+            }
+
+            Value last = heap.pop();
+
+            if (heap.elements.empty()) {
+                return last;
+            }
+
+            std::swap(last, heap.elements.front());
+            Heap(heap.elements.mutate()).siftUp(0);
+
+            return last;
+        }
+    ));
+
+    module->setAttribute("heapify", makeBuiltin(
+        "heapify",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "heapify");
+
+            ListValue& heap = heapOf(args[0]);
+            Heap sifter(heap.elements.mutate());
+
+            for (std::size_t i = heap.elements.size() / 2; i-- > 0;) {
+                sifter.siftUp(i);
+            }
+
+            return {};
+        }
+    ));
+
+    module->setAttribute("heappushpop", makeBuiltin(
+        "heappushpop",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 2, "heappushpop");
+
+            ListValue& heap = heapOf(args[0]);
+            Value item = args[1];
+
+            // вершина не меньше item: item и вернулся бы первым
+            if (heap.elements.empty() || !less(heap.elements.front(), item)) {
+                return item;
+            }
+
+            // `__lt__` мог опустошить список
+            if (heap.elements.empty()) {
+                throw std::runtime_error("IndexError: index out of range");
+            }
+
+            std::swap(item, heap.elements.front());
+            Heap(heap.elements.mutate()).siftUp(0);
+
+            return item;
+        }
+    ));
+
+    module->setAttribute("heapreplace", makeBuiltin(
+        "heapreplace",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 2, "heapreplace");
+
+            ListValue& heap = heapOf(args[0]);
+
+            if (heap.elements.empty()) {
+                throw std::runtime_error("IndexError: index out of range");
+            }
+
+            Value item = args[1];
+
+            std::swap(item, heap.elements.front());
+            Heap(heap.elements.mutate()).siftUp(0);
+
+            return item;
+        }
+    ));
+
+    module->setAttribute("nsmallest", makeBuiltin(
+        "nsmallest",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) {
+            return selectFirst(args, kwargs, env, false);
+        }
+    ));
+
+    module->setAttribute("nlargest", makeBuiltin(
+        "nlargest",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) {
+            return selectFirst(args, kwargs, env, true);
+        }
+    ));
+
+    return Value(module);
+}
+
+Value OrderModule::makeBisect() {
+
+    const auto module = std::make_shared<ClassValue>("bisect");
+
+    for (const auto& [name, right] : {std::pair{QString("bisect_left"), false},
+                                      std::pair{QString("bisect_right"), true},
+                                      std::pair{QString("bisect"), true}}) {
+
+        module->setAttribute(name, makeBuiltin(
+            name,
+            [name = name, right = right](const std::vector<Value>& args,
+                                         const Kwargs& kwargs,
+                                         const std::shared_ptr<Environment>& env) -> Value {
+
+                const BisectArgs parsed = parseBisect(args, kwargs, name);
+
+                return Value(Value::SmallInt(search(parsed, parsed.x, right, env)));
+            }
+        ));
+    }
+
+    for (const auto& [name, right] : {std::pair{QString("insort_left"), false},
+                                      std::pair{QString("insort_right"), true},
+                                      std::pair{QString("insort"), true}}) {
+
+        module->setAttribute(name, makeBuiltin(
+            name,
+            [name = name, right = right](const std::vector<Value>& args,
+                                         const Kwargs& kwargs,
+                                         const std::shared_ptr<Environment>& env) -> Value {
+
+                const BisectArgs parsed = parseBisect(args, kwargs, name);
+
+                // ключ x вычисляется один раз, вставляется сам x
+                const Value probe = parsed.key ? call(*parsed.key, {parsed.x}, {}, env) : parsed.x;
+                const Value position(Value::SmallInt(search(parsed, probe, right, env)));
+
+                if (const auto list = std::get_if<Value::ListPtr>(&parsed.sequence.data)) {
+                    (*list)->insert(position, parsed.x);
+                } else {
+                    callMethod(parsed.sequence, "insert", {position, parsed.x}, {}, env);
+                }
+
+                return {};
+            }
+        ));
+    }
+
+    return Value(module);
+}
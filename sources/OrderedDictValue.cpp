@@ -0,0 +1,63 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "OrderedDictValue.h"
+
+#include <algorithm>
+
+OrderedDictValue* OrderedDictValue::of(const Value& value) {
+
+    const auto dict = std::get_if<Value::DictPtr>(&value.data);
+
+    return dict ? dynamic_cast<OrderedDictValue*>(dict->get()) : nullptr;
+}
+
+QString OrderedDictValue::toString() const {
+
+    if (len() == 0) {
+        return "OrderedDict()";
+    }
+
+    QString out = "OrderedDict([";
+    bool first = true;
+
+    forEachItem([&](const Value& key, const Value& value) {
+
+        if (!first) {
+            out += ", ";
+        }
+
+        first = false;
+        out += "(" + key.repr() + ", " + value.repr() + ")";
+    });
+
+    return out + "])";
+}
+
+Value OrderedDictValue::copy() const {
+    return Value(std::static_pointer_cast<DictValue>(std::make_shared<OrderedDictValue>(*this)));
+}
+
+bool OrderedDictValue::equal(const Value& other) const {
+
+    const OrderedDictValue* rhs = of(other);
+
+    if (!DictValue::equal(other)) {
+        return false;
+    }
+
+    if (!rhs) {
+        return true;
+    }
+
+    // те же пары — остаётся сверить порядок ключей
+    const QVector<Value> left = getOrder();
+    const QVector<Value> right = rhs->getOrder();
+
+    return std::equal(left.begin(), left.end(), right.begin(),
+                      [](const Value& a, const Value& b) { return a.keyEquals(b); });
+}
+
+bool OrderedDictValue::notEqual(const Value& other) const {
+    return !equal(other);
+}
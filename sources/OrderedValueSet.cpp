@@ -0,0 +1,264 @@
+//
+// Created by semyo on 14.10.2026.
+//
+#include "OrderedValueSet.h"
+
+#include <algorithm>
+
+#include "FrozenSetValue.h"
+#include "IteratorValue.h"
+#include "SetValue.h"
+
+std::ptrdiff_t OrderedValueSet::lookup(const Value& value, const std::size_t hash) const {
+
+    if (indices.empty()) {
+
+        for (std::size_t ix = head; ix < entries.size(); ++ix) {
+
+            if (entries[ix].live && entries[ix].hash == hash && entries[ix].value.keyEquals(value)) {
+                return static_cast<std::ptrdiff_t>(ix);
+            }
+        }
+
+        return -1;
+    }
+
+    const std::size_t mask = indices.size() - 1;
+    std::size_t perturb = hash;
+    std::size_t i = hash & mask;
+
+    while (true) {
+
+        const std::int32_t ix = indices[i];
+
+        if (ix == EMPTY) {
+            return -1;
+        }
+
+        if (ix >= 0 && entries[ix].hash == hash && entries[ix].value.keyEquals(value)) {
+            return ix;
+        }
+
+        perturb >>= 5;
+        i = (i * 5 + perturb + 1) & mask;
+    }
+}
+
+bool OrderedValueSet::insert(const Value& value) {
+
+    const std::size_t hash = qHash(value);
+
+    if (lookup(value, hash) >= 0) {
+        return false;
+    }
+
+    if (indices.empty()) {
+
+        if (entries.size() == SMALL_SIZE) {
+            rebuild();
+        }
+
+        if (indices.empty()) {
+
+            std::vector<Entry>& own = entries.mutate();
+
+            if (own.capacity() == 0) {
+                own.reserve(SMALL_SIZE / 2);
+            }
+
+            own.push_back(Entry{hash, value, true});
+            ++used;
+
+            return true;
+        }
+    }
+
+    if (std::max(fill, entries.size()) + 1 > indices.size() * 2 / 3) {
+        rebuild();
+    }
+
+    // общие с другой копией буферы отделяются один раз, а не на каждом шаге пробы
+    std::vector<std::int32_t>& slots = indices.mutate();
+    std::vector<Entry>& own = entries.mutate();
+
+    const std::size_t mask = slots.size() - 1;
+    std::size_t perturb = hash;
+    std::size_t i = hash & mask;
+
+    while (slots[i] >= 0) {
+        perturb >>= 5;
+        i = (i * 5 + perturb + 1) & mask;
+    }
+
+    if (slots[i] == EMPTY) {
+        ++fill;
+    }
+
+    slots[i] = static_cast<std::int32_t>(own.size());
+    own.push_back(Entry{hash, value, true});
+
+    ++used;
+
+    return true;
+}
+
+bool OrderedValueSet::remove(const Value& value) {
+
+    const std::ptrdiff_t ix = lookup(value, qHash(value));
+
+    if (ix < 0) {
+        return false;
+    }
+
+    removeAt(ix);
+
+    return true;
+}
+
+void OrderedValueSet::removeAt(const std::ptrdiff_t ix) {
+
+    std::vector<Entry>& own = entries.mutate();
+
+    if (!indices.empty()) {
+
+        std::vector<std::int32_t>& slots = indices.mutate();
+
+        const std::size_t mask = slots.size() - 1;
+        std::size_t perturb = own[ix].hash;
+        std::size_t i = perturb & mask;
+
+        while (slots[i] != ix) {
+            perturb >>= 5;
+            i = (i * 5 + perturb + 1) & mask;
+        }
+
+        slots[i] = DUMMY;
+    }
+
+    own[ix] = Entry{};
+
+    --used;
+
+    head = nextLive(head);
+}
+
+Value OrderedValueSet::takeFirst() {
+
+    Value value = entries.get()[head].value;
+
+    removeAt(static_cast<std::ptrdiff_t>(head));
+
+    return value;
+}
+
+void OrderedValueSet::clear() {
+    entries.clear();
+    indices.clear();
+    used = 0;
+    fill = 0;
+    head = 0;
+}
+
+std::size_t OrderedValueSet::nextLive(std::size_t from) const {
+
+    from = std::max(from, head);
+
+    while (from < entries.size() && !entries[from].live) {
+        ++from;
+    }
+
+    return from;
+}
+
+QList<Value> OrderedValueSet::values() const {
+
+    QList<Value> result;
+    result.reserve(static_cast<qsizetype>(used));
+
+    forEach([&result](const Value& value) {
+        result.push_back(value);
+    });
+
+    return result;
+}
+
+void OrderedValueSet::rebuild() {
+
+    // малое множество с надгробиями только уплотняется и остаётся без таблицы
+    if (indices.empty() && used < SMALL_SIZE) {
+
+        std::vector<Entry>& own = entries.mutate();
+
+        own.erase(std::remove_if(own.begin(), own.end(),
+                                 [](const Entry& entry) { return !entry.live; }),
+                  own.end());
+        head = 0;
+        return;
+    }
+
+    std::size_t size = MIN_SIZE;
+
+    while (size < used * 3) {
+        size <<= 1;
+    }
+
+    std::vector<Entry> compacted;
+    compacted.reserve(size * 2 / 3);
+
+    // записи общего буфера копируются, собственного — переносятся
+    if (entries.shared()) {
+        for (const auto& entry : entries.get()) {
+            if (entry.live) {
+                compacted.push_back(entry);
+            }
+        }
+    } else {
+        for (auto& entry : entries.mutate()) {
+            if (entry.live) {
+                compacted.push_back(std::move(entry));
+            }
+        }
+    }
+
+    std::vector<std::int32_t> slots(size, EMPTY);
+
+    const std::size_t mask = size - 1;
+
+    for (std::size_t ix = 0; ix < compacted.size(); ++ix) {
+
+        std::size_t perturb = compacted[ix].hash;
+        std::size_t i = perturb & mask;
+
+        while (slots[i] != EMPTY) {
+            perturb >>= 5;
+            i = (i * 5 + perturb + 1) & mask;
+        }
+
+        slots[i] = static_cast<std::int32_t>(ix);
+    }
+
+    entries = std::move(compacted);
+    indices = std::move(slots);
+
+    fill = used;
+    head = 0;
+}
+
+const OrderedValueSet& OrderedValueSet::of(const Value& iterable, OrderedValueSet& storage) {
+
+    if (iterable.isSet()) {
+        return iterable.asSet()->elements;
+    }
+
+    if (iterable.isFrozenSet()) {
+        return iterable.asFrozenSet()->getElements();
+    }
+
+    const auto it = iterable.getIterator();
+
+    while (it->hasNext()) {
+        storage.insert(it->next());
+    }
+
+    return storage;
+}
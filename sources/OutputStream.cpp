@@ -0,0 +1,126 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "OutputStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#define CPPYTHON_ISATTY(file) _isatty(_fileno(file))
+#else
+#include <unistd.h>
+#define CPPYTHON_ISATTY(file) isatty(fileno(file))
+#endif
+
+OutputStream& OutputStream::standardOutput() {
+    static OutputStream stream(stdout, false);
+    return stream;
+}
+
+OutputStream& OutputStream::standardError() {
+    static OutputStream stream(stderr, true);
+    return stream;
+}
+
+OutputStream::OutputStream(std::FILE* file, const bool unbuffered)
+    : file(file),
+      unbuffered(unbuffered),
+      lineBuffered(CPPYTHON_ISATTY(file) != 0),
+      buffer(capacity) {}
+
+OutputStream::~OutputStream() {
+    flush();
+}
+
+void OutputStream::write(const QStringView text) {
+
+    const char16_t* units = text.utf16();
+    const qsizetype size = text.size();
+    bool newline = false;
+
+    for (qsizetype i = 0; i < size;) {
+
+        // на одну кодовую единицу UTF-16 приходится не больше трёх байт UTF-8
+        if (capacity - used < 4) {
+            flush();
+        }
+
+        // минус байт: суррогатная пара на границе порции даёт четыре байта на последнюю единицу
+        const qsizetype room = static_cast<qsizetype>((capacity - used - 1) / 3);
+        const qsizetype chunkEnd = i + std::min(size - i, room);
+
+        char* out = buffer.data() + used;
+
+        while (i < chunkEnd) {
+
+            const char16_t unit = units[i++];
+
+            if (unit < 0x80) {
+                newline |= unit == u'\n';
+                *out++ = static_cast<char>(unit);
+            } else if (unit < 0x800) {
+                *out++ = static_cast<char>(0xC0 | unit >> 6);
+                *out++ = static_cast<char>(0x80 | (unit & 0x3F));
+            } else if (unit >= 0xD800 && unit < 0xDC00 && i < size && units[i] >= 0xDC00 && units[i] < 0xE000) {
+
+                const char32_t code = 0x10000 + ((unit - 0xD800) << 10) + (units[i++] - 0xDC00);
+
+                *out++ = static_cast<char>(0xF0 | code >> 18);
+                *out++ = static_cast<char>(0x80 | (code >> 12 & 0x3F));
+                *out++ = static_cast<char>(0x80 | (code >> 6 & 0x3F));
+                *out++ = static_cast<char>(0x80 | (code & 0x3F));
+
+            } else {
+
+                // одиночный суррогат не кодируется — пишется U+FFFD
+                const char16_t code = unit >= 0xD800 && unit < 0xE000 ? u'\uFFFD' : unit;
+
+                *out++ = static_cast<char>(0xE0 | code >> 12);
+                *out++ = static_cast<char>(0x80 | (code >> 6 & 0x3F));
+                *out++ = static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+
+        used = static_cast<std::size_t>(out - buffer.data());
+    }
+
+    commit(newline);
+}
+
+void OutputStream::write(const std::string_view bytes) {
+
+    if (bytes.size() > capacity - used) {
+
+        flush();
+
+        // больше буфера — напрямую, без копирования
+        if (bytes.size() >= capacity) {
+            std::fwrite(bytes.data(), 1, bytes.size(), file);
+            std::fflush(file);
+            return;
+        }
+    }
+
+    std::memcpy(buffer.data() + used, bytes.data(), bytes.size());
+    used += bytes.size();
+
+    commit(bytes.find('\n') != std::string_view::npos);
+}
+
+void OutputStream::commit(const bool newline) {
+    if (unbuffered || (lineBuffered && newline)) {
+        flush();
+    }
+}
+
+void OutputStream::flush() {
+
+    if (used > 0) {
+        std::fwrite(buffer.data(), 1, used, file);
+        used = 0;
+    }
+
+    std::fflush(file);
+}
@@ -0,0 +1,63 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "PackedValue.h"
+
+#include <QStringList>
+
+#include "ArrayKernels.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+
+PackedValue::PackedValue(const char typecode, QByteArray data)
+    : code(typecode), size(arraykernels::itemSize(typecode)), data(std::move(data)) {}
+
+PackedValue* PackedValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<PackedValue*>(object->get()) : nullptr;
+}
+
+Value PackedValue::item(const qsizetype index) const {
+    return arraykernels::visitCode(code, [&](auto zero) {
+        return arraykernels::box(arraykernels::load<decltype(zero)>(data.constData(), index));
+    });
+}
+
+Value PackedValue::toList() const {
+
+    std::vector<Value> elements;
+    elements.reserve(len());
+
+    for (qsizetype i = 0; i < len(); ++i) {
+        elements.push_back(item(i));
+    }
+
+    return Value(makePooled<ListValue>(std::move(elements)));
+}
+
+std::optional<Value> PackedValue::sumOf(const Value& start) const {
+    return arraykernels::sum(code, data, start);
+}
+
+Value PackedValue::extremum(const bool wantMax) const {
+    return arraykernels::extremum(code, data, wantMax);
+}
+
+QString PackedValue::reprAs(const char* name) const {
+
+    QString result = QString("%1('%2'").arg(name, QChar(code));
+
+    if (data.isEmpty()) {
+        return result + ")";
+    }
+
+    QStringList parts;
+
+    for (qsizetype i = 0; i < len(); ++i) {
+        parts << item(i).repr();
+    }
+
+    return result + ", [" + parts.join(", ") + "])";
+}
@@ -0,0 +1,288 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ParallelMap.h"
+
+#include <algorithm>
+#include <optional>
+#include <thread>
+
+#include <QFile>
+#include <QProcess>
+#include <QTemporaryFile>
+
+#include "CallRuntime.h"
+#include "ClassUtils.h"
+#include "Environment.h"
+#include "FunctionValue.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "OutputStream.h"
+#include "ValueCodec.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    /// первый байт файла результатов
+    constexpr char resultsTag = 'R';
+    constexpr char errorTag = 'E';
+
+    /// число рабочих: None — по числу ядер
+    qsizetype workerCount(const Value* workers) {
+
+        if (!workers || workers->isNone()) {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        const Value::BigInt count = workers->asBigInt("parallel_map");
+
+        if (count < 1) {
+            throw std::runtime_error("ValueError: Number of processes must be at least 1");
+        }
+
+        return count > 1024 ? 1024 : count.convert_to<qsizetype>();
+    }
+
+    /// файл модуля, в глобальных именах которого функция видна под своим именем
+    QString moduleFileOf(const Value& function) {
+
+        if (!function.isFunction()) {
+            throw std::runtime_error(
+                "TypeError: parallel_map() argument 1 must be a function, not '" + typeName(function).toStdString() + "'");
+        }
+
+        const Value::FunctionPtr fn = function.asFunction();
+        const Value* file = fn->closure ? fn->closure->findLocal("__file__") : nullptr;
+        const Value* defined = fn->closure ? fn->closure->findLocal(fn->name) : nullptr;
+
+        if (!file || !file->isString() || !defined || !defined->isFunction() || defined->asFunction() != fn) {
+            throw std::runtime_error(
+                "TypeError: cannot ship function '" + fn->name.toStdString() +
+                "' to a worker: parallel_map() needs a function defined at module level");
+        }
+
+        return file->asString()->toString();
+    }
+
+    /// файл, отображённый в память: valuecodec читает его без копии в буфер
+    class MappedFile {
+    public:
+        explicit MappedFile(const QString& path) : file(path) {
+
+            if (!file.open(QIODevice::ReadOnly)) {
+                throw std::runtime_error("OSError: can't read '" + path.toStdString() + "': " +
+                                         file.errorString().toStdString());
+            }
+
+            const qint64 size = file.size();
+            const uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+
+            data = mapped
+                ? QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<qsizetype>(size))
+                : file.readAll();
+        }
+
+        /// действительны, пока жив MappedFile
+        [[nodiscard]] const QByteArray& bytes() const { return data; }
+
+    private:
+        QFile file;
+        QByteArray data;
+    };
+
+    void writeAll(const QString& path, const QByteArray& data) {
+
+        QFile file(path);
+
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data) != data.size()) {
+            throw std::runtime_error("OSError: can't write '" + path.toStdString() + "': " +
+                                     file.errorString().toStdString());
+        }
+    }
+
+    /// кусок элементов для одного рабочего: файл с его элементами и файл для результатов
+    struct Worker {
+        QTemporaryFile input;
+        QTemporaryFile output;
+        QProcess process;
+    };
+
+    Value parallelMap(const std::vector<Value>& args, const Kwargs& kwargs) {
+
+        expectArgsRange(args, 2, 3, "parallel_map");
+
+        for (const auto& [name, value] : kwargs) {
+            if (name != "workers") {
+                throw std::runtime_error(
+                    "TypeError: parallel_map() got an unexpected keyword argument '" + name.toStdString() + "'");
+            }
+        }
+
+        if (ParallelMap::bootstrapping) {
+            throw std::runtime_error(
+                "RuntimeError: parallel_map() was called while a worker was importing the main module; "
+                "guard the call with if __name__ == \"__main__\":");
+        }
+
+        const QString script = moduleFileOf(args[0]);
+        const QString function = args[0].asFunction()->name;
+
+        std::vector<Value> items;
+        const auto it = args[1].getIterator();
+
+        while (it->hasNext()) {
+            items.push_back(it->next());
+        }
+
+        if (items.empty()) {
+            return Value(makePooled<ListValue>());
+        }
+
+        const qsizetype count = static_cast<qsizetype>(items.size());
+        const qsizetype workers = std::min(workerCount(option(args, kwargs, 2, "workers")), count);
+        const qsizetype chunk = (count + workers - 1) / workers;
+
+        // все куски сериализуются до запуска: ошибка сериализации не оставляет запущенных процессов
+        std::vector<QByteArray> payloads;
+
+        for (qsizetype begin = 0; begin < count; begin += chunk) {
+
+            std::vector<Value> part(items.begin() + begin, items.begin() + std::min(begin + chunk, count));
+
+            // memoryview над общим сегментом уходит рабочему ссылкой на сегмент, без байтов
+            valuecodec::encode(Value(makePooled<ListValue>(std::move(part))), payloads.emplace_back(), true);
+        }
+
+        // вывод рабочих идёт в те же потоки: накопленное родителем выводится раньше
+        OutputStream::standardOutput().flush();
+        OutputStream::standardError().flush();
+
+        std::vector<std::unique_ptr<Worker>> pool;
+
+        for (const QByteArray& payload : payloads) {
+
+            auto worker = std::make_unique<Worker>();
+
+            if (!worker->input.open() || worker->input.write(payload) != payload.size() || !worker->input.flush() ||
+                !worker->output.open()) {
+                throw std::runtime_error("OSError: parallel_map() can't create a temporary file");
+            }
+
+            worker->input.close();
+            worker->output.close();
+
+            worker->process.setProcessChannelMode(QProcess::ForwardedChannels);
+            worker->process.setStandardInputFile(QProcess::nullDevice());
+            worker->process.start(ParallelMap::executable,
+                                  {"--worker=" + function, script, worker->input.fileName(), worker->output.fileName()});
+
+            pool.push_back(std::move(worker));
+        }
+
+        auto result = makePooled<ListValue>();
+        result->elements.reserve(count);
+
+        std::optional<std::string> failure;
+
+        // ждём всех рабочих, даже если один уже упал: процессы не остаются без родителя
+        for (const auto& worker : pool) {
+
+            if (!worker->process.waitForFinished(-1) && worker->process.error() == QProcess::FailedToStart) {
+                failure = failure.value_or("RuntimeError: parallel_map() can't start a worker: " +
+                                           worker->process.errorString().toStdString());
+                continue;
+            }
+
+            if (failure) {
+                continue;
+            }
+
+            const MappedFile output(worker->output.fileName());
+            const QByteArray& data = output.bytes();
+
+            if (data.isEmpty()) {
+                failure = "RuntimeError: parallel_map() worker exited with code " +
+                          std::to_string(worker->process.exitCode());
+                continue;
+            }
+
+            qsizetype pos = 1;
+            const Value payload = valuecodec::decode(data, pos);
+
+            if (data[0] == errorTag) {
+                failure = payload.asString()->toString().toStdString();
+                continue;
+            }
+
+            const auto& values = payload.asList()->elements;
+            result->elements.insert(result->elements.end(), values.begin(), values.end());
+        }
+
+        if (failure) {
+            throw std::runtime_error(*failure);
+        }
+
+        return Value(result);
+    }
+}
+
+Value ParallelMap::makeBuiltin() {
+    return ::makeBuiltin(
+        "parallel_map",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+            return parallelMap(args, kwargs);
+        }
+    );
+}
+
+int ParallelMap::serve(const std::shared_ptr<Environment>& globals, const QString& function,
+                       const QString& input, const QString& output) {
+
+    QByteArray data;
+
+    try {
+
+        const Value* found = globals->findLocal(function);
+
+        if (!found) {
+            throw std::runtime_error("AttributeError: Can't get attribute '" + function.toStdString() +
+                                     "' on <module '__mp_main__'>");
+        }
+
+        // копия: вызов может перестроить глобальные имена модуля
+        const Value callable = *found;
+        const MappedFile mapped(input);
+        const QByteArray& payload = mapped.bytes();
+        qsizetype pos = 0;
+        const Value items = valuecodec::decode(payload, pos, true);
+
+        auto results = makePooled<ListValue>();
+        results->elements.reserve(items.asList()->elements.size());
+
+        for (const Value& item : items.asList()->elements.get()) {
+            results->elements.push_back(call(callable, {item}, {}, globals));
+        }
+
+        data.append(resultsTag);
+        valuecodec::encode(Value(results), data);
+
+    } catch (const std::runtime_error& e) {
+
+        data.clear();
+        data.append(errorTag);
+        valuecodec::encode(Value(e.what()), data);
+
+    } catch (const std::exception& e) {
+
+        // bad_alloc и другие исключения C++ без типа Python в тексте — тоже родителю, а не пустой файл
+        data.clear();
+        data.append(errorTag);
+        valuecodec::encode(Value((std::string("RuntimeError: parallel_map() worker failed: ") + e.what()).c_str()), data);
+    }
+
+    OutputStream::standardOutput().flush();
+    writeAll(output, data);
+
+    return 0;
+}
@@ -1,6 +1,13 @@
 #include "Parser.h"
 
+#include <algorithm>
+#include <cstdlib>
+
+#include <QHash>
+
+#include "BigIntText.h"
 #include "BytesValue.h"
+#include "StringTable.h"
 
 /**
  * @brief Конструирует объект Parser с заданным вектором токенов.
@@ -11,7 +18,78 @@
  * @param tokens QVector объектов Token, представляющий лексические токены,
  *               которые будут анализироваться парсером.
  */
-Parser::Parser(const QVector<Token>& tokens) : tokens(tokens) {}
+Parser::Parser(const QVector<Token>& tokens) : tokens(tokens) {
+    classifyOperators();
+}
+
+/**
+ * Один проход по токенам: каждому оператору сопоставляется его Infix, чтобы разбор
+ * выражений сравнивал байт, а не строки значений. `not` перед `in` — часть сравнения
+ * `not in`, одиночный `not` остаётся префиксным.
+ */
+void Parser::classifyOperators() {
+
+    static const QHash<QString, Infix> operators = {
+        {"|", Infix::BitOr},
+        {"^", Infix::BitXor},
+        {"&", Infix::BitAnd},
+        {"+", Infix::Additive},
+        {"-", Infix::Additive},
+        {"*", Infix::Multiplicative},
+        {"/", Infix::Multiplicative},
+        {"//", Infix::Multiplicative},
+        {"%", Infix::Multiplicative},
+        {"**", Infix::Power},
+        {"==", Infix::Compare},
+        {"!=", Infix::Compare},
+        {"<", Infix::Compare},
+        {"<=", Infix::Compare},
+        {">", Infix::Compare},
+        {">=", Infix::Compare},
+        {"=", Infix::Assign},
+        {"+=", Infix::AugAssign},
+        {"-=", Infix::AugAssign},
+        {"*=", Infix::AugAssign},
+        {"/=", Infix::AugAssign},
+        {"//=", Infix::AugAssign},
+        {"%=", Infix::AugAssign},
+        {"**=", Infix::AugAssign},
+        {"|=", Infix::AugAssign},
+        {"&=", Infix::AugAssign},
+        {"^=", Infix::AugAssign},
+    };
+
+    infix.assign(static_cast<std::size_t>(tokens.size()), Infix::None);
+
+    for (qsizetype i = 0; i < tokens.size(); ++i) {
+
+        const Token& token = tokens[i];
+
+        if (token.type == TOKEN_OP) {
+            infix[i] = operators.value(token.value, Infix::None);
+            continue;
+        }
+
+        if (token.type != TOKEN_KEYWORD || !token.keyword) {
+            continue;
+        }
+
+        switch (*token.keyword) {
+            case Keyword::OR:  infix[i] = Infix::Or; break;
+            case Keyword::AND: infix[i] = Infix::And; break;
+            case Keyword::IN:
+            case Keyword::IS:  infix[i] = Infix::Compare; break;
+            case Keyword::NOT:
+                if (i + 1 < tokens.size() && tokens[i + 1].type == TOKEN_KEYWORD &&
+                    tokens[i + 1].keyword == Keyword::IN) {
+                    infix[i] = Infix::Compare;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
 
 /**
  * @brief Разбирает входные токены и формирует абстрактное синтаксическое дерево (AST).
@@ -25,6 +103,20 @@ Parser::Parser(const QVector<Token>& tokens) : tokens(tokens) {}
  */
 std::shared_ptr<ASTNode> Parser::parse() {
 
+    // строка первого токена инструкции: по ней компилятор расставляет TraceLine
+    const int line = peek().line;
+
+    std::shared_ptr<ASTNode> node = parseStatement();
+
+    if (node) {
+        node->line = line;
+    }
+
+    return node;
+}
+
+std::shared_ptr<ASTNode> Parser::parseStatement() {
+
     if (peek().type == TOKEN_KEYWORD) {
 
         switch (peek().keyword.value()) {
@@ -33,23 +125,146 @@ std::shared_ptr<ASTNode> Parser::parse() {
             case Keyword::BREAK:    return parseBreakStatement();
             case Keyword::CONTINUE: return parseContinueStatement();
             case Keyword::DEF:      return parseFunctionDef();
+            case Keyword::ASYNC:    return parseAsync();
             case Keyword::RETURN:   return parseReturn();
             case Keyword::PASS:     return parsePass();
             case Keyword::CLASS:    return parseClassDef();
             case Keyword::LAMBDA:   return parseLambda();
             case Keyword::FOR:      return parseForStatement();
             case Keyword::DEL:      return parseDelStatement();
+            case Keyword::TRY:      return parseTryStatement();
+            case Keyword::RAISE:    return parseRaise();
+            case Keyword::IMPORT:   return parseImport();
+            case Keyword::GLOBAL:
+            case Keyword::NONLOCAL: return parseScopeDeclaration();
             default:                break;
         }
     }
 
+    // `from` не ключевое слово (см. parseYield): инструкцию выдаёт имя модуля или точка после него
+    if (peek().type == TOKEN_ID && peek().value == "from" && current + 1 < tokens.size() &&
+        (tokens.at(current + 1).type == TOKEN_ID ||
+         (tokens.at(current + 1).type == TOKEN_OP && tokens.at(current + 1).value == "."))) {
+        return parseFromImport();
+    }
+
     if (peek().type == TOKEN_AT) {
         return parseDecorated();
     }
 
+    if (isUnpackTarget()) {
+        return parseUnpackAssignment();
+    }
+
     return parseExpression();
 }
 
+/// `имя, имя[,] =` в начале инструкции
+bool Parser::isUnpackTarget() const {
+
+    int pos = current;
+    int names = 0;
+
+    while (pos + 1 < tokens.size() && tokens.at(pos).type == TOKEN_ID) {
+
+        ++names;
+        const Token& after = tokens.at(pos + 1);
+
+        if (after.type != TOKEN_OP) {
+            return false;
+        }
+
+        if (after.value == "=") {
+            return names > 1;
+        }
+
+        if (after.value != ",") {
+            return false;
+        }
+
+        pos += 2;
+
+        // запятая в конце: `a, = value`
+        if (pos < tokens.size() && tokens.at(pos).type == TOKEN_OP && tokens.at(pos).value == "=") {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Разбирает `a, b = value`. Правая часть через запятую без скобок собирается
+ * в кортеж, как в Python: `a, b = b, a`.
+ */
+std::shared_ptr<ASTNode> Parser::parseUnpackAssignment() {
+
+    std::vector<QString> targets;
+
+    while (!match(TOKEN_OP, "=")) {
+        targets.push_back(advance().value);
+        matchAndAdvance(TOKEN_OP, ",");
+    }
+
+    advance(); // =
+
+    auto value = parseStarredExpression();
+
+    if (match(TOKEN_OP, ",")) {
+
+        std::vector<std::shared_ptr<ASTNode>> elements{value};
+
+        while (matchAndAdvance(TOKEN_OP, ",")) {
+
+            if (peek().type == TOKEN_NEWLINE || peek().type == TOKEN_EOF || peek().type == TOKEN_DEDENT) {
+                break;
+            }
+
+            elements.push_back(parseStarredExpression());
+        }
+
+        value = makeNode<TupleNode>(std::move(elements));
+    }
+
+    return makeNode<UnpackAssignNode>(std::move(targets), std::move(value));
+}
+
+/**
+ * @brief Разбирает исходный файл целиком.
+ *
+ * В отличие от REPL, который передаёт парсеру по одной инструкции, файл токенизируется
+ * один раз, и инструкции верхнего уровня разбираются подряд до TOKEN_EOF.
+ * Разделяющие их NEWLINE пропускаются, как в parseBlock().
+ *
+ * @return Инструкции верхнего уровня в порядке следования.
+ */
+std::vector<std::shared_ptr<ASTNode>> Parser::parseModule() {
+
+    std::vector<std::shared_ptr<ASTNode>> statements;
+
+    while (peek().type != TOKEN_EOF) {
+
+        if (peek().type == TOKEN_NEWLINE) {
+            advance();
+            continue;
+        }
+
+        if (peek().type == TOKEN_INDENT) {
+            throw std::runtime_error("IndentationError: unexpected indent");
+        }
+
+        const auto start = current;
+
+        statements.push_back(parse());
+
+        if (current == start) {
+            throw std::runtime_error("SyntaxError: invalid syntax");
+        }
+    }
+
+    return statements;
+}
+
 /**
  * Разбирает выражение присваивания.
  *
@@ -68,32 +283,18 @@ std::shared_ptr<ASTNode> Parser::parse() {
  */
 std::shared_ptr<ASTNode> Parser::parseExpression() {
 
-    std::shared_ptr<ASTNode> left = parseOr();
+    std::shared_ptr<ASTNode> left = parseBinary();
 
-    if (matchAny(
-        TOKEN_OP,
-        {
-            "+=",
-            "-=",
-            "*=",
-            "/=",
-            "//=",
-            "%=",
-            "**=",
-            "|=",
-            "&=",
-            "^="
-        }
-    )) {
+    if (infixAt(current) == Infix::AugAssign) {
 
         QString op = advance().value;
 
-        auto right = parseOr();
+        auto right = parseBinary();
 
         if (const auto var =
             std::dynamic_pointer_cast<VarNode>(left)) {
 
-            return std::make_shared<AugAssignNode>(var->name, op, right);
+            return makeNode<AugAssignNode>(var->name, op, right);
         }
 
         throw std::runtime_error(
@@ -101,20 +302,22 @@ std::shared_ptr<ASTNode> Parser::parseExpression() {
         );
     }
 
-    if (matchAndAdvance(TOKEN_OP, "=")) {
+    if (infixAt(current) == Infix::Assign) {
 
-        auto right = parseOr();
+        advance();
+
+        auto right = parseBinary();
 
         if (const auto var =
             std::dynamic_pointer_cast<VarNode>(left)) {
 
-            return std::make_shared<AssignNode>(var->name, right);
+            return makeNode<AssignNode>(var->name, right);
         }
 
         if (const auto attr =
             std::dynamic_pointer_cast<AttributeAccessNode>(left)) {
 
-            return std::make_shared<AttributeAssignNode>(
+            return makeNode<AttributeAssignNode>(
                 attr->object,
                 attr->attr,
                 right
@@ -124,7 +327,7 @@ std::shared_ptr<ASTNode> Parser::parseExpression() {
         if (const auto idx =
             std::dynamic_pointer_cast<IndexNode>(left)) {
 
-            return std::make_shared<IndexAssignNode>(
+            return makeNode<IndexAssignNode>(
                 idx->object,
                 idx->index,
                 right
@@ -140,7 +343,7 @@ std::shared_ptr<ASTNode> Parser::parseExpression() {
 std::shared_ptr<ASTNode> Parser::parseStarredExpression() {
 
     if (matchAndAdvance(TOKEN_OP, "*")) {
-        return std::make_shared<StarredNode>(parseExpression());
+        return makeNode<StarredNode>(parseExpression());
     }
 
     return parseExpression();
@@ -149,135 +352,142 @@ std::shared_ptr<ASTNode> Parser::parseStarredExpression() {
 std::shared_ptr<ASTNode> Parser::parseDoubleStarredExpression() {
 
     if (matchAndAdvance(TOKEN_OP, "**")) {
-        return std::make_shared<DictUnpackNode>(parseExpression());
+        return makeNode<DictUnpackNode>(parseExpression());
     }
 
     return parseExpression();
 }
 
 /**
- * Разбирает выражения с операциями сравнения (==, !=, <, <=, >, >=).
+ * Разбор операторов по Пратту: операнд (с префиксными not, + и -), затем, пока у
+ * следующего токена есть инфиксный оператор с силой связывания не меньше minPower,
+ * он поглощается вместе с правым операндом. Левоассоциативный оператор разбирает
+ * правый операнд с силой на единицу больше своей, `**` — с силой унарного минуса,
+ * поэтому `2 ** -1` и `2 ** 3 ** 2` разбираются как в Python.
  *
- * Метод обрабатывает токены, соответствующие операциям сравнения,
- * через последовательный разбор выражений сложения и вычитания. Для каждой
- * операции создается бинарный узел AST (BinOpNode), объединяющий левый
- * и правый операнды. Построение дерева выражений выполняется последовательно
- * слева направо.
- *
- * @return Умный указатель на узел AST, представляющий разобранное выражение
- *         для операций сравнения. Исключения могут быть выброшены в случае
- *         синтаксических ошибок.
+ * Первичное выражение проходит один вызов parsePrimary и одну проверку таблицы,
+ * а не спуск через все уровни приоритета.
  */
-std::shared_ptr<ASTNode> Parser::parseComparison() {
+std::shared_ptr<ASTNode> Parser::parseBinary(const int minPower) {
 
-    std::shared_ptr<ASTNode> left = parseBitOr();
-    std::vector<QString> compOps;
-    std::vector<std::shared_ptr<ASTNode>> compRights;
+    std::shared_ptr<ASTNode> left = parseOperand(minPower);
 
-    while (isComparisonOperator()) {
+    while (true) {
 
-        compOps.push_back(parseComparisonOperator());
-        compRights.push_back(parseAdditionAndSubtraction());
-    }
+        const Infix op = infixAt(current);
+        const int power = bindingPower(op);
 
-    if (compOps.empty()) {
-        return left;
-    }
+        if (power == 0 || power < minPower) {
+            return left;
+        }
 
-    return std::make_shared<CompareNode> (
-        left,
-        std::move(compOps),
-        std::move(compRights)
-    );
+        if (op == Infix::Compare) {
+            left = parseComparisonChain(std::move(left));
+            continue;
+        }
+
+        const QString name = advance().value;
+
+        if (op == Infix::Or || op == Infix::And) {
+            left = makeNode<LogicalOpNode>(left, name, parseBinary(power + 1));
+        } else if (op == Infix::Power) {
+            left = makeNode<BinOpNode>(left, name, parseBinary(unaryPower));
+        } else if (name == "+") {
+            left = makeAddition(std::move(left), parseBinary(power + 1));
+        } else {
+            left = makeNode<BinOpNode>(left, name, parseBinary(power + 1));
+        }
+    }
 }
 
 /**
- * Разбирает выражения с операциями сложения (+) и вычитания (-).
- *
- * Метод обрабатывает токены, соответствующие операциям сложения и вычитания,
- * используя результаты разбора термов. Для каждой найденной операции создается
- * бинарный узел AST (BinOpNode), который объединяет левый и правый операнды.
- * После этого дерево выражений строится последовательно слева направо.
- *
- * @return Умный указатель на узел AST, представляющий разобранное выражение
- *         для операций сложения и вычитания. Исключения могут быть выброшены
- *         в случае ошибок синтаксического анализа.
+ * Цепочка `+` со строковым литералом или f-строкой становится ConcatNode: левые
+ * слагаемые вложенных BinOpNode разворачиваются в его части, следующие `+`
+ * дописываются к нему же. Правый операнд в скобках остаётся одной частью —
+ * `a + (b + c)` не переставляется.
  */
-std::shared_ptr<ASTNode> Parser::parseAdditionAndSubtraction() {
-    std::shared_ptr<ASTNode> left = parseTerm();
+std::shared_ptr<ASTNode> Parser::makeAddition(std::shared_ptr<ASTNode> left, std::shared_ptr<ASTNode> right) {
 
-    while (matchAny(TOKEN_OP, {"+", "-"})) {
+    if (const auto chain = std::dynamic_pointer_cast<ConcatNode>(left)) {
+        chain->append(std::move(right));
+        return left;
+    }
 
-        QString op = advance().value;
+    const auto isStringPiece = [](const std::shared_ptr<ASTNode>& node) {
 
-        std::shared_ptr<ASTNode> right = parseTerm();
+        if (const auto literal = dynamic_cast<const ValueNode*>(node.get())) {
+            return std::holds_alternative<Value::StrPtr>(literal->value.data);
+        }
+
+        return dynamic_cast<const FormattedStringNode*>(node.get()) != nullptr ||
+               dynamic_cast<const ConcatNode*>(node.get()) != nullptr;
+    };
 
-        left = std::make_shared<BinOpNode>(left, op, right);
+    if (!isStringPiece(left) && !isStringPiece(right)) {
+        return makeNode<BinOpNode>(std::move(left), "+", std::move(right));
     }
 
-    return left;
-}
+    std::vector<std::shared_ptr<ASTNode>> pieces{std::move(right)};
 
-/**
- * @brief Разбирает терм в последовательности токенов и строит соответствующий узел AST.
- *
- * Этот метод разбирает терм, определённый как последовательность выражений-степеней,
- * объединённых операторами умножения (*), деления (/), целочисленного деления (//) и остатка от деления (%).
- * Для каждого встреченного оператора формируется узел бинарной операции, что позволяет построить
- * левосторонне ассоциативное представление выражения.
- *
- * @return Умный указатель на корневой узел AST, представляющий разобранный терм.
- *         Если терм не может быть разобран, поведение не определено.
- */
-std::shared_ptr<ASTNode> Parser::parseTerm() {
+    while (const auto sum = std::dynamic_pointer_cast<BinOpNode>(left)) {
 
-    std::shared_ptr<ASTNode> left = parseUnary();
+        if (sum->operation != BinOpNode::Operation::Add) {
+            break;
+        }
 
-    while (matchAny(TOKEN_OP, {"*", "/", "//", "%"})) {
+        pieces.push_back(sum->right);
+        left = sum->left;
+    }
 
-        QString op = advance().value;
+    pieces.push_back(std::move(left));
+    std::reverse(pieces.begin(), pieces.end());
 
-        std::shared_ptr<ASTNode> right = parseUnary();
+    return makeNode<ConcatNode>(std::move(pieces));
+}
+
+std::shared_ptr<ASTNode> Parser::parseOperand(const int minPower) {
+
+    const Token& token = peek();
+
+    // `a == not b` — синтаксическая ошибка, как в Python: not разбирается только не выше своего уровня
+    if (token.type == TOKEN_KEYWORD && token.keyword == Keyword::NOT && minPower <= notPower) {
+        advance();
+        return makeNode<UnaryOpNode>("not", parseBinary(notPower));
+    }
 
-        left = std::make_shared<BinOpNode>(left, op, right);
+    if (token.type == TOKEN_OP && (token.value == "+" || token.value == "-")) {
+        const QString op = advance().value;
+        return makeNode<UnaryOpNode>(op, parseBinary(unaryPower));
     }
 
-    return left;
+    return parsePrimary();
 }
 
 /**
- * @brief Разбирает выражение возведения в степень в потоке входных токенов.
- *
- * Этот метод обрабатывает выражения с оператором возведения в степень ("**"),
- * учитывая соответствующие правила ассоциативности и приоритетов. Рекурсивно строит
- * узлы абстрактного синтаксического дерева (AST), представляющие такие операции. Если
- * оператор "**" не встречается, метод передаёт управление разбору
- * отдельных факторов.
- *
- * @return Умный указатель на корневой узел разобранного выражения, который
- *         может быть либо отдельным фактором, либо узлом бинарной операции
- *         возведения в степень.
+ * Цепочка сравнений `a < b <= c` — один CompareNode. Правые операнды разбираются
+ * на уровне `|`: `a == b | c` — это `a == (b | c)`.
  */
-std::shared_ptr<ASTNode> Parser::parsePower()
-{
-    std::shared_ptr<ASTNode> left = parsePrimary();
-
-    if (match(TOKEN_OP, "**")) {
-
-        QString op = advance().value;
+std::shared_ptr<ASTNode> Parser::parseComparisonChain(std::shared_ptr<ASTNode> left) {
 
-        std::shared_ptr<ASTNode> right = parseUnary();
+    std::vector<QString> compOps;
+    std::vector<std::shared_ptr<ASTNode>> compRights;
 
-        left = std::make_shared<BinOpNode>(left, op, right);
+    while (infixAt(current) == Infix::Compare) {
+        compOps.push_back(parseComparisonOperator());
+        compRights.push_back(parseBinary(bindingPower(Infix::Compare) + 1));
     }
 
-    return left;
+    return makeNode<CompareNode>(
+        left,
+        std::move(compOps),
+        std::move(compRights)
+    );
 }
 
 std::shared_ptr<ASTNode> Parser::parseNoneToken() {
 
     advance();
-    return std::make_shared<ValueNode>(Value());
+    return makeNode<ValueNode>(Value());
 }
 
 /**
@@ -304,6 +514,7 @@ std::shared_ptr<ASTNode> Parser::parsePrimary() {
         case TOKEN_NUMBER: node = parseNumberToken(); break;
         case TOKEN_STRING: node = parseStringToken(); break;
         case TOKEN_BYTES:  node = parseBytesToken(); break;
+        case TOKEN_FSTRING: node = parseFStringToken(); break;
         case TOKEN_BOOL:   node = parseBoolToken(); break;
         case TOKEN_NONE:   node = parseNoneToken(); break;
         case TOKEN_ID:     node = parseIdentifierToken(); break;
@@ -312,6 +523,15 @@ std::shared_ptr<ASTNode> Parser::parsePrimary() {
             if (token.keyword.value() == Keyword::LAMBDA)
                 return parseLambda();
 
+            if (token.keyword.value() == Keyword::YIELD)
+                return parseYield();
+
+            if (token.keyword.value() == Keyword::AWAIT) {
+                // `await` связывает сильнее унарных операторов: `-await x` — это -(await x)
+                advance();
+                return makeNode<AwaitNode>(parsePrimary());
+            }
+
         case TOKEN_OP:
             if (token.value == "(")
                 node = parseParenthesizedExpression();
@@ -356,13 +576,13 @@ std::shared_ptr<ASTNode> Parser::parseNumberToken() {
             normalized.contains('e') ||
             normalized.contains('E')) {
 
-            return std::make_shared<ValueNode>(
-                Value(Value::BigFloat(str))
+            return makeNode<ValueNode>(
+                Value(Value::Float(std::strtod(str.c_str(), nullptr)))
             );
         }
         else {
-            return std::make_shared<ValueNode>(
-                Value(Value::BigInt(str))
+            return makeNode<ValueNode>(
+                Value(BigIntText::fromString(str))
             );
         }
     } catch (const std::exception&) {
@@ -381,14 +601,22 @@ std::shared_ptr<ASTNode> Parser::parseNumberToken() {
  */
 std::shared_ptr<ASTNode> Parser::parseStringToken() {
 
-    return std::make_shared<ValueNode>(
-        Value(advance().value)
+    const QString value = advance().value;
+
+    if (StringTable::isInternable(value)) {
+        return makeNode<ValueNode>(
+            Value(StringTable::internStr(value))
+        );
+    }
+
+    return makeNode<ValueNode>(
+        Value(value)
     );
 }
 
 std::shared_ptr<ASTNode> Parser::parseBytesToken() {
 
-    return std::make_shared<ValueNode>(
+    return makeNode<ValueNode>(
         Value(
             std::make_shared<BytesValue>(
                 advance().value.toLatin1()
@@ -397,6 +625,183 @@ std::shared_ptr<ASTNode> Parser::parseBytesToken() {
     );
 }
 
+std::shared_ptr<ASTNode> Parser::parseFStringToken() {
+    return parseFString(advance().value);
+}
+
+/**
+ * Делит тело f-строки на литералы и поля `{expr!c:spec}`.
+ *
+ * Выражение поля — текст до `}`, `!` или `:` вне скобок и строковых литералов;
+ * оно разбирается отдельным Parser, как если бы стояло в скобках. Спецификатор
+ * с вложенными полями (`{x:>{width}}`) сам разбирается как f-строка. `{x=}`
+ * выводит текст выражения перед значением, по умолчанию через repr.
+ *
+ * @param text Тело литерала без префикса и кавычек, escape-последовательности уже раскрыты.
+ * @return Узел FormattedStringNode; строка без полей — обычный ValueNode.
+ */
+std::shared_ptr<ASTNode> Parser::parseFString(const QString& text) {
+
+    std::vector<FormattedStringNode::Part> parts;
+    FormattedStringNode::Part segment;
+
+    for (qsizetype pos = 0; pos < text.size();) {
+
+        const QChar c = text[pos];
+
+        if ((c == '{' || c == '}') && pos + 1 < text.size() && text[pos + 1] == c) {
+            segment.literal += c;
+            pos += 2;
+            continue;
+        }
+
+        if (c == '}') {
+            throw std::runtime_error("SyntaxError: f-string: single '}' is not allowed");
+        }
+
+        if (c != '{') {
+            segment.literal += c;
+            ++pos;
+            continue;
+        }
+
+        const qsizetype start = ++pos;
+        int depth = 0;
+        QChar quote;
+
+        for (; pos < text.size(); ++pos) {
+
+            const QChar ch = text[pos];
+
+            if (!quote.isNull()) {
+                if (ch == quote) {
+                    quote = QChar();
+                }
+                continue;
+            }
+
+            if (ch == '\'' || ch == '"') {
+                quote = ch;
+            } else if (ch == '(' || ch == '[' || ch == '{') {
+                ++depth;
+            } else if (depth > 0 && (ch == ')' || ch == ']' || ch == '}')) {
+                --depth;
+            } else if (depth == 0 && (ch == '}' || ch == ':' ||
+                                      (ch == '!' && (pos + 1 >= text.size() || text[pos + 1] != '=')))) {
+                break;
+            }
+        }
+
+        if (pos >= text.size()) {
+            throw std::runtime_error("SyntaxError: f-string: expecting '}'");
+        }
+
+        QString source = text.mid(start, pos - start);
+        QString debugText;
+
+        // `{x=}`, но не `{x==y}`, `{x!=y}`, `{x<=y}`
+        if (const QString trimmed = source.trimmed();
+            trimmed.size() > 1 && trimmed.endsWith('=') && !QStringLiteral("=!<>").contains(trimmed[trimmed.size() - 2])) {
+            debugText = source;
+            source = trimmed.chopped(1);
+        }
+
+        if (source.trimmed().isEmpty()) {
+            throw std::runtime_error("SyntaxError: f-string: empty expression not allowed");
+        }
+
+        QChar conversion;
+
+        if (text[pos] == '!') {
+
+            if (pos + 1 >= text.size() || (text[pos + 1] != 'r' && text[pos + 1] != 's' && text[pos + 1] != 'a')) {
+                throw std::runtime_error("SyntaxError: f-string: invalid conversion character");
+            }
+
+            conversion = text[pos + 1];
+            pos += 2;
+
+            if (pos >= text.size() || (text[pos] != ':' && text[pos] != '}')) {
+                throw std::runtime_error("SyntaxError: f-string: expecting '}'");
+            }
+        }
+
+        QString spec;
+        std::shared_ptr<ASTNode> specNode;
+
+        if (text[pos] == ':') {
+
+            const qsizetype specStart = ++pos;
+            int nesting = 0;
+
+            for (; pos < text.size(); ++pos) {
+
+                if (text[pos] == '{') {
+                    ++nesting;
+                } else if (text[pos] == '}') {
+                    if (nesting == 0) {
+                        break;
+                    }
+                    --nesting;
+                }
+            }
+
+            if (pos >= text.size()) {
+                throw std::runtime_error("SyntaxError: f-string: expecting '}'");
+            }
+
+            spec = text.mid(specStart, pos - specStart);
+
+            if (spec.contains('{')) {
+
+                specNode = parseFString(spec);
+
+                if (const auto constant = std::dynamic_pointer_cast<ValueNode>(specNode)) {
+                    spec = constant->value.toString();
+                    specNode = nullptr;
+                }
+            }
+        }
+
+        ++pos; // '}'
+
+        if (!debugText.isEmpty()) {
+
+            segment.literal += debugText;
+
+            if (conversion.isNull() && spec.isEmpty() && !specNode) {
+                conversion = 'r';
+            }
+        }
+
+        Lexer lexer;
+        const QByteArray code = ("(" + source + ")").toUtf8();
+        Parser parser(lexer.tokenize(std::string_view(code.constData(), code.size())));
+        parser.arena = arena;
+
+        segment.expr = parser.parseExpression();
+
+        if (parser.peek().type != TOKEN_NEWLINE && parser.peek().type != TOKEN_EOF) {
+            throw std::runtime_error("SyntaxError: f-string: invalid syntax");
+        }
+
+        segment.format = FormatTemplate::field(conversion, std::move(spec));
+        segment.spec = std::move(specNode);
+        parts.push_back(std::move(segment));
+        segment = FormattedStringNode::Part();
+    }
+
+    if (parts.empty()) {
+        return makeNode<ValueNode>(Value(segment.literal));
+    }
+
+    if (!segment.literal.isEmpty()) {
+        parts.push_back(std::move(segment));
+    }
+
+    return makeNode<FormattedStringNode>(std::move(parts));
+}
+
 /**
  * Парсит логический токен в узел синтаксического дерева.
  *
@@ -410,7 +815,7 @@ std::shared_ptr<ASTNode> Parser::parseBytesToken() {
  *         Если токен невалиден, поведение не определено.
  */
 std::shared_ptr<ASTNode> Parser::parseBoolToken() {
-    return std::make_shared<ValueNode>(
+    return makeNode<ValueNode>(
         Value(
             advance().value == "True"
             )
@@ -446,14 +851,14 @@ std::shared_ptr<ASTNode> Parser::parseIdentifierToken() {
 
         consume(TOKEN_OP, ")");
 
-        return std::make_shared<CallNode>(
-            std::make_shared<VarNode>(name),
+        return makeNode<CallNode>(
+            makeNode<VarNode>(name),
             parsedArgs.positional,
             parsedArgs.keyword
         );
     }
 
-    return std::make_shared<VarNode>(name);
+    return makeNode<VarNode>(name);
 }
 
 /**
@@ -476,13 +881,20 @@ std::shared_ptr<ASTNode> Parser::parseParenthesizedExpression() {
     // ()
     if (matchAndAdvance(TOKEN_OP, ")")) {
 
-        return std::make_shared<TupleNode>(
+        return makeNode<TupleNode>(
             std::vector<std::shared_ptr<ASTNode>>{}
         );
     }
 
     auto first = parseStarredExpression();
 
+    // генераторное выражение: (x for x in xs)
+    if (matchKeyword(Keyword::FOR)) {
+        auto generator = parseComprehension(Comprehension::Kind::Generator, first);
+        consume(TOKEN_OP, ")");
+        return generator;
+    }
+
     // tuple?
     if (match(TOKEN_OP, ",")) {
 
@@ -501,7 +913,7 @@ std::shared_ptr<ASTNode> Parser::parseParenthesizedExpression() {
 
         consume(TOKEN_OP, ")");
 
-        return std::make_shared<TupleNode>(
+        return makeNode<TupleNode>(
             std::move(elements)
         );
     }
@@ -574,7 +986,7 @@ std::shared_ptr<ASTNode> Parser::parseIfStatement() {
         elseBody = parseBlock();
     }
 
-    return std::make_shared<IfNode>(condition, body, elifs, elseBody);
+    return makeNode<IfNode>(condition, body, elifs, elseBody);
 }
 
 /**
@@ -651,7 +1063,7 @@ std::shared_ptr<ASTNode> Parser::parseWhileStatement() {
         elseBody = parseBlock();
     }
 
-    return std::make_shared<WhileNode>(condition, body, elseBody);
+    return makeNode<WhileNode>(condition, body, elseBody);
 }
 
 /**
@@ -667,7 +1079,7 @@ std::shared_ptr<ASTNode> Parser::parseWhileStatement() {
 std::shared_ptr<ASTNode> Parser::parseBreakStatement() {
 
     advance();
-    return std::make_shared<BreakNode>();
+    return makeNode<BreakNode>();
 }
 
 /**
@@ -681,10 +1093,11 @@ std::shared_ptr<ASTNode> Parser::parseBreakStatement() {
 std::shared_ptr<ASTNode> Parser::parseContinueStatement() {
 
     advance();
-    return std::make_shared<ContinueNode>();
+    return makeNode<ContinueNode>();
 }
 
-std::shared_ptr<ASTNode> Parser::parseFunctionDef(const std::vector<std::shared_ptr<ASTNode>>& decorators) {
+std::shared_ptr<ASTNode> Parser::parseFunctionDef(const std::vector<std::shared_ptr<ASTNode>>& decorators,
+                                                  const bool coroutine) {
 
     advance();
 
@@ -739,7 +1152,26 @@ std::shared_ptr<ASTNode> Parser::parseFunctionDef(const std::vector<std::shared_
 
     auto body = parseBlock();
 
-    return std::make_shared<FunctionDefNode>(name, params, body, decorators);
+    auto node = makeNode<FunctionDefNode>(name, params, body, decorators);
+    node->coroutine = coroutine;
+
+    return node;
+}
+
+/// `async def` или `async for`; `async with` интерпретатор не знает, как и `with`
+std::shared_ptr<ASTNode> Parser::parseAsync(const std::vector<std::shared_ptr<ASTNode>>& decorators) {
+
+    advance(); // async
+
+    if (matchKeyword(Keyword::DEF)) {
+        return parseFunctionDef(decorators, true);
+    }
+
+    if (decorators.empty() && matchKeyword(Keyword::FOR)) {
+        return parseForStatement(true);
+    }
+
+    throw std::runtime_error("SyntaxError: expected 'def' or 'for' after 'async'");
 }
 
 std::shared_ptr<ASTNode> Parser::parseReturn() {
@@ -749,16 +1181,268 @@ std::shared_ptr<ASTNode> Parser::parseReturn() {
         case TOKEN_NEWLINE:
         case TOKEN_DEDENT:
         case TOKEN_EOF:
-            return std::make_shared<ReturnNode>(nullptr);
+            return makeNode<ReturnNode>(nullptr);
         default:
-            return std::make_shared<ReturnNode>(parseExpression());
+            return makeNode<ReturnNode>(parseExpression());
     }
 }
 
-std::shared_ptr<ASTNode> Parser::parsePass() {
+/**
+ * Разбирает выражение `yield`. Слово `from` после `yield` не ключевое,
+ * как `match` в CPython: других его употреблений интерпретатор не знает.
+ */
+std::shared_ptr<ASTNode> Parser::parseYield() {
+    advance();
+
+    if (peek().type == TOKEN_ID && peek().value == "from") {
+        advance();
+        return makeNode<YieldNode>(parseBinary(), true);
+    }
+
+    switch (peek().type) {
+        case TOKEN_NEWLINE:
+        case TOKEN_DEDENT:
+        case TOKEN_EOF:
+            return makeNode<YieldNode>(nullptr, false);
+        default:
+            break;
+    }
+
+    if (peek().type == TOKEN_OP && (peek().value == ")" || peek().value == "]" || peek().value == ",")) {
+        return makeNode<YieldNode>(nullptr, false);
+    }
+
+    return makeNode<YieldNode>(parseBinary(), false);
+}
+
+/**
+ * Разбирает `try` с секциями `except [тип [as имя]]`, `else` и `finally`.
+ * Голый `except` должен быть последним, `else` допустим только после `except`.
+ */
+std::shared_ptr<ASTNode> Parser::parseTryStatement() {
+
+    advance(); // try
+
+    consume(TOKEN_OP, ":");
+
+    auto body = parseBlock();
+
+    std::vector<ExceptHandler> handlers;
+
+    while (matchAndAdvance(TOKEN_KEYWORD, "except")) {
+
+        if (!handlers.empty() && !handlers.back().type) {
+            throw std::runtime_error("SyntaxError: default 'except:' must be last");
+        }
+
+        ExceptHandler handler;
+
+        if (!match(TOKEN_OP, ":")) {
+
+            handler.type = parseExpression();
+
+            if (matchAndAdvance(TOKEN_KEYWORD, "as")) {
+
+                if (peek().type != TOKEN_ID) {
+                    throw std::runtime_error("SyntaxError: expected name after 'as'");
+                }
+
+                handler.name = advance().value;
+            }
+        }
+
+        consume(TOKEN_OP, ":");
+        handler.body = parseBlock();
+
+        handlers.push_back(std::move(handler));
+    }
+
+    std::vector<std::shared_ptr<ASTNode>> elseBody;
+
+    if (!handlers.empty() && matchAndAdvance(TOKEN_KEYWORD, "else")) {
+
+        consume(TOKEN_OP, ":");
+        elseBody = parseBlock();
+    }
+
+    std::vector<std::shared_ptr<ASTNode>> finallyBody;
+    bool hasFinally = false;
+
+    if (matchAndAdvance(TOKEN_KEYWORD, "finally")) {
+
+        consume(TOKEN_OP, ":");
+        finallyBody = parseBlock();
+        hasFinally = true;
+    }
+
+    if (handlers.empty() && !hasFinally) {
+        throw std::runtime_error("SyntaxError: expected 'except' or 'finally' block");
+    }
+
+    return makeNode<TryNode>(std::move(body), std::move(handlers), std::move(elseBody), std::move(finallyBody));
+}
+
+/// `raise`, `raise исключение` или `raise исключение from причина`; `from` не ключевое, как в parseYield
+std::shared_ptr<ASTNode> Parser::parseRaise() {
+
+    advance(); // raise
+
+    switch (peek().type) {
+        case TOKEN_NEWLINE:
+        case TOKEN_DEDENT:
+        case TOKEN_EOF:
+            return makeNode<RaiseNode>(nullptr, nullptr);
+        default:
+            break;
+    }
+
+    auto exception = parseExpression();
+    std::shared_ptr<ASTNode> cause;
+
+    if (peek().type == TOKEN_ID && peek().value == "from") {
+        advance();
+        cause = parseExpression();
+    }
+
+    return makeNode<RaiseNode>(std::move(exception), std::move(cause));
+}
+
+QString Parser::parseDottedName() {
+
+    if (peek().type != TOKEN_ID) {
+        throw std::runtime_error("SyntaxError: expected module name");
+    }
+
+    QString name = advance().value;
+
+    while (matchAndAdvance(TOKEN_OP, ".")) {
+
+        if (peek().type != TOKEN_ID) {
+            throw std::runtime_error("SyntaxError: expected name after '.'");
+        }
+
+        name += "." + advance().value;
+    }
+
+    return name;
+}
+
+QString Parser::parseImportAlias() {
+
+    if (peek().type != TOKEN_ID) {
+        throw std::runtime_error("SyntaxError: expected name after 'as'");
+    }
+
+    return advance().value;
+}
+
+std::shared_ptr<ASTNode> Parser::parseImport() {
+
+    advance(); // import
+
+    std::vector<ImportName> modules;
+
+    do {
+
+        ImportName module;
+        module.name = parseDottedName();
+
+        if (matchAndAdvance(TOKEN_KEYWORD, "as")) {
+            module.alias = parseImportAlias();
+        }
+
+        modules.push_back(std::move(module));
+
+    } while (matchAndAdvance(TOKEN_OP, ","));
+
+    return makeNode<ImportNode>(std::move(modules));
+}
+
+std::shared_ptr<ASTNode> Parser::parseFromImport() {
+
+    advance(); // from
+
+    // число точек — на сколько пакетов вверх от текущего искать модуль
+    int level = 0;
+
+    while (matchAndAdvance(TOKEN_OP, ".")) {
+        ++level;
+    }
+
+    const QString module = level > 0 && peek().type != TOKEN_ID ? QString() : parseDottedName();
+
+    consume(TOKEN_KEYWORD, "import");
+
+    std::vector<ImportName> names;
+
+    if (matchAndAdvance(TOKEN_OP, "*")) {
+        return makeNode<ImportFromNode>(module, level, std::move(names));
+    }
+
+    const bool parenthesized = matchAndAdvance(TOKEN_OP, "(");
+
+    do {
+
+        // запятая в конце списка в скобках
+        if (parenthesized && match(TOKEN_OP, ")")) {
+            break;
+        }
+
+        if (peek().type != TOKEN_ID) {
+            throw std::runtime_error("SyntaxError: expected name to import");
+        }
+
+        ImportName name;
+        name.name = advance().value;
+
+        if (matchAndAdvance(TOKEN_KEYWORD, "as")) {
+            name.alias = parseImportAlias();
+        }
+
+        names.push_back(std::move(name));
+
+    } while (matchAndAdvance(TOKEN_OP, ","));
+
+    if (parenthesized) {
+        consume(TOKEN_OP, ")");
+    }
+
+    if (names.empty()) {
+        throw std::runtime_error("SyntaxError: expected names after 'import'");
+    }
+
+    return makeNode<ImportFromNode>(module, level, std::move(names));
+}
+
+std::shared_ptr<ASTNode> Parser::parsePass() {
 
     advance();
-    return std::make_shared<PassNode>();
+    return makeNode<PassNode>();
+}
+
+std::shared_ptr<ASTNode> Parser::parseScopeDeclaration() {
+
+    const bool global = advance().keyword == Keyword::GLOBAL;
+
+    std::vector<QString> names;
+
+    do {
+        if (peek().type != TOKEN_ID) {
+            throw std::runtime_error("SyntaxError: invalid syntax");
+        }
+
+        names.push_back(advance().value);
+    } while (matchAndAdvance(TOKEN_OP, ","));
+
+    if (global) {
+        auto node = makeNode<GlobalNode>();
+        node->names = std::move(names);
+        return node;
+    }
+
+    auto node = makeNode<NonlocalNode>();
+    node->names = std::move(names);
+    return node;
 }
 
 std::shared_ptr<ASTNode> Parser::parseClassDef(const std::vector<std::shared_ptr<ASTNode>>& decorators) {
@@ -804,7 +1488,7 @@ std::shared_ptr<ASTNode> Parser::parseClassDef(const std::vector<std::shared_ptr
         qBody.push_back(stmt);
     }
 
-    return std::make_shared<ClassDefNode>(name, bases, qBody, decorators);
+    return makeNode<ClassDefNode>(name, bases, qBody, decorators);
 }
 
 std::shared_ptr<ASTNode> Parser::parsePostfix(std::shared_ptr<ASTNode> node) {
@@ -818,7 +1502,7 @@ std::shared_ptr<ASTNode> Parser::parsePostfix(std::shared_ptr<ASTNode> node) {
                 throw std::runtime_error("Expected attribute name after '.'");
 
             QString attr = advance().value;
-            node = std::make_shared<AttributeAccessNode>(node, attr);
+            node = makeNode<AttributeAccessNode>(node, attr);
 
             continue;
         }
@@ -842,7 +1526,7 @@ std::shared_ptr<ASTNode> Parser::parsePostfix(std::shared_ptr<ASTNode> node) {
 
             consume(TOKEN_OP, ")");
 
-            node = std::make_shared<CallNode>(node, parsedArgs.positional, parsedArgs.keyword);
+            node = makeNode<CallNode>(node, parsedArgs.positional, parsedArgs.keyword);
 
             continue;
         }
@@ -854,7 +1538,7 @@ std::shared_ptr<ASTNode> Parser::parsePostfix(std::shared_ptr<ASTNode> node) {
 
             consume(TOKEN_OP, "]");
 
-            node = std::make_shared<IndexNode>(node, index);
+            node = makeNode<IndexNode>(node, index);
 
             continue;
         }
@@ -890,6 +1574,10 @@ std::shared_ptr<ASTNode> Parser::parseDecorated() {
         return parseFunctionDef(decorators);
     }
 
+    if (kw == Keyword::ASYNC) {
+        return parseAsync(decorators);
+    }
+
     if (kw == Keyword::CLASS) {
         return parseClassDef(decorators);
     }
@@ -904,13 +1592,20 @@ std::shared_ptr<ASTNode> Parser::parseList() {
 
     // пустой список: []
     if (matchAndAdvance(TOKEN_OP, "]")) {
-        return std::make_shared<ListNode>(std::move(elements));
+        return makeNode<ListNode>(std::move(elements));
     }
 
     while (true) {
 
         elements.push_back(parseStarredExpression());
 
+        // списковое включение: [x for x in xs]
+        if (elements.size() == 1 && matchKeyword(Keyword::FOR)) {
+            auto comprehension = parseComprehension(Comprehension::Kind::List, elements.front());
+            consume(TOKEN_OP, "]");
+            return comprehension;
+        }
+
         // конец списка, например [1, 2, 3]
         if  (matchAndAdvance(TOKEN_OP, "]")) {
             break;
@@ -924,7 +1619,7 @@ std::shared_ptr<ASTNode> Parser::parseList() {
         }
     }
 
-    return std::make_shared<ListNode>(std::move(elements));
+    return makeNode<ListNode>(std::move(elements));
 }
 
 std::shared_ptr<ASTNode> Parser::parseLambda() {
@@ -955,7 +1650,7 @@ std::shared_ptr<ASTNode> Parser::parseLambda() {
 
     auto expr = parseExpression();
 
-    return std::make_shared<LambdaNode>(std::move(params), expr);
+    return makeNode<LambdaNode>(std::move(params), expr);
 }
 
 QString Parser::consume(const TokenType type, const QString& value) {
@@ -1010,37 +1705,6 @@ bool Parser::matchAnyAndAdvance(const TokenType type, const std::vector<QString>
     return false;
 }
 
-bool Parser::isComparisonOperator() const {
-    if (matchAny(
-            TOKEN_OP,
-            {"==","!=","<","<=",">",">="}))
-        return true;
-
-    if (peek().type == TOKEN_KEYWORD &&
-        peek().keyword == Keyword::IN)
-        return true;
-
-    if (peek().type == TOKEN_KEYWORD &&
-        peek().keyword == Keyword::NOT &&
-        current + 1 < tokens.size() &&
-        tokens[current + 1].type == TOKEN_KEYWORD &&
-        tokens[current + 1].keyword == Keyword::IN)
-        return true;
-
-    if (peek().type == TOKEN_KEYWORD &&
-        peek().keyword == Keyword::IS)
-        return true;
-
-    if (peek().type == TOKEN_KEYWORD &&
-    peek().keyword == Keyword::IS &&
-    current + 1 < tokens.size() &&
-    tokens[current + 1].type == TOKEN_KEYWORD &&
-    tokens[current + 1].keyword == Keyword::NOT)
-        return true;
-
-    return false;
-}
-
 QString Parser::parseComparisonOperator() {
 
     if (peek().type == TOKEN_KEYWORD && peek().keyword == Keyword::IS) {
@@ -1079,129 +1743,6 @@ QString Parser::parseComparisonOperator() {
     return advance().value;
 }
 
-std::shared_ptr<ASTNode> Parser::parseUnary() {
-
-    if (matchAndAdvance(TOKEN_OP, "+"))
-        return std::make_shared<UnaryOpNode>(
-            "+",
-            parseUnary()
-        );
-
-    if (matchAndAdvance(TOKEN_OP, "-"))
-        return std::make_shared<UnaryOpNode>(
-            "-",
-            parseUnary()
-        );
-
-    return parsePower();
-}
-
-std::shared_ptr<ASTNode> Parser::parseNot() {
-    if (peek().type == TOKEN_KEYWORD &&
-        peek().keyword == Keyword::NOT) {
-        advance();
-
-        return std::make_shared<UnaryOpNode>(
-            "not",
-            parseNot()
-        );
-    }
-
-    return parseComparison();
-}
-
-std::shared_ptr<ASTNode> Parser::parseAnd() {
-    auto left = parseNot();
-
-    while (peek().type == TOKEN_KEYWORD &&
-        peek().keyword == Keyword::AND) {
-
-        advance();
-
-        auto right = parseNot();
-
-        left = std::make_shared<LogicalOpNode>(left, "and", right);
-    }
-
-    return left;
-}
-
-std::shared_ptr<ASTNode> Parser::parseOr() {
-
-    auto left = parseAnd();
-
-    while (peek().type == TOKEN_KEYWORD &&
-        peek().keyword == Keyword::OR) {
-
-        advance();
-
-        auto right = parseAnd();
-
-        left = std::make_shared<LogicalOpNode>(left, "or", right);
-    }
-
-    return left;
-}
-
-std::shared_ptr<ASTNode> Parser::parseBitOr() {
-
-    auto left = parseBitXor();
-
-    while (matchAndAdvance(TOKEN_OP, "|")) {
-
-        auto right = parseBitXor();
-
-        left = std::make_shared<BinOpNode>(
-            left,
-            "|",
-            right
-        );
-    }
-
-    return left;
-}
-
-std::shared_ptr<ASTNode> Parser::parseBitXor() {
-
-    auto left = parseBitAnd();
-
-    while (matchAndAdvance(TOKEN_OP, "^")) {
-
-        auto right = parseBitAnd();
-
-        left = std::make_shared<BinOpNode>(
-            left,
-            "^",
-            right
-        );
-    }
-
-    return left;
-}
-
-std::shared_ptr<ASTNode> Parser::parseBitAnd() {
-
-    auto left = parseShift();
-
-    while (matchAndAdvance(TOKEN_OP, "&")) {
-
-        auto right = parseShift();
-
-        left = std::make_shared<BinOpNode>(
-            left,
-            "&",
-            right
-        );
-    }
-
-    return left;
-}
-
-//TODO: пока это заглушка
-std::shared_ptr<ASTNode> Parser::parseShift() {
-    return parseAdditionAndSubtraction();
-}
-
 std::shared_ptr<ASTNode>Parser::parseDelStatement() {
 
     consume(TOKEN_KEYWORD, "del");
@@ -1218,7 +1759,7 @@ std::shared_ptr<ASTNode>Parser::parseDelStatement() {
         );
     }
 
-    return std::make_shared<DeleteNode>(target);
+    return makeNode<DeleteNode>(target);
 }
 
 ParsedCallArgs Parser::parseCallArguments() {
@@ -1232,8 +1773,8 @@ ParsedCallArgs Parser::parseCallArguments() {
     while (true) {
 
         if (peek().type == TOKEN_ID &&
-            tokens[current + 1].type == TOKEN_OP &&
-            tokens[current + 1].value == "=") {
+            tokens.at(current + 1).type == TOKEN_OP &&
+            tokens.at(current + 1).value == "=") {
 
             const QString name = advance().value;
 
@@ -1246,6 +1787,12 @@ ParsedCallArgs Parser::parseCallArguments() {
         }
         else {
             result.positional.push_back(parseExpression());
+
+            // единственный аргумент-генератор пишется без скобок: sum(x for x in xs)
+            if (matchKeyword(Keyword::FOR)) {
+                result.positional.back() = parseComprehension(
+                    Comprehension::Kind::Generator, result.positional.back());
+            }
         }
 
         if (matchAndAdvance(TOKEN_OP, ",")) {
@@ -1265,7 +1812,7 @@ std::shared_ptr<ASTNode> Parser::parseDict() {
     consume(TOKEN_OP, "{");
 
     if (matchAndAdvance(TOKEN_OP, "}")) {
-        return std::make_shared<DictNode>(std::move(items));
+        return makeNode<DictNode>(std::move(items));
     }
 
     while (true) {
@@ -1276,7 +1823,7 @@ std::shared_ptr<ASTNode> Parser::parseDict() {
             auto unpackExpr = parseExpression();
 
             items.emplace_back(
-                std::make_shared<DictUnpackNode>(unpackExpr)
+                makeNode<DictUnpackNode>(unpackExpr)
             );
         }
         else {
@@ -1287,7 +1834,14 @@ std::shared_ptr<ASTNode> Parser::parseDict() {
 
             auto value = parseExpression();
 
-            items.emplace_back(std::make_shared<DictPairNode>(key, value));
+            // словарное включение: {k: v for k in xs}
+            if (items.empty() && matchKeyword(Keyword::FOR)) {
+                auto comprehension = parseComprehension(Comprehension::Kind::Dict, key, value);
+                consume(TOKEN_OP, "}");
+                return comprehension;
+            }
+
+            items.emplace_back(makeNode<DictPairNode>(key, value));
         }
 
         // конец dict
@@ -1303,7 +1857,7 @@ std::shared_ptr<ASTNode> Parser::parseDict() {
         }
     }
 
-    return std::make_shared<DictNode>(std::move(items));
+    return makeNode<DictNode>(std::move(items));
 }
 
 std::shared_ptr<ASTNode> Parser::parseSet() {
@@ -1316,6 +1870,13 @@ std::shared_ptr<ASTNode> Parser::parseSet() {
 
         elements.push_back(parseStarredExpression());
 
+        // включение множества: {x for x in xs}
+        if (elements.size() == 1 && matchKeyword(Keyword::FOR)) {
+            auto comprehension = parseComprehension(Comprehension::Kind::Set, elements.front());
+            consume(TOKEN_OP, "}");
+            return comprehension;
+        }
+
         if (matchAndAdvance(TOKEN_OP, "}")) {
             break;
         }
@@ -1327,7 +1888,7 @@ std::shared_ptr<ASTNode> Parser::parseSet() {
         }
     }
 
-    return std::make_shared<SetNode>(std::move(elements));
+    return makeNode<SetNode>(std::move(elements));
 }
 
 bool Parser::isDictLiteral() {
@@ -1336,7 +1897,7 @@ bool Parser::isDictLiteral() {
     int nesting = 0;
 
     while (pos < tokens.size()) {
-        const Token &tok = tokens[pos];
+        const Token &tok = tokens.at(pos);
 
         if (tok.type == TOKEN_OP) {
             if (tok.value == "{"
@@ -1363,15 +1924,20 @@ bool Parser::isDictLiteral() {
     return false;
 }
 
-std::shared_ptr<ASTNode> Parser::parseForStatement() {
+std::shared_ptr<ASTNode> Parser::parseForStatement(const bool isAsync) {
 
     advance(); // for
 
-    if (peek().type != TOKEN_ID) {
-        throw std::runtime_error("Expected variable name after 'for'");
-    }
+    std::vector<QString> targets;
 
-    QString varName = advance().value;
+    do {
+        if (peek().type != TOKEN_ID) {
+            throw std::runtime_error("Expected variable name after 'for'");
+        }
+
+        targets.push_back(advance().value);
+
+    } while (matchAndAdvance(TOKEN_OP, ",") && !matchKeyword(Keyword::IN));
 
     if (peek().type != TOKEN_KEYWORD ||
         peek().keyword.value() != Keyword::IN) {
@@ -1387,19 +1953,87 @@ std::shared_ptr<ASTNode> Parser::parseForStatement() {
 
     auto body = parseBlock();
 
-    return std::make_shared<ForNode>(
-        varName,
+    if (isAsync) {
+        return makeNode<AsyncForNode>(std::move(targets), iterable, body);
+    }
+
+    return makeNode<ForNode>(
+        std::move(targets),
         iterable,
         body
     );
 }
 
+/**
+ * Разбирает секции включения. Цель — имя или несколько имён через запятую;
+ * источник и условия разбираются без тернарного уровня, как `or_test` в CPython,
+ * поэтому `if` после источника начинает условие.
+ */
+std::vector<ComprehensionClause> Parser::parseComprehensionClauses() {
+
+    std::vector<ComprehensionClause> clauses;
+
+    while (matchKeyword(Keyword::FOR)) {
+
+        advance(); // for
+
+        ComprehensionClause clause;
+
+        do {
+            if (peek().type != TOKEN_ID) {
+                throw std::runtime_error("Expected variable name after 'for'");
+            }
+
+            clause.targets.push_back(advance().value);
+
+        } while (matchAndAdvance(TOKEN_OP, ","));
+
+        if (!matchKeyword(Keyword::IN)) {
+            throw std::runtime_error("Expected 'in' after for variable");
+        }
+
+        advance(); // in
+
+        clause.iterable = parseBinary();
+
+        while (matchKeyword(Keyword::IF)) {
+            advance(); // if
+            clause.conditions.push_back(parseBinary());
+        }
+
+        clauses.push_back(std::move(clause));
+    }
+
+    return clauses;
+}
+
+std::shared_ptr<ASTNode> Parser::parseComprehension(const Comprehension::Kind kind,
+                                                    std::shared_ptr<ASTNode> element,
+                                                    std::shared_ptr<ASTNode> value) {
+
+    auto comprehension = std::make_shared<const Comprehension>(
+        kind, std::move(element), std::move(value), parseComprehensionClauses());
+
+    switch (kind) {
+        case Comprehension::Kind::List: return makeNode<ListCompNode>(std::move(comprehension));
+        case Comprehension::Kind::Set: return makeNode<SetCompNode>(std::move(comprehension));
+        case Comprehension::Kind::Dict: return makeNode<DictCompNode>(std::move(comprehension));
+        case Comprehension::Kind::Generator: return makeNode<GeneratorExpNode>(std::move(comprehension));
+    }
+
+    throw std::logic_error("unknown comprehension kind");
+}
+
+bool Parser::matchKeyword(const Keyword keyword) const {
+    return peek().type == TOKEN_KEYWORD && peek().keyword == keyword;
+}
+
 std::shared_ptr<ASTNode> Parser::parseDictOrSet() {
 
     // {}
-    if (tokens[current].value == "{" &&
+    if (tokens.at(current).value == "{" &&
         current + 1 < tokens.size() &&
-        tokens[current + 1].value == "}") {
+        tokens.at(current + 1).value == "}") {
 
         return parseDict();
     }
@@ -1437,7 +2071,7 @@ std::shared_ptr<ASTNode> Parser::parseIndexOrSlice() {
             }
         }
 
-        return std::make_shared<SliceNode>(
+        return makeNode<SliceNode>(
             nullptr,
             stop,
             step
@@ -1471,7 +2105,7 @@ std::shared_ptr<ASTNode> Parser::parseIndexOrSlice() {
         }
     }
 
-    return std::make_shared<SliceNode>(
+    return makeNode<SliceNode>(
         first,
         stop,
         step
@@ -1486,11 +2120,11 @@ std::shared_ptr<ASTNode> Parser::parseIndexOrSlice() {
  *
  * @return Текущий токен, если позиция в потоке допустима; иначе токен типа TOKEN_EOF.
  */
-Token Parser::peek() const {
+const Token& Parser::peek() const {
 
     return current < tokens.size()
-    ? tokens[current]
-    : Token(TOKEN_EOF, "", 0);
+    ? tokens.at(current)
+    : eofToken();
 }
 
 /**
@@ -1502,9 +2136,20 @@ Token Parser::peek() const {
  * @return Текущий Token до продвижения. Если достигнут конец потока токенов,
  *         возвращается токен TOKEN_EOF.
  */
-Token Parser::advance() {
+const Token& Parser::advance() {
 
     return current < tokens.size()
-    ? tokens[current++]
-    : Token(TOKEN_EOF, "", 0);
+    ? tokens.at(current++)
+    : eofToken();
+}
+
+/**
+ * @brief Токен конца потока, который peek() и advance() возвращают за его пределами.
+ *
+ * Токены возвращаются по ссылке, поэтому общий экземпляр не копирует строку значения.
+ */
+const Token& Parser::eofToken() {
+
+    static const Token eof(TOKEN_EOF, QString(), 0);
+    return eof;
 }
@@ -0,0 +1,159 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <QFile>
+#include <QStringList>
+
+#include "ClassValue.h"
+#include "FunctionValue.h"
+#include "OutputStream.h"
+
+namespace {
+
+    double milliseconds(const Profiler::Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+Profiler::Frame::Frame(const FunctionValue& function) : active(enabled) {
+    if (active) {
+        enter(function.ownerClass ? function.ownerClass->name + "." + function.name : function.name);
+    }
+}
+
+void Profiler::start(const QString& stacksPath) {
+
+    Profiler::stacksPath = stacksPath;
+
+    functions.clear();
+    activations.clear();
+    wall = {};
+
+    // узел 0 — корень дерева стеков
+    stacks.assign(1, StackNode{});
+
+    enabled = true;
+}
+
+void Profiler::enter(const QString& name) {
+
+    const int parent = activations.empty() ? 0 : activations.back().node;
+
+    int node;
+
+    if (const auto it = stacks[parent].children.constFind(name); it != stacks[parent].children.constEnd()) {
+        node = it.value();
+    } else {
+        node = static_cast<int>(stacks.size());
+        stacks[parent].children.insert(name, node);
+        stacks.push_back(StackNode{name, parent, {}, {}});
+    }
+
+    Stats& stats = functions[name];
+    ++stats.calls;
+    ++stats.active;
+
+    activations.push_back(Activation{node, &stats, Clock::now()});
+}
+
+void Profiler::leave() {
+
+    const Clock::time_point now = Clock::now();
+    const Activation activation = activations.back();
+    activations.pop_back();
+
+    const Clock::duration elapsed = now - activation.start;
+    const Clock::duration self = elapsed - activation.nested;
+
+    stacks[activation.node].self += self;
+    activation.stats->self += self;
+
+    if (--activation.stats->active == 0) {
+        activation.stats->total += elapsed;
+    }
+
+    if (activations.empty()) {
+        wall += elapsed;
+    } else {
+        activations.back().nested += elapsed;
+    }
+}
+
+void Profiler::report() {
+
+    enabled = false;
+
+    std::vector<std::pair<const QString*, const Stats*>> rows;
+    rows.reserve(functions.size());
+
+    std::uint64_t calls = 0;
+
+    for (const auto& [name, stats] : functions) {
+        rows.emplace_back(&name, &stats);
+        calls += stats.calls;
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        if (a.second->total != b.second->total) {
+            return a.second->total > b.second->total;
+        }
+        return *a.first < *b.first;
+    });
+
+    OutputStream& err = OutputStream::standardError();
+    char line[128];
+
+    std::snprintf(line, sizeof(line), "%llu calls in %.3f ms\n\n   ncalls    self ms   total ms  function\n",
+                  static_cast<unsigned long long>(calls), milliseconds(wall));
+    err.write(std::string_view(line));
+
+    for (const auto& [name, stats] : rows) {
+        std::snprintf(line, sizeof(line), "%9llu %10.3f %10.3f  ",
+                      static_cast<unsigned long long>(stats->calls), milliseconds(stats->self), milliseconds(stats->total));
+        err.write(std::string_view(line));
+        err.write(*name);
+        err.write(std::string_view("\n"));
+    }
+
+    err.flush();
+
+    writeStacks();
+}
+
+void Profiler::writeStacks() {
+
+    if (stacksPath.isEmpty()) {
+        return;
+    }
+
+    QFile file(stacksPath);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        OutputStream::standardError().write(QString("cppython: can't write profile '%1': %2\n")
+                                                .arg(stacksPath, file.errorString()));
+        return;
+    }
+
+    for (std::size_t i = 1; i < stacks.size(); ++i) {
+
+        const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(stacks[i].self).count();
+
+        // flamegraph принимает только целые веса: кадры короче микросекунды не видны и там
+        if (micros <= 0) {
+            continue;
+        }
+
+        QStringList path;
+
+        for (int node = static_cast<int>(i); node > 0; node = stacks[node].parent) {
+            path.prepend(stacks[node].name);
+        }
+
+        file.write((path.join(u';') + " " + QString::number(micros) + "\n").toUtf8());
+    }
+}
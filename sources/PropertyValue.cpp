@@ -2,7 +2,6 @@
 
 #include <stdexcept>
 
-#include "BoundMethod.h"
 #include "CallRuntime.h"
 //
 // Created by semyo on 05.05.2026.
@@ -13,9 +12,8 @@ Value PropertyValue::get(const Value& instance,
         throw std::runtime_error("unreadable attribute");
     }
 
-    // вызываем fget как bound method
-    const auto bound = std::make_shared<BoundMethod>(Value(fget), instance, owner);
-    return callBoundMethod(bound, {}, {});
+    // fget вызывается как метод instance напрямую, без объекта связанного метода
+    return callMethodFunction(fget, instance, owner, {}, {});
 }
 
 QString PropertyValue::toString() const {
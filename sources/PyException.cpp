@@ -0,0 +1,291 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "PyException.h"
+
+#include <algorithm>
+
+#include "CallRuntime.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "Environment.h"
+#include "InstanceValue.h"
+#include "InterpreterContext.h"
+#include "StopIterationException.h"
+#include "TupleValue.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    /// встроенная иерархия исключений: базы перечислены раньше производных классов
+    const std::vector<std::pair<QString, QStringList>>& hierarchy() {
+
+        static const std::vector<std::pair<QString, QStringList>> classes = {
+            {"BaseException", {}},
+            {"Exception", {"BaseException"}},
+            {"ArithmeticError", {"Exception"}},
+            {"ZeroDivisionError", {"ArithmeticError"}},
+            {"OverflowError", {"ArithmeticError"}},
+            {"LookupError", {"Exception"}},
+            {"IndexError", {"LookupError"}},
+            {"KeyError", {"LookupError"}},
+            {"ValueError", {"Exception"}},
+            {"UnicodeError", {"ValueError"}},
+            {"UnicodeEncodeError", {"UnicodeError"}},
+            {"UnicodeDecodeError", {"UnicodeError"}},
+            {"TypeError", {"Exception"}},
+            {"AttributeError", {"Exception"}},
+            {"NameError", {"Exception"}},
+            {"ImportError", {"Exception"}},
+            {"ModuleNotFoundError", {"ImportError"}},
+            {"RuntimeError", {"Exception"}},
+            {"NotImplementedError", {"RuntimeError"}},
+            {"RecursionError", {"RuntimeError"}},
+            {"MemoryError", {"Exception"}},
+            {"StopIteration", {"Exception"}},
+            {"StopAsyncIteration", {"Exception"}},
+            {"AssertionError", {"Exception"}},
+            {"BufferError", {"Exception"}},
+            {"OSError", {"Exception"}},
+            {"FileNotFoundError", {"OSError"}},
+            {"FileExistsError", {"OSError"}},
+            {"ConnectionError", {"OSError"}},
+            {"ConnectionRefusedError", {"ConnectionError"}},
+            {"ConnectionResetError", {"ConnectionError"}},
+            {"BrokenPipeError", {"ConnectionError"}},
+            {"TimeoutError", {"OSError"}},
+            // io.UnsupportedOperation: глобального имени нет, ловится как OSError или ValueError
+            {"UnsupportedOperation", {"OSError", "ValueError"}},
+            // binascii.Error, как и UnsupportedOperation, доступен только через модуль
+            {"Error", {"ValueError"}},
+            // struct.error
+            {"error", {"Exception"}},
+            {"JSONDecodeError", {"ValueError"}},
+            // re.error, он же re.PatternError
+            {"PatternError", {"Exception"}},
+            {"SyntaxError", {"Exception"}},
+            {"IndentationError", {"SyntaxError"}},
+        };
+
+        return classes;
+    }
+
+    const std::vector<Value>* argsOf(const InstanceValue& exception) {
+
+        const Value* args = exception.findField("args");
+
+        return args && args->isTuple() ? &args->asTuple()->items : nullptr;
+    }
+
+    /// класс `cls` — это `base` или его подкласс
+    bool inherits(const Value::ClassPtr& cls, const Value::ClassPtr& base) {
+
+        if (cls == base) {
+            return true;
+        }
+
+        const auto& mro = getMRO(cls);
+
+        return std::find(mro.begin(), mro.end(), base) != mro.end();
+    }
+
+    std::string describe(const Value& exception) {
+
+        const auto& instance = *exception.asInstance();
+        const QString text = PyException::message(instance);
+
+        return (text.isEmpty() ? instance.klass->name : instance.klass->name + ": " + text).toStdString();
+    }
+}
+
+PyException::PyException(Value exception)
+    : std::runtime_error(describe(exception)),
+      object(std::move(exception)),
+      type(object.asInstance()->klass->name) {}
+
+PyException::PyException(const QString& type, const std::string& message)
+    : std::runtime_error(type.toStdString() + ": " + message),
+      type(type) {}
+
+Value PyException::exception() const {
+
+    if (object.isNone()) {
+        const QString text = QString::fromUtf8(what()).mid(type.size() + 2);
+        object = make(type, {Value(text)});
+    }
+
+    return object;
+}
+
+Value PyException::toException(const std::exception& error) {
+
+    if (const auto raised = dynamic_cast<const PyException*>(&error)) {
+        return raised->exception();
+    }
+
+    if (dynamic_cast<const StopIterationException*>(&error)) {
+        return make("StopIteration", {});
+    }
+
+    // «ValueError: текст»; «io.UnsupportedOperation: текст», «binascii.Error: текст», «struct.error: текст»
+    // «json.JSONDecodeError: текст» и «re.PatternError: текст» — классы модулей
+    const QString what = QString::fromUtf8(error.what());
+    const qsizetype colon = what.indexOf(": ");
+
+    QString prefix = colon > 0 ? what.left(colon) : what;
+
+    if (prefix.startsWith("io.")) {
+        prefix.remove(0, 3);
+    } else if (prefix.startsWith("binascii.")) {
+        prefix.remove(0, 9);
+    } else if (prefix.startsWith("struct.")) {
+        prefix.remove(0, 7);
+    } else if (prefix.startsWith("json.")) {
+        prefix.remove(0, 5);
+    } else if (prefix.startsWith("re.")) {
+        prefix.remove(0, 3);
+    }
+
+    if (InterpreterContext::current().exceptionClasses.contains(prefix)) {
+
+        if (colon < 0) {
+            return make(prefix, {});
+        }
+
+        return make(prefix, {Value(what.mid(colon + 2))});
+    }
+
+    return make("RuntimeError", {Value(what)});
+}
+
+void PyException::raise(const Value& exception, const Value& cause) {
+
+    Value object = exception;
+
+    // raise ValueError — то же, что raise ValueError()
+    if (const auto cls = std::get_if<Value::ClassPtr>(&exception.data); cls && isExceptionClass(*cls)) {
+        object = call(exception, {}, {}, nullptr);
+    }
+
+    const auto instance = std::get_if<Value::InstancePtr>(&object.data);
+
+    if (!instance || !isExceptionClass((*instance)->klass)) {
+        throw std::runtime_error("TypeError: exceptions must derive from BaseException");
+    }
+
+    if (!cause.isNone()) {
+        (*instance)->setField("__cause__", cause);
+    }
+
+    if (matches(object, Value(InterpreterContext::current().exceptionClasses.value("AttributeError")))) {
+        throw AttributeErrorException(object);
+    }
+
+    throw PyException(object);
+}
+
+Value PyException::make(const QString& type, std::vector<Value> args) {
+
+    const auto instance = std::make_shared<InstanceValue>(InterpreterContext::current().exceptionClasses.value(type));
+    instance->setField("args", TupleValue::make(std::move(args)));
+
+    return Value(instance);
+}
+
+bool PyException::matches(const Value& exception, const Value& type) {
+
+    if (type.isTuple()) {
+
+        const auto& items = type.asTuple()->items;
+
+        return std::any_of(items.begin(), items.end(), [&](const Value& item) {
+            return matches(exception, item);
+        });
+    }
+
+    const auto cls = std::get_if<Value::ClassPtr>(&type.data);
+
+    if (!cls || !isExceptionClass(*cls)) {
+        throw std::runtime_error("TypeError: catching classes that do not inherit from BaseException is not allowed");
+    }
+
+    return inherits(exception.asInstance()->klass, *cls);
+}
+
+bool PyException::isExceptionClass(const Value::ClassPtr& cls) {
+    return inherits(cls, InterpreterContext::current().baseExceptionClass);
+}
+
+QString PyException::message(const InstanceValue& exception) {
+
+    const std::vector<Value>* args = argsOf(exception);
+
+    if (!args || args->empty()) {
+        return "";
+    }
+
+    // KeyError показывает ключ так, как он записан в коде: str(KeyError('k')) == "'k'"
+    if (args->size() == 1) {
+        return inherits(exception.klass, InterpreterContext::current().exceptionClasses.value("KeyError")) ? args->front().repr() : args->front().toString();
+    }
+
+    return exception.findField("args")->toString();
+}
+
+QString PyException::repr(const InstanceValue& exception) {
+
+    QStringList parts;
+
+    if (const std::vector<Value>* args = argsOf(exception)) {
+        for (const Value& arg : *args) {
+            parts.append(arg.repr());
+        }
+    }
+
+    return exception.klass->name + "(" + parts.join(", ") + ")";
+}
+
+void PyException::registerClasses(const std::shared_ptr<Environment>& globals) {
+
+    InterpreterContext& context = InterpreterContext::current();
+
+    for (const auto& [name, bases] : hierarchy()) {
+
+        const auto cls = std::make_shared<ClassValue>(name);
+
+        if (bases.isEmpty()) {
+            cls->bases.push_back(context.objectClass);
+        }
+
+        for (const QString& base : bases) {
+            cls->bases.push_back(context.exceptionClasses.value(base));
+        }
+
+        context.exceptionClasses.insert(name, cls);
+
+        if (name != "UnsupportedOperation" && name != "Error" && name != "error" && name != "JSONDecodeError"
+            && name != "PatternError") {
+            globals->set(name, Value(cls));
+        }
+    }
+
+    context.baseExceptionClass = context.exceptionClasses.value("BaseException");
+
+    // аргументы конструктора записывает constructClass; __init__ нужен для super().__init__(...)
+    context.baseExceptionClass->setAttribute("__init__", makeBuiltin(
+        "__init__",
+
+        [](const std::vector<Value>& args,
+           const Kwargs&,
+           const std::shared_ptr<Environment>&) -> Value {
+
+            if (args.empty() || !args[0].isInstance()) {
+                throw std::runtime_error("TypeError: descriptor '__init__' requires a 'BaseException' object");
+            }
+
+            args[0].asInstance()->setField("args", TupleValue::make({args.begin() + 1, args.end()}));
+
+            return {};
+        }
+    ));
+}
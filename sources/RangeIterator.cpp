@@ -0,0 +1,48 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "RangeIterator.h"
+
+#include "StopIterationException.h"
+#include "Value.h"
+
+Value RangeIterator::next() {
+
+    std::int64_t value;
+
+    if (!advance(value)) {
+        throw StopIterationException();
+    }
+
+    return Value(value);
+}
+
+bool RangeIterator::hasNext() const {
+    return remaining > 0;
+}
+
+QString RangeIterator::getTypeName() const {
+    return "range_iterator";
+}
+
+Value LongRangeIterator::next() {
+
+    if (remaining <= 0) {
+        throw StopIterationException();
+    }
+
+    Value value(current);
+
+    current += step;
+    --remaining;
+
+    return value;
+}
+
+bool LongRangeIterator::hasNext() const {
+    return remaining > 0;
+}
+
+QString LongRangeIterator::getTypeName() const {
+    return "longrange_iterator";
+}
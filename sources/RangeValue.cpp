@@ -0,0 +1,501 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "RangeValue.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "IntOps.h"
+#include "ObjectPool.h"
+#include "RangeIterator.h"
+#include "SliceValue.h"
+#include "TupleValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/ProtocolHelpers.h"
+
+namespace {
+
+    [[noreturn]] void notInteger(const Value& value) {
+        throw std::runtime_error(
+            "TypeError: '" + value.toString().toStdString() + "' object cannot be interpreted as an integer"
+        );
+    }
+
+    [[noreturn]] void tooLarge() {
+        throw std::runtime_error("OverflowError: Python int too large to convert to C ssize_t");
+    }
+
+    bool isLong(const Value& value) {
+        return std::holds_alternative<Value::BigIntPtr>(value.data);
+    }
+
+    /// аргумент, помещающийся в int64: длинные целые fromArgs отправляет в make()
+    Value::SmallInt rangeArg(const Value& value) {
+
+        if (const auto small = std::get_if<Value::SmallInt>(&value.data)) {
+            return *small;
+        }
+
+        if (value.isBool()) {
+            return value.toBool() ? 1 : 0;
+        }
+
+        notInteger(value);
+    }
+
+    Value::BigInt longRangeArg(const Value& value) {
+
+        if (!value.isBigInt() && !value.isBool()) {
+            notInteger(value);
+        }
+
+        return value.toBigInt();
+    }
+
+    bool fitsSmall(const Value::BigInt& value) {
+        return value >= std::numeric_limits<Value::SmallInt>::min() &&
+               value <= std::numeric_limits<Value::SmallInt>::max();
+    }
+
+    Value::BigInt longLength(const Value::BigInt& start, const Value::BigInt& stop, const Value::BigInt& step) {
+
+        if (step > 0 && start < stop) {
+            return (stop - start - 1) / step + 1;
+        }
+
+        if (step < 0 && start > stop) {
+            return (start - stop - 1) / -step + 1;
+        }
+
+        return 0;
+    }
+
+    /// длина машинной прогрессии или nullopt, если она не помещается в int64
+    std::optional<Value::SmallInt> smallLength(const Value::SmallInt start, const Value::SmallInt stop, const Value::SmallInt step) {
+
+        std::uint64_t distance;
+        std::uint64_t stride;
+
+        if (step > 0 && start < stop) {
+            distance = static_cast<std::uint64_t>(stop) - static_cast<std::uint64_t>(start);
+            stride = static_cast<std::uint64_t>(step);
+        } else if (step < 0 && start > stop) {
+            distance = static_cast<std::uint64_t>(start) - static_cast<std::uint64_t>(stop);
+            stride = 0 - static_cast<std::uint64_t>(step);
+        } else {
+            return 0;
+        }
+
+        const std::uint64_t count = (distance - 1) / stride + 1;
+
+        if (count > static_cast<std::uint64_t>(std::numeric_limits<Value::SmallInt>::max())) {
+            return std::nullopt;
+        }
+
+        return static_cast<Value::SmallInt>(count);
+    }
+
+    Value::SmallInt rangeLength(const Value::SmallInt start, const Value::SmallInt stop, const Value::SmallInt step) {
+
+        const std::optional<Value::SmallInt> length = smallLength(start, stop, step);
+
+        if (!length) {
+            tooLarge();
+        }
+
+        return *length;
+    }
+}
+
+RangeValue::RangeValue(const Value::SmallInt start, const Value::SmallInt stop, const Value::SmallInt step)
+: start(start), stop(stop), step(step), length(rangeLength(start, stop, step)) {}
+
+RangeValue::RangeValue(std::shared_ptr<const Wide> wide)
+: start(0), stop(0), step(1), length(0), wide(std::move(wide)) {}
+
+Value RangeValue::make(const Value::BigInt& start, const Value::BigInt& stop, const Value::BigInt& step) {
+
+    Value::BigInt length = longLength(start, stop, step);
+
+    if (fitsSmall(start) && fitsSmall(stop) && fitsSmall(step) && fitsSmall(length)) {
+        return Value(makePooled<RangeValue>(start.convert_to<Value::SmallInt>(),
+                                            stop.convert_to<Value::SmallInt>(),
+                                            step.convert_to<Value::SmallInt>()));
+    }
+
+    return Value(makePooled<RangeValue>(std::make_shared<const Wide>(Wide{start, stop, step, std::move(length)})));
+}
+
+Value RangeValue::fromArgs(const std::vector<Value>& args) {
+
+    expectArgsRange(args, 1, 3, "range");
+
+    // длинные границы — редкость: обычный range() не трогает длинную арифметику
+    if (std::any_of(args.begin(), args.end(), isLong)) {
+
+        Value::BigInt start = 0;
+        Value::BigInt stop;
+        Value::BigInt step = 1;
+
+        if (args.size() == 1) {
+            stop = longRangeArg(args[0]);
+        } else {
+            start = longRangeArg(args[0]);
+            stop = longRangeArg(args[1]);
+        }
+
+        if (args.size() == 3) {
+            step = longRangeArg(args[2]);
+        }
+
+        if (step == 0) {
+            throw std::runtime_error("ValueError: range() arg 3 must not be zero");
+        }
+
+        return make(start, stop, step);
+    }
+
+    Value::SmallInt start = 0;
+    Value::SmallInt stop;
+    Value::SmallInt step = 1;
+
+    if (args.size() == 1) {
+        stop = rangeArg(args[0]);
+    } else {
+        start = rangeArg(args[0]);
+        stop = rangeArg(args[1]);
+    }
+
+    if (args.size() == 3) {
+
+        step = rangeArg(args[2]);
+
+        if (step == 0) {
+            throw std::runtime_error("ValueError: range() arg 3 must not be zero");
+        }
+    }
+
+    // range(-2**63, 2**63 - 1): границы машинные, а длина — уже нет
+    if (!smallLength(start, stop, step)) {
+        return make(start, stop, step);
+    }
+
+    return Value(makePooled<RangeValue>(start, stop, step));
+}
+
+Value::SmallInt RangeValue::wideLength() const {
+
+    if (!fitsSmall(wide->length)) {
+        tooLarge();
+    }
+
+    return wide->length.convert_to<Value::SmallInt>();
+}
+
+RangeValue::Wide RangeValue::bounds() const {
+
+    if (wide) {
+        return *wide;
+    }
+
+    return Wide{start, stop, step, length};
+}
+
+Value RangeValue::startValue() const {
+    return wide ? Value(wide->start) : Value(start);
+}
+
+Value RangeValue::stopValue() const {
+    return wide ? Value(wide->stop) : Value(stop);
+}
+
+Value RangeValue::stepValue() const {
+    return wide ? Value(wide->step) : Value(step);
+}
+
+Value::IteratorPtr RangeValue::makeIterator(const bool reversed) const {
+
+    if (wide) {
+
+        if (!reversed) {
+            return makePooled<LongRangeIterator>(wide->start, wide->step, wide->length);
+        }
+
+        Value::BigInt last = wide->start;
+
+        if (wide->length > 0) {
+            last += (wide->length - 1) * wide->step;
+        }
+
+        return makePooled<LongRangeIterator>(std::move(last), Value::BigInt(-wide->step), wide->length);
+    }
+
+    if (!reversed) {
+        return makePooled<RangeIterator>(start, step, length);
+    }
+
+    // шаг меняет знак в беззнаковой арифметике: -INT64_MIN не представим
+    const auto back = static_cast<Value::SmallInt>(0 - static_cast<std::uint64_t>(step));
+
+    return makePooled<RangeIterator>(length > 0 ? at(length - 1) : start, back, length);
+}
+
+std::optional<Value::BigInt> RangeValue::wideIndexOf(const Value& value) const {
+
+    if (!value.isBigInt() && !value.isBool()) {
+
+        // не целые сравниваются поэлементно, как и в машинной прогрессии
+        Value::BigInt item = wide->start;
+
+        for (Value::BigInt i = 0; i < wide->length; ++i, item += wide->step) {
+            if (Value(item) == value) {
+                return i;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    const Value::BigInt x = value.toBigInt();
+    Value::BigInt offset = x - wide->start;
+    Value::BigInt stride = wide->step;
+
+    if (stride < 0) {
+        offset = -offset;
+        stride = -stride;
+    }
+
+    if (offset < 0 || offset % stride != 0) {
+        return std::nullopt;
+    }
+
+    const Value::BigInt index = offset / stride;
+
+    if (index >= wide->length) {
+        return std::nullopt;
+    }
+
+    return index;
+}
+
+Value::SmallInt RangeValue::indexOf(const Value& value) const {
+
+    if (wide) {
+
+        const std::optional<Value::BigInt> index = wideIndexOf(value);
+
+        if (!index) {
+            return -1;
+        }
+
+        if (!fitsSmall(*index)) {
+            tooLarge();
+        }
+
+        return index->convert_to<Value::SmallInt>();
+    }
+
+    const auto small = std::get_if<Value::SmallInt>(&value.data);
+
+    if (!small && !value.isBool()) {
+
+        // не целые (2.0 in range(3)) сравниваются поэлементно, как в CPython
+        if (value.isBigInt()) {
+            return -1;
+        }
+
+        for (Value::SmallInt i = 0; i < length; ++i) {
+            if (Value(at(i)) == value) {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    const Value::SmallInt x = small ? *small : (value.toBool() ? 1 : 0);
+
+    std::uint64_t offset;
+    std::uint64_t stride;
+
+    if (step > 0) {
+
+        if (x < start || x >= stop) {
+            return -1;
+        }
+
+        offset = static_cast<std::uint64_t>(x) - static_cast<std::uint64_t>(start);
+        stride = static_cast<std::uint64_t>(step);
+
+    } else {
+
+        if (x > start || x <= stop) {
+            return -1;
+        }
+
+        offset = static_cast<std::uint64_t>(start) - static_cast<std::uint64_t>(x);
+        stride = 0 - static_cast<std::uint64_t>(step);
+    }
+
+    if (offset % stride != 0) {
+        return -1;
+    }
+
+    return static_cast<Value::SmallInt>(offset / stride);
+}
+
+Value RangeValue::getItem(const Value& index) const {
+
+    if (wide) {
+
+        if (index.isSlice()) {
+
+            const NormalizedSlice slice = normalizeSlice(*index.asSlice(), len());
+            const auto item = [this](const Value::SmallInt i) -> Value::BigInt {
+                return wide->start + Value::BigInt(i) * wide->step;
+            };
+
+            return make(item(slice.start), item(slice.stop), wide->step * Value::BigInt(slice.step));
+        }
+
+        if (!index.isBigInt() && !index.isBool()) {
+            throw std::runtime_error("TypeError: range indices must be integers or slices");
+        }
+
+        Value::BigInt i = index.toBigInt();
+
+        if (i < 0) {
+            i += wide->length;
+        }
+
+        if (i < 0 || i >= wide->length) {
+            throw std::runtime_error("IndexError: range object index out of range");
+        }
+
+        return Value(Value::BigInt(wide->start + i * wide->step));
+    }
+
+    if (index.isSlice()) {
+
+        const NormalizedSlice slice = normalizeSlice(*index.asSlice(), length);
+
+        Value::SmallInt sliceStep;
+
+        if (intops::mulOverflow(step, static_cast<Value::SmallInt>(slice.step), sliceStep)) {
+            throw std::runtime_error("OverflowError: Python int too large to convert to C ssize_t");
+        }
+
+        // границы среза переводятся в значения прогрессии, как это делает CPython
+        return Value(makePooled<RangeValue>(at(slice.start), at(slice.stop), sliceStep));
+    }
+
+    if (!index.isBigInt() && !index.isBool()) {
+        throw std::runtime_error("TypeError: range indices must be integers or slices");
+    }
+
+    const auto small = std::get_if<Value::SmallInt>(&index.data);
+
+    Value::SmallInt i = small ? *small : (index.isBool() ? (index.toBool() ? 1 : 0) : length);
+
+    if (i < 0) {
+        i += length;
+    }
+
+    if (i < 0 || i >= length) {
+        throw std::runtime_error("IndexError: range object index out of range");
+    }
+
+    return Value(at(i));
+}
+
+bool RangeValue::contains(const Value& value) const {
+    return wide ? wideIndexOf(value).has_value() : indexOf(value) >= 0;
+}
+
+bool RangeValue::equal(const Value& other) const {
+
+    const auto range = std::get_if<Value::RangePtr>(&other.data);
+
+    if (!range) {
+        return false;
+    }
+
+    const RangeValue& r = **range;
+
+    if (wide || r.wide) {
+
+        const Wide a = bounds();
+        const Wide b = r.bounds();
+
+        return a.length == b.length &&
+               (a.length == 0 || (a.start == b.start && (a.length == 1 || a.step == b.step)));
+    }
+
+    // диапазоны сравниваются как последовательности, а не по аргументам конструктора
+    if (length != r.length) {
+        return false;
+    }
+
+    if (length == 0) {
+        return true;
+    }
+
+    if (start != r.start) {
+        return false;
+    }
+
+    return length == 1 || step == r.step;
+}
+
+bool RangeValue::notEqual(const Value& other) const {
+    return !equal(other);
+}
+
+std::size_t RangeValue::hash() const {
+
+    if (wide) {
+
+        // Value из длинного целого, помещающегося в int64, хешируется как машинное
+        std::vector<Value> key{Value(wide->length), Value(), Value()};
+
+        if (wide->length > 0) {
+            key[1] = Value(wide->start);
+        }
+
+        if (wide->length > 1) {
+            key[2] = Value(wide->step);
+        }
+
+        return Value(makePooled<TupleValue>(std::move(key))).hash();
+    }
+
+    // как в CPython: хеш кортежа (len, start, step), где неважные поля заменены на None
+    std::vector<Value> key{Value(length), Value(), Value()};
+
+    if (length > 0) {
+        key[1] = Value(start);
+    }
+
+    if (length > 1) {
+        key[2] = Value(step);
+    }
+
+    return Value(makePooled<TupleValue>(std::move(key))).hash();
+}
+
+QString RangeValue::toString() const {
+
+    if (wide) {
+
+        const QString bounds = startValue().toString() + ", " + stopValue().toString();
+
+        return wide->step == 1 ? "range(" + bounds + ")" : "range(" + bounds + ", " + stepValue().toString() + ")";
+    }
+
+    if (step == 1) {
+        return QString("range(%1, %2)").arg(start).arg(stop);
+    }
+
+    return QString("range(%1, %2, %3)").arg(start).arg(stop).arg(step);
+}
@@ -0,0 +1,185 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "RegexModule.h"
+
+#include <algorithm>
+
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "InterpreterContext.h"
+#include "RegexValue.h"
+#include "StrValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+#include "../runtime/builtins/re/RegexMethods.h"
+
+namespace {
+
+    /// символы, которые re.escape экранирует обратной косой чертой
+    const QString special = QStringLiteral("()[]{}?*+-|^$\\.&~# \t\n\r\v\f");
+
+    int flagsOf(const Value& value) {
+
+        if (!value.isBigInt() && !value.isBool()) {
+            throw std::runtime_error(
+                "TypeError: flags must be an int, not '" + typeName(value).toStdString() + "'");
+        }
+
+        return value.toBigInt().convert_to<int>();
+    }
+
+    /// скомпилированный шаблон: готовый Pattern или строка через кэш
+    Value compile(const Value& pattern, const int flags) {
+
+        if (PatternValue::of(pattern)) {
+
+            if (flags != 0) {
+                throw std::runtime_error("ValueError: cannot process flags argument with a compiled pattern");
+            }
+
+            return pattern;
+        }
+
+        if (pattern.isBytes() || pattern.isByteArray()) {
+            throw std::runtime_error("TypeError: bytes patterns are not supported");
+        }
+
+        if (!pattern.isString()) {
+            throw std::runtime_error("TypeError: first argument must be string or compiled pattern");
+        }
+
+        return Value(std::static_pointer_cast<ObjectValue>(PatternValue::compile(pattern.asString()->toString(), flags)));
+    }
+
+    /**
+     * re.<name>(pattern, ..., flags=0) → Pattern.<name>(...): flags стоит в позиции flagsAt
+     * или передаётся по имени, остальные аргументы уходят методу как есть.
+     */
+    Value delegate(const char* name, const std::size_t flagsAt, const std::vector<Value>& args,
+                   const Kwargs& kwargs, const std::shared_ptr<Environment>& env) {
+
+        expectArgsRange(args, 1, flagsAt + 1, name);
+
+        int flags = args.size() > flagsAt ? flagsOf(args[flagsAt]) : 0;
+        Kwargs rest;
+
+        for (const auto& [key, value] : kwargs) {
+
+            if (key == "flags") {
+                flags = flagsOf(value);
+            } else {
+                rest.emplace_back(key, value);
+            }
+        }
+
+        const std::vector<Value> methodArgs(args.begin() + 1, args.begin() + static_cast<std::ptrdiff_t>(std::min(args.size(), flagsAt)));
+
+        return callPatternMethod(compile(args[0], flags), name, methodArgs, rest, env);
+    }
+
+    void setDelegate(const std::shared_ptr<ClassValue>& module, const char* name, const std::size_t flagsAt) {
+
+        module->setAttribute(name, makeBuiltin(
+            name,
+            [name, flagsAt](const std::vector<Value>& args, const Kwargs& kwargs,
+                            const std::shared_ptr<Environment>& env) -> Value {
+                return delegate(name, flagsAt, args, kwargs, env);
+            }
+        ));
+    }
+}
+
+Value RegexModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("re");
+
+    module->setAttribute("compile", makeBuiltin(
+        "compile",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgsRange(args, 1, 2, "compile");
+
+            int flags = args.size() > 1 ? flagsOf(args[1]) : 0;
+
+            for (const auto& [name, value] : kwargs) {
+
+                if (name != "flags") {
+                    throw std::runtime_error(
+                        "TypeError: compile() got an unexpected keyword argument '" + name.toStdString() + "'");
+                }
+
+                flags = flagsOf(value);
+            }
+
+            return compile(args[0], flags);
+        }
+    ));
+
+    // позиция flags: re.match(pattern, string, flags), re.sub(pattern, repl, string, count, flags)
+    setDelegate(module, "match", 2);
+    setDelegate(module, "search", 2);
+    setDelegate(module, "fullmatch", 2);
+    setDelegate(module, "findall", 2);
+    setDelegate(module, "finditer", 2);
+    setDelegate(module, "split", 3);
+    setDelegate(module, "sub", 4);
+    setDelegate(module, "subn", 4);
+
+    module->setAttribute("escape", makeBuiltin(
+        "escape",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "escape");
+
+            const QStringView text = args[0].asString("escape")->view();
+
+            QString out;
+            out.reserve(text.size() * 2);
+
+            for (const QChar ch : text) {
+
+                if (special.contains(ch)) {
+                    out += '\\';
+                }
+
+                out += ch;
+            }
+
+            return Value(out);
+        }
+    ));
+
+    module->setAttribute("purge", makeBuiltin(
+        "purge",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 0, "purge");
+            PatternValue::purge();
+
+            return {};
+        }
+    ));
+
+    const std::pair<const char*, int> flags[] = {
+        {"NOFLAG", 0},
+        {"IGNORECASE", PatternValue::IgnoreCase}, {"I", PatternValue::IgnoreCase},
+        {"LOCALE", PatternValue::Locale}, {"L", PatternValue::Locale},
+        {"MULTILINE", PatternValue::Multiline}, {"M", PatternValue::Multiline},
+        {"DOTALL", PatternValue::DotAll}, {"S", PatternValue::DotAll},
+        {"UNICODE", PatternValue::Unicode}, {"U", PatternValue::Unicode},
+        {"VERBOSE", PatternValue::Verbose}, {"X", PatternValue::Verbose},
+        {"ASCII", PatternValue::Ascii}, {"A", PatternValue::Ascii},
+    };
+
+    for (const auto& [name, value] : flags) {
+        module->setAttribute(name, Value(Value::SmallInt(value)));
+    }
+
+    const Value error(InterpreterContext::current().exceptionClasses.value("PatternError"));
+
+    module->setAttribute("error", error);
+    module->setAttribute("PatternError", error);
+
+    return Value(module);
+}
@@ -0,0 +1,614 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "RegexValue.h"
+
+#include <algorithm>
+
+#include <QCache>
+
+#include "ClassUtils.h"
+#include "DictValue.h"
+#include "ListValue.h"
+#include "ObjectPool.h"
+#include "StopIterationException.h"
+#include "StrValue.h"
+#include "TupleValue.h"
+
+namespace {
+
+    /// столько шаблонов держит кэш, как _MAXCACHE модуля re
+    constexpr int cacheSize = 512;
+
+    QCache<QPair<QString, int>, std::shared_ptr<PatternValue>>& cache() {
+
+        static QCache<QPair<QString, int>, std::shared_ptr<PatternValue>> patterns(cacheSize);
+        return patterns;
+    }
+
+    [[noreturn]] void patternError(const QString& message) {
+        throw std::runtime_error("re.PatternError: " + message.toStdString());
+    }
+
+    bool isHex(const QStringView digits) {
+
+        return std::all_of(digits.begin(), digits.end(), [](const QChar ch) {
+            const char16_t c = ch.unicode();
+            return (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'f');
+        });
+    }
+
+    bool isOctal(const QChar ch) {
+        return ch >= '0' && ch <= '7';
+    }
+
+    /// `\Z`, `\uXXXX` и `\UXXXXXXXX` из синтаксиса Python в синтаксис PCRE2
+    QString translate(const QString& pattern) {
+
+        QString out;
+        out.reserve(pattern.size());
+
+        for (qsizetype i = 0; i < pattern.size(); ++i) {
+
+            if (pattern[i] != '\\' || i + 1 >= pattern.size()) {
+                out.append(pattern[i]);
+                continue;
+            }
+
+            const QChar next = pattern[i + 1];
+            const qsizetype digits = next == 'u' ? 4 : next == 'U' ? 8 : 0;
+
+            if (next == 'Z') {
+                out.append(u"\\z");
+            } else if (digits && i + 2 + digits <= pattern.size() && isHex(QStringView(pattern).mid(i + 2, digits))) {
+                out.append(u"\\x{").append(QStringView(pattern).mid(i + 2, digits)).append(u'}');
+                i += digits;
+            } else {
+                out.append(pattern[i]).append(next);
+            }
+
+            ++i;
+        }
+
+        return out;
+    }
+
+    QRegularExpression::PatternOptions patternOptions(const int flags) {
+
+        QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption;
+
+        if (flags & PatternValue::IgnoreCase) options |= QRegularExpression::CaseInsensitiveOption;
+        if (flags & PatternValue::Multiline) options |= QRegularExpression::MultilineOption;
+        if (flags & PatternValue::DotAll) options |= QRegularExpression::DotMatchesEverythingOption;
+        if (flags & PatternValue::Verbose) options |= QRegularExpression::ExtendedPatternSyntaxOption;
+
+        // \w, \d и регистр по Unicode, как у str-шаблонов CPython без re.ASCII
+        if (!(flags & PatternValue::Ascii)) options |= QRegularExpression::UseUnicodePropertiesOption;
+
+        return options;
+    }
+
+    /// группа index совпадения как срез строки-источника или None
+    Value captured(const Value::StrPtr& subject, const QRegularExpressionMatch& match, const int index) {
+
+        const qsizetype start = match.capturedStart(index);
+
+        if (start < 0) {
+            return {};
+        }
+
+        return StrValue::substring(subject, start, match.capturedLength(index));
+    }
+
+    /// кусок шаблона замены: текст или номер группы
+    struct Piece {
+        QString text;
+        int group = -1;
+    };
+
+    /// разбирает шаблон замены re.sub: `\1`, `\g<name>`, `\g<1>` и escape-последовательности
+    std::vector<Piece> parseTemplate(const QString& templ, const PatternValue& pattern) {
+
+        std::vector<Piece> pieces;
+        QString literal;
+
+        const auto addGroup = [&](const int group, const qsizetype at) {
+
+            if (group > pattern.groups()) {
+                patternError(QString("invalid group reference %1 at position %2").arg(group).arg(at));
+            }
+
+            if (!literal.isEmpty()) {
+                pieces.push_back({std::move(literal)});
+                literal.clear();
+            }
+
+            pieces.push_back({QString(), group});
+        };
+
+        for (qsizetype i = 0; i < templ.size(); ++i) {
+
+            if (templ[i] != '\\') {
+                literal.append(templ[i]);
+                continue;
+            }
+
+            const qsizetype at = i++;
+
+            if (i >= templ.size()) {
+                patternError(QString("bad escape (end of pattern) at position %1").arg(at));
+            }
+
+            const QChar ch = templ[i];
+
+            if (ch == 'g') {
+
+                const qsizetype close = templ.indexOf('>', i + 1);
+
+                if (i + 1 >= templ.size() || templ[i + 1] != '<' || close < 0) {
+                    patternError(QString("missing < or > at position %1").arg(i + 1));
+                }
+
+                const QString name = templ.mid(i + 2, close - i - 2);
+
+                if (name.isEmpty()) {
+                    patternError(QString("missing group name at position %1").arg(i + 2));
+                }
+
+                bool numeric = false;
+                const int number = name.toInt(&numeric);
+                const int group = numeric ? number : pattern.groupIndex(name);
+
+                if (group < 0) {
+                    throw std::runtime_error("IndexError: unknown group name '" + name.toStdString() + "'");
+                }
+
+                addGroup(group, i + 2);
+                i = close;
+
+            } else if (ch == '0' || (isOctal(ch) && i + 2 < templ.size() && isOctal(templ[i + 1]) && isOctal(templ[i + 2]))) {
+
+                // восьмеричный код символа: \0, \0o, \0oo или ровно три восьмеричные цифры
+                int code = ch.unicode() - '0';
+                qsizetype taken = 1;
+
+                for (; taken < 3 && i + taken < templ.size() && isOctal(templ[i + taken]); ++taken) {
+                    code = code * 8 + templ[i + taken].unicode() - '0';
+                }
+
+                literal.append(QChar(code));
+                i += taken - 1;
+
+            } else if (ch.isDigit() && ch.unicode() < 0x80) {
+
+                int group = ch.unicode() - '0';
+
+                if (i + 1 < templ.size() && templ[i + 1].isDigit() && templ[i + 1].unicode() < 0x80) {
+                    group = group * 10 + templ[++i].unicode() - '0';
+                }
+
+                addGroup(group, at + 1);
+
+            } else {
+
+                switch (ch.unicode()) {
+                    case 'a':  literal.append(u'\a'); break;
+                    case 'b':  literal.append(u'\b'); break;
+                    case 'f':  literal.append(u'\f'); break;
+                    case 'n':  literal.append(u'\n'); break;
+                    case 'r':  literal.append(u'\r'); break;
+                    case 't':  literal.append(u'\t'); break;
+                    case 'v':  literal.append(u'\v'); break;
+                    case '\\': literal.append(u'\\'); break;
+                    default:
+                        if (ch.unicode() < 0x80 && ch.isLetter()) {
+                            patternError(QString("bad escape \\%1 at position %2").arg(ch).arg(at));
+                        }
+                        literal.append(u'\\').append(ch);
+                }
+            }
+        }
+
+        if (!literal.isEmpty()) {
+            pieces.push_back({std::move(literal)});
+        }
+
+        return pieces;
+    }
+
+    void applyTemplate(const std::vector<Piece>& pieces, const QRegularExpressionMatch& match, QString& out) {
+
+        for (const Piece& piece : pieces) {
+
+            if (piece.group < 0) {
+                out.append(piece.text);
+            } else if (match.capturedStart(piece.group) >= 0) {
+                out.append(match.capturedView(piece.group));
+            }
+        }
+    }
+
+    Value makeMatch(std::shared_ptr<const PatternValue> pattern, const Value::StrPtr& subject,
+                    QRegularExpressionMatch match, const qsizetype pos, const qsizetype endpos) {
+
+        return Value(std::static_pointer_cast<ObjectValue>(std::make_shared<MatchValue>(
+            std::move(pattern), subject, std::move(match), pos, endpos)));
+    }
+}
+
+PatternValue::PatternValue(QString pattern, int flags) : source(std::move(pattern)) {
+
+    if ((flags & Ascii) && (flags & Unicode)) {
+        throw std::runtime_error("ValueError: ASCII and UNICODE flags are incompatible");
+    }
+
+    options = (flags & Ascii) ? flags : flags | Unicode;
+    regex = QRegularExpression(translate(source), patternOptions(options));
+
+    if (!regex.isValid()) {
+        patternError(regex.errorString() + QString(" at position %1").arg(regex.patternErrorOffset()));
+    }
+
+    // JIT-компиляция сразу, а не после нескольких совпадений
+    regex.optimize();
+    names = regex.namedCaptureGroups();
+}
+
+std::shared_ptr<PatternValue> PatternValue::compile(const QString& pattern, const int flags) {
+
+    const QPair<QString, int> key(pattern, flags);
+
+    if (const std::shared_ptr<PatternValue>* hit = cache().object(key)) {
+        return *hit;
+    }
+
+    auto compiled = std::make_shared<PatternValue>(pattern, flags);
+    cache().insert(key, new std::shared_ptr<PatternValue>(compiled));
+
+    return compiled;
+}
+
+void PatternValue::purge() {
+    cache().clear();
+}
+
+PatternValue* PatternValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<PatternValue*>(object->get()) : nullptr;
+}
+
+QString PatternValue::toString() const {
+
+    static const std::pair<int, const char*> flagNames[] = {
+        {IgnoreCase, "re.IGNORECASE"}, {Locale, "re.LOCALE"}, {Multiline, "re.MULTILINE"},
+        {DotAll, "re.DOTALL"}, {Verbose, "re.VERBOSE"}, {Ascii, "re.ASCII"}
+    };
+
+    QStringList shown;
+
+    for (const auto& [flag, name] : flagNames) {
+        if (options & flag) {
+            shown << name;
+        }
+    }
+
+    const QString flagsText = shown.isEmpty() ? QString() : ", " + shown.join('|');
+
+    return "re.compile(" + Value(source).repr() + flagsText + ")";
+}
+
+int PatternValue::groupIndex(const QString& name) const {
+
+    const qsizetype index = names.indexOf(name, 1);
+
+    return name.isEmpty() ? -1 : static_cast<int>(index);
+}
+
+QString PatternValue::window(const Value::StrPtr& subject, const qsizetype endpos) {
+
+    const QString& text = subject->text();
+
+    return endpos < text.size() ? text.left(std::max<qsizetype>(endpos, 0)) : text;
+}
+
+Value PatternValue::match(const Value::StrPtr& subject, qsizetype pos, const qsizetype endpos,
+                          const Anchor anchor) const {
+
+    const QString text = window(subject, endpos);
+    pos = std::clamp<qsizetype>(pos, 0, text.size());
+
+    QRegularExpressionMatch found;
+
+    if (anchor == Anchor::Search) {
+        found = regex.match(text, pos);
+    } else if (anchor == Anchor::Start) {
+        found = regex.match(text, pos, QRegularExpression::NormalMatch, QRegularExpression::AnchorAtOffsetMatchOption);
+    } else {
+
+        if (!anchored) {
+            // перевод строки закрывает комментарий в конце шаблона re.VERBOSE
+            const QString tail = options & Verbose ? "\n)\\z" : ")\\z";
+            anchored.emplace("(?:" + regex.pattern() + tail, regex.patternOptions());
+            anchored->optimize();
+        }
+
+        found = anchored->match(text, pos, QRegularExpression::NormalMatch, QRegularExpression::AnchorAtOffsetMatchOption);
+    }
+
+    if (!found.hasMatch()) {
+        return {};
+    }
+
+    return makeMatch(shared_from_this(), subject, std::move(found), pos, text.size());
+}
+
+Value PatternValue::findIter(const Value::StrPtr& subject, qsizetype pos, const qsizetype endpos) const {
+
+    const QString text = window(subject, endpos);
+    pos = std::clamp<qsizetype>(pos, 0, text.size());
+
+    return Value(std::static_pointer_cast<IteratorValue>(std::make_shared<MatchIterator>(
+        shared_from_this(), subject, regex.globalMatch(text, pos), pos, text.size())));
+}
+
+Value PatternValue::findAll(const Value::StrPtr& subject, qsizetype pos, const qsizetype endpos) const {
+
+    const QString text = window(subject, endpos);
+    pos = std::clamp<qsizetype>(pos, 0, text.size());
+
+    const int count = groups();
+    const Value empty{QString()};
+    const auto result = makePooled<ListValue>();
+
+    for (auto matches = regex.globalMatch(text, pos); matches.hasNext();) {
+
+        const QRegularExpressionMatch found = matches.next();
+
+        if (count <= 1) {
+            const Value group = captured(subject, found, count);
+            result->elements.push_back(group.isNone() ? empty : group);
+            continue;
+        }
+
+        std::vector<Value> items;
+        items.reserve(count);
+
+        for (int i = 1; i <= count; ++i) {
+            const Value group = captured(subject, found, i);
+            items.push_back(group.isNone() ? empty : group);
+        }
+
+        result->elements.push_back(TupleValue::make(std::move(items)));
+    }
+
+    return Value(result);
+}
+
+Value PatternValue::split(const Value::StrPtr& subject, const qsizetype maxsplit) const {
+
+    const QString& text = subject->text();
+    const auto result = makePooled<ListValue>();
+
+    qsizetype last = 0;
+    qsizetype splits = 0;
+
+    for (auto matches = regex.globalMatch(text); matches.hasNext() && (maxsplit <= 0 || splits < maxsplit); ++splits) {
+
+        const QRegularExpressionMatch found = matches.next();
+
+        result->elements.push_back(StrValue::substring(subject, last, found.capturedStart() - last));
+
+        for (int i = 1; i <= groups(); ++i) {
+            result->elements.push_back(captured(subject, found, i));
+        }
+
+        last = found.capturedEnd();
+    }
+
+    result->elements.push_back(StrValue::substring(subject, last, text.size() - last));
+
+    return Value(result);
+}
+
+std::pair<Value, qsizetype> PatternValue::sub(const Value& repl, const Value::StrPtr& subject, const qsizetype count,
+                                               const std::shared_ptr<Environment>& env) const {
+
+    const bool callable = !repl.isString();
+
+    if (callable && !repl.isCallable()) {
+        throw std::runtime_error("TypeError: expected str instance, " + typeName(repl).toStdString() + " found");
+    }
+
+    // шаблон замены разбирается один раз на весь вызов
+    const std::vector<Piece> pieces = callable ? std::vector<Piece>{} : parseTemplate(repl.asString()->toString(), *this);
+
+    const QString& text = subject->text();
+    QString out;
+
+    qsizetype last = 0;
+    qsizetype replaced = 0;
+
+    for (auto matches = regex.globalMatch(text); matches.hasNext() && (count <= 0 || replaced < count); ++replaced) {
+
+        const QRegularExpressionMatch found = matches.next();
+
+        if (replaced == 0) {
+            out.reserve(text.size());
+        }
+
+        out.append(QStringView(text).mid(last, found.capturedStart() - last));
+
+        if (!callable) {
+            applyTemplate(pieces, found, out);
+        } else {
+
+            const Value piece = call(repl, {makeMatch(shared_from_this(), subject, found, 0, text.size())}, {}, env);
+
+            if (!piece.isString()) {
+                throw std::runtime_error("TypeError: expected str instance, " + typeName(piece).toStdString() + " found");
+            }
+
+            out.append(piece.asString()->view());
+        }
+
+        last = found.capturedEnd();
+    }
+
+    // без замен возвращается сама строка
+    if (replaced == 0) {
+        return {Value(subject), 0};
+    }
+
+    out.append(QStringView(text).mid(last));
+
+    return {Value(out), replaced};
+}
+
+bool PatternValue::equal(const Value& other) const {
+
+    const PatternValue* rhs = of(other);
+
+    return rhs && rhs->source == source && rhs->options == options;
+}
+
+bool PatternValue::notEqual(const Value& other) const {
+    return !equal(other);
+}
+
+std::size_t PatternValue::hash() const {
+    return qHash(source) ^ static_cast<std::size_t>(options);
+}
+
+MatchValue::MatchValue(std::shared_ptr<const PatternValue> pattern, Value::StrPtr subject,
+                       QRegularExpressionMatch match, const qsizetype pos, const qsizetype endpos)
+    : regex(std::move(pattern)), string(std::move(subject)), result(std::move(match)), from(pos), to(endpos) {}
+
+MatchValue* MatchValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<MatchValue*>(object->get()) : nullptr;
+}
+
+QString MatchValue::toString() const {
+
+    return QString("<re.Match object; span=(%1, %2), match=%3>")
+        .arg(start(0)).arg(end(0)).arg(group(0).repr());
+}
+
+int MatchValue::groupIndex(const Value& group) const {
+
+    int index = -1;
+
+    if (group.isBigInt() || group.isBool()) {
+
+        const Value::BigInt number = group.toBigInt();
+
+        if (number >= 0 && number <= regex->groups()) {
+            index = number.convert_to<int>();
+        }
+
+    } else if (group.isString()) {
+        index = regex->groupIndex(group.asString()->toString());
+    }
+
+    if (index < 0) {
+        throw std::runtime_error("IndexError: no such group");
+    }
+
+    return index;
+}
+
+Value MatchValue::group(const int index) const {
+    return captured(string, result, index);
+}
+
+Value MatchValue::groups(const Value& fallback) const {
+
+    std::vector<Value> items;
+    items.reserve(regex->groups());
+
+    for (int i = 1; i <= regex->groups(); ++i) {
+        const Value item = group(i);
+        items.push_back(item.isNone() ? fallback : item);
+    }
+
+    return TupleValue::make(std::move(items));
+}
+
+Value MatchValue::groupDict(const Value& fallback) const {
+
+    const auto dict = std::make_shared<DictValue>();
+    const QStringList& names = regex->groupNames();
+
+    for (int i = 1; i < names.size(); ++i) {
+
+        if (names[i].isEmpty()) {
+            continue;
+        }
+
+        const Value item = group(i);
+        dict->setItem(Value(names[i]), item.isNone() ? fallback : item);
+    }
+
+    return Value(dict);
+}
+
+Value MatchValue::expand(const QString& templ) const {
+
+    QString out;
+    applyTemplate(parseTemplate(templ, *regex), result, out);
+
+    return Value(out);
+}
+
+Value MatchValue::lastIndex() const {
+
+    for (int i = regex->groups(); i >= 1; --i) {
+        if (result.capturedStart(i) >= 0) {
+            return Value(Value::SmallInt(i));
+        }
+    }
+
+    return {};
+}
+
+Value MatchValue::lastGroup() const {
+
+    const Value index = lastIndex();
+
+    if (index.isNone()) {
+        return {};
+    }
+
+    const QString& name = regex->groupNames().value(static_cast<qsizetype>(index.toBigInt().convert_to<int>()));
+
+    return name.isEmpty() ? Value() : Value(name);
+}
+
+Value MatchValue::getItem(const Value& index) const {
+    return group(groupIndex(index));
+}
+
+MatchIterator::MatchIterator(std::shared_ptr<const PatternValue> pattern, Value::StrPtr subject,
+                             QRegularExpressionMatchIterator matches, const qsizetype pos, const qsizetype endpos)
+    : pattern(std::move(pattern)), subject(std::move(subject)), matches(std::move(matches)), pos(pos), endpos(endpos) {}
+
+Value MatchIterator::next() {
+
+    if (!hasNext()) {
+        throw StopIterationException();
+    }
+
+    return makeMatch(pattern, subject, matches.next(), pos, endpos);
+}
+
+bool MatchIterator::hasNext() const {
+    return matches.hasNext();
+}
+
+QString MatchIterator::getTypeName() const {
+    return "callable_iterator";
+}
@@ -0,0 +1,230 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ReprWriter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "DictValue.h"
+#include "ListValue.h"
+#include "OutputStream.h"
+#include "RecursionLimit.h"
+#include "SetValue.h"
+#include "StrValue.h"
+#include "TupleValue.h"
+#include "Value.h"
+
+namespace {
+
+/// контейнеры, которые сейчас печатаются в этом потоке, — общие для всех ReprWriter
+thread_local std::vector<const void*> printing;
+
+/**
+ * Вход в контейнер: единица глубины и отметка в printing. Вложенный repr того же
+ * контейнера (через defaultdict или другой приёмник) видит отметку и пишет `...`.
+ */
+class Entry {
+public:
+    explicit Entry(const void* container)
+        : cycle(std::find(printing.begin(), printing.end(), container) != printing.end()) {
+
+        if (!cycle) {
+            printing.push_back(container);
+        }
+    }
+
+    ~Entry() {
+        if (!cycle) {
+            printing.pop_back();
+        }
+    }
+
+    Entry(const Entry&) = delete;
+    Entry& operator=(const Entry&) = delete;
+
+    /// контейнер уже печатается выше по стеку
+    [[nodiscard]] bool repeated() const { return cycle; }
+
+private:
+    RecursionLimit::Guard depth;
+    bool cycle;
+};
+
+}
+
+void ReprWriter::repr(const Value& value) {
+
+    if (const auto small = std::get_if<Value::SmallInt>(&value.data)) {
+
+        char buffer[24];
+        const auto [end, error] = std::to_chars(buffer, buffer + sizeof buffer, *small);
+
+        write(std::string_view(buffer, static_cast<std::size_t>(end - buffer)));
+        return;
+    }
+
+    if (const auto list = std::get_if<Value::ListPtr>(&value.data)) {
+        this->list(**list);
+        return;
+    }
+
+    if (const auto tuple = std::get_if<Value::TuplePtr>(&value.data)) {
+        this->tuple(**tuple);
+        return;
+    }
+
+    // defaultdict, OrderedDict и Counter печатаются своим toString
+    if (const auto dict = std::get_if<Value::DictPtr>(&value.data); dict && typeid(**dict) == typeid(DictValue)) {
+        this->dict(**dict);
+        return;
+    }
+
+    if (const auto set = std::get_if<Value::SetPtr>(&value.data)) {
+        this->set(**set);
+        return;
+    }
+
+    write(value.repr());
+}
+
+void ReprWriter::str(const Value& value) {
+
+    if (const auto text = std::get_if<Value::StrPtr>(&value.data)) {
+        write((*text)->text());
+        return;
+    }
+
+    if (value.isList() || value.isTuple() || value.isDict() || value.isSet()) {
+        repr(value);
+        return;
+    }
+
+    write(value.toString());
+}
+
+void ReprWriter::list(const ListValue& list) {
+
+    const Entry entry(&list);
+
+    if (entry.repeated()) {
+        write(std::string_view("[...]"));
+        return;
+    }
+
+    write(std::string_view("["));
+
+    const auto& elements = std::as_const(list.elements);
+
+    for (std::size_t i = 0; i < elements.size(); ++i) {
+
+        if (i > 0) {
+            write(std::string_view(", "));
+        }
+
+        repr(elements[i]);
+    }
+
+    write(std::string_view("]"));
+}
+
+void ReprWriter::tuple(const TupleValue& tuple) {
+
+    const Entry entry(&tuple);
+
+    if (entry.repeated()) {
+        write(std::string_view("(...)"));
+        return;
+    }
+
+    write(std::string_view("("));
+
+    for (std::size_t i = 0; i < tuple.items.size(); ++i) {
+
+        if (i > 0) {
+            write(std::string_view(", "));
+        }
+
+        repr(tuple.items[i]);
+    }
+
+    // (1,) вместо (1)
+    write(std::string_view(tuple.items.size() == 1 ? ",)" : ")"));
+}
+
+void ReprWriter::dict(const DictValue& dict) {
+
+    const Entry entry(&dict);
+
+    if (entry.repeated()) {
+        write(std::string_view("{...}"));
+        return;
+    }
+
+    write(std::string_view("{"));
+
+    bool first = true;
+
+    dict.forEachItem([&](const Value& key, const Value& value) {
+
+        if (!first) {
+            write(std::string_view(", "));
+        }
+
+        first = false;
+
+        repr(key);
+        write(std::string_view(": "));
+        repr(value);
+    });
+
+    write(std::string_view("}"));
+}
+
+void ReprWriter::set(const SetValue& set) {
+
+    if (set.elements.isEmpty()) {
+        write(std::string_view("set()"));
+        return;
+    }
+
+    const Entry entry(&set);
+
+    write(std::string_view("{"));
+
+    bool first = true;
+
+    set.elements.forEach([&](const Value& value) {
+
+        if (!first) {
+            write(std::string_view(", "));
+        }
+
+        first = false;
+
+        repr(value);
+    });
+
+    write(std::string_view("}"));
+}
+
+void ReprWriter::write(const QStringView text) {
+
+    if (stream) {
+        stream->write(text);
+    } else {
+        target->append(text);
+    }
+}
+
+void ReprWriter::write(const std::string_view text) {
+
+    if (stream) {
+        stream->write(text);
+    } else {
+        target->append(QLatin1String(text.data(), static_cast<qsizetype>(text.size())));
+    }
+}
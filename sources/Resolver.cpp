@@ -0,0 +1,179 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#include "Resolver.h"
+
+#include "Parser.h"
+
+std::shared_ptr<ResolvedScope> Resolver::resolveFunction(
+    const std::vector<Param>& params,
+    const std::vector<std::shared_ptr<ASTNode>>& body) {
+
+    Resolver resolver;
+
+    // слот i — параметр i, даже при повторяющихся именах
+    for (const auto& param : params) {
+        resolver.bound.push_back(param.name);
+        resolver.boundSet.insert(param.name);
+    }
+
+    resolver.visitAll(body);
+
+    const auto isLocal = [&](const QString& name) {
+        return resolver.boundSet.contains(name) && !resolver.excluded.contains(name) && !resolver.globals.contains(name);
+    };
+
+    // локальные переменные, которые читают вложенные области, живут в ячейках
+    QSet<QString> captured;
+
+    for (const ResolvedScope* child : resolver.children) {
+        for (const QString& name : child->freeCandidates) {
+            if (isLocal(name)) {
+                captured.insert(name);
+            }
+        }
+    }
+
+    const auto scope = std::make_shared<ResolvedScope>();
+    scope->layout = std::make_shared<FrameLayout>();
+    scope->children = resolver.children;
+
+    FrameLayout& layout = *scope->layout;
+
+    for (std::size_t i = 0; i < resolver.bound.size(); ++i) {
+
+        const QString& name = resolver.bound[i];
+        const bool param = i < params.size();
+
+        // параметры остаются в своих слотах: callFunction связывает их по индексу
+        if (!param && !isLocal(name)) {
+            continue;
+        }
+
+        if (!captured.contains(name)) {
+            layout.indices.insert(name, static_cast<int>(layout.names.size()));
+            layout.names.push_back(name);
+            continue;
+        }
+
+        const int cell = static_cast<int>(layout.cellNames.size());
+
+        layout.cellIndices.insert(name, cell);
+        layout.cellNames.push_back(name);
+
+        // слот параметра без имени: значение переносится из него в ячейку при вызове
+        if (param) {
+            layout.cellParams.emplace_back(static_cast<int>(layout.names.size()), cell);
+            layout.names.push_back(name);
+        }
+    }
+
+    layout.ownCells = layout.cellNames.size();
+
+    for (const auto& [name, slot] : resolver.references) {
+
+        if (const auto it = layout.indices.constFind(name); it != layout.indices.constEnd()) {
+            *slot = LocalSlot{&layout, it.value()};
+        } else if (const auto cell = layout.cellIndices.constFind(name); cell != layout.cellIndices.constEnd()) {
+            *slot = LocalSlot{&layout, cell.value(), true};
+        } else if (resolver.globals.contains(name)) {
+            slot->global = true;
+        } else {
+            scope->unresolved[name].push_back(slot);
+        }
+    }
+
+    for (auto it = scope->unresolved.cbegin(); it != scope->unresolved.cend(); ++it) {
+        scope->freeCandidates.insert(it.key());
+    }
+
+    for (ResolvedScope* child : resolver.children) {
+        for (const QString& name : child->freeCandidates) {
+            if (layout.cellIndices.contains(name)) {
+                capture(*child, name);
+            } else if (!resolver.globals.contains(name)) {
+                scope->freeCandidates.insert(name);
+            }
+        }
+    }
+
+    return scope;
+}
+
+std::shared_ptr<ResolvedScope> Resolver::resolveClass(const QVector<std::shared_ptr<ASTNode>>& body) {
+
+    Resolver resolver;
+    resolver.visitAll(body);
+
+    // имена самого тела класса не видны методам, поэтому наверх передаются только их имена
+    const auto scope = std::make_shared<ResolvedScope>();
+    scope->children = resolver.children;
+
+    for (const ResolvedScope* child : resolver.children) {
+        scope->freeCandidates.unite(child->freeCandidates);
+    }
+
+    return scope;
+}
+
+void Resolver::capture(ResolvedScope& scope, const QString& name) {
+
+    if (scope.layout) {
+
+        FrameLayout& layout = *scope.layout;
+
+        if (layout.cellIndices.contains(name)) {
+            return;
+        }
+
+        const int cell = static_cast<int>(layout.cellNames.size());
+
+        layout.cellIndices.insert(name, cell);
+        layout.cellNames.push_back(name);
+
+        for (LocalSlot* slot : scope.unresolved.take(name)) {
+            *slot = LocalSlot{&layout, cell, true};
+        }
+    }
+
+    for (ResolvedScope* child : scope.children) {
+        if (child->freeCandidates.contains(name)) {
+            capture(*child, name);
+        }
+    }
+}
+
+void Resolver::visit(const std::shared_ptr<ASTNode>& node) {
+    if (node) {
+        node->resolve(*this);
+    }
+}
+
+void Resolver::use(const QString& name, LocalSlot& slot) {
+    references.emplace_back(name, &slot);
+}
+
+void Resolver::bind(const QString& name, LocalSlot& slot) {
+    bind(name);
+    references.emplace_back(name, &slot);
+}
+
+void Resolver::bind(const QString& name) {
+    if (!boundSet.contains(name)) {
+        boundSet.insert(name);
+        bound.push_back(name);
+    }
+}
+
+void Resolver::exclude(const QString& name) {
+    excluded.insert(name);
+}
+
+void Resolver::declareGlobal(const QString& name) {
+    globals.insert(name);
+}
+
+void Resolver::nested(ResolvedScope& scope) {
+    children.push_back(&scope);
+}
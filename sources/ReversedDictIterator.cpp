@@ -7,7 +7,9 @@
 
 ReversedDictIterator::ReversedDictIterator(std::shared_ptr<const DictValue> dict)
     : dict(std::move(dict)),
-      index(this->dict->getOrder().size() - 1) {}
+      index(this->dict->prevLive(static_cast<std::ptrdiff_t>(this->dict->entryCount()) - 1)),
+      size(this->dict->len()),
+      version(this->dict->version()) {}
 
 Value ReversedDictIterator::next() {
 
@@ -15,10 +17,17 @@ Value ReversedDictIterator::next() {
         throw StopIterationException();
     }
 
-    return dict->getOrder()[index--];
+    const Value key = dict->entryAt(index).key;
+
+    index = dict->prevLive(index - 1);
+
+    return key;
 }
 
 bool ReversedDictIterator::hasNext() const {
+
+    dict->ensureUnchanged(size, version);
+
     return index >= 0;
 }
 
@@ -0,0 +1,100 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "RuntimeStats.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include "OutputStream.h"
+
+namespace {
+
+    constexpr std::array<const char*, RuntimeStats::CounterCount> counterNames = {
+        "environments",
+        "exceptions.StopIteration",
+        "exceptions.break",
+        "exceptions.continue",
+        "exceptions.AttributeError",
+        "attr_cache.hits",
+        "attr_cache.misses",
+        "dict.resizes",
+        "superinstructions.fused",
+        "superinstructions.deopts",
+        "str.inplace_appends",
+    };
+
+    /// имя класса без искажения компилятором и без «class »/«struct » у MSVC
+    std::string typeName(const std::type_info& type) {
+
+        std::string name = type.name();
+
+#if defined(__GNUG__)
+        int status = 0;
+        const std::unique_ptr<char, void (*)(void*)> demangled(
+            abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status), std::free);
+
+        if (status == 0 && demangled) {
+            name = demangled.get();
+        }
+#endif
+
+        for (const std::string prefix : {"class ", "struct "}) {
+            if (name.compare(0, prefix.size(), prefix) == 0) {
+                name.erase(0, prefix.size());
+            }
+        }
+
+        return name;
+    }
+}
+
+std::map<std::string, std::uint64_t>& RuntimeStats::allocations() {
+    static std::map<std::string, std::uint64_t> counts;
+    return counts;
+}
+
+std::uint64_t& RuntimeStats::allocationCounter(const std::type_info& type) {
+    return allocations()[typeName(type)];
+}
+
+std::vector<std::pair<std::string, std::uint64_t>> RuntimeStats::snapshot() {
+
+    std::vector<std::pair<std::string, std::uint64_t>> result;
+    result.reserve(CounterCount + allocations().size());
+
+    for (std::size_t i = 0; i < CounterCount; ++i) {
+        result.emplace_back(counterNames[i], counters[i]);
+    }
+
+    for (const auto& [type, count] : allocations()) {
+        result.emplace_back("alloc." + type, count);
+    }
+
+    return result;
+}
+
+void RuntimeStats::report() {
+
+    OutputStream& err = OutputStream::standardError();
+    char line[160];
+
+    err.write(std::string_view("runtime stats:\n"));
+
+    for (const auto& [name, count] : snapshot()) {
+
+        if (count == 0) {
+            continue;
+        }
+
+        std::snprintf(line, sizeof(line), "%12llu  %s\n", static_cast<unsigned long long>(count), name.c_str());
+        err.write(std::string_view(line));
+    }
+
+    err.flush();
+}
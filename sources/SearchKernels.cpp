@@ -0,0 +1,386 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "SearchKernels.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <QtEndian>
+
+#include "IntOps.h"
+
+namespace searchkernels {
+
+    namespace {
+
+        using Word = std::uint64_t;
+
+        constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        template<typename Char>
+        constexpr int laneBits = 8 * sizeof(Char);
+
+        template<typename Char>
+        constexpr qsizetype laneCount = sizeof(Word) / sizeof(Char);
+
+        /// value в каждой дорожке слова
+        template<typename Char>
+        constexpr Word broadcast(const Char value) {
+            constexpr Word ones = ~Word(0) / ((Word(1) << laneBits<Char>) - 1);
+            return static_cast<Word>(static_cast<std::make_unsigned_t<Char>>(value)) * ones;
+        }
+
+        /// слово текста; дорожки идут в порядке адресов при любом порядке байтов
+        template<typename Char>
+        Word load(const Char* chars) {
+            return qFromLittleEndian<Word>(chars);
+        }
+
+        /**
+         * Старший бит нулевых дорожек. Заём может отметить и дорожку выше настоящего
+         * нуля — такие кандидаты отсеивает полное сравнение, а настоящие нули не теряются.
+         */
+        template<typename Char>
+        constexpr Word zeroLanes(const Word word) {
+            constexpr Word ones = broadcast<Char>(Char(1));
+            constexpr Word highs = ones << (laneBits<Char> - 1);
+            return (word - ones) & ~word & highs;
+        }
+
+        template<typename Char>
+        bool equal(const Char* a, const Char* b, const qsizetype size) {
+            return std::memcmp(a, b, static_cast<std::size_t>(size) * sizeof(Char)) == 0;
+        }
+
+        /// отметки позиций [at, at + laneCount), где совпали первый и последний символы образца
+        template<typename Char>
+        Word edgeHits(const Char* text, const qsizetype at, const Char* needle, const qsizetype size) {
+            return zeroLanes<Char>(load(text + at) ^ broadcast(needle[0])) &
+                   zeroLanes<Char>(load(text + at + size - 1) ^ broadcast(needle[size - 1]));
+        }
+
+        template<typename Char>
+        qsizetype filterFind(const Char* text, const qsizetype size, const Char* needle, const qsizetype length) {
+
+            // последнее возможное начало вхождения
+            const qsizetype last = size - length;
+
+            if constexpr (sizeof(Char) == 1) {
+
+                // один байт — memchr, векторизованный в libc
+                if (length == 1) {
+                    const void* found = std::memchr(text, static_cast<unsigned char>(needle[0]), static_cast<std::size_t>(size));
+                    return found ? static_cast<const Char*>(found) - text : -1;
+                }
+            }
+
+            constexpr qsizetype lanes = laneCount<Char>;
+            qsizetype i = 0;
+
+            for (; i + lanes - 1 <= last; i += lanes) {
+
+                for (Word hits = edgeHits(text, i, needle, length); hits; hits &= hits - 1) {
+
+                    const qsizetype at = i + intops::countTrailingZeros(hits) / laneBits<Char>;
+
+                    if (equal(text + at, needle, length)) {
+                        return at;
+                    }
+                }
+            }
+
+            for (; i <= last; ++i) {
+
+                if (text[i] == needle[0] && equal(text + i, needle, length)) {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        template<typename Char>
+        qsizetype filterRFind(const Char* text, const qsizetype end, const Char* needle, const qsizetype length) {
+
+            constexpr qsizetype lanes = laneCount<Char>;
+            qsizetype last = end - length;
+
+            // слова справа налево, в слове — от старшей дорожки к младшей
+            for (; last + 1 >= lanes; last -= lanes) {
+
+                const qsizetype i = last + 1 - lanes;
+
+                for (Word hits = edgeHits(text, i, needle, length); hits;) {
+
+                    const int bit = 63 - intops::countLeadingZeros(hits);
+                    const qsizetype at = i + bit / laneBits<Char>;
+
+                    if (equal(text + at, needle, length)) {
+                        return at;
+                    }
+
+                    hits &= ~(Word(1) << bit);
+                }
+            }
+
+            for (; last >= 0; --last) {
+
+                if (text[last] == needle[0] && equal(text + last, needle, length)) {
+                    return last;
+                }
+            }
+
+            return -1;
+        }
+
+        template<typename Char>
+        struct Forward {
+            const Char* data;
+
+            Char operator[](const std::size_t i) const {
+                return data[i];
+            }
+        };
+
+        /// текст, читаемый с конца: [0] — последний символ перед end
+        template<typename Char>
+        struct Backward {
+            const Char* end;
+
+            Char operator[](const std::size_t i) const {
+                return *(end - 1 - static_cast<std::ptrdiff_t>(i));
+            }
+        };
+
+        /**
+         * Критическая факторизация: позиция, где делится образец, — большая из позиций
+         * максимальных суффиксов при прямом и обратном порядке символов.
+         */
+        template<typename Text>
+        Factorization factorize(const Text& needle, const std::size_t size) {
+
+            const auto maxSuffix = [&](const bool reversed, std::size_t& period) {
+
+                // npos + k переполняется в k - 1: «суффикс до начала образца»
+                std::size_t suffix = npos;
+                std::size_t j = 0;
+                std::size_t k = 1;
+                std::size_t p = 1;
+
+                while (j + k < size) {
+
+                    const auto a = needle[j + k];
+                    const auto b = needle[suffix + k];
+
+                    if (reversed ? b < a : a < b) {
+                        j += k;
+                        k = 1;
+                        p = j - suffix;
+                    } else if (a == b) {
+                        if (k != p) {
+                            ++k;
+                        } else {
+                            j += p;
+                            k = 1;
+                        }
+                    } else {
+                        suffix = j++;
+                        k = p = 1;
+                    }
+                }
+
+                period = p;
+                return suffix;
+            };
+
+            std::size_t period = 0;
+            std::size_t reversePeriod = 0;
+
+            const std::size_t suffix = maxSuffix(false, period);
+            const std::size_t reverseSuffix = maxSuffix(true, reversePeriod);
+
+            Factorization result;
+
+            if (reverseSuffix + 1 < suffix + 1) {
+                result.suffix = suffix + 1;
+                result.period = period;
+            } else {
+                result.suffix = reverseSuffix + 1;
+                result.period = reversePeriod;
+            }
+
+            result.periodic = result.suffix + result.period <= size;
+
+            for (std::size_t i = 0; result.periodic && i < result.suffix; ++i) {
+                result.periodic = needle[i] == needle[i + result.period];
+            }
+
+            if (!result.periodic) {
+                result.period = std::max(result.suffix, size - result.suffix) + 1;
+            }
+
+            return result;
+        }
+
+        /// двусторонний поиск: правая часть образца сравнивается слева направо, затем левая — справа налево
+        template<typename Text, typename Needle>
+        std::size_t twoWay(const Text& text, const std::size_t size,
+                           const Needle& needle, const std::size_t length, const Factorization& factorization) {
+
+            const std::size_t suffix = factorization.suffix;
+            const std::size_t period = factorization.period;
+
+            std::size_t j = 0;
+
+            if (factorization.periodic) {
+
+                // длина префикса, уже совпавшего при прошлом сдвиге на период
+                std::size_t memory = 0;
+
+                while (j + length <= size) {
+
+                    std::size_t i = std::max(suffix, memory);
+
+                    while (i < length && needle[i] == text[i + j]) {
+                        ++i;
+                    }
+
+                    if (i < length) {
+                        j += i - suffix + 1;
+                        memory = 0;
+                        continue;
+                    }
+
+                    i = suffix - 1;
+
+                    while (memory < i + 1 && needle[i] == text[i + j]) {
+                        --i;
+                    }
+
+                    if (i + 1 < memory + 1) {
+                        return j;
+                    }
+
+                    j += period;
+                    memory = length - period;
+                }
+
+                return npos;
+            }
+
+            while (j + length <= size) {
+
+                std::size_t i = suffix;
+
+                while (i < length && needle[i] == text[i + j]) {
+                    ++i;
+                }
+
+                if (i < length) {
+                    j += i - suffix + 1;
+                    continue;
+                }
+
+                i = suffix - 1;
+
+                while (i != npos && needle[i] == text[i + j]) {
+                    --i;
+                }
+
+                if (i == npos) {
+                    return j;
+                }
+
+                j += period;
+            }
+
+            return npos;
+        }
+    }
+
+    template<typename Char>
+    Pattern<Char>::Pattern(const Char* needle, const qsizetype size) : needle(needle), length(size) {
+
+        if (length >= twoWayThreshold) {
+            const auto m = static_cast<std::size_t>(length);
+            forward = factorize(Forward<Char>{needle}, m);
+            backward = factorize(Backward<Char>{needle + length}, m);
+        }
+    }
+
+    template<typename Char>
+    qsizetype Pattern<Char>::find(const Char* text, const qsizetype size, const qsizetype from) const {
+
+        if (length == 0) {
+            return from <= size ? from : -1;
+        }
+
+        if (size - from < length) {
+            return -1;
+        }
+
+        if (length < twoWayThreshold) {
+            const qsizetype at = filterFind(text + from, size - from, needle, length);
+            return at < 0 ? -1 : from + at;
+        }
+
+        const std::size_t at = twoWay(Forward<Char>{text + from}, static_cast<std::size_t>(size - from),
+                                      Forward<Char>{needle}, static_cast<std::size_t>(length), forward);
+
+        return at == npos ? -1 : from + static_cast<qsizetype>(at);
+    }
+
+    template<typename Char>
+    qsizetype Pattern<Char>::rfind(const Char* text, const qsizetype end) const {
+
+        if (length == 0) {
+            return end;
+        }
+
+        if (end < length) {
+            return -1;
+        }
+
+        if (length < twoWayThreshold) {
+            return filterRFind(text, end, needle, length);
+        }
+
+        // совпадение в позиции j перевёрнутого текста занимает [end - j - length, end - j)
+        const std::size_t at = twoWay(Backward<Char>{text + end}, static_cast<std::size_t>(end),
+                                      Backward<Char>{needle + length}, static_cast<std::size_t>(length), backward);
+
+        return at == npos ? -1 : end - static_cast<qsizetype>(at) - length;
+    }
+
+    template<typename Char>
+    std::vector<qsizetype> Pattern<Char>::findAll(const Char* text, const qsizetype size, const long long limit) const {
+
+        std::vector<qsizetype> positions;
+
+        const auto more = [&] {
+            return limit < 0 || static_cast<long long>(positions.size()) < limit;
+        };
+
+        // пустой образец совпадает перед каждым символом и в конце
+        if (length == 0) {
+
+            for (qsizetype i = 0; i <= size && more(); ++i) {
+                positions.push_back(i);
+            }
+
+            return positions;
+        }
+
+        for (qsizetype pos = 0; more() && (pos = find(text, size, pos)) != -1; pos += length) {
+            positions.push_back(pos);
+        }
+
+        return positions;
+    }
+
+    template class Pattern<char>;
+    template class Pattern<char16_t>;
+}
@@ -11,11 +11,13 @@ Value SetIterator::next() {
         throw StopIterationException();
     }
 
-    return set->order[index++];
+    index = set->elements.nextLive(index);
+
+    return set->elements.at(index++);
 }
 
 bool SetIterator::hasNext() const {
-    return index < set->order.size();
+    return set->elements.nextLive(index) < set->elements.entryCount();
 }
 
 QString SetIterator::getTypeName() const {
@@ -5,30 +5,14 @@
 
 #include "FrozenSetValue.h"
 #include "IteratorValue.h"
+#include "PyException.h"
+#include "ReprWriter.h"
 #include "Value.h"
 
 QString SetValue::toString() const {
 
-    if (order.empty()) {
-        return "set()";
-    }
-
-    QString out = "{";
-
-    bool first = true;
-
-    for (const auto& value : order) {
-
-        if (!first) {
-            out += ", ";
-        }
-
-        first = false;
-
-        out += value.repr();
-    }
-
-    out += "}";
+    QString out;
+    ReprWriter(out).set(*this);
 
     return out;
 }
@@ -38,55 +22,25 @@ QString SetValue::repr() const {
 }
 
 void SetValue::add(const Value& value) {
-
-    if (!elements.contains(value)) {
-        elements.insert(value);
-        order.push_back(value);
-    }
+    elements.insert(value);
 }
 
 void SetValue::remove(const Value& value) {
 
-    if (!elements.contains(value)) {
-        throw std::runtime_error("KeyError: element not found in set");
+    if (!elements.remove(value)) {
+        throw PyException(PyException::make("KeyError", {value}));
     }
-
-    elements.remove(value);
-
-    order.removeIf([&](const Value& v) {
-        return v == value;
-    });
 }
 
 void SetValue::discard(const Value& value) {
-    if (!elements.contains(value)) {
-        return;
-    }
-
     elements.remove(value);
-
-    order.removeIf([&](const Value& v) {
-        return v == value;
-    });
 }
 
 Value SetValue::unionSet(const std::vector<Value>& others) const {
 
-    const auto result = std::make_shared<SetValue>();
-
-    for (const auto& value : order) {
-        result->add(value);
-    }
-
-    for (const auto& iterable : others) {
-
-        const auto it = iterable.getIterator();
+    const auto result = std::make_shared<SetValue>(elements);
 
-        while (it->hasNext()) {
-            result->add(it->next());
-        }
-
-    }
+    result->update(others);
 
     return Value(result);
 }
@@ -97,73 +51,25 @@ bool SetValue::contains(const Value& value) const {
 
 Value SetValue::intersection(const std::vector<Value>& others) const {
 
-    const auto result = std::make_shared<SetValue>();
-
-    result->elements = elements;
-    result->order = order;
-
-    for (const auto& iterable : others) {
-
-        QSet<Value> current;
+    const auto result = std::make_shared<SetValue>(elements);
 
-        const auto it = iterable.getIterator();
-
-        while (it->hasNext()) {
-            current.insert(it->next());
-        }
-
-        for (auto iter = result->elements.begin();
-             iter != result->elements.end();) {
-
-            if (!current.contains(*iter)) {
-                iter = result->elements.erase(iter);
-            }
-            else {
-                ++iter;
-            }
-             }
-    }
-
-    result->order.removeIf(
-        [&](const Value& v) {
-            return !result->elements.contains(v);
-        }
-    );
+    result->intersectionUpdate(others);
 
     return Value(result);
 }
 
 Value SetValue::difference(const std::vector<Value>& others) const {
 
-    const auto result = std::make_shared<SetValue>();
+    const auto result = std::make_shared<SetValue>(elements);
 
-    result->elements = elements;
-    result->order = order;
-
-    for (const auto& iterable : others) {
-
-        const auto it = iterable.getIterator();
-
-        while (it->hasNext()) {
-            result->elements.remove(it->next());
-        }
-    }
-
-    result->order.removeIf(
-        [&](const Value& v) {
-            return !result->elements.contains(v);
-        }
-    );
+    result->differenceUpdate(others);
 
     return Value(result);
 }
 
 Value SetValue::symmetricDifference(const Value& other) const {
 
-    const auto result = std::make_shared<SetValue>();
-
-    result->elements = elements;
-    result->order = order;
+    const auto result = std::make_shared<SetValue>(elements);
 
     result->symmetricDifferenceUpdate(other);
 
@@ -172,22 +78,20 @@ Value SetValue::symmetricDifference(const Value& other) const {
 
 bool SetValue::isSubset(const Value& other) const {
 
-    const auto it = other.getIterator();
-
-    QSet<Value> otherSet;
+    OrderedValueSet storage;
+    const OrderedValueSet& otherSet = OrderedValueSet::of(other, storage);
 
-    while (it->hasNext()) {
-        otherSet.insert(it->next());
+    if (elements.size() > otherSet.size()) {
+        return false;
     }
 
-    for (const auto& value : elements) {
+    bool subset = true;
 
-        if (!otherSet.contains(value)) {
-            return false;
-        }
-    }
+    elements.forEach([&](const Value& value) {
+        subset = subset && otherSet.contains(value);
+    });
 
-    return true;
+    return subset;
 }
 
 bool SetValue::isSuperset(const Value& other) const {
@@ -205,53 +109,38 @@ bool SetValue::isSuperset(const Value& other) const {
 
 bool SetValue::isDisjoint(const Value& other) const {
 
-    const auto it = other.getIterator();
+    OrderedValueSet storage;
+    const OrderedValueSet& otherSet = OrderedValueSet::of(other, storage);
 
-    QSet<Value> otherSet;
+    // проход по меньшему из множеств
+    const bool selfSmaller = elements.size() <= otherSet.size();
+    const OrderedValueSet& smaller = selfSmaller ? elements : otherSet;
+    const OrderedValueSet& larger = selfSmaller ? otherSet : elements;
 
-    while (it->hasNext()) {
-        otherSet.insert(it->next());
-    }
-
-    for (const auto& item : elements) {
+    bool disjoint = true;
 
-        if (otherSet.contains(item)) {
-            return false;
-        }
-    }
+    smaller.forEach([&](const Value& value) {
+        disjoint = disjoint && !larger.contains(value);
+    });
 
-    return true;
+    return disjoint;
 }
 
 Value SetValue::copy() const {
-
-    return Value(
-    std::make_shared<SetValue>(
-        elements,
-        order
-    )
-);
+    return Value(std::make_shared<SetValue>(elements));
 }
 
 void SetValue::clear() {
-
     elements.clear();
-    order.clear();
 }
 
 Value SetValue::pop() {
 
-    if (order.empty()) {
+    if (elements.isEmpty()) {
         throw std::runtime_error("pop from an empty set");
     }
 
-    Value value = order.front();
-
-    order.pop_front();
-
-    elements.remove(value);
-
-    return value;
+    return elements.takeFirst();
 }
 
 void SetValue::update(const std::vector<Value>& others) {
@@ -271,17 +160,17 @@ void SetValue::differenceUpdate(const std::vector<Value>& others) {
 
     for (const auto& iterable : others) {
 
-        QList<Value> snapshot;
-
-        const auto it = iterable.getIterator();
-
-        while (it->hasNext()) {
-            snapshot.push_back(it->next());
+        // s -= s: нельзя удалять элементы во время обхода самого s
+        if (iterable.isSet() && iterable.asSet().get() == this) {
+            clear();
+            continue;
         }
 
-        for (const auto& value : snapshot) {
-            discard(value);
-        }
+        OrderedValueSet storage;
+
+        OrderedValueSet::of(iterable, storage).forEach([this](const Value& value) {
+            elements.remove(value);
+        });
     }
 }
 
@@ -289,87 +178,64 @@ void SetValue::intersectionUpdate(const std::vector<Value>& others) {
 
     for (const auto& iterable : others) {
 
-        QSet<Value> current;
-
-        const auto it = iterable.getIterator();
+        OrderedValueSet storage;
+        const OrderedValueSet& current = OrderedValueSet::of(iterable, storage);
 
-        while (it->hasNext()) {
-            current.insert(it->next());
-        }
-
-        order.removeIf(
-            [&](const Value &v) {
-                return !current.contains(v);
-            });
-
-        QSet<Value> newElements;
-
-        for (const auto& value : order) {
-            newElements.insert(value);
-        }
+        // проход по меньшему из множеств, проверка — в большем
+        const bool selfSmaller = elements.size() <= current.size();
+        const OrderedValueSet& smaller = selfSmaller ? elements : current;
+        const OrderedValueSet& larger = selfSmaller ? current : elements;
 
-        elements = std::move(newElements);
+        OrderedValueSet kept;
 
-        order.removeIf(
-            [&](const Value& v) {
-                return !current.contains(v);
+        smaller.forEach([&](const Value& value) {
+            if (larger.contains(value)) {
+                kept.insert(value);
             }
-        );
+        });
+
+        elements = std::move(kept);
     }
 }
 
 void SetValue::symmetricDifferenceUpdate(const Value& other) {
 
-    QList<Value> newOrder;
-    QSet<Value> newElements;
-
-    QSet<Value> otherSet;
-    QList<Value> otherOrder;
-
-    const auto it = other.getIterator();
-
-    while (it->hasNext()) {
-
-        Value value = it->next();
-
-        otherSet.insert(value);
-        otherOrder.push_back(value);
-    }
-
-    // элементы текущего set, которых нет в other
-    for (const auto& value : order) {
-
-        if (!otherSet.contains(value)) {
-
-            newOrder.push_back(value);
-            newElements.insert(value);
-        }
+    // s ^= s
+    if (other.isSet() && other.asSet().get() == this) {
+        clear();
+        return;
     }
 
-    // элементы other, которых нет в текущем set
-    for (const auto& value : otherOrder) {
-
-        if (!elements.contains(value)) {
+    OrderedValueSet storage;
+    const OrderedValueSet& otherSet = OrderedValueSet::of(other, storage);
 
-            newOrder.push_back(value);
-            newElements.insert(value);
+    // удаление сохраняет порядок остальных, новые элементы встают в конец
+    otherSet.forEach([this](const Value& value) {
+        if (!elements.remove(value)) {
+            elements.insert(value);
         }
-    }
-
-    order = std::move(newOrder);
-    elements = std::move(newElements);
+    });
 }
 
 std::size_t SetValue::len() const {
-    return order.size();
+    return elements.size();
 }
 
 Value SetValue::bitOr(const Value &other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return unionSet({other});
 }
 
 Value SetValue::ror(const Value &other) const {
 
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return other | Value(
         std::const_pointer_cast<SetValue>(
             shared_from_this()
@@ -378,11 +244,20 @@ Value SetValue::ror(const Value &other) const {
 }
 
 Value SetValue::bitAnd(const Value &other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return intersection({other});
 }
 
 Value SetValue::rand(const Value &other) const {
 
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return other & Value(
         std::const_pointer_cast<SetValue>(
             shared_from_this()
@@ -391,11 +266,20 @@ Value SetValue::rand(const Value &other) const {
 }
 
 Value SetValue::sub(const Value &other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return difference({other});
 }
 
 Value SetValue::rsub(const Value &other) const {
 
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return other - Value(
         std::const_pointer_cast<SetValue>(
             shared_from_this()
@@ -404,11 +288,20 @@ Value SetValue::rsub(const Value &other) const {
 }
 
 Value SetValue::bitXor(const Value &other) const {
+
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return symmetricDifference(other);
 }
 
 Value SetValue::rxor(const Value &other) const {
 
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return Value::notImplemented();
+    }
+
     return other ^ Value(
         std::const_pointer_cast<SetValue>(
             shared_from_this()
@@ -418,45 +311,24 @@ Value SetValue::rxor(const Value &other) const {
 
 bool SetValue::equal(const Value& other) const {
 
-    if (other.isSet()) {
-
-        const auto otherSet = other.asSet();
-
-        if (elements.size() != otherSet->elements.size()) {
-            return false;
-        }
-
-        for (const auto& value : elements) {
-
-            if (!otherSet->elements.contains(value)) {
-                return false;
-            }
-        }
-
-        return true;
+    if (!other.isSet() && !other.isFrozenSet()) {
+        return false;
     }
 
-    if (other.isFrozenSet()) {
-
-        const auto frozenPtr = other.asFrozenSet();
+    OrderedValueSet storage;
+    const OrderedValueSet& otherSet = OrderedValueSet::of(other, storage);
 
-        const auto& otherElements = frozenPtr->getElements();
-
-        if (elements.size() != otherElements.size()) {
-            return false;
-        }
+    if (elements.size() != otherSet.size()) {
+        return false;
+    }
 
-        for (const auto& value : elements) {
+    bool same = true;
 
-            if (!otherElements.contains(value)) {
-                return false;
-            }
-        }
-
-        return true;
-    }
+    elements.forEach([&](const Value& value) {
+        same = same && otherSet.contains(value);
+    });
 
-    return false;
+    return same;
 }
 
 bool SetValue::notEqual(const Value &other) const {
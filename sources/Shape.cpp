@@ -0,0 +1,19 @@
+//
+// Created by semyo on 14.10.2026.
+//
+#include "Shape.h"
+
+std::shared_ptr<const Shape> Shape::withField(const QString& name) const {
+
+    if (const auto it = transitions.constFind(name); it != transitions.cend()) {
+        return it.value();
+    }
+
+    const auto child = std::make_shared<Shape>();
+    child->offsets = offsets;
+    child->offsets.insert(name, size());
+
+    transitions.insert(name, child);
+
+    return child;
+}
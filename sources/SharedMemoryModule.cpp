@@ -0,0 +1,138 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "SharedMemoryModule.h"
+
+#include <cstdint>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "MemoryViewValue.h"
+#include "PackedValue.h"
+#include "SharedSegment.h"
+#include "TupleValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    /// формат memoryview того же размера, что элемент массива: `l` у array бывает 4 или 8 байт
+    char viewFormat(const PackedValue& packed) {
+
+        const char code = packed.typecode();
+
+        if (code == 'f' || code == 'd') {
+            return code;
+        }
+
+        const bool isUnsigned = code >= 'A' && code <= 'Z';
+
+        switch (packed.itemSize()) {
+            case 1: return isUnsigned ? 'B' : 'b';
+            case 2: return isUnsigned ? 'H' : 'h';
+            case 4: return isUnsigned ? 'I' : 'i';
+            default: return isUnsigned ? 'Q' : 'q';
+        }
+    }
+
+    template<typename T>
+    void put(QByteArray& out, const T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof value);
+    }
+
+    /// кортеж примитивов, упакованный в один C-тип: все bool — `?`, все int — `q`, int и float — `d`
+    char packTuple(const TupleValue& tuple, QByteArray& out) {
+
+        bool bools = true;
+        bool floats = false;
+
+        for (const Value& item : tuple.items) {
+
+            if (item.isBool()) {
+                continue;
+            }
+
+            bools = false;
+
+            if (item.isDouble()) {
+                floats = true;
+            } else if (!item.isBigInt()) {
+                throw std::runtime_error(
+                    "TypeError: share() tuple items must be bool, int or float, not '" + typeName(item).toStdString() + "'");
+            }
+        }
+
+        const char format = tuple.items.empty() ? 'B' : bools ? '?' : floats ? 'd' : 'q';
+
+        out.reserve(static_cast<qsizetype>(tuple.items.size()) * (format == 'q' || format == 'd' ? 8 : 1));
+
+        for (const Value& item : tuple.items) {
+
+            if (format == '?') {
+                put(out, static_cast<char>(item.toBool()));
+            } else if (format == 'd') {
+                put(out, item.toDouble());
+            } else if (const auto small = std::get_if<Value::SmallInt>(&item.data)) {
+                put(out, *small);
+            } else if (item.isBool()) {
+                put(out, static_cast<std::int64_t>(item.toBool()));
+            } else {
+                throw std::runtime_error("OverflowError: share() int is too large for a 64-bit item");
+            }
+        }
+
+        return format;
+    }
+
+    Value share(const Value& source) {
+
+        QByteArray packed;
+        QByteArrayView data;
+        char format = 'B';
+
+        if (source.isBytes()) {
+            data = source.asBytes()->bytes();
+        } else if (source.isByteArray()) {
+            data = source.asByteArray()->bytes();
+        } else if (const MemoryViewValue* view = MemoryViewValue::of(source)) {
+            packed = view->toBytes();
+            data = packed;
+            format = view->format()[0].toLatin1();
+        } else if (const PackedValue* array = PackedValue::of(source)) {
+            data = array->bytes();
+            format = viewFormat(*array);
+        } else if (const auto tuple = std::get_if<Value::TuplePtr>(&source.data)) {
+            format = packTuple(**tuple, packed);
+            data = packed;
+        } else {
+            throw std::runtime_error(
+                "TypeError: share() argument must be bytes, bytearray, memoryview, array or tuple, not '" +
+                typeName(source).toStdString() + "'");
+        }
+
+        const Value owner(std::static_pointer_cast<ObjectValue>(
+            std::make_shared<SharedBufferValue>(SharedSegment::create(data))));
+
+        // вид байтов сегмента, приведённый к формату элементов
+        return std::make_shared<MemoryViewValue>(owner)->cast(QString(QChar(format)));
+    }
+}
+
+Value SharedMemoryModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("sharedmem");
+
+    module->setAttribute("share", makeBuiltin(
+        "share",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) {
+
+            expectArgs(args, 1, "share");
+
+            return share(args[0]);
+        }
+    ));
+
+    return Value(module);
+}
@@ -0,0 +1,134 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "SharedSegment.h"
+
+#include <mutex>
+
+#include <QDir>
+#include <QHash>
+#include <QTemporaryFile>
+
+namespace {
+
+    /// открытые в процессе сегменты по пути: attach() одного файла не отображает его дважды
+    std::mutex registryMutex;
+    QHash<QString, std::weak_ptr<SharedSegment>>& registry() {
+        static QHash<QString, std::weak_ptr<SharedSegment>> segments;
+        return segments;
+    }
+
+    [[noreturn]] void fail(const char* action, const QString& path, const QString& reason) {
+        throw std::runtime_error(std::string("OSError: can't ") + action + " shared segment '" +
+                                 path.toStdString() + "': " + reason.toStdString());
+    }
+}
+
+std::shared_ptr<SharedSegment> SharedSegment::create(const QByteArrayView data) {
+
+    QTemporaryFile temporary(QDir::temp().filePath("cppython-shared-XXXXXX"));
+    temporary.setAutoRemove(false);
+
+    if (!temporary.open() || temporary.write(data.data(), data.size()) != data.size() || !temporary.flush()) {
+        const QString path = temporary.fileName();
+        temporary.remove();
+        fail("create", path, temporary.errorString());
+    }
+
+    const QString path = temporary.fileName();
+    temporary.close();
+
+    std::shared_ptr<SharedSegment> segment(new SharedSegment(path, true));
+
+    const std::lock_guard lock(registryMutex);
+    registry().insert(path, segment);
+
+    return segment;
+}
+
+std::shared_ptr<SharedSegment> SharedSegment::attach(const QString& path) {
+
+    const std::lock_guard lock(registryMutex);
+
+    if (std::shared_ptr<SharedSegment> open = registry().value(path).lock()) {
+        return open;
+    }
+
+    std::shared_ptr<SharedSegment> segment(new SharedSegment(path, false));
+    registry().insert(path, segment);
+
+    return segment;
+}
+
+SharedSegment::SharedSegment(const QString& path, const bool owner) : file(path), owner(owner) {
+
+    if (!file.open(QIODevice::ReadOnly)) {
+
+        const QString reason = file.errorString();
+
+        if (owner) {
+            file.remove();
+        }
+
+        fail("open", path, reason);
+    }
+
+    const qint64 size = file.size();
+
+    // пустой файл не отображается — пустому сегменту отображение и не нужно
+    if (size > 0) {
+
+        mapped = file.map(0, size);
+
+        if (!mapped) {
+
+            const QString reason = file.errorString();
+            file.close();
+
+            if (owner) {
+                file.remove();
+            }
+
+            fail("map", path, reason);
+        }
+
+        data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<qsizetype>(size));
+    }
+}
+
+SharedSegment::~SharedSegment() {
+
+    {
+        const std::lock_guard lock(registryMutex);
+
+        // под тем же путём уже может быть зарегистрирован новый сегмент
+        const auto it = registry().constFind(file.fileName());
+
+        if (it != registry().constEnd() && it->expired()) {
+            registry().erase(it);
+        }
+    }
+
+    data.clear();
+
+    if (mapped) {
+        file.unmap(mapped);
+    }
+
+    file.close();
+
+    if (owner) {
+        file.remove();
+    }
+}
+
+SharedBufferValue* SharedBufferValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<SharedBufferValue*>(object->get()) : nullptr;
+}
+
+QString SharedBufferValue::toString() const {
+    return QString("<shared buffer '%1', %2 bytes>").arg(path()).arg(bytes().size());
+}
@@ -4,45 +4,130 @@
 
 #include "StrValue.h"
 
-#include <QRegularExpression>
+#include <algorithm>
+#include <array>
 
 #include "BytesValue.h"
 #include "ClassUtils.h"
 #include "DictValue.h"
+#include "HashKernels.h"
 #include "IteratorValue.h"
 #include "ListValue.h"
+#include "ObjectPool.h"
+#include "PyException.h"
+#include "SearchKernels.h"
+#include "TextCodec.h"
+#include "TextKernels.h"
 #include "TupleValue.h"
 #include "Value.h"
 #include "../runtime/ProtocolHelpers.h"
+#include "../runtime/TextScan.h"
 
 namespace {
 
-    std::vector<Value> toValueVector(const QStringList& list) {
+    /// цифра ASCII — без таблиц Unicode
+    bool asciiDigit(const char16_t ch) {
+        return ch >= u'0' && ch <= u'9';
+    }
+
+    /// непустая строка, все символы которой в классе charClass (ASCII) или удовлетворяют wide (остальные)
+    template<typename Wide>
+    bool allChars(const StrValue& str, const textkernels::CharClass charClass, Wide wide) {
 
-        std::vector<Value> result;
-        result.reserve(list.size());
+        const QStringView value = str.view();
 
-        for (const auto& item : list) {
-            result.emplace_back(item);
+        if (value.isEmpty()) {
+            return false;
         }
 
-        return result;
+        if (str.isAscii()) {
+            return textkernels::allOf(value, charClass);
+        }
+
+        return std::all_of(value.begin(), value.end(), wide);
+    }
+
+    /// ASCII-строка в другом регистре — без таблиц Unicode, пословно
+    Value convertAsciiCase(const StrValue& str, const textkernels::Case mode) {
+
+        const QStringView value = str.view();
+        QString result(value.size(), Qt::Uninitialized);
+
+        textkernels::convertCase(value, reinterpret_cast<char16_t*>(result.data()), mode);
+
+        return Value(std::move(result));
+    }
+
+    /// образец поиска по символам needle; needle должна жить дольше образца
+    searchkernels::Pattern<char16_t> pattern(const QStringView needle) {
+        return {needle.utf16(), needle.size()};
+    }
+
+    /// ограничивает [start, end) длиной строки, как это делают срезы Python
+    QStringView clampedView(const QStringView value, const std::optional<Value>& start,
+                            const std::optional<Value>& end, qsizetype& begin) {
+
+        const qsizetype size = value.size();
+
+        begin = start.has_value() ? static_cast<qsizetype>(start->toBigInt()) : 0;
+        qsizetype finish = end.has_value() ? static_cast<qsizetype>(end->toBigInt()) : size;
+
+        begin = std::max<qsizetype>(0, begin);
+        finish = std::min<qsizetype>(finish, size);
+
+        if (begin > finish) {
+            begin = finish;
+        }
+
+        return value.mid(begin, finish - begin);
+    }
+
+}
+
+Value StrValue::substring(const std::shared_ptr<const StrValue>& source,
+                          const qsizetype offset, const qsizetype length) {
+
+    // срез среза ссылается сразу на корневую строку
+    if (const auto parent = source->root) {
+        return substring(parent, source->offset + offset, length);
+    }
+
+    const qsizetype total = source->value.size();
+
+    if (offset == 0 && length == total) {
+        return Value(std::const_pointer_cast<StrValue>(source));
     }
 
+    if (length < minViewLength || length * 4 < total) {
+        return Value(source->value.mid(offset, length));
+    }
+
+    auto slice = makePooled<StrValue>(QString());
+    slice->root = source;
+    slice->offset = offset;
+    slice->length = length;
+
+    return Value(slice);
+}
+
+void StrValue::materialize() const {
+
+    value = view().toString();
+    root.reset();
 }
 
 QString StrValue::toString() const {
-    return value;
+    return text();
 }
 
 QString StrValue::repr() const {
 
     QChar quote;
 
-    if (!value.contains('\'')) {
+    if (!text().contains('\'')) {
         quote = '\'';
     }
-    else if (!value.contains('"')) {
+    else if (!text().contains('"')) {
         quote = '"';
     }
     else {
@@ -51,7 +136,7 @@ QString StrValue::repr() const {
 
     QString escaped;
 
-    for (const QChar ch : value) {
+    for (const QChar ch : text()) {
 
         switch (ch.unicode()) {
 
@@ -87,8 +172,21 @@ QString StrValue::repr() const {
     return QString(quote) + escaped + QString(quote);
 }
 
+StrValue::Kind StrValue::kind() const {
+
+    if (!cachedKind) {
+
+        // старший бит ИЛИ всех символов — старший бит наибольшего из них
+        const char16_t bits = textkernels::unionBits(view());
+
+        cachedKind = bits < 0x80 ? Kind::Ascii : bits < 0x100 ? Kind::Latin1 : Kind::Wide;
+    }
+
+    return *cachedKind;
+}
+
 std::size_t StrValue::len() const {
-    return value.size();
+    return view().size();
 }
 
 
@@ -97,20 +195,28 @@ Value StrValue::getItem(const Value& index) const {
     if (index.isSlice()) {
 
         const auto sliceObj = index.asSlice();
+        const QStringView chars = view();
+        const NormalizedSlice slice = normalizeSlice(*sliceObj, chars.size());
+
+        // непрерывный срез не копирует символы
+        if (slice.step == 1) {
+            return substring(shared_from_this(), slice.start,
+                             std::max(0LL, slice.stop - slice.start));
+        }
 
         QString result;
 
         iterateSlice(
-            normalizeSlice(*sliceObj, value.size()),
+            slice,
             [&](const long long i) {
                 result.append(
-                    value[static_cast<int>(i)]
+                    chars[static_cast<qsizetype>(i)]
                 );
             }
         );
 
         return Value(
-            std::make_shared<StrValue>(result));
+            makePooled<StrValue>(result));
     }
 
 
@@ -118,70 +224,92 @@ Value StrValue::getItem(const Value& index) const {
         throw std::runtime_error("TypeError: string indices must be integers");
     }
 
-    auto i = static_cast<long long>(index.toBigInt());
+    if (const auto small = std::get_if<Value::SmallInt>(&index.data)) {
+        return getItemInt(*small);
+    }
+
+    // длинное целое за пределами любой строки
+    throw std::runtime_error("IndexError: string index out of range");
+}
+
+Value StrValue::getItemInt(Value::SmallInt index) const {
+
+    const QStringView chars = view();
 
-    if (i < 0) {
-        i += value.size();
+    if (index < 0) {
+        index += chars.size();
     }
 
-    if (i < 0 || i >= value.size()) {
+    if (index < 0 || index >= chars.size()) {
         throw std::runtime_error("IndexError: string index out of range");
     }
 
     return Value(
-        std::make_shared<StrValue>(
-            QString(value[static_cast<int>(i)])
+        makePooled<StrValue>(
+            QString(chars[static_cast<qsizetype>(index)])
         )
     );
 }
 
 Value StrValue::upper() const {
-    return Value(value.toUpper());
+
+    if (isAscii()) {
+        return convertAsciiCase(*this, textkernels::Case::Upper);
+    }
+
+    return Value(text().toUpper());
 }
 
 Value StrValue::lower() const {
-    return Value(value.toLower());
+
+    if (isAscii()) {
+        return convertAsciiCase(*this, textkernels::Case::Lower);
+    }
+
+    return Value(text().toLower());
 }
 
 Value StrValue::strip(const std::optional<QString>& chars) const {
 
-    QString result = value;
-
-    // default whitespace strip
-    if (!chars.has_value()) {
-        return Value(result.trimmed());
-    }
+    const QStringView result = view();
 
-    const QString& trimChars = *chars;
+    // по умолчанию срезаются пробельные символы
+    const auto trimmed = [&](const QChar ch) {
+        return chars.has_value() ? chars->contains(ch) : textscan::isStrSpace(ch);
+    };
 
     qsizetype start = 0;
     qsizetype end = result.size() - 1;
 
-    while (start < result.size() && trimChars.contains(result[start])) {
+    while (start < result.size() && trimmed(result[start])) {
         ++start;
     }
 
-    while (end >= start && trimChars.contains(result[end])) {
+    while (end >= start && trimmed(result[end])) {
         --end;
     }
 
-    return Value(
-        result.mid(start, end - start + 1)
-    );
+    return substring(shared_from_this(), start, end - start + 1);
 }
 
 Value StrValue::split(const std::optional<QString>& sep,
     const std::optional<qsizetype> maxSplit) const {
 
-    QStringList parts;
+    // части ссылаются на эту строку, а не копируют её символы
+    const auto self = shared_from_this();
+    const QStringView chars = view();
+
+    std::vector<Value> parts;
 
-    // whitespace split
+    const auto part = [&](const qsizetype start, const qsizetype length) {
+        parts.push_back(substring(self, start, length));
+    };
+
+    // whitespace split: один проход сканера вместо регулярного выражения
     if (!sep.has_value()) {
 
-        parts = value.split(
-            QRegularExpression("\\s+"),
-            Qt::SkipEmptyParts
-        );
+        textscan::splitWhitespace(chars, chars.size(), maxSplit.value_or(-1),
+                                  textscan::isStrSpace, part);
 
     } else {
 
@@ -189,96 +317,117 @@ Value StrValue::split(const std::optional<QString>& sep,
             throw std::runtime_error("empty separator");
         }
 
-        if (maxSplit.has_value()) {
-
-            QString remaining = value;
-            qsizetype splits = 0;
-
-            while (splits < *maxSplit) {
+        const auto separator = pattern(*sep);
 
-                const qsizetype idx = remaining.indexOf(*sep);
-
-                if (idx == -1)
-                    break;
+        qsizetype from = 0;
+        qsizetype splits = 0;
 
-                parts.append(remaining.left(idx));
+        while (!maxSplit.has_value() || splits < *maxSplit) {
 
-                remaining = remaining.mid(idx + sep->size());
+            const qsizetype idx = separator.find(chars.utf16(), chars.size(), from);
 
-                ++splits;
-            }
+            if (idx == -1)
+                break;
 
-            parts.append(remaining);
+            part(from, idx - from);
 
-        } else {
+            from = idx + sep->size();
 
-            parts = value.split(*sep);
+            ++splits;
         }
+
+        part(from, chars.size() - from);
     }
 
     return Value(
-        std::make_shared<ListValue>(
-            toValueVector(parts)
+        makePooled<ListValue>(
+            std::move(parts)
         )
     );
 }
 
+/**
+ * Два прохода по элементам: первый проверяет типы и считает длину результата,
+ * второй копирует части в строку, выделенную один раз.
+ */
 Value StrValue::join(const Value& iterable) const {
 
-    const auto it = iterable.getIterator();
+    std::vector<Value> storage;
+    const std::vector<Value>& items = sequenceItems(iterable, storage);
+
+    const QStringView separator = view();
+    qsizetype total = items.empty() ? 0 : separator.size() * static_cast<qsizetype>(items.size() - 1);
 
-    QStringList parts;
+    for (std::size_t i = 0; i < items.size(); ++i) {
 
-    while (it->hasNext()) {
+        const auto str = std::get_if<Value::StrPtr>(&items[i].data);
 
-        Value item = it->next();
+        if (!str) {
+            throw std::runtime_error("TypeError: sequence item " + std::to_string(i) +
+                                     ": expected str instance, " + typeName(items[i]).toStdString() + " found");
+        }
 
-        parts.append(item.asString("join iterable")->toString());
+        total += (*str)->view().size();
     }
 
-    return Value(parts.join(value));
-}
+    // единственная строка возвращается как есть: строки неизменяемы
+    if (items.size() == 1) {
+        return items[0];
+    }
 
-Value StrValue::replace(
-    const Value& oldValue,
-    const Value& newValue,
-    const std::optional<Value>& count) const {
+    QString result;
+    result.reserve(total);
 
-    const QString oldStr = oldValue.asString("replace")->toString();
-    const QString newStr = newValue.asString("replace")->toString();
+    for (std::size_t i = 0; i < items.size(); ++i) {
 
-    QString result = value;
+        if (i > 0) {
+            result += separator;
+        }
 
-    // replace all
-    if (!count.has_value()) {
+        result += std::get<Value::StrPtr>(items[i].data)->view();
+    }
 
-        result.replace(oldStr, newStr);
+    return Value(std::move(result));
+}
 
-        return Value(result);
-    }
+Value StrValue::replace(
+    const Value& oldValue,
+    const Value& newValue,
+    const std::optional<Value>& count) const {
 
-    const long long limit = static_cast<long long>(count->asBigInt());
+    const QStringView chars = view();
+    const QStringView oldStr = oldValue.asString("replace")->view();
+    const QStringView newStr = newValue.asString("replace")->view();
 
-    if (limit < 0) {
+    const long long limit = count.has_value() ? static_cast<long long>(count->asBigInt()) : -1;
 
-        result.replace(oldStr, newStr);
+    // все вхождения находятся до копирования, и результат выделяется ровно нужного размера
+    const std::vector<qsizetype> positions = pattern(oldStr).findAll(chars.utf16(), chars.size(), limit);
 
-        return Value(result);
+    if (positions.empty()) {
+        return Value(std::const_pointer_cast<StrValue>(shared_from_this()));
     }
 
-    qsizetype pos = 0;
-    long long replaced = 0;
+    QString result(chars.size() + static_cast<qsizetype>(positions.size()) * (newStr.size() - oldStr.size()),
+                   Qt::Uninitialized);
 
-    while ((pos = result.indexOf(oldStr, pos)) != -1 && replaced < limit) {
+    QChar* out = result.data();
 
-        result.replace(pos, oldStr.size(), newStr);
+    const auto append = [&out](const QStringView piece) {
+        out = std::copy(piece.begin(), piece.end(), out);
+    };
 
-        pos += newStr.size();
+    qsizetype copied = 0;
 
-        ++replaced;
+    for (const qsizetype pos : positions) {
+        append(chars.mid(copied, pos - copied));
+        append(newStr);
+        copied = pos + oldStr.size();
     }
 
-    return Value(result);
+    append(chars.mid(copied));
+
+    return Value(std::move(result));
 }
 
 Value StrValue::startswith(
@@ -286,29 +435,11 @@ Value StrValue::startswith(
     const std::optional<Value>& start,
     const std::optional<Value>& end) const {
 
-    QString prefixStr =
+    const QString prefixStr =
         prefix.asString("startwith")->toString();
 
     qsizetype begin = 0;
-    qsizetype finish = value.size();
-
-    if (start.has_value()) {
-        begin = static_cast<qsizetype>(start->asBigInt());
-    }
-
-    if (end.has_value()) {
-        finish = static_cast<qsizetype>(end->asBigInt());
-    }
-
-    // clamp
-    begin = std::max<qsizetype>(0, begin);
-    finish = std::min<qsizetype>(finish, value.size());
-
-    if (begin > finish) {
-        begin = finish;
-    }
-
-    const QString sliced = value.mid(begin, finish - begin);
+    const QStringView sliced = clampedView(view(), start, end, begin);
 
     return Value(sliced.startsWith(prefixStr));
 }
@@ -318,30 +449,11 @@ Value StrValue::endswith(
     const std::optional<Value>& start,
     const std::optional<Value>& end) const {
 
-    QString suffixStr =
+    const QString suffixStr =
         suffix.asString("endswith")->toString();
 
     qsizetype begin = 0;
-    qsizetype finish = value.size();
-
-    if (start.has_value()) {
-        begin = static_cast<qsizetype>(start->toBigInt());
-    }
-
-    if (end.has_value()) {
-        finish = static_cast<qsizetype>(end->toBigInt());
-    }
-
-    // clamp
-    begin = std::max<qsizetype>(0, begin);
-
-    finish = std::min<qsizetype>(finish, value.size());
-
-    if (begin > finish) {
-        begin = finish;
-    }
-
-    const QString sliced = value.mid(begin, finish - begin);
+    const QStringView sliced = clampedView(view(), start, end, begin);
 
     return Value(sliced.endsWith(suffixStr));
 }
@@ -351,31 +463,13 @@ Value StrValue::find(
     const std::optional<Value>& start,
     const std::optional<Value>& end) const {
 
-    const QString subStr = sub.asString("find")->toString();
+    const QStringView subStr = sub.asString("find")->view();
 
+    // поиск идёт по представлению исходной строки, без копии среза
     qsizetype begin = 0;
-    qsizetype finish = value.size();
-
-    if (start.has_value()) {
-        begin = static_cast<qsizetype>(start->toBigInt());
-    }
-
-    if (end.has_value()) {
-        finish = static_cast<qsizetype>(end->toBigInt());
-    }
-
-    // clamp
-    begin = std::max<qsizetype>(0, begin);
-
-    finish = std::min<qsizetype>(finish, value.size());
-
-    if (begin > finish) {
-        begin = finish;
-    }
-
-    const QString sliced = value.mid(begin, finish - begin);
+    const QStringView sliced = clampedView(view(), start, end, begin);
 
-    const qsizetype idx = sliced.indexOf(subStr);
+    const qsizetype idx = pattern(subStr).find(sliced.utf16(), sliced.size());
 
     if (idx == -1) {
         return Value(Value::BigInt(-1));
@@ -391,28 +485,10 @@ Value StrValue::count(
     const std::optional<Value>& start,
     const std::optional<Value>& end) const {
 
-    const QString subStr = sub.asString("count")->toString();
+    const QStringView subStr = sub.asString("count")->view();
 
     qsizetype begin = 0;
-    qsizetype finish = value.size();
-
-    if (start.has_value()) {
-        begin = static_cast<qsizetype>(start->toBigInt());
-    }
-
-    if (end.has_value()) {
-        finish = static_cast<qsizetype>(end->toBigInt() );
-    }
-
-    begin = std::max<qsizetype>(0, begin);
-
-    finish = std::min<qsizetype>(finish, value.size());
-
-    if (begin > finish) {
-        begin = finish;
-    }
-
-    const QString sliced = value.mid(begin, finish - begin);
+    const QStringView sliced = clampedView(view(), start, end, begin);
 
     // особый случай:
     // Python: "".count("") == 1
@@ -420,21 +496,13 @@ Value StrValue::count(
         return Value(Value::BigInt(sliced.size() + 1));
     }
 
-    qsizetype occurrences = 0;
-    qsizetype pos = 0;
-
-    while (true) {
-
-        pos = sliced.indexOf(subStr, pos);
+    const auto needle = pattern(subStr);
 
-        if (pos == -1) {
-            break;
-        }
+    qsizetype occurrences = 0;
 
+    // не пересекающиеся вхождения
+    for (qsizetype pos = 0; (pos = needle.find(sliced.utf16(), sliced.size(), pos)) != -1; pos += subStr.size()) {
         ++occurrences;
-
-        // не пересекающиеся вхождения
-        pos += subStr.size();
     }
 
     return Value(Value::BigInt(occurrences));
@@ -459,30 +527,12 @@ Value StrValue::rfind(
     const std::optional<Value>& start,
     const std::optional<Value>& end) const {
 
-    const QString subStr = sub.asString("rfind")->toString();
+    const QStringView subStr = sub.asString("rfind")->view();
 
     qsizetype begin = 0;
-    qsizetype finish = value.size();
-
-    if (start.has_value()) {
-        begin = static_cast<qsizetype>(start->toBigInt());
-    }
+    const QStringView sliced = clampedView(view(), start, end, begin);
 
-    if (end.has_value()) {
-        finish = static_cast<qsizetype>(end->toBigInt());
-    }
-
-    begin = std::max<qsizetype>(0, begin);
-
-    finish = std::min<qsizetype>(finish, value.size());
-
-    if (begin > finish) {
-        begin = finish;
-    }
-
-    const QString sliced = value.mid(begin, finish - begin);
-
-    const qsizetype pos = sliced.lastIndexOf(subStr);
+    const qsizetype pos = pattern(subStr).rfind(sliced.utf16(), sliced.size());
 
     if (pos == -1) {
         return Value(Value::BigInt(-1));
@@ -507,15 +557,15 @@ Value StrValue::rindex(
 
 Value StrValue::capitalize() const {
 
-    if (value.isEmpty()) {
-        return Value(std::make_shared<StrValue>(""));
+    if (text().isEmpty()) {
+        return Value(makePooled<StrValue>(""));
     }
 
-    QString result = value.toLower();
+    QString result = text().toLower();
 
     result[0] = result[0].toUpper();
 
-    return Value(std::make_shared<StrValue>(result));
+    return Value(makePooled<StrValue>(result));
 }
 
 Value StrValue::title() const {
@@ -524,7 +574,7 @@ Value StrValue::title() const {
 
     bool newWord = true;
 
-    for (const QChar ch : value) {
+    for (const QChar ch : text()) {
 
         if (!ch.isLetterOrNumber()) {
 
@@ -543,14 +593,18 @@ Value StrValue::title() const {
         }
     }
 
-    return Value(std::make_shared<StrValue>(result));
+    return Value(makePooled<StrValue>(result));
 }
 
 Value StrValue::swapcase() const {
 
+    if (isAscii()) {
+        return convertAsciiCase(*this, textkernels::Case::Swap);
+    }
+
     QString result;
 
-    for (const QChar ch : value) {
+    for (const QChar ch : text()) {
 
         if (ch.isUpper()) {
             result += ch.toLower();
@@ -570,92 +624,62 @@ Value StrValue::swapcase() const {
 
 Value StrValue::isalpha() const {
 
-    if (value.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const QChar& ch : value) {
-
-        if (!ch.isLetter()) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(allChars(*this, textkernels::CharClass::Alpha,
+        [](const QChar ch) { return ch.isLetter(); }));
 }
 
 Value StrValue::isdigit() const {
 
-    if (value.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const QChar& ch : value) {
-
-        if (!ch.isDigit()) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(allChars(*this, textkernels::CharClass::Digit,
+        [](const QChar ch) { return ch.isDigit(); }));
 }
 
 Value StrValue::isalnum() const {
 
-    if (value.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const QChar& ch : value) {
-
-        if (!ch.isLetterOrNumber()) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(allChars(*this, textkernels::CharClass::Alnum,
+        [](const QChar ch) { return ch.isLetterOrNumber(); }));
 }
 
 Value StrValue::isspace() const {
 
-    if (value.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const QChar& ch : value) {
-
-        if (!ch.isSpace()) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(allChars(*this, textkernels::CharClass::Space, textscan::isStrSpace));
 }
 
 Value StrValue::add(const Value& other) const {
 
     if (!other.isString()) {
-        throw std::runtime_error(
-            "TypeError: can only concatenate str to str"
-        );
+        return Value::notImplemented();
     }
 
-    QString result = value;
-    result += other.asString("__add__")->value;
+    QString result = text();
+    result += other.asString("__add__")->text();
 
     return Value(
-        std::make_shared<StrValue>(
+        makePooled<StrValue>(
             std::move(result)
         )
     );
 }
 
+void StrValue::append(const StrValue& other) {
+
+    if (root) {
+        materialize();
+    }
+
+    value += other.view();
+    cachedHash.reset();
+
+    // ширина объединения — наибольшая из ширин частей
+    if (cachedKind) {
+        cachedKind = std::max(*cachedKind, other.kind());
+    }
+}
+
 Value StrValue::multiply(const Value& other) const {
 
     if (!other.isNumeric() || other.isBigFloat()) {
-        throw std::runtime_error(
-            "TypeError: can't multiply sequence by non-int"
-        );
+        return Value::notImplemented();
     }
 
     const Value::BigInt numVal = other.toBigInt();
@@ -667,7 +691,7 @@ Value StrValue::multiply(const Value& other) const {
         throw std::runtime_error("String repetition too large");
     }
 
-    return Value(value.repeated(static_cast<qsizetype>(numVal)));
+    return Value(text().repeated(static_cast<qsizetype>(numVal)));
 
 }
 
@@ -676,7 +700,7 @@ bool StrValue::equal(const Value &other) const {
     if (!other.isString())
         return false;
 
-    return value == other.asString("__eq__")->value;
+    return view() == other.asString("__eq__")->view();
 }
 
 bool StrValue::notEqual(const Value &other) const {
@@ -684,7 +708,7 @@ bool StrValue::notEqual(const Value &other) const {
     if (!other.isString())
         return true;
 
-    return value != other.asString("__ne__")->value;
+    return view() != other.asString("__ne__")->view();
 }
 
 bool StrValue::lessOrEqual(const Value &other) const {
@@ -695,7 +719,7 @@ bool StrValue::lessOrEqual(const Value &other) const {
         );
     }
 
-    return value <= other.asString("__le__")->value;
+    return view() <= other.asString("__le__")->view();
 }
 
 bool StrValue::less(const Value &other) const {
@@ -706,7 +730,7 @@ bool StrValue::less(const Value &other) const {
         );
     }
 
-    return value < other.asString("__lt__")->value;
+    return view() < other.asString("__lt__")->view();
 }
 
 bool StrValue::greaterOrEqual(const Value &other) const {
@@ -717,7 +741,7 @@ bool StrValue::greaterOrEqual(const Value &other) const {
         );
     }
 
-    return value >= other.asString("__ge__")->value;
+    return view() >= other.asString("__ge__")->view();
 }
 
 bool StrValue::greater(const Value &other) const {
@@ -728,7 +752,7 @@ bool StrValue::greater(const Value &other) const {
         );
     }
 
-    return value > other.asString("__gt__")->value;
+    return view() > other.asString("__gt__")->view();
 }
 
 QString StrValue::escapeString(const QString &str) {
@@ -790,11 +814,11 @@ Value StrValue::center(
         }
     }
 
-    if (width <= value.size()) {
-        return Value(value);
+    if (width <= text().size()) {
+        return Value(text());
     }
 
-    const qsizetype marg = width - value.size();
+    const qsizetype marg = width - text().size();
 
     const qsizetype left = marg / 2 + (marg & width & 1);
 
@@ -802,7 +826,7 @@ Value StrValue::center(
 
     return Value(
         QString(left, fillChar[0]) +
-        value +
+        text() +
         QString(right, fillChar[0])
     );
 }
@@ -826,13 +850,13 @@ Value StrValue::ljust(
         }
     }
 
-    if (width <= value.size()) {
-        return Value(value);
+    if (width <= text().size()) {
+        return Value(text());
     }
 
-    const qsizetype padding = width - value.size();
+    const qsizetype padding = width - text().size();
 
-    return Value(value + QString(padding, fillChar[0]));
+    return Value(text() + QString(padding, fillChar[0]));
 }
 
 Value StrValue::rjust(
@@ -854,27 +878,25 @@ Value StrValue::rjust(
         }
     }
 
-    if (width <= value.size()) {
-        return Value(value);
+    if (width <= text().size()) {
+        return Value(text());
     }
 
-    const qsizetype padding = width - value.size();
+    const qsizetype padding = width - text().size();
 
-    return Value(QString(padding, fillChar[0]) + value);
+    return Value(QString(padding, fillChar[0]) + text());
 }
 
 Value StrValue::lstrip(
     const std::optional<QString>& chars) const {
 
-    if (value.isEmpty()) {
-        return Value(value);
-    }
+    const QStringView result = view();
 
     qsizetype start = 0;
 
     if (!chars.has_value()) {
 
-        while (start < value.size() && value[start].isSpace()) {
+        while (start < result.size() && textscan::isStrSpace(result[start])) {
             ++start;
         }
 
@@ -882,27 +904,25 @@ Value StrValue::lstrip(
 
         const QString& stripChars = *chars;
 
-        while (start < value.size() && stripChars.contains(value[start])) {
+        while (start < result.size() && stripChars.contains(result[start])) {
             ++start;
         }
     }
 
-    return Value(value.mid(start));
+    return substring(shared_from_this(), start, result.size() - start);
 }
 
 Value StrValue::rstrip(const std::optional<QString>& chars) const {
 
-    if (value.isEmpty()) {
-        return Value(value);
-    }
+    const QStringView result = view();
 
-    qsizetype end = value.size() - 1;
+    qsizetype end = result.size() - 1;
 
     if (!chars.has_value()) {
 
         while (
             end >= 0 &&
-            value[end].isSpace()
+            textscan::isStrSpace(result[end])
         ) {
             --end;
         }
@@ -913,20 +933,20 @@ Value StrValue::rstrip(const std::optional<QString>& chars) const {
 
         while (
             end >= 0 &&
-            stripChars.contains(value[end])
+            stripChars.contains(result[end])
         ) {
             --end;
         }
     }
 
-    return Value(value.left(end + 1));
+    return substring(shared_from_this(), 0, end + 1);
 }
 
 Value StrValue::islower() const {
 
     bool hasLetter = false;
 
-    for (const QChar ch : value) {
+    for (const QChar ch : text()) {
 
         if (!ch.isLetter()) {
             continue;
@@ -946,7 +966,7 @@ Value StrValue::isupper() const {
 
     bool hasLetter = false;
 
-    for (const QChar ch : value) {
+    for (const QChar ch : text()) {
 
         if (!ch.isLetter()) {
             continue;
@@ -964,34 +984,14 @@ Value StrValue::isupper() const {
 
 Value StrValue::isdecimal() const {
 
-    if (value.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const QChar ch : value) {
-
-        if (!ch.isDigit()) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(allChars(*this, textkernels::CharClass::Digit,
+        [](const QChar ch) { return ch.isDigit(); }));
 }
 
 Value StrValue::isnumeric() const {
 
-    if (value.isEmpty()) {
-        return Value(false);
-    }
-
-    for (const QChar ch : value) {
-
-        if (!ch.isDigit()) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(allChars(*this, textkernels::CharClass::Digit,
+        [](const QChar ch) { return ch.isDigit(); }));
 }
 
 Value StrValue::istitle() const {
@@ -999,7 +999,7 @@ Value StrValue::istitle() const {
     bool hasLetter = false;
     bool newWord = true;
 
-    for (const QChar ch : value) {
+    for (const QChar ch : text()) {
 
         if (!ch.isLetter()) {
             newWord = true;
@@ -1028,32 +1028,29 @@ Value StrValue::istitle() const {
 }
 
 Value StrValue::isASCII() const {
-
-    for (const QChar ch : value) {
-
-        if (ch.unicode() > 127) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(isAscii());
 }
 
 Value StrValue::isidentifier() const {
 
-    if (value.isEmpty()) {
+    if (text().isEmpty()) {
         return Value(false);
     }
 
-    const QChar first = value[0];
+    if (isAscii()) {
+        return Value(!asciiDigit(view()[0].unicode()) &&
+                     textkernels::allOf(view(), textkernels::CharClass::Identifier));
+    }
+
+    const QChar first = text()[0];
 
     if (!(first == '_' || first.isLetter())) {
         return Value(false);
     }
 
-    for (qsizetype i = 1; i < value.size(); ++i) {
+    for (qsizetype i = 1; i < text().size(); ++i) {
 
-        const QChar ch = value[i];
+        const QChar ch = text()[i];
 
         if (!(ch == '_' || ch.isLetterOrNumber())) {
             return Value(false);
@@ -1065,7 +1062,7 @@ Value StrValue::isidentifier() const {
 
 Value StrValue::isprintable() const {
 
-    for (const QChar ch : value) {
+    for (const QChar ch : text()) {
 
         switch (ch.category()) {
 
@@ -1098,14 +1095,15 @@ Value StrValue::partition(const Value& sepValue) const {
         );
     }
 
-    const qsizetype pos = value.indexOf(sep);
+    const QStringView chars = view();
+    const qsizetype pos = pattern(sep).find(chars.utf16(), chars.size());
 
     if (pos == -1) {
 
         return Value(
-            std::make_shared<TupleValue>(
+            makePooled<TupleValue>(
                 std::vector<Value>{
-                    Value(value),
+                    Value(std::const_pointer_cast<StrValue>(shared_from_this())),
                     Value(""),
                     Value("")
                 }
@@ -1114,11 +1112,11 @@ Value StrValue::partition(const Value& sepValue) const {
     }
 
     return Value(
-        std::make_shared<TupleValue>(
+        makePooled<TupleValue>(
             std::vector{
-                Value(value.left(pos)),
+                substring(shared_from_this(), 0, pos),
                 Value(sep),
-                Value(value.mid(pos + sep.size()))
+                substring(shared_from_this(), pos + sep.size(), chars.size() - pos - sep.size())
             }
         )
     );
@@ -1137,27 +1135,28 @@ Value StrValue::rpartition(const Value& sepValue) const {
         );
     }
 
-    const qsizetype pos = value.lastIndexOf(sep);
+    const QStringView chars = view();
+    const qsizetype pos = pattern(sep).rfind(chars.utf16(), chars.size());
 
     if (pos == -1) {
 
         return Value(
-            std::make_shared<TupleValue>(
+            makePooled<TupleValue>(
                 std::vector{
                     Value(""),
                     Value(""),
-                    Value(value)
+                    Value(std::const_pointer_cast<StrValue>(shared_from_this()))
                 }
             )
         );
     }
 
     return Value(
-        std::make_shared<TupleValue>(
+        makePooled<TupleValue>(
             std::vector{
-                Value(value.left(pos)),
+                substring(shared_from_this(), 0, pos),
                 Value(sep),
-                Value(value.mid(pos + sep.size()))
+                substring(shared_from_this(), pos + sep.size(), chars.size() - pos - sep.size())
             }
         )
     );
@@ -1170,75 +1169,42 @@ Value StrValue::splitlines(
             ? keepEnds->toBool()
             : false;
 
-    std::vector<Value> result;
-
-    qsizetype start = 0;
-
-    while (start < value.size()) {
-
-        qsizetype end = start;
-
-        while (
-            end < value.size()
-            && value[end] != '\n'
-            && value[end] != '\r')
-        {
-            ++end;
-        }
-
-        if (end == value.size()) {
-            result.emplace_back(value.mid(start));
-            break;
-        }
-
-        const qsizetype lineEnd = end;
-
-        if (value[end] == '\r'
-            && end + 1 < value.size()
-            && value[end + 1] == '\n')
-        {
-            end += 2;
-        }
-        else {
-            ++end;
-        }
-
-        if (keep) {
+    const auto self = shared_from_this();
+    const QStringView chars = view();
+    const qsizetype size = chars.size();
 
-            result.emplace_back(value.mid(start, end - start));
-        }
-        else {
-
-            result.emplace_back(value.mid(start, lineEnd - start));
-        }
+    std::vector<Value> result;
 
-        start = end;
-    }
+    textscan::splitLines(size, keep,
+        [&](const qsizetype i) { return textscan::strLineBreak(chars, size, i); },
+        [&](const qsizetype start, const qsizetype length) {
+            result.push_back(substring(self, start, length));
+        });
 
-    return Value(std::make_shared<ListValue>(result));
+    return Value(makePooled<ListValue>(std::move(result)));
 }
 
 Value StrValue::zfill(const Value& widthValue) const {
 
     const auto width = static_cast<qsizetype>(widthValue.toBigInt());
 
-    if (width <= value.size()) {
-        return Value(value);
+    if (width <= text().size()) {
+        return Value(text());
     }
 
-    const qsizetype zeros = width - value.size();
+    const qsizetype zeros = width - text().size();
 
-    if (!value.isEmpty()
-        && (value[0] == '+' || value[0] == '-'))
+    if (!text().isEmpty()
+        && (text()[0] == '+' || text()[0] == '-'))
     {
         return Value(
-            QString(value[0]) +
+            QString(text()[0]) +
             QString(zeros, '0') +
-            value.mid(1)
+            text().mid(1)
         );
     }
 
-    return Value(QString(zeros, '0') + value);
+    return Value(QString(zeros, '0') + text());
 }
 
 Value StrValue::expandtabs(
@@ -1253,7 +1219,7 @@ Value StrValue::expandtabs(
 
     qsizetype column = 0;
 
-    for (const QChar ch : value) {
+    for (const QChar ch : text()) {
 
         if (ch == '\t') {
 
@@ -1285,124 +1251,59 @@ Value StrValue::rsplit(
     const std::optional<QString>& sep,
     const std::optional<qsizetype> maxSplit) const {
 
-    // rsplit(None)
+    const auto self = shared_from_this();
+    const QStringView chars = view();
+    const long long limit = maxSplit.value_or(-1);
+
+    // куски собираются справа налево, затем разворачиваются
+    std::vector<Value> parts;
+
+    const auto part = [&](const qsizetype start, const qsizetype length) {
+        parts.push_back(substring(self, start, length));
+    };
+
     if (!sep.has_value()) {
 
-        const qsizetype limit =
-            maxSplit.has_value()
-                ? *maxSplit
-                : -1;
+        textscan::rsplitWhitespace(chars, chars.size(), limit, textscan::isStrSpace, part);
 
-        // без ограничения
-        if (limit < 0) {
+    } else {
 
-            const QStringList parts =
-                value.split(
-                    QRegularExpression("\\s+"),
-                    Qt::SkipEmptyParts
-                );
+        const QString& separator = *sep;
 
-            return Value(
-                std::make_shared<ListValue>(
-                    toValueVector(parts)
-                )
+        if (separator.isEmpty()) {
+            throw std::runtime_error(
+                "ValueError: empty separator"
             );
         }
 
-        QString remaining = value.trimmed();
+        const auto needle = pattern(separator);
 
-        QStringList result;
+        qsizetype end = chars.size();
+        long long splits = 0;
 
-        qsizetype splits = 0;
-
-        while (splits < limit) {
+        while (limit < 0 || splits < limit) {
 
-            qsizetype pos = remaining.size() - 1;
-
-            while (pos >= 0 && remaining[pos].isSpace()) {
-                --pos;
-            }
+            const qsizetype pos = needle.rfind(chars.utf16(), end);
 
-            if (pos < 0) {
+            if (pos == -1) {
                 break;
             }
 
-            const qsizetype wordEnd = pos;
+            part(pos + separator.size(), end - pos - separator.size());
 
-            while (pos >= 0 && !remaining[pos].isSpace()) {
-                --pos;
-            }
-
-            result.prepend(remaining.mid(pos + 1, wordEnd - pos));
-
-            remaining = remaining.left(pos + 1);
+            end = pos;
 
             ++splits;
         }
 
-        remaining = remaining.trimmed();
-
-        if (!remaining.isEmpty()) {
-            result.prepend(remaining);
-        }
-
-        return Value(
-            std::make_shared<ListValue>(
-                toValueVector(result)
-            )
-        );
-    }
-
-    const QString& separator = *sep;
-
-    if (separator.isEmpty()) {
-        throw std::runtime_error(
-            "ValueError: empty separator"
-        );
+        part(0, end);
     }
 
-    const qsizetype limit =
-        maxSplit.has_value()
-            ? *maxSplit
-            : -1;
-
-    if (limit < 0) {
-
-        const QStringList parts = value.split(separator);
-
-        return Value(
-            std::make_shared<ListValue>(
-                toValueVector(parts)
-            )
-        );
-    }
-
-    QString remaining = value;
-
-    QStringList reversed;
-
-    qsizetype splits = 0;
-
-    while (splits < limit) {
-
-        const qsizetype pos = remaining.lastIndexOf(separator);
-
-        if (pos == -1) {
-            break;
-        }
-
-        reversed.prepend(remaining.mid(pos + separator.size()));
-
-        remaining = remaining.left(pos);
-
-        ++splits;
-    }
-
-    reversed.prepend(remaining);
+    std::reverse(parts.begin(), parts.end());
 
     return Value(
-        std::make_shared<ListValue>(
-            toValueVector(reversed)
+        makePooled<ListValue>(
+            std::move(parts)
         )
     );
 }
@@ -1410,7 +1311,12 @@ Value StrValue::rsplit(
 //TODO: метод пока костыльный, не поддерживает полностью unicode.
 Value StrValue::casefold() const {
 
-    QString result = value.toCaseFolded();
+    // у ASCII свёртка регистра совпадает с lower()
+    if (isAscii()) {
+        return convertAsciiCase(*this, textkernels::Case::Lower);
+    }
+
+    QString result = text().toCaseFolded();
 
     //TODO: костыль
     // TODO: Full Unicode Case Folding (CaseFolding.txt)
@@ -1510,283 +1416,148 @@ Value StrValue::translate(const Value& table) const {
 
     const auto dict = table.asDict("translate");
 
-    QString result;
-
-    for (const auto ch : value) {
-
-        const Value key(
-            Value::BigInt(ch.unicode())
-        );
+    // замена символа по таблице; nullopt — символ удаляется
+    const auto lookup = [&dict](const char16_t ch) -> std::optional<QString> {
 
-        Value replacement;
+        const Value* found = dict->find(Value(static_cast<Value::SmallInt>(ch)));
 
-        try {
-            replacement = dict->getItem(key);
+        if (!found) {
+            return QString(QChar(ch));
         }
-        catch (...) {
 
-            result += ch;
-            continue;
+        if (found->isNone()) {
+            return std::nullopt;
         }
 
-        if (replacement.isNone()) {
-            continue;
-        }
-
-        if (replacement.isString()) {
-
-            result += replacement.asString("translate")->toString();
-            continue;
+        if (found->isString()) {
+            return found->asString("translate")->toString();
         }
 
-        if (replacement.isBigInt()) {
-
-            const auto code =
-                static_cast<char32_t>(
-                    replacement.asBigInt("translate")
-                );
-
-            result += QChar(static_cast<char16_t>(code));
-
-            continue;
+        if (found->isBigInt()) {
+            const auto code = static_cast<char32_t>(found->asBigInt("translate"));
+            return QString(QChar(static_cast<char16_t>(code)));
         }
 
         throw std::runtime_error(
             "TypeError: character mapping must return integer, None or str"
         );
-    }
+    };
 
-    return Value(result);
-}
-
-Value StrValue::formatMap(const Value& mapping) const {
+    // ASCII-символы ищутся в таблице один раз на символ, а не на каждую позицию
+    std::array<std::optional<std::optional<QString>>, 0x80> ascii;
 
-    const auto dict = mapping.asDict("format_map");
+    const QStringView chars = view();
 
     QString result;
+    result.reserve(chars.size());
 
-    qsizetype pos = 0;
+    for (const QChar ch : chars) {
 
-    while (pos < value.size()) {
+        const char16_t code = ch.unicode();
 
-        if (value[pos] == '{' &&
-            pos + 1 < value.size() &&
-            value[pos + 1] == '{')
-        {
-            result += '{';
-            pos += 2;
-            continue;
-        }
+        if (code >= 0x80) {
 
-        if (value[pos] == '}' &&
-            pos + 1 < value.size() &&
-            value[pos + 1] == '}')
-        {
-            result += '}';
-            pos += 2;
-            continue;
-        }
+            if (const auto replacement = lookup(code)) {
+                result += *replacement;
+            }
 
-        if (value[pos] != '{') {
-            result += value[pos++];
             continue;
         }
 
-        const qsizetype end = value.indexOf('}', pos);
-
-        if (end == -1) {
+        auto& cached = ascii[code];
 
-            throw std::runtime_error("ValueError: unmatched '{'");
+        if (!cached) {
+            cached = lookup(code);
         }
 
-        QString field = value.mid(pos + 1, end - pos - 1);
-
-        QString formatSpec;
-
-        const qsizetype colon = field.indexOf(':');
-
-        if (colon != -1) {
-
-            formatSpec = field.mid(colon + 1);
-
-            field = field.left(colon);
-        }
-
-        QString key = field;
-
-        QChar conversion;
-
-        const qsizetype bang = field.indexOf('!');
-
-        if (bang != -1) {
-
-            key = field.left(bang);
-
-            if (bang + 1 >= field.size()) {
-
-                throw std::runtime_error("ValueError: expected conversion");
-            }
-
-            conversion = field[bang + 1];
-        }
-
-        Value replacement;
-
-        try {
-            if (key.isEmpty()) {
-                replacement = resolveEmptyFormatField(dict);
-            } else {
-                replacement = resolveFormatField(dict, key);
-            }
+        if (*cached) {
+            result += **cached;
         }
-        catch (...) {
+    }
 
-            throw std::runtime_error(
-                "KeyError: '" + key.toStdString() + "'"
-            );
-        }
+    return Value(std::move(result));
+}
 
-        if (conversion == 'r') {
+/// подстановка разобранного шаблона; root возвращает значение поля по имени или номеру
+template<typename Root>
+Value StrValue::renderFormat(const FormatTemplate& compiled, Root&& root) {
 
-            result += replacement.repr();
-        }
-        else if (conversion == 's') {
+    QString result;
+    result.reserve(compiled.literalLength + compiled.fieldCount * 8);
 
-            result += applyFormatSpec(replacement, formatSpec);
-        }
-        else if (!conversion.isNull()) {
+    for (const auto& segment : compiled.segments) {
 
-            throw std::runtime_error(
-                "ValueError: unknown conversion"
-            );
-        }
-        else {
+        result += segment.literal;
 
-            result += applyFormatSpec(replacement, formatSpec);
+        if (segment.field) {
+            result += formatField(segment, root(segment));
         }
-
-        pos = end + 1;
     }
 
-    return Value(result);
+    return Value(std::move(result));
 }
 
-Value StrValue::resolveFormatField(
-    const std::shared_ptr<DictValue>& dict,
-    const QString& field) {
-
-    qsizetype pos = 0;
+QString StrValue::formatField(const FormatTemplate::Segment& segment, Value value) {
 
-    QString root;
+    for (const auto& accessor : segment.accessors) {
 
-    while (pos < field.size()
-           && field[pos] != '.'
-           && field[pos] != '[')
-    {
-        root += field[pos++];
-    }
-
-    Value current = dict->getItem(Value(root));
-
-    while (pos < field.size()) {
-
-        // .attr
-        if (field[pos] == '.') {
-
-            ++pos;
-
-            QString attr;
-
-            while (pos < field.size()
-                   && field[pos] != '.'
-                   && field[pos] != '[')
-            {
-                attr += field[pos++];
-            }
-
-            current = getAttrValue(current, attr);
-
-            continue;
+        if (accessor.attribute) {
+            value = getAttrValue(value, accessor.name);
+        } else if (accessor.index >= 0) {
+            value = getItemValue(value, Value(static_cast<Value::SmallInt>(accessor.index)));
+        } else {
+            value = getItemValue(value, Value(accessor.name));
         }
+    }
 
-        // [ ... ]
-        if (field[pos] == '[') {
-
-            ++pos;
-
-            QString token;
+    switch (segment.fast) {
 
-            while (pos < field.size()
-                   && field[pos] != ']')
-            {
-                token += field[pos++];
-            }
+        case FormatTemplate::FastSpec::Empty:
+            return value.toString();
 
-            if (pos >= field.size()) {
-                throw std::runtime_error(
-                    "ValueError: unmatched '[' in format field"
-                );
+        case FormatTemplate::FastSpec::Decimal:
+            if (value.isBigInt()) {
+                return value.toString();
             }
+            break;
 
-            ++pos; // пропускаем ]
-
-            // ['name'] или ["name"]
-            if ((token.startsWith('\'') && token.endsWith('\'')) ||
-                (token.startsWith('"') && token.endsWith('"')))
-            {
-                token = token.mid(1, token.size() - 2);
-
-                if (current.isDict()) {
-
-                    current =
-                        current.asDict("format_map")
-                               ->getItem(Value(token));
-                }
-                else {
-
-                    current = getItemValue(current, Value(token));
-                }
-
-                continue;
+        case FormatTemplate::FastSpec::Fixed:
+            if (const auto number = std::get_if<Value::Float>(&value.data)) {
+                return QString::number(*number, 'f', segment.precision);
             }
+            break;
 
-            // [123]
-            bool ok = false;
-
-            const qlonglong index = token.toLongLong(&ok);
-
-            if (ok) {
+        case FormatTemplate::FastSpec::None:
+            break;
+    }
 
-                current =
-                    getItemValue(
-                        current,
-                        Value(Value::BigInt(index))
-                    );
+    if (segment.conversion == 'r') {
+        value = Value(value.repr());
+    } else if (segment.conversion == 'a') {
+        value = Value(asciiRepr(value));
+    } else if (segment.conversion == 's') {
+        value = Value(value.toString());
+    }
 
-                continue;
-            }
+    return applyFormatSpec(value, segment.spec);
+}
 
-            // [name]
-            if (current.isDict()) {
+Value StrValue::formatMap(const Value& mapping) const {
 
-                current =
-                    current.asDict("format_map")
-                           ->getItem(Value(token));
+    const auto dict = mapping.asDict("format_map");
 
-                continue;
-            }
+    return renderFormat(*FormatTemplate::compile(text()), [&dict](const FormatTemplate::Segment& segment) {
 
-            throw std::runtime_error(
-                "ValueError: invalid index in format field"
-            );
+        if (segment.name.isEmpty()) {
+            throw std::runtime_error("ValueError: Format string contains positional fields");
         }
 
-        throw std::runtime_error(
-            "ValueError: invalid format field"
-        );
-    }
+        if (const Value* value = dict->find(Value(segment.name))) {
+            return *value;
+        }
 
-    return current;
+        throw PyException(PyException::make("KeyError", {Value(segment.name)}));
+    });
 }
 
 Value StrValue::getItemValue(const Value& obj, const Value& key) {
@@ -1815,45 +1586,27 @@ Value StrValue::getItemValue(const Value& obj, const Value& key) {
 Value StrValue::format(
     const std::vector<Value>& args,
     const Kwargs& kwargs) const {
-    const auto mapping = std::make_shared<DictValue>();
-
-    // позиционные аргументы
-    for (size_t i = 0; i < args.size(); ++i) {
-
-        mapping->setItem(Value(QString::number(i)), args[i]);
-    }
 
-    // именованные аргументы
-    for (const auto& [name, val] : kwargs) {
-
-        mapping->setItem(Value(name), val);
-    }
-
-    return formatMap(Value(mapping));
-}
+    return renderFormat(*FormatTemplate::compile(text()), [&](const FormatTemplate::Segment& segment) {
 
-Value StrValue::resolveEmptyFormatField(const std::shared_ptr<DictValue>& dict) {
+        if (segment.name.isEmpty()) {
 
-    if (dict->hasKey(Value("_positional_0"))) {
-        return dict->getItem(Value("_positional_0"));
-    }
-
-    qlonglong idx = 0;
-
-    while (true) {
-
-        Value key = Value(QString::number(idx));
+            if (static_cast<std::size_t>(segment.index) >= args.size()) {
+                throw std::runtime_error("IndexError: Replacement index " + std::to_string(segment.index) +
+                                         " out of range for positional args tuple");
+            }
 
-        if (dict->hasKey(key)) {
-            return dict->getItem(key);
+            return args[segment.index];
         }
 
-        idx++;
-
-        if (idx > 100) break;
-    }
+        for (const auto& [name, value] : kwargs) {
+            if (name == segment.name) {
+                return value;
+            }
+        }
 
-    throw std::runtime_error("KeyError: ''");
+        throw PyException(PyException::make("KeyError", {Value(segment.name)}));
+    });
 }
 
 QString StrValue::applyFormatSpec(const Value& value, const QString& spec) {
@@ -1919,7 +1672,7 @@ QString StrValue::applyFormatSpec(const Value& value, const QString& spec) {
         if (value.isBigInt()) {
             d = value.toBigInt().convert_to<double>();
         } else {
-            d = value.toBigFloat().convert_to<double>();
+            d = value.toDouble();
         }
 
         return QString::number(d * 100.0, 'f', 6) + "%";
@@ -2075,7 +1828,7 @@ QString StrValue::applyFormatSpec(const Value& value, const QString& spec) {
         if (value.isBigInt()) {
             d = value.toBigInt().convert_to<double>();
         } else {
-            d = value.toBigFloat().convert_to<double>();
+            d = value.toDouble();
         }
 
         QString result = QString::number(d, 'f', precision);
@@ -2102,7 +1855,7 @@ QString StrValue::applyFormatSpec(const Value& value, const QString& spec) {
         if (value.isBigInt()) {
             d = value.toBigInt().convert_to<double>();
         } else {
-            d = value.toBigFloat().convert_to<double>();
+            d = value.toDouble();
         }
 
         return QString::number(d, 'f', precision);
@@ -2288,7 +2041,7 @@ QString StrValue::applyPercentSpec(
             d = value.toBigInt().convert_to<double>();
         }
         else if (value.isBigFloat()) {
-            d = value.toBigFloat().convert_to<double>();
+            d = value.toDouble();
         }
         else {
             throw std::runtime_error(
@@ -2317,7 +2070,7 @@ QString StrValue::applyPercentSpec(
 
         } else if (value.isBigFloat()) {
 
-            d = value.toBigFloat().convert_to<double>();
+            d = value.toDouble();
 
         } else {
 
@@ -2345,7 +2098,7 @@ QString StrValue::applyPercentSpec(
 
         } else if (value.isBigFloat()) {
 
-            d = value.toBigFloat().convert_to<double>();
+            d = value.toDouble();
 
         } else {
 
@@ -2373,7 +2126,7 @@ QString StrValue::applyPercentSpec(
 
         } else if (value.isBigFloat()) {
 
-            d = value.toBigFloat().convert_to<double>();
+            d = value.toDouble();
 
         } else {
 
@@ -2397,7 +2150,7 @@ QString StrValue::applyPercentSpec(
 
         } else if (value.isBigFloat()) {
 
-            d = value.toBigFloat().convert_to<double>();
+            d = value.toDouble();
 
         } else {
 
@@ -2532,245 +2285,112 @@ QString StrValue::formatPercentValue(
     return replacement;
 }
 
-Value StrValue::modTuple(const std::shared_ptr<TupleValue>& tuple) const {
+/**
+ * Аргументы `%`: элементы кортежа или единственное значение. Словарь справа служит
+ * ещё и отображением для `%(key)s`; с ним лишние аргументы не считаются ошибкой.
+ */
+Value StrValue::mod(const Value& rhs) const {
 
-    QString result;
+    const auto compiled = PercentTemplate::compile(text());
 
-    qsizetype tupleIndex = 0;
+    const auto mapping = std::get_if<Value::DictPtr>(&rhs.data);
+    const auto tuple = std::get_if<Value::TuplePtr>(&rhs.data);
 
-    for (qsizetype pos = 0; pos < value.size();) {
+    std::vector<Value> single;
 
-        if (value[pos] != '%') {
+    if (!tuple) {
+        single.push_back(rhs);
+    }
 
-            result += value[pos++];
-            continue;
+    const std::vector<Value>& items = tuple ? (*tuple)->items : single;
+    std::size_t next = 0;
+
+    const auto take = [&]() -> const Value& {
+
+        if (next >= items.size()) {
+            throw std::runtime_error("TypeError: not enough arguments for format string");
         }
 
-        if (pos + 1 < value.size() && value[pos + 1] == '%') {
+        return items[next++];
+    };
 
-            result += '%';
+    const auto starInt = [&]() {
 
-            pos += 2;
+        const Value& value = take();
 
-            continue;
+        if (!value.isBigInt()) {
+            throw std::runtime_error("TypeError: * wants int");
         }
 
-        bool leftAlign = false;
-        bool zeroPad = false;
-        bool showSign = false;
-        bool spaceSign = false;
-        bool alternateForm = false;
-        int width = 0;
-        int precision = -1;
+        return static_cast<int>(value.toBigInt().convert_to<long long>());
+    };
 
-        qsizetype i = pos + 1;
+    QString result;
+    result.reserve(compiled->literalLength + compiled->argumentCount * 8);
 
-        while (i < value.size()) {
+    for (const auto& conversion : compiled->segments) {
 
-            if (value[i] == '+') {
-                showSign = true;
-            }
-            else if (value[i] == ' ') {
-                spaceSign = true;
-            }
-            else if (value[i] == '#') {
-                alternateForm = true;
-            }
-            else if (value[i] == '-') {
-                leftAlign = true;
-            }
-            else if (value[i] == '0') {
-                zeroPad = true;
-            }
-            else {
-                break;
-            }
+        result += conversion.literal;
 
-            ++i;
+        if (!conversion.field) {
+            continue;
         }
 
-        if (i < value.size() && value[i] == '*') {
-            if (tupleIndex >= tuple->len()) {
+        int width = conversion.width;
+        int precision = conversion.precision;
+        bool leftAlign = conversion.leftAlign;
 
-                throw std::runtime_error(
-                    "not enough arguments for format string"
-                );
-            }
-
-            Value widthValue =
-                tuple->getItem(
-                    Value(
-                        Value::BigInt(tupleIndex++)
-                    )
-                );
+        if (conversion.starWidth) {
 
-            if (!widthValue.isBigInt()) {
-
-                throw std::runtime_error(
-                    "* wants int"
-                );
-            }
-
-            width =
-                static_cast<int>(
-                    widthValue.toBigInt()
-                    .convert_to<long long>()
-                );
+            width = starInt();
 
             if (width < 0) {
-
                 leftAlign = true;
                 width = -width;
             }
-
-            ++i;
         }
-        else {
-
-            while (i < value.size() && value[i].isDigit()) {
 
-                width = width * 10 + value[i].digitValue();
-
-                ++i;
-            }
+        if (conversion.starPrecision) {
+            precision = starInt();
         }
 
-        if (i < value.size() && value[i] == '.') {
-
-            ++i;
-
-            if (i < value.size() && value[i] == '*') {
-
-                if (tupleIndex >= tuple->len()) {
-
-                    throw std::runtime_error(
-                        "not enough arguments for format string"
-                    );
-                }
-
-                Value precisionValue =
-                    tuple->getItem(
-                        Value(
-                            Value::BigInt(tupleIndex++)
-                        )
-                    );
-
-                if (!precisionValue.isBigInt()) {
+        Value value;
 
-                    throw std::runtime_error(
-                        "* wants int"
-                    );
-                }
+        if (conversion.keyed) {
 
-                precision =
-                    static_cast<int>(
-                        precisionValue.toBigInt()
-                        .convert_to<long long>()
-                    );
-
-                ++i;
+            if (!mapping) {
+                throw std::runtime_error("TypeError: format requires a mapping");
             }
-            else {
-
-                precision = 0;
 
-                while (i < value.size() && value[i].isDigit()) {
-
-                    precision = precision * 10 + value[i].digitValue();
-
-                    ++i;
-                }
-            }
-        }
-
-        if (i >= value.size()) {
-
-            throw std::runtime_error(
-                "incomplete format"
-            );
+            value = (*mapping)->getItem(Value(conversion.key));
+        } else {
+            value = take();
         }
 
-        QString spec(value[i]);
-
-        if (tupleIndex >= tuple->len()) {
-
-            throw std::runtime_error(
-                "TypeError: not enough arguments for format string"
-            );
+        // %s и %d без флагов — прямо текст значения
+        if (conversion.plain && (conversion.type == "s" || value.isBigInt())) {
+            result += value.toString();
+            continue;
         }
 
-        Value current = tuple->getItem(
-            Value(
-                Value::BigInt(tupleIndex++)
-            )
-        );
-
-        result +=
-                formatPercentValue(
-                    current,
-                    spec,
-                    leftAlign,
-                    zeroPad,
-                    showSign,
-                    spaceSign,
-                    alternateForm,
-                    width,
-                    precision
-                );
-
-        pos = i + 1;
-
-    }
-
-    if (tupleIndex != tuple->len()) {
-
-        throw std::runtime_error(
-            "TypeError: not all arguments converted during string formatting"
+        result += formatPercentValue(
+            value,
+            conversion.type,
+            leftAlign,
+            conversion.zeroPad,
+            conversion.showSign,
+            conversion.spaceSign,
+            conversion.alternateForm,
+            width,
+            precision
         );
     }
 
-    return Value(result);
-}
-
-Value StrValue::mod(const Value& rhs) const {
-
-    QString text = value;
-
-    qsizetype count = 0;
-
-    for (qsizetype i = 0; i < text.size(); ++i) {
-
-        if (text[i] == '%') {
-
-            if (i + 1 < text.size() &&
-                text[i + 1] == '%') {
-                ++i;
-                continue;
-            }
-
-            ++count;
-        }
-    }
-
-    if (rhs.isDict() && value.contains("%(")) {
-
-        return modMapping(rhs.asDict());
+    if (!mapping && next != items.size()) {
+        throw std::runtime_error("TypeError: not all arguments converted during string formatting");
     }
 
-    if (count == 1 && !rhs.isTuple()) {
-
-        return modSingle(rhs);
-    }
-
-    if (!rhs.isTuple()) {
-
-        throw std::runtime_error(
-            "TypeError: not enough arguments for format string"
-        );
-    }
-
-    return modTuple(rhs.asTuple());
-
+    return Value(std::move(result));
 }
 
 QString StrValue::applyStringFormatSpec(
@@ -2856,12 +2476,12 @@ QString StrValue::applyStringFormatSpec(
 Value StrValue::formatSelf(const QString& spec) const {
 
     if (spec.isEmpty()) {
-        return Value(value);
+        return Value(text());
     }
 
     return Value(
         applyFormatSpec(
-            Value(value),
+            Value(text()),
             spec
         )
     );
@@ -2871,132 +2491,11 @@ Value StrValue::encode(
     const std::optional<QString>& encoding,
     const std::optional<QString>& errors) const {
 
-    const QString enc = encoding.value_or("utf-8").toLower();
-
-    const QString err = errors.value_or("strict").toLower();
-
-    QByteArray result;
-
-    if (enc == "utf-8") {
-        result = value.toUtf8();
-    }
-
-    else if (enc == "latin-1" || enc == "latin1") {
-
-        if (err == "strict") {
-
-            for (QChar ch : value) {
-
-                if (ch.unicode() > 255) {
-
-                    throw std::runtime_error(
-                        "UnicodeEncodeError: latin-1 codec can't encode character"
-                    );
-                }
-            }
-
-            result = value.toLatin1();
-        }
-
-        else if (err == "ignore") {
-
-            for (QChar ch : value) {
-
-                if (ch.unicode() <= 255) {
-
-                    result.append(
-                        static_cast<char>(ch.unicode())
-                    );
-                }
-            }
-        }
-
-        else if (err == "replace") {
-
-            for (QChar ch : value) {
-
-                if (ch.unicode() <= 255) {
-
-                    result.append(
-                        static_cast<char>(ch.unicode())
-                    );
-                }
-                else {
-
-                    result.append('?');
-                }
-            }
-        }
-
-        else {
-
-            throw std::runtime_error(
-                "LookupError: unknown error handler"
-            );
-        }
-    }
-
-    else if (enc == "ascii") {
-
-        if (err == "strict") {
-
-            for (QChar ch : value) {
-
-                if (ch.unicode() > 127) {
-
-                    throw std::runtime_error(
-                        "UnicodeEncodeError: ascii codec can't encode character"
-                    );
-                }
-            }
-
-            result = value.toLatin1();
-        }
-
-        else if (err == "ignore") {
-
-            for (QChar ch : value) {
-
-                if (ch.unicode() <= 127) {
-
-                    result.append(
-                        static_cast<char>(ch.unicode())
-                    );
-                }
-            }
-        }
-
-        else if (err == "replace") {
-
-            for (QChar ch : value) {
-
-                if (ch.unicode() <= 127) {
-
-                    result.append(
-                        static_cast<char>(ch.unicode())
-                    );
-                }
-                else {
-
-                    result.append('?');
-                }
-            }
-        }
-
-        else {
-
-            throw std::runtime_error(
-                "LookupError: unknown error handler"
-            );
-        }
-    }
-
-    else {
-
-        throw std::runtime_error(
-            "LookupError: unknown encoding"
-        );
-    }
+    QByteArray result = textcodec::encode(
+        view(),
+        textcodec::codecOf(encoding.value_or("utf-8")),
+        textcodec::errorsOf(errors.value_or("strict"))
+    );
 
     const auto bytes = std::make_shared<BytesValue>(std::move(result));
 
@@ -3007,261 +2506,28 @@ Value StrValue::removePrefix(const Value& prefix) const {
 
     const QString pref = prefix.toString();
 
-    if (value.startsWith(pref)) {
+    if (text().startsWith(pref)) {
 
-        return Value(value.mid(pref.size()));
+        return Value(text().mid(pref.size()));
     }
 
-    return Value(value);
+    return Value(text());
 }
 
 Value StrValue::removeSuffix(const Value& suffix) const {
 
     const QString suff = suffix.toString();
 
-    if (!suff.isEmpty() && value.endsWith(suff)) {
+    if (!suff.isEmpty() && text().endsWith(suff)) {
 
         return Value(
-            value.left(
-                value.size() - suff.size()
+            text().left(
+                text().size() - suff.size()
             )
         );
     }
 
-    return Value(value);
-}
-
-Value StrValue::modSingle(const Value& rhs) const {
-
-    QString text = value;
-
-    const qsizetype pos = text.indexOf('%');
-
-    if (pos == -1) {
-        throw std::runtime_error(
-            "no format specifier"
-        );
-    }
-
-    bool leftAlign = false;
-    bool zeroPad = false;
-    int width = 0;
-    int precision = -1;
-    bool showSign = false;
-    bool spaceSign = false;
-    bool alternateForm = false;
-
-    qsizetype i = pos + 1;
-
-    while (i < value.size()) {
-
-        if (value[i] == '+') {
-            showSign = true;
-        }
-        else if (value[i] == ' ') {
-            spaceSign = true;
-        }
-        else if (value[i] == '#') {
-            alternateForm = true;
-        }
-        else if (value[i] == '-') {
-            leftAlign = true;
-        }
-        else if (value[i] == '0') {
-            zeroPad = true;
-        }
-        else {
-            break;
-        }
-
-        ++i;
-    }
-
-    while (i < text.size() && text[i].isDigit()) {
-        width = width * 10 + (text[i].digitValue());
-        ++i;
-    }
-
-    if (i < text.size() && text[i] == '.') {
-
-        ++i;
-
-        precision = 0;
-
-        while (i < text.size() && text[i].isDigit()) {
-            precision =
-                precision * 10 +
-                text[i].digitValue();
-
-            ++i;
-        }
-    }
-
-    if (i >= text.size()) {
-        throw std::runtime_error(
-            "incomplete format"
-        );
-    }
-
-    const QString spec(text[i]);
-
-    const QString replacement =
-    formatPercentValue(
-        rhs,
-        spec,
-        leftAlign,
-        zeroPad,
-        showSign,
-        spaceSign,
-        alternateForm,
-        width,
-        precision
-    );
-
-    text.replace(
-        pos,
-        i - pos + 1,
-        replacement
-    );
-
-    return Value(text);
-
-}
-
-Value StrValue::modMapping(const Value::DictPtr &dict) const {
-
-    QString result;
-
-    for (qsizetype pos = 0; pos < value.size();) {
-
-        if (value[pos] != '%') {
-
-            result += value[pos++];
-            continue;
-        }
-
-        if (pos + 1 < value.size() && value[pos + 1] == '%') {
-
-            result += '%';
-
-            pos += 2;
-
-            continue;
-        }
-
-        if (pos + 1 >= value.size() ||
-            value[pos + 1] != '(')
-        {
-            throw std::runtime_error(
-                "invalid mapping format"
-            );
-        }
-
-        const qsizetype keyStart = pos + 2;
-
-        const qsizetype keyEnd = value.indexOf(')', keyStart);
-
-        if (keyEnd == -1) {
-
-            throw std::runtime_error(
-                "incomplete mapping key"
-            );
-        }
-
-        QString key = value.mid(keyStart, keyEnd - keyStart);
-
-        const qsizetype specPos = keyEnd + 1;
-
-        bool leftAlign = false;
-        bool zeroPad = false;
-        bool showSign = false;
-        bool spaceSign = false;
-        bool alternateForm = false;
-        int width = 0;
-        int precision = -1;
-
-        qsizetype i = specPos;
-
-        while (i < value.size()) {
-
-            if (value[i] == '+') {
-                showSign = true;
-            }
-            else if (value[i] == ' ') {
-                spaceSign = true;
-            }
-            else if (value[i] == '#') {
-                alternateForm = true;
-            }
-            else if (value[i] == '-') {
-                leftAlign = true;
-            }
-            else if (value[i] == '0') {
-                zeroPad = true;
-            }
-            else {
-                break;
-            }
-
-            ++i;
-        }
-
-        while (i < value.size() && value[i].isDigit()) {
-
-            width = width * 10 + value[i].digitValue();
-
-            ++i;
-        }
-
-        if (i < value.size() &&
-            value[i] == '.')
-        {
-            ++i;
-
-            precision = 0;
-
-            while (i < value.size() &&
-                   value[i].isDigit())
-            {
-                precision =
-                    precision * 10 +
-                    value[i].digitValue();
-
-                ++i;
-            }
-        }
-
-        if (i >= value.size()) {
-
-            throw std::runtime_error(
-                "missing format specifier"
-            );
-        }
-
-        QString spec(value[i]);
-
-        Value fieldValue = dict->getItem(Value(key));
-
-        const QString replacement =
-                formatPercentValue(
-                    fieldValue,
-                    spec,
-                    leftAlign,
-                    zeroPad,
-                    showSign,
-                    spaceSign,
-                    alternateForm,
-                    width,
-                    precision
-                );
-
-        result += replacement;
-
-        pos = i + 1;
-    }
-
-    return Value(result);
-
+    return Value(text());
 }
 
 bool StrValue::contains(const Value& val) const {
@@ -3272,13 +2538,19 @@ bool StrValue::contains(const Value& val) const {
         );
     }
 
-    return value.contains(
-        val.toString()
-    );
+    const QStringView chars = view();
+
+    return pattern(val.asString("__contains__")->view()).find(chars.utf16(), chars.size()) != -1;
 }
 
 std::size_t StrValue::hash() const {
-    return qHash(value);
+
+    if (!cachedHash) {
+        const QStringView chars = view();
+        cachedHash = hashkernels::hashBytes(chars.data(), static_cast<std::size_t>(chars.size()) * sizeof(QChar));
+    }
+
+    return *cachedHash;
 }
 
 Value StrValue::rmul(const Value& other) const {
@@ -0,0 +1,557 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "StreamValue.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <functional>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "BytesValue.h"
+#include "EventLoop.h"
+#include "FutureValue.h"
+#include "ObjectPool.h"
+#include "PyException.h"
+#include "TupleValue.h"
+
+namespace {
+
+#ifdef _WIN32
+    // коды winsock вместо errno; connect в процессе — тот же WSAEWOULDBLOCK
+    constexpr int interrupted = WSAEINTR;
+    constexpr int wouldBlock = WSAEWOULDBLOCK;
+    constexpr int inProgress = WSAEWOULDBLOCK;
+    constexpr int connectionRefused = WSAECONNREFUSED;
+    constexpr int connectionReset = WSAECONNRESET;
+    constexpr int brokenPipe = WSAECONNABORTED;
+
+    int lastError() {
+        return WSAGetLastError();
+    }
+
+    void closeSocket(const int fd) {
+        closesocket(static_cast<SOCKET>(fd));
+    }
+
+    /// WSAStartup один раз на процесс, перед первым сокетом
+    void startSockets() {
+
+        static const int status = [] {
+            WSADATA data;
+            return WSAStartup(MAKEWORD(2, 2), &data);
+        }();
+
+        if (status != 0) {
+            throw std::runtime_error("OSError: WSAStartup failed: " + std::system_category().message(status));
+        }
+    }
+
+    void makeNonBlocking(const int fd) {
+        u_long on = 1;
+        ioctlsocket(static_cast<SOCKET>(fd), FIONBIO, &on);
+    }
+
+    /// узкая версия явно: со сборкой под UNICODE gai_strerror возвращает WCHAR*
+    const char* resolveError(const int status) {
+        return gai_strerrorA(status);
+    }
+#else
+    constexpr int interrupted = EINTR;
+    constexpr int wouldBlock = EWOULDBLOCK;
+    constexpr int inProgress = EINPROGRESS;
+    constexpr int connectionRefused = ECONNREFUSED;
+    constexpr int connectionReset = ECONNRESET;
+    constexpr int brokenPipe = EPIPE;
+
+    int lastError() {
+        return errno;
+    }
+
+    void closeSocket(const int fd) {
+        ::close(fd);
+    }
+
+    void startSockets() {}
+
+    void makeNonBlocking(const int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    const char* resolveError(const int status) {
+        return gai_strerror(status);
+    }
+#endif
+
+    /// EAGAIN и EWOULDBLOCK в POSIX могут различаться
+    bool isWouldBlock(const int code) {
+        return code == wouldBlock || code == EAGAIN;
+    }
+
+#ifdef MSG_NOSIGNAL
+    // запись в закрытый собеседником сокет — EPIPE, а не SIGPIPE, убивающий процесс
+    constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+    constexpr int sendFlags = 0;
+#endif
+
+    std::string errorText(const int code) {
+
+        const char* type;
+
+        switch (code) {
+            case connectionRefused: type = "ConnectionRefusedError"; break;
+            case connectionReset:   type = "ConnectionResetError"; break;
+            case brokenPipe:        type = "BrokenPipeError"; break;
+            default:                type = "OSError"; break;
+        }
+
+        return std::string(type) + ": [Errno " + std::to_string(code) + "] " + std::system_category().message(code);
+    }
+
+    [[noreturn]] void socketError(const int code) {
+        throw std::runtime_error(errorText(code));
+    }
+
+    Value futureValue(const std::shared_ptr<FutureValue>& future) {
+        return Value(std::static_pointer_cast<ObjectValue>(future));
+    }
+
+    Value bytesValue(QByteArray data) {
+        return Value(std::make_shared<BytesValue>(std::move(data)));
+    }
+
+    QByteArray takeFront(QByteArray& buffer, const qsizetype n) {
+
+        QByteArray head = buffer.left(n);
+        buffer.remove(0, n);
+
+        return head;
+    }
+
+    /// строка с `\n`, остаток в конце потока (пустой — поток кончился) или nullopt — нужно дочитать
+    std::optional<QByteArray> takeLine(StreamConnection& c) {
+
+        if (const qsizetype end = c.input.indexOf('\n'); end >= 0) {
+            return takeFront(c.input, end + 1);
+        }
+
+        if (c.eof) {
+            return std::exchange(c.input, {});
+        }
+
+        return std::nullopt;
+    }
+
+    /// дочитывает, что пришло; короткое чтение значит, что больше пока нет
+    void fill(StreamConnection& c) {
+
+        char chunk[65536];
+
+        while (true) {
+
+            const auto n = ::recv(c.fd, chunk, static_cast<int>(sizeof chunk), 0);
+
+            if (n > 0) {
+
+                c.input.append(chunk, n);
+
+                if (static_cast<std::size_t>(n) < sizeof chunk) {
+                    return;
+                }
+
+                continue;
+            }
+
+            if (n == 0) {
+                c.eof = true;
+                return;
+            }
+
+            const int code = lastError();
+
+            if (code == interrupted) {
+                continue;
+            }
+
+            if (isWouldBlock(code)) {
+                return;
+            }
+
+            socketError(code);
+        }
+    }
+
+    /// отправляет буфер записи, пока сокет принимает данные
+    void flush(StreamConnection& c) {
+
+        while (!c.output.isEmpty()) {
+
+            const auto n = ::send(c.fd, c.output.constData(), static_cast<int>(std::min<qsizetype>(c.output.size(), INT_MAX)), sendFlags);
+
+            if (n >= 0) {
+                c.output.remove(0, n);
+                continue;
+            }
+
+            const int code = lastError();
+
+            if (code == interrupted) {
+                continue;
+            }
+
+            if (isWouldBlock(code)) {
+                return;
+            }
+
+            socketError(code);
+        }
+    }
+
+    void finishDrain(StreamConnection& c, const std::exception_ptr& error) {
+
+        for (const auto& drainer : std::exchange(c.drainers, {})) {
+            if (error) {
+                drainer->setException(error);
+            } else {
+                drainer->setResult(Value());
+            }
+        }
+    }
+
+    /// дописывает буфер по готовности сокета; пустой буфер отпускает drain() и закрывает после close()
+    void awaitWritable(const std::shared_ptr<StreamConnection>& c) {
+
+        EventLoop::running().watch(c->fd, true, [c] {
+
+            if (c->fd < 0) {
+                return;
+            }
+
+            try {
+                flush(*c);
+            } catch (...) {
+                finishDrain(*c, std::current_exception());
+                return;
+            }
+
+            if (!c->output.isEmpty()) {
+                awaitWritable(c);
+                return;
+            }
+
+            finishDrain(*c, nullptr);
+
+            if (c->closing) {
+                c->close();
+            }
+        });
+    }
+
+    /// первый ответ take или nullopt, если данных пока не хватает
+    using Take = std::function<std::optional<Value>(StreamConnection&)>;
+
+    void pump(const std::shared_ptr<StreamConnection>& c, const std::shared_ptr<FutureValue>& future, const Take& take) {
+
+        try {
+            if (std::optional<Value> value = take(*c)) {
+                c->pendingRead.reset();
+                future->setResult(std::move(*value));
+                return;
+            }
+
+            if (c->fd < 0) {
+                throw std::runtime_error("OSError: stream is closed");
+            }
+
+            c->pendingRead = future;
+
+            EventLoop::running().watch(c->fd, false, [c, future, take] {
+
+                // соединение закрыли, пока чтение ждало
+                if (future->done()) {
+                    return;
+                }
+
+                try {
+                    fill(*c);
+                } catch (...) {
+                    c->pendingRead.reset();
+                    future->setException(std::current_exception());
+                    return;
+                }
+
+                pump(c, future, take);
+            });
+
+        } catch (...) {
+            c->pendingRead.reset();
+            future->setException(std::current_exception());
+        }
+    }
+
+    Value startRead(const std::shared_ptr<StreamConnection>& c, const Take& take) {
+
+        if (c->pendingRead) {
+            throw std::runtime_error("RuntimeError: read() called while another coroutine is already waiting for incoming data");
+        }
+
+        const auto future = FutureValue::create();
+        pump(c, future, take);
+
+        return futureValue(future);
+    }
+}
+
+StreamConnection::~StreamConnection() {
+
+    if (fd < 0) {
+        return;
+    }
+
+    if (EventLoop* loop = EventLoop::current()) {
+        loop->forget(fd);
+    }
+
+    closeSocket(fd);
+}
+
+void StreamConnection::close() {
+
+    if (fd < 0) {
+        return;
+    }
+
+    if (EventLoop* loop = EventLoop::current()) {
+        loop->forget(fd);
+    }
+
+    closeSocket(fd);
+    fd = -1;
+
+    const auto closed = std::make_exception_ptr(std::runtime_error("OSError: stream is closed"));
+
+    if (const auto read = std::exchange(pendingRead, nullptr); read && !read->done()) {
+        read->setException(closed);
+    }
+
+    finishDrain(*this, closed);
+}
+
+Value StreamConnection::open(const QString& host, const int port) {
+
+    EventLoop& loop = EventLoop::running();
+
+    startSockets();
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* found = nullptr;
+    const QByteArray service = QByteArray::number(port);
+
+    if (const int status = getaddrinfo(host.toUtf8().constData(), service.constData(), &hints, &found); status != 0) {
+        throw std::runtime_error(std::string("OSError: ") + resolveError(status));
+    }
+
+    const std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> addresses(found, &freeaddrinfo);
+
+    auto connection = std::make_shared<StreamConnection>();
+    // INVALID_SOCKET winsock после приведения — тоже -1
+    connection->fd = static_cast<int>(::socket(found->ai_family, found->ai_socktype, found->ai_protocol));
+
+    if (connection->fd < 0) {
+        socketError(lastError());
+    }
+
+    makeNonBlocking(connection->fd);
+
+#ifdef SO_NOSIGPIPE
+    const int on = 1;
+    setsockopt(connection->fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof on);
+#endif
+
+    const auto future = FutureValue::create();
+
+    const auto connected = [connection, future] {
+
+        Value reader(std::static_pointer_cast<ObjectValue>(std::make_shared<StreamReaderValue>(connection)));
+        Value writer(std::static_pointer_cast<ObjectValue>(std::make_shared<StreamWriterValue>(connection)));
+
+        future->setResult(Value(makePooled<TupleValue>(std::vector<Value>{std::move(reader), std::move(writer)})));
+    };
+
+    if (::connect(connection->fd, found->ai_addr, static_cast<socklen_t>(found->ai_addrlen)) == 0) {
+        connected();
+        return futureValue(future);
+    }
+
+    if (const int code = lastError(); code != inProgress) {
+        socketError(code);
+    }
+
+    // неблокирующий connect закончен, когда сокет готов к записи; итог — в SO_ERROR
+    loop.watch(connection->fd, true, [connection, future, connected] {
+
+        int error = 0;
+        socklen_t length = sizeof error;
+
+        if (getsockopt(connection->fd, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length) < 0) {
+            error = lastError();
+        }
+
+        if (error != 0) {
+            connection->close();
+            future->setException(std::make_exception_ptr(std::runtime_error(errorText(error))));
+            return;
+        }
+
+        connected();
+    });
+
+    return futureValue(future);
+}
+
+StreamReaderValue::StreamReaderValue(std::shared_ptr<StreamConnection> connection)
+    : connection(std::move(connection)) {}
+
+StreamReaderValue* StreamReaderValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<StreamReaderValue*>(object->get()) : nullptr;
+}
+
+Value StreamReaderValue::read(const qsizetype n) const {
+
+    return startRead(connection, [n](StreamConnection& c) -> std::optional<Value> {
+
+        if (n == 0) {
+            return bytesValue({});
+        }
+
+        if (n < 0) {
+            return c.eof ? std::optional(bytesValue(std::exchange(c.input, {}))) : std::nullopt;
+        }
+
+        if (!c.input.isEmpty() || c.eof) {
+            return bytesValue(takeFront(c.input, std::min(n, c.input.size())));
+        }
+
+        return std::nullopt;
+    });
+}
+
+Value StreamReaderValue::readline() const {
+
+    return startRead(connection, [](StreamConnection& c) -> std::optional<Value> {
+
+        std::optional<QByteArray> line = takeLine(c);
+
+        return line ? std::optional(bytesValue(std::move(*line))) : std::nullopt;
+    });
+}
+
+Value StreamReaderValue::nextLine() const {
+
+    return startRead(connection, [](StreamConnection& c) -> std::optional<Value> {
+
+        std::optional<QByteArray> line = takeLine(c);
+
+        if (!line) {
+            return std::nullopt;
+        }
+
+        if (line->isEmpty()) {
+            throw PyException(PyException::make("StopAsyncIteration", {}));
+        }
+
+        return bytesValue(std::move(*line));
+    });
+}
+
+bool StreamReaderValue::atEof() const {
+    return connection->eof && connection->input.isEmpty();
+}
+
+QString StreamReaderValue::toString() const {
+    return atEof() ? "<StreamReader eof>" : "<StreamReader>";
+}
+
+StreamWriterValue::StreamWriterValue(std::shared_ptr<StreamConnection> connection)
+    : connection(std::move(connection)) {}
+
+StreamWriterValue* StreamWriterValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<StreamWriterValue*>(object->get()) : nullptr;
+}
+
+void StreamWriterValue::write(const QByteArrayView data) const {
+
+    if (connection->closing || connection->fd < 0) {
+        throw std::runtime_error("RuntimeError: write() on a closed stream");
+    }
+
+    connection->output.append(data);
+    flush(*connection);
+}
+
+Value StreamWriterValue::drain() const {
+
+    const auto future = FutureValue::create();
+
+    if (connection->output.isEmpty() || connection->fd < 0) {
+        future->setResult(Value());
+        return futureValue(future);
+    }
+
+    connection->drainers.push_back(future);
+    awaitWritable(connection);
+
+    return futureValue(future);
+}
+
+void StreamWriterValue::close() const {
+
+    if (connection->closing) {
+        return;
+    }
+
+    connection->closing = true;
+
+    // остаток буфера дописывает цикл событий; вне цикла дописывать некому
+    if (connection->output.isEmpty() || !EventLoop::current() || connection->fd < 0) {
+        connection->close();
+        return;
+    }
+
+    awaitWritable(connection);
+}
+
+bool StreamWriterValue::isClosing() const {
+    return connection->closing;
+}
+
+QString StreamWriterValue::toString() const {
+    return connection->closing ? "<StreamWriter closing>" : "<StreamWriter>";
+}
@@ -0,0 +1,49 @@
+//
+// Created by semyo on 14.10.2026.
+//
+#include "StringTable.h"
+
+#include "ObjectPool.h"
+#include "StrValue.h"
+
+QHash<QString, Value::StrPtr>& StringTable::table() {
+
+    static QHash<QString, Value::StrPtr> atoms;
+    return atoms;
+}
+
+Value::StrPtr StringTable::internStr(const QString& str) {
+
+    auto& atoms = table();
+
+    if (const auto it = atoms.constFind(str); it != atoms.cend()) {
+        return it.value();
+    }
+
+    auto atom = makePooled<StrValue>(str);
+    atoms.insert(str, atom);
+
+    return atom;
+}
+
+QString StringTable::intern(const QString& str) {
+
+    // ключ таблицы и строка внутри StrValue разделяют один буфер
+    return internStr(str)->toString();
+}
+
+bool StringTable::isInternable(const QString& str) {
+
+    if (str.isEmpty()) {
+        return false;
+    }
+
+    for (const QChar ch : str) {
+
+        if (ch.unicode() > 0x7f || !(ch.isLetterOrNumber() || ch == '_')) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,438 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "StructFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <QHash>
+#include <QSysInfo>
+#include <QtEndian>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassUtils.h"
+#include "MemoryViewValue.h"
+#include "StrValue.h"
+#include "TupleValue.h"
+
+namespace {
+
+    /// CPython держит в кэше struct не больше 100 форматов
+    constexpr qsizetype maxCached = 100;
+
+    [[noreturn]] void structError(const std::string& message) {
+        throw std::runtime_error("struct.error: " + message);
+    }
+
+    /// размер кода; 0 — кода нет в этом режиме
+    qsizetype codeSize(const char code, const bool native) {
+
+        switch (code) {
+            case 'x': case 'c': case 'b': case 'B': case '?': case 's': case 'p':
+                return 1;
+            case 'h': case 'H':
+                return 2;
+            case 'i': case 'I': case 'f':
+                return 4;
+            case 'q': case 'Q': case 'd':
+                return 8;
+            case 'l': case 'L':
+                return native ? static_cast<qsizetype>(sizeof(long)) : 4;
+            case 'n': case 'N':
+                return native ? static_cast<qsizetype>(sizeof(std::size_t)) : 0;
+            case 'P':
+                return native ? static_cast<qsizetype>(sizeof(void*)) : 0;
+            default:
+                return 0;
+        }
+    }
+
+    bool isSigned(const char code) {
+        return code == 'b' || code == 'h' || code == 'i' || code == 'l' || code == 'q' || code == 'n';
+    }
+
+    template<typename T>
+    T load(const char* data, const bool swap) {
+        T value;
+        std::memcpy(&value, data, sizeof value);
+        return swap ? qbswap(value) : value;
+    }
+
+    template<typename T>
+    void store(char* out, const T value, const bool swap) {
+        const T ordered = swap ? qbswap(value) : value;
+        std::memcpy(out, &ordered, sizeof ordered);
+    }
+
+    std::uint64_t loadBits(const char* data, const qsizetype size, const bool swap) {
+
+        switch (size) {
+            case 1: return load<std::uint8_t>(data, swap);
+            case 2: return load<std::uint16_t>(data, swap);
+            case 4: return load<std::uint32_t>(data, swap);
+            default: return load<std::uint64_t>(data, swap);
+        }
+    }
+
+    void storeBits(char* out, const std::uint64_t bits, const qsizetype size, const bool swap) {
+
+        switch (size) {
+            case 1: store(out, static_cast<std::uint8_t>(bits), swap); break;
+            case 2: store(out, static_cast<std::uint16_t>(bits), swap); break;
+            case 4: store(out, static_cast<std::uint32_t>(bits), swap); break;
+            default: store(out, bits, swap); break;
+        }
+    }
+
+    /// текст ошибки диапазона: у коротких целых CPython называет границы
+    [[noreturn]] void rangeError(const char code, const qsizetype size, const Value::BigInt& value) {
+
+        switch (code) {
+            case 'b': structError("byte format requires -128 <= number <= 127");
+            case 'B': structError("ubyte format requires 0 <= number <= 255");
+            case 'h': structError("short format requires -32768 <= number <= 32767");
+            case 'H': structError("ushort format requires 0 <= number <= 65535");
+            default: break;
+        }
+
+        const bool fitsLong = value >= std::numeric_limits<std::int64_t>::min() &&
+                              value <= std::numeric_limits<std::int64_t>::max();
+
+        if (isSigned(code) && size == 4 && fitsLong) {
+            structError("'" + std::string(1, code) + "' format requires -2147483648 <= number <= 2147483647");
+        }
+
+        structError("argument out of range");
+    }
+
+    const QByteArray& bytesArgument(const Value& value, const char code) {
+
+        if (value.isBytes()) {
+            return value.asBytes()->bytes();
+        }
+
+        if (value.isByteArray()) {
+            return value.asByteArray()->bytes();
+        }
+
+        structError("argument for '" + std::string(1, code) + "' must be a bytes object");
+    }
+}
+
+StructFormat::StructFormat(const QString& format) : source(format) {
+
+    qsizetype pos = 0;
+
+    if (!format.isEmpty()) {
+
+        switch (format[0].toLatin1()) {
+            case '@': pos = 1; break;
+            case '=': pos = 1; native = false; break;
+            case '<': pos = 1; native = false; swap = QSysInfo::ByteOrder != QSysInfo::LittleEndian; break;
+            case '>': case '!': pos = 1; native = false; swap = QSysInfo::ByteOrder != QSysInfo::BigEndian; break;
+            default: break;
+        }
+    }
+
+    while (pos < format.size()) {
+
+        if (format[pos].isSpace()) {
+            ++pos;
+            continue;
+        }
+
+        qsizetype count = 1;
+
+        if (format[pos].isDigit()) {
+
+            count = 0;
+
+            while (pos < format.size() && format[pos].isDigit()) {
+
+                count = count * 10 + format[pos++].digitValue();
+
+                if (count > std::numeric_limits<int>::max()) {
+                    structError("total struct size too long");
+                }
+            }
+
+            if (pos == format.size()) {
+                structError("repeat count given without format specifier");
+            }
+        }
+
+        const char code = format[pos].unicode() < 0x80 ? format[pos].toLatin1() : '\0';
+        const qsizetype size = codeSize(code, native);
+        ++pos;
+
+        if (size == 0) {
+            structError("bad char in struct format");
+        }
+
+        // в родном режиме поле выравнивается по своему размеру, как в структуре C
+        if (native && code != 's' && code != 'p') {
+            length = (length + size - 1) / size * size;
+        }
+
+        if (length + count * size > std::numeric_limits<int>::max()) {
+            structError("total struct size too long");
+        }
+
+        if (code == 's' || code == 'p') {
+            fields.push_back({code, length, count});
+            length += count;
+            continue;
+        }
+
+        if (code != 'x') {
+            for (qsizetype i = 0; i < count; ++i) {
+                fields.push_back({code, length + i * size, size});
+            }
+        }
+
+        length += count * size;
+    }
+}
+
+std::shared_ptr<const StructFormat> StructFormat::compile(const QString& format) {
+
+    static QHash<QString, std::shared_ptr<const StructFormat>> cache;
+
+    if (const auto it = cache.constFind(format); it != cache.constEnd()) {
+        return it.value();
+    }
+
+    std::shared_ptr<const StructFormat> compiled(new StructFormat(format));
+
+    if (cache.size() >= maxCached) {
+        cache.clear();
+    }
+
+    cache.insert(format, compiled);
+
+    return compiled;
+}
+
+std::shared_ptr<const StructFormat> StructFormat::compile(const Value& format) {
+
+    if (format.isString()) {
+        return compile(format.asString()->view().toString());
+    }
+
+    if (format.isBytes()) {
+        return compile(QString::fromLatin1(format.asBytes()->bytes()));
+    }
+
+    throw std::runtime_error(
+        "TypeError: Struct() argument 1 must be a str or bytes object, not " + typeName(format).toStdString());
+}
+
+QByteArrayView StructFormat::bufferOf(const Value& value) {
+
+    if (value.isBytes()) {
+        return value.asBytes()->bytes();
+    }
+
+    if (value.isByteArray()) {
+        return value.asByteArray()->bytes();
+    }
+
+    if (const MemoryViewValue* view = MemoryViewValue::of(value)) {
+
+        if (!view->contiguous()) {
+            throw std::runtime_error("BufferError: memoryview: underlying buffer is not C-contiguous");
+        }
+
+        return view->view();
+    }
+
+    throw std::runtime_error(
+        "TypeError: a bytes-like object is required, not '" + typeName(value).toStdString() + "'");
+}
+
+QByteArray StructFormat::pack(const std::vector<Value>& args, const std::size_t first) const {
+
+    const std::size_t given = args.size() - first;
+
+    if (given != fields.size()) {
+        structError("pack expected " + std::to_string(fields.size()) +
+                    " items for packing (got " + std::to_string(given) + ")");
+    }
+
+    QByteArray result(length, '\0');
+
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        packField(result.data() + fields[i].offset, fields[i], args[first + i]);
+    }
+
+    return result;
+}
+
+void StructFormat::packField(char* out, const Field& field, const Value& value) const {
+
+    switch (field.code) {
+
+        case 'c': {
+
+            if (!value.isBytes() || value.asBytes()->bytes().size() != 1) {
+                structError("char format requires a bytes object of length 1");
+            }
+
+            *out = value.asBytes()->bytes()[0];
+            return;
+        }
+
+        case 's': {
+            const QByteArray& bytes = bytesArgument(value, 's');
+            std::memcpy(out, bytes.constData(), std::min(bytes.size(), field.size));
+            return;
+        }
+
+        case 'p': {
+
+            const QByteArray& bytes = bytesArgument(value, 'p');
+
+            if (field.size == 0) {
+                return;
+            }
+
+            // первый байт — длина, не больше 255 и не больше места в поле
+            const qsizetype stored = std::min<qsizetype>({bytes.size(), field.size - 1, 255});
+
+            *out = static_cast<char>(stored);
+            std::memcpy(out + 1, bytes.constData(), stored);
+            return;
+        }
+
+        case '?':
+            *out = value.toBool() ? 1 : 0;
+            return;
+
+        case 'f':
+        case 'd': {
+
+            if (!value.isNumeric()) {
+                structError("required argument is not a float");
+            }
+
+            const double number = value.toDouble();
+
+            if (field.code == 'd') {
+                store(out, number, swap);
+                return;
+            }
+
+            const auto single = static_cast<float>(number);
+
+            if (!native && std::isinf(single) && !std::isinf(number)) {
+                throw std::runtime_error("OverflowError: float too large to pack with f format");
+            }
+
+            store(out, single, swap);
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    if (!value.isBigInt() && !value.isBool()) {
+        structError("required argument is not an integer");
+    }
+
+    const int bits = static_cast<int>(field.size) * 8;
+
+    // у малых целых граница проверяется без BigInt
+    if (const auto* small = std::get_if<Value::SmallInt>(&value.data)) {
+
+        const Value::SmallInt number = *small;
+        const bool fits = isSigned(field.code)
+            ? bits == 64 || (number >= -(Value::SmallInt(1) << (bits - 1)) && number < (Value::SmallInt(1) << (bits - 1)))
+            : number >= 0 && (bits == 64 || number < (Value::SmallInt(1) << bits));
+
+        if (!fits) {
+            rangeError(field.code, field.size, Value::BigInt(number));
+        }
+
+        storeBits(out, static_cast<std::uint64_t>(number), field.size, swap);
+        return;
+    }
+
+    const Value::BigInt number = value.toBigInt();
+    const Value::BigInt limit = Value::BigInt(1) << (isSigned(field.code) ? bits - 1 : bits);
+
+    if (isSigned(field.code) ? number < -limit || number >= limit : number < 0 || number >= limit) {
+        rangeError(field.code, field.size, number);
+    }
+
+    storeBits(out, isSigned(field.code) ? static_cast<std::uint64_t>(number.convert_to<std::int64_t>())
+                                        : number.convert_to<std::uint64_t>(), field.size, swap);
+}
+
+Value StructFormat::unpack(const char* data) const {
+
+    std::vector<Value> items = TupleValue::acquireItems(fields.size());
+
+    for (const Field& field : fields) {
+        items.push_back(unpackField(data + field.offset, field));
+    }
+
+    return TupleValue::make(std::move(items));
+}
+
+Value StructFormat::unpackField(const char* data, const Field& field) const {
+
+    switch (field.code) {
+
+        case 'c':
+            return Value(std::make_shared<BytesValue>(QByteArray(data, 1)));
+
+        case 's':
+            return Value(std::make_shared<BytesValue>(QByteArray(data, field.size)));
+
+        case 'p': {
+
+            if (field.size == 0) {
+                return Value(std::make_shared<BytesValue>(QByteArray()));
+            }
+
+            const qsizetype stored = std::min<qsizetype>(static_cast<unsigned char>(*data), field.size - 1);
+
+            return Value(std::make_shared<BytesValue>(QByteArray(data + 1, stored)));
+        }
+
+        case '?':
+            return Value(*data != 0);
+
+        case 'f':
+            return Value(Value::Float(load<float>(data, swap)));
+
+        case 'd':
+            return Value(load<double>(data, swap));
+
+        default:
+            break;
+    }
+
+    const std::uint64_t bits = loadBits(data, field.size, swap);
+
+    if (isSigned(field.code)) {
+
+        // знаковое расширение из field.size байтов
+        const int shift = 64 - static_cast<int>(field.size) * 8;
+
+        return Value(Value::SmallInt(static_cast<std::int64_t>(bits << shift) >> shift));
+    }
+
+    // беззнаковые 64 бита могут не уместиться в SmallInt
+    if (bits > static_cast<std::uint64_t>(std::numeric_limits<Value::SmallInt>::max())) {
+        return Value(Value::BigInt(bits));
+    }
+
+    return Value(Value::SmallInt(bits));
+}
@@ -0,0 +1,43 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "StructIterator.h"
+
+#include "ByteArrayValue.h"
+#include "StopIterationException.h"
+#include "StructFormat.h"
+
+StructIterator::StructIterator(std::shared_ptr<const StructFormat> format, const Value& source)
+    : format(std::move(format)), source(source) {
+
+    if (this->source.isByteArray()) {
+        this->source.asByteArray()->exportBuffer();
+    }
+}
+
+StructIterator::~StructIterator() {
+
+    if (source.isByteArray()) {
+        source.asByteArray()->releaseBuffer();
+    }
+}
+
+Value StructIterator::next() {
+
+    if (!hasNext()) {
+        throw StopIterationException();
+    }
+
+    const Value record = format->unpack(StructFormat::bufferOf(source).data() + offset);
+    offset += format->size();
+
+    return record;
+}
+
+bool StructIterator::hasNext() const {
+    return offset + format->size() <= StructFormat::bufferOf(source).size();
+}
+
+QString StructIterator::getTypeName() const {
+    return "_struct.unpack_iterator";
+}
@@ -0,0 +1,136 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "StructModule.h"
+
+#include <algorithm>
+
+#include "BytesValue.h"
+#include "ClassValue.h"
+#include "InterpreterContext.h"
+#include "StructFormat.h"
+#include "StructIterator.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    [[noreturn]] void structError(const std::string& message) {
+        throw std::runtime_error("struct.error: " + message);
+    }
+}
+
+Value StructModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("struct");
+
+    module->setAttribute("calcsize", makeBuiltin(
+        "calcsize",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 1, "calcsize");
+            return Value(Value::SmallInt(StructFormat::compile(args[0])->size()));
+        }
+    ));
+
+    module->setAttribute("pack", makeBuiltin(
+        "pack",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            if (args.empty()) {
+                throw std::runtime_error("TypeError: pack expected at least 1 argument, got 0");
+            }
+
+            return Value(std::make_shared<BytesValue>(StructFormat::compile(args[0])->pack(args, 1)));
+        }
+    ));
+
+    module->setAttribute("unpack", makeBuiltin(
+        "unpack",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 2, "unpack");
+
+            const auto format = StructFormat::compile(args[0]);
+
+            const QByteArrayView buffer = StructFormat::bufferOf(args[1]);
+
+            if (buffer.size() != format->size()) {
+                structError("unpack requires a buffer of " + std::to_string(format->size()) + " bytes");
+            }
+
+            return format->unpack(buffer.data());
+        }
+    ));
+
+    module->setAttribute("unpack_from", makeBuiltin(
+        "unpack_from",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgsRange(args, 1, 3, "unpack_from");
+
+            const auto format = StructFormat::compile(args[0]);
+            const Value* source = option(args, kwargs, 1, "buffer");
+
+            if (!source) {
+                throw std::runtime_error("TypeError: unpack_from() missing required argument 'buffer' (pos 2)");
+            }
+
+            const Value* offsetValue = option(args, kwargs, 2, "offset");
+            qsizetype offset = offsetValue ? offsetValue->asBigInt("unpack_from").convert_to<qsizetype>() : 0;
+
+            const QByteArrayView buffer = StructFormat::bufferOf(*source);
+            const qsizetype size = format->size();
+
+            // отрицательное смещение считается от конца буфера
+            if (offset < 0) {
+
+                if (offset + buffer.size() < 0) {
+                    structError("offset " + std::to_string(offset) + " out of range for " +
+                                std::to_string(buffer.size()) + "-byte buffer");
+                }
+
+                if (offset + size > 0) {
+                    structError("not enough data to unpack " + std::to_string(size) +
+                                " bytes at offset " + std::to_string(offset));
+                }
+
+                offset += buffer.size();
+            }
+
+            if (buffer.size() - offset < size) {
+                structError("unpack_from requires a buffer of at least " + std::to_string(offset + size) +
+                            " bytes for unpacking " + std::to_string(size) + " bytes at offset " +
+                            std::to_string(offset) + " (actual buffer size is " +
+                            std::to_string(buffer.size()) + ")");
+            }
+
+            return format->unpack(buffer.data() + offset);
+        }
+    ));
+
+    module->setAttribute("iter_unpack", makeBuiltin(
+        "iter_unpack",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 2, "iter_unpack");
+
+            auto format = StructFormat::compile(args[0]);
+
+            if (format->size() == 0) {
+                structError("cannot iteratively unpack with a struct of length 0");
+            }
+
+            if (StructFormat::bufferOf(args[1]).size() % format->size() != 0) {
+                structError("iterative unpacking requires a buffer of a multiple of " +
+                            std::to_string(format->size()) + " bytes");
+            }
+
+            return Value(std::static_pointer_cast<IteratorValue>(
+                std::make_shared<StructIterator>(std::move(format), args[1])));
+        }
+    ));
+
+    module->setAttribute("error", Value(InterpreterContext::current().exceptionClasses.value("error")));
+
+    return Value(module);
+}
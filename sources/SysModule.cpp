@@ -0,0 +1,187 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "SysModule.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassValue.h"
+#include "DictValue.h"
+#include "ListValue.h"
+#include "ModuleLoader.h"
+#include "OutputStream.h"
+#include "RecursionLimit.h"
+#include "RuntimeStats.h"
+#include "StrValue.h"
+#include "Tracer.h"
+#include "TupleValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+std::size_t SysModule::sizeOf(const Value& value) {
+
+    if (value.isList()) {
+        return sizeof(ListValue) + value.asList()->elements.capacity() * sizeof(Value);
+    }
+
+    if (value.isTuple()) {
+        return sizeof(TupleValue) + value.asTuple()->items.capacity() * sizeof(Value);
+    }
+
+    if (value.isString()) {
+        return sizeof(StrValue) + static_cast<std::size_t>(value.asString()->view().size()) * sizeof(QChar);
+    }
+
+    if (value.isBytes()) {
+        return sizeof(BytesValue) + static_cast<std::size_t>(value.asBytes()->bytes().capacity());
+    }
+
+    if (value.isByteArray()) {
+        return sizeof(ByteArrayValue) + static_cast<std::size_t>(value.asByteArray()->bytes().capacity());
+    }
+
+    return sizeof(Value);
+}
+
+namespace {
+
+    struct StreamObject {
+        const ClassValue* object;
+        OutputStream* stream;
+    };
+
+    std::vector<StreamObject>& streamObjects() {
+        static std::vector<StreamObject> objects;
+        return objects;
+    }
+
+    Value makeStream(const QString& name, OutputStream& stream) {
+
+        const auto object = std::make_shared<ClassValue>(name);
+
+        object->setAttribute("write", makeBuiltin(
+            "write",
+            [&stream](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+                expectArgs(args, 1, "write");
+
+                if (!args[0].isString()) {
+                    throw std::runtime_error("TypeError: write() argument must be str");
+                }
+
+                const QStringView text = args[0].asString()->view();
+                stream.write(text);
+
+                return Value(static_cast<Value::SmallInt>(text.size()));
+            }
+        ));
+
+        object->setAttribute("flush", makeBuiltin(
+            "flush",
+            [&stream](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+                expectArgs(args, 0, "flush");
+                stream.flush();
+                return Value();
+            }
+        ));
+
+        streamObjects().push_back(StreamObject{object.get(), &stream});
+
+        return Value(object);
+    }
+}
+
+OutputStream* SysModule::nativeStream(const Value& file) {
+
+    if (const auto object = std::get_if<Value::ClassPtr>(&file.data)) {
+        for (const auto& [known, stream] : streamObjects()) {
+            if (known == object->get()) {
+                return stream;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+Value SysModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("sys");
+
+    module->setAttribute("getsizeof", makeBuiltin(
+        "getsizeof",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 1, "getsizeof");
+            return Value(static_cast<Value::SmallInt>(sizeOf(args[0])));
+        }
+    ));
+
+    module->setAttribute("runtime_stats", makeBuiltin(
+        "runtime_stats",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 0, "runtime_stats");
+
+            const auto stats = std::make_shared<DictValue>();
+
+            for (const auto& [name, count] : RuntimeStats::snapshot()) {
+                stats->setItem(Value(QString::fromStdString(name)), Value(static_cast<Value::SmallInt>(count)));
+            }
+
+            return Value(stats);
+        }
+    ));
+
+    module->setAttribute("settrace", makeBuiltin(
+        "settrace",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 1, "settrace");
+            Tracer::setTrace(args[0]);
+            return Value();
+        }
+    ));
+
+    module->setAttribute("gettrace", makeBuiltin(
+        "gettrace",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "gettrace");
+            return Tracer::getTrace();
+        }
+    ));
+
+    module->setAttribute("setrecursionlimit", makeBuiltin(
+        "setrecursionlimit",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "setrecursionlimit");
+
+            if (!args[0].isSmallInt()) {
+                throw std::runtime_error("TypeError: 'setrecursionlimit' argument must be int");
+            }
+
+            const Value::SmallInt limit = std::get<Value::SmallInt>(args[0].data);
+            RecursionLimit::setLimit(static_cast<int>(std::clamp<Value::SmallInt>(
+                limit, std::numeric_limits<int>::min(), std::numeric_limits<int>::max())));
+            return Value();
+        }
+    ));
+
+    module->setAttribute("getrecursionlimit", makeBuiltin(
+        "getrecursionlimit",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+            expectArgs(args, 0, "getrecursionlimit");
+            return Value(static_cast<Value::SmallInt>(RecursionLimit::limit()));
+        }
+    ));
+
+    module->setAttribute("maxsize", Value(std::numeric_limits<Value::SmallInt>::max()));
+    module->setAttribute("modules", ModuleLoader::modules());
+    module->setAttribute("path", ModuleLoader::path());
+    module->setAttribute("stdout", makeStream("stdout", OutputStream::standardOutput()));
+    module->setAttribute("stderr", makeStream("stderr", OutputStream::standardError()));
+
+    return Value(module);
+}
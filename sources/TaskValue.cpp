@@ -0,0 +1,61 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "TaskValue.h"
+
+#include "CoroutineValue.h"
+#include "EventLoop.h"
+
+TaskValue::TaskValue(Value coroutine) : coroutine(std::move(coroutine)) {}
+
+void TaskValue::start(const std::shared_ptr<TaskValue>& task) {
+    EventLoop::running().callSoon([task] { step(task); });
+}
+
+void TaskValue::abandon() {
+
+    if (done()) {
+        return;
+    }
+
+    // кадр сопрограммы держит ожидаемую Future, а её подписчики — эту задачу
+    dropCallbacks();
+    CoroutineValue::of(coroutine)->close();
+}
+
+void TaskValue::step(const std::shared_ptr<TaskValue>& task) {
+
+    if (task->done()) {
+        return;
+    }
+
+    CoroutineValue* body = CoroutineValue::of(task->coroutine);
+    Value yielded;
+    bool suspended;
+
+    try {
+        suspended = body->resume(Value(), yielded);
+    } catch (...) {
+        task->setException(std::current_exception());
+        return;
+    }
+
+    if (!suspended) {
+        task->setResult(body->returnValue());
+        return;
+    }
+
+    if (FutureValue* future = FutureValue::of(yielded)) {
+        future->addDoneCallback([task] { step(task); });
+        return;
+    }
+
+    if (yielded.isNone()) {
+        EventLoop::running().callSoon([task] { step(task); });
+        return;
+    }
+
+    body->close();
+    task->setException(std::make_exception_ptr(std::runtime_error(
+        "RuntimeError: Task got bad yield: " + yielded.repr().toStdString())));
+}
@@ -0,0 +1,407 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "TextCodec.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace textcodec {
+
+    namespace {
+
+        /// старший бит каждого байта слова
+        constexpr std::uint64_t highBytes = 0x8080808080808080ULL;
+
+        /// биты 0x7 и выше каждого символа UTF-16 слова: символ >= 0x80
+        constexpr std::uint64_t highUnits = 0xFF80FF80FF80FF80ULL;
+
+        const char* nameOf(const Codec codec) {
+
+            switch (codec) {
+                case Codec::Utf8:  return "utf-8";
+                case Codec::Ascii: return "ascii";
+                default:           return "latin-1";
+            }
+        }
+
+        /// символ в виде литерала Python: '\xe9', '€', '\U0001f600'
+        QString charRepr(const char32_t code) {
+
+            const int width = code < 0x100 ? 2 : code < 0x10000 ? 4 : 8;
+            const char* prefix = code < 0x100 ? "\\x" : code < 0x10000 ? "\\u" : "\\U";
+
+            return QString("'%1%2'").arg(QString::fromLatin1(prefix)).arg(static_cast<uint>(code), width, 16, QChar('0'));
+        }
+
+        [[noreturn]] void decodeError(const Codec codec, const QByteArrayView data, const qsizetype at,
+                                      const qsizetype length, const char* reason) {
+
+            const QString where = length == 1
+                ? QString("byte 0x%1 in position %2")
+                      .arg(static_cast<uint>(static_cast<unsigned char>(data[at])), 2, 16, QChar('0')).arg(at)
+                : QString("bytes in position %1-%2").arg(at).arg(at + length - 1);
+
+            throw std::runtime_error(QString("UnicodeDecodeError: '%1' codec can't decode %2: %3")
+                .arg(QString::fromLatin1(nameOf(codec)), where, QString::fromLatin1(reason)).toStdString());
+        }
+
+        [[noreturn]] void encodeError(const Codec codec, const char32_t code, const qsizetype at,
+                                      const qsizetype length, const char* reason) {
+
+            const QString where = length == 1
+                ? QString("character %1 in position %2").arg(charRepr(code)).arg(at)
+                : QString("characters in position %1-%2").arg(at).arg(at + length - 1);
+
+            throw std::runtime_error(QString("UnicodeEncodeError: '%1' codec can't encode %2: %3")
+                .arg(QString::fromLatin1(nameOf(codec)), where, QString::fromLatin1(reason)).toStdString());
+        }
+
+        void widen(const char* from, const qsizetype size, char16_t* to) {
+
+            for (qsizetype i = 0; i < size; ++i) {
+                to[i] = static_cast<unsigned char>(from[i]);
+            }
+        }
+
+        void narrow(const char16_t* from, const qsizetype size, char* to) {
+
+            for (qsizetype i = 0; i < size; ++i) {
+                to[i] = static_cast<char>(from[i]);
+            }
+        }
+
+        QString decodeUtf8(const QByteArrayView data, const Errors errors) {
+
+            const qsizetype size = data.size();
+
+            // в UTF-16 символов не больше, чем байтов в UTF-8
+            QString out(size, Qt::Uninitialized);
+            char16_t* const begin = reinterpret_cast<char16_t*>(out.data());
+            char16_t* to = begin;
+
+            const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+            qsizetype i = 0;
+
+            while (i < size) {
+
+                const qsizetype run = asciiPrefix(data.sliced(i));
+                widen(data.data() + i, run, to);
+                to += run;
+                i += run;
+
+                if (i >= size) {
+                    break;
+                }
+
+                // допустимые диапазоны второго байта исключают overlong-формы, суррогаты и коды > U+10FFFF
+                const unsigned char lead = bytes[i];
+                int need = 0;
+                unsigned char low = 0x80;
+                unsigned char high = 0xBF;
+
+                if (lead >= 0xC2 && lead <= 0xDF) {
+                    need = 1;
+                } else if (lead >= 0xE0 && lead <= 0xEF) {
+                    need = 2;
+                    low = lead == 0xE0 ? 0xA0 : 0x80;
+                    high = lead == 0xED ? 0x9F : 0xBF;
+                } else if (lead >= 0xF0 && lead <= 0xF4) {
+                    need = 3;
+                    low = lead == 0xF0 ? 0x90 : 0x80;
+                    high = lead == 0xF4 ? 0x8F : 0xBF;
+                }
+
+                char32_t code = lead & (0x3F >> need);
+                qsizetype taken = 1;
+                const char* reason = need ? nullptr : "invalid start byte";
+
+                for (int j = 0; j < need; ++j, ++taken) {
+
+                    if (i + taken >= size) {
+                        reason = "unexpected end of data";
+                        break;
+                    }
+
+                    const unsigned char next = bytes[i + taken];
+
+                    if (next < low || next > high) {
+                        reason = "invalid continuation byte";
+                        break;
+                    }
+
+                    code = code << 6 | (next & 0x3F);
+                    low = 0x80;
+                    high = 0xBF;
+                }
+
+                if (!reason) {
+
+                    if (code >= 0x10000) {
+                        *to++ = static_cast<char16_t>(0xD7C0 + (code >> 10));
+                        *to++ = static_cast<char16_t>(0xDC00 | (code & 0x3FF));
+                    } else {
+                        *to++ = static_cast<char16_t>(code);
+                    }
+
+                } else if (errors == Errors::Strict) {
+                    decodeError(Codec::Utf8, data, i, taken, reason);
+                } else if (errors == Errors::Replace) {
+                    // одна замена на максимальную неверную подпоследовательность, как в CPython
+                    *to++ = 0xFFFD;
+                }
+
+                i += taken;
+            }
+
+            out.resize(to - begin);
+
+            return out;
+        }
+
+        QString decodeAscii(const QByteArrayView data, const Errors errors) {
+
+            const qsizetype prefix = asciiPrefix(data);
+
+            if (prefix == data.size()) {
+                return QString::fromLatin1(data);
+            }
+
+            QString out(data.size(), Qt::Uninitialized);
+            char16_t* const begin = reinterpret_cast<char16_t*>(out.data());
+            char16_t* to = begin + prefix;
+
+            widen(data.data(), prefix, begin);
+
+            for (qsizetype i = prefix; i < data.size(); ++i) {
+
+                const auto byte = static_cast<unsigned char>(data[i]);
+
+                if (byte < 0x80) {
+                    *to++ = byte;
+                } else if (errors == Errors::Strict) {
+                    decodeError(Codec::Ascii, data, i, 1, "ordinal not in range(128)");
+                } else if (errors == Errors::Replace) {
+                    *to++ = 0xFFFD;
+                }
+            }
+
+            out.resize(to - begin);
+
+            return out;
+        }
+
+        QByteArray encodeUtf8(const QStringView text, const Errors errors) {
+
+            const qsizetype size = text.size();
+            const qsizetype prefix = asciiPrefix(text);
+            const auto* units = reinterpret_cast<const char16_t*>(text.utf16());
+
+            // символ UTF-16 даёт не больше трёх байтов, суррогатная пара — четыре на два символа
+            QByteArray out(prefix + (size - prefix) * 3, Qt::Uninitialized);
+            char* const begin = out.data();
+            char* to = begin + prefix;
+
+            narrow(units, prefix, begin);
+
+            for (qsizetype i = prefix; i < size; ++i) {
+
+                const char16_t unit = units[i];
+
+                if (unit < 0x80) {
+                    *to++ = static_cast<char>(unit);
+                } else if (unit < 0x800) {
+                    *to++ = static_cast<char>(0xC0 | unit >> 6);
+                    *to++ = static_cast<char>(0x80 | (unit & 0x3F));
+                } else if (QChar::isHighSurrogate(unit) && i + 1 < size && QChar::isLowSurrogate(units[i + 1])) {
+
+                    const char32_t code = QChar::surrogateToUcs4(unit, units[++i]);
+
+                    *to++ = static_cast<char>(0xF0 | code >> 18);
+                    *to++ = static_cast<char>(0x80 | (code >> 12 & 0x3F));
+                    *to++ = static_cast<char>(0x80 | (code >> 6 & 0x3F));
+                    *to++ = static_cast<char>(0x80 | (code & 0x3F));
+
+                } else if (QChar::isSurrogate(unit)) {
+
+                    if (errors == Errors::Strict) {
+
+                        qsizetype run = 1;
+
+                        while (i + run < size && QChar::isSurrogate(units[i + run])) {
+                            ++run;
+                        }
+
+                        encodeError(Codec::Utf8, unit, i, run, "surrogates not allowed");
+                    }
+
+                    if (errors == Errors::Replace) {
+                        *to++ = '?';
+                    }
+
+                } else {
+                    *to++ = static_cast<char>(0xE0 | unit >> 12);
+                    *to++ = static_cast<char>(0x80 | (unit >> 6 & 0x3F));
+                    *to++ = static_cast<char>(0x80 | (unit & 0x3F));
+                }
+            }
+
+            out.resize(to - begin);
+
+            return out;
+        }
+
+        /// ascii и latin-1: символы до limit переписываются байтом как есть
+        QByteArray encodeNarrow(const QStringView text, const Codec codec, const Errors errors) {
+
+            const char16_t limit = codec == Codec::Ascii ? 0x7F : 0xFF;
+            const char* reason = codec == Codec::Ascii ? "ordinal not in range(128)" : "ordinal not in range(256)";
+
+            const qsizetype size = text.size();
+            const qsizetype prefix = asciiPrefix(text);
+            const auto* units = reinterpret_cast<const char16_t*>(text.utf16());
+
+            QByteArray out(size, Qt::Uninitialized);
+            char* const begin = out.data();
+            char* to = begin + prefix;
+
+            narrow(units, prefix, begin);
+
+            for (qsizetype i = prefix; i < size; ++i) {
+
+                if (units[i] <= limit) {
+                    *to++ = static_cast<char>(units[i]);
+                    continue;
+                }
+
+                // суррогатная пара — один символ и одна замена
+                const auto width = [&](const qsizetype at) -> qsizetype {
+                    return QChar::isHighSurrogate(units[at]) && at + 1 < size && QChar::isLowSurrogate(units[at + 1]) ? 2 : 1;
+                };
+
+                if (errors == Errors::Strict) {
+
+                    const char32_t code = width(i) == 2 ? QChar::surrogateToUcs4(units[i], units[i + 1]) : units[i];
+                    qsizetype run = 0;
+
+                    while (i + run < size && units[i + run] > limit) {
+                        run += width(i + run);
+                    }
+
+                    encodeError(codec, code, i, run == width(i) ? 1 : run, reason);
+                }
+
+                if (errors == Errors::Replace) {
+                    *to++ = '?';
+                }
+
+                i += width(i) - 1;
+            }
+
+            out.resize(to - begin);
+
+            return out;
+        }
+    }
+
+    Codec codecOf(const QString& name) {
+
+        QString key = name.toLower();
+        key.remove(u'-').remove(u'_').remove(u' ');
+
+        if (key == "utf8" || key == "u8" || key == "utf" || key == "cp65001") {
+            return Codec::Utf8;
+        }
+
+        if (key == "ascii" || key == "usascii" || key == "646") {
+            return Codec::Ascii;
+        }
+
+        if (key == "latin1" || key == "latin" || key == "l1" || key == "iso88591" || key == "iso885911987"
+            || key == "8859" || key == "cp819") {
+            return Codec::Latin1;
+        }
+
+        throw std::runtime_error("LookupError: unknown encoding: " + name.toStdString());
+    }
+
+    Errors errorsOf(const QString& name) {
+
+        if (name == "strict") {
+            return Errors::Strict;
+        }
+
+        if (name == "replace") {
+            return Errors::Replace;
+        }
+
+        if (name == "ignore") {
+            return Errors::Ignore;
+        }
+
+        throw std::runtime_error("LookupError: unknown error handler name '" + name.toStdString() + "'");
+    }
+
+    qsizetype asciiPrefix(const QByteArrayView data) {
+
+        const char* bytes = data.data();
+        const qsizetype size = data.size();
+        qsizetype i = 0;
+
+        for (std::uint64_t word; i + 8 <= size; i += 8) {
+
+            std::memcpy(&word, bytes + i, sizeof word);
+
+            if (word & highBytes) {
+                break;
+            }
+        }
+
+        while (i < size && static_cast<unsigned char>(bytes[i]) < 0x80) {
+            ++i;
+        }
+
+        return i;
+    }
+
+    qsizetype asciiPrefix(const QStringView text) {
+
+        const char16_t* units = reinterpret_cast<const char16_t*>(text.utf16());
+        const qsizetype size = text.size();
+        qsizetype i = 0;
+
+        for (std::uint64_t word; i + 4 <= size; i += 4) {
+
+            std::memcpy(&word, units + i, sizeof word);
+
+            if (word & highUnits) {
+                break;
+            }
+        }
+
+        while (i < size && units[i] < 0x80) {
+            ++i;
+        }
+
+        return i;
+    }
+
+    QString decode(const QByteArrayView data, const Codec codec, const Errors errors) {
+
+        switch (codec) {
+            case Codec::Utf8:  return decodeUtf8(data, errors);
+            case Codec::Ascii: return decodeAscii(data, errors);
+            default:           return QString::fromLatin1(data);
+        }
+    }
+
+    QByteArray encode(const QStringView text, const Codec codec, const Errors errors) {
+
+        if (codec == Codec::Utf8) {
+            return encodeUtf8(text, errors);
+        }
+
+        return encodeNarrow(text, codec, errors);
+    }
+}
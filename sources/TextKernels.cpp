@@ -0,0 +1,174 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "TextKernels.h"
+
+#include <cstring>
+
+namespace textkernels {
+
+    namespace {
+
+        using Word = std::uint64_t;
+
+        constexpr qsizetype wordChars = 4;
+        /// символов за шаг цикла: четыре слова, 32 байта
+        constexpr qsizetype blockChars = 4 * wordChars;
+
+        /// value в каждой из четырёх дорожек
+        constexpr Word lanes(const std::uint16_t value) {
+            return value * Word(0x0001000100010001);
+        }
+
+        constexpr Word high = lanes(0x80);
+
+        Word load(const char16_t* chars) {
+            Word word;
+            std::memcpy(&word, chars, sizeof word);
+            return word;
+        }
+
+        void store(char16_t* chars, const Word word) {
+            std::memcpy(chars, &word, sizeof word);
+        }
+
+        /// 0x80 в дорожках, где lo <= символ <= hi
+        constexpr Word inRange(const Word word, const char16_t lo, const char16_t hi) {
+            return (word + lanes(0x80 - lo)) & ~(word + lanes(0x7f - hi)) & high;
+        }
+
+        template<CharClass charClass>
+        constexpr Word classMask(const Word word) {
+
+            if constexpr (charClass == CharClass::Digit) {
+                return inRange(word, '0', '9');
+            } else if constexpr (charClass == CharClass::Alpha) {
+                // 0x20 сводит заглавные к строчным
+                return inRange(word | lanes(0x20), 'a', 'z');
+            } else if constexpr (charClass == CharClass::Alnum) {
+                return classMask<CharClass::Digit>(word) | classMask<CharClass::Alpha>(word);
+            } else if constexpr (charClass == CharClass::Space) {
+                // как textscan::isStrSpace: \t..\r и 0x1c..0x1f вместе с пробелом
+                return inRange(word, '\t', '\r') | inRange(word, 0x1c, ' ');
+            } else {
+                return classMask<CharClass::Alnum>(word) | inRange(word, '_', '_');
+            }
+        }
+
+        /// 0x20 в дорожках, где у символа меняется регистр
+        template<Case mode>
+        constexpr Word caseFlip(const Word word) {
+
+            if constexpr (mode == Case::Upper) {
+                return inRange(word, 'a', 'z') >> 2;
+            } else if constexpr (mode == Case::Lower) {
+                return inRange(word, 'A', 'Z') >> 2;
+            } else {
+                return classMask<CharClass::Alpha>(word) >> 2;
+            }
+        }
+
+        template<Case mode>
+        void convert(const char16_t* chars, const qsizetype size, char16_t* dst) {
+
+            qsizetype i = 0;
+
+            for (; i + blockChars <= size; i += blockChars) {
+
+                for (qsizetype w = i; w < i + blockChars; w += wordChars) {
+                    const Word word = load(chars + w);
+                    store(dst + w, word ^ caseFlip<mode>(word));
+                }
+            }
+
+            // хвост — по символу в младшей дорожке
+            for (; i < size; ++i) {
+                dst[i] = static_cast<char16_t>(chars[i] ^ caseFlip<mode>(chars[i]));
+            }
+        }
+
+        template<CharClass charClass>
+        bool all(const char16_t* chars, const qsizetype size) {
+
+            qsizetype i = 0;
+
+            for (; i + blockChars <= size; i += blockChars) {
+
+                const Word matched = classMask<charClass>(load(chars + i)) &
+                                     classMask<charClass>(load(chars + i + wordChars)) &
+                                     classMask<charClass>(load(chars + i + 2 * wordChars)) &
+                                     classMask<charClass>(load(chars + i + 3 * wordChars));
+
+                if (matched != high) {
+                    return false;
+                }
+            }
+
+            for (; i < size; ++i) {
+
+                if ((classMask<charClass>(chars[i]) & 0x80) == 0) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    char16_t unionBits(const QStringView text) {
+
+        const char16_t* chars = text.utf16();
+        const qsizetype size = text.size();
+
+        Word bits = 0;
+        qsizetype i = 0;
+
+        for (; i + blockChars <= size; i += blockChars) {
+
+            bits |= load(chars + i) | load(chars + i + wordChars) |
+                    load(chars + i + 2 * wordChars) | load(chars + i + 3 * wordChars);
+
+            // шире Latin-1 строка уже не станет
+            if (bits & lanes(0xff00)) {
+                break;
+            }
+        }
+
+        auto result = static_cast<char16_t>(bits | bits >> 16 | bits >> 32 | bits >> 48);
+
+        if (result >= 0x100) {
+            return result;
+        }
+
+        for (; i < size; ++i) {
+            result |= chars[i];
+        }
+
+        return result;
+    }
+
+    void convertCase(const QStringView text, char16_t* dst, const Case mode) {
+
+        switch (mode) {
+            case Case::Upper: convert<Case::Upper>(text.utf16(), text.size(), dst); break;
+            case Case::Lower: convert<Case::Lower>(text.utf16(), text.size(), dst); break;
+            case Case::Swap:  convert<Case::Swap>(text.utf16(), text.size(), dst); break;
+        }
+    }
+
+    bool allOf(const QStringView text, const CharClass charClass) {
+
+        const char16_t* chars = text.utf16();
+        const qsizetype size = text.size();
+
+        switch (charClass) {
+            case CharClass::Digit:      return all<CharClass::Digit>(chars, size);
+            case CharClass::Alpha:      return all<CharClass::Alpha>(chars, size);
+            case CharClass::Alnum:      return all<CharClass::Alnum>(chars, size);
+            case CharClass::Space:      return all<CharClass::Space>(chars, size);
+            case CharClass::Identifier: return all<CharClass::Identifier>(chars, size);
+        }
+
+        return false;
+    }
+}
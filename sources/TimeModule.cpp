@@ -0,0 +1,423 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "TimeModule.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+#include "CallRuntime.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "Compiler.h"
+#include "DictValue.h"
+#include "GarbageCollector.h"
+#include "Lexer.h"
+#include "ListValue.h"
+#include "Parser.h"
+#include "StrValue.h"
+#include "VirtualMachine.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    std::int64_t nanoseconds(const std::chrono::nanoseconds duration) {
+        return duration.count();
+    }
+
+    Value seconds(const std::int64_t nanos) {
+        return Value(static_cast<Value::Float>(nanos) / 1e9);
+    }
+
+    std::int64_t steadyNanoseconds() {
+        return nanoseconds(Clock::now().time_since_epoch());
+    }
+
+    std::int64_t systemNanoseconds() {
+        return nanoseconds(std::chrono::system_clock::now().time_since_epoch());
+    }
+
+    /// процессорное время процесса (user + system), без времени сна
+    std::int64_t processNanoseconds() {
+
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+
+        const auto ticks = [](const FILETIME& time) {
+            return static_cast<std::int64_t>(
+                (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime);
+        };
+
+        // FILETIME считает интервалами по 100 нс
+        return (ticks(kernel) + ticks(user)) * 100;
+#else
+        timespec time{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+
+        return static_cast<std::int64_t>(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+#endif
+    }
+
+    /// `name()` в секундах и `name_ns()` в целых наносекундах по одним часам
+    void defineClock(const std::shared_ptr<ClassValue>& module, const QString& name, std::int64_t (*clock)()) {
+
+        module->setAttribute(name, makeBuiltin(
+            name,
+            [name, clock](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) {
+                expectArgs(args, 0, name);
+                return seconds(clock());
+            }
+        ));
+
+        module->setAttribute(name + "_ns", makeBuiltin(
+            name + "_ns",
+            [name, clock](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) {
+                expectArgs(args, 0, name + "_ns");
+                return Value(Value::SmallInt(clock()));
+            }
+        ));
+    }
+
+    /// сборщик мусора выключен на время замера: его паузы не попадают в результат
+    class GcPause {
+    public:
+        GcPause() : saved(GarbageCollector::enabled) {
+            GarbageCollector::enabled = false;
+        }
+
+        ~GcPause() {
+            GarbageCollector::enabled = saved;
+        }
+
+        GcPause(const GcPause&) = delete;
+        GcPause& operator=(const GcPause&) = delete;
+
+    private:
+        bool saved;
+    };
+
+    /// stmt или setup: объект для вызова либо байткод текста
+    struct Step {
+        Value callable;
+        std::shared_ptr<const CodeObject> code;
+    };
+
+    Step prepare(const Value& piece, const char* name) {
+
+        if (piece.isString()) {
+
+            // результаты выражений не печатаются, даже если timeit вызван из REPL
+            const bool echo = Compiler::echoResults;
+            Compiler::echoResults = false;
+
+            try {
+
+                const QByteArray source = piece.asString()->text().toUtf8();
+
+                Lexer lexer;
+                const QVector<Token> tokens = lexer.tokenize(
+                    std::string_view(source.constData(), static_cast<std::size_t>(source.size())));
+
+                Parser parser(tokens);
+
+                Step step{Value(), Compiler::compileModule(parser.parseModule())};
+
+                Compiler::echoResults = echo;
+                return step;
+
+            } catch (...) {
+                Compiler::echoResults = echo;
+                throw;
+            }
+        }
+
+        if (piece.isCallable()) {
+            return Step{piece, nullptr};
+        }
+
+        throw std::runtime_error(std::string("ValueError: ") + name + " is neither a string nor callable");
+    }
+
+    struct TimeitArgs {
+        Value stmt = Value("pass");
+        Value setup = Value("pass");
+        std::optional<std::int64_t> number;
+        std::int64_t repeat = 5;
+    };
+
+    std::int64_t toCount(const Value& value, const char* name) {
+
+        if (!value.isBigInt() || value.isBool()) {
+            throw std::runtime_error(
+                "TypeError: '" + typeName(value).toStdString() + "' object cannot be interpreted as an integer");
+        }
+
+        const Value::BigInt count = value.toBigInt();
+
+        if (count < 0) {
+            throw std::runtime_error(std::string("ValueError: ") + name + " must be non-negative");
+        }
+
+        return count.convert_to<std::int64_t>();
+    }
+
+    TimeitArgs parseTimeit(const std::vector<Value>& args, const Kwargs& kwargs, const QString& name, const bool repeats) {
+
+        expectArgsRange(args, 0, 2, name);
+
+        TimeitArgs parsed;
+
+        if (!args.empty()) {
+            parsed.stmt = args[0];
+        }
+
+        if (args.size() > 1) {
+            parsed.setup = args[1];
+        }
+
+        for (const auto& [kwarg, value] : kwargs) {
+
+            if (kwarg == "stmt") {
+                parsed.stmt = value;
+            } else if (kwarg == "setup") {
+                parsed.setup = value;
+            } else if (kwarg == "number") {
+                parsed.number = toCount(value, "number");
+            } else if (kwarg == "repeat" && repeats) {
+                parsed.repeat = toCount(value, "repeat");
+            } else {
+                throw std::runtime_error(
+                    "TypeError: " + name.toStdString() + "() got an unexpected keyword argument '" + kwarg.toStdString() + "'");
+            }
+        }
+
+        return parsed;
+    }
+
+    /**
+     * Замер одного stmt: тексты компилируются в конструкторе, run() только выполняет.
+     * Цикл выбирается до первого выполнения — внутри него нет разбора вида stmt.
+     */
+    class Benchmark {
+    public:
+        Benchmark(const TimeitArgs& args, const std::shared_ptr<Environment>& env)
+            : stmt(prepare(args.stmt, "stmt")),
+              setup(prepare(args.setup, "setup")),
+              // кадр функции виден тексту только через глобальное окружение своего модуля
+              globals(env->layout && env->parent ? env->parent : env) {}
+
+        /// number выполнений stmt после одного setup, в наносекундах
+        [[nodiscard]] std::int64_t run(const std::int64_t number) const {
+
+            const auto scope = std::make_shared<Environment>(globals);
+            scope->moduleScope = true;
+
+            execute(setup, scope);
+
+            const GcPause pause;
+            const auto start = Clock::now();
+
+            if (stmt.code) {
+
+                const CodeObject& code = *stmt.code;
+
+                for (std::int64_t i = 0; i < number; ++i) {
+                    VirtualMachine::run(code, scope);
+                }
+
+            } else {
+
+                const std::vector<Value> noArgs;
+                const Kwargs noKwargs;
+
+                for (std::int64_t i = 0; i < number; ++i) {
+                    call(stmt.callable, noArgs, noKwargs, scope);
+                }
+            }
+
+            return nanoseconds(Clock::now() - start);
+        }
+
+        /**
+         * Число выполнений, как у `python -m timeit`: 1, 2, 5, 10, 20, 50, ...,
+         * пока один повтор не займёт 0,2 с.
+         */
+        [[nodiscard]] std::int64_t autorange() const {
+
+            for (std::int64_t scale = 1;; scale *= 10) {
+                for (const std::int64_t base : {1, 2, 5}) {
+
+                    const std::int64_t number = base * scale;
+
+                    if (run(number) >= 200'000'000) {
+                        return number;
+                    }
+                }
+            }
+        }
+
+    private:
+        static void execute(const Step& step, const std::shared_ptr<Environment>& scope) {
+
+            if (step.code) {
+                VirtualMachine::run(*step.code, scope);
+            } else {
+                call(step.callable, {}, {}, scope);
+            }
+        }
+
+        Step stmt;
+        Step setup;
+        std::shared_ptr<Environment> globals;
+    };
+
+    Value repeatTimes(const Benchmark& benchmark, const std::int64_t repeat, const std::int64_t number) {
+
+        const auto times = std::make_shared<ListValue>();
+        std::vector<Value>& elements = times->elements.mutate();
+
+        elements.reserve(static_cast<std::size_t>(repeat));
+
+        for (std::int64_t i = 0; i < repeat; ++i) {
+            elements.push_back(seconds(benchmark.run(number)));
+        }
+
+        return Value(times);
+    }
+}
+
+Value TimeModule::makeTime() {
+
+    const auto module = std::make_shared<ClassValue>("time");
+
+    defineClock(module, "time", systemNanoseconds);
+    defineClock(module, "perf_counter", steadyNanoseconds);
+    defineClock(module, "monotonic", steadyNanoseconds);
+    defineClock(module, "process_time", processNanoseconds);
+
+    module->setAttribute("sleep", makeBuiltin(
+        "sleep",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "sleep");
+
+            if (!args[0].isNumeric()) {
+                throw std::runtime_error(
+                    "TypeError: '" + typeName(args[0]).toStdString() + "' object cannot be interpreted as an integer");
+            }
+
+            const Value::Float duration = args[0].toDouble();
+
+            if (duration < 0) {
+                throw std::runtime_error("ValueError: sleep length must be non-negative");
+            }
+
+            std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+
+            return {};
+        }
+    ));
+
+    return Value(module);
+}
+
+Value TimeModule::makeTimeit() {
+
+    const auto module = std::make_shared<ClassValue>("timeit");
+
+    module->setAttribute("default_timer", makeBuiltin(
+        "perf_counter",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) {
+            expectArgs(args, 0, "perf_counter");
+            return seconds(steadyNanoseconds());
+        }
+    ));
+
+    module->setAttribute("timeit", makeBuiltin(
+        "timeit",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) {
+
+            const TimeitArgs parsed = parseTimeit(args, kwargs, "timeit", false);
+            const Benchmark benchmark(parsed, env);
+
+            return seconds(benchmark.run(parsed.number.value_or(1'000'000)));
+        }
+    ));
+
+    module->setAttribute("repeat", makeBuiltin(
+        "repeat",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) {
+
+            const TimeitArgs parsed = parseTimeit(args, kwargs, "repeat", true);
+            const Benchmark benchmark(parsed, env);
+
+            return repeatTimes(benchmark, parsed.repeat, parsed.number.value_or(1'000'000));
+        }
+    ));
+
+    module->setAttribute("measure", makeBuiltin(
+        "measure",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>& env) {
+
+            const TimeitArgs parsed = parseTimeit(args, kwargs, "measure", true);
+
+            if (parsed.repeat < 1) {
+                throw std::runtime_error("ValueError: repeat must be positive");
+            }
+
+            const Benchmark benchmark(parsed, env);
+            const std::int64_t number = parsed.number ? *parsed.number : benchmark.autorange();
+
+            std::vector<Value::Float> perLoop;
+            perLoop.reserve(static_cast<std::size_t>(parsed.repeat));
+
+            for (std::int64_t i = 0; i < parsed.repeat; ++i) {
+
+                const std::int64_t total = benchmark.run(number);
+
+                perLoop.push_back(number > 0 ? static_cast<Value::Float>(total) / 1e9 / static_cast<Value::Float>(number) : 0.0);
+            }
+
+            const auto times = std::make_shared<ListValue>();
+            std::vector<Value>& elements = times->elements.mutate();
+
+            for (const Value::Float time : perLoop) {
+                elements.emplace_back(time);
+            }
+
+            std::sort(perLoop.begin(), perLoop.end());
+
+            const std::size_t middle = perLoop.size() / 2;
+            const Value::Float median = perLoop.size() % 2 == 1
+                ? perLoop[middle]
+                : (perLoop[middle - 1] + perLoop[middle]) / 2;
+
+            const auto result = std::make_shared<DictValue>();
+            result->setItem(Value("number"), Value(Value::SmallInt(number)));
+            result->setItem(Value("repeat"), Value(Value::SmallInt(parsed.repeat)));
+            result->setItem(Value("times"), Value(times));
+            result->setItem(Value("min"), Value(perLoop.front()));
+            result->setItem(Value("median"), Value(median));
+
+            return Value(result);
+        }
+    ));
+
+    return Value(module);
+}
@@ -0,0 +1,214 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "TokenCache.h"
+
+#include <cstring>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "StringTable.h"
+
+namespace {
+
+/// 'CPYT' в порядке байт машины: файл с другим порядком байт не пройдёт проверку
+constexpr std::uint32_t cacheMagic = 0x54595043;
+
+struct CacheHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::int64_t mtime;
+    std::int64_t size;
+    std::uint64_t hash;
+    std::uint32_t tokenCount;
+    /// длина пула строк в UTF-16 символах
+    std::uint32_t poolLength;
+};
+
+struct CacheRecord {
+    std::uint8_t type;
+    /// Keyword или -1
+    std::int8_t keyword;
+    std::uint16_t reserved;
+    std::int32_t line;
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+static_assert(sizeof(CacheHeader) == 40);
+static_assert(sizeof(CacheRecord) == 16);
+
+}
+
+std::uint64_t TokenCache::hashSource(const char* data, const qint64 size) {
+
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (qint64 i = 0; i < size; ++i) {
+        hash ^= static_cast<std::uint8_t>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+QString TokenCache::cachePath(const QString& sourcePath) {
+
+    const QFileInfo info(sourcePath);
+
+    return info.absoluteDir().filePath("__pycache__/" + info.fileName() + ".tokc");
+}
+
+/**
+ * Читает кэш через отображение в память. Перед созданием токенов проверяются заголовок,
+ * точный размер файла и границы каждой записи, поэтому усечённый или чужой файл
+ * считается промахом, а не приводит к чтению за пределами отображения.
+ * Идентификаторы интернируются так же, как это делает Lexer.
+ */
+std::optional<QVector<Token>> TokenCache::load(const QString& sourcePath, const qint64 mtime, const qint64 size,
+                                               const std::uint64_t hash) {
+
+    QFile file(cachePath(sourcePath));
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    const qint64 fileSize = file.size();
+
+    if (fileSize < static_cast<qint64>(sizeof(CacheHeader))) {
+        return std::nullopt;
+    }
+
+    const uchar* data = file.map(0, fileSize);
+
+    if (!data) {
+        return std::nullopt;
+    }
+
+    CacheHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+
+    const qint64 expectedSize = static_cast<qint64>(sizeof(CacheHeader))
+        + static_cast<qint64>(header.tokenCount) * static_cast<qint64>(sizeof(CacheRecord))
+        + static_cast<qint64>(header.poolLength) * static_cast<qint64>(sizeof(char16_t));
+
+    if (header.magic != cacheMagic || header.version != version ||
+        header.mtime != mtime || header.size != size || header.hash != hash ||
+        expectedSize != fileSize) {
+
+        file.unmap(const_cast<uchar*>(data));
+        return std::nullopt;
+    }
+
+    const uchar* records = data + sizeof(CacheHeader);
+    const auto* pool = reinterpret_cast<const char16_t*>(
+        records + static_cast<qint64>(header.tokenCount) * sizeof(CacheRecord));
+
+    QVector<Token> tokens;
+    tokens.reserve(static_cast<qsizetype>(header.tokenCount));
+
+    for (std::uint32_t i = 0; i < header.tokenCount; ++i) {
+
+        CacheRecord record{};
+        std::memcpy(&record, records + static_cast<qint64>(i) * sizeof(CacheRecord), sizeof(record));
+
+        if (record.type > TOKEN_EOF ||
+            record.keyword < -1 || record.keyword > static_cast<std::int8_t>(Keyword::IS) ||
+            record.offset > header.poolLength || record.length > header.poolLength - record.offset) {
+
+            file.unmap(const_cast<uchar*>(data));
+            return std::nullopt;
+        }
+
+        QString value = QString::fromUtf16(pool + record.offset, record.length);
+
+        if (record.type == TOKEN_ID) {
+            value = StringTable::intern(value);
+        }
+
+        std::optional<Keyword> keyword;
+
+        if (record.keyword >= 0) {
+            keyword = static_cast<Keyword>(record.keyword);
+        }
+
+        tokens.push_back(Token(static_cast<TokenType>(record.type), std::move(value), record.line, keyword));
+    }
+
+    file.unmap(const_cast<uchar*>(data));
+
+    return tokens;
+}
+
+QByteArray TokenCache::serialize(const qint64 mtime, const qint64 size, const std::uint64_t hash,
+                                 const QVector<Token>& tokens) {
+
+    QByteArray records;
+    QByteArray pool;
+
+    records.reserve(tokens.size() * static_cast<qsizetype>(sizeof(CacheRecord)));
+
+    for (const Token& token : tokens) {
+
+        CacheRecord record{};
+        record.type = static_cast<std::uint8_t>(token.type);
+        record.keyword = token.keyword ? static_cast<std::int8_t>(*token.keyword) : std::int8_t{-1};
+        record.line = token.line;
+        record.offset = static_cast<std::uint32_t>(pool.size() / sizeof(char16_t));
+        record.length = static_cast<std::uint32_t>(token.value.size());
+
+        records.append(reinterpret_cast<const char*>(&record), sizeof(record));
+        pool.append(reinterpret_cast<const char*>(token.value.utf16()),
+                    token.value.size() * static_cast<qsizetype>(sizeof(char16_t)));
+    }
+
+    CacheHeader header{};
+    header.magic = cacheMagic;
+    header.version = version;
+    header.mtime = mtime;
+    header.size = size;
+    header.hash = hash;
+    header.tokenCount = static_cast<std::uint32_t>(tokens.size());
+    header.poolLength = static_cast<std::uint32_t>(pool.size() / sizeof(char16_t));
+
+    QByteArray out;
+    out.reserve(static_cast<qsizetype>(sizeof(header)) + records.size() + pool.size());
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(records);
+    out.append(pool);
+
+    return out;
+}
+
+/**
+ * Пишет кэш через QSaveFile: файл заменяется атомарно, поэтому параллельный запуск
+ * того же скрипта никогда не увидит частично записанный кэш.
+ */
+bool TokenCache::store(const QString& sourcePath, const qint64 mtime, const qint64 size, const std::uint64_t hash,
+                       const QVector<Token>& tokens) {
+
+    const QString path = cachePath(sourcePath);
+
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return false;
+    }
+
+    QSaveFile file(path);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    const QByteArray bytes = serialize(mtime, size, hash, tokens);
+
+    if (file.write(bytes) != bytes.size()) {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
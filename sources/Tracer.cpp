@@ -0,0 +1,310 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "Tracer.h"
+
+#include <cstdio>
+
+#include <QFile>
+#include <QStringList>
+
+#include "Bytecode.h"
+#include "CallRuntime.h"
+#include "ClassValue.h"
+#include "Environment.h"
+#include "FunctionValue.h"
+#include "InstanceValue.h"
+#include "OutputStream.h"
+#include "PyException.h"
+#include "InterpreterContext.h"
+#include "StopIterationException.h"
+#include "TupleValue.h"
+
+namespace {
+
+    std::shared_ptr<ClassValue> makeClass(const QString& name) {
+        const auto cls = std::make_shared<ClassValue>(name);
+        cls->bases.push_back(InterpreterContext::current().objectClass);
+        return cls;
+    }
+
+    QString qualifiedName(const FunctionValue& function) {
+        return function.ownerClass ? function.ownerClass->name + "." + function.name : function.name;
+    }
+
+    /// `__file__` модуля, в котором определена функция
+    QString fileOf(const FunctionValue& function) {
+
+        if (function.closure) {
+            if (const Value* file = function.closure->findLocal("__file__")) {
+                return file->toString();
+            }
+        }
+
+        return "<stdin>";
+    }
+
+    double milliseconds(const Tracer::Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+void Tracer::setTrace(const Value& function) {
+    globalTrace = function;
+    updateActive();
+}
+
+void Tracer::startLineProfile() {
+    lineProfiling = true;
+    updateActive();
+}
+
+void Tracer::trackLocations(const bool enabled) {
+    locationTracking = enabled;
+    updateActive();
+}
+
+std::pair<QString, int> Tracer::location() {
+
+    if (frames.empty()) {
+        return {"<unknown>", 0};
+    }
+
+    const TraceFrame& frame = frames.back();
+
+    // до первой строки функции — строка её заголовка
+    if (frame.line == 0 && frame.function) {
+        return {frame.file, frame.function->firstLine};
+    }
+
+    return {frame.file, frame.line};
+}
+
+bool Tracer::enterModule(const CodeObject& code, const QString& file) {
+
+    if (inTracer) {
+        return false;
+    }
+
+    frames.push_back(TraceFrame{nullptr, &code, file, Value(), Value()});
+    frames.back().lineStart = Clock::now();
+
+    return true;
+}
+
+bool Tracer::enter(const FunctionValue& function) {
+
+    if (inTracer) {
+        return false;
+    }
+
+    frames.push_back(TraceFrame{&function, function.code.get(), fileOf(function), Value(), Value()});
+
+    if (!globalTrace.isNone()) {
+        try {
+            dispatch(frames.back(), globalTrace, "call", Value());
+        } catch (...) {
+            frames.pop_back();
+            throw;
+        }
+    }
+
+    frames.back().lineStart = Clock::now();
+
+    return true;
+}
+
+void Tracer::leave(const Value& result, const bool propagate) {
+
+    TraceFrame& frame = frames.back();
+
+    if (lineProfiling && frame.function) {
+        closeLine(frame, Clock::now());
+    }
+
+    if (!globalTrace.isNone() && !frame.localTrace.isNone()) {
+        try {
+            dispatch(frame, frame.localTrace, "return", result);
+        } catch (...) {
+            frames.pop_back();
+
+            // из деструктора кадра исключение не выпускается: трассировка уже снята
+            if (propagate) {
+                throw;
+            }
+            return;
+        }
+    }
+
+    frames.pop_back();
+}
+
+Tracer::TraceFrame* Tracer::current(const CodeObject& code) {
+
+    if (inTracer || frames.empty() || frames.back().code != &code) {
+        return nullptr;
+    }
+
+    return &frames.back();
+}
+
+void Tracer::closeLine(TraceFrame& frame, const Clock::time_point now) {
+    if (frame.line > 0) {
+        lines[{frame.file, frame.line}].time += now - frame.lineStart;
+    }
+}
+
+void Tracer::line(const CodeObject& code, const int line) {
+
+    TraceFrame* frame = current(code);
+
+    if (!frame) {
+        return;
+    }
+
+    // профилировщик считает только строки функций
+    if (lineProfiling && frame->function) {
+
+        closeLine(*frame, Clock::now());
+
+        LineStats& stats = lines[{frame->file, line}];
+        ++stats.hits;
+
+        if (stats.function.isEmpty()) {
+            stats.function = qualifiedName(*frame->function);
+        }
+    }
+
+    frame->line = line;
+
+    if (!globalTrace.isNone() && !frame->localTrace.isNone()) {
+        dispatch(*frame, frame->localTrace, "line", Value());
+    }
+
+    // время функции трассировки не относится к строке
+    frame->lineStart = Clock::now();
+}
+
+void Tracer::exception(const CodeObject& code, const std::exception& error) {
+
+    TraceFrame* frame = current(code);
+
+    // StopIteration — служебное завершение итерации, а не ошибка программы
+    if (!frame || globalTrace.isNone() || frame->localTrace.isNone() ||
+        dynamic_cast<const StopIterationException*>(&error)) {
+        return;
+    }
+
+    const Value exception = PyException::toException(error);
+    const Value info = TupleValue::make({Value(exception.asInstance()->klass), exception, Value()});
+
+    dispatch(*frame, frame->localTrace, "exception", info);
+}
+
+void Tracer::dispatch(TraceFrame& frame, const Value& trace, const char* event, const Value& arg) {
+
+    static const auto frameClass = makeClass("frame");
+    static const auto codeClass = makeClass("code");
+
+    if (frame.object.isNone()) {
+
+        const auto code = std::make_shared<InstanceValue>(codeClass);
+        code->setField("co_name", Value(frame.function->name));
+        code->setField("co_filename", Value(frame.file));
+        code->setField("co_firstlineno", Value(static_cast<Value::SmallInt>(frame.function->firstLine)));
+
+        const auto object = std::make_shared<InstanceValue>(frameClass);
+        object->setField("f_code", Value(code));
+        frame.object = Value(object);
+    }
+
+    const int line = frame.line > 0 ? frame.line : frame.function->firstLine;
+    frame.object.asInstance()->setField("f_lineno", Value(static_cast<Value::SmallInt>(line)));
+
+    Value result;
+    inTracer = true;
+
+    try {
+        result = call(trace, {frame.object, Value(event), arg}, {}, nullptr);
+    } catch (...) {
+        // ошибка в функции трассировки снимает трассировку, как в CPython
+        inTracer = false;
+        globalTrace = Value();
+
+        for (TraceFrame& traced : frames) {
+            traced.localTrace = Value();
+        }
+
+        updateActive();
+        throw;
+    }
+
+    inTracer = false;
+
+    // None оставляет прежнюю локальную функцию; у события call её ещё нет
+    if (!result.isNone()) {
+        frame.localTrace = std::move(result);
+    }
+}
+
+void Tracer::reportLineProfile() {
+
+    if (!lineProfiling) {
+        return;
+    }
+
+    lineProfiling = false;
+    updateActive();
+
+    OutputStream& err = OutputStream::standardError();
+    char text[128];
+
+    QString file;
+    QStringList source;
+    QString function;
+
+    err.write(std::string_view("line profile (time per line includes calls made from it)\n"));
+
+    for (const auto& [key, stats] : lines) {
+
+        if (key.first != file) {
+
+            file = key.first;
+            function.clear();
+            source.clear();
+
+            if (QFile input(file); input.open(QIODevice::ReadOnly)) {
+                source = QString::fromUtf8(input.readAll()).split(u'\n');
+            }
+
+            err.write(std::string_view("\nFile: "));
+            err.write(file);
+            err.write(std::string_view("\n"));
+        }
+
+        if (stats.function != function) {
+
+            function = stats.function;
+
+            std::snprintf(text, sizeof(text), "\n%8s %10s %12s %12s  ", "line", "hits", "time ms", "per hit us");
+            err.write(std::string_view(text));
+            err.write(function);
+            err.write(std::string_view("\n"));
+        }
+
+        const double total = milliseconds(stats.time);
+        const double perHit = stats.hits ? total * 1000.0 / static_cast<double>(stats.hits) : 0.0;
+
+        std::snprintf(text, sizeof(text), "%8d %10llu %12.3f %12.3f  ",
+                      key.second, static_cast<unsigned long long>(stats.hits), total, perHit);
+        err.write(std::string_view(text));
+
+        if (key.second - 1 < source.size()) {
+            err.write(source[key.second - 1].trimmed());
+        }
+
+        err.write(std::string_view("\n"));
+    }
+
+    err.flush();
+}
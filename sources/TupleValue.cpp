@@ -3,32 +3,83 @@
 //
 #include "TupleValue.h"
 
+#include <cstdint>
+
 #include "../runtime/ProtocolHelpers.h"
+#include "ObjectPool.h"
+#include "ReprWriter.h"
 
 TupleValue::TupleValue(const std::vector<Value>& items)
     : items(items) {}
 
-QString TupleValue::toString() const {
+TupleValue::TupleValue(std::vector<Value>&& items) noexcept
+    : items(std::move(items)) {}
 
-    QString out = "(";
+TupleValue::~TupleValue() {
 
-    for (size_t i = 0; i < items.size(); ++i) {
+    const std::size_t capacity = items.capacity();
 
-        out += items[i].repr();
+    if (capacity == 0 || capacity > maxCachedLength) {
+        return;
+    }
 
-        if (i + 1 < items.size()) {
-            out += ", ";
+    // элементы разрушаются до обращения к списку: среди них могут быть другие кортежи
+    items.clear();
+
+    if (auto& list = freeLists()[capacity]; list.size() < maxFreePerLength) {
+        list.push_back(std::move(items));
+    }
+}
+
+std::array<std::vector<std::vector<Value>>, TupleValue::maxCachedLength + 1>& TupleValue::freeLists() {
+    static auto* lists = new std::array<std::vector<std::vector<Value>>, maxCachedLength + 1>();
+    return *lists;
+}
+
+std::vector<Value> TupleValue::acquireItems(const std::size_t length) {
+
+    if (length > 0 && length <= maxCachedLength) {
+
+        if (auto& list = freeLists()[length]; !list.empty()) {
+            std::vector<Value> items = std::move(list.back());
+            list.pop_back();
+            return items;
         }
     }
 
-    // Python semantics:
-    // (1,) вместо (1)
+    std::vector<Value> items;
+    items.reserve(length);
 
-    if (items.size() == 1) {
-        out += ",";
+    return items;
+}
+
+Value TupleValue::empty() {
+    static const auto* instance = new Value(makePooled<TupleValue>());
+    return *instance;
+}
+
+Value TupleValue::make(std::vector<Value> items) {
+
+    if (items.empty()) {
+        return empty();
     }
 
-    out += ")";
+    return Value(makePooled<TupleValue>(std::move(items)));
+}
+
+Value TupleValue::pair(Value first, Value second) {
+
+    std::vector<Value> items = acquireItems(2);
+    items.push_back(std::move(first));
+    items.push_back(std::move(second));
+
+    return Value(makePooled<TupleValue>(std::move(items)));
+}
+
+QString TupleValue::toString() const {
+
+    QString out;
+    ReprWriter(out).tuple(*this);
 
     return out;
 }
@@ -37,6 +88,21 @@ QString TupleValue::repr() const {
     return toString();
 }
 
+Value TupleValue::getItemInt(Value::SmallInt index) const {
+
+    const auto size = static_cast<Value::SmallInt>(items.size());
+
+    if (index < 0) {
+        index += size;
+    }
+
+    if (index < 0 || index >= size) {
+        throw std::runtime_error("IndexError: tuple index out of range");
+    }
+
+    return items[static_cast<std::size_t>(index)];
+}
+
 Value TupleValue::getItem(const Value& index) const {
 
     if (index.isSlice()) {
@@ -54,11 +120,11 @@ Value TupleValue::getItem(const Value& index) const {
             }
         );
 
-        return Value(
-            std::make_shared<TupleValue>(
-                std::move(result)
-            )
-        );
+        return make(std::move(result));
+    }
+
+    if (const auto small = std::get_if<Value::SmallInt>(&index.data)) {
+        return getItemInt(*small);
     }
 
     if (!index.isBigInt() && !index.isBool()) {
@@ -88,7 +154,7 @@ Value TupleValue::count(const Value& value) const {
 
     for (const auto& item : items) {
 
-        if (item == value) {
+        if (item.itemEquals(value)) {
             ++count;
         }
     }
@@ -150,7 +216,7 @@ Value TupleValue::index(
 
     for (std::ptrdiff_t i = s; i < e; ++i) {
 
-        if (items[i] == value) {
+        if (items[i].itemEquals(value)) {
             return Value(
                 Value::BigInt(i)
             );
@@ -178,7 +244,7 @@ bool TupleValue::equal(const Value& other) const {
 
     for (size_t i = 0; i < items.size(); ++i) {
 
-        if (items[i] != rhs[i]) {
+        if (!items[i].itemEquals(rhs[i])) {
             return false;
         }
     }
@@ -208,7 +274,7 @@ bool TupleValue::less(const Value& other) const {
 
     for (size_t i = 0; i < minSize; ++i) {
 
-        if (items[i] == rhs[i]) {
+        if (items[i].itemEquals(rhs[i])) {
             continue;
         }
 
@@ -237,7 +303,7 @@ bool TupleValue::greater(const Value& other) const {
 
     for (size_t i = 0; i < minSize; ++i) {
 
-        if (items[i] == rhs[i]) {
+        if (items[i].itemEquals(rhs[i])) {
             continue;
         }
 
@@ -250,9 +316,7 @@ bool TupleValue::greater(const Value& other) const {
 Value TupleValue::add(const Value& other) const {
 
     if (!other.isTuple()) {
-        throw std::runtime_error(
-            "TypeError: can only concatenate tuple to tuple"
-        );
+        return Value::notImplemented();
     }
 
     std::vector<Value> result;
@@ -275,7 +339,7 @@ Value TupleValue::add(const Value& other) const {
     );
 
     return Value(
-        std::make_shared<TupleValue>(
+        makePooled<TupleValue>(
             std::move(result)
         )
     );
@@ -284,17 +348,13 @@ Value TupleValue::add(const Value& other) const {
 Value TupleValue::multiply(const Value& other) const {
 
     if (!other.isBigInt() && !other.isBool()) {
-        throw std::runtime_error(
-            "TypeError: can't multiply sequence by non-int"
-        );
+        return Value::notImplemented();
     }
 
     const auto count = other.toBigInt().convert_to<long long>();
 
     if (count <= 0) {
-        return Value(
-            std::make_shared<TupleValue>()
-        );
+        return empty();
     }
 
     std::vector<Value> result;
@@ -311,7 +371,7 @@ Value TupleValue::multiply(const Value& other) const {
     }
 
     return Value(
-        std::make_shared<TupleValue>(
+        makePooled<TupleValue>(
             std::move(result)
         )
     );
@@ -323,24 +383,39 @@ Value TupleValue::rmul(const Value& other) const {
 
 std::size_t TupleValue::hash() const {
 
-    std::size_t seed = 0;
+    if (cachedHash) {
+        return *cachedHash;
+    }
+
+    // схема xxHash из CPython: каждый хеш элемента проходит умножение и поворот,
+    // так что (1, 2) и (2, 1) расходятся, а для int-элементов результат совпадает с CPython
+    constexpr std::uint64_t prime1 = 11400714785074694791ULL;
+    constexpr std::uint64_t prime2 = 14029467366897019727ULL;
+    constexpr std::uint64_t prime5 = 2870177450012600261ULL;
 
-    for (const auto& item : items) {
+    // нехешируемый элемент бросает TypeError, и в кэш ничего не попадает
+    std::uint64_t acc = prime5;
 
-        seed ^= item.hash()
-            + 0x9e3779b9
-            + (seed << 6)
-            + (seed >> 2);
+    for (const auto& item : items) {
+        acc += static_cast<std::uint64_t>(item.hash()) * prime2;
+        acc = acc << 31 | acc >> 33;
+        acc *= prime1;
     }
 
-    return seed;
+    acc += items.size() ^ (prime5 ^ 3527539ULL);
+
+    const std::size_t hash = acc == static_cast<std::uint64_t>(-1) ? 1546275796 : static_cast<std::size_t>(acc);
+
+    cachedHash = hash;
+
+    return hash;
 }
 
 bool TupleValue::contains(const Value& value) const {
 
     for (const auto& item : items) {
 
-        if (item == value) {
+        if (item.itemEquals(value)) {
             return true;
         }
     }
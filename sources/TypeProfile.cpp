@@ -0,0 +1,323 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "TypeProfile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "Bytecode.h"
+#include "TokenCache.h"
+#include "VirtualMachine.h"
+
+namespace {
+
+/// 'CPYP' в порядке байт машины
+constexpr std::uint32_t profileMagic = 0x50595043;
+
+struct ProfileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t hash;
+    std::uint32_t codeCount;
+    std::uint32_t siteCount;
+};
+
+struct CodeRecord {
+    std::int32_t line;
+    /// 1 — байткод был горячим
+    std::uint32_t hot;
+    std::uint64_t shape;
+    std::uint32_t firstSite;
+    std::uint32_t siteCount;
+};
+
+struct SiteRecord {
+    std::uint32_t index;
+    std::uint8_t op;
+    std::uint8_t reserved[3];
+};
+
+static_assert(sizeof(ProfileHeader) == 24);
+static_assert(sizeof(CodeRecord) == 24);
+static_assert(sizeof(SiteRecord) == 8);
+
+/// строка начала и хеш инструкций в исходном виде
+using Key = std::pair<std::int32_t, std::uint64_t>;
+
+struct Feedback {
+    std::vector<std::pair<std::uint32_t, OpCode>> sites;
+    bool hot = false;
+};
+
+struct State {
+    QString sourcePath;
+    std::uint64_t hash = 0;
+    bool active = false;
+    std::map<Key, Feedback> loaded;
+    std::vector<std::pair<Key, std::weak_ptr<const CodeObject>>> live;
+};
+
+State& state() {
+    static State instance;
+    return instance;
+}
+
+bool isFast(const OpCode op) {
+    return op >= OpCode::BinaryOpInt && op <= OpCode::CompareOpFloat;
+}
+
+/// FNV-1a по коду операции и аргументам: тот же исходник даёт тот же хеш в любом запуске
+std::uint64_t shapeOf(const CodeObject& code) {
+
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+    const auto mix = [&hash](const std::uint32_t word) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash ^= (word >> shift) & 0xff;
+            hash *= 0x100000001b3ULL;
+        }
+    };
+
+    for (const Instruction& instr : code.code) {
+        mix(static_cast<std::uint32_t>(instr.op));
+        mix(static_cast<std::uint32_t>(instr.arg));
+        mix(static_cast<std::uint32_t>(instr.arg2));
+    }
+
+    return hash;
+}
+
+/// строка первой TraceLine; у байткода без трассировки — 0
+std::int32_t lineOf(const CodeObject& code) {
+
+    for (const Instruction& instr : code.code) {
+        if (instr.op == OpCode::TraceLine) {
+            return instr.arg;
+        }
+    }
+
+    return 0;
+}
+
+/// разбирает файл профиля; любое несоответствие — пустой профиль
+std::map<Key, Feedback> parse(const QByteArray& bytes, const std::uint64_t hash) {
+
+    if (bytes.size() < static_cast<qsizetype>(sizeof(ProfileHeader))) {
+        return {};
+    }
+
+    ProfileHeader header{};
+    std::memcpy(&header, bytes.constData(), sizeof(header));
+
+    const qint64 expectedSize = static_cast<qint64>(sizeof(ProfileHeader))
+        + static_cast<qint64>(header.codeCount) * static_cast<qint64>(sizeof(CodeRecord))
+        + static_cast<qint64>(header.siteCount) * static_cast<qint64>(sizeof(SiteRecord));
+
+    if (header.magic != profileMagic || header.version != TypeProfile::version ||
+        header.hash != hash || expectedSize != bytes.size()) {
+        return {};
+    }
+
+    const char* codes = bytes.constData() + sizeof(ProfileHeader);
+    const char* sites = codes + static_cast<qint64>(header.codeCount) * sizeof(CodeRecord);
+
+    std::map<Key, Feedback> profile;
+
+    for (std::uint32_t i = 0; i < header.codeCount; ++i) {
+
+        CodeRecord record{};
+        std::memcpy(&record, codes + static_cast<qint64>(i) * sizeof(CodeRecord), sizeof(record));
+
+        if (record.firstSite > header.siteCount || record.siteCount > header.siteCount - record.firstSite) {
+            return {};
+        }
+
+        Feedback& feedback = profile[{record.line, record.shape}];
+        feedback.hot = record.hot != 0;
+
+        for (std::uint32_t j = 0; j < record.siteCount; ++j) {
+
+            SiteRecord site{};
+            std::memcpy(&site, sites + static_cast<qint64>(record.firstSite + j) * sizeof(SiteRecord), sizeof(site));
+
+            feedback.sites.emplace_back(site.index, static_cast<OpCode>(site.op));
+        }
+    }
+
+    return profile;
+}
+
+}
+
+QString TypeProfile::profilePath(const QString& sourcePath) {
+
+    const QFileInfo info(sourcePath);
+
+    return info.absoluteDir().filePath("__pycache__/" + info.fileName() + ".prof");
+}
+
+void TypeProfile::open(const QString& sourcePath) {
+
+    QFile source(sourcePath);
+
+    if (!source.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QByteArray text = source.readAll();
+
+    State& current = state();
+    current.sourcePath = sourcePath;
+    current.hash = TokenCache::hashSource(text.constData(), text.size());
+    current.active = true;
+    current.live.clear();
+
+    QFile profile(profilePath(sourcePath));
+
+    current.loaded = profile.open(QIODevice::ReadOnly) ? parse(profile.readAll(), current.hash)
+                                                       : std::map<Key, Feedback>();
+}
+
+void TypeProfile::attach(const std::shared_ptr<const CodeObject>& code) {
+
+    State& current = state();
+
+    if (!current.active) {
+        return;
+    }
+
+    const Key key{lineOf(*code), shapeOf(*code)};
+    current.live.emplace_back(key, code);
+
+    const auto found = current.loaded.find(key);
+
+    if (found == current.loaded.end()) {
+        return;
+    }
+
+    for (const auto& [index, op] : found->second.sites) {
+        VirtualMachine::prespecialize(*code, index, op);
+    }
+
+    if (found->second.hot) {
+        VirtualMachine::preheat(*code);
+    }
+}
+
+/**
+ * Байткод с одинаковым ключом (одинаковые функции на одной строке) сливается в одну
+ * запись: для каждой инструкции остаётся первая встреченная быстрая форма.
+ * Файл заменяется атомарно через QSaveFile, как кэш токенов.
+ */
+void TypeProfile::save() {
+
+    State& current = state();
+
+    if (!current.active) {
+        return;
+    }
+
+    std::map<Key, Feedback> observed;
+
+    for (const auto& [key, weak] : current.live) {
+
+        const std::shared_ptr<const CodeObject> code = weak.lock();
+
+        if (!code) {
+            continue;
+        }
+
+        Feedback& feedback = observed[key];
+        feedback.hot = feedback.hot || code->heat >= VirtualMachine::hotThreshold;
+
+        for (std::size_t i = 0; i < code->code.size(); ++i) {
+
+            const OpCode op = code->code[i].op;
+            const auto index = static_cast<std::uint32_t>(i);
+
+            if (!isFast(op)) {
+                continue;
+            }
+
+            const bool known = std::any_of(feedback.sites.begin(), feedback.sites.end(),
+                                           [index](const auto& site) { return site.first == index; });
+
+            if (!known) {
+                feedback.sites.emplace_back(index, op);
+            }
+        }
+    }
+
+    QByteArray codes;
+    QByteArray sites;
+    std::uint32_t codeCount = 0;
+    std::uint32_t siteCount = 0;
+
+    for (const auto& [key, feedback] : observed) {
+
+        if (feedback.sites.empty() && !feedback.hot) {
+            continue;
+        }
+
+        CodeRecord record{};
+        record.line = key.first;
+        record.hot = feedback.hot ? 1 : 0;
+        record.shape = key.second;
+        record.firstSite = siteCount;
+        record.siteCount = static_cast<std::uint32_t>(feedback.sites.size());
+
+        codes.append(reinterpret_cast<const char*>(&record), sizeof(record));
+        ++codeCount;
+
+        for (const auto& [index, op] : feedback.sites) {
+
+            SiteRecord site{};
+            site.index = index;
+            site.op = static_cast<std::uint8_t>(op);
+
+            sites.append(reinterpret_cast<const char*>(&site), sizeof(site));
+            ++siteCount;
+        }
+    }
+
+    ProfileHeader header{};
+    header.magic = profileMagic;
+    header.version = version;
+    header.hash = current.hash;
+    header.codeCount = codeCount;
+    header.siteCount = siteCount;
+
+    const QString path = profilePath(current.sourcePath);
+
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return;
+    }
+
+    QSaveFile file(path);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QByteArray out;
+    out.reserve(static_cast<qsizetype>(sizeof(header)) + codes.size() + sites.size());
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(codes);
+    out.append(sites);
+
+    if (file.write(out) != out.size()) {
+        file.cancelWriting();
+        return;
+    }
+
+    file.commit();
+}
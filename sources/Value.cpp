@@ -1,9 +1,13 @@
 #include "Value.h"
 
+#include "PackedValue.h"
+#include "BigIntText.h"
 #include "BoundMethod.h"
 #include "ByteArrayValue.h"
+#include "CachedFunctionValue.h"
 #include "BytesIterator.h"
 #include "BytesValue.h"
+#include "CallRuntime.h"
 #include "ClassMethodValue.h"
 #include "DictItemsIterator.h"
 #include "DictItemsView.h"
@@ -12,9 +16,16 @@
 #include "DictValue.h"
 #include "DictValuesIterator.h"
 #include "DictValuesView.h"
+#include "DictViewSetOps.h"
+#include "DequeValue.h"
 #include "FunctionValue.h"
+#include "InstanceValue.h"
+#include "IntMath.h"
+#include "IntOps.h"
 #include "ListIterator.h"
 #include "ListValue.h"
+#include "MemoryViewValue.h"
+#include "ObjectPool.h"
 #include "PropertyValue.h"
 #include "SetIterator.h"
 #include "SetValue.h"
@@ -28,13 +39,65 @@
 #include "ByteArrayIterator.h"
 
 #include <QDebug>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
 
 #include "FrozenSetIterator.h"
 #include "FrozenSetValue.h"
+#include "RangeValue.h"
 
-Value::Value(const QString& str) : data(std::make_shared<StrValue>(str)) {}
+Value::Value(const BigInt& integer) {
 
-Value::Value(const char *str) : data(std::make_shared<StrValue>(str)) {}
+    if (integer >= std::numeric_limits<SmallInt>::min() &&
+        integer <= std::numeric_limits<SmallInt>::max()) {
+
+        data = integer.convert_to<SmallInt>();
+    }
+    else {
+        data = std::make_shared<BigInt>(integer);
+    }
+}
+
+Value::Value(const QString& str) : data(makePooled<StrValue>(str)) {}
+
+Value::Value(const char *str) : data(makePooled<StrValue>(str)) {}
+
+namespace {
+
+class NotImplementedValue final : public ObjectValue {
+public:
+    [[nodiscard]] QString toString() const override {
+        return "NotImplemented";
+    }
+
+    [[nodiscard]] QString repr() const override {
+        return toString();
+    }
+};
+
+const Value::ObjectPtr& notImplementedObject() {
+    static const Value::ObjectPtr object = std::make_shared<NotImplementedValue>();
+    return object;
+}
+
+}
+
+Value Value::notImplemented() {
+
+    Value value;
+    value.data = notImplementedObject();
+
+    return value;
+}
+
+bool Value::isNotImplemented() const {
+
+    const auto object = std::get_if<ObjectPtr>(&data);
+
+    return object && *object == notImplementedObject();
+}
 
 /**
  * Преобразует экземпляр `Value` в его строковое представление в зависимости от его типа.
@@ -58,12 +121,20 @@ QString Value::toString() const {
     return std::visit(
         overloaded{
 
-            [](const BigInt& v) {
-                return QString::fromStdString(v.convert_to<std::string>());
+            [](const SmallInt v) {
+                return QString::number(v);
             },
 
-            [](const BigFloat& v) {
-                return formatFloat(v);
+            [](const BigIntPtr& v) {
+                return QString::fromStdString(BigIntText::toString(*v));
+            },
+
+            [](const Float v) {
+                return formatDouble(v);
+            },
+
+            [](const BigFloatPtr& v) {
+                return formatFloat(*v);
             },
 
             [](const bool v) {
@@ -162,6 +233,10 @@ QString Value::toString() const {
                 return p->toString();
             },
 
+            [](const RangePtr& p) {
+                return p->toString();
+            },
+
             [](std::monostate) {
                 return QString("None");
             }
@@ -213,6 +288,10 @@ QString Value::repr() const {
         return std::get<ByteArrayPtr>(data)->repr();
     }
 
+    if (isInstance()) {
+        return std::get<InstancePtr>(data)->repr();
+    }
+
     return toString();
 }
 
@@ -235,12 +314,20 @@ QString Value::repr() const {
  */
 bool Value::toBool() const {
 
+    if (isSmallInt()) {
+        return std::get<SmallInt>(data) != 0;
+    }
+
     if (isBigInt()) {
-        return std::get<BigInt>(data) != 0;
+        return *std::get<BigIntPtr>(data) != 0;
     }
 
-    if (isBigFloat()) {
-        return std::get<BigFloat>(data) != 0.0;
+    if (isDouble()) {
+        return std::get<Float>(data) != 0.0;
+    }
+
+    if (isDecimal()) {
+        return *std::get<BigFloatPtr>(data) != 0.0;
     }
 
     if (std::holds_alternative<bool>(data)) {
@@ -303,6 +390,22 @@ bool Value::toBool() const {
         return std::get<ClassMethodPtr>(data) != nullptr;
     }
 
+    if (isRange()) {
+        return !std::get<RangePtr>(data)->empty();
+    }
+
+    if (const DequeValue* deque = DequeValue::of(*this)) {
+        return deque->len() != 0;
+    }
+
+    if (const PackedValue* array = PackedValue::of(*this)) {
+        return array->len() != 0;
+    }
+
+    if (isNotImplemented()) {
+        return true;
+    }
+
     throw std::runtime_error("Unsupported type");
 }
 
@@ -320,12 +423,20 @@ bool Value::toBool() const {
  * @throws std::runtime_error если преобразование невозможно.
  */
 Value::BigFloat Value::toBigFloat() const {
-    if (std::holds_alternative<BigInt>(data)) {
-        return BigFloat(std::get<BigInt>(data));
+    if (std::holds_alternative<SmallInt>(data)) {
+        return BigFloat(std::get<SmallInt>(data));
+    }
+
+    if (std::holds_alternative<BigIntPtr>(data)) {
+        return BigFloat(*std::get<BigIntPtr>(data));
     }
 
-    if (std::holds_alternative<BigFloat>(data)) {
-        return std::get<BigFloat>(data);
+    if (std::holds_alternative<Float>(data)) {
+        return BigFloat(std::get<Float>(data));
+    }
+
+    if (std::holds_alternative<BigFloatPtr>(data)) {
+        return *std::get<BigFloatPtr>(data);
     }
 
     if (std::holds_alternative<bool>(data)) {
@@ -335,49 +446,238 @@ Value::BigFloat Value::toBigFloat() const {
     throw std::runtime_error("Cannot convert to double");
 }
 
+Value::Float Value::toDouble() const {
+
+    if (std::holds_alternative<Float>(data)) {
+        return std::get<Float>(data);
+    }
+
+    if (std::holds_alternative<SmallInt>(data)) {
+        return static_cast<Float>(std::get<SmallInt>(data));
+    }
+
+    if (std::holds_alternative<BigIntPtr>(data)) {
+        return std::get<BigIntPtr>(data)->convert_to<Float>();
+    }
+
+    if (std::holds_alternative<BigFloatPtr>(data)) {
+        return std::get<BigFloatPtr>(data)->convert_to<Float>();
+    }
+
+    if (std::holds_alternative<bool>(data)) {
+        return std::get<bool>(data) ? 1.0 : 0.0;
+    }
+
+    throw std::runtime_error("Cannot convert to double");
+}
+
 Value::BigInt Value::toBigInt() const {
 
-    if (std::holds_alternative<BigInt>(data))
-        return std::get<BigInt>(data);
+    if (std::holds_alternative<SmallInt>(data))
+        return BigInt(std::get<SmallInt>(data));
+
+    if (std::holds_alternative<BigIntPtr>(data))
+        return *std::get<BigIntPtr>(data);
 
     if (std::holds_alternative<bool>(data))
         return std::get<bool>(data) ? BigInt(1) : BigInt(0);
 
     // сюда лучше не попадать, но на всякий:
-    return BigInt(std::get<BigFloat>(data));
+    if (std::holds_alternative<Float>(data))
+        return BigInt(std::get<Float>(data));
+
+    return BigInt(*std::get<BigFloatPtr>(data));
 }
 
 bool Value::isNone() const {
     return std::holds_alternative<std::monostate>(data);;
 }
 
+/**
+ * Операция над двумя числами выполняется в «старшем» из типов операндов:
+ * decimal (BigFloat), затем float (double), иначе — в целых.
+ */
 template<typename Op>
-    static bool applyComparison(const Value &l, const Value &r, const bool isFloat, Op operation) {
-    return isFloat
-    ? operation(l.toBigFloat(), r.toBigFloat())
-    : operation(l.toBigInt(), r.toBigInt());
+    static bool applyComparison(const Value &l, const Value &r, Op operation) {
+
+    if (l.isDecimal() || r.isDecimal())
+        return operation(l.toBigFloat(), r.toBigFloat());
+
+    if (l.isDouble() || r.isDouble())
+        return operation(l.toDouble(), r.toDouble());
+
+    return operation(l.toBigInt(), r.toBigInt());
 }
 
 template<typename Op>
-    static Value applyCalculation(const Value &l, const Value &r, const bool isFloat, Op operation) {
-    return isFloat
-    ? Value(operation(l.toBigFloat(), r.toBigFloat()))
-    : Value(operation(l.toBigInt(), r.toBigInt()));
+    static Value applyCalculation(const Value &l, const Value &r, Op operation) {
+
+    if (l.isDecimal() || r.isDecimal())
+        return Value(Value::BigFloat(operation(l.toBigFloat(), r.toBigFloat())));
+
+    if (l.isDouble() || r.isDouble())
+        return Value(Value::Float(operation(l.toDouble(), r.toDouble())));
+
+    return Value(Value::BigInt(operation(l.toBigInt(), r.toBigInt())));
+}
+
+/**
+ * Быстрый путь для двух целых, помещающихся в машинное слово: извлекает оба значения
+ * без преобразования в boost::cpp_int.
+ */
+static bool bothSmall(const Value &l, const Value &r, Value::SmallInt &a, Value::SmallInt &b) {
+
+    const auto pa = std::get_if<Value::SmallInt>(&l.data);
+    const auto pb = std::get_if<Value::SmallInt>(&r.data);
+
+    if (!pa || !pb) {
+        return false;
+    }
+
+    a = *pa;
+    b = *pb;
+    return true;
+}
+
+/// обе строки: сравнение идёт прямо по тексту, без перебора вариантов и виртуальных вызовов
+static bool bothStrings(const Value &l, const Value &r, const StrValue *&a, const StrValue *&b) {
+
+    const auto pa = std::get_if<Value::StrPtr>(&l.data);
+    const auto pb = std::get_if<Value::StrPtr>(&r.data);
+
+    if (!pa || !pb) {
+        return false;
+    }
+
+    a = pa->get();
+    b = pb->get();
+    return true;
+}
+
+template<typename T>
+struct IsSharedPtr : std::false_type {};
+
+template<typename T>
+struct IsSharedPtr<std::shared_ptr<T>> : std::true_type {};
+
+/// оба значения держат один и тот же объект по указателю
+static bool sameReference(const Value &l, const Value &r) {
+
+    if (l.data.index() != r.data.index()) {
+        return false;
+    }
+
+    return std::visit([&r](const auto& held) {
+
+        using Held = std::decay_t<decltype(held)>;
+
+        if constexpr (IsSharedPtr<Held>::value) {
+            return held.get() == std::get<Held>(r.data).get();
+        } else {
+            return false;
+        }
+    }, l.data);
+}
+
+using ObjectOperation = Value (ObjectValue::*)(const Value&) const;
+
+/// встроенный объект операнда: и с собственной альтернативой в variant, и без неё (array)
+static ObjectValue* binaryOperand(const Value& value) {
+
+    if (value.isObject()) {
+        return value.asObject().get();
+    }
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? object->get() : nullptr;
+}
+
+/**
+ * Бинарная операция по протоколу NotImplemented: прямой метод левого операнда, затем
+ * отражённый метод правого. У экземпляров пользовательских классов вызываются
+ * dunder-методы (`__add__`, `__radd__`...). Неподдерживаемая комбинация типов
+ * определяется по возвращённому NotImplemented, без исключений, и заканчивается TypeError.
+ */
+static Value dispatchBinary(const Value& l, const Value& r,
+                            const ObjectOperation direct, const ObjectOperation reflected,
+                            const QString& dunder, const QString& reflectedDunder,
+                            const char* symbol) {
+
+    if (ObjectValue* object = binaryOperand(l)) {
+        if (Value result = (object->*direct)(r); !result.isNotImplemented()) {
+            return result;
+        }
+    } else if (l.isInstance()) {
+        if (Value result = callOperatorMethod(l, dunder, r); !result.isNotImplemented()) {
+            return result;
+        }
+    }
+
+    if (ObjectValue* object = binaryOperand(r)) {
+        if (Value result = (object->*reflected)(l); !result.isNotImplemented()) {
+            return result;
+        }
+    } else if (r.isInstance() && !(l.isInstance() && l.asInstance()->klass == r.asInstance()->klass)) {
+        // как в Python: для операндов одного класса отражённый метод не вызывается
+        if (Value result = callOperatorMethod(r, reflectedDunder, l); !result.isNotImplemented()) {
+            return result;
+        }
+    }
+
+    // dict_keys и dict_items не ObjectValue: их операции множеств разбираются здесь, в обе стороны
+    if (std::optional<Value> result = dictviews::binary(l, r, symbol)) {
+        return std::move(*result);
+    }
+
+    throw std::runtime_error(std::string("TypeError: unsupported operand type(s) for ") + symbol + ": "
+        + l.toString().toStdString() + " " + " " + r.toString().toStdString());
 }
 
 bool Value::operator==(const Value& other) const {
 
-    if (isNumeric() && other.isNumeric()) {
+    if (SmallInt a, b; bothSmall(*this, other, a, b)) {
+        return a == b;
+    }
+
+    if (const StrValue *a, *b; bothStrings(*this, other, a, b)) {
+        return a->sameText(*b);
+    }
+
+    // кортеж равен себе сразу; иначе поэлементно, тоже с тождеством элементов
+    const auto* leftTuple = std::get_if<TuplePtr>(&data);
+    const auto* rightTuple = std::get_if<TuplePtr>(&other.data);
 
-        const bool isFloat = isBigFloat() || other.isBigFloat();
+    if (leftTuple && rightTuple) {
+        return *leftTuple == *rightTuple || (*leftTuple)->equal(other);
+    }
+
+    if (isNumeric() && other.isNumeric()) {
 
-        return applyComparison(*this, other, isFloat, std::equal_to<>());
+        return applyComparison(*this, other, std::equal_to<>());
     }
 
     if (isNone() && other.isNone()) {
         return true;
     }
 
+    // memoryview равен bytes-подобному объекту с теми же элементами при любом порядке операндов
+    if (const MemoryViewValue* view = MemoryViewValue::of(*this)) {
+        return view->equal(other);
+    }
+
+    if (const MemoryViewValue* view = MemoryViewValue::of(other)) {
+        return view->equal(*this);
+    }
+
+    if (const DequeValue* deque = DequeValue::of(*this)) {
+        return deque->equal(other);
+    }
+
+    if (const PackedValue* array = PackedValue::of(*this)) {
+        return array->equal(other);
+    }
+
     if (isObject()) {
         try {
             return asObject()->equal(other);
@@ -390,12 +690,18 @@ bool Value::operator==(const Value& other) const {
 
 bool Value::operator<(const Value& other) const {
 
+    if (SmallInt a, b; bothSmall(*this, other, a, b)) {
+        return a < b;
+    }
+
+    if (const StrValue *a, *b; bothStrings(*this, other, a, b)) {
+        return a->view() < b->view();
+    }
+
     // numeric comparison
     if (isNumeric() && other.isNumeric()) {
 
-        const bool isFloat = isBigFloat() || other.isBigFloat();
-
-        return applyComparison(*this, other, isFloat, std::less<>());
+        return applyComparison(*this, other, std::less<>());
     }
 
     if (isBytes() && other.isBytes()) {
@@ -416,11 +722,21 @@ bool Value::operator<(const Value& other) const {
 
 bool Value::operator!=(const Value &other) const {
 
+    if (SmallInt a, b; bothSmall(*this, other, a, b)) {
+        return a != b;
+    }
+
+    if (const StrValue *a, *b; bothStrings(*this, other, a, b)) {
+        return !a->sameText(*b);
+    }
+
     if (isNumeric() && other.isNumeric()) {
 
-        const bool isFloat = isBigFloat() || other.isBigFloat();
+        return applyComparison(*this, other, std::not_equal_to<>());
+    }
 
-        return applyComparison(*this, other, isFloat, std::not_equal_to<>());
+    if (MemoryViewValue::of(*this) || MemoryViewValue::of(other) || DequeValue::of(*this) || PackedValue::of(*this)) {
+        return !(*this == other);
     }
 
     if (isObject()) {
@@ -436,11 +752,17 @@ bool Value::operator!=(const Value &other) const {
 
 bool Value::operator<=(const Value &other) const {
 
-    if (isNumeric() && other.isNumeric()) {
+    if (SmallInt a, b; bothSmall(*this, other, a, b)) {
+        return a <= b;
+    }
 
-        const bool isFloat = isBigFloat() || other.isBigFloat();
+    if (const StrValue *a, *b; bothStrings(*this, other, a, b)) {
+        return a->view() <= b->view();
+    }
 
-        return applyComparison(*this, other, isFloat, std::less_equal<>());
+    if (isNumeric() && other.isNumeric()) {
+
+        return applyComparison(*this, other, std::less_equal<>());
     }
 
     if (isObject()) {
@@ -456,11 +778,17 @@ bool Value::operator<=(const Value &other) const {
 
 bool Value::operator>(const Value &other) const {
 
-    if (isNumeric() && other.isNumeric()) {
+    if (SmallInt a, b; bothSmall(*this, other, a, b)) {
+        return a > b;
+    }
 
-        const bool isFloat = isBigFloat() || other.isBigFloat();
+    if (const StrValue *a, *b; bothStrings(*this, other, a, b)) {
+        return a->view() > b->view();
+    }
 
-        return applyComparison(*this, other, isFloat, std::greater<>());
+    if (isNumeric() && other.isNumeric()) {
+
+        return applyComparison(*this, other, std::greater<>());
     }
 
     if (isObject()) {
@@ -476,9 +804,15 @@ bool Value::operator>(const Value &other) const {
 
 bool Value::operator>=(const Value &other) const {
 
-    if (isNumeric() && other.isNumeric()) {
-        const bool isFloat = isBigFloat() || other.isBigFloat();
-        return applyComparison(*this, other, isFloat, std::greater_equal<>());
+    if (SmallInt a, b; bothSmall(*this, other, a, b)) {
+        return a >= b;
+    }
+
+    if (const StrValue *a, *b; bothStrings(*this, other, a, b)) {
+        return a->view() >= b->view();
+    }
+
+    if (isNumeric() && other.isNumeric()) {        return applyComparison(*this, other, std::greater_equal<>());
     }
 
     if (isObject()) {
@@ -494,59 +828,32 @@ bool Value::operator>=(const Value &other) const {
 
 Value Value::operator+(const Value& other) const {
 
-    if (isNumeric() && other.isNumeric()) {
-
-        const bool isFloat = isBigFloat() || other.isBigFloat();
-
-        return applyCalculation(*this, other, isFloat, std::plus<>());
-    }
-
-    if (isObject()) {
-        try {
-            return asObject()->add(other);
-        }
-        catch (...) {}
+    if (SmallInt a, b, result; bothSmall(*this, other, a, b) &&
+        !intops::addOverflow(a, b, result)) {
+        return Value(result);
     }
 
-    if (other.isObject()) {
+    if (isNumeric() && other.isNumeric()) {
 
-        try {
-            return other.asObject()->radd(*this);
-        }
-        catch (...) {}
+        return applyCalculation(*this, other, std::plus<>());
     }
 
-    throw std::runtime_error("TypeError: unsupported operand type(s) for +: "
-        + toString().toStdString() + " " + " " + other.toString().toStdString());
-
+    return dispatchBinary(*this, other, &ObjectValue::add, &ObjectValue::radd, "__add__", "__radd__", "+");
 }
 
 Value Value::operator-(const Value &other) const {
 
-    if (isNumeric() && other.isNumeric()) {
-
-        const bool isFloat = isBigFloat() || other.isBigFloat();
-
-        return applyCalculation(*this, other, isFloat, std::minus<>());
-    }
-
-    if (isObject()) {
-        try {
-            return asObject()->sub(other);
-        }
-        catch (...) {}
+    if (SmallInt a, b, result; bothSmall(*this, other, a, b) &&
+        !intops::subOverflow(a, b, result)) {
+        return Value(result);
     }
 
-    if (other.isObject()) {
+    if (isNumeric() && other.isNumeric()) {
 
-        try {
-            return other.asObject()->rsub(*this);
-        }
-        catch (...) {}
+        return applyCalculation(*this, other, std::minus<>());
     }
 
-    throw std::runtime_error("TypeError: unsupported operand type(s) for -: "
-        + toString().toStdString() + " " + " " + other.toString().toStdString());
+    return dispatchBinary(*this, other, &ObjectValue::sub, &ObjectValue::rsub, "__sub__", "__rsub__", "-");
 }
 
 bool Value::isObject() const {
@@ -558,7 +865,8 @@ bool Value::isObject() const {
         || isTuple()
         || isDict()
         || isSet()
-        || isFrozenSet();
+        || isFrozenSet()
+        || isRange();
 }
 
 Value::ObjectPtr Value::asObject() const {
@@ -595,6 +903,10 @@ Value::ObjectPtr Value::asObject() const {
         return std::static_pointer_cast<ObjectValue>(asFrozenSet());
     }
 
+    if (isRange()) {
+        return std::static_pointer_cast<ObjectValue>(asRange());
+    }
+
     throw std::runtime_error(
         "Value is not an object"
     );
@@ -614,114 +926,146 @@ Value::FrozenSetPtr Value::asFrozenSet(const QString &) const {
 
 }
 
-Value Value::operator*(const Value &other) const {
-
-    if (isNumeric() && other.isNumeric()) {
+bool Value::isRange() const {
+    return std::holds_alternative<RangePtr>(data);
+}
 
-        const bool isFloat = isBigFloat() || other.isBigFloat();
+Value::RangePtr Value::asRange() const {
 
-        return applyCalculation(*this, other, isFloat, std::multiplies<>());
+    if (!isRange()) {
+        throw std::runtime_error("Value is not a range");
     }
 
+    return std::get<RangePtr>(data);
+}
 
-    if (isObject()) {
-        try {
-            return asObject()->multiply(other);
-        }
-        catch (...) {}
+Value Value::operator*(const Value &other) const {
+
+    if (SmallInt a, b, result; bothSmall(*this, other, a, b) &&
+        !intops::mulOverflow(a, b, result)) {
+        return Value(result);
     }
 
-    if (other.isObject()) {
+    if (isNumeric() && other.isNumeric()) {
 
-        try {
-            return other.asObject()->rmul(*this);
-        }
-        catch (...) {}
+        return applyCalculation(*this, other, std::multiplies<>());
     }
 
-    throw std::runtime_error("TypeError: unsupported operand type(s) for *: "
-        + toString().toStdString() + " " + " " + other.toString().toStdString());
+    return dispatchBinary(*this, other, &ObjectValue::multiply, &ObjectValue::rmul, "__mul__", "__rmul__", "*");
 }
 
 Value Value::operator/(const Value &other) const {
 
     if (isNumeric() && other.isNumeric()) {
 
-        const BigFloat r = other.toBigFloat();
+        if (isDecimal() || other.isDecimal()) {
+
+            const BigFloat r = other.toBigFloat();
+
+            if (r == 0) {
+                throw std::runtime_error("ZeroDivisionError: division by zero");
+            }
+
+            return Value(BigFloat(toBigFloat() / r));
+        }
+
+        const Float r = other.toDouble();
 
         if (r == 0) {
-            throw std::runtime_error("ArithmeticError: Division by zero");
+            throw std::runtime_error(isDouble() || other.isDouble()
+                ? "ZeroDivisionError: float division by zero"
+                : "ZeroDivisionError: division by zero");
         }
 
-        return Value(toBigFloat() / r);
+        return Value(toDouble() / r);
     }
 
-    throw std::runtime_error("TypeError: unsupported operand type(s) for /: "
-        + toString().toStdString() + " " + " " + other.toString().toStdString());
+    return dispatchBinary(*this, other, &ObjectValue::truediv, &ObjectValue::rtruediv, "__truediv__", "__rtruediv__", "/");
 }
 
 Value Value::operator%(const Value &other) const {
 
-    if (isNumeric() && other.isNumeric()) {
+    if (SmallInt a, b; bothSmall(*this, other, a, b) && b != 0 && b != -1) {
 
-        const auto rf = other.toBigFloat();
+        // знак остатка совпадает со знаком делителя, как в Python
+        SmallInt remainder = a % b;
 
-        if (rf == 0) {
-            throw std::runtime_error("ArithmeticError: Division by zero");
+        if (remainder != 0 && (remainder < 0) != (b < 0)) {
+            remainder += b;
         }
 
+        return Value(remainder);
+    }
+
+    if (isNumeric() && other.isNumeric()) {
+
         if (!isBigFloat() && !other.isBigFloat()) {
-            return Value(toBigInt() % other.toBigInt());
+
+            const BigInt r = other.toBigInt();
+
+            if (r == 0) {
+                throw std::runtime_error("ZeroDivisionError: integer modulo by zero");
+            }
+
+            return IntMath::divMod(*this, other).second;
         }
 
-        const BigFloat lf = toBigFloat();
+        if (!isDecimal() && !other.isDecimal()) {
 
-        const BigFloat quotient = floor(lf / rf);
-        const BigFloat remainder = lf - rf * quotient;
+            const Float r = other.toDouble();
 
-        return Value(remainder);
-    }
+            if (r == 0) {
+                throw std::runtime_error("ZeroDivisionError: float modulo");
+            }
 
-    if (isObject()) {
-        try {
-            return asObject()->mod(other);
+            // знак остатка совпадает со знаком делителя, как в Python
+            Float remainder = std::fmod(toDouble(), r);
+
+            if (remainder != 0) {
+                if ((remainder < 0) != (r < 0)) {
+                    remainder += r;
+                }
+            } else {
+                remainder = std::copysign(0.0, r);
+            }
+
+            return Value(remainder);
         }
-        catch (...) {}
-    }
 
-    if (other.isObject()) {
+        const auto rf = other.toBigFloat();
 
-        try {
-            return other.asObject()->rmod(*this);
+        if (rf == 0) {
+            throw std::runtime_error("ZeroDivisionError: division by zero");
         }
-        catch (...) {}
+
+        const BigFloat lf = toBigFloat();
+
+        const BigFloat quotient = floor(lf / rf);
+        const BigFloat remainder = lf - rf * quotient;
+
+        return Value(BigFloat(remainder));
     }
 
-    throw std::runtime_error("TypeError: unsupported operand type(s) for %: "
-        + toString().toStdString() + " " + " " + other.toString().toStdString());
+    return dispatchBinary(*this, other, &ObjectValue::mod, &ObjectValue::rmod, "__mod__", "__rmod__", "%");
 }
 
 Value Value::power(const Value& other) const {
 
     if (isNumeric() && other.isNumeric()) {
 
-        if (isBigFloat() || other.isBigFloat()) {
-            return Value(pow(toBigFloat(), other.toBigFloat()));
+        if (isDecimal() || other.isDecimal()) {
+            return Value(BigFloat(pow(toBigFloat(), other.toBigFloat())));
         }
 
-        const auto base = toBigInt();
-        const auto exp  = other.toBigInt();
-
-        if (exp < 0) {
-            return Value(pow(toBigFloat(), other.toBigFloat()));
+        if (isDouble() || other.isDouble()) {
+            return Value(std::pow(toDouble(), other.toDouble()));
         }
 
-        BigInt result = 1;
-
-        for (BigInt i = 0; i < exp; ++i)
-            result *= base;
+        if (other.toBigInt() < 0) {
+            return Value(std::pow(toDouble(), other.toDouble()));
+        }
 
-        return Value(result);
+        return IntMath::power(*this, other);
     }
 
     throw std::runtime_error("TypeError: unsupported operand type(s) for **: "
@@ -730,21 +1074,76 @@ Value Value::power(const Value& other) const {
 
 Value Value::intDivide(const Value& other) const {
 
+    if (SmallInt a, b; bothSmall(*this, other, a, b) && b != 0 && b != -1) {
+
+        SmallInt quotient = a / b;
+
+        // округление к минус бесконечности, как в Python
+        if (a % b != 0 && (a < 0) != (b < 0)) {
+            --quotient;
+        }
+
+        return Value(quotient);
+    }
+
     if (isNumeric() && other.isNumeric()) {
 
+        if (!isBigFloat() && !other.isBigFloat()) {
+
+            const BigInt l = toBigInt();
+            const BigInt r = other.toBigInt();
+
+            if (r == 0) {
+                throw std::runtime_error("ZeroDivisionError: integer division or modulo by zero");
+            }
+
+            BigInt quotient = l / r;
+
+            if (quotient * r != l && (l < 0) != (r < 0)) {
+                --quotient;
+            }
+
+            return Value(quotient);
+        }
+
+        if (!isDecimal() && !other.isDecimal()) {
+
+            const Float l = toDouble();
+            const Float r = other.toDouble();
+
+            if (r == 0) {
+                throw std::runtime_error("ZeroDivisionError: float floor division by zero");
+            }
+
+            // деление через остаток, как float_floor_div в CPython
+            const Float mod = std::fmod(l, r);
+            Float div = (l - mod) / r;
+
+            if (mod != 0 && (r < 0) != (mod < 0)) {
+                div -= 1.0;
+            }
+
+            if (div == 0) {
+                return Value(std::copysign(0.0, l / r));
+            }
+
+            Float floorDiv = std::floor(div);
+
+            if (div - floorDiv > 0.5) {
+                floorDiv += 1.0;
+            }
+
+            return Value(floorDiv);
+        }
+
         const BigFloat lf = toBigFloat();
         const BigFloat rf = other.toBigFloat();
 
         if (rf == 0) {
-            throw std::runtime_error("ArithmeticError: Division by zero");
+            throw std::runtime_error("ZeroDivisionError: division by zero");
         }
 
-        const BigFloat result = floor(lf / rf);
-
-        return isBigFloat() || other.isBigFloat()
-        ? Value(result)
-        : Value(BigInt(result));
-
+        return Value(BigFloat(floor(lf / rf)));
     }
 
     throw std::runtime_error("TypeError: unsupported operand type(s) for //: "
@@ -812,9 +1211,15 @@ bool Value::is(const Value& other) const {
     if (data.index() != other.data.index())
         return false;
 
+    if (isSmallInt())
+        return std::get<SmallInt>(data) == std::get<SmallInt>(other.data);
+
     if (isBigInt())
         return toBigInt() == other.toBigInt();
 
+    if (isDouble())
+        return std::get<Float>(data) == std::get<Float>(other.data);
+
     if (isBigFloat())
         return toBigFloat() == other.toBigFloat();
 
@@ -842,6 +1247,10 @@ bool Value::is(const Value& other) const {
         return asFrozenSet().get() == other.asFrozenSet().get();
     }
 
+    if (isRange()) {
+        return asRange().get() == other.asRange().get();
+    }
+
     if (isFunction()) {
         return asFunction().get() == other.asFunction().get();
     }
@@ -894,6 +1303,10 @@ bool Value::is(const Value& other) const {
         return asSet().get() == other.asSet().get();
     }
 
+    if (const auto object = std::get_if<ObjectPtr>(&data)) {
+        return object->get() == std::get<ObjectPtr>(other.data).get();
+    }
+
     if (isIterable()) {
         return getIterator() == other.getIterator();
     }
@@ -922,12 +1335,20 @@ Value Value::operator+() const {
 
 Value Value::operator-() const {
 
+    if (isSmallInt() && std::get<SmallInt>(data) != std::numeric_limits<SmallInt>::min()) {
+        return Value(SmallInt(-std::get<SmallInt>(data)));
+    }
+
     if (isBigInt()) {
         return Value(-toBigInt());
     }
 
+    if (isDouble()) {
+        return Value(-std::get<Float>(data));
+    }
+
     if (isBigFloat()) {
-        return Value(-toBigFloat());
+        return Value(BigFloat(-toBigFloat()));
     }
 
     if (isBool()) {
@@ -948,6 +1369,14 @@ bool Value::contains(const Value &value) const {
         catch (...) {}
     }
 
+    if (const DequeValue* deque = DequeValue::of(*this)) {
+        return deque->contains(value);
+    }
+
+    if (const PackedValue* array = PackedValue::of(*this)) {
+        return array->contains(value);
+    }
+
     throw std::runtime_error("TypeError: argument of type '" +
        toString().toStdString() + "' is not iterable"
     );
@@ -955,65 +1384,17 @@ bool Value::contains(const Value &value) const {
 
 Value Value::operator|(const Value& other) const {
 
-    if (isObject()) {
-        try {
-            return asObject()->bitOr(other);
-        }
-        catch (...) {}
-    }
-
-    if (other.isObject()) {
-
-        try {
-            return other.asObject()->ror(*this);
-        }
-        catch (...) {}
-    }
-
-    throw std::runtime_error("TypeError: unsupported operand type(s) for |: "
-        + toString().toStdString() + " " + " " + other.toString().toStdString());
+    return dispatchBinary(*this, other, &ObjectValue::bitOr, &ObjectValue::ror, "__or__", "__ror__", "|");
 }
 
 Value Value::operator&(const Value& other) const {
 
-    if (isObject()) {
-        try {
-            return asObject()->bitAnd(other);
-        }
-        catch (...) {}
-    }
-
-    if (other.isObject()) {
-
-        try {
-            return other.asObject()->rand(*this);
-        }
-        catch (...) {}
-    }
-
-    throw std::runtime_error("TypeError: unsupported operand type(s) for &: "
-        + toString().toStdString() + " " + " " + other.toString().toStdString());
+    return dispatchBinary(*this, other, &ObjectValue::bitAnd, &ObjectValue::rand, "__and__", "__rand__", "&");
 }
 
 Value Value::operator^(const Value& other) const {
 
-    if (isObject()) {
-        try {
-            return asObject()->bitXor(other);
-        }
-        catch (...) {}
-    }
-
-    if (other.isObject()) {
-
-        try {
-            return other.asObject()->rxor(*this);
-        }
-        catch (...) {}
-    }
-
-    throw std::runtime_error("TypeError: unsupported operand type(s) for &: "
-        + toString().toStdString() + " " + " " + other.toString().toStdString());
+    return dispatchBinary(*this, other, &ObjectValue::bitXor, &ObjectValue::rxor, "__xor__", "__rxor__", "^");
 }
 
 Value& Value::operator|=(const Value& other) {
@@ -1095,13 +1476,92 @@ QString Value::formatFloat(const BigFloat& num) {
     return QString::fromStdString(s);
 }
 
+/**
+ * Кратчайшее представление double, которое читается обратно в то же число
+ * (repr(float) в CPython): фиксированная запись для порядков [-4, 16),
+ * иначе экспоненциальная с минимум двумя цифрами порядка.
+ */
+QString Value::formatDouble(const Float num) {
+
+    if (std::isnan(num)) {
+        return "nan";
+    }
+
+    if (std::isinf(num)) {
+        return num > 0 ? "inf" : "-inf";
+    }
+
+    if (num == 0) {
+        return std::signbit(num) ? "-0.0" : "0.0";
+    }
+
+    char buffer[32];
+
+    for (int precision = 1; precision <= 17; ++precision) {
+        std::snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, num);
+
+        if (std::strtod(buffer, nullptr) == num) {
+            break;
+        }
+    }
+
+    // buffer: [-]d[.ddd]e±XX
+    const std::string scientific(buffer);
+    const std::size_t ePos = scientific.find('e');
+    const bool negative = scientific[0] == '-';
+
+    std::string digits;
+
+    for (std::size_t i = negative ? 1 : 0; i < ePos; ++i) {
+        if (scientific[i] != '.') {
+            digits += scientific[i];
+        }
+    }
+
+    while (digits.size() > 1 && digits.back() == '0') {
+        digits.pop_back();
+    }
+
+    const int exponent = std::stoi(scientific.substr(ePos + 1));
+
+    std::string result = negative ? "-" : "";
+
+    if (exponent >= -4 && exponent < 16) {
+
+        if (exponent < 0) {
+            result += "0." + std::string(-exponent - 1, '0') + digits;
+        } else if (digits.size() <= static_cast<std::size_t>(exponent) + 1) {
+            result += digits + std::string(exponent + 1 - digits.size(), '0') + ".0";
+        } else {
+            result += digits.substr(0, exponent + 1) + "." + digits.substr(exponent + 1);
+        }
+    } else {
+
+        result += digits.substr(0, 1);
+
+        if (digits.size() > 1) {
+            result += "." + digits.substr(1);
+        }
+
+        char exponentBuffer[8];
+        std::snprintf(exponentBuffer, sizeof(exponentBuffer), "e%c%02d",
+            exponent < 0 ? '-' : '+', std::abs(exponent));
+
+        result += exponentBuffer;
+    }
+
+    return QString::fromStdString(result);
+}
+
 size_t qHash(const Value &value, const size_t seed) {
     return value.hash() ^ seed;
 }
 
 bool Value::isNumeric() const {
-    return std::holds_alternative<BigInt>(data) ||
-           std::holds_alternative<BigFloat>(data) ||
+    return std::holds_alternative<SmallInt>(data) ||
+           std::holds_alternative<BigIntPtr>(data) ||
+           std::holds_alternative<Float>(data) ||
+           std::holds_alternative<BigFloatPtr>(data) ||
            std::holds_alternative<bool>(data);
 }
 
@@ -1113,11 +1573,17 @@ bool Value::isCallable() const {
         std::holds_alternative<ClassPtr>(data) ||
         std::holds_alternative<BoundMethodPtr>(data) ||
         std::holds_alternative<StaticMethodPtr>(data) ||
-        std::holds_alternative<ClassMethodPtr>(data);
+        std::holds_alternative<ClassMethodPtr>(data) ||
+        CachedFunctionValue::of(*this);
 }
 
 bool Value::isBigInt() const {
-    return std::holds_alternative<BigInt>(data);
+    return std::holds_alternative<SmallInt>(data) ||
+           std::holds_alternative<BigIntPtr>(data);
+}
+
+bool Value::isSmallInt() const {
+    return std::holds_alternative<SmallInt>(data);
 }
 
 Value::BigInt Value::asBigInt(const QString& where) const {
@@ -1129,11 +1595,20 @@ Value::BigInt Value::asBigInt(const QString& where) const {
        );
     }
 
-    return std::get<BigInt>(data);
+    return toBigInt();
 }
 
 bool Value::isBigFloat() const {
-    return std::holds_alternative<BigFloat>(data);
+    return std::holds_alternative<Float>(data) ||
+           std::holds_alternative<BigFloatPtr>(data);
+}
+
+bool Value::isDouble() const {
+    return std::holds_alternative<Float>(data);
+}
+
+bool Value::isDecimal() const {
+    return std::holds_alternative<BigFloatPtr>(data);
 }
 
 Value::BigFloat Value::asBigFloat(const QString &) const {
@@ -1142,7 +1617,7 @@ Value::BigFloat Value::asBigFloat(const QString &) const {
         throw std::runtime_error("Value is not a float");
     }
 
-    return std::get<BigFloat>(data);
+    return toBigFloat();
 }
 
 bool Value::isList() const {
@@ -1422,28 +1897,159 @@ bool Value::isHashable() const {
     return false;
 }
 
+// Числовой хеш как в CPython: значение по модулю простого 2^61 - 1, так что
+// равные числа разных типов (1 == 1.0 == True) хешируются одинаково
+static constexpr std::uint64_t hashBits = 61;
+static constexpr std::uint64_t hashModulus = (std::uint64_t{1} << hashBits) - 1;
+static constexpr std::int64_t hashInf = 314159;
+
+// циклический сдвиг 61-битного остатка: умножение на 2^shift по модулю
+static std::uint64_t rotateHash(const std::uint64_t x, const unsigned shift) {
+
+    if (shift == 0) {
+        return x;
+    }
+
+    return ((x << shift) & hashModulus) | (x >> (hashBits - shift));
+}
+
+static std::size_t finishHash(const std::uint64_t magnitude, const bool negative) {
+
+    auto result = static_cast<std::int64_t>(magnitude);
+
+    if (negative) {
+        result = -result;
+    }
+
+    // -1 зарезервирован в CPython под ошибку
+    if (result == -1) {
+        result = -2;
+    }
+
+    return static_cast<std::size_t>(result);
+}
+
+static std::size_t hashSmallInt(const Value::SmallInt value) {
+
+    const bool negative = value < 0;
+    const std::uint64_t magnitude = negative
+        ? std::uint64_t{0} - static_cast<std::uint64_t>(value)
+        : static_cast<std::uint64_t>(value);
+
+    return finishHash(magnitude % hashModulus, negative);
+}
+
+// остаток считается прямо по лимбам числа, от старшего к младшему
+static std::size_t hashBigInt(const Value::BigInt& value) {
+
+#ifdef CPPYTHON_USE_GMP
+    using limb_type = mp_limb_t;
+
+    const mpz_srcptr number = value.backend().data();
+    const limb_type* limbs = mpz_limbs_read(number);
+    const std::size_t size = mpz_size(number);
+#else
+    using boost::multiprecision::limb_type;
+
+    const auto& backend = value.backend();
+    const limb_type* limbs = backend.limbs();
+    const std::size_t size = backend.size();
+#endif
+
+    constexpr unsigned limbBits = sizeof(limb_type) * 8;
+    constexpr unsigned limbShift = limbBits % hashBits;
+
+    std::uint64_t x = 0;
+
+    for (std::size_t i = size; i-- > 0;) {
+
+        const auto limb = static_cast<std::uint64_t>(limbs[i]);
+
+        x = rotateHash(x, limbShift) + (limb & hashModulus) + (limb >> hashBits);
+
+        // сумма трёх остатков меньше 3P
+        while (x >= hashModulus) {
+            x -= hashModulus;
+        }
+    }
+
+    return finishHash(x, value.sign() < 0);
+}
+
+// точный остаток двоичной дроби: мантисса по 28 бит, затем сдвиг на экспоненту
+static std::size_t hashDouble(const Value::Float value) {
+
+    if (std::isinf(value)) {
+        return static_cast<std::size_t>(value > 0 ? hashInf : -hashInf);
+    }
+
+    if (std::isnan(value)) {
+        return 0;
+    }
+
+    int exponent = 0;
+    double mantissa = std::frexp(value, &exponent);
+
+    const bool negative = mantissa < 0;
+
+    if (negative) {
+        mantissa = -mantissa;
+    }
+
+    std::uint64_t x = 0;
+
+    while (mantissa != 0.0) {
+
+        x = rotateHash(x, 28);
+        mantissa *= 268435456.0;
+        exponent -= 28;
+
+        const auto digit = static_cast<std::uint64_t>(mantissa);
+        mantissa -= static_cast<double>(digit);
+
+        x += digit;
+
+        if (x >= hashModulus) {
+            x -= hashModulus;
+        }
+    }
+
+    const int shift = exponent >= 0
+        ? exponent % static_cast<int>(hashBits)
+        : static_cast<int>(hashBits) - 1 - ((-1 - exponent) % static_cast<int>(hashBits));
+
+    return finishHash(rotateHash(x, static_cast<unsigned>(shift)), negative);
+}
+
 std::size_t Value::hash() const {
 
-    if (!isHashable()) {
-        throw std::runtime_error("TypeError: unhashable type");
+    // нехешируемые типы доходят до исключения в конце; кортеж проверяет элементы сам
+    if (isSmallInt()) {
+        return hashSmallInt(std::get<SmallInt>(data));
     }
 
-    // numeric
-    if (isNumeric()) {
+    if (isDouble()) {
+        return hashDouble(std::get<Float>(data));
+    }
 
-        const auto value = toBigFloat();
+    if (std::holds_alternative<bool>(data)) {
+        return std::get<bool>(data) ? 1 : 0;
+    }
 
-        // 1 == 1.0 == True
-        if (floor(value) == value) {
+    if (std::holds_alternative<BigIntPtr>(data)) {
+        return hashBigInt(*std::get<BigIntPtr>(data));
+    }
+
+    if (std::holds_alternative<BigFloatPtr>(data)) {
 
-            return std::hash<long long>{}(
-                value.convert_to<long long>()
-            );
+        const BigFloat& value = *std::get<BigFloatPtr>(data);
+
+        // целое decimal хешируется как int; дробное — через ближайший double
+        if (floor(value) == value) {
+            return hashBigInt(value.convert_to<BigInt>());
         }
 
-        return std::hash<long double>{}(
-            value.convert_to<long double>()
-        );
+        return hashDouble(value.convert_to<Float>());
     }
 
     if (isNone()) {
@@ -1452,24 +2058,49 @@ std::size_t Value::hash() const {
 
     // str
     if (isString()) {
-        return qHash(asString()->toString());
+        return std::get<StrPtr>(data)->hash();
     }
 
     if (isBytes()) {
-        return asBytes()->hash();
+        return std::get<BytesPtr>(data)->hash();
     }
 
     if (isTuple()) {
-        return asTuple()->hash();
+        return std::get<TuplePtr>(data)->hash();
     }
 
     if (isFrozenSet()) {
-        return asFrozenSet()->hash();
+        return std::get<FrozenSetPtr>(data)->hash();
+    }
+
+    if (isRange()) {
+        return std::get<RangePtr>(data)->hash();
     }
 
     throw std::runtime_error("TypeError: unhashable type");
 }
 
+bool Value::keyEquals(const Value& other) const {
+
+    const auto* left = std::get_if<StrPtr>(&data);
+    const auto* right = std::get_if<StrPtr>(&other.data);
+
+    if (left && right) {
+        return (*left)->sameText(**right);
+    }
+
+    return itemEquals(other);
+}
+
+bool Value::itemEquals(const Value& other) const {
+
+    if (SmallInt a, b; bothSmall(*this, other, a, b)) {
+        return a == b;
+    }
+
+    return sameReference(*this, other) || *this == other;
+}
+
 bool Value::isIterable() const {
     return isList() ||
            isTuple() ||
@@ -1479,7 +2110,8 @@ bool Value::isIterable() const {
            isDict() ||
            isDictKeysView() ||
            isDictValuesView() ||
-           isDictItemsView();
+           isDictItemsView() ||
+           isRange();
 }
 
 Value::IteratorPtr Value::getIterator() const {
@@ -1563,6 +2195,11 @@ Value::IteratorPtr Value::getIterator() const {
         );
     }
 
+    if (isRange()) {
+
+        return asRange()->makeIterator(false);
+    }
+
     if (std::holds_alternative<IteratorPtr>(data)) {
         return std::get<IteratorPtr>(data);
     }
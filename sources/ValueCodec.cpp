@@ -0,0 +1,459 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ValueCodec.h"
+
+#include <cstring>
+#include <unordered_map>
+
+#include "BigIntText.h"
+#include "ByteArrayValue.h"
+#include "BytesValue.h"
+#include "ClassUtils.h"
+#include "DictValue.h"
+#include "FrozenSetValue.h"
+#include "ListValue.h"
+#include "MemoryViewValue.h"
+#include "ObjectPool.h"
+#include "SetValue.h"
+#include "SharedSegment.h"
+#include "StrValue.h"
+#include "TupleValue.h"
+
+namespace valuecodec {
+
+    namespace {
+
+        enum class Tag : char {
+            None = 'N',
+            True = 'T',
+            False = 'F',
+            Small = 'i',
+            Big = 'I',
+            Float = 'f',
+            Decimal = 'D',
+            Str = 's',
+            Bytes = 'b',
+            ByteArray = 'a',
+            Tuple = 't',
+            List = 'l',
+            Dict = 'd',
+            Set = 'S',
+            FrozenSet = 'Z',
+            Ref = 'r',
+            Shared = 'M'
+        };
+
+        /// глубже этого вложенность не записывается и не читается, как RecursionError в CPython
+        constexpr int maxDepth = 1000;
+
+        [[noreturn]] void corrupted() {
+            throw std::runtime_error("ValueError: corrupted serialized value");
+        }
+
+        void putTag(QByteArray& out, const Tag tag) {
+            out.append(static_cast<char>(tag));
+        }
+
+        /// LEB128: по 7 бит в байте, старший бит — «дальше есть ещё байт»
+        void putVarint(QByteArray& out, std::uint64_t value) {
+
+            while (value >= 0x80) {
+                out.append(static_cast<char>((value & 0x7f) | 0x80));
+                value >>= 7;
+            }
+
+            out.append(static_cast<char>(value));
+        }
+
+        std::uint64_t takeVarint(const QByteArray& data, qsizetype& pos) {
+
+            std::uint64_t value = 0;
+
+            for (int shift = 0; shift < 64; shift += 7) {
+
+                if (pos >= data.size()) {
+                    corrupted();
+                }
+
+                const auto byte = static_cast<unsigned char>(data[pos++]);
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+
+                if (!(byte & 0x80)) {
+                    return value;
+                }
+            }
+
+            corrupted();
+        }
+
+        /// zigzag: отрицательные числа с малым модулем тоже занимают один-два байта
+        std::uint64_t zigzag(const std::int64_t value) {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        std::int64_t unzigzag(const std::uint64_t value) {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+
+        void putDouble(QByteArray& out, const double value) {
+            out.append(reinterpret_cast<const char*>(&value), sizeof value);
+        }
+
+        double takeDouble(const QByteArray& data, qsizetype& pos) {
+
+            if (data.size() - pos < qsizetype(sizeof(double))) {
+                corrupted();
+            }
+
+            double value;
+            std::memcpy(&value, data.constData() + pos, sizeof value);
+            pos += sizeof value;
+
+            return value;
+        }
+
+        void putBlob(QByteArray& out, const Tag tag, const QByteArrayView blob) {
+            putTag(out, tag);
+            putVarint(out, blob.size());
+            out.append(blob);
+        }
+
+        /// данные блоба прямо в буфере data, без копии
+        QByteArrayView takeBlob(const QByteArray& data, qsizetype& pos) {
+
+            const std::uint64_t size = takeVarint(data, pos);
+
+            if (size > static_cast<std::uint64_t>(data.size() - pos)) {
+                corrupted();
+            }
+
+            const QByteArrayView blob(data.constData() + pos, static_cast<qsizetype>(size));
+            pos += blob.size();
+
+            return blob;
+        }
+
+        /// число элементов контейнера: каждый занимает хотя бы байт тега
+        qsizetype takeCount(const QByteArray& data, qsizetype& pos) {
+
+            const std::uint64_t count = takeVarint(data, pos);
+
+            if (count > static_cast<std::uint64_t>(data.size() - pos)) {
+                corrupted();
+            }
+
+            return static_cast<qsizetype>(count);
+        }
+
+        class Encoder {
+        public:
+            Encoder(QByteArray& out, const bool shareSegments) : out(out), shareSegments(shareSegments) {}
+
+            void encode(const Value& value, const int depth) {
+
+                if (depth > maxDepth) {
+                    throw std::runtime_error("TypeError: cannot serialize a too deeply nested container");
+                }
+
+                if (value.isNone()) {
+                    putTag(out, Tag::None);
+                } else if (value.isBool()) {
+                    putTag(out, value.toBool() ? Tag::True : Tag::False);
+                } else if (const auto* small = std::get_if<Value::SmallInt>(&value.data)) {
+                    putTag(out, Tag::Small);
+                    putVarint(out, zigzag(*small));
+                } else if (value.isBigInt()) {
+                    putBlob(out, Tag::Big, QByteArray::fromStdString(BigIntText::toString(value.toBigInt())));
+                } else if (value.isDouble()) {
+                    putTag(out, Tag::Float);
+                    putDouble(out, value.toDouble());
+                } else if (value.isDecimal()) {
+                    const Value::BigFloat decimal = value.toBigFloat();
+                    putBlob(out, Tag::Decimal, QByteArray::fromStdString(
+                        decimal.str(std::numeric_limits<Value::BigFloat>::max_digits10, std::ios_base::scientific)));
+                } else if (const auto* str = std::get_if<Value::StrPtr>(&value.data)) {
+                    if (!reference(str->get())) {
+                        putBlob(out, Tag::Str, (*str)->view().toUtf8());
+                    }
+                } else if (const auto* bytes = std::get_if<Value::BytesPtr>(&value.data)) {
+                    if (!reference(bytes->get())) {
+                        putBlob(out, Tag::Bytes, (*bytes)->bytes());
+                    }
+                } else if (value.isByteArray()) {
+                    const auto array = value.asByteArray();
+                    if (!reference(array.get())) {
+                        putBlob(out, Tag::ByteArray, array->bytes());
+                    }
+                } else if (const auto* tuple = std::get_if<Value::TuplePtr>(&value.data)) {
+                    encodeSealed(tuple->get(), Tag::Tuple, (*tuple)->items, depth);
+                } else if (const auto* list = std::get_if<Value::ListPtr>(&value.data)) {
+                    if (!reference(list->get())) {
+                        encodeItems(Tag::List, (*list)->elements.get(), depth);
+                    }
+                } else if (value.isSet()) {
+                    const auto set = value.asSet();
+                    if (!reference(set.get())) {
+                        encodeItems(Tag::Set, elementsOf(set->elements), depth);
+                    }
+                } else if (value.isFrozenSet()) {
+                    const auto set = value.asFrozenSet();
+                    encodeSealed(set.get(), Tag::FrozenSet, elementsOf(set->getElements()), depth);
+                } else if (const auto* dict = std::get_if<Value::DictPtr>(&value.data)) {
+                    if (!reference(dict->get())) {
+                        encodeDict(**dict, depth);
+                    }
+                } else if (const MemoryViewValue* view = shareSegments ? sharedView(value) : nullptr) {
+                    encodeShared(*view);
+                } else {
+                    throw std::runtime_error("TypeError: cannot serialize '" + typeName(value).toStdString() + "' object");
+                }
+            }
+
+        private:
+            struct Slot {
+                std::uint64_t index;
+                /// tuple и frozenset получают номер до элементов, но читатель создаёт их после
+                bool complete;
+            };
+
+            QByteArray& out;
+            bool shareSegments;
+            std::unordered_map<const void*, Slot> memo;
+
+            /**
+             * Объект, который уже записан, заменяется ссылкой на его номер; новый
+             * объект получает следующий номер — читатель нумерует их в том же порядке.
+             */
+            bool reference(const void* object, const bool complete = true) {
+
+                const auto [it, inserted] = memo.try_emplace(object, Slot{memo.size(), complete});
+
+                if (inserted) {
+                    return false;
+                }
+
+                if (!it->second.complete) {
+                    throw std::runtime_error("TypeError: cannot serialize a tuple or frozenset that contains itself");
+                }
+
+                putTag(out, Tag::Ref);
+                putVarint(out, it->second.index);
+
+                return true;
+            }
+
+            static std::vector<Value> elementsOf(const OrderedValueSet& set) {
+
+                std::vector<Value> elements;
+                elements.reserve(set.size());
+                set.forEach([&](const Value& element) { elements.push_back(element); });
+
+                return elements;
+            }
+
+            void encodeItems(const Tag tag, const std::vector<Value>& items, const int depth) {
+
+                putTag(out, tag);
+                putVarint(out, items.size());
+
+                for (const Value& item : items) {
+                    encode(item, depth + 1);
+                }
+            }
+
+            /// неизменяемый контейнер: ссылка на него изнутри него самого невозможна при чтении
+            void encodeSealed(const void* object, const Tag tag, const std::vector<Value>& items, const int depth) {
+
+                if (reference(object, false)) {
+                    return;
+                }
+
+                encodeItems(tag, items, depth);
+
+                // ссылка на элемент unordered_map переживает перехеширование
+                memo.at(object).complete = true;
+            }
+
+            /// memoryview над общим сегментом или nullptr
+            static const MemoryViewValue* sharedView(const Value& value) {
+
+                const MemoryViewValue* view = MemoryViewValue::of(value);
+
+                return view && SharedBufferValue::of(view->object()) ? view : nullptr;
+            }
+
+            /// путь файла сегмента и положение вида в нём — без байтов
+            void encodeShared(const MemoryViewValue& view) {
+
+                const MemoryViewValue::Layout layout = view.layout();
+
+                putBlob(out, Tag::Shared, SharedBufferValue::of(view.object())->path().toUtf8());
+                putVarint(out, zigzag(layout.offset));
+                putVarint(out, zigzag(layout.length));
+                putVarint(out, zigzag(layout.stride));
+                out.append(layout.format);
+            }
+
+            void encodeDict(const DictValue& dict, const int depth) {
+
+                putTag(out, Tag::Dict);
+                putVarint(out, dict.len());
+
+                dict.forEachItem([&](const Value& key, const Value& value) {
+                    encode(key, depth + 1);
+                    encode(value, depth + 1);
+                });
+            }
+        };
+
+        class Decoder {
+        public:
+            Decoder(const QByteArray& data, qsizetype& pos, const bool shareSegments)
+                : data(data), pos(pos), shareSegments(shareSegments) {}
+
+            Value decode(const int depth) {
+
+                if (depth > maxDepth || pos >= data.size()) {
+                    corrupted();
+                }
+
+                switch (static_cast<Tag>(data[pos++])) {
+                    case Tag::None:
+                        return {};
+                    case Tag::True:
+                        return Value(true);
+                    case Tag::False:
+                        return Value(false);
+                    case Tag::Small:
+                        return Value(static_cast<Value::SmallInt>(unzigzag(takeVarint(data, pos))));
+                    case Tag::Big:
+                        return Value(BigIntText::fromString(takeBlob(data, pos).toByteArray().toStdString()));
+                    case Tag::Float:
+                        return Value(takeDouble(data, pos));
+                    case Tag::Decimal:
+                        return Value(Value::BigFloat(takeBlob(data, pos).toByteArray().toStdString()));
+                    case Tag::Str: {
+                        const std::size_t slot = reserve();
+                        return memo[slot] = Value(QString::fromUtf8(takeBlob(data, pos)));
+                    }
+                    case Tag::Bytes: {
+                        const std::size_t slot = reserve();
+                        return memo[slot] = Value(std::make_shared<BytesValue>(takeBlob(data, pos).toByteArray()));
+                    }
+                    case Tag::ByteArray: {
+                        const std::size_t slot = reserve();
+                        return memo[slot] = Value(std::make_shared<ByteArrayValue>(takeBlob(data, pos).toByteArray()));
+                    }
+                    case Tag::Tuple: {
+                        const std::size_t slot = reserve();
+                        return memo[slot] = Value(makePooled<TupleValue>(decodeItems(depth)));
+                    }
+                    case Tag::List: {
+                        // изменяемый контейнер запоминается до элементов: они могут ссылаться на него
+                        const auto list = makePooled<ListValue>();
+                        memo.emplace_back(list);
+                        list->elements = decodeItems(depth);
+                        return Value(list);
+                    }
+                    case Tag::Set: {
+                        const auto set = std::make_shared<SetValue>();
+                        memo.emplace_back(set);
+                        for (const Value& item : decodeItems(depth)) {
+                            set->add(item);
+                        }
+                        return Value(set);
+                    }
+                    case Tag::FrozenSet: {
+                        const std::size_t slot = reserve();
+                        OrderedValueSet elements;
+                        for (const Value& item : decodeItems(depth)) {
+                            elements.insert(item);
+                        }
+                        return memo[slot] = Value(std::make_shared<FrozenSetValue>(std::move(elements)));
+                    }
+                    case Tag::Dict: {
+                        const auto dict = std::make_shared<DictValue>();
+                        memo.emplace_back(dict);
+                        const qsizetype count = takeCount(data, pos);
+                        for (qsizetype i = 0; i < count; ++i) {
+                            Value key = decode(depth + 1);
+                            dict->setItem(key, decode(depth + 1));
+                        }
+                        return Value(dict);
+                    }
+                    case Tag::Shared: {
+                        if (!shareSegments) {
+                            corrupted();
+                        }
+                        return decodeShared();
+                    }
+                    case Tag::Ref: {
+                        const std::uint64_t index = takeVarint(data, pos);
+                        if (index >= memo.size()) {
+                            corrupted();
+                        }
+                        return memo[index];
+                    }
+                    default:
+                        corrupted();
+                }
+            }
+
+        private:
+            const QByteArray& data;
+            qsizetype& pos;
+            bool shareSegments;
+            /// прочитанные объекты в порядке номеров, которые им дал Encoder
+            std::vector<Value> memo;
+
+            std::size_t reserve() {
+                memo.emplace_back();
+                return memo.size() - 1;
+            }
+
+            Value decodeShared() {
+
+                const QString path = QString::fromUtf8(takeBlob(data, pos));
+
+                MemoryViewValue::Layout layout{};
+                layout.offset = static_cast<qsizetype>(unzigzag(takeVarint(data, pos)));
+                layout.length = static_cast<qsizetype>(unzigzag(takeVarint(data, pos)));
+                layout.stride = static_cast<qsizetype>(unzigzag(takeVarint(data, pos)));
+
+                if (pos >= data.size()) {
+                    corrupted();
+                }
+
+                layout.format = data[pos++];
+
+                const Value owner(std::static_pointer_cast<ObjectValue>(
+                    std::make_shared<SharedBufferValue>(SharedSegment::attach(path))));
+
+                return MemoryViewValue::over(owner, layout);
+            }
+
+            std::vector<Value> decodeItems(const int depth) {
+
+                const qsizetype count = takeCount(data, pos);
+
+                std::vector<Value> items;
+                items.reserve(count);
+
+                for (qsizetype i = 0; i < count; ++i) {
+                    items.push_back(decode(depth + 1));
+                }
+
+                return items;
+            }
+        };
+    }
+
+    void encode(const Value& value, QByteArray& out, const bool shareSegments) {
+        Encoder(out, shareSegments).encode(value, 0);
+    }
+
+    Value decode(const QByteArray& data, qsizetype& pos, const bool shareSegments) {
+        return Decoder(data, pos, shareSegments).decode(0);
+    }
+}
@@ -0,0 +1,76 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "VecMathModule.h"
+
+#include "ArrayKernels.h"
+#include "ArrayValue.h"
+#include "ClassUtils.h"
+#include "ClassValue.h"
+#include "VectorValue.h"
+#include "../runtime/ArgValidation.h"
+#include "../runtime/RuntimeUtils.h"
+
+Value VecMathModule::makeModule() {
+
+    const auto module = std::make_shared<ClassValue>("vecmath");
+
+    module->setAttribute("vector", makeBuiltin(
+        "vector",
+        [](const std::vector<Value>& args, const Kwargs& kwargs, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgsRange(args, 1, 2, "vector");
+
+            const Value* typecode = args.size() > 1 ? &args[1] : nullptr;
+
+            for (const auto& [name, value] : kwargs) {
+
+                if (name != "typecode") {
+                    throw std::runtime_error(
+                        "TypeError: vector() got an unexpected keyword argument '" + name.toStdString() + "'");
+                }
+
+                typecode = &value;
+            }
+
+            const char code = typecode ? ArrayValue::parseTypecode(*typecode) : 'd';
+
+            // другой упакованный буфер приводится ядром, без обхода по элементам
+            if (const PackedValue* packed = PackedValue::of(args[0])) {
+                return VectorValue::make(code, arraykernels::widen(packed->bytes(), packed->typecode(), code));
+            }
+
+            ArrayValue staging(code);
+            staging.extend(args[0]);
+
+            return VectorValue::make(code, staging.bytes());
+        }
+    ));
+
+    module->setAttribute("set_threads", makeBuiltin(
+        "set_threads",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 1, "set_threads");
+
+            const Value::BigInt count = args[0].asBigInt("set_threads");
+
+            // 0 и меньше — по числу ядер
+            arraykernels::setThreads(count < 0 ? 0 : count > 1024 ? 1024 : count.convert_to<int>());
+
+            return {};
+        }
+    ));
+
+    module->setAttribute("get_threads", makeBuiltin(
+        "get_threads",
+        [](const std::vector<Value>& args, const Kwargs&, const std::shared_ptr<Environment>&) -> Value {
+
+            expectArgs(args, 0, "get_threads");
+
+            return Value(Value::SmallInt(arraykernels::threads()));
+        }
+    ));
+
+    return Value(module);
+}
@@ -0,0 +1,283 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "VectorValue.h"
+
+#include "ClassUtils.h"
+#include "../runtime/ProtocolHelpers.h"
+
+namespace {
+
+    /// операнд поэлементной операции: буфер с кодом; число — буфер из одного элемента
+    struct Operand {
+        char code;
+        QByteArray data;
+    };
+
+    std::optional<Operand> operandOf(const Value& value) {
+
+        if (const VectorValue* vector = VectorValue::of(value)) {
+            return Operand{vector->typecode(), vector->bytes()};
+        }
+
+        const auto single = [](auto number) {
+            QByteArray data(sizeof number, Qt::Uninitialized);
+            arraykernels::store(data.data(), 0, number);
+            return data;
+        };
+
+        if (const auto* small = std::get_if<Value::SmallInt>(&value.data)) {
+            return Operand{'q', single(static_cast<long long>(*small))};
+        }
+
+        if (value.isBool()) {
+            return Operand{'q', single(static_cast<long long>(value.toBool()))};
+        }
+
+        // длинное целое и Decimal считаются в double
+        if (value.isNumeric()) {
+            return Operand{'d', single(value.toDouble())};
+        }
+
+        return std::nullopt;
+    }
+
+    /// `q`, если оба кода целые и помещаются в int64, иначе `d`
+    char commonCode(const char left, const char right) {
+
+        const auto wide = [](const char code) {
+            return arraykernels::isFloatCode(code) || code == 'Q' || code == 'L';
+        };
+
+        return wide(left) || wide(right) ? 'd' : 'q';
+    }
+
+    [[noreturn]] void shapeError(const qsizetype left, const qsizetype right) {
+        throw std::runtime_error("ValueError: operands could not be broadcast together with shapes (" +
+                                 std::to_string(left) + ",) (" + std::to_string(right) + ",)");
+    }
+
+    /// операнды в общем коде; ValueError, если длины разные и ни одна не равна 1
+    void align(Operand& left, Operand& right, const char code) {
+
+        const qsizetype leftCount = left.data.size() / arraykernels::itemSize(left.code);
+        const qsizetype rightCount = right.data.size() / arraykernels::itemSize(right.code);
+
+        if (leftCount != rightCount && leftCount != 1 && rightCount != 1) {
+            shapeError(leftCount, rightCount);
+        }
+
+        left.data = arraykernels::widen(left.data, left.code, code);
+        right.data = arraykernels::widen(right.data, right.code, code);
+    }
+}
+
+VectorValue::VectorValue(const char typecode, QByteArray data) : PackedValue(typecode, std::move(data)) {}
+
+VectorValue* VectorValue::of(const Value& value) {
+
+    const auto object = std::get_if<Value::ObjectPtr>(&value.data);
+
+    return object ? dynamic_cast<VectorValue*>(object->get()) : nullptr;
+}
+
+Value VectorValue::make(const char typecode, QByteArray data) {
+    return Value(std::static_pointer_cast<ObjectValue>(std::make_shared<VectorValue>(typecode, std::move(data))));
+}
+
+Value VectorValue::getItem(const Value& index) const {
+
+    if (index.isSlice()) {
+
+        const auto slice = normalizeSlice(*index.asSlice(), len());
+
+        if (slice.step == 1) {
+            return make(code, data.mid(slice.start * size, sliceLength(slice) * size));
+        }
+
+        QByteArray result;
+        result.reserve(sliceLength(slice) * size);
+
+        iterateSlice(slice, [&](const long long i) {
+            result.append(data.constData() + i * size, size);
+        });
+
+        return make(code, std::move(result));
+    }
+
+    if (const VectorValue* mask = of(index)) {
+
+        if (mask->code != 'B') {
+            throw std::runtime_error("IndexError: only 'B' mask vectors can be used as indices");
+        }
+
+        if (mask->len() != len()) {
+            throw std::runtime_error(
+                "IndexError: boolean index did not match indexed vector; dimension is " + std::to_string(len()) +
+                " but corresponding boolean dimension is " + std::to_string(mask->len()));
+        }
+
+        QByteArray result;
+        const char* selected = mask->data.constData();
+
+        for (qsizetype i = 0; i < len(); ++i) {
+            if (selected[i]) {
+                result.append(data.constData() + i * size, size);
+            }
+        }
+
+        return make(code, std::move(result));
+    }
+
+    if (!index.isBigInt() && !index.isBool()) {
+        throw std::runtime_error("TypeError: vector indices must be integers, slices or masks");
+    }
+
+    Value::BigInt position = index.toBigInt();
+
+    if (position < 0) {
+        position += len();
+    }
+
+    if (position < 0 || position >= len()) {
+        throw std::runtime_error("IndexError: vector index out of range");
+    }
+
+    return item(position.convert_to<qsizetype>());
+}
+
+bool VectorValue::contains(const Value& value) const {
+
+    for (qsizetype i = 0; i < len(); ++i) {
+        if (item(i) == value) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool VectorValue::equal(const Value& other) const {
+
+    const VectorValue* vector = of(other);
+
+    if (!vector || vector->len() != len()) {
+        return false;
+    }
+
+    if (vector->code == code && !arraykernels::isFloatCode(code)) {
+        return vector->data == data;
+    }
+
+    for (qsizetype i = 0; i < len(); ++i) {
+        if (!(item(i) == vector->item(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool VectorValue::notEqual(const Value& other) const {
+    return !equal(other);
+}
+
+Value VectorValue::arithmetic(const arraykernels::Op op, const Value& other, const bool reflected) const {
+
+    std::optional<Operand> operand = operandOf(other);
+
+    if (!operand) {
+        return Value::notImplemented();
+    }
+
+    Operand self{code, data};
+    Operand& left = reflected ? *operand : self;
+    Operand& right = reflected ? self : *operand;
+
+    const char result = op == arraykernels::Op::Div ? 'd' : commonCode(left.code, right.code);
+
+    align(left, right, result);
+
+    return make(result, arraykernels::apply(op, result, left.data, right.data));
+}
+
+Value VectorValue::add(const Value& other) const {
+    return arithmetic(arraykernels::Op::Add, other, false);
+}
+
+Value VectorValue::sub(const Value& other) const {
+    return arithmetic(arraykernels::Op::Sub, other, false);
+}
+
+Value VectorValue::multiply(const Value& other) const {
+    return arithmetic(arraykernels::Op::Mul, other, false);
+}
+
+Value VectorValue::truediv(const Value& other) const {
+    return arithmetic(arraykernels::Op::Div, other, false);
+}
+
+Value VectorValue::radd(const Value& other) const {
+    return arithmetic(arraykernels::Op::Add, other, true);
+}
+
+Value VectorValue::rsub(const Value& other) const {
+    return arithmetic(arraykernels::Op::Sub, other, true);
+}
+
+Value VectorValue::rmul(const Value& other) const {
+    return arithmetic(arraykernels::Op::Mul, other, true);
+}
+
+Value VectorValue::rtruediv(const Value& other) const {
+    return arithmetic(arraykernels::Op::Div, other, true);
+}
+
+Value VectorValue::compare(const arraykernels::Compare op, const Value& other) const {
+
+    std::optional<Operand> operand = operandOf(other);
+
+    if (!operand) {
+        throw std::runtime_error(
+            "TypeError: vector can only be compared with a vector or a number, not '" +
+            typeName(other).toStdString() + "'");
+    }
+
+    Operand self{code, data};
+    const char common = commonCode(code, operand->code);
+
+    align(self, *operand, common);
+
+    return make('B', arraykernels::compare(op, common, self.data, operand->data));
+}
+
+Value VectorValue::dot(const Value& other) const {
+
+    const VectorValue* vector = of(other);
+
+    if (!vector) {
+        throw std::runtime_error("TypeError: dot() argument must be a vector, not '" + typeName(other).toStdString() + "'");
+    }
+
+    if (vector->len() != len()) {
+        shapeError(len(), vector->len());
+    }
+
+    Operand left{code, data};
+    Operand right{vector->code, vector->data};
+    const char common = commonCode(code, vector->code);
+
+    align(left, right, common);
+
+    const QByteArray products = arraykernels::apply(arraykernels::Op::Mul, common, left.data, right.data);
+
+    return *arraykernels::sum(common, products, Value(Value::SmallInt(0)));
+}
+
+Value VectorValue::astype(const char target) const {
+    return make(target, arraykernels::widen(data, code, target));
+}
+
+QString VectorValue::toString() const {
+    return reprAs("vector");
+}
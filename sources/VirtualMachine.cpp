@@ -0,0 +1,1128 @@
+//
+// Created by semyo on 14.10.2026.
+//
+
+#include "VirtualMachine.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "ExecutionBudget.h"
+#include "FunctionValue.h"
+#include "FutureValue.h"
+#include "GarbageCollector.h"
+#include "GeneratorValue.h"
+#include "InterpreterContext.h"
+#include "IntOps.h"
+#include "OutputStream.h"
+#include "Parser.h"
+#include "Profiler.h"
+#include "PyException.h"
+#include "RangeIterator.h"
+#include "RecursionLimit.h"
+#include "ReprWriter.h"
+#include "RuntimeStats.h"
+#include "SuperValue.h"
+#include "Tracer.h"
+#include "VectorPool.h"
+
+namespace {
+
+Value pop(std::vector<Value>& stack) {
+    Value value = std::move(stack.back());
+    stack.pop_back();
+    return value;
+}
+
+bool isStopAsyncIteration(const std::exception& error) {
+    return PyException::matches(PyException::toException(error),
+                                Value(InterpreterContext::current().exceptionClasses.value("StopAsyncIteration")));
+}
+
+template <typename T>
+bool bothHold(const Value& l, const Value& r) {
+    return std::holds_alternative<T>(l.data) && std::holds_alternative<T>(r.data);
+}
+
+bool isIntOperation(const BinOpNode::Operation operation) {
+    return operation == BinOpNode::Operation::Add ||
+           operation == BinOpNode::Operation::Subtract ||
+           operation == BinOpNode::Operation::Multiply;
+}
+
+bool isFloatOperation(const BinOpNode::Operation operation) {
+    return isIntOperation(operation) || operation == BinOpNode::Operation::Divide;
+}
+
+/**
+ * Арифметика быстрой формы инструкции. Возвращает nullopt, если операнды не того вида,
+ * на который инструкция специализирована. Переполнение машинного целого и деление
+ * на ноль уходят в общий путь, который даёт BigInt или исключение.
+ */
+std::optional<Value> applySpecialized(const OpCode op,
+                                      const BinOpNode::Operation operation,
+                                      const Value& l,
+                                      const Value& r) {
+
+    switch (op) {
+
+        case OpCode::BinaryOpInt:
+        case OpCode::InplaceOpInt: {
+
+            const auto a = std::get_if<Value::SmallInt>(&l.data);
+            const auto b = std::get_if<Value::SmallInt>(&r.data);
+
+            if (!a || !b) {
+                return std::nullopt;
+            }
+
+            Value::SmallInt result;
+            bool overflow;
+
+            switch (operation) {
+                case BinOpNode::Operation::Add:      overflow = intops::addOverflow(*a, *b, result); break;
+                case BinOpNode::Operation::Subtract: overflow = intops::subOverflow(*a, *b, result); break;
+                default:                             overflow = intops::mulOverflow(*a, *b, result); break;
+            }
+
+            return overflow ? BinOpNode::apply(operation, l, r) : Value(result);
+        }
+
+        case OpCode::BinaryOpFloat:
+        case OpCode::InplaceOpFloat: {
+
+            const auto a = std::get_if<Value::Float>(&l.data);
+            const auto b = std::get_if<Value::Float>(&r.data);
+
+            if (!a || !b) {
+                return std::nullopt;
+            }
+
+            switch (operation) {
+                case BinOpNode::Operation::Add:      return Value(*a + *b);
+                case BinOpNode::Operation::Subtract: return Value(*a - *b);
+                case BinOpNode::Operation::Multiply: return Value(*a * *b);
+                default:
+                    return *b == 0 ? BinOpNode::apply(operation, l, r) : Value(*a / *b);
+            }
+        }
+
+        case OpCode::BinaryAddStr:
+        case OpCode::InplaceAddStr: {
+
+            const auto a = std::get_if<Value::StrPtr>(&l.data);
+
+            if (!a || !r.isString()) {
+                return std::nullopt;
+            }
+
+            return (*a)->add(r);
+        }
+
+        default:
+            return std::nullopt;
+    }
+}
+
+/// бинарная операция составного присваивания, у которой для int, float и str нет отдельного __iop__
+std::optional<BinOpNode::Operation> binaryOperation(const AugAssignNode::Operation operation) {
+    switch (operation) {
+        case AugAssignNode::Operation::Add:      return BinOpNode::Operation::Add;
+        case AugAssignNode::Operation::Subtract: return BinOpNode::Operation::Subtract;
+        case AugAssignNode::Operation::Multiply: return BinOpNode::Operation::Multiply;
+        case AugAssignNode::Operation::Divide:   return BinOpNode::Operation::Divide;
+        default:                                 return std::nullopt;
+    }
+}
+
+/// сравнение, у которого есть быстрая форма: <, <=, >, >=, ==, !=
+bool isOrdering(const CompareNode::Operation operation) {
+    switch (operation) {
+        case CompareNode::Operation::Equal:
+        case CompareNode::Operation::NotEqual:
+        case CompareNode::Operation::Less:
+        case CompareNode::Operation::LessOrEqual:
+        case CompareNode::Operation::Greater:
+        case CompareNode::Operation::GreaterOrEqual:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template <typename T>
+bool compareAs(const CompareNode::Operation operation, const T a, const T b) {
+    switch (operation) {
+        case CompareNode::Operation::Equal:       return a == b;
+        case CompareNode::Operation::NotEqual:    return a != b;
+        case CompareNode::Operation::Less:        return a < b;
+        case CompareNode::Operation::LessOrEqual: return a <= b;
+        case CompareNode::Operation::Greater:     return a > b;
+        default:                                  return a >= b;
+    }
+}
+
+/// арифметика суперинструкции: два int или два float, иначе nullopt
+std::optional<Value> applyNumbers(const BinOpNode::Operation operation, const Value& l, const Value& r) {
+
+    if (bothHold<Value::SmallInt>(l, r) && isIntOperation(operation)) {
+        return applySpecialized(OpCode::BinaryOpInt, operation, l, r);
+    }
+
+    if (bothHold<Value::Float>(l, r) && isFloatOperation(operation)) {
+        return applySpecialized(OpCode::BinaryOpFloat, operation, l, r);
+    }
+
+    return std::nullopt;
+}
+
+/// сравнение суперинструкции: два int или два float, иначе nullopt
+std::optional<bool> compareNumbers(const CompareNode::Operation operation, const Value& l, const Value& r) {
+
+    if (const auto a = std::get_if<Value::SmallInt>(&l.data)) {
+        if (const auto b = std::get_if<Value::SmallInt>(&r.data)) {
+            return compareAs(operation, *a, *b);
+        }
+        return std::nullopt;
+    }
+
+    if (const auto a = std::get_if<Value::Float>(&l.data)) {
+        if (const auto b = std::get_if<Value::Float>(&r.data)) {
+            return compareAs(operation, *a, *b);
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool isOperand(const OpCode op) {
+    return op == OpCode::LoadFast || op == OpCode::LoadConst;
+}
+
+/// значение операнда суперинструкции без копирования; nullptr — слот не связан или чужой
+const Value* operand(const CodeObject& code, const OpCode op, const std::int32_t arg, Environment& env) {
+    return op == OpCode::LoadConst ? &code.constants[arg] : env.slot(LocalSlot{code.layout, arg});
+}
+
+/**
+ * `s += t` дописывает t в саму строку s, если её больше никто не держит. Следующая
+ * инструкция должна записать результат в ту же переменную, откуда взят левый операнд:
+ * переменная на время отпускает строку, и единственной ссылкой остаётся стек.
+ */
+bool appendInPlace(const CodeObject& code, const std::int32_t pc, Environment& env, Value& left, const Value& right) {
+
+    const auto l = std::get_if<Value::StrPtr>(&left.data);
+    const auto r = std::get_if<Value::StrPtr>(&right.data);
+
+    if (!l || !r || pc >= static_cast<std::int32_t>(code.code.size())) {
+        return false;
+    }
+
+    const Instruction& store = code.code[pc];
+    Value* target = nullptr;
+
+    if (store.op == OpCode::StoreFast) {
+        target = env.slot(LocalSlot{code.layout, store.arg});
+    } else if (store.op == OpCode::StoreName) {
+        target = env.findLocal(code.names[store.arg]);
+    } else if (store.op == OpCode::StoreGlobal) {
+        target = env.moduleGlobals()->findLocal(code.names[store.arg]);
+    }
+
+    const auto held = target ? std::get_if<Value::StrPtr>(&target->data) : nullptr;
+
+    if (!held || held->get() != l->get()) {
+        return false;
+    }
+
+    *target = Value();
+
+    // остальные владельцы: константы, интернированные атомы, другие переменные, `s += s`
+    if (l->use_count() != 1) {
+        *target = left;
+        return false;
+    }
+
+    (*l)->append(**r);
+    RuntimeStats::add(RuntimeStats::StrAppends);
+
+    return true;
+}
+
+bool isBinaryOp(const OpCode op) {
+    return op == OpCode::BinaryOp || op == OpCode::BinaryOpInt ||
+           op == OpCode::BinaryOpFloat || op == OpCode::BinaryAddStr;
+}
+
+bool isInplaceOp(const OpCode op) {
+    return op == OpCode::InplaceOp || op == OpCode::InplaceOpInt ||
+           op == OpCode::InplaceOpFloat || op == OpCode::InplaceAddStr;
+}
+
+bool isCompareOp(const OpCode op) {
+    return op == OpCode::CompareOp || op == OpCode::CompareOpInt || op == OpCode::CompareOpFloat;
+}
+
+}
+
+/**
+ * Выбирает быструю форму по видам операндов текущего выполнения. Для BinaryOp и InplaceOp
+ * в `arg2` записывается бинарная операция (у InplaceOp `arg` остаётся операцией
+ * составного присваивания — она нужна при возврате к общей форме).
+ */
+OpCode VirtualMachine::specialize(Instruction& instr, const Value& l, const Value& r) {
+
+    const bool ints = bothHold<Value::SmallInt>(l, r);
+    const bool floats = bothHold<Value::Float>(l, r);
+    const bool strs = bothHold<Value::StrPtr>(l, r);
+
+    switch (instr.op) {
+
+        case OpCode::BinaryOp: {
+
+            const auto operation = static_cast<BinOpNode::Operation>(instr.arg);
+            instr.arg2 = instr.arg;
+
+            if (ints && isIntOperation(operation)) return OpCode::BinaryOpInt;
+            if (floats && isFloatOperation(operation)) return OpCode::BinaryOpFloat;
+            if (strs && operation == BinOpNode::Operation::Add) return OpCode::BinaryAddStr;
+            break;
+        }
+
+        case OpCode::InplaceOp: {
+
+            // у int, float и str нет __iadd__ и т.п. — составное присваивание равно бинарной операции
+            const auto binary = binaryOperation(static_cast<AugAssignNode::Operation>(instr.arg));
+
+            if (!binary) {
+                return instr.op;
+            }
+
+            const BinOpNode::Operation operation = *binary;
+            instr.arg2 = static_cast<std::int32_t>(operation);
+
+            if (ints && isIntOperation(operation)) return OpCode::InplaceOpInt;
+            if (floats && isFloatOperation(operation)) return OpCode::InplaceOpFloat;
+            if (strs && operation == BinOpNode::Operation::Add) return OpCode::InplaceAddStr;
+            break;
+        }
+
+        case OpCode::CompareOp: {
+
+            if (isOrdering(static_cast<CompareNode::Operation>(instr.arg))) {
+                if (ints) return OpCode::CompareOpInt;
+                if (floats) return OpCode::CompareOpFloat;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return instr.op;
+}
+
+std::optional<bool> VirtualMachine::compareSpecialized(const Instruction& instr, const Value& l, const Value& r) {
+
+    const auto operation = static_cast<CompareNode::Operation>(instr.arg);
+    const auto compare = [operation](const auto a, const auto b) {
+        return compareAs(operation, a, b);
+    };
+
+    if (instr.op == OpCode::CompareOpInt) {
+
+        const auto a = std::get_if<Value::SmallInt>(&l.data);
+        const auto b = std::get_if<Value::SmallInt>(&r.data);
+
+        return a && b ? std::optional(compare(*a, *b)) : std::nullopt;
+    }
+
+    const auto a = std::get_if<Value::Float>(&l.data);
+    const auto b = std::get_if<Value::Float>(&r.data);
+
+    return a && b ? std::optional(compare(*a, *b)) : std::nullopt;
+}
+
+void VirtualMachine::deoptimize(Instruction& instr, const OpCode generic) {
+    instr.op = generic;
+    instr.cache = -backoff;
+}
+
+/**
+ * Те же условия, что в specialize, но по заданной форме вместо операндов: профиль
+ * прошлого запуска не может дать инструкции форму, которую она не получила бы сама.
+ */
+bool VirtualMachine::prespecialize(const CodeObject& code, const std::size_t at, const OpCode fast) {
+
+    if (at >= code.code.size()) {
+        return false;
+    }
+
+    Instruction& instr = code.code[at];
+    std::optional<BinOpNode::Operation> operation;
+
+    if (instr.op == OpCode::BinaryOp) {
+        operation = static_cast<BinOpNode::Operation>(instr.arg);
+    } else if (instr.op == OpCode::InplaceOp) {
+        operation = binaryOperation(static_cast<AugAssignNode::Operation>(instr.arg));
+    }
+
+    bool fits = false;
+
+    switch (fast) {
+        case OpCode::BinaryOpInt:
+        case OpCode::InplaceOpInt:
+            fits = operation && isIntOperation(*operation);
+            break;
+        case OpCode::BinaryOpFloat:
+        case OpCode::InplaceOpFloat:
+            fits = operation && isFloatOperation(*operation);
+            break;
+        case OpCode::BinaryAddStr:
+        case OpCode::InplaceAddStr:
+            fits = operation == BinOpNode::Operation::Add;
+            break;
+        case OpCode::CompareOpInt:
+        case OpCode::CompareOpFloat:
+            fits = instr.op == OpCode::CompareOp && isOrdering(static_cast<CompareNode::Operation>(instr.arg));
+            break;
+        default:
+            break;
+    }
+
+    // общая форма должна совпадать с семейством: BinaryOpInt не встанет на место InplaceOp
+    const bool inplace = fast == OpCode::InplaceOpInt || fast == OpCode::InplaceOpFloat || fast == OpCode::InplaceAddStr;
+
+    if (!fits || (operation && inplace != (instr.op == OpCode::InplaceOp))) {
+        return false;
+    }
+
+    if (operation) {
+        instr.arg2 = static_cast<std::int32_t>(*operation);
+    }
+
+    instr.op = fast;
+    instr.cache = -backoff;
+
+    return true;
+}
+
+void VirtualMachine::preheat(const CodeObject& code) {
+    if (code.heat < hotThreshold) {
+        code.heat = hotThreshold;
+        fuse(code);
+    }
+}
+
+/**
+ * Один проход по байткоду: последовательность заменяется, если её первая инструкция
+ * ещё в исходном виде. Последовательности не перекрываются — после замены проход
+ * продолжается за её концом.
+ */
+void VirtualMachine::fuse(const CodeObject& code) {
+
+    std::vector<Instruction>& instructions = code.code;
+    const std::size_t size = instructions.size();
+
+    for (std::size_t i = 0; i + 2 < size; ++i) {
+
+        Instruction& first = instructions[i];
+        const Instruction& second = instructions[i + 1];
+        const Instruction& third = instructions[i + 2];
+        const Instruction* fourth = i + 3 < size ? &instructions[i + 3] : nullptr;
+
+        if (!isOperand(first.op) || !isOperand(second.op)) {
+            continue;
+        }
+
+        OpCode fused;
+        std::size_t length;
+
+        if (isCompareOp(third.op) && isOrdering(static_cast<CompareNode::Operation>(third.arg)) &&
+            fourth && fourth->op == OpCode::PopJumpIfFalse) {
+            fused = OpCode::FastCompareJump;
+            length = 4;
+        } else if (isInplaceOp(third.op) && first.op == OpCode::LoadFast &&
+                   binaryOperation(static_cast<AugAssignNode::Operation>(third.arg)) &&
+                   fourth && fourth->op == OpCode::StoreFast && fourth->arg == first.arg) {
+            fused = OpCode::FastInplace;
+            length = 4;
+        } else if (isBinaryOp(third.op) && isFloatOperation(static_cast<BinOpNode::Operation>(third.arg))) {
+            fused = OpCode::FastBinary;
+            length = 3;
+        } else {
+            continue;
+        }
+
+        first.cache = static_cast<std::int32_t>(first.op);
+        first.op = fused;
+        RuntimeStats::add(RuntimeStats::Superinstructions);
+
+        i += length - 1;
+    }
+}
+
+Value VirtualMachine::run(const CodeObject& code, const std::shared_ptr<Environment>& env) {
+
+    // стеки кадра берутся из пула: вложенные вызовы не выделяют память заново
+    Frame frame;
+
+    return execute(code, env, frame);
+}
+
+Value VirtualMachine::execute(const CodeObject& code, const std::shared_ptr<Environment>& env, Frame& frame) {
+
+    // кадры вызовов из байткода; deque не двигает кадры при росте
+    std::deque<Activation> calls;
+    std::exception_ptr error;
+
+    while (true) {
+
+        const std::size_t depth = calls.size();
+        Value result;
+
+        try {
+            result = depth == 0
+                ? executeFrame(code, env, frame, calls, error)
+                : executeFrame(*calls.back().code, calls.back().env, calls.back().frame, calls, error);
+        }
+        catch (ReturnException& e) {
+
+            // `return` из узла, вычисленного по дереву, в теле функции — как в callFunction
+            if (depth == 0) {
+                throw;
+            }
+
+            result = e.getValue();
+        }
+        catch (...) {
+
+            if (depth == 0) {
+                throw;
+            }
+
+            error = std::current_exception();
+        }
+
+        Frame& current = depth == 0 ? frame : calls[depth - 1].frame;
+
+        // кадр вызвал функцию (или заменил себя хвостовым вызовом): следующим выполняется верхний кадр
+        if (current.calling) {
+            current.calling = false;
+            continue;
+        }
+
+        if (depth == 0) {
+            return result;
+        }
+
+        RecursionLimit::leave(1 + calls.back().tailCalls);
+        calls.pop_back();
+
+        if (!error) {
+            Frame& caller = calls.empty() ? frame : calls.back().frame;
+            caller.stack->push_back(std::move(result));
+        }
+    }
+}
+
+bool VirtualMachine::runsInline(const FunctionValue& func) {
+    return func.code && !func.code->generator && !func.code->coroutine && !Tracer::active && !Profiler::enabled;
+}
+
+void VirtualMachine::enterCall(const CodeObject& code, const std::int32_t pc, Frame& frame,
+                               std::deque<Activation>& calls, const FunctionValue& func,
+                               std::shared_ptr<Environment> local) {
+
+    GarbageCollector::collectIfNeeded();
+
+    const bool tail = !calls.empty() && &calls.back().frame == &frame && func.code.get() == &code &&
+        pc < static_cast<std::int32_t>(code.code.size()) && code.code[pc].op == OpCode::ReturnValue &&
+        std::none_of(code.exceptionTable.begin(), code.exceptionTable.end(), [pc](const ExceptionEntry& entry) {
+            return pc - 1 >= entry.start && pc - 1 < entry.end;
+        });
+
+    ExecutionBudget::tick();
+    RecursionLimit::enter();
+
+    if (tail) {
+        ++calls.back().tailCalls;
+        calls.back().env = std::move(local);
+        frame.stack->clear();
+        frame.blocks->clear();
+        frame.last = Value();
+        frame.pc = 0;
+        frame.calling = true;
+        return;
+    }
+
+    frame.pc = pc;
+    frame.calling = true;
+    calls.push_back(Activation{func.code, std::move(local), Frame{}});
+}
+
+Value VirtualMachine::executeFrame(const CodeObject& code, const std::shared_ptr<Environment>& env, Frame& frame,
+                                   std::deque<Activation>& calls, std::exception_ptr& error) {
+
+    std::vector<Value>& stack = *frame.stack;
+    std::vector<LoopBlock>& blocks = *frame.blocks;
+    Value& last = frame.last;
+
+    const auto size = static_cast<std::int32_t>(code.code.size());
+    // счётчик команд в локальной переменной: в кадр он записывается только при приостановке
+    std::int32_t pc = frame.pc;
+
+    frame.suspended = false;
+
+    if (pc == 0) {
+        heatUp(code);
+    }
+
+    while (true) {
+
+        try {
+
+            // исключение вложенного вызова выбрасывается здесь: pc - 1 — адрес инструкции вызова
+            if (error) {
+                std::rethrow_exception(std::exchange(error, nullptr));
+            }
+
+            while (pc < size) {
+
+                Instruction& instr = code.code[pc++];
+
+                switch (instr.op) {
+
+                    case OpCode::LoadConst:
+                        stack.push_back(code.constants[instr.arg]);
+                        break;
+
+                    case OpCode::LoadName:
+                        stack.push_back(env->lookup(code.names[instr.arg], code.nameCaches[instr.arg2]));
+                        break;
+
+                    case OpCode::StoreName:
+                        env->set(code.names[instr.arg], pop(stack));
+                        break;
+
+                    case OpCode::LoadGlobal:
+                        stack.push_back(env->moduleGlobals()->lookup(code.names[instr.arg], code.nameCaches[instr.arg2]));
+                        break;
+
+                    case OpCode::StoreGlobal:
+                        env->setGlobal(code.names[instr.arg], pop(stack));
+                        break;
+
+                    case OpCode::LoadFast:
+                        if (const Value* local = env->slot(LocalSlot{code.layout, instr.arg})) {
+                            stack.push_back(*local);
+                        } else {
+                            stack.push_back(env->get(code.names[instr.arg2]));
+                        }
+                        break;
+
+                    case OpCode::StoreFast: {
+                        Value value = pop(stack);
+
+                        // setSlot забирает значение только при успешной записи
+                        if (!env->setSlot(LocalSlot{code.layout, instr.arg}, std::move(value))) {
+                            env->set(code.names[instr.arg2], std::move(value));
+                        }
+                        break;
+                    }
+
+                    case OpCode::LoadDeref:
+                        if (const Value* cell = env->slot(LocalSlot{code.layout, instr.arg, true})) {
+                            stack.push_back(*cell);
+                        } else {
+                            stack.push_back(env->get(code.names[instr.arg2]));
+                        }
+                        break;
+
+                    case OpCode::StoreDeref: {
+                        Value value = pop(stack);
+
+                        if (!env->setSlot(LocalSlot{code.layout, instr.arg, true}, std::move(value))) {
+                            env->set(code.names[instr.arg2], std::move(value));
+                        }
+                        break;
+                    }
+
+                    case OpCode::LoadAttr:
+                        stack.back() = code.caches[instr.arg2].getAttr(stack.back(), code.names[instr.arg]);
+                        break;
+
+                    case OpCode::BinarySubscr: {
+                        const Value idx = pop(stack);
+                        const Value obj = pop(stack);
+
+                        stack.push_back(getSubscript(obj, idx, env));
+                        break;
+                    }
+
+                    case OpCode::PopTop:
+                        last = pop(stack);
+                        break;
+
+                    case OpCode::TraceLine:
+                        // без трассировки — одна проверка флага на инструкцию исходника
+                        if (Tracer::active) {
+                            Tracer::line(code, instr.arg);
+                        }
+                        break;
+
+                    case OpCode::PrintExpr:
+                        last = pop(stack);
+
+                        if (!last.isNone()) {
+                            OutputStream& out = OutputStream::standardOutput();
+                            ReprWriter(out).repr(last);
+                            out.write(std::string_view("\n"));
+                        }
+                        break;
+
+                    case OpCode::DupTop:
+                        stack.push_back(stack.back());
+                        break;
+
+                    case OpCode::RotTwo:
+                        std::swap(stack[stack.size() - 1], stack[stack.size() - 2]);
+                        break;
+
+                    case OpCode::RotThree: {
+                        Value top = pop(stack);
+                        stack.insert(stack.end() - 2, std::move(top));
+                        break;
+                    }
+
+                    case OpCode::UnaryOp:
+                        stack.back() = UnaryOpNode::apply(
+                            static_cast<UnaryOpNode::Operation>(instr.arg), stack.back());
+                        break;
+
+                    case OpCode::BinaryOp:
+                    case OpCode::CompareOp:
+                    case OpCode::InplaceOp: {
+                        const Value r = pop(stack);
+                        const OpCode generic = instr.op;
+
+                        // специализированная форма начнёт работать со следующего выполнения
+                        if (++instr.cache >= warmup) {
+                            instr.cache = -backoff;
+                            instr.op = specialize(instr, stack.back(), r);
+                        }
+
+                        if (generic == OpCode::BinaryOp) {
+                            stack.back() = BinOpNode::apply(
+                                static_cast<BinOpNode::Operation>(instr.arg), stack.back(), r);
+                        } else if (generic == OpCode::CompareOp) {
+                            stack.back() = Value(CompareNode::compare(
+                                stack.back(), r, static_cast<CompareNode::Operation>(instr.arg)));
+                        } else {
+                            stack.back() = AugAssignNode::apply(
+                                static_cast<AugAssignNode::Operation>(instr.arg), stack.back(), r, env);
+                        }
+                        break;
+                    }
+
+                    case OpCode::BinaryOpInt:
+                    case OpCode::BinaryOpFloat:
+                    case OpCode::BinaryAddStr: {
+                        const Value r = pop(stack);
+                        const auto operation = static_cast<BinOpNode::Operation>(instr.arg2);
+
+                        if (auto result = applySpecialized(instr.op, operation, stack.back(), r)) {
+                            stack.back() = std::move(*result);
+                        } else {
+                            deoptimize(instr, OpCode::BinaryOp);
+                            stack.back() = BinOpNode::apply(operation, stack.back(), r);
+                        }
+                        break;
+                    }
+
+                    case OpCode::InplaceOpInt:
+                    case OpCode::InplaceOpFloat:
+                    case OpCode::InplaceAddStr: {
+                        const Value r = pop(stack);
+
+                        if (instr.op == OpCode::InplaceAddStr && appendInPlace(code, pc, *env, stack.back(), r)) {
+                            break;
+                        }
+
+                        if (auto result = applySpecialized(
+                                instr.op, static_cast<BinOpNode::Operation>(instr.arg2), stack.back(), r)) {
+                            stack.back() = std::move(*result);
+                        } else {
+                            deoptimize(instr, OpCode::InplaceOp);
+                            stack.back() = AugAssignNode::apply(
+                                static_cast<AugAssignNode::Operation>(instr.arg), stack.back(), r, env);
+                        }
+                        break;
+                    }
+
+                    case OpCode::CompareOpInt:
+                    case OpCode::CompareOpFloat: {
+                        const Value r = pop(stack);
+
+                        if (const auto result = compareSpecialized(instr, stack.back(), r)) {
+                            stack.back() = Value(*result);
+                        } else {
+                            deoptimize(instr, OpCode::CompareOp);
+                            stack.back() = Value(CompareNode::compare(
+                                stack.back(), r, static_cast<CompareNode::Operation>(instr.arg)));
+                        }
+                        break;
+                    }
+
+                    case OpCode::FastBinary:
+                    case OpCode::FastInplace:
+                    case OpCode::FastCompareJump: {
+                        // операнды и операция — в инструкциях последовательности за этой
+                        const Instruction& second = code.code[pc];
+                        const std::int32_t operation = code.code[pc + 1].arg;
+
+                        const Value* l = operand(code, static_cast<OpCode>(instr.cache), instr.arg, *env);
+                        const Value* r = l ? operand(code, second.op, second.arg, *env) : nullptr;
+
+                        if (l && r) {
+
+                            if (instr.op == OpCode::FastCompareJump) {
+                                if (const auto result = compareNumbers(
+                                        static_cast<CompareNode::Operation>(operation), *l, *r)) {
+                                    pc = *result ? pc + 3 : code.code[pc + 2].arg;
+                                    break;
+                                }
+                            } else if (instr.op == OpCode::FastBinary) {
+                                if (auto result = applyNumbers(static_cast<BinOpNode::Operation>(operation), *l, *r)) {
+                                    stack.push_back(std::move(*result));
+                                    pc += 2;
+                                    break;
+                                }
+                            } else if (auto result = applyNumbers(
+                                           *binaryOperation(static_cast<AugAssignNode::Operation>(operation)), *l, *r)) {
+                                // запись как у StoreFast: при global/nonlocal в кадре — по имени
+                                if (!env->setSlot(LocalSlot{code.layout, instr.arg}, std::move(*result))) {
+                                    env->set(code.names[instr.arg2], std::move(*result));
+                                }
+                                pc += 3;
+                                break;
+                            }
+                        }
+
+                        // деоптимизация: исходная инструкция выполняется с того же адреса
+                        instr.op = static_cast<OpCode>(instr.cache);
+                        instr.cache = 0;
+                        RuntimeStats::add(RuntimeStats::Deoptimizations);
+                        --pc;
+                        break;
+                    }
+
+                    case OpCode::CallFunction: {
+                        const auto args = VectorPool<Value>::acquire();
+                        args->assign(
+                            std::make_move_iterator(stack.end() - instr.arg),
+                            std::make_move_iterator(stack.end()));
+
+                        stack.erase(stack.end() - instr.arg, stack.end());
+
+                        const Value callee = pop(stack);
+
+                        if (const auto func = std::get_if<Value::FunctionPtr>(&callee.data); func && runsInline(**func)) {
+                            enterCall(code, pc, frame, calls, **func, makeCallFrame(*func, *args, {}));
+                            return Value();
+                        }
+
+                        stack.push_back(call(callee, *args, {}, env));
+                        break;
+                    }
+
+                    case OpCode::CallMethod: {
+                        const auto args = VectorPool<Value>::acquire();
+                        args->assign(
+                            std::make_move_iterator(stack.end() - instr.arg),
+                            std::make_move_iterator(stack.end()));
+
+                        stack.erase(stack.end() - instr.arg, stack.end());
+
+                        InlineCache& cache = code.caches[instr.cache];
+                        std::shared_ptr<ClassValue> owner;
+
+                        if (const Value::FunctionPtr method = cache.findMethod(stack.back(), code.names[instr.arg2], owner);
+                            method && runsInline(*method)) {
+                            std::shared_ptr<Environment> local = makeCallFrame(method, *args, {}, &stack.back(), owner);
+                            stack.pop_back();
+                            enterCall(code, pc, frame, calls, *method, std::move(local));
+                            return Value();
+                        }
+
+                        stack.back() = cache.callMethod(stack.back(), code.names[instr.arg2], *args, {}, env);
+                        break;
+                    }
+
+                    case OpCode::Jump:
+                        // обратный переход цикла — безопасная точка для сборки циклов
+                        if (instr.arg < pc) {
+                            ExecutionBudget::tick();
+                            GarbageCollector::collectIfNeeded();
+                            heatUp(code);
+                        }
+                        pc = instr.arg;
+                        break;
+
+                    case OpCode::PopJumpIfFalse:
+                        if (!pop(stack).toBool()) {
+                            pc = instr.arg;
+                        }
+                        break;
+
+                    case OpCode::PopJumpIfTrue:
+                        if (pop(stack).toBool()) {
+                            pc = instr.arg;
+                        }
+                        break;
+
+                    case OpCode::JumpIfFalseOrPop:
+                        if (!stack.back().toBool()) {
+                            pc = instr.arg;
+                        } else {
+                            stack.pop_back();
+                        }
+                        break;
+
+                    case OpCode::JumpIfTrueOrPop:
+                        if (stack.back().toBool()) {
+                            pc = instr.arg;
+                        } else {
+                            stack.pop_back();
+                        }
+                        break;
+
+                    case OpCode::SetupLoop:
+                        blocks.push_back(LoopBlock{instr.arg, instr.arg2, stack.size()});
+                        break;
+
+                    case OpCode::PopBlock:
+                        blocks.pop_back();
+                        break;
+
+                    case OpCode::BreakLoop:
+                        stack.resize(blocks.back().stackDepth);
+                        pc = blocks.back().breakTarget;
+                        break;
+
+                    case OpCode::GetIter:
+                        stack.back() = getIter(stack.back(), env);
+                        break;
+
+                    case OpCode::ForIter: {
+
+                        // range: счётчик продвигается на месте, без виртуальных вызовов и исключений
+                        if (const auto native = std::get_if<Value::IteratorPtr>(&stack.back().data)) {
+                            if (const auto range = dynamic_cast<RangeIterator*>(native->get())) {
+
+                                if (Value::SmallInt i; range->advance(i)) {
+                                    stack.emplace_back(i);
+                                } else {
+                                    pc = instr.arg;
+                                }
+                                break;
+                            }
+                        }
+
+                        Value next;
+
+                        if (iterNext(stack.back(), next, env)) {
+                            stack.push_back(std::move(next));
+                        } else {
+                            pc = instr.arg;
+                        }
+                        break;
+                    }
+
+                    case OpCode::ForIterPair: {
+
+                        Value first;
+                        Value second;
+
+                        if (IteratorValue* pairs = pairIterator(stack.back())) {
+
+                            if (pairs->nextPair(first, second)) {
+                                stack.push_back(std::move(second));
+                                stack.push_back(std::move(first));
+                            } else {
+                                pc = instr.arg;
+                            }
+                            break;
+                        }
+
+                        if (Value item; iterNext(stack.back(), item, env)) {
+                            unpackSequence(item, 2, stack, env);
+                            std::swap(stack.back(), stack[stack.size() - 2]);
+                        } else {
+                            pc = instr.arg;
+                        }
+                        break;
+                    }
+
+                    case OpCode::UnpackSequence: {
+                        const Value value = pop(stack);
+                        unpackSequence(value, instr.arg, stack, env);
+                        std::reverse(stack.end() - instr.arg, stack.end());
+                        break;
+                    }
+
+                    case OpCode::ReturnValue:
+                        return pop(stack);
+
+                    case OpCode::YieldValue:
+                        frame.pc = pc;
+                        frame.suspended = true;
+                        return pop(stack);
+
+                    case OpCode::Send: {
+                        const Value sent = pop(stack);
+                        Value next;
+                        bool produced;
+
+                        // вложенный генератор получает отправленное значение и отдаёт результат return
+                        const auto native = std::get_if<Value::IteratorPtr>(&stack.back().data);
+
+                        try {
+                            if (const auto generator = native ? dynamic_cast<GeneratorValue*>(native->get()) : nullptr) {
+
+                                produced = generator->resume(sent, next);
+
+                                if (!produced) {
+                                    next = generator->returnValue();
+                                }
+
+                            } else if (const auto awaiter = native ? dynamic_cast<FutureAwaiter*>(native->get()) : nullptr) {
+                                produced = awaiter->resume(next);
+                            } else {
+                                produced = iterNext(stack.back(), next, env);
+                            }
+                        } catch (const std::exception& error) {
+
+                            // `async for`: StopAsyncIteration из ожидания __anext__() завершает цикл
+                            if (instr.arg2 == 0 || !isStopAsyncIteration(error)) {
+                                throw;
+                            }
+
+                            stack.pop_back();
+                            pc = instr.arg2;
+                            break;
+                        }
+
+                        if (produced) {
+                            stack.push_back(std::move(next));
+                        } else {
+                            stack.back() = std::move(next);
+                            pc = instr.arg;
+                        }
+                        break;
+                    }
+
+                    case OpCode::GetAwaitable:
+                        stack.back() = getAwaitable(stack.back(), env);
+                        break;
+
+                    case OpCode::GetAIter:
+                        stack.back() = getAsyncIter(stack.back(), env);
+                        break;
+
+                    case OpCode::GetANext:
+                        stack.push_back(getAwaitable(callMethod(stack.back(), "__anext__", {}, {}, env), env));
+                        break;
+
+                    case OpCode::EvalNode:
+                        stack.push_back(code.nodes[instr.arg]->eval(env));
+                        break;
+
+                    case OpCode::BuildString: {
+                        const auto& formatted = static_cast<const FormattedStringNode&>(*code.nodes[instr.arg]);
+                        Value result = formatted.build(stack.data() + stack.size() - instr.arg2);
+
+                        stack.erase(stack.end() - instr.arg2, stack.end());
+                        stack.push_back(std::move(result));
+                        break;
+                    }
+
+                    case OpCode::BuildConcat: {
+                        Value* pieces = stack.data() + stack.size() - instr.arg;
+                        ConcatNode::step(pieces, instr.arg);
+
+                        if (instr.arg2) {
+                            Value result = ConcatNode::finish(pieces, instr.arg);
+
+                            stack.erase(stack.end() - instr.arg, stack.end());
+                            stack.push_back(std::move(result));
+                        }
+                        break;
+                    }
+
+                    case OpCode::Raise: {
+                        const Value cause = instr.arg ? pop(stack) : Value();
+                        const Value exception = pop(stack);
+                        PyException::raise(exception, cause);
+                    }
+
+                    case OpCode::Reraise:
+                        PyException::raise(stack[instr.arg]);
+
+                    case OpCode::MatchException: {
+                        const Value type = pop(stack);
+                        stack.emplace_back(PyException::matches(stack.back(), type));
+                        break;
+                    }
+                }
+            }
+
+            return last;
+        }
+        catch ([[maybe_unused]] const BreakException& e) {
+
+            if (blocks.empty()) {
+                throw;
+            }
+
+            stack.resize(blocks.back().stackDepth);
+            pc = blocks.back().breakTarget;
+        }
+        catch ([[maybe_unused]] const ContinueException& e) {
+
+            if (blocks.empty()) {
+                throw;
+            }
+
+            stack.resize(blocks.back().stackDepth);
+            pc = blocks.back().continueTarget;
+        }
+        catch ([[maybe_unused]] const ReturnException& e) {
+            throw;
+        }
+        catch (const std::exception& e) {
+
+            if (Tracer::active) {
+                Tracer::exception(code, e);
+            }
+
+            // обработчик ищется только после исключения: вход в try ничего не стоил
+            const std::int32_t at = pc - 1;
+            const auto& table = code.exceptionTable;
+
+            const auto entry = std::find_if(table.begin(), table.end(), [at](const ExceptionEntry& candidate) {
+                return at >= candidate.start && at < candidate.end;
+            });
+
+            if (entry == table.end()) {
+                throw;
+            }
+
+            stack.resize(entry->stackDepth);
+            blocks.resize(entry->blockDepth);
+            stack.push_back(PyException::toException(e));
+            pc = entry->target;
+        }
+    }
+}
@@ -0,0 +1,39 @@
+//
+// Created by semyo on 15.10.2026.
+//
+#include "ZipIterator.h"
+
+#include "CallRuntime.h"
+#include "TupleValue.h"
+
+ZipIterator::ZipIterator(std::vector<Value> sources, std::shared_ptr<Environment> env)
+    : LookaheadIterator(std::move(env)), sources(std::move(sources)) {}
+
+bool ZipIterator::produce(Value& out) {
+
+    // zip() без аргументов пуст, а не бесконечен
+    if (sources.empty()) {
+        return false;
+    }
+
+    std::vector<Value> items = TupleValue::acquireItems(sources.size());
+    items.resize(sources.size());
+
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        if (!iterNext(sources[i], items[i], env)) {
+            return false;
+        }
+    }
+
+    out = TupleValue::make(std::move(items));
+
+    return true;
+}
+
+bool ZipIterator::producePair(Value& first, Value& second) {
+    return iterNext(sources[0], first, env) && iterNext(sources[1], second, env);
+}
+
+QString ZipIterator::getTypeName() const {
+    return "zip";
+}
@@ -3,6 +3,8 @@ import os
 import sys
 import pytest
 import platform
+import socket
+import threading
 
 ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
 
@@ -802,6 +804,18 @@ def run_cppython(cmds: str | list[str]) -> str:
 
     ("hash((1, True)) == hash((1.0, 1))", "True"),
 
+    # числовой хеш по модулю 2^61 - 1, как в CPython
+    ("(hash(-1), hash(2**61), hash(2**61 - 1), hash(-2**64), hash(10**40))", "(-2, 1, 0, -8, 1388497483929617590)"),
+    ("(hash(1.5), hash(-0.25), hash(1e300), hash(2.0**70) == hash(2**70))", "(1152921504606846977, -576460752303423488, 1224995262755759164, True)"),
+    (["d = {2**64: 'a', 2**64 + 1: 'b', 1: 'c'}",
+      "(d[2**64], d[18446744073709551617], d[1.0], d[True])"], "('a', 'b', 'c', 'c')"),
+
+    # литералы-идентификаторы интернируются
+    (["a = 'name'",
+      "b = 'name'",
+      "d = {a: 1, 'x y': 2}",
+      "(a is b, d[b], d['x y'], d['na' + 'me'])"], "(True, 1, 2, 1)"),
+
     # tuple.__hash__
     ("().__hash__() == ().__hash__()", "True"),
     ("(1,).__hash__() == (1,).__hash__()", "True"),
@@ -1511,6 +1525,25 @@ def run_cppython(cmds: str | list[str]) -> str:
     # multiple spaces
     ("'  a   b  c '.split()", "['a', 'b', 'c']"),
 
+    # whitespace split с maxsplit оставляет хвост как есть
+    ("('a b  c  '.split(None, 1), '  a b c  '.rsplit(None, 1), ' a '.split(None, 0), 'aaa'.rsplit('aa'), 'a,b,,c'.rsplit(',', 2))",
+     "(['a', 'b  c  '], ['  a b', 'c'], ['a '], ['a', ''], ['a,b', '', 'c'])"),
+    ("(b'  a b c '.rsplit(None, 1), b'aaa'.rsplit(b'aa'), bytearray(b' a  b ').split(), bytearray(b'a b c').rsplit(None, 1))",
+     "([b'  a b', b'c'], [b'a', b''], [bytearray(b'a'), bytearray(b'b')], [bytearray(b'a b'), bytearray(b'c')])"),
+
+    # ASCII и не-ASCII строки проходят разными путями
+    (["line = '  GET /index.html 200\\t 512  '",
+      "(line.split(), line.upper(), 'ÀbC'.lower(), line.find('200', 3, 30), line.count(' '))"],
+     "(['GET', '/index.html', '200', '512'], '  GET /INDEX.HTML 200\\t 512  ', 'àbc', 18, 7)"),
+    ("('123'.isdigit(), ''.isdigit(), 'ab1'.isalnum(), 'кот'.isalpha(), 'abc'.endswith('b', 0, 2))", "(True, False, True, True, True)"),
+
+    # длинные срезы ссылаются на буфер исходной строки
+    (["line = 'GET /index.html HTTP/1.1 200 host=example.org agent=curl/8.0'",
+      "rest = line[4:]",
+      "words = rest.split('=')",
+      "(len(rest), rest[10:20], {rest: 1}[line[4:]], words[1][-7:], line.partition(' HTTP')[2][:8], rest < line)"],
+     "(56, 'l HTTP/1.1', 1, 'g agent', '/1.1 200', True)"),
+
     # separator split
     ("'a,b,c'.split(',')", "['a', 'b', 'c']"),
 
@@ -3112,6 +3145,14 @@ def run_cppython(cmds: str | list[str]) -> str:
     ("b'aaaa'.count(b'aaa')", "1"),
 
     ("b'ababa'.count(b'aba')", "1"),
+
+    # поиск по диапазону без копии среза
+    (["d = b'GET /a HTTP/1.1 Host: x Host: y'",
+      "(d.find(b'Host'), d.rfind(b'Host'), d.find(b'', 100), d.rfind(b''), d.count(b'', 3, 1), d.find(b'x', -10))"],
+     "(16, 24, -1, 31, 0, 22)"),
+    (["ba = bytearray(b'Host: x Host: y')",
+      "(ba.find(b'Host', 3), ba.rfind(b'Host', 0, 10), bytearray(b'abcdef').find(b'f', 5, 3), b'abc'.replace(b'', b'-', 2), ba.replace(b'Host', b'H', 1))"],
+     "(8, 0, -1, b'-a-bc', bytearray(b'H: x Host: y'))"),
     ("b'ababa'.count(b'ba')", "2"),
 
     ("b''.count(b'a')", "0"),
@@ -6135,6 +6176,22 @@ def run_cppython(cmds: str | list[str]) -> str:
 
     ("[] is []", "False"),
 
+    # переход малых целых в длинную арифметику при переполнении
+    ("9223372036854775807 + 1", "9223372036854775808"),
+    ("-9223372036854775807 - 2", "-9223372036854775809"),
+    ("3037000500 * 3037000500", "9223372037000250000"),
+    ("-(-9223372036854775807 - 1)", "9223372036854775808"),
+    ("2 ** 64 - 2 ** 64 + 5", "5"),
+    ("-7 // 2", "-4"),
+
+    # float — IEEE double с кратчайшим repr, как в CPython
+    ("0.1 + 0.2", "0.30000000000000004"),
+    ("1 / 3", "0.3333333333333333"),
+    ("1e16", "1e+16"),
+    ("1.5e-7", "1.5e-07"),
+    ("7.5 % -2", "-0.5"),
+    ("-7.5 // 2", "-4.0"),
+
 ])
 
 def test_single_line_expressions(expr, expected):
@@ -6748,6 +6805,98 @@ if _result is not None:
       "",
       "C().f()"], "3"),
 
+    # ромбовидное наследование: super() идёт по C3 MRO
+    (["class A:",
+      "    def f(self):",
+      "        return 'A'",
+      "",
+      "class B(A):",
+      "    def f(self):",
+      "        return 'B' + super().f()",
+      "",
+      "class C(A):",
+      "    def f(self):",
+      "        return 'C' + super().f()",
+      "",
+      "class D(B, C):",
+      "    def f(self):",
+      "        return 'D' + super().f()",
+      "",
+      "D().f()"], "'DBCA'"),
+
+    # изменение атрибута базового класса видно через уже искавший его подкласс
+    (["class A:",
+      "    x = 1",
+      "",
+      "class B(A):",
+      "    pass",
+      "",
+      "b = B()",
+      "first = b.x",
+      "A.x = 2",
+      "(first, b.x)"], "(1, 2)"),
+
+    # одно место вызова для разных классов, поле экземпляра и замена метода после прогрева
+    (["class A:",
+      "    def f(self):",
+      "        return 1",
+      "",
+      "class B(A):",
+      "    def f(self):",
+      "        return 2",
+      "",
+      "def run(objs):",
+      "    total = 0",
+      "    for o in objs:",
+      "        total = total * 10 + o.f()",
+      "    return total",
+      "",
+      "a = A()",
+      "first = run([a, B(), a])",
+      "a.f = lambda: 3",
+      "A.f = lambda self: 4",
+      "(first, run([a, B(), A()]))"], "(121, 324)"),
+
+    # поля в разном порядке и больше полей, чем помещается в форму экземпляра
+    (["class P:",
+      "    def __init__(self, n):",
+      "        i = 0",
+      "        while i < n:",
+      "            setattr(self, 'f' + str(i), i)",
+      "            i += 1",
+      "",
+      "big = P(40)",
+      "big.f35 = 100",
+      "a = P(0)",
+      "a.x = 1",
+      "a.y = 2",
+      "b = P(0)",
+      "b.y = 3",
+      "b.x = 4",
+      "(big.f0, big.f39, big.f35, a.x, a.y, b.x, b.y)"], "(0, 39, 100, 1, 2, 4, 3)"),
+
+    # __slots__: объявленные поля работают, остальные запрещены, подкласс без __slots__ свободен
+    (["class P:",
+      "    __slots__ = ('x', 'y')",
+      "    def __init__(self, x):",
+      "        self.x = x",
+      "",
+      "class Q(P):",
+      "    pass",
+      "",
+      "p = P(1)",
+      "p.y = 2",
+      "q = Q(3)",
+      "q.z = 4",
+      "(p.x, p.y, q.x, q.z)"], "(1, 2, 3, 4)"),
+
+    (["class P:",
+      "    __slots__ = ['x', 'y']",
+      "",
+      "p = P()",
+      "p.x = 1",
+      "(hasattr(p, 'x'), hasattr(p, 'y'))"], "(True, False)"),
+
     # shadowing метода полем
     (["class A:",
       "    def f(self):",
@@ -8091,6 +8240,32 @@ if _result is not None:
       "a.popitem()",
       "a"], "{}"),
 
+    # popitem после удаления последнего и повторная вставка
+    (["a = {'x': 1, 'y': 2, 'z': 3}",
+      "del a['z']",
+      "a.popitem()",
+      "a['z'] = 4",
+      "a"], "{'x': 1, 'z': 4}"),
+
+    # скользящее окно: множество удалений и вставок сохраняет порядок
+    (["d = {}",
+      "for i in [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12]:",
+      "    d[i] = i * i",
+      "    if i > 3:",
+      "        del d[i - 3]",
+      "",
+      "(list(d.items()), list(reversed(d)))"], "([(10, 100), (11, 121), (12, 144)], [12, 11, 10])"),
+
+    # повторный поиск по одним и тем же неизменяемым ключам
+    (["k = 'key' * 50",
+      "t = (k, (1, 2), b'xy', frozenset({3}))",
+      "d = {k: 1, t: 2}",
+      "n = 0",
+      "for i in [1, 2, 3, 4, 5]:",
+      "    n = n + d[k] + d[t]",
+      "",
+      "(n, d[('key' * 50, (1, 2), b'xy', frozenset({3}))], hash(t) == hash(t))"], "(15, 2, True)"),
+
     # базовый keys()
     (["a = {'x': 1, 'y': 2}",
       "a.keys()"],
@@ -8600,6 +8775,14 @@ if _result is not None:
       "a.discard(999)",
       "a"], "{1}"),
 
+    # массовое удаление и повторное добавление
+    (["a = {1, 2, 3, 4, 5, 6, 7, 8}",
+      "for x in [2, 4, 6, 8, 1]:",
+      "    a.discard(x)",
+      "",
+      "a.add(1)",
+      "(len(a), 1 in a, 2 in a, a - {3} == {1, 5, 7}, a & {5, 7, 9} == {5, 7})"], "(4, True, False, True, True)"),
+
     # базовый union
     (["a = {1, 2}",
       "b = {2, 3}",
@@ -10778,6 +10961,121 @@ if _result is not None:
       "b=[1]",
       "a is not b"], "True"),
 
+    # байткод: break/continue внутри for и цепочки сравнений
+    (["s = 0",
+      "for x in [1, 2, 3, 4, 5, 6]:",
+      "    if x == 2:",
+      "        continue",
+      "    if x == 5:",
+      "        break",
+      "    s += x",
+      "",
+      "s"], "8"),
+
+    (["n = 0",
+      "i = 0",
+      "while i < 10:",
+      "    i += 1",
+      "    if 2 < i <= 7:",
+      "        n = n + i",
+      "",
+      "n"], "25"),
+
+    (["def f():",
+      "    t = 0",
+      "    for i in [1, 2, 3]:",
+      "        while True:",
+      "            t += i",
+      "            break",
+      "    return t",
+      "",
+      "f()"], "6"),
+
+    # локальные переменные функций в слотах кадра
+    (["def outer():",
+      "    x = 1",
+      "    def show():",
+      "        return x",
+      "    x = 2",
+      "    return show()",
+      "",
+      "outer()"], "2"),
+
+    (["def scale(a, b):",
+      "    s = 0",
+      "    for i in [1, 2, 3]:",
+      "        s += i * b - a",
+      "    return s",
+      "",
+      "scale(b=2, a=1)"], "9"),
+
+    # return/continue в теле функции — переходы байткода
+    (["def find(items, target):",
+      "    for i in items:",
+      "        while True:",
+      "            if i == target:",
+      "                return i * 10",
+      "            break",
+      "    return -1",
+      "",
+      "find([1, 2, 3], 2)"], "20"),
+
+    (["def odd_sum(n):",
+      "    i = 0",
+      "    s = 0",
+      "    while i < n:",
+      "        i += 1",
+      "        if i % 2 == 0:",
+      "            continue",
+      "        s += i",
+      "    return s",
+      "",
+      "odd_sum(10)"], "25"),
+
+    (["def noop():",
+      "    x = 1",
+      "",
+      "print(noop())"], "None"),
+
+    # for по встроенным итераторам и по пользовательскому __next__
+    (["class Doubler:",
+      "    def __init__(self, items):",
+      "        self.it = iter(items)",
+      "    def __iter__(self):",
+      "        return self",
+      "    def __next__(self):",
+      "        return next(self.it) * 2",
+      "",
+      "t = 0",
+      "for v in Doubler([1, 2, 3]):",
+      "    t += v",
+      "",
+      "t"], "12"),
+
+    (["keys = []",
+      "for k in {'a': 1, 'b': 2}:",
+      "    keys = keys + [k]",
+      "",
+      "keys"], "['a', 'b']"),
+
+    # прямой вызов методов списка и явно взятый метод
+    (["lst = []",
+      "add = lst.append",
+      "for x in [1, 2]:",
+      "    add(x)",
+      "    lst.append(x * 10)",
+      "",
+      "lst"], "[1, 10, 2, 20]"),
+
+    # sys.getsizeof: неотрицательное int, растущее с длиной контейнера
+    (["import sys",
+      "s = sys.getsizeof([0] * 100)",
+      "(type(s) is int, s >= 0, s > sys.getsizeof([]))"], "(True, True, True)"),
+
+    (["import sys",
+      "(sys.getsizeof('a' * 1000) > sys.getsizeof(''), sys.getsizeof((1, 2, 3)) > sys.getsizeof(()),"
+      " sys.getsizeof(b'x' * 100) > sys.getsizeof(b''), sys.getsizeof(7) >= 0)"], "(True, True, True, True)"),
+
 
 ])
 
@@ -10805,4 +11103,4118 @@ def test_multiline_expressions(commands, expected):
     py = run_cpython(commands)
     assert my == expected, f"cppython: {commands!r} -> {my!r}, expected: {expected!r}"
     assert py == expected, f"CPython: {commands!r} -> {py!r}, expected: {expected!r}"
-    assert my == py,     f"Mismatch: cppython={my!r} vs CPython={py!r}"
\ No newline at end of file
+    assert my == py,     f"Mismatch: cppython={my!r} vs CPython={py!r}"
+
+def run_script(interpreter: str, source: str, tmp_path) -> str:
+    """
+    Записывает исходный код во временный файл и выполняет его интерпретатором
+    как скрипт (без REPL) во временном каталоге, возвращая весь стандартный вывод.
+
+    :param interpreter: Путь к исполняемому файлу интерпретатора.
+    :param source: Текст скрипта.
+    :param tmp_path: Временный каталог pytest.
+    :return: Стандартный вывод процесса.
+    """
+    script = tmp_path / "script.py"
+    script.write_text(source, encoding="utf-8")
+
+    p = subprocess.run(
+        [interpreter, str(script)],
+        cwd=tmp_path,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        timeout=5,
+    )
+
+    return p.stdout.decode("utf-8", "ignore")
+
+
+@pytest.mark.parametrize("source,expected", [
+    # результаты выражений не печатаются, комментарии и пустые строки внутри блоков
+    ("# comment\n"
+     "x = 1  # trailing\n"
+     "x + 1\n"
+     "\n"
+     "def f(a):\n"
+     "    # inside\n"
+     "    b = a * 2\n"
+     "\n"
+     "    return b + 1\n"
+     "\n"
+     "for i in [1, 2]:\n"
+     "    print(i, f(i))\n"
+     "print('end')\n",
+     "1 3\n2 5\nend\n"),
+
+    # классы и циклы без завершающего перевода строки
+    ("class C:\n"
+     "    z = 3\n"
+     "    def m(self):\n"
+     "        return self.z\n"
+     "s = 0\n"
+     "while s < 4:\n"
+     "    s += C().m()\n"
+     "print(s)",
+     "6\n"),
+
+    # имена и литералы вне ASCII, escape-последовательности, составные операторы
+    ("имя = 'привет'\n"
+     "n = 2\n"
+     "n **= 3\n"
+     "n //= 3\n"
+     "print(имя, n, '\\x41\\tb', len('\\xe9'))\n",
+     "привет 2 A\tb 1\n"),
+
+    # константные выражения, проверки вхождения в литералы, ветви с константным условием
+    ("x = 3\n"
+     "print(2 ** 10 - 1, -(4 + 4), 'ab' * 3, (1, 2) + (3,), 1 < 2 < 3)\n"
+     "print(x in {1, 2, 3}, x not in [4, 5], x in (1, 2), 0 and x, 0 or 'y')\n"
+     "if 1 > 2:\n"
+     "    print('dead')\n"
+     "elif x:\n"
+     "    print('elif')\n"
+     "if True:\n"
+     "    print('live')\n"
+     "else:\n"
+     "    print('dead')\n"
+     "def f():\n"
+     "    return 1 / 0\n"
+     "print(len('x' * 5000), 2 ** 200 > 0)\n",
+     "1023 -8 ababab (1, 2, 3) True\nTrue True False 0 y\nelif\nlive\n5000 True\n"),
+
+    # арифметика и сравнения в цикле меняют типы операндов после специализации
+    ("def add(a, b):\n"
+     "    return a + b\n"
+     "def less(a, b):\n"
+     "    return a < b\n"
+     "i = 0\n"
+     "total = 0\n"
+     "while less(i, 20):\n"
+     "    total = add(total, i)\n"
+     "    i += 1\n"
+     "print(add(2 ** 62, 2 ** 62), add(1.5, 2), add('a', 'b'), add([1], [2]))\n"
+     "s = 0\n"
+     "t = ''\n"
+     "for x in [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12]:\n"
+     "    s += x\n"
+     "    t += 'x'\n"
+     "s += 0.5\n"
+     "print(s, len(t), less(1, 2), less(2.5, 1.0), less('a', 'b'), total)\n",
+     "9223372036854775808 3.5 ab [1, 2]\n78.5 12 True False True 190\n"),
+
+    # операторы пользовательских классов и отражённые методы через NotImplemented
+    ("class V:\n"
+     "    def __init__(self, x):\n"
+     "        self.x = x\n"
+     "    def __add__(self, other):\n"
+     "        if hasattr(other, 'x'):\n"
+     "            return V(self.x + other.x)\n"
+     "        return NotImplemented\n"
+     "    def __radd__(self, other):\n"
+     "        return V(other + self.x)\n"
+     "    def __mul__(self, k):\n"
+     "        return V(self.x * k)\n"
+     "print((V(1) + V(2)).x, (10 + V(5)).x, ('a' + V('b')).x, (V(3) * 4).x)\n"
+     "print(3 * [1, 2], {1, 2} | {3}, V(1).__add__(2) is NotImplemented, NotImplemented)\n",
+     "3 15 ab 12\n[1, 2, 1, 2, 1, 2] {1, 2, 3} True NotImplemented\n"),
+
+    # ленивый range: длина, индексы, срезы и in без построения элементов
+    ("r = range(10, 0, -3)\n"
+     "print(r, len(r), list(r), r[1], r[-1], r[1:], 4 in r, 5 in r, 7.0 in r, r.index(4))\n"
+     "total = 0\n"
+     "for i in range(5):\n"
+     "    total += i\n"
+     "print(total, list(range(3)), range(0), not range(0), range(2, 8)[::-1], list(reversed(range(4))))\n"
+     "print(range(0, 3) == range(0, 3, 1), range(0) == range(5, 2), range(1, 10, 2).count(7), len(range(-5, 5, 2)))\n",
+     "range(10, 0, -3) 4 [10, 7, 4, 1] 7 1 range(7, -2, -3) True False True 2\n"
+     "10 [0, 1, 2] range(0, 0) True range(7, 1, -1) [3, 2, 1, 0]\n"
+     "True True 1 5\n"),
+
+    # встроенные свёртки и ленивые комбинаторы
+    ("words = ['pear', 'fig', 'apple']\n"
+     "print(sum([1, 2, 3]), sum(range(5), 10), min(words), max(words, key=len), min([], default=0), max(3, 7, 5))\n"
+     "print(any([0, 2]), all([1, 0]), all([]), sorted(words), sorted([3, 1, 2], reverse=True))\n"
+     "print(list(enumerate(words, 1)), list(zip([1, 2, 3], 'ab')), list(map(lambda a, b: a * b, [1, 2], [3, 4])))\n"
+     "print(list(filter(lambda w: len(w) > 3, words)), list(filter(None, [0, 1, '', 'x'])), sorted(words, key=len))\n",
+     "6 20 apple apple 0 7\n"
+     "True False True ['apple', 'fig', 'pear'] [3, 2, 1]\n"
+     "[(1, 'pear'), (2, 'fig'), (3, 'apple')] [(1, 'a'), (2, 'b')] [3, 8]\n"
+     "['pear', 'apple'] [1, 'x'] ['fig', 'pear', 'apple']\n"),
+
+    # устойчивая сортировка: равные ключи сохраняют порядок, в том числе при reverse
+    ("records = [('b', 2), ('a', 2), ('c', 1), ('d', 3), ('e', 1)]\n"
+     "records.sort(key=lambda r: r[1])\n"
+     "print(records)\n"
+     "print(sorted(records, key=lambda r: r[1], reverse=True))\n"
+     "print(sorted([3.5, -1.0, 2.25]), sorted(['b', 'a', 'C']), sorted(list(range(100, 0, -1)))[:5], sorted([1, 2.5, 0]))\n",
+     "[('c', 1), ('e', 1), ('b', 2), ('a', 2), ('d', 3)]\n"
+     "[('d', 3), ('b', 2), ('a', 2), ('c', 1), ('e', 1)]\n"
+     "[-1.0, 2.25, 3.5] ['C', 'a', 'b'] [1, 2, 3, 4, 5] [0, 1, 2.5]\n"),
+
+    # присваивание и удаление срезов на месте, границы срезов как в CPython
+    ("a = list(range(10))\n"
+     "a[2:5] = ['x']\n"
+     "print(a)\n"
+     "a[1:1] = (7, 8)\n"
+     "print(a)\n"
+     "del a[::3]\n"
+     "print(a)\n"
+     "a[::-2] = range(3)\n"
+     "print(a)\n"
+     "b = [1, 2, 3]\n"
+     "b[:] = b + b\n"
+     "del b[-2:]\n"
+     "print(b, [0, 1, 2, 3, 4][4:-6:-1], [0, 1, 2][5:-1:-1])\n",
+     "[0, 1, 'x', 5, 6, 7, 8, 9]\n"
+     "[0, 7, 8, 1, 'x', 5, 6, 7, 8, 9]\n"
+     "[7, 8, 'x', 5, 7, 8]\n"
+     "[7, 2, 'x', 1, 7, 0]\n"
+     "[1, 2, 3, 1] [4, 3, 2, 1, 0] []\n"),
+
+    # короткие кортежи на переиспользуемых буферах, общий пустой кортеж
+    ("d = {'a': 1, 'b': 2}\n"
+     "pairs = []\n"
+     "for item in d.items():\n"
+     "    pairs.append(item)\n"
+     "print(pairs, list(enumerate('xy')), d.popitem(), d)\n"
+     "print(() is (), tuple([]) is (), (1, 2)[5:] is (), (1, 2) * 0 is (), tuple('abc'))\n",
+     "[('a', 1), ('b', 2)] [(0, 'x'), (1, 'y')] ('b', 2) {'a': 1}\n"
+     "True True True True ('a', 'b', 'c')\n"),
+
+    # генераторы: ленивые конвейеры, return как результат yield from, send
+    ("def count(n):\n"
+     "    i = 0\n"
+     "    while i < n:\n"
+     "        yield i\n"
+     "        i += 1\n"
+     "    return 'done'\n"
+     "\n"
+     "def squares(source):\n"
+     "    for x in source:\n"
+     "        yield x * x\n"
+     "\n"
+     "def chain(a, b):\n"
+     "    r = yield from a\n"
+     "    print('inner returned', r)\n"
+     "    yield from b\n"
+     "\n"
+     "print(list(count(3)), sum(squares(count(4))))\n"
+     "print(list(chain(count(2), ['a', 'b'])))\n"
+     "\n"
+     "def echo():\n"
+     "    received = yield 'ready'\n"
+     "    while received != 'stop':\n"
+     "        received = yield received * 2\n"
+     "\n"
+     "g = echo()\n"
+     "print(next(g), g.send(5), g.send('ab'))\n"
+     "total = 0\n"
+     "for v in squares(range(100000)):\n"
+     "    total += v\n"
+     "print(total)\n",
+     "[0, 1, 2] 14\n"
+     "inner returned done\n"
+     "[0, 1, 'a', 'b']\n"
+     "ready 10 abab\n"
+     "333328333350000\n"),
+    # включения и генераторные выражения: переменные циклов не попадают в объемлющую область
+    ("def f(n):\n"
+     "    xs = [i * i for i in range(n) if i % 2 == 0]\n"
+     "    pairs = [(a, b) for a in range(3) for b in 'xy' if a != 1]\n"
+     "    return (xs, pairs)\n"
+     "\n"
+     "x = 'outer'\n"
+     "print(f(7), x)\n"
+     "d = {k: v * 2 for k, v in {'a': 1, 'b': 2}.items()}\n"
+     "print(d, sorted({c for c in 'mississippi'}))\n"
+     "g = (n * 3 for n in [1, 2, 3])\n"
+     "print(next(g), list(g), sum(n for n in range(10) if n > 4))\n"
+     "print([[j for j in range(i)] for i in range(4)], x)\n",
+     "([0, 4, 16, 36], [(0, 'x'), (0, 'y'), (2, 'x'), (2, 'y')]) outer\n"
+     "{'a': 2, 'b': 4} ['i', 'm', 'p', 's']\n"
+     "3 [6, 9] 35\n"
+     "[[], [0], [0, 1], [0, 1, 2]] outer\n"),
+    # распаковка в цикле for и в присваивании; пары dict.items()/enumerate/zip без кортежей
+    ("def walk(d):\n"
+     "    total = 0\n"
+     "    for k, v in d.items():\n"
+     "        total += v\n"
+     "    for i, name in enumerate(['a', 'b'], 1):\n"
+     "        print(i, name)\n"
+     "    for x, y, z in [(1, 2, 3), [4, 5, 6]]:\n"
+     "        total += x * y * z\n"
+     "    return total\n"
+     "\n"
+     "print(walk({'p': 1, 'q': 2}))\n"
+     "a, b = 1, 2\n"
+     "a, b = b, a\n"
+     "print(a, b)\n"
+     "for n, c in zip(range(3), 'xyz'):\n"
+     "    print(n, c)\n"
+     "first, second = 'hi'\n"
+     "print(first, second, {v: k for k, v in {'one': 1}.items()})\n",
+     "1 a\n"
+     "2 b\n"
+     "129\n"
+     "2 1\n"
+     "0 x\n"
+     "1 y\n"
+     "2 z\n"
+     "h i {1: 'one'}\n"),
+    # print: sep/end=None, file= с методом write, не-ASCII в UTF-8
+    ("class Sink:\n"
+     "    def __init__(self):\n"
+     "        self.parts = []\n"
+     "\n"
+     "    def write(self, text):\n"
+     "        self.parts.append(text)\n"
+     "\n"
+     "sink = Sink()\n"
+     "print(1, 'a', [2], sep='-', end='!', file=sink)\n"
+     "print(sink.parts)\n"
+     "print('x', 'y', sep=None, end=None)\n"
+     "print('é', 'ж', '中', '😀', sep='|', file=None)\n",
+     "['1', '-', 'a', '-', '[2]', '!']\n"
+     "x y\n"
+     "é|ж|中|😀\n"),
+    # open(): запись, построчное чтение с переводом \r\n, read(size), двоичный режим и readinto
+    ("f = open('data.txt', 'w')\n"
+     "print(f.write('alpha\\nbeta\\r\\ngamma'))\n"
+     "f.close()\n"
+     "print(f.closed)\n"
+     "f = open('data.txt')\n"
+     "print(f.name, f.mode)\n"
+     "for line in f:\n"
+     "    print(repr(line))\n"
+     "f.close()\n"
+     "f = open('data.txt', encoding='utf-8')\n"
+     "print(repr(f.readline()), repr(f.read(3)), repr(f.read()))\n"
+     "print(repr(f.read()))\n"
+     "f.close()\n"
+     "f = open('data.txt', 'rb')\n"
+     "print(f.readlines())\n"
+     "f.close()\n"
+     "b = bytearray(4)\n"
+     "f = open('data.txt', 'rb')\n"
+     "print(f.readinto(b), b)\n"
+     "f.close()\n"
+     "f = open('data.txt', 'a')\n"
+     "f.write('\\ndelta\\n')\n"
+     "f.close()\n"
+     "f = open('data.txt')\n"
+     "print(len(f.readlines()))\n"
+     "f.close()\n",
+     "17\n"
+     "True\n"
+     "data.txt r\n"
+     "'alpha\\n'\n"
+     "'beta\\n'\n"
+     "'gamma'\n"
+     "'alpha\\n' 'bet' 'a\\ngamma'\n"
+     "''\n"
+     "[b'alpha\\n', b'beta\\r\\n', b'gamma']\n"
+     "4 bytearray(b'alph')\n"
+     "4\n"),
+    # try/except/else/finally, raise и повторный raise, собственные исключения, выход из try через return и break
+    ("class AppError(Exception):\n"
+     "    def __init__(self, code, text):\n"
+     "        super().__init__(code, text)\n"
+     "        self.code = code\n"
+     "\n"
+     "def divide(a, b):\n"
+     "    try:\n"
+     "        result = a // b\n"
+     "    except ZeroDivisionError as e:\n"
+     "        print(\"caught:\", e)\n"
+     "        return None\n"
+     "    else:\n"
+     "        print(\"ok\")\n"
+     "        return result\n"
+     "    finally:\n"
+     "        print(\"finally\", a, b)\n"
+     "\n"
+     "print(divide(7, 2))\n"
+     "print(divide(1, 0))\n"
+     "\n"
+     "try:\n"
+     "    raise AppError(404, \"missing\")\n"
+     "except (KeyError, AppError) as e:\n"
+     "    print(e.code, e.args, repr(e), e)\n"
+     "\n"
+     "try:\n"
+     "    {}[\"k\"]\n"
+     "except LookupError as e:\n"
+     "    print(\"lookup\", str(e))\n"
+     "\n"
+     "def check(n):\n"
+     "    if n < 0:\n"
+     "        raise ValueError(\"negative\")\n"
+     "    return n\n"
+     "\n"
+     "for n in [1, -1, 2]:\n"
+     "    try:\n"
+     "        check(n)\n"
+     "    except ValueError as e:\n"
+     "        print(\"bad\", e)\n"
+     "        continue\n"
+     "    print(\"good\", n)\n"
+     "\n"
+     "def reraise():\n"
+     "    try:\n"
+     "        undefined_name\n"
+     "    except NameError:\n"
+     "        print(\"inner\")\n"
+     "        raise\n"
+     "\n"
+     "try:\n"
+     "    reraise()\n"
+     "except Exception as e:\n"
+     "    print(\"outer\", e)\n"
+     "\n"
+     "for i in range(5):\n"
+     "    try:\n"
+     "        if i == 3:\n"
+     "            break\n"
+     "    finally:\n"
+     "        print(\"tick\", i)\n"
+     "\n"
+     "class Countdown:\n"
+     "    def __init__(self, n):\n"
+     "        self.n = n\n"
+     "    def __iter__(self):\n"
+     "        return self\n"
+     "    def __next__(self):\n"
+     "        if self.n == 0:\n"
+     "            raise StopIteration\n"
+     "        self.n -= 1\n"
+     "        return self.n\n"
+     "\n"
+     "print(list(Countdown(3)))\n"
+     "\n"
+     "try:\n"
+     "    try:\n"
+     "        raise KeyError(\"a\")\n"
+     "    finally:\n"
+     "        print(\"cleanup\")\n"
+     "except KeyError as e:\n"
+     "    print(\"key\", repr(e))\n"
+     "\n"
+     "try:\n"
+     "    raise RuntimeError(\"first\") from ValueError(\"cause\")\n"
+     "except RuntimeError as e:\n"
+     "    print(e, repr(e.__cause__))\n",
+     "ok\n"
+     "finally 7 2\n"
+     "3\n"
+     "caught: integer division or modulo by zero\n"
+     "finally 1 0\n"
+     "None\n"
+     "404 (404, 'missing') AppError(404, 'missing') (404, 'missing')\n"
+     "lookup 'k'\n"
+     "good 1\n"
+     "bad negative\n"
+     "good 2\n"
+     "inner\n"
+     "outer name 'undefined_name' is not defined\n"
+     "tick 0\n"
+     "tick 1\n"
+     "tick 2\n"
+     "tick 3\n"
+     "[2, 1, 0]\n"
+     "cleanup\n"
+     "key KeyError('a')\n"
+     "first ValueError('cause')\n"),
+    # tryGetAttr: проверки атрибутов и итерируемости без исключений на промахе
+    ("class Plain:\n"
+     "    pass\n"
+     "\n"
+     "class Lazy:\n"
+     "    def __getattr__(self, name):\n"
+     "        if name == \"answer\":\n"
+     "            return 42\n"
+     "        raise AttributeError(name)\n"
+     "\n"
+     "class Broken:\n"
+     "    def __init__(self):\n"
+     "        raise ValueError(\"bad init\")\n"
+     "\n"
+     "class Countdown:\n"
+     "    def __len__(self):\n"
+     "        return 3\n"
+     "    def __getitem__(self, i):\n"
+     "        return i * 10\n"
+     "\n"
+     "p = Plain()\n"
+     "print(hasattr(p, \"x\"), getattr(p, \"x\", \"default\"))\n"
+     "print(hasattr(Lazy(), \"answer\"), hasattr(Lazy(), \"other\"), getattr(Lazy(), \"other\", None))\n"
+     "try:\n"
+     "    Broken()\n"
+     "except ValueError as e:\n"
+     "    print(\"init\", e)\n"
+     "try:\n"
+     "    Plain(1)\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    iter(p)\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    p.missing\n"
+     "except AttributeError as e:\n"
+     "    print(e)\n"
+     "print(list(reversed(Countdown())))\n",
+     "False default\n"
+     "True False None\n"
+     "init bad init\n"
+     "Plain() takes no arguments\n"
+     "'Plain' object is not iterable\n"
+     "'Plain' object has no attribute 'missing'\n"
+     "[20, 10, 0]\n"),
+    # import: модули из каталога скрипта, sys.modules, from-импорт и import *
+    ("f = open(\"helper.py\", \"w\")\n"
+     'f.write("print(\'loading helper\', __name__)\\n")\n'
+     "f.write(\"counts = [0]\\n_hidden = 1\\nscale = 1\\n\\n\")\n"
+     "f.write(\"def bump(n):\\n    counts[0] += n * scale\\n    return counts[0]\\n\\n\")\n"
+     "f.write(\"class Point:\\n    def __init__(self, x):\\n        self.x = x\\n\")\n"
+     "f.close()\n"
+     "f = open(\"shapes.py\", \"w\")\n"
+     'f.write("__all__ = [\'area\']\\n")\n'
+     "f.write(\"def area(w, h):\\n    return w * h\\n\")\n"
+     "f.write(\"def perimeter(w, h):\\n    return 2 * (w + h)\\n\")\n"
+     "f.close()\n"
+     "\n"
+     "import helper\n"
+     "import helper as h\n"
+     "import sys\n"
+     "print(h is helper, \"helper\" in sys.modules, helper.__name__, __name__)\n"
+     "print(helper.bump(2), helper.bump(3), helper.counts)\n"
+     "helper.scale = 10\n"
+     "print(helper.bump(1))\n"
+     "from helper import bump, Point as P\n"
+     "print(bump(1), P(7).x)\n"
+     "from shapes import *\n"
+     "print(area(3, 4))\n"
+     "try:\n"
+     "    perimeter(1, 1)\n"
+     "except NameError as e:\n"
+     "    print(\"NameError\", e)\n"
+     "try:\n"
+     "    import no_such_module\n"
+     "except ModuleNotFoundError as e:\n"
+     "    print(\"ModuleNotFoundError\", e)\n"
+     "try:\n"
+     "    from shapes import volume\n"
+     "except ImportError as e:\n"
+     "    print(\"ImportError\", str(e).split(\" (\")[0])\n"
+     "try:\n"
+     "    helper.missing\n"
+     "except AttributeError as e:\n"
+     "    print(e)\n"
+     "\n"
+     "def local_import():\n"
+     "    import shapes\n"
+     "    from helper import counts as c\n"
+     "    return shapes.perimeter(2, 3), c\n"
+     "\n"
+     "print(local_import())\n",
+     "loading helper helper\n"
+     "True True helper __main__\n"
+     "2 5 [5]\n"
+     "15\n"
+     "25 7\n"
+     "12\n"
+     "NameError name 'perimeter' is not defined\n"
+     "ModuleNotFoundError No module named 'no_such_module'\n"
+     "ImportError cannot import name 'volume' from 'shapes'\n"
+     "module 'helper' has no attribute 'missing'\n"
+     "(10, [25])\n"),
+    # кэш глобальных и встроенных имён сбрасывается при появлении глобального имени
+    ("def measure(items):\n"
+     "    def inner():\n"
+     "        return len(items) + bonus\n"
+     "    return inner()\n"
+     "\n"
+     "bonus = 1\n"
+     "print(measure([1, 2, 3]))\n"
+     "bonus = 10\n"
+     "print(measure([1, 2, 3]))\n"
+     "\n"
+     "def len(obj):\n"
+     "    return 100\n"
+     "\n"
+     "print(measure([1, 2, 3]))\n"
+     "for i in range(3):\n"
+     "    bonus = i\n"
+     "    print(measure(\"ab\"))\n",
+     "4\n"
+     "13\n"
+     "110\n"
+     "100\n"
+     "101\n"
+     "102\n"),
+    # замыкания захватывают переменные объемлющих функций ячейками
+    ("def make_counter():\n"
+     "    count = 0\n"
+     "    def increment(step):\n"
+     "        nonlocal count\n"
+     "        count += step\n"
+     "        return count\n"
+     "    return increment\n"
+     "\n"
+     "counter = make_counter()\n"
+     "counter(1)\n"
+     "counter(5)\n"
+     "print(counter(10))\n"
+     "\n"
+     "def outer(base):\n"
+     "    def middle():\n"
+     "        def inner(x):\n"
+     "            return base + x\n"
+     "        return inner\n"
+     "    return middle()\n"
+     "\n"
+     "print(outer(100)(5))\n"
+     "\n"
+     "def late():\n"
+     "    fns = [lambda: i * 10 for i in range(3)]\n"
+     "    return [f() for f in fns]\n"
+     "\n"
+     "print(late())\n"
+     "\n"
+     "def scale(factor, items):\n"
+     "    return [x * factor for x in items]\n"
+     "\n"
+     "print(scale(3, [1, 2, 3]))\n"
+     "\n"
+     "def factory(label):\n"
+     "    class Tagged:\n"
+     "        def describe(self):\n"
+     "            return label + \"!\"\n"
+     "    return Tagged()\n"
+     "\n"
+     "print(factory(\"box\").describe())\n"
+     "\n"
+     "def rebinding():\n"
+     "    value = \"before\"\n"
+     "    get = lambda: value\n"
+     "    value = \"after\"\n"
+     "    return get()\n"
+     "\n"
+     "print(rebinding())\n"
+     "\n"
+     "total = 0\n"
+     "\n"
+     "def add_total(n):\n"
+     "    global total\n"
+     "    total += n\n"
+     "\n"
+     "add_total(4)\n"
+     "add_total(6)\n"
+     "print(total)\n"
+     "\n"
+     "def recursive():\n"
+     "    def fact(n):\n"
+     "        if n <= 1:\n"
+     "            return 1\n"
+     "        return n * fact(n - 1)\n"
+     "    return fact(5)\n"
+     "\n"
+     "print(recursive())\n",
+     "16\n"
+     "105\n"
+     "[20, 20, 20]\n"
+     "[3, 6, 9]\n"
+     "box!\n"
+     "after\n"
+     "10\n"
+     "120\n"),
+    # sys.settrace: события call/line/return/exception и строки исходника
+    ("import sys\n"
+     "\n"
+     "\n"
+     "def tracer(frame, event, arg):\n"
+     "    if event == \"exception\":\n"
+     "        arg = arg[1]\n"
+     "    print(event, frame.f_code.co_name, frame.f_lineno, arg)\n"
+     "    return tracer\n"
+     "\n"
+     "\n"
+     "def add(a, b):\n"
+     "    c = a + b\n"
+     "    return c\n"
+     "\n"
+     "\n"
+     "def total(n):\n"
+     "    s = 0\n"
+     "    for i in range(n):\n"
+     "        s = add(s, i)\n"
+     "    return s\n"
+     "\n"
+     "\n"
+     "def fail():\n"
+     "    raise ValueError(\"bad\")\n"
+     "\n"
+     "\n"
+     "sys.settrace(tracer)\n"
+     "x = total(2)\n"
+     "try:\n"
+     "    fail()\n"
+     "except ValueError:\n"
+     "    print(\"caught\")\n"
+     "sys.settrace(None)\n"
+     "print(x, sys.gettrace())\n",
+     "call total 16 None\n"
+     "line total 17 None\n"
+     "line total 18 None\n"
+     "line total 19 None\n"
+     "call add 11 None\n"
+     "line add 12 None\n"
+     "line add 13 None\n"
+     "return add 13 0\n"
+     "line total 18 None\n"
+     "line total 19 None\n"
+     "call add 11 None\n"
+     "line add 12 None\n"
+     "line add 13 None\n"
+     "return add 13 1\n"
+     "line total 18 None\n"
+     "line total 20 None\n"
+     "return total 20 1\n"
+     "call fail 23 None\n"
+     "line fail 24 None\n"
+     "exception fail 24 bad\n"
+     "return fail 24 None\n"
+     "caught\n"
+     "1 None\n"),
+    # superinstructions of hot code: int/float fast paths, overflow and deoptimization
+    ("def accumulate(n, step):\n"
+     "    s = 0\n"
+     "    i = 0\n"
+     "    while i < n:\n"
+     "        s += i * step\n"
+     "        i += 1\n"
+     "    return s\n"
+     "print(accumulate(1000, 3))\n"
+     "print(accumulate(10000, 1000000000000000))\n"
+     "print(accumulate(400, 0.5))\n"
+     "print(accumulate(3.5, 2))\n"
+     "def poly(x):\n"
+     "    return x * x - 3 * x + 2\n"
+     "total = 0\n"
+     "for k in range(600):\n"
+     "    total = total + poly(k)\n"
+     "print(total)\n"
+     "print(poly(1.5), poly(2))\n"
+     "def count_down(n):\n"
+     "    steps = 0\n"
+     "    while n > 0:\n"
+     "        n -= 1\n"
+     "        steps += 1\n"
+     "    return steps\n"
+     "print(count_down(300), count_down(10.5))\n"
+     "def concat(n):\n"
+     "    s = ''\n"
+     "    for i in range(n):\n"
+     "        s += 'ab'\n"
+     "    return len(s)\n"
+     "print(concat(500))\n",
+     "1498500\n"
+     "49995000000000000000000\n"
+     "39900.0\n"
+     "12\n"
+     "71282200\n"
+     "-0.25 0\n"
+     "300 11\n"
+     "1000\n"),
+    # длинные целые: разбор и печать тысяч цифр
+    ("s = str(7 ** 5000)\n"
+     "print(len(s))\n"
+     "print(s[:20])\n"
+     "print(s[-20:])\n"
+     "n = 993330376544796491073717865012402442993123722230441789495962443739379912174577472120830400391107084795580512233561723930029056571508696761519362912610318634870680241841607909374155231125665237484516950252195828373353207887827202929591237995687661408151174536248275739233781743078812728646558020674050822844272573430260776525151082316822641645525265960396240069703080738707905130601854523051763814340180141163564715979796674982776274323783383042397179667233742826474351623752690675926044906655870349646365586864984574069424947490490410406191837599350763911567291616861441396522268578410489953437836953140736518686542576101359309924652084270547653768282958739977758743862041884280459519262011187569620600038731101600736617263245147140787294968952758608391098258687631182731688629914295564841998741619373914328909437912435468559561736263350126323228768672359296519552918360077954587333003930097968978240384616689654119047135785149986109294773346809420839123307687551387835454887260854621224263670122219387827797816953348629397663716955269268933542246687634235331914757916575033441017797072216249746390993621301961057415364827787937343207304296575557839073156511971336158693998183297360961138049528199296200000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000008113386547139846570249258396269653594821202123065602298796884622382469634396046211694544617292439207130204626685001649425927690524962759650919723185807400225943754575396665179020996280285275165751186944463704632936313010081598637819587306169222171709030915410060771062075270443738560079532055768876637013673001519843337906276266295636933703728226913268483845418868382999780552470106107384616129337236058078068745879043896170863559262103183777351724266661076724176876397558116349624716972538126582274495975143402538453664278828996886174657604521395880148310578195593965648158026548069586015597664319995276666466733060113434034362712395020557834735230220776481466868357123586976026015601090138438370290305944147790985608775566732841821803286933183440361486631483428356841294844243323019253455492514386241353257335033011033557277946806133404383711036720904888466106819606100476767394138764986856699403479278962301992079545768183169011400630649108142612533780747401591534626390536414605077889440566132603376649644808338335872369823149281805249817790314804974216348958096520999208705072341426557169244652\n"
+     "print(n % 1000000007)\n"
+     "print(n // 10 ** 2990)\n"
+     "print(str(n) == \"993330376544796491073717865012402442993123722230441789495962443739379912174577472120830400391107084795580512233561723930029056571508696761519362912610318634870680241841607909374155231125665237484516950252195828373353207887827202929591237995687661408151174536248275739233781743078812728646558020674050822844272573430260776525151082316822641645525265960396240069703080738707905130601854523051763814340180141163564715979796674982776274323783383042397179667233742826474351623752690675926044906655870349646365586864984574069424947490490410406191837599350763911567291616861441396522268578410489953437836953140736518686542576101359309924652084270547653768282958739977758743862041884280459519262011187569620600038731101600736617263245147140787294968952758608391098258687631182731688629914295564841998741619373914328909437912435468559561736263350126323228768672359296519552918360077954587333003930097968978240384616689654119047135785149986109294773346809420839123307687551387835454887260854621224263670122219387827797816953348629397663716955269268933542246687634235331914757916575033441017797072216249746390993621301961057415364827787937343207304296575557839073156511971336158693998183297360961138049528199296200000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000008113386547139846570249258396269653594821202123065602298796884622382469634396046211694544617292439207130204626685001649425927690524962759650919723185807400225943754575396665179020996280285275165751186944463704632936313010081598637819587306169222171709030915410060771062075270443738560079532055768876637013673001519843337906276266295636933703728226913268483845418868382999780552470106107384616129337236058078068745879043896170863559262103183777351724266661076724176876397558116349624716972538126582274495975143402538453664278828996886174657604521395880148310578195593965648158026548069586015597664319995276666466733060113434034362712395020557834735230220776481466868357123586976026015601090138438370290305944147790985608775566732841821803286933183440361486631483428356841294844243323019253455492514386241353257335033011033557277946806133404383711036720904888466106819606100476767394138764986856699403479278962301992079545768183169011400630649108142612533780747401591534626390536414605077889440566132603376649644808338335872369823149281805249817790314804974216348958096520999208705072341426557169244652\")\n"
+     "m = -993330376544796491073717865012402442993123722230441789495962443739379912174577472120830400391107084795580512233561723930029056571508696761519362912610318634870680241841607909374155231125665237484516950252195828373353207887827202929591237995687661408151174536248275739233781743078812728646558020674050822844272573430260776525151082316822641645525265960396240069703080738707905130601854523051763814340180141163564715979796674982776274323783383042397179667233742826474351623752690675926044906655870349646365586864984574069424947490490410406191837599350763911567291616861441396522268578410489953437836953140736518686542576101359309924652084270547653768282958739977758743862041884280459519262011187569620600038731101600736617263245147140787294968952758608391098258687631182731688629914295564841998741619373914328909437912435468559561736263350126323228768672359296519552918360077954587333003930097968978240384616689654119047135785149986109294773346809420839123307687551387835454887260854621224263670122219387827797816953348629397663716955269268933542246687634235331914757916575033441017797072216249746390993621301961057415364827787937343207304296575557839073156511971336158693998183297360961138049528199296200000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000008113386547139846570249258396269653594821202123065602298796884622382469634396046211694544617292439207130204626685001649425927690524962759650919723185807400225943754575396665179020996280285275165751186944463704632936313010081598637819587306169222171709030915410060771062075270443738560079532055768876637013673001519843337906276266295636933703728226913268483845418868382999780552470106107384616129337236058078068745879043896170863559262103183777351724266661076724176876397558116349624716972538126582274495975143402538453664278828996886174657604521395880148310578195593965648158026548069586015597664319995276666466733060113434034362712395020557834735230220776481466868357123586976026015601090138438370290305944147790985608775566732841821803286933183440361486631483428356841294844243323019253455492514386241353257335033011033557277946806133404383711036720904888466106819606100476767394138764986856699403479278962301992079545768183169011400630649108142612533780747401591534626390536414605077889440566132603376649644808338335872369823149281805249817790314804974216348958096520999208705072341426557169244652\n"
+     "print(m % 998244353)\n"
+     "print((n * n) % 1000000009)\n"
+     "print(1000)\n",
+     "4226\n"
+     "30917194013597692114\n"
+     "79025402256403000001\n"
+     "747171823\n"
+     "9933303765\n"
+     "True\n"
+     "193000554\n"
+     "898941146\n"
+     "1000\n"),
+    # pow с модулем, divmod, abs, round и int.bit_length/bit_count
+    ("print(pow(3, 200, 1000000007))\n"
+     "print(pow(-7, 13, 97), pow(7, 13, -97), pow(5, -1, 7))\n"
+     "print(pow(2, 10), pow(2, -2), pow(2, 100))\n"
+     "p = 2 ** 127 - 1\n"
+     "print(pow(3, p - 1, p))\n"
+     "print(pow(12345678901234567890, 98765, 10 ** 30 + 57))\n"
+     "print(divmod(17, 5), divmod(-17, 5), divmod(17, -5), divmod(-17, -5))\n"
+     "print(divmod(10 ** 30 + 7, -10 ** 12))\n"
+     "print(divmod(7.5, 2))\n"
+     "print(-7 % 3, 7 % -3, -(10 ** 25) % 7)\n"
+     "print(abs(-5), abs(3.5), abs(-(2 ** 70)), abs(True))\n"
+     "print(round(2.5), round(3.5), round(-0.5), round(2.675, 2), round(1234.5678, -2))\n"
+     "print(round(125, -1), round(135, -1), round(-150, -2), round(7, 3), round(10 ** 20 + 5, -1))\n"
+     "n = 255\n"
+     "print(n.bit_length(), n.bit_count(), (-n).bit_length(), (0).bit_length())\n"
+     "big = 3 ** 100\n"
+     "print(big.bit_length(), big.bit_count(), (-big).bit_count())\n"
+     "try:\n"
+     "    pow(2, 3, 0)\n"
+     "except ValueError as e:\n"
+     "    print(\"ValueError\", e)\n"
+     "try:\n"
+     "    pow(2, -1, 4)\n"
+     "except ValueError as e:\n"
+     "    print(\"ValueError\", e)\n"
+     "print(1000)\n",
+     "136318165\n"
+     "59 -59 3\n"
+     "1024 0.25 1267650600228229401496703205376\n"
+     "1\n"
+     "799295795674860712869226349064\n"
+     "(3, 2) (-4, 3) (-4, -3) (3, -2)\n"
+     "(-1000000000000000001, -999999999993)\n"
+     "(3.0, 1.5)\n"
+     "2 -2 4\n"
+     "5 3.5 1180591620717411303424 1\n"
+     "2 4 0 2.67 1200.0\n"
+     "120 140 -200 7 100000000000000000000\n"
+     "8 8 8 0\n"
+     "159 85 85\n"
+     "ValueError pow() 3rd argument cannot be 0\n"
+     "ValueError base is not invertible for the given modulus\n"
+     "1000\n"),
+    # s += t дописывает на месте только ненаблюдаемо: псевдонимы сохраняют старое значение
+    ("def build(n):\n"
+     "    s = \"\"\n"
+     "    for i in range(n):\n"
+     "        s += str(i % 10)\n"
+     "    return s\n"
+     "\n"
+     "r = build(2000)\n"
+     "print(len(r), r[:12], r[-5:])\n"
+     "s = \"ab\"\n"
+     "t = s\n"
+     "for i in range(20):\n"
+     "    s += \"c\"\n"
+     "print(t, len(s))\n"
+     "keep = []\n"
+     "u = \"\"\n"
+     "for i in range(12):\n"
+     "    u += \"x\"\n"
+     "    keep.append(u)\n"
+     "print(keep[0], keep[3], len(keep[11]))\n"
+     "w = \"q\"\n"
+     "for i in range(5):\n"
+     "    w += w\n"
+     "print(len(w))\n"
+     "d = {}\n"
+     "k = \"\"\n"
+     "for ch in \"hello\":\n"
+     "    k += ch\n"
+     "    d[k] = len(k)\n"
+     "print(d)\n"
+     "print(hash(k) == hash(\"hello\"), k == \"hello\")\n"
+     "uni = \"a\"\n"
+     "for i in range(10):\n"
+     "    uni += \"ж\"\n"
+     "print(uni, len(uni))\n"
+     "print(1000)\n",
+     "2000 012345678901 56789\n"
+     "ab 22\n"
+     "x xxxx 12\n"
+     "32\n"
+     "{'h': 1, 'he': 2, 'hel': 3, 'hell': 4, 'hello': 5}\n"
+     "True True\n"
+     "aжжжжжжжжжж 11\n"
+     "1000\n"),
+    # join: str, bytes и bytearray из списков, кортежей и итераторов, ошибки типов элементов
+    ("words = []\n"
+     "for i in range(1000):\n"
+     "    words.append(str(i))\n"
+     "s = \",\".join(words)\n"
+     "print(len(s), s[:20], s[-10:])\n"
+     "print(\"-\".join((\"a\", \"bb\", \"ccc\")))\n"
+     "print(\"\".join([\"solo\"]), \"|\".join([]), \"|\".join([\"\", \"\"]))\n"
+     "print(\"+\".join(w for w in [\"x\", \"y\", \"z\"]))\n"
+     "print(\", \".join({\"k1\": 1, \"k2\": 2}))\n"
+     "print(\"жж\".join([\"a\", \"ё\", \"b\"]))\n"
+     "try:\n"
+     "    \" \".join([\"a\", 1])\n"
+     "except TypeError as e:\n"
+     "    print(\"TypeError\", e)\n"
+     "print(b\"--\".join([b\"ab\", bytearray(b\"cd\"), b\"\"]))\n"
+     "print(bytearray(b\", \").join((b\"x\", b\"y\")))\n"
+     "print(b\"\".join(b\"%d\" % i for i in range(5)))\n"
+     "try:\n"
+     "    b\"\".join([b\"a\", \"b\"])\n"
+     "except TypeError as e:\n"
+     "    print(\"TypeError\", e)\n"
+     "print(1000)\n",
+     "3889 0,1,2,3,4,5,6,7,8,9, 97,998,999\n"
+     "a-bb-ccc\n"
+     "solo  |\n"
+     "x+y+z\n"
+     "k1, k2\n"
+     "aжжёжжb\n"
+     "TypeError sequence item 1: expected str instance, int found\n"
+     "b'ab--cd--'\n"
+     "bytearray(b'x, y')\n"
+     "b'01234'\n"
+     "TypeError sequence item 1: expected a bytes-like object, str found\n"
+     "1000\n"),
+    # шаблоны format и % из кэша: автонумерация, ключи, звёздочки, ошибки
+    ("rows = []\n"
+     "for i in range(300):\n"
+     "    rows.append(\"{} {:d} {:.2f} [{name}]\".format(i, i * 3, i / 7, name=\"r\"))\n"
+     "print(rows[0], \"|\", rows[299])\n"
+     "lines = []\n"
+     "for i in range(300):\n"
+     "    lines.append(\"%s=%d (%5.1f%%) %-4s|\" % (\"k\", i, i / 3, \"ab\"))\n"
+     "print(lines[1], lines[299])\n"
+     "print(\"{0}{1}{0}\".format(\"a\", \"b\"), \"{x.real}\".format(x=5), \"{0[1]}-{0[2]}\".format(\"xyz\"))\n"
+     "print(\"{!r:>8}|{!s}\".format(\"q\", 7), \"{k[a]}\".format(k={\"a\": 1}))\n"
+     "print(\"%(a)s-%(b)05d\" % {\"a\": \"x\", \"b\": 42}, \"%*d|%-*d|\" % (4, 7, 4, 7), \"%.*f\" % (2, 3.14159))\n"
+     "print(\"%s\" % [1, 2], \"%s\" % (5,), \"100%%\" % (), \"no args\" % {})\n"
+     "print(\"%d%%\" % 50, \"%x %X %o %e\" % (255, 255, 8, 1234.5))\n"
+     "for bad in [\"{} {0}\", \"{0} {}\"]:\n"
+     "    try:\n"
+     "        bad.format(1, 2)\n"
+     "    except ValueError as e:\n"
+     "        print(\"ValueError\", e)\n"
+     "try:\n"
+     "    \"{} {}\".format(1)\n"
+     "except IndexError as e:\n"
+     "    print(\"IndexError\", e)\n"
+     "try:\n"
+     "    \"{missing}\".format(1)\n"
+     "except KeyError:\n"
+     "    print(\"KeyError\")\n"
+     "try:\n"
+     "    \"%s %s\" % (1,)\n"
+     "except TypeError as e:\n"
+     "    print(\"TypeError\", e)\n"
+     "try:\n"
+     "    \"%s\" % (1, 2)\n"
+     "except TypeError as e:\n"
+     "    print(\"TypeError\", e)\n"
+     "print(1000)\n",
+     "0 0 0.00 [r] | 299 897 42.71 [r]\n"
+     "k=1 (  0.3%) ab  | k=299 ( 99.7%) ab  |\n"
+     "aba 5 y-z\n"
+     "     'q'|7 1\n"
+     "x-00042    7|7   | 3.14\n"
+     "[1, 2] 5 100% no args\n"
+     "50% ff FF 10 1.234500e+03\n"
+     "ValueError cannot switch from automatic field numbering to manual field specification\n"
+     "ValueError cannot switch from manual field specification to automatic field numbering\n"
+     "IndexError Replacement index 1 out of range for positional args tuple\n"
+     "KeyError\n"
+     "TypeError not enough arguments for format string\n"
+     "TypeError not all arguments converted during string formatting\n"
+     "1000\n"),
+    # f-строки: поля, спецификаторы, вложенная ширина, {x=}
+    ("name = \"world\"\n"
+     "n = 42\n"
+     "pi = 3.14159\n"
+     "print(f\"hello {name}!\")\n"
+     "print(f\"{n} + 1 = {n + 1}\")\n"
+     "print(f\"{pi:.2f} {n:d} {n:>6} {name!r}\")\n"
+     "print(f\"{{literal}} {n}\")\n"
+     "width = 8\n"
+     "print(f\"[{name:>{width}}]\")\n"
+     "print(f\"{n=}\")\n"
+     "d = {'a': 1}\n"
+     'print(f"{d[\'a\']} {[1, 2][1]}")\n'
+     "print(f\"{n != 3}\")\n"
+     "def greet(who):\n"
+     "    return f\"hi {who.upper()}\"\n"
+     "print(greet(name))\n"
+     "parts = []\n"
+     "for i in range(3):\n"
+     "    parts.append(f\"{i}:{i * i}\")\n"
+     "print(\",\".join(parts))\n"
+     "print(f\"\")\n"
+     "print(f'plain')\n"
+     "print(1000)\n",
+     "hello world!\n"
+     "42 + 1 = 43\n"
+     "3.14 42     42 'world'\n"
+     "{literal} 42\n"
+     "[   world]\n"
+     "n=42\n"
+     "1 2\n"
+     "True\n"
+     "hi WORLD\n"
+     "0:0,1:1,2:4\n"
+     "\n"
+     "plain\n"
+     "1000\n"),
+    # ASCII-ядра регистра, классификации и translate
+    ("s = \"Hello, World! data_cleaning 123 \" * 3\n"
+     "print(s.upper())\n"
+     "print(s.lower())\n"
+     "print(s.swapcase())\n"
+     "print(s.casefold())\n"
+     "print(\"Straße\".casefold(), \"ÀbC\".swapcase(), \"ÀbC\".upper())\n"
+     "print(\"abcdefghijklmnopqrstuvwxyzABCDEFGHIJ\".isalpha(), \"abcdefghijklmnopqrstuvwxyz ABC\".isalpha())\n"
+     "print(\"01234567890123456789\".isdigit(), \"0123456789012345678x\".isdigit(), \"\".isdigit())\n"
+     "print(\"abc123XYZ456abc123XYZ\".isalnum(), \"abc123XYZ456abc123XY_\".isalnum())\n"
+     "print(\" \\t\\n\\r  \\x0b\\x0c          \".isspace(), \"                  x\".isspace())\n"
+     "print(\"ascii only text here\".isascii(), \"не ascii\".isascii(), \"\".isascii())\n"
+     "print(\"valid_identifier_name_123\".isidentifier(), \"1abc\".isidentifier(), \"_x\".isidentifier(), \"a-b\".isidentifier(), \"имя\".isidentifier())\n"
+     "table = str.maketrans(\"abc\", \"xyz\", \"d\")\n"
+     "print(\"aabbccdd-abcd\".translate(table))\n"
+     "print(\"héllo\".translate({104: \"H\", 233: None}))\n"
+     "print(1000)\n",
+     "HELLO, WORLD! DATA_CLEANING 123 HELLO, WORLD! DATA_CLEANING 123 HELLO, WORLD! DATA_CLEANING 123 \n"
+     "hello, world! data_cleaning 123 hello, world! data_cleaning 123 hello, world! data_cleaning 123 \n"
+     "hELLO, wORLD! DATA_CLEANING 123 hELLO, wORLD! DATA_CLEANING 123 hELLO, wORLD! DATA_CLEANING 123 \n"
+     "hello, world! data_cleaning 123 hello, world! data_cleaning 123 hello, world! data_cleaning 123 \n"
+     "strasse àBc ÀBC\n"
+     "True False\n"
+     "True False False\n"
+     "True False\n"
+     "True False\n"
+     "True False True\n"
+     "True False True False True\n"
+     "xxyyzz-xyz\n"
+     "Hllo\n"
+     "1000\n"),
+    # поиск подстроки: длинные периодичные образцы, replace с пределом, bytes
+    ("hay = \"ab\" * 50 + \"abc\" + \"ab\" * 50\n"
+     "needle = \"ab\" * 20 + \"abc\"\n"
+     "print(hay.find(needle), hay.rfind(needle), hay.count(needle), needle in hay)\n"
+     "print(hay.find(\"ab\" * 40 + \"c\"), (\"x\" + \"ab\" * 40) in hay)\n"
+     "text = \"the quick brown fox jumps over the lazy dog; the end\"\n"
+     "print(text.find(\"the\"), text.rfind(\"the\"), text.count(\"the\"), text.index(\"fox\"), text.rindex(\"the\", 0, 40))\n"
+     "print(text.replace(\"the\", \"THE\"), text.replace(\"the\", \"a\", 2), text.replace(\"zzz\", \"y\"))\n"
+     "print(\"abc\".replace(\"\", \"-\"), \"abc\".replace(\"\", \"-\", 2), \"aaaa\".replace(\"aa\", \"b\"))\n"
+     "print(text.partition(\"fox\"), text.rpartition(\"the\"))\n"
+     "print(\"a--b--c\".split(\"--\"), \"a--b--c\".rsplit(\"--\", 1))\n"
+     "long_sep = \"=\" * 40\n"
+     "print((\"x\" + long_sep + \"y\" + long_sep + \"z\").split(long_sep), (\"x\" + long_sep + \"y\" + long_sep + \"z\").rsplit(long_sep, 1))\n"
+     "print(\"é—ж\" * 20 + \"ключ\" in \"ж\" * 100 + \"é—ж\" * 20 + \"ключ\", (\"é—ж\" * 5).count(\"ж\"))\n"
+     "data = b\"ab\" * 50 + b\"abc\" + b\"ab\" * 50\n"
+     "print(data.find(b\"ab\" * 20 + b\"abc\"), data.rfind(b\"ab\"), data.count(b\"ab\"), data.replace(b\"abc\", b\"!\")[95:110])\n"
+     "print(1000)\n",
+     "60 60 1 True\n"
+     "22 False\n"
+     "0 45 3 16 31\n"
+     "THE quick brown fox jumps over THE lazy dog; THE end a quick brown fox jumps over a lazy dog; the end the quick brown fox jumps over the lazy dog; the end\n"
+     "-a-b-c- -a-bc bb\n"
+     "('the quick brown ', 'fox', ' jumps over the lazy dog; the end') ('the quick brown fox jumps over the lazy dog; ', 'the', ' end')\n"
+     "['a', 'b', 'c'] ['a--b', 'c']\n"
+     "['x', 'y', 'z'] ['x========================================y', 'z']\n"
+     "True 5\n"
+     "60 201 101 b'babab!ababababa'\n"
+     "1000\n"),
+    # memoryview: срезы без копирования, cast и закреплённый bytearray
+    ("data = bytearray(b\"header:payload-bytes\")\n"
+     "view = memoryview(data)\n"
+     "print(len(view), view.nbytes, view.readonly, view.format, view.itemsize)\n"
+     "body = view[7:]\n"
+     "print(body.tobytes(), body[0], body[-1])\n"
+     "part = body[2:9:2]\n"
+     "print(part.tobytes(), part.tolist(), part.strides, part.contiguous)\n"
+     "print(view[::-1][:6].tobytes())\n"
+     "body[0] = 80\n"
+     "print(data[:9])\n"
+     "view[0:6] = b\"HEADER\"\n"
+     "print(data)\n"
+     "print(body == b\"Payload-bytes\", view[:6] == memoryview(b\"HEADER\"), view[:3] != b\"HEA\")\n"
+     "try:\n"
+     "    data.append(33)\n"
+     "except BufferError as e:\n"
+     "    print(\"BufferError\", e)\n"
+     "view.release()\n"
+     "body.release()\n"
+     "part.release()\n"
+     "try:\n"
+     "    data.extend(b\"!!\")\n"
+     "    print(len(data))\n"
+     "except BufferError as e:\n"
+     "    print(\"still pinned\", e)\n"
+     "try:\n"
+     "    view[0]\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "words = memoryview(b\"\\x01\\x00\\x02\\x00\\xff\\xff\").cast(\"H\")\n"
+     "print(words.tolist(), words.format, words.itemsize, len(words), words.readonly)\n"
+     "signed = memoryview(b\"\\x7f\\x80\\xff\").cast(\"b\")\n"
+     "print(signed.tolist(), [x for x in signed])\n"
+     "try:\n"
+     "    memoryview(b\"abc\").cast(\"H\")\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    memoryview(b\"abcd\")[::2].cast(\"B\")\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "ro = memoryview(b\"xyz\")\n"
+     "try:\n"
+     "    ro[0] = 1\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "print(bytes(ro[1:]), bytearray(ro[:2]), ro.hex(), ro[0:0].tobytes())\n"
+     "m = memoryview(bytearray(b\"ab\"))\n"
+     "print(m.tolist())\n"
+     "m.release()\n"
+     "try:\n"
+     "    m.tobytes()\n"
+     "except ValueError as e:\n"
+     "    print(\"closed\")\n"
+     "print(1000)\n",
+     "20 20 False B 1\n"
+     "b'payload-bytes' 112 115\n"
+     "b'yodb' [121, 111, 100, 98] (2,) False\n"
+     "b'setyb-'\n"
+     "bytearray(b'header:Pa')\n"
+     "bytearray(b'HEADER:Payload-bytes')\n"
+     "True True False\n"
+     "BufferError Existing exports of data: object cannot be re-sized\n"
+     "22\n"
+     "operation forbidden on released memoryview object\n"
+     "[1, 2, 65535] H 2 3 True\n"
+     "[127, -128, -1] [127, -128, -1]\n"
+     "memoryview: length is not a multiple of itemsize\n"
+     "memoryview: casts are restricted to C-contiguous views\n"
+     "cannot modify read-only memory\n"
+     "b'yz' bytearray(b'xy') 78797a b''\n"
+     "[97, 98]\n"
+     "closed\n"
+     "1000\n"),
+    # hex с разделителем, fromhex, модули binascii и base64
+    ("data = b\"\\x00\\x01\\xab\\xcd\\xef\\x10\\xff\"\n"
+     "print(data.hex())\n"
+     "print(data.hex(\":\"))\n"
+     "print(data.hex(\"-\", 2))\n"
+     "print(data.hex(b\" \", -3))\n"
+     "print(bytearray(b\"abc\").hex(\".\"))\n"
+     "print(memoryview(b\"hello\")[1:4].hex())\n"
+     "print(bytes.fromhex(\"00 ab  CD ef\"))\n"
+     "print(bytes.fromhex(\"0123456789abcdef0123456789ABCDEF0011\"))\n"
+     "try:\n"
+     "    bytes.fromhex(\"0011zz\")\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    bytes.fromhex(\"001\")\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    data.hex(\"ab\")\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "import binascii\n"
+     "import base64\n"
+     "print(binascii.hexlify(b\"abc\", \"-\"))\n"
+     "print(binascii.unhexlify(\"616263\"))\n"
+     "print(binascii.a2b_hex(b\"FFfe\"))\n"
+     "try:\n"
+     "    binascii.unhexlify(b\"abc\")\n"
+     "except binascii.Error as e:\n"
+     "    print(\"Error\", e)\n"
+     "try:\n"
+     "    binascii.unhexlify(b\"zz\")\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "print(binascii.b2a_base64(b\"hello\"))\n"
+     "print(binascii.b2a_base64(b\"hello\", newline=False))\n"
+     "print(binascii.a2b_base64(b\"aGVs bG8=\\n\"))\n"
+     "try:\n"
+     "    binascii.a2b_base64(b\"aGVsbG8=xx\", strict_mode=True)\n"
+     "except binascii.Error as e:\n"
+     "    print(e)\n"
+     "for n in range(6):\n"
+     "    raw = b\"\\xfb\\xff\\x01abcdef\"[:n]\n"
+     "    enc = base64.b64encode(raw)\n"
+     "    print(enc, base64.b64decode(enc) == raw, base64.urlsafe_b64encode(raw))\n"
+     "print(base64.urlsafe_b64decode(b\"-_8=\"))\n"
+     "print(base64.b64encode(b\"\\xfb\\xff\", altchars=b\"*!\"))\n"
+     "print(base64.b64decode(\"+/8=\"))\n"
+     "try:\n"
+     "    base64.b64decode(b\"aGVsbG8\")\n"
+     "except binascii.Error as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    base64.b64decode(b\"aGV$sbG8=\", validate=True)\n"
+     "except binascii.Error as e:\n"
+     "    print(e)\n"
+     "print(base64.b64decode(b\"aGV$sbG8=\"))\n"
+     "print(base64.b16encode(b\"\\xab\\x01\"))\n"
+     "print(base64.b16decode(b\"AB01\"), base64.b16decode(b\"ab01\", casefold=True))\n"
+     "try:\n"
+     "    base64.b16decode(b\"ab01\")\n"
+     "except binascii.Error as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    base64.b64encode(\"text\")\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "print(issubclass(binascii.Error, ValueError))\n"
+     "print(1000)\n",
+     "0001abcdef10ff\n"
+     "00:01:ab:cd:ef:10:ff\n"
+     "00-01ab-cdef-10ff\n"
+     "0001ab cdef10 ff\n"
+     "61.62.63\n"
+     "656c6c\n"
+     "b'\\x00\\xab\\xcd\\xef'\n"
+     "b'\\x01#Eg\\x89\\xab\\xcd\\xef\\x01#Eg\\x89\\xab\\xcd\\xef\\x00\\x11'\n"
+     "non-hexadecimal number found in fromhex() arg at position 4\n"
+     "non-hexadecimal number found in fromhex() arg at position 3\n"
+     "sep must be length 1.\n"
+     "b'61-62-63'\n"
+     "b'abc'\n"
+     "b'\\xff\\xfe'\n"
+     "Error Odd-length string\n"
+     "Non-hexadecimal digit found\n"
+     "b'aGVsbG8=\\n'\n"
+     "b'aGVsbG8='\n"
+     "b'hello'\n"
+     "Excess data after padding\n"
+     "b'' True b''\n"
+     "b'+w==' True b'-w=='\n"
+     "b'+/8=' True b'-_8='\n"
+     "b'+/8B' True b'-_8B'\n"
+     "b'+/8BYQ==' True b'-_8BYQ=='\n"
+     "b'+/8BYWI=' True b'-_8BYWI='\n"
+     "b'\\xfb\\xff'\n"
+     "b'*!8='\n"
+     "b'\\xfb\\xff'\n"
+     "Incorrect padding\n"
+     "Only base64 data is allowed\n"
+     "b'hello'\n"
+     "b'AB01'\n"
+     "b'\\xab\\x01' b'\\xab\\x01'\n"
+     "Non-base16 digit found\n"
+     "a bytes-like object is required, not 'str'\n"
+     "True\n"
+     "1000\n"),
+    # collections.deque и удаление префикса bytearray
+    ("from collections import deque\n"
+     "import collections\n"
+     "d = deque([1, 2, 3])\n"
+     "d.append(4)\n"
+     "d.appendleft(0)\n"
+     "print(d, len(d), d[0], d[-1], 3 in d, 9 in d)\n"
+     "print(d.pop(), d.popleft(), d)\n"
+     "d.extend(range(4, 8))\n"
+     "d.extendleft(\"ab\")\n"
+     "print(d)\n"
+     "d.rotate(2)\n"
+     "print(d)\n"
+     "d.rotate(-3)\n"
+     "print(d)\n"
+     "d.insert(2, \"x\")\n"
+     "del d[0]\n"
+     "d[1] = \"y\"\n"
+     "print(d, d.index(\"y\"), d.count(5))\n"
+     "d.remove(2)\n"
+     "d.reverse()\n"
+     "print(d, list(reversed(d)))\n"
+     "q = deque(maxlen=3)\n"
+     "for i in range(6):\n"
+     "    q.append(i)\n"
+     "print(q, q.maxlen)\n"
+     "q.appendleft(-1)\n"
+     "print(q)\n"
+     "try:\n"
+     "    q.insert(0, 9)\n"
+     "except IndexError as e:\n"
+     "    print(e)\n"
+     "big = deque()\n"
+     "for i in range(1000):\n"
+     "    big.append(i)\n"
+     "    big.appendleft(-i)\n"
+     "total = 0\n"
+     "while big:\n"
+     "    total += big.popleft()\n"
+     "    if big:\n"
+     "        total += big.pop()\n"
+     "print(total, len(big), bool(big))\n"
+     "w = collections.deque(range(200))\n"
+     "for i in range(150):\n"
+     "    w.append(w.popleft() * 2)\n"
+     "print(w[0], w[-1], w[100], sum(w))\n"
+     "try:\n"
+     "    deque().pop()\n"
+     "except IndexError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    w[500]\n"
+     "except IndexError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    deque(maxlen=-1)\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    for x in w:\n"
+     "        w.append(1)\n"
+     "except RuntimeError as e:\n"
+     "    print(e)\n"
+     "c = w.copy()\n"
+     "print(c == w, c == list(w), deque([1, 2]) != deque([1, 3]))\n"
+     "c.clear()\n"
+     "print(c, len(w))\n"
+     "s = deque()\n"
+     "s.append(s)\n"
+     "print(s)\n"
+     "b = bytearray(b\"header:payload:tail\")\n"
+     "consumed = []\n"
+     "while b:\n"
+     "    i = b.find(b\":\")\n"
+     "    if i < 0:\n"
+     "        consumed.append(bytes(b))\n"
+     "        del b[:]\n"
+     "    else:\n"
+     "        consumed.append(bytes(b[:i]))\n"
+     "        del b[:i + 1]\n"
+     "print(consumed, b)\n"
+     "b = bytearray(b\"abcdefgh\")\n"
+     "print(b.pop(0), b)\n"
+     "del b[::2]\n"
+     "print(b)\n"
+     "b = bytearray(b\"abcdefgh\")\n"
+     "del b[6:1:-2]\n"
+     "print(b)\n"
+     "b.extend(b\"XYZ\")\n"
+     "del b[:2]\n"
+     "print(b)\n"
+     "print(1000)\n",
+     "deque([0, 1, 2, 3, 4]) 5 0 4 True False\n"
+     "4 0 deque([1, 2, 3])\n"
+     "deque(['b', 'a', 1, 2, 3, 4, 5, 6, 7])\n"
+     "deque([6, 7, 'b', 'a', 1, 2, 3, 4, 5])\n"
+     "deque(['a', 1, 2, 3, 4, 5, 6, 7, 'b'])\n"
+     "deque([1, 'y', 2, 3, 4, 5, 6, 7, 'b']) 1 1\n"
+     "deque(['b', 7, 6, 5, 4, 3, 'y', 1]) [1, 'y', 3, 4, 5, 6, 7, 'b']\n"
+     "deque([3, 4, 5], maxlen=3) 3\n"
+     "deque([-1, 3, 4], maxlen=3)\n"
+     "deque already at its maximum size\n"
+     "0 0 False\n"
+     "150 298 100 31075\n"
+     "pop from an empty deque\n"
+     "deque index out of range\n"
+     "maxlen must be non-negative\n"
+     "deque mutated during iteration\n"
+     "True False True\n"
+     "deque([]) 201\n"
+     "deque([[...]])\n"
+     "[b'header', b'payload', b'tail'] bytearray(b'')\n"
+     "97 bytearray(b'bcdefgh')\n"
+     "bytearray(b'ceg')\n"
+     "bytearray(b'abdfh')\n"
+     "bytearray(b'dfhXYZ')\n"
+     "1000\n"),
+    # bytes.translate и maketrans: таблица, delete=, None
+    ("t = bytes.maketrans(b\"abc\", b\"xyz\")\n"
+     "print(len(t))\n"
+     "print(b\"aabbccdd\".translate(t))\n"
+     "print(b\"hello abc world, abc again and again\".translate(t, b\"o \"))\n"
+     "print(b\"hello world\".translate(None, b\"lo\"))\n"
+     "print(b\"hello world\".translate(None, delete=b\"l\"))\n"
+     "print(bytearray(b\"abcabcabcabc\").translate(t))\n"
+     "print(bytearray(b\"abcabc\").translate(None, b\"b\"))\n"
+     "print(bytearray(b\"abcabc\").translate(t, delete=b\"c\"))\n"
+     "print(b\"abc\".translate(bytearray(t)))\n"
+     "print(bytearray.maketrans(b\"ab\", b\"ba\"))\n"
+     "print(b\"same\".translate(None))\n"
+     "try:\n"
+     "    bytes.maketrans(b\"ab\", b\"c\")\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    b\"x\".translate(b\"short\")\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    b\"x\".translate(None, \"x\")\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "print(1000)\n",
+     "256\n"
+     "b'xxyyzzdd'\n"
+     "b'hellxyzwrld,xyzxgxinxndxgxin'\n"
+     "b'he wrd'\n"
+     "b'heo word'\n"
+     "bytearray(b'xyzxyzxyzxyz')\n"
+     "bytearray(b'acac')\n"
+     "bytearray(b'xyxy')\n"
+     "b'xyz'\n"
+     'b\'\\x00\\x01\\x02\\x03\\x04\\x05\\x06\\x07\\x08\\t\\n\\x0b\\x0c\\r\\x0e\\x0f\\x10\\x11\\x12\\x13\\x14\\x15\\x16\\x17\\x18\\x19\\x1a\\x1b\\x1c\\x1d\\x1e\\x1f !"#$%&\\\'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\\\]^_`bacdefghijklmnopqrstuvwxyz{|}~\\x7f\\x80\\x81\\x82\\x83\\x84\\x85\\x86\\x87\\x88\\x89\\x8a\\x8b\\x8c\\x8d\\x8e\\x8f\\x90\\x91\\x92\\x93\\x94\\x95\\x96\\x97\\x98\\x99\\x9a\\x9b\\x9c\\x9d\\x9e\\x9f\\xa0\\xa1\\xa2\\xa3\\xa4\\xa5\\xa6\\xa7\\xa8\\xa9\\xaa\\xab\\xac\\xad\\xae\\xaf\\xb0\\xb1\\xb2\\xb3\\xb4\\xb5\\xb6\\xb7\\xb8\\xb9\\xba\\xbb\\xbc\\xbd\\xbe\\xbf\\xc0\\xc1\\xc2\\xc3\\xc4\\xc5\\xc6\\xc7\\xc8\\xc9\\xca\\xcb\\xcc\\xcd\\xce\\xcf\\xd0\\xd1\\xd2\\xd3\\xd4\\xd5\\xd6\\xd7\\xd8\\xd9\\xda\\xdb\\xdc\\xdd\\xde\\xdf\\xe0\\xe1\\xe2\\xe3\\xe4\\xe5\\xe6\\xe7\\xe8\\xe9\\xea\\xeb\\xec\\xed\\xee\\xef\\xf0\\xf1\\xf2\\xf3\\xf4\\xf5\\xf6\\xf7\\xf8\\xf9\\xfa\\xfb\\xfc\\xfd\\xfe\\xff\'\n'
+     "b'same'\n"
+     "maketrans arguments must have same length\n"
+     "translation table must be 256 characters long\n"
+     "a bytes-like object is required, not 'str'\n"
+     "1000\n"),
+    # struct: pack, unpack, unpack_from, iter_unpack
+    ("import struct\n"
+     "print(struct.calcsize(\"<IHb\"), struct.calcsize(\"@bi\"), struct.calcsize(\"=bi\"), struct.calcsize(\"3s2xh\"))\n"
+     "packed = struct.pack(\"<IhB\", 70000, -2, 255)\n"
+     "print(packed)\n"
+     "print(struct.unpack(\"<IhB\", packed))\n"
+     "print(struct.pack(\">hxI\", 1, 2))\n"
+     "print(struct.unpack(\"!Q\", b\"\\xff\" * 8))\n"
+     "print(struct.unpack(\"<q\", b\"\\xff\" * 8))\n"
+     "print(struct.pack(\"<d\", 1.5), struct.unpack(\"<f\", struct.pack(\"<f\", 0.25)))\n"
+     "print(struct.pack(\"4s\", b\"ab\"), struct.pack(\"2s\", b\"abcd\"), struct.pack(\"5p\", b\"ab\"))\n"
+     "print(struct.unpack(\"5p\", b\"\\x02abcd\"), struct.unpack(\"c?\", b\"z\\x05\"))\n"
+     "print(struct.pack(b\"<2H\", 1, 2))\n"
+     "records = b\"\".join([struct.pack(\"<HH\", i, i * i) for i in range(20)])\n"
+     "total = 0\n"
+     "for a, b in struct.iter_unpack(\"<HH\", records):\n"
+     "    total += a + b\n"
+     "print(total)\n"
+     "print(struct.unpack_from(\"<H\", records, 4), struct.unpack_from(\"<H\", records, offset=-2))\n"
+     "print(struct.unpack_from(\"<H\", buffer=records))\n"
+     "ba = bytearray(b\"\\x01\\x00\\x02\\x00\")\n"
+     "print(struct.unpack(\"<2H\", ba), struct.unpack(\"<H\", memoryview(ba)[2:]))\n"
+     "print(list(struct.iter_unpack(\"<b\", memoryview(b\"\\x01\\x02\\x03\\x04\")[1:])))\n"
+     "try:\n"
+     "    struct.unpack(\"<2b\", memoryview(b\"\\x01\\x02\\x03\\x04\")[::2])\n"
+     "except BufferError as e:\n"
+     "    print(e)\n"
+     "it = struct.iter_unpack(\"<H\", ba)\n"
+     "try:\n"
+     "    ba.append(1)\n"
+     "except BufferError as e:\n"
+     "    print(\"BufferError\", e)\n"
+     "print(list(it))\n"
+     "for call in [lambda: struct.pack(\"b\", 200), lambda: struct.pack(\"<B\", -1), lambda: struct.pack(\"h\", 40000),\n"
+     "             lambda: struct.pack(\"<H\", -1), lambda: struct.pack(\"<i\", 2 ** 31), lambda: struct.pack(\"<I\", -1),\n"
+     "             lambda: struct.pack(\"<q\", 2 ** 63), lambda: struct.pack(\"i\", \"x\"), lambda: struct.pack(\"f\", \"x\"),\n"
+     "             lambda: struct.pack(\"c\", b\"ab\"), lambda: struct.pack(\"s\", 1), lambda: struct.pack(\"ii\", 1),\n"
+     "             lambda: struct.unpack(\"i\", b\"abc\"), lambda: struct.unpack_from(\"i\", b\"abc\", 1),\n"
+     "             lambda: struct.calcsize(\"z\"), lambda: struct.iter_unpack(\"i\", b\"abcde\"),\n"
+     "             lambda: struct.iter_unpack(\"\", b\"\"), lambda: struct.pack(\"3\"), lambda: struct.calcsize(\"i<\"),\n"
+     "             lambda: struct.unpack_from(\"i\", b\"abcd\", -1), lambda: struct.unpack_from(\"i\", b\"abcd\", -5),\n"
+     "             lambda: struct.pack(\"<f\", 1e300)]:\n"
+     "    try:\n"
+     "        call()\n"
+     "    except struct.error as e:\n"
+     "        print(\"error\", e)\n"
+     "    except OverflowError as e:\n"
+     "        print(\"OverflowError\", e)\n"
+     "try:\n"
+     "    struct.unpack(\"i\", \"abcd\")\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    struct.pack(\"q\", 2 ** 70)\n"
+     "except Exception as e:\n"
+     "    print(isinstance(e, struct.error), isinstance(e, ValueError))\n"
+     "print(1000)\n",
+     "7 8 5 8\n"
+     "b'p\\x11\\x01\\x00\\xfe\\xff\\xff'\n"
+     "(70000, -2, 255)\n"
+     "b'\\x00\\x01\\x00\\x00\\x00\\x00\\x02'\n"
+     "(18446744073709551615,)\n"
+     "(-1,)\n"
+     "b'\\x00\\x00\\x00\\x00\\x00\\x00\\xf8?' (0.25,)\n"
+     "b'ab\\x00\\x00' b'ab' b'\\x02ab\\x00\\x00'\n"
+     "(b'ab',) (b'z', True)\n"
+     "b'\\x01\\x00\\x02\\x00'\n"
+     "2660\n"
+     "(1,) (361,)\n"
+     "(0,)\n"
+     "(1, 2) (2,)\n"
+     "[(2,), (3,), (4,)]\n"
+     "memoryview: underlying buffer is not C-contiguous\n"
+     "BufferError Existing exports of data: object cannot be re-sized\n"
+     "[(1,), (2,)]\n"
+     "error byte format requires -128 <= number <= 127\n"
+     "error ubyte format requires 0 <= number <= 255\n"
+     "error short format requires -32768 <= number <= 32767\n"
+     "error ushort format requires 0 <= number <= 65535\n"
+     "error 'i' format requires -2147483648 <= number <= 2147483647\n"
+     "error argument out of range\n"
+     "error argument out of range\n"
+     "error required argument is not an integer\n"
+     "error required argument is not a float\n"
+     "error char format requires a bytes object of length 1\n"
+     "error argument for 's' must be a bytes object\n"
+     "error pack expected 2 items for packing (got 1)\n"
+     "error unpack requires a buffer of 4 bytes\n"
+     "error unpack_from requires a buffer of at least 5 bytes for unpacking 4 bytes at offset 1 (actual buffer size is 3)\n"
+     "error bad char in struct format\n"
+     "error iterative unpacking requires a buffer of a multiple of 4 bytes\n"
+     "error cannot iteratively unpack with a struct of length 0\n"
+     "error repeat count given without format specifier\n"
+     "error bad char in struct format\n"
+     "error not enough data to unpack 4 bytes at offset -1\n"
+     "error offset -5 out of range for 4-byte buffer\n"
+     "OverflowError float too large to pack with f format\n"
+     "a bytes-like object is required, not 'str'\n"
+     "True False\n"
+     "1000\n"),
+    # изменение словаря во время обхода
+    ("d = {\"a\": 1, \"b\": 2, \"c\": 3}\n"
+     "for k in d:\n"
+     "    d[k] = d[k] * 10\n"
+     "print(d)\n"
+     "for k, v in d.items():\n"
+     "    d[k] = v + 1\n"
+     "print(list(d.values()))\n"
+     "try:\n"
+     "    for k in d:\n"
+     "        d[\"new\"] = 0\n"
+     "except RuntimeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    for v in d.values():\n"
+     "        d.pop(\"new\", None)\n"
+     "except RuntimeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    for k, v in d.items():\n"
+     "        del d[k]\n"
+     "except RuntimeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    for k in reversed(d):\n"
+     "        d.clear()\n"
+     "except RuntimeError as e:\n"
+     "    print(e)\n"
+     "e = {i: i for i in range(6)}\n"
+     "for i in range(3):\n"
+     "    del e[i]\n"
+     "print(list(e.items()), list(reversed(e)))\n"
+     "it = iter(e)\n"
+     "print(next(it))\n"
+     "e[3] = \"x\"\n"
+     "print(list(it), e)\n"
+     "print(1000)\n",
+     "{'a': 10, 'b': 20, 'c': 30}\n"
+     "[11, 21, 31]\n"
+     "dictionary changed size during iteration\n"
+     "dictionary changed size during iteration\n"
+     "dictionary changed size during iteration\n"
+     "dictionary changed size during iteration\n"
+     "[(3, 3), (4, 4), (5, 5)] [5, 4, 3]\n"
+     "3\n"
+     "[4, 5] {3: 'x', 4: 4, 5: 5}\n"
+     "1000\n"),
+    # операции множеств над dict.keys() и dict.items()
+    ("a = {\"x\": 1, \"y\": 2, \"z\": 3}\n"
+     "b = {\"y\": 20, \"z\": 3, \"w\": 4}\n"
+     "print(sorted(a.keys() & b.keys()), sorted(a.keys() | b.keys()))\n"
+     "print(sorted(a.keys() - b.keys()), sorted(a.keys() ^ b.keys()))\n"
+     "print(sorted(a.items() & b.items()), sorted(a.items() - b.items()))\n"
+     "print(sorted(a.keys() & [\"x\", \"q\"]), sorted([\"x\", \"q\"] & a.keys()), sorted({\"y\", \"q\"} - a.keys()))\n"
+     "print(sorted({\"y\", \"q\"} | a.keys()), sorted(a.keys() ^ {\"x\", \"q\"}))\n"
+     "print(type(a.keys() & b.keys()).__name__)\n"
+     "print(a.keys().isdisjoint([\"q\"]), a.keys().isdisjoint(b.keys()), a.items().isdisjoint(b.items()))\n"
+     "print(a.items().isdisjoint({(\"x\", 2)}), a.items().isdisjoint([(\"x\", 1)]))\n"
+     "print(sorted(a.items() | {(\"q\", 0)}))\n"
+     "big = {i: i for i in range(1000)}\n"
+     "print(len(big.keys() & {5, 7, 2000}), len(big.keys() - range(10, 1000)))\n"
+     "k = a.keys()\n"
+     "k &= b.keys()\n"
+     "print(sorted(k))\n"
+     "try:\n"
+     "    a.keys() & 5\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "print(1000)\n",
+     "['y', 'z'] ['w', 'x', 'y', 'z']\n"
+     "['x'] ['w', 'x']\n"
+     "[('z', 3)] [('x', 1), ('y', 2)]\n"
+     "['x'] ['x'] ['q']\n"
+     "['q', 'x', 'y', 'z'] ['q', 'y', 'z']\n"
+     "set\n"
+     "True False False\n"
+     "True False\n"
+     "[('q', 0), ('x', 1), ('y', 2), ('z', 3)]\n"
+     "2 10\n"
+     "['y', 'z']\n"
+     "'int' object is not iterable\n"
+     "1000\n"),
+    # малые dict и set: удаление, уплотнение и переход к таблице
+    ("d = {}\n"
+     "for i in range(8):\n"
+     "    d[i] = i * i\n"
+     "del d[3]\n"
+     "del d[0]\n"
+     "d[3] = \"back\"\n"
+     "d[10] = 100\n"
+     "d[11] = 121\n"
+     "print(d, len(d))\n"
+     "d[12] = 144\n"
+     "d[13] = 169\n"
+     "print(list(d.keys()), d.get(5), d.get(0), 3 in d, 0 in d)\n"
+     "for k in list(d):\n"
+     "    if k % 2:\n"
+     "        d.pop(k)\n"
+     "print(d)\n"
+     "s = set()\n"
+     "for i in range(12):\n"
+     "    s.add(i % 9)\n"
+     "    if i % 3 == 0:\n"
+     "        s.discard(i // 2)\n"
+     "print(sorted(s), len(s), 8 in s, 0 in s)\n"
+     "small = {\"a\", \"b\"}\n"
+     "print(\"a\" in small, \"c\" in small, small.pop() in (\"a\", \"b\"), len(small))\n"
+     "kw = dict(x=1, y=2)\n"
+     "kw.update(z=3)\n"
+     "kw.pop(\"x\")\n"
+     "kw[\"x\"] = 4\n"
+     "print(kw, tuple(kw.items()))\n"
+     "print(1000)\n",
+     "{1: 1, 2: 4, 4: 16, 5: 25, 6: 36, 7: 49, 3: 'back', 10: 100, 11: 121} 9\n"
+     "[1, 2, 4, 5, 6, 7, 3, 10, 11, 12, 13] 25 None True False\n"
+     "{2: 4, 4: 16, 6: 36, 10: 100, 12: 144}\n"
+     "[0, 1, 2, 5, 6, 7, 8] 7 True True\n"
+     "True False True 1\n"
+     "{'y': 2, 'z': 3, 'x': 4} (('y', 2), ('z', 3), ('x', 4))\n"
+     "1000\n"),
+    # array: упакованное хранение, срезы, frombytes/tobytes, sum/min/max по буферу, ошибки
+    ("import array\n"
+     "a = array.array('i', [1, 2, 3, 4, 5])\n"
+     "print(a, len(a), a.itemsize, a.typecode)\n"
+     "print(a[1], a[-1], a[1:4], a[::2], a[::-1])\n"
+     "a[0] = 10\n"
+     "a[1:3] = array.array('i', [7, 8, 9])\n"
+     "print(a)\n"
+     "del a[::2]\n"
+     "print(a, 8 in a, 100 in a)\n"
+     "b = array.array('d')\n"
+     "b.frombytes(array.array('d', [1.5, -2.25]).tobytes())\n"
+     "b.frombytes(memoryview(array.array('d', [4.0]).tobytes()))\n"
+     "b.extend([5, 6.5])\n"
+     "print(b, b.tolist())\n"
+     "print(sum(array.array('q', [2**62, 2**62, 2**62])), sum(array.array('i', [1, 2, 3]), 0.5))\n"
+     "print(sum(array.array('d', [0.1, 0.2, 0.3])), min(array.array('b', [3, -7, 5])), max(array.array('H', [3, 65535, 5])))\n"
+     "nan = float('nan')\n"
+     "print(max(array.array('d', [1.0, nan])), min(array.array('f', [0.1])))\n"
+     "c = array.array('B', b'\\x01\\x02\\x03')\n"
+     "c += array.array('B', [4])\n"
+     "c *= 2\n"
+     "print(c, c.index(3), c.count(1), c.pop(), c == array.array('B', [1, 2, 3, 4, 1, 2, 3]))\n"
+     "for code, value in [('b', 128), ('B', -1), ('I', -1), ('q', 2**63)]:\n"
+     "    try:\n"
+     "        array.array(code, [value])\n"
+     "    except OverflowError as e:\n"
+     "        print('OverflowError', e)\n"
+     "for bad in [lambda: array.array('z'), lambda: array.array('i', 'ab'), lambda: array.array('i', [1.5]),\n"
+     "            lambda: array.array('d').frombytes(b'abc'), lambda: array.array('i') + [1],\n"
+     "            lambda: array.array('i').extend(array.array('d')), lambda: array.array('i').pop(),\n"
+     "            lambda: array.array('i', [1])[5]]:\n"
+     "    try:\n"
+     "        bad()\n"
+     "    except Exception as e:\n"
+     "        print(type(e).__name__, e)\n"
+     "print(array.array('i'), array.array('f', [0.5]) == array.array('d', [0.5]), bool(array.array('i')))\n"
+     "print(1000)\n",
+     "array('i', [1, 2, 3, 4, 5]) 5 4 i\n"
+     "2 5 array('i', [2, 3, 4]) array('i', [1, 3, 5]) array('i', [5, 4, 3, 2, 1])\n"
+     "array('i', [10, 7, 8, 9, 4, 5])\n"
+     "array('i', [7, 9, 5]) False False\n"
+     "array('d', [1.5, -2.25, 4.0, 5.0, 6.5]) [1.5, -2.25, 4.0, 5.0, 6.5]\n"
+     "13835058055282163712 6.5\n"
+     "0.6000000000000001 -7 65535\n"
+     "1.0 0.10000000149011612\n"
+     "array('B', [1, 2, 3, 4, 1, 2, 3]) 2 2 4 True\n"
+     "OverflowError signed char is greater than maximum\n"
+     "OverflowError unsigned byte integer is less than minimum\n"
+     "OverflowError can't convert negative value to unsigned int\n"
+     "OverflowError int too big to convert\n"
+     "ValueError bad typecode (must be b, B, u, h, H, i, I, l, L, q, Q, f or d)\n"
+     "TypeError cannot use a str to initialize an array with typecode 'i'\n"
+     "TypeError 'float' object cannot be interpreted as an integer\n"
+     "ValueError bytes length not a multiple of item size\n"
+     "TypeError can only append array (not \"list\") to array\n"
+     "TypeError can only extend with array of same kind\n"
+     "IndexError pop from empty array\n"
+     "IndexError array index out of range\n"
+     "array('i') True False\n"
+     "1000\n"),
+    # async/await: задачи, gather, async for и исключения в корутинах
+    ("import asyncio\n"
+     "\n"
+     "\n"
+     "async def worker(name, delay):\n"
+     "    await asyncio.sleep(delay)\n"
+     "    return name + \" done\"\n"
+     "\n"
+     "\n"
+     "class Countdown:\n"
+     "    def __init__(self, n):\n"
+     "        self.n = n\n"
+     "\n"
+     "    def __aiter__(self):\n"
+     "        return self\n"
+     "\n"
+     "    async def __anext__(self):\n"
+     "        if self.n == 0:\n"
+     "            raise StopAsyncIteration\n"
+     "        self.n -= 1\n"
+     "        await asyncio.sleep(0)\n"
+     "        return self.n\n"
+     "\n"
+     "\n"
+     "async def fail():\n"
+     "    await asyncio.sleep(0.01)\n"
+     "    raise ValueError(\"boom\")\n"
+     "\n"
+     "\n"
+     "async def main():\n"
+     "    task = asyncio.create_task(worker(\"task\", 0.05))\n"
+     "    results = await asyncio.gather(worker(\"a\", 0.15), worker(\"b\", 0.05), worker(\"c\", 0.1))\n"
+     "    print(results)\n"
+     "    print(await task)\n"
+     "\n"
+     "    total = 0\n"
+     "    async for value in Countdown(4):\n"
+     "        total += value\n"
+     "    print(total)\n"
+     "\n"
+     "    try:\n"
+     "        await fail()\n"
+     "    except ValueError as error:\n"
+     "        print(\"caught\", error)\n"
+     "\n"
+     "    print(await asyncio.sleep(0, \"slept\"))\n"
+     "    return \"finished\"\n"
+     "\n"
+     "\n"
+     "print(asyncio.run(main()))\n"
+     "print(1000)\n",
+     "['a done', 'b done', 'c done']\n"
+     "task done\n"
+     "6\n"
+     "caught boom\n"
+     "slept\n"
+     "finished\n"
+     "1000\n"),
+    # кадр функции не видит переменных вызывающего
+    ("def peek():\n"
+     "    try:\n"
+     "        return secret\n"
+     "    except NameError:\n"
+     "        return \"no secret\"\n"
+     "\n"
+     "\n"
+     "def caller():\n"
+     "    secret = \"caller local\"\n"
+     "    return peek()\n"
+     "\n"
+     "\n"
+     "class Base:\n"
+     "    def greet(self):\n"
+     "        return \"base\"\n"
+     "\n"
+     "\n"
+     "class Child(Base):\n"
+     "    def greet(self):\n"
+     "        secret = \"method local\"\n"
+     "        return super().greet() + \" \" + peek()\n"
+     "\n"
+     "\n"
+     "print(caller())\n"
+     "print(Child().greet())\n"
+     "print(peek())\n"
+     "secret = \"global\"\n"
+     "print(caller())\n"
+     "print(1000)\n",
+     "no secret\n"
+     "base no secret\n"
+     "no secret\n"
+     "global\n"
+     "1000\n"),
+    # super() в унаследованном методе начинает с класса, где метод определён
+    ("class A:\n"
+     "    def greet(self):\n"
+     "        return [\"A\"]\n"
+     "\n"
+     "    def describe(self, prefix, suffix=\"!\"):\n"
+     "        return prefix + type(self).__name__ + suffix\n"
+     "\n"
+     "\n"
+     "class B(A):\n"
+     "    def greet(self):\n"
+     "        return [\"B\"] + super().greet()\n"
+     "\n"
+     "\n"
+     "class C(B):\n"
+     "    pass\n"
+     "\n"
+     "\n"
+     "class D(C):\n"
+     "    def greet(self):\n"
+     "        return [\"D\"] + super().greet()\n"
+     "\n"
+     "\n"
+     "print(C().greet())\n"
+     "print(D().greet())\n"
+     "print(B.greet(D()))\n"
+     "\n"
+     "d = D()\n"
+     "method = d.describe\n"
+     "print(method(\"type: \"))\n"
+     "print(method(prefix=\"<\", suffix=\">\"))\n"
+     "print(1000)\n",
+     "['B', 'A']\n"
+     "['D', 'B', 'A']\n"
+     "['B', 'A']\n"
+     "type: D!\n"
+     "<D>\n"
+     "1000\n"),
+    # создание экземпляров: __init__ из кэша класса и его сброс при замене
+    ("class Point:\n"
+     "    def __init__(self, x, y):\n"
+     "        self.x = x\n"
+     "        self.y = y\n"
+     "\n"
+     "\n"
+     "class Point3(Point):\n"
+     "    pass\n"
+     "\n"
+     "\n"
+     "class Empty:\n"
+     "    pass\n"
+     "\n"
+     "\n"
+     "class AppError(Exception):\n"
+     "    def __init__(self, code):\n"
+     "        super().__init__(\"code \" + str(code))\n"
+     "        self.code = code\n"
+     "\n"
+     "\n"
+     "points = [Point(i, i * 2) for i in range(1000)]\n"
+     "print(sum(p.x + p.y for p in points))\n"
+     "print(Point3(1, 2).y)\n"
+     "\n"
+     "\n"
+     "def init3(self, x, y, z=0):\n"
+     "    self.x = x\n"
+     "    self.y = y\n"
+     "    self.z = z\n"
+     "\n"
+     "\n"
+     "Point.__init__ = init3\n"
+     "p = Point3(1, 2, 3)\n"
+     "print(p.x, p.y, p.z)\n"
+     "\n"
+     "try:\n"
+     "    Empty(1)\n"
+     "except TypeError as error:\n"
+     "    print(\"TypeError\")\n"
+     "\n"
+     "try:\n"
+     "    raise AppError(7)\n"
+     "except AppError as error:\n"
+     "    print(error.code, error.args)\n"
+     "\n"
+     "print(str(), str(12), bytes(3), bytearray(b\"ab\"))\n"
+     "print(1000)\n",
+     "1498500\n"
+     "2\n"
+     "1 2 3\n"
+     "TypeError\n"
+     "7 ('code 7',)\n"
+     " 12 b'\\x00\\x00\\x00' bytearray(b'ab')\n"
+     "1000\n"),
+    # роль атрибута класса в протоколе дескрипторов и её пересчёт
+    ("class Loud:\n"
+     "    def __get__(self, obj, owner):\n"
+     "        return \"loud\"\n"
+     "\n"
+     "\n"
+     "class Guard:\n"
+     "    def __get__(self, obj, owner):\n"
+     "        return \"guarded\"\n"
+     "\n"
+     "    def __set__(self, obj, value):\n"
+     "        obj.stored = value\n"
+     "\n"
+     "\n"
+     "class Box:\n"
+     "    loud = Loud()\n"
+     "    guard = Guard()\n"
+     "    plain = 5\n"
+     "\n"
+     "    @property\n"
+     "    def size(self):\n"
+     "        return 10\n"
+     "\n"
+     "    @staticmethod\n"
+     "    def make():\n"
+     "        return \"static\"\n"
+     "\n"
+     "    @classmethod\n"
+     "    def kind(cls):\n"
+     "        return cls.__name__\n"
+     "\n"
+     "\n"
+     "b = Box()\n"
+     "print(b.loud, b.guard, b.plain, b.size, b.make(), b.kind(), Box.loud)\n"
+     "b.loud = \"field\"\n"
+     "b.guard = \"ignored\"\n"
+     "b.plain = 6\n"
+     "print(b.loud, b.guard, b.plain, Box.plain)\n"
+     "\n"
+     "\n"
+     "def late_set(self, obj, value):\n"
+     "    pass\n"
+     "\n"
+     "\n"
+     "Loud.__set__ = late_set\n"
+     "print(b.loud)\n"
+     "b.loud = \"again\"\n"
+     "print(b.loud)\n"
+     "print(1000)\n",
+     "loud guarded 5 10 static Box loud\n"
+     "field guarded 6 5\n"
+     "loud\n"
+     "loud\n"
+     "1000\n"),
+    # цепочка super().__init__ в ромбовидной иерархии, super() в property и classmethod
+    ("class Base:\n"
+     "    def __init__(self, log):\n"
+     "        self.log = log\n"
+     "        log.append(\"Base\")\n"
+     "\n"
+     "    @property\n"
+     "    def depth(self):\n"
+     "        return len(self.log)\n"
+     "\n"
+     "    @classmethod\n"
+     "    def make(cls):\n"
+     "        return cls.__name__\n"
+     "\n"
+     "\n"
+     "class Left(Base):\n"
+     "    def __init__(self, log):\n"
+     "        log.append(\"Left\")\n"
+     "        super().__init__(log)\n"
+     "\n"
+     "\n"
+     "class Right(Base):\n"
+     "    def __init__(self, log):\n"
+     "        log.append(\"Right\")\n"
+     "        super().__init__(log)\n"
+     "\n"
+     "    @classmethod\n"
+     "    def make(cls):\n"
+     "        return \"Right>\" + super().make()\n"
+     "\n"
+     "\n"
+     "class Diamond(Left, Right):\n"
+     "    def __init__(self, log):\n"
+     "        log.append(\"Diamond\")\n"
+     "        super().__init__(log)\n"
+     "\n"
+     "    @property\n"
+     "    def depth(self):\n"
+     "        return super().depth * 10\n"
+     "\n"
+     "\n"
+     "for i in range(3):\n"
+     "    d = Diamond([])\n"
+     "print(d.log, d.depth, Diamond.make())\n"
+     "print(Left([]).depth)\n"
+     "print(1000)\n",
+     "['Diamond', 'Left', 'Right', 'Base'] 40 Right>Diamond\n"
+     "2\n"
+     "1000\n"),
+    # global и nonlocal, разрешённые при разборе
+    ("counter = 0\n"
+     "total = 0\n"
+     "\n"
+     "\n"
+     "def bump(n):\n"
+     "    global counter, total\n"
+     "    local = 0\n"
+     "    for i in range(n):\n"
+     "        counter += 1\n"
+     "        local += i\n"
+     "    total = total + local\n"
+     "    return local\n"
+     "\n"
+     "\n"
+     "def outer():\n"
+     "    counter = \"outer local\"\n"
+     "\n"
+     "    def inner():\n"
+     "        global counter\n"
+     "        counter += 100\n"
+     "        return counter\n"
+     "\n"
+     "    def rebinder():\n"
+     "        nonlocal counter\n"
+     "        counter = counter + \"!\"\n"
+     "        return counter\n"
+     "\n"
+     "    return inner(), rebinder(), counter\n"
+     "\n"
+     "\n"
+     "print(bump(10), counter, total)\n"
+     "print(bump(5), counter, total)\n"
+     "print(outer())\n"
+     "print(counter)\n"
+     "\n"
+     "\n"
+     "def make_global():\n"
+     "    global created\n"
+     "    created = \"made\"\n"
+     "\n"
+     "\n"
+     "make_global()\n"
+     "print(created)\n"
+     "print(1000)\n",
+     "45 10 45\n"
+     "10 15 55\n"
+     "(115, 'outer local!', 'outer local!')\n"
+     "115\n"
+     "made\n"
+     "1000\n"),
+    # индексация машинным целым: list, tuple, str, bytes, bytearray
+    ("n = 6\n"
+     "grid = [[0] * n for _ in range(n)]\n"
+     "for i in range(n):\n"
+     "    for j in range(n):\n"
+     "        grid[i][j] = (grid[i - 1][j] if i else 1) + (grid[i][j - 1] if j else 0)\n"
+     "print(grid[n - 1][n - 1], grid[-1][-2])\n"
+     "\n"
+     "word = \"matrix\"\n"
+     "pair = (10, 20, 30)\n"
+     "data = b\"\\x01\\xff\"\n"
+     "buf = bytearray(b\"abc\")\n"
+     "buf[1] = 120\n"
+     "buf[-1] = 121\n"
+     "print(word[0], word[-1], pair[1], pair[-3], data[1], data[-2], buf, buf[0])\n"
+     "\n"
+     "for target in ([1, 2], (1, 2), \"ab\", b\"ab\", bytearray(b\"ab\")):\n"
+     "    try:\n"
+     "        target[5]\n"
+     "    except IndexError as error:\n"
+     "        print(\"IndexError\", error)\n"
+     "\n"
+     "try:\n"
+     "    grid[0][99] = 1\n"
+     "except IndexError as error:\n"
+     "    print(error)\n"
+     "try:\n"
+     "    buf[0] = 300\n"
+     "except ValueError as error:\n"
+     "    print(error)\n"
+     "print(1000)\n",
+     "462 210\n"
+     "m x 20 10 255 1 bytearray(b'axy') 97\n"
+     "IndexError list index out of range\n"
+     "IndexError tuple index out of range\n"
+     "IndexError string index out of range\n"
+     "IndexError index out of range\n"
+     "IndexError bytearray index out of range\n"
+     "list assignment index out of range\n"
+     "byte must be in range(0, 256)\n"
+     "1000\n"),
+    # сравнение строк и кортежей, тождество элементов в контейнерах
+    ("words = [\"alpha\", \"beta\", \"gamma\", \"delta\", \"beta\"]\n"
+     "print(\"gamma\" in words, \"omega\" in words, \"omega\" not in words)\n"
+     "print(words.count(\"beta\"), words.index(\"delta\"), (\"x\", \"y\").index(\"y\"))\n"
+     "print(\"abc\" < \"abd\", \"b\" > \"abc\", \"abc\" <= \"abc\", \"abc\" >= \"abd\", \"abc\" != \"abc\")\n"
+     "print(sorted([\"pear\", \"apple\", \"fig\", \"apple\"]))\n"
+     "\n"
+     "pair = (1, \"two\", (3.5, None))\n"
+     "print(pair == (1, \"two\", (3.5, None)), pair != (1, \"two\"), pair == pair)\n"
+     "print((1, 2) < (1, 3), (1, \"a\") == (1, 1), [1, \"a\"] == [1, \"a\"])\n"
+     "\n"
+     "class Token:\n"
+     "    pass\n"
+     "\n"
+     "token = Token()\n"
+     "other = Token()\n"
+     "bag = [other, token]\n"
+     "print(token in bag, bag.index(token), bag.count(token), [token] == [token], (token,) == (token,))\n"
+     "print(1000)\n",
+     "True False True\n"
+     "2 3 1\n"
+     "True True True False False\n"
+     "['apple', 'apple', 'fig', 'pear']\n"
+     "True True True\n"
+     "True False True\n"
+     "True 1 1 True True\n"
+     "1000\n"),
+    # цепочки сравнений в условиях if, while и включений
+    ("def classify(x):\n"
+     "    if 0 <= x < 10:\n"
+     "        return \"digit\"\n"
+     "    elif 10 <= x < 100 <= 1000:\n"
+     "        return \"two\"\n"
+     "    elif x < 0 and -10 < x:\n"
+     "        return \"small negative\"\n"
+     "    return \"other\"\n"
+     "\n"
+     "print([classify(v) for v in (-20, -5, 0, 9, 10, 99, 100)])\n"
+     "\n"
+     "calls = []\n"
+     "def probe(v):\n"
+     "    calls.append(v)\n"
+     "    return v\n"
+     "\n"
+     "if probe(1) < probe(2) > probe(5) < probe(9):\n"
+     "    print(\"unexpected\")\n"
+     "print(calls)\n"
+     "\n"
+     "i, seen = 0, []\n"
+     "while 0 <= i < 10 != i * 3:\n"
+     "    seen.append(i)\n"
+     "    i += 3\n"
+     "print(seen, i)\n"
+     "\n"
+     "print([n for n in range(30) if 3 < n <= 12 and n % 2 or n == 29])\n"
+     "print(1 < 2 < 3, 3 > 2 > 2, \"a\" < \"b\" in [\"b\"], [] == [] is not None)\n"
+     "print(1000)\n",
+     "['other', 'small negative', 'digit', 'digit', 'two', 'two', 'other']\n"
+     "[1, 2, 5]\n"
+     "[0, 3, 6, 9] 12\n"
+     "[5, 7, 9, 11, 29]\n"
+     "True False True True\n"
+     "1000\n"),
+    # условия с not, and и or в if, while и включениях
+    ("def check(flags, limit):\n"
+     "    out = []\n"
+     "    for x in range(limit):\n"
+     "        if not x % 3 or x == 4:\n"
+     "            out.append(x)\n"
+     "        elif not (x < 6) and not flags:\n"
+     "            out.append(-x)\n"
+     "        elif x == 5 or flags and x > 6:\n"
+     "            out.append(x * 10)\n"
+     "    return out\n"
+     "\n"
+     "print(check([], 10))\n"
+     "print(check([1], 10))\n"
+     "\n"
+     "queue = [3, 0, 2]\n"
+     "done = False\n"
+     "while not done and queue or len(queue) > 5:\n"
+     "    item = queue.pop()\n"
+     "    done = item == 0\n"
+     "print(queue, done)\n"
+     "\n"
+     "empty = \"\"\n"
+     "print(not empty, not not empty, [v for v in [\"\", \"a\", 0, 2] if not v])\n"
+     "print(1000)\n",
+     "[0, 3, 4, 50, 6, -7, -8, 9]\n"
+     "[0, 3, 4, 50, 6, 70, 80, 9]\n"
+     "[3] True\n"
+     "True False ['', 0]\n"
+     "1000\n"),
+    # глубокая рекурсия без стека C++, sys.setrecursionlimit и RecursionError
+    ("import sys\n"
+     "\n"
+     "sys.setrecursionlimit(60000)\n"
+     "print(sys.getrecursionlimit())\n"
+     "\n"
+     "def depth(n):\n"
+     "    if n == 0:\n"
+     "        return 0\n"
+     "    return 1 + depth(n - 1)\n"
+     "\n"
+     "def count_down(n, acc):\n"
+     "    if n == 0:\n"
+     "        return acc\n"
+     "    return count_down(n - 1, acc + n)\n"
+     "\n"
+     "class Node:\n"
+     "    def __init__(self, value, child):\n"
+     "        self.value = value\n"
+     "        self.child = child\n"
+     "\n"
+     "    def total(self):\n"
+     "        if self.child is None:\n"
+     "            return self.value\n"
+     "        return self.value + self.child.total()\n"
+     "\n"
+     "chain = None\n"
+     "for i in range(40000):\n"
+     "    chain = Node(i, chain)\n"
+     "\n"
+     "print(depth(40000), count_down(40000, 0), chain.total())\n"
+     "\n"
+     "sys.setrecursionlimit(200)\n"
+     "\n"
+     "def forever(n):\n"
+     "    return forever(n + 1)\n"
+     "\n"
+     "def guarded(n):\n"
+     "    try:\n"
+     "        return guarded(n + 1)\n"
+     "    except RecursionError:\n"
+     "        return n\n"
+     "\n"
+     "try:\n"
+     "    forever(0)\n"
+     "except RecursionError as error:\n"
+     "    print(\"RecursionError\", error)\n"
+     "\n"
+     "print(guarded(0) > 100)\n"
+     "\n"
+     "try:\n"
+     "    sys.setrecursionlimit(0)\n"
+     "except ValueError as error:\n"
+     "    print(error)\n"
+     "print(1000)\n",
+     "60000\n"
+     "40000 800020000 799980000\n"
+     "RecursionError maximum recursion depth exceeded\n"
+     "True\n"
+     "recursion limit must be greater or equal than 1\n"
+     "1000\n"),
+    # functools.lru_cache и cache: попадания, вытеснение, cache_info, cache_clear
+    ("from functools import lru_cache, cache\n"
+     "\n"
+     "@cache\n"
+     "def fib(n):\n"
+     "    if n < 2:\n"
+     "        return n\n"
+     "    return fib(n - 1) + fib(n - 2)\n"
+     "\n"
+     "print(fib(80))\n"
+     "info = fib.cache_info()\n"
+     "print(info.hits, info.misses, info.maxsize, info.currsize)\n"
+     "print(info)\n"
+     "\n"
+     "calls = []\n"
+     "\n"
+     "@lru_cache(maxsize=2)\n"
+     "def square(x, scale=1):\n"
+     "    calls.append(x)\n"
+     "    return x * x * scale\n"
+     "\n"
+     "print(square(2), square(3), square(2))\n"
+     "print(square(4))\n"
+     "print(square(3))\n"
+     "print(square(2, scale=10), square(2, scale=10))\n"
+     "print(calls)\n"
+     "print(square.cache_info() == (2, 6, 2, 2), square.cache_info()[0])\n"
+     "square.cache_clear()\n"
+     "print(square.cache_info())\n"
+     "\n"
+     "@lru_cache\n"
+     "def grid(r, c):\n"
+     "    if r == 0 or c == 0:\n"
+     "        return 1\n"
+     "    return grid(r - 1, c) + grid(r, c - 1)\n"
+     "\n"
+     "print(grid(16, 16), grid.__name__, grid.__wrapped__(1, 1))\n"
+     "\n"
+     "@lru_cache(maxsize=0)\n"
+     "def ident(x):\n"
+     "    return x\n"
+     "\n"
+     "print(ident(1), ident(1), ident.cache_info())\n"
+     "\n"
+     "try:\n"
+     "    fib([1])\n"
+     "except TypeError:\n"
+     "    print(\"unhashable\")\n"
+     "print(1000)\n",
+     "23416728348467685\n"
+     "78 81 None 81\n"
+     "CacheInfo(hits=78, misses=81, maxsize=None, currsize=81)\n"
+     "4 9 4\n"
+     "16\n"
+     "9\n"
+     "40 40\n"
+     "[2, 3, 4, 3, 2]\n"
+     "False 2\n"
+     "CacheInfo(hits=0, misses=0, maxsize=2, currsize=0)\n"
+     "601080390 grid 2\n"
+     "1 1 CacheInfo(hits=0, misses=2, maxsize=0, currsize=0)\n"
+     "unhashable\n"
+     "1000\n"),
+    # heapq и bisect: куча на месте, nsmallest/nlargest, бинарный поиск и вставка с key
+    ("import heapq\n"
+     "from bisect import bisect_left, bisect_right, bisect, insort, insort_left\n"
+     "\n"
+     "heap = []\n"
+     "for x in [5, 1, 8, 3, 9, 2, 7, 1]:\n"
+     "    heapq.heappush(heap, x)\n"
+     "print(heap)\n"
+     "print([heapq.heappop(heap) for i in range(len(heap))])\n"
+     "\n"
+     "data = [9, 4, 7, 1, 8, 2, 6, 3, 5, 0]\n"
+     "heapq.heapify(data)\n"
+     "print(data)\n"
+     "print(heapq.heappushpop(data, -1), heapq.heapreplace(data, 10), data)\n"
+     "\n"
+     "tasks = []\n"
+     "heapq.heappush(tasks, (2, \"write\"))\n"
+     "heapq.heappush(tasks, (1, \"plan\"))\n"
+     "heapq.heappush(tasks, (3, \"ship\"))\n"
+     "heapq.heappush(tasks, (1, \"coffee\"))\n"
+     "while tasks:\n"
+     "    print(heapq.heappop(tasks))\n"
+     "\n"
+     "words = [\"pear\", \"fig\", \"banana\", \"kiwi\", \"apple\", \"date\", \"plum\"]\n"
+     "print(heapq.nsmallest(3, words), heapq.nlargest(2, words))\n"
+     "print(heapq.nsmallest(4, words, key=len), heapq.nlargest(3, words, key=len))\n"
+     "print(heapq.nsmallest(0, words), heapq.nlargest(20, [3.5, 1.25, 2.0]))\n"
+     "\n"
+     "try:\n"
+     "    heapq.heappop([])\n"
+     "except IndexError:\n"
+     "    print(\"empty\")\n"
+     "\n"
+     "a = [1, 2, 2, 2, 4, 7, 9]\n"
+     "print(bisect_left(a, 2), bisect_right(a, 2), bisect(a, 5), bisect_left(a, 10), bisect_left(a, 2, 2), bisect_right(a, 2, 0, 3))\n"
+     "print(bisect_left((1.5, 2.5, 3.5), 2.5), bisect([\"a\", \"c\", \"e\"], \"d\"))\n"
+     "insort(a, 3)\n"
+     "insort_left(a, 2)\n"
+     "print(a)\n"
+     "\n"
+     "people = [(\"ann\", 25), (\"bob\", 30), (\"cid\", 35)]\n"
+     "print(bisect_left(people, 30, key=lambda p: p[1]))\n"
+     "insort(people, (\"dan\", 31), key=lambda p: p[1])\n"
+     "print(people)\n"
+     "try:\n"
+     "    bisect(a, 1, -1)\n"
+     "except ValueError:\n"
+     "    print(\"lo\")\n"
+     "print(1000)\n",
+     "[1, 1, 2, 3, 9, 8, 7, 5]\n"
+     "[1, 1, 2, 3, 5, 7, 8, 9]\n"
+     "[0, 1, 2, 3, 4, 7, 6, 9, 5, 8]\n"
+     "-1 0 [1, 3, 2, 5, 4, 7, 6, 9, 10, 8]\n"
+     "(1, 'coffee')\n"
+     "(1, 'plan')\n"
+     "(2, 'write')\n"
+     "(3, 'ship')\n"
+     "['apple', 'banana', 'date'] ['plum', 'pear']\n"
+     "['fig', 'pear', 'kiwi', 'date'] ['banana', 'apple', 'pear']\n"
+     "[] [3.5, 2.0, 1.25]\n"
+     "empty\n"
+     "1 4 5 7 2 3\n"
+     "1 2\n"
+     "[1, 2, 2, 2, 2, 3, 4, 7, 9]\n"
+     "1\n"
+     "[('ann', 25), ('bob', 30), ('dan', 31), ('cid', 35)]\n"
+     "lo\n"
+     "1000\n"),
+    # collections: defaultdict, Counter и OrderedDict с move_to_end
+    ("from collections import defaultdict, Counter, OrderedDict\n"
+     "d = defaultdict(list)\n"
+     "for k, v in [(\"a\", 1), (\"b\", 2), (\"a\", 3)]:\n"
+     "    d[k].append(v)\n"
+     "print(d[\"a\"], d[\"b\"], len(d))\n"
+     "print(d.default_factory is list)\n"
+     "n = defaultdict(int)\n"
+     "for ch in \"abracadabra\":\n"
+     "    n[ch] += 1\n"
+     "print(sorted(n.items()))\n"
+     "print(repr(defaultdict(int, {\"x\": 1})))\n"
+     "try:\n"
+     "    defaultdict(5)\n"
+     "except TypeError:\n"
+     "    print(\"te\")\n"
+     "c = Counter(\"the quick the lazy the dog\".split())\n"
+     "print(c.most_common(2))\n"
+     "print(c[\"missing\"], \"missing\" in c)\n"
+     "c.update([\"dog\", \"cat\"])\n"
+     "c.subtract({\"the\": 1})\n"
+     "print(c[\"the\"], c[\"dog\"], c[\"cat\"], c.total())\n"
+     "print(sorted(Counter(\"aabbbc\").elements()))\n"
+     "a = Counter(a=3, b=1)\n"
+     "b = Counter(a=1, b=2)\n"
+     "print(a + b, a - b, a | b, a & b)\n"
+     "print(Counter(a=1, b=0) == Counter(a=1))\n"
+     "print(Counter())\n"
+     "print(repr(Counter(\"abbccc\")))\n"
+     "o = OrderedDict([(\"x\", 1), (\"y\", 2), (\"z\", 3)])\n"
+     "o.move_to_end(\"x\")\n"
+     "print(list(o))\n"
+     "o.move_to_end(\"z\", last=False)\n"
+     "print(list(o))\n"
+     "print(o.popitem(last=False), o.popitem())\n"
+     "print(o, OrderedDict())\n"
+     "p = OrderedDict(a=1, b=2)\n"
+     "q = OrderedDict(b=2, a=1)\n"
+     "print(p == q, p == {\"b\": 2, \"a\": 1}, dict(p) == dict(q))\n"
+     "try:\n"
+     "    o.move_to_end(\"nope\")\n"
+     "except KeyError:\n"
+     "    print(\"ke\")\n"
+     "print(1000)\n",
+     "[1, 3] [2] 2\n"
+     "True\n"
+     "[('a', 5), ('b', 2), ('c', 1), ('d', 1), ('r', 2)]\n"
+     "defaultdict(<class 'int'>, {'x': 1})\n"
+     "te\n"
+     "[('the', 3), ('quick', 1)]\n"
+     "0 False\n"
+     "2 2 1 7\n"
+     "['a', 'a', 'b', 'b', 'b', 'c']\n"
+     "Counter({'a': 4, 'b': 3}) Counter({'a': 2}) Counter({'a': 3, 'b': 2}) Counter({'a': 1, 'b': 1})\n"
+     "True\n"
+     "Counter()\n"
+     "Counter({'c': 3, 'b': 2, 'a': 1})\n"
+     "['y', 'z', 'x']\n"
+     "['z', 'y', 'x']\n"
+     "('z', 3) ('x', 1)\n"
+     "OrderedDict([('y', 2)]) OrderedDict()\n"
+     "False True True\n"
+     "ke\n"
+     "1000\n"),
+    # json: loads/dumps, ошибки разбора, indent, sort_keys, default и object_hook
+    ("import json\n"
+     'doc = json.loads(\'{"name": "cppython", "tags": ["a", "b"], "n": -12, "big": 123456789012345678901234567890, "pi": 3.5e2, "ok": true, "none": null, "esc": "tab\\\\tq\\\\"\\\\u00e9\\\\ud83d\\\\ude00"}\')\n'
+     "print(doc[\"name\"], doc[\"tags\"], doc[\"n\"], doc[\"big\"], doc[\"pi\"], doc[\"ok\"], doc[\"none\"])\n"
+     "print(doc[\"esc\"] == \"tab\\tq\\\"é😀\")\n"
+     'rows = json.loads(\'[{"id": 1, "v": 0.5}, {"id": 2, "v": 1e-3}, {}, []]\')\n'
+     "print(rows, len(rows))\n"
+     "print(json.dumps({\"a\": [1, 2.5, None, True, False], \"b\": \"x\\nyé\", \"c\": {}}))\n"
+     "print(json.dumps({\"a\": \"é\"}, ensure_ascii=False))\n"
+     "print(json.dumps([1, {\"z\": 1, \"a\": [2, 3]}], indent=2, sort_keys=True))\n"
+     "print(json.dumps((1, 2), separators=(\",\", \":\")))\n"
+     "print(json.dumps({1: \"x\", 2.5: \"y\", None: 0, True: 1}))\n"
+     "print(json.dumps(float(\"inf\")), json.dumps(float(\"nan\")), json.loads(\"[NaN, -Infinity]\")[1])\n"
+     "print(json.loads(json.dumps(\"quote\\\" back\\\\ ctl\\x01\")) == \"quote\\\" back\\\\ ctl\\x01\")\n"
+     'for bad in [\'\', \'[1, 2\', \'{"a" 1}\', \'{"a": 1,}\', \'[1] x\', \'"abc\', \'{1: 2}\', \'"\\\\q"\']:\n'
+     "    try:\n"
+     "        json.loads(bad)\n"
+     "    except json.JSONDecodeError as e:\n"
+     "        print(\"error:\", e)\n"
+     "try:\n"
+     "    json.loads(\"[1,\\n 2,\\n ]\")\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    json.dumps({\"s\": {1, 2}})\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "print(json.dumps({\"s\": {3}}, default=lambda o: sorted(o)))\n"
+     "loop = []\n"
+     "loop.append(loop)\n"
+     "try:\n"
+     "    json.dumps(loop)\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    json.dumps(float(\"nan\"), allow_nan=False)\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     'print(json.loads(\'{"a": {"b": 1}}\', object_hook=lambda d: len(d)))\n'
+     'print(json.loads(b\'{"k": [1, 2]}\'))\n'
+     "print(json.dumps({(1, 2): 1, \"k\": 2}, skipkeys=True))\n"
+     "print(1000)\n",
+     "cppython ['a', 'b'] -12 123456789012345678901234567890 350.0 True None\n"
+     "True\n"
+     "[{'id': 1, 'v': 0.5}, {'id': 2, 'v': 0.001}, {}, []] 4\n"
+     "{\"a\": [1, 2.5, null, true, false], \"b\": \"x\\ny\\u00e9\", \"c\": {}}\n"
+     "{\"a\": \"é\"}\n"
+     "[\n"
+     "  1,\n"
+     "  {\n"
+     "    \"a\": [\n"
+     "      2,\n"
+     "      3\n"
+     "    ],\n"
+     "    \"z\": 1\n"
+     "  }\n"
+     "]\n"
+     "[1,2]\n"
+     "{\"1\": 1, \"2.5\": \"y\", \"null\": 0}\n"
+     "Infinity NaN -inf\n"
+     "True\n"
+     "error: Expecting value: line 1 column 1 (char 0)\n"
+     "error: Expecting ',' delimiter: line 1 column 6 (char 5)\n"
+     "error: Expecting ':' delimiter: line 1 column 6 (char 5)\n"
+     "error: Expecting property name enclosed in double quotes: line 1 column 9 (char 8)\n"
+     "error: Extra data: line 1 column 5 (char 4)\n"
+     "error: Unterminated string starting at: line 1 column 1 (char 0)\n"
+     "error: Expecting property name enclosed in double quotes: line 1 column 2 (char 1)\n"
+     "error: Invalid \\escape: line 1 column 2 (char 1)\n"
+     "Expecting value: line 3 column 2 (char 9)\n"
+     "Object of type set is not JSON serializable\n"
+     "{\"s\": [3]}\n"
+     "Circular reference detected\n"
+     "Out of range float values are not JSON compliant\n"
+     "1\n"
+     "{'k': [1, 2]}\n"
+     "{\"k\": 2}\n"
+     "1000\n"),
+    # marshal: общие ссылки и циклы переживают dumps/loads
+    ("import marshal\n"
+     "shared = [1, 2]\n"
+     "data = {\"a\": shared, \"b\": shared, \"n\": -5, \"big\": 2 ** 100, \"f\": 0.25, \"s\": \"привет\", \"raw\": b\"\\x00\\x01\", \"t\": (1, \"x\"), \"fs\": frozenset([3]), \"set\": {4}}\n"
+     "back = marshal.loads(marshal.dumps(data))\n"
+     "print(back == data, back[\"a\"] is back[\"b\"], back[\"s\"], back[\"big\"])\n"
+     "back[\"a\"].append(3)\n"
+     "print(back[\"b\"])\n"
+     "loop = [1]\n"
+     "loop.append(loop)\n"
+     "copy = marshal.loads(marshal.dumps(loop))\n"
+     "print(copy[1] is copy, copy[0])\n"
+     "print(1000)\n",
+     "True True привет 1267650600228229401496703205376\n"
+     "[1, 2, 3]\n"
+     "True 1\n"
+     "1000\n"),
+    # модуль re: Pattern, Match, findall, sub, split, флаги и кэш шаблонов
+    ("import re\n"
+     "\n"
+     "p = re.compile(\"(\\\\d+)-(\\\\w+)\")\n"
+     "m = p.match(\"12-ab rest\")\n"
+     "print(m.group(), m.group(1), m.group(2), m.group(1, 2))\n"
+     "print(m.groups(), m.span(), m.start(2), m.end(2), m[1])\n"
+     "print(m)\n"
+     "print(p.match(\"x12-ab\"), p.search(\"x12-ab\").span())\n"
+     "print(p.fullmatch(\"12-ab\"), p.fullmatch(\"12-ab \") is None)\n"
+     "print(p.pattern, p.groups, p.flags == re.UNICODE)\n"
+     "print(p)\n"
+     "\n"
+     "d = re.match(\"(?P<key>\\\\w+)=(?P<value>\\\\w*)(;)?\", \"name=bob\")\n"
+     "print(d.groupdict(), d.group(\"key\"), d[\"value\"], d.groups(), d.groups(\"-\"))\n"
+     "print(d.lastindex, d.lastgroup, d.re is re.compile(\"(?P<key>\\\\w+)=(?P<value>\\\\w*)(;)?\"))\n"
+     "print(sorted(re.compile(\"(?P<a>x)(?P<b>y)\").groupindex.items()))\n"
+     "\n"
+     "print(re.findall(\"\\\\d+\", \"a1b22c333\"))\n"
+     "print(re.findall(\"(\\\\w)=(\\\\d)\", \"a=1, b=2, c\"))\n"
+     "print(re.findall(\"(a)|b\", \"ab\"))\n"
+     "print([x.group() for x in re.finditer(\"[aeiou]\", \"education\")])\n"
+     "print(re.sub(\"(\\\\w+)@(\\\\w+)\", \"\\\\2 at \\\\1\", \"joe@site, ann@home\"))\n"
+     "print(re.sub(\"\\\\d\", lambda m: str(int(m.group()) * 2), \"a1b2c3\"))\n"
+     "print(re.subn(\"o\", \"0\", \"foo boo\", count=3))\n"
+     "print(re.sub(\"(?P<w>\\\\w+)\", \"<\\\\g<w>>\", \"hi there\"))\n"
+     "print(re.split(\"[,;]\\\\s*\", \"a, b;c\"), re.split(\"(-)\", \"1-2-3\"), re.split(\",\", \"a,b,c\", 1))\n"
+     "print(re.match(\"HELLO\", \"hello world\", re.I).group(), re.findall(\"^\\\\w\", \"ab\\ncd\", re.M))\n"
+     "print(re.search(\"a.b\", \"a\\nb\", re.S) is not None, re.search(\"a.b\", \"a\\nb\") is None)\n"
+     "print(re.escape(\"1.5*x+y\"), re.I == 2, re.IGNORECASE | re.MULTILINE)\n"
+     "print(re.compile(\"x\", re.I | re.M))\n"
+     "print(re.compile(\"a b # space\", re.X).match(\"ab\").group())\n"
+     "print(d.expand(\"\\\\g<value> is \\\\1\"), p.match(\"7-z\").expand(\"[\\\\2\\\\1]\"))\n"
+     "try:\n"
+     "    re.compile(\"(abc\")\n"
+     "except re.error:\n"
+     "    print(\"error\")\n"
+     "try:\n"
+     "    m.group(5)\n"
+     "except IndexError as e:\n"
+     "    print(e)\n"
+     "s = \"x\" * 100 + \"hello\" + \"y\" * 100\n"
+     "print(len(re.search(\"h\\\\w+o\", s).group()), re.search(\"l+\", s).span())\n"
+     "print(1000)\n",
+     "12-ab 12 ab ('12', 'ab')\n"
+     "('12', 'ab') (0, 5) 3 5 12\n"
+     "<re.Match object; span=(0, 5), match='12-ab'>\n"
+     "None (1, 6)\n"
+     "<re.Match object; span=(0, 5), match='12-ab'> True\n"
+     "(\\d+)-(\\w+) 2 True\n"
+     "re.compile('(\\\\d+)-(\\\\w+)')\n"
+     "{'key': 'name', 'value': 'bob'} name bob ('name', 'bob', None) ('name', 'bob', '-')\n"
+     "2 value True\n"
+     "[('a', 1), ('b', 2)]\n"
+     "['1', '22', '333']\n"
+     "[('a', '1'), ('b', '2')]\n"
+     "['a', '']\n"
+     "['e', 'u', 'a', 'i', 'o']\n"
+     "site at joe, home at ann\n"
+     "a2b4c6\n"
+     "('f00 b0o', 3)\n"
+     "<hi> <there>\n"
+     "['a', 'b', 'c'] ['1', '-', '2', '-', '3'] ['a', 'b,c']\n"
+     "hello ['a', 'c']\n"
+     "True True\n"
+     "1\\.5\\*x\\+y True re.IGNORECASE|re.MULTILINE\n"
+     "re.compile('x', re.IGNORECASE|re.MULTILINE)\n"
+     "ab\n"
+     "bob is name [z7]\n"
+     "error\n"
+     "no such group\n"
+     "5 (102, 104)\n"
+     "1000\n"),
+    # кодеки utf-8, ascii и latin-1: быстрый путь ASCII, обработчики ошибок и сообщения CPython
+    ("s = \"naïve café € 😀\"\n"
+     "b = s.encode()\n"
+     "print(len(b), b.decode() == s, s.encode(\"utf-8\") == b, bytearray(b).decode(\"UTF8\") == s)\n"
+     "print(\"plain ascii\".encode(\"ascii\"), b\"plain\".decode(\"ascii\"), \"abc\".encode(\"US-ASCII\"))\n"
+     "print(\"café\".encode(\"latin-1\"), b\"caf\\xe9\".decode(\"latin1\"), b\"\\xff\\x80\".decode(\"iso-8859-1\") == \"ÿ\\x80\")\n"
+     "print(\"x€y\".encode(\"latin-1\", \"replace\"), \"x€y😀z\".encode(\"ascii\", \"ignore\"), \"é😀\".encode(\"ascii\", \"replace\"))\n"
+     "print(b\"a\\xffb\\xe2\\x82c\".decode(\"utf-8\", \"replace\"), b\"a\\xffb\\xe2\\x82c\".decode(\"utf-8\", \"ignore\"))\n"
+     "print(b\"\\xc3\\xa9\\xff\".decode(\"ascii\", \"replace\"), b\"\\xf0\\x9f\\x98\\x80\".decode() == \"😀\")\n"
+     "for data in [b\"ab\\xff\", b\"\\xe2\\x82x\", b\"ok\\xe2\\x82\", b\"\\xc0\\xaf\", b\"\\xed\\xa0\\x80\"]:\n"
+     "    try:\n"
+     "        data.decode()\n"
+     "    except UnicodeDecodeError as e:\n"
+     "        print(e)\n"
+     "try:\n"
+     "    b\"hi\\xc3\\xa9\".decode(\"ascii\")\n"
+     "except UnicodeDecodeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    \"ab€\".encode(\"latin-1\")\n"
+     "except UnicodeEncodeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    \"aéé\".encode(\"ascii\")\n"
+     "except UnicodeEncodeError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    \"x\".encode(\"klingon\")\n"
+     "except LookupError as e:\n"
+     "    print(e)\n"
+     "long = \"word \" * 1000\n"
+     "print(long.encode() == long.encode(\"ascii\"), len((long + \"é\").encode()), (long + \"é\").encode().decode()[-3:])\n"
+     "print(1000)\n",
+     "21 True True True\n"
+     "b'plain ascii' plain b'abc'\n"
+     "b'caf\\xe9' café True\n"
+     "b'x?y' b'xyz' b'??'\n"
+     "a�b�c abc\n"
+     "��� True\n"
+     "'utf-8' codec can't decode byte 0xff in position 2: invalid start byte\n"
+     "'utf-8' codec can't decode bytes in position 0-1: invalid continuation byte\n"
+     "'utf-8' codec can't decode bytes in position 2-3: unexpected end of data\n"
+     "'utf-8' codec can't decode byte 0xc0 in position 0: invalid start byte\n"
+     "'utf-8' codec can't decode byte 0xed in position 0: invalid continuation byte\n"
+     "'ascii' codec can't decode byte 0xc3 in position 2: ordinal not in range(128)\n"
+     "'latin-1' codec can't encode character '\\u20ac' in position 2: ordinal not in range(256)\n"
+     "'ascii' codec can't encode characters in position 1-2: ordinal not in range(128)\n"
+     "unknown encoding: klingon\n"
+     "True 5002 d é\n"
+     "1000\n"),
+    # io.StringIO и io.BytesIO: запись, seek, truncate, getvalue и getbuffer
+    ("import io\n"
+     "\n"
+     "out = io.StringIO()\n"
+     "for i in range(5):\n"
+     "    out.write(\"line \" + str(i) + \"\\n\")\n"
+     "print(out.write(\"tail\"), out.tell())\n"
+     "text = out.getvalue()\n"
+     "print(len(text), text.count(\"\\n\"), text[-4:])\n"
+     "out.seek(0)\n"
+     "print(repr(out.readline()), repr(out.read(4)), out.tell())\n"
+     "print([line for line in out])\n"
+     "out.seek(5)\n"
+     "out.write(\"X\")\n"
+     "out.truncate(12)\n"
+     "print(repr(out.getvalue()), out.tell())\n"
+     "out.seek(20)\n"
+     "out.write(\"!\")\n"
+     "print(len(out.getvalue()), out.getvalue()[-1], out.getvalue().count(\"\\x00\"))\n"
+     "s = io.StringIO(\"a\\nb\\nc\")\n"
+     "print(s.readlines(), s.read(), s.readable(), s.seekable())\n"
+     "s.close()\n"
+     "print(s.closed)\n"
+     "try:\n"
+     "    s.write(\"x\")\n"
+     "except ValueError as e:\n"
+     "    print(e)\n"
+     "try:\n"
+     "    io.StringIO().write(b\"x\")\n"
+     "except TypeError as e:\n"
+     "    print(e)\n"
+     "\n"
+     "b = io.BytesIO(b\"hello\")\n"
+     "b.seek(0, 2)\n"
+     "b.write(b\" world\")\n"
+     "b.writelines([b\"!\", bytearray(b\"?\")])\n"
+     "print(b.getvalue(), b.tell())\n"
+     "b.seek(-5, 2)\n"
+     "print(b.read(), b.read(), b.seek(0), b.readline(), b.read(3))\n"
+     "view = b.getbuffer()\n"
+     "print(len(view), view[0], view[:5].tobytes())\n"
+     "view[0] = 72\n"
+     "try:\n"
+     "    b.write(b\"more\")\n"
+     "except BufferError as e:\n"
+     "    print(\"BufferError\")\n"
+     "view.release()\n"
+     "b.write(b\"!\")\n"
+     "print(b.getvalue())\n"
+     "buf = bytearray(4)\n"
+     "b.seek(0)\n"
+     "print(b.readinto(buf), buf)\n"
+     "z = io.BytesIO()\n"
+     "z.seek(3)\n"
+     "z.write(b\"x\")\n"
+     "print(z.getvalue(), io.BytesIO(bytearray(b\"ab\")).read())\n"
+     "parts = io.StringIO()\n"
+     "for i in range(2000):\n"
+     "    parts.write(str(i % 10))\n"
+     "print(len(parts.getvalue()), parts.getvalue()[:12])\n"
+     "print(1000)\n",
+     "4 39\n"
+     "39 5 tail\n"
+     "'line 0\\n' 'line' 11\n"
+     "[' 1\\n', 'line 2\\n', 'line 3\\n', 'line 4\\n', 'tail']\n"
+     "'line X\\nline ' 6\n"
+     "21 ! 8\n"
+     "['a\\n', 'b\\n', 'c']  True True\n"
+     "True\n"
+     "I/O operation on closed file\n"
+     "string argument expected, got 'bytes'\n"
+     "b'hello world!?' 13\n"
+     "b'rld!?' b'' 0 b'hello world!?' b''\n"
+     "13 104 b'hello'\n"
+     "BufferError\n"
+     "b'Hello world!?!'\n"
+     "4 bytearray(b'Hell')\n"
+     "b'\\x00\\x00\\x00x' b'ab'\n"
+     "2000 012345678901\n"
+     "1000\n"),
+    # Копии списка делят буфер до первой записи и не видят изменений друг друга
+    ("a = [3, 1, 2]\n"
+     "b = a.copy()\n"
+     "c = a[:]\n"
+     "d = list(a)\n"
+     "b.append(4)\n"
+     "c[0] = 9\n"
+     "d.sort()\n"
+     "print(a, b, c, d)\n"
+     "e = a[:]\n"
+     "e.clear()\n"
+     "print(a, e)\n"
+     "f = a.copy()\n"
+     "del f[0]\n"
+     "f.insert(0, 7)\n"
+     "f.reverse()\n"
+     "print(a, f)\n"
+     "g = a[:]\n"
+     "g += [5]\n"
+     "g *= 2\n"
+     "print(a, g)\n"
+     "h = a[:]\n"
+     "h[1:2] = [8, 8]\n"
+     "print(a, h)\n"
+     "k = a[:]\n"
+     "a.pop()\n"
+     "print(a, k, a == k[:2])\n"
+     "n = [[1], [2]]\n"
+     "m = n[:]\n"
+     "m[0].append(0)\n"
+     "print(n, m)\n"
+     "print(1000)\n",
+     "[3, 1, 2] [3, 1, 2, 4] [9, 1, 2] [1, 2, 3]\n"
+     "[3, 1, 2] []\n"
+     "[3, 1, 2] [2, 1, 7]\n"
+     "[3, 1, 2] [3, 1, 2, 5, 3, 1, 2, 5]\n"
+     "[3, 1, 2] [3, 8, 8, 2]\n"
+     "[3, 1] [3, 1, 2] True\n"
+     "[[1, 0], [2]] [[1, 0], [2]]\n"
+     "1000\n"),
+    # Хеш кортежа по схеме xxHash совпадает с CPython; хеш длинных строк и байтов стабилен
+    ("print(hash((1, 2)), hash((2, 1)), hash(()))\n"
+     "print(hash((1, (2, 3))), hash((-1,)), hash((True, 2.0)) == hash((1, 2)))\n"
+     "url = \"https://example.com/\" + \"path/\" * 40\n"
+     "key = \"https://example.com/\" + \"path/\" * 40\n"
+     "print(hash(url) == hash(key), hash(url) != hash(url + \"x\"))\n"
+     "print(hash(b\"abc\" * 30) == hash(b\"abcabc\" * 15), hash(b\"\") == hash(b\"\"))\n"
+     "print(hash(\"\") != -1, hash(\"a\") != hash(\"b\"), hash(\"ab\") != hash(\"ba\"))\n"
+     "d = {url: 1, key + \"/\": 2}\n"
+     "print(d[key], len({(1, 2), (2, 1), (1, 2)}))\n"
+     "print(1000)\n",
+     "-3550055125485641917 6794810172467074373 5740354900026072187\n"
+     "7267574591690527098 8078679518589016365 True\n"
+     "True True\n"
+     "True True\n"
+     "True True True\n"
+     "1 2\n"
+     "1000\n"),
+    # Однородные списки int, float и str: sum, min/max, in, index, count и == прямыми циклами
+    ("ints = list(range(10))\n"
+     "print(sum(ints), min(ints), max(ints), 7 in ints, 7.0 in ints, True in ints, ints.index(3), ints.count(2))\n"
+     "big = [2**62, 2**62, 2**62]\n"
+     "print(sum(big), sum(big, 0.5), sum([1.5, 2.5], 1))\n"
+     "fl = [0.5, -1.25, 3.0, -1.25]\n"
+     "print(sum(fl), min(fl), max(fl), fl.count(-1.25), fl.index(3.0), 3 in fl)\n"
+     "words = [\"b\", \"a\", \"c\"]\n"
+     "print(\"a\" in words, words.index(\"c\"), sorted(words))\n"
+     "ints.append(2.5)\n"
+     "print(max(ints), ints.count(2), sum(ints))\n"
+     "ints.append(\"x\")\n"
+     "print(\"x\" in ints, ints.index(\"x\"))\n"
+     "print([1, 2] == [1, 2], [1, 2] == [1.0, 2.0], [0.0] == [-0.0], [1, 2] == [1, 3])\n"
+     "m = [3, 1, 2]\n"
+     "m.sort()\n"
+     "m.append(0)\n"
+     "print(m, max(m), min([5, 5, 4, 4]), max([True, 2]))\n"
+     "nan = float(\"nan\")\n"
+     "print(min([nan, 1.0]), max([1.0, nan]))\n"
+     "print(1000)\n",
+     "45 0 9 True True True 3 1\n"
+     "13835058055282163712 1.3835058055282164e+19 5.0\n"
+     "1.0 -1.25 3.0 2 2 True\n"
+     "True 2 ['a', 'b', 'c']\n"
+     "9 1 47.5\n"
+     "True 11\n"
+     "True True True False\n"
+     "[1, 2, 3, 0] 3 4 2\n"
+     "nan 1.0\n"
+     "1000\n"),
+    # приоритеты и ассоциативность операторов: унарный минус и **, цепочки сравнений, not/and/or, битовые операции
+    ("a = 6\n"
+     "b = 3\n"
+     "c = 5\n"
+     "print(-2 ** 2, 2 ** -1, 2 ** 3 ** 2, -a * -b)\n"
+     "print(a - b - c, a // b * c, a % 4 * 2, 100 / 10 / 5)\n"
+     "print(a + b < c + a, a < b < c, b < c < a, 1 < 2 == 2 > 1)\n"
+     "print(not a == b, not not a, not a and b, a and not b)\n"
+     "print(a | b & c, a ^ b | c, a & b ^ c, a == b | c, 4 in [1, 4] == False)\n"
+     "print(a or b and 0, 0 or b and c)\n"
+     "print(1 not in [2, 3], a is not None, [1] + [2] * 2, -a ** 2 + b)\n"
+     "x = 1\n"
+     "x += a * b - c\n"
+     "print(x, 3 - -3, +-+a)\n"
+     "print(1000)\n",
+     "-4 0.5 512 18\n"
+     "-2 10 4 2.0\n"
+     "True False True True\n"
+     "True True False False\n"
+     "7 5 7 False False\n"
+     "6 5\n"
+     "True True [1, 2, 2] -33\n"
+     "14 6 -6\n"
+     "1000\n"),
+    # bytes(), bytearray() и extend из списков, кортежей и буферов; проверка диапазона
+    ("import array\n"
+     "data = [0, 1, 127, 128, 255] * 3\n"
+     "print(bytes(data), bytes(tuple(data)) == bytes(data))\n"
+     "print(bytearray([65, True, 66]))\n"
+     "buf = bytearray(b\"ab\")\n"
+     "buf.extend([99, 100])\n"
+     "buf.extend((101,))\n"
+     "buf.extend(b\"fg\")\n"
+     "buf.extend(bytearray(b\"h\"))\n"
+     "buf.extend(memoryview(b\"xyz\")[1:])\n"
+     "buf.extend(range(48, 51))\n"
+     "print(buf)\n"
+     "print(bytes(array.array(\"B\", [1, 2, 3])), len(bytes(array.array(\"i\", [1, 2]))))\n"
+     "print(bytes(memoryview(b\"hello\")[1:4]))\n"
+     "buf.extend(buf)\n"
+     "print(len(buf))\n"
+     "for bad in ([1, 256], [1, -1], (300, \"x\"), [1, 2, 999999999999]):\n"
+     "    try:\n"
+     "        bytes(bad)\n"
+     "    except ValueError as error:\n"
+     "        print(\"ValueError\", error)\n"
+     "try:\n"
+     "    buf.extend([1, 2, 300])\n"
+     "except ValueError as error:\n"
+     "    print(error, len(buf))\n"
+     "print(1000)\n",
+     "b'\\x00\\x01\\x7f\\x80\\xff\\x00\\x01\\x7f\\x80\\xff\\x00\\x01\\x7f\\x80\\xff' True\n"
+     "bytearray(b'A\\x01B')\n"
+     "bytearray(b'abcdefghyz012')\n"
+     "b'\\x01\\x02\\x03' 8\n"
+     "b'ell'\n"
+     "26\n"
+     "ValueError bytes must be in range(0, 256)\n"
+     "ValueError bytes must be in range(0, 256)\n"
+     "ValueError bytes must be in range(0, 256)\n"
+     "ValueError bytes must be in range(0, 256)\n"
+     "byte must be in range(0, 256) 26\n"
+     "1000\n"),
+    # цепочки + со строками склеиваются ConcatNode: порядок вычисления, __add__/__radd__ и TypeError как без свёртки
+    ("class Tag:\n"
+     "    def __init__(self, name):\n"
+     "        self.name = name\n"
+     "    def __add__(self, other):\n"
+     "        print(\"add\", self.name)\n"
+     "        return \"<\" + self.name + \">\" + other\n"
+     "    def __radd__(self, other):\n"
+     "        print(\"radd\", self.name)\n"
+     "        return other + \"[\" + self.name + \"]\"\n"
+     "\n"
+     "def piece(text):\n"
+     "    print(\"eval\", text)\n"
+     "    return text\n"
+     "\n"
+     "a = \"alpha\"\n"
+     "b = \"beta\"\n"
+     "n = 3\n"
+     "line = a + \":\" + b + \"\\n\"\n"
+     "print(line, end=\"\")\n"
+     "print(a + \",\" + str(n) + \",\" + b)\n"
+     "print(piece(\"x\") + \"-\" + piece(\"y\") + \"-\" + piece(\"z\"))\n"
+     "print(\"pre \" + Tag(\"t\") + \" post\")\n"
+     "print(Tag(\"u\") + \"-\" + piece(\"w\"))\n"
+     "print(f\"{n}\" + \"=\" + a)\n"
+     "print(\"a\" + \"b\" + \"c\")\n"
+     "print(a + (\"(\" + b + \")\"))\n"
+     "print(1 + 2 + n)\n"
+     "try:\n"
+     "    print(a + \":\" + n + piece(\"never\"))\n"
+     "except TypeError:\n"
+     "    print(\"TypeError\")\n"
+     "try:\n"
+     "    print(n + \"x\" + piece(\"later\"))\n"
+     "except TypeError:\n"
+     "    print(\"TypeError 2\")\n"
+     "rows = []\n"
+     "for i in range(3):\n"
+     "    rows.append(str(i) + \";\" + str(i * i) + \";\" + a + \"\\n\")\n"
+     "print(\"\".join(rows), end=\"\")\n"
+     "def csv(x, y):\n"
+     "    return x + \",\" + y\n"
+     "print(csv(\"p\", \"q\"), csv(\"r\", \"s\"))\n"
+     "print(1000)\n",
+     "alpha:beta\n"
+     "alpha,3,beta\n"
+     "eval x\n"
+     "eval y\n"
+     "eval z\n"
+     "x-y-z\n"
+     "radd t\n"
+     "pre [t] post\n"
+     "add u\n"
+     "eval w\n"
+     "<u>-w\n"
+     "3=alpha\n"
+     "abc\n"
+     "alpha(beta)\n"
+     "6\n"
+     "TypeError\n"
+     "TypeError 2\n"
+     "0;0;alpha\n"
+     "1;1;alpha\n"
+     "2;4;alpha\n"
+     "p,q r,s\n"
+     "1000\n"),
+    # repr контейнеров по частям: самоссылки [...], {...}, (...), глубокая вложенность и большой список
+    ("items = [1, 2]\n"
+     "items.append(items)\n"
+     "print(items)\n"
+     "table = {\"a\": 1}\n"
+     "table[\"self\"] = table\n"
+     "print(table, repr(table))\n"
+     "holder = ([],)\n"
+     "holder[0].append(holder)\n"
+     "print(holder)\n"
+     "outer = [items, items]\n"
+     "print(outer)\n"
+     "print([(1,), (), {1: [2.5, \"x\"]}, set(), {3}, None, True, -7])\n"
+     "nested = []\n"
+     "for i in range(50):\n"
+     "    nested = [nested, i]\n"
+     "text = str(nested)\n"
+     "print(len(text), text[:20], text[-10:])\n"
+     "big = list(range(100000))\n"
+     "line = repr(big)\n"
+     "print(len(line), line[-12:])\n"
+     'print(str(["a\\n", \'b"\', "c\'"]))\n'
+     "print(1000)\n",
+     "[1, 2, [...]]\n"
+     "{'a': 1, 'self': {...}} {'a': 1, 'self': {...}}\n"
+     "([(...)],)\n"
+     "[[1, 2, [...]], [1, 2, [...]]]\n"
+     "[(1,), (), {1: [2.5, 'x']}, set(), {3}, None, True, -7]\n"
+     "292 [[[[[[[[[[[[[[[[[[[[ , 48], 49]\n"
+     "688890 9998, 99999]\n"
+     '[\'a\\n\', \'b"\', "c\'"]\n'
+     "1000\n"),
+    # dict(), update, | и ** с резервом и копированием записей
+    ("base = {\"a\": 1, \"b\": 2}\n"
+     "print(dict(base), dict([(\"x\", 1), (\"y\", 2)]), dict(base, b=5, c=6))\n"
+     "print(dict.fromkeys({3}, 0), dict.fromkeys(base), dict.fromkeys([1, 2, 1], \"v\"))\n"
+     "d1 = {\"a\": 1, \"b\": 2}\n"
+     "d2 = {\"b\": 20, \"c\": 30}\n"
+     "print(d1 | d2, d2 | d1)\n"
+     "d1 |= d2\n"
+     "print(d1)\n"
+     "print({**base, **d2, \"x\": 1})\n"
+     "e = {}\n"
+     "e.update(base)\n"
+     "e.update([(\"z\", 0)], q=9)\n"
+     "e.update(k=1)\n"
+     "print(e, list(e))\n"
+     "big = {}\n"
+     "for i in range(1000):\n"
+     "    big[i] = i * 2\n"
+     "m = {}\n"
+     "m.update(big)\n"
+     "m[5000] = 1\n"
+     "print(len(m), m[999], m[5000], list(m)[:3])\n"
+     "del m[0]\n"
+     "n = {}\n"
+     "n.update(m)\n"
+     "print(len(n), 0 in n, n[1])\n"
+     "c = {i: i for i in range(50)}\n"
+     "print(len(c), c[49])\n"
+     "print(dict(), dict({}), {} | {})\n"
+     "print(1000)\n",
+     "{'a': 1, 'b': 2} {'x': 1, 'y': 2} {'a': 1, 'b': 5, 'c': 6}\n"
+     "{3: 0} {'a': None, 'b': None} {1: 'v', 2: 'v'}\n"
+     "{'a': 1, 'b': 20, 'c': 30} {'b': 2, 'c': 30, 'a': 1}\n"
+     "{'a': 1, 'b': 20, 'c': 30}\n"
+     "{'a': 1, 'b': 20, 'c': 30, 'x': 1}\n"
+     "{'a': 1, 'b': 2, 'z': 0, 'q': 9, 'k': 1} ['a', 'b', 'z', 'q', 'k']\n"
+     "1001 1998 1 [0, 1, 2]\n"
+     "1000 False 2\n"
+     "50 49\n"
+     "{} {} {}\n"
+     "1000\n"),
+    # time и timeit: часы, число вызовов stmt и setup
+    ("import time\n"
+     "import timeit\n"
+     "from timeit import repeat\n"
+     "\n"
+     "calls = []\n"
+     "def work():\n"
+     "    calls.append(1)\n"
+     "\n"
+     "def prepare():\n"
+     "    calls.append(0)\n"
+     "\n"
+     "t = timeit.timeit(work, number=5)\n"
+     "print(t >= 0, len(calls))\n"
+     "calls.clear()\n"
+     "times = repeat(work, setup=prepare, repeat=3, number=2)\n"
+     "print(len(times), calls.count(0), calls.count(1))\n"
+     "print(len(timeit.repeat(\"x = 1\\ny = x + 1\", repeat=2, number=100)))\n"
+     "print(timeit.timeit(\"pass\", number=0) >= 0)\n"
+     "a = time.perf_counter_ns()\n"
+     "b = time.perf_counter_ns()\n"
+     "print(b >= a, time.monotonic_ns() > 0, time.process_time() >= 0, time.time() > 1000000000)\n"
+     "start = time.monotonic()\n"
+     "time.sleep(0.01)\n"
+     "print(time.monotonic() - start >= 0.01)\n"
+     "try:\n"
+     "    timeit.timeit(5)\n"
+     "except ValueError as e:\n"
+     "    print(\"ValueError\", e)\n"
+     "print(1000)\n",
+     "True 5\n"
+     "3 3 6\n"
+     "2\n"
+     "True\n"
+     "True True True True\n"
+     "True\n"
+     "ValueError stmt is neither a string nor callable\n"
+     "1000\n"),
+    # frozenset(s), set(fs) и copy() делят таблицу до изменения; хеш frozenset
+    ("s = {3, 1, 2}\n"
+     "fs = frozenset(s)\n"
+     "s.add(4)\n"
+     "s.discard(1)\n"
+     "print(sorted(fs), sorted(s), len(fs), len(s))\n"
+     "print(frozenset(fs) is fs)\n"
+     "t = set(fs)\n"
+     "t.add(9)\n"
+     "print(sorted(t), sorted(fs))\n"
+     "big = set(range(100))\n"
+     "frozen = frozenset(big)\n"
+     "for i in range(50):\n"
+     "    big.remove(i)\n"
+     "big.add(1000)\n"
+     "print(len(frozen), len(big), 0 in frozen, 0 in big, 1000 in frozen)\n"
+     "c = big.copy()\n"
+     "c.clear()\n"
+     "print(len(big), len(c))\n"
+     "graph = {}\n"
+     "graph[frozenset({1, 2})] = \"a\"\n"
+     "graph[frozenset([2, 1])] = \"b\"\n"
+     "graph[frozenset(set([3]))] = \"c\"\n"
+     "print(graph[frozenset({2, 1})], len(graph), hash(frozenset({1, 2})) == hash(frozenset(set([2, 1]))))\n"
+     "print(hash(frozenset({1, 2})) != hash(frozenset({3})))\n"
+     "edges = set()\n"
+     "for a in range(20):\n"
+     "    for b in range(a + 1, 20):\n"
+     "        edges.add(frozenset((a, b)))\n"
+     "print(len(edges), frozenset((5, 3)) in edges)\n"
+     "u = frozenset({1}) | {2}\n"
+     "print(sorted(u), sorted(fs))\n"
+     "p = set(fs)\n"
+     "p.pop()\n"
+     "print(len(p), len(fs))\n"
+     "print(1000)\n",
+     "[1, 2, 3] [2, 3, 4] 3 3\n"
+     "True\n"
+     "[1, 2, 3, 9] [1, 2, 3]\n"
+     "100 51 True False False\n"
+     "51 0\n"
+     "b 2 True\n"
+     "True\n"
+     "190 True\n"
+     "[1, 2] [1, 2, 3]\n"
+     "2 3\n"
+     "1000\n"),
+    # range с границами за пределами int64: длинная прогрессия вместо OverflowError
+    ("r = range(2**70, 2**70 + 3)\n"
+     "print(len(r), list(r))\n"
+     "print(r[1], r[-1], r.start, r.stop, r.step)\n"
+     "print(2**70 + 1 in r, 5 in r, r.index(2**70 + 2))\n"
+     "print(r, list(reversed(r)))\n"
+     "print(r[1:], r == range(2**70, 2**70 + 3), hash(r) == hash(range(2**70, 2**70 + 3)))\n"
+     "print(bool(range(2**80)), range(2**70, 0, -2**69), list(range(2**70, 0, -2**69)))\n"
+     "print(range(2**70, 2**70) == range(0), sum(range(2**64, 2**64 + 4)))\n"
+     "total = 0\n"
+     "for i in range(-2**66, -2**66 + 5):\n"
+     "    total += i\n"
+     "print(total)\n"
+     "try:\n"
+     "    len(range(2**70))\n"
+     "except OverflowError as e:\n"
+     "    print(\"OverflowError\", e)\n"
+     "print(1000)\n",
+     "3 [1180591620717411303424, 1180591620717411303425, 1180591620717411303426]\n"
+     "1180591620717411303425 1180591620717411303426 1180591620717411303424 1180591620717411303427 1\n"
+     "True False 2\n"
+     "range(1180591620717411303424, 1180591620717411303427) [1180591620717411303426, 1180591620717411303425, 1180591620717411303424]\n"
+     "range(1180591620717411303425, 1180591620717411303427) True True\n"
+     "True range(1180591620717411303424, 0, -590295810358705651712) [1180591620717411303424, 590295810358705651712]\n"
+     "True 73786976294838206470\n"
+     "-368934881474191032310\n"
+     "OverflowError Python int too large to convert to C ssize_t\n"
+     "1000\n"),
+    # gc: циклы список↔себя и словарь↔список собираются, достижимые объекты целы, enable/disable
+    ("import gc\n"
+     "gc.collect()\n"
+     "a = []\n"
+     "a.append(a)\n"
+     "del a\n"
+     "print(gc.collect())\n"
+     "d = {}\n"
+     "l = [d]\n"
+     "d[\"l\"] = l\n"
+     "del d, l\n"
+     "print(gc.collect())\n"
+     "keep = [1, 2]\n"
+     "keep.append(keep)\n"
+     "alias = {\"k\": keep}\n"
+     "print(gc.collect(), len(keep), keep[2] is keep, alias[\"k\"] is keep)\n"
+     "print(gc.isenabled())\n"
+     "gc.disable()\n"
+     "print(gc.isenabled())\n"
+     "gc.enable()\n"
+     "print(gc.isenabled())\n"
+     "print(1000)\n",
+     "1\n"
+     "2\n"
+     "0 3 True True\n"
+     "True\n"
+     "False\n"
+     "True\n"
+     "1000\n"),
+    # Тела вложенных функций и лямбд переживают разбор модуля: узлы AST остаются в арене
+    ("def make_adder(i):\n"
+     "    def add(x):\n"
+     "        return x + i\n"
+     "    return add\n"
+     "\n"
+     "\n"
+     "def outer(n):\n"
+     "    def middle(m):\n"
+     "        def inner(k):\n"
+     "            return n * 100 + m * 10 + k\n"
+     "        return inner\n"
+     "    return middle\n"
+     "\n"
+     "\n"
+     "fs = []\n"
+     "for i in range(5):\n"
+     "    fs.append(make_adder(i))\n"
+     "print([f(10) for f in fs])\n"
+     "g = outer(1)(2)\n"
+     "print(g(3), outer(4)(5)(6))\n"
+     "sq = lambda v: v * v\n"
+     "print([sq(h) for h in range(4)])\n"
+     "print(1000)\n",
+     "[10, 11, 12, 13, 14]\n"
+     "123 456\n"
+     "[0, 1, 4, 9]\n"
+     "1000\n"),
+    # Операторы разбираются один раз при построении узлов: арифметика, сравнения и составное присваивание
+    ("a, b = 17, 5\n"
+     "print(a + b, a - b, a * b, a / b, a // b, a % b, a ** 2)\n"
+     "print(a & b, a | b, a ^ b, -a, +a, not a, not 0)\n"
+     "print(-a // b, -a % b, 2.5 * 4, 7.5 // 2, \"ab\" * 3, [1] + [2, 3])\n"
+     "print(1 < a < 20, 1 < a > 20, a == 17 != b, b <= 5 >= 4, a is a, 3 in [1, 3])\n"
+     "print(\"b\" not in \"abc\", (1, 2) < (1, 3), \"x\" < \"y\" <= \"y\", None is not a)\n"
+     "x = 10\n"
+     "x += 5\n"
+     "x -= 3\n"
+     "x *= 4\n"
+     "x //= 5\n"
+     "x %= 7\n"
+     "x **= 3\n"
+     "x |= 64\n"
+     "x &= 0xf0\n"
+     "x ^= 3\n"
+     "x /= 2\n"
+     "print(x)\n"
+     "s = \"a\"\n"
+     "s += \"b\"\n"
+     "s *= 2\n"
+     "l = [1]\n"
+     "l += [2]\n"
+     "l *= 2\n"
+     "print(s, l)\n"
+     "print(1000)\n",
+     "22 12 85 3.4 3 2 289\n"
+     "1 21 20 -17 17 False True\n"
+     "-4 3 10.0 3.0 ababab [1, 2, 3]\n"
+     "True False True True True True\n"
+     "False True True True\n"
+     "33.5\n"
+     "abab [1, 2, 1, 2]\n"
+     "1000\n"),
+    # Длинные целые за общим указателем: копии делят число, изменение одной не трогает другую
+    ("a = 2 ** 100\n"
+     "b = a\n"
+     "a += 1\n"
+     "print(a, b, a - b)\n"
+     "big = []\n"
+     "for i in range(40):\n"
+     "    big.append(3 ** (60 + i))\n"
+     "copy = big[:]\n"
+     "big[0] = -big[0]\n"
+     "print(copy[0] == -big[0], big[1] == copy[1], big[-1] % 1000003)\n"
+     "print(sum(copy) % 1000000007, max(copy) == 3 ** 99)\n"
+     "d = {2 ** 80: \"a\", 2 ** 80 + 1: \"b\"}\n"
+     "print(d[2 ** 80 + 1], (2 ** 64) // (2 ** 63), -(2 ** 70) // 3)\n"
+     "print(1000)\n",
+     "1267650600228229401496703205377 1267650600228229401496703205376 1\n"
+     "True True 729919\n"
+     "969146086 True\n"
+     "b 2 -393530540239137101142\n"
+     "1000\n"),
+    # Объекты из пулов: кортежи, списки, строки и связанные методы создаются и освобождаются в цикле
+    ("class Point:\n"
+     "    def __init__(self, x, y):\n"
+     "        self.x = x\n"
+     "        self.y = y\n"
+     "\n"
+     "    def norm(self):\n"
+     "        return self.x * self.x + self.y * self.y\n"
+     "\n"
+     "\n"
+     "kept = []\n"
+     "total = 0\n"
+     "for i in range(3000):\n"
+     "    t = (i, i + 1, str(i))\n"
+     "    l = [i, t, \"s\" + str(i)]\n"
+     "    m = Point(i, 1).norm\n"
+     "    total += m() + len(l[2]) + t[1]\n"
+     "    if i % 500 == 0:\n"
+     "        kept.append((t, l, m))\n"
+     "print(total)\n"
+     "print(kept[2][0], kept[2][1], kept[2][2]())\n"
+     "print([k[1][2] for k in kept], len(kept))\n"
+     "print(1000)\n",
+     "9000018890\n"
+     "(1000, 1001, '1000') [1000, (1000, 1001, '1000'), 's1000'] 1000001\n"
+     "['s0', 's500', 's1000', 's1500', 's2000', 's2500'] 6\n"
+     "1000\n"),
+    # Стеки значений и векторы аргументов переиспользуются: вложенные вызовы, рекурсия и раскрутка исключения
+    ("def add3(a, b, c):\n"
+     "    return a + b + c\n"
+     "\n"
+     "\n"
+     "def depth(n):\n"
+     "    if n == 0:\n"
+     "        return 0\n"
+     "    return 1 + depth(n - 1)\n"
+     "\n"
+     "\n"
+     "def loops(n):\n"
+     "    acc = 0\n"
+     "    for i in range(n):\n"
+     "        for j in range(i):\n"
+     "            if j > 3:\n"
+     "                break\n"
+     "            acc += add3(i, j, depth(j))\n"
+     "    return acc\n"
+     "\n"
+     "\n"
+     "def fails(n):\n"
+     "    if n == 0:\n"
+     "        raise ValueError(\"bottom\")\n"
+     "    return add3(n, fails(n - 1), n)\n"
+     "\n"
+     "\n"
+     "print(add3(add3(1, 2, 3), add3(4, add3(5, 6, 7), 8), depth(200)))\n"
+     "print(loops(30))\n"
+     "for k in range(3):\n"
+     "    try:\n"
+     "        fails(50)\n"
+     "    except ValueError as e:\n"
+     "        print(e, depth(k * 100), add3(k, k, k))\n"
+     "print(sum([add3(i, i, i) for i in range(1000)]))\n"
+     "print(1000)\n",
+     "236\n"
+     "2050\n"
+     "bottom 0 0\n"
+     "bottom 100 3\n"
+     "bottom 200 6\n"
+     "1498500\n"
+     "1000\n"),
+    # Привязка именованных аргументов по плану: любой порядок, смесь с позиционными, методы и лямбды
+    ("def f(a, b, c):\n"
+     "    return a * 100 + b * 10 + c\n"
+     "\n"
+     "\n"
+     "class Box:\n"
+     "    def __init__(self, width, height):\n"
+     "        self.area = width * height\n"
+     "\n"
+     "    def scale(self, kx, ky):\n"
+     "        return Box(height=self.area * ky, width=kx)\n"
+     "\n"
+     "\n"
+     "print(f(1, 2, 3), f(c=3, b=2, a=1), f(1, c=3, b=2), f(1, 2, c=3))\n"
+     "for i in range(3):\n"
+     "    print(f(b=i, c=i + 1, a=i + 2))\n"
+     "g = lambda x, y: x - y\n"
+     "print(g(y=1, x=10), Box(height=2, width=3).area, Box(4, 5).scale(ky=2, kx=3).area)\n"
+     "print(1000)\n",
+     "123 123 123 123\n"
+     "201\n"
+     "312\n"
+     "423\n"
+     "9 6 120\n"
+     "1000\n"),
+    # Операции из микробенчмарков: строки, словари и множества, сортировка и срезы списка, поиск в bytes и struct
+    ("import struct\n"
+     "\n"
+     "words = \" \".join([\"w\" + str(i % 37) for i in range(200)])\n"
+     "parts = words.split()\n"
+     "csv = words.replace(\" \", \",\")\n"
+     "print(len(parts), len(csv.split(\",\")), \"-\".join(parts[:4]), csv.find(\"w36\"), words.upper()[:7])\n"
+     "print(\"{} + {} = {:.3f} [{name}]\".format(2, 40, 42.0, name=\"answer\"))\n"
+     "\n"
+     "d = {}\n"
+     "s = set()\n"
+     "for i in range(1000):\n"
+     "    d[i * 7] = i\n"
+     "    s.add(i * 3)\n"
+     "hits = 0\n"
+     "for i in range(0, 7000, 5):\n"
+     "    if i in d and i in s:\n"
+     "        hits += 1\n"
+     "for i in range(0, 7000, 14):\n"
+     "    del d[i]\n"
+     "    s.discard(i)\n"
+     "print(hits, len(d), len(s), hash(12345) == hash(12345.0))\n"
+     "\n"
+     "l = []\n"
+     "for i in range(500):\n"
+     "    l.append((i * 7919) % 1009)\n"
+     "l.sort()\n"
+     "print(l[:5], l[100:105], l[::100], 3 * 4 + 1.5 < 14)\n"
+     "\n"
+     "data = bytes(range(256)) * 8\n"
+     "print(data.find(b\"\\xfe\\xff\\x00\"), data.count(b\"\\x10\"), data.count(b\"ab\"))\n"
+     "packed = struct.pack(\"<IHh\", 1, 2, -3) * 3\n"
+     "print([struct.unpack(\"<IHh\", packed[o:o + 8]) for o in range(0, len(packed), 8)])\n"
+     "print(1000)\n",
+     "200 200 w0-w1-w2-w3 134 W0 W1 W\n"
+     "2 + 40 = 42.000 [answer]\n"
+     "29 500 928 True\n"
+     "[0, 1, 2, 5, 6] [203, 204, 207, 208, 211] [0, 203, 403, 605, 807] True\n"
+     "254 8 8\n"
+     "[(1, 2, -3), (1, 2, -3), (1, 2, -3)]\n"
+     "1000\n"),
+    # Уменьшенные программы из benchmarks/programs: рекурсия, обработка текста и иерархия классов
+    ("WORDS = [\"alpha\", \"Beta\", \"gamma\", \"delta\", \"Epsilon\", \"zeta\", \"eta\", \"pi\"]\n"
+     "\n"
+     "\n"
+     "def fib(n):\n"
+     "    if n < 2:\n"
+     "        return n\n"
+     "    return fib(n - 1) + fib(n - 2)\n"
+     "\n"
+     "\n"
+     "def make_text(lines, width):\n"
+     "    seed = 12345\n"
+     "    result = []\n"
+     "    for _ in range(lines):\n"
+     "        words = []\n"
+     "        for _ in range(width):\n"
+     "            seed = (seed * 1103515245 + 12345) % 2147483648\n"
+     "            words.append(WORDS[(seed // 65536) % len(WORDS)])\n"
+     "        result.append(\" \".join(words) + \".\")\n"
+     "    return \"\\n\".join(result)\n"
+     "\n"
+     "\n"
+     "def word_counts(text):\n"
+     "    counts = {}\n"
+     "    for line in text.splitlines():\n"
+     "        for word in line.strip(\".\").lower().split():\n"
+     "            counts[word] = counts.get(word, 0) + 1\n"
+     "    return counts\n"
+     "\n"
+     "\n"
+     "class Shape:\n"
+     "    count = 0\n"
+     "\n"
+     "    def __init__(self, name):\n"
+     "        self.name = name\n"
+     "        Shape.count += 1\n"
+     "\n"
+     "    def describe(self):\n"
+     "        return \"{}:{:.2f}\".format(self.name, self.area())\n"
+     "\n"
+     "\n"
+     "class Rect(Shape):\n"
+     "    def __init__(self, w, h):\n"
+     "        super().__init__(\"rect\")\n"
+     "        self.w = w\n"
+     "        self.h = h\n"
+     "\n"
+     "    def area(self):\n"
+     "        return self.w * self.h\n"
+     "\n"
+     "    @property\n"
+     "    def perimeter(self):\n"
+     "        return 2 * (self.w + self.h)\n"
+     "\n"
+     "\n"
+     "class Square(Rect):\n"
+     "    def __init__(self, side):\n"
+     "        super().__init__(side, side)\n"
+     "        self.name = \"square\"\n"
+     "\n"
+     "\n"
+     "print(fib(15))\n"
+     "counts = word_counts(make_text(50, 6))\n"
+     "ordered = sorted(counts.items(), key=lambda item: (-item[1], item[0]))\n"
+     "print(\", \".join([\"{}={}\".format(w, c) for w, c in ordered[:4]]))\n"
+     "shapes = []\n"
+     "for i in range(30):\n"
+     "    if i % 2 == 0:\n"
+     "        shapes.append(Rect(i % 7 + 1, i % 5 + 1))\n"
+     "    else:\n"
+     "        shapes.append(Square(i % 4 + 1))\n"
+     "print(sum([s.area() for s in shapes]), sum([s.perimeter for s in shapes]), Shape.count)\n"
+     "print(shapes[0].describe(), shapes[1].describe())\n"
+     "print(1000)\n",
+     "610\n"
+     "epsilon=47, gamma=44, pi=38, alpha=36\n"
+     "303 380 30\n"
+     "rect:1.00 square:4.00\n"
+     "1000\n"),
+    # Встроенные классы из контекста интерпретатора: иерархия исключений, собственные наследники и типы str/bytes/bytearray
+    ("class ConfigError(ValueError):\n"
+     "    pass\n"
+     "\n"
+     "\n"
+     "class MissingKey(ConfigError):\n"
+     "    def __init__(self, key):\n"
+     "        super().__init__(\"missing \" + key)\n"
+     "        self.key = key\n"
+     "\n"
+     "\n"
+     "class Plain:\n"
+     "    pass\n"
+     "\n"
+     "\n"
+     "def load(key):\n"
+     "    if key == \"x\":\n"
+     "        raise MissingKey(key)\n"
+     "    return {\"a\": 1}[key]\n"
+     "\n"
+     "\n"
+     "for key in [\"a\", \"x\", \"b\"]:\n"
+     "    try:\n"
+     "        print(load(key))\n"
+     "    except ConfigError as e:\n"
+     "        print(\"config\", e.key, e, type(e).__name__)\n"
+     "    except LookupError as e:\n"
+     "        print(\"lookup\", type(e).__name__)\n"
+     "\n"
+     "for bad in [lambda: 1 // 0, lambda: [][1], lambda: \"a\" + 1]:\n"
+     "    try:\n"
+     "        bad()\n"
+     "    except ArithmeticError as e:\n"
+     "        print(\"arith\", type(e).__name__)\n"
+     "    except LookupError as e:\n"
+     "        print(\"lookup\", type(e).__name__)\n"
+     "    except Exception as e:\n"
+     "        print(\"other\", type(e).__name__)\n"
+     "\n"
+     "print(issubclass(MissingKey, ValueError), issubclass(KeyError, LookupError), issubclass(ValueError, KeyError))\n"
+     "print(type(\"s\").__name__, type(b\"s\").__name__, type(bytearray(b\"s\")).__name__, type(Plain()).__name__)\n"
+     "print(\"a-b\".split(\"-\"), b\"a-b\".split(b\"-\"), bytearray(b\"ab\").upper())\n"
+     "print(1000)\n",
+     "1\n"
+     "config x missing x MissingKey\n"
+     "lookup KeyError\n"
+     "arith ZeroDivisionError\n"
+     "lookup IndexError\n"
+     "other TypeError\n"
+     "True True False\n"
+     "str bytes bytearray Plain\n"
+     "['a', 'b'] [b'a', b'b'] bytearray(b'AB')\n"
+     "1000\n"),
+    # Глобальные __main__, собранные createGlobals: функции-правила читают переназначенные глобальные переменные
+    ("threshold = 10\n"
+     "rules = []\n"
+     "\n"
+     "\n"
+     "def over(value):\n"
+     "    return value > threshold\n"
+     "\n"
+     "\n"
+     "def scaled(value, factor):\n"
+     "    return value * factor\n"
+     "\n"
+     "\n"
+     "rules.append(over)\n"
+     "rules.append(lambda v: scaled(v, 2) > threshold)\n"
+     "if __name__ == \"__main__\":\n"
+     "    print(__name__, [r(7) for r in rules])\n"
+     "threshold = 13\n"
+     "print([r(7) for r in rules], over(14), scaled(factor=3, value=5))\n"
+     "print(1000)\n",
+     "__main__ [False, True]\n"
+     "[False, True] True 15\n"
+     "1000\n"),
+    # Общая таблица встроенных функций: затенение len и max в скрипте не задевает импортированный модуль
+    ("f = open(\"measure.py\", \"w\")\n"
+     "f.write(\"def size(x):\\n    return len(x)\\n\\ndef biggest(xs):\\n    return max(xs)\\n\")\n"
+     "f.close()\n"
+     "\n"
+     "\n"
+     "def local_shadow(xs):\n"
+     "    len = 5\n"
+     "    max = min\n"
+     "    return len, max(xs)\n"
+     "\n"
+     "\n"
+     "len = lambda x: -1\n"
+     "print(len([1, 2]), local_shadow([3, 1, 2]))\n"
+     "import measure\n"
+     "print(measure.size([1, 2, 3]), measure.biggest([3, 9, 4]))\n"
+     "del len\n"
+     "print(len(\"abcd\"), max([3, 9, 4]), sorted([3, 1, 2]), abs(-7))\n"
+     "print(1000)\n",
+     "-1 (5, 1)\n"
+     "3 9\n"
+     "4 9 [1, 2, 3] 7\n"
+     "1000\n"),
+])
+
+def test_script_file(source, expected, tmp_path):
+    """
+    Тестирует выполнение файла (`cppython script.py`): вывод должен совпадать
+    с выводом CPython для того же скрипта.
+    """
+    my = run_script(MYPYTHON, source, tmp_path)
+    py = run_script(PYTHON, source, tmp_path)
+    assert my == expected, f"cppython: {source!r} -> {my!r}, expected: {expected!r}"
+    assert py == expected, f"CPython: {source!r} -> {py!r}, expected: {expected!r}"
+
+
+def test_script_token_cache(tmp_path):
+    """
+    Тестирует кэш токенов: первый запуск создаёт `__pycache__/script.py.tokc`,
+    повторный запуск берёт токены из кэша, а изменённый файл токенизируется заново.
+    """
+    source = "def f(n):\n    return n * 2\nprint(f(21))\n"
+
+    assert run_script(MYPYTHON, source, tmp_path) == "42\n"
+    assert (tmp_path / "__pycache__" / "script.py.tokc").is_file()
+    assert run_script(MYPYTHON, source, tmp_path) == "42\n"
+
+    assert run_script(MYPYTHON, source.replace("21", "5"), tmp_path) == "10\n"
+
+
+def test_script_profile(tmp_path):
+    """
+    Тестирует `--profile=файл`: вывод скрипта не меняется, таблица функций
+    уходит в stderr, а файл свёрнутых стеков содержит стеки вызовов для flamegraph.
+    """
+    source = "def fib(n):\n    if n < 2:\n        return n\n    return fib(n - 1) + fib(n - 2)\nprint(fib(15))\n"
+    script = tmp_path / "script.py"
+    script.write_text(source, encoding="utf-8")
+    stacks = tmp_path / "profile.folded"
+
+    p = subprocess.run(
+        [MYPYTHON, f"--profile={stacks}", str(script)],
+        cwd=tmp_path,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        timeout=5,
+    )
+
+    assert p.stdout.decode("utf-8") == "610\n"
+
+    report = p.stderr.decode("utf-8")
+    assert "ncalls" in report
+    assert any(line.split()[:1] == ["1973"] and line.endswith("fib") for line in report.splitlines())
+
+    lines = stacks.read_text(encoding="utf-8").splitlines()
+    assert any(line.startswith("<module>;fib;fib") for line in lines)
+
+
+def test_script_runtime_stats(tmp_path):
+    """
+    Тестирует счётчики RuntimeStats: `sys.runtime_stats()` видит попадания
+    инлайн-кэша, перестройки словаря и новые окружения, а `--stats` печатает
+    сводку в stderr, не меняя вывода скрипта.
+    """
+    source = (
+        "import sys\n"
+        "class P:\n"
+        "    def __init__(self):\n"
+        "        self.x = 1\n"
+        "def f(n):\n"
+        "    return n\n"
+        "p = P()\n"
+        "before = sys.runtime_stats()\n"
+        "d = {}\n"
+        "for i in range(100):\n"
+        "    d[i] = f(p.x)\n"
+        "after = sys.runtime_stats()\n"
+        "print(after['attr_cache.hits'] > before['attr_cache.hits'])\n"
+        "print(after['dict.resizes'] - before['dict.resizes'] >= 3)\n"
+        "print(after['environments'] - before['environments'] >= 100)\n"
+    )
+    script = tmp_path / "script.py"
+    script.write_text(source, encoding="utf-8")
+
+    p = subprocess.run(
+        [MYPYTHON, "--stats", str(script)],
+        cwd=tmp_path,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        timeout=5,
+    )
+
+    assert p.stdout.decode("utf-8") == "True\nTrue\nTrue\n"
+
+    report = p.stderr.decode("utf-8")
+    assert report.startswith("runtime stats:")
+    assert any(line.split()[1:] == ["environments"] for line in report.splitlines()[1:])
+
+
+def test_script_lineprofile(tmp_path):
+    """
+    Тестирует `--lineprofile`: вывод скрипта не меняется, а в stderr по каждой
+    выполненной строке функции печатается число выполнений и текст строки.
+    """
+    source = "def f(n):\n    s = 0\n    for i in range(n):\n        s += i\n    return s\nprint(f(10))\n"
+    script = tmp_path / "script.py"
+    script.write_text(source, encoding="utf-8")
+
+    p = subprocess.run(
+        [MYPYTHON, "--lineprofile", str(script)],
+        cwd=tmp_path,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        timeout=5,
+    )
+
+    assert p.stdout.decode("utf-8") == "45\n"
+
+    rows = {}
+    for line in p.stderr.decode("utf-8").splitlines():
+        parts = line.split(None, 4)
+        if len(parts) == 5 and parts[0].isdigit():
+            rows[int(parts[0])] = (int(parts[1]), parts[4])
+
+    assert rows[3] == (11, "for i in range(n):")
+    assert rows[4] == (10, "s += i")
+    assert rows[5] == (1, "return s")
+
+
+def test_script_tracemalloc(tmp_path):
+    """
+    Тестирует MemoryTracker: снимки `tracemalloc` группируют живые объекты
+    по типу и строке создания, `compare_to` показывает прирост между снимками,
+    а замыкания видны как удерживаемые окружения. `--tracemalloc` печатает
+    живые при выходе объекты в stderr, не меняя вывода скрипта.
+    """
+    source = (
+        "import tracemalloc\n"
+        "class Node:\n"
+        "    def __init__(self, parent):\n"
+        "        self.parent = parent\n"
+        "def make(n):\n"
+        "    items = []\n"
+        "    for i in range(n):\n"
+        "        items.append(Node(None))\n"
+        "    return items\n"
+        "def closure():\n"
+        "    big = [0] * 100\n"
+        "    def inner():\n"
+        "        return big\n"
+        "    return inner\n"
+        "tracemalloc.start()\n"
+        "print(tracemalloc.is_tracing())\n"
+        "before = tracemalloc.take_snapshot()\n"
+        "kept = make(50)\n"
+        "fns = [closure() for i in range(10)]\n"
+        "after = tracemalloc.take_snapshot()\n"
+        "types = {}\n"
+        "for stat in after.statistics('type'):\n"
+        "    types[stat[0]] = stat[2]\n"
+        "print(types['Node'] >= 50, types['environment'] >= 10)\n"
+        "lines = {}\n"
+        "for stat in after.compare_to(before, 'lineno'):\n"
+        "    lines[stat[0].split('script.py')[-1]] = stat\n"
+        "print(lines[':8'][2] > 0, lines[':8'][4] >= 50)\n"
+        "print(lines[':11'][4] >= 10)\n"
+        "try:\n"
+        "    after.statistics('traceback')\n"
+        "except ValueError as e:\n"
+        "    print(e)\n"
+        "tracemalloc.stop()\n"
+        "print(tracemalloc.is_tracing())\n"
+    )
+    script = tmp_path / "script.py"
+    script.write_text(source, encoding="utf-8")
+
+    p = subprocess.run(
+        [MYPYTHON, "--tracemalloc", str(script)],
+        cwd=tmp_path,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        timeout=5,
+    )
+
+    assert p.stdout.decode("utf-8") == (
+        "True\nTrue True\nTrue True\nTrue\nunknown key_type: 'traceback'\nFalse\n"
+    )
+    assert p.stderr.decode("utf-8").startswith("tracemalloc: live objects at exit")
+
+
+def test_script_superinstructions(tmp_path):
+    """
+    Тестирует суперинструкции горячего кода: после порога горячий цикл
+    переписывается (`superinstructions.fused`), а смена типа операндов
+    возвращает исходные инструкции (`superinstructions.deopts`).
+    """
+    source = (
+        "import sys\n"
+        "def loop(n, step):\n"
+        "    s = 0\n"
+        "    i = 0\n"
+        "    while i < n:\n"
+        "        s += step\n"
+        "        i += 1\n"
+        "    return s\n"
+        "print(loop(1000, 2))\n"
+        "fused = sys.runtime_stats()['superinstructions.fused']\n"
+        "print(fused >= 3)\n"
+        "print(loop(3, 0.5))\n"
+        "print(sys.runtime_stats()['superinstructions.deopts'] >= 1)\n"
+    )
+
+    assert run_script(MYPYTHON, source, tmp_path) == "2000\nTrue\n1.5\nTrue\n"
+
+
+def test_script_str_inplace_append(tmp_path):
+    """
+    Тестирует дописывание строки на месте: `s += t` над строкой, на которую
+    ссылается только сама переменная, не копирует накопленный текст
+    (`str.inplace_appends`), а строка с псевдонимом копируется как обычно.
+    """
+    source = (
+        "import sys\n"
+        "def build(n):\n"
+        "    s = ''\n"
+        "    for i in range(n):\n"
+        "        s += 'ab'\n"
+        "    return s\n"
+        "before = sys.runtime_stats()['str.inplace_appends']\n"
+        "print(len(build(5000)))\n"
+        "print(sys.runtime_stats()['str.inplace_appends'] - before >= 4000)\n"
+        "s = 'x'\n"
+        "t = s\n"
+        "s += 'y'\n"
+        "print(t, s)\n"
+    )
+
+    assert run_script(MYPYTHON, source, tmp_path) == "10000\nTrue\nx xy\n"
+
+
+def test_script_vecmath_vector(tmp_path):
+    """
+    Тестирует vecmath.vector: поэлементная арифметика с растяжением числа,
+    `/` в `d`, маски из gt() как индекс, dot, sum/min/max/mean по буферу
+    и ValueError для векторов разной длины.
+    """
+    source = (
+        "import vecmath\n"
+        "v = vecmath.vector([1, 2, 3, 4], 'q')\n"
+        "w = vecmath.vector([0.5, 0.5, 0.5, 0.5])\n"
+        "print(v + 1)\n"
+        "print(2 * v - w)\n"
+        "print(v / 2)\n"
+        "m = v.gt(2)\n"
+        "print(m, v[m])\n"
+        "print(v.dot(v), v.sum(), v.min(), v.max(), v.mean())\n"
+        "print(sum(v), max(w), len(v[1:3]), list(v * v))\n"
+        "print(v.astype('d').typecode, vecmath.vector(v).typecode, v == vecmath.vector([1, 2, 3, 4], 'q'))\n"
+        "try:\n"
+        "    v + vecmath.vector([1, 2, 3])\n"
+        "except ValueError as e:\n"
+        "    print(e)\n"
+    )
+
+    assert run_script(MYPYTHON, source, tmp_path) == (
+        "vector('q', [2, 3, 4, 5])\n"
+        "vector('d', [1.5, 3.5, 5.5, 7.5])\n"
+        "vector('d', [0.5, 1.0, 1.5, 2.0])\n"
+        "vector('B', [0, 0, 1, 1]) vector('q', [3, 4])\n"
+        "30 10 1 4 2.5\n"
+        "10 0.5 2 [1, 4, 9, 16]\n"
+        "d d True\n"
+        "operands could not be broadcast together with shapes (4,) (3,)\n"
+    )
+
+
+def test_script_parallel_map(tmp_path):
+    """
+    Тестирует parallel_map: элементы и результаты проходят через рабочие
+    процессы в исходном порядке, исключение функции поднимается в родителе
+    с тем же типом, а lambda передать нельзя.
+    """
+    source = (
+        "def square(x):\n"
+        "    return x * x\n"
+        "def describe(item):\n"
+        "    return {item: str(item) * 2, 't': (item, None)}\n"
+        "def fail(x):\n"
+        "    if x == 3:\n"
+        "        raise ValueError('bad item')\n"
+        "    return x\n"
+        "if __name__ == '__main__':\n"
+        "    print(parallel_map(square, range(10), workers=3))\n"
+        "    print(parallel_map(square, [], workers=2))\n"
+        "    print(parallel_map(describe, [1.5, 2]))\n"
+        "    try:\n"
+        "        parallel_map(fail, [1, 2, 3, 4], 2)\n"
+        "    except ValueError as e:\n"
+        "        print(e)\n"
+        "    try:\n"
+        "        parallel_map(lambda x: x, [1])\n"
+        "    except TypeError:\n"
+        "        print('lambda')\n"
+    )
+
+    assert run_script(MYPYTHON, source, tmp_path) == (
+        "[0, 1, 4, 9, 16, 25, 36, 49, 64, 81]\n"
+        "[]\n"
+        "[{1.5: '1.51.5', 't': (1.5, None)}, {2: '22', 't': (2, None)}]\n"
+        "bad item\n"
+        "lambda\n"
+    )
+
+
+def test_script_asyncio_streams(tmp_path):
+    """
+    Тестирует asyncio.open_connection: запись с drain(), readline() и чтение
+    строк через async for у эхо-сервера в потоке pytest; отказ в соединении
+    поднимается как ConnectionRefusedError.
+    """
+    server = socket.socket()
+    server.bind(("127.0.0.1", 0))
+    server.listen(1)
+    port = server.getsockname()[1]
+
+    closed = socket.socket()
+    closed.bind(("127.0.0.1", 0))
+    closed_port = closed.getsockname()[1]
+    closed.close()
+
+    def echo():
+        conn, _ = server.accept()
+        while True:
+            data = conn.recv(4096)
+            if not data:
+                break
+            conn.sendall(data)
+            if data.endswith(b"bye\n"):
+                break
+        conn.close()
+
+    thread = threading.Thread(target=echo, daemon=True)
+    thread.start()
+
+    source = (
+        "import asyncio\n"
+        "async def main():\n"
+        f"    reader, writer = await asyncio.open_connection('127.0.0.1', {port})\n"
+        "    writer.write(b'hello\\n')\n"
+        "    await writer.drain()\n"
+        "    print(await reader.readline())\n"
+        "    writer.write(b'one\\ntwo\\nbye\\n')\n"
+        "    await writer.drain()\n"
+        "    async for line in reader:\n"
+        "        print(line.decode().strip())\n"
+        "    print(reader.at_eof())\n"
+        "    writer.close()\n"
+        "    try:\n"
+        f"        await asyncio.open_connection('127.0.0.1', {closed_port})\n"
+        "    except ConnectionRefusedError:\n"
+        "        print('refused')\n"
+        "asyncio.run(main())\n"
+    )
+
+    try:
+        assert run_script(MYPYTHON, source, tmp_path) == (
+            "b'hello\\n'\n"
+            "one\n"
+            "two\n"
+            "bye\n"
+            "True\n"
+            "refused\n"
+        )
+    finally:
+        thread.join(timeout=5)
+        server.close()
+
+
+def test_script_marshal_format(tmp_path):
+    """
+    Тестирует формат marshal: малые целые занимают один-два байта varint,
+    неподдерживаемый тип — TypeError, а общий список внутри элемента
+    parallel_map остаётся общим у рабочего.
+    """
+    source = (
+        "import marshal\n"
+        "def same(pair):\n"
+        "    return pair[0] is pair[1]\n"
+        "if __name__ == '__main__':\n"
+        "    print(len(marshal.dumps(list(range(100)))))\n"
+        "    print(len(marshal.dumps(-1)), len(marshal.dumps(['ab', 'ab'])))\n"
+        "    try:\n"
+        "        marshal.dumps(object())\n"
+        "    except TypeError as e:\n"
+        "        print(e)\n"
+        "    try:\n"
+        "        marshal.loads(b'l')\n"
+        "    except ValueError as e:\n"
+        "        print(e)\n"
+        "    shared = [1]\n"
+        "    print(parallel_map(same, [(shared, shared), ([1], [1])], workers=2))\n"
+    )
+
+    assert run_script(MYPYTHON, source, tmp_path) == (
+        "238\n"
+        "2 8\n"
+        "cannot serialize 'object' object\n"
+        "corrupted serialized value\n"
+        "[True, False]\n"
+    )
+
+
+def test_script_parallel_sort(tmp_path):
+    """
+    Тестирует параллельную сортировку больших однородных списков после
+    vecmath.set_threads: результат, включая порядок равных 0.0 и -0.0
+    и reverse=True, совпадает с последовательной сортировкой.
+    """
+    source = (
+        "import vecmath\n"
+        "seed = 12345\n"
+        "ints = []\n"
+        "for i in range(300000):\n"
+        "    seed = (seed * 1103515245 + 12345) % 2147483648\n"
+        "    ints.append(seed % 100000 - 50000)\n"
+        "floats = [x / 7 if x % 5 else (0.0 if x % 2 else -0.0) for x in ints]\n"
+        "words = ['w' + str(x % 5000) for x in ints]\n"
+        "def both(items, reverse):\n"
+        "    vecmath.set_threads(1)\n"
+        "    one = sorted(items, reverse=reverse)\n"
+        "    vecmath.set_threads(4)\n"
+        "    many = sorted(items, reverse=reverse)\n"
+        "    return str(one) == str(many)\n"
+        "print(both(ints, False), both(ints, True))\n"
+        "print(both(floats, False), both(floats, True))\n"
+        "print(both(words, False), both(words, True))\n"
+        "ints.sort()\n"
+        "print(all(ints[i] <= ints[i + 1] for i in range(len(ints) - 1)), len(ints))\n"
+    )
+
+    assert run_script(MYPYTHON, source, tmp_path) == (
+        "True True\n"
+        "True True\n"
+        "True True\n"
+        "True 300000\n"
+    )
+
+
+def test_script_type_profile(tmp_path):
+    """
+    Тестирует профиль специализации: первый запуск пишет `__pycache__/script.py.prof`,
+    повторный применяет его сразу после компиляции, а запуск того же скрипта с
+    операндами других типов откатывает быстрые формы и считает верно.
+    """
+    source = (
+        "mode = open('mode.txt').read()\n"
+        "def conv(i):\n"
+        "    if mode == 'int':\n"
+        "        return i\n"
+        "    return str(i)\n"
+        "def add(a, b):\n"
+        "    return a + b\n"
+        "acc = conv(0)\n"
+        "i = 1\n"
+        "while i < 2000:\n"
+        "    acc = add(acc, conv(i % 10))\n"
+        "    i += 1\n"
+        "print(len(acc) if mode == 'str' else acc)\n"
+    )
+    mode = tmp_path / "mode.txt"
+
+    mode.write_text("int", encoding="utf-8")
+    assert run_script(MYPYTHON, source, tmp_path) == "9000\n"
+    assert (tmp_path / "__pycache__" / "script.py.prof").is_file()
+    assert run_script(MYPYTHON, source, tmp_path) == "9000\n"
+
+    mode.write_text("str", encoding="utf-8")
+    assert run_script(MYPYTHON, source, tmp_path) == "2000\n"
+
+    mode.write_text("int", encoding="utf-8")
+    assert run_script(MYPYTHON, source, tmp_path) == "9000\n"
+
+
+def test_script_execution_budget(tmp_path):
+    """
+    Тестирует `--max-ticks` и `--max-memory`: бесконечный цикл и неограниченный рост
+    памяти прерываются TimeoutError и MemoryError. Ошибку можно поймать, но следующий
+    тик бросает её снова, а процесс всё равно завершается с кодом 1. С `--tracemalloc`
+    объекты, созданные до скрипта (встроенные имена), в предел памяти не входят.
+    """
+    script = tmp_path / "script.py"
+
+    def run(*options_and_source):
+        *options, source = options_and_source
+        script.write_text(source, encoding="utf-8")
+        return subprocess.run(
+            [MYPYTHON, *options, str(script)],
+            cwd=tmp_path,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.PIPE,
+            timeout=5,
+        )
+
+    p = run("--max-ticks=100000", "total = 0\nfor i in range(1000):\n    total += i\nprint(total)\n")
+    assert p.returncode == 0
+    assert p.stdout.decode() == "499500\n"
+
+    p = run("--max-ticks=100000", (
+        "def spin():\n"
+        "    n = 0\n"
+        "    while True:\n"
+        "        n += 1\n"
+        "try:\n"
+        "    spin()\n"
+        "except TimeoutError:\n"
+        "    print('caught')\n"
+        "    try:\n"
+        "        for i in range(10):\n"
+        "            pass\n"
+        "    except TimeoutError:\n"
+        "        print('again')\n"
+    ))
+    assert p.returncode == 1
+    assert p.stdout.decode() == "caught\nagain\n"
+    assert "TimeoutError" in p.stderr.decode()
+
+    p = run("--max-memory=1000000", "items = []\nwhile True:\n    items.append('x' * 1000 + str(len(items)))\n")
+    assert p.returncode == 1
+    assert "MemoryError" in p.stderr.decode()
+
+    grow = "items = []\nwhile True:\n    items.append('x' * 1000 + str(len(items)))\n"
+    p = run("--tracemalloc", "--max-memory=1000000", grow)
+    assert p.returncode == 1
+    assert "MemoryError" in p.stderr.decode()
+
+    # предел считает только прирост: ранее отслеженные встроенные объекты не в счёт
+    p = run("--tracemalloc", "--max-memory=20000", (
+        "words = [str(i) for i in range(20)]\n"
+        "total = 0\n"
+        "for i in range(20000):\n"
+        "    total += i\n"
+        "print(len(words), total)\n"
+    ))
+    assert p.returncode == 0, p.stderr.decode()
+    assert p.stdout.decode() == "20 199990000\n"
+
+    p = run("--max-ticks=0", "print(1)\n")
+    assert p.returncode == 2
+
+
+def test_script_timeit_measure(tmp_path):
+    """
+    Тестирует timeit.measure: текст видит глобальные имена скрипта, но присваивает
+    в свою область; число выполнений задаётся или подбирается само, а минимум
+    не больше медианы времени одного выполнения.
+    """
+    source = (
+        "import timeit\n"
+        "counter = [0]\n"
+        "def bump():\n"
+        "    counter[0] += 1\n"
+        "r = timeit.measure('bump()\\nlocal = 1', number=10, repeat=3)\n"
+        "print(r['number'], r['repeat'], len(r['times']), counter[0])\n"
+        "print(r['min'] <= r['median'])\n"
+        "try:\n"
+        "    print(local)\n"
+        "except NameError:\n"
+        "    print('no local')\n"
+        "auto = timeit.measure(bump, repeat=1)\n"
+        "print(auto['number'] >= 1, counter[0] > 30)\n"
+        "def inner():\n"
+        "    return timeit.timeit('bump()', number=4)\n"
+        "before = counter[0]\n"
+        "inner()\n"
+        "print(counter[0] - before)\n"
+    )
+
+    assert run_script(MYPYTHON, source, tmp_path) == (
+        "10 3 3 30\n"
+        "True\n"
+        "no local\n"
+        "True True\n"
+        "4\n"
+    )
+
+
+def test_script_shared_memory(tmp_path):
+    """
+    Тестирует sharedmem.share: bytes, array и кортежи чисел ложатся в общий
+    сегмент как memoryview только для чтения, а рабочие parallel_map получают
+    вид над тем же сегментом, а не копию байтов.
+    """
+    source = (
+        "import sharedmem\n"
+        "from array import array\n"
+        "table = sharedmem.share(bytes(range(256)) * 4)\n"
+        "weights = sharedmem.share((1, 2.5, -3))\n"
+        "codes = sharedmem.share(array('i', [10, -20, 30]))\n"
+        "flags = sharedmem.share((True, False))\n"
+        "def lookup(item):\n"
+        "    view, i = item\n"
+        "    return (view[i], view.format, len(view), view.readonly, str(view.obj).startswith('<shared buffer'))\n"
+        "if __name__ == '__main__':\n"
+        "    print(len(table), table.format, table.readonly, table[255], table[256])\n"
+        "    print(weights.format, weights.tolist(), codes.format, codes.tolist(), flags.tolist())\n"
+        "    print(parallel_map(lookup, [(table, 1), (table[512:], 3), (weights, 1), (codes, 2)], workers=2))\n"
+        "    try:\n"
+        "        table[0] = 1\n"
+        "    except TypeError:\n"
+        "        print('readonly')\n"
+        "    try:\n"
+        "        sharedmem.share(('a', 1))\n"
+        "    except TypeError as e:\n"
+        "        print(e)\n"
+    )
+
+    assert run_script(MYPYTHON, source, tmp_path) == (
+        "1024 B True 255 0\n"
+        "d [1.0, 2.5, -3.0] i [10, -20, 30] [True, False]\n"
+        "[(1, 'B', 1024, True, True), (3, 'B', 512, True, True), (2.5, 'd', 3, True, True), (30, 'i', 3, True, True)]\n"
+        "readonly\n"
+        "share() tuple items must be bool, int or float, not 'str'\n"
+    )